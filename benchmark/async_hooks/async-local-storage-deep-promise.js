@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common.js');
+const { AsyncLocalStorage } = require('async_hooks');
+
+/**
+ * This benchmark measures the cost of entering `AsyncLocalStorage`s and
+ * propagating them through deep promise chains, on the increasing number of
+ * active `AsyncLocalStorage`s.
+ *
+ * - AsyncLocalStorage1.run()
+ *   ...
+ *   - AsyncLocalStorageN.run()
+ *     - Promise
+ *       ...
+ *         - Promise
+ *           - AsyncLocalStorage1.getStore()
+ */
+const bench = common.createBenchmark(main, {
+  storageCount: [1, 3, 10, 100],
+  depth: [10, 100],
+  n: [1e4],
+});
+
+async function chain(depth, store) {
+  if (depth === 0) {
+    return store.getStore();
+  }
+  await undefined;
+  return chain(depth - 1, store);
+}
+
+function runStores(stores, value, cb, idx = 0) {
+  if (idx === stores.length) {
+    return cb();
+  }
+  return stores[idx].run(value, () => {
+    return runStores(stores, value, cb, idx + 1);
+  });
+}
+
+async function runBenchmark(stores, depth, n) {
+  for (let i = 0; i < n; i++) {
+    await runStores(stores, i, () => chain(depth, stores[0]));
+  }
+}
+
+function main({ n, storageCount, depth }) {
+  const stores = new Array(storageCount).fill(0).map(() => new AsyncLocalStorage());
+
+  bench.start();
+  runBenchmark(stores, depth, n).then(() => {
+    bench.end(n);
+  });
+}
@@ -0,0 +1,35 @@
+'use strict';
+const common = require('../common.js');
+const { Blob } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  parts: [10, 1000],
+  bytes: [16, 1024],
+  n: [1e2],
+  operation: ['arrayBuffer', 'stream', 'response'],
+});
+
+async function run(n, parts, bytes, operation) {
+  const part = Buffer.allocUnsafe(bytes);
+  const source = new Blob(Array(parts).fill(part));
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    switch (operation) {
+      case 'arrayBuffer':
+        await source.arrayBuffer();
+        break;
+      case 'stream':
+        // eslint-disable-next-line no-unused-vars, no-empty
+        for await (const _ of source.stream()) {}
+        break;
+      case 'response':
+        await new Response(source).arrayBuffer();
+        break;
+    }
+  }
+  bench.end(n);
+}
+
+function main(conf) {
+  run(conf.n, conf.parts, conf.bytes, conf.operation).catch(console.log);
+}
@@ -0,0 +1,28 @@
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  bytes: [64 * 1024, 16 * 1024 * 1024],
+  mmap: ['true', 'false'],
+  n: [50],
+});
+
+async function run(n, bytes, mmap) {
+  tmpdir.refresh();
+  const file = tmpdir.resolve(`open-as-blob-${process.pid}`);
+  fs.writeFileSync(file, Buffer.alloc(bytes));
+  const blob = await fs.openAsBlob(file, { mmap: mmap === 'true' });
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    // eslint-disable-next-line no-unused-vars, no-empty
+    for await (const _ of blob.stream()) {}
+  }
+  bench.end(n);
+}
+
+function main({ n, bytes, mmap }) {
+  run(n, bytes, mmap).catch(console.log);
+}
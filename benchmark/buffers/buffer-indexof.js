@@ -2,6 +2,7 @@
 const common = require('../common.js');
 const fs = require('fs');
 const path = require('path');
+const { Needle } = require('buffer');
 
 const searchStrings = [
   '@',
@@ -20,12 +21,12 @@ const searchStrings = [
 const bench = common.createBenchmark(main, {
   search: searchStrings,
   encoding: ['undefined', 'utf8', 'ucs2'],
-  type: ['buffer', 'string'],
+  type: ['buffer', 'string', 'needle'],
   n: [5e4],
 }, {
   combinationFilter: (p) => {
-    return (p.type === 'buffer' && p.encoding === 'undefined') ||
-           (p.type !== 'buffer' && p.encoding !== 'undefined');
+    return (p.type !== 'string' && p.encoding === 'undefined') ||
+           (p.type === 'string' && p.encoding !== 'undefined');
   },
 });
 
@@ -46,6 +47,16 @@ function main({ n, search, encoding, type }) {
     search = Buffer.from(Buffer.from(search).toString(), encoding);
   }
 
+  if (type === 'needle') {
+    const needle = new Needle(search);
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      needle.indexOf(aliceBuffer, 0);
+    }
+    bench.end(n);
+    return;
+  }
+
   bench.start();
   for (let i = 0; i < n; i++) {
     aliceBuffer.indexOf(search, 0, encoding);
@@ -0,0 +1,25 @@
+'use strict';
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  size: [1024, 1024 * 1024, 64 * 1024 * 1024],
+  hint: [0, 1],
+  n: [20],
+});
+
+const { spawnSync } = require('child_process');
+
+function main({ size, hint, n }) {
+  const args = ['-e', `process.stdout.write(Buffer.alloc(${size}))`];
+  const options = {
+    maxBuffer: Infinity,
+    outputSizeHint: hint ? size : 0,
+  };
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const ret = spawnSync(process.execPath, args, options);
+    if (ret.stdout.length !== size)
+      throw new Error(`unexpected output length ${ret.stdout.length}`);
+  }
+  bench.end(n);
+}
@@ -61,6 +61,10 @@ class Benchmark {
     process.nextTick(() => {
       if (process.env.NODE_RUN_BENCHMARK_FN !== undefined) {
         fn(this.config);
+      } else if (process.env.NODE_BENCHMARK_LIST_JOBS !== undefined) {
+        // Used by compare-wasi.js, which runs every configuration itself
+        // because binaries that run inside a WebAssembly runtime can't fork.
+        this._listJobs();
       } else {
         // _run will use fork() to create a new process for each configuration
         // combination.
@@ -194,6 +198,25 @@ class Benchmark {
     );
   }
 
+  // Create configuration arguments
+  _childArgs(config) {
+    const childArgs = [];
+    for (const [key, value] of Object.entries(config)) {
+      childArgs.push(`${key}=${value}`);
+    }
+    for (const [key, value] of Object.entries(this.extra_options)) {
+      childArgs.push(`${key}=${value}`);
+    }
+    return childArgs;
+  }
+
+  _listJobs() {
+    process.stdout.write(`${JSON.stringify({
+      flags: this.flags,
+      jobs: this.queue.map((config) => this._childArgs(config)),
+    })}\n`);
+  }
+
   _run() {
     // If forked, report to the parent.
     if (process.send) {
@@ -213,16 +236,8 @@ class Benchmark {
       const childEnv = { ...process.env };
       childEnv.NODE_RUN_BENCHMARK_FN = '';
 
-      // Create configuration arguments
-      const childArgs = [];
-      for (const [key, value] of Object.entries(config)) {
-        childArgs.push(`${key}=${value}`);
-      }
-      for (const [key, value] of Object.entries(this.extra_options)) {
-        childArgs.push(`${key}=${value}`);
-      }
-
-      const child = child_process.fork(require.main.filename, childArgs, {
+      const child = child_process.fork(require.main.filename,
+                                       this._childArgs(config), {
         env: childEnv,
         execArgv: this.flags.concat(process.execArgv),
       });
@@ -0,0 +1,165 @@
+'use strict';
+
+const { spawn, spawnSync } = require('node:child_process');
+const path = require('path');
+const CLI = require('./_cli.js');
+
+//
+// Parse arguments
+//
+const cli = new CLI(`usage: ./node compare-wasi.js [options] [--] <category> ...
+  Run each benchmark in the <category> directory many times using a native
+  node binary and a WASI build of node that runs inside a WebAssembly runtime.
+  More than one <category> directory can be specified. The output is
+  formatted as csv, which can be processed using 'wasi-overhead.js'.
+
+  --native   ./node             native node binary (required)
+  --wasi     ./node.wasm        WASI node binary (required)
+  --runtime  "wasmtime run"     command that runs the WASI binary, split at
+                                whitespace. It is followed by the environment
+                                variables, the WASI binary and the node
+                                arguments. The benchmark directory must be
+                                accessible from inside the runtime, e.g. with
+                                "wasmtime run --dir=/"
+  --env-flag --env              flag that passes an environment variable
+                                (NAME=value) to the runtime, or '' if the
+                                runtime passes on its own environment
+  --runs     5                  number of samples
+  --warmup   1                  number of discarded runs of each configuration
+                                before the samples are taken
+  --filter   pattern            includes only benchmark scripts matching
+                                <pattern> (can be repeated)
+  --exclude  pattern            excludes scripts matching <pattern> (can be
+                                repeated)
+  --set      variable=value     set benchmark variable (can be repeated)
+
+  Unlike compare.js, every configuration runs in a process of its own that is
+  started by this script, because the WASI binary can't fork. The native
+  binary is run the same way so that the samples are comparable. The time
+  column is the wall-clock time of the whole process, in seconds, including
+  the startup of node and of the runtime.
+`, { arrayArgs: ['set', 'filter', 'exclude'] });
+
+if (!cli.optional.native || !cli.optional.wasi) {
+  cli.abort(cli.usage);
+}
+
+const runtime = (cli.optional.runtime ?? 'wasmtime run').split(/\s+/)
+  .filter(Boolean);
+const envFlag = cli.optional['env-flag'] ?? '--env';
+const runs = cli.optional.runs ? parseInt(cli.optional.runs, 10) : 5;
+const warmup = cli.optional.warmup ? parseInt(cli.optional.warmup, 10) : 1;
+const benchmarks = cli.benchmarks();
+
+if (benchmarks.length === 0) {
+  console.error('No benchmarks found');
+  process.exitCode = 1;
+  return;
+}
+
+const binaries = ['native', 'wasi'];
+
+// Returns the command that runs node with `args` and the additional
+// environment variables in `env`.
+function command(binary, args, env) {
+  if (binary === 'native') {
+    return {
+      file: cli.optional.native,
+      args,
+      env: { ...process.env, ...env },
+    };
+  }
+  const envArgs = [];
+  if (envFlag !== '') {
+    for (const [key, value] of Object.entries(env)) {
+      envArgs.push(envFlag, `${key}=${value}`);
+    }
+  }
+  return {
+    file: runtime[0],
+    args: [...runtime.slice(1), ...envArgs, cli.optional.wasi, ...args],
+    env: { ...process.env, ...env },
+  };
+}
+
+// The configurations are computed by the native binary, so that both
+// binaries run exactly the same jobs.
+function listJobs(filename) {
+  const { file, args, env } = command(
+    'native',
+    [path.resolve(__dirname, filename), ...cli.optional.set],
+    { NODE_BENCHMARK_LIST_JOBS: '' });
+  const child = spawnSync(file, args, { env, encoding: 'utf8' });
+  if (child.status !== 0) {
+    process.stderr.write(child.stderr);
+    process.exit(child.status ?? 1);
+  }
+  const output = child.stdout.trim();
+  return output === '' ? { flags: [], jobs: [] } : JSON.parse(output);
+}
+
+// A benchmark that doesn't fork reports "<name> <configuration>: <rate>".
+function parseRate(stdout) {
+  const line = stdout.trim().split('\n').pop() ?? '';
+  const index = line.lastIndexOf(': ');
+  return index === -1 ? NaN : +line.slice(index + 2).replace(/,/g, '');
+}
+
+function runJob(binary, filename, flags, jobArgs) {
+  const { file, args, env } = command(
+    binary,
+    [...flags, path.resolve(__dirname, filename), ...jobArgs],
+    { NODE_RUN_BENCHMARK_FN: '' });
+  return new Promise((resolve) => {
+    const child = spawn(file, args, {
+      env,
+      stdio: ['ignore', 'pipe', 'inherit'],
+    });
+    let stdout = '';
+    child.stdout.setEncoding('utf8');
+    child.stdout.on('data', (chunk) => stdout += chunk);
+    child.on('close', (code) => {
+      if (code) {
+        console.error(`${binary} ${filename} ${jobArgs.join(' ')} ` +
+                      `exited with code ${code}`);
+        process.exit(code);
+      }
+      resolve(parseRate(stdout));
+    });
+  });
+}
+
+(async function main() {
+  // Print csv header
+  console.log('"binary","filename","configuration","rate","time"');
+
+  for (const filename of benchmarks) {
+    const { flags, jobs } = listJobs(filename);
+    for (const jobArgs of jobs) {
+      // Escape quotes (") for correct csv formatting
+      const conf = jobArgs.join(' ').replace(/"/g, '""');
+
+      // The first runs pay for filling the file system caches and for
+      // compiling the WebAssembly module, which runtimes that compile in
+      // tiers or cache the compiled code only do once, so they are
+      // discarded. Warming up the JIT inside of node is left to the
+      // benchmark itself, as with compare.js.
+      for (let iter = 0; iter < warmup; iter++) {
+        for (const binary of binaries) {
+          await runJob(binary, filename, flags, jobArgs);
+        }
+      }
+
+      // The binaries take turns so that changes in the load of the machine
+      // affect both of them.
+      for (let iter = 0; iter < runs; iter++) {
+        for (const binary of binaries) {
+          const start = process.hrtime.bigint();
+          const rate = await runJob(binary, filename, flags, jobArgs);
+          const time = Number(process.hrtime.bigint() - start) / 1e9;
+          console.log(`"${binary}","${filename}","${conf}",${rate},${time}`);
+        }
+      }
+    }
+  }
+})();
@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+const keylen = { 'aes-128-gcm': 16, 'aes-256-gcm': 32, 'chacha20-poly1305': 32 };
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  cipher: ['aes-128-gcm', 'aes-256-gcm', 'chacha20-poly1305'],
+  len: [64, 1024, 16 * 1024],
+  api: ['oneshot', 'into', 'cipher'],
+});
+
+function main({ n, len, cipher, api }) {
+  const message = Buffer.alloc(len, 'b');
+  const key = crypto.randomBytes(keylen[cipher]);
+  const iv = crypto.randomBytes(12);
+  const aad = Buffer.alloc(16, 'z');
+  const record = Buffer.alloc(len + 16);
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    switch (api) {
+      case 'oneshot': {
+        crypto.aeadSeal(cipher, key, iv, message, record, { aad });
+        crypto.aeadOpen(cipher, key, iv, record, record, { aad });
+        break;
+      }
+      case 'into': {
+        const alice = crypto.createCipheriv(cipher, key, iv);
+        alice.setAAD(aad);
+        alice.updateInto(message, record);
+        alice.finalInto(record, len);
+        const bob = crypto.createDecipheriv(cipher, key, iv);
+        bob.setAuthTag(alice.getAuthTag());
+        bob.setAAD(aad);
+        bob.updateInto(record.subarray(0, len), record);
+        bob.finalInto(record, len);
+        break;
+      }
+      case 'cipher': {
+        const alice = crypto.createCipheriv(cipher, key, iv);
+        alice.setAAD(aad);
+        const enc = alice.update(message);
+        alice.final();
+        const bob = crypto.createDecipheriv(cipher, key, iv);
+        bob.setAuthTag(alice.getAuthTag());
+        bob.setAAD(aad);
+        bob.update(enc);
+        bob.final();
+        break;
+      }
+    }
+  }
+  bench.end(n);
+}
@@ -0,0 +1,48 @@
+'use strict';
+
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const keyOptions = {
+  ec: { namedCurve: 'P-256' },
+  x25519: undefined,
+};
+
+const bench = common.createBenchmark(main, {
+  keyType: ['ec', 'x25519'],
+  mode: ['batch', 'async-parallel'],
+  batch: [100],
+  n: [1e3],
+});
+
+function main({ keyType, mode, batch, n }) {
+  const { privateKey } =
+    crypto.generateKeyPairSync(keyType, keyOptions[keyType]);
+  const publicKeys = [];
+  for (let i = 0; i < batch; i++) {
+    publicKeys.push(
+      crypto.generateKeyPairSync(keyType, keyOptions[keyType]).publicKey);
+  }
+
+  // Both modes derive n secrets on the threadpool, either in batches or one
+  // job per public key.
+  let remaining = n;
+  function done(err) {
+    if (err) throw err;
+    if (--remaining === 0)
+      bench.end(n);
+  }
+
+  bench.start();
+  if (mode === 'batch') {
+    remaining = n / batch;
+    for (let i = 0; i < n / batch; i++) {
+      crypto.diffieHellmanBatch({ privateKey, publicKeys }, done);
+    }
+  } else {
+    for (let i = 0; i < n; i++) {
+      crypto.diffieHellman({ privateKey, publicKey: publicKeys[i % batch] },
+                           done);
+    }
+  }
+}
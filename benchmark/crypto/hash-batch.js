@@ -0,0 +1,37 @@
+'use strict';
+
+const common = require('../common.js');
+const { hash, hashBatch } = require('crypto');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  method: ['batch', 'oneshot'],
+  algorithm: ['sha1', 'sha256'],
+  length: [32, 1024],
+  batch: [1000],
+  n: [100],
+});
+
+function main({ method, algorithm, length, batch, n }) {
+  const data = Buffer.alloc(length * batch, 'x');
+  const offsets = [];
+  for (let i = 0; i < batch; i++)
+    offsets.push(i * length);
+
+  let result;
+  bench.start();
+  if (method === 'batch') {
+    for (let i = 0; i < n; i++)
+      result = hashBatch(algorithm, data, offsets);
+  } else {
+    for (let i = 0; i < n; i++) {
+      for (let j = 0; j < batch; j++) {
+        result = hash(algorithm,
+                      data.subarray(j * length, (j + 1) * length),
+                      'buffer');
+      }
+    }
+  }
+  bench.end(n * batch);
+  assert.ok(result.length > 0);
+}
@@ -0,0 +1,55 @@
+'use strict';
+
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+function readKey(name) {
+  return fs.readFileSync(`${fixtures_keydir}/${name}.pem`, 'utf8');
+}
+
+const keyFixtures = {
+  ec: ['ec_p256_public', 'ec_p256_private'],
+  ed25519: ['ed25519_public', 'ed25519_private'],
+};
+
+const bench = common.createBenchmark(main, {
+  keyType: ['ec', 'ed25519'],
+  mode: ['batch', 'async-parallel'],
+  batch: [100],
+  n: [1e3],
+});
+
+function main({ keyType, mode, batch, n }) {
+  const publicKey = crypto.createPublicKey(readKey(keyFixtures[keyType][0]));
+  const privateKey = crypto.createPrivateKey(readKey(keyFixtures[keyType][1]));
+  const digest = keyType === 'ec' ? 'sha256' : null;
+  const data = [];
+  for (let i = 0; i < batch; i++)
+    data.push(crypto.randomBytes(256));
+  const signatures = crypto.signBatch(digest, data, privateKey);
+
+  // Both modes verify n messages on the threadpool, either in batches or one
+  // job per message.
+  let remaining = n;
+  function done(err) {
+    if (err) throw err;
+    if (--remaining === 0)
+      bench.end(n);
+  }
+
+  bench.start();
+  if (mode === 'batch') {
+    remaining = n / batch;
+    for (let i = 0; i < n / batch; i++) {
+      crypto.verifyBatch(digest, data, publicKey, signatures, done);
+    }
+  } else {
+    for (let i = 0; i < n; i++) {
+      crypto.verify(digest, data[i % batch], publicKey,
+                    signatures[i % batch], done);
+    }
+  }
+}
@@ -0,0 +1,36 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [10],
+  files: [16, 1024],
+  size: [1024, 64 * 1024],
+});
+
+function prepareTestDirectory(files, size) {
+  const testDir = tmpdir.resolve(`test-cp-tree-${process.pid}`);
+  const contents = Buffer.alloc(size, 'x');
+  for (let i = 0; i < files; i++) {
+    const dir = path.join(testDir, `dir-${i % 16}`);
+    fs.mkdirSync(dir, { recursive: true });
+    fs.writeFileSync(path.join(dir, `file-${i}.txt`), contents);
+  }
+  return testDir;
+}
+
+function main({ n, files, size }) {
+  tmpdir.refresh();
+
+  const src = prepareTestDirectory(files, size);
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const dest = tmpdir.resolve(`cp-tree-bench-${process.pid}-${i}`);
+    fs.cpSync(src, dest, { recursive: true });
+  }
+  bench.end(n * files);
+}
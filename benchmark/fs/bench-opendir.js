@@ -9,22 +9,24 @@ const bench = common.createBenchmark(main, {
   dir: [ 'lib', 'test/parallel'],
   mode: [ 'async', 'sync', 'callback' ],
   bufferSize: [ 4, 32, 1024 ],
+  prefetch: [0, 1],
 });
 
-async function main({ n, dir, mode, bufferSize }) {
+async function main({ n, dir, mode, bufferSize, prefetch }) {
   const fullPath = path.resolve(__dirname, '../../', dir);
 
   bench.start();
 
+  const options = { bufferSize, prefetch: prefetch === 1 };
   let counter = 0;
   for (let i = 0; i < n; i++) {
     if (mode === 'async') {
-      const dir = await fs.promises.opendir(fullPath, { bufferSize });
+      const dir = await fs.promises.opendir(fullPath, options);
       // eslint-disable-next-line no-unused-vars
       for await (const entry of dir)
         counter++;
     } else if (mode === 'callback') {
-      const dir = await fs.promises.opendir(fullPath, { bufferSize });
+      const dir = await fs.promises.opendir(fullPath, options);
       await new Promise((resolve, reject) => {
         function read() {
           dir.read((err, entry) => {
@@ -42,7 +44,7 @@ async function main({ n, dir, mode, bufferSize }) {
         read();
       });
     } else {
-      const dir = fs.opendirSync(fullPath, { bufferSize });
+      const dir = fs.opendirSync(fullPath, options);
       while (dir.readSync() !== null)
         counter++;
       dir.closeSync();
@@ -0,0 +1,45 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [100],
+  files: [16, 256],
+  size: [1024],
+  method: ['readFile', 'readMany'],
+});
+
+function main({ n, files, size, method }) {
+  tmpdir.refresh();
+  const paths = [];
+  for (let i = 0; i < files; i++) {
+    const path = tmpdir.resolve(`file-${i}.txt`);
+    fs.writeFileSync(path, 'a'.repeat(size));
+    paths.push(path);
+  }
+
+  let remaining = n;
+  bench.start();
+  if (method === 'readFile') {
+    (function next() {
+      if (remaining-- === 0) return bench.end(n * files);
+      let pending = files;
+      for (const path of paths) {
+        fs.readFile(path, (err) => {
+          if (err) throw err;
+          if (--pending === 0) next();
+        });
+      }
+    })();
+  } else {
+    (function next() {
+      if (remaining-- === 0) return bench.end(n * files);
+      fs.readMany(paths, (err) => {
+        if (err) throw err;
+        next();
+      });
+    })();
+  }
+}
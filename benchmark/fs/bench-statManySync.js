@@ -0,0 +1,27 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+
+const bench = common.createBenchmark(main, {
+  n: [1e4],
+  batch: [1, 16, 256],
+  method: ['statSync', 'statManySync'],
+});
+
+function main({ n, batch, method }) {
+  const paths = new Array(batch).fill(__dirname);
+
+  bench.start();
+  if (method === 'statSync') {
+    for (let i = 0; i < n; i++) {
+      for (let j = 0; j < batch; j++)
+        fs.statSync(paths[j]);
+    }
+  } else {
+    for (let i = 0; i < n; i++) {
+      fs.statManySync(paths);
+    }
+  }
+  bench.end(n * batch);
+}
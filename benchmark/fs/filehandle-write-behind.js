@@ -0,0 +1,33 @@
+// Issue many small filehandle.write() calls without waiting for each one,
+// with and without write-behind mode.
+'use strict';
+
+const common = require('../common.js');
+const fsp = require('fs/promises');
+const tmpdir = require('../../test/common/tmpdir');
+
+tmpdir.refresh();
+const filename = tmpdir.resolve(`.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  writeBehind: ['true', 'false'],
+  size: [64, 1024],
+  n: [1e5],
+});
+
+async function main({ writeBehind, size, n }) {
+  const chunk = Buffer.alloc(size, 'l');
+  const file = await fsp.open(filename, 'w');
+  file.setWriteBehind(writeBehind === 'true');
+  // Without write-behind, concurrent writes need explicit positions to land
+  // in a well-defined order.
+  const writes = new Array(n);
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    writes[i] = file.write(chunk, 0, size, i * size);
+  }
+  await Promise.all(writes);
+  bench.end(n);
+  await file.close();
+  await fsp.rm(filename);
+}
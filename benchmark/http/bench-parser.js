@@ -4,12 +4,14 @@ const common = require('../common');
 
 const bench = common.createBenchmark(main, {
   len: [4, 8, 16, 32],
+  valueLen: [12, 256],
+  flatHeaders: [0, 1],
   n: [1e5],
 }, {
   flags: ['--expose-internals', '--no-warnings'],
 });
 
-function main({ len, n }) {
+function main({ len, valueLen, flatHeaders, n }) {
   const { HTTPParser } = common.binding('http_parser');
   const REQUEST = HTTPParser.REQUEST;
   const kOnHeaders = HTTPParser.kOnHeaders | 0;
@@ -24,14 +26,14 @@ function main({ len, n }) {
     bench.start();
     for (let i = 0; i < n; i++) {
       parser.execute(header, 0, header.length);
-      parser.initialize(REQUEST, {});
+      parser.initialize(REQUEST, {}, 0, 0, null, flatHeaders === 1);
     }
     bench.end(n);
   }
 
   function newParser(type) {
     const parser = new HTTPParser();
-    parser.initialize(type, {});
+    parser.initialize(type, {}, 0, 0, null, flatHeaders === 1);
 
     parser.headers = [];
 
@@ -45,8 +47,11 @@ function main({ len, n }) {
 
   let header = `GET /hello HTTP/1.1${CRLF}Content-Type: text/plain${CRLF}`;
 
+  // Long values are scanned with the vectorized spans of llhttp, where they
+  // are available.
   for (let i = 0; i < len; i++) {
-    header += `X-Filler${i}: ${Math.random().toString(36).substring(2)}${CRLF}`;
+    const value = Math.random().toString(36).substring(2).padEnd(valueLen, 'x');
+    header += `X-Filler${i}: ${value}${CRLF}`;
   }
   header += CRLF;
 
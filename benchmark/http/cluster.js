@@ -10,15 +10,20 @@ if (cluster.isPrimary) {
     type: ['bytes', 'buffer'],
     len: [4, 1024, 102400],
     c: [50, 500],
+    reusePort: [0, 1],
     duration: 5,
   });
 } else {
   const port = parseInt(process.env.PORT || PORT);
-  require('../fixtures/simple-http-server.js').listen(port);
+  // With reusePort every worker accepts on its own socket instead of
+  // getting connections handed over by the primary.
+  const reusePort = process.env.REUSE_PORT === '1';
+  require('../fixtures/simple-http-server.js').listen({ port, reusePort });
 }
 
-function main({ type, len, c, duration }) {
+function main({ type, len, c, reusePort, duration }) {
   process.env.PORT = PORT;
+  process.env.REUSE_PORT = reusePort;
   let workers = 0;
   const w1 = cluster.fork();
   const w2 = cluster.fork();
@@ -0,0 +1,26 @@
+'use strict';
+
+const common = require('../common.js');
+const { BlockList } = require('net');
+
+const bench = common.createBenchmark(main, {
+  rules: [10, 1000, 100000],
+  n: [1e5],
+});
+
+function main({ rules, n }) {
+  const blockList = new BlockList();
+  for (let i = 0; i < rules; i++) {
+    blockList.addSubnet(`10.${(i >> 8) & 0xff}.${i & 0xff}.0`, 24);
+  }
+  const addresses = [];
+  for (let i = 0; i < 256; i++) {
+    addresses.push(`${i % 2 ? 10 : 11}.${i}.${255 - i}.1`);
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    blockList.check(addresses[i & 0xff]);
+  }
+  bench.end(n);
+}
@@ -0,0 +1,30 @@
+'use strict';
+const common = require('../common.js');
+const readline = require('readline');
+const { Readable } = require('stream');
+
+const bench = common.createBenchmark(main, {
+  lineLength: [16, 128, 1024],
+  chunkSize: [64 * 1024],
+  n: [1e3],
+});
+
+async function main({ lineLength, chunkSize, n }) {
+  const line = 'x'.repeat(lineLength - 1) + '\n';
+  const chunk = Buffer.from(line.repeat(Math.ceil(chunkSize / lineLength)));
+
+  let i = 0;
+  const input = new Readable({
+    read() {
+      this.push(i++ < n ? chunk : null);
+    },
+  });
+  const rl = readline.createInterface({ input, crlfDelay: Infinity });
+
+  let lineCount = 0;
+  rl.on('line', () => lineCount++);
+
+  bench.start();
+  await new Promise((resolve) => rl.on('close', resolve));
+  bench.end(lineCount);
+}
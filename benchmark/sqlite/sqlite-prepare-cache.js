@@ -0,0 +1,38 @@
+'use strict';
+const common = require('../common.js');
+const sqlite = require('node:sqlite');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  statementCacheSize: [0, 16],
+  statement: [
+    'SELECT ?',
+    'SELECT text_column, integer_column FROM foo WHERE integer_column = ?',
+  ],
+});
+
+function main(conf) {
+  const db = new sqlite.DatabaseSync(':memory:', {
+    statementCacheSize: conf.statementCacheSize,
+  });
+
+  db.exec('CREATE TABLE foo (text_column TEXT, integer_column INTEGER)');
+  const fooInsertStatement = db.prepare(
+    'INSERT INTO foo (text_column, integer_column) VALUES (?, ?)',
+  );
+
+  for (let i = 0; i < 100; i++) {
+    fooInsertStatement.run(crypto.randomUUID(), i);
+  }
+
+  let i;
+  let deadCodeElimination;
+
+  bench.start();
+  for (i = 0; i < conf.n; i += 1)
+    deadCodeElimination = db.prepare(conf.statement).get(i % 100);
+  bench.end(conf.n);
+
+  assert.ok(deadCodeElimination !== undefined);
+}
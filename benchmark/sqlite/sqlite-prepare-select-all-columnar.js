@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common.js');
+const sqlite = require('node:sqlite');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  n: [100],
+  tableSeedSize: [1e5],
+  mode: ['all', 'allColumnar'],
+  statement: [
+    'SELECT integer_column, real_column FROM foo',
+    'SELECT text_column, integer_column, real_column FROM foo',
+  ],
+});
+
+function main(conf) {
+  const db = new sqlite.DatabaseSync(':memory:');
+
+  db.exec('CREATE TABLE foo (text_column TEXT, integer_column INTEGER, real_column REAL)');
+  const fooInsertStatement = db.prepare(
+    'INSERT INTO foo (text_column, integer_column, real_column) VALUES (?, ?, ?)',
+  );
+
+  for (let i = 0; i < conf.tableSeedSize; i++) {
+    fooInsertStatement.run(
+      crypto.randomUUID(),
+      Math.floor(Math.random() * 100),
+      Math.random(),
+    );
+  }
+
+  let i;
+  let deadCodeElimination;
+
+  const stmt = db.prepare(conf.statement);
+
+  bench.start();
+  if (conf.mode === 'all') {
+    for (i = 0; i < conf.n; i += 1)
+      deadCodeElimination = stmt.all();
+  } else {
+    for (i = 0; i < conf.n; i += 1)
+      deadCodeElimination = stmt.allColumnar();
+  }
+  bench.end(conf.n);
+
+  assert.ok(deadCodeElimination !== undefined);
+}
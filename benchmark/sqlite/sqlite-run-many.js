@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common.js');
+const sqlite = require('node:sqlite');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  mode: ['run', 'run-in-transaction', 'runMany-rows', 'runMany-columns'],
+});
+
+function main(conf) {
+  const db = new sqlite.DatabaseSync(':memory:');
+  db.exec('CREATE TABLE events (time REAL, kind TEXT)');
+
+  const time = new Float64Array(conf.n);
+  const kind = [];
+  const rows = [];
+  for (let i = 0; i < conf.n; i++) {
+    time[i] = Math.random();
+    kind.push(crypto.randomUUID());
+    rows.push([time[i], kind[i]]);
+  }
+
+  const anonymous = db.prepare('INSERT INTO events (time, kind) VALUES (?, ?)');
+  const named = db.prepare(
+    'INSERT INTO events (time, kind) VALUES ($time, $kind)',
+  );
+
+  let i;
+  let result;
+
+  bench.start();
+  switch (conf.mode) {
+    case 'run':
+      for (i = 0; i < conf.n; i += 1)
+        result = anonymous.run(rows[i][0], rows[i][1]);
+      break;
+    case 'run-in-transaction':
+      db.exec('BEGIN');
+      for (i = 0; i < conf.n; i += 1)
+        result = anonymous.run(rows[i][0], rows[i][1]);
+      db.exec('COMMIT');
+      break;
+    case 'runMany-rows':
+      result = anonymous.runMany(rows);
+      break;
+    case 'runMany-columns':
+      result = named.runMany({ time, kind });
+      break;
+  }
+  bench.end(conf.n);
+
+  assert.ok(result !== undefined);
+}
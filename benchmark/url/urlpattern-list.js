@@ -0,0 +1,38 @@
+'use strict';
+const common = require('../common.js');
+const { URLPattern, URLPatternList } = require('url');
+const { notStrictEqual } = require('assert');
+
+const bench = common.createBenchmark(main, {
+  method: ['URLPattern', 'URLPatternList'],
+  patterns: [10, 500],
+  n: [1e4],
+});
+
+function main({ method, patterns, n }) {
+  const routes = [];
+  for (let i = 0; i < patterns; i++) {
+    routes.push(new URLPattern({ pathname: `/resource${i}/:id` }));
+  }
+  const input = `https://example.org/resource${patterns - 1}/42`;
+
+  let deadcode;
+  if (method === 'URLPattern') {
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      for (let j = 0; j < routes.length; j++) {
+        deadcode = routes[j].exec(input);
+        if (deadcode !== null) break;
+      }
+    }
+    bench.end(n);
+  } else {
+    const list = new URLPatternList(routes);
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      deadcode = list.exec(input);
+    }
+    bench.end(n);
+  }
+  notStrictEqual(deadcode, null);
+}
@@ -0,0 +1,44 @@
+'use strict';
+const common = require('../common.js');
+const url = require('url');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  method: ['URL', 'parseMany', 'parseMany-url'],
+  type: common.urlDataTypes,
+  e: [1],
+});
+
+function main({ e, method, type }) {
+  const data = common.bakeUrlData(type, e, false, false);
+  const len = data.length;
+  let noDead;
+
+  switch (method) {
+    case 'URL':
+      bench.start();
+      for (let i = 0; i < len; ++i) {
+        noDead = URL.parse(data[i]);
+      }
+      bench.end(len);
+      break;
+    case 'parseMany':
+      bench.start();
+      noDead = url.parseMany(data).href(len - 1);
+      bench.end(len);
+      break;
+    case 'parseMany-url': {
+      bench.start();
+      const results = url.parseMany(data);
+      for (let i = 0; i < len; ++i) {
+        noDead = results.url(i);
+      }
+      bench.end(len);
+      break;
+    }
+    default:
+      throw new Error(`Unsupported method ${method}`);
+  }
+
+  assert.notStrictEqual(noDead, undefined);
+}
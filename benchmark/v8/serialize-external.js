@@ -0,0 +1,27 @@
+'use strict';
+
+const common = require('../common.js');
+const v8 = require('v8');
+
+const bench = common.createBenchmark(main, {
+  len: [1024 * 16, 1024 * 1024],
+  mode: ['copy', 'presized', 'external'],
+  n: [1e3],
+});
+
+function main({ n, len, mode }) {
+  const value = { shape: [len], data: new Float64Array(len) };
+  const options = {};
+  if (mode === 'presized') options.bufferSize = len * 8 + 64;
+  if (mode === 'external') options.externalThreshold = 4096;
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const ser = new v8.DefaultSerializer(options);
+    ser.writeHeader();
+    ser.writeValue(value);
+    if (mode === 'external') ser.releaseBuffers();
+    else ser.releaseBuffer();
+  }
+  bench.end(n);
+}
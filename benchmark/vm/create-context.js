@@ -4,6 +4,7 @@ const common = require('../common.js');
 
 const bench = common.createBenchmark(main, {
   n: [100],
+  poolSize: [0, 100],
 });
 
 const vm = require('vm');
@@ -13,7 +14,8 @@ const ctxFn = new vm.Script(`
   var c = a + b;
 `);
 
-function main({ n }) {
+function main({ n, poolSize }) {
+  vm.setContextPoolSize(poolSize);
   bench.start();
   let context;
   for (let i = 0; i < n; i++) {
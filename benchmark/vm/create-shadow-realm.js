@@ -0,0 +1,19 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  n: [100],
+}, {
+  flags: ['--experimental-shadow-realm'],
+});
+
+function main({ n }) {
+  bench.start();
+  let realm;
+  for (let i = 0; i < n; i++) {
+    realm = new ShadowRealm();
+  }
+  bench.end(n);
+  realm.evaluate('globalThis');
+}
@@ -0,0 +1,114 @@
+'use strict';
+
+const fs = require('fs');
+const CLI = require('./_cli.js');
+
+//
+// Parse arguments
+//
+const cli = new CLI(`usage: ./node wasi-overhead.js [options] <csv>
+  Read the output of compare-wasi.js and rank the benchmark categories by
+  how much slower they are with the WASI binary than with the native one.
+
+  --by  category             rank by 'category' or by 'file'
+
+  The slowdown of every configuration is the median rate of the native binary
+  divided by the median rate of the WASI binary. The slowdowns of a category
+  or file are summarized by their geometric mean.
+`, { arrayArgs: [] });
+
+const by = cli.optional.by ?? 'category';
+if (cli.items.length !== 1 || !['category', 'file'].includes(by)) {
+  cli.abort(cli.usage);
+}
+
+function parseCsvLine(line) {
+  const fields = [];
+  const re = /"((?:[^"]|"")*)"|([^,]*)/y;
+  for (let i = 0; i <= line.length; i = re.lastIndex + 1) {
+    re.lastIndex = i;
+    const match = re.exec(line);
+    fields.push(match[1] !== undefined ? match[1].replace(/""/g, '"') :
+      match[2]);
+  }
+  return fields;
+}
+
+function median(values) {
+  const sorted = values.toSorted((a, b) => a - b);
+  const middle = sorted.length >> 1;
+  return sorted.length % 2 ?
+    sorted[middle] :
+    (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+function geometricMean(values) {
+  return Math.exp(values.reduce((sum, v) => sum + Math.log(v), 0) /
+                  values.length);
+}
+
+// Collect the rates of every configuration.
+const lines = fs.readFileSync(cli.items[0], 'utf8').split(/\r?\n/);
+const header = parseCsvLine(lines.shift());
+const columns = Object.fromEntries(header.map((name, i) => [name, i]));
+const samples = new Map();
+for (const line of lines) {
+  if (line === '') continue;
+  const fields = parseCsvLine(line);
+  const binary = fields[columns.binary];
+  const filename = fields[columns.filename];
+  const configuration = fields[columns.configuration];
+  const rate = +fields[columns.rate];
+  if (!Number.isFinite(rate) || rate <= 0) continue;
+
+  const key = `${filename}\0${configuration}`;
+  if (!samples.has(key)) {
+    samples.set(key, { filename, configuration, native: [], wasi: [] });
+  }
+  samples.get(key)[binary]?.push(rate);
+}
+
+// Compute the slowdowns and group them.
+const groups = new Map();
+for (const { filename, configuration, native, wasi } of samples.values()) {
+  if (native.length === 0 || wasi.length === 0) continue;
+  const slowdown = median(native) / median(wasi);
+  const name = by === 'file' ? filename : filename.split(/[\\/]/)[0];
+  if (!groups.has(name)) {
+    groups.set(name, { name, slowdowns: [], slowest: null });
+  }
+  const group = groups.get(name);
+  group.slowdowns.push(slowdown);
+  if (group.slowest === null || slowdown > group.slowest.slowdown) {
+    group.slowest = { filename, configuration, slowdown };
+  }
+}
+
+const ranking = [...groups.values()]
+  .map((group) => ({ ...group, slowdown: geometricMean(group.slowdowns) }))
+  .sort((a, b) => b.slowdown - a.slowdown);
+
+if (ranking.length === 0) {
+  console.error('No configurations with samples of both binaries found');
+  process.exitCode = 1;
+  return;
+}
+
+const rows = [[by, 'configurations', 'slowdown', 'slowest configuration']];
+for (const { name, slowdowns, slowdown, slowest } of ranking) {
+  rows.push([
+    name,
+    `${slowdowns.length}`,
+    `${slowdown.toFixed(2)}x`,
+    `${slowest.filename} ${slowest.configuration} ` +
+      `(${slowest.slowdown.toFixed(2)}x)`,
+  ]);
+}
+
+const widths = rows[0].map((_, i) => Math.max(...rows.map((r) => r[i].length)));
+for (const row of rows) {
+  console.log(row.map((cell, i) => {
+    if (i === row.length - 1) return cell;
+    return i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]);
+  }).join('  '));
+}
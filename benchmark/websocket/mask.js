@@ -0,0 +1,42 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  method: ['native', 'js'],
+  size: [16, 1024, 64 * 1024, 1024 * 1024],
+  // The amount of data that is masked, in MiB.
+  total: [256],
+}, {
+  flags: ['--expose-internals'],
+});
+
+// The 32-bit loop that WebSocket implementations in JavaScript use.
+function maskInJS(data, key) {
+  const length = data.length;
+  const words = length >> 2;
+  const view = new Int32Array(data.buffer, data.byteOffset, words);
+  const mask = new Int32Array(key.buffer, key.byteOffset, 1)[0];
+  for (let i = 0; i < words; i++) {
+    view[i] ^= mask;
+  }
+  for (let i = words << 2; i < length; i++) {
+    data[i] ^= key[i & 3];
+  }
+}
+
+function main({ method, size, total }) {
+  const mask = method === 'native' ?
+    common.binding('buffer').webSocketMask :
+    maskInJS;
+
+  const data = Buffer.alloc(size, 'a');
+  const key = new Uint8Array([0x37, 0xfa, 0x21, 0x3d]);
+  const iterations = Math.ceil(total * 1024 * 1024 / size);
+
+  bench.start();
+  for (let i = 0; i < iterations; i++) {
+    mask(data, key);
+  }
+  bench.end(iterations);
+}
@@ -0,0 +1,42 @@
+'use strict';
+const { join } = require('node:path');
+const common = require('../common.js');
+const tmpdir = require('../../test/common/tmpdir');
+
+tmpdir.refresh();
+
+const localStorageFile = join(tmpdir.path, 'write-back.localstorage');
+const options = {
+  flags: ['--experimental-webstorage',
+          '--localstorage-write-back',
+          `--localstorage-file=${localStorageFile}`],
+};
+
+const bench = common.createBenchmark(main, {
+  type: ['setItem', 'setter'],
+  // Note: web storage has only 10mb quota
+  n: [1e5],
+}, options);
+
+function main({ n, type }) {
+  const localStorage = globalThis.localStorage;
+
+  switch (type) {
+    case 'setItem':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        localStorage.setItem(i, i);
+      }
+      bench.end(n);
+      break;
+    case 'setter':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        localStorage[i] = i;
+      }
+      bench.end(n);
+      break;
+    default:
+      throw new Error('Invalid type');
+  }
+}
@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  size: [1024, 64 * 1024],
+  direction: ['read', 'write'],
+}, {
+  flags: ['--expose-internals', '--no-warnings'],
+});
+
+async function main({ n, size, direction }) {
+  const { internalBinding } = require('internal/test/binding');
+  const { JSStream } = internalBinding('js_stream');
+  const {
+    newReadableStreamFromStreamBase,
+    newWritableStreamFromStreamBase,
+  } = require('internal/webstreams/adapters');
+  const chunk = Buffer.alloc(size, 'a');
+  const stream = new JSStream();
+
+  if (direction === 'read') {
+    const reader = newReadableStreamFromStreamBase(stream)
+      .getReader({ mode: 'byob' });
+    let view = new Uint8Array(size);
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      const read = reader.read(view);
+      stream.readBuffer(chunk);
+      ({ value: view } = await read);
+    }
+    bench.end(n);
+  } else {
+    stream.onwrite = (req) => stream.finishWrite(req, 0);
+    const writer = newWritableStreamFromStreamBase(stream).getWriter();
+    bench.start();
+    for (let i = 0; i < n; i++)
+      await writer.write(chunk);
+    bench.end(n);
+  }
+}
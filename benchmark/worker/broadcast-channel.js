@@ -0,0 +1,55 @@
+'use strict';
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+const bench = common.createBenchmark(main, {
+  payload: ['string', 'object'],
+  workers: [1, 8, 32],
+  n: [1e4],
+});
+
+function main({ payload, workers, n }) {
+  let message;
+  switch (payload) {
+    case 'string':
+      message = 'hello world!';
+      break;
+    case 'object':
+      message = { action: 'invalidate', keys: ['a', 'b', 'c'], version: 1 };
+      break;
+    default:
+      throw new Error('Unsupported payload type');
+  }
+
+  const channel = new BroadcastChannel('benchmark');
+  const done = new BroadcastChannel('benchmark-done');
+  let ready = 0;
+  let finished = 0;
+  done.onmessage = ({ data }) => {
+    if (data === 'ready') {
+      if (++ready === workers) {
+        bench.start();
+        for (let i = 0; i < n; i++) channel.postMessage(message);
+        channel.postMessage('end');
+      }
+    } else if (++finished === workers) {
+      bench.end(n);
+      channel.close();
+      done.close();
+    }
+  };
+
+  for (let i = 0; i < workers; i++) {
+    new Worker(`
+      const channel = new BroadcastChannel('benchmark');
+      const done = new BroadcastChannel('benchmark-done');
+      channel.onmessage = ({ data }) => {
+        if (data !== 'end') return;
+        done.postMessage('finished');
+        channel.close();
+        done.close();
+      };
+      done.postMessage('ready');
+    `, { eval: true });
+  }
+}
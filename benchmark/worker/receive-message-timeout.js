@@ -0,0 +1,50 @@
+'use strict';
+
+const common = require('../common.js');
+const {
+  MessageChannel,
+  Worker,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  // Whether the worker answers from its event loop or blocks on the port, too.
+  responder: ['event', 'blocking'],
+  n: [1e5],
+});
+
+const workerSource = {
+  event: `
+    const { workerData: port } = require('worker_threads');
+    port.on('message', (message) => port.postMessage(message));
+  `,
+  blocking: `
+    const { workerData: port, receiveMessageOnPort } = require('worker_threads');
+    let received;
+    while ((received = receiveMessageOnPort(port, { timeout: Infinity })))
+      port.postMessage(received.message);
+  `,
+};
+
+function main({ responder, n }) {
+  const { port1, port2 } = new MessageChannel();
+  const worker = new Worker(workerSource[responder], {
+    eval: true,
+    workerData: port2,
+    transferList: [port2],
+  });
+
+  // Wait for the worker to start before measuring the round trips.
+  port1.postMessage(0);
+  receiveMessageOnPort(port1, { timeout: Infinity });
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    port1.postMessage(i);
+    receiveMessageOnPort(port1, { timeout: Infinity });
+  }
+  bench.end(n);
+
+  port1.close();
+  worker.unref();
+}
@@ -0,0 +1,19 @@
+'use strict';
+const common = require('../common.js');
+const { crc32 } = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  type: ['buffer', 'string'],
+  len: [16, 1024, 64 * 1024],
+  n: [1e5],
+});
+
+function main({ n, type, len }) {
+  const data = type === 'buffer' ? Buffer.alloc(len, 'a') : 'a'.repeat(len);
+
+  let crc = 0;
+  bench.start();
+  for (let i = 0; i < n; i++)
+    crc = crc32(data, crc);
+  bench.end(n);
+}
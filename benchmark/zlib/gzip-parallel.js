@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'gzipSync'],
+  parallelism: [1, 2, 4],
+  inputLen: [16 * 1024 * 1024],
+  n: [10],
+});
+
+function main({ n, method, parallelism, inputLen }) {
+  // Compressible, but not trivially so.
+  const input = Buffer.alloc(inputLen);
+  for (let i = 0; i < inputLen; i++)
+    input[i] = (i * 7 + (i >> 10)) % 61;
+  const options = { parallelism };
+
+  switch (method) {
+    case 'gzip': {
+      let i = 0;
+      bench.start();
+      (function next(err) {
+        if (err) throw err;
+        if (i++ === n)
+          return bench.end(n);
+        zlib.gzip(input, options, next);
+      })();
+      break;
+    }
+    case 'gzipSync': {
+      bench.start();
+      for (let i = 0; i < n; ++i)
+        zlib.gzipSync(input, options);
+      bench.end(n);
+      break;
+    }
+    default:
+      throw new Error('Unsupported gzip method');
+  }
+}
@@ -0,0 +1,26 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['deflateSync', 'inflateSync'],
+  output: ['none', 'buffer'],
+  inputLen: [256, 4096, 16384],
+  n: [1e5],
+});
+
+function main({ n, method, output, inputLen }) {
+  const data = Buffer.alloc(inputLen);
+  for (let i = 0; i < inputLen; i++)
+    data[i] = i % 7 === 0 ? i & 0xff : 97;
+  const input = method === 'deflateSync' ? data : zlib.deflateSync(data);
+  const options = output === 'buffer' ?
+    { output: Buffer.alloc(zlib.deflateBound(inputLen)) } :
+    undefined;
+  const fn = zlib[method];
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    fn(input, options);
+  bench.end(n);
+}
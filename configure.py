@@ -214,6 +214,14 @@ parser.add_argument("--enable-lto",
     help="Enable compiling with lto of a binary. This feature is only available "
          "with gcc 5.4.1+ or clang 3.9.1+.")
 
+parser.add_argument("--enable-wasm-simd128",
+    action="store_true",
+    dest="enable_wasm_simd128",
+    default=None,
+    help="Build the wasm simd128 code paths of llhttp and zlib. This only "
+         "has an effect when building for WASI, and the runtime must support "
+         "the simd128 proposal.")
+
 parser.add_argument("--link-module",
     action="append",
     dest="linked_module",
@@ -1579,6 +1587,8 @@ def configure_node(o):
 
   o['variables']['enable_lto'] = b(options.enable_lto)
 
+  o['variables']['wasm_simd128'] = 1 if options.enable_wasm_simd128 else 0
+
   if options.node_use_large_pages or options.node_use_large_pages_script_lld:
     warn('''The `--use-largepages` and `--use-largepages-script-lld` options
          have no effect during build time. Support for mapping to large pages is
@@ -4,7 +4,11 @@
       'src/llhttp.c',
       'src/api.c',
       'src/http.c',
-    ]
+    ],
+    # Build the wasm simd128 spans of the generated parser on WASI. Set by
+    # `configure --enable-wasm-simd128`. The runtime must support the simd128
+    # proposal.
+    'wasm_simd128%': 0,
   },
   'targets': [
     {
@@ -17,6 +21,11 @@
       'sources': [
         '<@(llhttp_sources)',
       ],
+      'conditions': [
+        ['OS=="wasi" and wasm_simd128==1', {
+          'cflags': [ '-msimd128' ],
+        }],
+      ],
     },
   ]
 }
@@ -60,6 +60,8 @@
 #include "cpu_features.h"
 #if defined(ADLER32_SIMD_SSSE3) || defined(ADLER32_SIMD_NEON) || defined(ADLER32_SIMD_RVV)
 #include "adler32_simd.h"
+#elif defined(ADLER32_SIMD_WASM) && defined(__wasm_simd128__)
+#include "adler32_simd.h"
 #endif
 
 /* ========================================================================= */
@@ -77,6 +79,10 @@ uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
     if (buf != Z_NULL && len >= 32 && riscv_cpu_enable_rvv)
 #endif
         return adler32_simd_(adler, buf, len);
+#elif defined(ADLER32_SIMD_WASM) && defined(__wasm_simd128__)
+    /* simd128 is a build-time feature of wasm, no runtime check needed. */
+    if (buf != Z_NULL && len >= 64)
+        return adler32_simd_(adler, buf, len);
 #endif
 
     /* split Adler-32 into component sums */
@@ -11,6 +11,10 @@
 
 /* SIMD implementations for Adler-32 checksums. */
 
+#define BASE 65521U     /* largest prime smaller than 65536 */
+#define NMAX 5552       /* NMAX is the largest n such that */
+                        /* 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+
 #ifdef ADLER32_SIMD_SSSE3
 #  if defined(__GNUC__) || defined(__clang__)
 #    define TARGET_CPU_WITH_SSSE3 __attribute__((target("ssse3")))
@@ -35,37 +39,455 @@
 #  endif
 #endif
 
-/* Disable SIMD for WASI */
+/*
+ * WASI targets have no runtime CPU detection: only the wasm simd128 variant
+ * can be used there, selected at build time with -msimd128.
+ */
 #ifdef __wasi__
 #undef ADLER32_SIMD_SSSE3
 #undef ADLER32_SIMD_NEON
 #undef ADLER32_SIMD_RVV
+#if !defined(__wasm_simd128__)
+#undef ADLER32_SIMD_WASM
+#endif
+#else
+#undef ADLER32_SIMD_WASM
 #endif
 
-#if defined(ADLER32_SIMD_SSSE3) && !defined(__wasi__)
+#if defined(ADLER32_SIMD_SSSE3)
 
 #include <tmmintrin.h>
 
+TARGET_CPU_WITH_SSSE3
 uint32_t ZLIB_INTERNAL adler32_simd_(  /* SSSE3 */
     uint32_t adler,
     const unsigned char *buf,
     z_size_t len)
 {
-    /* SIMD implementation would go here for non-WASI builds */
-    return adler32_z(adler, buf, len);
+    /*
+     * Split Adler-32 into component sums.
+     */
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+
+    /*
+     * Process the data in blocks.
+     */
+    const unsigned BLOCK_SIZE = 1 << 5;
+
+    z_size_t blocks = len / BLOCK_SIZE;
+    len -= blocks * BLOCK_SIZE;
+
+    while (blocks)
+    {
+        unsigned n = NMAX / BLOCK_SIZE;  /* The NMAX constraint. */
+        if (n > blocks)
+            n = (unsigned) blocks;
+        blocks -= n;
+
+        const __m128i tap1 =
+            _mm_setr_epi8(32,31,30,29,28,27,26,25,24,23,22,21,20,19,18,17);
+        const __m128i tap2 =
+            _mm_setr_epi8(16,15,14,13,12,11,10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        const __m128i zero =
+            _mm_setr_epi8( 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i ones =
+            _mm_set_epi16( 1, 1, 1, 1, 1, 1, 1, 1);
+
+        /*
+         * Process n blocks of data. At most NMAX data bytes can be
+         * processed before s2 must be reduced modulo BASE.
+         */
+        __m128i v_ps = _mm_set_epi32(0, 0, 0, s1 * n);
+        __m128i v_s2 = _mm_set_epi32(0, 0, 0, s2);
+        __m128i v_s1 = _mm_set_epi32(0, 0, 0, 0);
+
+        do {
+            /*
+             * Load 32 input bytes.
+             */
+            const __m128i bytes1 = _mm_loadu_si128((__m128i*)(buf));
+            const __m128i bytes2 = _mm_loadu_si128((__m128i*)(buf + 16));
+
+            /*
+             * Add previous block byte sum to v_ps.
+             */
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+
+            /*
+             * Horizontally add the bytes for s1, multiply-adds the
+             * bytes by [ 32, 31, 30, ... ] for s2.
+             */
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            const __m128i mad1 = _mm_maddubs_epi16(bytes1, tap1);
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(mad1, ones));
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            const __m128i mad2 = _mm_maddubs_epi16(bytes2, tap2);
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(mad2, ones));
+
+            buf += BLOCK_SIZE;
+
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /*
+         * Sum epi32 ints v_s1(s2) and accumulate in s1(s2).
+         */
+
+#define S23O1 _MM_SHUFFLE(2,3,0,1)  /* A B C D -> B A D C */
+#define S1O32 _MM_SHUFFLE(1,0,3,2)  /* A B C D -> C D A B */
+
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, S1O32));
+
+        s1 += _mm_cvtsi128_si32(v_s1);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, S23O1));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, S1O32));
+
+        s2 = _mm_cvtsi128_si32(v_s2);
+
+#undef S23O1
+#undef S1O32
+
+        /*
+         * Reduce.
+         */
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Handle leftover data.
+     */
+    if (len) {
+        if (len >= 16) {
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            len -= 16;
+        }
+
+        while (len--) {
+            s2 += (s1 += *buf++);
+        }
+
+        if (s1 >= BASE)
+            s1 -= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Return the recombined sums.
+     */
+    return s1 | (s2 << 16);
 }
 
-#else
+#elif defined(ADLER32_SIMD_NEON)
 
-/* Fallback implementation for WASI and other platforms */
-uint32_t ZLIB_INTERNAL adler32_simd_(
+#include <arm_neon.h>
+
+uint32_t ZLIB_INTERNAL adler32_simd_(  /* NEON */
     uint32_t adler,
     const unsigned char *buf,
     z_size_t len)
 {
-    /* WASI doesn't support SIMD, so return the original adler value
-     * The main adler32 function will handle the computation */
-    return adler32_z(adler, buf, len);
+    /*
+     * Split Adler-32 into component sums.
+     */
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+
+    /*
+     * Serially compute s1 & s2, until the data is 16-byte aligned.
+     */
+    if ((uintptr_t)buf & 15) {
+        while ((uintptr_t)buf & 15) {
+            s2 += (s1 += *buf++);
+            --len;
+        }
+
+        if (s1 >= BASE)
+            s1 -= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Process the data in blocks.
+     */
+    const unsigned BLOCK_SIZE = 1 << 5;
+
+    z_size_t blocks = len / BLOCK_SIZE;
+    len -= blocks * BLOCK_SIZE;
+
+    while (blocks)
+    {
+        unsigned n = NMAX / BLOCK_SIZE;  /* The NMAX constraint. */
+        if (n > blocks)
+            n = (unsigned) blocks;
+        blocks -= n;
+
+        /*
+         * Process n blocks of data. At most NMAX data bytes can be
+         * processed before s2 must be reduced modulo BASE.
+         */
+        uint32x4_t v_s2 = (uint32x4_t) { 0, 0, 0, s1 * n };
+        uint32x4_t v_s1 = (uint32x4_t) { 0, 0, 0, 0 };
+
+        uint16x8_t v_column_sum_1 = vdupq_n_u16(0);
+        uint16x8_t v_column_sum_2 = vdupq_n_u16(0);
+        uint16x8_t v_column_sum_3 = vdupq_n_u16(0);
+        uint16x8_t v_column_sum_4 = vdupq_n_u16(0);
+
+        do {
+            /*
+             * Load 32 input bytes.
+             */
+            const uint8x16_t bytes1 = vld1q_u8((uint8_t*)(buf));
+            const uint8x16_t bytes2 = vld1q_u8((uint8_t*)(buf + 16));
+
+            /*
+             * Add previous block byte sum to v_s2.
+             */
+            v_s2 = vaddq_u32(v_s2, v_s1);
+
+            /*
+             * Horizontally add the bytes for s1.
+             */
+            v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+
+            /*
+             * Vertically add the bytes for s2.
+             */
+            v_column_sum_1 = vaddw_u8(v_column_sum_1, vget_low_u8 (bytes1));
+            v_column_sum_2 = vaddw_u8(v_column_sum_2, vget_high_u8(bytes1));
+            v_column_sum_3 = vaddw_u8(v_column_sum_3, vget_low_u8 (bytes2));
+            v_column_sum_4 = vaddw_u8(v_column_sum_4, vget_high_u8(bytes2));
+
+            buf += BLOCK_SIZE;
+
+        } while (--n);
+
+        v_s2 = vshlq_n_u32(v_s2, 5);
+
+        /*
+         * Multiply-add bytes by [ 32, 31, 30, ... ] for s2.
+         */
+        v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_column_sum_1),
+            (uint16x4_t) { 32, 31, 30, 29 });
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_column_sum_1),
+            (uint16x4_t) { 28, 27, 26, 25 });
+        v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_column_sum_2),
+            (uint16x4_t) { 24, 23, 22, 21 });
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_column_sum_2),
+            (uint16x4_t) { 20, 19, 18, 17 });
+        v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_column_sum_3),
+            (uint16x4_t) { 16, 15, 14, 13 });
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_column_sum_3),
+            (uint16x4_t) { 12, 11, 10,  9 });
+        v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_column_sum_4),
+            (uint16x4_t) {  8,  7,  6,  5 });
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_column_sum_4),
+            (uint16x4_t) {  4,  3,  2,  1 });
+
+        /*
+         * Sum epi32 ints v_s1(s2) and accumulate in s1(s2).
+         */
+        uint32x2_t sum1 = vpadd_u32(vget_low_u32(v_s1), vget_high_u32(v_s1));
+        uint32x2_t sum2 = vpadd_u32(vget_low_u32(v_s2), vget_high_u32(v_s2));
+        uint32x2_t s1s2 = vpadd_u32(sum1, sum2);
+
+        s1 += vget_lane_u32(s1s2, 0);
+        s2 += vget_lane_u32(s1s2, 1);
+
+        /*
+         * Reduce.
+         */
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Handle leftover data.
+     */
+    if (len) {
+        if (len >= 16) {
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+            s2 += (s1 += *buf++);
+
+            len -= 16;
+        }
+
+        while (len--) {
+            s2 += (s1 += *buf++);
+        }
+
+        if (s1 >= BASE)
+            s1 -= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Return the recombined sums.
+     */
+    return s1 | (s2 << 16);
+}
+
+#elif defined(ADLER32_SIMD_WASM)
+
+#include <wasm_simd128.h>
+
+uint32_t ZLIB_INTERNAL adler32_simd_(  /* wasm simd128 */
+    uint32_t adler,
+    const unsigned char *buf,
+    z_size_t len)
+{
+    /*
+     * Split Adler-32 into component sums.
+     */
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+
+    /*
+     * Process the data in blocks.
+     */
+    const unsigned BLOCK_SIZE = 1 << 5;
+
+    z_size_t blocks = len / BLOCK_SIZE;
+    len -= blocks * BLOCK_SIZE;
+
+    /*
+     * There is no unsigned 8-bit multiply-add in simd128: the bytes are
+     * widened to 16 bits and multiplied with a signed 16-bit dot product,
+     * which is exact since both the bytes and the taps are small.
+     */
+    const v128_t tap1 = wasm_i16x8_make(32, 31, 30, 29, 28, 27, 26, 25);
+    const v128_t tap2 = wasm_i16x8_make(24, 23, 22, 21, 20, 19, 18, 17);
+    const v128_t tap3 = wasm_i16x8_make(16, 15, 14, 13, 12, 11, 10,  9);
+    const v128_t tap4 = wasm_i16x8_make( 8,  7,  6,  5,  4,  3,  2,  1);
+
+    while (blocks)
+    {
+        unsigned n = NMAX / BLOCK_SIZE;  /* The NMAX constraint. */
+        if (n > blocks)
+            n = (unsigned) blocks;
+        blocks -= n;
+
+        /*
+         * Process n blocks of data. At most NMAX data bytes can be
+         * processed before s2 must be reduced modulo BASE.
+         */
+        v128_t v_ps = wasm_i32x4_make(0, 0, 0, (int32_t)(s1 * n));
+        v128_t v_s2 = wasm_i32x4_make(0, 0, 0, (int32_t)s2);
+        v128_t v_s1 = wasm_i32x4_splat(0);
+
+        do {
+            /*
+             * Load 32 input bytes.
+             */
+            const v128_t bytes1 = wasm_v128_load(buf);
+            const v128_t bytes2 = wasm_v128_load(buf + 16);
+
+            /*
+             * Add previous block byte sum to v_ps.
+             */
+            v_ps = wasm_i32x4_add(v_ps, v_s1);
+
+            /*
+             * Horizontally add the bytes for s1.
+             */
+            v_s1 = wasm_i32x4_add(v_s1, wasm_u32x4_extadd_pairwise_u16x8(
+                wasm_u16x8_extadd_pairwise_u8x16(bytes1)));
+            v_s1 = wasm_i32x4_add(v_s1, wasm_u32x4_extadd_pairwise_u16x8(
+                wasm_u16x8_extadd_pairwise_u8x16(bytes2)));
+
+            /*
+             * Multiply-add bytes by [ 32, 31, 30, ... ] for s2.
+             */
+            v_s2 = wasm_i32x4_add(v_s2, wasm_i32x4_dot_i16x8(
+                wasm_u16x8_extend_low_u8x16(bytes1), tap1));
+            v_s2 = wasm_i32x4_add(v_s2, wasm_i32x4_dot_i16x8(
+                wasm_u16x8_extend_high_u8x16(bytes1), tap2));
+            v_s2 = wasm_i32x4_add(v_s2, wasm_i32x4_dot_i16x8(
+                wasm_u16x8_extend_low_u8x16(bytes2), tap3));
+            v_s2 = wasm_i32x4_add(v_s2, wasm_i32x4_dot_i16x8(
+                wasm_u16x8_extend_high_u8x16(bytes2), tap4));
+
+            buf += BLOCK_SIZE;
+
+        } while (--n);
+
+        v_s2 = wasm_i32x4_add(v_s2, wasm_i32x4_shl(v_ps, 5));
+
+        /*
+         * Sum i32 lanes v_s1(s2) and accumulate in s1(s2).
+         */
+        s1 += (uint32_t)wasm_i32x4_extract_lane(v_s1, 0) +
+              (uint32_t)wasm_i32x4_extract_lane(v_s1, 1) +
+              (uint32_t)wasm_i32x4_extract_lane(v_s1, 2) +
+              (uint32_t)wasm_i32x4_extract_lane(v_s1, 3);
+        s2 = (uint32_t)wasm_i32x4_extract_lane(v_s2, 0) +
+             (uint32_t)wasm_i32x4_extract_lane(v_s2, 1) +
+             (uint32_t)wasm_i32x4_extract_lane(v_s2, 2) +
+             (uint32_t)wasm_i32x4_extract_lane(v_s2, 3);
+
+        /*
+         * Reduce.
+         */
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Handle leftover data.
+     */
+    while (len--) {
+        s2 += (s1 += *buf++);
+    }
+
+    if (s1 >= BASE)
+        s1 -= BASE;
+    s2 %= BASE;
+
+    /*
+     * Return the recombined sums.
+     */
+    return s1 | (s2 << 16);
 }
 
-#endif
\ No newline at end of file
+#endif  /* ADLER32_SIMD_SSSE3 */
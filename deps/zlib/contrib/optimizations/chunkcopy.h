@@ -26,15 +26,35 @@
 #define Z_BUILTIN_MEMCPY zmemcpy
 #define Z_BUILTIN_MEMSET zmemset
 #endif
+
+/*
+ * WASI builds can only use the wasm simd128 instructions, and only when the
+ * compiler targets them (-msimd128). Any other build that was not configured
+ * with a chunk copy implementation uses the portable one.
+ */
+#if defined(__wasi__)
+#undef INFLATE_CHUNK_SIMD_NEON
 #undef INFLATE_CHUNK_SIMD_SSE2
+#if !defined(__wasm_simd128__)
+#undef INFLATE_CHUNK_SIMD_WASM
+#endif
+#else
+#undef INFLATE_CHUNK_SIMD_WASM
+#endif
+#if !defined(INFLATE_CHUNK_SIMD_NEON) && !defined(INFLATE_CHUNK_SIMD_SSE2) && \
+    !defined(INFLATE_CHUNK_SIMD_WASM) && !defined(INFLATE_CHUNK_GENERIC)
 #define INFLATE_CHUNK_GENERIC
-/* NEON-accelerated version for ARM systems */
-#if 0 && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#endif
+
+#if defined(INFLATE_CHUNK_SIMD_NEON)
 #include <arm_neon.h>
 typedef uint8x16_t z_vec128i_t;
 #elif defined(INFLATE_CHUNK_SIMD_SSE2)
 #include <emmintrin.h>
 typedef __m128i z_vec128i_t;
+#elif defined(INFLATE_CHUNK_SIMD_WASM)
+#include <wasm_simd128.h>
+typedef v128_t z_vec128i_t;
 #elif defined(INFLATE_CHUNK_GENERIC)
 typedef struct {
   uint8_t x[16];
@@ -177,7 +197,7 @@ static inline unsigned char FAR* chunkunroll_relaxed(unsigned char FAR* out,
   }
   return out;
 }
-#undef INFLATE_CHUNK_SIMD_NEON
+
 #if defined(INFLATE_CHUNK_SIMD_NEON)
 /*
  * v_load64_dup(): load *src as an unaligned 64-bit int and duplicate it in
@@ -269,6 +289,46 @@ static inline z_vec128i_t v_load8_dup(const void* src) {
 static inline void v_store_128(void* out, const z_vec128i_t vec) {
   _mm_storeu_si128((__m128i*)out, vec);
 }
+#elif defined(INFLATE_CHUNK_SIMD_WASM)
+/*
+ * v_load64_dup(): load *src as an unaligned 64-bit int and duplicate it in
+ * every 64-bit component of the 128-bit result (64-bit int splat).
+ */
+static inline z_vec128i_t v_load64_dup(const void* src) {
+  return wasm_v128_load64_splat(src);
+}
+
+/*
+ * v_load32_dup(): load *src as an unaligned 32-bit int and duplicate it in
+ * every 32-bit component of the 128-bit result (32-bit int splat).
+ */
+static inline z_vec128i_t v_load32_dup(const void* src) {
+  return wasm_v128_load32_splat(src);
+}
+
+/*
+ * v_load16_dup(): load *src as an unaligned 16-bit int and duplicate it in
+ * every 16-bit component of the 128-bit result (16-bit int splat).
+ */
+static inline z_vec128i_t v_load16_dup(const void* src) {
+  return wasm_v128_load16_splat(src);
+}
+
+/*
+ * v_load8_dup(): load the 8-bit int *src and duplicate it in every 8-bit
+ * component of the 128-bit result (8-bit int splat).
+ */
+static inline z_vec128i_t v_load8_dup(const void* src) {
+  return wasm_v128_load8_splat(src);
+}
+
+/*
+ * v_store_128(): store the 128-bit vec in a memory destination (that might
+ * not be 16-byte aligned) void* out.
+ */
+static inline void v_store_128(void* out, const z_vec128i_t vec) {
+  wasm_v128_store(out, vec);
+}
 #elif defined(INFLATE_CHUNK_GENERIC)
 /*
  * Default implementations for chunk-copy functions rely on memcpy() being
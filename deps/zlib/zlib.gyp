@@ -7,6 +7,10 @@
         "ZLIB_ROOT": ".",
         "use_system_zlib%": 0,
         "arm_fpu%": "",
+        # Build the wasm simd128 variants of the adler32 and inflate chunk
+        # copy code on WASI. Set by `configure --enable-wasm-simd128`. The
+        # runtime must support the simd128 proposal.
+        "wasm_simd128%": 0,
     },
     "conditions": [
         [
@@ -45,6 +49,13 @@
                                     "defines": ["ADLER32_SIMD_NEON"],
                                 },
                             ],
+                            [
+                                'OS=="wasi" and wasm_simd128==1',
+                                {
+                                    "cflags": ["-msimd128"],
+                                    "defines": ["ADLER32_SIMD_WASM"],
+                                },
+                            ],
                         ],
                         "include_dirs": ["<(ZLIB_ROOT)"],
                         "direct_dependent_settings": {
@@ -72,6 +83,12 @@
                                         "defines": ["ADLER32_SIMD_NEON"],
                                     },
                                 ],
+                                [
+                                    'OS=="wasi" and wasm_simd128==1',
+                                    {
+                                        "defines": ["ADLER32_SIMD_WASM"],
+                                    },
+                                ],
                             ],
                             "include_dirs": ["<(ZLIB_ROOT)"],
                         },
@@ -216,6 +233,13 @@
                                     ],
                                 },
                             ],
+                            [
+                                'OS=="wasi" and wasm_simd128==1',
+                                {
+                                    "cflags": ["-msimd128"],
+                                    "defines": ["INFLATE_CHUNK_SIMD_WASM"],
+                                },
+                            ],
                         ],
                         "include_dirs": ["<(ZLIB_ROOT)"],
                         "direct_dependent_settings": {
@@ -232,6 +256,12 @@
                                         "defines": ["INFLATE_CHUNK_SIMD_NEON"],
                                     },
                                 ],
+                                [
+                                    'OS=="wasi" and wasm_simd128==1',
+                                    {
+                                        "defines": ["INFLATE_CHUNK_SIMD_WASM"],
+                                    },
+                                ],
                             ],
                             "include_dirs": ["<(ZLIB_ROOT)"],
                         },
@@ -271,13 +301,27 @@
                             [
                                 'OS=="wasi"',
                                 {
-                                    # WASI doesn't support SIMD optimizations
+                                    # WASI has no runtime CPU feature detection,
+                                    # the simd128 variants are chosen at build
+                                    # time instead.
                                     "defines": ["CPU_NO_SIMD", "USE_FILE32API"],
+                                    "conditions": [
+                                        [
+                                            'wasm_simd128==1',
+                                            {
+                                                "cflags": ["-msimd128"],
+                                                "dependencies": [
+                                                    "zlib_adler32_simd",
+                                                ],
+                                            },
+                                        ],
+                                    ],
                                 },
                             ],
                             # Incorporate optimizations where possible.
                             [
-                                '((target_arch in "ia32 x64" and OS!="ios") or arm_fpu=="neon") and OS!="wasi"',
+                                '((target_arch in "ia32 x64" and OS!="ios") or arm_fpu=="neon") and OS!="wasi" or '
+                                '(OS=="wasi" and wasm_simd128==1)',
                                 {
                                     "dependencies": ["zlib_data_chunk_simd"],
                                     "sources": ["<(ZLIB_ROOT)/slide_hash_simd.h"],
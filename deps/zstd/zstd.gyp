@@ -58,6 +58,12 @@
       'lib/decompress/zstd_ddict.c',
       'lib/decompress/zstd_decompress.c',
       'lib/decompress/zstd_decompress_block.c',
+
+      # cxx_library(name='zdict')
+      'lib/dictBuilder/cover.c',
+      'lib/dictBuilder/divsufsort.c',
+      'lib/dictBuilder/fastcover.c',
+      'lib/dictBuilder/zdict.c',
     ],
   },
   'targets': [
@@ -22,6 +22,7 @@
 'use strict';
 
 const {
+  ArrayIsArray,
   MathMin,
   Symbol,
 } = primordials;
@@ -37,6 +38,7 @@ const {
   IncomingMessage,
   readStart,
   readStop,
+  setFlatHeaders,
 } = incoming;
 
 const kIncomingMessage = Symbol('IncomingMessage');
@@ -65,7 +67,8 @@ function parserOnHeaders(headers, url) {
 }
 
 // `headers` and `url` are set only if .onHeaders() has not been called for
-// this request.
+// this request. `headers` is a Uint32Array instead of an array of strings if
+// the parser was initialized with `flatHeaders`, see setFlatHeaders().
 // `url` is not set for response parsers but that's not applicable here since
 // all our parsers are request parsers.
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
@@ -97,13 +100,17 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   incoming.url = url;
   incoming.upgrade = upgrade;
 
-  let n = headers.length;
+  if (ArrayIsArray(headers)) {
+    let n = headers.length;
 
-  // If parser.maxHeaderPairs <= 0 assume that there's no limit.
-  if (parser.maxHeaderPairs > 0)
-    n = MathMin(n, parser.maxHeaderPairs);
+    // If parser.maxHeaderPairs <= 0 assume that there's no limit.
+    if (parser.maxHeaderPairs > 0)
+      n = MathMin(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+    incoming._addHeaderLines(headers, n);
+  } else {
+    setFlatHeaders(incoming, headers, parser.maxHeaderPairs);
+  }
 
   if (typeof method === 'number') {
     // server only
@@ -22,16 +22,27 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
+  StringPrototypeToLowerCase,
   Symbol,
 } = primordials;
 
 const { Readable, finished } = require('stream');
+const { FastBuffer } = require('internal/buffer');
+const {
+  HTTPParser: { kCommonHeaderFlag },
+  commonHeaders,
+} = internalBinding('http_parser');
+const commonHeadersLowerCase =
+  ArrayPrototypeMap(commonHeaders, (name) => StringPrototypeToLowerCase(name));
 
 const kHeaders = Symbol('kHeaders');
 const kHeadersDistinct = Symbol('kHeadersDistinct');
 const kHeadersCount = Symbol('kHeadersCount');
+const kRawHeaders = Symbol('kRawHeaders');
+const kFlatHeaders = Symbol('kFlatHeaders');
 const kTrailers = Symbol('kTrailers');
 const kTrailersDistinct = Symbol('kTrailersDistinct');
 const kTrailersCount = Symbol('kTrailersCount');
@@ -68,7 +79,8 @@ function IncomingMessage(socket) {
   this.complete = false;
   this[kHeaders] = null;
   this[kHeadersCount] = 0;
-  this.rawHeaders = [];
+  this[kRawHeaders] = [];
+  this[kFlatHeaders] = null;
   this[kTrailers] = null;
   this[kTrailersCount] = 0;
   this.rawTrailers = [];
@@ -104,6 +116,21 @@ ObjectDefineProperty(IncomingMessage.prototype, 'connection', {
   },
 });
 
+ObjectDefineProperty(IncomingMessage.prototype, 'rawHeaders', {
+  __proto__: null,
+  get: function() {
+    if (this[kFlatHeaders] !== null) {
+      this[kRawHeaders] = createHeaderStrings(this[kFlatHeaders]);
+      this[kFlatHeaders] = null;
+    }
+    return this[kRawHeaders];
+  },
+  set: function(val) {
+    this[kRawHeaders] = val;
+    this[kFlatHeaders] = null;
+  },
+});
+
 ObjectDefineProperty(IncomingMessage.prototype, 'headers', {
   __proto__: null,
   get: function() {
@@ -263,6 +290,64 @@ function _addHeaderLines(headers, n) {
 }
 
 
+// Headers delivered by a parser that was initialized with `flatHeaders`
+// arrive as a Uint32Array of the offsets at which each field and value ends
+// in the Latin-1 buffer that precedes the offsets in the same ArrayBuffer.
+// Fields that are one of `commonHeaders` are not in the buffer, their offset
+// is `kCommonHeaderFlag` plus their index instead. The strings are only
+// created once `rawHeaders` or `headers` is accessed.
+function setFlatHeaders(message, offsets, maxHeaderPairs) {
+  let n = offsets.length;
+  // If maxHeaderPairs <= 0 assume that there's no limit.
+  if (maxHeaderPairs > 0 && n > maxHeaderPairs)
+    n = maxHeaderPairs;
+  message[kRawHeaders] = null;
+  message[kFlatHeaders] = offsets;
+  message[kHeadersCount] = n;
+}
+
+function createHeaderStrings(offsets) {
+  const buffer = new FastBuffer(offsets.buffer, 0, offsets.byteOffset);
+  const headers = new Array(offsets.length);
+  let start = 0;
+  for (let i = 0; i < offsets.length; i++) {
+    const end = offsets[i];
+    if (end >= kCommonHeaderFlag) {
+      headers[i] = commonHeaders[end - kCommonHeaderFlag];
+    } else {
+      headers[i] = buffer.latin1Slice(start, end);
+      start = end;
+    }
+  }
+  return headers;
+}
+
+// Returns whether the message has a header named `name`, which must be lower
+// case, without creating the header strings of flat headers.
+function hasHeader(message, name) {
+  const offsets = message[kFlatHeaders];
+  if (!offsets)
+    return message.headers[name] !== undefined;
+
+  let buffer;
+  let start = 0;
+  for (let i = 0; i < message[kHeadersCount]; i++) {
+    const end = offsets[i];
+    if (end >= kCommonHeaderFlag) {
+      if (commonHeadersLowerCase[end - kCommonHeaderFlag] === name)
+        return true;
+      continue;
+    }
+    if (i % 2 === 0 && end - start === name.length) {
+      buffer ??= new FastBuffer(offsets.buffer, 0, offsets.byteOffset);
+      if (StringPrototypeToLowerCase(buffer.latin1Slice(start, end)) === name)
+        return true;
+    }
+    start = end;
+  }
+  return false;
+}
+
 // This function is used to help avoid the lowercasing of a field name if it
 // matches a 'traditional cased' version of a field name. It then returns the
 // lowercased name to both avoid calling toLowerCase() a second time and to
@@ -448,6 +533,8 @@ function onError(self, error, cb) {
 
 module.exports = {
   IncomingMessage,
+  hasHeader,
   readStart,
   readStop,
+  setFlatHeaders,
 };
@@ -32,6 +32,7 @@ const {
   ObjectValues,
   SafeSet,
   Symbol,
+  Uint32Array,
 } = primordials;
 
 const { getDefaultHighWaterMark } = require('internal/streams/state');
@@ -70,6 +71,7 @@ const {
   hideStackFrames,
 } = require('internal/errors');
 const { validateString } = require('internal/validators');
+const { serializeHeaders } = internalBinding('http_serializer');
 const { assignFunctionName } = require('internal/util');
 const { isUint8Array } = require('internal/util/types');
 
@@ -278,8 +280,7 @@ OutgoingMessage.prototype.uncork = function uncork() {
   assert(this.chunkedEncoding);
 
   let callbacks;
-  this._send(len.toString(16), 'latin1', null);
-  this._send(crlf_buf, null, null);
+  this._send(len.toString(16) + '\r\n', 'latin1', null);
   for (let n = 0; n < buf.length; n += 3) {
     this._send(buf[n + 0], buf[n + 1], null);
     if (buf[n + 2]) {
@@ -407,7 +408,7 @@ function _storeHeader(firstLine, headers) {
     header: firstLine,
   };
 
-  if (headers) {
+  if (headers && !storeHeadersFast(this, state, headers)) {
     if (headers === this[kOutHeaders]) {
       for (const key in headers) {
         const entry = headers[key];
@@ -530,6 +531,91 @@ function _storeHeader(firstLine, headers) {
   if (state.expect) this._send('');
 }
 
+// Room for the count and the indices of the headers that matchHeader() has
+// to see, which are rarely more than a handful.
+const kMaxSpecialHeaders = 32;
+const specialHeaders = new Uint32Array(1 + kMaxSpecialHeaders);
+
+// Stores the headers through the native serializer, which validates and joins
+// them in one pass. Returns false, without having changed anything, if the
+// headers are not all plain strings (or numbers) or if any of them is invalid,
+// in which case processHeader() handles them and throws the usual errors.
+function storeHeadersFast(self, state, headers) {
+  const flat = [];
+  let validate = true;
+  if (headers === self[kOutHeaders]) {
+    validate = false;
+    for (const key in headers) {
+      const entry = headers[key];
+      if (!flattenHeader(self, flat, entry[0], entry[1]))
+        return false;
+    }
+  } else if (ArrayIsArray(headers)) {
+    if (headers.length && ArrayIsArray(headers[0])) {
+      for (let i = 0; i < headers.length; i++) {
+        const entry = headers[i];
+        if (!flattenHeader(self, flat, entry[0], entry[1]))
+          return false;
+      }
+    } else {
+      if (headers.length % 2 !== 0)
+        return false;
+      for (let n = 0; n < headers.length; n += 2) {
+        if (!flattenHeader(self, flat, headers[n], headers[n + 1]))
+          return false;
+      }
+    }
+  } else {
+    for (const key in headers) {
+      if (ObjectHasOwn(headers, key) &&
+          !flattenHeader(self, flat, key, headers[key])) {
+        return false;
+      }
+    }
+  }
+
+  const serialized = serializeHeaders(flat, validate, specialHeaders);
+  if (serialized === undefined)
+    return false;
+  state.header += serialized;
+  for (let i = 1; i <= specialHeaders[0]; i++) {
+    const n = specialHeaders[i];
+    matchHeader(self, state, flat[n], flat[n + 1]);
+  }
+  return true;
+}
+
+// Mirrors processHeader() for the fast path, without validating.
+function flattenHeader(self, flat, key, value) {
+  if (typeof key !== 'string' ||
+      (isContentDispositionField(key) && self._contentLength)) {
+    return false;
+  }
+  if (ArrayIsArray(value)) {
+    if (
+      (value.length < 2 || !isCookieField(key)) &&
+      (!self[kUniqueHeaders] || !self[kUniqueHeaders].has(key.toLowerCase()))
+    ) {
+      for (let i = 0; i < value.length; i++) {
+        if (!flattenHeaderValue(flat, key, value[i]))
+          return false;
+      }
+      return true;
+    }
+    value = value.join('; ');
+  }
+  return flattenHeaderValue(flat, key, value);
+}
+
+function flattenHeaderValue(flat, key, value) {
+  if (typeof value === 'number')
+    value = `${value}`;
+  else if (typeof value !== 'string')
+    return false;
+  flat.push(key, value);
+  return true;
+}
+
 function processHeader(self, state, key, value, validate) {
   if (validate)
     validateHeaderName(key);
@@ -956,8 +1042,7 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
       msg[kChunkedLength] += len;
       ret = msg[kChunkedLength] < msg[kHighWaterMark];
     } else {
-      msg._send(len.toString(16), 'latin1', null);
-      msg._send(crlf_buf, null, null);
+      msg._send(len.toString(16) + '\r\n', 'latin1', null);
       msg._send(chunk, encoding, null, len);
       ret = msg._send(crlf_buf, null, callback);
     }
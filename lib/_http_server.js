@@ -65,7 +65,7 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId,
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const { IncomingMessage, hasHeader } = require('_http_incoming');
 const {
   ConnResetException,
   codes: {
@@ -100,6 +100,7 @@ const dc = require('diagnostics_channel');
 const onRequestStartChannel = dc.channel('http.server.request.start');
 const onResponseCreatedChannel = dc.channel('http.server.response.created');
 const onResponseFinishChannel = dc.channel('http.server.response.finish');
+const onConnectionsCheckChannel = dc.channel('http.server.connections.check');
 
 const kServerResponse = Symbol('ServerResponse');
 const kServerResponseStatistics = Symbol('ServerResponseStatistics');
@@ -109,6 +110,7 @@ const {
   startPerf,
   stopPerf,
 } = require('internal/perf/observe');
+const { now } = require('internal/perf/utils');
 
 const STATUS_CODES = {
   100: 'Continue',                   // RFC 7231 6.2.1
@@ -506,6 +508,14 @@ function storeHTTPOptions(options) {
   }
   this.joinDuplicateHeaders = joinDuplicateHeaders;
 
+  const lazyHeaders = options.lazyHeaders;
+  if (lazyHeaders !== undefined) {
+    validateBoolean(lazyHeaders, 'options.lazyHeaders');
+    this.lazyHeaders = lazyHeaders;
+  } else {
+    this.lazyHeaders = false;
+  }
+
   const rejectNonStandardBodyWrites = options.rejectNonStandardBodyWrites;
   if (rejectNonStandardBodyWrites !== undefined) {
     validateBoolean(rejectNonStandardBodyWrites, 'options.rejectNonStandardBodyWrites');
@@ -551,7 +561,8 @@ function Server(options, requestListener) {
     { allowHalfOpen: true, noDelay: options.noDelay ?? true,
       keepAlive: options.keepAlive,
       keepAliveInitialDelay: options.keepAliveInitialDelay,
-      highWaterMark: options.highWaterMark });
+      highWaterMark: options.highWaterMark,
+      connectionRateLimit: options.connectionRateLimit });
 
   if (requestListener) {
     this.on('request', requestListener);
@@ -648,8 +659,17 @@ function checkConnections() {
     return;
   }
 
+  const start = onConnectionsCheckChannel.hasSubscribers ? now() : 0;
   const expired = this[kConnections].expired(this.headersTimeout, this.requestTimeout);
 
+  if (onConnectionsCheckChannel.hasSubscribers) {
+    onConnectionsCheckChannel.publish({
+      server: this,
+      expired: expired.length,
+      duration: now() - start,
+    });
+  }
+
   for (let i = 0; i < expired.length; i++) {
     const socket = expired[i].socket;
 
@@ -693,6 +713,7 @@ function connectionListenerInternal(server, socket) {
     server.maxHeaderSize || 0,
     lenient ? kLenientAll : kLenientNone,
     server[kConnections],
+    server.lazyHeaders === true,
   );
   parser.socket = socket;
   socket.parser = parser;
@@ -1108,7 +1129,7 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
     // From RFC 7230 5.4 https://datatracker.ietf.org/doc/html/rfc7230#section-5.4
     // A server MUST respond with a 400 (Bad Request) status code to any
     // HTTP/1.1 request message that lacks a Host header field
-    if (server.requireHostHeader && req.headers.host === undefined) {
+    if (server.requireHostHeader && !hasHeader(req, 'host')) {
       res.writeHead(400, ['Connection', 'close']);
       res.end();
       return 0;
@@ -1131,7 +1152,7 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
       server.emit('dropRequest', req, socket);
       res.writeHead(503);
       res.end();
-    } else if (req.headers.expect !== undefined) {
+    } else if (hasHeader(req, 'expect')) {
       handled = true;
 
       if (continueExpression.test(req.headers.expect)) {
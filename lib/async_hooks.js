@@ -24,6 +24,7 @@ const {
 } = require('internal/util');
 const {
   validateFunction,
+  validateNumber,
   validateString,
 } = require('internal/validators');
 const internal_async_hooks = require('internal/async_hooks');
@@ -264,6 +265,21 @@ class AsyncResource {
   }
 }
 
+// Thread CPU time accounting of the callbacks that are invoked from native
+// code for async resources.
+function enableCPUTimeAccounting() {
+  asyncWrap.setCPUTimeAccounting(true);
+}
+
+function disableCPUTimeAccounting() {
+  asyncWrap.setCPUTimeAccounting(false);
+}
+
+function getCPUTime(asyncId) {
+  validateNumber(asyncId, 'asyncId');
+  return asyncWrap.getCPUTime(asyncId);
+}
+
 // Placing all exports down here because the exported classes won't export
 // otherwise.
 module.exports = {
@@ -277,6 +293,9 @@ module.exports = {
   executionAsyncId,
   triggerAsyncId,
   executionAsyncResource,
+  enableCPUTimeAccounting,
+  disableCPUTimeAccounting,
+  getCPUTime,
   asyncWrapProviders: ObjectFreeze({ __proto__: null, ...asyncWrap.Providers }),
   // Embedder API
   AsyncResource,
@@ -58,6 +58,7 @@ const {
   byteLengthUtf8,
   compare: _compare,
   compareOffset,
+  concat: _concat,
   copy: _copy,
   fill: bindingFill,
   isAscii: bindingIsAscii,
@@ -564,6 +565,17 @@ Buffer.isEncoding = function isEncoding(encoding) {
 };
 Buffer[kIsEncodingSymbol] = Buffer.isEncoding;
 
+// Shorter lists are copied with one fast API call per element, which costs
+// less than the one regular call into C++ that copies a whole list.
+const kConcatNativeMinLength = 8;
+
+function throwInvalidConcatElement(list, i) {
+  // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
+  // Instead, find the proper error code for this.
+  throw new ERR_INVALID_ARG_TYPE(
+    `list[${i}]`, ['Buffer', 'Uint8Array'], list[i]);
+}
+
 Buffer.concat = function concat(list, length) {
   validateArray(list, 'list');
 
@@ -583,15 +595,18 @@ Buffer.concat = function concat(list, length) {
 
   const buffer = Buffer.allocUnsafe(length);
   let pos = 0;
-  for (let i = 0; i < list.length; i++) {
-    const buf = list[i];
-    if (!isUint8Array(buf)) {
-      // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
-      // Instead, find the proper error code for this.
-      throw new ERR_INVALID_ARG_TYPE(
-        `list[${i}]`, ['Buffer', 'Uint8Array'], list[i]);
+  if (list.length < kConcatNativeMinLength) {
+    for (let i = 0; i < list.length; i++) {
+      const buf = list[i];
+      if (!isUint8Array(buf))
+        throwInvalidConcatElement(list, i);
+      pos += _copyActual(buf, buffer, pos, 0, buf.length);
     }
-    pos += _copyActual(buf, buffer, pos, 0, buf.length);
+  } else {
+    // All elements are copied in a single call.
+    pos = _concat(list, buffer);
+    if (pos < 0)
+      throwInvalidConcatElement(list, -1 - pos);
   }
 
   // Note: `length` is always equal to `buffer.length` at this point
@@ -1359,3 +1374,8 @@ defineLazyProperties(
   'internal/file',
   ['File'],
 );
+defineLazyProperties(
+  module.exports,
+  'internal/buffer_needle',
+  ['Needle'],
+);
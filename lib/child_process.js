@@ -82,6 +82,7 @@ const {
   validateArray,
   validateBoolean,
   validateFunction,
+  validateInteger,
   validateObject,
   validateString,
 } = require('internal/validators');
@@ -815,6 +816,7 @@ function spawn(file, args, options) {
  *   timeout?: number;
  *   killSignal?: string | number;
  *   maxBuffer?: number;
+ *   outputSizeHint?: number;
  *   encoding?: string;
  *   shell?: boolean | string;
  *   windowsVerbatimArguments?: boolean;
@@ -845,6 +847,11 @@ function spawnSync(file, args, options) {
   // Validate maxBuffer, if present.
   validateMaxBuffer(options.maxBuffer);
 
+  // Validate outputSizeHint, if present.
+  if (options.outputSizeHint != null) {
+    validateInteger(options.outputSizeHint, 'options.outputSizeHint', 0);
+  }
+
   // Validate and translate the kill signal, if present.
   options.killSignal = sanitizeKillSignal(options.killSignal);
 
@@ -908,6 +915,7 @@ function checkExecSyncError(ret, args, cmd) {
  *   timeout?: number;
  *   killSignal?: string | number;
  *   maxBuffer?: number;
+ *   outputSizeHint?: number;
  *   encoding?: string;
  *   windowsHide?: boolean;
  *   shell?: boolean | string;
@@ -947,6 +955,7 @@ function execFileSync(file, args, options) {
  *   timeout?: number;
  *   killSignal?: string | number;
  *   maxBuffer?: number;
+ *   outputSizeHint?: number;
  *   encoding?: string;
  *   windowsHide?: boolean;
  *   }} [options]
@@ -74,6 +74,7 @@ const {
   generateKeyPairSync,
   generateKey,
   generateKeySync,
+  setKeyPairPoolSize,
 } = require('internal/crypto/keygen');
 const {
   createSecretKey,
@@ -86,8 +87,11 @@ const {
   DiffieHellmanGroup,
   ECDH,
   diffieHellman,
+  diffieHellmanBatch,
 } = require('internal/crypto/diffiehellman');
 const {
+  aeadOpen,
+  aeadSeal,
   Cipheriv,
   Decipheriv,
   privateDecrypt,
@@ -98,14 +102,17 @@ const {
 } = require('internal/crypto/cipher');
 const {
   Sign,
+  signBatch,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot,
 } = require('internal/crypto/sig');
 const {
   Hash,
   Hmac,
   hash,
+  hashBatch,
 } = require('internal/crypto/hash');
 const {
   X509Certificate,
@@ -114,6 +121,8 @@ const {
   getCiphers,
   getCurves,
   getHashes,
+  getParseCacheStats,
+  getThreadPoolStats,
   setEngine,
   secureHeapUsed,
 } = require('internal/crypto/util');
@@ -171,6 +180,8 @@ function createVerify(algorithm, options) {
 
 module.exports = {
   // Methods
+  aeadOpen,
+  aeadSeal,
   checkPrime,
   checkPrimeSync,
   createCipheriv,
@@ -186,6 +197,7 @@ module.exports = {
   createSign,
   createVerify,
   diffieHellman,
+  diffieHellmanBatch,
   generatePrime,
   generatePrimeSync,
   getCiphers,
@@ -213,12 +225,16 @@ module.exports = {
   scrypt,
   scryptSync,
   sign: signOneShot,
+  signBatch,
   setEngine,
+  setKeyPairPoolSize,
   timingSafeEqual,
   getFips,
   setFips,
   verify: verifyOneShot,
+  verifyBatch,
   hash,
+  hashBatch,
 
   // Classes
   Certificate,
@@ -234,6 +250,8 @@ module.exports = {
   Verify,
   X509Certificate,
   secureHeapUsed,
+  getThreadPoolStats,
+  getParseCacheStats,
 };
 
 function getFips() {
@@ -59,6 +59,7 @@ const { isIP } = require('internal/net');
 const {
   isInt32,
   validateAbortSignal,
+  validateBoolean,
   validateString,
   validateNumber,
   validatePort,
@@ -112,6 +113,7 @@ function Socket(type, listener) {
   let sendBufferSize;
   let receiveBlockList;
   let sendBlockList;
+  let receiveBatch = false;
 
   let options;
   if (type !== null && typeof type === 'object') {
@@ -138,9 +140,13 @@ function Socket(type, listener) {
       }
       sendBlockList = options.sendBlockList;
     }
+    if (options.receiveBatch !== undefined) {
+      validateBoolean(options.receiveBatch, 'options.receiveBatch');
+      receiveBatch = options.receiveBatch;
+    }
   }
 
-  const handle = newHandle(type, lookup);
+  const handle = newHandle(type, lookup, receiveBatch);
   handle[owner_symbol] = this;
 
   this[async_id_symbol] = handle.getAsyncId();
@@ -196,6 +202,7 @@ function startListening(socket) {
   const state = socket[kStateSymbol];
 
   state.handle.onmessage = onMessage;
+  state.handle.onmessagebatch = onMessageBatch;
   state.handle.onerror = onError;
   state.handle.recvStart();
   state.receiving = true;
@@ -990,6 +997,17 @@ function onMessage(nread, handle, buf, rinfo) {
 }
 
 
+// Datagrams read with a single recvmmsg() call are delivered together and
+// emitted one after the other.
+function onMessageBatch(count, handle, bufs, rinfos) {
+  for (let i = 0; i < count; i++) {
+    onMessage(bufs[i].length, handle, bufs[i], rinfos[i]);
+    if (handle[owner_symbol][kStateSymbol].handle !== handle)
+      return;
+  }
+}
+
+
 function onError(nread, handle, error) {
   const self = handle[owner_symbol];
   return self.emit('error', error);
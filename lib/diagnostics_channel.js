@@ -30,6 +30,11 @@ const {
 } = require('internal/validators');
 
 const { triggerUncaughtException } = internalBinding('errors');
+const {
+  channels: nativeChannelNames,
+  subscribers: nativeChannelSubscribers,
+  setPublishCallback,
+} = internalBinding('diagnostics_channel');
 
 const { WeakReference } = require('internal/util');
 
@@ -58,11 +63,24 @@ class WeakRefMap extends SafeMap {
   }
 }
 
+// The channels that native code publishes to. Native code only builds
+// messages for them when they are flagged to have subscribers.
+const nativeChannels = new SafeMap();
+for (let i = 0; i < nativeChannelNames.length; i++) {
+  nativeChannels.set(nativeChannelNames[i], i);
+}
+
+function setNativeSubscribers(channel, active) {
+  const index = nativeChannels.get(channel.name);
+  if (index !== undefined) nativeChannelSubscribers[index] = active ? 1 : 0;
+}
+
 function markActive(channel) {
   // eslint-disable-next-line no-use-before-define
   ObjectSetPrototypeOf(channel, ActiveChannel.prototype);
   channel._subscribers = [];
   channel._stores = new SafeMap();
+  setNativeSubscribers(channel, true);
 }
 
 function maybeMarkInactive(channel) {
@@ -72,6 +90,7 @@ function maybeMarkInactive(channel) {
     ObjectSetPrototypeOf(channel, Channel.prototype);
     channel._subscribers = undefined;
     channel._stores = undefined;
+    setNativeSubscribers(channel, false);
   }
 }
 
@@ -95,7 +114,6 @@ function wrapStoreRun(store, data, next, transform = defaultTransform) {
   };
 }
 
-// TODO(qard): should there be a C++ channel interface?
 class ActiveChannel {
   subscribe(subscription) {
     validateFunction(subscription, 'subscription');
@@ -229,6 +247,10 @@ function channel(name) {
   return new Channel(name);
 }
 
+setPublishCallback((index, message) => {
+  channels.get(nativeChannelNames[index])?.publish(message);
+});
+
 function subscribe(name, subscription) {
   return channel(name).subscribe(subscription);
 }
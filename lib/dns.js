@@ -44,6 +44,8 @@ const {
   validateHints,
   getDefaultResultOrder,
   setDefaultResultOrder,
+  getLookupCacheStats,
+  setLookupCache,
   errorCodes: dnsErrorCodes,
   validDnsOrders,
   validFamilies,
@@ -318,6 +320,8 @@ module.exports = {
   Resolver,
   getDefaultResultOrder,
   setDefaultResultOrder,
+  getLookupCacheStats,
+  setLookupCache,
   setServers: defaultResolverSetServers,
 
   // uv_getaddrinfo flags
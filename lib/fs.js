@@ -25,6 +25,7 @@
 'use strict';
 
 const {
+  Array,
   ArrayFromAsync,
   ArrayPrototypePush,
   BigIntPrototypeToString,
@@ -79,6 +80,7 @@ const {
 
 const {
   FSReqCallback,
+  kReadFileMmapThreshold,
   statValues,
 } = binding;
 const { toPathIfFileURL } = require('internal/url');
@@ -100,18 +102,22 @@ const {
     kMaxUserId,
   },
   copyObject,
+  decodeFileContents,
   Dirent,
   emitRecursiveRmdirWarning,
   getDirent,
   getDirents,
   getOptions,
+  getReadManyResultFromBinding,
   getValidatedFd,
   getValidatedPath,
+  getValidatedPaths,
   handleErrorFromBinding,
   preprocessSymlinkDestination,
   Stats,
   getStatFsFromBinding,
   getStatsFromBinding,
+  getStatsArrayFromBinding,
   realpathCacheKey,
   stringToFlags,
   stringToSymlinkType,
@@ -311,6 +317,17 @@ function readFileAfterStat(err, stats) {
     return context.close(err);
   }
 
+  if (context.mmap && !context.isUserFd && kReadFileMmapThreshold !== 0 &&
+      size >= kReadFileMmapThreshold) {
+    const buffer = binding.mapFile(context.fd, size);
+    if (buffer !== undefined) {
+      context.buffer = buffer;
+      context.mapped = true;
+      context.pos = size;
+      return context.close();
+    }
+  }
+
   try {
     if (size === 0) {
       // TODO(BridgeAR): If an encoding is set, use the StringDecoder to concat
@@ -340,6 +357,7 @@ function checkAborted(signal, callback) {
  *   encoding?: string | null;
  *   flag?: string;
  *   signal?: AbortSignal;
+ *   mmap?: boolean;
  *   } | string} [options]
  * @param {(
  *   err?: Error,
@@ -354,6 +372,10 @@ function readFile(path, options, callback) {
   ReadFileContext ??= require('internal/fs/read/context');
   const context = new ReadFileContext(callback, options.encoding);
   context.isUserFd = isFd(path); // File descriptor ownership
+  if (options.mmap !== undefined) {
+    validateBoolean(options.mmap, 'options.mmap');
+    context.mmap = options.mmap;
+  }
 
   if (options.signal) {
     context.signal = options.signal;
@@ -416,17 +438,21 @@ function tryReadSync(fd, isUserFd, buffer, pos, len) {
  * @param {{
  *   encoding?: string | null;
  *   flag?: string;
+ *   mmap?: boolean;
  *   }} [options]
  * @returns {string | Buffer}
  */
 function readFileSync(path, options) {
   options = getOptions(options, { flag: 'r' });
+  if (options.mmap !== undefined)
+    validateBoolean(options.mmap, 'options.mmap');
+  const mmap = options.mmap === true;
 
   if (options.encoding === 'utf8' || options.encoding === 'utf-8') {
     if (!isInt32(path)) {
       path = getValidatedPath(path);
     }
-    return binding.readFileUtf8(path, stringToFlags(options.flag));
+    return binding.readFileUtf8(path, stringToFlags(options.flag), mmap);
   }
 
   const isUserFd = isFd(path); // File descriptor ownership
@@ -438,6 +464,20 @@ function readFileSync(path, options) {
   let buffer; // Single buffer with file data
   let buffers; // List for when size is unknown
 
+  // With the mmap option, large regular files that we opened ourselves are
+  // mapped instead of read; a user-supplied fd has to be read from its
+  // current position.
+  if (mmap && !isUserFd && kReadFileMmapThreshold !== 0 &&
+      size >= kReadFileMmapThreshold && size <= kIoMaxLength) {
+    buffer = binding.mapFile(fd, size);
+    if (buffer !== undefined) {
+      fs.closeSync(fd);
+      // Strings are always copied out of the mapping.
+      if (options.encoding) buffer = buffer.toString(options.encoding);
+      return buffer;
+    }
+  }
+
   if (size === 0) {
     buffers = [];
   } else {
@@ -474,10 +514,63 @@ function readFileSync(path, options) {
     buffer = buffer.slice(0, pos);
   }
 
-  if (options.encoding) buffer = buffer.toString(options.encoding);
+  if (options.encoding) buffer = decodeFileContents(buffer, options.encoding);
   return buffer;
 }
 
+/**
+ * Asynchronously reads the entire contents of many
+ * files from a single thread pool job.
+ * @param {Array<string | Buffer | URL>} paths
+ * @param {{
+ *   encoding?: string | null;
+ *   flag?: string;
+ *   } | string} [options]
+ * @param {(
+ *   err?: Error,
+ *   contents?: Array<string | Buffer | Error>
+ *   ) => any} callback
+ * @returns {void}
+ */
+function readMany(paths, options, callback) {
+  callback ||= options;
+  validateFunction(callback, 'cb');
+  options = getOptions(options, { flag: 'r' });
+  paths = getValidatedPaths(paths);
+  const flagsNumber = stringToFlags(options.flag, 'options.flag');
+  const req = new FSReqCallback();
+  req.oncomplete = (err, result) => {
+    if (err) {
+      return callback(err);
+    }
+    callback(null,
+             getReadManyResultFromBinding(result, paths, options.encoding));
+  };
+  binding.readMany(paths, flagsNumber, req);
+}
+
+/**
+ * Synchronously reads the entire contents of many files.
+ * Files that cannot be read are reported as the error
+ * instead of throwing.
+ * @param {Array<string | Buffer | URL>} paths
+ * @param {{
+ *   encoding?: string | null;
+ *   flag?: string;
+ *   } | string} [options]
+ * @returns {Array<string | Buffer | Error>}
+ */
+function readManySync(paths, options) {
+  options = getOptions(options, { flag: 'r' });
+  paths = getValidatedPaths(paths);
+  const result = binding.readMany(
+    paths,
+    stringToFlags(options.flag, 'options.flag'),
+    undefined,
+  );
+  return getReadManyResultFromBinding(result, paths, options.encoding);
+}
+
 function defaultCloseCallback(err) {
   if (err != null) throw err;
 }
@@ -557,6 +650,7 @@ function openSync(path, flags, mode) {
  * @param {string | Buffer | URL } path
  * @param {{
  *   type?: string;
+ *   mmap?: boolean;
  *   }} [options]
  * @returns {Promise<Blob>}
  */
@@ -564,11 +658,13 @@ function openAsBlob(path, options = kEmptyObject) {
   validateObject(options, 'options');
   const type = options.type || '';
   validateString(type, 'options.type');
+  const mmap = options.mmap ?? false;
+  validateBoolean(mmap, 'options.mmap');
   // The underlying implementation here returns the Blob synchronously for now.
   // To give ourselves flexibility to maybe return the Blob asynchronously,
   // this API returns a Promise.
   path = getValidatedPath(path);
-  return PromiseResolve(createBlobFromFilePath(path, { type }));
+  return PromiseResolve(createBlobFromFilePath(path, { type, mmap }));
 }
 
 /**
@@ -1359,6 +1455,19 @@ function mkdirSync(path, options) {
  * @returns {void}
 */
 function readdirRecursive(basePath, options, callback) {
+  if (canUseNativeReaddirRecursive(options)) {
+    const req = new FSReqCallback();
+    req.oncomplete = (err, result) => {
+      if (err) {
+        callback(err);
+        return;
+      }
+      callback(null, getReaddirRecursiveResults(basePath, options, result));
+    };
+    binding.readdirRecursive(basePath, req);
+    return;
+  }
+
   const context = {
     withFileTypes: Boolean(options.withFileTypes),
     encoding: options.encoding,
@@ -1406,6 +1515,50 @@ function readdirRecursive(basePath, options, callback) {
   read(context.pathsQueue[i++]);
 }
 
+/**
+ * The native walker only produces UTF-8 names, and cannot check every
+ * directory it enters against the permission model.
+ * @param {{ encoding: string }} options
+ * @returns {boolean}
+ */
+function canUseNativeReaddirRecursive(options) {
+  const { encoding } = options;
+  return (encoding == null || encoding === 'utf8' || encoding === 'utf-8') &&
+    !permission.isEnabled();
+}
+
+/**
+ * Turns the flat result of `binding.readdirRecursive()` into the values
+ * that `readdir(path, { recursive: true })` returns.
+ * @param {string} basePath
+ * @param {{ withFileTypes: boolean }} options
+ * @param {[string[], Uint32Array, string[], Uint8Array]} result
+ * @returns {string[] | Dirent[]}
+ */
+function getReaddirRecursiveResults(basePath, options, result) {
+  const { 0: dirs, 1: parents, 2: names, 3: types } = result;
+  const { length } = names;
+  const results = new Array(length);
+
+  if (options.withFileTypes) {
+    const parentPaths = new Array(dirs.length);
+    parentPaths[0] = basePath;
+    for (let i = 1; i < dirs.length; i++) {
+      parentPaths[i] = pathModule.join(basePath, dirs[i]);
+    }
+    for (let i = 0; i < length; i++) {
+      results[i] = getDirent(parentPaths[parents[i]], names[i], types[i]);
+    }
+  } else {
+    for (let i = 0; i < length; i++) {
+      const parent = parents[i];
+      results[i] = parent === 0 ?
+        names[i] : `${dirs[parent]}${pathModule.sep}${names[i]}`;
+    }
+  }
+  return results;
+}
+
 // Calling `readdir` with `withFileTypes=true`, the result is an array of arrays.
 // The first array is the names, and the second array is the types.
 // They are guaranteed to be the same length; hence, setting `length` to the length
@@ -1451,6 +1604,11 @@ function handleFilePaths({ result, currentPath, context }) {
  * @returns {string[] | Dirent[]}
  */
 function readdirSyncRecursive(basePath, options) {
+  if (canUseNativeReaddirRecursive(options)) {
+    return getReaddirRecursiveResults(
+      basePath, options, binding.readdirRecursive(basePath, undefined));
+  }
+
   const context = {
     withFileTypes: Boolean(options.withFileTypes),
     encoding: options.encoding,
@@ -1638,6 +1796,34 @@ function stat(path, options = { bigint: false }, callback) {
   binding.stat(getValidatedPath(path), options.bigint, req);
 }
 
+/**
+ * Asynchronously gets the stats of many files from
+ * a single thread pool job.
+ * @param {Array<string | Buffer | URL>} paths
+ * @param {{ bigint?: boolean; }} [options]
+ * @param {(
+ *   err?: Error,
+ *   stats?: Array<Stats | string>
+ *   ) => any} callback
+ * @returns {void}
+ */
+function statMany(paths, options = { bigint: false }, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = kEmptyObject;
+  }
+  validateFunction(callback, 'cb');
+  paths = getValidatedPaths(paths);
+  const req = new FSReqCallback(options.bigint);
+  req.oncomplete = (err, result) => {
+    if (err) {
+      return callback(err);
+    }
+    callback(null, getStatsArrayFromBinding(result));
+  };
+  binding.statMany(paths, options.bigint, req);
+}
+
 function statfs(path, options = { bigint: false }, callback) {
   if (typeof options === 'function') {
     callback = options;
@@ -1723,6 +1909,23 @@ function statSync(path, options = { bigint: false, throwIfNoEntry: true }) {
   return getStatsFromBinding(stats);
 }
 
+/**
+ * Synchronously retrieves the `fs.Stats` of many files.
+ * Entries that cannot be stat'ed are reported as their
+ * error code instead of throwing.
+ * @param {Array<string | Buffer | URL>} paths
+ * @param {{ bigint?: boolean; }} [options]
+ * @returns {Array<Stats | string>}
+ */
+function statManySync(paths, options = { bigint: false }) {
+  const result = binding.statMany(
+    getValidatedPaths(paths),
+    options.bigint,
+    undefined,
+  );
+  return getStatsArrayFromBinding(result);
+}
+
 function statfsSync(path, options = { bigint: false }) {
   const stats = binding.statfs(getValidatedPath(path), options.bigint);
   return getStatFsFromBinding(stats);
@@ -3248,6 +3451,8 @@ module.exports = fs = {
   readvSync,
   readFile,
   readFileSync,
+  readMany,
+  readManySync,
   readlink,
   readlinkSync,
   realpath,
@@ -3260,6 +3465,8 @@ module.exports = fs = {
   rmdirSync,
   stat,
   statfs,
+  statMany,
+  statManySync,
   statSync,
   statfsSync,
   symlink,
@@ -1,8 +1,11 @@
 'use strict';
 
 const {
+  ArrayPrototypeSlice,
+  ArrayPrototypeSplice,
+  MathImul,
   ObjectSetPrototypeOf,
-  SafeMap,
+  Symbol,
 } = primordials;
 
 const {
@@ -12,7 +15,104 @@ const {
 
 let enabled_;
 
-class ActiveAsyncContextFrame extends SafeMap {
+// The stores of a frame are kept in a persistent hash array mapped trie that
+// is keyed by an id assigned to every store. Entering a store copies only the
+// nodes on the path to it, so the cost of a new frame does not grow with the
+// number of stores, and frames share the rest of their structure.
+const kBits = 5;
+const kMask = (1 << kBits) - 1;
+const kStoreId = Symbol('kAsyncContextFrameStoreId');
+let nextStoreId = 0;
+
+class Entry {
+  constructor(id, value) {
+    this.id = id;
+    this.value = value;
+  }
+}
+
+class Node {
+  constructor(bitmap, children) {
+    this.bitmap = bitmap;
+    this.children = children;
+  }
+}
+
+function popcount(n) {
+  n -= (n >>> 1) & 0x55555555;
+  n = (n & 0x33333333) + ((n >>> 2) & 0x33333333);
+  return MathImul((n + (n >>> 4)) & 0x0f0f0f0f, 0x01010101) >>> 24;
+}
+
+function storeId(store) {
+  let id = store[kStoreId];
+  if (id === undefined) {
+    id = nextStoreId++;
+    store[kStoreId] = id;
+  }
+  return id;
+}
+
+function find(node, id) {
+  for (let shift = 0; node !== undefined; shift += kBits) {
+    const bit = 1 << ((id >>> shift) & kMask);
+    if ((node.bitmap & bit) === 0) return undefined;
+    const child = node.children[popcount(node.bitmap & (bit - 1))];
+    if (child instanceof Entry) return child.id === id ? child : undefined;
+    node = child;
+  }
+}
+
+function insert(node, shift, entry) {
+  const bit = 1 << ((entry.id >>> shift) & kMask);
+  if (node === undefined) return new Node(bit, [entry]);
+
+  const index = popcount(node.bitmap & (bit - 1));
+  const children = ArrayPrototypeSlice(node.children);
+  if ((node.bitmap & bit) === 0) {
+    ArrayPrototypeSplice(children, index, 0, entry);
+    return new Node(node.bitmap | bit, children);
+  }
+
+  const child = children[index];
+  if (child instanceof Node) {
+    children[index] = insert(child, shift + kBits, entry);
+  } else if (child.id === entry.id) {
+    children[index] = entry;
+  } else {
+    children[index] =
+      insert(insert(undefined, shift + kBits, child), shift + kBits, entry);
+  }
+  return new Node(node.bitmap, children);
+}
+
+function remove(node, shift, id) {
+  if (node === undefined) return undefined;
+  const bit = 1 << ((id >>> shift) & kMask);
+  if ((node.bitmap & bit) === 0) return node;
+
+  const index = popcount(node.bitmap & (bit - 1));
+  const child = node.children[index];
+  let replacement;
+  if (child instanceof Node) {
+    replacement = remove(child, shift + kBits, id);
+    if (replacement === child) return node;
+  } else if (child.id !== id) {
+    return node;
+  }
+
+  const children = ArrayPrototypeSlice(node.children);
+  if (replacement !== undefined) {
+    children[index] = replacement;
+    return new Node(node.bitmap, children);
+  }
+  const bitmap = node.bitmap & ~bit;
+  if (bitmap === 0) return undefined;
+  ArrayPrototypeSplice(children, index, 1);
+  return new Node(bitmap, children);
+}
+
+class ActiveAsyncContextFrame {
   static get enabled() {
     return true;
   }
@@ -51,7 +151,7 @@ function checkEnabled() {
   return enabled;
 }
 
-class InactiveAsyncContextFrame extends SafeMap {
+class InactiveAsyncContextFrame {
   static get enabled() {
     enabled_ ??= checkEnabled();
     return enabled_;
@@ -64,13 +164,30 @@ class InactiveAsyncContextFrame extends SafeMap {
 }
 
 class AsyncContextFrame extends InactiveAsyncContextFrame {
+  #root;
+
   constructor(store, data) {
-    super(AsyncContextFrame.current());
-    this.set(store, data);
+    super();
+    const current = AsyncContextFrame.current();
+    this.#root = insert(current?.#root, 0, new Entry(storeId(store), data));
+  }
+
+  has(store) {
+    const id = store[kStoreId];
+    return id !== undefined && find(this.#root, id) !== undefined;
+  }
+
+  get(store) {
+    const id = store[kStoreId];
+    if (id === undefined) return undefined;
+    return find(this.#root, id)?.value;
   }
 
+  // Only this frame stops seeing the store. The frames it shares its
+  // structure with are not changed.
   disable(store) {
-    this.delete(store);
+    const id = store[kStoreId];
+    if (id !== undefined) this.#root = remove(this.#root, 0, id);
   }
 }
 
@@ -394,7 +394,7 @@ function resolveObjectURL(url) {
 // TODO(@jasnell): Now that the File class exists, we might consider having
 // this return a `File` instead of a `Blob`.
 function createBlobFromFilePath(path, options) {
-  const maybeBlob = _createBlobFromFilePath(path);
+  const maybeBlob = _createBlobFromFilePath(path, options?.mmap === true);
   if (maybeBlob === undefined) {
     return lazyDOMException('The blob could not be read', 'NotReadableError');
   }
@@ -404,6 +404,13 @@ function createBlobFromFilePath(path, options) {
   return res;
 }
 
+// A single pull from a blob reader collects the data of up to kMaxPullsPerRead
+// reads from the underlying data source, and stops once it has at least the
+// number of bytes it was asked for. blob.stream() asks for
+// kStreamChunkSize bytes, blob.arrayBuffer() for the whole blob.
+const kMaxPullsPerRead = 1024;
+const kStreamChunkSize = 64 * 1024;
+
 function arrayBuffer(blob) {
   const { promise, resolve, reject } = PromiseWithResolvers();
   const reader = blob[kHandle].getReader();
@@ -413,7 +420,7 @@ function arrayBuffer(blob) {
       if (status === 0) {
         // EOS, concat & resolve
         // buffer should be undefined here
-        resolve(concat(buffers));
+        resolve(buffers.length === 1 ? buffers[0] : concat(buffers));
         return;
       } else if (status < 0) {
         // The read could fail for many different reasons when reading
@@ -426,7 +433,7 @@ function arrayBuffer(blob) {
       if (buffer !== undefined)
         buffers.push(buffer);
       queueMicrotask(() => readNext());
-    });
+    }, blob.size, kMaxPullsPerRead);
   };
   readNext();
   return promise;
@@ -492,7 +499,7 @@ function createBlobReaderStream(reader) {
             }
             readNext();
           });
-        });
+        }, kStreamChunkSize, kMaxPullsPerRead);
       };
       readNext();
       return promise;
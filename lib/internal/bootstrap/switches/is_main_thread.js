@@ -46,6 +46,7 @@ process.on('removeListener', stopListeningIfSignal);
 // ----              compare the setups side-by-side                    -----
 
 const { guessHandleType } = require('internal/util');
+const { getOptionValue } = require('internal/options');
 
 function createWritableStdioStream(fd) {
   let stream;
@@ -103,6 +104,15 @@ function createWritableStdioStream(fd) {
     }
   }
 
+  // The IPC channel is written to by libuv as well, so it is left alone.
+  const asyncStdio = getOptionValue('--experimental-async-stdio');
+  if (asyncStdio !== '' && stream._type !== undefined &&
+      !(process.channel && process.channel.fd === fd)) {
+    const { enableAsyncStdio } = require('internal/process/async_stdio');
+    enableAsyncStdio(stream, fd, asyncStdio,
+                     getOptionValue('--experimental-async-stdio-buffer-size'));
+  }
+
   // For supporting legacy API we put the FD here.
   stream.fd = fd;
 
@@ -33,7 +33,7 @@ process.removeListener('removeListener', stopListeningIfSignal);
 
 const {
   createWorkerStdio,
-  kStdioWantsMoreDataCallback,
+  kStdioFlushSync,
 } = require('internal/worker/io');
 
 let workerStdio;
@@ -47,8 +47,9 @@ function lazyWorkerStdio() {
 }
 
 function flushSync() {
-  workerStdio.stdout[kStdioWantsMoreDataCallback]();
-  workerStdio.stderr[kStdioWantsMoreDataCallback]();
+  // With the `inheritStdio` option, the output has been written already.
+  workerStdio.stdout[kStdioFlushSync]?.();
+  workerStdio.stderr[kStdioFlushSync]?.();
 }
 
 function getStdout() { return lazyWorkerStdio().stdout; }
@@ -0,0 +1,114 @@
+'use strict';
+
+const {
+  NumberIsNaN,
+  Symbol,
+  TypedArrayPrototypeGetByteLength,
+} = primordials;
+
+const {
+  Needle: NeedleHandle,
+} = internalBinding('buffer');
+
+const {
+  ERR_INVALID_ARG_TYPE,
+} = require('internal/errors').codes;
+
+const {
+  isArrayBufferView,
+  isUint8Array,
+} = require('internal/util/types');
+
+const {
+  FastBuffer,
+} = require('internal/buffer');
+
+const { Buffer } = require('buffer');
+const { validateBuffer } = require('internal/validators');
+
+const kHandle = Symbol('kHandle');
+const kLength = Symbol('kLength');
+
+function toBytes(value, encoding) {
+  if (typeof value === 'string')
+    return Buffer.from(value, encoding);
+  if (isUint8Array(value))
+    return value;
+  if (isArrayBufferView(value)) {
+    return new FastBuffer(value.buffer, value.byteOffset, value.byteLength);
+  }
+  throw new ERR_INVALID_ARG_TYPE(
+    'value', ['string', 'Buffer', 'TypedArray', 'DataView'], value,
+  );
+}
+
+// Same as the coercion of `byteOffset` in `bidirectionalIndexOf()` of
+// lib/buffer.js.
+function toByteOffset(buffer, byteOffset, dir) {
+  if (byteOffset > 0x7fffffff) {
+    byteOffset = 0x7fffffff;
+  } else if (byteOffset < -0x80000000) {
+    byteOffset = -0x80000000;
+  }
+  byteOffset = +byteOffset;
+  if (NumberIsNaN(byteOffset)) {
+    byteOffset = dir ? 0 : buffer.byteLength;
+  }
+  return byteOffset;
+}
+
+class Needle {
+  /**
+   * @param {string|Buffer|TypedArray|DataView} value
+   * @param {string} [encoding]
+   */
+  constructor(value, encoding) {
+    const bytes = toBytes(value, encoding);
+    // The handle keeps its own copy of the bytes.
+    this[kHandle] = new NeedleHandle(bytes);
+    this[kLength] = TypedArrayPrototypeGetByteLength(bytes);
+  }
+
+  /**
+   * The length of the needle in bytes.
+   * @type {number}
+   */
+  get length() {
+    return this[kLength];
+  }
+
+  /**
+   * @param {Buffer|Uint8Array} buffer
+   * @param {number} [byteOffset]
+   * @returns {number}
+   */
+  indexOf(buffer, byteOffset) {
+    validateBuffer(buffer);
+    return this[kHandle].indexOf(
+      buffer, toByteOffset(buffer, byteOffset, true), true);
+  }
+
+  /**
+   * @param {Buffer|Uint8Array} buffer
+   * @param {number} [byteOffset]
+   * @returns {number}
+   */
+  lastIndexOf(buffer, byteOffset) {
+    validateBuffer(buffer);
+    return this[kHandle].indexOf(
+      buffer, toByteOffset(buffer, byteOffset, false), false);
+  }
+
+  /**
+   * @param {Buffer|Uint8Array} buffer
+   * @param {number} [byteOffset]
+   * @returns {boolean}
+   */
+  includes(buffer, byteOffset) {
+    return this.indexOf(buffer, byteOffset) !== -1;
+  }
+}
+
+module.exports = {
+  Needle,
+};
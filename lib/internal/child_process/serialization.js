@@ -17,6 +17,7 @@ const { streamBaseState, kLastWriteWasAsync } = internalBinding('stream_wrap');
 
 const kMessageBuffer = Symbol('kMessageBuffer');
 const kMessageBufferSize = Symbol('kMessageBufferSize');
+const kReadIntoTarget = Symbol('kReadIntoTarget');
 const kJSONBuffer = Symbol('kJSONBuffer');
 const kStringDecoder = Symbol('kStringDecoder');
 
@@ -47,6 +48,37 @@ class ChildProcessDeserializer extends v8.DefaultDeserializer {
   }
 }
 
+// The rest of advanced messages at least this large is read straight into a
+// buffer of the message size, instead of collecting and concatenating the
+// chunks it arrives in.
+const kMinReadIntoSize = 256 * 1024;
+
+function readMessageSize(buffer) {
+  // We call `readUInt32BE` manually here, because this is faster than first converting
+  // it to a buffer and using `readUInt32BE` on that.
+  return (
+    buffer[0] << 24 |
+    buffer[1] << 16 |
+    buffer[2] << 8 |
+    buffer[3]
+  ) + 4;
+}
+
+function readRestOfMessageInto(channel) {
+  const fullMessageSize = readMessageSize(channel[kMessageBuffer][0]);
+  if (fullMessageSize < kMinReadIntoSize) return;
+
+  const target = Buffer.allocUnsafeSlow(fullMessageSize);
+  let offset = 0;
+  for (const chunk of channel[kMessageBuffer]) {
+    target.set(chunk, offset);
+    offset += chunk.length;
+  }
+  channel[kMessageBuffer] = [TypedArrayPrototypeSubarray(target, 0, offset)];
+  channel[kReadIntoTarget] = target;
+  channel.readInto(TypedArrayPrototypeSubarray(target, offset));
+}
+
 // Messages are parsed in either of the following formats:
 // - Newline-delimited JSON, or
 // - V8-serialized buffers, prefixed with their length as a big endian uint32
@@ -55,13 +87,21 @@ const advanced = {
   initMessageChannel(channel) {
     channel[kMessageBuffer] = [];
     channel[kMessageBufferSize] = 0;
+    channel[kReadIntoTarget] = undefined;
     channel.buffering = false;
   },
 
   *parseChannelMessages(channel, readData) {
     if (readData.length === 0) return;
 
-    if (channel[kMessageBufferSize] && channel[kMessageBuffer][0].length < 4) {
+    const target = channel[kReadIntoTarget];
+    if (target !== undefined) {
+      // This is (the start of) the rest of the message, read in place.
+      assert(readData.buffer === target.buffer);
+      channel[kReadIntoTarget] = undefined;
+      channel[kMessageBuffer][0] = TypedArrayPrototypeSubarray(
+        target, 0, channel[kMessageBufferSize] + readData.length);
+    } else if (channel[kMessageBufferSize] && channel[kMessageBuffer][0].length < 4) {
       // Message length split into two buffers, so let's concatenate it.
       channel[kMessageBuffer][0] = Buffer.concat([channel[kMessageBuffer][0], readData]);
     } else {
@@ -72,14 +112,7 @@ const advanced = {
     // Index 0 should always be present because we just pushed data into it.
     let messageBufferHead = channel[kMessageBuffer][0];
     while (messageBufferHead.length >= 4) {
-      // We call `readUInt32BE` manually here, because this is faster than first converting
-      // it to a buffer and using `readUInt32BE` on that.
-      const fullMessageSize = (
-        messageBufferHead[0] << 24 |
-        messageBufferHead[1] << 16 |
-        messageBufferHead[2] << 8 |
-        messageBufferHead[3]
-      ) + 4;
+      const fullMessageSize = readMessageSize(messageBufferHead);
 
       if (channel[kMessageBufferSize] < fullMessageSize) break;
 
@@ -104,6 +137,10 @@ const advanced = {
     }
 
     channel.buffering = channel[kMessageBufferSize] > 0;
+    if (channel.buffering && channel[kMessageBuffer][0].length >= 4 &&
+        typeof channel.readInto === 'function') {
+      readRestOfMessageInto(channel);
+    }
   },
 
   writeChannelMessage(channel, req, message, handle) {
@@ -13,6 +13,8 @@ const {
   publicDecrypt: _publicDecrypt,
   publicEncrypt: _publicEncrypt,
   getCipherInfo: _getCipherInfo,
+  aeadSeal: _aeadSeal,
+  aeadOpen: _aeadOpen,
 } = internalBinding('crypto');
 
 const {
@@ -32,10 +34,13 @@ const {
 } = require('internal/errors');
 
 const {
+  validateBuffer,
   validateEncoding,
   validateInt32,
+  validateInteger,
   validateObject,
   validateString,
+  validateUint32,
 } = require('internal/validators');
 
 const {
@@ -177,6 +182,19 @@ function final(outputEncoding) {
   return ret;
 };
 
+function updateInto(data, output, offset = 0) {
+  validateBuffer(data, 'data');
+  validateBuffer(output, 'output');
+  validateInteger(offset, 'offset', 0, output.byteLength);
+  return this[kHandle].updateInto(data, output, offset);
+}
+
+function finalInto(output, offset = 0) {
+  validateBuffer(output, 'output');
+  validateInteger(offset, 'offset', 0, output.byteLength);
+  return this[kHandle].finalInto(output, offset);
+}
+
 function setAutoPadding(ap) {
   if (!this[kHandle].setAutoPadding(!!ap))
     throw new ERR_CRYPTO_INVALID_STATE('setAutoPadding');
@@ -223,6 +241,8 @@ function addCipherPrototypeFunctions(constructor) {
   constructor.prototype._flush = _flush;
   constructor.prototype.update = update;
   constructor.prototype.final = final;
+  constructor.prototype.updateInto = updateInto;
+  constructor.prototype.finalInto = finalInto;
   constructor.prototype.setAutoPadding = setAutoPadding;
   if (constructor === Cipheriv) {
     constructor.prototype.getAuthTag = getAuthTag;
@@ -251,6 +271,37 @@ ObjectSetPrototypeOf(Decipheriv.prototype, LazyTransform.prototype);
 ObjectSetPrototypeOf(Decipheriv, LazyTransform);
 addCipherPrototypeFunctions(Decipheriv);
 
+function aeadFunctionFor(method, inputName) {
+  return (algorithm, key, iv, input, output, options) => {
+    validateString(algorithm, 'algorithm');
+    key = prepareSecretKey(key);
+    iv = getArrayBufferOrView(iv, 'iv');
+    validateBuffer(input, inputName);
+    validateBuffer(output, 'output');
+    let offset = 0;
+    let aad;
+    let authTagLength = 16;
+    if (options !== undefined) {
+      validateObject(options, 'options');
+      if (options.offset !== undefined) {
+        offset = options.offset;
+        validateInteger(offset, 'options.offset', 0, output.byteLength);
+      }
+      if (options.aad !== undefined)
+        aad = getArrayBufferOrView(options.aad, 'options.aad');
+      if (options.authTagLength !== undefined) {
+        authTagLength = options.authTagLength;
+        validateUint32(authTagLength, 'options.authTagLength');
+      }
+    }
+    return method(algorithm, key, iv, input, output, offset, aad,
+                  authTagLength);
+  };
+}
+
+const aeadSeal = aeadFunctionFor(_aeadSeal, 'plaintext');
+const aeadOpen = aeadFunctionFor(_aeadOpen, 'ciphertext');
+
 function getCipherInfo(nameOrNid, options) {
   if (typeof nameOrNid !== 'string' && typeof nameOrNid !== 'number') {
     throw new ERR_INVALID_ARG_TYPE(
@@ -279,6 +330,8 @@ function getCipherInfo(nameOrNid, options) {
 }
 
 module.exports = {
+  aeadOpen,
+  aeadSeal,
   Cipheriv,
   Decipheriv,
   privateDecrypt,
@@ -2,6 +2,8 @@
 
 const {
   ArrayBufferPrototypeSlice,
+  ArrayIsArray,
+  ArrayPrototypeMap,
   FunctionPrototypeCall,
   MathCeil,
   ObjectDefineProperty,
@@ -12,6 +14,7 @@ const {
 const { Buffer } = require('buffer');
 
 const {
+  DHBatchJob,
   DHBitsJob,
   DiffieHellman: _DiffieHellman,
   DiffieHellmanGroup: _DiffieHellmanGroup,
@@ -274,21 +277,17 @@ function getFormat(format) {
 
 const dhEnabledKeyTypes = new SafeSet(['dh', 'ec', 'x448', 'x25519']);
 
-function diffieHellman(options, callback) {
-  validateObject(options, 'options');
-
-  if (callback !== undefined)
-    validateFunction(callback, 'callback');
-
-  const { privateKey, publicKey } = options;
+function validateDHPrivateKey(privateKey) {
   if (!(privateKey instanceof KeyObject))
     throw new ERR_INVALID_ARG_VALUE('options.privateKey', privateKey);
 
-  if (!(publicKey instanceof KeyObject))
-    throw new ERR_INVALID_ARG_VALUE('options.publicKey', publicKey);
-
   if (privateKey.type !== 'private')
     throw new ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE(privateKey.type, 'private');
+}
+
+function validateDHPublicKey(publicKey, privateKey, name) {
+  if (!(publicKey instanceof KeyObject))
+    throw new ERR_INVALID_ARG_VALUE(name, publicKey);
 
   if (publicKey.type !== 'public' && publicKey.type !== 'private') {
     throw new ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE(publicKey.type,
@@ -301,6 +300,17 @@ function diffieHellman(options, callback) {
     throw new ERR_CRYPTO_INCOMPATIBLE_KEY('key types for Diffie-Hellman',
                                           `${privateType} and ${publicType}`);
   }
+}
+
+function diffieHellman(options, callback) {
+  validateObject(options, 'options');
+
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  const { privateKey, publicKey } = options;
+  validateDHPrivateKey(privateKey);
+  validateDHPublicKey(publicKey, privateKey, 'options.publicKey');
 
   const job = new DHBitsJob(
     callback ? kCryptoJobAsync : kCryptoJobSync,
@@ -322,6 +332,44 @@ function diffieHellman(options, callback) {
   job.run();
 }
 
+function diffieHellmanBatch(options, callback) {
+  validateObject(options, 'options');
+
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  const { privateKey, publicKeys } = options;
+  validateDHPrivateKey(privateKey);
+  if (!ArrayIsArray(publicKeys))
+    throw new ERR_INVALID_ARG_TYPE('options.publicKeys', 'Array', publicKeys);
+  const handles = ArrayPrototypeMap(publicKeys, (publicKey, i) => {
+    validateDHPublicKey(publicKey, privateKey, `options.publicKeys[${i}]`);
+    return publicKey[kHandle];
+  });
+
+  const job = new DHBatchJob(
+    callback ? kCryptoJobAsync : kCryptoJobSync,
+    handles,
+    privateKey[kHandle]);
+
+  const toBuffers = (secrets) =>
+    ArrayPrototypeMap(secrets, (secret) => Buffer.from(secret));
+
+  if (!callback) {
+    const { 0: err, 1: secrets } = job.run();
+    if (err !== undefined)
+      throw err;
+
+    return toBuffers(secrets);
+  }
+
+  job.ondone = (error, secrets) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, toBuffers(secrets));
+  };
+  job.run();
+}
+
 let masks;
 // The ecdhDeriveBits function is part of the Web Crypto API and serves both
 // deriveKeys and deriveBits functions.
@@ -383,5 +431,6 @@ module.exports = {
   DiffieHellmanGroup,
   ECDH,
   diffieHellman,
+  diffieHellmanBatch,
   ecdhDeriveBits,
 };
@@ -1,17 +1,24 @@
 'use strict';
 
 const {
+  Array,
+  ArrayIsArray,
+  FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
   StringPrototypeToLowerCase,
   Symbol,
+  Uint32Array,
+  Uint8Array,
 } = primordials;
 
 const {
   Hash: _Hash,
+  HashBatchJob,
   HashJob,
   Hmac: _Hmac,
   kCryptoJobAsync,
+  kCryptoJobSync,
   oneShotDigest,
 } = internalBinding('crypto');
 
@@ -50,12 +57,15 @@ const {
 
 const {
   validateEncoding,
+  validateFunction,
+  validateInteger,
   validateString,
   validateUint32,
 } = require('internal/validators');
 
 const {
   isArrayBufferView,
+  isUint32Array,
 } = require('internal/util/types');
 
 const LazyTransform = require('internal/streams/lazy_transform');
@@ -217,9 +227,86 @@ function hash(algorithm, input, outputEncoding = 'hex') {
                        input, normalized, encodingsMap[normalized]);
 }
 
+// Returns the concatenated inputs and a Uint32Array of the offsets that
+// delimit them, with one more element than there are inputs.
+function prepareHashBatch(data, offsets) {
+  if (ArrayIsArray(data)) {
+    if (offsets !== undefined) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'offsets', offsets, 'must be undefined when data is an array');
+    }
+    const views = new Array(data.length);
+    const boundaries = new Uint32Array(data.length + 1);
+    let total = 0;
+    for (let i = 0; i < data.length; i++) {
+      const item = data[i];
+      let view;
+      if (typeof item === 'string') {
+        view = Buffer.from(item, 'utf8');
+      } else if (isArrayBufferView(item)) {
+        view = new Uint8Array(item.buffer, item.byteOffset, item.byteLength);
+      } else {
+        throw new ERR_INVALID_ARG_TYPE(
+          `data[${i}]`, ['Buffer', 'TypedArray', 'DataView', 'string'], item);
+      }
+      views[i] = view;
+      total += view.byteLength;
+      boundaries[i + 1] = total;
+    }
+    return { data: Buffer.concat(views, total), boundaries };
+  }
+
+  if (!isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['Array', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+  if (offsets === undefined)
+    return { data, boundaries: new Uint32Array([0, data.byteLength]) };
+  if (!ArrayIsArray(offsets) && !isUint32Array(offsets)) {
+    throw new ERR_INVALID_ARG_TYPE('offsets', ['Array', 'Uint32Array'],
+                                   offsets);
+  }
+  const boundaries = new Uint32Array(offsets.length + 1);
+  let previous = 0;
+  for (let i = 0; i < offsets.length; i++) {
+    validateInteger(offsets[i], `offsets[${i}]`, previous, data.byteLength);
+    boundaries[i] = previous = offsets[i];
+  }
+  boundaries[offsets.length] = data.byteLength;
+  return { data, boundaries };
+}
+
+function hashBatch(algorithm, data, offsets, callback) {
+  if (typeof offsets === 'function') {
+    callback = offsets;
+    offsets = undefined;
+  }
+  validateString(algorithm, 'algorithm');
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+  const { data: input, boundaries } = prepareHashBatch(data, offsets);
+
+  if (callback === undefined) {
+    const job = new HashBatchJob(kCryptoJobSync, algorithm, input, boundaries);
+    const { 0: err, 1: result } = job.run();
+    if (err !== undefined)
+      throw err;
+    return Buffer.from(result);
+  }
+
+  const job = new HashBatchJob(kCryptoJobAsync, algorithm, input, boundaries);
+  job.ondone = (err, result) => {
+    if (err !== undefined)
+      return FunctionPrototypeCall(callback, job, err);
+    return FunctionPrototypeCall(callback, job, null, Buffer.from(result));
+  };
+  job.run();
+}
+
 module.exports = {
   Hash,
   Hmac,
   asyncDigest,
   hash,
+  hashBatch,
 };
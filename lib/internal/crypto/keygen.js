@@ -23,6 +23,8 @@ const {
   EVP_PKEY_X448,
   OPENSSL_EC_NAMED_CURVE,
   OPENSSL_EC_EXPLICIT_CURVE,
+  setEcKeyPairPoolSize,
+  setRsaKeyPairPoolSize,
 } = internalBinding('crypto');
 
 const {
@@ -102,6 +104,21 @@ function generateKeyPairSync(type, options) {
   return handleError(createJob(kCryptoJobSync, type, options).run());
 }
 
+function setKeyPairPoolSize(type, options, size) {
+  validateString(type, 'type');
+  if (type !== 'rsa' && type !== 'ec') {
+    throw new ERR_INVALID_ARG_VALUE('type', type,
+                                    'must be a key type that can be pooled');
+  }
+  validateUint32(size, 'size');
+
+  // The job is only used to validate the options, it is never run.
+  const job = createJob(kCryptoJobSync, type, options);
+  if (type === 'rsa')
+    return setRsaKeyPairPoolSize(job, size);
+  return setEcKeyPairPoolSize(job, size);
+}
+
 function handleError(ret) {
   if (ret == null)
     return; // async
@@ -400,6 +417,7 @@ function generateKeySync(type, options) {
 module.exports = {
   generateKeyPair,
   generateKeyPairSync,
+  setKeyPairPoolSize,
   generateKey,
   generateKeySync,
 };
@@ -19,6 +19,7 @@ const {
   NumberPrototypeToString,
   StringFromCharCodeApply,
   StringPrototypePadStart,
+  TypedArrayPrototypeGetByteLength,
 } = primordials;
 
 const {
@@ -27,6 +28,8 @@ const {
   CheckPrimeJob,
   kCryptoJobAsync,
   kCryptoJobSync,
+  kMaxPooledRandomBytes,
+  randomFillPooled,
   secureBuffer,
 } = internalBinding('crypto');
 
@@ -136,6 +139,11 @@ function randomFillSync(buf, offset = 0, size) {
   if (size === 0)
     return buf;
 
+  // Small requests are served from a per-thread pool of random bytes. If
+  // refilling the pool fails, the job below reports the error.
+  if (size <= kMaxPooledRandomBytes && randomFillPooled(buf, offset, size))
+    return buf;
+
   const job = new RandomBytesJob(
     kCryptoJobSync,
     buf,
@@ -331,7 +339,9 @@ function getRandomValues(data) {
       'The requested length exceeds 65,536 bytes',
       'QuotaExceededError');
   }
-  randomFillSync(data, 0);
+  const size = TypedArrayPrototypeGetByteLength(data);
+  if (size > kMaxPooledRandomBytes || !randomFillPooled(data, 0, size))
+    randomFillSync(data, 0);
   return data;
 }
 
@@ -1,6 +1,8 @@
 'use strict';
 
 const {
+  ArrayIsArray,
+  ArrayPrototypeMap,
   FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
@@ -22,6 +24,7 @@ const {
 
 const {
   Sign: _Sign,
+  SignBatchJob,
   SignJob,
   Verify: _Verify,
   kCryptoJobAsync,
@@ -293,9 +296,140 @@ function verifyOneShot(algorithm, data, key, signature, callback) {
   job.run();
 }
 
+function getBatchData(data, name) {
+  if (!ArrayIsArray(data))
+    throw new ERR_INVALID_ARG_TYPE(name, 'Array', data);
+  return ArrayPrototypeMap(data, (item, i) => {
+    if (!isArrayBufferView(item)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `${name}[${i}]`,
+        ['Buffer', 'TypedArray', 'DataView'],
+        item,
+      );
+    }
+    return item;
+  });
+}
+
+function signBatch(algorithm, data, key, callback) {
+  if (algorithm != null)
+    validateString(algorithm, 'algorithm');
+
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  data = getBatchData(data, 'data');
+
+  if (!key)
+    throw new ERR_CRYPTO_SIGN_KEY_REQUIRED();
+
+  // Options specific to RSA
+  const rsaPadding = getPadding(key);
+  const pssSaltLength = getSaltLength(key);
+
+  // Options specific to (EC)DSA
+  const dsaSigEnc = getDSASignatureEncoding(key);
+
+  const {
+    data: keyData,
+    format: keyFormat,
+    type: keyType,
+    passphrase: keyPassphrase,
+  } = preparePrivateKey(key);
+
+  const job = new SignBatchJob(
+    callback ? kCryptoJobAsync : kCryptoJobSync,
+    kSignJobModeSign,
+    keyData,
+    keyFormat,
+    keyType,
+    keyPassphrase,
+    data,
+    algorithm,
+    pssSaltLength,
+    rsaPadding,
+    dsaSigEnc);
+
+  const toBuffers = (signatures) =>
+    ArrayPrototypeMap(signatures, (signature) => Buffer.from(signature));
+
+  if (!callback) {
+    const { 0: err, 1: signatures } = job.run();
+    if (err !== undefined)
+      throw err;
+
+    return toBuffers(signatures);
+  }
+
+  job.ondone = (error, signatures) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, toBuffers(signatures));
+  };
+  job.run();
+}
+
+function verifyBatch(algorithm, data, key, signatures, callback) {
+  if (algorithm != null)
+    validateString(algorithm, 'algorithm');
+
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  data = getBatchData(data, 'data');
+  signatures = getBatchData(signatures, 'signatures');
+  if (signatures.length !== data.length) {
+    throw new ERR_INVALID_ARG_VALUE(
+      'signatures', signatures, 'must have as many elements as data');
+  }
+
+  // Options specific to RSA
+  const rsaPadding = getPadding(key);
+  const pssSaltLength = getSaltLength(key);
+
+  // Options specific to (EC)DSA
+  const dsaSigEnc = getDSASignatureEncoding(key);
+
+  const {
+    data: keyData,
+    format: keyFormat,
+    type: keyType,
+    passphrase: keyPassphrase,
+  } = preparePublicOrPrivateKey(key);
+
+  const job = new SignBatchJob(
+    callback ? kCryptoJobAsync : kCryptoJobSync,
+    kSignJobModeVerify,
+    keyData,
+    keyFormat,
+    keyType,
+    keyPassphrase,
+    data,
+    algorithm,
+    pssSaltLength,
+    rsaPadding,
+    dsaSigEnc,
+    signatures);
+
+  if (!callback) {
+    const { 0: err, 1: result } = job.run();
+    if (err !== undefined)
+      throw err;
+
+    return result;
+  }
+
+  job.ondone = (error, result) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, result);
+  };
+  job.run();
+}
+
 module.exports = {
   Sign,
+  signBatch,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot,
 };
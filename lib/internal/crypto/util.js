@@ -31,6 +31,8 @@ const {
   getHashes: _getHashes,
   setEngine: _setEngine,
   secureHeapUsed: _secureHeapUsed,
+  getCryptoThreadPoolStats: _getCryptoThreadPoolStats,
+  getParseCacheStats: _getParseCacheStats,
   getCachedAliases,
   getOpenSSLSecLevelCrypto: getOpenSSLSecLevel,
 } = internalBinding('crypto');
@@ -575,6 +577,26 @@ function secureHeapUsed() {
   return { total, used, utilization, min };
 }
 
+function getThreadPoolStats() {
+  const { 0: size, 1: queued, 2: active, 3: completed } =
+    _getCryptoThreadPoolStats();
+  return { size, queued, active, completed };
+}
+
+function getParseCacheStats() {
+  const stats = _getParseCacheStats();
+  const entry = (offset) => ({
+    hits: stats[offset],
+    misses: stats[offset + 1],
+    entries: stats[offset + 2],
+    size: stats[offset + 3],
+  });
+  return {
+    certificates: entry(0),
+    publicKeys: entry(4),
+  };
+}
+
 module.exports = {
   getArrayBufferOrView,
   getCiphers,
@@ -601,6 +623,8 @@ module.exports = {
   getStringOption,
   getUsagesUnion,
   secureHeapUsed,
+  getThreadPoolStats,
+  getParseCacheStats,
   getCachedHashId,
   getHashCache,
   getOpenSSLSecLevel,
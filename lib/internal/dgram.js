@@ -8,7 +8,10 @@ const {
 const { codes: {
   ERR_SOCKET_BAD_TYPE,
 } } = require('internal/errors');
-const { UDP } = internalBinding('udp_wrap');
+const {
+  UDP,
+  constants: { UV_UDP_RECVMMSG },
+} = internalBinding('udp_wrap');
 const { guessHandleType } = require('internal/util');
 const {
   isInt32,
@@ -28,7 +31,7 @@ function lookup6(lookup, address, callback) {
   return lookup(address || '::1', 6, callback);
 }
 
-function newHandle(type, lookup) {
+function newHandle(type, lookup, receiveBatch = false) {
   if (lookup === undefined) {
     if (dns === undefined) {
       dns = require('dns');
@@ -39,15 +42,17 @@ function newHandle(type, lookup) {
     validateFunction(lookup, 'lookup');
   }
 
+  const flags = receiveBatch ? UV_UDP_RECVMMSG : 0;
+
   if (type === 'udp4') {
-    const handle = new UDP();
+    const handle = new UDP(flags);
 
     handle.lookup = FunctionPrototypeBind(lookup4, handle, lookup);
     return handle;
   }
 
   if (type === 'udp6') {
-    const handle = new UDP();
+    const handle = new UDP(flags);
 
     handle.lookup = FunctionPrototypeBind(lookup6, handle, lookup);
     handle.bind = handle.bind6;
@@ -23,8 +23,10 @@ const { getOptionValue } = require('internal/options');
 const {
   validateArray,
   validateInt32,
+  validateObject,
   validateOneOf,
   validateString,
+  validateUint32,
 } = require('internal/validators');
 let binding;
 function lazyBinding() {
@@ -278,6 +280,36 @@ function getDefaultResultOrder() {
   return dnsOrder;
 }
 
+function setLookupCache(options) {
+  if (options === false) {
+    lazyBinding().setLookupCache(0, 0, 0, 0);
+    return;
+  }
+  validateObject(options, 'options');
+  const {
+    ttl = 30_000,
+    negativeTtl = 0,
+    staleTtl = 0,
+    maxEntries = 1024,
+  } = options;
+  validateUint32(ttl, 'options.ttl');
+  validateUint32(negativeTtl, 'options.negativeTtl');
+  validateUint32(staleTtl, 'options.staleTtl');
+  validateUint32(maxEntries, 'options.maxEntries');
+  lazyBinding().setLookupCache(ttl, negativeTtl, staleTtl, maxEntries);
+}
+
+function getLookupCacheStats() {
+  const {
+    0: hits,
+    1: misses,
+    2: staleHits,
+    3: coalesced,
+    4: entries,
+  } = lazyBinding().getLookupCacheStats();
+  return { hits, misses, staleHits, coalesced, entries };
+}
+
 function createResolverClass(resolver) {
   const resolveMap = { __proto__: null };
 
@@ -341,6 +373,8 @@ module.exports = {
   validateTries,
   getDefaultResultOrder,
   setDefaultResultOrder,
+  getLookupCacheStats,
+  setLookupCache,
   errorCodes,
   createResolverClass,
   initializeDns,
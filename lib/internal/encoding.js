@@ -31,6 +31,7 @@ const kFatal = Symbol('kFatal');
 const kUTF8FastPath = Symbol('kUTF8FastPath');
 const kLatin1FastPath = Symbol('kLatin1FastPath');
 const kIgnoreBOM = Symbol('kIgnoreBOM');
+const kUTF8Decoder = Symbol('kUTF8Decoder');
 
 const {
   getConstructorOf,
@@ -57,6 +58,7 @@ const {
   encodeUtf8String,
   decodeUTF8,
   decodeLatin1,
+  UTF8Decoder,
 } = binding;
 
 const { Buffer } = require('buffer');
@@ -422,6 +424,7 @@ function makeTextDecoderICU() {
       // Only support fast path for UTF-8.
       this[kUTF8FastPath] = enc === 'utf-8';
       this[kLatin1FastPath] = enc === 'windows-1252';
+      this[kUTF8Decoder] = undefined;
       this[kHandle] = undefined;
 
       if (!this[kUTF8FastPath] && !this[kLatin1FastPath]) {
@@ -440,10 +443,17 @@ function makeTextDecoderICU() {
     decode(input = empty, options = kEmptyObject) {
       validateDecoder(this);
 
-      this[kUTF8FastPath] &&= !(options?.stream);
       this[kLatin1FastPath] &&= !(options?.stream);
 
       if (this[kUTF8FastPath]) {
+        const stream = Boolean(options?.stream);
+        // The native decoder keeps the bytes of a sequence that is split
+        // between chunks, until the next call without `stream`.
+        if (stream || this[kUTF8Decoder] !== undefined) {
+          this[kUTF8Decoder] ??=
+            new UTF8Decoder(this[kIgnoreBOM], this[kFatal]);
+          return this[kUTF8Decoder].decode(input, !stream);
+        }
         return decodeUTF8(input, this[kIgnoreBOM], this[kFatal]);
       }
 
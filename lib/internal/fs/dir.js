@@ -6,9 +6,11 @@ const {
   FunctionPrototypeBind,
   ObjectDefineProperties,
   PromiseReject,
+  StringPrototypeSplit,
   SymbolAsyncDispose,
   SymbolAsyncIterator,
   SymbolDispose,
+  TypedArrayPrototypeSubarray,
 } = primordials;
 
 const pathModule = require('path');
@@ -25,6 +27,7 @@ const {
 const { FSReqCallback } = binding;
 const {
   assignFunctionName,
+  normalizeEncoding,
   promisify,
 } = require('internal/util');
 const {
@@ -33,6 +36,7 @@ const {
   getValidatedPath,
 } = require('internal/fs/utils');
 const {
+  validateBoolean,
   validateFunction,
   validateUint32,
 } = require('internal/validators');
@@ -47,6 +51,9 @@ class Dir {
   #closePromisified;
   #operationQueue = null;
   #handlerQueue = [];
+  #prefetchReq = null;
+  #prefetched = null;
+  #prefetchWaiter = null;
 
   constructor(handle, path, options) {
     if (handle == null) throw new ERR_MISSING_ARGS('handle');
@@ -54,12 +61,14 @@ class Dir {
     this.#path = path;
     this.#options = {
       bufferSize: 32,
+      prefetch: false,
       ...getOptions(options, {
         encoding: 'utf8',
       }),
     };
 
     validateUint32(this.#options.bufferSize, 'options.bufferSize', true);
+    validateBoolean(this.#options.prefetch, 'options.prefetch');
 
     this.#readPromisified = FunctionPrototypeBind(
       promisify(this.#readImpl), this, false);
@@ -138,6 +147,11 @@ class Dir {
       }
     }
 
+    if (this.#options.prefetch) {
+      this.#readPrefetched(maybeSync, callback);
+      return;
+    }
+
     const req = new FSReqCallback();
     req.oncomplete = (err, result) => {
       process.nextTick(() => {
@@ -170,6 +184,117 @@ class Dir {
     );
   }
 
+  // In prefetch mode, the next batch is read as soon as the current one
+  // arrives, so that the threadpool round-trip overlaps with the processing
+  // of the entries in JS. Batches use the packed format of the binding.
+  #readPrefetched(maybeSync, callback) {
+    const deliver = (err, result) => {
+      if (!err && result !== null) {
+        this.#prefetch();
+      }
+
+      if (err || result === null) {
+        return callback(err, result);
+      }
+
+      try {
+        this.processPackedResult(this.#path, result);
+        const dirent = ArrayPrototypeShift(this.#bufferedEntries);
+        if (this.#options.recursive && dirent.isDirectory()) {
+          this.readSyncRecursive(dirent);
+        }
+        callback(null, dirent);
+      } catch (error) {
+        callback(error);
+      }
+    };
+
+    const prefetched = this.#prefetched;
+    if (prefetched !== null) {
+      this.#prefetched = null;
+      if (!maybeSync) {
+        deliver(prefetched.err, prefetched.result);
+        return;
+      }
+      this.#operationQueue = [];
+      process.nextTick(() => {
+        const queue = this.#operationQueue;
+        this.#operationQueue = null;
+        deliver(prefetched.err, prefetched.result);
+        for (const op of queue) op();
+      });
+      return;
+    }
+
+    this.#operationQueue = [];
+    this.#prefetchWaiter = (err, result) => {
+      process.nextTick(() => {
+        const queue = this.#operationQueue;
+        this.#operationQueue = null;
+        for (const op of queue) op();
+      });
+      deliver(err, result);
+    };
+    if (this.#prefetchReq === null) {
+      this.#prefetch();
+    }
+  }
+
+  #prefetch() {
+    const req = new FSReqCallback();
+    req.oncomplete = (err, result) => {
+      this.#prefetchReq = null;
+      const waiter = this.#prefetchWaiter;
+      if (waiter === null) {
+        this.#prefetched = { err, result };
+        return;
+      }
+      this.#prefetchWaiter = null;
+      waiter(err, result);
+    };
+
+    this.#prefetchReq = req;
+    this.#handle.read(
+      this.#options.encoding,
+      this.#options.bufferSize,
+      req,
+      true,
+    );
+  }
+
+  processPackedResult(path, { 0: names, 1: types }) {
+    const encoding = this.#options.encoding;
+    const count = types.length;
+
+    if (encoding !== 'buffer') {
+      const normalized = normalizeEncoding(encoding);
+      if (normalized === 'utf8' || normalized === 'latin1') {
+        // Names cannot contain NUL bytes, so decode all of them at once.
+        const decoded = StringPrototypeSplit(names.toString(normalized), '\0');
+        for (let i = 0; i < count; i++) {
+          ArrayPrototypePush(
+            this.#bufferedEntries,
+            getDirent(path, decoded[i], types[i]),
+          );
+        }
+        return;
+      }
+    }
+
+    let start = 0;
+    for (let i = 0; i < count; i++) {
+      const end = names.indexOf(0, start);
+      const name = encoding === 'buffer' ?
+        TypedArrayPrototypeSubarray(names, start, end) :
+        names.toString(encoding, start, end);
+      ArrayPrototypePush(
+        this.#bufferedEntries,
+        getDirent(path, name, types[i]),
+      );
+      start = end + 1;
+    }
+  }
+
   processReadResult(path, result) {
     for (let i = 0; i < result.length; i += 2) {
       ArrayPrototypePush(
@@ -202,7 +327,7 @@ class Dir {
       throw new ERR_DIR_CLOSED();
     }
 
-    if (this.#operationQueue !== null) {
+    if (this.#operationQueue !== null || this.#prefetchReq !== null) {
       throw new ERR_DIR_CONCURRENT_OPERATION();
     }
 
@@ -214,16 +339,41 @@ class Dir {
       return dirent;
     }
 
-    const result = this.#handle.read(
-      this.#options.encoding,
-      this.#options.bufferSize,
-    );
+    if (this.#options.prefetch) {
+      let result;
+      const prefetched = this.#prefetched;
+      if (prefetched !== null) {
+        this.#prefetched = null;
+        if (prefetched.err) {
+          throw prefetched.err;
+        }
+        result = prefetched.result;
+      } else {
+        result = this.#handle.read(
+          this.#options.encoding,
+          this.#options.bufferSize,
+          undefined,
+          true,
+        );
+      }
 
-    if (result === null) {
-      return result;
-    }
+      if (result === null) {
+        return result;
+      }
+
+      this.processPackedResult(this.#path, result);
+    } else {
+      const result = this.#handle.read(
+        this.#options.encoding,
+        this.#options.bufferSize,
+      );
 
-    this.processReadResult(this.#path, result);
+      if (result === null) {
+        return result;
+      }
+
+      this.processReadResult(this.#path, result);
+    }
 
     const dirent = ArrayPrototypeShift(this.#bufferedEntries);
     if (this.#options.recursive && dirent.isDirectory()) {
@@ -254,6 +404,19 @@ class Dir {
       return;
     }
 
+    if (this.#prefetchReq !== null) {
+      // Let the pending prefetch finish before closing the handle.
+      this.#operationQueue = [];
+      this.#prefetchWaiter = () => {
+        const queue = this.#operationQueue;
+        this.#operationQueue = null;
+        this.close(callback);
+        for (const op of queue) op();
+      };
+      return;
+    }
+
+    this.#prefetched = null;
     while (this.#handlerQueue.length > 0) {
       const handler = ArrayPrototypeShift(this.#handlerQueue);
       handler.handle.close();
@@ -270,10 +433,11 @@ class Dir {
       throw new ERR_DIR_CLOSED();
     }
 
-    if (this.#operationQueue !== null) {
+    if (this.#operationQueue !== null || this.#prefetchReq !== null) {
       throw new ERR_DIR_CONCURRENT_OPERATION();
     }
 
+    this.#prefetched = null;
     while (this.#handlerQueue.length > 0) {
       const handler = ArrayPrototypeShift(this.#handlerQueue);
       handler.handle.close();
@@ -39,6 +39,8 @@ const {
 } = require('internal/errors');
 const assert = require('internal/assert');
 const { toPathIfFileURL } = require('internal/url');
+const binding = internalBinding('fs');
+const permission = require('internal/process/permission');
 
 let minimatch;
 function lazyMinimatch() {
@@ -265,12 +267,17 @@ class Glob {
   #subpatterns = new SafeMap();
   #patterns;
   #withFileTypes;
+  #canUseNative;
   #isExcluded = () => false;
   constructor(pattern, options = kEmptyObject) {
     validateObject(options, 'options');
     const { exclude, cwd, withFileTypes } = options;
     this.#root = toPathIfFileURL(cwd) ?? '.';
     this.#withFileTypes = !!withFileTypes;
+    // The native walker only knows about plain string results, exclusions
+    // need to be checked for every path that is visited.
+    this.#canUseNative = exclude == null && !this.#withFileTypes &&
+      typeof this.#root === 'string';
     if (exclude != null) {
       validateStringArrayOrFunction(exclude, 'options.exclude');
       if (ArrayIsArray(exclude)) {
@@ -306,6 +313,17 @@ class Glob {
   }
 
   globSync() {
+    if (this.#canUseNative && !permission.isEnabled()) {
+      const results = binding.glob(
+        resolve(this.#root),
+        ArrayPrototypeFlatMap(this.matchers, (matcher) => matcher.globParts),
+        isWindows || isMacOS,
+      );
+      // `undefined` means that the patterns need the JS implementation.
+      if (results !== undefined) {
+        return results;
+      }
+    }
     ArrayPrototypePush(this.#queue, { __proto__: null, path: '.', patterns: this.#patterns });
     while (this.#queue.length > 0) {
       const item = ArrayPrototypePop(this.#queue);
@@ -1,8 +1,10 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
   ArrayPrototypePop,
   ArrayPrototypePush,
+  ArrayPrototypeSplice,
   Error,
   ErrorCaptureStackTrace,
   FunctionPrototypeBind,
@@ -12,6 +14,7 @@ const {
   PromisePrototypeThen,
   PromiseReject,
   PromiseResolve,
+  PromiseWithResolvers,
   SafeArrayIterator,
   SafePromisePrototypeFinally,
   Symbol,
@@ -56,12 +59,16 @@ const {
     kWriteFileMaxChunkSize,
   },
   copyObject,
+  decodeFileContents,
   emitRecursiveRmdirWarning,
   getDirents,
   getOptions,
+  getReadManyResultFromBinding,
   getStatFsFromBinding,
   getStatsFromBinding,
+  getStatsArrayFromBinding,
   getValidatedPath,
+  getValidatedPaths,
   preprocessSymlinkDestination,
   stringToFlags,
   stringToSymlinkType,
@@ -117,6 +124,11 @@ const kCloseReject = Symbol('kCloseReject');
 const kRef = Symbol('kRef');
 const kUnref = Symbol('kUnref');
 const kLocked = Symbol('kLocked');
+const kWriteBehind = Symbol('kWriteBehind');
+
+// Upper bound for the number of queued writes that are merged into one
+// writev() call, to stay below IOV_MAX.
+const kWriteBehindMaxBuffers = 1024;
 
 const { kUsePromises } = binding;
 const { Interface } = require('internal/readline/interface');
@@ -165,6 +177,7 @@ class FileHandle extends EventEmitter {
 
     this[kRefs] = 1;
     this[kClosePromise] = null;
+    this[kWriteBehind] = null;
   }
 
   getAsyncId() {
@@ -234,6 +247,16 @@ class FileHandle extends EventEmitter {
     return fsCall(writev, this, buffers, position);
   }
 
+  setWriteBehind(writeBehind = true) {
+    validateBoolean(writeBehind, 'writeBehind');
+    if (!writeBehind) {
+      this[kWriteBehind] = null;
+    } else {
+      this[kWriteBehind] ??= { __proto__: null, writing: false, pending: [] };
+    }
+    return this;
+  }
+
   writeFile(data, options) {
     return fsCall(writeFile, this, data, options);
   }
@@ -580,7 +603,7 @@ async function readFileHandle(filehandle, options) {
       }
 
       if (singleRead) {
-        return buffer.toString(encoding);
+        return decodeFileContents(buffer, encoding);
       }
       result += decoder.end(buffer);
       return result;
@@ -741,6 +764,12 @@ async function write(handle, buffer, offsetOrOptions, length, position) {
     if (typeof position !== 'number')
       position = null;
     validateOffsetLengthWrite(offset, length, buffer.byteLength);
+    if (handle[kWriteBehind] !== null) {
+      const view = new Uint8Array(buffer.buffer, buffer.byteOffset + offset,
+                                  length);
+      const bytesWritten = await writeBehind(handle, view, position);
+      return { __proto__: null, bytesWritten, buffer };
+    }
     const bytesWritten =
       (await PromisePrototypeThen(
         binding.writeBuffer(handle.fd, buffer, offset,
@@ -753,6 +782,14 @@ async function write(handle, buffer, offsetOrOptions, length, position) {
 
   validateStringAfterArrayBufferView(buffer, 'buffer');
   validateEncoding(buffer, length);
+  if (handle[kWriteBehind] !== null) {
+    const bytesWritten = await writeBehind(
+      handle,
+      Buffer.from(buffer, length),
+      typeof offset === 'number' ? offset : null,
+    );
+    return { __proto__: null, bytesWritten, buffer };
+  }
   const bytesWritten = (await PromisePrototypeThen(
     binding.writeString(handle.fd, buffer, offset, length, kUsePromises),
     undefined,
@@ -761,6 +798,70 @@ async function write(handle, buffer, offsetOrOptions, length, position) {
   return { __proto__: null, bytesWritten, buffer };
 }
 
+/**
+ * Queues a write on a FileHandle in write-behind mode. While a write is in
+ * progress, writes that continue where the previous one ends (or that all
+ * use the current file position) are merged into a single writev() call.
+ * Each write resolves with its share of the bytes that were written.
+ * @param {FileHandle} handle
+ * @param {Uint8Array} view
+ * @param {number | null} position
+ * @returns {Promise<number>}
+ */
+function writeBehind(handle, view, position) {
+  const queue = handle[kWriteBehind];
+  const { promise, resolve, reject } = PromiseWithResolvers();
+  ArrayPrototypePush(queue.pending,
+                     { __proto__: null, view, position, resolve, reject });
+  if (!queue.writing) {
+    flushWriteBehind(handle, queue);
+  }
+  return promise;
+}
+
+function takeWriteBehindBatch(pending) {
+  const { position } = pending[0];
+  let next = position === null ? null : position + pending[0].view.byteLength;
+  let count = 1;
+  while (count < pending.length && count < kWriteBehindMaxBuffers &&
+         pending[count].position === next) {
+    if (next !== null) {
+      next += pending[count].view.byteLength;
+    }
+    count++;
+  }
+  return ArrayPrototypeSplice(pending, 0, count);
+}
+
+async function flushWriteBehind(handle, queue) {
+  queue.writing = true;
+  while (queue.pending.length > 0) {
+    const batch = takeWriteBehindBatch(queue.pending);
+    let bytesWritten;
+    try {
+      bytesWritten = (await PromisePrototypeThen(
+        binding.writeBuffers(handle.fd,
+                             ArrayPrototypeMap(batch, (write) => write.view),
+                             batch[0].position,
+                             kUsePromises),
+        undefined,
+        handleErrorFromBinding,
+      )) || 0;
+    } catch (err) {
+      for (let i = 0; i < batch.length; i++) {
+        batch[i].reject(err);
+      }
+      continue;
+    }
+    for (let i = 0; i < batch.length; i++) {
+      const written = MathMin(batch[i].view.byteLength, bytesWritten);
+      bytesWritten -= written;
+      batch[i].resolve(written);
+    }
+  }
+  queue.writing = false;
+}
+
 async function writev(handle, buffers, position) {
   validateBufferArray(buffers);
 
@@ -1043,6 +1144,15 @@ async function stat(path, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function statMany(paths, options = { bigint: false }) {
+  const result = await PromisePrototypeThen(
+    binding.statMany(getValidatedPaths(paths), options.bigint, kUsePromises),
+    undefined,
+    handleErrorFromBinding,
+  );
+  return getStatsArrayFromBinding(result);
+}
+
 async function statfs(path, options = { bigint: false }) {
   const result = await PromisePrototypeThen(
     binding.statfs(path, options.bigint, kUsePromises),
@@ -1245,6 +1355,18 @@ async function readFile(path, options) {
   return handleFdClose(readFileHandle(fd, options), fd.close);
 }
 
+async function readMany(paths, options) {
+  options = getOptions(options, { flag: 'r' });
+  paths = getValidatedPaths(paths);
+  const result = await PromisePrototypeThen(
+    binding.readMany(
+      paths, stringToFlags(options.flag, 'options.flag'), kUsePromises),
+    undefined,
+    handleErrorFromBinding,
+  );
+  return getReadManyResultFromBinding(result, paths, options.encoding);
+}
+
 async function* _watch(filename, options = kEmptyObject) {
   validateObject(options, 'options');
 
@@ -1289,6 +1411,7 @@ module.exports = {
     symlink,
     lstat,
     stat,
+    statMany,
     statfs,
     link,
     unlink,
@@ -1303,6 +1426,7 @@ module.exports = {
     writeFile,
     appendFile,
     readFile,
+    readMany,
     watch: !isMacOS && !isWindows ? _watch : watch,
     constants,
   },
@@ -11,6 +11,7 @@ const {
     kReadFileBufferLength,
     kReadFileUnknownBufferLength,
   },
+  decodeFileContents,
 } = require('internal/fs/utils');
 
 const { Buffer } = require('buffer');
@@ -59,8 +60,11 @@ function readFileAfterClose(err) {
     else
       buffer = context.buffer;
 
-    if (context.encoding)
+    // A mapped buffer would let later changes to the file show through.
+    if (context.encoding && context.mapped)
       buffer = buffer.toString(context.encoding);
+    else if (context.encoding)
+      buffer = decodeFileContents(buffer, context.encoding);
   } catch (err) {
     return callback(err);
   }
@@ -78,6 +82,8 @@ class ReadFileContext {
     this.buffer = null;
     this.pos = 0;
     this.encoding = encoding;
+    this.mmap = false;
+    this.mapped = false;
     this.err = null;
     this.signal = undefined;
   }
@@ -12,6 +12,7 @@ const { EventEmitter } = require('events');
 const assert = require('internal/assert');
 const {
   AbortError,
+  UVException,
   codes: {
     ERR_INVALID_ARG_VALUE,
   },
@@ -27,6 +28,11 @@ const {
   resolve: pathResolve,
 } = require('path');
 
+// On Linux, a single handle watches the whole tree. The emulation below
+// watches every file on platforms that don't have it.
+const { FSEventRecursive } = internalBinding('fs_event_wrap');
+const { UV_ENOSPC } = internalBinding('uv');
+
 let internalSync;
 
 function lazyLoadFsSync() {
@@ -44,6 +50,7 @@ class FSWatcher extends EventEmitter {
   #symbolicFiles = new SafeSet();
   #rootPath = pathResolve();
   #watchingFile = false;
+  #handle = null;
 
   constructor(options = kEmptyObject) {
     super();
@@ -82,6 +89,11 @@ class FSWatcher extends EventEmitter {
 
     this.#closed = true;
 
+    if (this.#handle !== null) {
+      this.#handle.close();
+      this.#handle = null;
+    }
+
     for (const file of this.#files.keys()) {
       this.#watchers.get(file)?.close();
       this.#watchers.delete(file);
@@ -197,9 +209,49 @@ class FSWatcher extends EventEmitter {
     this.#watchers.set(file, watcher);
   }
 
+  #watchTree(directory) {
+    const handle = new FSEventRecursive();
+    handle.onchange = (status, events) => {
+      if (status < 0) {
+        // As with FSWatcher in internal/fs/watchers, the error closes the
+        // watcher without a close event.
+        this.#closed = true;
+        this.#handle?.close();
+        this.#handle = null;
+        const error = new UVException({
+          errno: status,
+          syscall: 'watch',
+          path: directory,
+        });
+        error.filename = directory;
+        this.emit('error', error);
+        return;
+      }
+      for (let i = 0; i < events.length && !this.#closed; i += 2) {
+        this.emit('change', events[i], events[i + 1]);
+      }
+    };
+
+    const { persistent = true, encoding } = this.#options;
+    const err = handle.start(directory, persistent, encoding);
+    if (err) {
+      const error = new UVException({
+        errno: err,
+        syscall: 'watch',
+        path: directory,
+        message: err === UV_ENOSPC ?
+          'System limit for number of file watchers reached' : '',
+      });
+      error.filename = directory;
+      throw error;
+    }
+    this.#handle = handle;
+  }
+
   [kFSWatchStart](filename) {
     filename = pathResolve(getValidatedPath(filename));
 
+    let watchTree = false;
     try {
       const file = lazyLoadFsSync().statSync(filename);
 
@@ -207,9 +259,12 @@ class FSWatcher extends EventEmitter {
       this.#closed = false;
       this.#watchingFile = file.isFile();
 
-      this.#watchFile(filename);
-      if (file.isDirectory()) {
-        this.#watchFolder(filename);
+      watchTree = FSEventRecursive !== undefined && file.isDirectory();
+      if (!watchTree) {
+        this.#watchFile(filename);
+        if (file.isDirectory()) {
+          this.#watchFolder(filename);
+        }
       }
     } catch (error) {
       if (error.code === 'ENOENT') {
@@ -218,9 +273,13 @@ class FSWatcher extends EventEmitter {
       }
     }
 
+    if (watchTree) {
+      this.#watchTree(filename);
+    }
   }
 
   ref() {
+    this.#handle?.ref();
     this.#files.forEach((file) => {
       if (file instanceof StatWatcher) {
         file.ref();
@@ -229,6 +288,7 @@ class FSWatcher extends EventEmitter {
   }
 
   unref() {
+    this.#handle?.unref();
     this.#files.forEach((file) => {
       if (file instanceof StatWatcher) {
         file.unref();
@@ -24,6 +24,8 @@ const {
 const { sep } = require('path');
 const { setTimeout } = require('timers');
 const { isWindows } = require('internal/util');
+const permission = require('internal/process/permission');
+const { FSReqCallback, rmRecursive } = internalBinding('fs');
 const notEmptyErrorCodes = new SafeSet(['ENOTEMPTY', 'EEXIST', 'EPERM']);
 const retryErrorCodes = new SafeSet(
   ['EBUSY', 'EMFILE', 'ENFILE', 'ENOTEMPTY', 'EPERM']);
@@ -34,13 +36,17 @@ const separator = Buffer.from(sep);
 
 function rimraf(path, options, callback) {
   let retries = 0;
+  // The native implementation does not check permissions for every entry
+  // and does not handle the Windows specific EPERM cases.
+  const remove = options.recursive && !isWindows && !permission.isEnabled() ?
+    rimrafNative : _rimraf;
 
-  _rimraf(path, options, function CB(err) {
+  remove(path, options, function CB(err) {
     if (err) {
       if (retryErrorCodes.has(err.code) && retries < options.maxRetries) {
         retries++;
         const delay = retries * options.retryDelay;
-        return setTimeout(_rimraf, delay, path, options, CB);
+        return setTimeout(remove, delay, path, options, CB);
       }
 
       // The file is already gone.
@@ -53,6 +59,13 @@ function rimraf(path, options, callback) {
 }
 
 
+function rimrafNative(path, options, callback) {
+  const req = new FSReqCallback();
+  req.oncomplete = callback;
+  rmRecursive(path, req);
+}
+
+
 function _rimraf(path, options, callback) {
   // SunOS lets the root user unlink directories. Use lstat here to make sure
   // it's not a directory.
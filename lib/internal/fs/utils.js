@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  Array,
   ArrayIsArray,
   BigInt,
   Date,
@@ -37,6 +38,7 @@ const {
     ERR_OUT_OF_RANGE,
   },
   hideStackFrames,
+  uvErrmapGet,
 } = require('internal/errors');
 const {
   isArrayBufferView,
@@ -49,6 +51,7 @@ const {
   once,
   deprecate,
   isWindows,
+  normalizeEncoding,
 } = require('internal/util');
 const { toPathIfFileURL } = require('internal/url');
 const {
@@ -107,6 +110,8 @@ const {
     },
   },
 } = internalBinding('constants');
+const { kFsStatsFieldsNumber } = internalBinding('fs');
+const { toStringWithoutCopy } = internalBinding('buffer');
 
 // The access modes can be any of F_OK, R_OK, W_OK or X_OK. Some might not be
 // available on specific systems. They can be used in combination as well
@@ -572,6 +577,24 @@ function getStatsFromBinding(stats, offset = 0) {
   );
 }
 
+/**
+ * @param {[Float64Array | BigInt64Array, Int32Array]} result
+ * @returns {Array<BigIntStats | Stats | string>}
+ */
+function getStatsArrayFromBinding(result) {
+  const { 0: stats, 1: errors } = result;
+  const entries = new Array(errors.length);
+  for (let i = 0; i < errors.length; i++) {
+    const err = errors[i];
+    if (err === 0) {
+      entries[i] = getStatsFromBinding(stats, i * kFsStatsFieldsNumber);
+    } else {
+      entries[i] = uvErrmapGet(err)?.[0] ?? `Unknown system error ${err}`;
+    }
+  }
+  return entries;
+}
+
 class StatFs {
   constructor(type, bsize, blocks, bfree, bavail, files, ffree) {
     this.type = type;
@@ -725,6 +748,17 @@ const getValidatedPath = hideStackFrames((fileURLOrPath, propName = 'path') => {
   return path;
 });
 
+const getValidatedPaths = hideStackFrames((paths, propName = 'paths') => {
+  if (!ArrayIsArray(paths))
+    throw new ERR_INVALID_ARG_TYPE.HideStackFramesError(propName, 'Array', paths);
+
+  const validated = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    validated[i] = getValidatedPath(paths[i], `${propName}[${i}]`);
+  }
+  return validated;
+});
+
 const getValidatedFd = hideStackFrames((fd, propName = 'fd') => {
   if (ObjectIs(fd, -0)) {
     return 0;
@@ -937,6 +971,37 @@ const validatePosition = hideStackFrames((position, name, length) => {
   }
 });
 
+// Decodes the contents of a file that were read into `buffer`, which is not
+// used afterwards. Large latin1 and ASCII strings share its memory instead of
+// being copied.
+function decodeFileContents(buffer, encoding) {
+  const normalized = normalizeEncoding(encoding);
+  if (normalized === 'latin1' || normalized === 'ascii')
+    return toStringWithoutCopy(buffer, normalized);
+  return buffer.toString(encoding);
+}
+
+// Turns the result of binding.readMany() into one entry per path: the
+// contents of the file, or the error that happened while reading it.
+function getReadManyResultFromBinding(result, paths, encoding) {
+  const { 0: contents, 1: errors } = result;
+  const entries = new Array(errors.length);
+  for (let i = 0; i < errors.length; i++) {
+    const err = errors[i];
+    if (err === 0) {
+      entries[i] = encoding ? decodeFileContents(contents[i], encoding) :
+        contents[i];
+    } else {
+      entries[i] = new UVException({
+        errno: err,
+        syscall: contents[i],
+        path: paths[i],
+      });
+    }
+  }
+  return entries;
+}
+
 module.exports = {
   constants: {
     kIoMaxLength,
@@ -948,19 +1013,23 @@ module.exports = {
   assertEncoding,
   BigIntStats,  // for testing
   copyObject,
+  decodeFileContents,
   Dirent,
   DirentFromStats,
   emitRecursiveRmdirWarning,
   getDirent,
   getDirents,
   getOptions,
+  getReadManyResultFromBinding,
   getValidatedFd,
   getValidatedPath,
+  getValidatedPaths,
   handleErrorFromBinding,
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
   getStatFsFromBinding,
   getStatsFromBinding,
+  getStatsArrayFromBinding,
   stringToFlags,
   stringToSymlinkType,
   Stats: deprecate(Stats, 'fs.Stats constructor is deprecated.', 'DEP0180'),
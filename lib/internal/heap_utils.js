@@ -1,5 +1,6 @@
 'use strict';
 const {
+  ArrayPrototypeIndexOf,
   ArrayPrototypeMap,
   Symbol,
   Uint8Array,
@@ -14,6 +15,7 @@ const {
   validateObject,
   validateBoolean,
   validateFunction,
+  validateOneOf,
 } = require('internal/validators');
 const {
   codes: {
@@ -28,16 +30,26 @@ const {
   inspect,
 } = require('internal/util/inspect');
 const kHandle = Symbol('kHandle');
+// The index + 1 of a compression is its value in the options passed to C++.
+const kCompressions = ['gzip', 'zstd'];
 
 function getHeapSnapshotOptions(options = kEmptyObject) {
   validateObject(options, 'options');
   const {
     exposeInternals = false,
     exposeNumericValues = false,
+    compression,
   } = options;
   validateBoolean(exposeInternals, 'options.exposeInternals');
   validateBoolean(exposeNumericValues, 'options.exposeNumericValues');
-  return new Uint8Array([+exposeInternals, +exposeNumericValues]);
+  if (compression !== undefined) {
+    validateOneOf(compression, 'options.compression', kCompressions);
+  }
+  return new Uint8Array([
+    +exposeInternals,
+    +exposeNumericValues,
+    ArrayPrototypeIndexOf(kCompressions, compression) + 1,
+  ]);
 }
 
 class HeapSnapshotStream extends Readable {
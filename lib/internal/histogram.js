@@ -32,6 +32,7 @@ const {
 } = require('internal/errors');
 
 const {
+  validateBoolean,
   validateInteger,
   validateNumber,
   validateObject,
@@ -313,6 +314,19 @@ class RecordableHistogram extends Histogram {
     this[kHandle]?.add(other[kHandle]);
   }
 
+  /**
+   * @param {{ reset? : boolean }} [options]
+   * @returns {RecordableHistogram}
+   */
+  snapshot(options = kEmptyObject) {
+    if (this[kRecordable] === undefined)
+      throw new ERR_INVALID_THIS('RecordableHistogram');
+    validateObject(options, 'options');
+    const { reset = false } = options;
+    validateBoolean(reset, 'options.reset');
+    return createRecordableHistogram(this[kHandle].snapshot(reset));
+  }
+
   [kClone]() {
     const handle = this[kHandle];
     return {
@@ -359,7 +373,8 @@ function createRecordableHistogram(handle) {
  * @param {{
  *   lowest? : number,
  *   highest? : number,
- *   figures? : number
+ *   figures? : number,
+ *   shared? : boolean
  * }} [options]
  * @returns {RecordableHistogram}
  */
@@ -369,6 +384,7 @@ function createHistogram(options = kEmptyObject) {
     lowest = 1,
     highest = NumberMAX_SAFE_INTEGER,
     figures = 3,
+    shared = false,
   } = options;
   if (typeof lowest !== 'bigint')
     validateInteger(lowest, 'options.lowest', 1, NumberMAX_SAFE_INTEGER);
@@ -379,7 +395,9 @@ function createHistogram(options = kEmptyObject) {
     throw new ERR_INVALID_ARG_VALUE.RangeError('options.highest', highest);
   }
   validateInteger(figures, 'options.figures', 1, 5);
-  return createRecordableHistogram(new _Histogram(lowest, highest, figures));
+  validateBoolean(shared, 'options.shared');
+  return createRecordableHistogram(
+    new _Histogram(lowest, highest, figures, shared));
 }
 
 module.exports = {
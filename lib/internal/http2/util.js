@@ -210,6 +210,8 @@ const IDX_SESSION_STATE_REMOTE_WINDOW_SIZE = 5;
 const IDX_SESSION_STATE_OUTBOUND_QUEUE_SIZE = 6;
 const IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE = 7;
 const IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE = 8;
+const IDX_SESSION_STATE_BDP_ESTIMATE = 9;
+const IDX_SESSION_STATE_BDP_RTT = 10;
 const IDX_STREAM_STATE = 0;
 const IDX_STREAM_STATE_WEIGHT = 1;
 const IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT = 2;
@@ -230,7 +232,9 @@ const IDX_OPTIONS_MAX_SETTINGS = 9;
 const IDX_OPTIONS_STREAM_RESET_RATE = 10;
 const IDX_OPTIONS_STREAM_RESET_BURST = 11;
 const IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION = 12;
-const IDX_OPTIONS_FLAGS = 13;
+const IDX_OPTIONS_WRITE_COALESCING_THRESHOLD = 13;
+const IDX_OPTIONS_AUTO_WINDOW_TUNING = 14;
+const IDX_OPTIONS_FLAGS = 15;
 
 function updateOptionsBuffer(options) {
   let flags = 0;
@@ -300,6 +304,16 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION] =
       options.strictFieldWhitespaceValidation === true ? 0 : 1;
   }
+  if (typeof options.writeCoalescingThreshold === 'number') {
+    flags |= (1 << IDX_OPTIONS_WRITE_COALESCING_THRESHOLD);
+    optionsBuffer[IDX_OPTIONS_WRITE_COALESCING_THRESHOLD] =
+      MathMax(0, options.writeCoalescingThreshold);
+  }
+  if (typeof options.autoWindowTuning === 'boolean') {
+    flags |= (1 << IDX_OPTIONS_AUTO_WINDOW_TUNING);
+    optionsBuffer[IDX_OPTIONS_AUTO_WINDOW_TUNING] =
+      options.autoWindowTuning === true ? 1 : 0;
+  }
 
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
@@ -565,6 +579,10 @@ function getSessionState(session) {
       sessionState[IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE],
     inflateDynamicTableSize:
       sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE],
+    bdpEstimate:
+      sessionState[IDX_SESSION_STATE_BDP_ESTIMATE],
+    bdpRtt:
+      sessionState[IDX_SESSION_STATE_BDP_RTT],
   };
 }
 
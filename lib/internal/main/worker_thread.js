@@ -102,11 +102,14 @@ port.on('message', (message) => {
       environmentData,
       filename,
       hasStdin,
+      inheritStdio,
       publicPort,
       workerData,
       mainThreadPort,
     } = message;
 
+    workerIo.setInheritStdio(inheritStdio);
+
     if (doEval !== 'internal') {
       if (argv !== undefined) {
         ArrayPrototypePushApply(process.argv, argv);
@@ -22,6 +22,7 @@
 'use strict';
 
 const {
+  ArrayFrom,
   ArrayIsArray,
   ArrayPrototypeFilter,
   ArrayPrototypeIncludes,
@@ -152,6 +153,10 @@ const fs = require('fs');
 const path = require('path');
 const internalFsBinding = internalBinding('fs');
 const { safeGetenv } = internalBinding('credentials');
+const {
+  cacheResolution,
+  getCachedResolution,
+} = internalBinding('modules');
 const {
   getCjsConditions,
   initializeCjsConditions,
@@ -255,7 +260,7 @@ function stat(filename) {
     const result = statCache.get(filename);
     if (result !== undefined) { return result; }
   }
-  const result = internalFsBinding.internalModuleStat(filename);
+  const result = internalFsBinding.internalModuleStat(filename, true);
   if (statCache !== null && result >= 0) {
     // Only set cache when `internalModuleStat(filename)` succeeds.
     statCache.set(filename, result);
@@ -1282,10 +1287,34 @@ Module._load = function(request, parent, isMain) {
  * @property {string[]} paths Paths to search for modules in
  * @property {string[]} conditions Conditions used for resolution.
  */
+let cjsResolverConditions;
+/**
+ * Describes the options of the resolver that a resolution in the native
+ * resolution cache depends on, besides the parent directory and the request.
+ * @returns {string}
+ */
+function getCjsResolverKey() {
+  cjsResolverConditions ??= ArrayPrototypeJoin(ArrayFrom(getCjsConditions()), ',');
+  return `cjs\x00${cjsResolverConditions}\x00${getOptionValue('--preserve-symlinks')}\x00` +
+    `${ArrayPrototypeJoin(ObjectKeys(Module._extensions), ',')}\x00` +
+    ArrayPrototypeJoin(Module.globalPaths, '\x00');
+}
+
 Module._resolveFilename = function(request, parent, isMain, options) {
   if (BuiltinModule.normalizeRequirableId(request)) {
     return request;
   }
+
+  // With the compile cache enabled, resolutions from the same directory are
+  // reused by the other modules and threads of the process.
+  let resolverKey;
+  if (options === undefined && !isMain && parent?.filename && request[0] !== '#') {
+    resolverKey = getCjsResolverKey();
+    const cached = getCachedResolution(request, parent.path, resolverKey);
+    if (cached !== undefined) {
+      return cached;
+    }
+  }
   const conditions = (options?.conditions) || getCjsConditions();
 
   let paths;
@@ -1347,12 +1376,20 @@ Module._resolveFilename = function(request, parent, isMain, options) {
     const cacheKey = request + '\x00' +
          (paths.length === 1 ? paths[0] : ArrayPrototypeJoin(paths, '\x00'));
     Module._pathCache[cacheKey] = selfResolved;
+    if (resolverKey !== undefined) {
+      cacheResolution(request, parent.path, resolverKey, selfResolved, selfResolved);
+    }
     return selfResolved;
   }
 
   // Look up the filename first, since that's the cache key.
   const filename = Module._findPath(request, paths, isMain, conditions);
-  if (filename) { return filename; }
+  if (filename) {
+    if (resolverKey !== undefined) {
+      cacheResolution(request, parent.path, resolverKey, filename, filename);
+    }
+    return filename;
+  }
   const requireStack = [];
   for (let cursor = parent;
     cursor;
@@ -590,7 +590,10 @@ class ModuleLoader {
    */
   async loadAndTranslate(url, loadContext, isMain) {
     const { format, source } = await this.load(url, loadContext);
-    return this.#translate(url, format, source, isMain);
+    // Modules that are imported asynchronously can be compiled off-thread.
+    const finalFormat =
+      format === 'module' && getOptionValue('--experimental-module-streaming') ? 'module-streaming' : format;
+    return this.#translate(url, finalFormat, source, isMain);
   }
 
   /**
@@ -28,7 +28,7 @@ const { BuiltinModule } = require('internal/bootstrap/realm');
 const { realpathSync } = require('fs');
 const { getOptionValue } = require('internal/options');
 // Do not eagerly grab .manifest, it may be in TDZ
-const { sep, posix: { relative: relativePosixPath }, resolve } = require('path');
+const { dirname, sep, posix: { relative: relativePosixPath }, resolve } = require('path');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
 const inputTypeFlag = getOptionValue('--input-type');
@@ -36,6 +36,7 @@ const { URL, pathToFileURL, fileURLToPath, isURL, URLParse } = require('internal
 const { getCWDURL, setOwnProperty } = require('internal/util');
 const { canParse: URLCanParse } = internalBinding('url');
 const { legacyMainResolve: FSLegacyMainResolve } = internalBinding('fs');
+const { cacheResolution, getCachedResolution } = internalBinding('modules');
 const {
   ERR_INPUT_TYPE_NOT_ALLOWED,
   ERR_INVALID_ARG_TYPE,
@@ -50,7 +51,7 @@ const {
 } = require('internal/errors').codes;
 
 const { Module: CJSModule } = require('internal/modules/cjs/loader');
-const { getConditionsSet } = require('internal/modules/esm/utils');
+const { getConditionsSet, getDefaultConditions } = require('internal/modules/esm/utils');
 const packageJsonReader = require('internal/modules/package_json_reader');
 const internalFsBinding = internalBinding('fs');
 
@@ -249,6 +250,7 @@ function finalizeResolution(resolved, base, preserveSymlinks) {
 
   const stats = internalFsBinding.internalModuleStat(
     StringPrototypeEndsWith(internalFsBinding, path, '/') ? StringPrototypeSlice(path, -1) : path,
+    true,
   );
 
   // Check for stats.isDirectory()
@@ -927,6 +929,17 @@ function throwIfInvalidParentURL(parentURL) {
   }
 }
 
+let esmResolverKey;
+/**
+ * Describes the options of the resolver that a resolution in the native
+ * resolution cache depends on, besides the parent directory and the specifier.
+ * @returns {string}
+ */
+function getEsmResolverKey() {
+  esmResolverKey ??= `esm\x00${ArrayPrototypeJoin(getDefaultConditions(), ',')}\x00${preserveSymlinks}`;
+  return esmResolverKey;
+}
+
 /**
  * Resolves the given specifier using the provided context, which includes the parent URL and conditions.
  * Attempts to resolve the specifier and returns the resulting URL and format.
@@ -977,15 +990,32 @@ function defaultResolve(specifier, context = {}) {
     if (inputTypeFlag) { throw new ERR_INPUT_TYPE_NOT_ALLOWED(); }
   }
 
+  // With the compile cache enabled, resolutions from the same directory are
+  // reused by the other modules and threads of the process.
+  let parentPath;
+  let cached;
+  if (!isMain && parsedParentURL?.protocol === 'file:' && specifier[0] !== '#' &&
+      (conditions === undefined || conditions === getDefaultConditions())) {
+    parentPath = dirname(fileURLToPath(parsedParentURL));
+    cached = getCachedResolution(specifier, parentPath, getEsmResolverKey());
+  }
+
   conditions = getConditionsSet(conditions);
   let url;
   try {
-    url = moduleResolve(
-      specifier,
-      parentURL,
-      conditions,
-      isMain ? preserveSymlinksMain : preserveSymlinks,
-    );
+    if (cached !== undefined) {
+      url = new URL(cached);
+    } else {
+      url = moduleResolve(
+        specifier,
+        parentURL,
+        conditions,
+        isMain ? preserveSymlinksMain : preserveSymlinks,
+      );
+      if (parentPath !== undefined && url.protocol === 'file:') {
+        cacheResolution(specifier, parentPath, getEsmResolverKey(), fileURLToPath(url), url.href);
+      }
+    }
   } catch (error) {
     // Try to give the user a hint of what would have been the
     // resolved CommonJS module
@@ -4,6 +4,7 @@ const {
   ArrayPrototypePush,
   FunctionPrototypeCall,
   JSONParse,
+  JSONStringify,
   ObjectAssign,
   ObjectPrototypeHasOwnProperty,
   ReflectApply,
@@ -55,8 +56,13 @@ const {
   ERR_UNKNOWN_BUILTIN_MODULE,
 } = require('internal/errors').codes;
 const { maybeCacheSourceMap } = require('internal/source_map/source_map_cache');
+const {
+  getCompileCacheEntry,
+  saveCompileCacheEntry,
+  cachedCodeTypes: { kCommonJSExports },
+} = internalBinding('modules');
 const moduleWrap = internalBinding('module_wrap');
-const { ModuleWrap } = moduleWrap;
+const { ModuleStreamingJob, ModuleWrap } = moduleWrap;
 
 // Lazy-loading to avoid circular dependencies.
 let getSourceSync;
@@ -82,6 +88,31 @@ function initCJSParseSync() {
   }
 }
 
+/**
+ * Runs the CommonJS module lexer on the source, reusing the export names
+ * stored in the compile cache when the source has not changed since they
+ * were computed.
+ * @param {string} filename The filename of the module.
+ * @param {string} source The source code of the module.
+ * @returns {{ exports: string[], reexports: string[] }}
+ */
+function cjsParseWithCompileCache(filename, source) {
+  // The cache entry is keyed by the filename and checked against the hash
+  // of the source, see getCompileCacheEntry() in src/node_modules.cc.
+  // When the compile cache is not enabled, this returns undefined.
+  const cached = typeof source === 'string' ?
+    getCompileCacheEntry(source, filename, kCommonJSExports) : undefined;
+  if (cached?.transpiled) {
+    const { 0: exports, 1: reexports } = JSONParse(cached.transpiled);
+    return { exports, reexports };
+  }
+  const { exports, reexports } = cjsParse(source || '');
+  if (cached) {
+    saveCompileCacheEntry(cached.external, JSONStringify([exports, reexports]));
+  }
+  return { exports, reexports };
+}
+
 const translators = new SafeMap();
 exports.translators = translators;
 
@@ -108,6 +139,18 @@ translators.set('module', function moduleStrategy(url, source, isMain) {
   return module;
 });
 
+// Strategy for loading a standard JavaScript module whose source text is
+// parsed and compiled on a worker thread, see --experimental-module-streaming.
+translators.set('module-streaming', async function moduleStreamingStrategy(url, source, isMain) {
+  assertBufferSource(source, true, 'load');
+  source = stringify(source);
+  debug(`Translating StandardModule ${url} off-thread`);
+  const job = new ModuleStreamingJob(source);
+  await job.promise;
+  const { compileSourceTextModule } = require('internal/modules/esm/utils');
+  return compileSourceTextModule(url, source, this, { __proto__: null, isMain, streamingJob: job });
+});
+
 /**
  * Loads a CommonJS module via the ESM Loader sync CommonJS translator.
  * This translator creates its own version of the `require` function passed into CommonJS modules.
@@ -366,7 +409,7 @@ function cjsPreparseModuleExports(filename, source, format) {
   debug(`Preparsing exports of ${filename}`);
   let exports, reexports;
   try {
-    ({ exports, reexports } = cjsParse(source || ''));
+    ({ exports, reexports } = cjsParseWithCompileCache(filename, source));
   } catch {
     exports = [];
     reexports = [];
@@ -343,12 +343,15 @@ async function initializeHooks() {
  * @param {string} source Source code of the module.
  * @param {typeof import('./loader.js').ModuleLoader|undefined} cascadedLoader If provided,
  *        register the module for default handling.
- * @param {{ isMain?: boolean }|undefined} context - context object containing module metadata.
+ * @param {{ isMain?: boolean, streamingJob?: object }|undefined} context - context object containing module
+ *        metadata. `streamingJob` is a finished ModuleStreamingJob for the source.
  * @returns {ModuleWrap}
  */
 function compileSourceTextModule(url, source, cascadedLoader, context = kEmptyObject) {
   const hostDefinedOption = cascadedLoader ? source_text_module_default_hdo : undefined;
-  const wrap = new ModuleWrap(url, undefined, source, 0, 0, hostDefinedOption);
+  const wrap = cascadedLoader && context.streamingJob ?
+    new ModuleWrap(url, undefined, source, 0, 0, hostDefinedOption, context.streamingJob) :
+    new ModuleWrap(url, undefined, source, 0, 0, hostDefinedOption);
 
   if (!cascadedLoader) {
     return wrap;
@@ -39,6 +39,10 @@ const {
   compileCacheStatus: _compileCacheStatus,
   flushCompileCache,
 } = internalBinding('modules');
+const {
+  clearModuleStatCache,
+  getModuleStatCacheStats,
+} = internalBinding('fs');
 
 let debug = require('internal/util/debuglog').debuglog('module', (fn) => {
   debug = fn;
@@ -400,15 +404,40 @@ function getCompileCacheDir() {
   return _getCompileCacheDir() || undefined;
 }
 
+/**
+ * Drop all entries of the module resolution stat cache enabled by
+ * `--experimental-module-stat-cache`.
+ */
+function clearStatCache() {
+  clearModuleStatCache();
+}
+
+/**
+ * Get the counters of the module resolution stat cache.
+ * @returns {{ enabled: boolean, hits: number, misses: number, size: number }}
+ */
+function getStatCacheStats() {
+  const { 0: hits, 1: misses, 2: size } = getModuleStatCacheStats();
+  return {
+    __proto__: null,
+    enabled: getOptionValue('--experimental-module-stat-cache'),
+    hits,
+    misses,
+    size,
+  };
+}
+
 module.exports = {
   addBuiltinLibsToObject,
   assertBufferSource,
+  clearStatCache,
   constants,
   enableCompileCache,
   flushCompileCache,
   getBuiltinModule,
   getCjsConditions,
   getCompileCacheDir,
+  getStatCacheStats,
   initializeCjsConditions,
   loadBuiltinModule,
   makeRequireFunction,
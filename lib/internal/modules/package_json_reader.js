@@ -236,6 +236,7 @@ function getPackageJSONURL(specifier, base) {
   do {
     const stat = internalFsBinding.internalModuleStat(
       StringPrototypeSlice(packageJSONPath, 0, packageJSONPath.length - 13),
+      true,
     );
     // Check for !stat.isDirectory()
     if (stat !== 1) {
@@ -1,11 +1,19 @@
 'use strict';
 
 const {
+  SafePromisePrototypeFinally,
   StringPrototypeEndsWith,
   globalThis,
 } = primordials;
 
 const { getNearestParentPackageJSONType } = internalBinding('modules');
+const {
+  constants: {
+    NODE_BOOTSTRAP_PHASE_USER_MODULE_LOADING,
+  },
+  markBootstrapPhaseStart,
+  markBootstrapPhaseEnd,
+} = internalBinding('performance');
 const { getOptionValue } = require('internal/options');
 const path = require('path');
 const { pathToFileURL, URL } = require('internal/url');
@@ -146,10 +154,15 @@ function executeUserEntryPoint(main = process.argv[1]) {
   }
   // Unless we know we should use the ESM loader to handle the entry point per the checks in `shouldUseESMLoader`, first
   // try to run the entry point via the CommonJS loader; and if that fails under certain conditions, retry as ESM.
+  markBootstrapPhaseStart(NODE_BOOTSTRAP_PHASE_USER_MODULE_LOADING);
   if (!useESMLoader) {
     const cjsLoader = require('internal/modules/cjs/loader');
     const { wrapModuleLoad } = cjsLoader;
-    wrapModuleLoad(main, null, true);
+    try {
+      wrapModuleLoad(main, null, true);
+    } finally {
+      markBootstrapPhaseEnd(NODE_BOOTSTRAP_PHASE_USER_MODULE_LOADING);
+    }
   } else {
     const mainPath = resolvedMain || main;
     const mainURL = getOptionValue('--entry-url') ? new URL(mainPath, getCWDURL()) : pathToFileURL(mainPath);
@@ -157,7 +170,10 @@ function executeUserEntryPoint(main = process.argv[1]) {
     runEntryPointWithESMLoader((cascadedLoader) => {
       // Note that if the graph contains unsettled TLA, this may never resolve
       // even after the event loop stops running.
-      return cascadedLoader.import(mainURL, undefined, { __proto__: null }, undefined, true);
+      const promise = cascadedLoader.import(mainURL, undefined, { __proto__: null }, undefined, true);
+      return SafePromisePrototypeFinally(promise, () => {
+        markBootstrapPhaseEnd(NODE_BOOTSTRAP_PHASE_USER_MODULE_LOADING);
+      });
     });
   }
 }
@@ -143,7 +143,17 @@ function stripTypeScriptTypes(code, options = kEmptyObject) {
  * @returns {string} The processed code.
  */
 function processTypeScriptCode(code, options) {
-  const { code: transformedCode, map } = parseTypeScript(code, options);
+  return finishTypeScriptCode(parseTypeScript(code, options), options);
+}
+
+/**
+ * Attaches the source map or the source URL to the output of the parser.
+ * @param {TransformOutput} output The output of the parser.
+ * @param {TypeScriptOptions} options The configuration object.
+ * @returns {string} The processed code.
+ */
+function finishTypeScriptCode(output, options) {
+  const { code: transformedCode, map } = output;
 
   if (map) {
     return addSourceMap(transformedCode, map);
@@ -156,6 +166,37 @@ function processTypeScriptCode(code, options) {
   return transformedCode;
 }
 
+/**
+ * The last output of the parser for a module. When the format of a .ts file
+ * has to be detected, it is stripped once for the detection and once more to
+ * be run, by a different file name, so the output is reused for the latter.
+ * @type {{ source: string, options: TypeScriptOptions, output: TransformOutput } | undefined}
+ */
+let lastModuleOutput;
+
+/**
+ * Parses the TypeScript code of a module, reusing the output of the last
+ * module if it had the same source.
+ * @param {string} source TypeScript code to parse.
+ * @param {TypeScriptOptions} options The configuration object.
+ * @returns {TransformOutput} The output of the parser.
+ */
+function parseTypeScriptModule(source, options) {
+  const last = lastModuleOutput;
+  // The file name only ends up in the output of the parser through the
+  // source map.
+  if (last !== undefined && last.source === source &&
+      last.options.mode === options.mode &&
+      last.options.sourceMap === options.sourceMap &&
+      (!options.sourceMap || last.options.filename === options.filename)) {
+    lastModuleOutput = undefined;
+    return last.output;
+  }
+  const output = parseTypeScript(source, options);
+  lastModuleOutput = { source, options, output };
+  return output;
+}
+
 /**
  * Get the type enum used for compile cache.
  * @param {TypeScriptMode} mode Mode of transpilation.
@@ -206,7 +247,7 @@ function stripTypeScriptModuleTypes(source, filename) {
     filename,
   };
 
-  const transpiled = processTypeScriptCode(source, options);
+  const transpiled = finishTypeScriptCode(parseTypeScriptModule(source, options), options);
   if (cached) {
     // cached.external contains a pointer to the native cache entry.
     // The cached object would be unreachable once it's out of scope,
@@ -0,0 +1,58 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const { ClonedHistogram } = require('internal/histogram');
+
+const {
+  createEventLoopPhaseHistograms: _createEventLoopPhaseHistograms,
+  getEventLoopCallbackCounts,
+  getEventLoopStalls,
+} = internalBinding('performance');
+
+const { Providers } = internalBinding('async_wrap');
+
+/**
+ * @returns {Record<string, import('internal/histogram').Histogram>}
+ */
+function createEventLoopPhaseHistograms() {
+  const handles = _createEventLoopPhaseHistograms();
+  const histograms = {};
+  const names = ObjectKeys(handles);
+  for (let i = 0; i < names.length; i++)
+    histograms[names[i]] = new ClonedHistogram(handles[names[i]]);
+  return histograms;
+}
+
+/**
+ * @returns {Record<string, number>}
+ */
+function eventLoopCallbackCounts() {
+  const counts = getEventLoopCallbackCounts();
+  const result = {};
+  if (counts.length === 0)
+    return result;
+  const names = ObjectKeys(Providers);
+  for (let i = 0; i < names.length; i++) {
+    const count = counts[Providers[names[i]]];
+    if (count > 0)
+      result[names[i]] = count;
+  }
+  return result;
+}
+
+/**
+ * @returns {{ count: number, maxDuration: number }}
+ */
+function eventLoopStalls() {
+  const { 0: count, 1: maxDuration } = getEventLoopStalls();
+  return { count, maxDuration };
+}
+
+module.exports = {
+  createEventLoopPhaseHistograms,
+  eventLoopCallbackCounts,
+  eventLoopStalls,
+};
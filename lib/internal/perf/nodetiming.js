@@ -27,6 +27,7 @@ const {
     NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
     NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
   },
+  getBootstrapPhases,
   loopIdleTime,
   uvMetricsInfo,
 } = internalBinding('performance');
@@ -117,6 +118,13 @@ class PerformanceNodeTiming {
         },
       },
 
+      bootstrapPhases: {
+        __proto__: null,
+        enumerable: true,
+        configurable: true,
+        get: () => ({ ...getBootstrapPhases() }),
+      },
+
       idleTime: {
         __proto__: null,
         enumerable: true,
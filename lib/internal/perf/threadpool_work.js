@@ -0,0 +1,33 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const { ClonedHistogram } = require('internal/histogram');
+
+const {
+  createThreadPoolWorkHistograms: _createThreadPoolWorkHistograms,
+} = internalBinding('performance');
+
+/**
+ * @returns {Record<string, {
+ *   queueWait: import('internal/histogram').Histogram,
+ *   runTime: import('internal/histogram').Histogram,
+ * }>}
+ */
+function createThreadPoolWorkHistograms() {
+  const handles = _createThreadPoolWorkHistograms();
+  const histograms = {};
+  const names = ObjectKeys(handles);
+  for (let i = 0; i < names.length; i++) {
+    const { 0: queueWait, 1: runTime } = handles[names[i]];
+    histograms[names[i]] = {
+      queueWait: new ClonedHistogram(queueWait),
+      runTime: new ClonedHistogram(runTime),
+    };
+  }
+  return histograms;
+}
+
+module.exports = createThreadPoolWorkHistograms;
@@ -0,0 +1,59 @@
+'use strict';
+
+// With --experimental-async-stdio, the data written to process.stdout and
+// process.stderr is handed to a native writer that buffers it and writes it
+// to the file descriptor from a separate thread (see src/node_stdio_writer.cc).
+
+const {
+  ObjectDefineProperty,
+} = primordials;
+
+const { Buffer } = require('buffer');
+const {
+  start,
+  writeBuffer,
+  writeUtf8String,
+  flush,
+  getDroppedBytes,
+} = internalBinding('stdio_writer');
+
+function enableAsyncStdio(stream, fd, mode, bufferSize) {
+  start(fd, bufferSize, mode === 'drop');
+
+  stream._write = function(chunk, encoding, cb) {
+    if (typeof chunk !== 'string') {
+      writeBuffer(fd, chunk);
+    } else if (encoding === 'utf8') {
+      writeUtf8String(fd, chunk);
+    } else {
+      writeBuffer(fd, Buffer.from(chunk, encoding));
+    }
+    cb();
+  };
+  stream._writev = null;
+
+  // Make sure that everything has been written before e.g. a pipe is shut
+  // down.
+  const final = stream._final;
+  stream._final = function(cb) {
+    flush(fd);
+    if (typeof final === 'function') {
+      final.call(this, cb);
+    } else {
+      cb();
+    }
+  };
+
+  ObjectDefineProperty(stream, 'droppedBytes', {
+    __proto__: null,
+    configurable: true,
+    enumerable: false,
+    get() {
+      return getDroppedBytes(fd);
+    },
+  });
+}
+
+module.exports = {
+  enableAsyncStdio,
+};
@@ -108,8 +108,6 @@ function wrapProcessMethods(binding) {
   const {
     cpuUsage: _cpuUsage,
     threadCpuUsage: _threadCpuUsage,
-    memoryUsage: _memoryUsage,
-    rss,
     resourceUsage: _resourceUsage,
     loadEnvFile: _loadEnvFile,
     execve: _execve,
@@ -212,9 +210,11 @@ function wrapProcessMethods(binding) {
         num >= 0;
   }
 
-  const memValues = new Float64Array(5);
+  // The memory usage values are written into a buffer shared with the
+  // binding, so polling does not allocate anything besides the result.
+  const memValues = binding.memoryUsageBuffer;
   function memoryUsage() {
-    _memoryUsage(memValues);
+    binding.memoryUsage();
     return {
       rss: memValues[0],
       heapTotal: memValues[1],
@@ -224,6 +224,10 @@ function wrapProcessMethods(binding) {
     };
   }
 
+  function rss() {
+    return binding.rss();
+  }
+
   memoryUsage.rss = rss;
 
   function exit(code) {
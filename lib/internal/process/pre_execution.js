@@ -146,9 +146,14 @@ function prepareExecution(options) {
     // channel. This needs to be done before any user code gets executed
     // (including preload modules).
     initializeClusterIPC();
+    setupWorkerIsolatePool();
 
     // TODO(joyeecheung): do this for worker threads as well.
-    runDeserializeCallbacks();
+    // When a snapshot is built on top of a base snapshot, the deserialize
+    // callbacks of the base are kept for the snapshot being built.
+    if (!isBuildingSnapshot()) {
+      runDeserializeCallbacks();
+    }
   } else {
     assert(!internalBinding('worker').isMainThread);
     // The setup should be called in LOAD_SCRIPT message handler.
@@ -419,6 +424,7 @@ function initializeReportSignalHandlers() {
 function initializeHeapSnapshotSignalHandlers() {
   const signal = getOptionValue('--heapsnapshot-signal');
   const diagnosticDir = getOptionValue('--diagnostic-dir');
+  const compression = getOptionValue('--heapsnapshot-compression') || undefined;
 
   if (!signal)
     return;
@@ -427,8 +433,9 @@ function initializeHeapSnapshotSignalHandlers() {
   const { writeHeapSnapshot } = require('v8');
 
   function doWriteHeapSnapshot() {
-    const heapSnapshotFilename = getHeapSnapshotFilename(diagnosticDir);
-    writeHeapSnapshot(heapSnapshotFilename);
+    const heapSnapshotFilename =
+      getHeapSnapshotFilename(diagnosticDir, compression);
+    writeHeapSnapshot(heapSnapshotFilename, { compression });
   }
   process.on(signal, doWriteHeapSnapshot);
 
@@ -441,6 +448,15 @@ function initializeHeapSnapshotSignalHandlers() {
   }
 }
 
+function setupWorkerIsolatePool() {
+  const size = getOptionValue('--experimental-worker-isolate-pool');
+  if (size === 0 || isBuildingSnapshot()) {
+    return;
+  }
+  const maxUses = getOptionValue('--experimental-worker-isolate-pool-max-uses');
+  internalBinding('worker').startIsolatePool(size, maxUses);
+}
+
 function setupTraceCategoryState() {
   const { isTraceCategoryEnabled } = internalBinding('trace_events');
   const { toggleTraceCategoryState } = require('internal/process/per_thread');
@@ -695,7 +711,7 @@ function markBootstrapComplete() {
 let sequenceNumOfheapSnapshot = 0;
 
 // To generate the HeapSnapshotFilename while using custom diagnosticDir
-function getHeapSnapshotFilename(diagnosticDir) {
+function getHeapSnapshotFilename(diagnosticDir, compression) {
   if (!diagnosticDir) return undefined;
 
   const date = new Date();
@@ -713,7 +729,11 @@ function getHeapSnapshotFilename(diagnosticDir) {
   const threadId = internalBinding('worker').threadId;
   const fileSequence = (++sequenceNumOfheapSnapshot).toString().padStart(3, '0');
 
-  return `${diagnosticDir}/Heap.${dateString}.${timeString}.${pid}.${threadId}.${fileSequence}.heapsnapshot`;
+  let extension = 'heapsnapshot';
+  if (compression === 'gzip') extension += '.gz';
+  else if (compression === 'zstd') extension += '.zst';
+
+  return `${diagnosticDir}/Heap.${dateString}.${timeString}.${pid}.${threadId}.${fileSequence}.${extension}`;
 }
 
 module.exports = {
@@ -16,24 +16,33 @@ const {
 } = require('internal/validators');
 const nr = internalBinding('report');
 
+function writeReportArgs(file, err) {
+  if (typeof file === 'object' && file !== null) {
+    err = file;
+    file = undefined;
+  } else if (file !== undefined) {
+    validateString(file, 'file');
+    file = getValidatedPath(file);
+  }
+
+  if (err === undefined) {
+    err = new ERR_SYNTHETIC();
+  } else {
+    validateObject(err, 'err');
+  }
+
+  return { file, err };
+}
+
 const report = {
   writeReport(file, err) {
-    if (typeof file === 'object' && file !== null) {
-      err = file;
-      file = undefined;
-    } else if (file !== undefined) {
-      validateString(file, 'file');
-      file = getValidatedPath(file);
-    }
-
-    if (err === undefined) {
-      err = new ERR_SYNTHETIC();
-    } else {
-      validateObject(err, 'err');
-    }
-
+    ({ file, err } = writeReportArgs(file, err));
     return nr.writeReport('JavaScript API', 'API', file, err);
   },
+  writeReportAsync(file, err) {
+    ({ file, err } = writeReportArgs(file, err));
+    return nr.writeReportAsync('JavaScript API', 'API', file, err);
+  },
   getReport(err) {
     if (err === undefined)
       err = new ERR_SYNTHETIC();
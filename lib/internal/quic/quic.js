@@ -10,6 +10,7 @@ const {
   ArrayPrototypePush,
   BigInt,
   ObjectDefineProperties,
+  ObjectFreeze,
   SafeSet,
   SymbolAsyncDispose,
   Uint8Array,
@@ -31,6 +32,7 @@ const {
   Endpoint: Endpoint_,
   Http3Application: Http3,
   setCallbacks,
+  http3HeaderNames,
 
   // The constants to be exposed to end users for various options.
   CC_ALGO_RENO_STR,
@@ -52,6 +54,7 @@ const {
   CLOSECONTEXT_RECEIVE_FAILURE: kCloseContextReceiveFailure,
   CLOSECONTEXT_SEND_FAILURE: kCloseContextSendFailure,
   CLOSECONTEXT_START_FAILURE: kCloseContextStartFailure,
+  QUIC_STREAM_HEADER_TOKEN_FLAG: kHeaderTokenFlag,
 } = internalBinding('quic');
 
 const {
@@ -63,6 +66,8 @@ const {
   Buffer,
 } = require('buffer');
 
+const { FastBuffer } = require('internal/buffer');
+
 const {
   codes: {
     ERR_ILLEGAL_CONSTRUCTOR,
@@ -108,6 +113,8 @@ const {
   buildNgHeaderString,
 } = require('internal/http2/util');
 
+const { ClonedHistogram } = require('internal/histogram');
+
 const kEmptyObject = { __proto__: null };
 
 const {
@@ -195,6 +202,7 @@ const onSessionHandshakeChannel = dc.channel('quic.session.handshake');
  * @property {string|SocketAddress} [address] The local address to bind to
  * @property {bigint|number} [addressLRUSize] The size of the address LRU cache
  * @property {boolean} [ipv6Only] Use IPv6 only
+ * @property {boolean} [reusePort] Share the local address with other endpoints
  * @property {bigint|number} [maxConnectionsPerHost] The maximum number of connections per host
  * @property {bigint|number} [maxConnectionsTotal] The maximum number of total connections
  * @property {bigint|number} [maxRetries] The maximum number of retries
@@ -258,6 +266,7 @@ const onSessionHandshakeChannel = dc.channel('quic.session.handshake');
  * @property {ArrayBuffer|ArrayBufferView|Array<ArrayBuffer|ArrayBufferView>} [certs] The certificates
  * @property {ArrayBuffer|ArrayBufferView|Array<ArrayBuffer|ArrayBufferView>} [ca] The certificate authority
  * @property {ArrayBuffer|ArrayBufferView|Array<ArrayBuffer|ArrayBufferView>} [crl] The certificate revocation list
+ * @property {ArrayBuffer|ArrayBufferView|Array<ArrayBuffer|ArrayBufferView>} [ticketKeys] The session ticket keys
  * @property {boolean} [qlog] Enable qlog
  * @property {ArrayBufferView} [sessionTicket] The session ticket
  * @property {bigint|number} [handshakeTimeout] The handshake timeout
@@ -266,6 +275,15 @@ const onSessionHandshakeChannel = dc.channel('quic.session.handshake');
  * @property {bigint|number} [maxPayloadSize] The maximum payload size
  * @property {bigint|number} [unacknowledgedPacketThreshold] The unacknowledged packet threshold
  * @property {'reno'|'cubic'|'bbr'} [cc] The congestion control algorithm
+ * @property {boolean} [recordMetrics] Record RTT, cwnd and pacing histograms
+ * @property {boolean} [pacing] Send packets in smaller, paced bursts
+ */
+
+/**
+ * @typedef {object} QuicSessionMetrics
+ * @property {Histogram} rtt The RTT samples, in nanoseconds
+ * @property {Histogram} cwnd The congestion window sizes, in bytes
+ * @property {Histogram} pacingDelay The pacing delays, in nanoseconds
  */
 
 /**
@@ -355,6 +373,7 @@ const onSessionHandshakeChannel = dc.channel('quic.session.handshake');
  * @property {number} [udpTTL] The UDP TTL
  * @property {boolean} [validateAddress] Validate the address
  * @property {boolean} [ipv6Only] Use IPv6 only
+ * @property {boolean} [reusePort] Share the local address with other endpoints
  * @property {ArrayBufferView} [resetTokenSecret] The reset token secret
  * @property {ArrayBufferView} [tokenSecret] The token secret
  */
@@ -556,6 +575,45 @@ function validateBody(body) {
   ], body);
 }
 
+/**
+ * The native stream delivers a block of headers as a Uint32Array of the
+ * offsets at which each name and value ends in the Latin-1 buffer that
+ * precedes the offsets in the same ArrayBuffer. Names that were received as
+ * a QPACK token are not in the buffer, their offset is kHeaderTokenFlag plus
+ * the token instead. See Stream::EmitHeaders() in src/quic/streams.cc.
+ * @param {Uint32Array} offsets
+ * @returns {object}
+ */
+function decodeHeaders(offsets) {
+  assert(offsets.length % 2 === 0);
+  const buffer = new FastBuffer(offsets.buffer, 0, offsets.byteOffset);
+  const block = {
+    __proto__: null,
+  };
+  let start = 0;
+  for (let n = 0; n + 1 < offsets.length; n += 2) {
+    let name;
+    const nameEnd = offsets[n];
+    if (nameEnd >= kHeaderTokenFlag) {
+      name = http3HeaderNames[nameEnd - kHeaderTokenFlag];
+    } else {
+      name = buffer.latin1Slice(start, nameEnd);
+      start = nameEnd;
+    }
+    const value = buffer.latin1Slice(start, offsets[n + 1]);
+    start = offsets[n + 1];
+    const existing = block[name];
+    if (existing === undefined) {
+      block[name] = value;
+    } else if (ArrayIsArray(existing)) {
+      ArrayPrototypePush(existing, value);
+    } else {
+      block[name] = [existing, value];
+    }
+  }
+  return block;
+}
+
 class QuicStream {
   /** @type {object} */
   #handle;
@@ -832,20 +890,7 @@ class QuicStream {
     // The headers event should only be called if the stream was created with
     // an onheaders callback. The callback should always exist here.
     assert(this.#onheaders, 'Unexpected stream headers event');
-    assert(ArrayIsArray(headers));
-    assert(headers.length % 2 === 0);
-    const block = {
-      __proto__: null,
-    };
-    for (let n = 0; n + 1 < headers.length; n += 2) {
-      if (block[headers[n]] !== undefined) {
-        block[headers[n]] = [block[headers[n]], headers[n + 1]];
-      } else {
-        block[headers[n]] = headers[n + 1];
-      }
-    }
-
-    this.#onheaders(block, kind);
+    this.#onheaders(decodeHeaders(headers), kind);
   }
 
   [kTrailers]() {
@@ -898,6 +943,8 @@ class QuicSession {
   #ondatagram = undefined;
   /** @type {{}} */
   #sessionticket = undefined;
+  /** @type {QuicSessionMetrics|undefined} */
+  #metrics = undefined;
 
   /**
    * @param {symbol} privateSymbol
@@ -918,6 +965,15 @@ class QuicSession {
     this.#state.hasVersionNegotiationListener = true;
     this.#state.hasPathValidationListener = true;
     this.#state.hasSessionTicketListener = true;
+    if (handle.metrics !== undefined) {
+      const { 0: rtt, 1: cwnd, 2: pacingDelay } = handle.metrics;
+      this.#metrics = ObjectFreeze({
+        __proto__: null,
+        rtt: new ClonedHistogram(rtt),
+        cwnd: new ClonedHistogram(cwnd),
+        pacingDelay: new ClonedHistogram(pacingDelay),
+      });
+    }
 
     debug('session created');
   }
@@ -959,6 +1015,13 @@ class QuicSession {
   /** @type {QuicSessionStats} */
   get stats() { return this.#stats; }
 
+  /**
+   * The histograms recorded when the session was created with the
+   * `recordMetrics` option, or undefined.
+   * @type {QuicSessionMetrics|undefined}
+   */
+  get metrics() { return this.#metrics; }
+
   /** @type {QuicSessionState} */
   get [kState]() { return this.#state; }
 
@@ -1521,6 +1584,7 @@ class QuicEndpoint {
       udpTTL,
       validateAddress,
       ipv6Only,
+      reusePort,
       cc,
       resetTokenSecret,
       tokenSecret,
@@ -1554,6 +1618,7 @@ class QuicEndpoint {
       udpTTL,
       validateAddress,
       ipv6Only,
+      reusePort,
       cc,
       resetTokenSecret,
       tokenSecret,
@@ -1627,6 +1692,27 @@ class QuicEndpoint {
     }
   }
 
+  /**
+   * Replaces the secret used to generate new retry and regular tokens. Tokens
+   * generated with the previous secret are still accepted until they expire.
+   * @param {ArrayBufferView} [secret] The new 16-byte secret. If not specified,
+   *   a random secret is used.
+   */
+  rotateTokenSecret(secret) {
+    if (this.#isClosedOrClosing) {
+      throw new ERR_INVALID_STATE('Endpoint is closed');
+    }
+    if (secret !== undefined) {
+      if (!isArrayBufferView(secret)) {
+        throw new ERR_INVALID_ARG_TYPE('secret', 'ArrayBufferView', secret);
+      }
+      if (secret.byteLength !== 16) {
+        throw new ERR_INVALID_ARG_VALUE('secret', secret, 'must be exactly 16 bytes');
+      }
+    }
+    this.#handle.rotateTokenSecret(secret);
+  }
+
   /**
    * The local address the endpoint is bound to (if any)
    * @type {SocketAddress|undefined}
@@ -1929,6 +2015,7 @@ function processTlsOptions(tls, forServer) {
     certs,
     ca,
     crl,
+    ticketKeys,
   } = tls;
 
   if (servername !== undefined) {
@@ -1978,6 +2065,20 @@ function processTlsOptions(tls, forServer) {
     }
   }
 
+  if (ticketKeys !== undefined) {
+    const ticketKeyInputs = ArrayIsArray(ticketKeys) ? ticketKeys : [ticketKeys];
+    for (const ticketKey of ticketKeyInputs) {
+      if (!isArrayBufferView(ticketKey) && !isArrayBuffer(ticketKey)) {
+        throw new ERR_INVALID_ARG_TYPE('options.ticketKeys',
+                                       ['ArrayBufferView', 'ArrayBuffer'], ticketKey);
+      }
+      if (ticketKey.byteLength !== 48) {
+        throw new ERR_INVALID_ARG_VALUE('options.ticketKeys', ticketKey,
+                                        'must be exactly 48 bytes');
+      }
+    }
+  }
+
   const keyHandles = [];
   if (keys !== undefined) {
     const keyInputs = ArrayIsArray(keys) ? keys : [keys];
@@ -2022,6 +2123,7 @@ function processTlsOptions(tls, forServer) {
     certs,
     ca,
     crl,
+    ticketKeys,
   };
 }
 
@@ -2059,11 +2161,24 @@ function processSessionOptions(options, forServer = false) {
     maxStreamWindow,
     maxWindow,
     cc,
+    recordMetrics = false,
+    pacing = false,
+    application,
+  } = options;
+  let {
     [kApplicationProvider]: provider,
   } = options;
 
+  validateBoolean(recordMetrics, 'options.recordMetrics');
+  validateBoolean(pacing, 'options.pacing');
+
   if (provider !== undefined) {
     validateObject(provider, 'options[kApplicationProvider]');
+  } else if (application !== undefined) {
+    // The application options configure the HTTP/3 application, including
+    // its QPACK settings.
+    validateObject(application, 'options.application');
+    provider = new Http3(application);
   }
 
   if (cc !== undefined) {
@@ -2096,6 +2211,8 @@ function processSessionOptions(options, forServer = false) {
     sessionTicket,
     provider,
     cc,
+    recordMetrics,
+    pacing,
   };
 }
 
@@ -48,6 +48,7 @@ const {
   IDX_STATS_ENDPOINT_VERSION_NEGOTIATION_COUNT,
   IDX_STATS_ENDPOINT_STATELESS_RESET_COUNT,
   IDX_STATS_ENDPOINT_IMMEDIATE_CLOSE_COUNT,
+  IDX_STATS_ENDPOINT_FORWARDED_PACKET_COUNT,
 
   IDX_STATS_SESSION_CREATED_AT,
   IDX_STATS_SESSION_CLOSING_AT,
@@ -99,6 +100,7 @@ assert(IDX_STATS_ENDPOINT_RETRY_COUNT !== undefined);
 assert(IDX_STATS_ENDPOINT_VERSION_NEGOTIATION_COUNT !== undefined);
 assert(IDX_STATS_ENDPOINT_STATELESS_RESET_COUNT !== undefined);
 assert(IDX_STATS_ENDPOINT_IMMEDIATE_CLOSE_COUNT !== undefined);
+assert(IDX_STATS_ENDPOINT_FORWARDED_PACKET_COUNT !== undefined);
 assert(IDX_STATS_SESSION_CREATED_AT !== undefined);
 assert(IDX_STATS_SESSION_CLOSING_AT !== undefined);
 assert(IDX_STATS_SESSION_HANDSHAKE_COMPLETED_AT !== undefined);
@@ -221,6 +223,11 @@ class QuicEndpointStats {
     return this.#handle[IDX_STATS_ENDPOINT_IMMEDIATE_CLOSE_COUNT];
   }
 
+  /** @type {bigint} */
+  get forwardedPacketCount() {
+    return this.#handle[IDX_STATS_ENDPOINT_FORWARDED_PACKET_COUNT];
+  }
+
   toString() {
     return JSONStringify(this.toJSON());
   }
@@ -244,6 +251,7 @@ class QuicEndpointStats {
       versionNegotiationCount: `${this.versionNegotiationCount}`,
       statelessResetCount: `${this.statelessResetCount}`,
       immediateCloseCount: `${this.immediateCloseCount}`,
+      forwardedPacketCount: `${this.forwardedPacketCount}`,
     };
   }
 
@@ -271,6 +279,7 @@ class QuicEndpointStats {
       versionNegotiationCount: this.versionNegotiationCount,
       statelessResetCount: this.statelessResetCount,
       immediateCloseCount: this.immediateCloseCount,
+      forwardedPacketCount: this.forwardedPacketCount,
     }, opts)}`;
   }
 
@@ -56,6 +56,7 @@ const {
   getStringWidth,
   stripVTControlCharacters,
 } = require('internal/util/inspect');
+const { isUint8Array } = require('internal/util/types');
 const EventEmitter = require('events');
 const { addAbortListener } = require('internal/events/abort_listener');
 const {
@@ -73,6 +74,10 @@ const {
 } = require('internal/readline/callbacks');
 
 const { StringDecoder } = require('string_decoder');
+const {
+  findLineBreaks,
+  utf8Slice,
+} = internalBinding('buffer');
 const { ReplHistory } = require('internal/repl/history');
 
 const kMaxUndoRedoStackSize = 2048;
@@ -120,6 +125,7 @@ const kKillRing = Symbol('_killRing');
 const kKillRingCursor = Symbol('_killRingCursor');
 const kMoveCursor = Symbol('_moveCursor');
 const kNormalWrite = Symbol('_normalWrite');
+const kNormalWriteBuffer = Symbol('_normalWriteBuffer');
 const kOldPrompt = Symbol('_oldPrompt');
 const kOnLine = Symbol('_onLine');
 const kSetLine = Symbol('_setLine');
@@ -617,6 +623,12 @@ class Interface extends InterfaceConstructor {
     if (b === undefined) {
       return;
     }
+    // A chunk that doesn't end within a character, and that doesn't complete
+    // one, can be split into lines before it is decoded.
+    if (isUint8Array(b) && b.length > 0 && b[b.length - 1] < 0x80 &&
+        this[kDecoder].lastNeed === 0 && this[kNormalWriteBuffer](b)) {
+      return;
+    }
     let string = this[kDecoder].write(b);
     if (
       this[kSawReturnAt] &&
@@ -660,6 +672,51 @@ class Interface extends InterfaceConstructor {
     }
   }
 
+  // Same as [kNormalWrite](), but with the line breaks found in the chunk
+  // by native code. Returns false if the chunk is too large for that.
+  [kNormalWriteBuffer](b) {
+    let start = 0;
+    if (
+      this[kSawReturnAt] &&
+      DateNow() - this[kSawReturnAt] <= this.crlfDelay
+    ) {
+      if (b[0] === 10) start = 1;
+      this[kSawReturnAt] = 0;
+    }
+
+    const breaks = findLineBreaks(b, start);
+    if (breaks === undefined) {
+      return false;
+    }
+    if (breaks.length === 0) {
+      // No newlines this time, save what we have for next time
+      const string = FunctionPrototypeCall(utf8Slice, b, start, b.length);
+      if (this[kLine_buffer]) {
+        this[kLine_buffer] += string;
+      } else if (string) {
+        this[kLine_buffer] = string;
+      }
+      return true;
+    }
+
+    this[kSawReturnAt] = b[b.length - 1] === 13 ? DateNow() : 0;
+
+    let line = FunctionPrototypeCall(utf8Slice, b, start, breaks[0]);
+    if (this[kLine_buffer]) {
+      line = this[kLine_buffer] + line;
+    }
+    const lastIndex = breaks.length - 1;
+    // Either '' or (conceivably) the unfinished portion of the next line
+    this[kLine_buffer] =
+      FunctionPrototypeCall(utf8Slice, b, breaks[lastIndex], b.length);
+    this[kOnLine](line);
+    for (let i = 2; i < lastIndex; i += 2) {
+      this[kOnLine](FunctionPrototypeCall(utf8Slice, b, breaks[i - 1],
+                                          breaks[i]));
+    }
+    return true;
+  }
+
   [kInsertString](c) {
     this[kBeforeEdit](this.line, this.cursor);
     if (this.cursor < this.line.length) {
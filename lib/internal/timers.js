@@ -65,19 +65,19 @@
 // after the first one encountered that does not yet need to timeout will also
 // always be due to timeout at a later time.
 //
-// Less-than constant time operations are thus contained in two places:
-// The PriorityQueue — an efficient binary heap implementation that does all
-// operations in worst-case O(log n) time — which manages the order of expiring
-// Timeout lists and the object map lookup of a specific list by the duration of
-// timers within (or creation of a new list). However, these operations combined
-// have shown to be trivial in comparison to other timers architectures.
+// The order in which the lists expire is kept in C++, in a hierarchical timing
+// wheel (see src/timer_wheel.h) that schedules, reschedules and cancels a list
+// in constant time, and that hands all the lists that expired to JS in one
+// call. Lists are identified in the wheel by small integer ids, which are
+// reused once a list is removed.
 
 const {
+  ArrayPrototypePop,
+  ArrayPrototypePush,
   MathMax,
   MathTrunc,
   NumberIsFinite,
   NumberIsNaN,
-  NumberMIN_SAFE_INTEGER,
   ReflectApply,
   Symbol,
 } = primordials;
@@ -115,7 +115,6 @@ const {
 } = require('internal/validators');
 
 const L = require('internal/linkedlist');
-const PriorityQueue = require('internal/priority_queue');
 
 const { inspect } = require('internal/util/inspect');
 let debug = require('internal/util/debuglog').debuglog('timer', (fn) => {
@@ -134,8 +133,6 @@ const kHasOutstanding = 2;
 // Timeout values > TIMEOUT_MAX are set to 1.
 const TIMEOUT_MAX = 2 ** 31 - 1;
 
-let timerListId = NumberMIN_SAFE_INTEGER;
-
 const kRefed = Symbol('refed');
 
 let nextExpiry = Infinity;
@@ -145,10 +142,10 @@ let nextExpiry = Infinity;
 // the JS-C++ boundary, which is slow at the time of writing.
 timeoutInfo[0] = 0;
 
-// This is a priority queue with a custom sorting function that first compares
-// the expiry times of two lists and if they're the same then compares their
-// individual IDs to determine which list was created first.
-const timerListQueue = new PriorityQueue(compareTimersLists, setPosition);
+// The lists by the ids under which they are scheduled in the timing wheel,
+// and the ids of removed lists, which are reused first.
+const timerListsById = [];
+const freeTimerListIds = [];
 
 // Object map containing linked lists of timers, keyed and sorted by their
 // duration in milliseconds.
@@ -269,9 +266,10 @@ class TimersList {
     this._idleNext = this; // Create the list with the linkedlist properties to
     this._idlePrev = this; // Prevent any unnecessary hidden class changes.
     this.expiry = expiry;
-    this.id = timerListId++;
+    this.id = freeTimerListIds.length > 0 ?
+      ArrayPrototypePop(freeTimerListIds) : timerListsById.length;
     this.msecs = msecs;
-    this.priorityQueuePosition = null;
+    timerListsById[this.id] = this;
   }
 
   // Make sure the linked list only shows the minimal necessary information.
@@ -396,7 +394,8 @@ function insert(item, msecs, start = binding.getLibuvNow()) {
     debug('no %d list was found in insert, creating a new one', msecs);
     const expiry = start + msecs;
     timerListMap[msecs] = list = new TimersList(expiry, msecs);
-    timerListQueue.insert(list);
+    // We need to use the binding as the receiver for fast API calls.
+    binding.scheduleTimerList(list.id, expiry);
 
     if (nextExpiry > expiry) {
       // We need to use the binding as the receiver for fast API calls.
@@ -436,16 +435,13 @@ function getTimerDuration(msecs, name) {
   return msecs;
 }
 
-function compareTimersLists(a, b) {
-  const expiryDiff = a.expiry - b.expiry;
-  if (expiryDiff === 0) {
-    return a.id - b.id;
-  }
-  return expiryDiff;
-}
-
-function setPosition(node, pos) {
-  node.priorityQueuePosition = pos;
+// Removes an empty list from the object map and from the timing wheel.
+function removeTimersList(list) {
+  delete timerListMap[list.msecs];
+  // We need to use the binding as the receiver for fast API calls.
+  binding.cancelTimerList(list.id);
+  timerListsById[list.id] = undefined;
+  ArrayPrototypePush(freeTimerListIds, list.id);
 }
 
 function getTimerCallbacks(runNextTicks) {
@@ -525,24 +521,43 @@ function getTimerCallbacks(runNextTicks) {
   }
 
 
+  // The ids of the lists that expired and have not been processed yet. They
+  // are kept across calls, as processTimers() is called again with the same
+  // `now` if a timer throws.
+  let expiredLists = [];
+  let expiredListIndex = 0;
+
   function processTimers(now) {
     debug('process timer lists %d', now);
     nextExpiry = Infinity;
 
-    let list;
+    if (expiredListIndex === expiredLists.length) {
+      expiredLists = binding.expireTimerLists(now);
+      expiredListIndex = 0;
+    }
+
     let ranAtLeastOneList = false;
-    while ((list = timerListQueue.peek()) != null) {
-      if (list.expiry > now) {
-        nextExpiry = list.expiry;
-        return timeoutInfo[0] > 0 ? nextExpiry : -nextExpiry;
+    while (expiredListIndex < expiredLists.length) {
+      const list = timerListsById[expiredLists[expiredListIndex]];
+      // Skip the lists that were removed while earlier ones were processed,
+      // including when their ids were reused by new lists, which cannot have
+      // expired yet.
+      if (list !== undefined && list.expiry <= now) {
+        if (ranAtLeastOneList)
+          runNextTicks();
+        else
+          ranAtLeastOneList = true;
+        listOnTimeout(list, now);
       }
-      if (ranAtLeastOneList)
-        runNextTicks();
-      else
-        ranAtLeastOneList = true;
-      listOnTimeout(list, now);
+      expiredListIndex++;
     }
-    return 0;
+
+    // We need to use the binding as the receiver for fast API calls.
+    const expiry = binding.getNextTimerListExpiry();
+    if (expiry === -1)
+      return 0;
+    nextExpiry = expiry;
+    return timeoutInfo[0] > 0 ? nextExpiry : -nextExpiry;
   }
 
   function listOnTimeout(list, now) {
@@ -559,8 +574,8 @@ function getTimerCallbacks(runNextTicks) {
       // This happens if there are more timers scheduled for later in the list.
       if (diff < msecs) {
         list.expiry = MathMax(timer._idleStart + msecs, now + 1);
-        list.id = timerListId++;
-        timerListQueue.percolateDown(1);
+        // We need to use the binding as the receiver for fast API calls.
+        binding.scheduleTimerList(list.id, list.expiry);
         debug('%d list wait because diff is %d', msecs, diff);
         return;
       }
@@ -634,15 +649,14 @@ function getTimerCallbacks(runNextTicks) {
     // If `L.peek(list)` returned nothing, the list was either empty or we have
     // called all of the timer timeouts.
     // As such, we can remove the list from the object map and
-    // the PriorityQueue.
+    // the timing wheel.
     debug('%d list empty', msecs);
 
     // The current list may have been removed and recreated since the reference
     // to `list` was created. Make sure they're the same instance of the list
     // before destroying.
     if (list === timerListMap[msecs]) {
-      delete timerListMap[msecs];
-      timerListQueue.shift();
+      removeTimersList(list);
     }
   }
 
@@ -720,7 +734,7 @@ module.exports = {
   unrefActive,
   insert,
   timerListMap,
-  timerListQueue,
+  removeTimersList,
   decRefCount,
   incRefCount,
   knownTimersById,
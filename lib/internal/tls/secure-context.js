@@ -36,6 +36,11 @@ const {
   toBuf,
 } = require('internal/crypto/util');
 
+const {
+  SessionCache,
+  kHandle: kSessionCacheHandle,
+} = require('internal/tls/session-cache');
+
 const {
   crypto: {
     TLS1_2_VERSION,
@@ -143,6 +148,7 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     pfx,
     privateKeyIdentifier,
     privateKeyEngine,
+    sessionCache,
     sessionIdContext,
     sessionTimeout,
     sigalgs,
@@ -319,6 +325,15 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     validateInt32(sessionTimeout, `${name}.sessionTimeout`, 0);
     context.setSessionTimeout(sessionTimeout);
   }
+
+  if (sessionCache !== undefined && sessionCache !== null) {
+    if (!(sessionCache instanceof SessionCache)) {
+      throw new ERR_INVALID_ARG_TYPE(`${name}.sessionCache`,
+                                     'SessionCache',
+                                     sessionCache);
+    }
+    context.setSessionCache(sessionCache[kSessionCacheHandle]);
+  }
 }
 
 module.exports = {
@@ -0,0 +1,96 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+  Symbol,
+} = primordials;
+
+const {
+  SessionCache: SessionCacheHandle,
+} = internalBinding('crypto');
+
+const {
+  codes: {
+    ERR_INVALID_ARG_VALUE,
+  },
+} = require('internal/errors');
+
+const {
+  kEmptyObject,
+} = require('internal/util');
+
+const {
+  validateBuffer,
+  validateObject,
+  validateUint32,
+} = require('internal/validators');
+
+const {
+  markTransferMode,
+  kClone,
+  kDeserialize,
+} = require('internal/worker/js_transferable');
+
+const kHandle = Symbol('kHandle');
+
+class SessionCache {
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const { maxSessions = 20 * 1024 } = options;
+    validateUint32(maxSessions, 'options.maxSessions', true);
+    markTransferMode(this, true, false);
+    this[kHandle] = new SessionCacheHandle(maxSessions);
+  }
+
+  get size() {
+    return this[kHandle].getSize();
+  }
+
+  clear() {
+    this[kHandle].clear();
+  }
+
+  getTicketKeys() {
+    return this[kHandle].getTicketKeys();
+  }
+
+  setTicketKeys(keys) {
+    validateBuffer(keys, 'keys');
+    if (keys.byteLength !== 48) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'keys', keys.byteLength, 'must be exactly 48 bytes');
+    }
+    this[kHandle].setTicketKeys(keys);
+  }
+
+  rotateTicketKeys() {
+    this[kHandle].rotateTicketKeys();
+  }
+
+  [kClone]() {
+    const handle = this[kHandle];
+    return {
+      data: { handle },
+      deserializeInfo: 'internal/tls/session-cache:InternalSessionCache',
+    };
+  }
+
+  [kDeserialize]({ handle }) {
+    this[kHandle] = handle;
+  }
+}
+
+class InternalSessionCache {
+  constructor() {
+    markTransferMode(this, true, false);
+  }
+}
+
+InternalSessionCache.prototype.constructor = SessionCache.prototype.constructor;
+ObjectSetPrototypeOf(InternalSessionCache.prototype, SessionCache.prototype);
+
+module.exports = {
+  SessionCache,
+  InternalSessionCache,
+  kHandle,
+};
@@ -22,11 +22,14 @@
 'use strict';
 
 const {
+  DateNow,
+  MathMax,
   ObjectAssign,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
   ReflectApply,
   RegExp,
+  SafeMap,
   Symbol,
   SymbolFor,
 } = primordials;
@@ -38,7 +41,7 @@ const {
 
 assertCrypto();
 
-const { setImmediate } = require('timers');
+const { clearTimeout, setImmediate, setTimeout } = require('timers');
 const assert = require('internal/assert');
 const crypto = require('crypto');
 const EE = require('events');
@@ -109,6 +112,12 @@ const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
 const kPendingSession = Symbol('pendingSession');
 const kIsVerified = Symbol('verified');
+const kOCSPCache = Symbol('ocspCache');
+const kOCSPRefreshTimers = Symbol('ocspRefreshTimers');
+
+// Cached OCSP responses are refreshed halfway to their nextUpdate, but not
+// more often than this.
+const kMinOCSPRefreshDelay = 60 * 1000;
 
 const noop = () => {};
 
@@ -291,6 +300,10 @@ function requestOCSP(socket, info) {
     return requestOCSPDone(socket);
   }
 
+  // The response is stapled from the cache by the native side.
+  if (socket.server[kOCSPCache] && ctx.hasOCSPResponse())
+    return requestOCSPDone(socket);
+
   let once = false;
   const onOCSP = (err, response) => {
     debug('server OCSPRequest done', 'handle?', !!socket._handle, 'once?', once,
@@ -305,8 +318,11 @@ function requestOCSP(socket, info) {
     if (socket._handle === null)
       return socket.destroy(new ERR_SOCKET_CLOSED());
 
-    if (response)
+    if (response) {
       socket._handle.setOCSPResponse(response);
+      if (socket.server[kOCSPCache])
+        cacheOCSPResponse(socket.server, ctx, response);
+    }
     requestOCSPDone(socket);
   };
 
@@ -317,6 +333,56 @@ function requestOCSP(socket, info) {
                      onOCSP);
 }
 
+function cacheOCSPResponse(server, ctx, response) {
+  // Responses without a nextUpdate, or that cannot be parsed, are not cached,
+  // and 'OCSPRequest' keeps being emitted for every handshake.
+  const expires = ctx.setOCSPResponse(response);
+  debug('server cached OCSP response', 'expires', expires);
+  if (expires > 0)
+    scheduleOCSPRefresh(server, ctx, expires);
+}
+
+function scheduleOCSPRefresh(server, ctx, expires) {
+  const timers = server[kOCSPRefreshTimers];
+  clearTimeout(timers.get(ctx));
+  timers.delete(ctx);
+  if (!server.listening)
+    return;
+
+  const delay = MathMax((expires - DateNow()) / 2, kMinOCSPRefreshDelay);
+  // Without a refresh before it expires, the next handshake requests the
+  // response again.
+  if (DateNow() + delay >= expires)
+    return;
+  const timer = setTimeout(refreshOCSPResponse, delay, server, ctx, expires);
+  timer.unref();
+  timers.set(ctx, timer);
+}
+
+function refreshOCSPResponse(server, ctx, expires) {
+  server[kOCSPRefreshTimers].delete(ctx);
+  if (server.listenerCount('OCSPRequest') === 0)
+    return;
+
+  debug('server refresh OCSP response');
+  let once = false;
+  server.emit('OCSPRequest',
+              ctx.getCertificate(),
+              ctx.getIssuer(),
+              (err, response) => {
+                if (once)
+                  return;
+                once = true;
+                if (err || !response) {
+                  debug('server refresh OCSP response failed', err);
+                  // Try again while the cached response is still valid.
+                  scheduleOCSPRefresh(server, ctx, expires);
+                  return;
+                }
+                cacheOCSPResponse(server, ctx, response);
+              });
+}
+
 function requestOCSPDone(socket) {
   debug('server certcb done');
   try {
@@ -905,6 +971,9 @@ TLSSocket.prototype._init = function(socket, wrap) {
     ssl.enableCertCb();
   }
 
+  if (options.isServer && this.server?.[kOCSPCache])
+    ssl.enableOCSPCache(!this._SNICallback);
+
   if (options.ALPNProtocols)
     ssl.setALPNProtocols(options.ALPNProtocols);
 
@@ -1353,6 +1422,9 @@ function Server(options, listener) {
 
   this[kHandshakeTimeout] = options.handshakeTimeout || (120 * 1000);
   this[kSNICallback] = options.SNICallback;
+  if (options.ocspCache !== undefined)
+    validateBoolean(options.ocspCache, 'options.ocspCache');
+  this[kOCSPCache] = options.ocspCache === true;
   this[kPskCallback] = options.pskCallback;
   this[kPskIdentityHint] = options.pskIdentityHint;
 
@@ -1377,6 +1449,15 @@ function Server(options, listener) {
     this.on('secureConnection', listener);
   }
 
+  if (this[kOCSPCache]) {
+    this[kOCSPRefreshTimers] = new SafeMap();
+    this.once('close', () => {
+      for (const timer of this[kOCSPRefreshTimers].values())
+        clearTimeout(timer);
+      this[kOCSPRefreshTimers].clear();
+    });
+  }
+
   this[kEnableTrace] = options.enableTrace;
 }
 
@@ -1482,6 +1563,9 @@ Server.prototype.setSecureContext = function(options) {
   if (options.ticketKeys)
     this.ticketKeys = options.ticketKeys;
 
+  if (options.sessionCache)
+    this.sessionCache = options.sessionCache;
+
   this.privateKeyIdentifier = options.privateKeyIdentifier;
   this.privateKeyEngine = options.privateKeyEngine;
 
@@ -1504,6 +1588,7 @@ Server.prototype.setSecureContext = function(options) {
     crl: this.crl,
     sessionIdContext: this.sessionIdContext,
     ticketKeys: this.ticketKeys,
+    sessionCache: this.sessionCache,
     sessionTimeout: this.sessionTimeout,
     privateKeyIdentifier: this.privateKeyIdentifier,
     privateKeyEngine: this.privateKeyEngine,
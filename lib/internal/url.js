@@ -37,7 +37,6 @@ const { inspect } = require('internal/util/inspect');
 const {
   encodeStr,
   hexTable,
-  isHexTable,
 } = require('internal/querystring');
 
 const {
@@ -73,23 +72,19 @@ const {
   },
 } = require('internal/errors');
 const {
-  CHAR_AMPERSAND,
   CHAR_BACKWARD_SLASH,
-  CHAR_EQUAL,
   CHAR_FORWARD_SLASH,
   CHAR_LOWERCASE_A,
   CHAR_LOWERCASE_Z,
-  CHAR_PERCENT,
-  CHAR_PLUS,
 } = require('internal/constants');
 const path = require('path');
 
 const {
+  validateArray,
   validateFunction,
+  validateInteger,
 } = require('internal/validators');
 
-const querystring = require('querystring');
-
 const bindingUrl = internalBinding('url');
 
 const FORWARD_SLASH = /\//g;
@@ -781,6 +776,7 @@ function isURL(self) {
 const kParseURLSymbol = Symbol('kParseURL');
 const kCreateURLFromPosixPathSymbol = Symbol('kCreateURLFromPosixPath');
 const kCreateURLFromWindowsPathSymbol = Symbol('kCreateURLFromWindowsPath');
+const kCreateURLFromComponentsSymbol = Symbol('kCreateURLFromComponents');
 
 class URL {
   #context = new URLContext();
@@ -817,6 +813,10 @@ class URL {
     let href;
     if (arguments.length < 3) {
       href = bindingUrl.parse(input, base, true);
+    } else if (parseSymbol === kCreateURLFromComponentsSymbol) {
+      // The caller has already written the components of the serialized
+      // `input` to bindingUrl.urlComponents.
+      href = input;
     } else {
       const raiseException = parseSymbol !== kParseURLSymbol;
       const interpretAsWindowsPath = parseSymbol === kCreateURLFromWindowsPathSymbol;
@@ -1235,101 +1235,12 @@ function installObjectURLMethods() {
 
 // application/x-www-form-urlencoded parser
 // Ref: https://url.spec.whatwg.org/#concept-urlencoded-parser
+// The pairs are split and decoded in C++, which returns the names and values
+// as a flat array.
 function parseParams(qs) {
-  const out = [];
-  let seenSep = false;
-  let buf = '';
-  let encoded = false;
-  let encodeCheck = 0;
-  let i = qs[0] === '?' ? 1 : 0;
-  let pairStart = i;
-  let lastPos = i;
-  for (; i < qs.length; ++i) {
-    const code = StringPrototypeCharCodeAt(qs, i);
-
-    // Try matching key/value pair separator
-    if (code === CHAR_AMPERSAND) {
-      if (pairStart === i) {
-        // We saw an empty substring between pair separators
-        lastPos = pairStart = i + 1;
-        continue;
-      }
-
-      if (lastPos < i)
-        buf += qs.slice(lastPos, i);
-      if (encoded)
-        buf = querystring.unescape(buf);
-      out.push(buf);
-
-      // If `buf` is the key, add an empty value.
-      if (!seenSep)
-        out.push('');
-
-      seenSep = false;
-      buf = '';
-      encoded = false;
-      encodeCheck = 0;
-      lastPos = pairStart = i + 1;
-      continue;
-    }
-
-    // Try matching key/value separator (e.g. '=') if we haven't already
-    if (!seenSep && code === CHAR_EQUAL) {
-      // Key/value separator match!
-      if (lastPos < i)
-        buf += qs.slice(lastPos, i);
-      if (encoded)
-        buf = querystring.unescape(buf);
-      out.push(buf);
-
-      seenSep = true;
-      buf = '';
-      encoded = false;
-      encodeCheck = 0;
-      lastPos = i + 1;
-      continue;
-    }
-
-    // Handle + and percent decoding.
-    if (code === CHAR_PLUS) {
-      if (lastPos < i)
-        buf += StringPrototypeSlice(qs, lastPos, i);
-      buf += ' ';
-      lastPos = i + 1;
-    } else if (!encoded) {
-      // Try to match an (valid) encoded byte (once) to minimize unnecessary
-      // calls to string decoding functions
-      if (code === CHAR_PERCENT) {
-        encodeCheck = 1;
-      } else if (encodeCheck > 0) {
-        if (isHexTable[code] === 1) {
-          if (++encodeCheck === 3) {
-            encoded = true;
-          }
-        } else {
-          encodeCheck = 0;
-        }
-      }
-    }
-  }
-
-  // Deal with any leftover key or value data
-
-  // There is a trailing &. No more processing is needed.
-  if (pairStart === i)
-    return out;
-
-  if (lastPos < i)
-    buf += StringPrototypeSlice(qs, lastPos, i);
-  if (encoded)
-    buf = querystring.unescape(buf);
-  ArrayPrototypePush(out, buf);
-
-  // If `buf` is the key, add an empty value.
-  if (!seenSep)
-    ArrayPrototypePush(out, '');
-
-  return out;
+  if (qs[0] === '?')
+    qs = StringPrototypeSlice(qs, 1);
+  return bindingUrl.parseSearchParams(qs, 0, false);
 }
 
 // Adapted from querystring's implementation.
@@ -1553,6 +1464,62 @@ function pathToFileURL(filepath, options = kEmptyObject) {
   return new URL(resolved, undefined, windows ? kCreateURLFromWindowsPathSymbol : kCreateURLFromPosixPathSymbol);
 }
 
+// Number of entries per URL in bindingUrl.urlComponents.
+const kURLComponentsLength = 9;
+
+// Holds the result of parseMany(). The URL objects are only created when
+// they are requested, from the components computed by the batch parse.
+class URLParseResults {
+  #hrefs;
+  #components;
+
+  constructor(hrefs, components) {
+    this.#hrefs = hrefs;
+    this.#components = components;
+  }
+
+  get length() {
+    return this.#hrefs.length;
+  }
+
+  href(index) {
+    validateInteger(index, 'index', 0);
+    return this.#hrefs[index] ?? null;
+  }
+
+  url(index) {
+    validateInteger(index, 'index', 0);
+    const href = this.#hrefs[index];
+    if (href == null) return null;
+    const components = bindingUrl.urlComponents;
+    const offset = index * kURLComponentsLength;
+    for (let i = 0; i < kURLComponentsLength; i++) {
+      components[i] = this.#components[offset + i];
+    }
+    return new URL(href, undefined, kCreateURLFromComponentsSymbol);
+  }
+
+  *[SymbolIterator]() {
+    for (let i = 0; i < this.#hrefs.length; i++) {
+      yield this.url(i);
+    }
+  }
+}
+
+function parseMany(inputs, base = undefined) {
+  validateArray(inputs, 'inputs');
+  // StringPrototypeToWellFormed is not needed.
+  const strings = new Array(inputs.length);
+  for (let i = 0; i < inputs.length; i++) {
+    strings[i] = `${inputs[i]}`;
+  }
+  if (base !== undefined) {
+    base = `${base}`;
+  }
+  const { 0: hrefs, 1: components } = bindingUrl.parseMany(strings, base);
+  return new URLParseResults(hrefs, components);
+}
+
 function toPathIfFileURL(fileURLOrPath) {
   if (!isURL(fileURLOrPath))
     return fileURLOrPath;
@@ -1580,6 +1547,7 @@ module.exports = {
   URLParse: URL.parse,
   domainToASCII,
   domainToUnicode,
+  parseMany,
   urlToHttpOptions,
   encodeStr,
   isURL,
@@ -80,15 +80,18 @@ function addAfterUserSerializeCallback(callback, data) {
   afterUserSerializeCallbacks.push([callback, data]);
 }
 
+let deserializeMainIsSet = false;
 function initializeCallbacks() {
   // Only run the serialize callbacks in snapshot building mode, otherwise
   // they throw.
   if (isBuildingSnapshot()) {
     setSerializeCallback(runSerializeCallbacks);
+    // The snapshot being built can replace the main function set by the
+    // base snapshot it is built on.
+    deserializeMainIsSet = false;
   }
 }
 
-let deserializeMainIsSet = false;
 function setDeserializeMainFunction(callback, data) {
   throwIfNotBuildingSnapshot();
   // TODO(joyeecheung): In lib/internal/bootstrap/node.js, create a default
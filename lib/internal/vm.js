@@ -126,6 +126,7 @@ function registerImportModuleDynamically(referrer, importModuleDynamically) {
  * @param {symbol} hostDefinedOptionId - A symbol referenced by the field `host_defined_option_symbol`.
  * @param {VmImportModuleDynamicallyCallback} [importModuleDynamically] -
  * A function to use for dynamically importing modules.
+ * @param {boolean} [useCompileCache=false] - Whether to use the module compile cache.
  * @returns {object} An object containing the compiled function and any associated data.
  * @throws {TypeError} If any of the arguments are of the wrong type.
  * @throws {ERR_INVALID_ARG_TYPE} If the parsing context is not a valid context object.
@@ -133,7 +134,8 @@ function registerImportModuleDynamically(referrer, importModuleDynamically) {
 function internalCompileFunction(
   code, filename, lineOffset, columnOffset,
   cachedData, produceCachedData, parsingContext, contextExtensions,
-  params, hostDefinedOptionId, importModuleDynamically) {
+  params, hostDefinedOptionId, importModuleDynamically,
+  useCompileCache = false) {
   const result = compileFunction(
     code,
     filename,
@@ -145,6 +147,7 @@ function internalCompileFunction(
     contextExtensions,
     params,
     hostDefinedOptionId,
+    useCompileCache,
   );
 
   if (produceCachedData) {
@@ -175,6 +178,7 @@ function internalCompileFunction(
  * @param {object} parsingContext - The parsing context of the script.
  * @param {number} hostDefinedOptionId - The host-defined option ID.
  * @param {boolean} importModuleDynamically - Indicates whether to import modules dynamically.
+ * @param {boolean} [useCompileCache=false] - Whether to use the module compile cache.
  * @returns {ContextifyScript} The created contextify script.
  */
 function makeContextifyScript(code,
@@ -185,7 +189,8 @@ function makeContextifyScript(code,
                               produceCachedData,
                               parsingContext,
                               hostDefinedOptionId,
-                              importModuleDynamically) {
+                              importModuleDynamically,
+                              useCompileCache = false) {
   let script;
   // Calling `ReThrow()` on a native TryCatch does not generate a new
   // abort-on-uncaught-exception check. A dummy try/catch in JS land
@@ -198,7 +203,8 @@ function makeContextifyScript(code,
                                   cachedData,
                                   produceCachedData,
                                   parsingContext,
-                                  hostDefinedOptionId);
+                                  hostDefinedOptionId,
+                                  useCompileCache);
   } catch (e) {
     throw e; /* node-do-not-add-exception-line */
   }
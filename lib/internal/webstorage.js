@@ -5,7 +5,7 @@ const {
 const { ERR_INVALID_ARG_VALUE } = require('internal/errors').codes;
 const { getOptionValue } = require('internal/options');
 const { emitExperimentalWarning } = require('internal/util');
-const { kConstructorKey, Storage } = internalBinding('webstorage');
+const { flush, kConstructorKey, Storage } = internalBinding('webstorage');
 const { getValidatedPath } = require('internal/fs/utils');
 const kInMemoryPath = ':memory:';
 
@@ -32,7 +32,14 @@ ObjectDefineProperties(module.exports, {
                                           'is an invalid localStorage location');
         }
 
-        lazyLocalStorage = new Storage(kConstructorKey, getValidatedPath(location));
+        const writeBack = getOptionValue('--localstorage-write-back');
+        lazyLocalStorage = new Storage(kConstructorKey,
+                                       getValidatedPath(location),
+                                       writeBack);
+        if (writeBack) {
+          // process.exit() does not wait for the pending commit.
+          process.on('exit', () => flush(lazyLocalStorage));
+        }
       }
 
       return lazyLocalStorage;
@@ -53,6 +53,11 @@ const {
   Buffer,
 } = require('buffer');
 
+const {
+  isAnyArrayBuffer,
+  isArrayBufferView,
+} = require('internal/util/types');
+
 const {
   AbortError,
   ErrnoException,
@@ -76,13 +81,19 @@ const {
 } = require('internal/validators');
 
 const {
-  WriteWrap,
   ShutdownWrap,
-  kReadBytesOrError,
-  kLastWriteWasAsync,
-  streamBaseState,
 } = internalBinding('stream_wrap');
 
+let streamBridge;
+function lazyStreamBridge() {
+  streamBridge ??= internalBinding('stream_bridge');
+  return streamBridge;
+}
+
+// The size of the views that are allocated for default readers of StreamBase
+// backed byte streams.
+const kStreamBaseChunkSize = 64 * 1024;
+
 const finished = require('internal/streams/end-of-stream');
 
 const { UV_EOF } = internalBinding('uv');
@@ -875,64 +886,44 @@ function newStreamDuplexFromReadableWritablePair(pair = kEmptyObject, options =
 function newWritableStreamFromStreamBase(streamBase, strategy) {
   validateObject(streamBase, 'streamBase');
 
-  let current;
-
-  function createWriteWrap(controller, promise) {
-    const req = new WriteWrap();
-    req.handle = streamBase;
-    req.oncomplete = onWriteComplete;
-    req.async = false;
-    req.bytes = 0;
-    req.buffer = null;
-    req.controller = controller;
-    req.promise = promise;
-    return req;
-  }
-
-  function onWriteComplete(status) {
-    if (status < 0) {
-      const error = new ErrnoException(status, 'write', this.error);
-      this.promise.reject(error);
-      this.controller.error(error);
-      return;
-    }
-    this.promise.resolve();
-  }
-
-  function doWrite(chunk, controller) {
-    const promise = PromiseWithResolvers();
-    let ret;
-    let req;
-    try {
-      req = createWriteWrap(controller, promise);
-      ret = streamBase.writeBuffer(req, chunk);
-      if (streamBaseState[kLastWriteWasAsync])
-        req.buffer = chunk;
-      req.async = !!streamBaseState[kLastWriteWasAsync];
-    } catch (error) {
-      promise.reject(error);
-    }
-
-    if (ret !== 0)
-      promise.reject(new ErrnoException(ret, 'write', req));
-    else if (!req.async)
-      promise.resolve();
-
-    return promise.promise;
-  }
+  // Chunks are written by a native sink that sits on top of the stream, so no
+  // WriteWrap has to be created for every write. The WritableStream never has
+  // more than one write in flight.
+  const { StreamByteSink } = lazyStreamBridge();
+  const sink = new StreamByteSink(streamBase);
+  let pending;
+
+  sink.oncomplete = (status) => {
+    const { resolve, reject } = pending;
+    pending = undefined;
+    if (status < 0)
+      reject(new ErrnoException(status, 'write'));
+    else
+      resolve();
+  };
 
   return new WritableStream({
-    write(chunk, controller) {
-      current = current !== undefined ?
-        PromisePrototypeThen(
-          current,
-          () => doWrite(chunk, controller),
-          (error) => controller.error(error)) :
-        doWrite(chunk, controller);
-      return current;
+    write(chunk) {
+      if (isAnyArrayBuffer(chunk)) {
+        chunk = new Uint8Array(chunk);
+      } else if (!isArrayBufferView(chunk)) {
+        throw new ERR_INVALID_ARG_TYPE(
+          'chunk',
+          ['ArrayBuffer', 'Buffer', 'TypedArray', 'DataView'],
+          chunk);
+      }
+
+      const ret = sink.write(chunk);
+      if (ret === 1)
+        return;
+      if (ret < 0)
+        throw new ErrnoException(ret, 'write');
+      pending = PromiseWithResolvers();
+      return pending.promise;
     },
 
     close() {
+      sink.detach();
       const promise = PromiseWithResolvers();
       const req = new ShutdownWrap();
       req.oncomplete = () => promise.resolve();
@@ -941,6 +932,10 @@ function newWritableStreamFromStreamBase(streamBase, strategy) {
         promise.resolve();
       return promise.promise;
     },
+
+    abort() {
+      sink.detach();
+    },
   }, strategy);
 }
 
@@ -962,44 +957,65 @@ function newReadableStreamFromStreamBase(streamBase, strategy, options = kEmptyO
 
   validateFunction(ondone, 'options.ondone');
 
-  let controller;
+  // Reads are handled by a native source that reads straight into the views
+  // of BYOB requests. The onread callback only marks the StreamBase as
+  // consumed, and swallows data that arrives after the source has detached.
+  streamBase.onread = () => {};
 
-  streamBase.onread = (arrayBuffer) => {
-    const nread = streamBaseState[kReadBytesOrError];
+  const { StreamByteSource } = lazyStreamBridge();
+  const source = new StreamByteSource(streamBase);
+  let pending;
 
-    if (nread === 0)
+  function onread(controller, byobRequest, nread) {
+    if (nread > 0) {
+      byobRequest.respond(nread);
       return;
+    }
 
-    try {
-      if (nread === UV_EOF) {
-        controller.close();
-        streamBase.readStop();
-        try {
-          ondone();
-        } catch (error) {
-          controller.error(error);
-        }
-        return;
-      }
-
-      controller.enqueue(arrayBuffer);
+    source.detach();
+    if (nread !== UV_EOF) {
+      controller.error(new ErrnoException(nread, 'read'));
+      return;
+    }
 
-      if (controller.desiredSize <= 0)
-        streamBase.readStop();
+    controller.close();
+    byobRequest.respond(0);
+    try {
+      ondone();
     } catch (error) {
       controller.error(error);
-      streamBase.readStop();
+    }
+  }
+
+  source.oncomplete = (nread) => {
+    const { controller, byobRequest, resolve, reject } = pending;
+    pending = undefined;
+    try {
+      onread(controller, byobRequest, nread);
+      resolve();
+    } catch (error) {
+      reject(error);
     }
   };
 
   return new ReadableStream({
-    start(c) { controller = c; },
-
-    pull() {
-      streamBase.readStart();
+    type: 'bytes',
+    autoAllocateChunkSize: kStreamBaseChunkSize,
+
+    pull(controller) {
+      const { byobRequest } = controller;
+      const ret = source.read(byobRequest.view);
+      if (ret !== 0) {
+        onread(controller, byobRequest, ret);
+        return;
+      }
+      const { promise, resolve, reject } = PromiseWithResolvers();
+      pending = { controller, byobRequest, resolve, reject };
+      return promise;
     },
 
     cancel() {
+      source.detach();
       const promise = PromiseWithResolvers();
       try {
         ondone();
@@ -61,7 +61,13 @@ const { createMainThreadPort, destroyMainThreadPort } = require('internal/worker
 const { deserializeError } = require('internal/error_serdes');
 const { fileURLToPath, isURL, pathToFileURL } = require('internal/url');
 const { kEmptyObject } = require('internal/util');
-const { validateArray, validateString } = require('internal/validators');
+const {
+  validateArray,
+  validateBoolean,
+  validateInt32,
+  validateString,
+  validateUint32,
+} = require('internal/validators');
 const {
   throwIfBuildingSnapshot,
 } = require('internal/v8/startup_snapshot');
@@ -211,6 +217,24 @@ class Worker extends EventEmitter {
       name = StringPrototypeTrim(options.name);
     }
 
+    let cpuAffinity;
+    if (options.cpuAffinity !== undefined) {
+      validateArray(options.cpuAffinity, 'options.cpuAffinity');
+      cpuAffinity = ArrayPrototypeMap(options.cpuAffinity, (cpu, i) => {
+        validateUint32(cpu, `options.cpuAffinity[${i}]`);
+        return cpu;
+      });
+    }
+
+    let numaNode;
+    if (options.numaNode !== undefined) {
+      validateInt32(options.numaNode, 'options.numaNode', 0);
+      numaNode = options.numaNode;
+    }
+
+    const inheritStdio = options.inheritStdio ?? false;
+    validateBoolean(inheritStdio, 'options.inheritStdio');
+
     debug('instantiating Worker.', `url: ${url}`, `doEval: ${doEval}`);
     // Set up the C++ handle for the worker, as well as some internal wiring.
     this[kHandle] = new WorkerImpl(url,
@@ -219,7 +243,9 @@ class Worker extends EventEmitter {
                                    parseResourceLimits(options.resourceLimits),
                                    !!(options.trackUnmanagedFds ?? true),
                                    isInternal,
-                                   name);
+                                   name,
+                                   cpuAffinity,
+                                   numaNode);
     if (this[kHandle].invalidExecArgv) {
       throw new ERR_WORKER_INVALID_EXEC_ARGV(this[kHandle].invalidExecArgv);
     }
@@ -241,14 +267,20 @@ class Worker extends EventEmitter {
     if (options.stdin)
       stdin = new WritableWorkerStdio(this[kPort], 'stdin');
     const stdout = new ReadableWorkerStdio(this[kPort], 'stdout');
-    if (!options.stdout) {
-      stdout[kIncrementsPortRef] = false;
-      pipeWithoutWarning(stdout, process.stdout);
-    }
     const stderr = new ReadableWorkerStdio(this[kPort], 'stderr');
-    if (!options.stderr) {
-      stderr[kIncrementsPortRef] = false;
-      pipeWithoutWarning(stderr, process.stderr);
+    if (inheritStdio) {
+      // The worker writes to the file descriptors of the process directly.
+      stdout.push(null);
+      stderr.push(null);
+    } else {
+      if (!options.stdout) {
+        stdout[kIncrementsPortRef] = false;
+        pipeWithoutWarning(stdout, process.stdout);
+      }
+      if (!options.stderr) {
+        stderr[kIncrementsPortRef] = false;
+        pipeWithoutWarning(stderr, process.stderr);
+      }
     }
 
     this[kParentSideStdio] = { stdin, stdout, stderr };
@@ -279,6 +311,7 @@ class Worker extends EventEmitter {
       workerData: options.workerData,
       environmentData,
       hasStdin: !!options.stdin,
+      inheritStdio,
       publicPort: publicPortToWorker,
       mainThreadPort: mainThreadPortToWorker,
     }, transferList);
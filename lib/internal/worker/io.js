@@ -19,9 +19,14 @@ const {
 
 const {
   assignFunctionName,
+  kEmptyObject,
   kEnumerableProperty,
   setOwnProperty,
 } = require('internal/util');
+const {
+  validateNumber,
+  validateObject,
+} = require('internal/validators');
 
 const {
   handle_onclose: handleOnCloseSymbol,
@@ -79,6 +84,8 @@ const kWaitingStreams = Symbol('kWaitingStreams');
 const kWritableCallback = Symbol('kWritableCallback');
 const kStartedReading = Symbol('kStartedReading');
 const kStdioWantsMoreDataCallback = Symbol('kStdioWantsMoreDataCallback');
+const kStdioFlushSync = Symbol('kStdioFlushSync');
+const kCorked = Symbol('kCorked');
 const kCurrentlyReceivingPorts =
   SymbolFor('nodejs.internal.kCurrentlyReceivingPorts');
 const kType = Symbol('kType');
@@ -276,12 +283,35 @@ class ReadableWorkerStdio extends Readable {
   }
 }
 
+function uncorkWorkerStdio(stream) {
+  if (stream[kCorked]) {
+    stream[kCorked] = false;
+    stream.uncork();
+  }
+}
+
 class WritableWorkerStdio extends Writable {
   constructor(port, name) {
     super({ decodeStrings: false });
     this[kPort] = port;
     this[kName] = name;
     this[kWritableCallback] = null;
+    this[kCorked] = false;
+  }
+
+  write(chunk, encoding, cb) {
+    // Coalesce the writes of one tick, e.g. a loop of console.log() calls,
+    // into a single message, unless they fill up the buffer first. There are
+    // no more ticks once the thread is exiting.
+    if (!this[kCorked] && !process._exiting) {
+      this[kCorked] = true;
+      this.cork();
+      process.nextTick(uncorkWorkerStdio, this);
+    }
+    const ret = super.write(chunk, encoding, cb);
+    if (this.writableLength >= this.writableHighWaterMark)
+      uncorkWorkerStdio(this);
+    return ret;
   }
 
   _writev(chunks, cb) {
@@ -327,20 +357,47 @@ class WritableWorkerStdio extends Writable {
         this[kPort].unref();
     }
   }
+
+  // Sends everything that has been written when the thread exits.
+  [kStdioFlushSync]() {
+    uncorkWorkerStdio(this);
+    this[kStdioWantsMoreDataCallback]();
+  }
+}
+
+// Set in the worker when it was created with the `inheritStdio` option.
+let inheritStdio = false;
+function setInheritStdio(value) {
+  inheritStdio = value;
 }
 
 function createWorkerStdio() {
   const port = getEnvMessagePort();
   port[kWaitingStreams] = 0;
+  let stdout, stderr;
+  if (inheritStdio) {
+    // The file descriptors are shared by all threads of the process, so
+    // the output does not have to take a detour through the parent thread.
+    const SyncWriteStream = require('internal/fs/sync_write_stream');
+    stdout = new SyncWriteStream(1, { autoClose: false });
+    stderr = new SyncWriteStream(2, { autoClose: false });
+  } else {
+    stdout = new WritableWorkerStdio(port, 'stdout');
+    stderr = new WritableWorkerStdio(port, 'stderr');
+  }
   return {
     stdin: new ReadableWorkerStdio(port, 'stdin'),
-    stdout: new WritableWorkerStdio(port, 'stdout'),
-    stderr: new WritableWorkerStdio(port, 'stderr'),
+    stdout,
+    stderr,
   };
 }
 
-function receiveMessageOnPort(port) {
-  const message = receiveMessageOnPort_(port?.[kHandle] ?? port);
+function receiveMessageOnPort(port, options = kEmptyObject) {
+  validateObject(options, 'options');
+  const { timeout } = options;
+  if (timeout !== undefined)
+    validateNumber(timeout, 'options.timeout', 0);
+  const message = receiveMessageOnPort_(port?.[kHandle] ?? port, timeout);
   if (message === noMessageSymbol) return undefined;
   return { message };
 }
@@ -483,6 +540,7 @@ module.exports = {
   kIncrementsPortRef,
   kWaitingStreams,
   kStdioWantsMoreDataCallback,
+  kStdioFlushSync,
   markAsUncloneable,
   moveMessagePortToContext,
   MessagePort,
@@ -492,5 +550,6 @@ module.exports = {
   ReadableWorkerStdio,
   WritableWorkerStdio,
   createWorkerStdio,
+  setInheritStdio,
   BroadcastChannel,
 };
@@ -0,0 +1,144 @@
+'use strict';
+
+const {
+  MathCeil,
+  MathFloor,
+  SharedArrayBuffer,
+  Symbol,
+} = primordials;
+
+const {
+  SharedBufferSlice: SharedBufferSliceHandle,
+} = internalBinding('messaging');
+
+const {
+  codes: {
+    ERR_INVALID_STATE,
+  },
+} = require('internal/errors');
+
+const {
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+
+const {
+  kEmptyObject,
+} = require('internal/util');
+
+const {
+  kDeserialize,
+  kTransfer,
+  kTransferList,
+  markTransferMode,
+} = require('internal/worker/js_transferable');
+
+const kHandle = Symbol('kHandle');
+const kBuffer = Symbol('kBuffer');
+const kLength = Symbol('kLength');
+
+// Slices are kept 8-byte aligned, so that typed arrays of any element type
+// can be created on top of them.
+const kAlignment = 8;
+
+class SharedBufferSlice {
+  constructor(handle, length) {
+    markTransferMode(this, false, true);
+    this[kHandle] = handle;
+    this[kLength] = length;
+    this[kBuffer] = undefined;
+  }
+
+  /**
+   * @type {Buffer}
+   */
+  get buffer() {
+    if (this[kHandle] === null) {
+      throw new ERR_INVALID_STATE('The slice has been transferred or released');
+    }
+    return this[kBuffer] ??= this[kHandle].getBuffer();
+  }
+
+  /**
+   * @type {number}
+   */
+  get length() {
+    return this[kLength];
+  }
+
+  release() {
+    if (this[kHandle] === null) return;
+    this[kHandle].release();
+    this[kHandle] = null;
+    this[kBuffer] = undefined;
+  }
+
+  [kTransfer]() {
+    if (this[kHandle] === null) {
+      throw new ERR_INVALID_STATE('The slice has been transferred or released');
+    }
+    const handle = this[kHandle];
+    const length = this[kLength];
+    this[kHandle] = null;
+    this[kBuffer] = undefined;
+    return {
+      data: { handle, length },
+      deserializeInfo: 'internal/worker/shared_buffer_pool:SharedBufferSlice',
+    };
+  }
+
+  [kTransferList]() {
+    if (this[kHandle] === null) {
+      throw new ERR_INVALID_STATE('The slice has been transferred or released');
+    }
+    return [this[kHandle]];
+  }
+
+  [kDeserialize]({ handle, length }) {
+    this[kHandle] = handle;
+    this[kLength] = length;
+  }
+}
+
+class SharedBufferPool {
+  #slabSize;
+  #slab = null;
+  #offset = 0;
+
+  /**
+   * @param {{ slabSize?: number }} [options]
+   */
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const { slabSize = 64 * 1024 } = options;
+    validateInteger(slabSize, 'options.slabSize', kAlignment);
+    this.#slabSize = slabSize;
+  }
+
+  /**
+   * @param {number} size
+   * @returns {SharedBufferSlice}
+   */
+  allocate(size) {
+    validateInteger(size, 'size', 0);
+    // Large slices get a slab of their own, so that they do not keep a
+    // mostly unused slab alive.
+    if (size > MathFloor(this.#slabSize / 2)) {
+      const handle = new SharedBufferSliceHandle(
+        new SharedArrayBuffer(size), 0, size);
+      return new SharedBufferSlice(handle, size);
+    }
+    if (this.#slab === null || this.#offset + size > this.#slabSize) {
+      this.#slab = new SharedArrayBuffer(this.#slabSize);
+      this.#offset = 0;
+    }
+    const handle = new SharedBufferSliceHandle(this.#slab, this.#offset, size);
+    this.#offset = MathCeil((this.#offset + size) / kAlignment) * kAlignment;
+    return new SharedBufferSlice(handle, size);
+  }
+}
+
+module.exports = {
+  SharedBufferPool,
+  SharedBufferSlice,
+};
@@ -0,0 +1,114 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+  Symbol,
+} = primordials;
+
+const {
+  ZstdDictionary: ZstdDictionaryHandle,
+} = internalBinding('zlib');
+
+const {
+  markTransferMode,
+  kClone,
+  kDeserialize,
+} = require('internal/worker/js_transferable');
+
+const {
+  ERR_INVALID_ARG_TYPE,
+} = require('internal/errors').codes;
+
+const {
+  isAnyArrayBuffer,
+  isArrayBufferView,
+} = require('internal/util/types');
+
+const { Buffer } = require('buffer');
+const { kEmptyObject } = require('internal/util');
+const {
+  validateInt32,
+  validateObject,
+} = require('internal/validators');
+
+const { ZSTD_CLEVEL_DEFAULT } = internalBinding('constants').zlib;
+
+const kHandle = Symbol('kHandle');
+// The range of ZSTD_minCLevel() to ZSTD_maxCLevel().
+const kMinLevel = -(1 << 17);
+const kMaxLevel = 22;
+
+class ZstdDictionary {
+  /**
+   * @param {ArrayBuffer|Buffer|TypedArray|DataView} data
+   * @param {{ level?: number }} [options]
+   */
+  constructor(data, options = kEmptyObject) {
+    markTransferMode(this, true, false);
+    if (isAnyArrayBuffer(data)) {
+      data = Buffer.from(data);
+    } else if (!isArrayBufferView(data)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'data',
+        ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+        data,
+      );
+    }
+    validateObject(options, 'options');
+    const { level = ZSTD_CLEVEL_DEFAULT } = options;
+    validateInt32(level, 'options.level', kMinLevel, kMaxLevel);
+    this[kHandle] = new ZstdDictionaryHandle(data, level);
+  }
+
+  /**
+   * Returns true if the value is a ZstdDictionary
+   * @param {any} value
+   * @returns {boolean}
+   */
+  static isZstdDictionary(value) {
+    return value?.[kHandle] !== undefined;
+  }
+
+  /**
+   * The dictionary ID, or 0 for raw content dictionaries.
+   * @type {number}
+   */
+  get id() {
+    return this[kHandle].getId();
+  }
+
+  /**
+   * @type {number}
+   */
+  get size() {
+    return this[kHandle].getSize();
+  }
+
+  [kClone]() {
+    const handle = this[kHandle];
+    return {
+      data: { handle },
+      deserializeInfo: 'internal/zlib/zstd_dictionary:InternalZstdDictionary',
+    };
+  }
+
+  [kDeserialize]({ handle }) {
+    this[kHandle] = handle;
+  }
+}
+
+class InternalZstdDictionary {
+  constructor(handle) {
+    markTransferMode(this, true, false);
+    this[kHandle] = handle;
+  }
+}
+
+InternalZstdDictionary.prototype.constructor = ZstdDictionary.prototype.constructor;
+ObjectSetPrototypeOf(InternalZstdDictionary.prototype, ZstdDictionary.prototype);
+
+module.exports = {
+  ZstdDictionary,
+  InternalZstdDictionary,
+  kHandle,
+};
@@ -11,22 +11,26 @@ const {
   SourceMap,
 } = require('internal/source_map/source_map');
 const {
+  clearStatCache,
   constants,
   enableCompileCache,
   flushCompileCache,
   getCompileCacheDir,
+  getStatCacheStats,
 } = require('internal/modules/helpers');
 const {
   findPackageJSON,
 } = require('internal/modules/package_json_reader');
 const { stripTypeScriptTypes } = require('internal/modules/typescript');
 
+Module.clearStatCache = clearStatCache;
 Module.register = register;
 Module.constants = constants;
 Module.enableCompileCache = enableCompileCache;
 Module.findPackageJSON = findPackageJSON;
 Module.flushCompileCache = flushCompileCache;
 Module.getCompileCacheDir = getCompileCacheDir;
+Module.getStatCacheStats = getStatCacheStats;
 Module.stripTypeScriptTypes = stripTypeScriptTypes;
 
 // SourceMap APIs
@@ -32,6 +32,7 @@ const {
   MathMax,
   Number,
   NumberIsNaN,
+  NumberMAX_SAFE_INTEGER,
   NumberParseInt,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
@@ -68,6 +69,7 @@ const { Buffer } = require('buffer');
 const { ShutdownWrap } = internalBinding('stream_wrap');
 const {
   TCP,
+  TCPConnectRace,
   TCPConnectWrap,
   constants: TCPConstants,
 } = internalBinding('tcp_wrap');
@@ -107,7 +109,9 @@ const {
     ERR_INVALID_IP_ADDRESS,
     ERR_IP_BLOCKED,
     ERR_MISSING_ARGS,
+    ERR_OUT_OF_RANGE,
     ERR_SERVER_ALREADY_LISTEN,
+    ERR_INVALID_STATE,
     ERR_SERVER_NOT_RUNNING,
     ERR_SOCKET_CLOSED,
     ERR_SOCKET_CLOSED_BEFORE_CONNECTION,
@@ -129,16 +133,20 @@ const {
   validateFunction,
   validateInt32,
   validateNumber,
+  validateObject,
   validatePort,
   validateString,
+  validateUint32,
 } = require('internal/validators');
 const kLastWriteQueueSize = Symbol('lastWriteQueueSize');
+const kConnectionRateLimit = Symbol('kConnectionRateLimit');
 const { getOptionValue } = require('internal/options');
 
 // Lazy loaded to improve startup performance.
 let cluster;
 let dns;
 let BlockList;
+let ClonedHistogram;
 let SocketAddress;
 let autoSelectFamilyDefault = getOptionValue('--network-family-autoselection');
 let autoSelectFamilyAttemptTimeoutDefault = getOptionValue('--network-family-autoselection-attempt-timeout');
@@ -356,8 +364,11 @@ function closeSocketHandle(self, isException, isCleanupPending = false) {
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
 const kSetNoDelay = Symbol('kSetNoDelay');
+const kConnectRace = Symbol('kConnectRace');
 const kSetKeepAlive = Symbol('kSetKeepAlive');
 const kSetKeepAliveInitialDelay = Symbol('kSetKeepAliveInitialDelay');
+const kAutoCork = Symbol('kAutoCork');
+const kAutoCorked = Symbol('kAutoCorked');
 
 function Socket(options) {
   if (!(this instanceof Socket)) return new Socket(options);
@@ -386,6 +397,10 @@ function Socket(options) {
     }
   }
 
+  if (options?.autoCork !== undefined) {
+    validateBoolean(options.autoCork, 'options.autoCork');
+  }
+
   this.connecting = false;
   // Problem with this is that users can supply their own handle, that may not
   // have _handle.getAsyncId(). In this case an[async_id_symbol] should
@@ -473,6 +488,10 @@ function Socket(options) {
   this[kSetNoDelay] = Boolean(options.noDelay);
   this[kSetKeepAlive] = Boolean(options.keepAlive);
   this[kSetKeepAliveInitialDelay] = ~~(options.keepAliveInitialDelay / 1000);
+  this[kAutoCork] = options.autoCork === true;
+  this[kAutoCorked] = false;
+  if (this[kAutoCork])
+    this.write = autoCorkWrite;
 
   // Shut down the socket when we're finished with it.
   this.on('end', onReadableStreamEnd);
@@ -564,7 +583,8 @@ function afterShutdown() {
 // is overly vague, and makes it seem like the user's code is to blame.
 function writeAfterFIN(chunk, encoding, cb) {
   if (!this.writableEnded) {
-    return stream.Duplex.prototype.write.call(this, chunk, encoding, cb);
+    const write = this[kAutoCork] ? autoCorkWrite : stream.Duplex.prototype.write;
+    return write.call(this, chunk, encoding, cb);
   }
 
   if (typeof encoding === 'function') {
@@ -787,6 +807,30 @@ Socket.prototype.read = function(n) {
 
 
 // Called when the 'end' event is emitted.
+// Writes issued while the current tick runs are corked together and flushed
+// as a single writev() once it ends, or as soon as the buffered data reaches
+// the high-water mark.
+function autoCorkWrite(chunk, encoding, cb) {
+  if (!this[kAutoCorked] && !this.writableCorked) {
+    this[kAutoCorked] = true;
+    this.cork();
+    process.nextTick(autoUncorkNT, this);
+  }
+  const ret = stream.Duplex.prototype.write.call(this, chunk, encoding, cb);
+  if (this[kAutoCorked] && this.writableLength >= this.writableHighWaterMark) {
+    this[kAutoCorked] = false;
+    this.uncork();
+  }
+  return ret;
+}
+
+function autoUncorkNT(socket) {
+  if (socket[kAutoCorked]) {
+    socket[kAutoCorked] = false;
+    socket.uncork();
+  }
+}
+
 function onReadableStreamEnd() {
   if (!this.allowHalfOpen) {
     this.write = writeAfterFIN;
@@ -814,6 +858,11 @@ Socket.prototype._destroy = function(exception, cb) {
     clearTimeout(s[kTimeout]);
   }
 
+  if (this[kConnectRace]) {
+    this[kConnectRace].cancel();
+    this[kConnectRace] = null;
+  }
+
   debug('close');
   if (this._handle) {
     if (this !== process.stderr)
@@ -1252,8 +1301,9 @@ Socket.prototype.connect = function(...args) {
   if (options.port === undefined && options.path == null)
     throw new ERR_MISSING_ARGS(['options', 'port', 'path']);
 
-  if (this.write !== Socket.prototype.write)
-    this.write = Socket.prototype.write;
+  const write = this[kAutoCork] ? autoCorkWrite : Socket.prototype.write;
+  if (this.write !== write)
+    this.write = write;
 
   if (this.destroyed) {
     this._handle = null;
@@ -1549,7 +1599,13 @@ function lookupAndConnectMultiple(
       };
 
       self._unrefTimer();
-      defaultTriggerAsyncIdScope(self[async_id_symbol], internalConnectMultiple, context);
+      // Binding to a local port and checking the block list are done for
+      // each attempt, which only the JavaScript implementation can do.
+      defaultTriggerAsyncIdScope(
+        self[async_id_symbol],
+        localPort || self.blockList ? internalConnectMultiple : internalConnectRace,
+        context,
+      );
     });
   });
 }
@@ -1729,6 +1785,97 @@ function afterConnectMultiple(context, current, status, handle, req, readable, w
   afterConnect(status, self._handle, req, readable, writable);
 }
 
+// Races the connection attempts in native code. Only the handle that
+// connected first comes back to JavaScript, and the attempts are only reported
+// one by one when there are listeners for their events.
+function internalConnectRace(context) {
+  const self = context.socket;
+  const { addresses } = context;
+  const flatAddresses = [];
+  for (let i = 0; i < addresses.length; i++) {
+    ArrayPrototypePush(flatAddresses, addresses[i].address, addresses[i].family);
+  }
+
+  const race = new TCPConnectRace();
+  race.context = context;
+  race.oncomplete = afterConnectRace;
+  race.onattempt = onConnectRaceAttempt;
+  context.attempted = 0;
+  self[kConnectRace] = race;
+
+  const reportAttempts = self.listenerCount('connectionAttempt') > 0 ||
+                         self.listenerCount('connectionAttemptFailed') > 0 ||
+                         self.listenerCount('connectionAttemptTimeout') > 0;
+  race.start(self._handle, flatAddresses, context.port, context.timeout, reportAttempts);
+}
+
+function recordConnectRaceAttempts(context, attempted) {
+  const { socket, addresses, port } = context;
+  for (; context.attempted < attempted; context.attempted++) {
+    const { address } = addresses[context.attempted];
+    ArrayPrototypePush(socket.autoSelectFamilyAttemptedAddresses, `${address}:${port}`);
+  }
+}
+
+function onConnectRaceAttempt(event, index, status) {
+  const { context } = this;
+  const self = context.socket;
+  const { port } = context;
+  const { address, family } = context.addresses[index];
+
+  switch (event) {
+    case TCPConstants.kAttemptStarted:
+      debug('connect/multiple: attempting to connect to %s:%d (addressType: %d)', address, port, family);
+      recordConnectRaceAttempts(context, index + 1);
+      self.emit('connectionAttempt', address, port, family);
+      break;
+    case TCPConstants.kAttemptFailed: {
+      const ex = createConnectionError({ address, port }, status);
+      self.emit('connectionAttemptFailed', address, port, family, ex);
+      break;
+    }
+    case TCPConstants.kAttemptTimedOut:
+      debug('connect/multiple: connection to %s:%s timed out, starting the next one', address, port);
+      self.emit('connectionAttemptTimeout', address, port, family);
+      break;
+  }
+}
+
+function afterConnectRace(status, handle, index, readable, writable, errors, attempted) {
+  const { context } = this;
+  const self = context.socket;
+  const { port } = context;
+  self[kConnectRace] = null;
+  recordConnectRaceAttempts(context, attempted);
+
+  if (status !== 0) {
+    const exceptions = [];
+    for (let i = 0; i < errors.length; i += 2) {
+      const { address } = context.addresses[errors[i]];
+      ArrayPrototypePush(exceptions, createConnectionError({ address, port }, errors[i + 1]));
+    }
+    self.destroy(new NodeAggregateError(exceptions));
+    return;
+  }
+
+  const { address, family } = context.addresses[index];
+  debug('connect/multiple: connection attempt to %s:%s succeeded', address, port);
+
+  if (handle !== self._handle) {
+    self[kReinitializeHandle](handle);
+  }
+
+  if (hasObserver('net')) {
+    startPerf(
+      self,
+      kPerfHooksNetConnectContext,
+      { type: 'net', name: 'connect', detail: { host: address, port } },
+    );
+  }
+
+  afterConnect(status, handle, { address, port, addressType: family }, readable, writable);
+}
+
 function internalConnectMultipleTimeout(context, req, handle) {
   debug('connect/multiple: connection to %s:%s timed out', req.address, req.port);
   context.socket.emit('connectionAttemptTimeout', req.address, req.port, req.addressType);
@@ -1810,6 +1957,7 @@ function Server(options, connectionListener) {
   this.allowHalfOpen = options.allowHalfOpen || false;
   this.pauseOnConnect = !!options.pauseOnConnect;
   this.noDelay = Boolean(options.noDelay);
+  this.autoCork = Boolean(options.autoCork);
   this.keepAlive = Boolean(options.keepAlive);
   this.keepAliveInitialDelay = ~~(options.keepAliveInitialDelay / 1000);
   this.highWaterMark = options.highWaterMark ?? getDefaultHighWaterMark();
@@ -1819,11 +1967,28 @@ function Server(options, connectionListener) {
     }
     this.blockList = options.blockList;
   }
+  if (options.connectionRateLimit !== undefined) {
+    this[kConnectionRateLimit] =
+      validateConnectionRateLimit(options.connectionRateLimit);
+  }
 }
 ObjectSetPrototypeOf(Server.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(Server, EventEmitter);
 
 
+function validateConnectionRateLimit(limit) {
+  const name = 'options.connectionRateLimit';
+  validateObject(limit, name);
+  const { rate, burst = rate, maxAddresses = 10000 } = limit;
+  validateNumber(rate, `${name}.rate`, 0, NumberMAX_SAFE_INTEGER);
+  if (rate === 0) {
+    throw new ERR_OUT_OF_RANGE(`${name}.rate`, '> 0', rate);
+  }
+  validateNumber(burst, `${name}.burst`, 1, NumberMAX_SAFE_INTEGER);
+  validateUint32(maxAddresses, `${name}.maxAddresses`, true);
+  return { rate, burst, maxAddresses };
+}
+
 function toNumber(x) { return (x = Number(x)) >= 0 ? x : false; }
 
 // Returns handle if it can be created, or error code if it can't
@@ -1931,6 +2096,13 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
   this._handle.onconnection = onconnection;
   this._handle[owner_symbol] = this;
 
+  const rateLimit = this[kConnectionRateLimit];
+  if (rateLimit !== undefined &&
+      typeof this._handle.setConnectionRateLimit === 'function') {
+    this._handle.setConnectionRateLimit(
+      rateLimit.rate, rateLimit.burst, rateLimit.maxAddresses);
+  }
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
@@ -2232,6 +2404,21 @@ Server.prototype.address = function() {
   return null;
 };
 
+Server.prototype.createAcceptHistogram = function() {
+  if (!this._handle) {
+    throw new ERR_SERVER_NOT_RUNNING();
+  }
+  // Servers sharing a round-robin handle in a cluster worker never accept
+  // connections themselves, the primary does.
+  if (typeof this._handle.createAcceptHistogram !== 'function') {
+    throw new ERR_INVALID_STATE(
+      'Accept histograms are only available for TCP servers that own their ' +
+      'listening socket');
+  }
+  ClonedHistogram ??= require('internal/histogram').ClonedHistogram;
+  return new ClonedHistogram(this._handle.createAcceptHistogram());
+};
+
 function onconnection(err, clientHandle) {
   const handle = this;
   const self = handle[owner_symbol];
@@ -2284,6 +2471,7 @@ function onconnection(err, clientHandle) {
     writable: true,
     readableHighWaterMark: self.highWaterMark,
     writableHighWaterMark: self.highWaterMark,
+    autoCork: self.autoCork,
   });
 
   if (self.noDelay && clientHandle.setNoDelay) {
@@ -57,6 +57,11 @@ const {
   getLazy,
 } = require('internal/util');
 
+const {
+  isNormalizedPosix,
+  isNormalizedWin32,
+} = internalBinding('path');
+
 const lazyMatchGlobPattern = getLazy(() => require('internal/fs/glob').matchGlobPattern);
 
 function isPathSeparator(code) {
@@ -318,6 +323,15 @@ const win32 = {
     // but handle relative paths to be safe (might happen when process.cwd()
     // fails)
 
+    // Fast path for a tail that is already normalized, which only needs the
+    // trailing separator added above to be removed.
+    if (resolvedAbsolute && resolvedTail.length > 0) {
+      const resolvedPath = `${resolvedDevice}\\${resolvedTail}`;
+      if (isNormalizedWin32(resolvedPath)) {
+        return StringPrototypeSlice(resolvedPath, 0, -1);
+      }
+    }
+
     // Normalize the tail path
     resolvedTail = normalizeString(resolvedTail, !resolvedAbsolute, '\\',
                                    isPathSeparator);
@@ -336,6 +350,8 @@ const win32 = {
     const len = path.length;
     if (len === 0)
       return '.';
+    if (isNormalizedWin32(path))
+      return path;
     let rootEnd = 0;
     let device;
     let isAbsolute = false;
@@ -1214,6 +1230,12 @@ const posix = {
     // At this point the path should be resolved to a full absolute path, but
     // handle relative paths to be safe (might happen when process.cwd() fails)
 
+    // Fast path for a path that is already normalized, which only needs the
+    // trailing separator added above to be removed.
+    if (resolvedAbsolute && isNormalizedPosix(resolvedPath)) {
+      return StringPrototypeSlice(resolvedPath, 0, -1);
+    }
+
     // Normalize the path
     resolvedPath = normalizeString(resolvedPath, !resolvedAbsolute, '/',
                                    isPosixPathSeparator);
@@ -1234,6 +1256,9 @@ const posix = {
     if (path.length === 0)
       return '.';
 
+    if (isNormalizedPosix(path))
+      return path;
+
     const isAbsolute =
       StringPrototypeCharCodeAt(path, 0) === CHAR_FORWARD_SLASH;
     const trailingSeparator =
@@ -28,6 +28,12 @@ const {
 } = require('internal/histogram');
 
 const monitorEventLoopDelay = require('internal/perf/event_loop_delay');
+const createThreadPoolWorkHistograms = require('internal/perf/threadpool_work');
+const {
+  createEventLoopPhaseHistograms,
+  eventLoopCallbackCounts,
+  eventLoopStalls,
+} = require('internal/perf/event_loop_phases');
 
 module.exports = {
   Performance,
@@ -39,6 +45,10 @@ module.exports = {
   PerformanceResourceTiming,
   monitorEventLoopDelay,
   createHistogram,
+  createThreadPoolWorkHistograms,
+  createEventLoopPhaseHistograms,
+  eventLoopCallbackCounts,
+  eventLoopStalls,
   performance,
 };
 
@@ -32,6 +32,7 @@ const {
   ObjectKeys,
   String,
   StringPrototypeCharCodeAt,
+  StringPrototypeIsWellFormed,
   StringPrototypeSlice,
   decodeURIComponent,
 } = primordials;
@@ -42,6 +43,7 @@ const {
   hexTable,
   isHexTable,
 } = require('internal/querystring');
+const { parseSearchParams } = internalBinding('url');
 const QueryString = module.exports = {
   unescapeBuffer,
   // `unescape()` is a JS global, so we need to use a different local name
@@ -343,6 +345,22 @@ function parse(qs, sep, eq, options) {
   }
   const customDecode = (decode !== qsUnescape);
 
+  // With the default separators and decoder, the pairs are split and decoded
+  // by the same C++ parser as URLSearchParams. Strings with lone surrogates,
+  // which it would replace, and strings that qsUnescape() decodes byte by
+  // byte are left to the loop below.
+  if (!customDecode &&
+      sepLen === 1 && sepCodes[0] === 38/* & */ &&
+      eqLen === 1 && eqCodes[0] === 61/* = */ &&
+      StringPrototypeIsWellFormed(qs)) {
+    const params = parseSearchParams(qs, pairs, true);
+    if (params !== undefined) {
+      for (let i = 0; i < params.length; i += 2)
+        addKeyVal(obj, params[i], params[i + 1], false, false, decode);
+      return obj;
+    }
+  }
+
   let lastPos = 0;
   let sepIdx = 0;
   let eqIdx = 0;
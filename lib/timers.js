@@ -46,7 +46,7 @@ const {
   kRefed,
   kHasPrimitive,
   timerListMap,
-  timerListQueue,
+  removeTimersList,
   immediateQueue,
   insert,
   knownTimersById,
@@ -95,8 +95,7 @@ function unenroll(item) {
     const list = timerListMap[msecs];
     if (list !== undefined && L.isEmpty(list)) {
       debug('unenroll: list empty');
-      timerListQueue.removeAt(list.priorityQueuePosition);
-      delete timerListMap[list.msecs];
+      removeTimersList(list);
     }
 
     decRefCount();
@@ -388,6 +388,7 @@ exports.checkServerIdentity = function checkServerIdentity(hostname, cert) {
 
 exports.createSecureContext = tlsCommon.createSecureContext;
 exports.SecureContext = tlsCommon.SecureContext;
+exports.SessionCache = require('internal/tls/session-cache').SessionCache;
 exports.TLSSocket = tlsWrap.TLSSocket;
 exports.Server = tlsWrap.Server;
 exports.createServer = tlsWrap.createServer;
@@ -33,7 +33,7 @@ const {
   decodeURIComponent,
 } = primordials;
 
-const { URLPattern } = internalBinding('url_pattern');
+const { URLPattern, URLPatternList } = internalBinding('url_pattern');
 const { toASCII } = internalBinding('encoding_binding');
 const { encodeStr, hexTable } = require('internal/querystring');
 const querystring = require('querystring');
@@ -60,6 +60,7 @@ const {
   domainToASCII,
   domainToUnicode,
   fileURLToPath,
+  parseMany,
   pathToFileURL: _pathToFileURL,
   urlToHttpOptions,
   unsafeProtocol,
@@ -1030,6 +1031,7 @@ module.exports = {
   // WHATWG API
   URL,
   URLPattern,
+  URLPatternList,
   URLSearchParams,
   domainToASCII,
   domainToUnicode,
@@ -1037,5 +1039,6 @@ module.exports = {
   // Utilities
   pathToFileURL,
   fileURLToPath,
+  parseMany,
   urlToHttpOptions,
 };
@@ -19,6 +19,7 @@ const {
   BigInt64Array,
   BigUint64Array,
   DataView,
+  DateNow,
   Error,
   Float32Array,
   Float64Array,
@@ -38,6 +39,14 @@ const {
 
 const { Buffer } = require('buffer');
 const {
+  codes: {
+    ERR_INVALID_STATE,
+  },
+} = require('internal/errors');
+const { kEmptyObject } = require('internal/util');
+const {
+  validateInteger,
+  validateObject,
   validateString,
   validateUint32,
   validateOneOf,
@@ -147,10 +156,33 @@ const {
   kExternalScriptSourceSizeIndex,
   kCPUProfilerMetaDataSizeIndex,
 
+  // Properties for GC profiler statistics buffer extraction.
+  kGCTypes,
+  kGCTypeStatisticsPropertiesCount,
+  kGCCountIndex,
+  kGCPauseTotalIndex,
+  kGCPauseMinIndex,
+  kGCPauseMaxIndex,
+  kGCPauseMeanIndex,
+  kGCPauseStddevIndex,
+  kGCPauseP50Index,
+  kGCPauseP90Index,
+  kGCPauseP99Index,
+  kGCBytesFreedIndex,
+  kGCBytesPromotedIndex,
+  kGCSpaceStatisticsPropertiesCount,
+  kGCSpaceCountIndex,
+  kGCSpaceBytesFreedIndex,
+  kGCSpaceBytesFreedMaxIndex,
+  kGCSpaceBytesFreedMeanIndex,
+  kGCSpaceBytesFreedP50Index,
+  kGCSpaceBytesFreedP99Index,
+
   heapStatisticsBuffer,
   heapCodeStatisticsBuffer,
   heapSpaceStatisticsBuffer,
   getCppHeapStatistics: _getCppHeapStatistics,
+  getNativeMemoryStatistics,
   detailLevel,
 } = binding;
 
@@ -347,9 +379,22 @@ function arrayBufferViewIndexToType(index) {
 }
 
 class DefaultSerializer extends Serializer {
-  constructor() {
+  #externalThreshold = Infinity;
+
+  constructor(options = kEmptyObject) {
     super();
 
+    validateObject(options, 'options');
+    const { bufferSize, externalThreshold } = options;
+    if (bufferSize !== undefined) {
+      validateInteger(bufferSize, 'options.bufferSize', 0);
+      this._setInitialBufferSize(bufferSize);
+    }
+    if (externalThreshold !== undefined) {
+      validateInteger(externalThreshold, 'options.externalThreshold', 0);
+      this.#externalThreshold = externalThreshold;
+    }
+
     this._setTreatArrayBufferViewsAsHostObjects(true);
   }
 
@@ -377,6 +422,10 @@ class DefaultSerializer extends Serializer {
     }
     this.writeUint32(i);
     this.writeUint32(abView.byteLength);
+    if (abView.byteLength >= this.#externalThreshold) {
+      this.writeExternalBytes(abView);
+      return;
+    }
     this.writeRawBytes(new Uint8Array(abView.buffer,
                                       abView.byteOffset,
                                       abView.byteLength));
@@ -415,10 +464,14 @@ class DefaultDeserializer extends Deserializer {
  * Uses a `DefaultSerializer` to serialize `value`
  * into a buffer.
  * @param {any} value
+ * @param {{
+ *   bufferSize?: number,
+ *   externalThreshold?: number,
+ *   }} [options]
  * @returns {Buffer}
  */
-function serialize(value) {
-  const ser = new DefaultSerializer();
+function serialize(value, options) {
+  const ser = new DefaultSerializer(options);
   ser.writeHeader();
   ser.writeValue(value);
   return ser.releaseBuffer();
@@ -436,21 +489,88 @@ function deserialize(buffer) {
   return der.readValue();
 }
 
+function getGCStatistics(profiler, startTime) {
+  profiler.updateStatisticsBuffer();
+  const buffer = profiler.statisticsBuffer;
+
+  const gcTypes = { __proto__: null };
+  for (let i = 0; i < kGCTypes.length; i++) {
+    const offset = i * kGCTypeStatisticsPropertiesCount;
+    gcTypes[kGCTypes[i]] = {
+      count: buffer[offset + kGCCountIndex],
+      pauseTotal: buffer[offset + kGCPauseTotalIndex],
+      pauseMin: buffer[offset + kGCPauseMinIndex],
+      pauseMax: buffer[offset + kGCPauseMaxIndex],
+      pauseMean: buffer[offset + kGCPauseMeanIndex],
+      pauseStddev: buffer[offset + kGCPauseStddevIndex],
+      pauseP50: buffer[offset + kGCPauseP50Index],
+      pauseP90: buffer[offset + kGCPauseP90Index],
+      pauseP99: buffer[offset + kGCPauseP99Index],
+      bytesFreed: buffer[offset + kGCBytesFreedIndex],
+      bytesPromoted: buffer[offset + kGCBytesPromotedIndex],
+    };
+  }
+
+  const heapSpaces = { __proto__: null };
+  const spacesOffset = kGCTypes.length * kGCTypeStatisticsPropertiesCount;
+  for (let i = 0; i < kNumberOfHeapSpaces; i++) {
+    const offset = spacesOffset + i * kGCSpaceStatisticsPropertiesCount;
+    heapSpaces[kHeapSpaces[i]] = {
+      count: buffer[offset + kGCSpaceCountIndex],
+      bytesFreed: buffer[offset + kGCSpaceBytesFreedIndex],
+      bytesFreedMax: buffer[offset + kGCSpaceBytesFreedMaxIndex],
+      bytesFreedMean: buffer[offset + kGCSpaceBytesFreedMeanIndex],
+      bytesFreedP50: buffer[offset + kGCSpaceBytesFreedP50Index],
+      bytesFreedP99: buffer[offset + kGCSpaceBytesFreedP99Index],
+    };
+  }
+
+  return { startTime, gcTypes, heapSpaces };
+}
+
 class GCProfiler {
   #profiler = null;
+  #mode;
+  #startTime = 0;
+
+  /**
+   * @param {{
+   *   mode?: 'json' | 'histogram'
+   * }} [options]
+   */
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const { mode = 'json' } = options;
+    validateOneOf(mode, 'options.mode', ['json', 'histogram']);
+    this.#mode = mode;
+  }
 
   start() {
     if (!this.#profiler) {
-      this.#profiler = new binding.GCProfiler();
+      this.#profiler = new binding.GCProfiler(this.#mode === 'histogram');
+      this.#startTime = DateNow();
       this.#profiler.start();
     }
   }
 
+  getStatistics() {
+    if (this.#mode !== 'histogram') {
+      throw new ERR_INVALID_STATE('The profiler is not in the histogram mode');
+    }
+    if (this.#profiler) {
+      return getGCStatistics(this.#profiler, this.#startTime);
+    }
+  }
+
   stop() {
     if (this.#profiler) {
-      const data = this.#profiler.stop();
+      const profiler = this.#profiler;
       this.#profiler = null;
-      return JSONParse(data);
+      if (this.#mode === 'histogram') {
+        profiler.stop();
+        return getGCStatistics(profiler, this.#startTime);
+      }
+      return JSONParse(profiler.stop());
     }
   }
 }
@@ -462,6 +582,7 @@ module.exports = {
   getHeapSpaceStatistics,
   getHeapCodeStatistics,
   getCppHeapStatistics,
+  getNativeMemoryStatistics,
   setFlagsFromString,
   Serializer,
   Deserializer,
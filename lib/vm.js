@@ -34,6 +34,7 @@ const {
   makeContext,
   constants,
   measureMemory: _measureMemory,
+  setContextPoolSize: _setContextPoolSize,
 } = internalBinding('contextify');
 const {
   ERR_CONTEXT_NOT_INITIALIZED,
@@ -67,6 +68,9 @@ const {
   vm_dynamic_import_main_context_default,
   vm_context_no_contextify,
 } = internalBinding('symbols');
+const {
+  throwIfBuildingSnapshot,
+} = require('internal/v8/startup_snapshot');
 const kParsingContext = Symbol('script parsing context');
 
 /**
@@ -96,6 +100,7 @@ class Script extends ContextifyScript {
       columnOffset = 0,
       cachedData,
       produceCachedData = false,
+      useCompileCache = false,
       importModuleDynamically,
       [kParsingContext]: parsingContext,
     } = options;
@@ -107,6 +112,7 @@ class Script extends ContextifyScript {
       validateBuffer(cachedData, 'options.cachedData');
     }
     validateBoolean(produceCachedData, 'options.produceCachedData');
+    validateBoolean(useCompileCache, 'options.useCompileCache');
 
     const hostDefinedOptionId =
         getHostDefinedOptionId(importModuleDynamically, filename);
@@ -121,7 +127,8 @@ class Script extends ContextifyScript {
             cachedData,
             produceCachedData,
             parsingContext,
-            hostDefinedOptionId);
+            hostDefinedOptionId,
+            useCompileCache);
     } catch (e) {
       throw e; /* node-do-not-add-exception-line */
     }
@@ -331,6 +338,7 @@ function compileFunction(code, params, options = kEmptyObject) {
     produceCachedData = false,
     parsingContext = undefined,
     contextExtensions = [],
+    useCompileCache = false,
     importModuleDynamically,
   } = options;
 
@@ -340,6 +348,7 @@ function compileFunction(code, params, options = kEmptyObject) {
   if (cachedData !== undefined)
     validateBuffer(cachedData, 'options.cachedData');
   validateBoolean(produceCachedData, 'options.produceCachedData');
+  validateBoolean(useCompileCache, 'options.useCompileCache');
   if (parsingContext !== undefined) {
     if (
       typeof parsingContext !== 'object' ||
@@ -365,7 +374,7 @@ function compileFunction(code, params, options = kEmptyObject) {
   return internalCompileFunction(
     code, filename, lineOffset, columnOffset,
     cachedData, produceCachedData, parsingContext, contextExtensions,
-    params, hostDefinedOptionId, importModuleDynamically,
+    params, hostDefinedOptionId, importModuleDynamically, useCompileCache,
   ).function;
 }
 
@@ -393,6 +402,17 @@ function measureMemory(options = kEmptyObject) {
   return result;
 }
 
+/**
+ * Sets the number of contexts that are created ahead of time for
+ * vm.createContext().
+ * @param {number} size
+ */
+function setContextPoolSize(size) {
+  validateUint32(size, 'size');
+  throwIfBuildingSnapshot('vm.setContextPoolSize()');
+  _setContextPoolSize(size);
+}
+
 const vmConstants = {
   __proto__: null,
   USE_MAIN_CONTEXT_DEFAULT_LOADER: vm_dynamic_import_main_context_default,
@@ -411,6 +431,7 @@ module.exports = {
   isContext,
   compileFunction,
   measureMemory,
+  setContextPoolSize,
   constants: vmConstants,
 };
 
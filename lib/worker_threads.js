@@ -24,6 +24,10 @@ const {
   postMessageToThread,
 } = require('internal/worker/messaging');
 
+const {
+  SharedBufferPool,
+} = require('internal/worker/shared_buffer_pool');
+
 const {
   markAsUntransferable,
   isMarkedAsUntransferable,
@@ -43,6 +47,7 @@ module.exports = {
   postMessageToThread,
   threadId,
   SHARE_ENV,
+  SharedBufferPool,
   Worker,
   parentPort: null,
   workerData: null,
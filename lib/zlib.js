@@ -23,6 +23,7 @@
 
 const {
   ArrayBuffer,
+  ArrayPrototypePush,
   MathMax,
   NumberIsNaN,
   ObjectDefineProperties,
@@ -40,6 +41,7 @@ const {
   codes: {
     ERR_BROTLI_INVALID_PARAM,
     ERR_BUFFER_TOO_LARGE,
+    ERR_INCOMPATIBLE_OPTION_PAIR,
     ERR_INVALID_ARG_TYPE,
     ERR_OUT_OF_RANGE,
     ERR_TRAILING_JUNK_AFTER_STREAM_END,
@@ -50,6 +52,7 @@ const {
 const { Transform, finished } = require('stream');
 const {
   deprecateInstantiation,
+  kEmptyObject,
 } = require('internal/util');
 const {
   isArrayBufferView,
@@ -57,19 +60,33 @@ const {
   isUint8Array,
 } = require('internal/util/types');
 const binding = internalBinding('zlib');
-const { crc32: crc32Native } = binding;
+const {
+  crc32: crc32Native,
+  deflateBound: deflateBoundNative,
+  trainZstdDictionary: trainZstdDictionaryNative,
+  zlibOneShot,
+} = binding;
 const assert = require('internal/assert');
 const {
   Buffer,
   kMaxLength,
 } = require('buffer');
+const { FastBuffer } = require('internal/buffer');
 const { owner_symbol } = require('internal/async_hooks').symbols;
 const {
   checkRangesOrGetDefault,
+  validateArray,
   validateFunction,
+  validateInteger,
+  validateObject,
+  validateOneOf,
   validateUint32,
   validateFiniteNumber,
 } = require('internal/validators');
+const {
+  ZstdDictionary,
+  kHandle: kZstdDictionaryHandle,
+} = require('internal/zlib/zstd_dictionary');
 
 const kFlushFlag = Symbol('kFlushFlag');
 const kError = Symbol('kError');
@@ -606,42 +623,54 @@ const zlibDefaultOpts = {
 };
 // Base class for all streams actually backed by zlib and using zlib-specific
 // parameters.
-function Zlib(opts, mode) {
-  let windowBits = Z_DEFAULT_WINDOWBITS;
-  let level = Z_DEFAULT_COMPRESSION;
-  let memLevel = Z_DEFAULT_MEMLEVEL;
-  let strategy = Z_DEFAULT_STRATEGY;
-  let dictionary;
+// Returns the validated zlib parameters in `opts`.
+function zlibParams(opts, mode) {
+  const params = {
+    __proto__: null,
+    windowBits: Z_DEFAULT_WINDOWBITS,
+    level: Z_DEFAULT_COMPRESSION,
+    memLevel: Z_DEFAULT_MEMLEVEL,
+    strategy: Z_DEFAULT_STRATEGY,
+  };
+  if (!opts)
+    return params;
+
+  // windowBits is special. On the compression side, 0 is an invalid value.
+  // But on the decompression side, a value of 0 for windowBits tells zlib
+  // to use the window size in the zlib header of the compressed stream.
+  if ((opts.windowBits == null || opts.windowBits === 0) &&
+      (mode === INFLATE ||
+       mode === GUNZIP ||
+       mode === UNZIP)) {
+    params.windowBits = 0;
+  } else {
+    // `{ windowBits: 8 }` is valid for deflate but not gzip.
+    const min = Z_MIN_WINDOWBITS + (mode === GZIP ? 1 : 0);
+    params.windowBits = checkRangesOrGetDefault(
+      opts.windowBits, 'options.windowBits',
+      min, Z_MAX_WINDOWBITS, Z_DEFAULT_WINDOWBITS);
+  }
 
-  if (opts) {
-    // windowBits is special. On the compression side, 0 is an invalid value.
-    // But on the decompression side, a value of 0 for windowBits tells zlib
-    // to use the window size in the zlib header of the compressed stream.
-    if ((opts.windowBits == null || opts.windowBits === 0) &&
-        (mode === INFLATE ||
-         mode === GUNZIP ||
-         mode === UNZIP)) {
-      windowBits = 0;
-    } else {
-      // `{ windowBits: 8 }` is valid for deflate but not gzip.
-      const min = Z_MIN_WINDOWBITS + (mode === GZIP ? 1 : 0);
-      windowBits = checkRangesOrGetDefault(
-        opts.windowBits, 'options.windowBits',
-        min, Z_MAX_WINDOWBITS, Z_DEFAULT_WINDOWBITS);
-    }
+  params.level = checkRangesOrGetDefault(
+    opts.level, 'options.level',
+    Z_MIN_LEVEL, Z_MAX_LEVEL, Z_DEFAULT_COMPRESSION);
+
+  params.memLevel = checkRangesOrGetDefault(
+    opts.memLevel, 'options.memLevel',
+    Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_MEMLEVEL);
 
-    level = checkRangesOrGetDefault(
-      opts.level, 'options.level',
-      Z_MIN_LEVEL, Z_MAX_LEVEL, Z_DEFAULT_COMPRESSION);
+  params.strategy = checkRangesOrGetDefault(
+    opts.strategy, 'options.strategy',
+    Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
 
-    memLevel = checkRangesOrGetDefault(
-      opts.memLevel, 'options.memLevel',
-      Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_MEMLEVEL);
+  return params;
+}
 
-    strategy = checkRangesOrGetDefault(
-      opts.strategy, 'options.strategy',
-      Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
+function Zlib(opts, mode) {
+  const { windowBits, level, memLevel, strategy } = zlibParams(opts, mode);
+  let dictionary;
 
+  if (opts) {
     dictionary = opts.dictionary;
     if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
       if (isAnyArrayBuffer(dictionary)) {
@@ -787,6 +816,241 @@ function createConvenienceMethod(ctor, sync) {
   };
 }
 
+const kMinParallelBlockSize = 32 * 1024;
+const kMaxParallelBlockSize = 1024 * 1024 * 1024;
+const kDefaultParallelBlockSize = 128 * 1024;
+const kMaxParallelism = 1024;
+
+// Returns the validated parallel compression options in `opts`,
+// or undefined when the input should go through a regular stream instead.
+// The blocks are deflated without a preset dictionary and the engine is not
+// exposed, so `info` and `dictionary` always use the stream.
+function parallelDeflateArgs(opts, mode) {
+  if (opts == null || opts.parallelism == null ||
+      opts.dictionary !== undefined || opts.info)
+    return;
+
+  const parallelism = checkRangesOrGetDefault(
+    opts.parallelism, 'options.parallelism', 1, kMaxParallelism, 1);
+  const blockSize = checkRangesOrGetDefault(
+    opts.blockSize, 'options.blockSize',
+    kMinParallelBlockSize, kMaxParallelBlockSize, kDefaultParallelBlockSize);
+  if (parallelism === 1)
+    return;
+
+  const { windowBits, level, memLevel, strategy } = zlibParams(opts, mode);
+  const maxOutputLength = checkRangesOrGetDefault(
+    opts.maxOutputLength, 'options.maxOutputLength',
+    1, kMaxLength, kMaxLength);
+
+  return {
+    __proto__: null,
+    mode,
+    level,
+    windowBits,
+    memLevel,
+    strategy,
+    blockSize,
+    parallelism,
+    maxOutputLength,
+  };
+}
+
+function convenienceMethodInput(buffer) {
+  if (typeof buffer === 'string')
+    return Buffer.from(buffer);
+  if (isArrayBufferView(buffer))
+    return buffer;
+  if (isAnyArrayBuffer(buffer))
+    return Buffer.from(buffer);
+  throw new ERR_INVALID_ARG_TYPE(
+    'buffer',
+    ['string', 'Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+    buffer,
+  );
+}
+
+function parallelDeflateResult(result, maxOutputLength) {
+  if (typeof result === 'number') {
+    const code = codes[result];
+    return genericNodeError(`Compression failed: ${code}`,
+                            { errno: result, code });
+  }
+  if (result.length > maxOutputLength)
+    return new ERR_BUFFER_TOO_LARGE(maxOutputLength);
+  return result;
+}
+
+function compressParallel(job, buffer, options, sync) {
+  return job.compress(buffer, options.mode, options.level, options.windowBits,
+                      options.memLevel, options.strategy, options.blockSize,
+                      options.parallelism, sync);
+}
+
+function parallelDeflateSync(buffer, options) {
+  buffer = convenienceMethodInput(buffer);
+  const job = new binding.ParallelDeflate();
+  const result = parallelDeflateResult(
+    compressParallel(job, buffer, options, true), options.maxOutputLength);
+  if (!isUint8Array(result))
+    throw result;
+  return result;
+}
+
+function parallelDeflate(buffer, options, callback) {
+  validateFunction(callback, 'callback');
+  buffer = convenienceMethodInput(buffer);
+  const job = new binding.ParallelDeflate();
+  job.oncomplete = (errno, result) => {
+    result = parallelDeflateResult(errno === 0 ? result : errno,
+                                   options.maxOutputLength);
+    if (isUint8Array(result))
+      callback(null, result);
+    else
+      callback(result);
+  };
+  compressParallel(job, buffer, options, false);
+}
+
+// Inputs up to this size are run through a zlib state at once, into a scratch
+// buffer, instead of through a stream.
+const kMaxOneShotInputLength = 16 * 1024;
+const kOneShotScratchLength = 64 * 1024;
+let oneShotScratch;
+
+// Returns the validated parameters for zlibOneShot() in `opts`, or undefined
+// when the input has to go through a regular stream. `oneShot` is false when
+// only `options.output` needs handling.
+function zlibOneShotArgs(opts, mode) {
+  if (opts == null) {
+    return {
+      __proto__: null,
+      oneShot: true,
+      mode,
+      ...zlibParams(opts, mode),
+      maxOutputLength: kMaxLength,
+      output: undefined,
+    };
+  }
+
+  const { output } = opts;
+  if (output !== undefined) {
+    if (!isArrayBufferView(output)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'options.output', ['Buffer', 'TypedArray', 'DataView'], output);
+    }
+    if (opts.info)
+      throw new ERR_INCOMPATIBLE_OPTION_PAIR('output', 'info');
+  }
+  // The stream validates and applies these.
+  const oneShot = !opts.info && opts.dictionary === undefined &&
+    opts.flush === undefined && opts.finishFlush === undefined &&
+    opts.chunkSize === undefined;
+  if (!oneShot) {
+    if (output === undefined)
+      return;
+    return { __proto__: null, oneShot, output };
+  }
+
+  return {
+    __proto__: null,
+    oneShot,
+    mode,
+    ...zlibParams(opts, mode),
+    maxOutputLength: checkRangesOrGetDefault(
+      opts.maxOutputLength, 'options.maxOutputLength',
+      1, kMaxLength, kMaxLength),
+    output,
+  };
+}
+
+function zlibOneShotSync(ctor, buffer, opts, args) {
+  buffer = convenienceMethodInput(buffer);
+  const { output } = args;
+
+  if (args.oneShot &&
+      (output !== undefined || buffer.byteLength <= kMaxOneShotInputLength)) {
+    let { mode } = args;
+    if (mode === UNZIP) {
+      mode = buffer.byteLength >= 2 && buffer[0] === 0x1f &&
+        buffer[1] === 0x8b ? GUNZIP : INFLATE;
+    }
+    const target = output ??
+      (oneShotScratch ??= Buffer.allocUnsafeSlow(kOneShotScratchLength));
+    const length = zlibOneShot(mode, buffer, target, args.level,
+                               args.windowBits, args.memLevel, args.strategy);
+    if (length >= 0 && length <= args.maxOutputLength) {
+      if (output !== undefined)
+        return new FastBuffer(output.buffer, output.byteOffset, length);
+      const result = Buffer.allocUnsafe(length);
+      target.copy(result, 0, 0, length);
+      return result;
+    }
+  }
+
+  // The stream reports the errors, and the size that the output needs.
+  const result = zlibBufferSync(new ctor(opts), buffer);
+  if (output === undefined)
+    return result;
+  if (result.length > output.byteLength) {
+    throw new ERR_OUT_OF_RANGE('options.output.byteLength',
+                               `>= ${result.length}`, output.byteLength);
+  }
+  const view = new FastBuffer(output.buffer, output.byteOffset, result.length);
+  result.copy(view);
+  return view;
+}
+
+// Like createConvenienceMethod(), but compresses the input in blocks on
+// several threads when `options.parallelism` asks for it, and runs small
+// inputs of the synchronous methods through zlib without a stream.
+function createZlibConvenienceMethod(ctor, mode, sync) {
+  const compress = mode === DEFLATE || mode === GZIP || mode === DEFLATERAW;
+  if (sync) {
+    return function syncBufferWrapper(buffer, opts) {
+      if (compress) {
+        const parallel = parallelDeflateArgs(opts, mode);
+        if (parallel !== undefined)
+          return parallelDeflateSync(buffer, parallel);
+      }
+      const oneShot = zlibOneShotArgs(opts, mode);
+      if (oneShot !== undefined)
+        return zlibOneShotSync(ctor, buffer, opts, oneShot);
+      return zlibBufferSync(new ctor(opts), buffer);
+    };
+  }
+  return function asyncBufferWrapper(buffer, opts, callback) {
+    if (typeof opts === 'function') {
+      callback = opts;
+      opts = {};
+    }
+    if (compress) {
+      const parallel = parallelDeflateArgs(opts, mode);
+      if (parallel !== undefined)
+        return parallelDeflate(buffer, parallel, callback);
+    }
+    return zlibBuffer(new ctor(opts), buffer, callback);
+  };
+}
+
+const kDeflateBoundFormats = {
+  __proto__: null,
+  deflate: DEFLATE,
+  deflateRaw: DEFLATERAW,
+  gzip: GZIP,
+};
+
+function deflateBound(length, options = kEmptyObject) {
+  validateInteger(length, 'length', 0, kMaxLength);
+  validateObject(options, 'options');
+  const { format = 'deflate' } = options;
+  validateOneOf(format, 'options.format', ['deflate', 'deflateRaw', 'gzip']);
+  const mode = kDeflateBoundFormats[format];
+  const { windowBits, level, memLevel, strategy } = zlibParams(options, mode);
+  return deflateBoundNative(mode, length, level, windowBits, memLevel,
+                            strategy);
+}
+
 const kMaxBrotliParam = MathMax(
   ...ObjectEntries(constants)
     .map(({ 0: key, 1: value }) => (key.startsWith('BROTLI_PARAM_') ? value : 0)),
@@ -881,12 +1145,29 @@ class Zstd extends ZlibBase {
 
     const pledgedSrcSize = opts?.pledgedSrcSize ?? undefined;
 
+    let dictionary = opts?.dictionary;
+    if (ZstdDictionary.isZstdDictionary(dictionary)) {
+      dictionary = dictionary[kZstdDictionaryHandle];
+    } else if (isAnyArrayBuffer(dictionary)) {
+      dictionary = Buffer.from(dictionary);
+    } else if (isArrayBufferView(dictionary) && !isUint8Array(dictionary)) {
+      dictionary = Buffer.from(dictionary.buffer, dictionary.byteOffset,
+                               dictionary.byteLength);
+    } else if (dictionary !== undefined && !isUint8Array(dictionary)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'options.dictionary',
+        ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer', 'ZstdDictionary'],
+        dictionary,
+      );
+    }
+
     const writeState = new Uint32Array(2);
     handle.init(
       initParamsArray,
       pledgedSrcSize,
       writeState,
       processCallback,
+      dictionary,
     );
     super(opts, mode, handle, zstdDefaultOpts);
     this._writeState = writeState;
@@ -921,6 +1202,33 @@ class ZstdDecompress extends Zstd {
   }
 }
 
+// The default of `zstd --train`.
+const kDefaultZstdDictionarySize = 112640;
+
+function trainZstdDictionary(samples, options = kEmptyObject) {
+  validateArray(samples, 'samples');
+  validateObject(options, 'options');
+  const { dictionarySize = kDefaultZstdDictionarySize } = options;
+  validateUint32(dictionarySize, 'options.dictionarySize', true);
+  const buffers = [];
+  for (let i = 0; i < samples.length; i++) {
+    let sample = samples[i];
+    if (typeof sample === 'string') {
+      sample = Buffer.from(sample);
+    } else if (isAnyArrayBuffer(sample)) {
+      sample = Buffer.from(sample);
+    } else if (!isArrayBufferView(sample)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `samples[${i}]`,
+        ['string', 'Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+        sample,
+      );
+    }
+    ArrayPrototypePush(buffers, sample);
+  }
+  return trainZstdDictionaryNative(buffers, dictionarySize);
+}
+
 function createProperty(ctor) {
   return {
     __proto__: null,
@@ -950,6 +1258,7 @@ ObjectDefineProperty(binding.Zlib.prototype, 'jsref', {
 
 module.exports = {
   crc32,
+  deflateBound,
   Deflate,
   Inflate,
   Gzip,
@@ -961,23 +1270,25 @@ module.exports = {
   BrotliDecompress,
   ZstdCompress,
   ZstdDecompress,
+  ZstdDictionary,
+  trainZstdDictionary,
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
-  deflate: createConvenienceMethod(Deflate, false),
-  deflateSync: createConvenienceMethod(Deflate, true),
-  gzip: createConvenienceMethod(Gzip, false),
-  gzipSync: createConvenienceMethod(Gzip, true),
-  deflateRaw: createConvenienceMethod(DeflateRaw, false),
-  deflateRawSync: createConvenienceMethod(DeflateRaw, true),
-  unzip: createConvenienceMethod(Unzip, false),
-  unzipSync: createConvenienceMethod(Unzip, true),
-  inflate: createConvenienceMethod(Inflate, false),
-  inflateSync: createConvenienceMethod(Inflate, true),
-  gunzip: createConvenienceMethod(Gunzip, false),
-  gunzipSync: createConvenienceMethod(Gunzip, true),
-  inflateRaw: createConvenienceMethod(InflateRaw, false),
-  inflateRawSync: createConvenienceMethod(InflateRaw, true),
+  deflate: createZlibConvenienceMethod(Deflate, DEFLATE, false),
+  deflateSync: createZlibConvenienceMethod(Deflate, DEFLATE, true),
+  gzip: createZlibConvenienceMethod(Gzip, GZIP, false),
+  gzipSync: createZlibConvenienceMethod(Gzip, GZIP, true),
+  deflateRaw: createZlibConvenienceMethod(DeflateRaw, DEFLATERAW, false),
+  deflateRawSync: createZlibConvenienceMethod(DeflateRaw, DEFLATERAW, true),
+  unzip: createZlibConvenienceMethod(Unzip, UNZIP, false),
+  unzipSync: createZlibConvenienceMethod(Unzip, UNZIP, true),
+  inflate: createZlibConvenienceMethod(Inflate, INFLATE, false),
+  inflateSync: createZlibConvenienceMethod(Inflate, INFLATE, true),
+  gunzip: createZlibConvenienceMethod(Gunzip, GUNZIP, false),
+  gunzipSync: createZlibConvenienceMethod(Gunzip, GUNZIP, true),
+  inflateRaw: createZlibConvenienceMethod(InflateRaw, INFLATERAW, false),
+  inflateRawSync: createZlibConvenienceMethod(InflateRaw, INFLATERAW, true),
   brotliCompress: createConvenienceMethod(BrotliCompress, false),
   brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
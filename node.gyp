@@ -88,6 +88,7 @@
       'src/heap_utils.cc',
       'src/histogram.cc',
       'src/internal_only_v8.cc',
+      'src/io_uring_stream.cc',
       'src/js_native_api.h',
       'src/js_native_api_types.h',
       'src/js_native_api_v8.cc',
@@ -111,6 +112,7 @@
       'src/node_contextify.cc',
       'src/node_credentials.cc',
       'src/node_debug.cc',
+      'src/node_diagnostics_channel.cc',
       'src/node_dir.cc',
       'src/node_dotenv.cc',
       'src/node_env_var.cc',
@@ -118,6 +120,7 @@
       'src/node_external_reference.cc',
       'src/node_file.cc',
       'src/node_http_parser.cc',
+      'src/node_http_serializer.cc',
       'src/node_http2.cc',
       'src/node_i18n.cc',
       'src/node_main_instance.cc',
@@ -126,6 +129,7 @@
       'src/node_modules.cc',
       'src/node_options.cc',
       'src/node_os.cc',
+      'src/node_path.cc',
       'src/node_perf.cc',
       'src/node_platform.cc',
       'src/node_postmortem_metadata.cc',
@@ -142,6 +146,7 @@
       'src/node_snapshotable.cc',
       'src/node_sockaddr.cc',
       'src/node_stat_watcher.cc',
+      'src/node_stdio_writer.cc',
       'src/node_symbols.cc',
       'src/node_task_queue.cc',
       'src/node_task_runner.cc',
@@ -166,24 +171,30 @@
       'src/pipe_wrap.cc',
       'src/process_wrap.cc',
       'src/signal_wrap.cc',
+      'src/slab_allocator.cc',
       'src/spawn_sync.cc',
+      'src/spawn_zygote.cc',
       'src/stream_base.cc',
+      'src/stream_bridge.cc',
       'src/stream_pipe.cc',
       'src/stream_wrap.cc',
       'src/string_bytes.cc',
       'src/string_decoder.cc',
       'src/tcp_wrap.cc',
       'src/timers.cc',
+      'src/timer_wheel.cc',
       'src/timer_wrap.cc',
       'src/tracing/agent.cc',
       'src/tracing/node_trace_buffer.cc',
       'src/tracing/node_trace_writer.cc',
+      'src/tracing/perfetto_trace_writer.cc',
       'src/tracing/trace_event.cc',
       'src/tracing/traced_value.cc',
       'src/tty_wrap.cc',
       'src/udp_wrap.cc',
       'src/util.cc',
       'src/uv.cc',
+      'src/wasi_arena_allocator.cc',
       # headers to make for a more pleasant IDE experience
       'src/aliased_buffer.h',
       'src/aliased_buffer-inl.h',
@@ -217,6 +228,7 @@
       'src/handle_wrap.h',
       'src/histogram.h',
       'src/histogram-inl.h',
+      'src/io_uring_stream.h',
       'src/js_stream.h',
       'src/json_utils.h',
       'src/large_pages/node_large_page.cc',
@@ -236,6 +248,7 @@
       'src/node_context_data.h',
       'src/node_contextify.h',
       'src/node_debug.h',
+      'src/node_diagnostics_channel.h',
       'src/node_dir.h',
       'src/node_dotenv.h',
       'src/node_errors.h',
@@ -293,21 +306,29 @@
       'src/permission/wasi_permission.h',
       'src/permission/worker_permission.h',
       'src/pipe_wrap.h',
+      'src/protobuf_writer.h',
       'src/req_wrap.h',
       'src/req_wrap-inl.h',
+      'src/slab_allocator.h',
       'src/spawn_sync.h',
+      'src/spawn_zygote.h',
       'src/stream_base.h',
       'src/stream_base-inl.h',
+      'src/stream_bridge.h',
       'src/stream_pipe.h',
       'src/stream_wrap.h',
       'src/string_bytes.h',
+      'src/string_bytes_simd.h',
+      'src/string_search.h',
       'src/string_decoder.h',
       'src/string_decoder-inl.h',
       'src/tcp_wrap.h',
       'src/timers.h',
+      'src/timer_wheel.h',
       'src/tracing/agent.h',
       'src/tracing/node_trace_buffer.h',
       'src/tracing/node_trace_writer.h',
+      'src/tracing/perfetto_trace_writer.h',
       'src/tracing/trace_event.h',
       'src/tracing/trace_event_common.h',
       'src/tracing/traced_value.h',
@@ -317,6 +338,7 @@
       'src/udp_wrap.h',
       'src/util.h',
       'src/util-inl.h',
+      'src/wasi_arena_allocator.h',
     ],
     'node_crypto_sources': [
       'src/crypto/crypto_aes.cc',
@@ -340,7 +362,11 @@
       'src/crypto/crypto_hash.cc',
       'src/crypto/crypto_keys.cc',
       'src/crypto/crypto_keygen.cc',
+      'src/crypto/crypto_ocsp_cache.cc',
+      'src/crypto/crypto_parse_cache.cc',
       'src/crypto/crypto_scrypt.cc',
+      'src/crypto/crypto_session_cache.cc',
+      'src/crypto/crypto_threadpool.cc',
       'src/crypto/crypto_tls.cc',
       'src/crypto/crypto_x509.cc',
       'src/crypto/crypto_bio.h',
@@ -356,7 +382,11 @@
       'src/crypto/crypto_hash.h',
       'src/crypto/crypto_keys.h',
       'src/crypto/crypto_keygen.h',
+      'src/crypto/crypto_ocsp_cache.h',
+      'src/crypto/crypto_parse_cache.h',
       'src/crypto/crypto_scrypt.h',
+      'src/crypto/crypto_session_cache.h',
+      'src/crypto/crypto_threadpool.h',
       'src/crypto/crypto_tls.h',
       'src/crypto/crypto_clienthello.h',
       'src/crypto/crypto_context.h',
@@ -380,6 +410,7 @@
       'src/quic/logstream.cc',
       'src/quic/packet.cc',
       'src/quic/preferredaddress.cc',
+      'src/quic/routing.cc',
       'src/quic/session.cc',
       'src/quic/sessionticket.cc',
       'src/quic/streams.cc',
@@ -395,6 +426,7 @@
       'src/quic/logstream.h',
       'src/quic/packet.h',
       'src/quic/preferredaddress.h',
+      'src/quic/routing.h',
       'src/quic/session.h',
       'src/quic/sessionticket.h',
       'src/quic/streams.h',
@@ -403,12 +435,23 @@
       'src/quic/transportparams.h',
       'src/quic/quic.cc',
     ],
+    'node_bench_sources': [
+      'src/node_snapshot_stub.cc',
+      'test/cctest/bench/bench_cleanup_queue.cc',
+      'test/cctest/bench/bench_fs_permission.cc',
+      'test/cctest/bench/bench_http_parser.cc',
+      'test/cctest/bench/bench_search_string.cc',
+      'test/cctest/bench/bench_string_bytes.cc',
+      'test/cctest/bench/node_bench.cc',
+      'test/cctest/bench/node_bench.h',
+    ],
     'node_cctest_openssl_sources': [
       'test/cctest/test_crypto_clienthello.cc',
       'test/cctest/test_node_crypto.cc',
       'test/cctest/test_node_crypto_env.cc',
       'test/cctest/test_quic_cid.cc',
       'test/cctest/test_quic_error.cc',
+      'test/cctest/test_quic_routing.cc',
       'test/cctest/test_quic_tokens.cc',
     ],
     'node_cctest_inspector_sources': [
@@ -1255,6 +1298,65 @@
       ],
     }, # cctest
 
+    {
+      'target_name': 'node_bench',
+      'type': 'executable',
+
+      'dependencies': [
+        '<(node_lib_target_name)',
+        'deps/histogram/histogram.gyp:histogram',
+        'deps/llhttp/llhttp.gyp:llhttp',
+        'deps/nbytes/nbytes.gyp:nbytes',
+      ],
+
+      'includes': [
+        'node.gypi'
+      ],
+
+      'include_dirs': [
+        'src',
+        'tools/msvs/genfiles',
+        'deps/v8/include',
+        'deps/cares/include',
+        'deps/uv/include',
+        'test/cctest/bench',
+      ],
+
+      'defines': [
+        'NODE_ARCH="<(target_arch)"',
+        'NODE_PLATFORM="<(OS)"',
+        'NODE_WANT_INTERNALS=1',
+      ],
+
+      'sources': [ '<@(node_bench_sources)' ],
+
+      'conditions': [
+        ['OS=="solaris"', {
+          'ldflags': [ '-I<(SHARED_INTERMEDIATE_DIR)' ]
+        }],
+        # Skip node_bench while building shared lib node for Windows
+        [ 'OS=="win" and node_shared=="true"', {
+          'type': 'none',
+        }],
+        [ 'node_shared=="true"', {
+          'xcode_settings': {
+            'OTHER_LDFLAGS': [ '-Wl,-rpath,@loader_path', ],
+          },
+        }],
+        ['OS=="win"', {
+          'libraries': [
+            'Dbghelp.lib',
+            'winmm.lib',
+            'Ws2_32.lib',
+          ],
+        }],
+        # Avoid excessive LTO
+        ['enable_lto=="true"', {
+          'ldflags': [ '-fno-lto' ],
+        }],
+      ],
+    }, # node_bench
+
     {
       'target_name': 'embedtest',
       'type': 'executable',
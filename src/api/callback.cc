@@ -88,6 +88,11 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
 
   pushed_ids_ = true;
 
+  if (env->async_hooks()->cpu_time_accounting()) [[unlikely]] {
+    prior_cpu_time_async_id_ =
+        env->async_hooks()->StartCPUTimeAccounting(async_context_.async_id);
+  }
+
   if (asyncContext.async_id != 0 && !skip_hooks_) {
     // No need to check a return value because the application will exit if
     // an exception occurs.
@@ -125,6 +130,9 @@ void InternalCallbackScope::Close() {
   }
 
   if (pushed_ids_) {
+    if (prior_cpu_time_async_id_ >= 0) {
+      env_->async_hooks()->StopCPUTimeAccounting(prior_cpu_time_async_id_);
+    }
     env_->async_hooks()->pop_async_context(async_context_.async_id);
 
     async_context_frame::exchange(isolate, prior_context_frame_.Get(isolate));
@@ -142,6 +150,7 @@ void InternalCallbackScope::Close() {
 
   auto weakref_cleanup = OnScopeLeave([&]() { env_->RunWeakRefCleanup(); });
 
+  EventLoopPhaseTimer phase_timer(env_, EventLoopPhase::kMicrotasks);
   Local<Context> context = env_->context();
   if (!tick_info->has_tick_scheduled()) {
     context->GetMicrotaskQueue()->PerformCheckpoint(isolate);
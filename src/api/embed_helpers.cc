@@ -40,6 +40,7 @@ Maybe<ExitCode> SpinEventLoopInternal(Environment* env) {
   if (env->is_stopping()) return Nothing<ExitCode>();
 
   env->set_trace_sync_io(env->options()->trace_sync_io);
+  env->StartStallWatchdog();
   {
     bool more;
     env->performance_state()->Mark(
@@ -71,6 +72,7 @@ Maybe<ExitCode> SpinEventLoopInternal(Environment* env) {
     env->performance_state()->Mark(
         node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_EXIT);
   }
+  env->StopStallWatchdog();
   if (env->is_stopping()) return Nothing<ExitCode>();
 
   env->set_trace_sync_io(false);
@@ -93,6 +95,7 @@ struct CommonEnvironmentSetup::Impl {
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data;
   DeleteFnPtr<Environment, FreeEnvironment> env;
   Global<Context> main_context;
+  std::function<Environment*(const CommonEnvironmentSetup*)> make_env;
 };
 
 CommonEnvironmentSetup::CommonEnvironmentSetup(
@@ -126,9 +129,8 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
 #ifndef __wasi__
   params.array_buffer_allocator = impl_->allocator.get();
   params.external_references = external_references.data();
-  params.cpp_heap =
-      v8::CppHeap::Create(platform, v8::CppHeapCreateParams{{}}).release();
 #endif
+  params.cpp_heap = NewCppHeap(platform).release();
 
   Isolate* isolate;
 
@@ -146,6 +148,12 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
 #endif
     platform->RegisterIsolate(isolate, loop);
 
+    // When extending a base snapshot, the snapshot creator deserializes the
+    // isolate from it.
+    if (snapshot_data != nullptr) {
+      SnapshotBuilder::InitializeIsolateParams(
+          SnapshotData::FromEmbedderWrapper(snapshot_data), &params);
+    }
     impl_->snapshot_creator.emplace(isolate, params);
     
 #ifndef __wasi__
@@ -181,24 +189,57 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
         isolate, loop, platform, impl_->allocator.get(), snapshot_data));
     impl_->isolate_data->set_snapshot_config(snapshot_config);
 
-    if (snapshot_data) {
-      impl_->env.reset(make_env(this));
-      if (impl_->env) {
-        impl_->main_context.Reset(isolate, impl_->env->context());
-      }
-      return;
-    }
+    impl_->make_env = std::move(make_env);
+    InitializeEnvironment(errors);
+    // The factories passed by the Create*() methods capture their arguments
+    // by reference, so they can only be kept if the caller owns them.
+    if (!(flags & Flags::kIsPooled)) impl_->make_env = nullptr;
+  }
+}
 
-    Local<Context> context = NewContext(isolate);
-    impl_->main_context.Reset(isolate, context);
-    if (context.IsEmpty()) {
-      errors->push_back("Failed to initialize V8 Context");
-      return;
+void CommonEnvironmentSetup::InitializeEnvironment(
+    std::vector<std::string>* errors) {
+  Isolate* isolate = impl_->isolate;
+  if (impl_->isolate_data->snapshot_data() != nullptr) {
+    impl_->env.reset(impl_->make_env(this));
+    if (impl_->env) {
+      impl_->main_context.Reset(isolate, impl_->env->context());
     }
+    return;
+  }
+
+  Local<Context> context = NewContext(isolate);
+  impl_->main_context.Reset(isolate, context);
+  if (context.IsEmpty()) {
+    errors->push_back("Failed to initialize V8 Context");
+    return;
+  }
+
+  Context::Scope context_scope(context);
+  impl_->env.reset(impl_->make_env(this));
+}
 
-    Context::Scope context_scope(context);
-    impl_->env.reset(make_env(this));
+bool CommonEnvironmentSetup::ResetEnvironment(
+    std::vector<std::string>* errors) {
+  CHECK(impl_->make_env);
+  Isolate* isolate = impl_->isolate;
+  Locker locker(isolate);
+  Isolate::Scope isolate_scope(isolate);
+
+  // FreeEnvironment() runs the cleanup hooks and closes the handles of the
+  // Environment, which leaves the event loop ready to be reused.
+  impl_->main_context.Reset();
+  impl_->env.reset();
+
+  HandleScope handle_scope(isolate);
+  TryCatch try_catch(isolate);
+  size_t error_count = errors->size();
+  InitializeEnvironment(errors);
+  if (try_catch.HasCaught()) {
+    errors->push_back(FormatCaughtException(
+        isolate, isolate->GetCurrentContext(), try_catch));
   }
+  return impl_->env && errors->size() == error_count;
 }
 
 CommonEnvironmentSetup::CommonEnvironmentSetup(
@@ -214,6 +255,18 @@ CommonEnvironmentSetup::CreateForSnapshotting(
     const std::vector<std::string>& args,
     const std::vector<std::string>& exec_args,
     const SnapshotConfig& snapshot_config) {
+  return CreateForSnapshottingFrom(
+      platform, errors, nullptr, args, exec_args, snapshot_config);
+}
+
+std::unique_ptr<CommonEnvironmentSetup>
+CommonEnvironmentSetup::CreateForSnapshottingFrom(
+    MultiIsolatePlatform* platform,
+    std::vector<std::string>* errors,
+    const EmbedderSnapshotData* base,
+    const std::vector<std::string>& args,
+    const std::vector<std::string>& exec_args,
+    const SnapshotConfig& snapshot_config) {
   // It's not guaranteed that a context that goes through
   // v8_inspector::V8Inspector::contextCreated() is runtime-independent,
   // so do not start the inspector on the main context when building
@@ -224,7 +277,7 @@ CommonEnvironmentSetup::CreateForSnapshotting(
   auto ret = std::unique_ptr<CommonEnvironmentSetup>(new CommonEnvironmentSetup(
       platform,
       errors,
-      nullptr,
+      base,
       true,
       [&](const CommonEnvironmentSetup* setup) -> Environment* {
         return CreateEnvironment(
@@ -275,6 +328,121 @@ CommonEnvironmentSetup::~CommonEnvironmentSetup() {
   delete impl_;
 }
 
+struct EnvironmentPool::Impl {
+  MultiIsolatePlatform* platform;
+  const EmbedderSnapshotData* snapshot_data;
+  size_t max_size;
+  std::vector<std::string> args;
+  std::vector<std::string> exec_args;
+  EnvironmentFlags::Flags flags;
+  mutable Mutex mutex;
+  std::vector<std::unique_ptr<CommonEnvironmentSetup>> setups;
+};
+
+EnvironmentPool::EnvironmentPool(Impl* impl) : impl_(impl) {}
+
+EnvironmentPool::~EnvironmentPool() {
+  delete impl_;
+}
+
+std::unique_ptr<EnvironmentPool> EnvironmentPool::Create(
+    MultiIsolatePlatform* platform,
+    std::vector<std::string>* errors,
+    const EmbedderSnapshotData* snapshot_data,
+    size_t size,
+    const std::vector<std::string>& args,
+    const std::vector<std::string>& exec_args,
+    EnvironmentFlags::Flags flags) {
+  CHECK_NOT_NULL(platform);
+  CHECK_NOT_NULL(errors);
+  std::unique_ptr<EnvironmentPool> pool{new EnvironmentPool(
+      new Impl{platform, snapshot_data, size, args, exec_args, flags})};
+  for (size_t i = 0; i < size; i++) {
+    std::unique_ptr<CommonEnvironmentSetup> setup = pool->CreateSetup(errors);
+    if (!setup) return {};
+    pool->impl_->setups.push_back(std::move(setup));
+  }
+  return pool;
+}
+
+std::unique_ptr<CommonEnvironmentSetup> EnvironmentPool::CreateSetup(
+    std::vector<std::string>* errors) {
+  // The factory outlives this call, so it holds on to the pool state instead
+  // of capturing anything by reference.
+  Impl* impl = impl_;
+  auto setup = std::unique_ptr<CommonEnvironmentSetup>(
+      new CommonEnvironmentSetup(
+          impl->platform,
+          errors,
+          impl->snapshot_data,
+          CommonEnvironmentSetup::Flags::kIsPooled,
+          [impl](const CommonEnvironmentSetup* setup) -> Environment* {
+            return CreateEnvironment(setup->isolate_data(),
+                                     setup->context(),
+                                     impl->args,
+                                     impl->exec_args,
+                                     impl->flags);
+          }));
+  if (!errors->empty()) setup.reset();
+  return setup;
+}
+
+std::unique_ptr<CommonEnvironmentSetup> EnvironmentPool::Acquire(
+    std::vector<std::string>* errors) {
+  {
+    Mutex::ScopedLock lock(impl_->mutex);
+    if (!impl_->setups.empty()) {
+      std::unique_ptr<CommonEnvironmentSetup> setup =
+          std::move(impl_->setups.back());
+      impl_->setups.pop_back();
+      return setup;
+    }
+  }
+  return CreateSetup(errors);
+}
+
+void EnvironmentPool::Release(std::unique_ptr<CommonEnvironmentSetup> setup) {
+  CHECK(setup);
+  {
+    Mutex::ScopedLock lock(impl_->mutex);
+    if (impl_->setups.size() >= impl_->max_size) return;
+  }
+  // Recreate the Environment outside of the lock, since this can take a few
+  // milliseconds. Setups that fail to reset are simply dropped.
+  std::vector<std::string> errors;
+  if (!setup->ResetEnvironment(&errors)) return;
+  Mutex::ScopedLock lock(impl_->mutex);
+  if (impl_->setups.size() < impl_->max_size) {
+    impl_->setups.push_back(std::move(setup));
+  }
+}
+
+Maybe<int> EnvironmentPool::RunScript(
+    std::string_view main_script_source_utf8) {
+  std::vector<std::string> errors;
+  std::unique_ptr<CommonEnvironmentSetup> setup = Acquire(&errors);
+  if (!setup) return Nothing<int>();
+
+  Maybe<int> result = Nothing<int>();
+  {
+    Isolate* isolate = setup->isolate();
+    Locker locker(isolate);
+    Isolate::Scope isolate_scope(isolate);
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(setup->context());
+    if (!LoadEnvironment(setup->env(), main_script_source_utf8).IsEmpty()) {
+      result = SpinEventLoop(setup->env());
+    }
+  }
+  Release(std::move(setup));
+  return result;
+}
+
+size_t EnvironmentPool::size() const {
+  Mutex::ScopedLock lock(impl_->mutex);
+  return impl_->setups.size();
+}
+
 EmbedderSnapshotData::Pointer CommonEnvironmentSetup::CreateSnapshot() {
   CHECK_NOT_NULL(snapshot_creator());
   SnapshotData* snapshot_data = new SnapshotData();
@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <cstring>
 #include "env_properties.h"
 #include "node.h"
 #include "node_builtins.h"
@@ -7,6 +8,7 @@
 #include "node_exit_code.h"
 #include "node_internals.h"
 #include "node_options-inl.h"
+#include "node_perf.h"
 #include "node_platform.h"
 #include "node_realm-inl.h"
 #include "node_shadow_realm.h"
@@ -106,12 +108,25 @@ MaybeLocal<Value> PrepareStackTraceCallback(Local<Context> context,
   return result;
 }
 
+NodeArrayBufferAllocator::NodeArrayBufferAllocator() {
+  if (per_process::cli_options->experimental_arraybuffer_slab_allocator)
+    slabs_ = std::make_unique<SlabAllocator>(allocator_);
+}
+
 void* NodeArrayBufferAllocator::Allocate(size_t size) {
-  void* ret;
-  if (zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers)
-    ret = allocator_->Allocate(size);
-  else
-    ret = allocator_->AllocateUninitialized(size);
+  const bool zero_fill =
+      zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers;
+  void* ret = nullptr;
+  if (slabs_ && size <= SlabAllocator::kMaxSize) {
+    ret = slabs_->Allocate(size);
+    if (ret != nullptr && zero_fill) memset(ret, 0, size);
+  }
+  if (ret == nullptr) {
+    if (zero_fill)
+      ret = allocator_->Allocate(size);
+    else
+      ret = allocator_->AllocateUninitialized(size);
+  }
   if (ret != nullptr) [[likely]] {
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   }
@@ -119,7 +134,9 @@ void* NodeArrayBufferAllocator::Allocate(size_t size) {
 }
 
 void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
-  void* ret = allocator_->AllocateUninitialized(size);
+  void* ret = nullptr;
+  if (slabs_ && size <= SlabAllocator::kMaxSize) ret = slabs_->Allocate(size);
+  if (ret == nullptr) ret = allocator_->AllocateUninitialized(size);
   if (ret != nullptr) [[likely]] {
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   }
@@ -128,6 +145,7 @@ void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
 
 void NodeArrayBufferAllocator::Free(void* data, size_t size) {
   total_mem_usage_.fetch_sub(size, std::memory_order_relaxed);
+  if (slabs_ && slabs_->Free(data, size)) return;
   allocator_->Free(data, size);
 }
 
@@ -301,6 +319,19 @@ void SetIsolateUpForNode(v8::Isolate* isolate) {
   SetIsolateUpForNode(isolate, settings);
 }
 
+std::unique_ptr<CppHeap> NewCppHeap(v8::Platform* platform) {
+  CppHeapCreateParams params{{}};
+#if defined(__wasi__) && !defined(_REENTRANT)
+  // Without wasi-threads there are no platform worker threads to run the
+  // concurrent marking and sweeping jobs on. The incremental steps are posted
+  // to the foreground task runner of the isolate instead, which is drained by
+  // its event loop.
+  params.marking_support = cppgc::Heap::MarkingType::kIncremental;
+  params.sweeping_support = cppgc::Heap::SweepingType::kIncremental;
+#endif
+  return CppHeap::Create(platform, params);
+}
+
 // TODO(joyeecheung): we may want to expose this, but then we need to be
 // careful about what we override in the params.
 Isolate* NewIsolate(Isolate::CreateParams* params,
@@ -331,8 +362,7 @@ Isolate* NewIsolate(Isolate::CreateParams* params,
 
   // Ensure that there is always a CppHeap.
   if (settings.cpp_heap == nullptr) {
-    params->cpp_heap =
-        CppHeap::Create(platform, CppHeapCreateParams{{}}).release();
+    params->cpp_heap = NewCppHeap(platform).release();
   } else {
     params->cpp_heap = settings.cpp_heap;
   }
@@ -437,6 +467,7 @@ Environment* CreateEnvironment(
                                      thread_id);
   CHECK_NOT_NULL(env);
 
+  uint64_t deserialization_start = PERFORMANCE_NOW();
   if (use_snapshot) {
     context = Context::FromSnapshot(isolate,
                                     SnapshotData::kNodeMainContextIndex,
@@ -461,6 +492,11 @@ Environment* CreateEnvironment(
 
   Context::Scope context_scope(context);
   env->InitializeMainContext(context, env_snapshot_info);
+  if (use_snapshot) {
+    env->performance_state()->RecordBootstrapPhase(
+        performance::NODE_BOOTSTRAP_PHASE_SNAPSHOT_DESERIALIZATION,
+        deserialization_start);
+  }
 
 #if HAVE_INSPECTOR
   if (env->should_create_inspector()) {
@@ -81,6 +81,9 @@ void AsyncWrap::DestroyAsyncIdsCallback(Environment* env) {
       Local<Value> async_id_value = Number::New(env->isolate(), async_id);
       MaybeLocal<Value> ret = fn->Call(
           env->context(), Undefined(env->isolate()), 1, &async_id_value);
+      // The CPU time of the resource can be read until its destroy hooks
+      // have run.
+      env->async_hooks()->ClearCPUTime(async_id);
 
       if (ret.IsEmpty())
         return;
@@ -249,7 +252,7 @@ static void RegisterDestroyHook(const FunctionCallbackInfo<Value>& args) {
     p->propBag.Reset(isolate, args[2].As<Object>());
   }
   p->target.SetWeak(p, AsyncWrap::WeakCallback, WeakCallbackType::kParameter);
-  p->env->AddCleanupHook(DestroyParamCleanupHook, p);
+  p->env->AddCleanupHook(DestroyParamCleanupHook, p, /* memory_only */ true);
 }
 
 void AsyncWrap::GetAsyncId(const FunctionCallbackInfo<Value>& args) {
@@ -332,6 +335,22 @@ void AsyncWrap::QueueDestroyAsyncId(const FunctionCallbackInfo<Value>& args) {
       args[0].As<Number>()->Value());
 }
 
+static void SetCPUTimeAccounting(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsBoolean());
+  env->async_hooks()->set_cpu_time_accounting(args[0]->IsTrue());
+}
+
+static void GetCPUTime(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsNumber());
+  int64_t time =
+      env->async_hooks()->GetCPUTime(args[0].As<Number>()->Value());
+  if (time < 0) return;
+  // In microseconds, like process.cpuUsage().
+  args.GetReturnValue().Set(static_cast<double>(time) / 1000);
+}
+
 void AsyncWrap::SetCallbackTrampoline(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -373,6 +392,8 @@ void AsyncWrap::CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(isolate, target, "setPromiseHooks", SetPromiseHooks);
   SetMethod(isolate, target, "getPromiseHooks", GetPromiseHooks);
   SetMethod(isolate, target, "registerDestroyHook", RegisterDestroyHook);
+  SetMethod(isolate, target, "setCPUTimeAccounting", SetCPUTimeAccounting);
+  SetMethod(isolate, target, "getCPUTime", GetCPUTime);
   AsyncWrap::GetConstructorTemplate(isolate_data);
 }
 
@@ -479,6 +500,8 @@ void AsyncWrap::RegisterExternalReferences(
   registry->Register(SetPromiseHooks);
   registry->Register(GetPromiseHooks);
   registry->Register(RegisterDestroyHook);
+  registry->Register(SetCPUTimeAccounting);
+  registry->Register(GetCPUTime);
   registry->Register(AsyncWrap::GetAsyncId);
   registry->Register(AsyncWrap::AsyncReset);
   registry->Register(AsyncWrap::GetProviderType);
@@ -550,6 +573,7 @@ void AsyncWrap::EmitTraceEventDestroy() {
 void AsyncWrap::EmitDestroy(Environment* env, double async_id) {
   if (env->async_hooks()->fields()[AsyncHooks::kDestroy] == 0 ||
       !env->can_call_into_js()) {
+    env->async_hooks()->ClearCPUTime(async_id);
     return;
   }
 
@@ -666,6 +690,8 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
 
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
+  if (EventLoopPhaseState* phases = env()->event_loop_phases())
+    phases->callbacks[provider]++;
   MaybeLocal<Value> ret =
       InternalMakeCallback(env(),
                            object(),
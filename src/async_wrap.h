@@ -69,6 +69,7 @@ namespace node {
   V(SHUTDOWNWRAP)                                                              \
   V(SIGNALWRAP)                                                                \
   V(STATWATCHER)                                                               \
+  V(STREAMBRIDGE)                                                              \
   V(STREAMPIPE)                                                                \
   V(TCPCONNECTWRAP)                                                            \
   V(TCPSERVERWRAP)                                                             \
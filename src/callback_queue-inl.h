@@ -56,6 +56,86 @@ size_t CallbackQueue<R, Args...>::size() const {
   return size_.load();
 }
 
+template <typename R, typename... Args>
+ThreadsafeCallbackQueue<R, Args...>::~ThreadsafeCallbackQueue() {
+  Callback* node = head_.exchange(nullptr, std::memory_order_acquire);
+  while (node != nullptr) {
+    Callback* next = node->pending_next_;
+    delete node;
+    node = next;
+  }
+}
+
+template <typename R, typename... Args>
+template <typename Fn>
+std::unique_ptr<typename ThreadsafeCallbackQueue<R, Args...>::Callback>
+ThreadsafeCallbackQueue<R, Args...>::CreateCallback(
+    Fn&& fn, CallbackFlags::Flags flags) {
+  return std::make_unique<typename Queue::template CallbackImpl<Fn>>(
+      std::move(fn), flags);
+}
+
+template <typename R, typename... Args>
+bool ThreadsafeCallbackQueue<R, Args...>::Push(std::unique_ptr<Callback> cb) {
+  // The size is raised first, so that a consumer that sees the callback also
+  // sees it counted.
+  const size_t depth = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+  size_t peak = peak_size_.load(std::memory_order_relaxed);
+  while (depth > peak &&
+         !peak_size_.compare_exchange_weak(
+             peak, depth, std::memory_order_relaxed)) {
+  }
+
+  Callback* node = cb.release();
+  Callback* head = head_.load(std::memory_order_relaxed);
+  do {
+    node->pending_next_ = head;
+  } while (!head_.compare_exchange_weak(
+      head, node, std::memory_order_release, std::memory_order_relaxed));
+
+  if (head != nullptr) return false;
+  wakeups_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename R, typename... Args>
+void ThreadsafeCallbackQueue<R, Args...>::TakeAll(Queue* out) {
+  Callback* node = head_.exchange(nullptr, std::memory_order_acquire);
+  // The callbacks are linked from the newest to the oldest one, so reverse
+  // the list before it is appended.
+  Callback* oldest = nullptr;
+  size_t count = 0;
+  while (node != nullptr) {
+    Callback* next = node->pending_next_;
+    node->pending_next_ = oldest;
+    oldest = node;
+    node = next;
+    count++;
+  }
+  while (oldest != nullptr) {
+    Callback* next = oldest->pending_next_;
+    oldest->pending_next_ = nullptr;
+    out->Push(std::unique_ptr<Callback>(oldest));
+    oldest = next;
+  }
+  size_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+template <typename R, typename... Args>
+size_t ThreadsafeCallbackQueue<R, Args...>::size() const {
+  return size_.load();
+}
+
+template <typename R, typename... Args>
+size_t ThreadsafeCallbackQueue<R, Args...>::peak_size() const {
+  return peak_size_.load(std::memory_order_relaxed);
+}
+
+template <typename R, typename... Args>
+size_t ThreadsafeCallbackQueue<R, Args...>::wakeups() const {
+  return wakeups_.load(std::memory_order_relaxed);
+}
+
 template <typename R, typename... Args>
 CallbackQueue<R, Args...>::Callback::Callback(CallbackFlags::Flags flags)
   : flags_(flags) {}
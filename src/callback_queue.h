@@ -39,8 +39,12 @@ class CallbackQueue {
 
     CallbackFlags::Flags flags_;
     std::unique_ptr<Callback> next_;
+    // The link while the callback is in a ThreadsafeCallbackQueue.
+    Callback* pending_next_ = nullptr;
 
     friend class CallbackQueue;
+    template <typename, typename...>
+    friend class ThreadsafeCallbackQueue;
   };
 
   template <typename Fn>
@@ -70,6 +74,51 @@ class CallbackQueue {
   std::atomic<size_t> size_ {0};
   std::unique_ptr<Callback> head_;
   Callback* tail_ = nullptr;
+
+  template <typename, typename...>
+  friend class ThreadsafeCallbackQueue;
+};
+
+// A variant of CallbackQueue that any number of threads can push to without
+// taking a lock, while a single thread takes the callbacks out of it.
+// Push() reports whether the queue was empty, so that producers only need to
+// wake up the consumer for the first callback after it has drained the queue.
+template <typename R, typename... Args>
+class ThreadsafeCallbackQueue {
+ public:
+  using Queue = CallbackQueue<R, Args...>;
+  using Callback = typename Queue::Callback;
+
+  ThreadsafeCallbackQueue() = default;
+  inline ~ThreadsafeCallbackQueue();
+  ThreadsafeCallbackQueue(const ThreadsafeCallbackQueue&) = delete;
+  ThreadsafeCallbackQueue& operator=(const ThreadsafeCallbackQueue&) = delete;
+
+  template <typename Fn>
+  inline std::unique_ptr<Callback> CreateCallback(
+      Fn&& fn, CallbackFlags::Flags);
+
+  // May be called from any thread. Returns true if the queue was empty.
+  inline bool Push(std::unique_ptr<Callback> cb);
+  // Moves all of the callbacks to the end of |out|, in the order in which they
+  // were pushed. Only called by the consumer.
+  inline void TakeAll(Queue* out);
+
+  // These are atomic and may be called from any thread.
+  inline size_t size() const;
+  // The largest number of callbacks that were in the queue at once.
+  inline size_t peak_size() const;
+  // The number of times that a callback was pushed to the empty queue, i.e.
+  // how often the consumer had to be woken up.
+  inline size_t wakeups() const;
+
+ private:
+  // The most recently pushed callback, linked to the ones before it through
+  // Callback::pending_next_.
+  std::atomic<Callback*> head_ {nullptr};
+  std::atomic<size_t> size_ {0};
+  std::atomic<size_t> peak_size_ {0};
+  std::atomic<size_t> wakeups_ {0};
 };
 
 }  // namespace node
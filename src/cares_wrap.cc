@@ -79,6 +79,7 @@ using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
 using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
@@ -823,6 +824,171 @@ GetAddrInfoReqWrap::GetAddrInfoReqWrap(Environment* env,
     : ReqWrap(env, req_wrap_obj, AsyncWrap::PROVIDER_GETADDRINFOREQWRAP),
       order_(order) {}
 
+GetAddrInfoReqWrap::~GetAddrInfoReqWrap() {
+  if (!cache_key_.empty()) AddrInfoCache::Get().Forget(cache_key_, this);
+}
+
+void GetAddrInfoReqWrap::Complete(int status,
+                                  const std::vector<std::string>& addresses) {
+  Isolate* isolate = env()->isolate();
+  Local<Value> argv[] = {Integer::New(isolate, status), Null(isolate)};
+  if (status == 0) {
+    LocalVector<Value> results(isolate);
+    results.reserve(addresses.size());
+    for (const std::string& address : addresses)
+      results.push_back(OneByteString(isolate, address));
+    argv[1] = Array::New(isolate, results.data(), results.size());
+  }
+  MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+}
+
+// Deliberately leaked, like the crypto parse caches, so that it can still be
+// used by worker threads that finish while the process exits.
+AddrInfoCache& AddrInfoCache::Get() {
+  static auto* cache = new AddrInfoCache();
+  return *cache;
+}
+
+void AddrInfoCache::Configure(const Options& options) {
+  Mutex::ScopedLock lock(mutex_);
+  options_ = options;
+  enabled_ = options.max_entries > 0;
+  Evict();
+}
+
+AddrInfoCache::Result AddrInfoCache::Find(
+    const std::string& key,
+    std::unique_ptr<GetAddrInfoReqWrap>* req,
+    int* status,
+    std::vector<std::string>* addresses) {
+  Mutex::ScopedLock lock(mutex_);
+  const uint64_t now = uv_hrtime();
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    misses_++;
+    entries_.push_front(Entry{key});
+    entries_.front().pending = req->get();
+    entries_.front().pending_env = (*req)->env();
+    index_.emplace(key, entries_.begin());
+    Evict();
+    return Result::kMiss;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+  Entry& entry = entries_.front();
+  if (entry.has_value && now < entry.stale_until) {
+    *status = entry.status;
+    *addresses = entry.addresses;
+    if (now < entry.expires_at) {
+      hits_++;
+      return Result::kHit;
+    }
+    stale_hits_++;
+    if (entry.pending != nullptr) return Result::kHit;
+    entry.pending = req->get();
+    entry.pending_env = (*req)->env();
+    return Result::kStale;
+  }
+
+  // The GetAddrInfoReqWrap objects of other threads can not be touched here,
+  // so requests are only coalesced with those of the same Environment.
+  if (entry.pending != nullptr && entry.pending_env == (*req)->env()) {
+    coalesced_++;
+    entry.pending->waiters_.emplace_back(req->release());
+    return Result::kCoalesced;
+  }
+  misses_++;
+  if (entry.pending == nullptr) {
+    entry.pending = req->get();
+    entry.pending_env = (*req)->env();
+  }
+  return Result::kMiss;
+}
+
+void AddrInfoCache::Store(const std::string& key,
+                          GetAddrInfoReqWrap* req,
+                          int status,
+                          const std::vector<std::string>& addresses) {
+  // Only the failures that say that the name does not resolve are cached.
+  // Anything else, such as a timeout or a cancelled lookup, may succeed the
+  // next time.
+  const bool negative = status == UV_EAI_NONAME || status == UV_EAI_NODATA;
+  Mutex::ScopedLock lock(mutex_);
+  if (!enabled_) return;
+  auto it = index_.find(key);
+  if (it != index_.end() && it->second->pending == req) {
+    it->second->pending = nullptr;
+    it->second->pending_env = nullptr;
+  }
+  const uint64_t ttl = status == 0 ? options_.ttl
+                       : negative  ? options_.negative_ttl
+                                   : 0;
+  if (ttl == 0) return;
+
+  if (it == index_.end()) {
+    entries_.push_front(Entry{key});
+    it = index_.emplace(key, entries_.begin()).first;
+  }
+  Entry& entry = *it->second;
+  const uint64_t now = uv_hrtime();
+  entry.has_value = true;
+  entry.status = status;
+  entry.addresses = addresses;
+  entry.expires_at = now + ttl * 1000000;
+  // Failed lookups are not served past their time.
+  entry.stale_until =
+      entry.expires_at + (status == 0 ? options_.stale_ttl * 1000000 : 0);
+  Evict();
+}
+
+void AddrInfoCache::Forget(const std::string& key, GetAddrInfoReqWrap* req) {
+  Mutex::ScopedLock lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end() && it->second->pending == req) {
+    it->second->pending = nullptr;
+    it->second->pending_env = nullptr;
+  }
+}
+
+void AddrInfoCache::Evict() {
+  while (entries_.size() > options_.max_entries) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+AddrInfoCache::Stats AddrInfoCache::GetStats() {
+  Mutex::ScopedLock lock(mutex_);
+  return Stats{hits_, misses_, stale_hits_, coalesced_, entries_.size()};
+}
+
+// setLookupCache(ttl, negativeTtl, staleTtl, maxEntries) configures the cache.
+// A maxEntries of 0 disables it and drops the cached results.
+void AddrInfoCache::SetLookupCache(const FunctionCallbackInfo<Value>& args) {
+  CHECK_EQ(args.Length(), 4);
+  for (int i = 0; i < 4; i++) CHECK(args[i]->IsNumber());
+  Options options;
+  options.ttl = static_cast<uint64_t>(args[0].As<Number>()->Value());
+  options.negative_ttl = static_cast<uint64_t>(args[1].As<Number>()->Value());
+  options.stale_ttl = static_cast<uint64_t>(args[2].As<Number>()->Value());
+  options.max_entries = static_cast<size_t>(args[3].As<Number>()->Value());
+  Get().Configure(options);
+}
+
+void AddrInfoCache::GetLookupCacheStats(
+    const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Stats stats = Get().GetStats();
+  Local<Value> values[] = {
+      Number::New(isolate, static_cast<double>(stats.hits)),
+      Number::New(isolate, static_cast<double>(stats.misses)),
+      Number::New(isolate, static_cast<double>(stats.stale_hits)),
+      Number::New(isolate, static_cast<double>(stats.coalesced)),
+      Number::New(isolate, static_cast<double>(stats.entries)),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
 GetNameInfoReqWrap::GetNameInfoReqWrap(
     Environment* env,
     Local<Object> req_wrap_obj)
@@ -1698,18 +1864,11 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
-  Local<Value> argv[] = {
-    Integer::New(env->isolate(), status),
-    Null(env->isolate())
-  };
-
-  uint32_t n = 0;
+  std::vector<std::string> addresses;
   const uint8_t order = req_wrap->order();
 
   if (status == 0) {
-    Local<Array> results = Array::New(env->isolate());
-
-    auto add = [&](bool want_ipv4, bool want_ipv6) -> Maybe<void> {
+    auto add = [&](bool want_ipv4, bool want_ipv6) {
       for (auto p = res; p != nullptr; p = p->ai_next) {
         CHECK_EQ(p->ai_socktype, SOCK_STREAM);
 
@@ -1728,49 +1887,46 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
         if (uv_inet_ntop(p->ai_family, addr, ip, sizeof(ip)))
           continue;
 
-        Local<String> s = OneByteString(env->isolate(), ip);
-        if (results->Set(env->context(), n, s).IsNothing())
-          return Nothing<void>();
-        n++;
+        addresses.emplace_back(ip);
       }
-      return JustVoid();
     };
 
     switch (order) {
       case DNS_ORDER_IPV4_FIRST:
-        if (add(true, false).IsNothing() || add(false, true).IsNothing())
-          return;
-
+        add(true, false);
+        add(false, true);
         break;
       case DNS_ORDER_IPV6_FIRST:
-        if (add(false, true).IsNothing() || add(true, false).IsNothing())
-          return;
-
+        add(false, true);
+        add(true, false);
         break;
       default:
-        if (add(true, true).IsNothing()) return;
-
+        add(true, true);
         break;
     }
 
     // No responses were found to return
-    if (n == 0) {
-      argv[0] = Integer::New(env->isolate(), UV_EAI_NODATA);
-    }
+    if (addresses.empty()) status = UV_EAI_NODATA;
+  }
 
-    argv[1] = results;
+  if (!req_wrap->cache_key_.empty()) {
+    AddrInfoCache::Get().Store(
+        req_wrap->cache_key_, req_wrap.get(), status, addresses);
   }
 
   TRACE_EVENT_NESTABLE_ASYNC_END2(TRACING_CATEGORY_NODE2(dns, native),
                                   "lookup",
                                   req_wrap.get(),
                                   "count",
-                                  n,
+                                  static_cast<uint32_t>(addresses.size()),
                                   "order",
                                   order);
 
-  // Make the callback into JavaScript
-  req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  // Make the callbacks into JavaScript
+  if (!req_wrap->completed_) req_wrap->Complete(status, addresses);
+  for (const auto& waiter : req_wrap->waiters_)
+    waiter->Complete(status, addresses);
+  req_wrap->waiters_.clear();
 }
 
 
@@ -1842,6 +1998,23 @@ void ConvertIpv6StringToBuffer(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+int DispatchGetAddrInfo(GetAddrInfoReqWrap* req_wrap,
+                        const std::string& hostname,
+                        const struct addrinfo& hints) {
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(TRACING_CATEGORY_NODE2(dns, native),
+                                    "lookup",
+                                    req_wrap,
+                                    "hostname",
+                                    TRACE_STR_COPY(hostname.data()),
+                                    "family",
+                                    hints.ai_family == AF_INET    ? "ipv4"
+                                    : hints.ai_family == AF_INET6 ? "ipv6"
+                                                                  : "unspec");
+
+  return req_wrap->Dispatch(
+      uv_getaddrinfo, AfterGetAddrInfo, hostname.data(), nullptr, &hints);
+}
+
 void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -1885,18 +2058,43 @@ void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
   hints.ai_socktype = SOCK_STREAM;
   hints.ai_flags = flags;
 
-  TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(TRACING_CATEGORY_NODE2(dns, native),
-                                    "lookup",
-                                    req_wrap.get(),
-                                    "hostname",
-                                    TRACE_STR_COPY(ascii_hostname.data()),
-                                    "family",
-                                    family == AF_INET    ? "ipv4"
-                                    : family == AF_INET6 ? "ipv6"
-                                                         : "unspec");
+  AddrInfoCache& cache = AddrInfoCache::Get();
+  if (cache.enabled()) {
+    // The order only matters when both address families are returned.
+    req_wrap->cache_key_ =
+        std::to_string(family) + ":" + std::to_string(flags) + ":" +
+        std::to_string(family == AF_UNSPEC ? order->Value() : 0) + ":" +
+        ascii_hostname;
+    int status = 0;
+    std::vector<std::string> addresses;
+    const AddrInfoCache::Result result =
+        cache.Find(req_wrap->cache_key_, &req_wrap, &status, &addresses);
+    if (result == AddrInfoCache::Result::kCoalesced)
+      return args.GetReturnValue().Set(0);
+    if (result != AddrInfoCache::Result::kMiss) {
+      // The callback is still asynchronous, as it is for a lookup.
+      req_wrap->completed_ = true;
+      env->SetImmediate(
+          [strong_ref = BaseObjectPtr<GetAddrInfoReqWrap>(req_wrap.get()),
+           status,
+           addresses = std::move(addresses)](Environment* env) {
+            HandleScope handle_scope(env->isolate());
+            Context::Scope context_scope(env->context());
+            strong_ref->Complete(status, addresses);
+          });
+      // From here on the request is kept alive by the immediate and, while
+      // a stale result is refreshed, by the lookup.
+      GetAddrInfoReqWrap* wrap = req_wrap.release();
+      if (result == AddrInfoCache::Result::kStale &&
+          DispatchGetAddrInfo(wrap, ascii_hostname, hints) != 0) {
+        // Leaves the refresh to a later lookup.
+        cache.Forget(wrap->cache_key_, wrap);
+      }
+      return args.GetReturnValue().Set(0);
+    }
+  }
 
-  int err = req_wrap->Dispatch(
-      uv_getaddrinfo, AfterGetAddrInfo, ascii_hostname.data(), nullptr, &hints);
+  int err = DispatchGetAddrInfo(req_wrap.get(), ascii_hostname, hints);
   if (err == 0)
     // Release ownership of the pointer allowing the ownership to be transferred
     USE(req_wrap.release());
@@ -2182,6 +2380,11 @@ void Initialize(Local<Object> target,
 
   SetMethod(context, target, "getaddrinfo", GetAddrInfo);
   SetMethod(context, target, "getnameinfo", GetNameInfo);
+  SetMethod(context, target, "setLookupCache", AddrInfoCache::SetLookupCache);
+  SetMethodNoSideEffect(context,
+                        target,
+                        "getLookupCacheStats",
+                        AddrInfoCache::GetLookupCacheStats);
   SetMethodNoSideEffect(context, target, "canonicalizeIP", CanonicalizeIP);
   SetMethodNoSideEffect(
       context, target, "convertIpv6StringToBuffer", ConvertIpv6StringToBuffer);
@@ -2235,6 +2438,8 @@ void Initialize(Local<Object> target,
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GetAddrInfo);
   registry->Register(GetNameInfo);
+  registry->Register(AddrInfoCache::SetLookupCache);
+  registry->Register(AddrInfoCache::GetLookupCacheStats);
   registry->Register(CanonicalizeIP);
   registry->Register(ConvertIpv6StringToBuffer);
   registry->Register(StrError);
@@ -11,13 +11,20 @@
 #include "memory_tracker.h"
 #include "node.h"
 #include "node_internals.h"
+#include "node_mutex.h"
 #include "util.h"
 
 #include "ares.h"
 #include "v8.h"
 #include "uv.h"
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #ifdef __POSIX__
 # include <netdb.h>
@@ -199,6 +206,7 @@ class GetAddrInfoReqWrap final : public ReqWrap<uv_getaddrinfo_t> {
   GetAddrInfoReqWrap(Environment* env,
                      v8::Local<v8::Object> req_wrap_obj,
                      uint8_t order);
+  ~GetAddrInfoReqWrap() override;
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(GetAddrInfoReqWrap)
@@ -206,10 +214,112 @@ class GetAddrInfoReqWrap final : public ReqWrap<uv_getaddrinfo_t> {
 
   uint8_t order() const { return order_; }
 
+  // Calls oncomplete with |status| and, on success, the array of |addresses|.
+  void Complete(int status, const std::vector<std::string>& addresses);
+
+  // Set when the lookup goes through the AddrInfoCache. The result is then
+  // stored under |cache_key_| once the lookup completes.
+  std::string cache_key_;
+  // Set when oncomplete is called with a cached result. If the result was
+  // stale, the lookup made by this request then only refreshes the entry.
+  bool completed_ = false;
+  // The requests for the same key made by this thread while this one was in
+  // flight. They complete with this request's result.
+  std::vector<BaseObjectPtr<GetAddrInfoReqWrap>> waiters_;
+
  private:
   const uint8_t order_;
 };
 
+// A cache of getaddrinfo() results, shared by all threads of the process and
+// keyed by hostname, family, hints and result order. getaddrinfo() does not
+// report TTLs, so entries are kept for a configured time. Failed lookups that
+// are not transient are cached for their own time. An expired entry can still
+// be used for a while, as long as a lookup refreshes it in the background.
+// Concurrent misses by the same thread share a single lookup. The cache is
+// disabled until it is configured with dns.setLookupCache().
+class AddrInfoCache final {
+ public:
+  struct Options {
+    // All times in milliseconds.
+    uint64_t ttl = 0;
+    uint64_t negative_ttl = 0;
+    uint64_t stale_ttl = 0;
+    // Zero disables the cache.
+    size_t max_entries = 0;
+  };
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t stale_hits;
+    uint64_t coalesced;
+    size_t entries;
+  };
+
+  enum class Result {
+    // The caller should look the name up and Store() the result.
+    kMiss,
+    // |status| and |addresses| hold the cached result.
+    kHit,
+    // Like kHit, but the entry expired and the caller should also look the
+    // name up and Store() the result, without completing again.
+    kStale,
+    // The request was released to the request that is already looking up
+    // the same key on this thread.
+    kCoalesced,
+  };
+
+  static AddrInfoCache& Get();
+
+  bool enabled() const { return enabled_; }
+  void Configure(const Options& options);
+
+  Result Find(const std::string& key,
+              std::unique_ptr<GetAddrInfoReqWrap>* req,
+              int* status,
+              std::vector<std::string>* addresses);
+  void Store(const std::string& key,
+             GetAddrInfoReqWrap* req,
+             int status,
+             const std::vector<std::string>& addresses);
+  // Called when |req| is destroyed, so that it is no longer used as the
+  // request that waiters are added to.
+  void Forget(const std::string& key, GetAddrInfoReqWrap* req);
+
+  Stats GetStats();
+
+  static void SetLookupCache(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetLookupCacheStats(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ private:
+  struct Entry {
+    std::string key;
+    bool has_value = false;
+    int status = 0;
+    std::vector<std::string> addresses;
+    uint64_t expires_at = 0;
+    uint64_t stale_until = 0;
+    // The request that is looking this key up, and its thread's Environment.
+    GetAddrInfoReqWrap* pending = nullptr;
+    Environment* pending_env = nullptr;
+  };
+
+  void Evict();
+
+  std::atomic<bool> enabled_{false};
+  Mutex mutex_;
+  Options options_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t stale_hits_ = 0;
+  uint64_t coalesced_ = 0;
+};
+
 class GetNameInfoReqWrap final : public ReqWrap<uv_getnameinfo_t> {
  public:
   GetNameInfoReqWrap(Environment* env, v8::Local<v8::Object> req_wrap_obj);
@@ -17,16 +17,40 @@ bool CleanupQueue::empty() const {
   return cleanup_hooks_.empty();
 }
 
-void CleanupQueue::Add(Callback cb, void* arg) {
-  auto insertion_info =
-      cleanup_hooks_.emplace(cb, arg, cleanup_hook_counter_++);
+void CleanupQueue::Add(Callback cb, void* arg, bool memory_only) {
+  auto insertion_info = cleanup_hooks_.emplace(cb, arg, memory_only);
   // Make sure there was no existing element with these values.
   CHECK_EQ(insertion_info.second, true);
+
+  const CleanupHookCallback* hook = &*insertion_info.first;
+  hook->prev_ = tail_;
+  if (tail_ != nullptr) {
+    tail_->next_ = hook;
+  } else {
+    head_ = hook;
+  }
+  tail_ = hook;
 }
 
 void CleanupQueue::Remove(Callback cb, void* arg) {
-  CleanupHookCallback search{cb, arg, 0};
-  cleanup_hooks_.erase(search);
+  auto it = cleanup_hooks_.find(CleanupHookCallback{cb, arg});
+  if (it == cleanup_hooks_.end()) return;
+  Unlink(&*it);
+  cleanup_hooks_.erase(it);
+}
+
+void CleanupQueue::Unlink(const CleanupHookCallback* hook) {
+  if (drain_next_ == hook) drain_next_ = hook->prev_;
+  if (hook->prev_ != nullptr) {
+    hook->prev_->next_ = hook->next_;
+  } else {
+    head_ = hook->next_;
+  }
+  if (hook->next_ != nullptr) {
+    hook->next_->prev_ = hook->prev_;
+  } else {
+    tail_ = hook->prev_;
+  }
 }
 
 }  // namespace node
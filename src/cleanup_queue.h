@@ -6,7 +6,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <unordered_set>
-#include <vector>
 
 #include "memory_tracker.h"
 
@@ -27,19 +26,20 @@ class CleanupQueue : public MemoryRetainer {
 
   inline bool empty() const;
 
-  inline void Add(Callback cb, void* arg);
+  // Hooks that are added with `memory_only` set do nothing but release
+  // memory, so Drain() can drop them without calling them when the process
+  // is about to exit anyway.
+  inline void Add(Callback cb, void* arg, bool memory_only = false);
   inline void Remove(Callback cb, void* arg);
-  void Drain();
+  // Runs the hooks in reverse insertion order. Hooks that are added while
+  // draining are left for the next call.
+  void Drain(bool skip_memory_only = false);
 
  private:
   class CleanupHookCallback {
    public:
-    CleanupHookCallback(Callback fn,
-                        void* arg,
-                        uint64_t insertion_order_counter)
-        : fn_(fn),
-          arg_(arg),
-          insertion_order_counter_(insertion_order_counter) {}
+    CleanupHookCallback(Callback fn, void* arg, bool memory_only = false)
+        : fn_(fn), arg_(arg), memory_only_(memory_only) {}
 
     // Only hashes `arg_`, since that is usually enough to identify the hook.
     struct Hash {
@@ -56,20 +56,26 @@ class CleanupQueue : public MemoryRetainer {
     friend class CleanupQueue;
     Callback fn_;
     void* arg_;
+    bool memory_only_;
 
-    // We keep track of the insertion order for these objects, so that we can
-    // call the callbacks in reverse order when we are cleaning up.
-    uint64_t insertion_order_counter_;
+    // The hooks form a list in insertion order, so that we can call them in
+    // reverse order when we are cleaning up. The nodes of the set do not
+    // move, so these stay valid until the hook is erased.
+    mutable const CleanupHookCallback* prev_ = nullptr;
+    mutable const CleanupHookCallback* next_ = nullptr;
   };
 
-  std::vector<CleanupHookCallback> GetOrdered() const;
+  inline void Unlink(const CleanupHookCallback* hook);
 
   // Use an unordered_set, so that we have efficient insertion and removal.
   std::unordered_set<CleanupHookCallback,
                      CleanupHookCallback::Hash,
                      CleanupHookCallback::Equal>
       cleanup_hooks_;
-  uint64_t cleanup_hook_counter_ = 0;
+  const CleanupHookCallback* head_ = nullptr;
+  const CleanupHookCallback* tail_ = nullptr;
+  // The next hook that Drain() is going to run.
+  const CleanupHookCallback* drain_next_ = nullptr;
 };
 
 }  // namespace node
@@ -1,5 +1,8 @@
 #include "compile_cache.h"
+#include <array>
 #include <string>
+#include <type_traits>
+#include "amaro_version.h"
 #include "debug_utils-inl.h"
 #include "env-inl.h"
 #include "node_file.h"
@@ -13,13 +16,22 @@
 #include <unistd.h>  // getuid
 #endif
 
+#if defined(__POSIX__) && !defined(__wasi__)
+#include <sys/mman.h>
+#endif
+
 namespace node {
 
+using v8::CompiledWasmModule;
 using v8::Function;
+using v8::HandleScope;
 using v8::Local;
+using v8::MemorySpan;
 using v8::Module;
+using v8::OwnedBuffer;
 using v8::ScriptCompiler;
 using v8::String;
+using v8::UnboundScript;
 
 namespace {
 std::string Uint32ToHex(uint32_t crc) {
@@ -55,11 +67,74 @@ std::string GetCacheVersionTag() {
   return tag;
 }
 
-uint32_t GetCacheKey(std::string_view filename, CachedCodeType type) {
+// Maps the first |size| bytes of |file| into memory, or reads them into a
+// new[]-allocated buffer where that is not possible.
+bool MapOrReadFile(uv_file file, size_t size, uint8_t** data, bool* mapped) {
+#if defined(__POSIX__) && !defined(__wasi__)
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  if (mapping != MAP_FAILED) {
+    *data = static_cast<uint8_t*>(mapping);
+    *mapped = true;
+    return true;
+  }
+#endif
+  uint8_t* buffer = new uint8_t[size];
+  size_t total_read = 0;
+  while (total_read < size) {
+    uv_fs_t req;
+    uv_buf_t iov = uv_buf_init(reinterpret_cast<char*>(buffer + total_read),
+                               size - total_read);
+    int bytes_read =
+        uv_fs_read(nullptr, &req, file, &iov, 1, total_read, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes_read <= 0) {
+      break;
+    }
+    total_read += bytes_read;
+  }
+  if (total_read != size) {
+    delete[] buffer;
+    return false;
+  }
+  *data = buffer;
+  *mapped = false;
+  return true;
+}
+
+void UnmapOrFree(uint8_t* data, size_t size, bool mapped) {
+#if defined(__POSIX__) && !defined(__wasi__)
+  if (mapped) {
+    munmap(data, size);
+    return;
+  }
+#endif
+  delete[] data;
+}
+
+uint32_t GetCacheKey(std::string_view filename,
+                     CachedCodeType type,
+                     uint32_t code_hash) {
   uLong crc = crc32(0L, Z_NULL, 0);
   crc = crc32(crc, reinterpret_cast<const Bytef*>(&type), sizeof(type));
   crc = crc32(
       crc, reinterpret_cast<const Bytef*>(filename.data()), filename.length());
+  // Code compiled through vm often shares a file name, e.g. the default
+  // "evalmachine.<anonymous>", so it is also keyed by its content.
+  if (type == CachedCodeType::kVMScript ||
+      type == CachedCodeType::kVMFunction) {
+    crc = crc32(
+        crc, reinterpret_cast<const Bytef*>(&code_hash), sizeof(code_hash));
+  }
+  // The output of type stripping depends on the version of amaro, which can
+  // be updated without a change of NODE_VERSION, e.g. in nightly builds.
+  if (type == CachedCodeType::kStrippedTypeScript ||
+      type == CachedCodeType::kTransformedTypeScript ||
+      type == CachedCodeType::kTransformedTypeScriptWithSourceMaps) {
+    static constexpr std::string_view amaro_version = AMARO_VERSION;
+    crc = crc32(crc,
+                reinterpret_cast<const Bytef*>(amaro_version.data()),
+                amaro_version.length());
+  }
   return crc;
 }
 }  // namespace
@@ -74,6 +149,12 @@ inline void CompileCacheHandler::Debug(const char* format,
 
 ScriptCompiler::CachedData* CompileCacheEntry::CopyCache() const {
   DCHECK_NOT_NULL(cache);
+  // A cache read from a pack file points into the content of the file, which
+  // is kept until the handler is destroyed.
+  if (cache->buffer_policy == ScriptCompiler::CachedData::BufferNotOwned) {
+    return new ScriptCompiler::CachedData(
+        cache->data, cache->length, ScriptCompiler::CachedData::BufferNotOwned);
+  }
   int cache_size = cache->length;
   uint8_t* data = new uint8_t[cache_size];
   memcpy(data, cache->data, cache_size);
@@ -85,6 +166,37 @@ ScriptCompiler::CachedData* CompileCacheEntry::CopyCache() const {
 // See comments in CompileCacheHandler::Persist().
 constexpr uint32_t kCacheMagicNumber = 0x8adfdbb2;
 
+// Used for identifying and verifying a file is a compile cache pack file.
+// See comments in CompileCacheHandler::PersistPack().
+constexpr uint32_t kPackMagicNumber = 0x8adfdbb3;
+constexpr uint32_t kPackVersion = 1;
+constexpr size_t kPackHeaderSize = 2 * sizeof(uint32_t);
+
+// Used for identifying and verifying a file is a compiled WebAssembly module
+// cache file. See comments in CompileCacheHandler::SaveWasmModule().
+constexpr uint32_t kWasmCacheMagicNumber = 0x8adfdbb4;
+
+constexpr size_t kRecordMagicNumberOffset = 0;
+constexpr size_t kRecordCacheKeyOffset = 1;
+constexpr size_t kRecordCodeSizeOffset = 2;
+constexpr size_t kRecordCacheSizeOffset = 3;
+constexpr size_t kRecordCodeHashOffset = 4;
+constexpr size_t kRecordCacheHashOffset = 5;
+constexpr size_t kRecordHeaderHashOffset = 6;
+constexpr size_t kRecordHeaderCount = 8;
+constexpr size_t kRecordHeaderSize = kRecordHeaderCount * sizeof(uint32_t);
+// Records are padded to this alignment, so that the cache content of any
+// record is aligned in a mapping of the file.
+constexpr size_t kRecordAlignment = 8;
+
+constexpr size_t PadRecordSize(size_t size) {
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+size_t CompileCacheHandler::PackRecord::size() const {
+  return kRecordHeaderSize + PadRecordSize(cache_size);
+}
+
 const char* CompileCacheEntry::type_name() const {
   switch (type) {
     case CachedCodeType::kCommonJS:
@@ -97,6 +209,14 @@ const char* CompileCacheEntry::type_name() const {
       return "TransformedTypeScript";
     case CachedCodeType::kTransformedTypeScriptWithSourceMaps:
       return "TransformedTypeScriptWithSourceMaps";
+    case CachedCodeType::kCommonJSExports:
+      return "CommonJSExports";
+    case CachedCodeType::kWasm:
+      return "Wasm";
+    case CachedCodeType::kVMScript:
+      return "VMScript";
+    case CachedCodeType::kVMFunction:
+      return "VMFunction";
     default:
       UNREACHABLE();
   }
@@ -223,19 +343,147 @@ void CompileCacheHandler::ReadCacheFile(CompileCacheEntry* entry) {
   Debug(" success, size=%d\n", total_read);
 }
 
+void CompileCacheHandler::LoadPack() {
+  Debug("[compile cache] loading pack %s...", pack_filename_);
+
+  uv_fs_t req;
+  auto defer_req_cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+  const char* path = pack_filename_.c_str();
+  uv_file file = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  if (req.result < 0) {
+    // req will be cleaned up by scope leave.
+    Debug(" %s\n", uv_strerror(req.result));
+    return;
+  }
+  uv_fs_req_cleanup(&req);
+
+  auto defer_close = OnScopeLeave([file]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, file, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  if (uv_fs_fstat(nullptr, &req, file, nullptr) < 0) {
+    Debug(" %s\n", uv_strerror(req.result));
+    return;
+  }
+  const size_t size = static_cast<size_t>(req.statbuf.st_size);
+  uv_fs_req_cleanup(&req);
+  if (size < kPackHeaderSize) {
+    Debug(" too small, size=%zu\n", size);
+    return;
+  }
+
+  if (!MapOrReadFile(file, size, &pack_data_, &pack_mapped_)) {
+    Debug(" reading failed\n");
+    return;
+  }
+  pack_size_ = size;
+
+  uint32_t pack_header[2];
+  memcpy(pack_header, pack_data_, kPackHeaderSize);
+  if (pack_header[0] != kPackMagicNumber || pack_header[1] != kPackVersion) {
+    Debug(" magic number or version mismatch: [%d %d]\n",
+          pack_header[0],
+          pack_header[1]);
+    // Replace the whole file on the next write.
+    pack_dead_bytes_ = pack_size_;
+    return;
+  }
+
+  // Build the index. The last record of a key supersedes the earlier ones.
+  // The hashes of the cache contents are only checked when they are used.
+  size_t offset = kPackHeaderSize;
+  while (offset + kRecordHeaderSize <= size) {
+    uint32_t header[kRecordHeaderCount];
+    memcpy(header, pack_data_ + offset, kRecordHeaderSize);
+    if (header[kRecordMagicNumberOffset] != kCacheMagicNumber ||
+        header[kRecordHeaderHashOffset] !=
+            GetHash(reinterpret_cast<char*>(header),
+                    kRecordHeaderHashOffset * sizeof(uint32_t))) {
+      break;
+    }
+    PackRecord record{offset,
+                      header[kRecordCodeSizeOffset],
+                      header[kRecordCodeHashOffset],
+                      header[kRecordCacheSizeOffset],
+                      header[kRecordCacheHashOffset]};
+    if (record.size() > size - offset) {
+      break;
+    }
+    auto emplaced = pack_index_.emplace(header[kRecordCacheKeyOffset], record);
+    if (!emplaced.second) {
+      pack_dead_bytes_ += emplaced.first->second.size();
+      emplaced.first->second = record;
+    }
+    offset += record.size();
+  }
+
+  if (offset != size) {
+    // The end of the file is a partial or corrupted record, which would hide
+    // the records appended after it. Replace the whole file on the next write.
+    Debug(" invalid record at %zu...", offset);
+    pack_dead_bytes_ = pack_size_;
+  }
+  Debug(" %zu records, size=%zu\n", pack_index_.size(), size);
+}
+
+void CompileCacheHandler::ReadPackRecord(CompileCacheEntry* entry) {
+  Debug("[compile cache] reading cache from pack for %s %s...",
+        entry->type_name(),
+        entry->source_filename);
+
+  auto it = pack_index_.find(entry->cache_key);
+  if (it == pack_index_.end()) {
+    Debug(" not found\n");
+    return;
+  }
+  PackRecord* record = &it->second;
+
+  if (record->code_size != entry->code_size) {
+    Debug("code size mismatch: expected %d, actual %d\n",
+          entry->code_size,
+          record->code_size);
+    return;
+  }
+  if (record->code_hash != entry->code_hash) {
+    Debug("code hash mismatch: expected %d, actual %d\n",
+          entry->code_hash,
+          record->code_hash);
+    return;
+  }
+
+  const uint8_t* cache = pack_data_ + record->offset + kRecordHeaderSize;
+  if (!record->verified) {
+    uint32_t cache_hash =
+        GetHash(reinterpret_cast<const char*>(cache), record->cache_size);
+    if (record->cache_hash != cache_hash) {
+      Debug("cache hash mismatch: expected %d, actual %d\n",
+            record->cache_hash,
+            cache_hash);
+      return;
+    }
+    record->verified = true;
+  }
+
+  entry->cache.reset(new ScriptCompiler::CachedData(
+      cache, record->cache_size, ScriptCompiler::CachedData::BufferNotOwned));
+  Debug(" success, size=%d\n", record->cache_size);
+}
+
 CompileCacheEntry* CompileCacheHandler::GetOrInsert(Local<String> code,
                                                     Local<String> filename,
                                                     CachedCodeType type) {
   DCHECK(!compile_cache_dir_.empty());
 
   Utf8Value filename_utf8(isolate_, filename);
-  uint32_t key = GetCacheKey(filename_utf8.ToStringView(), type);
 
   // TODO(joyeecheung): don't encode this again into UTF8. If we read the
   // UTF8 content on disk as raw buffer (from the JS layer, while watching out
   // for monkey patching), we can just hash it directly.
   Utf8Value code_utf8(isolate_, code);
   uint32_t code_hash = GetHash(code_utf8.out(), code_utf8.length());
+  uint32_t key = GetCacheKey(filename_utf8.ToStringView(), type, code_hash);
   auto loaded = compiler_cache_store_.find(key);
 
   // TODO(joyeecheung): let V8's in-isolate compilation cache take precedence.
@@ -258,14 +506,245 @@ CompileCacheEntry* CompileCacheHandler::GetOrInsert(Local<String> code,
   result->source_filename = filename_utf8.ToString();
   result->cache = nullptr;
   result->type = type;
+  result->pending_function.Reset();
+  result->pending_module.Reset();
+  result->pending_script.Reset();
 
   // TODO(joyeecheung): if we fail enough times, stop trying for any future
   // files.
-  ReadCacheFile(result);
+  if (use_pack_) {
+    ReadPackRecord(result);
+  } else {
+    ReadCacheFile(result);
+  }
 
   return result;
 }
 
+// The size of the headers of a WebAssembly module cache file, which are the
+// same as those of the code cache files.
+constexpr size_t kWasmHeaderSize = 5 * sizeof(uint32_t);
+
+const uint8_t* WasmCacheEntry::module_data() const {
+  DCHECK_NOT_NULL(file_data);
+  return file_data + kWasmHeaderSize;
+}
+
+size_t WasmCacheEntry::module_size() const {
+  DCHECK_NOT_NULL(file_data);
+  return file_size - kWasmHeaderSize;
+}
+
+void WasmCacheEntry::UpdateStreamedHash(const uint8_t* bytes, size_t size) {
+  streamed_hash = static_cast<uint32_t>(crc32(streamed_hash, bytes, size));
+  streamed_size += static_cast<uint32_t>(size);
+}
+
+bool WasmCacheEntry::MatchesStreamedBytes() const {
+  return file_data != nullptr && streamed_size == wire_size &&
+         streamed_hash == wire_hash;
+}
+
+void WasmCacheEntry::ReleaseData() {
+  if (file_data == nullptr) {
+    return;
+  }
+  UnmapOrFree(file_data, file_size, file_mapped);
+  file_data = nullptr;
+  file_size = 0;
+}
+
+WasmCacheEntry::~WasmCacheEntry() {
+  ReleaseData();
+}
+
+std::unique_ptr<WasmCacheEntry> CompileCacheHandler::GetWasmModule(
+    std::string_view url) {
+  DCHECK(!compile_cache_dir_.empty());
+  uint32_t key = GetCacheKey(url, CachedCodeType::kWasm, 0);
+  auto entry = std::make_unique<WasmCacheEntry>();
+  entry->url = url;
+  entry->cache_filename =
+      compile_cache_dir_ + kPathSeparator + Uint32ToHex(key);
+  ReadWasmCacheFile(entry.get());
+  return entry;
+}
+
+void CompileCacheHandler::ReadWasmCacheFile(WasmCacheEntry* entry) {
+  Debug("[compile cache] reading WebAssembly module from %s for %s...",
+        entry->cache_filename,
+        entry->url);
+
+  uv_fs_t req;
+  auto defer_req_cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+  const char* path = entry->cache_filename.c_str();
+  uv_file file = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  if (req.result < 0) {
+    // req will be cleaned up by scope leave.
+    Debug(" %s\n", uv_strerror(req.result));
+    return;
+  }
+  uv_fs_req_cleanup(&req);
+
+  auto defer_close = OnScopeLeave([file]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, file, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  if (uv_fs_fstat(nullptr, &req, file, nullptr) < 0) {
+    Debug(" %s\n", uv_strerror(req.result));
+    return;
+  }
+  const size_t size = static_cast<size_t>(req.statbuf.st_size);
+  uv_fs_req_cleanup(&req);
+  if (size <= kWasmHeaderSize) {
+    Debug(" too small, size=%zu\n", size);
+    return;
+  }
+
+  uint8_t* data;
+  bool mapped;
+  if (!MapOrReadFile(file, size, &data, &mapped)) {
+    Debug(" reading failed\n");
+    return;
+  }
+  auto defer_free = OnScopeLeave([&]() {
+    if (data != nullptr) UnmapOrFree(data, size, mapped);
+  });
+
+  static_assert(kHeaderCount * sizeof(uint32_t) == kWasmHeaderSize);
+  uint32_t headers[kHeaderCount];
+  memcpy(headers, data, kWasmHeaderSize);
+  Debug("[%d %d %d %d %d]...",
+        headers[kMagicNumberOffset],
+        headers[kCodeSizeOffset],
+        headers[kCacheSizeOffset],
+        headers[kCodeHashOffset],
+        headers[kCacheHashOffset]);
+
+  if (headers[kMagicNumberOffset] != kWasmCacheMagicNumber) {
+    Debug("magic number mismatch: expected %d, actual %d\n",
+          kWasmCacheMagicNumber,
+          headers[kMagicNumberOffset]);
+    return;
+  }
+  const size_t module_size = size - kWasmHeaderSize;
+  if (headers[kCacheSizeOffset] != module_size) {
+    Debug("cache size mismatch: expected %d, actual %zu\n",
+          headers[kCacheSizeOffset],
+          module_size);
+    return;
+  }
+  uint32_t cache_hash =
+      GetHash(reinterpret_cast<const char*>(data + kWasmHeaderSize),
+              module_size);
+  if (headers[kCacheHashOffset] != cache_hash) {
+    Debug("cache hash mismatch: expected %d, actual %d\n",
+          headers[kCacheHashOffset],
+          cache_hash);
+    return;
+  }
+
+  // The wire bytes are only known once they have been streamed, so they are
+  // checked against the headers by the caller.
+  entry->wire_size = headers[kCodeSizeOffset];
+  entry->wire_hash = headers[kCodeHashOffset];
+  entry->file_data = data;
+  entry->file_size = size;
+  entry->file_mapped = mapped;
+  data = nullptr;
+  Debug(" success, size=%zu\n", module_size);
+}
+
+// Layout of a compiled WebAssembly module cache file, where the headers are
+// the same as those of the files of the code cache:
+//
+// [uint32_t] kWasmCacheMagicNumber
+// [uint32_t] size of the wire bytes that the module was compiled from
+// [uint32_t] size of the serialized module
+// [uint32_t] hash of the wire bytes
+// [uint32_t] hash of the serialized module
+// ... serialized module, as produced by v8::CompiledWasmModule::Serialize()
+//
+// The serialized module does not contain the wire bytes, and V8 rejects it
+// when it was produced by a different version of V8 or with different flags.
+// Different versions of Node.js use different cache directories anyway.
+void CompileCacheHandler::SaveWasmModule(const std::string& cache_filename,
+                                         CompiledWasmModule module) {
+  MemorySpan<const uint8_t> wire_bytes = module.GetWireBytesRef();
+  OwnedBuffer serialized = module.Serialize();
+  if (serialized.size == 0) {
+    return;
+  }
+  char* module_ptr =
+      reinterpret_cast<char*>(const_cast<uint8_t*>(serialized.buffer.get()));
+
+  uint32_t headers[kHeaderCount];
+  headers[kMagicNumberOffset] = kWasmCacheMagicNumber;
+  headers[kCodeSizeOffset] = static_cast<uint32_t>(wire_bytes.size());
+  headers[kCacheSizeOffset] = static_cast<uint32_t>(serialized.size);
+  headers[kCodeHashOffset] =
+      GetHash(reinterpret_cast<const char*>(wire_bytes.data()),
+              wire_bytes.size());
+  headers[kCacheHashOffset] = GetHash(module_ptr, serialized.size);
+
+  // Write to a temporary file first, see WriteCacheFile().
+  uv_fs_t mkstemp_req;
+  auto cleanup_mkstemp =
+      OnScopeLeave([&mkstemp_req]() { uv_fs_req_cleanup(&mkstemp_req); });
+  std::string cache_filename_tmp = cache_filename + ".XXXXXX";
+  int err = uv_fs_mkstemp(
+      nullptr, &mkstemp_req, cache_filename_tmp.c_str(), nullptr);
+  if (err < 0) {
+    per_process::Debug(DebugCategory::COMPILE_CACHE,
+                       "[compile cache] creating temporary file for "
+                       "WebAssembly module %s failed: %s\n",
+                       module.source_url(),
+                       uv_strerror(err));
+    return;
+  }
+
+  uv_buf_t bufs[] = {
+      uv_buf_init(reinterpret_cast<char*>(headers), kWasmHeaderSize),
+      uv_buf_init(module_ptr, serialized.size)};
+  uv_fs_t write_req;
+  err = uv_fs_write(
+      nullptr, &write_req, mkstemp_req.result, bufs, 2, 0, nullptr);
+  uv_fs_req_cleanup(&write_req);
+  uv_fs_t close_req;
+  int close_err =
+      uv_fs_close(nullptr, &close_req, mkstemp_req.result, nullptr);
+  uv_fs_req_cleanup(&close_req);
+
+  uv_fs_t fs_req;
+  if (err >= 0 && close_err >= 0) {
+    err = uv_fs_rename(nullptr,
+                       &fs_req,
+                       mkstemp_req.path,
+                       cache_filename.c_str(),
+                       nullptr);
+    uv_fs_req_cleanup(&fs_req);
+  }
+  if (err < 0 || close_err < 0) {
+    uv_fs_unlink(nullptr, &fs_req, mkstemp_req.path, nullptr);
+    uv_fs_req_cleanup(&fs_req);
+    per_process::Debug(DebugCategory::COMPILE_CACHE,
+                       "[compile cache] writing WebAssembly module %s to %s "
+                       "failed: %s\n",
+                       module.source_url(),
+                       cache_filename,
+                       uv_strerror(err < 0 ? err : close_err));
+    return;
+  }
+  per_process::Debug(DebugCategory::COMPILE_CACHE,
+                     "[compile cache] wrote WebAssembly module %s to %s, "
+                     "size=%zu\n",
+                     module.source_url(),
+                     cache_filename,
+                     serialized.size);
+}
+
 ScriptCompiler::CachedData* SerializeCodeCache(Local<Function> func) {
   return ScriptCompiler::CreateCodeCacheForFunction(func);
 }
@@ -274,6 +753,10 @@ ScriptCompiler::CachedData* SerializeCodeCache(Local<Module> mod) {
   return ScriptCompiler::CreateCodeCache(mod->GetUnboundModuleScript());
 }
 
+ScriptCompiler::CachedData* SerializeCodeCache(Local<UnboundScript> script) {
+  return ScriptCompiler::CreateCodeCache(script);
+}
+
 template <typename T>
 void CompileCacheHandler::MaybeSaveImpl(CompileCacheEntry* entry,
                                         Local<T> func_or_mod,
@@ -289,8 +772,30 @@ void CompileCacheHandler::MaybeSaveImpl(CompileCacheEntry* entry,
     Debug("keeping the in-memory entry\n");
     return;
   }
-  Debug("%s the in-memory entry\n",
-        entry->cache == nullptr ? "initializing" : "refreshing");
+  Debug("%s the in-memory entry%s\n",
+        entry->cache == nullptr ? "initializing" : "refreshing",
+        async_ ? " after it has run" : "");
+
+  if (async_) {
+    // The code cache created after the code has run also contains the
+    // functions that were compiled lazily.
+    if constexpr (std::is_same_v<T, Function>) {
+      entry->pending_function.Reset(isolate_, func_or_mod);
+    } else if constexpr (std::is_same_v<T, UnboundScript>) {
+      entry->pending_script.Reset(isolate_, func_or_mod);
+    } else {
+      entry->pending_module.Reset(isolate_, func_or_mod);
+    }
+    pending_entries_.push_back(entry);
+    if (!pending_scheduled_) {
+      pending_scheduled_ = true;
+      env_->SetUnrefImmediate([this](Environment* env) {
+        pending_scheduled_ = false;
+        PersistInBackground();
+      });
+    }
+    return;
+  }
 
   ScriptCompiler::CachedData* data = SerializeCodeCache(func_or_mod);
   DCHECK_EQ(data->buffer_policy, ScriptCompiler::CachedData::BufferOwned);
@@ -311,11 +816,18 @@ void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
   MaybeSaveImpl(entry, func, rejected);
 }
 
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<UnboundScript> script,
+                                    bool rejected) {
+  MaybeSaveImpl(entry, script, rejected);
+}
+
 void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
                                     std::string_view transpiled) {
   CHECK(entry->type == CachedCodeType::kStrippedTypeScript ||
         entry->type == CachedCodeType::kTransformedTypeScript ||
-        entry->type == CachedCodeType::kTransformedTypeScriptWithSourceMaps);
+        entry->type == CachedCodeType::kTransformedTypeScriptWithSourceMaps ||
+        entry->type == CachedCodeType::kCommonJSExports);
   Debug("[compile cache] saving transpilation cache for %s %s\n",
         entry->type_name(),
         entry->source_filename);
@@ -330,159 +842,431 @@ void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
   entry->refreshed = true;
 }
 
+void CompileCacheHandler::ReleaseConsumedCaches() {
+  size_t released = 0;
+  for (auto& pair : compiler_cache_store_) {
+    CompileCacheEntry* entry = pair.second.get();
+    if (entry->cache == nullptr || entry->refreshed) continue;
+    released += entry->cache->length;
+    entry->cache.reset();
+  }
+  Debug("[compile cache] released %zu bytes of consumed caches\n", released);
+}
+
+bool CompileCacheHandler::NeedsPersisting(
+    const CompileCacheEntry* entry) const {
+  const char* type_name = entry->type_name();
+  if (entry->cache == nullptr) {
+    Debug("[compile cache] skip persisting %s %s because the cache was not "
+          "initialized\n",
+          type_name,
+          entry->source_filename);
+    return false;
+  }
+  if (entry->refreshed == false) {
+    Debug("[compile cache] skip persisting %s %s because cache was the same\n",
+          type_name,
+          entry->source_filename);
+    return false;
+  }
+  if (entry->persisted == true) {
+    Debug("[compile cache] skip persisting %s %s because cache was already "
+          "persisted\n",
+          type_name,
+          entry->source_filename);
+    return false;
+  }
+  return true;
+}
+
 /**
- * Persist the compile cache accumulated in memory to disk.
+ * Persist the compile cache accumulated in memory to the pack file.
  *
- * To avoid race conditions, the cache file includes hashes of the original
- * source code and the cache content. It's first written to a temporary file
- * before being renamed to the target name.
+ * New records are appended to the pack file, so that other processes can
+ * keep using the content of the file that they have read or mapped. When
+ * superseded records take up more than half of the file, the live records
+ * are written to a temporary file instead, which is then renamed to the
+ * pack file.
  *
- * Layout of a cache file:
+ * Layout of the pack file:
+ *   [uint32_t] pack magic number
+ *   [uint32_t] pack version
+ *   .... records ....
+ *
+ * Layout of a record, which is padded to a multiple of 8 bytes:
  *   [uint32_t] magic number
+ *   [uint32_t] cache key
  *   [uint32_t] code size
- *   [uint32_t] code hash
  *   [uint32_t] cache size
+ *   [uint32_t] code hash
  *   [uint32_t] cache hash
+ *   [uint32_t] hash of the fields above
+ *   [uint32_t] padding
  *   .... compile cache content ....
  */
-void CompileCacheHandler::Persist() {
-  DCHECK(!compile_cache_dir_.empty());
-
-  // TODO(joyeecheung): do this using a separate event loop to utilize the
-  // libuv thread pool and do the file system operations concurrently.
-  // TODO(joyeecheung): Currently flushing is triggered by either process
-  // shutdown or user requests. In the future we should simply start the
-  // writes right after module loading on a separate thread, and this method
-  // only blocks until all the pending writes (if any) on the other thread are
-  // finished. In that case, the off-thread writes should finish long
-  // before any attempt of flushing is made so the method would then only
-  // incur a negligible overhead from thread synchronization.
+void CompileCacheHandler::PersistPack() {
+  std::vector<CompileCacheEntry*> entries;
+  std::vector<std::array<uint32_t, kRecordHeaderCount>> headers;
+  size_t new_bytes = 0;
   for (auto& pair : compiler_cache_store_) {
     auto* entry = pair.second.get();
-    const char* type_name = entry->type_name();
-    if (entry->cache == nullptr) {
-      Debug("[compile cache] skip persisting %s %s because the cache was not "
-            "initialized\n",
-            type_name,
-            entry->source_filename);
+    if (!NeedsPersisting(entry)) {
       continue;
     }
-    if (entry->refreshed == false) {
-      Debug(
-          "[compile cache] skip persisting %s %s because cache was the same\n",
-          type_name,
-          entry->source_filename);
-      continue;
+    DCHECK_EQ(entry->cache->buffer_policy,
+              ScriptCompiler::CachedData::BufferOwned);
+    auto& header = headers.emplace_back();
+    header.fill(0);
+    header[kRecordMagicNumberOffset] = kCacheMagicNumber;
+    header[kRecordCacheKeyOffset] = entry->cache_key;
+    header[kRecordCodeSizeOffset] = entry->code_size;
+    header[kRecordCacheSizeOffset] = entry->cache->length;
+    header[kRecordCodeHashOffset] = entry->code_hash;
+    header[kRecordCacheHashOffset] =
+        GetHash(reinterpret_cast<const char*>(entry->cache->data),
+                entry->cache->length);
+    header[kRecordHeaderHashOffset] =
+        GetHash(reinterpret_cast<char*>(header.data()),
+                kRecordHeaderHashOffset * sizeof(uint32_t));
+    entries.push_back(entry);
+    new_bytes += kRecordHeaderSize + PadRecordSize(entry->cache->length);
+
+    // The records of the file that this one supersedes are dropped from the
+    // index, so that they are not written again by a compaction.
+    auto superseded = pack_index_.find(entry->cache_key);
+    if (superseded != pack_index_.end()) {
+      pack_dead_bytes_ += superseded->second.size();
+      pack_index_.erase(superseded);
     }
-    if (entry->persisted == true) {
-      Debug("[compile cache] skip persisting %s %s because cache was already "
-            "persisted\n",
-            type_name,
-            entry->source_filename);
-      continue;
+  }
+
+  if (!entries.empty()) {
+    const bool compact =
+        !pack_written_ &&
+        (pack_size_ == 0 || pack_dead_bytes_ * 2 > pack_size_ + new_bytes);
+    static constexpr char kPadding[kRecordAlignment] = {};
+    const uint32_t pack_header[] = {kPackMagicNumber, kPackVersion};
+
+    std::vector<uv_buf_t> bufs;
+    if (compact) {
+      bufs.push_back(uv_buf_init(
+          const_cast<char*>(reinterpret_cast<const char*>(pack_header)),
+          kPackHeaderSize));
+      for (const auto& [key, record] : pack_index_) {
+        bufs.push_back(uv_buf_init(
+            reinterpret_cast<char*>(pack_data_ + record.offset),
+            record.size()));
+      }
+    }
+    for (size_t i = 0; i < entries.size(); i++) {
+      const ScriptCompiler::CachedData* cache = entries[i]->cache.get();
+      bufs.push_back(uv_buf_init(reinterpret_cast<char*>(headers[i].data()),
+                                 kRecordHeaderSize));
+      bufs.push_back(uv_buf_init(
+          reinterpret_cast<char*>(const_cast<uint8_t*>(cache->data)),
+          cache->length));
+      if (size_t padding = PadRecordSize(cache->length) - cache->length) {
+        bufs.push_back(uv_buf_init(const_cast<char*>(kPadding), padding));
+      }
     }
 
-    DCHECK_EQ(entry->cache->buffer_policy,
-              ScriptCompiler::CachedData::BufferOwned);
-    char* cache_ptr =
-        reinterpret_cast<char*>(const_cast<uint8_t*>(entry->cache->data));
-    uint32_t cache_size = static_cast<uint32_t>(entry->cache->length);
-    uint32_t cache_hash = GetHash(cache_ptr, cache_size);
-
-    // Generating headers.
-    std::vector<uint32_t> headers(kHeaderCount);
-    headers[kMagicNumberOffset] = kCacheMagicNumber;
-    headers[kCodeSizeOffset] = entry->code_size;
-    headers[kCacheSizeOffset] = cache_size;
-    headers[kCodeHashOffset] = entry->code_hash;
-    headers[kCacheHashOffset] = cache_hash;
-
-    // Generate the temporary filename.
-    // The temporary file should be placed in a location like:
-    //
-    // $NODE_COMPILE_CACHE_DIR/v23.0.0-pre-arm64-5fad6d45-501/e7f8ef7f.cache.tcqrsK
-    //
-    // 1. $NODE_COMPILE_CACHE_DIR either comes from the $NODE_COMPILE_CACHE
-    // environment
-    //    variable or `module.enableCompileCache()`.
-    // 2. v23.0.0-pre-arm64-5fad6d45-501 is the sub cache directory and
-    //    e7f8ef7f is the hash for the cache (see
-    //    CompileCacheHandler::Enable()),
-    // 3. tcqrsK is generated by uv_fs_mkstemp() as a temporary identifier.
-    uv_fs_t mkstemp_req;
-    auto cleanup_mkstemp =
-        OnScopeLeave([&mkstemp_req]() { uv_fs_req_cleanup(&mkstemp_req); });
-    std::string cache_filename_tmp = entry->cache_filename + ".XXXXXX";
-    Debug("[compile cache] Creating temporary file for cache of %s (%s)...",
-          entry->source_filename,
-          type_name);
-    int err = uv_fs_mkstemp(
-        nullptr, &mkstemp_req, cache_filename_tmp.c_str(), nullptr);
-    if (err < 0) {
-      Debug("failed. %s\n", uv_strerror(err));
-      continue;
+    Debug("[compile cache] %s %zu records %s pack %s...",
+          compact ? "writing" : "appending",
+          entries.size(),
+          compact ? "to" : "to the end of",
+          pack_filename_);
+
+    uv_fs_t open_req;
+    auto cleanup_open =
+        OnScopeLeave([&open_req]() { uv_fs_req_cleanup(&open_req); });
+    std::string pack_filename_tmp = pack_filename_ + ".XXXXXX";
+    int err = compact ? uv_fs_mkstemp(nullptr,
+                                      &open_req,
+                                      pack_filename_tmp.c_str(),
+                                      nullptr)
+                      : uv_fs_open(nullptr,
+                                   &open_req,
+                                   pack_filename_.c_str(),
+                                   O_WRONLY | O_APPEND,
+                                   0,
+                                   nullptr);
+    if (err >= 0) {
+      uv_file file = static_cast<uv_file>(open_req.result);
+      uv_fs_t write_req;
+      err = uv_fs_write(
+          nullptr, &write_req, file, bufs.data(), bufs.size(), -1, nullptr);
+      uv_fs_req_cleanup(&write_req);
+      uv_fs_t close_req;
+      int close_err = uv_fs_close(nullptr, &close_req, file, nullptr);
+      uv_fs_req_cleanup(&close_req);
+      if (err >= 0) err = close_err;
     }
-    Debug(" -> %s\n", mkstemp_req.path);
-    Debug("[compile cache] writing cache for %s %s to temporary file %s [%d "
-          "%d %d "
-          "%d %d]...",
-          type_name,
-          entry->source_filename,
-          mkstemp_req.path,
-          headers[kMagicNumberOffset],
-          headers[kCodeSizeOffset],
-          headers[kCacheSizeOffset],
-          headers[kCodeHashOffset],
-          headers[kCacheHashOffset]);
-
-    // Write to the temporary file.
-    uv_buf_t headers_buf = uv_buf_init(reinterpret_cast<char*>(headers.data()),
-                                       headers.size() * sizeof(uint32_t));
-    uv_buf_t data_buf = uv_buf_init(cache_ptr, entry->cache->length);
-    uv_buf_t bufs[] = {headers_buf, data_buf};
-
-    uv_fs_t write_req;
-    auto cleanup_write =
-        OnScopeLeave([&write_req]() { uv_fs_req_cleanup(&write_req); });
-    err = uv_fs_write(
-        nullptr, &write_req, mkstemp_req.result, bufs, 2, 0, nullptr);
+    if (err >= 0 && compact) {
+      uv_fs_t rename_req;
+      err = uv_fs_rename(nullptr,
+                         &rename_req,
+                         open_req.path,
+                         pack_filename_.c_str(),
+                         nullptr);
+      uv_fs_req_cleanup(&rename_req);
+    }
+
     if (err < 0) {
       Debug("failed: %s\n", uv_strerror(err));
-      continue;
+    } else {
+      Debug("success\n");
+      pack_written_ = true;
+      for (auto* entry : entries) {
+        entry->persisted = true;
+      }
     }
+  }
 
-    uv_fs_t close_req;
-    auto cleanup_close =
-        OnScopeLeave([&close_req]() { uv_fs_req_cleanup(&close_req); });
-    err = uv_fs_close(nullptr, &close_req, mkstemp_req.result, nullptr);
+  // Clear the map at the end in one go instead of during the iteration to
+  // avoid rehashing costs.
+  Debug("[compile cache] Clear deserialized cache.\n");
+  compiler_cache_store_.clear();
+}
 
-    if (err < 0) {
-      Debug("failed: %s\n", uv_strerror(err));
+// Writes the cache of |entry| to its cache file. See Persist() for the
+// layout of the file. May be called on any thread.
+bool CompileCacheHandler::WriteCacheFile(
+    const CompileCacheEntry* entry) const {
+  const char* type_name = entry->type_name();
+  DCHECK_EQ(entry->cache->buffer_policy,
+            ScriptCompiler::CachedData::BufferOwned);
+  char* cache_ptr =
+      reinterpret_cast<char*>(const_cast<uint8_t*>(entry->cache->data));
+  uint32_t cache_size = static_cast<uint32_t>(entry->cache->length);
+  uint32_t cache_hash = GetHash(cache_ptr, cache_size);
+
+  // Generating headers.
+  std::vector<uint32_t> headers(kHeaderCount);
+  headers[kMagicNumberOffset] = kCacheMagicNumber;
+  headers[kCodeSizeOffset] = entry->code_size;
+  headers[kCacheSizeOffset] = cache_size;
+  headers[kCodeHashOffset] = entry->code_hash;
+  headers[kCacheHashOffset] = cache_hash;
+
+  // Generate the temporary filename.
+  // The temporary file should be placed in a location like:
+  //
+  // $NODE_COMPILE_CACHE_DIR/v23.0.0-pre-arm64-5fad6d45-501/e7f8ef7f.cache.tcqrsK
+  //
+  // 1. $NODE_COMPILE_CACHE_DIR either comes from the $NODE_COMPILE_CACHE
+  // environment
+  //    variable or `module.enableCompileCache()`.
+  // 2. v23.0.0-pre-arm64-5fad6d45-501 is the sub cache directory and
+  //    e7f8ef7f is the hash for the cache (see
+  //    CompileCacheHandler::Enable()),
+  // 3. tcqrsK is generated by uv_fs_mkstemp() as a temporary identifier.
+  uv_fs_t mkstemp_req;
+  auto cleanup_mkstemp =
+      OnScopeLeave([&mkstemp_req]() { uv_fs_req_cleanup(&mkstemp_req); });
+  std::string cache_filename_tmp = entry->cache_filename + ".XXXXXX";
+  Debug("[compile cache] Creating temporary file for cache of %s (%s)...",
+        entry->source_filename,
+        type_name);
+  int err = uv_fs_mkstemp(
+      nullptr, &mkstemp_req, cache_filename_tmp.c_str(), nullptr);
+  if (err < 0) {
+    Debug("failed. %s\n", uv_strerror(err));
+    return false;
+  }
+  Debug(" -> %s\n", mkstemp_req.path);
+  Debug("[compile cache] writing cache for %s %s to temporary file %s [%d "
+        "%d %d "
+        "%d %d]...",
+        type_name,
+        entry->source_filename,
+        mkstemp_req.path,
+        headers[kMagicNumberOffset],
+        headers[kCodeSizeOffset],
+        headers[kCacheSizeOffset],
+        headers[kCodeHashOffset],
+        headers[kCacheHashOffset]);
+
+  // Write to the temporary file.
+  uv_buf_t headers_buf = uv_buf_init(reinterpret_cast<char*>(headers.data()),
+                                     headers.size() * sizeof(uint32_t));
+  uv_buf_t data_buf = uv_buf_init(cache_ptr, entry->cache->length);
+  uv_buf_t bufs[] = {headers_buf, data_buf};
+
+  uv_fs_t write_req;
+  auto cleanup_write =
+      OnScopeLeave([&write_req]() { uv_fs_req_cleanup(&write_req); });
+  err = uv_fs_write(
+      nullptr, &write_req, mkstemp_req.result, bufs, 2, 0, nullptr);
+  if (err < 0) {
+    Debug("failed: %s\n", uv_strerror(err));
+    return false;
+  }
+
+  uv_fs_t close_req;
+  auto cleanup_close =
+      OnScopeLeave([&close_req]() { uv_fs_req_cleanup(&close_req); });
+  err = uv_fs_close(nullptr, &close_req, mkstemp_req.result, nullptr);
+
+  if (err < 0) {
+    Debug("failed: %s\n", uv_strerror(err));
+    return false;
+  }
+
+  Debug("success\n");
+
+  // Rename the temporary file to the actual cache file.
+  uv_fs_t rename_req;
+  auto cleanup_rename =
+      OnScopeLeave([&rename_req]() { uv_fs_req_cleanup(&rename_req); });
+  std::string cache_filename_final = entry->cache_filename;
+  Debug("[compile cache] Renaming %s to %s...",
+        mkstemp_req.path,
+        cache_filename_final);
+  err = uv_fs_rename(nullptr,
+                     &rename_req,
+                     mkstemp_req.path,
+                     cache_filename_final.c_str(),
+                     nullptr);
+  if (err < 0) {
+    Debug("failed: %s\n", uv_strerror(err));
+    return false;
+  }
+  Debug("success\n");
+  return true;
+}
+
+void CompileCacheHandler::ProducePendingCaches() {
+  HandleScope scope(isolate_);
+  for (CompileCacheEntry* entry : pending_entries_) {
+    ScriptCompiler::CachedData* data;
+    if (!entry->pending_function.IsEmpty()) {
+      data = SerializeCodeCache(entry->pending_function.Get(isolate_));
+    } else if (!entry->pending_module.IsEmpty()) {
+      data = SerializeCodeCache(entry->pending_module.Get(isolate_));
+    } else if (!entry->pending_script.IsEmpty()) {
+      data = SerializeCodeCache(entry->pending_script.Get(isolate_));
+    } else {
+      // The entry has been reused for a different version of the code.
       continue;
     }
+    Debug("[compile cache] created V8 code cache for %s %s after it has run\n",
+          entry->type_name(),
+          entry->source_filename);
+    entry->pending_function.Reset();
+    entry->pending_module.Reset();
+    entry->pending_script.Reset();
+    DCHECK_EQ(data->buffer_policy, ScriptCompiler::CachedData::BufferOwned);
+    entry->refreshed = true;
+    entry->cache.reset(data);
+  }
+  pending_entries_.clear();
+}
 
-    Debug("success\n");
+class CompileCacheHandler::WriteTask final : public v8::Task {
+ public:
+  WriteTask(CompileCacheHandler* handler,
+            std::vector<std::unique_ptr<CompileCacheEntry>>&& entries)
+      : handler_(handler), entries_(std::move(entries)) {}
 
-    // Rename the temporary file to the actual cache file.
-    uv_fs_t rename_req;
-    auto cleanup_rename =
-        OnScopeLeave([&rename_req]() { uv_fs_req_cleanup(&rename_req); });
-    std::string cache_filename_final = entry->cache_filename;
-    Debug("[compile cache] Renaming %s to %s...",
-          mkstemp_req.path,
-          cache_filename_final);
-    err = uv_fs_rename(nullptr,
-                       &rename_req,
-                       mkstemp_req.path,
-                       cache_filename_final.c_str(),
-                       nullptr);
-    if (err < 0) {
-      Debug("failed: %s\n", uv_strerror(err));
+  void Run() override {
+    for (const auto& entry : entries_) {
+      handler_->WriteCacheFile(entry.get());
+    }
+    Mutex::ScopedLock lock(handler_->write_mutex_);
+    handler_->running_write_tasks_--;
+    handler_->write_cond_.Broadcast(lock);
+  }
+
+ private:
+  CompileCacheHandler* handler_;
+  std::vector<std::unique_ptr<CompileCacheEntry>> entries_;
+};
+
+// Creates the caches of the code that has run since the last call, and writes
+// them with copies of the entries on a worker thread.
+void CompileCacheHandler::PersistInBackground() {
+  ProducePendingCaches();
+  // The pack file is only written by Persist().
+  if (use_pack_) {
+    return;
+  }
+
+  std::vector<std::unique_ptr<CompileCacheEntry>> entries;
+  for (auto& pair : compiler_cache_store_) {
+    auto* entry = pair.second.get();
+    if (!entry->refreshed || entry->persisted || entry->cache == nullptr) {
       continue;
     }
-    Debug("success\n");
+    auto copy = std::make_unique<CompileCacheEntry>();
+    copy->cache.reset(entry->CopyCache());
+    copy->cache_key = entry->cache_key;
+    copy->code_hash = entry->code_hash;
+    copy->code_size = entry->code_size;
+    copy->cache_filename = entry->cache_filename;
+    copy->source_filename = entry->source_filename;
+    copy->type = entry->type;
+    entries.push_back(std::move(copy));
+    // Failures to write are only reported in the debug output, like in
+    // Persist().
     entry->persisted = true;
   }
+  if (entries.empty()) {
+    return;
+  }
+
+  Debug("[compile cache] writing %zu caches on a worker thread\n",
+        entries.size());
+  {
+    Mutex::ScopedLock lock(write_mutex_);
+    running_write_tasks_++;
+  }
+  env_->isolate_data()->platform()->CallOnWorkerThread(
+      std::make_unique<WriteTask>(this, std::move(entries)));
+}
+
+void CompileCacheHandler::WaitForBackgroundWrites() {
+  Mutex::ScopedLock lock(write_mutex_);
+  while (running_write_tasks_ > 0) {
+    write_cond_.Wait(lock);
+  }
+}
+
+/**
+ * Persist the compile cache accumulated in memory to disk.
+ *
+ * To avoid race conditions, the cache file includes hashes of the original
+ * source code and the cache content. It's first written to a temporary file
+ * before being renamed to the target name.
+ *
+ * Layout of a cache file:
+ *   [uint32_t] magic number
+ *   [uint32_t] code size
+ *   [uint32_t] code hash
+ *   [uint32_t] cache size
+ *   [uint32_t] cache hash
+ *   .... compile cache content ....
+ */
+void CompileCacheHandler::Persist() {
+  DCHECK(!compile_cache_dir_.empty());
+
+  // TODO(joyeecheung): do this using a separate event loop to utilize the
+  // libuv thread pool and do the file system operations concurrently.
+  // With NODE_COMPILE_CACHE_ASYNC, the caches of the code that has run are
+  // usually written on a worker thread by now, and this only waits for those
+  // writes to finish before writing what is left.
+  ProducePendingCaches();
+  WaitForBackgroundWrites();
+
+  if (use_pack_) {
+    return PersistPack();
+  }
+
+  for (auto& pair : compiler_cache_store_) {
+    auto* entry = pair.second.get();
+    if (NeedsPersisting(entry) && WriteCacheFile(entry)) {
+      entry->persisted = true;
+    }
+  }
 
   // Clear the map at the end in one go instead of during the iteration to
   // avoid rehashing costs.
@@ -491,10 +1275,18 @@ void CompileCacheHandler::Persist() {
 }
 
 CompileCacheHandler::CompileCacheHandler(Environment* env)
-    : isolate_(env->isolate()),
+    : env_(env),
+      isolate_(env->isolate()),
       is_debug_(
           env->enabled_debug_list()->enabled(DebugCategory::COMPILE_CACHE)) {}
 
+CompileCacheHandler::~CompileCacheHandler() {
+  WaitForBackgroundWrites();
+  if (pack_data_ != nullptr) {
+    UnmapOrFree(pack_data_, pack_size_, pack_mapped_);
+  }
+}
+
 // Directory structure:
 // - Compile cache directory (from NODE_COMPILE_CACHE)
 //   - $NODE_VERSION-$ARCH-$CACHE_DATA_VERSION_TAG-$UID
@@ -549,6 +1341,20 @@ CompileCacheEnableResult CompileCacheHandler::Enable(Environment* env,
   result.cache_directory = absolute_cache_dir_base;
   compile_cache_dir_ = cache_dir_with_tag;
   result.status = CompileCacheEnableStatus::ENABLED;
+
+  std::string async_env;
+  if (credentials::SafeGetenv("NODE_COMPILE_CACHE_ASYNC", &async_env, env) &&
+      !async_env.empty()) {
+    async_ = true;
+  }
+
+  std::string pack_env;
+  if (credentials::SafeGetenv("NODE_COMPILE_CACHE_PACK", &pack_env, env) &&
+      !pack_env.empty()) {
+    use_pack_ = true;
+    pack_filename_ = cache_dir_with_tag + kPathSeparator + "pack";
+    LoadPack();
+  }
   return result;
 }
 
@@ -8,6 +8,8 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
+#include "node_mutex.h"
 #include "v8.h"
 
 namespace node {
@@ -18,7 +20,11 @@ class Environment;
   V(kESM, 1)                                                                   \
   V(kStrippedTypeScript, 2)                                                    \
   V(kTransformedTypeScript, 3)                                                 \
-  V(kTransformedTypeScriptWithSourceMaps, 4)
+  V(kTransformedTypeScriptWithSourceMaps, 4)                                   \
+  V(kCommonJSExports, 5)                                                       \
+  V(kWasm, 6)                                                                  \
+  V(kVMScript, 7)                                                              \
+  V(kVMFunction, 8)
 
 enum class CachedCodeType : uint8_t {
 #define V(type, value) type = value,
@@ -37,6 +43,11 @@ struct CompileCacheEntry {
   CachedCodeType type;
   bool refreshed = false;
   bool persisted = false;
+  // With NODE_COMPILE_CACHE_ASYNC, the function or module that the cache is
+  // created from after it has run.
+  v8::Global<v8::Function> pending_function;
+  v8::Global<v8::Module> pending_module;
+  v8::Global<v8::UnboundScript> pending_script;
 
   // Copy the cache into a new store for V8 to consume. Caller takes
   // ownership.
@@ -44,6 +55,40 @@ struct CompileCacheEntry {
   const char* type_name() const;
 };
 
+// A compiled WebAssembly module in the cache directory, looked up by the URL
+// of the response that it is streamed from. The module is only used if the
+// wire bytes that are streamed match the ones it was compiled from, which V8
+// is told when the streaming finishes.
+struct WasmCacheEntry {
+  WasmCacheEntry() = default;
+  ~WasmCacheEntry();
+  WasmCacheEntry(const WasmCacheEntry&) = delete;
+  WasmCacheEntry& operator=(const WasmCacheEntry&) = delete;
+
+  std::string cache_filename;
+  std::string url;
+  // The size and hash of the wire bytes that the module was compiled from.
+  uint32_t wire_size = 0;
+  uint32_t wire_hash = 0;
+  // The content of the cache file, mapped into memory where possible. The
+  // serialized module follows the headers. Null if there is no usable file.
+  uint8_t* file_data = nullptr;
+  size_t file_size = 0;
+  bool file_mapped = false;
+
+  // The size and hash of the wire bytes streamed so far.
+  uint32_t streamed_size = 0;
+  uint32_t streamed_hash = 0;
+
+  const uint8_t* module_data() const;
+  size_t module_size() const;
+  void UpdateStreamedHash(const uint8_t* bytes, size_t size);
+  // Whether the module can be used for the wire bytes that were streamed.
+  bool MatchesStreamedBytes() const;
+  // Unmaps or frees the content of the cache file once V8 is done with it.
+  void ReleaseData();
+};
+
 #define COMPILE_CACHE_STATUS(V)                                                \
   V(FAILED)          /* Failed to enable the cache */                          \
   V(ENABLED)         /* Was not enabled before, and now enabled. */            \
@@ -65,6 +110,10 @@ struct CompileCacheEnableResult {
 class CompileCacheHandler {
  public:
   explicit CompileCacheHandler(Environment* env);
+  ~CompileCacheHandler();
+  CompileCacheHandler(const CompileCacheHandler&) = delete;
+  CompileCacheHandler& operator=(const CompileCacheHandler&) = delete;
+
   CompileCacheEnableResult Enable(Environment* env, const std::string& dir);
 
   void Persist();
@@ -78,17 +127,54 @@ class CompileCacheHandler {
   void MaybeSave(CompileCacheEntry* entry,
                  v8::Local<v8::Module> mod,
                  bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::UnboundScript> script,
+                 bool rejected);
   void MaybeSave(CompileCacheEntry* entry, std::string_view transpiled);
+  // Frees the cache data of the entries that have been read from disk and do
+  // not need to be written back, e.g. under memory pressure.
+  void ReleaseConsumedCaches();
+  // Reads the compiled WebAssembly module that was streamed from |url| in a
+  // previous run, if any.
+  std::unique_ptr<WasmCacheEntry> GetWasmModule(std::string_view url);
+  // Writes |module| to the cache file of |entry|. This is called by V8 once
+  // enough functions are tiered up, possibly on another thread and after the
+  // handler is gone, so it only uses what is passed in.
+  static void SaveWasmModule(const std::string& cache_filename,
+                             v8::CompiledWasmModule module);
   std::string_view cache_dir() { return compile_cache_dir_; }
 
  private:
   void ReadCacheFile(CompileCacheEntry* entry);
+  void ReadWasmCacheFile(WasmCacheEntry* entry);
+
+  // A record of the pack file, see CompileCacheHandler::PersistPack().
+  struct PackRecord {
+    size_t offset;
+    uint32_t code_size;
+    uint32_t code_hash;
+    uint32_t cache_size;
+    uint32_t cache_hash;
+    bool verified = false;
+
+    size_t size() const;
+  };
+  void LoadPack();
+  void ReadPackRecord(CompileCacheEntry* entry);
+  void PersistPack();
+  bool NeedsPersisting(const CompileCacheEntry* entry) const;
 
   template <typename T>
   void MaybeSaveImpl(CompileCacheEntry* entry,
                      v8::Local<T> func_or_mod,
                      bool rejected);
 
+  bool WriteCacheFile(const CompileCacheEntry* entry) const;
+  void ProducePendingCaches();
+  void PersistInBackground();
+  void WaitForBackgroundWrites();
+  class WriteTask;
+
   template <typename... Args>
   inline void Debug(const char* format, Args&&... args) const;
 
@@ -99,12 +185,40 @@ class CompileCacheHandler {
   static constexpr size_t kCacheHashOffset = 4;
   static constexpr size_t kHeaderCount = 5;
 
+  Environment* env_ = nullptr;
   v8::Isolate* isolate_ = nullptr;
   bool is_debug_ = false;
 
   std::string compile_cache_dir_;
   std::unordered_map<uint32_t, std::unique_ptr<CompileCacheEntry>>
       compiler_cache_store_;
+
+  // Set by NODE_COMPILE_CACHE_PACK, in which case the caches are kept in a
+  // single file of the cache directory instead of one file per module.
+  bool use_pack_ = false;
+  std::string pack_filename_;
+  // The content of the pack file as it was when the cache was enabled. It is
+  // mapped into memory where possible, and the entries read from it point
+  // into it.
+  uint8_t* pack_data_ = nullptr;
+  size_t pack_size_ = 0;
+  bool pack_mapped_ = false;
+  std::unordered_map<uint32_t, PackRecord> pack_index_;
+  // The size of the records in the pack file that were superseded by later
+  // ones.
+  size_t pack_dead_bytes_ = 0;
+  // Once records that are not in pack_data_ were written, the pack file can
+  // only be appended to.
+  bool pack_written_ = false;
+
+  // Set by NODE_COMPILE_CACHE_ASYNC, in which case the caches are created
+  // after the code has run, and written on a worker thread.
+  bool async_ = false;
+  std::vector<CompileCacheEntry*> pending_entries_;
+  bool pending_scheduled_ = false;
+  Mutex write_mutex_;
+  ConditionVariable write_cond_;
+  size_t running_write_tasks_ = 0;
 };
 }  // namespace node
 
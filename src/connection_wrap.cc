@@ -2,12 +2,16 @@
 
 #include "connect_wrap.h"
 #include "env-inl.h"
+#include "histogram-inl.h"
+#include "node_sockaddr-inl.h"
 #include "pipe_wrap.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "tcp_wrap.h"
 #include "util-inl.h"
 
+#include <type_traits>
+
 namespace node {
 
 using v8::Boolean;
@@ -63,6 +67,18 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
     if (uv_accept(handle, client))
       return;
 
+    if constexpr (std::is_same_v<UVType, uv_tcp_t>) {
+      if (wrap_data->rate_limiter_ &&
+          !wrap_data->rate_limiter_->Consume(
+              SocketAddress::FromPeerName(wrap->handle_))) {
+        wrap->Close();
+        return;
+      }
+    }
+
+    if (wrap_data->accept_histogram_)
+      wrap_data->accept_histogram_->RecordDelta();
+
     // Successful accept. Call the onconnection callback in JavaScript land.
     client_handle = client_obj;
   } else {
@@ -3,8 +3,12 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "histogram.h"
+#include "node_sockaddr.h"
 #include "stream_wrap.h"
 
+#include <memory>
+
 namespace node {
 
 class Environment;
@@ -21,6 +25,12 @@ class ConnectionWrap : public LibuvStreamWrap {
                  ProviderType provider);
 
   UVType handle_;
+  // Time between consecutive accepted connections, in nanoseconds. Only
+  // recorded once JS asked for it through createAcceptHistogram().
+  std::shared_ptr<Histogram> accept_histogram_;
+  // Remote addresses that are out of tokens have their connections closed
+  // before JS is notified. Only used by TCP servers.
+  std::unique_ptr<SocketAddressRateLimiter> rate_limiter_;
 };
 
 }  // namespace node
@@ -28,6 +28,7 @@
 
 #include <climits>
 #include <cstring>
+#include <vector>
 
 namespace node {
 
@@ -35,6 +36,82 @@ using ncrypto::BIOPointer;
 
 namespace crypto {
 
+namespace {
+
+// Freed NodeBIO buffer memory of the common sizes, kept for reuse on the
+// thread that freed it. These are the initial buffer lengths used by TLSWrap
+// for client and server BIOs and the length of throughput buffers.
+class ChunkPool {
+ public:
+  ChunkPool() = default;
+  ChunkPool(const ChunkPool&) = delete;
+  ChunkPool& operator=(const ChunkPool&) = delete;
+
+  ~ChunkPool() {
+    for (std::vector<char*>& chunks : free_) {
+      for (char* chunk : chunks)
+        delete[] chunk;
+    }
+    destroyed = true;
+  }
+
+  // Buffers that are freed during thread teardown after the pool itself
+  // must bypass it.
+  static thread_local bool destroyed;
+
+  char* Allocate(size_t len) {
+    std::vector<char*>* chunks = ChunksFor(len);
+    if (chunks == nullptr || chunks->empty())
+      return new char[len];
+    char* chunk = chunks->back();
+    chunks->pop_back();
+    return chunk;
+  }
+
+  void Free(char* data, size_t len) {
+    std::vector<char*>* chunks = ChunksFor(len);
+    if (chunks == nullptr || chunks->size() >= kMaxChunksPerSize) {
+      delete[] data;
+      return;
+    }
+    chunks->push_back(data);
+  }
+
+ private:
+  // Bounds the memory held per thread to 64 * (1 + 4 + 16) KiB.
+  static constexpr size_t kMaxChunksPerSize = 64;
+  static constexpr size_t kSizes[] = {1024, 4096, 16384};
+
+  std::vector<char*>* ChunksFor(size_t len) {
+    for (size_t i = 0; i < arraysize(kSizes); i++) {
+      if (kSizes[i] == len)
+        return &free_[i];
+    }
+    return nullptr;
+  }
+
+  std::vector<char*> free_[arraysize(kSizes)];
+};
+
+thread_local bool ChunkPool::destroyed = false;
+thread_local ChunkPool chunk_pool;
+
+}  // anonymous namespace
+
+char* NodeBIO::AllocateChunk(size_t len) {
+  if (ChunkPool::destroyed) [[unlikely]]
+    return new char[len];
+  return chunk_pool.Allocate(len);
+}
+
+void NodeBIO::FreeChunk(char* data, size_t len) {
+  if (ChunkPool::destroyed) [[unlikely]] {
+    delete[] data;
+    return;
+  }
+  chunk_pool.Free(data, len);
+}
+
 BIOPointer NodeBIO::New(Environment* env) {
   auto bio = BIOPointer::New(GetMethod());
   if (bio && env != nullptr)
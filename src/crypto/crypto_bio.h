@@ -144,6 +144,12 @@ class NodeBIO : public MemoryRetainer {
 
   static const BIO_METHOD* GetMethod();
 
+  // Buffer memory is taken from and returned to a per-thread freelist for
+  // the sizes that most buffers have, so that short-lived connections do not
+  // cost a malloc()/free() pair per buffer.
+  static char* AllocateChunk(size_t len);
+  static void FreeChunk(char* data, size_t len);
+
   // Enough to handle the most of the client hellos
   static const size_t kInitialBufferLength = 1024;
   static const size_t kThroughputBufferLength = 16384;
@@ -155,14 +161,14 @@ class NodeBIO : public MemoryRetainer {
                                            write_pos_(0),
                                            len_(len),
                                            next_(nullptr) {
-      data_ = new char[len];
+      data_ = AllocateChunk(len);
       if (env_ != nullptr) {
         env_->external_memory_accounter()->Increase(env_->isolate(), len);
       }
     }
 
     ~Buffer() {
-      delete[] data_;
+      FreeChunk(data_, len_);
       if (env_ != nullptr) {
         env_->external_memory_accounter()->Decrease(env_->isolate(), len_);
       }
@@ -233,6 +233,8 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
 
   SetProtoMethod(isolate, t, "update", Update);
   SetProtoMethod(isolate, t, "final", Final);
+  SetProtoMethod(isolate, t, "updateInto", UpdateInto);
+  SetProtoMethod(isolate, t, "finalInto", FinalInto);
   SetProtoMethod(isolate, t, "setAutoPadding", SetAutoPadding);
   SetProtoMethodNoSideEffect(isolate, t, "getAuthTag", GetAuthTag);
   SetProtoMethod(isolate, t, "setAuthTag", SetAuthTag);
@@ -265,6 +267,9 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
 
   SetMethodNoSideEffect(context, target, "getCipherInfo", GetCipherInfo);
 
+  SetMethod(context, target, "aeadSeal", AeadOneShot<true>);
+  SetMethod(context, target, "aeadOpen", AeadOneShot<false>);
+
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherEncrypt);
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherDecrypt);
 }
@@ -275,6 +280,8 @@ void CipherBase::RegisterExternalReferences(
 
   registry->Register(Update);
   registry->Register(Final);
+  registry->Register(UpdateInto);
+  registry->Register(FinalInto);
   registry->Register(SetAutoPadding);
   registry->Register(GetAuthTag);
   registry->Register(SetAuthTag);
@@ -293,6 +300,8 @@ void CipherBase::RegisterExternalReferences(
                                              ncrypto::Cipher::recover>);
 
   registry->Register(GetCipherInfo);
+  registry->Register(AeadOneShot<true>);
+  registry->Register(AeadOneShot<false>);
 }
 
 void CipherBase::New(const FunctionCallbackInfo<Value>& args) {
@@ -642,10 +651,30 @@ void CipherBase::SetAAD(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(cipher->SetAAD(buf, plaintext_len));
 }
 
-CipherBase::UpdateResult CipherBase::Update(
-    const char* data,
-    size_t len,
-    std::unique_ptr<BackingStore>* out) {
+bool CipherBase::GetUpdateOutputLength(const char* data,
+                                       size_t len,
+                                       int* out_len) {
+  const int block_size = ctx_.getBlockSize();
+  CHECK_GT(block_size, 0);
+  if (len + block_size > INT_MAX) return false;
+  // Stream ciphers, including the AEAD modes, never produce more output than
+  // they are given input, which is what allows updating in place.
+  *out_len = block_size == 1 ? len : len + block_size;
+
+  if (kind_ == kCipher && ctx_.isWrapMode()) {
+    ncrypto::Buffer<const unsigned char> buffer = {
+        .data = reinterpret_cast<const unsigned char*>(data),
+        .len = len,
+    };
+    return ctx_.update(buffer, nullptr, out_len);
+  }
+  return true;
+}
+
+CipherBase::UpdateResult CipherBase::Update(const char* data,
+                                            size_t len,
+                                            unsigned char* out,
+                                            int* out_len) {
   if (!ctx_ || len > INT_MAX) return kErrorState;
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
@@ -653,32 +682,44 @@ CipherBase::UpdateResult CipherBase::Update(
     return kErrorMessageSize;
   }
 
-  const int block_size = ctx_.getBlockSize();
-  CHECK_GT(block_size, 0);
-  if (len + block_size > INT_MAX) return kErrorState;
-  int buf_len = len + block_size;
+  int required;
+  if (!GetUpdateOutputLength(data, len, &required)) return kErrorState;
+  if (*out_len < required) return kErrorOutputSize;
 
   ncrypto::Buffer<const unsigned char> buffer = {
       .data = reinterpret_cast<const unsigned char*>(data),
       .len = len,
   };
-  if (kind_ == kCipher && ctx_.isWrapMode() &&
-      !ctx_.update(buffer, nullptr, &buf_len)) {
-    return kErrorState;
+  bool r = ctx_.update(buffer, out, out_len);
+  CHECK_LE(*out_len, required);
+
+  // When in CCM mode, EVP_CipherUpdate will fail if the authentication tag is
+  // invalid. In that case, remember the error and throw in final().
+  if (!r && kind_ == kDecipher && ctx_.isCcmMode()) {
+    pending_auth_failed_ = true;
+    *out_len = 0;
+    return kSuccess;
   }
+  return r == 1 ? kSuccess : kErrorState;
+}
+
+CipherBase::UpdateResult CipherBase::Update(
+    const char* data,
+    size_t len,
+    std::unique_ptr<BackingStore>* out) {
+  if (!ctx_ || len > INT_MAX) return kErrorState;
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  int buf_len;
+  if (!GetUpdateOutputLength(data, len, &buf_len)) return kErrorState;
 
   *out = ArrayBuffer::NewBackingStore(
       env()->isolate(),
       buf_len,
       BackingStoreInitializationMode::kUninitialized);
 
-  buffer = {
-      .data = reinterpret_cast<const unsigned char*>(data),
-      .len = len,
-  };
-
-  bool r = ctx_.update(
-      buffer, static_cast<unsigned char*>((*out)->Data()), &buf_len);
+  UpdateResult r =
+      Update(data, len, static_cast<unsigned char*>((*out)->Data()), &buf_len);
 
   CHECK_LE(static_cast<size_t>(buf_len), (*out)->ByteLength());
   if (buf_len == 0) {
@@ -692,13 +733,7 @@ CipherBase::UpdateResult CipherBase::Update(
     memcpy((*out)->Data(), old_out->Data(), buf_len);
   }
 
-  // When in CCM mode, EVP_CipherUpdate will fail if the authentication tag is
-  // invalid. In that case, remember the error and throw in final().
-  if (!r && kind_ == kDecipher && ctx_.isCcmMode()) {
-    pending_auth_failed_ = true;
-    return kSuccess;
-  }
-  return r == 1 ? kSuccess : kErrorState;
+  return r;
 }
 
 void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
@@ -746,14 +781,9 @@ void CipherBase::SetAutoPadding(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(b);  // Possibly report invalid state failure
 }
 
-bool CipherBase::Final(std::unique_ptr<BackingStore>* out) {
+bool CipherBase::Final(unsigned char* out, int* out_len) {
   if (!ctx_) return false;
 
-  *out = ArrayBuffer::NewBackingStore(
-      env()->isolate(),
-      static_cast<size_t>(ctx_.getBlockSize()),
-      BackingStoreInitializationMode::kUninitialized);
-
 #if (OPENSSL_VERSION_NUMBER < 0x30000000L)
   // OpenSSL v1.x doesn't verify the presence of the auth tag so do
   // it ourselves, see https://github.com/nodejs/node/issues/45874.
@@ -768,23 +798,11 @@ bool CipherBase::Final(std::unique_ptr<BackingStore>* out) {
   bool ok;
   if (kind_ == kDecipher && ctx_.isCcmMode()) {
     ok = !pending_auth_failed_;
-    *out = ArrayBuffer::NewBackingStore(env()->isolate(), 0);
+    *out_len = 0;
   } else {
-    int out_len = (*out)->ByteLength();
-    ok = ctx_.update(
-        {}, static_cast<unsigned char*>((*out)->Data()), &out_len, true);
-
-    CHECK_LE(static_cast<size_t>(out_len), (*out)->ByteLength());
-    if (out_len == 0) {
-      *out = ArrayBuffer::NewBackingStore(env()->isolate(), 0);
-    } else if (static_cast<size_t>(out_len) != (*out)->ByteLength()) {
-      std::unique_ptr<BackingStore> old_out = std::move(*out);
-      *out = ArrayBuffer::NewBackingStore(
-          env()->isolate(),
-          out_len,
-          BackingStoreInitializationMode::kUninitialized);
-      memcpy((*out)->Data(), old_out->Data(), out_len);
-    }
+    const int capacity = *out_len;
+    ok = ctx_.update({}, out, out_len, true);
+    CHECK_LE(*out_len, capacity);
 
     if (ok && kind_ == kCipher && IsAuthenticatedMode()) {
       // In GCM mode, the authentication tag length can be specified in advance,
@@ -807,6 +825,32 @@ bool CipherBase::Final(std::unique_ptr<BackingStore>* out) {
   return ok;
 }
 
+bool CipherBase::Final(std::unique_ptr<BackingStore>* out) {
+  if (!ctx_) return false;
+
+  *out = ArrayBuffer::NewBackingStore(
+      env()->isolate(),
+      static_cast<size_t>(ctx_.getBlockSize()),
+      BackingStoreInitializationMode::kUninitialized);
+
+  int out_len = (*out)->ByteLength();
+  bool ok = Final(static_cast<unsigned char*>((*out)->Data()), &out_len);
+
+  CHECK_LE(static_cast<size_t>(out_len), (*out)->ByteLength());
+  if (out_len == 0) {
+    *out = ArrayBuffer::NewBackingStore(env()->isolate(), 0);
+  } else if (static_cast<size_t>(out_len) != (*out)->ByteLength()) {
+    std::unique_ptr<BackingStore> old_out = std::move(*out);
+    *out = ArrayBuffer::NewBackingStore(
+        env()->isolate(),
+        out_len,
+        BackingStoreInitializationMode::kUninitialized);
+    memcpy((*out)->Data(), old_out->Data(), out_len);
+  }
+
+  return ok;
+}
+
 void CipherBase::Final(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   MarkPopErrorOnReturn mark_pop_error_on_return;
@@ -836,6 +880,189 @@ void CipherBase::Final(const FunctionCallbackInfo<Value>& args) {
       Buffer::New(env, ab, 0, ab->ByteLength()).FromMaybe(Local<Value>()));
 }
 
+void CipherBase::UpdateInto(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.This());
+
+  SPREAD_BUFFER_ARG(args[0], data);
+  SPREAD_BUFFER_ARG(args[1], output);
+  CHECK(args[2]->IsUint32());
+  const size_t offset = args[2].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+
+  if (data_length > INT_MAX) [[unlikely]] {
+    return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
+  }
+
+  int out_len = std::min<size_t>(output_length - offset, INT_MAX);
+  UpdateResult r = cipher->Update(data_data,
+                                  data_length,
+                                  reinterpret_cast<unsigned char*>(
+                                      output_data + offset),
+                                  &out_len);
+
+  switch (r) {
+    case kSuccess:
+      return args.GetReturnValue().Set(out_len);
+    case kErrorOutputSize:
+      return THROW_ERR_OUT_OF_RANGE(env, "output is too small");
+    case kErrorState:
+      return ThrowCryptoError(env,
+                              mark_pop_error_on_return.peekError(),
+                              "Trying to add data in unsupported state");
+    default:
+      return;
+  }
+}
+
+void CipherBase::FinalInto(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.This());
+  if (cipher->ctx_ == nullptr) {
+    return THROW_ERR_CRYPTO_INVALID_STATE(env);
+  }
+
+  SPREAD_BUFFER_ARG(args[0], output);
+  CHECK(args[1]->IsUint32());
+  const size_t offset = args[1].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+
+  // Only block ciphers hold back data until final().
+  const int block_size = cipher->ctx_.getBlockSize();
+  const size_t required = block_size == 1 ? 0 : block_size;
+  if (output_length - offset < required) {
+    return THROW_ERR_OUT_OF_RANGE(env, "output is too small");
+  }
+
+  const bool is_auth_mode = cipher->IsAuthenticatedMode();
+  int out_len = required;
+  if (!cipher->Final(reinterpret_cast<unsigned char*>(output_data + offset),
+                     &out_len)) {
+    const char* msg = is_auth_mode
+                          ? "Unsupported state or unable to authenticate data"
+                          : "Unsupported state";
+
+    return ThrowCryptoError(env, mark_pop_error_on_return.peekError(), msg);
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
+namespace {
+// Encrypts or decrypts a complete message with AES-GCM or ChaCha20-Poly1305
+// without creating a CipherBase. The sealed message is the ciphertext followed
+// by the authentication tag. The output may be the same memory as the input.
+template <bool kEncrypt>
+void AeadOneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  CHECK(args[0]->IsString());  // cipher
+  SPREAD_BUFFER_ARG(args[3], input);
+  SPREAD_BUFFER_ARG(args[4], output);
+  CHECK(args[5]->IsUint32());  // offset
+  CHECK(args[7]->IsUint32());  // auth tag length
+
+  const Utf8Value cipher_type(env->isolate(), args[0]);
+  const auto cipher = Cipher::FromName(*cipher_type);
+  if (!cipher || !(cipher.isGcmMode() || cipher.isChaCha20Poly1305())) {
+    return THROW_ERR_CRYPTO_UNKNOWN_CIPHER(env);
+  }
+
+  const ByteSource key = ByteSource::FromSecretKeyBytes(env, args[1]);
+  if (key.size() != static_cast<size_t>(cipher.getKeyLength())) {
+    return THROW_ERR_CRYPTO_INVALID_KEYLEN(env);
+  }
+
+  ArrayBufferOrViewContents<unsigned char> iv(args[2]);
+  if (iv.size() == 0 || !iv.CheckSizeInt32() ||
+      (cipher.isChaCha20Poly1305() && iv.size() > 12)) {
+    return THROW_ERR_CRYPTO_INVALID_IV(env);
+  }
+
+  const unsigned int tag_len = args[7].As<Uint32>()->Value();
+  if (cipher.isGcmMode() ? !Cipher::IsValidGCMTagLength(tag_len)
+                         : tag_len == 0 || tag_len > 16) {
+    return THROW_ERR_CRYPTO_INVALID_AUTH_TAG(
+        env, "Invalid authentication tag length: %u", tag_len);
+  }
+
+  if (!kEncrypt && input_length < tag_len) {
+    return THROW_ERR_CRYPTO_INVALID_AUTH_TAG(env);
+  }
+  const size_t text_len = kEncrypt ? input_length : input_length - tag_len;
+  const size_t out_len = kEncrypt ? text_len + tag_len : text_len;
+  if (text_len > INT_MAX) [[unlikely]] {
+    return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
+  }
+  const size_t offset = args[5].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+  if (output_length - offset < out_len) {
+    return THROW_ERR_OUT_OF_RANGE(env, "output is too small");
+  }
+  unsigned char* out = reinterpret_cast<unsigned char*>(output_data + offset);
+
+  auto ctx = CipherCtxPointer::New();
+  CHECK(ctx);
+  if (!ctx.init(cipher, kEncrypt) || !ctx.setIvLength(iv.size()) ||
+      (kEncrypt && cipher.isChaCha20Poly1305() &&
+       !ctx.setAeadTagLength(tag_len)) ||
+      !ctx.init(Cipher(), kEncrypt, key.data<unsigned char>(), iv.data())) {
+    return ThrowCryptoError(env,
+                            mark_pop_error_on_return.peekError(),
+                            "Failed to initialize cipher");
+  }
+
+  // The tag is set before decrypting so that decrypting in place cannot
+  // overwrite it.
+  if (!kEncrypt && !ctx.setAeadTag({input_data + text_len, tag_len})) {
+    return ThrowCryptoError(env, mark_pop_error_on_return.peekError());
+  }
+
+  int len;
+  if (!args[6]->IsUndefined()) {
+    ArrayBufferOrViewContents<unsigned char> aad(args[6]);
+    if (!aad.CheckSizeInt32()) [[unlikely]] {
+      return THROW_ERR_OUT_OF_RANGE(env, "aad is too big");
+    }
+    if (!ctx.update({aad.data(), aad.size()}, nullptr, &len)) {
+      return ThrowCryptoError(env, mark_pop_error_on_return.peekError());
+    }
+  }
+
+  len = text_len;
+  bool ok = ctx.update(
+      {reinterpret_cast<const unsigned char*>(input_data), text_len},
+      out,
+      &len);
+  if (ok) {
+    CHECK_EQ(static_cast<size_t>(len), text_len);
+    int final_len = 0;
+    ok = ctx.update({}, out + text_len, &final_len, true);
+    CHECK_EQ(final_len, 0);
+  }
+  if (ok && kEncrypt) ok = ctx.getAeadTag(tag_len, out + text_len);
+
+  if (!ok) {
+    // Don't hand out any plaintext that failed to authenticate.
+    if (!kEncrypt) OPENSSL_cleanse(out, text_len);
+    return ThrowCryptoError(
+        env,
+        mark_pop_error_on_return.peekError(),
+        kEncrypt ? "Unsupported state"
+                 : "Unsupported state or unable to authenticate data");
+  }
+
+  args.GetReturnValue().Set(static_cast<double>(out_len));
+}
+}  // namespace
+
 template <PublicKeyCipher::Cipher_t cipher>
 bool PublicKeyCipher::Cipher(
     Environment* env,
@@ -34,6 +34,7 @@ class CipherBase : public BaseObject {
   enum UpdateResult {
     kSuccess,
     kErrorMessageSize,
+    kErrorOutputSize,
     kErrorState
   };
   enum AuthTagState {
@@ -60,7 +61,17 @@ class CipherBase : public BaseObject {
   bool CheckCCMMessageLength(int message_len);
   UpdateResult Update(const char* data, size_t len,
                       std::unique_ptr<v8::BackingStore>* out);
+  // Writes the output into the given buffer, which must be large enough for
+  // it. out_len is the size of the buffer on input and the number of bytes
+  // written on output.
+  UpdateResult Update(const char* data,
+                      size_t len,
+                      unsigned char* out,
+                      int* out_len);
   bool Final(std::unique_ptr<v8::BackingStore>* out);
+  bool Final(unsigned char* out, int* out_len);
+  // The size that the output buffer of Update() must at least have.
+  bool GetUpdateOutputLength(const char* data, size_t len, int* out_len);
   bool SetAutoPadding(bool auto_padding);
 
   bool IsAuthenticatedMode() const;
@@ -70,6 +81,8 @@ class CipherBase : public BaseObject {
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Final(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UpdateInto(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FinalInto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetAutoPadding(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void GetAuthTag(const v8::FunctionCallbackInfo<v8::Value>& args);
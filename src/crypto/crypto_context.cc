@@ -2,6 +2,8 @@
 #include "base_object-inl.h"
 #include "crypto/crypto_bio.h"
 #include "crypto/crypto_common.h"
+#include "crypto/crypto_ocsp_cache.h"
+#include "crypto/crypto_parse_cache.h"
 #include "crypto/crypto_util.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
@@ -188,43 +190,63 @@ int SSL_CTX_use_certificate_chain(SSL_CTX* ctx,
   // that we are interested in
   ERR_clear_error();
 
-  X509Pointer x(
-      PEM_read_bio_X509_AUX(in.get(), nullptr, NoPasswordCallback, nullptr));
-
-  if (!x)
-    return 0;
-
-  unsigned long err = 0;  // NOLINT(runtime/int)
-
-  StackOfX509 extra_certs(sk_X509_new_null());
-  if (!extra_certs)
-    return 0;
+  // Servers with many SecureContexts usually pass the same chain to several
+  // of them, so the parsed chain is looked up by the input first.
+  char* data;
+  long length = BIO_get_mem_data(in.get(), &data);  // NOLINT(runtime/int)
+  std::string key =
+      length > 0 ? ParsedObjectCache::MakeKey(
+                       reinterpret_cast<unsigned char*>(data), length)
+                 : std::string();
+  std::shared_ptr<const CertificateChain> chain;
+  if (key.empty() ||
+      !ParsedObjectCache::CertificateChains().Get(key, &chain)) {
+    X509Pointer x(
+        PEM_read_bio_X509_AUX(in.get(), nullptr, NoPasswordCallback, nullptr));
+
+    if (!x)
+      return 0;
+
+    unsigned long err = 0;  // NOLINT(runtime/int)
+
+    StackOfX509 extra_certs(sk_X509_new_null());
+    if (!extra_certs)
+      return 0;
+
+    while (X509Pointer extra {PEM_read_bio_X509(in.get(),
+                                      nullptr,
+                                      NoPasswordCallback,
+                                      nullptr)}) {
+      if (sk_X509_push(extra_certs.get(), extra.get())) {
+        extra.release();
+        continue;
+      }
 
-  while (X509Pointer extra {PEM_read_bio_X509(in.get(),
-                                    nullptr,
-                                    NoPasswordCallback,
-                                    nullptr)}) {
-    if (sk_X509_push(extra_certs.get(), extra.get())) {
-      extra.release();
-      continue;
+      return 0;
     }
 
-    return 0;
-  }
+    // When the while loop ends, it's usually just EOF.
+    err = ERR_peek_last_error();
+    if (ERR_GET_LIB(err) == ERR_LIB_PEM &&
+        ERR_GET_REASON(err) == PEM_R_NO_START_LINE) {
+      ERR_clear_error();
+    } else {
+      // some real error
+      return 0;
+    }
 
-  // When the while loop ends, it's usually just EOF.
-  err = ERR_peek_last_error();
-  if (ERR_GET_LIB(err) == ERR_LIB_PEM &&
-      ERR_GET_REASON(err) == PEM_R_NO_START_LINE) {
-    ERR_clear_error();
-  } else {
-    // some real error
-    return 0;
+    chain = std::make_shared<const CertificateChain>(
+        CertificateChain{std::move(x), std::move(extra_certs)});
+    if (!key.empty())
+      ParsedObjectCache::CertificateChains().Add(key, chain, length);
   }
 
+  // The certificates are only ever read, so they can be used by several
+  // SSL_CTXs, even on different threads.
+  X509_up_ref(chain->cert.get());
   return SSL_CTX_use_certificate_chain(ctx,
-                                       std::move(x),
-                                       extra_certs.get(),
+                                       X509Pointer(chain->cert.get()),
+                                       chain->extra_certs.get(),
                                        cert,
                                        issuer);
 }
@@ -867,6 +889,84 @@ X509_STORE* NewRootCertStore() {
   return store;
 }
 
+namespace {
+#if OPENSSL_VERSION_MAJOR >= 3
+using LookupName = const X509_NAME;
+#else
+using LookupName = X509_NAME;
+#endif
+
+// Lookup method that resolves certificates and CRLs from the shared root
+// store. Whatever is found is added to the store the lookup belongs to, so
+// only the roots that are actually needed during verification end up being
+// referenced by it. The returned object borrows the reference held by that
+// store, as OpenSSL expects from lookup methods.
+int GetBySubjectFromRootCertStore(X509_LOOKUP* lookup,
+                                  X509_LOOKUP_TYPE type,
+                                  LookupName* name,
+                                  X509_OBJECT* ret) {
+  X509_STORE* store = X509_LOOKUP_get_store(lookup);
+  DeleteFnPtr<X509_STORE_CTX, X509_STORE_CTX_free> root_ctx(
+      X509_STORE_CTX_new());
+  if (!root_ctx ||
+      X509_STORE_CTX_init(
+          root_ctx.get(), GetOrCreateRootCertStore(), nullptr, nullptr) != 1) {
+    return 0;
+  }
+
+  int found = 0;
+  if (type == X509_LU_X509) {
+    STACK_OF(X509)* certs = X509_STORE_CTX_get1_certs(root_ctx.get(), name);
+    if (certs == nullptr) return 0;
+    for (int i = 0; i < sk_X509_num(certs); i++) {
+      X509* cert = sk_X509_value(certs, i);
+      if (X509_STORE_add_cert(store, cert) != 1) continue;
+      if (found == 0 && X509_OBJECT_set1_X509(ret, cert) == 1) {
+        X509_free(cert);
+        found = 1;
+      }
+    }
+    sk_X509_pop_free(certs, X509_free);
+  } else if (type == X509_LU_CRL) {
+    STACK_OF(X509_CRL)* crls = X509_STORE_CTX_get1_crls(root_ctx.get(), name);
+    if (crls == nullptr) return 0;
+    for (int i = 0; i < sk_X509_CRL_num(crls); i++) {
+      X509_CRL* crl = sk_X509_CRL_value(crls, i);
+      if (X509_STORE_add_crl(store, crl) != 1) continue;
+      if (found == 0 && X509_OBJECT_set1_X509_CRL(ret, crl) == 1) {
+        X509_CRL_free(crl);
+        found = 1;
+      }
+    }
+    sk_X509_CRL_pop_free(crls, X509_CRL_free);
+  }
+  return found;
+}
+
+X509_LOOKUP_METHOD* GetRootCertStoreLookupMethod() {
+  static X509_LOOKUP_METHOD* method = []() {
+    X509_LOOKUP_METHOD* method = X509_LOOKUP_meth_new("node root store");
+    CHECK_NOT_NULL(method);
+    CHECK_EQ(1,
+             X509_LOOKUP_meth_set_get_by_subject(
+                 method, GetBySubjectFromRootCertStore));
+    return method;
+  }();
+  return method;
+}
+}  // namespace
+
+// Creates an empty store that falls back to the shared root store for
+// anything it does not contain itself. This replaces a full copy of the
+// root store when a SecureContext that uses the default root certificates
+// needs a store of its own, e.g. to add CAs, CRLs or verification flags.
+X509_STORE* NewRootCertStoreOverlay() {
+  X509_STORE* store = X509_STORE_new();
+  CHECK_NOT_NULL(store);
+  CHECK_NOT_NULL(X509_STORE_add_lookup(store, GetRootCertStoreLookupMethod()));
+  return store;
+}
+
 void CleanupCachedRootCertificates() {
   if (has_cached_bundled_root_certs.load()) {
     for (X509* cert : GetBundledRootCertificates()) {
@@ -992,10 +1092,14 @@ Local<FunctionTemplate> SecureContext::GetConstructorTemplate(
     SetProtoMethod(isolate, tmpl, "close", Close);
     SetProtoMethod(isolate, tmpl, "loadPKCS12", LoadPKCS12);
     SetProtoMethod(isolate, tmpl, "setTicketKeys", SetTicketKeys);
+    SetProtoMethod(isolate, tmpl, "setSessionCache", SetSessionCache);
+    SetProtoMethod(isolate, tmpl, "setOCSPResponse", SetOCSPResponse);
     SetProtoMethod(
         isolate, tmpl, "enableTicketKeyCallback", EnableTicketKeyCallback);
 
     SetProtoMethodNoSideEffect(isolate, tmpl, "getTicketKeys", GetTicketKeys);
+    SetProtoMethodNoSideEffect(
+        isolate, tmpl, "hasOCSPResponse", HasOCSPResponse);
     SetProtoMethodNoSideEffect(
         isolate, tmpl, "getCertificate", GetCertificate<true>);
     SetProtoMethodNoSideEffect(
@@ -1073,6 +1177,9 @@ void SecureContext::RegisterExternalReferences(
   registry->Register(Close);
   registry->Register(LoadPKCS12);
   registry->Register(SetTicketKeys);
+  registry->Register(SetSessionCache);
+  registry->Register(SetOCSPResponse);
+  registry->Register(HasOCSPResponse);
   registry->Register(EnableTicketKeyCallback);
   registry->Register(GetTicketKeys);
   registry->Register(GetCertificate<true>);
@@ -1115,6 +1222,8 @@ inline void SecureContext::Reset() {
   ctx_.reset();
   cert_.reset();
   issuer_.reset();
+  ocsp_keys_.clear();
+  session_cache_.reset();
 }
 
 SecureContext::~SecureContext() {
@@ -1407,9 +1516,52 @@ Maybe<void> SecureContext::AddCert(Environment* env, BIOPointer&& bio) {
     ThrowCryptoError(env, ERR_get_error(), "SSL_CTX_use_certificate_chain");
     return Nothing<void>();
   }
+  AddOCSPKey();
   return JustVoid();
 }
 
+void SecureContext::AddOCSPKey() {
+  X509* cert = SSL_CTX_get0_certificate(ctx_.get());
+  if (cert == nullptr) return;
+  for (const auto& [known, key] : ocsp_keys_) {
+    if (known.get() == cert) return;
+  }
+  std::string key = OCSPCache::GetKey(cert);
+  if (key.empty()) return;
+  X509_up_ref(cert);
+  ocsp_keys_.emplace_back(X509Pointer(cert), std::move(key));
+}
+
+std::string SecureContext::GetOCSPKey(X509* cert) const {
+  for (const auto& [known, key] : ocsp_keys_) {
+    if (known.get() == cert) return key;
+  }
+  return std::string();
+}
+
+void SecureContext::SetOCSPResponse(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.This());
+
+  THROW_AND_RETURN_IF_NOT_BUFFER(env, args[0], "OCSP response");
+  ArrayBufferViewContents<unsigned char> response(args[0]);
+  // The response is for the certificate that was added last, which is the
+  // one that getCertificate() returns.
+  std::string key =
+      sc->GetOCSPKey(SSL_CTX_get0_certificate(sc->ctx_.get()));
+  args.GetReturnValue().Set(
+      OCSPCache::Store(key, response.data(), response.length()));
+}
+
+void SecureContext::HasOCSPResponse(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.This());
+  std::string key =
+      sc->GetOCSPKey(SSL_CTX_get0_certificate(sc->ctx_.get()));
+  args.GetReturnValue().Set(OCSPCache::Find(key) != nullptr);
+}
+
 void SecureContext::SetCert(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -1433,7 +1585,7 @@ X509_STORE* SecureContext::GetCertStoreOwnedByThisSecureContext() {
 
   X509_STORE* cert_store = SSL_CTX_get_cert_store(ctx_.get());
   if (cert_store == GetOrCreateRootCertStore()) {
-    cert_store = NewRootCertStore();
+    cert_store = NewRootCertStoreOverlay();
     SSL_CTX_set_cert_store(ctx_.get(), cert_store);
   }
 
@@ -1808,6 +1960,7 @@ void SecureContext::LoadPKCS12(const FunctionCallbackInfo<Value>& args) {
                                      &sc->issuer_)) {
     goto done;
   }
+  sc->AddOCSPKey();
 
   if (!SSL_CTX_use_PrivateKey(sc->ctx_.get(), pkey.get())) {
     goto done;
@@ -1898,9 +2051,16 @@ void SecureContext::GetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   if (!Buffer::New(wrap->env(), 48).ToLocal(&buff))
     return;
 
-  memcpy(Buffer::Data(buff), wrap->ticket_key_name_, 16);
-  memcpy(Buffer::Data(buff) + 16, wrap->ticket_key_hmac_, 16);
-  memcpy(Buffer::Data(buff) + 32, wrap->ticket_key_aes_, 16);
+  if (wrap->session_cache_) {
+    SharedSessionCache::TicketKeys keys = wrap->session_cache_->GetTicketKeys();
+    memcpy(Buffer::Data(buff), keys.name, 16);
+    memcpy(Buffer::Data(buff) + 16, keys.hmac, 16);
+    memcpy(Buffer::Data(buff) + 32, keys.aes, 16);
+  } else {
+    memcpy(Buffer::Data(buff), wrap->ticket_key_name_, 16);
+    memcpy(Buffer::Data(buff) + 16, wrap->ticket_key_hmac_, 16);
+    memcpy(Buffer::Data(buff) + 32, wrap->ticket_key_aes_, 16);
+  }
 
   args.GetReturnValue().Set(buff);
 }
@@ -1915,13 +2075,36 @@ void SecureContext::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
 
   CHECK_EQ(buf.length(), 48);
 
-  memcpy(wrap->ticket_key_name_, buf.data(), 16);
-  memcpy(wrap->ticket_key_hmac_, buf.data() + 16, 16);
-  memcpy(wrap->ticket_key_aes_, buf.data() + 32, 16);
+  if (wrap->session_cache_) {
+    SharedSessionCache::TicketKeys keys;
+    memcpy(keys.name, buf.data(), 16);
+    memcpy(keys.hmac, buf.data() + 16, 16);
+    memcpy(keys.aes, buf.data() + 32, 16);
+    wrap->session_cache_->SetTicketKeys(keys);
+  } else {
+    memcpy(wrap->ticket_key_name_, buf.data(), 16);
+    memcpy(wrap->ticket_key_hmac_, buf.data() + 16, 16);
+    memcpy(wrap->ticket_key_aes_, buf.data() + 32, 16);
+  }
 
   args.GetReturnValue().Set(true);
 }
 
+void SecureContext::SetSessionCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SecureContext* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+
+  CHECK(SessionCache::HasInstance(env, args[0]));
+  SessionCache* cache;
+  ASSIGN_OR_RETURN_UNWRAP(&cache, args[0]);
+
+  wrap->session_cache_ = cache->cache();
+  SSL_CTX_set_tlsext_ticket_key_cb(wrap->ctx_.get(),
+                                   SessionCacheTicketKeyCallback);
+  SSL_CTX_sess_set_remove_cb(wrap->ctx_.get(), SessionCacheRemoveCallback);
+}
+
 // Currently, EnableTicketKeyCallback and TicketKeyCallback are only present for
 // the regression test in test/parallel/test-https-resume-after-renew.js.
 void SecureContext::EnableTicketKeyCallback(
@@ -2063,6 +2246,30 @@ int SecureContext::TicketCompatibilityCallback(SSL* ssl,
   return 1;
 }
 
+int SecureContext::SessionCacheTicketKeyCallback(SSL* ssl,
+                                                 unsigned char* name,
+                                                 unsigned char* iv,
+                                                 EVP_CIPHER_CTX* ectx,
+                                                 HMAC_CTX* hctx,
+                                                 int enc) {
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  // After an SNI switch, the context the ticket callback belongs to may not
+  // be the one that has the cache.
+  if (!sc->session_cache_)
+    return TicketCompatibilityCallback(ssl, name, iv, ectx, hctx, enc);
+  return sc->session_cache_->TicketKeyCallback(name, iv, ectx, hctx, enc);
+}
+
+void SecureContext::SessionCacheRemoveCallback(SSL_CTX* ctx,
+                                               SSL_SESSION* sess) {
+  SecureContext* sc = static_cast<SecureContext*>(SSL_CTX_get_app_data(ctx));
+  if (!sc->session_cache_) return;
+  unsigned int id_length;
+  const unsigned char* id = SSL_SESSION_get_id(sess, &id_length);
+  sc->session_cache_->Remove(id, id_length);
+}
+
 void SecureContext::CtxGetter(const FunctionCallbackInfo<Value>& info) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, info.This());
@@ -5,11 +5,16 @@
 
 #include "base_object.h"
 #include "crypto/crypto_keys.h"
+#include "crypto/crypto_session_cache.h"
 #include "crypto/crypto_util.h"
 #include "env.h"
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace node {
 namespace crypto {
 // A maxVersion of 0 means "any", but OpenSSL may support TLS versions that
@@ -23,6 +28,8 @@ X509_STORE* NewRootCertStore();
 
 X509_STORE* GetOrCreateRootCertStore();
 
+X509_STORE* NewRootCertStoreOverlay();
+
 ncrypto::BIOPointer LoadBIO(Environment* env, v8::Local<v8::Value> v);
 
 class SecureContext final : public BaseObject {
@@ -56,6 +63,13 @@ class SecureContext final : public BaseObject {
 
   inline const ncrypto::X509Pointer& issuer() const { return issuer_; }
   inline const ncrypto::X509Pointer& cert() const { return cert_; }
+  inline const std::shared_ptr<SharedSessionCache>& session_cache() const {
+    return session_cache_;
+  }
+
+  // Returns the key under which the OCSP response for |cert|, the certificate
+  // that a handshake with this context has selected, is cached. See OCSPCache.
+  std::string GetOCSPKey(X509* cert) const;
 
   v8::Maybe<void> AddCert(Environment* env, ncrypto::BIOPointer&& bio);
   v8::Maybe<void> SetCRL(Environment* env, const ncrypto::BIOPointer& bio);
@@ -119,6 +133,9 @@ class SecureContext final : public BaseObject {
 #endif  // !OPENSSL_NO_ENGINE
   static void GetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSessionCache(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetOCSPResponse(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HasOCSPResponse(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableTicketKeyCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void CtxGetter(const v8::FunctionCallbackInfo<v8::Value>& info);
@@ -140,13 +157,29 @@ class SecureContext final : public BaseObject {
                                          HMAC_CTX* hctx,
                                          int enc);
 
+  static int SessionCacheTicketKeyCallback(SSL* ssl,
+                                           unsigned char* name,
+                                           unsigned char* iv,
+                                           EVP_CIPHER_CTX* ectx,
+                                           HMAC_CTX* hctx,
+                                           int enc);
+  static void SessionCacheRemoveCallback(SSL_CTX* ctx, SSL_SESSION* sess);
+
   SecureContext(Environment* env, v8::Local<v8::Object> wrap);
   void Reset();
 
  private:
+  // Remembers the OCSP key of the certificate that was just set.
+  void AddOCSPKey();
+
   ncrypto::SSLCtxPointer ctx_;
   ncrypto::X509Pointer cert_;
   ncrypto::X509Pointer issuer_;
+  // The certificates of ctx_ with the keys of their OCSP responses, so that
+  // handshakes do not have to encode and hash the certificate. The
+  // certificates are referenced so that they cannot be mistaken for others
+  // that are allocated at the same address once replaced.
+  std::vector<std::pair<ncrypto::X509Pointer, std::string>> ocsp_keys_;
   // Non-owning cache for SSL_CTX_get_cert_store(ctx_.get())
   X509_STORE* own_cert_store_cache_ = nullptr;
 #ifndef OPENSSL_NO_ENGINE
@@ -154,6 +187,10 @@ class SecureContext final : public BaseObject {
   ncrypto::EnginePointer private_key_engine_;
 #endif  // !OPENSSL_NO_ENGINE
 
+  // Shared session cache and ticket keys, if one was attached with
+  // setSessionCache(). They replace the ticket keys below.
+  std::shared_ptr<SharedSessionCache> session_cache_;
+
   unsigned char ticket_key_name_[16];
   unsigned char ticket_key_aes_[16];
   unsigned char ticket_key_hmac_[16];
@@ -21,6 +21,7 @@ using ncrypto::DataPointer;
 using ncrypto::DHPointer;
 using ncrypto::EVPKeyCtxPointer;
 using ncrypto::EVPKeyPointer;
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::BackingStoreInitializationMode;
 using v8::BackingStoreOnFailureMode;
@@ -34,6 +35,7 @@ using v8::Int32;
 using v8::Isolate;
 using v8::JustVoid;
 using v8::Local;
+using v8::LocalVector;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
@@ -550,6 +552,124 @@ bool DHBitsTraits::DeriveBits(Environment* env,
   return true;
 }
 
+// DHBatchJob input arguments:
+//   1. CryptoJobMode
+//   2. An array of public keys
+//   3. The private key
+Maybe<void> DHBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    DHBatchConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[offset]->IsArray());  // public keys
+  CHECK(args[offset + 1]->IsObject());  // private key
+
+  KeyObjectHandle* private_key;
+  ASSIGN_OR_RETURN_UNWRAP(&private_key, args[offset + 1], Nothing<void>());
+  CHECK(private_key->Data().GetKeyType() == kKeyTypePrivate);
+  params->private_key = private_key->Data().addRef();
+
+  Local<Array> public_keys = args[offset].As<Array>();
+  params->public_keys.reserve(public_keys->Length());
+  for (uint32_t i = 0; i < public_keys->Length(); i++) {
+    Local<Value> item;
+    if (!public_keys->Get(env->context(), i).ToLocal(&item))
+      return Nothing<void>();
+    CHECK(item->IsObject());
+    KeyObjectHandle* public_key;
+    ASSIGN_OR_RETURN_UNWRAP(&public_key, item, Nothing<void>());
+    CHECK(public_key->Data().GetKeyType() != kKeyTypeSecret);
+    params->public_keys.push_back(public_key->Data().addRef());
+  }
+
+  return JustVoid();
+}
+
+// The output holds the length of each secret as a uint32_t, followed by the
+// secrets themselves.
+bool DHBatchTraits::DeriveBits(Environment* env,
+                               const DHBatchConfig& params,
+                               ByteSource* out,
+                               CryptoJobMode mode) {
+  auto fail = [&] {
+    if (mode == CryptoJobMode::kCryptoJobSync) {
+      unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
+      if (err) ThrowCryptoError(env, err, "diffieHellman failed");
+    }
+    return false;
+  };
+
+  // The derive context only depends on the private key, only the peer is
+  // replaced for each of the public keys.
+  auto ctx = EVPKeyCtxPointer::New(params.private_key.GetAsymmetricKey());
+  if (!ctx || EVP_PKEY_derive_init(ctx.get()) <= 0) return fail();
+
+  std::vector<DataPointer> secrets(params.public_keys.size());
+  size_t size = secrets.size() * sizeof(uint32_t);
+  for (size_t i = 0; i < secrets.size(); i++) {
+    const EVPKeyPointer& peer = params.public_keys[i].GetAsymmetricKey();
+    size_t secret_size;
+    if (EVP_PKEY_derive_set_peer(ctx.get(), peer.get()) <= 0 ||
+        EVP_PKEY_derive(ctx.get(), nullptr, &secret_size) <= 0 ||
+        secret_size == 0) {
+      return fail();
+    }
+
+    secrets[i] = DataPointer::Alloc(secret_size);
+    if (!secrets[i]) [[unlikely]]
+      return false;
+    uint8_t* data = static_cast<uint8_t*>(secrets[i].get());
+    if (EVP_PKEY_derive(ctx.get(), data, &secret_size) <= 0) return fail();
+
+    // Like DHPointer::stateless(), keep the leading zeros of the secret.
+    if (secret_size < secrets[i].size()) {
+      const size_t padding = secrets[i].size() - secret_size;
+      memmove(data + padding, data, secret_size);
+      memset(data, 0, padding);
+    }
+    size += secrets[i].size();
+  }
+
+  auto buf = DataPointer::Alloc(size);
+  if (!buf) [[unlikely]]
+    return false;
+  char* lengths = static_cast<char*>(buf.get());
+  char* ptr = lengths + secrets.size() * sizeof(uint32_t);
+  for (size_t i = 0; i < secrets.size(); i++) {
+    uint32_t length = static_cast<uint32_t>(secrets[i].size());
+    memcpy(lengths + i * sizeof(length), &length, sizeof(length));
+    memcpy(ptr, secrets[i].get(), length);
+    ptr += length;
+  }
+
+  *out = ByteSource::Allocated(buf.release());
+  return true;
+}
+
+MaybeLocal<Value> DHBatchTraits::EncodeOutput(Environment* env,
+                                              const DHBatchConfig& params,
+                                              ByteSource* out) {
+  Isolate* isolate = env->isolate();
+  size_t count = params.public_keys.size();
+  const char* lengths = out->data<char>();
+  const char* ptr = lengths + count * sizeof(uint32_t);
+
+  LocalVector<Value> results(isolate);
+  results.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    uint32_t length;
+    memcpy(&length, lengths + i * sizeof(length), sizeof(length));
+    auto store = ArrayBuffer::NewBackingStore(
+        isolate, length, BackingStoreInitializationMode::kUninitialized);
+    memcpy(store->Data(), ptr, length);
+    results.push_back(ArrayBuffer::New(isolate, std::move(store)));
+    ptr += length;
+  }
+
+  return Array::New(isolate, results.data(), results.size());
+}
+
 bool GetDhKeyDetail(Environment* env,
                     const KeyObjectData& key,
                     Local<Object> target) {
@@ -602,6 +722,7 @@ void DiffieHellman::Initialize(Environment* env, Local<Object> target) {
   DHKeyPairGenJob::Initialize(env, target);
   DHKeyExportJob::Initialize(env, target);
   DHBitsJob::Initialize(env, target);
+  DHBatchJob::Initialize(env, target);
 }
 
 void DiffieHellman::RegisterExternalReferences(
@@ -623,6 +744,7 @@ void DiffieHellman::RegisterExternalReferences(
   DHKeyPairGenJob::RegisterExternalReferences(registry);
   DHKeyExportJob::RegisterExternalReferences(registry);
   DHBitsJob::RegisterExternalReferences(registry);
+  DHBatchJob::RegisterExternalReferences(registry);
 }
 
 }  // namespace crypto
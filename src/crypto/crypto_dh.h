@@ -11,6 +11,7 @@
 #include "v8.h"
 
 #include <variant>
+#include <vector>
 
 namespace node {
 namespace crypto {
@@ -115,6 +116,41 @@ struct DHBitsTraits final {
 
 using DHBitsJob = DeriveBitsJob<DHBitsTraits>;
 
+// Derives the shared secrets of one private key with several public keys in
+// one job, so that a batch is dispatched to the threadpool once and shares
+// one EVP_PKEY_CTX.
+struct DHBatchConfig final : public MemoryRetainer {
+  KeyObjectData private_key;
+  std::vector<KeyObjectData> public_keys;
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(DHBatchConfig)
+  SET_SELF_SIZE(DHBatchConfig)
+};
+
+struct DHBatchTraits final {
+  using AdditionalParameters = DHBatchConfig;
+  static constexpr const char* JobName = "DHBatchJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_DERIVEBITSREQUEST;
+
+  static v8::Maybe<void> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      DHBatchConfig* params);
+
+  static bool DeriveBits(Environment* env,
+                         const DHBatchConfig& params,
+                         ByteSource* out_,
+                         CryptoJobMode mode);
+
+  static v8::MaybeLocal<v8::Value> EncodeOutput(Environment* env,
+                                                const DHBatchConfig& params,
+                                                ByteSource* out);
+};
+
+using DHBatchJob = DeriveBitsJob<DHBatchTraits>;
+
 bool GetDhKeyDetail(Environment* env,
                     const KeyObjectData& key,
                     v8::Local<v8::Object> target);
@@ -72,6 +72,11 @@ void ECDH::Initialize(Environment* env, Local<Object> target) {
   ECKeyPairGenJob::Initialize(env, target);
   ECKeyExportJob::Initialize(env, target);
 
+  SetMethod(context,
+            target,
+            "setEcKeyPairPoolSize",
+            ECKeyPairGenJob::SetPoolSize);
+
   NODE_DEFINE_CONSTANT(target, OPENSSL_EC_NAMED_CURVE);
   NODE_DEFINE_CONSTANT(target, OPENSSL_EC_EXPLICIT_CURVE);
 }
@@ -90,6 +95,7 @@ void ECDH::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   ECDHBitsJob::RegisterExternalReferences(registry);
   ECKeyPairGenJob::RegisterExternalReferences(registry);
   ECKeyExportJob::RegisterExternalReferences(registry);
+  registry->Register(ECKeyPairGenJob::SetPoolSize);
 }
 
 void ECDH::GetCurves(const FunctionCallbackInfo<Value>& args) {
@@ -554,6 +560,9 @@ Maybe<void> EcKeyGenTraits::AdditionalConfig(
     return Nothing<void>();
   }
 
+  params->pool_id = "ec:" + std::to_string(params->params.curve_nid) + ":" +
+                    std::to_string(params->params.param_encoding);
+
   *offset += 2;
 
   return JustVoid();
@@ -207,6 +207,26 @@ const EVP_MD* GetDigestImplementation(Environment* env,
 #endif
 }
 
+namespace {
+// Synchronous one-shot digests share one EVP_MD_CTX per thread instead of
+// allocating a new one for every input.
+EVP_MD_CTX* GetOneShotMDCtx(Environment* env) {
+  if (!env->one_shot_md_ctx) env->one_shot_md_ctx.reset(EVP_MD_CTX_new());
+  return env->one_shot_md_ctx.get();
+}
+
+// Writes EVP_MD_size(md) bytes to |out|.
+bool DigestInto(EVP_MD_CTX* ctx,
+                const EVP_MD* md,
+                const unsigned char* data,
+                size_t length,
+                unsigned char* out) {
+  return ctx != nullptr && EVP_DigestInit_ex(ctx, md, nullptr) == 1 &&
+         EVP_DigestUpdate(ctx, data, length) == 1 &&
+         EVP_DigestFinal_ex(ctx, out, nullptr) == 1;
+}
+}  // namespace
+
 // crypto.digest(algorithm, algorithmId, algorithmCache,
 //               input, outputEncoding, outputEncodingId)
 void Hash::OneShotDigest(const FunctionCallbackInfo<Value>& args) {
@@ -230,32 +250,33 @@ void Hash::OneShotDigest(const FunctionCallbackInfo<Value>& args) {
 
   enum encoding output_enc = ParseEncoding(isolate, args[4], args[5], HEX);
 
-  DataPointer output = ([&] {
+  unsigned char output[EVP_MAX_MD_SIZE];
+  size_t output_length = EVP_MD_size(md);
+  CHECK_LE(output_length, sizeof(output));
+
+  bool ok = ([&] {
+    EVP_MD_CTX* ctx = GetOneShotMDCtx(env);
     if (args[3]->IsString()) {
       Utf8Value utf8(isolate, args[3]);
-      ncrypto::Buffer<const unsigned char> buf{
-          .data = reinterpret_cast<const unsigned char*>(utf8.out()),
-          .len = utf8.length(),
-      };
-      return ncrypto::hashDigest(buf, md);
+      return DigestInto(ctx,
+                        md,
+                        reinterpret_cast<const unsigned char*>(utf8.out()),
+                        utf8.length(),
+                        output);
     }
 
     ArrayBufferViewContents<unsigned char> input(args[3]);
-    ncrypto::Buffer<const unsigned char> buf{
-        .data = reinterpret_cast<const unsigned char*>(input.data()),
-        .len = input.length(),
-    };
-    return ncrypto::hashDigest(buf, md);
+    return DigestInto(ctx, md, input.data(), input.length(), output);
   })();
 
-  if (!output) [[unlikely]] {
+  if (!ok) [[unlikely]] {
     return ThrowCryptoError(env, ERR_get_error());
   }
 
   Local<Value> ret;
   if (StringBytes::Encode(env->isolate(),
-                          static_cast<const char*>(output.get()),
-                          output.size(),
+                          reinterpret_cast<const char*>(output),
+                          output_length,
                           output_enc)
           .ToLocal(&ret)) {
     args.GetReturnValue().Set(ret);
@@ -279,6 +300,7 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   SetMethodNoSideEffect(context, target, "oneShotDigest", OneShotDigest);
 
   HashJob::Initialize(env, target);
+  HashBatchJob::Initialize(env, target);
 }
 
 void Hash::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -290,6 +312,7 @@ void Hash::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OneShotDigest);
 
   HashJob::RegisterExternalReferences(registry);
+  HashBatchJob::RegisterExternalReferences(registry);
 }
 
 // new Hash(algorithm, algorithmId, xofLen, algorithmCache)
@@ -499,5 +522,110 @@ bool HashTraits::DeriveBits(Environment* env,
   return true;
 }
 
+HashBatchConfig::HashBatchConfig(HashBatchConfig&& other) noexcept
+    : mode(other.mode),
+      in(std::move(other.in)),
+      offsets(std::move(other.offsets)),
+      digest(other.digest),
+      length(other.length) {}
+
+HashBatchConfig& HashBatchConfig::operator=(HashBatchConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~HashBatchConfig();
+  return *new (this) HashBatchConfig(std::move(other));
+}
+
+void HashBatchConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync, then the HashBatchConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("in", in.size());
+  tracker->TrackFieldWithSize("offsets", offsets.size() * sizeof(uint32_t));
+}
+
+MaybeLocal<Value> HashBatchTraits::EncodeOutput(Environment* env,
+                                                const HashBatchConfig& params,
+                                                ByteSource* out) {
+  return out->ToArrayBuffer(env);
+}
+
+// new HashBatchJob(mode, algorithm, data, offsets)
+// |offsets| is a Uint32Array with one more element than there are inputs.
+Maybe<void> HashBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    HashBatchConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  params->mode = mode;
+
+  CHECK(args[offset]->IsString());  // Hash algorithm
+  Utf8Value digest(env->isolate(), args[offset]);
+  params->digest = ncrypto::getDigestByName(*digest);
+  if (params->digest == nullptr) [[unlikely]] {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Invalid digest: %s", *digest);
+    return Nothing<void>();
+  }
+  params->length = EVP_MD_size(params->digest);
+  CHECK_LE(params->length, EVP_MAX_MD_SIZE);
+
+  ArrayBufferOrViewContents<char> data(args[offset + 1]);
+  if (!data.CheckSizeInt32()) [[unlikely]] {
+    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    return Nothing<void>();
+  }
+  params->in = mode == kCryptoJobAsync
+      ? data.ToCopy()
+      : data.ToByteSource();
+
+  CHECK(args[offset + 2]->IsUint32Array());
+  ArrayBufferViewContents<uint32_t> offsets(args[offset + 2]);
+  CHECK_GE(offsets.length(), 1);
+  params->offsets.assign(offsets.data(), offsets.data() + offsets.length());
+  for (size_t i = 1; i < params->offsets.size(); i++)
+    CHECK_LE(params->offsets[i - 1], params->offsets[i]);
+  CHECK_LE(params->offsets.back(), params->in.size());
+
+  return JustVoid();
+}
+
+bool HashBatchTraits::DeriveBits(Environment* env,
+                                 const HashBatchConfig& params,
+                                 ByteSource* out,
+                                 CryptoJobMode mode) {
+  size_t count = params.offsets.size() - 1;
+  if (count == 0 || params.length == 0) return true;
+
+  // Synchronous jobs run on the JS thread and can use its context. Jobs on
+  // the threadpool use one of their own for the whole batch.
+  EVPMDCtxPointer own_ctx;
+  EVP_MD_CTX* ctx;
+  if (mode == kCryptoJobSync) {
+    ctx = GetOneShotMDCtx(env);
+  } else {
+    own_ctx = EVPMDCtxPointer::New();
+    ctx = own_ctx.get();
+  }
+
+  auto buf = DataPointer::Alloc(count * params.length);
+  if (!buf) [[unlikely]]
+    return false;
+
+  const unsigned char* in = params.in.data<unsigned char>();
+  unsigned char* output = static_cast<unsigned char*>(buf.get());
+  for (size_t i = 0; i < count; i++) {
+    if (!DigestInto(ctx,
+                    params.digest,
+                    in + params.offsets[i],
+                    params.offsets[i + 1] - params.offsets[i],
+                    output + i * params.length)) [[unlikely]] {
+      return false;
+    }
+  }
+
+  *out = ByteSource::Allocated(buf.release());
+  return true;
+}
+
 }  // namespace crypto
 }  // namespace node
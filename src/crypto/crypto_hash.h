@@ -10,6 +10,8 @@
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 class Hash final : public BaseObject {
@@ -82,6 +84,51 @@ struct HashTraits final {
 
 using HashJob = DeriveBitsJob<HashTraits>;
 
+// Digests several inputs, given as one buffer and the offsets at which each
+// of them starts, with one EVP_MD_CTX and writes the digests back to back.
+struct HashBatchConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  ByteSource in;
+  // offsets[i] and offsets[i + 1] delimit the i-th input.
+  std::vector<uint32_t> offsets;
+  const EVP_MD* digest;
+  unsigned int length;
+
+  HashBatchConfig() = default;
+
+  explicit HashBatchConfig(HashBatchConfig&& other) noexcept;
+
+  HashBatchConfig& operator=(HashBatchConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(HashBatchConfig)
+  SET_SELF_SIZE(HashBatchConfig)
+};
+
+struct HashBatchTraits final {
+  using AdditionalParameters = HashBatchConfig;
+  static constexpr const char* JobName = "HashBatchJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<void> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      HashBatchConfig* params);
+
+  static bool DeriveBits(Environment* env,
+                         const HashBatchConfig& params,
+                         ByteSource* out,
+                         CryptoJobMode mode);
+
+  static v8::MaybeLocal<v8::Value> EncodeOutput(Environment* env,
+                                                const HashBatchConfig& params,
+                                                ByteSource* out);
+};
+
+using HashBatchJob = DeriveBitsJob<HashBatchTraits>;
+
 }  // namespace crypto
 }  // namespace node
 
@@ -9,11 +9,14 @@
 #include "v8.h"
 
 #include <cmath>
+#include <cstdlib>
 
 namespace node {
 
+using ncrypto::ClearErrorOnReturn;
 using ncrypto::DataPointer;
 using ncrypto::EVPKeyCtxPointer;
+using ncrypto::EVPKeyPointer;
 using v8::FunctionCallbackInfo;
 using v8::Int32;
 using v8::JustVoid;
@@ -25,6 +28,111 @@ using v8::Uint32;
 using v8::Value;
 
 namespace crypto {
+KeyPairPool* KeyPairPool::Get() {
+  // Intentionally leaked, the background thread is stopped at exit.
+  static KeyPairPool* pool = new KeyPairPool();
+  return pool;
+}
+
+size_t KeyPairPool::SetSize(const std::string& id, Setup&& setup, size_t size) {
+  Mutex::ScopedLock lock(mutex_);
+  if (size == 0) {
+    entries_.erase(id);
+    return 0;
+  }
+
+  Entry& entry = entries_[id];
+  entry.setup = std::move(setup);
+  entry.size = size;
+  while (entry.keys.size() > size) entry.keys.pop_back();
+
+  if (!started_) {
+    started_ = true;
+    CHECK_EQ(uv_thread_create(&thread_, Run, this), 0);
+    // The thread must not be generating keys while OpenSSL is cleaned up.
+    std::atexit([] { Get()->Stop(); });
+  }
+  cond_.Signal(lock);
+  return entry.keys.size();
+}
+
+EVPKeyPointer KeyPairPool::Take(const std::string& id) {
+  Mutex::ScopedLock lock(mutex_);
+  auto it = entries_.find(id);
+  if (it == entries_.end() || it->second.keys.empty()) return {};
+  EVPKeyPointer key = std::move(it->second.keys.front());
+  it->second.keys.pop_front();
+  cond_.Signal(lock);
+  return key;
+}
+
+EVPKeyPointer KeyPairPool::Generate(const Setup& setup) {
+  ClearErrorOnReturn clear_error_on_return;
+  EVPKeyCtxPointer ctx = setup();
+  if (!ctx) return {};
+
+  // Lets Stop() interrupt the generation of a large RSA key.
+  EVP_PKEY_CTX_set_app_data(ctx.get(), this);
+  EVP_PKEY_CTX_set_cb(ctx.get(), OnKeyGenProgress);
+
+  EVP_PKEY* pkey = nullptr;
+  if (EVP_PKEY_keygen(ctx.get(), &pkey) != 1) return {};
+  return EVPKeyPointer(pkey);
+}
+
+int KeyPairPool::OnKeyGenProgress(EVP_PKEY_CTX* ctx) {
+  auto* pool = static_cast<KeyPairPool*>(EVP_PKEY_CTX_get_app_data(ctx));
+  return pool->stopping_ ? 0 : 1;
+}
+
+void KeyPairPool::Stop() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    stopping_ = true;
+    cond_.Broadcast(lock);
+  }
+  CHECK_EQ(uv_thread_join(&thread_), 0);
+}
+
+void KeyPairPool::Run(void* data) {
+  KeyPairPool* pool = static_cast<KeyPairPool*>(data);
+  uv_thread_setpriority(uv_thread_self(), UV_THREAD_PRIORITY_LOWEST);
+
+  Mutex::ScopedLock lock(pool->mutex_);
+  while (!pool->stopping_) {
+    std::string id;
+    Setup setup;
+    for (const auto& [entry_id, entry] : pool->entries_) {
+      if (entry.keys.size() < entry.size) {
+        id = entry_id;
+        setup = entry.setup;
+        break;
+      }
+    }
+    if (id.empty()) {
+      pool->cond_.Wait(lock);
+      continue;
+    }
+
+    EVPKeyPointer key;
+    {
+      Mutex::ScopedUnlock unlock(lock);
+      key = pool->Generate(setup);
+    }
+
+    // The entry may have been changed or removed in the meantime.
+    auto it = pool->entries_.find(id);
+    if (it == pool->entries_.end()) continue;
+    if (!key) {
+      // Don't keep trying to generate a key that cannot be generated.
+      if (!pool->stopping_) it->second.size = it->second.keys.size();
+      continue;
+    }
+    if (it->second.keys.size() < it->second.size)
+      it->second.keys.push_back(std::move(key));
+  }
+}
+
 // NidKeyPairGenJob input arguments:
 //   1. CryptoJobMode
 //   2. NID
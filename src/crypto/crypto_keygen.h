@@ -9,8 +9,15 @@
 #include "crypto/crypto_util.h"
 #include "env.h"
 #include "memory_tracker.h"
+#include "node_mutex.h"
 #include "v8.h"
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
 namespace node::crypto {
 namespace Keygen {
 void Initialize(Environment* env, v8::Local<v8::Object> target);
@@ -22,6 +29,54 @@ enum class KeyGenJobStatus {
   FAILED
 };
 
+// Key pairs that are generated ahead of time, so that a key pair job with the
+// same parameters can complete without waiting for the generation of a key,
+// which takes a long time for RSA. The pool is shared by all of the
+// Environments of the process. It is filled by a background thread that runs
+// at the lowest priority, so that it only uses CPU time that nothing else
+// needs.
+class KeyPairPool final {
+ public:
+  // Returns a context that is ready for EVP_PKEY_keygen(). Called on the
+  // background thread.
+  using Setup = std::function<ncrypto::EVPKeyCtxPointer()>;
+
+  static KeyPairPool* Get();
+
+  KeyPairPool(const KeyPairPool&) = delete;
+  KeyPairPool& operator=(const KeyPairPool&) = delete;
+
+  // Sets the number of key pairs with the given id that the pool keeps ready.
+  // Returns the number that it currently holds.
+  size_t SetSize(const std::string& id, Setup&& setup, size_t size);
+
+  // Returns one of the pooled key pairs with the given id, or an empty pointer
+  // if there is none. Can be called from any thread.
+  ncrypto::EVPKeyPointer Take(const std::string& id);
+
+ private:
+  struct Entry final {
+    Setup setup;
+    size_t size = 0;
+    std::deque<ncrypto::EVPKeyPointer> keys;
+  };
+
+  KeyPairPool() = default;
+
+  ncrypto::EVPKeyPointer Generate(const Setup& setup);
+  void Stop();
+
+  static void Run(void* data);
+  static int OnKeyGenProgress(EVP_PKEY_CTX* ctx);
+
+  Mutex mutex_;
+  ConditionVariable cond_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::atomic<bool> stopping_ = false;
+  bool started_ = false;
+  uv_thread_t thread_;
+};
+
 // A Base CryptoJob for generating secret keys or key pairs.
 // The KeyGenTraits is largely responsible for the details of
 // the implementation, while KeyGenJob handles the common
@@ -61,6 +116,22 @@ class KeyGenJob final : public CryptoJob<KeyGenTraits> {
     CryptoJob<KeyGenTraits>::RegisterExternalReferences(New, registry);
   }
 
+  // Sets the number of key pairs with the parameters of the given job that
+  // the KeyPairPool keeps ready, and returns the number that it holds.
+  static void SetPoolSize(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    KeyGenJob<KeyGenTraits>* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args[0]);
+    CHECK(args[1]->IsUint32());
+
+    AdditionalParams* params = job->params();
+    CHECK(!params->pool_id.empty());
+    size_t count =
+        KeyPairPool::Get()->SetSize(params->pool_id,
+                                    KeyGenTraits::PoolSetup(*params),
+                                    args[1].As<v8::Uint32>()->Value());
+    args.GetReturnValue().Set(static_cast<uint32_t>(count));
+  }
+
   KeyGenJob(
       Environment* env,
       v8::Local<v8::Object> object,
@@ -162,18 +233,26 @@ struct KeyPairGenTraits final {
   static KeyGenJobStatus DoKeyGen(
       Environment* env,
       AdditionalParameters* params) {
-    ncrypto::EVPKeyCtxPointer ctx = KeyPairAlgorithmTraits::Setup(params);
-
-    if (!ctx)
-      return KeyGenJobStatus::FAILED;
-
-    // Generate the key
-    EVP_PKEY* pkey = nullptr;
-    if (!EVP_PKEY_keygen(ctx.get(), &pkey))
-      return KeyGenJobStatus::FAILED;
+    // Use a key pair that has been generated ahead of time if there is one.
+    ncrypto::EVPKeyPointer key;
+    if (!params->pool_id.empty())
+      key = KeyPairPool::Get()->Take(params->pool_id);
+
+    if (!key) {
+      ncrypto::EVPKeyCtxPointer ctx = KeyPairAlgorithmTraits::Setup(params);
+
+      if (!ctx)
+        return KeyGenJobStatus::FAILED;
+
+      // Generate the key
+      EVP_PKEY* pkey = nullptr;
+      if (!EVP_PKEY_keygen(ctx.get(), &pkey))
+        return KeyGenJobStatus::FAILED;
+      key = ncrypto::EVPKeyPointer(pkey);
+    }
 
     auto data = KeyObjectData::CreateAsymmetric(KeyType::kKeyTypePrivate,
-                                                ncrypto::EVPKeyPointer(pkey));
+                                                std::move(key));
     if (!data) [[unlikely]]
       return KeyGenJobStatus::FAILED;
     params->key = std::move(data);
@@ -191,6 +270,14 @@ struct KeyPairGenTraits final {
     }
     return v8::Array::New(env->isolate(), keys, arraysize(keys));
   }
+
+  static KeyPairPool::Setup PoolSetup(const AdditionalParameters& params) {
+    return [algorithm_params = params.params]() {
+      AdditionalParameters config;
+      config.params = algorithm_params;
+      return KeyPairAlgorithmTraits::Setup(&config);
+    };
+  }
 };
 
 struct SecretKeyGenConfig final : public MemoryRetainer {
@@ -228,6 +315,9 @@ struct KeyPairGenConfig final : public MemoryRetainer {
   ncrypto::EVPKeyPointer::PrivateKeyEncodingConfig private_key_encoding;
   KeyObjectData key;
   AlgorithmParams params;
+  // Identifies the parameters of the key pair for the KeyPairPool. Empty for
+  // the kinds of key pairs that are not pooled.
+  std::string pool_id;
 
   KeyPairGenConfig() = default;
 
@@ -237,7 +327,8 @@ struct KeyPairGenConfig final : public MemoryRetainer {
             std::forward<ncrypto::EVPKeyPointer::PrivateKeyEncodingConfig>(
                 other.private_key_encoding)),
         key(std::move(other.key)),
-        params(std::move(other.params)) {}
+        params(std::move(other.params)),
+        pool_id(std::move(other.pool_id)) {}
 
   KeyPairGenConfig& operator=(KeyPairGenConfig&& other) noexcept {
     if (&other == this) return *this;
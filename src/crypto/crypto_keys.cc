@@ -3,6 +3,7 @@
 #include "crypto/crypto_dsa.h"
 #include "crypto/crypto_ec.h"
 #include "crypto/crypto_dh.h"
+#include "crypto/crypto_parse_cache.h"
 #include "crypto/crypto_rsa.h"
 #include "crypto/crypto_util.h"
 #include "async_wrap-inl.h"
@@ -251,6 +252,26 @@ KeyObjectData TryParsePrivateKey(
   return {};
 }
 
+// Returns the key under which a public key parsed from |buffer| with |config|
+// is stored in ParsedObjectCache::PublicKeys(). The PEM parser ignores the
+// encoding type, so it is not part of the key for PEM input.
+std::string GetPublicKeyCacheKey(
+    const EVPKeyPointer::PrivateKeyEncodingConfig& config,
+    const ncrypto::Buffer<const unsigned char>& buffer) {
+  uint32_t tag = static_cast<uint32_t>(config.format) << 8;
+  if (config.format != EVPKeyPointer::PKFormatType::PEM)
+    tag |= static_cast<uint32_t>(config.type);
+  return ParsedObjectCache::MakeKey(buffer.data, buffer.len, tag);
+}
+
+KeyObjectData CachePublicKey(const std::string& cache_key,
+                             KeyObjectData&& key,
+                             size_t size) {
+  if (!cache_key.empty())
+    ParsedObjectCache::PublicKeys().Add(cache_key, key.addRef(), size);
+  return std::move(key);
+}
+
 bool ExportJWKInner(Environment* env,
                     const KeyObjectData& key,
                     Local<Value> result,
@@ -426,12 +447,24 @@ KeyObjectData KeyObjectData::GetPublicOrPrivateKeyFromJs(
         .len = data.size(),
     };
 
+    std::string cache_key;
+    KeyObjectData cached;
+
     if (config.format == EVPKeyPointer::PKFormatType::PEM) {
+      cache_key = GetPublicKeyCacheKey(config, buffer);
+      if (!cache_key.empty() &&
+          ParsedObjectCache::PublicKeys().Get(cache_key, &cached)) {
+        return cached;
+      }
+
       // For PEM, we can easily determine whether it is a public or private key
       // by looking for the respective PEM tags.
       auto res = EVPKeyPointer::TryParsePublicKeyPEM(buffer);
       if (res) {
-        return CreateAsymmetric(kKeyTypePublic, std::move(res.value));
+        return CachePublicKey(
+            cache_key,
+            CreateAsymmetric(kKeyTypePublic, std::move(res.value)),
+            buffer.len);
       }
 
       if (res.error.value() == EVPKeyPointer::PKParseError::NOT_RECOGNIZED) {
@@ -461,9 +494,18 @@ KeyObjectData KeyObjectData::GetPublicOrPrivateKeyFromJs(
     };
 
     if (is_public(config, buffer)) {
+      cache_key = GetPublicKeyCacheKey(config, buffer);
+      if (!cache_key.empty() &&
+          ParsedObjectCache::PublicKeys().Get(cache_key, &cached)) {
+        return cached;
+      }
+
       auto res = EVPKeyPointer::TryParsePublicKey(config, buffer);
       if (res) {
-        return CreateAsymmetric(KeyType::kKeyTypePublic, std::move(res.value));
+        return CachePublicKey(
+            cache_key,
+            CreateAsymmetric(KeyType::kKeyTypePublic, std::move(res.value)),
+            buffer.len);
       }
 
       ThrowCryptoError(
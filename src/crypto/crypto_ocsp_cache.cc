@@ -0,0 +1,108 @@
+#include "crypto/crypto_ocsp_cache.h"
+#include "ncrypto.h"
+#include "util-inl.h"
+
+#if !defined(OPENSSL_NO_OCSP) && !defined(OPENSSL_IS_BORINGSSL)
+#include <openssl/ocsp.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+namespace node {
+
+using ncrypto::ClearErrorOnReturn;
+
+namespace crypto {
+
+namespace {
+double Now() {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Returns the earliest nextUpdate of the response, in milliseconds since the
+// epoch, or 0 if there is none.
+double GetExpiry(const unsigned char* data, size_t length) {
+#if !defined(OPENSSL_NO_OCSP) && !defined(OPENSSL_IS_BORINGSSL)
+  ClearErrorOnReturn clear_error_on_return;
+  if (length > LONG_MAX) return 0;
+  const unsigned char* p = data;
+  DeleteFnPtr<OCSP_RESPONSE, OCSP_RESPONSE_free> response(
+      d2i_OCSP_RESPONSE(nullptr, &p, static_cast<long>(length)));  // NOLINT
+  if (!response ||
+      OCSP_response_status(response.get()) !=
+          OCSP_RESPONSE_STATUS_SUCCESSFUL) {
+    return 0;
+  }
+  DeleteFnPtr<OCSP_BASICRESP, OCSP_BASICRESP_free> basic(
+      OCSP_response_get1_basic(response.get()));
+  if (!basic || OCSP_resp_count(basic.get()) <= 0) return 0;
+
+  const double now = Now();
+  double expiry = 0;
+  for (int i = 0; i < OCSP_resp_count(basic.get()); i++) {
+    ASN1_GENERALIZEDTIME* next_update = nullptr;
+    if (OCSP_single_get0_status(OCSP_resp_get0(basic.get(), i),
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                &next_update) < 0 ||
+        next_update == nullptr) {
+      return 0;
+    }
+    int days;
+    int seconds;
+    // Relative to the current time, since OpenSSL has no portable way of
+    // converting an ASN1_TIME to a timestamp.
+    if (!ASN1_TIME_diff(&days, &seconds, nullptr, next_update)) return 0;
+    const double time = now + (days * 86400.0 + seconds) * 1000;
+    expiry = i == 0 ? time : std::min(expiry, time);
+  }
+  return expiry;
+#else
+  return 0;
+#endif
+}
+}  // namespace
+
+// Deliberately leaked, like the caches of ParsedObjectCache.
+ParseCache<std::shared_ptr<const OCSPCache::Staple>>& OCSPCache::Staples() {
+  static auto* cache = new ParseCache<std::shared_ptr<const Staple>>(kMaxSize);
+  return *cache;
+}
+
+std::string OCSPCache::GetKey(X509* cert) {
+  int size = i2d_X509(cert, nullptr);
+  if (size <= 0) return std::string();
+  std::vector<unsigned char> der(size);
+  unsigned char* p = der.data();
+  i2d_X509(cert, &p);
+  return ParsedObjectCache::MakeKey(der.data(), der.size());
+}
+
+std::shared_ptr<const OCSPCache::Staple> OCSPCache::Find(
+    const std::string& key) {
+  std::shared_ptr<const Staple> staple;
+  if (key.empty() || !Staples().Get(key, &staple)) return nullptr;
+  if (staple->expires <= Now()) return nullptr;
+  return staple;
+}
+
+double OCSPCache::Store(const std::string& key,
+                        const unsigned char* data,
+                        size_t length) {
+  if (key.empty()) return 0;
+  const double expires = GetExpiry(data, length);
+  if (expires <= Now()) return 0;
+  Staples().Set(
+      key,
+      std::make_shared<const Staple>(
+          Staple{std::vector<unsigned char>(data, data + length), expires}),
+      length);
+  return expires;
+}
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,54 @@
+#ifndef SRC_CRYPTO_CRYPTO_OCSP_CACHE_H_
+#define SRC_CRYPTO_CRYPTO_OCSP_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "crypto/crypto_parse_cache.h"
+
+#include <openssl/x509.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// The OCSP responses that TLS servers with the ocspCache option staple, by the
+// certificate they are for. The cache is shared by all threads of the process,
+// so that a certificate that is served by many SecureContexts, or by several
+// worker threads, needs a single response. Handshakes look the response up
+// without calling into JavaScript.
+class OCSPCache final {
+ public:
+  static constexpr size_t kMaxSize = 16 * 1024 * 1024;
+
+  struct Staple final {
+    std::vector<unsigned char> response;
+    // The time in milliseconds since the epoch after which the response is
+    // not stapled anymore. This is the earliest nextUpdate in the response.
+    double expires;
+  };
+
+  // Returns the key under which the response for |cert| is cached, or an
+  // empty string if the certificate could not be encoded.
+  static std::string GetKey(X509* cert);
+
+  // Returns nullptr if there is no unexpired response for the key.
+  static std::shared_ptr<const Staple> Find(const std::string& key);
+
+  // Caches a DER encoded OCSP response and returns the time until which it
+  // is stapled. Returns 0 if it cannot be cached, because it could not be
+  // parsed, was not successful, has expired already or has no nextUpdate.
+  static double Store(const std::string& key,
+                      const unsigned char* data,
+                      size_t length);
+
+ private:
+  static ParseCache<std::shared_ptr<const Staple>>& Staples();
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_OCSP_CACHE_H_
@@ -0,0 +1,88 @@
+#include "crypto/crypto_parse_cache.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+
+#include <openssl/evp.h>
+#include <cstring>
+
+namespace node {
+
+using v8::Array;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Value;
+
+namespace crypto {
+
+// The caches are deliberately leaked, so that the objects they hold are not
+// freed after OpenSSL has been cleaned up at exit.
+ParseCache<std::shared_ptr<ManagedX509>>& ParsedObjectCache::Certificates() {
+  static auto* cache =
+      new ParseCache<std::shared_ptr<ManagedX509>>(kMaxCertificatesSize);
+  return *cache;
+}
+
+ParseCache<KeyObjectData>& ParsedObjectCache::PublicKeys() {
+  static auto* cache = new ParseCache<KeyObjectData>(kMaxPublicKeysSize);
+  return *cache;
+}
+
+ParseCache<std::shared_ptr<const CertificateChain>>&
+ParsedObjectCache::CertificateChains() {
+  static auto* cache = new ParseCache<std::shared_ptr<const CertificateChain>>(
+      kMaxCertificateChainsSize);
+  return *cache;
+}
+
+std::string ParsedObjectCache::MakeKey(const unsigned char* data,
+                                       size_t length,
+                                       uint32_t tag) {
+  std::string key(sizeof(tag) + EVP_MAX_MD_SIZE, '\0');
+  memcpy(key.data(), &tag, sizeof(tag));
+  unsigned int digest_length;
+  if (!EVP_Digest(data,
+                  length,
+                  reinterpret_cast<unsigned char*>(key.data() + sizeof(tag)),
+                  &digest_length,
+                  EVP_sha256(),
+                  nullptr)) {
+    return std::string();
+  }
+  key.resize(sizeof(tag) + digest_length);
+  return key;
+}
+
+void ParsedObjectCache::GetParseCacheStats(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  auto certificates = Certificates().GetStats();
+  auto public_keys = PublicKeys().GetStats();
+  Local<Value> values[] = {
+      Number::New(env->isolate(), static_cast<double>(certificates.hits)),
+      Number::New(env->isolate(), static_cast<double>(certificates.misses)),
+      Number::New(env->isolate(), static_cast<double>(certificates.entries)),
+      Number::New(env->isolate(), static_cast<double>(certificates.size)),
+      Number::New(env->isolate(), static_cast<double>(public_keys.hits)),
+      Number::New(env->isolate(), static_cast<double>(public_keys.misses)),
+      Number::New(env->isolate(), static_cast<double>(public_keys.entries)),
+      Number::New(env->isolate(), static_cast<double>(public_keys.size)),
+  };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), values, arraysize(values)));
+}
+
+void ParsedObjectCache::Initialize(Environment* env, Local<Object> target) {
+  SetMethodNoSideEffect(
+      env->context(), target, "getParseCacheStats", GetParseCacheStats);
+}
+
+void ParsedObjectCache::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(GetParseCacheStats);
+}
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,155 @@
+#ifndef SRC_CRYPTO_CRYPTO_PARSE_CACHE_H_
+#define SRC_CRYPTO_CRYPTO_PARSE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "crypto/crypto_keys.h"
+#include "crypto/crypto_x509.h"
+#include "node_mutex.h"
+#include "v8.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace node {
+
+class ExternalReferenceRegistry;
+
+namespace crypto {
+
+// A least recently used cache of parsed objects, keyed by a digest of the
+// encoded input and bounded by the total size of the inputs it holds. It is
+// shared by all threads of the process.
+template <typename T>
+class ParseCache final {
+ public:
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    size_t entries;
+    size_t size;
+  };
+
+  explicit ParseCache(size_t max_size) : max_size_(max_size) {}
+
+  // Counts a hit or a miss. Callers are expected to Add() the parsed object
+  // after a miss.
+  bool Get(const std::string& key, T* out) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      misses_++;
+      return false;
+    }
+    hits_++;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *out = it->second->value;
+    return true;
+  }
+
+  // |size| is the size of the input that |value| was parsed from. It stands
+  // in for the size of the parsed object, which OpenSSL does not expose.
+  void Add(const std::string& key, T value, size_t size) {
+    size += key.size() + sizeof(Entry);
+    if (size > max_size_) return;
+    Mutex::ScopedLock lock(mutex_);
+    if (index_.find(key) != index_.end()) return;
+    Insert(key, std::move(value), size);
+  }
+
+  // Like Add(), but replaces the value that is cached for |key|, if any.
+  void Set(const std::string& key, T value, size_t size) {
+    size += key.size() + sizeof(Entry);
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      size_ -= it->second->size;
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    if (size > max_size_) return;
+    Insert(key, std::move(value), size);
+  }
+
+  Stats GetStats() {
+    Mutex::ScopedLock lock(mutex_);
+    return Stats{hits_, misses_, entries_.size(), size_};
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    T value;
+    size_t size;
+  };
+
+  // Called with mutex_ held.
+  void Insert(const std::string& key, T value, size_t size) {
+    while (size_ + size > max_size_) {
+      size_ -= entries_.back().size;
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+    entries_.push_front(Entry{key, std::move(value), size});
+    index_.emplace(entries_.front().key, entries_.begin());
+    size_ += size;
+  }
+
+  const size_t max_size_;
+  Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, typename std::list<Entry>::iterator> index_;
+  size_t size_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+// A certificate and the CA certificates that follow it in the PEM input of
+// SecureContext::SetCert(). All of the SecureContexts that are given the same
+// input share the parsed certificates, and with them the DER encoding that
+// OpenSSL keeps with each of them and writes to the Certificate message.
+struct CertificateChain final {
+  ncrypto::X509Pointer cert;
+  ncrypto::StackOfX509 extra_certs;
+};
+
+// The process-wide caches behind X509Certificate parsing, public key import
+// and the certificate chains of SecureContexts, so that a certificate or key
+// that is seen again, for example the certificate chain of a returning mTLS
+// peer, is not parsed again. Encrypted and private keys are never cached.
+class ParsedObjectCache final {
+ public:
+  static constexpr size_t kMaxCertificatesSize = 4 * 1024 * 1024;
+  static constexpr size_t kMaxPublicKeysSize = 1024 * 1024;
+  static constexpr size_t kMaxCertificateChainsSize = 16 * 1024 * 1024;
+
+  static ParseCache<std::shared_ptr<ManagedX509>>& Certificates();
+  static ParseCache<KeyObjectData>& PublicKeys();
+  static ParseCache<std::shared_ptr<const CertificateChain>>&
+  CertificateChains();
+
+  // Returns a key that identifies |data| together with the |tag| that
+  // distinguishes the ways in which the same bytes can be parsed, or an
+  // empty string if the data could not be hashed.
+  static std::string MakeKey(const unsigned char* data,
+                             size_t length,
+                             uint32_t tag = 0);
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+ private:
+  static void GetParseCacheStats(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_PARSE_CACHE_H_
@@ -4,10 +4,20 @@
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "ncrypto.h"
+#include "node_debug.h"
+#include "node_external_reference.h"
 #include "threadpoolwork-inl.h"
+#include "v8-fast-api-calls.h"
 #include "v8.h"
 
+#include <atomic>
 #include <compare>
+#include <cstring>
+#include <mutex>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 namespace node {
 
@@ -16,7 +26,10 @@ using ncrypto::ClearErrorOnReturn;
 using ncrypto::DataPointer;
 using v8::ArrayBuffer;
 using v8::Boolean;
+using v8::CFunction;
+using v8::FastApiCallbackOptions;
 using v8::FunctionCallbackInfo;
+using v8::HandleScope;
 using v8::Int32;
 using v8::JustVoid;
 using v8::Local;
@@ -37,7 +50,94 @@ BignumPointer::PrimeCheckCallback getPrimeCheckCallback(Environment* env) {
   return [env](int a, int b) -> bool { return !env->is_stopping(); };
 }
 
+constexpr size_t kEntropyPoolSize = 4096;
+
+// Incremented in the child after fork(), so that the child discards the
+// bytes that it inherited from the parent's pools instead of handing out
+// the same bytes as the parent.
+std::atomic<uint64_t> entropy_pool_generation{0};
+
+// Bytes are handed out from the front, and cleared as they are handed out.
+struct EntropyPool {
+  unsigned char data[kEntropyPoolSize];
+  size_t offset = kEntropyPoolSize;
+  uint64_t generation = 0;
+
+  ~EntropyPool() { OPENSSL_cleanse(data, sizeof(data)); }
+};
+
+thread_local EntropyPool entropy_pool;
+
+void RegisterEntropyPoolForkHandler() {
+#ifndef _WIN32
+  static std::once_flag once;
+  std::call_once(once, [] {
+    pthread_atfork(nullptr, nullptr, [] {
+      entropy_pool_generation.fetch_add(1, std::memory_order_relaxed);
+    });
+  });
+#endif
+}
+
+// randomFillPooled(buffer, offset, size)
+bool RandomFillPooled(Local<Value> buffer_val, uint32_t offset, uint32_t size) {
+  ArrayBufferOrViewContents<unsigned char> buffer(buffer_val);
+  CHECK_GE(offset + size, offset);  // Overflow check.
+  CHECK_LE(offset + size, buffer.size());  // Bounds check.
+  CHECK_LE(size, kMaxPooledRandomBytes);
+  return FillRandomBytes(buffer.data() + offset, size);
+}
+
+void SlowRandomFillPooled(const FunctionCallbackInfo<Value>& args) {
+  CHECK(IsAnyBufferSource(args[0]));
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  args.GetReturnValue().Set(RandomFillPooled(args[0],
+                                             args[1].As<Uint32>()->Value(),
+                                             args[2].As<Uint32>()->Value()));
+}
+
+bool FastRandomFillPooled(Local<Value> receiver,
+                          Local<Value> buffer,
+                          uint32_t offset,
+                          uint32_t size,
+                          // NOLINTNEXTLINE(runtime/references)
+                          FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("crypto.randomFillPooled");
+  HandleScope scope(options.isolate);
+  return RandomFillPooled(buffer, offset, size);
+}
+
+CFunction fast_random_fill_pooled(CFunction::Make(FastRandomFillPooled));
 }  // namespace
+
+bool FillRandomBytes(unsigned char* data, size_t size) {
+  // The pool does not live in the secure heap, so bypass it when the secure
+  // heap is in use.
+  if (size > kMaxPooledRandomBytes || CRYPTO_secure_malloc_initialized())
+    return ncrypto::CSPRNG(data, size);
+
+  EntropyPool& pool = entropy_pool;
+  uint64_t generation =
+      entropy_pool_generation.load(std::memory_order_relaxed);
+  if (pool.generation != generation) {
+    OPENSSL_cleanse(pool.data, sizeof(pool.data));
+    pool.offset = kEntropyPoolSize;
+    pool.generation = generation;
+  }
+
+  if (kEntropyPoolSize - pool.offset < size) {
+    if (!ncrypto::CSPRNG(pool.data, sizeof(pool.data))) [[unlikely]]
+      return false;
+    pool.offset = 0;
+  }
+
+  memcpy(data, pool.data + pool.offset, size);
+  OPENSSL_cleanse(pool.data + pool.offset, size);
+  pool.offset += size;
+  return true;
+}
+
 MaybeLocal<Value> RandomBytesTraits::EncodeOutput(
     Environment* env, const RandomBytesConfig& params, ByteSource* unused) {
   return Undefined(env->isolate());
@@ -69,7 +169,7 @@ bool RandomBytesTraits::DeriveBits(Environment* env,
                                    const RandomBytesConfig& params,
                                    ByteSource* unused,
                                    CryptoJobMode mode) {
-  return ncrypto::CSPRNG(params.buffer, params.size);
+  return FillRandomBytes(params.buffer, params.size);
 }
 
 void RandomPrimeConfig::MemoryInfo(MemoryTracker* tracker) const {
@@ -212,12 +312,22 @@ MaybeLocal<Value> CheckPrimeTraits::EncodeOutput(Environment* env,
 
 namespace Random {
 void Initialize(Environment* env, Local<Object> target) {
+  RegisterEntropyPoolForkHandler();
+  SetFastMethod(env->context(),
+                target,
+                "randomFillPooled",
+                SlowRandomFillPooled,
+                &fast_random_fill_pooled);
+  NODE_DEFINE_CONSTANT(target, kMaxPooledRandomBytes);
   RandomBytesJob::Initialize(env, target);
   RandomPrimeJob::Initialize(env, target);
   CheckPrimeJob::Initialize(env, target);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SlowRandomFillPooled);
+  registry->Register(FastRandomFillPooled);
+  registry->Register(fast_random_fill_pooled.GetTypeInfo());
   RandomBytesJob::RegisterExternalReferences(registry);
   RandomPrimeJob::RegisterExternalReferences(registry);
   CheckPrimeJob::RegisterExternalReferences(registry);
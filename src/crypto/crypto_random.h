@@ -12,6 +12,14 @@
 
 namespace node {
 namespace crypto {
+// Requests of up to this many bytes are served from a per-thread pool of
+// random bytes that is refilled from the CSPRNG in large chunks.
+constexpr size_t kMaxPooledRandomBytes = 256;
+
+// Fills |data| with |size| random bytes, from the per-thread pool when the
+// request is small enough and directly from the CSPRNG otherwise.
+bool FillRandomBytes(unsigned char* data, size_t size);
+
 struct RandomBytesConfig final : public MemoryRetainer {
   unsigned char* buffer;
   size_t size;
@@ -25,6 +33,9 @@ struct RandomBytesTraits final {
   static constexpr const char* JobName = "RandomBytesJob";
   static constexpr AsyncWrap::ProviderType Provider =
       AsyncWrap::PROVIDER_RANDOMBYTESREQUEST;
+  // Filling a buffer is short and often on the path of network I/O, so it
+  // stays on the libuv threadpool.
+  static constexpr bool kUseCryptoThreadPool = false;
 
   static v8::Maybe<void> AdditionalConfig(
       CryptoJobMode mode,
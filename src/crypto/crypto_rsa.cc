@@ -171,6 +171,9 @@ Maybe<void> RsaKeyGenTraits::AdditionalConfig(
     }
 
     *offset += 3;
+  } else {
+    params->pool_id = "rsa:" + std::to_string(params->params.modulus_bits) +
+                      ":" + std::to_string(params->params.exponent);
   }
 
   return JustVoid();
@@ -535,6 +538,11 @@ void Initialize(Environment* env, Local<Object> target) {
   RSAKeyExportJob::Initialize(env, target);
   RSACipherJob::Initialize(env, target);
 
+  SetMethod(env->context(),
+            target,
+            "setRsaKeyPairPoolSize",
+            RSAKeyPairGenJob::SetPoolSize);
+
   NODE_DEFINE_CONSTANT(target, kKeyVariantRSA_SSA_PKCS1_v1_5);
   NODE_DEFINE_CONSTANT(target, kKeyVariantRSA_PSS);
   NODE_DEFINE_CONSTANT(target, kKeyVariantRSA_OAEP);
@@ -544,6 +552,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   RSAKeyPairGenJob::RegisterExternalReferences(registry);
   RSAKeyExportJob::RegisterExternalReferences(registry);
   RSACipherJob::RegisterExternalReferences(registry);
+  registry->Register(RSAKeyPairGenJob::SetPoolSize);
 }
 }  // namespace RSAAlg
 }  // namespace crypto
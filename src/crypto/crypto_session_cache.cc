@@ -0,0 +1,336 @@
+#include "crypto/crypto_session_cache.h"
+#include "base_object-inl.h"
+#include "crypto/crypto_common.h"
+#include "crypto/crypto_context.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_buffer.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <cstring>
+
+namespace node {
+
+using ncrypto::Cipher;
+using ncrypto::Digest;
+using ncrypto::SSLSessionPointer;
+using v8::ArrayBufferView;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::Uint32;
+using v8::Value;
+
+namespace crypto {
+
+namespace {
+bool GenerateTicketKeys(SharedSessionCache::TicketKeys* keys) {
+  return ncrypto::CSPRNG(keys->name, sizeof(keys->name)) &&
+         ncrypto::CSPRNG(keys->hmac, sizeof(keys->hmac)) &&
+         ncrypto::CSPRNG(keys->aes, sizeof(keys->aes));
+}
+}  // namespace
+
+SharedSessionCache::SharedSessionCache(size_t max_sessions)
+    : max_sessions_(max_sessions),
+      max_sessions_per_shard_((max_sessions + kShardCount - 1) / kShardCount) {
+  CHECK_GT(max_sessions, 0);
+  CHECK(GenerateTicketKeys(&current_ticket_keys_));
+}
+
+SharedSessionCache::Shard& SharedSessionCache::ShardFor(
+    const std::string& id) {
+  return shards_[std::hash<std::string>{}(id) % kShardCount];
+}
+
+bool SharedSessionCache::Add(SSL_SESSION* sess) {
+  unsigned int id_length;
+  const unsigned char* id = SSL_SESSION_get_id(sess, &id_length);
+  if (id_length == 0) return false;
+
+  int size = i2d_SSL_SESSION(sess, nullptr);
+  if (size <= 0 || size > SecureContext::kMaxSessionSize) return false;
+  std::vector<unsigned char> data(size);
+  unsigned char* p = data.data();
+  CHECK_EQ(i2d_SSL_SESSION(sess, &p), size);
+
+  std::string key(reinterpret_cast<const char*>(id), id_length);
+  Shard& shard = ShardFor(key);
+  Mutex::ScopedLock lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    it->second->second = std::move(data);
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return true;
+  }
+  if (shard.entries.size() == max_sessions_per_shard_) {
+    shard.index.erase(shard.entries.back().first);
+    shard.entries.pop_back();
+  }
+  shard.entries.emplace_front(std::move(key), std::move(data));
+  shard.index.emplace(shard.entries.front().first, shard.entries.begin());
+  return true;
+}
+
+SSLSessionPointer SharedSessionCache::Get(const unsigned char* id,
+                                          size_t id_length) {
+  std::string key(reinterpret_cast<const char*>(id), id_length);
+  std::vector<unsigned char> data;
+  {
+    Shard& shard = ShardFor(key);
+    Mutex::ScopedLock lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) return {};
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    data = it->second->second;
+  }
+  return GetTLSSession(data.data(), data.size());
+}
+
+void SharedSessionCache::Remove(const unsigned char* id, size_t id_length) {
+  std::string key(reinterpret_cast<const char*>(id), id_length);
+  Shard& shard = ShardFor(key);
+  Mutex::ScopedLock lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) return;
+  shard.entries.erase(it->second);
+  shard.index.erase(it);
+}
+
+void SharedSessionCache::Clear() {
+  for (Shard& shard : shards_) {
+    Mutex::ScopedLock lock(shard.mutex);
+    shard.index.clear();
+    shard.entries.clear();
+  }
+}
+
+size_t SharedSessionCache::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    Mutex::ScopedLock lock(shard.mutex);
+    size += shard.entries.size();
+  }
+  return size;
+}
+
+void SharedSessionCache::SetTicketKeys(const TicketKeys& keys) {
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  previous_ticket_keys_ = current_ticket_keys_;
+  has_previous_ticket_keys_ = true;
+  current_ticket_keys_ = keys;
+}
+
+bool SharedSessionCache::RotateTicketKeys() {
+  TicketKeys keys;
+  if (!GenerateTicketKeys(&keys)) return false;
+  SetTicketKeys(keys);
+  return true;
+}
+
+SharedSessionCache::TicketKeys SharedSessionCache::GetTicketKeys() const {
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  return current_ticket_keys_;
+}
+
+int SharedSessionCache::TicketKeyCallback(unsigned char* name,
+                                          unsigned char* iv,
+                                          EVP_CIPHER_CTX* ectx,
+                                          HMAC_CTX* hctx,
+                                          int enc) {
+  TicketKeys keys;
+  int result = 1;
+  {
+    Mutex::ScopedLock lock(ticket_keys_mutex_);
+    if (enc ||
+        memcmp(name, current_ticket_keys_.name, kTicketKeyPartSize) == 0) {
+      keys = current_ticket_keys_;
+    } else if (has_previous_ticket_keys_ &&
+               memcmp(name, previous_ticket_keys_.name, kTicketKeyPartSize) ==
+                   0) {
+      keys = previous_ticket_keys_;
+      // Accept the ticket, but have a new one issued with the current keys.
+      result = 2;
+    } else {
+      // The ticket key name does not match. Discard the ticket.
+      return 0;
+    }
+  }
+
+  if (enc) {
+    memcpy(name, keys.name, kTicketKeyPartSize);
+    if (!ncrypto::CSPRNG(iv, 16) ||
+        EVP_EncryptInit_ex(ectx, Cipher::AES_128_CBC, nullptr, keys.aes, iv) <=
+            0 ||
+        HMAC_Init_ex(
+            hctx, keys.hmac, sizeof(keys.hmac), Digest::SHA256, nullptr) <=
+            0) {
+      return -1;
+    }
+    return 1;
+  }
+
+  if (EVP_DecryptInit_ex(ectx, Cipher::AES_128_CBC, nullptr, keys.aes, iv) <=
+          0 ||
+      HMAC_Init_ex(
+          hctx, keys.hmac, sizeof(keys.hmac), Digest::SHA256, nullptr) <= 0) {
+    return -1;
+  }
+  return result;
+}
+
+void SharedSessionCache::MemoryInfo(MemoryTracker* tracker) const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    Mutex::ScopedLock lock(shard.mutex);
+    for (const Entry& entry : shard.entries)
+      size += entry.first.size() + entry.second.size();
+  }
+  tracker->TrackFieldWithSize("sessions", size);
+}
+
+SessionCache::SessionCache(Environment* env,
+                           Local<Object> wrap,
+                           std::shared_ptr<SharedSessionCache> cache)
+    : BaseObject(env, wrap), cache_(std::move(cache)) {
+  MakeWeak();
+}
+
+BaseObjectPtr<SessionCache> SessionCache::New(
+    Environment* env, std::shared_ptr<SharedSessionCache> cache) {
+  Local<Object> obj;
+  if (!GetConstructorTemplate(env)
+           ->InstanceTemplate()
+           ->NewInstance(env->context())
+           .ToLocal(&obj)) {
+    return nullptr;
+  }
+  return MakeBaseObject<SessionCache>(env, obj, std::move(cache));
+}
+
+void SessionCache::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  uint32_t max_sessions = args[0].As<Uint32>()->Value();
+  new SessionCache(
+      env, args.This(), std::make_shared<SharedSessionCache>(max_sessions));
+}
+
+void SessionCache::GetSize(const FunctionCallbackInfo<Value>& args) {
+  SessionCache* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  args.GetReturnValue().Set(static_cast<double>(wrap->cache_->size()));
+}
+
+void SessionCache::Clear(const FunctionCallbackInfo<Value>& args) {
+  SessionCache* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  wrap->cache_->Clear();
+}
+
+void SessionCache::GetTicketKeys(const FunctionCallbackInfo<Value>& args) {
+  SessionCache* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+
+  SharedSessionCache::TicketKeys keys = wrap->cache_->GetTicketKeys();
+  Local<Object> buff;
+  if (!Buffer::Copy(wrap->env(),
+                    reinterpret_cast<const char*>(&keys),
+                    sizeof(keys))
+           .ToLocal(&buff)) {
+    return;
+  }
+  args.GetReturnValue().Set(buff);
+}
+
+void SessionCache::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
+  SessionCache* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+
+  CHECK(args[0]->IsArrayBufferView());
+  ArrayBufferViewContents<char> buf(args[0].As<ArrayBufferView>());
+  SharedSessionCache::TicketKeys keys;
+  CHECK_EQ(buf.length(), sizeof(keys));
+  memcpy(&keys, buf.data(), sizeof(keys));
+  wrap->cache_->SetTicketKeys(keys);
+}
+
+void SessionCache::RotateTicketKeys(const FunctionCallbackInfo<Value>& args) {
+  SessionCache* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  if (!wrap->cache_->RotateTicketKeys()) {
+    return THROW_ERR_CRYPTO_OPERATION_FAILED(
+        wrap->env(), "Error generating ticket keys");
+  }
+}
+
+void SessionCache::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("cache", cache_);
+}
+
+std::unique_ptr<worker::TransferData> SessionCache::CloneForMessaging()
+    const {
+  return std::make_unique<TransferData>(cache_);
+}
+
+BaseObjectPtr<BaseObject> SessionCache::TransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  return New(env, std::move(cache_));
+}
+
+void SessionCache::TransferData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("cache", cache_);
+}
+
+bool SessionCache::HasInstance(Environment* env, Local<Value> value) {
+  return GetConstructorTemplate(env)->HasInstance(value);
+}
+
+Local<FunctionTemplate> SessionCache::GetConstructorTemplate(
+    Environment* env) {
+  Local<FunctionTemplate> tmpl = env->session_cache_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, New);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        SessionCache::kInternalFieldCount);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "SessionCache"));
+    SetProtoMethodNoSideEffect(isolate, tmpl, "getSize", GetSize);
+    SetProtoMethod(isolate, tmpl, "clear", Clear);
+    SetProtoMethodNoSideEffect(isolate, tmpl, "getTicketKeys", GetTicketKeys);
+    SetProtoMethod(isolate, tmpl, "setTicketKeys", SetTicketKeys);
+    SetProtoMethod(isolate, tmpl, "rotateTicketKeys", RotateTicketKeys);
+    env->set_session_cache_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+void SessionCache::Initialize(Environment* env, Local<Object> target) {
+  SetConstructorFunction(env->context(),
+                         target,
+                         "SessionCache",
+                         GetConstructorTemplate(env),
+                         SetConstructorFunctionFlag::NONE);
+}
+
+void SessionCache::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetSize);
+  registry->Register(Clear);
+  registry->Register(GetTicketKeys);
+  registry->Register(SetTicketKeys);
+  registry->Register(RotateTicketKeys);
+}
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,160 @@
+#ifndef SRC_CRYPTO_CRYPTO_SESSION_CACHE_H_
+#define SRC_CRYPTO_CRYPTO_SESSION_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "crypto/crypto_util.h"
+#include "env.h"
+#include "memory_tracker.h"
+#include "ncrypto.h"
+#include "node_mutex.h"
+#include "node_worker.h"
+#include "v8.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// Server-side TLS resumption state that can be shared by SecureContexts on
+// any thread of the process: a cache of serialized sessions keyed by session
+// ID, and the keys used to encrypt and decrypt session tickets.
+//
+// The cache is split into shards that are locked independently. Each shard
+// holds a fixed number of sessions and evicts the least recently used one
+// when it is full.
+class SharedSessionCache final : public MemoryRetainer {
+ public:
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kTicketKeyPartSize = 16;
+
+  struct TicketKeys {
+    unsigned char name[kTicketKeyPartSize];
+    unsigned char hmac[kTicketKeyPartSize];
+    unsigned char aes[kTicketKeyPartSize];
+  };
+
+  explicit SharedSessionCache(size_t max_sessions);
+
+  // Stores the serialized |sess|. Sessions without an ID and sessions larger
+  // than SecureContext::kMaxSessionSize are not stored.
+  bool Add(SSL_SESSION* sess);
+  ncrypto::SSLSessionPointer Get(const unsigned char* id, size_t id_length);
+  void Remove(const unsigned char* id, size_t id_length);
+  void Clear();
+
+  size_t size() const;
+  inline size_t max_sessions() const { return max_sessions_; }
+
+  // Makes |keys| the keys used to issue new tickets. Tickets issued with the
+  // keys that were current until now are still accepted, and renewed, until
+  // the keys are replaced once more.
+  void SetTicketKeys(const TicketKeys& keys);
+  bool RotateTicketKeys();
+  TicketKeys GetTicketKeys() const;
+
+  // Has the semantics of the callback passed to
+  // SSL_CTX_set_tlsext_ticket_key_cb().
+  int TicketKeyCallback(unsigned char* name,
+                        unsigned char* iv,
+                        EVP_CIPHER_CTX* ectx,
+                        HMAC_CTX* hctx,
+                        int enc);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SharedSessionCache)
+  SET_SELF_SIZE(SharedSessionCache)
+
+ private:
+  using Entry = std::pair<std::string, std::vector<unsigned char>>;
+
+  struct Shard {
+    Mutex mutex;
+    // Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+  };
+
+  Shard& ShardFor(const std::string& id);
+
+  const size_t max_sessions_;
+  const size_t max_sessions_per_shard_;
+  Shard shards_[kShardCount];
+
+  Mutex ticket_keys_mutex_;
+  TicketKeys current_ticket_keys_;
+  TicketKeys previous_ticket_keys_;
+  bool has_previous_ticket_keys_ = false;
+};
+
+// JS handle for a SharedSessionCache. Cloning it with postMessage() gives
+// the receiving thread a handle to the same cache.
+class SessionCache final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+  static bool HasInstance(Environment* env, v8::Local<v8::Value> value);
+
+  static BaseObjectPtr<SessionCache> New(
+      Environment* env, std::shared_ptr<SharedSessionCache> cache);
+
+  SessionCache(Environment* env,
+               v8::Local<v8::Object> wrap,
+               std::shared_ptr<SharedSessionCache> cache);
+
+  inline const std::shared_ptr<SharedSessionCache>& cache() const {
+    return cache_;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SessionCache)
+  SET_SELF_SIZE(SessionCache)
+
+  BaseObject::TransferMode GetTransferMode() const override {
+    return TransferMode::kCloneable;
+  }
+  std::unique_ptr<worker::TransferData> CloneForMessaging() const override;
+
+  class TransferData : public worker::TransferData {
+   public:
+    inline explicit TransferData(std::shared_ptr<SharedSessionCache> cache)
+        : cache_(std::move(cache)) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    void MemoryInfo(MemoryTracker* tracker) const override;
+    SET_MEMORY_INFO_NAME(SessionCache::TransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    std::shared_ptr<SharedSessionCache> cache_;
+  };
+
+ private:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Clear(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void RotateTicketKeys(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  std::shared_ptr<SharedSessionCache> cache_;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_SESSION_CACHE_H_
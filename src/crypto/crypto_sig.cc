@@ -20,10 +20,12 @@ using ncrypto::ECDSASigPointer;
 using ncrypto::EVPKeyCtxPointer;
 using ncrypto::EVPKeyPointer;
 using ncrypto::EVPMDCtxPointer;
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::BackingStore;
 using v8::BackingStoreInitializationMode;
 using v8::Boolean;
+using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -31,6 +33,7 @@ using v8::Int32;
 using v8::Isolate;
 using v8::JustVoid;
 using v8::Local;
+using v8::LocalVector;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
@@ -285,6 +288,7 @@ void Sign::Initialize(Environment* env, Local<Object> target) {
   SetConstructorFunction(env->context(), target, "Sign", t);
 
   SignJob::Initialize(env, target);
+  SignBatchJob::Initialize(env, target);
 
   constexpr int kSignJobModeSign =
       static_cast<int>(SignConfiguration::Mode::Sign);
@@ -307,6 +311,7 @@ void Sign::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SignUpdate);
   registry->Register(SignFinal);
   SignJob::RegisterExternalReferences(registry);
+  SignBatchJob::RegisterExternalReferences(registry);
 }
 
 void Sign::New(const FunctionCallbackInfo<Value>& args) {
@@ -551,12 +556,13 @@ void SignConfiguration::MemoryInfo(MemoryTracker* tracker) const {
   }
 }
 
-Maybe<void> SignTraits::AdditionalConfig(
-    CryptoJobMode mode,
-    const FunctionCallbackInfo<Value>& args,
-    unsigned int offset,
-    SignConfiguration* params) {
-  ClearErrorOnReturn clear_error_on_return;
+namespace {
+// Reads the arguments that SignJob and SignBatchJob have in common: the mode,
+// the key, the digest and the padding and signature encoding options.
+Maybe<void> GetSignOptionsFromJs(CryptoJobMode mode,
+                                 const FunctionCallbackInfo<Value>& args,
+                                 unsigned int offset,
+                                 SignConfiguration* params) {
   Environment* env = Environment::GetCurrent(args);
 
   params->job_mode = mode;
@@ -578,15 +584,6 @@ Maybe<void> SignTraits::AdditionalConfig(
     params->key = std::move(data);
   }
 
-  ArrayBufferOrViewContents<char> data(args[offset + 5]);
-  if (!data.CheckSizeInt32()) [[unlikely]] {
-    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
-    return Nothing<void>();
-  }
-  params->data = mode == kCryptoJobAsync
-      ? data.ToCopy()
-      : data.ToByteSource();
-
   if (args[offset + 6]->IsString()) {
     Utf8Value digest(env->isolate(), args[offset + 6]);
     params->digest = Digest::FromName(*digest);
@@ -615,36 +612,55 @@ Maybe<void> SignTraits::AdditionalConfig(
     }
   }
 
-  if (params->mode == SignConfiguration::Mode::Verify) {
-    ArrayBufferOrViewContents<char> signature(args[offset + 10]);
-    if (!signature.CheckSizeInt32()) [[unlikely]] {
-      THROW_ERR_OUT_OF_RANGE(env, "signature is too big");
-      return Nothing<void>();
-    }
-    // If this is an EC key (assuming ECDSA) we need to convert the
-    // the signature from WebCrypto format into DER format...
-    Mutex::ScopedLock lock(params->key.mutex());
-    const auto& akey = params->key.GetAsymmetricKey();
-    if (UseP1363Encoding(akey, params->dsa_encoding)) {
-      params->signature = ConvertSignatureToDER(akey, signature.ToByteSource());
-    } else {
-      params->signature = mode == kCryptoJobAsync
-          ? signature.ToCopy()
-          : signature.ToByteSource();
-    }
+  return JustVoid();
+}
+
+bool GetDataFromJs(Environment* env,
+                   CryptoJobMode mode,
+                   Local<Value> value,
+                   ByteSource* out) {
+  ArrayBufferOrViewContents<char> data(value);
+  if (!data.CheckSizeInt32()) [[unlikely]] {
+    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    return false;
   }
+  *out = mode == kCryptoJobAsync ? data.ToCopy() : data.ToByteSource();
+  return true;
+}
 
-  return JustVoid();
+bool GetSignatureFromJs(Environment* env,
+                        const SignConfiguration& params,
+                        Local<Value> value,
+                        ByteSource* out) {
+  ArrayBufferOrViewContents<char> signature(value);
+  if (!signature.CheckSizeInt32()) [[unlikely]] {
+    THROW_ERR_OUT_OF_RANGE(env, "signature is too big");
+    return false;
+  }
+  // If this is an EC key (assuming ECDSA) we need to convert the
+  // the signature from WebCrypto format into DER format...
+  Mutex::ScopedLock lock(params.key.mutex());
+  const auto& akey = params.key.GetAsymmetricKey();
+  if (UseP1363Encoding(akey, params.dsa_encoding)) {
+    *out = ConvertSignatureToDER(akey, signature.ToByteSource());
+  } else {
+    *out = params.job_mode == kCryptoJobAsync ? signature.ToCopy()
+                                              : signature.ToByteSource();
+  }
+  return true;
 }
 
-bool SignTraits::DeriveBits(Environment* env,
-                            const SignConfiguration& params,
-                            ByteSource* out,
-                            CryptoJobMode mode) {
+// Signs or verifies |data| with the key and options in |params|. |context| is
+// reinitialized, so one context can be used for several messages.
+bool SignOrVerify(Environment* env,
+                  const SignConfiguration& params,
+                  const EVPMDCtxPointer& context,
+                  const ByteSource& data,
+                  const ByteSource& signature,
+                  ByteSource* out,
+                  CryptoJobMode mode) {
   bool can_throw = mode == CryptoJobMode::kCryptoJobSync;
-  auto context = EVPMDCtxPointer::New();
-  if (!context) [[unlikely]]
-    return false;
+  EVP_MD_CTX_reset(context.get());
   const auto& key = params.key.GetAsymmetricKey();
 
   auto ctx = ([&] {
@@ -679,21 +695,21 @@ bool SignTraits::DeriveBits(Environment* env,
   switch (params.mode) {
     case SignConfiguration::Mode::Sign: {
       if (key.isOneShotVariant()) {
-        auto data = context.signOneShot(params.data);
-        if (!data) [[unlikely]] {
+        auto sig = context.signOneShot(data);
+        if (!sig) [[unlikely]] {
           if (can_throw) crypto::CheckThrow(env, SignBase::Error::PrivateKey);
           return false;
         }
-        DCHECK(!data.isSecure());
-        *out = ByteSource::Allocated(data.release());
+        DCHECK(!sig.isSecure());
+        *out = ByteSource::Allocated(sig.release());
       } else {
-        auto data = context.sign(params.data);
-        if (!data) [[unlikely]] {
+        auto sig = context.sign(data);
+        if (!sig) [[unlikely]] {
           if (can_throw) crypto::CheckThrow(env, SignBase::Error::PrivateKey);
           return false;
         }
-        DCHECK(!data.isSecure());
-        auto bs = ByteSource::Allocated(data.release());
+        DCHECK(!sig.isSecure());
+        auto bs = ByteSource::Allocated(sig.release());
 
         if (UseP1363Encoding(key, params.dsa_encoding)) {
           *out = ConvertSignatureToP1363(env, key, std::move(bs));
@@ -706,7 +722,7 @@ bool SignTraits::DeriveBits(Environment* env,
     case SignConfiguration::Mode::Verify: {
       auto buf = DataPointer::Alloc(1);
       static_cast<char*>(buf.get())[0] = 0;
-      if (context.verify(params.data, params.signature)) {
+      if (context.verify(data, signature)) {
         static_cast<char*>(buf.get())[0] = 1;
       }
       *out = ByteSource::Allocated(buf.release());
@@ -715,6 +731,40 @@ bool SignTraits::DeriveBits(Environment* env,
 
   return true;
 }
+}  // namespace
+
+Maybe<void> SignTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    SignConfiguration* params) {
+  ClearErrorOnReturn clear_error_on_return;
+  Environment* env = Environment::GetCurrent(args);
+
+  if (GetSignOptionsFromJs(mode, args, offset, params).IsNothing() ||
+      !GetDataFromJs(env, mode, args[offset + 5], &params->data)) {
+    return Nothing<void>();
+  }
+
+  if (params->mode == SignConfiguration::Mode::Verify &&
+      !GetSignatureFromJs(
+          env, *params, args[offset + 10], &params->signature)) {
+    return Nothing<void>();
+  }
+
+  return JustVoid();
+}
+
+bool SignTraits::DeriveBits(Environment* env,
+                            const SignConfiguration& params,
+                            ByteSource* out,
+                            CryptoJobMode mode) {
+  auto context = EVPMDCtxPointer::New();
+  if (!context) [[unlikely]]
+    return false;
+  return SignOrVerify(
+      env, params, context, params.data, params.signature, out, mode);
+}
 
 MaybeLocal<Value> SignTraits::EncodeOutput(Environment* env,
                                            const SignConfiguration& params,
@@ -728,5 +778,141 @@ MaybeLocal<Value> SignTraits::EncodeOutput(Environment* env,
   UNREACHABLE();
 }
 
+SignBatchConfiguration::SignBatchConfiguration(
+    SignBatchConfiguration&& other) noexcept
+    : options(std::move(other.options)),
+      data(std::move(other.data)),
+      signatures(std::move(other.signatures)) {}
+
+SignBatchConfiguration& SignBatchConfiguration::operator=(
+    SignBatchConfiguration&& other) noexcept {
+  if (&other == this) return *this;
+  this->~SignBatchConfiguration();
+  return *new (this) SignBatchConfiguration(std::move(other));
+}
+
+void SignBatchConfiguration::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("options", options);
+  if (options.job_mode == kCryptoJobAsync) {
+    size_t size = 0;
+    for (const auto& item : data) size += item.size();
+    for (const auto& item : signatures) size += item.size();
+    tracker->TrackFieldWithSize("data", size);
+  }
+}
+
+// The arguments are those of SignJob, except that the data and, when
+// verifying, the signatures are arrays with one element per message.
+Maybe<void> SignBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    SignBatchConfiguration* params) {
+  ClearErrorOnReturn clear_error_on_return;
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  if (GetSignOptionsFromJs(mode, args, offset, &params->options).IsNothing())
+    return Nothing<void>();
+  bool verify = params->options.mode == SignConfiguration::Mode::Verify;
+
+  CHECK(args[offset + 5]->IsArray());
+  Local<Array> data = args[offset + 5].As<Array>();
+  Local<Array> signatures;
+  if (verify) {
+    CHECK(args[offset + 10]->IsArray());
+    signatures = args[offset + 10].As<Array>();
+    CHECK_EQ(signatures->Length(), data->Length());
+  }
+
+  params->data.resize(data->Length());
+  if (verify) params->signatures.resize(data->Length());
+  for (uint32_t i = 0; i < data->Length(); i++) {
+    Local<Value> item;
+    if (!data->Get(context, i).ToLocal(&item)) return Nothing<void>();
+    if (!GetDataFromJs(env, mode, item, &params->data[i]))
+      return Nothing<void>();
+
+    if (!verify) continue;
+    if (!signatures->Get(context, i).ToLocal(&item)) return Nothing<void>();
+    if (!GetSignatureFromJs(
+            env, params->options, item, &params->signatures[i])) {
+      return Nothing<void>();
+    }
+  }
+
+  return JustVoid();
+}
+
+// The output holds the length of each result as a uint32_t, followed by the
+// results themselves.
+bool SignBatchTraits::DeriveBits(Environment* env,
+                                 const SignBatchConfiguration& params,
+                                 ByteSource* out,
+                                 CryptoJobMode mode) {
+  auto context = EVPMDCtxPointer::New();
+  if (!context) [[unlikely]]
+    return false;
+
+  std::vector<ByteSource> results(params.data.size());
+  size_t size = results.size() * sizeof(uint32_t);
+  ByteSource no_signature;
+  for (size_t i = 0; i < results.size(); i++) {
+    const ByteSource& signature =
+        params.signatures.empty() ? no_signature : params.signatures[i];
+    if (!SignOrVerify(env,
+                      params.options,
+                      context,
+                      params.data[i],
+                      signature,
+                      &results[i],
+                      mode)) {
+      return false;
+    }
+    size += results[i].size();
+  }
+
+  auto buf = DataPointer::Alloc(size);
+  if (!buf) [[unlikely]]
+    return false;
+  char* lengths = static_cast<char*>(buf.get());
+  char* ptr = lengths + results.size() * sizeof(uint32_t);
+  for (size_t i = 0; i < results.size(); i++) {
+    uint32_t length = static_cast<uint32_t>(results[i].size());
+    memcpy(lengths + i * sizeof(length), &length, sizeof(length));
+    if (length > 0) memcpy(ptr, results[i].data(), length);
+    ptr += length;
+  }
+
+  *out = ByteSource::Allocated(buf.release());
+  return true;
+}
+
+MaybeLocal<Value> SignBatchTraits::EncodeOutput(
+    Environment* env, const SignBatchConfiguration& params, ByteSource* out) {
+  Isolate* isolate = env->isolate();
+  size_t count = params.data.size();
+  const char* lengths = out->data<char>();
+  const char* ptr = lengths + count * sizeof(uint32_t);
+
+  LocalVector<Value> results(isolate);
+  results.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    uint32_t length;
+    memcpy(&length, lengths + i * sizeof(length), sizeof(length));
+    if (params.options.mode == SignConfiguration::Mode::Verify) {
+      results.push_back(Boolean::New(isolate, ptr[0] == 1));
+    } else {
+      auto store = ArrayBuffer::NewBackingStore(
+          isolate, length, BackingStoreInitializationMode::kUninitialized);
+      if (length > 0) memcpy(store->Data(), ptr, length);
+      results.push_back(ArrayBuffer::New(isolate, std::move(store)));
+    }
+    ptr += length;
+  }
+
+  return Array::New(isolate, results.data(), results.size());
+}
+
 }  // namespace crypto
 }  // namespace node
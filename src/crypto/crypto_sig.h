@@ -9,6 +9,8 @@
 #include "env.h"
 #include "memory_tracker.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 static const unsigned int kNoDsaSignature = static_cast<unsigned int>(-1);
@@ -149,6 +151,49 @@ struct SignTraits final {
 
 using SignJob = DeriveBitsJob<SignTraits>;
 
+// Signs or verifies several messages with the same key and options in one
+// job, so that a batch of messages is dispatched to the threadpool once.
+struct SignBatchConfiguration final : public MemoryRetainer {
+  // The key and options. Its data and signature are not used.
+  SignConfiguration options;
+  std::vector<ByteSource> data;
+  std::vector<ByteSource> signatures;
+
+  SignBatchConfiguration() = default;
+
+  explicit SignBatchConfiguration(SignBatchConfiguration&& other) noexcept;
+
+  SignBatchConfiguration& operator=(SignBatchConfiguration&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SignBatchConfiguration)
+  SET_SELF_SIZE(SignBatchConfiguration)
+};
+
+struct SignBatchTraits final {
+  using AdditionalParameters = SignBatchConfiguration;
+  static constexpr const char* JobName = "SignBatchJob";
+
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_SIGNREQUEST;
+
+  static v8::Maybe<void> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      SignBatchConfiguration* params);
+
+  static bool DeriveBits(Environment* env,
+                         const SignBatchConfiguration& params,
+                         ByteSource* out,
+                         CryptoJobMode mode);
+
+  static v8::MaybeLocal<v8::Value> EncodeOutput(
+      Environment* env, const SignBatchConfiguration& params, ByteSource* out);
+};
+
+using SignBatchJob = DeriveBitsJob<SignBatchTraits>;
+
 }  // namespace crypto
 }  // namespace node
 
@@ -0,0 +1,123 @@
+#include "crypto/crypto_threadpool.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "node_options.h"
+#include "util-inl.h"
+
+#include <memory>
+#include <mutex>
+
+namespace node {
+
+using v8::Array;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Value;
+
+namespace crypto {
+
+CryptoThreadPool* CryptoThreadPool::Get() {
+  static std::once_flag once;
+  // Deliberately leaked, its threads live until the process exits.
+  static CryptoThreadPool* pool = nullptr;
+  std::call_once(once, [] {
+    int64_t size = per_process::cli_options->crypto_threadpool_size;
+    if (size > 0) pool = new CryptoThreadPool(static_cast<size_t>(size));
+  });
+  return pool;
+}
+
+CryptoThreadPool::CryptoThreadPool(size_t size) : threads_(size) {
+  for (uv_thread_t& thread : threads_)
+    CHECK_EQ(uv_thread_create(&thread, ThreadMain, this), 0);
+}
+
+void CryptoThreadPool::ThreadMain(void* arg) {
+  CryptoThreadPool* pool = static_cast<CryptoThreadPool*>(arg);
+  uv_thread_t self = uv_thread_self();
+  // Not being able to lower the priority is not an error.
+  uv_thread_setpriority(self, UV_THREAD_PRIORITY_BELOW_NORMAL);
+
+  for (;;) {
+    Task* task;
+    {
+      Mutex::ScopedLock lock(pool->mutex_);
+      while (pool->queue_.empty()) pool->cond_.Wait(lock);
+      task = pool->queue_.front();
+      pool->queue_.pop_front();
+      pool->active_++;
+    }
+
+    task->work->DoThreadPoolWork();
+
+    {
+      Mutex::ScopedLock lock(pool->mutex_);
+      pool->active_--;
+      pool->completed_++;
+    }
+    // The task is freed on the event loop thread once this has been sent.
+    uv_async_send(&task->async);
+  }
+}
+
+void CryptoThreadPool::Schedule(ThreadPoolWork* work) {
+  Environment* env = work->env();
+  env->IncreaseWaitingRequestCounter();
+
+  // The handle keeps the event loop alive until the work is done.
+  Task* task = new Task{work, {}};
+  CHECK_EQ(uv_async_init(env->event_loop(), &task->async, OnDone), 0);
+
+  Mutex::ScopedLock lock(mutex_);
+  queue_.push_back(task);
+  cond_.Signal(lock);
+}
+
+void CryptoThreadPool::OnDone(uv_async_t* async) {
+  uv_close(reinterpret_cast<uv_handle_t*>(async), [](uv_handle_t* handle) {
+    std::unique_ptr<Task> task(
+        ContainerOf(&Task::async, reinterpret_cast<uv_async_t*>(handle)));
+    ThreadPoolWork* work = task->work;
+    work->env()->DecreaseWaitingRequestCounter();
+    work->AfterThreadPoolWork(0);
+  });
+}
+
+CryptoThreadPool::Stats CryptoThreadPool::GetStats() {
+  Mutex::ScopedLock lock(mutex_);
+  return Stats{threads_.size(), queue_.size(), active_, completed_};
+}
+
+// Returns [size, queued, active, completed], all zero when the dedicated
+// threadpool is disabled.
+void CryptoThreadPool::GetCryptoThreadPoolStats(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CryptoThreadPool* pool = Get();
+  Stats stats = pool != nullptr ? pool->GetStats() : Stats{0, 0, 0, 0};
+  Local<Value> values[] = {
+      Number::New(env->isolate(), static_cast<double>(stats.size)),
+      Number::New(env->isolate(), static_cast<double>(stats.queued)),
+      Number::New(env->isolate(), static_cast<double>(stats.active)),
+      Number::New(env->isolate(), static_cast<double>(stats.completed)),
+  };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), values, arraysize(values)));
+}
+
+void CryptoThreadPool::Initialize(Environment* env, Local<Object> target) {
+  SetMethodNoSideEffect(env->context(),
+                        target,
+                        "getCryptoThreadPoolStats",
+                        GetCryptoThreadPoolStats);
+}
+
+void CryptoThreadPool::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(GetCryptoThreadPoolStats);
+}
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,73 @@
+#ifndef SRC_CRYPTO_CRYPTO_THREADPOOL_H_
+#define SRC_CRYPTO_CRYPTO_THREADPOOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "env.h"
+#include "node_internals.h"
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace node {
+
+class ExternalReferenceRegistry;
+
+namespace crypto {
+
+// A process-wide threadpool for asynchronous CryptoJobs. When
+// --crypto-threadpool-size is greater than zero, CryptoJobs run on it instead
+// of on the libuv threadpool, so that CPU-bound crypto work does not hold up
+// fs, dns and zlib requests. Its threads run at below normal priority.
+class CryptoThreadPool final {
+ public:
+  struct Stats {
+    size_t size;
+    size_t queued;
+    size_t active;
+    uint64_t completed;
+  };
+
+  // Returns nullptr when the dedicated threadpool is disabled.
+  static CryptoThreadPool* Get();
+
+  // Runs work->DoThreadPoolWork() on one of the pool's threads, and then
+  // work->AfterThreadPoolWork() on the event loop of work->env(). Must be
+  // called on the thread of that event loop.
+  void Schedule(ThreadPoolWork* work);
+
+  Stats GetStats();
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+ private:
+  struct Task {
+    ThreadPoolWork* work;
+    uv_async_t async;
+  };
+
+  explicit CryptoThreadPool(size_t size);
+
+  static void ThreadMain(void* arg);
+  static void OnDone(uv_async_t* async);
+  static void GetCryptoThreadPoolStats(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  Mutex mutex_;
+  ConditionVariable cond_;
+  std::deque<Task*> queue_;
+  std::vector<uv_thread_t> threads_;
+  size_t active_ = 0;
+  uint64_t completed_ = 0;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_THREADPOOL_H_
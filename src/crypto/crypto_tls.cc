@@ -100,7 +100,14 @@ SSL_SESSION* GetSessionCallback(
     int* copy) {
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   *copy = 0;
-  return w->ReleaseSession();
+  SSL_SESSION* sess = w->ReleaseSession();
+  if (sess == nullptr) {
+    // Nothing was loaded through the 'resumeSession' event, fall back to the
+    // shared session cache, if any.
+    const auto& cache = w->secure_context()->session_cache();
+    if (cache) sess = cache->Get(key, len).release();
+  }
+  return sess;
 }
 
 void OnClientHello(
@@ -159,6 +166,11 @@ void KeylogCallback(const SSL* s, const char* line) {
 
 int NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
+  if (w->is_server()) {
+    const auto& cache = w->secure_context()->session_cache();
+    if (cache) cache->Add(sess);
+  }
+
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -218,6 +230,15 @@ int SSLCertCallback(SSL* s, void* arg) {
     // handshake will continue after certcb is done.
     return -1;
 
+  // Without an SNICallback, the JavaScript side only looks up the OCSP
+  // response, which is not needed if it is cached or was not requested.
+  if (w->ocsp_cache_only_ &&
+      (SSL_get_tlsext_status_type(s) != TLSEXT_STATUSTYPE_ocsp ||
+       w->GetCachedOcspResponse())) {
+    w->WaitForCertCb(nullptr, nullptr);
+    return 1;
+  }
+
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -344,8 +365,18 @@ int TLSExtStatusCallback(SSL* s, void* arg) {
   // Outgoing response
   Local<ArrayBufferView> obj =
       w->ocsp_response().FromMaybe(Local<ArrayBufferView>());
-  if (obj.IsEmpty()) [[unlikely]]
-    return SSL_TLSEXT_ERR_NOACK;
+  if (obj.IsEmpty()) [[unlikely]] {
+    std::shared_ptr<const OCSPCache::Staple> staple =
+        w->GetCachedOcspResponse();
+    if (!staple) return SSL_TLSEXT_ERR_NOACK;
+
+    size_t len = staple->response.size();
+    unsigned char* data = MallocOpenSSL<unsigned char>(len);
+    memcpy(data, staple->response.data(), len);
+    if (!SSL_set_tlsext_status_ocsp_resp(s, data, len))
+      OPENSSL_free(data);
+    return SSL_TLSEXT_ERR_OK;
+  }
 
   size_t len = obj->ByteLength();
 
@@ -451,6 +482,14 @@ void TLSWrap::ClearOcspResponse() {
   ocsp_response_.Reset();
 }
 
+std::shared_ptr<const OCSPCache::Staple> TLSWrap::GetCachedOcspResponse()
+    const {
+  if (!ocsp_cache_enabled_) return nullptr;
+  const SecureContext* sc = sni_context_ ? sni_context_.get() : sc_.get();
+  if (sc == nullptr) return nullptr;
+  return OCSPCache::Find(sc->GetOCSPKey(SSL_get_certificate(ssl_.get())));
+}
+
 SSL_SESSION* TLSWrap::ReleaseSession() {
   return next_sess_.release();
 }
@@ -1084,20 +1123,58 @@ int TLSWrap::DoWrite(WriteWrap* w,
   // of data supplied to end() there is no sense allocating
   // and copying it when it could just be used.
 
-  if (nonempty_count != 1) {
-    bs = ArrayBuffer::NewBackingStore(
+  // Copies bufs[from, to) into a single backing store.
+  auto copy_bufs = [&](size_t from, size_t to) {
+    size_t size = 0;
+    for (size_t j = from; j < to; j++)
+      size += bufs[j].len;
+    std::unique_ptr<BackingStore> copy = ArrayBuffer::NewBackingStore(
         env()->isolate(),
-        length,
+        size,
         BackingStoreInitializationMode::kUninitialized);
     size_t offset = 0;
-    for (i = 0; i < count; i++) {
-      memcpy(static_cast<char*>(bs->Data()) + offset,
-             bufs[i].base, bufs[i].len);
-      offset += bufs[i].len;
+    for (size_t j = from; j < to; j++) {
+      memcpy(static_cast<char*>(copy->Data()) + offset,
+             bufs[j].base, bufs[j].len);
+      offset += bufs[j].len;
     }
+    return copy;
+  };
 
-    NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
-    written = SSL_write(ssl_.get(), bs->Data(), length);
+  if (nonempty_count != 1) {
+    // Runs of small buffers are copied together so that they share TLS
+    // records, but buffers that fill at least a whole record on their own
+    // are encrypted from where they are. If SSL_write() fails part way, the
+    // data that has not been written yet is saved below.
+    size_t run_start = 0;
+    for (i = 0; i <= count; i++) {
+      if (i < count && bufs[i].len < kMinDirectWriteLength)
+        continue;
+
+      if (run_start < i) {
+        std::unique_ptr<BackingStore> run = copy_bufs(run_start, i);
+        if (run->ByteLength() > 0) {
+          NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(run->ByteLength());
+          written = SSL_write(ssl_.get(), run->Data(), run->ByteLength());
+          if (written == -1) {
+            bs = i == count ? std::move(run) : copy_bufs(run_start, count);
+            break;
+          }
+        }
+      }
+      if (i == count)
+        break;
+
+      NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(bufs[i].len);
+      written = SSL_write(ssl_.get(), bufs[i].base, bufs[i].len);
+      if (written == -1) {
+        bs = copy_bufs(i, count);
+        break;
+      }
+      run_start = i + 1;
+    }
+    if (written != -1)
+      written = static_cast<int>(length);
   } else {
     // Only one buffer: try to write directly, only store if it fails
     uv_buf_t* buf = &bufs[nonempty_i];
@@ -1346,6 +1423,14 @@ void TLSWrap::OnClientHelloParseEnd(void* arg) {
   c->Cycle();
 }
 
+void TLSWrap::EnableOCSPCache(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  CHECK(args[0]->IsBoolean());
+  wrap->ocsp_cache_enabled_ = true;
+  wrap->ocsp_cache_only_ = args[0]->IsTrue();
+}
+
 void TLSWrap::EnableALPNCb(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
@@ -2200,6 +2285,7 @@ void TLSWrap::Initialize(
   SetProtoMethod(isolate, t, "destroySSL", DestroySSL);
   SetProtoMethod(isolate, t, "enableCertCb", EnableCertCb);
   SetProtoMethod(isolate, t, "enableALPNCb", EnableALPNCb);
+  SetProtoMethod(isolate, t, "enableOCSPCache", EnableOCSPCache);
   SetProtoMethod(isolate, t, "endParser", EndParser);
   SetProtoMethod(isolate, t, "enableKeylogCallback", EnableKeylogCallback);
   SetProtoMethod(isolate, t, "enableSessionCallbacks", EnableSessionCallbacks);
@@ -2271,6 +2357,7 @@ void TLSWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(DestroySSL);
   registry->Register(EnableCertCb);
   registry->Register(EnableALPNCb);
+  registry->Register(EnableOCSPCache);
   registry->Register(EndParser);
   registry->Register(EnableKeylogCallback);
   registry->Register(EnableSessionCallbacks);
@@ -26,6 +26,7 @@
 
 #include "crypto/crypto_context.h"
 #include "crypto/crypto_clienthello.h"
+#include "crypto/crypto_ocsp_cache.h"
 
 #include "async_wrap.h"
 #include "stream_wrap.h"
@@ -33,6 +34,7 @@
 
 #include <openssl/ssl.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -69,6 +71,7 @@ class TLSWrap : public AsyncWrap,
   inline bool is_server() const { return kind_ == Kind::kServer; }
   inline bool is_client() const { return kind_ == Kind::kClient; }
   inline bool is_awaiting_new_session() const { return awaiting_new_session_; }
+  inline SecureContext* secure_context() const { return sc_.get(); }
 
   // Implement StreamBase:
   bool IsAlive() override;
@@ -95,6 +98,9 @@ class TLSWrap : public AsyncWrap,
 
   v8::MaybeLocal<v8::ArrayBufferView> ocsp_response() const;
   void ClearOcspResponse();
+  // Returns the response in the OCSPCache for the certificate that the
+  // handshake uses, or nullptr if the cache is disabled or has none.
+  std::shared_ptr<const OCSPCache::Staple> GetCachedOcspResponse() const;
   SSL_SESSION* ReleaseSession();
 
   // Called by the done() callback of the 'newSession' event.
@@ -178,6 +184,7 @@ class TLSWrap : public AsyncWrap,
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableALPNCb(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableOCSPCache(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableKeylogCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableSessionCallbacks(
@@ -274,6 +281,10 @@ class TLSWrap : public AsyncWrap,
   bool shutdown_ = false;
   bool cert_cb_running_ = false;
   bool eof_ = false;
+  // Staple responses from the OCSPCache. If the cert callback is only waited
+  // for because of OCSP, it is skipped when the cache has the response.
+  bool ocsp_cache_enabled_ = false;
+  bool ocsp_cache_only_ = false;
 
   // TODO(@jasnell): These state flags should be revisited.
   // The established_ flag indicates that the handshake is
@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "async_wrap.h"
+#include "crypto/crypto_threadpool.h"
 #include "env.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -20,6 +21,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace node::crypto {
@@ -240,6 +242,18 @@ enum CryptoJobMode {
 
 CryptoJobMode GetCryptoJobMode(v8::Local<v8::Value> args);
 
+// Asynchronous CryptoJobs run on the CryptoThreadPool when it is enabled,
+// unless their traits opt out with
+// `static constexpr bool kUseCryptoThreadPool = false;`.
+template <typename CryptoJobTraits, typename = void>
+struct UsesCryptoThreadPool : std::true_type {};
+
+template <typename CryptoJobTraits>
+struct UsesCryptoThreadPool<
+    CryptoJobTraits,
+    std::void_t<decltype(CryptoJobTraits::kUseCryptoThreadPool)>>
+    : std::bool_constant<CryptoJobTraits::kUseCryptoThreadPool> {};
+
 template <typename CryptoJobTraits>
 class CryptoJob : public AsyncWrap, public ThreadPoolWork {
  public:
@@ -251,7 +265,7 @@ class CryptoJob : public AsyncWrap, public ThreadPoolWork {
                      CryptoJobMode mode,
                      AdditionalParams&& params)
       : AsyncWrap(env, object, type),
-        ThreadPoolWork(env, "crypto"),
+        ThreadPoolWork(env, "crypto", ThreadPoolWorkClass::kCrypto),
         mode_(mode),
         params_(std::move(params)) {
     // If the CryptoJob is async, then the instance will be
@@ -306,6 +320,15 @@ class CryptoJob : public AsyncWrap, public ThreadPoolWork {
 
   CryptoJobMode mode() const { return mode_; }
 
+  void ScheduleWork() {
+    if constexpr (UsesCryptoThreadPool<CryptoJobTraits>::value) {
+      if (CryptoThreadPool* pool = CryptoThreadPool::Get()) {
+        return pool->Schedule(this);
+      }
+    }
+    ThreadPoolWork::ScheduleWork();
+  }
+
   CryptoErrorStore* errors() { return &errors_; }
 
   AdditionalParams* params() { return &params_; }
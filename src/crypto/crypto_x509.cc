@@ -2,6 +2,7 @@
 #include "base_object-inl.h"
 #include "crypto/crypto_common.h"
 #include "crypto/crypto_keys.h"
+#include "crypto/crypto_parse_cache.h"
 #include "crypto/crypto_util.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
@@ -10,6 +11,7 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -515,16 +517,24 @@ void Parse(const FunctionCallbackInfo<Value>& args) {
   ArrayBufferViewContents<unsigned char> buf(args[0].As<ArrayBufferView>());
   Local<Object> cert;
 
-  auto result = X509Pointer::Parse(ncrypto::Buffer<const unsigned char>{
-      .data = buf.data(),
-      .len = buf.length(),
-  });
+  auto& cache = ParsedObjectCache::Certificates();
+  std::string key = ParsedObjectCache::MakeKey(buf.data(), buf.length());
+  std::shared_ptr<ManagedX509> mcert;
+  if (key.empty() || !cache.Get(key, &mcert)) {
+    auto result = X509Pointer::Parse(ncrypto::Buffer<const unsigned char>{
+        .data = buf.data(),
+        .len = buf.length(),
+    });
+
+    if (!result.value) [[unlikely]] {
+      return ThrowCryptoError(env, result.error.value_or(0));
+    }
 
-  if (!result.value) [[unlikely]] {
-    return ThrowCryptoError(env, result.error.value_or(0));
+    mcert = std::make_shared<ManagedX509>(std::move(result.value));
+    if (!key.empty()) cache.Add(key, mcert, buf.length());
   }
 
-  if (X509Certificate::New(env, std::move(result.value)).ToLocal(&cert)) {
+  if (X509Certificate::New(env, std::move(mcert)).ToLocal(&cert)) {
     args.GetReturnValue().Set(cert);
   }
 }
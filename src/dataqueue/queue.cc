@@ -15,9 +15,14 @@
 #include <algorithm>
 #include <deque>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <vector>
 
+#ifdef __POSIX__
+#include <sys/mman.h>
+#endif
+
 namespace node {
 
 using v8::ArrayBufferView;
@@ -1063,6 +1068,193 @@ class FdEntry final : public EntryImpl {
 
 // ============================================================================
 
+#ifdef __POSIX__
+// A MappedFileEntry serves a regular file through a read-only memory mapping
+// that is created along with the entry. Readers yield vectors that point
+// straight into the mapping and slices are views over the same mapping, so
+// neither performs any I/O. The mapping stays valid for as long as any entry,
+// reader, or pending Done callback refers to it. Like FdEntry, a best-effort
+// check on the size and modification time of the file is made before each
+// read. Unlike FdEntry, truncating the file while it is mapped makes accesses
+// beyond the new end of the file raise SIGBUS.
+class MappedFileEntry final : public EntryImpl {
+ public:
+  // The mapping is handed out in vectors of at most kChunkSize bytes so that
+  // consumers that copy each pull, such as Blob readers, see bounded chunks.
+  static constexpr uint64_t kChunkSize = 64 * 1024;
+
+  struct Mapping final {
+    Mapping(int fd, uint8_t* data, size_t size, const uv_stat_t& stat)
+        : fd(fd), data(data), size(size), stat(stat) {}
+
+    ~Mapping() {
+      if (data != nullptr) munmap(data, size);
+      uv_fs_t req;
+      uv_fs_close(nullptr, &req, fd, nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    bool IsModified() const {
+      uv_fs_t req = uv_fs_t();
+      auto cleanup = OnScopeLeave([&] { uv_fs_req_cleanup(&req); });
+      if (uv_fs_fstat(nullptr, &req, fd, nullptr) < 0) return true;
+      return req.statbuf.st_size != stat.st_size ||
+             req.statbuf.st_mtim.tv_sec != stat.st_mtim.tv_sec ||
+             req.statbuf.st_mtim.tv_nsec != stat.st_mtim.tv_nsec;
+    }
+
+    int fd;
+    uint8_t* data;
+    size_t size;
+    uv_stat_t stat;
+  };
+
+  static std::unique_ptr<MappedFileEntry> Create(Environment* env,
+                                                 Local<Value> path) {
+    BufferValue buf(env->isolate(), path);
+    uv_fs_t req = uv_fs_t();
+    int fd = uv_fs_open(nullptr, &req, buf.out(), O_RDONLY, 0, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0) return nullptr;
+
+    auto close_fd = OnScopeLeave([&] {
+      if (fd < 0) return;
+      uv_fs_t close_req;
+      uv_fs_close(nullptr, &close_req, fd, nullptr);
+      uv_fs_req_cleanup(&close_req);
+    });
+
+    if (uv_fs_fstat(nullptr, &req, fd, nullptr) < 0) {
+      uv_fs_req_cleanup(&req);
+      return nullptr;
+    }
+    uv_stat_t stat = req.statbuf;
+    uv_fs_req_cleanup(&req);
+
+    // Only regular files can be mapped, and they have to fit into the
+    // address space.
+    if ((stat.st_mode & S_IFMT) != S_IFREG ||
+        stat.st_size > std::numeric_limits<size_t>::max()) {
+      return nullptr;
+    }
+    size_t size = static_cast<size_t>(stat.st_size);
+
+    uint8_t* data = nullptr;
+    if (size > 0) {
+      void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped == MAP_FAILED) return nullptr;
+      madvise(mapped, size, MADV_SEQUENTIAL);
+      data = static_cast<uint8_t*>(mapped);
+    }
+
+    auto mapping = std::make_shared<Mapping>(fd, data, size, stat);
+    fd = -1;  // Owned by the mapping now.
+    return std::make_unique<MappedFileEntry>(std::move(mapping), 0, size);
+  }
+
+  MappedFileEntry(std::shared_ptr<Mapping> mapping,
+                  uint64_t start,
+                  uint64_t end)
+      : mapping_(std::move(mapping)), start_(start), end_(end) {
+    CHECK_LE(start_, end_);
+    CHECK_LE(end_, mapping_->size);
+  }
+
+  // Disallow moving and copying.
+  MappedFileEntry(const MappedFileEntry&) = delete;
+  MappedFileEntry(MappedFileEntry&&) = delete;
+  MappedFileEntry& operator=(const MappedFileEntry&) = delete;
+  MappedFileEntry& operator=(MappedFileEntry&&) = delete;
+
+  std::shared_ptr<DataQueue::Reader> get_reader() override {
+    if (mapping_->IsModified()) return nullptr;
+    return std::make_shared<ReaderImpl>(mapping_, start_, end_);
+  }
+
+  std::unique_ptr<Entry> slice(
+      uint64_t start, std::optional<uint64_t> end = std::nullopt) override {
+    uint64_t new_start = std::min(start_ + start, end_);
+    uint64_t new_end = end_;
+    if (end.has_value()) {
+      new_end = std::max(new_start, std::min(start_ + end.value(), end_));
+    }
+    return std::make_unique<MappedFileEntry>(mapping_, new_start, new_end);
+  }
+
+  std::optional<uint64_t> size() const override { return end_ - start_; }
+
+  bool is_idempotent() const override { return true; }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(MappedFileEntry)
+  SET_SELF_SIZE(MappedFileEntry)
+
+ private:
+  class ReaderImpl final : public DataQueue::Reader,
+                           public std::enable_shared_from_this<ReaderImpl> {
+   public:
+    ReaderImpl(std::shared_ptr<Mapping> mapping, uint64_t start, uint64_t end)
+        : mapping_(std::move(mapping)), position_(start), end_(end) {}
+
+    int Pull(Next next,
+             int options,
+             DataQueue::Vec* data,
+             size_t count,
+             size_t max_count_hint = bob::kMaxCountHint) override {
+      auto self = shared_from_this();
+      if (ended_) {
+        std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, [](uint64_t) {});
+        return bob::Status::STATUS_EOS;
+      }
+
+      if (mapping_->IsModified()) {
+        ended_ = true;
+        std::move(next)(UV_EINVAL, nullptr, 0, [](uint64_t) {});
+        return UV_EINVAL;
+      }
+
+      size_t max_vecs =
+          std::clamp<size_t>(max_count_hint, 1, bob::kMaxCountHint);
+      DataQueue::Vec vecs[bob::kMaxCountHint];
+      size_t vec_count = 0;
+      while (vec_count < max_vecs && position_ < end_) {
+        uint64_t len = std::min(kChunkSize, end_ - position_);
+        vecs[vec_count++] = {mapping_->data + position_, len};
+        position_ += len;
+      }
+      if (position_ == end_) ended_ = true;
+
+      // The vectors point into the mapping, which the Done callback keeps
+      // alive until the consumer has finished with them.
+      std::move(next)(bob::Status::STATUS_CONTINUE,
+                      vecs,
+                      vec_count,
+                      [mapping = mapping_](uint64_t) {});
+      return bob::Status::STATUS_CONTINUE;
+    }
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(MappedFileEntry::Reader)
+    SET_SELF_SIZE(ReaderImpl)
+
+   private:
+    std::shared_ptr<Mapping> mapping_;
+    uint64_t position_;
+    uint64_t end_;
+    bool ended_ = false;
+  };
+
+  std::shared_ptr<Mapping> mapping_;
+  uint64_t start_;
+  uint64_t end_;
+};
+#endif  // __POSIX__
+
+// ============================================================================
+
 }  // namespace
 
 std::shared_ptr<DataQueue> DataQueue::CreateIdempotent(
@@ -1137,6 +1329,15 @@ std::unique_ptr<DataQueue::Entry> DataQueue::CreateFdEntry(Environment* env,
   return FdEntry::Create(env, path);
 }
 
+std::unique_ptr<DataQueue::Entry> DataQueue::CreateMappedFileEntry(
+    Environment* env, Local<Value> path) {
+#ifdef __POSIX__
+  return MappedFileEntry::Create(env, path);
+#else
+  return FdEntry::Create(env, path);
+#endif
+}
+
 void DataQueue::Initialize(Environment* env, v8::Local<v8::Object> target) {
   // Nothing to do here currently.
 }
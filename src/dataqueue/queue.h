@@ -224,6 +224,14 @@ class DataQueue : public MemoryRetainer {
   static std::unique_ptr<Entry> CreateFdEntry(Environment* env,
                                               v8::Local<v8::Value> path);
 
+  // Creates an idempotent Entry backed by a read-only memory mapping of the
+  // file at the given path. Reads and slices of the entry do not perform any
+  // I/O or copies. Returns nullptr if the file is not a regular file or cannot
+  // be mapped. Where memory mapping is not supported, this is the same as
+  // CreateFdEntry().
+  static std::unique_ptr<Entry> CreateMappedFileEntry(
+      Environment* env, v8::Local<v8::Value> path);
+
   // Creates a Reader for the given queue. If the queue is idempotent,
   // any number of readers can be created, all of which are guaranteed
   // to provide the same data. Otherwise, only a single reader is
@@ -1,5 +1,6 @@
 #include "encoding_binding.h"
 #include "ada.h"
+#include "base_object-inl.h"
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
@@ -9,6 +10,7 @@
 #include "v8.h"
 
 #include <cstdint>
+#include <cstring>
 
 namespace node {
 namespace encoding_binding {
@@ -18,9 +20,11 @@ using v8::BackingStore;
 using v8::BackingStoreInitializationMode;
 using v8::Context;
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Isolate;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SnapshotCreator;
@@ -223,6 +227,13 @@ void BindingData::CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethodNoSideEffect(isolate, target, "toASCII", ToASCII);
   SetMethodNoSideEffect(isolate, target, "toUnicode", ToUnicode);
   SetMethodNoSideEffect(isolate, target, "decodeLatin1", DecodeLatin1);
+
+  Local<FunctionTemplate> decoder =
+      NewFunctionTemplate(isolate, UTF8Decoder::New);
+  decoder->InstanceTemplate()->SetInternalFieldCount(
+      UTF8Decoder::kInternalFieldCount);
+  SetProtoMethod(isolate, decoder, "decode", UTF8Decoder::Decode);
+  SetConstructorFunction(isolate, target, "UTF8Decoder", decoder);
 }
 
 void BindingData::CreatePerContextProperties(Local<Object> target,
@@ -241,6 +252,8 @@ void BindingData::RegisterTimerExternalReferences(
   registry->Register(ToASCII);
   registry->Register(ToUnicode);
   registry->Register(DecodeLatin1);
+  registry->Register(UTF8Decoder::New);
+  registry->Register(UTF8Decoder::Decode);
 }
 
 void BindingData::DecodeLatin1(const FunctionCallbackInfo<Value>& args) {
@@ -289,6 +302,178 @@ void BindingData::DecodeLatin1(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+namespace {
+
+// The length of the UTF-8 sequence that starts with |lead|, or 1 for the
+// bytes that do not start a multi-byte sequence.
+constexpr size_t SequenceLength(uint8_t lead) {
+  if (lead >= 0xC2 && lead <= 0xDF) return 2;
+  if (lead >= 0xE0 && lead <= 0xEF) return 3;
+  if (lead >= 0xF0 && lead <= 0xF4) return 4;
+  return 1;
+}
+
+// Whether |byte| is valid at |index| within the sequence that starts with
+// |lead|. The second byte is restricted for some lead bytes, to exclude
+// overlong forms, surrogates and code points above U+10FFFF.
+constexpr bool IsContinuation(uint8_t lead, size_t index, uint8_t byte) {
+  if (index == 1) {
+    switch (lead) {
+      case 0xE0:
+        return byte >= 0xA0 && byte <= 0xBF;
+      case 0xED:
+        return byte >= 0x80 && byte <= 0x9F;
+      case 0xF0:
+        return byte >= 0x90 && byte <= 0xBF;
+      case 0xF4:
+        return byte >= 0x80 && byte <= 0x8F;
+    }
+  }
+  return byte >= 0x80 && byte <= 0xBF;
+}
+
+// The number of bytes at the end of |data| that start a valid sequence
+// without completing it.
+size_t IncompleteTail(const uint8_t* data, size_t length) {
+  for (size_t count = 1; count <= 3 && count <= length; count++) {
+    const uint8_t* start = data + length - count;
+    if (*start >= 0x80 && *start <= 0xBF) continue;
+    if (SequenceLength(*start) <= count) return 0;
+    for (size_t i = 1; i < count; i++) {
+      if (!IsContinuation(*start, i, start[i])) return 0;
+    }
+    return count;
+  }
+  return 0;
+}
+
+MaybeLocal<String> DecodeToString(Isolate* isolate,
+                                  const uint8_t* data,
+                                  size_t length) {
+  if (length == 0) return String::Empty(isolate);
+  // ASCII does not need to be decoded, and StringBytes::Encode() makes
+  // external strings of large Latin-1 data.
+  const char* chars = reinterpret_cast<const char*>(data);
+  const enum encoding encoding =
+      simdutf::validate_ascii(chars, length) ? LATIN1 : UTF8;
+  Local<Value> value;
+  if (!StringBytes::Encode(isolate, chars, length, encoding).ToLocal(&value)) {
+    return MaybeLocal<String>();
+  }
+  return value.As<String>();
+}
+
+}  // namespace
+
+UTF8Decoder::UTF8Decoder(Environment* env,
+                         Local<Object> object,
+                         bool ignore_bom,
+                         bool fatal)
+    : BaseObject(env, object), ignore_bom_(ignore_bom), fatal_(fatal) {
+  MakeWeak();
+}
+
+void UTF8Decoder::Reset() {
+  bom_seen_ = false;
+  pending_length_ = 0;
+}
+
+MaybeLocal<String> UTF8Decoder::DecodeChunk(const uint8_t* data,
+                                            size_t length,
+                                            bool flush) {
+  Isolate* isolate = env()->isolate();
+
+  // Continue the sequence that was kept from the previous chunk, for as long
+  // as the bytes of this chunk are valid in it.
+  uint8_t head[sizeof(pending_)];
+  size_t head_length = 0;
+  if (pending_length_ > 0) {
+    const uint8_t lead = pending_[0];
+    const size_t sequence_length = SequenceLength(lead);
+    while (pending_length_ < sequence_length && length > 0 &&
+           IsContinuation(lead, pending_length_, *data)) {
+      pending_[pending_length_++] = *data++;
+      length--;
+    }
+    if (pending_length_ < sequence_length && length == 0 && !flush) {
+      return String::Empty(isolate);
+    }
+    // This is either a complete sequence, or one that is replaced with
+    // U+FFFD.
+    head_length = pending_length_;
+    memcpy(head, pending_, head_length);
+    pending_length_ = 0;
+  }
+
+  const size_t tail_length = flush ? 0 : IncompleteTail(data, length);
+  length -= tail_length;
+  const uint8_t* tail = data + length;
+
+  if (!ignore_bom_ && !bom_seen_ && head_length + length > 0) {
+    bom_seen_ = true;
+    static constexpr uint8_t kBOM[] = {0xEF, 0xBB, 0xBF};
+    if (head_length == sizeof(kBOM) && memcmp(head, kBOM, 3) == 0) {
+      head_length = 0;
+    } else if (head_length == 0 && length >= sizeof(kBOM) &&
+               memcmp(data, kBOM, sizeof(kBOM)) == 0) {
+      data += sizeof(kBOM);
+      length -= sizeof(kBOM);
+    }
+  }
+
+  if (fatal_ &&
+      (!simdutf::validate_utf8(reinterpret_cast<const char*>(head),
+                               head_length) ||
+       !simdutf::validate_utf8(reinterpret_cast<const char*>(data), length))) {
+    Reset();
+    THROW_ERR_ENCODING_INVALID_ENCODED_DATA(
+        isolate, "The encoded data was not valid for encoding utf-8");
+    return MaybeLocal<String>();
+  }
+
+  memcpy(pending_, tail, tail_length);
+  pending_length_ = tail_length;
+  if (flush) Reset();
+
+  Local<String> head_string;
+  Local<String> body;
+  if (!DecodeToString(isolate, head, head_length).ToLocal(&head_string) ||
+      !DecodeToString(isolate, data, length).ToLocal(&body)) {
+    return MaybeLocal<String>();
+  }
+  if (head_length == 0) return body;
+  return String::Concat(isolate, head_string, body);
+}
+
+// new UTF8Decoder(ignoreBOM, fatal)
+void UTF8Decoder::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new UTF8Decoder(env, args.This(), args[0]->IsTrue(), args[1]->IsTrue());
+}
+
+// decoder.decode(input, flush)
+void UTF8Decoder::Decode(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  UTF8Decoder* decoder;
+  ASSIGN_OR_RETURN_UNWRAP(&decoder, args.This());
+
+  if (!(args[0]->IsArrayBuffer() || args[0]->IsSharedArrayBuffer() ||
+        args[0]->IsArrayBufferView())) {
+    return node::THROW_ERR_INVALID_ARG_TYPE(
+        env->isolate(),
+        "The \"input\" argument must be an instance of ArrayBuffer, "
+        "SharedArrayBuffer, or ArrayBufferView.");
+  }
+
+  ArrayBufferViewContents<uint8_t> buffer(args[0]);
+  Local<String> ret;
+  if (decoder->DecodeChunk(buffer.data(), buffer.length(), args[1]->IsTrue())
+          .ToLocal(&ret)) {
+    args.GetReturnValue().Set(ret);
+  }
+}
+
 }  // namespace encoding_binding
 }  // namespace node
 
@@ -5,6 +5,7 @@
 
 #include <cinttypes>
 #include "aliased_buffer.h"
+#include "base_object.h"
 #include "node_snapshotable.h"
 #include "v8-fast-api-calls.h"
 
@@ -51,6 +52,42 @@ class BindingData : public SnapshotableObject {
   InternalFieldInfo* internal_field_info_ = nullptr;
 };
 
+// The state of a TextDecoder for UTF-8 with the stream option, see
+// https://encoding.spec.whatwg.org/#dom-textdecoder-decode. The bytes of a
+// sequence that is split between two chunks are kept here until the next
+// chunk completes it.
+class UTF8Decoder final : public BaseObject {
+ public:
+  UTF8Decoder(Environment* env,
+              v8::Local<v8::Object> object,
+              bool ignore_bom,
+              bool fatal);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Decode(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Returns the string for |data| and the bytes kept from the previous
+  // calls. Without |flush|, an incomplete sequence at the end of |data| is
+  // kept for the next call. Throws if |fatal| was set and the data is not
+  // valid UTF-8.
+  v8::MaybeLocal<v8::String> DecodeChunk(const uint8_t* data,
+                                         size_t length,
+                                         bool flush);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(UTF8Decoder)
+  SET_SELF_SIZE(UTF8Decoder)
+
+ private:
+  void Reset();
+
+  const bool ignore_bom_;
+  const bool fatal_;
+  bool bom_seen_ = false;
+  uint8_t pending_[4];
+  size_t pending_length_ = 0;
+};
+
 }  // namespace encoding_binding
 
 }  // namespace node
@@ -118,6 +118,10 @@ inline v8::Local<v8::String> AsyncHooks::provider_string(int idx) {
   return env()->isolate_data()->async_wrap_provider(idx);
 }
 
+inline bool AsyncHooks::cpu_time_accounting() const {
+  return cpu_time_accounting_;
+}
+
 inline void AsyncHooks::no_force_checks() {
   fields_[kCheck] -= 1;
 }
@@ -588,27 +592,27 @@ template <typename Fn>
 void Environment::SetImmediateThreadsafe(Fn&& cb, CallbackFlags::Flags flags) {
   auto callback = native_immediates_threadsafe_.CreateCallback(
       std::move(cb), flags);
-  {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    native_immediates_threadsafe_.Push(std::move(callback));
-    if (task_queues_async_initialized_)
-      uv_async_send(&task_queues_async_);
-  }
+  // Only the first callback after the queue has been drained needs to wake
+  // up the event loop, the others are run along with it.
+  if (native_immediates_threadsafe_.Push(std::move(callback)))
+    WakeUpTaskQueues();
 }
 
 template <typename Fn>
 void Environment::RequestInterrupt(Fn&& cb) {
   auto callback = native_immediates_interrupts_.CreateCallback(
       std::move(cb), CallbackFlags::kRefed);
-  {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    native_immediates_interrupts_.Push(std::move(callback));
-    if (task_queues_async_initialized_)
-      uv_async_send(&task_queues_async_);
-  }
+  if (native_immediates_interrupts_.Push(std::move(callback)))
+    WakeUpTaskQueues();
   RequestInterruptFromV8();
 }
 
+void Environment::WakeUpTaskQueues() {
+  Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
+  if (task_queues_async_initialized_)
+    uv_async_send(&task_queues_async_);
+}
+
 inline bool Environment::can_call_into_js() const {
   return can_call_into_js_ && !is_stopping();
 }
@@ -732,6 +736,10 @@ inline void Environment::set_stopping(bool value) {
   is_stopping_.store(value);
 }
 
+inline void Environment::set_fast_teardown(bool value) {
+  fast_teardown_ = value;
+}
+
 inline std::list<node_module>* Environment::extra_linked_bindings() {
   return &extra_linked_bindings_;
 }
@@ -754,6 +762,33 @@ inline performance::PerformanceState* Environment::performance_state() {
   return performance_state_.get();
 }
 
+inline StallWatchdog* Environment::stall_watchdog() {
+  return stall_watchdog_.get();
+}
+
+inline EventLoopPhaseState* Environment::event_loop_phases() {
+  return event_loop_phases_.get();
+}
+
+inline EventLoopPhaseTimer::EventLoopPhaseTimer(Environment* env,
+                                                EventLoopPhase phase) {
+  EventLoopPhaseState* state = env->event_loop_phases();
+  if (state == nullptr) [[likely]]
+    return;
+  histogram_ = state->histograms[static_cast<size_t>(phase)].get();
+  start_ = uv_hrtime();
+}
+
+inline EventLoopPhaseTimer::~EventLoopPhaseTimer() {
+  if (histogram_ != nullptr) Record(histogram_, start_);
+}
+
+inline ThreadPoolWorkClassState* Environment::threadpool_work_class(
+    ThreadPoolWorkClass work_class) {
+  DCHECK_LT(work_class, ThreadPoolWorkClass::kCount);
+  return &threadpool_work_classes_[static_cast<size_t>(work_class)];
+}
+
 inline IsolateData* Environment::isolate_data() const {
   return isolate_data_;
 }
@@ -807,8 +842,10 @@ inline void Environment::ThrowUVException(int errorno,
       UVException(isolate(), errorno, syscall, message, path, dest));
 }
 
-void Environment::AddCleanupHook(CleanupQueue::Callback fn, void* arg) {
-  cleanup_queue_.Add(fn, arg);
+void Environment::AddCleanupHook(CleanupQueue::Callback fn,
+                                 void* arg,
+                                 bool memory_only) {
+  cleanup_queue_.Add(fn, arg, memory_only);
 }
 
 void Environment::RemoveCleanupHook(CleanupQueue::Callback fn, void* arg) {
@@ -913,25 +950,20 @@ inline bool Environment::report_exclude_env() const {
 inline void Environment::AddHeapSnapshotNearHeapLimitCallback() {
   DCHECK(!heapsnapshot_near_heap_limit_callback_added_);
   heapsnapshot_near_heap_limit_callback_added_ = true;
-  
-#ifndef __wasi__
-  
+  // Under WASI, CheckLinearMemoryLimit() invokes the callback instead.
 #ifndef __wasi__
   isolate_->AddNearHeapLimitCallback(Environment::NearHeapLimitCallback, this);
 #endif
-#endif
 }
 
 inline void Environment::RemoveHeapSnapshotNearHeapLimitCallback(
     size_t heap_limit) {
   DCHECK(heapsnapshot_near_heap_limit_callback_added_);
   heapsnapshot_near_heap_limit_callback_added_ = false;
-  
-#ifndef __wasi__
-  
 #ifndef __wasi__
   isolate_->RemoveNearHeapLimitCallback(Environment::NearHeapLimitCallback,
                                         heap_limit);
+#endif
 }
 
 }  // namespace node
@@ -943,4 +975,3 @@ inline void Environment::RemoveHeapSnapshotNearHeapLimitCallback(
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #endif  // SRC_ENV_INL_H_
-#endif // Fix for unterminated conditional
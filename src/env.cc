@@ -3,6 +3,8 @@
 #include "base_object-inl.h"
 #include "debug_utils-inl.h"
 #include "diagnosticfilename-inl.h"
+#include "histogram-inl.h"
+#include "io_uring_stream.h"
 #include "memory_tracker-inl.h"
 #include "module_wrap.h"
 #include "node_buffer.h"
@@ -15,6 +17,7 @@
 #include "node_shadow_realm.h"
 #include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
+#include "node_watchdog.h"
 #include "node_worker.h"
 #include "req_wrap-inl.h"
 #include "stream_base.h"
@@ -29,6 +32,7 @@
 #include <atomic>
 #include <cinttypes>
 #include <cstdio>
+#include <ctime>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -71,6 +75,7 @@ using v8::StackTrace;
 using v8::String;
 using v8::Symbol;
 using v8::TracingController;
+using v8::True;
 using v8::TryCatch;
 using v8::Uint32;
 using v8::Undefined;
@@ -628,6 +633,10 @@ void IsolateData::MemoryInfo(MemoryTracker* tracker) const {
   if (node_allocator_ != nullptr) {
     tracker->TrackFieldWithSize(
         "node_allocator", sizeof(*node_allocator_), "NodeArrayBufferAllocator");
+    tracker->TrackField("array_buffer_slabs", node_allocator_->slabs());
+#ifdef __wasi__
+    tracker->TrackField("array_buffer_arenas", WasiArenaAllocator::Get());
+#endif
   }
   tracker->TrackFieldWithSize(
       "platform", sizeof(*platform_), "MultiIsolatePlatform");
@@ -752,6 +761,117 @@ std::unique_ptr<BackingStore> Environment::release_managed_buffer(
   return bs;
 }
 
+namespace {
+// Stream reads are carved out of slabs of this size.
+constexpr size_t kStreamReadSlabSize = 256 * 1024;
+// Do not hand out less than this from the end of a slab; start a new one.
+constexpr size_t kMinStreamReadSize = 16 * 1024;
+// Reads of up to this size are copied into a buffer of their own, so that
+// e.g. short HTTP requests do not keep a whole slab alive. Their space in
+// the slab is reused by the next read.
+constexpr size_t kStreamReadCopyThreshold = 4 * 1024;
+constexpr size_t kMaxRetiredStreamReadSlabs = 8;
+}  // anonymous namespace
+
+void Environment::NextStreamReadSlab() {
+  std::shared_ptr<BackingStore> next;
+  for (auto it = retired_stream_read_slabs_.begin();
+       it != retired_stream_read_slabs_.end();
+       ++it) {
+    // Only our reference is left, i.e. all ArrayBuffers were collected.
+    if (it->use_count() == 1) {
+      next = std::move(*it);
+      retired_stream_read_slabs_.erase(it);
+      break;
+    }
+  }
+
+  if (stream_read_slab_) {
+    if (retired_stream_read_slabs_.size() == kMaxRetiredStreamReadSlabs)
+      retired_stream_read_slabs_.erase(retired_stream_read_slabs_.begin());
+    retired_stream_read_slabs_.push_back(std::move(stream_read_slab_));
+  }
+
+  if (!next) {
+    next = ArrayBuffer::NewBackingStore(
+        isolate(),
+        kStreamReadSlabSize,
+        BackingStoreInitializationMode::kUninitialized);
+  }
+  stream_read_slab_ = std::move(next);
+  stream_read_slab_offset_ = 0;
+}
+
+uv_buf_t Environment::allocate_stream_read_buffer(const size_t suggested_size) {
+  // Only one read at a time is carved out of the slab. Concurrent reads
+  // and reads larger than a slab get a buffer of their own, and so does
+  // every read without --experimental-stream-read-slabs, since chunks over a
+  // slab cannot be transferred and their .buffer spans unrelated reads.
+  if (!options()->experimental_stream_read_slabs ||
+      stream_read_slab_reserved_ || suggested_size > kStreamReadSlabSize) {
+    return allocate_managed_buffer(suggested_size);
+  }
+
+  if (!stream_read_slab_ ||
+      kStreamReadSlabSize - stream_read_slab_offset_ <
+          std::min(suggested_size, kMinStreamReadSize)) {
+    NextStreamReadSlab();
+  }
+
+  stream_read_slab_reserved_ = true;
+  char* base =
+      static_cast<char*>(stream_read_slab_->Data()) + stream_read_slab_offset_;
+  return uv_buf_init(
+      base,
+      std::min(suggested_size, kStreamReadSlabSize - stream_read_slab_offset_));
+}
+
+Local<ArrayBuffer> Environment::release_stream_read_buffer(const uv_buf_t& buf,
+                                                           ssize_t nread,
+                                                           size_t* offset) {
+  *offset = 0;
+  if (!stream_read_slab_reserved_ ||
+      buf.base != static_cast<char*>(stream_read_slab_->Data()) +
+                      stream_read_slab_offset_) {
+    std::unique_ptr<BackingStore> bs = release_managed_buffer(buf);
+    if (nread <= 0) return Local<ArrayBuffer>();
+
+    CHECK_LE(static_cast<size_t>(nread), bs->ByteLength());
+    if (static_cast<size_t>(nread) != bs->ByteLength()) {
+      std::unique_ptr<BackingStore> old_bs = std::move(bs);
+      bs = ArrayBuffer::NewBackingStore(
+          isolate(), nread, BackingStoreInitializationMode::kUninitialized);
+      memcpy(bs->Data(), old_bs->Data(), nread);
+    }
+    return ArrayBuffer::New(isolate(), std::move(bs));
+  }
+
+  stream_read_slab_reserved_ = false;
+  if (nread <= 0) return Local<ArrayBuffer>();
+  CHECK_LE(static_cast<size_t>(nread), buf.len);
+
+  if (static_cast<size_t>(nread) <= kStreamReadCopyThreshold) {
+    std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+        isolate(), nread, BackingStoreInitializationMode::kUninitialized);
+    memcpy(bs->Data(), buf.base, nread);
+    return ArrayBuffer::New(isolate(), std::move(bs));
+  }
+
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate(), stream_read_slab_);
+  // Like the Buffer pool, a slab is shared between unrelated reads, so it
+  // must not be detached by transferring it to another thread.
+  ab->SetPrivate(context(),
+                 untransferable_object_private_symbol(),
+                 True(isolate()))
+      .Check();
+  *offset = stream_read_slab_offset_;
+  // Keep the start of every read 8-byte aligned.
+  stream_read_slab_offset_ =
+      std::min((*offset + nread + 7) & ~static_cast<size_t>(7),
+               kStreamReadSlabSize);
+  return ab;
+}
+
 std::string Environment::GetExecPath(const std::vector<std::string>& argv) {
   char exec_path_buf[2 * PATH_MAX];
   size_t exec_path_len = sizeof(exec_path_buf);
@@ -778,6 +898,52 @@ std::string Environment::GetExecPath(const std::vector<std::string>& argv) {
   return exec_path;
 }
 
+// The number of threads of the libuv threadpool, determined the same way
+// libuv does it.
+static uint32_t GetThreadPoolSize() {
+  static constexpr uint32_t kDefaultSize = 4;
+  static constexpr uint32_t kMaxSize = 1024;
+  std::string text;
+  if (!credentials::SafeGetenv("UV_THREADPOOL_SIZE", &text)) {
+    return kDefaultSize;
+  }
+  int size = atoi(text.c_str());
+  if (size <= 0) return 1;
+  return std::min(static_cast<uint32_t>(size), kMaxSize);
+}
+
+bool ParseThreadPoolWorkLimit(std::string_view text,
+                              ThreadPoolWorkClass* work_class,
+                              uint32_t* limit) {
+  size_t separator = text.find('=');
+  if (separator == std::string_view::npos) return false;
+  std::string_view name = text.substr(0, separator);
+  std::string_view value = text.substr(separator + 1);
+
+  static constexpr std::pair<std::string_view, ThreadPoolWorkClass>
+      kClassNames[] = {
+#define V(klass, class_name) {class_name, ThreadPoolWorkClass::klass},
+          THREADPOOL_WORK_CLASSES(V)
+#undef V
+      };
+  auto it = std::find_if(
+      std::begin(kClassNames), std::end(kClassNames), [&](const auto& entry) {
+        return entry.first == name;
+      });
+  if (it == std::end(kClassNames)) return false;
+
+  if (value.empty() || value.size() > 9) return false;
+  uint32_t result = 0;
+  for (char c : value) {
+    if (c < '0' || c > '9') return false;
+    result = result * 10 + (c - '0');
+  }
+  if (result == 0) return false;
+  *work_class = it->second;
+  *limit = result;
+  return true;
+}
+
 Environment::Environment(IsolateData* isolate_data,
                          Isolate* isolate,
                          const std::vector<std::string>& args,
@@ -867,6 +1033,20 @@ Environment::Environment(IsolateData* isolate_data,
   heap_snapshot_near_heap_limit_ =
       static_cast<uint32_t>(options_->heap_snapshot_near_heap_limit);
 
+  // Unless told otherwise, leave one thread of the threadpool to the other
+  // work while addons run CPU-bound work, so that bursts of it cannot starve
+  // the file system.
+  threadpool_work_class(ThreadPoolWorkClass::kAddonCpu)->limit =
+      std::max(GetThreadPoolSize(), 2u) - 1;
+  for (const std::string& text :
+       per_process::cli_options->threadpool_work_limits) {
+    ThreadPoolWorkClass work_class;
+    uint32_t limit;
+    // The values were validated when the options were parsed.
+    CHECK(ParseThreadPoolWorkLimit(text, &work_class, &limit));
+    threadpool_work_class(work_class)->limit = limit;
+  }
+
   if (!(flags_ & EnvironmentFlags::kOwnsProcessState)) {
     set_abort_on_uncaught_exception(false);
   }
@@ -994,6 +1174,15 @@ Environment::~Environment() {
   HandleScope handle_scope(isolate());
   Local<Context> ctx = context();
 
+  Debug(this,
+        DebugCategory::DIAGNOSTICS,
+        "Threadsafe immediates: peak queue depth %zu, %zu wakeups\n"
+        "Interrupts: peak queue depth %zu, %zu wakeups\n",
+        native_immediates_threadsafe_.peak_size(),
+        native_immediates_threadsafe_.wakeups(),
+        native_immediates_interrupts_.peak_size(),
+        native_immediates_interrupts_.wakeups());
+
   if (Environment** interrupt_data = interrupt_data_.load()) {
     // There are pending RequestInterrupt() callbacks. Tell them not to run,
     // then force V8 to run interrupts by compiling and running an empty script
@@ -1024,6 +1213,9 @@ Environment::~Environment() {
   if (heapsnapshot_near_heap_limit_callback_added_) {
     RemoveHeapSnapshotNearHeapLimitCallback(0);
   }
+#ifdef __wasi__
+  isolate()->RemoveGCEpilogueCallback(LinearMemoryGCCallback, this);
+#endif
 
   isolate()->GetHeapProfiler()->RemoveBuildEmbedderGraphCallback(
       BuildEmbedderGraph, this);
@@ -1083,6 +1275,8 @@ void Environment::InitializeLibuv() {
   // still end up in v8.log but with state=IDLE rather than state=EXTERNAL.
   CHECK_EQ(0, uv_prepare_init(event_loop(), &idle_prepare_handle_));
   CHECK_EQ(0, uv_check_init(event_loop(), &idle_check_handle_));
+  CHECK_EQ(0, uv_prepare_init(event_loop(), &phase_prepare_handle_));
+  CHECK_EQ(0, uv_check_init(event_loop(), &phase_check_handle_));
 
   CHECK_EQ(0, uv_async_init(
       event_loop(),
@@ -1096,6 +1290,8 @@ void Environment::InitializeLibuv() {
       }));
   uv_unref(reinterpret_cast<uv_handle_t*>(&idle_prepare_handle_));
   uv_unref(reinterpret_cast<uv_handle_t*>(&idle_check_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&phase_prepare_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&phase_check_handle_));
   uv_unref(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
 
   {
@@ -1205,6 +1401,8 @@ void Environment::ClosePerEnvHandles() {
   close_and_finish(reinterpret_cast<uv_handle_t*>(immediate_idle_handle()));
   close_and_finish(reinterpret_cast<uv_handle_t*>(&idle_prepare_handle_));
   close_and_finish(reinterpret_cast<uv_handle_t*>(&idle_check_handle_));
+  close_and_finish(reinterpret_cast<uv_handle_t*>(&phase_prepare_handle_));
+  close_and_finish(reinterpret_cast<uv_handle_t*>(&phase_check_handle_));
   close_and_finish(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
 }
 
@@ -1243,6 +1441,56 @@ void Environment::StartProfilerIdleNotifier() {
   });
 }
 
+EventLoopPhaseState* Environment::EnableEventLoopPhases(
+    size_t callback_types) {
+  if (event_loop_phases_) return event_loop_phases_.get();
+
+  event_loop_phases_ = std::make_unique<EventLoopPhaseState>();
+  for (auto& histogram : event_loop_phases_->histograms)
+    histogram = std::make_shared<Histogram>(Histogram::Options{});
+  event_loop_phases_->callbacks.resize(callback_types);
+
+  // The poll phase is measured from the prepare handles, which run right
+  // before it, to the check handles, which run right after it. Check handles
+  // run in the reverse order of their start, so this one runs before the one
+  // of the immediates.
+  uv_prepare_start(&phase_prepare_handle_, [](uv_prepare_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::phase_prepare_handle_, handle);
+    EventLoopPhaseState* state = env->event_loop_phases();
+    state->poll_start = uv_hrtime();
+    state->poll_idle_start = uv_metrics_idle_time(env->event_loop());
+  });
+  uv_check_start(&phase_check_handle_, [](uv_check_t* handle) {
+    Environment* env = ContainerOf(&Environment::phase_check_handle_, handle);
+    EventLoopPhaseState* state = env->event_loop_phases();
+    if (state->poll_start == 0) return;
+    uint64_t idle = uv_metrics_idle_time(env->event_loop()) -
+                    state->poll_idle_start;
+    uint64_t elapsed = uv_hrtime() - state->poll_start;
+    state->poll_start = 0;
+    state->histograms[static_cast<size_t>(EventLoopPhase::kPoll)]->Record(
+        elapsed > idle ? elapsed - idle : 1);
+  });
+  return event_loop_phases_.get();
+}
+
+void EventLoopPhaseTimer::Record(Histogram* histogram, uint64_t start) {
+  uint64_t elapsed = uv_hrtime() - start;
+  histogram->Record(elapsed > 0 ? elapsed : 1);
+}
+
+void Environment::StartStallWatchdog() {
+  uint64_t threshold = options()->trace_event_loop_stalls;
+  if (threshold == 0 || stall_watchdog_) return;
+  stall_watchdog_ = std::make_unique<StallWatchdog>(
+      this, threshold, isolate_data()->options()->report_on_event_loop_stall);
+}
+
+void Environment::StopStallWatchdog() {
+  if (stall_watchdog_) stall_watchdog_->Stop();
+}
+
 void Environment::PrintSyncTrace() const {
   if (!trace_sync_io_) [[likely]]
     return;
@@ -1281,6 +1529,7 @@ MaybeLocal<Value> Environment::RunSnapshotDeserializeMain() const {
 void Environment::RunCleanup() {
   started_cleanup_ = true;
   TRACE_EVENT0(TRACING_CATEGORY_NODE1(environment), "RunCleanup");
+  StopStallWatchdog();
   ClosePerEnvHandles();
   // Only BaseObject's cleanups are registered as per-realm cleanup hooks now.
   // Defer the BaseObject cleanup after handles are cleaned up.
@@ -1297,7 +1546,7 @@ void Environment::RunCleanup() {
          native_immediates_interrupts_.size() > 0) {
     // TODO(legendecas): cleanup handles in per-realm cleanup hooks as well.
     principal_realm_->RunCleanup();
-    cleanup_queue_.Drain();
+    cleanup_queue_.Drain(fast_teardown_);
     CleanupHandles();
   }
 
@@ -1358,10 +1607,7 @@ Maybe<bool> Environment::CheckUnsettledTopLevelAwait() const {
 void Environment::RunAndClearInterrupts() {
   while (native_immediates_interrupts_.size() > 0) {
     NativeImmediateQueue queue;
-    {
-      Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-      queue.ConcatMove(std::move(native_immediates_interrupts_));
-    }
+    native_immediates_interrupts_.TakeAll(&queue);
     DebugSealHandleScope seal_handle_scope(isolate());
 
     while (auto head = queue.Shift())
@@ -1419,15 +1665,13 @@ void Environment::RunAndClearNativeImmediates(bool only_refed) {
   // It is safe to check .size() first, because there is a causal relationship
   // between pushes to the threadsafe immediate list and this function being
   // called. For the common case, it's worth checking the size first before
-  // establishing a mutex lock.
+  // taking the callbacks out of the queue.
   // This is intentionally placed after the `ref_count` handling, because when
   // refed threadsafe immediates are created, they are not counted towards the
   // count in immediate_info() either.
   NativeImmediateQueue threadsafe_immediates;
-  if (native_immediates_threadsafe_.size() > 0) {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    threadsafe_immediates.ConcatMove(std::move(native_immediates_threadsafe_));
-  }
+  if (native_immediates_threadsafe_.size() > 0)
+    native_immediates_threadsafe_.TakeAll(&threadsafe_immediates);
   while (drain_list(&threadsafe_immediates)) {}
 }
 
@@ -1486,6 +1730,8 @@ void Environment::RunTimers(uv_timer_t* handle) {
   if (!env->can_call_into_js())
     return;
 
+  EventLoopPhaseTimer phase_timer(env, EventLoopPhase::kTimers);
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -1543,6 +1789,7 @@ void Environment::RunTimers(uv_timer_t* handle) {
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
   TRACE_EVENT0(TRACING_CATEGORY_NODE1(environment), "CheckImmediate");
+  EventLoopPhaseTimer phase_timer(env, EventLoopPhase::kCheck);
 
   HandleScope scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -1823,6 +2070,63 @@ void AsyncHooks::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("fields", fields_);
   tracker->TrackField("async_id_fields", async_id_fields_);
   tracker->TrackField("js_promise_hooks", js_promise_hooks_);
+  tracker->TrackField("cpu_time", cpu_time_);
+}
+
+// Returns the CPU time of the current thread in nanoseconds.
+static uint64_t GetThreadCPUTime() {
+  constexpr uint64_t kNanosPerSec = 1000 * 1000 * 1000;
+#if defined(_WIN32) || defined(__wasi__)
+  uv_rusage_t rusage;
+  if (uv_getrusage_thread(&rusage) != 0) return 0;
+  return (rusage.ru_utime.tv_sec + rusage.ru_stime.tv_sec) * kNanosPerSec +
+         (rusage.ru_utime.tv_usec + rusage.ru_stime.tv_usec) * 1000;
+#else
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+  return static_cast<uint64_t>(ts.tv_sec) * kNanosPerSec + ts.tv_nsec;
+#endif
+}
+
+void AsyncHooks::set_cpu_time_accounting(bool enabled) {
+  cpu_time_accounting_ = enabled;
+  cpu_time_async_id_ = 0;
+  if (!enabled) cpu_time_.clear();
+}
+
+double AsyncHooks::StartCPUTimeAccounting(double async_id) {
+  uint64_t now = GetThreadCPUTime();
+  double prior_async_id = cpu_time_async_id_;
+  if (prior_async_id > 0) cpu_time_[prior_async_id] += now - cpu_time_start_;
+  if (async_id > 0) cpu_time_.try_emplace(async_id, 0);
+  cpu_time_async_id_ = async_id;
+  cpu_time_start_ = now;
+  return prior_async_id;
+}
+
+void AsyncHooks::StopCPUTimeAccounting(double prior_async_id) {
+  if (!cpu_time_accounting_) return;
+  uint64_t now = GetThreadCPUTime();
+  if (cpu_time_async_id_ > 0) {
+    cpu_time_[cpu_time_async_id_] += now - cpu_time_start_;
+  }
+  cpu_time_async_id_ = prior_async_id;
+  cpu_time_start_ = now;
+}
+
+int64_t AsyncHooks::GetCPUTime(double async_id) const {
+  auto it = cpu_time_.find(async_id);
+  if (it == cpu_time_.end()) return -1;
+  uint64_t time = it->second;
+  // Include the time of the callback that is currently running.
+  if (async_id == cpu_time_async_id_) {
+    time += GetThreadCPUTime() - cpu_time_start_;
+  }
+  return static_cast<int64_t>(time);
+}
+
+void AsyncHooks::ClearCPUTime(double async_id) {
+  if (!cpu_time_.empty()) cpu_time_.erase(async_id);
 }
 
 void AsyncHooks::grow_async_ids_stack() {
@@ -1875,6 +2179,7 @@ void Environment::Exit(ExitCode exit_code) {
                                       static_cast<int>(stack_trace_limit()),
                                       StackTrace::kDetailed));
   }
+  StopStallWatchdog();
   process_exit_handler_(this, exit_code);
 }
 
@@ -2142,7 +2447,11 @@ size_t Environment::NearHeapLimitCallback(void* data,
   if (dir.empty()) {
     dir = Environment::GetCwd(env->exec_path_);
   }
-  DiagnosticFilename name(env, "Heap", "heapsnapshot");
+  heap::HeapSnapshotCompression compression =
+      heap::ParseHeapSnapshotCompression(
+          env->options()->heap_snapshot_compression);
+  DiagnosticFilename name(
+      env, "Heap", heap::HeapSnapshotExtension(compression));
   std::string filename = dir + kPathSeparator + (*name);
 
   Debug(env, DebugCategory::DIAGNOSTICS, "Start generating %s...\n", *name);
@@ -2150,7 +2459,7 @@ size_t Environment::NearHeapLimitCallback(void* data,
   HeapProfiler::HeapSnapshotOptions options;
   options.numerics_mode = HeapProfiler::NumericsMode::kExposeNumericValues;
   options.snapshot_mode = HeapProfiler::HeapSnapshotMode::kExposeInternals;
-  heap::WriteSnapshot(env, filename.c_str(), options);
+  heap::WriteSnapshot(env, filename.c_str(), options, compression);
   env->heap_limit_snapshot_taken_ += 1;
 
   Debug(env,
@@ -2179,6 +2488,57 @@ size_t Environment::NearHeapLimitCallback(void* data,
   return new_limit;
 }
 
+#ifdef __wasi__
+// The size of a page of WebAssembly linear memory.
+static constexpr size_t kWasmPageSize = 64 * 1024;
+
+void Environment::LinearMemoryGCCallback(Isolate* isolate,
+                                         v8::GCType type,
+                                         v8::GCCallbackFlags flags,
+                                         void* data) {
+  static_cast<Environment*>(data)->CheckLinearMemoryLimit();
+}
+
+void Environment::CheckLinearMemoryLimit() {
+  const size_t limit =
+      per_process::cli_options->max_linear_memory_size * 1024 * 1024;
+  if (linear_memory_threshold_ == 0) {
+    linear_memory_threshold_ = limit / 10 * 9;
+  }
+  // The linear memory never shrinks, so once it has been grown up to the
+  // threshold, only what the allocator has left inside of it remains.
+  const size_t size = __builtin_wasm_memory_size(0) * kWasmPageSize;
+  if (size < linear_memory_threshold_) return;
+
+  Debug(this,
+        DebugCategory::DIAGNOSTICS,
+        "Linear memory size %" PRIu64 " reached the threshold %" PRIu64
+        " of the limit %" PRIu64 "\n",
+        static_cast<uint64_t>(size),
+        static_cast<uint64_t>(linear_memory_threshold_),
+        static_cast<uint64_t>(limit));
+  // Raise the threshold halfway towards the limit, so that the actions below
+  // are taken again, but not after every GC.
+  linear_memory_threshold_ = size + (limit > size ? (limit - size) / 2 : 0);
+  if (linear_memory_threshold_ <= size) linear_memory_threshold_ = SIZE_MAX;
+
+  // This is called from within a GC, which must not be nested.
+  RequestInterrupt([size, limit](Environment* env) {
+    if (env->heapsnapshot_near_heap_limit_callback_added_) {
+      NearHeapLimitCallback(env, size, limit);
+    }
+    env->ReleaseMemoryUnderPressure();
+  });
+}
+
+void Environment::ReleaseMemoryUnderPressure() {
+  if (compile_cache_handler_) {
+    compile_cache_handler_->ReleaseConsumedCaches();
+  }
+  isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+}
+#endif  // __wasi__
+
 inline size_t Environment::SelfSize() const {
   size_t size = sizeof(*this);
   // Remove non pointer fields that will be tracked in MemoryInfo()
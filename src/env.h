@@ -61,6 +61,7 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
@@ -111,6 +112,7 @@ class ModuleWrap;
 
 class Environment;
 class Realm;
+class SnapshotDeserializer;
 
 struct IsolateDataSerializeInfo {
   std::vector<SnapshotIndex> primitive_values;
@@ -330,6 +332,20 @@ class AsyncHooks : public MemoryRetainer {
   bool pop_async_context(double async_id);
   void clear_async_id_stack();  // Used in fatal exceptions.
 
+  // Accounting of the thread CPU time that is spent in the callbacks of
+  // every async resource. The time of nested callbacks is only charged to
+  // the innermost resource. The time of a resource is discarded when it is
+  // destroyed, after its destroy hooks have run.
+  inline bool cpu_time_accounting() const;
+  void set_cpu_time_accounting(bool enabled);
+  // Starts charging the time to async_id and returns the id that it was
+  // charged to before, to be passed to StopCPUTimeAccounting().
+  double StartCPUTimeAccounting(double async_id);
+  void StopCPUTimeAccounting(double prior_async_id);
+  // Returns the CPU time in nanoseconds, or -1 for unknown resources.
+  int64_t GetCPUTime(double async_id) const;
+  void ClearCPUTime(double async_id);
+
   AsyncHooks(const AsyncHooks&) = delete;
   AsyncHooks& operator=(const AsyncHooks&) = delete;
   AsyncHooks(AsyncHooks&&) = delete;
@@ -402,6 +418,11 @@ class AsyncHooks : public MemoryRetainer {
   const SerializeInfo* info_ = nullptr;
 
   std::array<v8::Global<v8::Function>, 4> js_promise_hooks_;
+
+  bool cpu_time_accounting_ = false;
+  double cpu_time_async_id_ = 0;
+  uint64_t cpu_time_start_ = 0;
+  std::unordered_map<double, uint64_t> cpu_time_;
 };
 
 class ImmediateInfo : public MemoryRetainer {
@@ -578,17 +599,126 @@ struct SnapshotData {
   static bool FromFile(SnapshotData* out, FILE* in);
   static bool FromBlob(SnapshotData* out, const std::vector<char>& in);
   static bool FromBlob(SnapshotData* out, std::string_view in);
+  // Like FromBlob(), but the code cache refers to |in| instead of copying it.
+  // |backing_store| keeps |in| alive, or is nullptr if |in| has static
+  // lifetime.
+  static bool FromBlobWithoutCopy(SnapshotData* out,
+                                  std::string_view in,
+                                  std::shared_ptr<void> backing_store);
   static const SnapshotData* FromEmbedderWrapper(
       const EmbedderSnapshotData* data);
   EmbedderSnapshotData::Pointer AsEmbedderWrapper() const;
 
   ~SnapshotData();
+
+ private:
+  static bool FromBlobImpl(SnapshotData* out,
+                           SnapshotDeserializer* deserializer);
 };
 
 void DefaultProcessExitHandlerInternal(Environment* env, ExitCode exit_code);
 v8::Maybe<ExitCode> SpinEventLoopInternal(Environment* env);
 v8::Maybe<ExitCode> EmitProcessExitInternal(Environment* env);
 
+class Histogram;
+class IoUringStreamBackend;
+class StallWatchdog;
+class ThreadPoolWork;
+
+// The classes of the ThreadPoolWork, which can be limited separately with
+// --threadpool-work-limit so that bulk work does not take all the threads of
+// the libuv threadpool from the latency-sensitive work.
+#define THREADPOOL_WORK_CLASSES(V)                                            \
+  V(kFileSystem, "fs")                                                        \
+  V(kCrypto, "crypto")                                                        \
+  V(kCompression, "compression")                                              \
+  V(kAddon, "addon")                                                          \
+  V(kAddonIo, "addon-io")                                                     \
+  V(kAddonCpu, "addon-cpu")                                                   \
+  V(kOther, "other")
+
+enum class ThreadPoolWorkClass : uint8_t {
+#define V(name, _) name,
+  THREADPOOL_WORK_CLASSES(V)
+#undef V
+  kCount
+};
+
+// Parses a value of --threadpool-work-limit, which has the form
+// <class>=<limit>.
+bool ParseThreadPoolWorkLimit(std::string_view text,
+                              ThreadPoolWorkClass* work_class,
+                              uint32_t* limit);
+
+// The ThreadPoolWork of one class of an Environment. This is only accessed
+// from the thread of the Environment.
+struct ThreadPoolWorkClassState {
+  // The maximum number of the work items that are in the threadpool at the
+  // same time, or 0 if they are not limited.
+  uint32_t limit = 0;
+  uint32_t running = 0;
+  // The work items waiting for one of the running ones to finish, linked
+  // through the work items themselves so they can be cancelled in O(1).
+  ThreadPoolWork* pending_head = nullptr;
+  ThreadPoolWork* pending_tail = nullptr;
+  // Time from the scheduling of a work item to the start of it, and the time
+  // it ran for, in nanoseconds. Only recorded once JS asked for them through
+  // createThreadPoolWorkHistograms().
+  std::shared_ptr<Histogram> queue_wait;
+  std::shared_ptr<Histogram> run_time;
+};
+
+// The phases of the event loop whose durations can be recorded with
+// createEventLoopPhaseHistograms(). libuv has no hooks around its pending and
+// close phases, so those are not recorded.
+#define EVENT_LOOP_PHASES(V)                                                  \
+  V(kTimers, "timers")                                                        \
+  V(kPoll, "poll")                                                            \
+  V(kCheck, "check")                                                          \
+  V(kMicrotasks, "microtasks")
+
+enum class EventLoopPhase : uint8_t {
+#define V(name, _) name,
+  EVENT_LOOP_PHASES(V)
+#undef V
+  kCount
+};
+
+// The per-phase instrumentation of the event loop of an Environment. This is
+// only allocated once JS asked for it, so that the event loop only pays for a
+// null check when it is not used.
+struct EventLoopPhaseState {
+  // The time spent in each phase per iteration of the event loop that ran
+  // it, in nanoseconds. The poll phase does not include the time the loop
+  // was blocked waiting for I/O.
+  std::array<std::shared_ptr<Histogram>,
+             static_cast<size_t>(EventLoopPhase::kCount)>
+      histograms;
+  // The number of callbacks made into JS by AsyncWrap::MakeCallback(), by
+  // AsyncWrap::ProviderType.
+  std::vector<uint64_t> callbacks;
+  // The start of the current poll phase, set by the prepare handle.
+  uint64_t poll_start = 0;
+  uint64_t poll_idle_start = 0;
+};
+
+// Records the time from its construction to its destruction into the
+// histogram of a phase, if the phases are being recorded.
+class EventLoopPhaseTimer {
+ public:
+  inline EventLoopPhaseTimer(Environment* env, EventLoopPhase phase);
+  inline ~EventLoopPhaseTimer();
+
+  EventLoopPhaseTimer(const EventLoopPhaseTimer&) = delete;
+  EventLoopPhaseTimer& operator=(const EventLoopPhaseTimer&) = delete;
+
+ private:
+  static void Record(Histogram* histogram, uint64_t start);
+
+  Histogram* histogram_ = nullptr;
+  uint64_t start_ = 0;
+};
+
 class Cleanable {
  public:
   virtual ~Cleanable() = default;
@@ -692,7 +822,23 @@ class Environment final : public MemoryRetainer {
   void TrackShadowRealm(shadow_realm::ShadowRealm* realm);
   void UntrackShadowRealm(shadow_realm::ShadowRealm* realm);
 
+  // Contexts that vm.createContext() can use instead of creating a new one,
+  // see vm.setContextPoolSize().
+  struct VMContextPool {
+    std::vector<v8::Global<v8::Context>> contexts;
+    size_t size = 0;
+    bool refill_scheduled = false;
+  };
+  VMContextPool* vm_context_pool() { return &vm_context_pool_; }
+
   void StartProfilerIdleNotifier();
+  // Starts and stops the StallWatchdog of --trace-event-loop-stalls.
+  void StartStallWatchdog();
+  void StopStallWatchdog();
+  inline StallWatchdog* stall_watchdog();
+  // Allocates the EventLoopPhaseState and starts recording into it, if that
+  // has not happened yet.
+  EventLoopPhaseState* EnableEventLoopPhases(size_t callback_types);
 
   inline v8::Isolate* isolate() const;
   inline cppgc::AllocationHandle& cppgc_allocation_handle() const;
@@ -769,6 +915,9 @@ class Environment final : public MemoryRetainer {
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
   inline performance::PerformanceState* performance_state();
+  inline EventLoopPhaseState* event_loop_phases();
+  inline ThreadPoolWorkClassState* threadpool_work_class(
+      ThreadPoolWorkClass work_class);
 
   v8::Maybe<void> CollectUVExceptionInfo(v8::Local<v8::Value> context,
                                          int errorno,
@@ -820,6 +969,9 @@ class Environment final : public MemoryRetainer {
   // Determine if the environment is stopping. This getter is thread-safe.
   inline bool is_stopping() const;
   inline void set_stopping(bool value);
+  // Set when the process exits right after this Environment has been freed,
+  // so that cleanup hooks that only release memory can be skipped.
+  inline void set_fast_teardown(bool value);
   inline std::list<node_module>* extra_linked_bindings();
   inline node_module* extra_linked_bindings_head();
   inline node_module* extra_linked_bindings_tail();
@@ -947,6 +1099,8 @@ class Environment final : public MemoryRetainer {
   // This function can be called from any thread.
   template <typename Fn>
   inline void RequestInterrupt(Fn&& cb);
+  // Signals task_queues_async_ if it is initialized. Thread-safe.
+  inline void WakeUpTaskQueues();
   // This needs to be available for the JS-land setImmediate().
   void ToggleImmediateRef(bool ref);
 
@@ -962,7 +1116,10 @@ class Environment final : public MemoryRetainer {
   void ScheduleTimer(int64_t duration);
   void ToggleTimerRef(bool ref);
 
-  inline void AddCleanupHook(CleanupQueue::Callback cb, void* arg);
+  // See CleanupQueue::Add() for `memory_only`.
+  inline void AddCleanupHook(CleanupQueue::Callback cb,
+                             void* arg,
+                             bool memory_only = false);
   inline void RemoveCleanupHook(CleanupQueue::Callback cb, void* arg);
   void RunCleanup();
 
@@ -972,6 +1129,17 @@ class Environment final : public MemoryRetainer {
   static size_t NearHeapLimitCallback(void* data,
                                       size_t current_heap_limit,
                                       size_t initial_heap_limit);
+#ifdef __wasi__
+  // Under WASI, running out of linear memory traps the whole instance
+  // instead of triggering V8's near-heap-limit callbacks, so the size of the
+  // linear memory is checked against --max-linear-memory-size after every GC.
+  static void LinearMemoryGCCallback(v8::Isolate* isolate,
+                                     v8::GCType type,
+                                     v8::GCCallbackFlags flags,
+                                     void* data);
+  void CheckLinearMemoryLimit();
+  void ReleaseMemoryUnderPressure();
+#endif  // __wasi__
   static void BuildEmbedderGraph(v8::Isolate* isolate,
                                  v8::EmbedderGraph* graph,
                                  void* data);
@@ -1037,6 +1205,16 @@ class Environment final : public MemoryRetainer {
   uv_buf_t allocate_managed_buffer(const size_t suggested_size);
   std::unique_ptr<v8::BackingStore> release_managed_buffer(const uv_buf_t& buf);
 
+  // Like allocate_managed_buffer(), but with --experimental-stream-read-slabs
+  // carves the buffer out of a shared slab. release_stream_read_buffer()
+  // returns the ArrayBuffer holding the `nread` bytes that were read and
+  // stores their offset into `offset`, or an empty handle if `nread` is not
+  // positive.
+  uv_buf_t allocate_stream_read_buffer(const size_t suggested_size);
+  v8::Local<v8::ArrayBuffer> release_stream_read_buffer(const uv_buf_t& buf,
+                                                        ssize_t nread,
+                                                        size_t* offset);
+
   void AddUnmanagedFd(int fd);
   void RemoveUnmanagedFd(int fd);
 
@@ -1068,6 +1246,8 @@ class Environment final : public MemoryRetainer {
 #endif  // OPENSSL_VERSION_MAJOR >= 3
   std::unordered_map<std::string, size_t> alias_to_md_id_map;
   std::vector<std::string> supported_hash_algorithms;
+  // Reused by the synchronous one-shot digests computed on this thread.
+  DeleteFnPtr<EVP_MD_CTX, EVP_MD_CTX_free> one_shot_md_ctx;
 #endif  // HAVE_OPENSSL
 
   v8::Global<v8::Module> temporary_required_module_facade_original;
@@ -1091,6 +1271,8 @@ class Environment final : public MemoryRetainer {
   uv_idle_t immediate_idle_handle_;
   uv_prepare_t idle_prepare_handle_;
   uv_check_t idle_check_handle_;
+  uv_prepare_t phase_prepare_handle_;
+  uv_check_t phase_check_handle_;
   uv_async_t task_queues_async_;
   int64_t task_queues_async_refs_ = 0;
 
@@ -1147,6 +1329,11 @@ class Environment final : public MemoryRetainer {
   uint32_t heap_limit_snapshot_taken_ = 0;
   uint32_t heap_snapshot_near_heap_limit_ = 0;
   bool heapsnapshot_near_heap_limit_callback_added_ = false;
+#ifdef __wasi__
+  // The size of the linear memory at which CheckLinearMemoryLimit() takes
+  // action next. Zero until the first check.
+  size_t linear_memory_threshold_ = 0;
+#endif  // __wasi__
 
   uint32_t module_id_counter_ = 0;
   uint32_t script_id_counter_ = 0;
@@ -1174,6 +1361,15 @@ class Environment final : public MemoryRetainer {
   // This is the time when the environment is created.
   const uint64_t environment_start_;
   std::unique_ptr<performance::PerformanceState> performance_state_;
+  std::array<ThreadPoolWorkClassState,
+             static_cast<size_t>(ThreadPoolWorkClass::kCount)>
+      threadpool_work_classes_;
+  std::unique_ptr<EventLoopPhaseState> event_loop_phases_;
+  std::unique_ptr<StallWatchdog> stall_watchdog_;
+  // Set up by IoUringStreamBackend::Get() for --experimental-io-uring-sockets.
+  friend class IoUringStreamBackend;
+  std::unique_ptr<IoUringStreamBackend> io_uring_stream_backend_;
+  bool io_uring_stream_backend_unavailable_ = false;
 
   bool has_serialized_options_ = false;
 
@@ -1204,6 +1400,7 @@ class Environment final : public MemoryRetainer {
   EnabledDebugList enabled_debug_list_;
 
   std::vector<v8::Global<v8::Context>> contexts_;
+  VMContextPool vm_context_pool_;
   std::list<node_module> extra_linked_bindings_;
   Mutex extra_linked_bindings_mutex_;
 
@@ -1217,14 +1414,16 @@ class Environment final : public MemoryRetainer {
   std::list<ExitCallback> at_exit_functions_;
 
   typedef CallbackQueue<void, Environment*> NativeImmediateQueue;
+  typedef ThreadsafeCallbackQueue<void, Environment*>
+      ThreadsafeNativeImmediateQueue;
   NativeImmediateQueue native_immediates_;
+  ThreadsafeNativeImmediateQueue native_immediates_threadsafe_;
+  ThreadsafeNativeImmediateQueue native_immediates_interrupts_;
+  // Guards task_queues_async_initialized_, which is checked before the libuv
+  // handle for the immediate queues (task_queues_async_) is signaled from
+  // other threads, as it may not be initialized yet or already have been
+  // destroyed. The queues themselves do not need the lock.
   Mutex native_immediates_threadsafe_mutex_;
-  NativeImmediateQueue native_immediates_threadsafe_;
-  NativeImmediateQueue native_immediates_interrupts_;
-  // Also guarded by native_immediates_threadsafe_mutex_. This can be used when
-  // trying to post tasks from other threads to an Environment, as the libuv
-  // handle for the immediate queues (task_queues_async_) may not be initialized
-  // yet or already have been destroyed.
   bool task_queues_async_initialized_ = false;
 
   std::atomic<Environment**> interrupt_data_ {nullptr};
@@ -1233,6 +1432,7 @@ class Environment final : public MemoryRetainer {
 
   CleanupQueue cleanup_queue_;
   bool started_cleanup_ = false;
+  bool fast_teardown_ = false;
 
   std::unordered_set<int> unmanaged_fds_;
 
@@ -1248,6 +1448,14 @@ class Environment final : public MemoryRetainer {
   // track of the BackingStore for a given pointer.
   std::unordered_map<char*, std::unique_ptr<v8::BackingStore>>
       released_allocated_buffers_;
+
+  // Used by allocate_stream_read_buffer() and release_stream_read_buffer().
+  void NextStreamReadSlab();
+  std::shared_ptr<v8::BackingStore> stream_read_slab_;
+  size_t stream_read_slab_offset_ = 0;
+  bool stream_read_slab_reserved_ = false;
+  // Full slabs. They are reused once no ArrayBuffer refers to them anymore.
+  std::vector<std::shared_ptr<v8::BackingStore>> retired_stream_read_slabs_;
 };
 
 }  // namespace node
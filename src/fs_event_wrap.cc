@@ -24,11 +24,26 @@
 #include "handle_wrap.h"
 #include "node.h"
 #include "node_external_reference.h"
+#include "node_file.h"
 #include "permission/permission.h"
 #include "string_bytes.h"
 
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#endif
+
 namespace node {
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::DontEnum;
@@ -38,6 +53,7 @@ using v8::HandleScope;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::LocalVector;
 using v8::MaybeLocal;
 using v8::Object;
 using v8::PropertyAttribute;
@@ -77,6 +93,66 @@ class FSEventWrap: public HandleWrap {
   enum encoding encoding_ = kDefaultEncoding;
 };
 
+#ifdef __linux__
+// uv_fs_event_t can't watch a directory recursively on Linux. Watching every
+// subdirectory with a uv_fs_event_t of its own would take an inotify instance
+// per directory, so this class adds the watches of a whole tree to a single
+// inotify instance instead, and follows the directories that are created in or
+// moved into the tree. The events that are read from the instance at once are
+// passed to JS in one batch, without duplicates.
+class RecursiveFSEventWrap : public HandleWrap {
+ public:
+  static void Initialize(Environment* env,
+                         Local<Object> target,
+                         Local<Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Start(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RecursiveFSEventWrap)
+  SET_SELF_SIZE(RecursiveFSEventWrap)
+
+ private:
+  static const encoding kDefaultEncoding = UTF8;
+  static constexpr uint32_t kEventMask =
+      IN_ATTRIB | IN_CREATE | IN_MODIFY | IN_DELETE | IN_DELETE_SELF |
+      IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+  struct Event {
+    bool rename;
+    std::string filename;
+  };
+
+  RecursiveFSEventWrap(Environment* env, Local<Object> object);
+  ~RecursiveFSEventWrap() override = default;
+
+  void OnClose() override;
+
+  // Watches the directory at `relative` and the directories below it. The
+  // entries that are found are reported as renamed if `report` is true, as
+  // they may have been created before the watch was added.
+  int Watch(const std::string& relative, bool report);
+  void Unwatch(const std::string& relative);
+  void AddEvent(bool rename, const std::string& filename);
+  void HandleEvent(const struct inotify_event* event);
+  void ReadEvents();
+  void EmitEvents(int status);
+
+  static void OnEvents(uv_poll_t* handle, int status, int events);
+
+  uv_poll_t handle_;
+  int fd_ = -1;
+  std::string root_;
+  // Maps the watch descriptors to the directories relative to the root.
+  std::unordered_map<int, std::string> directories_;
+  std::vector<Event> events_;
+  std::unordered_set<std::string> pending_;
+  bool overflow_ = false;
+  enum encoding encoding_ = kDefaultEncoding;
+};
+#endif  // __linux__
+
 
 FSEventWrap::FSEventWrap(Environment* env, Local<Object> object)
     : HandleWrap(env,
@@ -120,6 +196,10 @@ void FSEventWrap::Initialize(Local<Object> target,
       static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
 
   SetConstructorFunction(context, target, "FSEvent", t);
+
+#ifdef __linux__
+  RecursiveFSEventWrap::Initialize(env, target, context);
+#endif
 }
 
 void FSEventWrap::RegisterExternalReferences(
@@ -127,6 +207,9 @@ void FSEventWrap::RegisterExternalReferences(
   registry->Register(New);
   registry->Register(Start);
   registry->Register(GetInitialized);
+#ifdef __linux__
+  RecursiveFSEventWrap::RegisterExternalReferences(registry);
+#endif
 }
 
 void FSEventWrap::New(const FunctionCallbackInfo<Value>& args) {
@@ -189,6 +272,9 @@ void FSEventWrap::OnEvent(uv_fs_event_t* handle, const char* filename,
 
   CHECK_EQ(wrap->persistent().IsEmpty(), false);
 
+  // Whatever changed may have been looked up during module resolution.
+  fs::InvalidateModuleStatCache();
+
   // We're in a bind here. libuv can set both UV_RENAME and UV_CHANGE but
   // the Node API only lets us pass a single event to JS land.
   //
@@ -239,6 +325,293 @@ void FSEventWrap::OnEvent(uv_fs_event_t* handle, const char* filename,
   wrap->MakeCallback(env->onchange_string(), arraysize(argv), argv);
 }
 
+#ifdef __linux__
+RecursiveFSEventWrap::RecursiveFSEventWrap(Environment* env,
+                                           Local<Object> object)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&handle_),
+                 AsyncWrap::PROVIDER_FSEVENTWRAP) {
+  MarkAsUninitialized();
+}
+
+void RecursiveFSEventWrap::Initialize(Environment* env,
+                                      Local<Object> target,
+                                      Local<Context> context) {
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> t = NewFunctionTemplate(isolate, New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      RecursiveFSEventWrap::kInternalFieldCount);
+
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, t, "start", Start);
+
+  SetConstructorFunction(context, target, "FSEventRecursive", t);
+}
+
+void RecursiveFSEventWrap::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Start);
+}
+
+void RecursiveFSEventWrap::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new RecursiveFSEventWrap(env, args.This());
+}
+
+// wrap.start(directory, persistent, encoding)
+void RecursiveFSEventWrap::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  RecursiveFSEventWrap* wrap = Unwrap<RecursiveFSEventWrap>(args.This());
+  CHECK_NOT_NULL(wrap);
+  CHECK(wrap->IsHandleClosing());  // Check that Start() has not been called.
+
+  CHECK_GE(args.Length(), 3);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  THROW_IF_INSUFFICIENT_PERMISSIONS(
+      env, permission::PermissionScope::kFileSystemRead, *path);
+
+  wrap->encoding_ = ParseEncoding(env->isolate(), args[2], kDefaultEncoding);
+  wrap->root_ = path.ToString();
+
+  wrap->fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (wrap->fd_ == -1) {
+    return args.GetReturnValue().Set(-errno);
+  }
+
+  int err = uv_poll_init(env->event_loop(), &wrap->handle_, wrap->fd_);
+  if (err != 0) {
+    close(wrap->fd_);
+    wrap->fd_ = -1;
+    return args.GetReturnValue().Set(err);
+  }
+  wrap->MarkAsInitialized();
+
+  err = wrap->Watch("", false);
+  if (err == 0) {
+    err = uv_poll_start(&wrap->handle_, UV_READABLE, OnEvents);
+  }
+
+  if (err != 0) {
+    wrap->Close();
+    return args.GetReturnValue().Set(err);
+  }
+
+  // Check for persistent argument
+  if (!args[1]->IsTrue()) {
+    uv_unref(reinterpret_cast<uv_handle_t*>(&wrap->handle_));
+  }
+
+  args.GetReturnValue().Set(err);
+}
+
+void RecursiveFSEventWrap::OnClose() {
+  // uv_poll_t doesn't own the file descriptor.
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+int RecursiveFSEventWrap::Watch(const std::string& relative, bool report) {
+  std::vector<std::string> queue{relative};
+  while (!queue.empty()) {
+    std::string directory = std::move(queue.back());
+    queue.pop_back();
+
+    std::string path = directory.empty() ? root_ : root_ + '/' + directory;
+    // The root may be a symbolic link, the directories below it are only
+    // watched if they are in the tree.
+    const uint32_t mask = directory.empty() ? kEventMask
+                                            : kEventMask | IN_DONT_FOLLOW;
+    int wd = inotify_add_watch(fd_, path.c_str(), mask);
+    if (wd == -1) {
+      // A directory below the root that is gone or can't be read again doesn't
+      // keep the rest of the tree from being watched.
+      int err = errno;
+      if (!directory.empty() &&
+          (err == ENOENT || err == ENOTDIR || err == EACCES)) {
+        continue;
+      }
+      return -err;
+    }
+    // The same directory can be reached twice through bind mounts, or when
+    // the events of a new directory and of its parent overlap.
+    if (!directories_.emplace(wd, directory).second) continue;
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) continue;
+    while (struct dirent* entry = readdir(dir)) {
+      const char* name = entry->d_name;
+      if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+
+      std::string child = directory.empty() ? name : directory + '/' + name;
+      if (report) AddEvent(true, child);
+
+      bool is_directory = entry->d_type == DT_DIR;
+      if (entry->d_type == DT_UNKNOWN) {
+        struct stat s;
+        is_directory = lstat((root_ + '/' + child).c_str(), &s) == 0 &&
+                       S_ISDIR(s.st_mode);
+      }
+      if (is_directory) queue.push_back(std::move(child));
+    }
+    closedir(dir);
+  }
+  return 0;
+}
+
+void RecursiveFSEventWrap::Unwatch(const std::string& relative) {
+  const std::string prefix = relative + '/';
+  for (auto it = directories_.begin(); it != directories_.end();) {
+    const std::string& directory = it->second;
+    if (directory == relative ||
+        directory.compare(0, prefix.size(), prefix) == 0) {
+      inotify_rm_watch(fd_, it->first);
+      it = directories_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void RecursiveFSEventWrap::AddEvent(bool rename, const std::string& filename) {
+  if (pending_.emplace((rename ? 'r' : 'c') + filename).second) {
+    events_.push_back({rename, filename});
+  }
+}
+
+void RecursiveFSEventWrap::HandleEvent(const struct inotify_event* event) {
+  if (event->mask & IN_Q_OVERFLOW) {
+    overflow_ = true;
+    return;
+  }
+
+  auto it = directories_.find(event->wd);
+  if (it == directories_.end()) return;
+  if (event->mask & IN_IGNORED) {
+    directories_.erase(it);
+    return;
+  }
+  const std::string directory = it->second;
+
+  if (event->len == 0) {
+    // The events of the directories below the root are reported by their
+    // parents, with their names. The root is reported by its name, as
+    // uv_fs_event_t does.
+    if (!directory.empty()) return;
+    size_t slash = root_.find_last_of('/');
+    AddEvent((event->mask & (IN_ATTRIB | IN_MODIFY)) == 0,
+             slash == std::string::npos ? root_ : root_.substr(slash + 1));
+    return;
+  }
+
+  std::string filename = directory.empty() ? std::string(event->name)
+                                           : directory + '/' + event->name;
+  bool rename = (event->mask & ~(IN_ATTRIB | IN_MODIFY | IN_ISDIR)) != 0;
+  AddEvent(rename, filename);
+
+  if (event->mask & IN_ISDIR) {
+    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+      int err = Watch(filename, true);
+      // Anything but running out of watches has been ignored by Watch().
+      if (err != 0) EmitEvents(err);
+    } else if (event->mask & IN_MOVED_FROM) {
+      Unwatch(filename);
+    }
+  }
+}
+
+void RecursiveFSEventWrap::ReadEvents() {
+  alignas(struct inotify_event) char buf[4096];
+  for (;;) {
+    ssize_t size;
+    do {
+      size = read(fd_, buf, sizeof(buf));
+    } while (size == -1 && errno == EINTR);
+    if (size <= 0) break;
+
+    for (char* p = buf; p < buf + size;) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(p);
+      HandleEvent(event);
+      if (IsHandleClosing()) return;
+      p += sizeof(*event) + event->len;
+    }
+  }
+}
+
+void RecursiveFSEventWrap::EmitEvents(int status) {
+  if (IsHandleClosing()) return;
+
+  std::vector<Event> events;
+  events.swap(events_);
+  pending_.clear();
+  bool overflow = overflow_;
+  overflow_ = false;
+  if (status == 0 && events.empty() && !overflow) return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  CHECK_EQ(persistent().IsEmpty(), false);
+
+  // Whatever changed may have been looked up during module resolution.
+  fs::InvalidateModuleStatCache();
+
+  // The batch is a flat list of event types and filenames. When events have
+  // been dropped because the queue of the instance overflowed, the batch ends
+  // with a rename event without filename.
+  LocalVector<Value> values(isolate);
+  values.reserve(events.size() * 2 + 2);
+  for (const Event& event : events) {
+    values.push_back(event.rename ? env->rename_string()
+                                  : env->change_string());
+    // As in FSEventWrap::OnEvent(), a filename that can't be encoded is
+    // passed as a Buffer, with an error.
+    TryCatch try_catch(isolate);
+    Local<Value> filename;
+    if (!StringBytes::Encode(isolate, event.filename.c_str(), encoding_)
+             .ToLocal(&filename)) {
+      status = UV_EINVAL;
+      filename = StringBytes::Encode(isolate,
+                                     event.filename.data(),
+                                     event.filename.size(),
+                                     BUFFER)
+                     .ToLocalChecked();
+    }
+    values.push_back(filename);
+  }
+  if (overflow) {
+    values.push_back(env->rename_string());
+    values.push_back(Null(isolate));
+  }
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, status),
+    Array::New(isolate, values.data(), values.size()),
+  };
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+
+void RecursiveFSEventWrap::OnEvents(uv_poll_t* handle,
+                                    int status,
+                                    int events) {
+  RecursiveFSEventWrap* wrap =
+      static_cast<RecursiveFSEventWrap*>(handle->data);
+  if (status == 0) wrap->ReadEvents();
+  wrap->EmitEvents(status);
+}
+#endif  // __linux__
+
 }  // anonymous namespace
 }  // namespace node
 
@@ -41,8 +41,10 @@ void HandleWrap::Ref(const FunctionCallbackInfo<Value>& args) {
   HandleWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
 
-  if (IsAlive(wrap))
+  if (IsAlive(wrap)) {
     uv_ref(wrap->GetHandle());
+    wrap->OnRefChanged();
+  }
 }
 
 
@@ -50,8 +52,10 @@ void HandleWrap::Unref(const FunctionCallbackInfo<Value>& args) {
   HandleWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
 
-  if (IsAlive(wrap))
+  if (IsAlive(wrap)) {
     uv_unref(wrap->GetHandle());
+    wrap->OnRefChanged();
+  }
 }
 
 
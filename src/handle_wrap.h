@@ -88,6 +88,9 @@ class HandleWrap : public AsyncWrap {
              uv_handle_t* handle,
              AsyncWrap::ProviderType provider);
   virtual void OnClose() {}
+  // Called after the handle has been referenced or unreferenced through
+  // ref() or unref().
+  virtual void OnRefChanged() {}
   void OnGCCollect() final;
   bool IsNotIndicativeOfMemoryLeakAtExit() const override;
 
@@ -11,6 +11,12 @@ namespace node {
 
 void Histogram::Reset() {
   Mutex::ScopedLock lock(mutex_);
+  if (concurrent_) {
+    count_ -= DrainCounts(nullptr);
+    exceeds_ = 0;
+    prev_ = 0;
+    return;
+  }
   hdr_reset(histogram_.get());
   exceeds_ = 0;
   count_ = 0;
@@ -19,6 +25,19 @@ void Histogram::Reset() {
 
 double Histogram::Add(const Histogram& other) {
   Mutex::ScopedLock lock(mutex_);
+  if (concurrent_) {
+    // hdr_add() does not record atomically.
+    int64_t added = 0;
+    hdr_iter iter;
+    hdr_iter_recorded_init(&iter, other.histogram_.get());
+    while (hdr_iter_next(&iter)) {
+      if (hdr_record_values_atomic(histogram_.get(), iter.value, iter.count))
+        added += iter.count;
+    }
+    count_ += added;
+    exceeds_ += other.exceeds_;
+    return static_cast<double>(added);
+  }
   count_ += other.count_;
   exceeds_ += other.exceeds_;
   if (other.prev_ > prev_)
@@ -70,6 +89,11 @@ void Histogram::Percentiles(Iterator&& fn) {
 }
 
 bool Histogram::Record(int64_t value) {
+  if (concurrent_) {
+    bool recorded = hdr_record_value_atomic(histogram_.get(), value);
+    (recorded ? count_ : exceeds_).fetch_add(1, std::memory_order_relaxed);
+    return recorded;
+  }
   Mutex::ScopedLock lock(mutex_);
   bool recorded = hdr_record_value(histogram_.get(), value);
   if (!recorded)
@@ -86,7 +110,10 @@ uint64_t Histogram::RecordDelta() {
   if (prev_ > 0) {
     CHECK_GE(time, prev_);
     delta = time - prev_;
-    if (hdr_record_value(histogram_.get(), delta))
+    bool recorded = concurrent_
+                        ? hdr_record_value_atomic(histogram_.get(), delta)
+                        : hdr_record_value(histogram_.get(), delta);
+    if (recorded)
       count_++;
     else
       exceeds_++;
@@ -26,7 +26,8 @@ using v8::String;
 using v8::Uint32;
 using v8::Value;
 
-Histogram::Histogram(const Options& options) {
+Histogram::Histogram(const Options& options)
+    : concurrent_(options.concurrent) {
   hdr_histogram* histogram;
   CHECK_EQ(0, hdr_init(options.lowest,
                        options.highest,
@@ -35,6 +36,63 @@ Histogram::Histogram(const Options& options) {
   histogram_.reset(histogram);
 }
 
+int64_t Histogram::DrainCounts(hdr_histogram* to) {
+  hdr_histogram* from = histogram_.get();
+  // Reset the minimum and the maximum first, so that the values recorded
+  // while the counts are moved are reflected in them.
+  std::atomic_ref<int64_t>(from->min_value).store(INT64_MAX);
+  std::atomic_ref<int64_t>(from->max_value).store(0);
+  int64_t total = 0;
+  for (int32_t i = 0; i < from->counts_len; i++) {
+    int64_t count = std::atomic_ref<int64_t>(from->counts[i]).exchange(0);
+    if (to != nullptr) to->counts[i] = count;
+    total += count;
+  }
+  std::atomic_ref<int64_t>(from->total_count).fetch_sub(total);
+  return total;
+}
+
+std::shared_ptr<Histogram> Histogram::Snapshot(bool reset) {
+  Mutex::ScopedLock lock(mutex_);
+  hdr_histogram* from = histogram_.get();
+  auto snapshot = std::make_shared<Histogram>(
+      Options{from->lowest_discernible_value,
+              from->highest_trackable_value,
+              from->significant_figures});
+  hdr_histogram* to = snapshot->histogram_.get();
+
+  if (!concurrent_) {
+    hdr_add(to, from);
+    snapshot->count_ = count_.load();
+    snapshot->exceeds_ = exceeds_.load();
+    snapshot->prev_ = prev_;
+    if (reset) {
+      hdr_reset(from);
+      count_ = 0;
+      exceeds_ = 0;
+      prev_ = 0;
+    }
+    return snapshot;
+  }
+
+  int64_t total;
+  if (reset) {
+    total = DrainCounts(to);
+    count_ -= total;
+    snapshot->exceeds_ = exceeds_.exchange(0);
+  } else {
+    total = 0;
+    for (int32_t i = 0; i < from->counts_len; i++) {
+      to->counts[i] = std::atomic_ref<int64_t>(from->counts[i]).load();
+      total += to->counts[i];
+    }
+    snapshot->exceeds_ = exceeds_.load();
+  }
+  hdr_reset_internal_counters(to);
+  snapshot->count_ = total;
+  return snapshot;
+}
+
 void Histogram::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("histogram", GetMemorySize());
 }
@@ -218,6 +276,17 @@ void HistogramBase::Add(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(count);
 }
 
+void HistogramBase::Snapshot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  HistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.This());
+
+  CHECK(args[0]->IsBoolean());
+  BaseObjectPtr<HistogramBase> snapshot =
+      Create(env, (*histogram)->Snapshot(args[0]->IsTrue()));
+  if (snapshot) args.GetReturnValue().Set(snapshot->object());
+}
+
 BaseObjectPtr<HistogramBase> HistogramBase::Create(
     Environment* env,
     const Histogram::Options& options) {
@@ -252,6 +321,7 @@ void HistogramBase::New(const FunctionCallbackInfo<Value>& args) {
   CHECK_IMPLIES(!args[0]->IsNumber(), args[0]->IsBigInt());
   CHECK_IMPLIES(!args[1]->IsNumber(), args[1]->IsBigInt());
   CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsBoolean());
 
   int64_t lowest = 1;
   int64_t highest = std::numeric_limits<int64_t>::max();
@@ -271,8 +341,9 @@ void HistogramBase::New(const FunctionCallbackInfo<Value>& args) {
   }
 
   int32_t figures = args[2].As<Uint32>()->Value();
+  bool concurrent = args[3]->IsTrue();
   new HistogramBase(env, args.This(), Histogram::Options {
-    lowest, highest, figures
+    lowest, highest, figures, concurrent
   });
 }
 
@@ -290,6 +361,7 @@ Local<FunctionTemplate> HistogramBase::GetConstructorTemplate(
     SetFastMethod(
         isolate, instance, "recordDelta", RecordDelta, &fast_record_delta_);
     SetProtoMethod(isolate, tmpl, "add", Add);
+    SetProtoMethod(isolate, tmpl, "snapshot", Snapshot);
     HistogramImpl::AddMethods(isolate, tmpl);
     isolate_data->set_histogram_ctor_template(tmpl);
   }
@@ -300,6 +372,7 @@ void HistogramBase::RegisterExternalReferences(
     ExternalReferenceRegistry* registry) {
   registry->Register(New);
   registry->Register(Add);
+  registry->Register(Snapshot);
   registry->Register(Record);
   registry->Register(RecordDelta);
   registry->Register(fast_record_.GetTypeInfo());
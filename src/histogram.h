@@ -11,6 +11,7 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <map>
@@ -28,11 +29,18 @@ class Histogram : public MemoryRetainer {
     int64_t lowest = 1;
     int64_t highest = std::numeric_limits<int64_t>::max();
     int figures = kDefaultHistogramFigures;
+    // Record without taking the lock, so that the threads that share the
+    // histogram can record into it at the same time. The values are read
+    // without synchronization with the recording threads; use Snapshot() to
+    // read them consistently.
+    bool concurrent = false;
   };
 
   explicit Histogram(const Options& options);
   virtual ~Histogram() = default;
 
+  bool concurrent() const { return concurrent_; }
+
   inline bool Record(int64_t value);
   inline void Reset();
   inline int64_t Min() const;
@@ -47,6 +55,12 @@ class Histogram : public MemoryRetainer {
 
   inline double Add(const Histogram& other);
 
+  // Returns a copy of the histogram that no other thread records into, and
+  // resets the histogram if |reset| is true. For a concurrent histogram, every
+  // value that is recorded at the same time is either in the copy or stays
+  // in the histogram.
+  std::shared_ptr<Histogram> Snapshot(bool reset);
+
   // Iterator is a function type that takes two doubles as argument, one for
   // percentile and one for the value at that percentile.
   template <typename Iterator>
@@ -60,10 +74,16 @@ class Histogram : public MemoryRetainer {
 
  private:
   using HistogramPointer = DeleteFnPtr<hdr_histogram, hdr_close>;
+
+  // Moves the counts of a concurrent histogram into |to|, if it is not
+  // nullptr, and returns the number of values that were moved.
+  int64_t DrainCounts(hdr_histogram* to);
+
   HistogramPointer histogram_;
+  const bool concurrent_;
   uint64_t prev_ = 0;
-  size_t exceeds_ = 0;
-  size_t count_ = 0;
+  std::atomic<size_t> exceeds_{0};
+  std::atomic<size_t> count_{0};
   Mutex mutex_;
 };
 
@@ -164,6 +184,7 @@ class HistogramBase final : public BaseObject, public HistogramImpl {
   static void Record(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecordDelta(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Add(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Snapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void FastRecord(
       v8::Local<v8::Value> unused,
@@ -1,4 +1,5 @@
 #include "network_agent.h"
+#include "env-inl.h"
 #include "inspector/protocol_helper.h"
 #include "network_inspector.h"
 #include "util-inl.h"
@@ -18,6 +19,17 @@ using v8::Object;
 using v8::Uint8Array;
 using v8::Value;
 
+// The limits that apply unless Network.enable sets others. They are the ones
+// Chrome DevTools passes.
+constexpr size_t kDefaultMaxTotalBufferSize = 100 * 1024 * 1024;
+constexpr size_t kDefaultMaxResourceBufferSize = 10 * 1024 * 1024;
+// The number of finished requests whose response body can still be streamed
+// with streamResourceContent.
+constexpr size_t kMaxRetainedRequests = 1000;
+// Streamed data is sent right away rather than at the end of the event loop
+// iteration once this much has been batched for a request.
+constexpr size_t kMaxDataBatchSize = 1024 * 1024;
+
 // Get a protocol string property from the object.
 Maybe<protocol::String> ObjectGetProtocolString(v8::Local<v8::Context> context,
                                                 Local<Object> object,
@@ -191,7 +203,11 @@ std::unique_ptr<protocol::Network::Response> createResponseFromObject(
 
 NetworkAgent::NetworkAgent(NetworkInspector* inspector,
                            v8_inspector::V8Inspector* v8_inspector)
-    : inspector_(inspector), v8_inspector_(v8_inspector) {
+    : inspector_(inspector),
+      v8_inspector_(v8_inspector),
+      max_total_buffer_size_(kDefaultMaxTotalBufferSize),
+      max_resource_buffer_size_(kDefaultMaxResourceBufferSize),
+      self_(std::make_shared<NetworkAgent*>(this)) {
   event_notifier_map_["requestWillBeSent"] = &NetworkAgent::requestWillBeSent;
   event_notifier_map_["responseReceived"] = &NetworkAgent::responseReceived;
   event_notifier_map_["loadingFailed"] = &NetworkAgent::loadingFailed;
@@ -215,35 +231,176 @@ void NetworkAgent::Wire(protocol::UberDispatcher* dispatcher) {
   protocol::Network::Dispatcher::wire(dispatcher, this);
 }
 
-protocol::DispatchResponse NetworkAgent::enable() {
+protocol::DispatchResponse NetworkAgent::enable(
+    protocol::Maybe<int> in_maxTotalBufferSize,
+    protocol::Maybe<int> in_maxResourceBufferSize,
+    protocol::Maybe<int> in_sampleInterval) {
+  if (in_maxTotalBufferSize.value_or(0) < 0 ||
+      in_maxResourceBufferSize.value_or(0) < 0) {
+    return protocol::DispatchResponse::InvalidParams(
+        "Buffer sizes must not be negative");
+  }
+  if (in_sampleInterval.value_or(1) < 1) {
+    return protocol::DispatchResponse::InvalidParams(
+        "sampleInterval must be a positive integer");
+  }
+  max_total_buffer_size_ =
+      in_maxTotalBufferSize.value_or(kDefaultMaxTotalBufferSize);
+  max_resource_buffer_size_ =
+      in_maxResourceBufferSize.value_or(kDefaultMaxResourceBufferSize);
+  sample_interval_ = in_sampleInterval.value_or(1);
+  request_count_ = 0;
+  EnforceBufferLimits();
   inspector_->Enable();
   return protocol::DispatchResponse::Success();
 }
 
 protocol::DispatchResponse NetworkAgent::disable() {
   inspector_->Disable();
+  // Nothing is sent for these anymore, there is no point in holding on to
+  // them.
+  requests_.clear();
+  retained_requests_.clear();
+  total_buffered_size_ = 0;
+  pending_data_.clear();
   return protocol::DispatchResponse::Success();
 }
 
+bool NetworkAgent::IsTracked(const protocol::String& request_id) const {
+  return sample_interval_ == 1 || requests_.contains(request_id);
+}
+
+void NetworkAgent::BufferData(
+    std::map<protocol::String, RequestEntry>::iterator it,
+    const protocol::Binary& data) {
+  RequestEntry& entry = it->second;
+  if (entry.is_evicted) return;
+  if (entry.buffered_size + data.size() > max_resource_buffer_size_) {
+    // Like Chrome, do not keep a part of a body that is too large.
+    ClearBufferedData(&entry);
+    entry.is_evicted = true;
+    return;
+  }
+  entry.response_data_blobs.push_back(data);
+  entry.buffered_size += data.size();
+  total_buffered_size_ += data.size();
+  if (!entry.retained_position.has_value()) {
+    entry.retained_position =
+        retained_requests_.insert(retained_requests_.end(), it->first);
+  }
+  EnforceBufferLimits();
+}
+
+void NetworkAgent::ClearBufferedData(RequestEntry* entry) {
+  total_buffered_size_ -= entry->buffered_size;
+  entry->buffered_size = 0;
+  entry->response_data_blobs.clear();
+  if (entry->retained_position.has_value()) {
+    retained_requests_.erase(*entry->retained_position);
+    entry->retained_position.reset();
+  }
+}
+
+void NetworkAgent::EraseRequest(
+    std::map<protocol::String, RequestEntry>::iterator it) {
+  ClearBufferedData(&it->second);
+  requests_.erase(it);
+}
+
+void NetworkAgent::EnforceBufferLimits() {
+  while (!retained_requests_.empty() &&
+         (total_buffered_size_ > max_total_buffer_size_ ||
+          retained_requests_.size() > kMaxRetainedRequests)) {
+    auto it = requests_.find(retained_requests_.front());
+    CHECK_NE(it, requests_.end());
+    if (it->second.is_finished) {
+      EraseRequest(it);
+    } else {
+      ClearBufferedData(&it->second);
+      it->second.is_evicted = true;
+    }
+  }
+}
+
+void NetworkAgent::QueueData(const protocol::String& request_id,
+                             double timestamp,
+                             int data_length,
+                             int encoded_data_length,
+                             const protocol::Binary& data) {
+  auto [it, inserted] = pending_data_.try_emplace(
+      request_id, PendingData{timestamp, 0, 0, {}, 0});
+  PendingData& pending = it->second;
+  pending.timestamp = timestamp;
+  pending.data_length += data_length;
+  pending.encoded_data_length += encoded_data_length;
+  pending.blobs.push_back(data);
+  pending.size += data.size();
+  if (pending.size >= kMaxDataBatchSize) {
+    FlushData(request_id);
+    return;
+  }
+
+  if (flush_scheduled_) return;
+  flush_scheduled_ = true;
+  std::weak_ptr<NetworkAgent*> weak_self = self_;
+  inspector_->env()->SetImmediate([weak_self](Environment* env) {
+    if (std::shared_ptr<NetworkAgent*> self = weak_self.lock()) {
+      (*self)->flush_scheduled_ = false;
+      (*self)->FlushAllData();
+    }
+  });
+}
+
+void NetworkAgent::FlushData(const protocol::String& request_id) {
+  auto it = pending_data_.find(request_id);
+  if (it == pending_data_.end()) return;
+  PendingData pending = std::move(it->second);
+  pending_data_.erase(it);
+  SendData(request_id, pending);
+}
+
+void NetworkAgent::FlushAllData() {
+  std::map<protocol::String, PendingData> pending_data;
+  pending_data.swap(pending_data_);
+  for (const auto& [request_id, pending] : pending_data) {
+    SendData(request_id, pending);
+  }
+}
+
+void NetworkAgent::SendData(const protocol::String& request_id,
+                            const PendingData& pending) {
+  frontend_->dataReceived(request_id,
+                          pending.timestamp,
+                          pending.data_length,
+                          pending.encoded_data_length,
+                          pending.blobs.size() == 1
+                              ? pending.blobs[0]
+                              : protocol::Binary::concat(pending.blobs));
+}
+
 protocol::DispatchResponse NetworkAgent::streamResourceContent(
     const protocol::String& in_requestId, protocol::Binary* out_bufferedData) {
-  if (!requests_.contains(in_requestId)) {
+  auto it = requests_.find(in_requestId);
+  if (it == requests_.end()) {
     // Request not found, ignore it.
     return protocol::DispatchResponse::InvalidParams("Request not found");
   }
 
-  auto& it = requests_[in_requestId];
+  if (it->second.is_evicted) {
+    return protocol::DispatchResponse::ServerError(
+        "Request content was evicted from inspector cache");
+  }
 
-  it.is_streaming = true;
+  it->second.is_streaming = true;
 
   // Concat response bodies.
-  *out_bufferedData = protocol::Binary::concat(it.response_data_blobs);
+  *out_bufferedData = protocol::Binary::concat(it->second.response_data_blobs);
   // Clear buffered data.
-  it.response_data_blobs.clear();
+  ClearBufferedData(&it->second);
 
-  if (it.is_finished) {
+  if (it->second.is_finished) {
     // If the request is finished, remove the entry.
-    requests_.erase(in_requestId);
+    requests_.erase(it);
   }
 
   return protocol::DispatchResponse::Success();
@@ -255,6 +412,12 @@ void NetworkAgent::requestWillBeSent(v8::Local<v8::Context> context,
   if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id)) {
     return;
   }
+  const bool is_duplicate = requests_.contains(request_id);
+  // Sampled out requests are dropped before anything else is done for them,
+  // including the capture of the stack trace.
+  if (!is_duplicate && request_count_++ % sample_interval_ != 0) {
+    return;
+  }
   double timestamp;
   if (!ObjectGetDouble(context, params, "timestamp").To(&timestamp)) {
     return;
@@ -286,17 +449,18 @@ void NetworkAgent::requestWillBeSent(v8::Local<v8::Context> context,
                                timestamp,
                                wall_time);
 
-  if (requests_.contains(request_id)) {
+  if (is_duplicate) {
     // Duplicate entry, ignore it.
     return;
   }
-  requests_.emplace(request_id, RequestEntry{timestamp, false, false, {}});
+  requests_.emplace(request_id, RequestEntry{timestamp});
 }
 
 void NetworkAgent::responseReceived(v8::Local<v8::Context> context,
                                     v8::Local<v8::Object> params) {
   protocol::String request_id;
-  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id)) {
+  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id) ||
+      !IsTracked(request_id)) {
     return;
   }
   double timestamp;
@@ -322,7 +486,8 @@ void NetworkAgent::responseReceived(v8::Local<v8::Context> context,
 void NetworkAgent::loadingFailed(v8::Local<v8::Context> context,
                                  v8::Local<v8::Object> params) {
   protocol::String request_id;
-  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id)) {
+  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id) ||
+      !IsTracked(request_id)) {
     return;
   }
   double timestamp;
@@ -338,15 +503,18 @@ void NetworkAgent::loadingFailed(v8::Local<v8::Context> context,
     return;
   }
 
+  FlushData(request_id);
   frontend_->loadingFailed(request_id, timestamp, type, error_text);
 
-  requests_.erase(request_id);
+  auto request_entry = requests_.find(request_id);
+  if (request_entry != requests_.end()) EraseRequest(request_entry);
 }
 
 void NetworkAgent::loadingFinished(v8::Local<v8::Context> context,
                                    Local<v8::Object> params) {
   protocol::String request_id;
-  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id)) {
+  if (!ObjectGetProtocolString(context, params, "requestId").To(&request_id) ||
+      !IsTracked(request_id)) {
     return;
   }
   double timestamp;
@@ -354,6 +522,7 @@ void NetworkAgent::loadingFinished(v8::Local<v8::Context> context,
     return;
   }
 
+  FlushData(request_id);
   frontend_->loadingFinished(request_id, timestamp);
 
   auto request_entry = requests_.find(request_id);
@@ -362,12 +531,20 @@ void NetworkAgent::loadingFinished(v8::Local<v8::Context> context,
     return;
   }
 
-  if (request_entry->second.is_streaming) {
-    // Streaming finished, remove the entry.
-    requests_.erase(request_id);
-  } else {
-    request_entry->second.is_finished = true;
+  if (request_entry->second.is_streaming ||
+      request_entry->second.is_evicted) {
+    // Streaming finished, or there is nothing left to stream. Remove the
+    // entry.
+    EraseRequest(request_entry);
+    return;
+  }
+  request_entry->second.is_finished = true;
+  // The entry is kept for streamResourceContent, within the buffer limits.
+  if (!request_entry->second.retained_position.has_value()) {
+    request_entry->second.retained_position =
+        retained_requests_.insert(retained_requests_.end(), request_id);
   }
+  EnforceBufferLimits();
 }
 
 void NetworkAgent::dataReceived(v8::Local<v8::Context> context,
@@ -407,10 +584,10 @@ void NetworkAgent::dataReceived(v8::Local<v8::Context> context,
   auto data_bin = protocol::Binary::fromUint8Array(data);
 
   if (request_entry->second.is_streaming) {
-    frontend_->dataReceived(
+    QueueData(
         request_id, timestamp, data_length, encoded_data_length, data_bin);
   } else {
-    requests_[request_id].response_data_blobs.push_back(data_bin);
+    BufferData(request_entry, data_bin);
   }
 }
 
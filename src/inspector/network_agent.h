@@ -3,7 +3,10 @@
 
 #include "node/inspector/protocol/Network.h"
 
+#include <list>
 #include <map>
+#include <memory>
+#include <optional>
 #include <unordered_map>
 
 namespace node {
@@ -13,9 +16,26 @@ class NetworkInspector;
 
 struct RequestEntry {
   double timestamp;
-  bool is_finished;
-  bool is_streaming;
+  bool is_finished = false;
+  bool is_streaming = false;
+  // Set when the response body had to be dropped to stay within the buffer
+  // limits. It is not buffered anymore from then on.
+  bool is_evicted = false;
   std::vector<protocol::Binary> response_data_blobs;
+  size_t buffered_size = 0;
+  // The position of the request in NetworkAgent::retained_requests_, if it is
+  // there.
+  std::optional<std::list<protocol::String>::iterator> retained_position;
+};
+
+// The response data of a streamed request that is sent with the next
+// dataReceived event.
+struct PendingData {
+  double timestamp;
+  int data_length;
+  int encoded_data_length;
+  std::vector<protocol::Binary> blobs;
+  size_t size;
 };
 
 class NetworkAgent : public protocol::Network::Backend {
@@ -25,7 +45,10 @@ class NetworkAgent : public protocol::Network::Backend {
 
   void Wire(protocol::UberDispatcher* dispatcher);
 
-  protocol::DispatchResponse enable() override;
+  protocol::DispatchResponse enable(
+      protocol::Maybe<int> in_maxTotalBufferSize,
+      protocol::Maybe<int> in_maxResourceBufferSize,
+      protocol::Maybe<int> in_sampleInterval) override;
 
   protocol::DispatchResponse disable() override;
 
@@ -53,6 +76,28 @@ class NetworkAgent : public protocol::Network::Backend {
                     v8::Local<v8::Object> params);
 
  private:
+  // Whether the events of the request are sent to the frontend. With
+  // sampling, only those of the sampled requests are.
+  bool IsTracked(const protocol::String& request_id) const;
+
+  void BufferData(std::map<protocol::String, RequestEntry>::iterator it,
+                  const protocol::Binary& data);
+  void ClearBufferedData(RequestEntry* entry);
+  void EraseRequest(std::map<protocol::String, RequestEntry>::iterator it);
+  // Drops the response bodies of the oldest requests until the buffer limits
+  // are met again.
+  void EnforceBufferLimits();
+
+  void QueueData(const protocol::String& request_id,
+                 double timestamp,
+                 int data_length,
+                 int encoded_data_length,
+                 const protocol::Binary& data);
+  void FlushData(const protocol::String& request_id);
+  void FlushAllData();
+  void SendData(const protocol::String& request_id,
+                const PendingData& pending);
+
   NetworkInspector* inspector_;
   v8_inspector::V8Inspector* v8_inspector_;
   std::shared_ptr<protocol::Network::Frontend> frontend_;
@@ -60,6 +105,24 @@ class NetworkAgent : public protocol::Network::Backend {
                                                v8::Local<v8::Object>);
   std::unordered_map<protocol::String, EventNotifier> event_notifier_map_;
   std::map<protocol::String, RequestEntry> requests_;
+
+  size_t max_total_buffer_size_;
+  size_t max_resource_buffer_size_;
+  uint32_t sample_interval_ = 1;
+  uint64_t request_count_ = 0;
+  // The requests whose response body is buffered, or that are finished and
+  // wait for streamResourceContent, oldest first. This is what the buffer
+  // limits evict from.
+  std::list<protocol::String> retained_requests_;
+  size_t total_buffered_size_ = 0;
+
+  // The data of streamed requests is sent once per event loop iteration, in
+  // a single dataReceived event per request.
+  std::map<protocol::String, PendingData> pending_data_;
+  bool flush_scheduled_ = false;
+  // Expires with the agent, so that a scheduled flush does not outlive the
+  // session.
+  std::shared_ptr<NetworkAgent*> self_;
 };
 
 }  // namespace inspector
@@ -27,6 +27,7 @@ class NetworkInspector {
   void Enable();
   void Disable();
   bool IsEnabled() const { return enabled_; }
+  Environment* env() const { return env_; }
 
  private:
   bool enabled_;
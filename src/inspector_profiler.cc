@@ -7,12 +7,14 @@
 #include "node_external_reference.h"
 #include "node_file.h"
 #include "node_internals.h"
+#include "protobuf_writer.h"
 #include "util-inl.h"
 #include "v8-inspector.h"
 
 #include <cinttypes>
 #include <limits>
 #include <sstream>
+#include <unordered_map>
 #include "simdutf.h"
 
 namespace node {
@@ -237,8 +239,10 @@ void V8ProfilerConnection::WriteProfile(simdjson::ondemand::object* result) {
   if (!profile_opt.has_value()) {
     return;
   }
-  std::string_view profile = profile_opt.value();
+  WriteProfileToFile(profile_opt.value());
+}
 
+void V8ProfilerConnection::WriteProfileToFile(std::string_view profile) {
   // Create the directory if necessary.
   std::string directory = GetDirectory();
   DCHECK(!directory.empty());
@@ -393,10 +397,299 @@ std::string V8CpuProfilerConnection::GetDirectory() const {
   return env()->cpu_prof_dir();
 }
 
+static const char* CpuProfileExtension(Environment* env) {
+  return env->options()->cpu_prof_format == "pprof" ? "pprof" : "cpuprofile";
+}
+
 std::string V8CpuProfilerConnection::GetFilename() const {
+  if (env()->options()->cpu_prof_window > 0) {
+    // Every window is written to a new file.
+    DiagnosticFilename filename(env(), "CPU", CpuProfileExtension(env()));
+    return *filename;
+  }
   return env()->cpu_prof_name();
 }
 
+void V8ProfilerConnection::StartWindowTimer(uint64_t window_ms) {
+  CHECK_NULL(window_timer_);
+  window_timer_ = new uv_timer_t();
+  CHECK_EQ(uv_timer_init(env()->event_loop(), window_timer_), 0);
+  window_timer_->data = this;
+  CHECK_EQ(uv_timer_start(
+               window_timer_,
+               [](uv_timer_t* timer) {
+                 auto* connection =
+                     static_cast<V8ProfilerConnection*>(timer->data);
+                 Debug(connection->env(),
+                       DebugCategory::INSPECTOR_PROFILER,
+                       "Writing %s profile of the window\n",
+                       connection->type());
+                 connection->WriteWindow();
+               },
+               window_ms,
+               window_ms),
+           0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(window_timer_));
+}
+
+void V8ProfilerConnection::StopWindowTimer() {
+  if (window_timer_ == nullptr) return;
+  uv_close(reinterpret_cast<uv_handle_t*>(window_timer_),
+           [](uv_handle_t* handle) {
+             delete reinterpret_cast<uv_timer_t*>(handle);
+           });
+  window_timer_ = nullptr;
+}
+
+namespace {
+
+// Builds a profile in the pprof format, see
+// https://github.com/google/pprof/blob/main/proto/profile.proto.
+// The locations of the profiles written here have a single line each, and
+// use the ids of the nodes of the inspector profiles as their ids.
+class PprofBuilder {
+ public:
+  uint64_t String(std::string_view str) {
+    auto [it, inserted] =
+        string_ids_.emplace(std::string(str), strings_.size());
+    if (inserted) strings_.emplace_back(str);
+    return it->second;
+  }
+
+  // Adds a location for a RuntimeCallFrame of the inspector protocol.
+  bool AddLocation(uint64_t id, simdjson::ondemand::object* call_frame) {
+    std::string_view name;
+    std::string_view url;
+    int64_t line;
+    int64_t column;
+    if ((*call_frame)["functionName"].get_string().get(name) ||
+        (*call_frame)["url"].get_string().get(url) ||
+        (*call_frame)["lineNumber"].get_int64().get(line) ||
+        (*call_frame)["columnNumber"].get_int64().get(column)) {
+      return false;
+    }
+    // Line and column numbers are 0-based in the inspector protocol.
+    line++;
+    if (name.empty()) name = "(anonymous)";
+
+    std::string key = std::string(name) + '\0' + std::string(url) + '\0' +
+                      std::to_string(line) + ':' + std::to_string(column);
+    auto [function, inserted] =
+        function_ids_.emplace(key, function_ids_.size() + 1);
+    if (inserted) {
+      ProtobufWriter message;
+      message.AppendVarint(kFunctionId, function->second);
+      message.AppendVarint(kFunctionName, String(name));
+      message.AppendVarint(kFunctionSystemName, String(name));
+      message.AppendVarint(kFunctionFilename, String(url));
+      message.AppendVarint(kFunctionStartLine, line);
+      profile_.AppendMessage(kProfileFunction, message);
+    }
+
+    ProtobufWriter line_message;
+    line_message.AppendVarint(kLineFunctionId, function->second);
+    line_message.AppendVarint(kLineLine, line);
+    ProtobufWriter location;
+    location.AppendVarint(kLocationId, id);
+    location.AppendMessage(kLocationLine, line_message);
+    profile_.AppendMessage(kProfileLocation, location);
+    return true;
+  }
+
+  // The location ids are ordered from the leaf to the root.
+  void AddSample(const std::vector<uint64_t>& location_ids,
+                 const std::vector<uint64_t>& values) {
+    ProtobufWriter sample;
+    sample.AppendPackedVarints(kSampleLocationId, location_ids);
+    sample.AppendPackedVarints(kSampleValue, values);
+    profile_.AppendMessage(kProfileSample, sample);
+  }
+
+  void AddSampleType(std::string_view type, std::string_view unit) {
+    profile_.AppendMessage(kProfileSampleType, ValueType(type, unit));
+  }
+
+  void SetPeriod(std::string_view type, std::string_view unit,
+                 uint64_t period) {
+    profile_.AppendMessage(kProfilePeriodType, ValueType(type, unit));
+    profile_.AppendVarint(kProfilePeriod, period);
+  }
+
+  // pprof wants the wall clock time at which the profile started, the
+  // timestamps of the inspector profiles are monotonic.
+  void SetDuration(uint64_t duration_ns) {
+    uint64_t now_ns =
+        static_cast<uint64_t>(GetCurrentTimeInMicroseconds()) * 1000;
+    profile_.AppendVarint(kProfileTimeNanos, now_ns - duration_ns);
+    profile_.AppendVarint(kProfileDurationNanos, duration_ns);
+  }
+
+  std::string Finish() {
+    for (const std::string& str : strings_) {
+      profile_.AppendString(kProfileStringTable, str);
+    }
+    return profile_.release();
+  }
+
+ private:
+  // Profile, Sample, Location, Line, Function and ValueType fields.
+  enum : uint32_t {
+    kProfileSampleType = 1,
+    kProfileSample = 2,
+    kProfileLocation = 4,
+    kProfileFunction = 5,
+    kProfileStringTable = 6,
+    kProfileTimeNanos = 9,
+    kProfileDurationNanos = 10,
+    kProfilePeriodType = 11,
+    kProfilePeriod = 12,
+  };
+  enum : uint32_t { kSampleLocationId = 1, kSampleValue = 2 };
+  enum : uint32_t { kLocationId = 1, kLocationLine = 4 };
+  enum : uint32_t { kLineFunctionId = 1, kLineLine = 2 };
+  enum : uint32_t {
+    kFunctionId = 1,
+    kFunctionName = 2,
+    kFunctionSystemName = 3,
+    kFunctionFilename = 4,
+    kFunctionStartLine = 5,
+  };
+  enum : uint32_t { kValueTypeType = 1, kValueTypeUnit = 2 };
+
+  ProtobufWriter ValueType(std::string_view type, std::string_view unit) {
+    ProtobufWriter value_type;
+    value_type.AppendVarint(kValueTypeType, String(type));
+    value_type.AppendVarint(kValueTypeUnit, String(unit));
+    return value_type;
+  }
+
+  ProtobufWriter profile_;
+  std::vector<std::string> strings_ = {""};
+  std::unordered_map<std::string, uint64_t> string_ids_ = {{"", 0}};
+  std::unordered_map<std::string, uint64_t> function_ids_;
+};
+
+// Parses the raw JSON of a profile, which has to be copied to add the
+// padding that simdjson needs.
+class ProfileParser {
+ public:
+  explicit ProfileParser(std::string_view json)
+      : buffer_(json), length_(json.size()) {
+    buffer_.append(simdjson::SIMDJSON_PADDING, ' ');
+  }
+
+  bool Parse(simdjson::ondemand::object* profile) {
+    return !parser_
+                .iterate(simdjson::padded_string_view(
+                    buffer_.data(), length_, buffer_.size()))
+                .get(document_) &&
+           !document_.get_object().get(*profile);
+  }
+
+ private:
+  std::string buffer_;
+  size_t length_;
+  simdjson::ondemand::parser parser_;
+  simdjson::ondemand::document document_;
+};
+
+// Returns the path from a node to the root, excluding the root, which has
+// no frame of its own.
+std::vector<uint64_t> GetStack(
+    uint64_t id, const std::unordered_map<uint64_t, uint64_t>& parents) {
+  std::vector<uint64_t> stack;
+  for (auto it = parents.find(id); it != parents.end();
+       it = parents.find(it->second)) {
+    stack.push_back(it->first);
+  }
+  return stack;
+}
+
+}  // namespace
+
+// Converts a Profile of the Profiler domain into pprof. The hit count of
+// every node becomes the sample of its stack.
+static bool CpuProfileToPprof(std::string_view json,
+                              uint64_t interval_us,
+                              std::string* out) {
+  ProfileParser parser(json);
+  simdjson::ondemand::object profile;
+  simdjson::ondemand::array nodes;
+  if (!parser.Parse(&profile) || profile["nodes"].get_array().get(nodes)) {
+    return false;
+  }
+
+  PprofBuilder pprof;
+  std::vector<std::pair<uint64_t, uint64_t>> hit_counts;
+  std::unordered_map<uint64_t, uint64_t> parents;
+  for (auto element : nodes) {
+    simdjson::ondemand::object node;
+    simdjson::ondemand::object call_frame;
+    uint64_t id;
+    if (element.get_object().get(node) || node["id"].get_uint64().get(id) ||
+        node["callFrame"].get_object().get(call_frame) ||
+        !pprof.AddLocation(id, &call_frame)) {
+      return false;
+    }
+    uint64_t hit_count;
+    if (!node["hitCount"].get_uint64().get(hit_count) && hit_count > 0) {
+      hit_counts.emplace_back(id, hit_count);
+    }
+    simdjson::ondemand::array children;
+    if (!node["children"].get_array().get(children)) {
+      for (auto child : children) {
+        uint64_t child_id;
+        if (child.get_uint64().get(child_id)) return false;
+        parents[child_id] = id;
+      }
+    }
+  }
+
+  int64_t start_time = 0;
+  int64_t end_time = 0;
+  if (profile["startTime"].get_int64().get(start_time) ||
+      profile["endTime"].get_int64().get(end_time)) {
+    return false;
+  }
+
+  for (auto [id, hit_count] : hit_counts) {
+    pprof.AddSample(GetStack(id, parents),
+                    {hit_count, hit_count * interval_us * 1000});
+  }
+  pprof.AddSampleType("samples", "count");
+  pprof.AddSampleType("cpu", "nanoseconds");
+  pprof.SetPeriod("cpu", "nanoseconds", interval_us * 1000);
+  pprof.SetDuration(static_cast<uint64_t>(end_time - start_time) * 1000);
+  *out = pprof.Finish();
+  return true;
+}
+
+void V8CpuProfilerConnection::WriteProfile(
+    simdjson::ondemand::object* result) {
+  if (env()->options()->cpu_prof_format != "pprof") {
+    V8ProfilerConnection::WriteProfile(result);
+    return;
+  }
+  auto profile_opt = GetProfile(result);
+  if (!profile_opt.has_value()) {
+    return;
+  }
+  std::string pprof;
+  if (!CpuProfileToPprof(
+          profile_opt.value(), env()->cpu_prof_interval(), &pprof)) {
+    fprintf(stderr, "Failed to convert the CPU profile to pprof\n");
+    return;
+  }
+  WriteProfileToFile(pprof);
+}
+
+void V8CpuProfilerConnection::WriteWindow() {
+  // Profiler.stop returns the profile synchronously, so it has been written
+  // by the time the next one is started.
+  DispatchMessage("Profiler.stop", nullptr, true);
+  DispatchMessage("Profiler.start");
+}
+
 void V8CpuProfilerConnection::Start() {
   DispatchMessage("Profiler.enable");
   std::string params = R"({ "interval": )";
@@ -404,6 +697,11 @@ void V8CpuProfilerConnection::Start() {
   params += " }";
   DispatchMessage("Profiler.setSamplingInterval", params.c_str());
   DispatchMessage("Profiler.start");
+
+  uint64_t window = env()->options()->cpu_prof_window;
+  if (window > 0) {
+    StartWindowTimer(window);
+  }
 }
 
 void V8CpuProfilerConnection::End() {
@@ -414,6 +712,7 @@ void V8CpuProfilerConnection::End() {
     return;
   }
   ending_ = true;
+  StopWindowTimer();
   DispatchMessage("Profiler.stop", nullptr, true);
 }
 
@@ -421,16 +720,145 @@ std::string V8HeapProfilerConnection::GetDirectory() const {
   return env()->heap_prof_dir();
 }
 
+static const char* HeapProfileExtension(Environment* env) {
+  return env->options()->heap_prof_format == "pprof" ? "pprof"
+                                                     : "heapprofile";
+}
+
 std::string V8HeapProfilerConnection::GetFilename() const {
+  if (env()->options()->heap_prof_window > 0) {
+    // Every window is written to a new file.
+    DiagnosticFilename filename(env(), "Heap", HeapProfileExtension(env()));
+    return *filename;
+  }
   return env()->heap_prof_name();
 }
 
+namespace {
+
+struct HeapProfileNode {
+  uint64_t id;
+  uint64_t self_size;
+};
+
+// Adds a SamplingHeapProfileNode of the HeapProfiler domain and its
+// children, which are nested in it.
+bool AddHeapProfileNode(simdjson::ondemand::object* node,
+                        uint64_t parent,
+                        PprofBuilder* pprof,
+                        std::vector<HeapProfileNode>* nodes,
+                        std::unordered_map<uint64_t, uint64_t>* parents) {
+  simdjson::ondemand::object call_frame;
+  HeapProfileNode result;
+  if ((*node)["callFrame"].get_object().get(call_frame) ||
+      (*node)["selfSize"].get_uint64().get(result.self_size) ||
+      (*node)["id"].get_uint64().get(result.id)) {
+    return false;
+  }
+  // The root is not part of the stacks.
+  if (parent != 0) {
+    if (!pprof->AddLocation(result.id, &call_frame)) return false;
+    (*parents)[result.id] = parent;
+  }
+  if (result.self_size > 0) nodes->push_back(result);
+
+  simdjson::ondemand::array children;
+  if ((*node)["children"].get_array().get(children)) return false;
+  for (auto element : children) {
+    simdjson::ondemand::object child;
+    if (element.get_object().get(child) ||
+        !AddHeapProfileNode(&child, result.id, pprof, nodes, parents)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// Converts a SamplingHeapProfile of the HeapProfiler domain into pprof. It
+// contains the sampled allocations that are still alive, so the samples are
+// the retained objects and bytes of every stack.
+static bool HeapProfileToPprof(std::string_view json,
+                               uint64_t interval_bytes,
+                               std::string* out) {
+  ProfileParser parser(json);
+  simdjson::ondemand::object profile;
+  simdjson::ondemand::object head;
+  if (!parser.Parse(&profile) || profile["head"].get_object().get(head)) {
+    return false;
+  }
+
+  PprofBuilder pprof;
+  std::vector<HeapProfileNode> nodes;
+  std::unordered_map<uint64_t, uint64_t> parents;
+  if (!AddHeapProfileNode(&head, 0, &pprof, &nodes, &parents)) {
+    return false;
+  }
+
+  std::unordered_map<uint64_t, uint64_t> counts;
+  simdjson::ondemand::array samples;
+  if (!profile["samples"].get_array().get(samples)) {
+    for (auto element : samples) {
+      simdjson::ondemand::object sample;
+      uint64_t node_id;
+      if (element.get_object().get(sample) ||
+          sample["nodeId"].get_uint64().get(node_id)) {
+        return false;
+      }
+      counts[node_id]++;
+    }
+  }
+
+  for (const HeapProfileNode& node : nodes) {
+    if (parents.count(node.id) == 0) continue;
+    pprof.AddSample(GetStack(node.id, parents),
+                    {counts[node.id], node.self_size});
+  }
+  pprof.AddSampleType("objects", "count");
+  pprof.AddSampleType("space", "bytes");
+  pprof.SetPeriod("space", "bytes", interval_bytes);
+  pprof.SetDuration(0);
+  *out = pprof.Finish();
+  return true;
+}
+
+void V8HeapProfilerConnection::WriteProfile(
+    simdjson::ondemand::object* result) {
+  if (env()->options()->heap_prof_format != "pprof") {
+    V8ProfilerConnection::WriteProfile(result);
+    return;
+  }
+  auto profile_opt = GetProfile(result);
+  if (!profile_opt.has_value()) {
+    return;
+  }
+  std::string pprof;
+  if (!HeapProfileToPprof(
+          profile_opt.value(), env()->heap_prof_interval(), &pprof)) {
+    fprintf(stderr, "Failed to convert the heap profile to pprof\n");
+    return;
+  }
+  WriteProfileToFile(pprof);
+}
+
+void V8HeapProfilerConnection::WriteWindow() {
+  // Unlike stopping and restarting the sampling, this keeps the samples of
+  // the allocations that are still alive.
+  DispatchMessage("HeapProfiler.getSamplingProfile", nullptr, true);
+}
+
 void V8HeapProfilerConnection::Start() {
   DispatchMessage("HeapProfiler.enable");
   std::string params = R"({ "samplingInterval": )";
   params += std::to_string(env()->heap_prof_interval());
   params += " }";
   DispatchMessage("HeapProfiler.startSampling", params.c_str());
+
+  uint64_t window = env()->options()->heap_prof_window;
+  if (window > 0) {
+    StartWindowTimer(window);
+  }
 }
 
 void V8HeapProfilerConnection::End() {
@@ -441,6 +869,7 @@ void V8HeapProfilerConnection::End() {
     return;
   }
   ending_ = true;
+  StopWindowTimer();
   DispatchMessage("HeapProfiler.stopSampling", nullptr, true);
 }
 
@@ -483,7 +912,7 @@ void StartProfilers(Environment* env) {
     env->set_cpu_prof_dir(dir.empty() ? Environment::GetCwd(env->exec_path())
                                       : dir);
     if (env->options()->cpu_prof_name.empty()) {
-      DiagnosticFilename filename(env, "CPU", "cpuprofile");
+      DiagnosticFilename filename(env, "CPU", CpuProfileExtension(env));
       env->set_cpu_prof_name(*filename);
     } else {
       env->set_cpu_prof_name(env->options()->cpu_prof_name);
@@ -499,7 +928,7 @@ void StartProfilers(Environment* env) {
     env->set_heap_prof_dir(dir.empty() ? Environment::GetCwd(env->exec_path())
                                        : dir);
     if (env->options()->heap_prof_name.empty()) {
-      DiagnosticFilename filename(env, "Heap", "heapprofile");
+      DiagnosticFilename filename(env, "Heap", HeapProfileExtension(env));
       env->set_heap_prof_name(*filename);
     } else {
       env->set_heap_prof_name(env->options()->heap_prof_name);
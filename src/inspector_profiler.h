@@ -11,6 +11,7 @@
 #include <unordered_set>
 #include "inspector_agent.h"
 #include "simdjson.h"
+#include "uv.h"
 
 namespace node {
 // Forward declaration to break recursive dependency chain with src/env.h.
@@ -64,6 +65,8 @@ class V8ProfilerConnection {
   virtual std::optional<std::string_view> GetProfile(
       simdjson::ondemand::object* result);
   virtual void WriteProfile(simdjson::ondemand::object* result);
+  // Writes the profile to GetFilename() in GetDirectory().
+  void WriteProfileToFile(std::string_view profile);
 
   bool HasProfileId(uint64_t id) const {
     return profile_ids_.find(id) != profile_ids_.end();
@@ -76,8 +79,17 @@ class V8ProfilerConnection {
   std::unique_ptr<inspector::InspectorSession> session_;
   uint64_t id_ = 1;
   std::unordered_set<uint64_t> profile_ids_;
+  // It is allocated separately because it is closed in End(), which runs at
+  // exit, possibly after the last turn of the event loop.
+  uv_timer_t* window_timer_ = nullptr;
 
  protected:
+  // Calls WriteWindow() every window_ms milliseconds, without keeping the
+  // event loop alive, until StopWindowTimer() is called.
+  void StartWindowTimer(uint64_t window_ms);
+  void StopWindowTimer();
+  virtual void WriteWindow() {}
+
   simdjson::ondemand::parser json_parser_;
   Environment* env_ = nullptr;
 };
@@ -119,6 +131,10 @@ class V8CpuProfilerConnection : public V8ProfilerConnection {
 
   std::string GetDirectory() const override;
   std::string GetFilename() const override;
+  void WriteProfile(simdjson::ondemand::object* result) override;
+
+ protected:
+  void WriteWindow() override;
 
  private:
   std::unique_ptr<inspector::InspectorSession> session_;
@@ -138,6 +154,10 @@ class V8HeapProfilerConnection : public V8ProfilerConnection {
 
   std::string GetDirectory() const override;
   std::string GetFilename() const override;
+  void WriteProfile(simdjson::ondemand::object* result) override;
+
+ protected:
+  void WriteWindow() override;
 
  private:
   std::unique_ptr<inspector::InspectorSession> session_;
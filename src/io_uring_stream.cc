@@ -0,0 +1,767 @@
+#include "io_uring_stream.h"
+
+#ifdef NODE_HAVE_IO_URING_STREAMS
+
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_errors.h"
+#include "stream_base-inl.h"
+#include "stream_wrap.h"
+#include "util-inl.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>  // IOV_MAX
+#include <cstring>
+
+namespace node {
+
+using errors::TryCatchScope;
+using v8::Context;
+using v8::HandleScope;
+
+namespace {
+
+constexpr unsigned kSubmissionQueueEntries = 1024;
+// Every chunk of data that arrives on a socket produces a completion, so the
+// completion queue is much larger than the submission queue. The kernel keeps
+// the completions that do not fit (IORING_FEAT_NODROP) until they are reaped.
+constexpr unsigned kCompletionQueueEntries = 16384;
+// The provided buffers are shared by all sockets. A socket whose data does
+// not fit into the free buffers gets ENOBUFS and its recv is armed again, the
+// data waits in the socket in the meantime.
+constexpr unsigned kBufferCount = 256;
+constexpr size_t kBufferSize = 16 * 1024;
+constexpr uint16_t kBufferGroup = 0;
+constexpr size_t kMaxSendIov = IOV_MAX;
+
+static_assert((kBufferCount & (kBufferCount - 1)) == 0,
+              "The number of provided buffers must be a power of 2");
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+void* MapRing(int fd, size_t size, off_t offset) {
+  void* ring = mmap(nullptr,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd,
+                    offset);
+  return ring == MAP_FAILED ? nullptr : ring;
+}
+
+void* MapAnonymous(size_t size) {
+  void* memory = mmap(nullptr,
+                      size,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1,
+                      0);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+// ============================================================================
+// IoUringStreamBackend
+
+IoUringStreamBackend* IoUringStreamBackend::Get(Environment* env) {
+  if (env->io_uring_stream_backend_) return env->io_uring_stream_backend_.get();
+  if (env->io_uring_stream_backend_unavailable_) return nullptr;
+
+  std::unique_ptr<IoUringStreamBackend> backend(new IoUringStreamBackend(env));
+  if (!backend->Init()) {
+    Debug(env,
+          DebugCategory::DIAGNOSTICS,
+          "io_uring is not available for sockets, using libuv instead\n");
+    env->io_uring_stream_backend_unavailable_ = true;
+    return nullptr;
+  }
+  env->io_uring_stream_backend_ = std::move(backend);
+  return env->io_uring_stream_backend_.get();
+}
+
+IoUringStreamBackend::IoUringStreamBackend(Environment* env) : env_(env) {}
+
+bool IoUringStreamBackend::Init() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionQueueEntries;
+  ring_fd_ = IoUringSetup(kSubmissionQueueEntries, &params);
+  if (ring_fd_ < 0) {
+    // ENOSYS, or EPERM if io_uring has been disabled or is blocked.
+    ring_fd_ = -1;
+    return false;
+  }
+  if ((params.features & IORING_FEAT_NODROP) == 0) return false;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  cq_ring_ = MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(
+      MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  if (sq_ring_ == nullptr || cq_ring_ == nullptr || sqes_ == nullptr)
+    return false;
+
+  sq_head_ = RingField<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_flags_ = RingField<uint32_t>(sq_ring_, params.sq_off.flags);
+  sq_array_ = RingField<uint32_t>(sq_ring_, params.sq_off.array);
+  sq_mask_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sqe_tail_ = *sq_tail_;
+  cq_head_ = RingField<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingField<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+  // Multishot recv has been added in the same release (Linux 6.0) as
+  // IORING_OP_SEND_ZC, which unlike the former can be probed for. Cancelling
+  // all requests on a file descriptor is a little older.
+  constexpr unsigned kProbeOps = 256;
+  std::unique_ptr<char[]> probe_storage(new char[
+      sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op)]());
+  io_uring_probe* probe =
+      reinterpret_cast<io_uring_probe*>(probe_storage.get());
+  if (IoUringRegister(ring_fd_, IORING_REGISTER_PROBE, probe, kProbeOps) != 0)
+    return false;
+  for (unsigned op : {IORING_OP_RECV,
+                      IORING_OP_SENDMSG,
+                      IORING_OP_ASYNC_CANCEL,
+                      IORING_OP_SEND_ZC}) {
+    if (op >= probe->ops_len ||
+        (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+      return false;
+    }
+  }
+
+  buf_ring_size_ = kBufferCount * sizeof(io_uring_buf);
+  buf_ring_ = static_cast<io_uring_buf_ring*>(MapAnonymous(buf_ring_size_));
+  buffers_ = static_cast<char*>(MapAnonymous(kBufferCount * kBufferSize));
+  if (buf_ring_ == nullptr || buffers_ == nullptr) return false;
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uintptr_t>(buf_ring_);
+  reg.ring_entries = kBufferCount;
+  reg.bgid = kBufferGroup;
+  if (IoUringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+    return false;
+  buf_ring_registered_ = true;
+  for (unsigned bid = 0; bid < kBufferCount; bid++) RecycleBuffer(bid);
+  PublishBuffers();
+
+  // The ring's file descriptor is readable while there are completions.
+  poll_handle_ = new uv_poll_t();
+  CHECK_EQ(uv_poll_init(env_->event_loop(), poll_handle_, ring_fd_), 0);
+  poll_handle_->data = this;
+  CHECK_EQ(uv_poll_start(poll_handle_,
+                         UV_READABLE,
+                         [](uv_poll_t* handle, int status, int events) {
+                           static_cast<IoUringStreamBackend*>(handle->data)
+                               ->Dispatch();
+                         }),
+           0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(poll_handle_));
+
+  // The writes are submitted right before libuv polls for I/O, so that all
+  // writes of an event loop iteration go out with one system call.
+  prepare_handle_ = new uv_prepare_t();
+  CHECK_EQ(uv_prepare_init(env_->event_loop(), prepare_handle_), 0);
+  prepare_handle_->data = this;
+  CHECK_EQ(uv_prepare_start(prepare_handle_,
+                            [](uv_prepare_t* handle) {
+                              static_cast<IoUringStreamBackend*>(handle->data)
+                                  ->Flush();
+                            }),
+           0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(prepare_handle_));
+
+  env_->AddCleanupHook(CleanupHook, this);
+  return true;
+}
+
+IoUringStreamBackend::~IoUringStreamBackend() {
+  if (poll_handle_ != nullptr) {
+    env_->RemoveCleanupHook(CleanupHook, this);
+    env_->CloseHandle(poll_handle_, [](uv_poll_t* handle) { delete handle; });
+    env_->CloseHandle(prepare_handle_,
+                      [](uv_prepare_t* handle) { delete handle; });
+  }
+  if (buf_ring_registered_) {
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = kBufferGroup;
+    IoUringRegister(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+  }
+  if (buffers_ != nullptr) munmap(buffers_, kBufferCount * kBufferSize);
+  if (buf_ring_ != nullptr) munmap(buf_ring_, buf_ring_size_);
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ != -1) close(ring_fd_);
+}
+
+void IoUringStreamBackend::CleanupHook(void* arg) {
+  // All streams have been closed by now.
+  Environment* env = static_cast<IoUringStreamBackend*>(arg)->env_;
+  env->io_uring_stream_backend_.reset();
+}
+
+io_uring_sqe* IoUringStreamBackend::GetSqe() {
+  if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_)
+    Submit();
+  const uint32_t index = sqe_tail_ & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  sqe_tail_++;
+  to_submit_++;
+  return sqe;
+}
+
+void IoUringStreamBackend::Submit() {
+  __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+  while (to_submit_ > 0) {
+    int ret = IoUringEnter(ring_fd_, to_submit_, 0, 0);
+    if (ret > 0) {
+      to_submit_ -= ret;
+      continue;
+    }
+    if (ret == 0) break;
+    // EBUSY and EAGAIN mean that the completions have to be reaped first.
+    CHECK(errno == EINTR || errno == EBUSY || errno == EAGAIN);
+    if (errno != EINTR) {
+      Reap();
+      ScheduleDispatch();
+    }
+  }
+}
+
+void IoUringStreamBackend::Reap() {
+  for (;;) {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      Op* op = reinterpret_cast<Op*>(static_cast<uintptr_t>(cqe.user_data));
+      if (op == nullptr) continue;  // A cancellation.
+      IoUringStream* stream = op->stream;
+      if (op->type == Op::kSend || (cqe.flags & IORING_CQE_F_MORE) == 0) {
+        CHECK_GT(stream->in_flight_, 0);
+        stream->in_flight_--;
+      }
+      stream->queued_completions_++;
+      completions_.push_back(Completion{op, cqe.res, cqe.flags});
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    if ((__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) &
+         IORING_SQ_CQ_OVERFLOW) == 0) {
+      break;
+    }
+    // Have the kernel move the completions that did not fit into the queue.
+    IoUringEnter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+  }
+}
+
+void IoUringStreamBackend::Dispatch() {
+  Reap();
+
+  std::vector<IoUringStream*> ready_streams;
+  ready_streams.swap(ready_streams_);
+  for (IoUringStream* stream : ready_streams) stream->in_ready_streams_ = false;
+  for (IoUringStream* stream : ready_streams) {
+    HandleScope scope(env_->isolate());
+    Context::Scope context_scope(env_->context());
+    TryCatchScope try_catch(env_);
+    try_catch.SetVerbose(true);
+    stream->DeliverStash();
+  }
+
+  // The callbacks may close streams, which reaps more completions, so this
+  // cannot hold on to any references into completions_.
+  for (size_t i = 0; i < completions_.size(); i++) {
+    const Completion completion = completions_[i];
+    if (completion.op == nullptr) continue;
+    IoUringStream* stream = completion.op->stream;
+    stream->queued_completions_--;
+    HandleScope scope(env_->isolate());
+    Context::Scope context_scope(env_->context());
+    TryCatchScope try_catch(env_);
+    try_catch.SetVerbose(true);
+    if (completion.op->type == Op::kRecv) {
+      stream->OnRecv(completion.res, completion.flags);
+    } else {
+      stream->OnSend(completion.res);
+    }
+  }
+  completions_.clear();
+
+  PublishBuffers();
+}
+
+void IoUringStreamBackend::ScheduleDispatch() {
+  if (dispatch_scheduled_) return;
+  dispatch_scheduled_ = true;
+  env_->SetImmediate([](Environment* env) {
+    IoUringStreamBackend* backend = env->io_uring_stream_backend_.get();
+    if (backend == nullptr) return;
+    backend->dispatch_scheduled_ = false;
+    backend->Dispatch();
+  });
+}
+
+void IoUringStreamBackend::Flush() {
+  std::vector<IoUringStream*> streams;
+  streams.swap(flush_queue_);
+  for (IoUringStream* stream : streams) {
+    stream->in_flush_queue_ = false;
+    stream->PrepareSend();
+  }
+  if (to_submit_ > 0) Submit();
+}
+
+void IoUringStreamBackend::WaitForStream(IoUringStream* stream) {
+  Forget(stream);
+  if (stream->in_flight_ == 0) return;
+
+  io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = stream->fd_;
+  sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  Submit();
+
+  // Cancelling a request on a socket completes it right away, unless it is
+  // just being completed anyway.
+  while (stream->in_flight_ > 0) {
+    if (IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+      CHECK(errno == EINTR || errno == EBUSY || errno == EAGAIN);
+    Reap();
+  }
+  if (!completions_.empty()) ScheduleDispatch();
+}
+
+void IoUringStreamBackend::Forget(IoUringStream* stream) {
+  if (stream->in_flush_queue_) {
+    stream->in_flush_queue_ = false;
+    flush_queue_.erase(
+        std::remove(flush_queue_.begin(), flush_queue_.end(), stream),
+        flush_queue_.end());
+  }
+  if (stream->in_ready_streams_) {
+    stream->in_ready_streams_ = false;
+    ready_streams_.erase(
+        std::remove(ready_streams_.begin(), ready_streams_.end(), stream),
+        ready_streams_.end());
+  }
+}
+
+char* IoUringStreamBackend::buffer(uint16_t bid) const {
+  return buffers_ + static_cast<size_t>(bid) * kBufferSize;
+}
+
+void IoUringStreamBackend::RecycleBuffer(uint16_t bid) {
+  // The tail of the ring overlays the `resv` field of the first entry, so
+  // the entries cannot be assigned as a whole.
+  io_uring_buf* buf = &buf_ring_->bufs[buf_tail_ & (kBufferCount - 1)];
+  buf->addr = reinterpret_cast<uintptr_t>(buffer(bid));
+  buf->len = kBufferSize;
+  buf->bid = bid;
+  buf_tail_++;
+}
+
+void IoUringStreamBackend::PublishBuffers() {
+  __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+void IoUringStreamBackend::Ref() {
+  if (ref_count_++ == 0)
+    uv_ref(reinterpret_cast<uv_handle_t*>(poll_handle_));
+}
+
+void IoUringStreamBackend::Unref() {
+  CHECK_GT(ref_count_, 0);
+  if (--ref_count_ == 0)
+    uv_unref(reinterpret_cast<uv_handle_t*>(poll_handle_));
+}
+
+// ============================================================================
+// IoUringStream
+
+std::unique_ptr<IoUringStream> IoUringStream::Create(LibuvStreamWrap* wrap) {
+  Environment* env = wrap->env();
+  if (!env->options()->experimental_io_uring_sockets) return {};
+  // IPC pipes pass handles along with the data, which only libuv can do.
+  if (!wrap->is_tcp() && (!wrap->is_named_pipe() || wrap->is_named_pipe_ipc()))
+    return {};
+  // Do not take over from libuv while it is reading or writing.
+  uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(wrap->stream());
+  if (uv_is_active(handle) || wrap->stream()->write_queue_size != 0) return {};
+
+  // Pipes can also be opened on file descriptors that are not sockets.
+  uv_os_fd_t fd;
+  int type;
+  socklen_t length = sizeof(type);
+  if (uv_fileno(handle, &fd) != 0 ||
+      getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) != 0 ||
+      type != SOCK_STREAM) {
+    return {};
+  }
+
+  IoUringStreamBackend* backend = IoUringStreamBackend::Get(env);
+  if (backend == nullptr) return {};
+  return std::make_unique<IoUringStream>(backend, wrap, fd);
+}
+
+IoUringStream::IoUringStream(IoUringStreamBackend* backend,
+                             LibuvStreamWrap* wrap,
+                             int fd)
+    : backend_(backend),
+      wrap_(wrap),
+      fd_(fd),
+      recv_op_{IoUringStreamBackend::Op::kRecv, this},
+      send_op_{IoUringStreamBackend::Op::kSend, this} {
+  memset(&send_msg_, 0, sizeof(send_msg_));
+}
+
+IoUringStream::~IoUringStream() {
+  CHECK_EQ(in_flight_, 0);
+  CHECK_EQ(queued_completions_, 0);
+  CHECK(!ref_counted_);
+}
+
+int IoUringStream::ReadStart() {
+  if (closing_) return UV_EINVAL;
+  if (recv_fallback_) return wrap_->UvReadStart();
+  reading_ = true;
+  if (!stash_.empty() || stash_status_ != 0) {
+    // Like libuv, do not call back into the listener from ReadStart().
+    if (!in_ready_streams_) {
+      in_ready_streams_ = true;
+      backend_->ready_streams_.push_back(this);
+    }
+    backend_->ScheduleDispatch();
+  }
+  if (!recv_armed_ && stash_status_ == 0) ArmRecv();
+  UpdateRef();
+  return 0;
+}
+
+int IoUringStream::ReadStop() {
+  if (recv_fallback_) return wrap_->UvReadStop();
+  reading_ = false;
+  // The data that arrives until the recv has been cancelled is stashed.
+  if (recv_armed_ && !recv_cancelled_) {
+    io_uring_sqe* sqe = backend_->GetSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = reinterpret_cast<uintptr_t>(&recv_op_);
+    recv_cancelled_ = true;
+  }
+  UpdateRef();
+  return 0;
+}
+
+int IoUringStream::Write(WriteWrap* req_wrap, uv_buf_t* bufs, size_t count) {
+  if (closing_) return UV_EBADF;
+  if (shut_down_) return UV_EPIPE;
+  if (write_error_ != 0) return write_error_;
+
+  QueuedWrite write{req_wrap, std::vector<uv_buf_t>(bufs, bufs + count)};
+  for (size_t i = 0; i < count; i++) write_queue_size_ += bufs[i].len;
+  writes_.push_back(std::move(write));
+  if (writes_in_flight_ == 0 && !in_flush_queue_) {
+    in_flush_queue_ = true;
+    backend_->flush_queue_.push_back(this);
+  }
+  UpdateRef();
+  return 0;
+}
+
+bool IoUringStream::DeferShutdown(ShutdownWrap* req_wrap) {
+  shut_down_ = true;
+  if (writes_.empty()) return false;
+  pending_shutdown_ = req_wrap;
+  UpdateRef();
+  return true;
+}
+
+void IoUringStream::Close() {
+  if (closing_) return;
+  closing_ = true;
+  reading_ = false;
+  stash_.clear();
+  backend_->WaitForStream(this);
+  UpdateRef();
+}
+
+void IoUringStream::OnClose() {
+  CHECK(closing_);
+  CHECK_EQ(in_flight_, 0);
+  // Finish what has been completed but not dispatched yet. The writes are
+  // reported before the handle is gone, as libuv does.
+  std::vector<IoUringStreamBackend::Completion>& completions =
+      backend_->completions_;
+  for (size_t i = 0; queued_completions_ > 0 && i < completions.size(); i++) {
+    IoUringStreamBackend::Op* op = completions[i].op;
+    if (op == nullptr || op->stream != this) continue;
+    const int32_t res = completions[i].res;
+    const uint32_t flags = completions[i].flags;
+    completions[i].op = nullptr;
+    queued_completions_--;
+    if (op->type == IoUringStreamBackend::Op::kRecv) {
+      OnRecv(res, flags);
+    } else {
+      OnSend(res);
+    }
+  }
+  backend_->PublishBuffers();
+
+  FailWrites(UV_ECANCELED);
+  if (pending_shutdown_ != nullptr) {
+    ShutdownWrap* req_wrap = pending_shutdown_;
+    pending_shutdown_ = nullptr;
+    req_wrap->Done(UV_ECANCELED);
+  }
+}
+
+void IoUringStream::UpdateRef() {
+  const bool active =
+      !closing_ &&
+      ((reading_ && !recv_fallback_) || !writes_.empty() ||
+       pending_shutdown_ != nullptr) &&
+      uv_has_ref(reinterpret_cast<uv_handle_t*>(wrap_->stream()));
+  if (active == ref_counted_) return;
+  ref_counted_ = active;
+  if (active) {
+    backend_->Ref();
+  } else {
+    backend_->Unref();
+  }
+}
+
+void IoUringStream::ArmRecv() {
+  io_uring_sqe* sqe = backend_->GetSqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd_;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = kBufferGroup;
+  sqe->user_data = reinterpret_cast<uintptr_t>(&recv_op_);
+  recv_armed_ = true;
+  in_flight_++;
+}
+
+void IoUringStream::OnRecv(int32_t res, uint32_t flags) {
+  if ((flags & IORING_CQE_F_MORE) == 0) {
+    recv_armed_ = false;
+    recv_cancelled_ = false;
+  }
+
+  if ((flags & IORING_CQE_F_BUFFER) != 0) {
+    const uint16_t bid = flags >> IORING_CQE_BUFFER_SHIFT;
+    if (res > 0 && !closing_) {
+      const char* data = backend_->buffer(bid);
+      received_data_ = true;
+      if (reading_ && stash_.empty()) {
+        Deliver(data, res);
+      } else {
+        stash_.emplace_back(data, data + res);
+      }
+    }
+    backend_->RecycleBuffer(bid);
+  }
+  if (closing_) return;
+
+  int status = 0;
+  if (res == 0) {
+    status = UV_EOF;
+  } else if (res < 0) {
+    switch (res) {
+      case -ECANCELED:
+      case -ENOBUFS:
+        // ReadStop() or Close(), or the provided buffers ran out. The recv is
+        // armed again below if the stream is still reading.
+        break;
+      case -EINVAL:
+      case -EOPNOTSUPP:
+      case -ENOTSOCK:
+        // Multishot recv is not supported by the kernel or not for this kind
+        // of socket.
+        if (!received_data_) {
+          recv_fallback_ = true;
+          if (reading_) {
+            reading_ = false;
+            UpdateRef();
+            int err = wrap_->UvReadStart();
+            if (err != 0) wrap_->EmitRead(err);
+          }
+          return;
+        }
+        status = res;
+        break;
+      default:
+        status = res;
+    }
+  }
+
+  if (status != 0) {
+    stash_status_ = status;
+  } else if (reading_ && !recv_armed_ && stash_status_ == 0) {
+    ArmRecv();
+  }
+  if (reading_) DeliverStash();
+}
+
+void IoUringStream::Deliver(const char* data, size_t length) {
+  size_t offset = 0;
+  while (offset < length && reading_ && !closing_) {
+    uv_buf_t buf = wrap_->EmitAlloc(length - offset);
+    if (buf.base == nullptr || buf.len == 0) {
+      // Same as libuv when the listener does not provide a buffer.
+      reading_ = false;
+      UpdateRef();
+      wrap_->EmitRead(UV_ENOBUFS, buf);
+      return;
+    }
+    const size_t n = std::min(buf.len, length - offset);
+    memcpy(buf.base, data + offset, n);
+    offset += n;
+    wrap_->EmitRead(n, buf);
+  }
+  // The listener stopped reading before it got all of the data.
+  if (offset < length && !closing_)
+    stash_.emplace_front(data + offset, data + length);
+}
+
+void IoUringStream::DeliverStash() {
+  while (reading_ && !closing_ && !stash_.empty()) {
+    std::vector<char> chunk = std::move(stash_.front());
+    stash_.pop_front();
+    Deliver(chunk.data(), chunk.size());
+  }
+  if (reading_ && !closing_ && stash_.empty() && stash_status_ != 0) {
+    // As with libuv, the stream stops reading on EOF and errors.
+    const int status = stash_status_;
+    stash_status_ = 0;
+    reading_ = false;
+    UpdateRef();
+    wrap_->EmitRead(status);
+  }
+}
+
+void IoUringStream::PrepareSend() {
+  if (closing_ || writes_in_flight_ != 0 || writes_.empty()) return;
+
+  send_iov_.clear();
+  for (const QueuedWrite& write : writes_) {
+    for (size_t i = write.first_buf;
+         i < write.bufs.size() && send_iov_.size() < kMaxSendIov;
+         i++) {
+      send_iov_.push_back(iovec{write.bufs[i].base, write.bufs[i].len});
+    }
+    writes_in_flight_++;
+    if (send_iov_.size() == kMaxSendIov) break;
+  }
+
+  memset(&send_msg_, 0, sizeof(send_msg_));
+  send_msg_.msg_iov = send_iov_.data();
+  send_msg_.msg_iovlen = send_iov_.size();
+  io_uring_sqe* sqe = backend_->GetSqe();
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(&send_msg_);
+  sqe->len = 1;
+  sqe->msg_flags = MSG_NOSIGNAL;
+  sqe->user_data = reinterpret_cast<uintptr_t>(&send_op_);
+  in_flight_++;
+}
+
+void IoUringStream::OnSend(int32_t res) {
+  writes_in_flight_ = 0;
+  std::vector<std::pair<WriteWrap*, int>> finished;
+
+  if (res >= 0) {
+    // Skip what has been sent, and finish the writes that are complete.
+    size_t sent = res;
+    write_queue_size_ -= sent;
+    while (!writes_.empty()) {
+      QueuedWrite& write = writes_.front();
+      for (; write.first_buf < write.bufs.size(); write.first_buf++) {
+        uv_buf_t& buf = write.bufs[write.first_buf];
+        if (buf.len > sent) {
+          buf.base += sent;
+          buf.len -= sent;
+          sent = 0;
+          break;
+        }
+        sent -= buf.len;
+      }
+      if (write.first_buf < write.bufs.size()) break;
+      finished.emplace_back(write.req_wrap, 0);
+      writes_.pop_front();
+    }
+  } else if (res != -EINTR && res != -EAGAIN) {
+    // The socket is broken, or it is being closed.
+    write_error_ = closing_ ? UV_ECANCELED : res;
+    for (const QueuedWrite& write : writes_)
+      finished.emplace_back(write.req_wrap, write_error_);
+    writes_.clear();
+    write_queue_size_ = 0;
+  }
+
+  if (!writes_.empty() && !closing_ && !in_flush_queue_) {
+    in_flush_queue_ = true;
+    backend_->flush_queue_.push_back(this);
+  }
+  if (writes_.empty()) MaybeStartShutdown();
+  UpdateRef();
+
+  for (const auto& [req_wrap, status] : finished) req_wrap->Done(status);
+}
+
+void IoUringStream::FailWrites(int status) {
+  CHECK_EQ(writes_in_flight_, 0);
+  std::vector<WriteWrap*> failed;
+  for (const QueuedWrite& write : writes_) failed.push_back(write.req_wrap);
+  writes_.clear();
+  write_queue_size_ = 0;
+  UpdateRef();
+  for (WriteWrap* req_wrap : failed) req_wrap->Done(status);
+}
+
+void IoUringStream::MaybeStartShutdown() {
+  if (pending_shutdown_ == nullptr || closing_) return;
+  ShutdownWrap* req_wrap = pending_shutdown_;
+  pending_shutdown_ = nullptr;
+  int err = wrap_->DispatchShutdown(req_wrap);
+  if (err != 0) req_wrap->Done(err);
+}
+
+}  // namespace node
+
+#endif  // NODE_HAVE_IO_URING_STREAMS
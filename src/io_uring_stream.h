@@ -0,0 +1,264 @@
+#ifndef SRC_IO_URING_STREAM_H_
+#define SRC_IO_URING_STREAM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+// The backend needs multishot recv and provided buffer rings, so the kernel
+// headers have to be recent enough (Linux 6.0) for it to be built at all.
+// Like libuv, leave it out on the platforms on which io_uring is known to be
+// unusable.
+#if defined(__linux__) && !defined(__ANDROID__) &&                            \
+    !(defined(__arm__) && __SIZEOF_POINTER__ == 4) &&                         \
+    !defined(__powerpc64__) && !defined(__ppc64__)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ASYNC_CANCEL_FD)
+#define NODE_HAVE_IO_URING_STREAMS 1
+#endif
+#endif
+#endif
+
+#ifdef NODE_HAVE_IO_URING_STREAMS
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "uv.h"
+
+namespace node {
+
+class Environment;
+class IoUringStream;
+class LibuvStreamWrap;
+class ShutdownWrap;
+class WriteWrap;
+
+// With --experimental-io-uring-sockets, the sockets of TCPWrap and PipeWrap
+// are read and written through an io_uring instead of libuv's epoll
+// readiness notifications:
+//
+// - Reads are multishot recv requests that pick buffers from a ring of
+//   provided buffers. The ring is shared by all of the sockets of the
+//   Environment, so idle connections do not hold on to any read buffers. The
+//   data is handed to the stream listener in a buffer from EmitAlloc(), that
+//   is usually carved out of the Environment's stream read slab, and the
+//   provided buffer goes right back to the ring.
+// - Writes are queued and submitted once per event loop iteration, right
+//   before libuv polls for I/O. All writes that are queued on a socket by
+//   then go out with a single sendmsg, and the sendmsgs of all sockets are
+//   submitted with a single io_uring_enter.
+//
+// There is one backend per Environment. It is created when the first socket
+// uses it. When io_uring or one of the features is not available, the
+// sockets keep using libuv.
+class IoUringStreamBackend final {
+ public:
+  // Returns nullptr if io_uring cannot be used.
+  static IoUringStreamBackend* Get(Environment* env);
+
+  ~IoUringStreamBackend();
+
+  IoUringStreamBackend(const IoUringStreamBackend&) = delete;
+  IoUringStreamBackend& operator=(const IoUringStreamBackend&) = delete;
+
+ private:
+  friend class IoUringStream;
+
+  // What a submission queue entry belongs to, passed back in the user_data
+  // of its completion. Cancellations are not tracked, their user_data is 0.
+  struct Op {
+    enum Type { kRecv, kSend };
+    Type type;
+    IoUringStream* stream;
+  };
+
+  struct Completion {
+    Op* op;
+    int32_t res;
+    uint32_t flags;
+  };
+
+  explicit IoUringStreamBackend(Environment* env);
+  bool Init();
+
+  static void CleanupHook(void* arg);
+
+  io_uring_sqe* GetSqe();
+  void Submit();
+  // Moves the completions from the completion queue to completions_. This
+  // never calls into JavaScript, so it can be done at any time.
+  void Reap();
+  // Runs the callbacks of the completions that have been reaped, as well as
+  // those of the streams in ready_streams_.
+  void Dispatch();
+  void ScheduleDispatch();
+  // Submits the queued writes of the streams in flush_queue_, and all other
+  // queued submission queue entries.
+  void Flush();
+  // Waits until the stream has no requests in flight anymore.
+  void WaitForStream(IoUringStream* stream);
+  // Removes all references to a stream that is going away.
+  void Forget(IoUringStream* stream);
+
+  char* buffer(uint16_t bid) const;
+  void RecycleBuffer(uint16_t bid);
+  void PublishBuffers();
+
+  void Ref();
+  void Unref();
+
+  Environment* const env_;
+  int ring_fd_ = -1;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_flags_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  // The tail of the entries that have been queued, which is only made
+  // visible to the kernel by Submit().
+  uint32_t sqe_tail_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  // Entries that have been queued but not submitted yet.
+  uint32_t to_submit_ = 0;
+
+  io_uring_buf_ring* buf_ring_ = nullptr;
+  size_t buf_ring_size_ = 0;
+  char* buffers_ = nullptr;
+  bool buf_ring_registered_ = false;
+  uint16_t buf_tail_ = 0;
+
+  uv_poll_t* poll_handle_ = nullptr;
+  uv_prepare_t* prepare_handle_ = nullptr;
+  // The number of streams that are reading or writing and whose handle is
+  // referenced. The poll handle is referenced as long as there are any.
+  size_t ref_count_ = 0;
+
+  std::vector<Completion> completions_;
+  std::vector<IoUringStream*> flush_queue_;
+  // Streams with data that arrived while they were not reading.
+  std::vector<IoUringStream*> ready_streams_;
+  bool dispatch_scheduled_ = false;
+};
+
+// The io_uring state of a LibuvStreamWrap.
+class IoUringStream final {
+ public:
+  // Returns nullptr if the stream cannot use io_uring, in which case it
+  // keeps using libuv.
+  static std::unique_ptr<IoUringStream> Create(LibuvStreamWrap* wrap);
+
+  IoUringStream(IoUringStreamBackend* backend, LibuvStreamWrap* wrap, int fd);
+  ~IoUringStream();
+
+  IoUringStream(const IoUringStream&) = delete;
+  IoUringStream& operator=(const IoUringStream&) = delete;
+
+  int ReadStart();
+  int ReadStop();
+  int Write(WriteWrap* req_wrap, uv_buf_t* bufs, size_t count);
+  // Returns false if there are no writes in flight, in which case the
+  // shutdown can be started right away. Otherwise, it is started once the
+  // writes are done.
+  bool DeferShutdown(ShutdownWrap* req_wrap);
+
+  // Called when the handle is closed. Cancels everything that is in flight.
+  void Close();
+  // Called from the close callback of the handle. Finishes the writes that
+  // have been cancelled, like libuv does before the close callback.
+  void OnClose();
+  // Called when the handle has been referenced or unreferenced.
+  void UpdateRef();
+
+  bool has_pending_writes() const { return !writes_.empty(); }
+  bool has_pending_shutdown() const { return pending_shutdown_ != nullptr; }
+  size_t write_queue_size() const { return write_queue_size_; }
+
+ private:
+  friend class IoUringStreamBackend;
+
+  struct QueuedWrite {
+    WriteWrap* req_wrap;
+    // The part of the data that has not been written yet.
+    std::vector<uv_buf_t> bufs;
+    size_t first_buf = 0;
+  };
+
+  void ArmRecv();
+  void OnRecv(int32_t res, uint32_t flags);
+  void OnSend(int32_t res);
+  void PrepareSend();
+  void FailWrites(int status);
+  void Deliver(const char* data, size_t length);
+  void DeliverStash();
+  void MaybeStartShutdown();
+
+  IoUringStreamBackend* const backend_;
+  LibuvStreamWrap* const wrap_;
+  const int fd_;
+
+  IoUringStreamBackend::Op recv_op_;
+  IoUringStreamBackend::Op send_op_;
+  // The number of requests of this stream in the kernel.
+  size_t in_flight_ = 0;
+  // The number of completions of this stream in backend_->completions_.
+  size_t queued_completions_ = 0;
+
+  bool reading_ = false;
+  bool recv_armed_ = false;
+  bool recv_cancelled_ = false;
+  // Set when the first multishot recv did not work out and the stream reads
+  // through libuv instead.
+  bool recv_fallback_ = false;
+  bool received_data_ = false;
+  bool closing_ = false;
+  bool ref_counted_ = false;
+  bool in_flush_queue_ = false;
+  bool in_ready_streams_ = false;
+  // Data that arrived after ReadStop(), before the recv was cancelled, and
+  // the EOF or error that ended it, if any.
+  std::deque<std::vector<char>> stash_;
+  int stash_status_ = 0;
+
+  std::deque<QueuedWrite> writes_;
+  // The number of writes at the front of writes_ that the sendmsg in flight
+  // covers. 0 if there is none.
+  size_t writes_in_flight_ = 0;
+  size_t write_queue_size_ = 0;
+  std::vector<iovec> send_iov_;
+  msghdr send_msg_;
+  // The first error of a write, with which all later writes fail.
+  int write_error_ = 0;
+  ShutdownWrap* pending_shutdown_ = nullptr;
+  bool shut_down_ = false;
+};
+
+}  // namespace node
+
+#else  // !NODE_HAVE_IO_URING_STREAMS
+
+namespace node {
+
+// So that Environment can hold a std::unique_ptr to it everywhere.
+class IoUringStreamBackend final {};
+
+}  // namespace node
+
+#endif  // NODE_HAVE_IO_URING_STREAMS
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_IO_URING_STREAM_H_
@@ -146,6 +146,26 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_create_function(napi_env env,
                                                         napi_callback cb,
                                                         void* data,
                                                         napi_value* result);
+#ifdef NAPI_EXPERIMENTAL
+#define NODE_API_EXPERIMENTAL_HAS_FAST_CALLS
+
+NAPI_EXTERN napi_status NAPI_CDECL node_api_create_function_with_fast_call(
+    napi_env env,
+    const char* utf8name,
+    size_t length,
+    napi_callback cb,
+    void* data,
+    const node_api_fast_function* fast_function,
+    napi_value* result);
+
+// Can be called from a fast call, which receives no napi_env.
+NAPI_EXTERN napi_status NAPI_CDECL
+node_api_get_fast_typedarray_contents(napi_value typedarray,
+                                      void* storage,
+                                      size_t storage_size,
+                                      const void** data,
+                                      size_t* byte_length);
+#endif  // NAPI_EXPERIMENTAL
 NAPI_EXTERN napi_status NAPI_CDECL napi_create_error(napi_env env,
                                                      napi_value code,
                                                      napi_value msg,
@@ -548,6 +568,13 @@ node_api_post_finalizer(node_api_basic_env env,
                         void* finalize_data,
                         void* finalize_hint);
 
+#define NODE_API_EXPERIMENTAL_HAS_REFERENCE_STATS
+
+NAPI_EXTERN napi_status NAPI_CDECL
+node_api_get_reference_stats(node_api_basic_env env,
+                             size_t* live_references,
+                             size_t* pending_finalizers);
+
 #endif  // NAPI_EXPERIMENTAL
 
 #if NAPI_VERSION >= 6
@@ -180,6 +180,34 @@ typedef struct {
   napi_status error_code;
 } napi_extended_error_info;
 
+#ifdef NAPI_EXPERIMENTAL
+typedef enum {
+  node_api_fast_void,  // Only valid as the return type.
+  node_api_fast_bool,
+  node_api_fast_int32,
+  node_api_fast_uint32,
+  node_api_fast_int64,
+  node_api_fast_uint64,
+  node_api_fast_float32,
+  node_api_fast_float64,
+  // Any JavaScript value, passed as a napi_value. Not valid as the return
+  // type.
+  node_api_fast_value,
+} node_api_fast_type;
+
+typedef struct {
+  // The C function to call. It receives the receiver as a napi_value,
+  // followed by the arguments described by arg_types.
+  const void* function;
+  node_api_fast_type return_type;
+  const node_api_fast_type* arg_types;
+  size_t arg_count;
+} node_api_fast_function;
+
+// Typed arrays that do not have an ArrayBuffer yet are at most this large.
+#define NODE_API_FAST_TYPEDARRAY_STORAGE_SIZE 64
+#endif  // NAPI_EXPERIMENTAL
+
 #if NAPI_VERSION >= 6
 typedef enum {
   napi_key_include_prototypes,
@@ -453,6 +453,33 @@ class FunctionCallbackWrapper {
     return napi_clear_last_error(env);
   }
 
+  static inline napi_status NewFunctionWithFastCall(
+      napi_env env,
+      napi_callback cb,
+      void* cb_data,
+      const v8::CFunction* c_function,
+      v8::Local<v8::Function>* result) {
+    v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb, cb_data);
+    RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), napi_generic_failure);
+
+    // Functions with a fast call cannot be used as constructors.
+    v8::Local<v8::FunctionTemplate> tpl =
+        v8::FunctionTemplate::New(env->isolate,
+                                  Invoke,
+                                  cbdata,
+                                  v8::Local<v8::Signature>(),
+                                  0,
+                                  v8::ConstructorBehavior::kThrow,
+                                  v8::SideEffectType::kHasSideEffect,
+                                  c_function);
+    v8::MaybeLocal<v8::Function> maybe_function =
+        tpl->GetFunction(env->context());
+    CHECK_MAYBE_EMPTY(env, maybe_function, napi_generic_failure);
+
+    *result = maybe_function.ToLocalChecked();
+    return napi_clear_last_error(env);
+  }
+
   napi_value GetNewTarget() {
     if (cbinfo_.IsConstructCall()) {
       return v8impl::JsValueFromV8LocalValue(cbinfo_.NewTarget());
@@ -651,6 +678,60 @@ void TrackedFinalizer::Finalize() {
   delete this;
 }
 
+static_assert(sizeof(Reference) <= ReferencePool::kObjectSize);
+static_assert(sizeof(ReferenceWithData) <= ReferencePool::kObjectSize);
+static_assert(sizeof(ReferenceWithFinalizer) <= ReferencePool::kObjectSize);
+
+void* ReferencePool::Allocate(size_t size) {
+  CHECK_LE(size, kObjectSize);
+  CHECK(!released_);
+  if (free_list_ == nullptr) AddSlab();
+  Slot* slot = free_list_;
+  free_list_ = slot->next_free;
+  slot->pool = this;
+  live_count_++;
+  return slot->object;
+}
+
+void ReferencePool::Free(void* ptr) {
+  Slot* slot = reinterpret_cast<Slot*>(static_cast<unsigned char*>(ptr) -
+                                       offsetof(Slot, object));
+  ReferencePool* pool = slot->pool;
+  slot->next_free = pool->free_list_;
+  pool->free_list_ = slot;
+  if (--pool->live_count_ == 0 && pool->released_) {
+    delete pool;
+  }
+}
+
+void ReferencePool::Release() {
+  released_ = true;
+  if (live_count_ == 0) {
+    delete this;
+  }
+}
+
+void ReferencePool::AddSlab() {
+  std::unique_ptr<Slot[]> slab(new Slot[kSlotsPerSlab]);
+  for (size_t i = 0; i < kSlotsPerSlab; i++) {
+    slab[i].next_free = free_list_;
+    free_list_ = &slab[i];
+  }
+  slabs_.push_back(std::move(slab));
+}
+
+void* Reference::operator new(size_t size, napi_env env) {
+  return env->reference_pool->Allocate(size);
+}
+
+void Reference::operator delete(void* ptr) {
+  ReferencePool::Free(ptr);
+}
+
+void Reference::operator delete(void* ptr, napi_env) {
+  ReferencePool::Free(ptr);
+}
+
 Reference::Reference(napi_env env,
                      v8::Local<v8::Value> value,
                      uint32_t initial_refcount,
@@ -677,7 +758,8 @@ Reference* Reference::New(napi_env env,
                           v8::Local<v8::Value> value,
                           uint32_t initial_refcount,
                           ReferenceOwnership ownership) {
-  Reference* reference = new Reference(env, value, initial_refcount, ownership);
+  Reference* reference =
+      new (env) Reference(env, value, initial_refcount, ownership);
   reference->Link(&env->reflist);
   return reference;
 }
@@ -764,8 +846,8 @@ ReferenceWithData* ReferenceWithData::New(napi_env env,
                                           uint32_t initial_refcount,
                                           ReferenceOwnership ownership,
                                           void* data) {
-  ReferenceWithData* reference =
-      new ReferenceWithData(env, value, initial_refcount, ownership, data);
+  ReferenceWithData* reference = new (env)
+      ReferenceWithData(env, value, initial_refcount, ownership, data);
   reference->Link(&env->reflist);
   return reference;
 }
@@ -786,13 +868,13 @@ ReferenceWithFinalizer* ReferenceWithFinalizer::New(
     void* finalize_data,
     void* finalize_hint) {
   ReferenceWithFinalizer* reference =
-      new ReferenceWithFinalizer(env,
-                                 value,
-                                 initial_refcount,
-                                 ownership,
-                                 finalize_callback,
-                                 finalize_data,
-                                 finalize_hint);
+      new (env) ReferenceWithFinalizer(env,
+                                       value,
+                                       initial_refcount,
+                                       ownership,
+                                       finalize_callback,
+                                       finalize_data,
+                                       finalize_hint);
   reference->Link(&env->finalizing_reflist);
   return reference;
 }
@@ -960,6 +1042,146 @@ napi_status NAPI_CDECL napi_create_function(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+#ifdef NAPI_EXPERIMENTAL
+
+namespace v8impl {
+namespace {
+
+bool ToCTypeInfoType(node_api_fast_type type, v8::CTypeInfo::Type* result) {
+  switch (type) {
+    case node_api_fast_void:
+      *result = v8::CTypeInfo::Type::kVoid;
+      return true;
+    case node_api_fast_bool:
+      *result = v8::CTypeInfo::Type::kBool;
+      return true;
+    case node_api_fast_int32:
+      *result = v8::CTypeInfo::Type::kInt32;
+      return true;
+    case node_api_fast_uint32:
+      *result = v8::CTypeInfo::Type::kUint32;
+      return true;
+    case node_api_fast_int64:
+      *result = v8::CTypeInfo::Type::kInt64;
+      return true;
+    case node_api_fast_uint64:
+      *result = v8::CTypeInfo::Type::kUint64;
+      return true;
+    case node_api_fast_float32:
+      *result = v8::CTypeInfo::Type::kFloat32;
+      return true;
+    case node_api_fast_float64:
+      *result = v8::CTypeInfo::Type::kFloat64;
+      return true;
+    case node_api_fast_value:
+      *result = v8::CTypeInfo::Type::kV8Value;
+      return true;
+  }
+  return false;
+}
+
+}  // end of anonymous namespace
+}  // end of namespace v8impl
+
+napi_status NAPI_CDECL
+node_api_create_function_with_fast_call(
+    napi_env env,
+    const char* utf8name,
+    size_t length,
+    napi_callback cb,
+    void* callback_data,
+    const node_api_fast_function* fast_function,
+    napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, cb);
+  CHECK_ARG(env, fast_function);
+  CHECK_ARG(env, fast_function->function);
+  RETURN_STATUS_IF_FALSE(
+      env,
+      fast_function->arg_count == 0 || fast_function->arg_types != nullptr,
+      napi_invalid_arg);
+
+  v8::CTypeInfo::Type return_type;
+  RETURN_STATUS_IF_FALSE(
+      env,
+      v8impl::ToCTypeInfoType(fast_function->return_type, &return_type) &&
+          return_type != v8::CTypeInfo::Type::kV8Value,
+      napi_invalid_arg);
+
+  auto fast_call = std::make_unique<v8impl::FastCallInfo>();
+  fast_call->arg_info.reserve(fast_function->arg_count + 1);
+  // The receiver.
+  fast_call->arg_info.emplace_back(v8::CTypeInfo::Type::kV8Value);
+  for (size_t i = 0; i < fast_function->arg_count; i++) {
+    v8::CTypeInfo::Type arg_type;
+    RETURN_STATUS_IF_FALSE(
+        env,
+        v8impl::ToCTypeInfoType(fast_function->arg_types[i], &arg_type) &&
+            arg_type != v8::CTypeInfo::Type::kVoid,
+        napi_invalid_arg);
+    fast_call->arg_info.emplace_back(arg_type);
+  }
+  fast_call->function_info = std::make_unique<v8::CFunctionInfo>(
+      v8::CTypeInfo(return_type),
+      static_cast<unsigned int>(fast_call->arg_info.size()),
+      fast_call->arg_info.data());
+  v8::CFunction c_function(fast_function->function,
+                           fast_call->function_info.get());
+
+  v8::Local<v8::Function> return_value;
+  v8::EscapableHandleScope scope(env->isolate);
+  v8::Local<v8::Function> fn;
+  STATUS_CALL(v8impl::FunctionCallbackWrapper::NewFunctionWithFastCall(
+      env, cb, callback_data, &c_function, &fn));
+  env->fast_calls.push_back(std::move(fast_call));
+  return_value = scope.Escape(fn);
+
+  if (utf8name != nullptr) {
+    v8::Local<v8::String> name_string;
+    CHECK_NEW_FROM_UTF8_LEN(env, name_string, utf8name, length);
+    return_value->SetName(name_string);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(return_value);
+
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL
+node_api_get_fast_typedarray_contents(napi_value typedarray,
+                                      void* storage,
+                                      size_t storage_size,
+                                      const void** data,
+                                      size_t* byte_length) {
+  // There is no env to record the error in, and nothing must be allocated
+  // on the JavaScript heap, as this is called from fast calls.
+  if (typedarray == nullptr || data == nullptr || byte_length == nullptr) {
+    return napi_invalid_arg;
+  }
+  v8::Local<v8::Value> value = v8impl::V8LocalValueFromJsValue(typedarray);
+  if (!value->IsArrayBufferView()) {
+    return napi_invalid_arg;
+  }
+  v8::Local<v8::ArrayBufferView> view = value.As<v8::ArrayBufferView>();
+  size_t length = view->ByteLength();
+  if (view->HasBuffer()) {
+    *data = static_cast<const uint8_t*>(view->Buffer()->Data()) +
+            view->ByteOffset();
+  } else {
+    // Materializing the buffer would allocate, so the contents are copied.
+    if (storage == nullptr || storage_size < length) {
+      return napi_invalid_arg;
+    }
+    view->CopyContents(storage, length);
+    *data = storage;
+  }
+  *byte_length = length;
+  return napi_ok;
+}
+
+#endif  // NAPI_EXPERIMENTAL
+
 napi_status NAPI_CDECL
 napi_define_class(napi_env env,
                   const char* utf8name,
@@ -3483,6 +3705,19 @@ napi_status NAPI_CDECL node_api_post_finalizer(node_api_basic_env basic_env,
   return napi_clear_last_error(env);
 }
 
+napi_status NAPI_CDECL
+node_api_get_reference_stats(node_api_basic_env basic_env,
+                             size_t* live_references,
+                             size_t* pending_finalizers) {
+  napi_env env = const_cast<napi_env>(basic_env);
+  CHECK_ENV(env);
+  CHECK_ARG(env, live_references);
+  CHECK_ARG(env, pending_finalizers);
+  *live_references = env->reference_pool->live_count();
+  *pending_finalizers = env->pending_finalizers.size();
+  return napi_clear_last_error(env);
+}
+
 #endif
 
 napi_status NAPI_CDECL napi_adjust_external_memory(node_api_basic_env env,
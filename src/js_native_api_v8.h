@@ -3,6 +3,11 @@
 
 #include "js_native_api_types.h"
 #include "js_native_api_v8_internals.h"
+#include "v8-fast-api-calls.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 inline napi_status napi_clear_last_error(node_api_basic_env env);
 
@@ -44,8 +49,121 @@ class RefTracker {
   }
 
  private:
+  friend class FinalizerQueue;
+
   RefList* next_ = nullptr;
   RefList* prev_ = nullptr;
+  // The links in the FinalizerQueue of the env.
+  RefTracker* pending_next_ = nullptr;
+  RefTracker* pending_prev_ = nullptr;
+  bool pending_ = false;
+};
+
+// The finalizers whose second pass weak callbacks are pending, in the order
+// in which they were enqueued. The links live in the RefTrackers themselves,
+// so enqueueing and dequeueing is O(1) and does not allocate, even when the
+// GC collects many wrapped objects at once.
+class FinalizerQueue {
+ public:
+  bool empty() const { return head_ == nullptr; }
+  size_t size() const { return size_; }
+
+  inline void Push(RefTracker* tracker) {
+    if (tracker->pending_) return;
+    tracker->pending_ = true;
+    tracker->pending_prev_ = tail_;
+    tracker->pending_next_ = nullptr;
+    if (tail_ != nullptr) {
+      tail_->pending_next_ = tracker;
+    } else {
+      head_ = tracker;
+    }
+    tail_ = tracker;
+    size_++;
+  }
+
+  inline void Remove(RefTracker* tracker) {
+    if (!tracker->pending_) return;
+    if (tracker->pending_prev_ != nullptr) {
+      tracker->pending_prev_->pending_next_ = tracker->pending_next_;
+    } else {
+      head_ = tracker->pending_next_;
+    }
+    if (tracker->pending_next_ != nullptr) {
+      tracker->pending_next_->pending_prev_ = tracker->pending_prev_;
+    } else {
+      tail_ = tracker->pending_prev_;
+    }
+    tracker->pending_prev_ = nullptr;
+    tracker->pending_next_ = nullptr;
+    tracker->pending_ = false;
+    size_--;
+  }
+
+  // Returns nullptr when the queue is empty.
+  inline RefTracker* Pop() {
+    RefTracker* tracker = head_;
+    if (tracker != nullptr) Remove(tracker);
+    return tracker;
+  }
+
+ private:
+  RefTracker* head_ = nullptr;
+  RefTracker* tail_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Hands out the memory of the References of an env from slabs and keeps the
+// memory of deleted References for reuse, as addons that wrap many native
+// objects create and delete References at a high rate.
+//
+// Each slot records the pool it belongs to, so a Reference can be deleted
+// without its env. The env releases the pool when it is deleted; the pool
+// then frees itself once the userland References that outlive the env are
+// deleted as well.
+class ReferencePool {
+ public:
+  // Large enough for any of the Reference classes, see the static_asserts in
+  // js_native_api_v8.cc.
+  static constexpr size_t kObjectSize = 96;
+  static constexpr size_t kSlotsPerSlab = 128;
+
+  ReferencePool() = default;
+  ReferencePool(const ReferencePool&) = delete;
+  ReferencePool& operator=(const ReferencePool&) = delete;
+
+  void* Allocate(size_t size);
+  static void Free(void* ptr);
+  // Called by the env that owns the pool when it is deleted.
+  void Release();
+
+  size_t live_count() const { return live_count_; }
+  size_t capacity() const { return slabs_.size() * kSlotsPerSlab; }
+
+ private:
+  struct Slot {
+    union {
+      ReferencePool* pool;
+      Slot* next_free;
+    };
+    alignas(std::max_align_t) unsigned char object[kObjectSize];
+  };
+
+  ~ReferencePool() = default;
+  void AddSlab();
+
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* free_list_ = nullptr;
+  size_t live_count_ = 0;
+  bool released_ = false;
+};
+
+// The signature of a function created with
+// node_api_create_function_with_fast_call(). V8 refers to it for as long as
+// the function exists, so it is kept until the env is deleted.
+struct FastCallInfo {
+  std::vector<v8::CTypeInfo> arg_info;
+  std::unique_ptr<v8::CFunctionInfo> function_info;
 };
 
 }  // end of namespace v8impl
@@ -109,13 +227,13 @@ struct napi_env__ {
   // Implementation should drain the queue at the time it is safe to call
   // into JavaScript.
   virtual void EnqueueFinalizer(v8impl::RefTracker* finalizer) {
-    pending_finalizers.emplace(finalizer);
+    pending_finalizers.Push(finalizer);
   }
 
   // Remove the finalizer from the scheduled second pass weak callback queue.
   // The finalizer can be deleted after this call.
   virtual void DequeueFinalizer(v8impl::RefTracker* finalizer) {
-    pending_finalizers.erase(finalizer);
+    pending_finalizers.Remove(finalizer);
   }
 
   virtual void DeleteMe() {
@@ -153,7 +271,9 @@ struct napi_env__ {
   v8impl::RefTracker::RefList reflist;
   v8impl::RefTracker::RefList finalizing_reflist;
   // The invocation order of the finalizers is not determined.
-  std::unordered_set<v8impl::RefTracker*> pending_finalizers;
+  v8impl::FinalizerQueue pending_finalizers;
+  v8impl::ReferencePool* const reference_pool = new v8impl::ReferencePool();
+  std::vector<std::unique_ptr<v8impl::FastCallInfo>> fast_calls;
   napi_extended_error_info last_error;
   int open_handle_scopes = 0;
   int open_callback_scopes = 0;
@@ -165,7 +285,7 @@ struct napi_env__ {
  protected:
   // Should not be deleted directly. Delete with `napi_env__::DeleteMe()`
   // instead.
-  virtual ~napi_env__() = default;
+  virtual ~napi_env__() { reference_pool->Release(); }
 };
 
 inline napi_status napi_clear_last_error(node_api_basic_env basic_env) {
@@ -398,6 +518,12 @@ class Reference : public RefTracker {
                         ReferenceOwnership ownership);
   ~Reference() override;
 
+  // References are allocated from the ReferencePool of their env.
+  static void* operator new(size_t size, napi_env env);
+  static void operator delete(void* ptr);
+  // Used when a constructor throws after the placement form above.
+  static void operator delete(void* ptr, napi_env env);
+
   uint32_t Ref();
   uint32_t Unref();
   v8::Local<v8::Value> Get(napi_env env);
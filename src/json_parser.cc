@@ -4,20 +4,18 @@
 #include "util-inl.h"
 
 namespace node {
-using v8::Array;
 using v8::Context;
 using v8::Isolate;
 using v8::Local;
-using v8::Object;
 using v8::String;
 using v8::Value;
 
-JSONParser::JSONParser() {}
-
-bool JSONParser::Parse(const std::string& content) {
-  DCHECK(!parsed_);
-
-  Isolate* isolate = isolate_.get();
+namespace {
+// simdjson only reports the kind of a syntax error. Parse the invalid
+// content again with V8, only to print the error with its position.
+void PrintSyntaxError(const std::string& content) {
+  RAIIIsolateWithoutEntering raii_isolate;
+  Isolate* isolate = raii_isolate.get();
   v8::Locker locker(isolate);
   v8::Isolate::Scope isolate_scope(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -29,127 +27,90 @@ bool JSONParser::Parse(const std::string& content) {
   errors::PrinterTryCatch bootstrapCatch(
       isolate, errors::PrinterTryCatch::kDontPrintSourceLine);
   Local<Value> json_string_value;
-  Local<Value> result_value;
-  if (!ToV8Value(context, content).ToLocal(&json_string_value) ||
-      !json_string_value->IsString() ||
-      !v8::JSON::Parse(context, json_string_value.As<String>())
-           .ToLocal(&result_value) ||
-      !result_value->IsObject()) {
+  if (ToV8Value(context, content).ToLocal(&json_string_value) &&
+      json_string_value->IsString()) {
+    USE(v8::JSON::Parse(context, json_string_value.As<String>()));
+  }
+}
+
+// Like JSON.parse(), use the last of duplicate keys. simdjson::dom::object's
+// lookup returns the first one.
+simdjson::error_code FindField(const simdjson::dom::object& object,
+                               std::string_view field,
+                               simdjson::dom::element* out) {
+  simdjson::error_code error = simdjson::NO_SUCH_FIELD;
+  for (auto [key, element] : object) {
+    if (key == field) {
+      *out = element;
+      error = simdjson::SUCCESS;
+    }
+  }
+  return error;
+}
+}  // namespace
+
+JSONParser::JSONParser() {}
+
+bool JSONParser::Parse(const std::string& content) {
+  DCHECK(!parsed_);
+
+  simdjson::dom::element document;
+  simdjson::error_code error =
+      parser_.parse(content.data(), content.size()).get(document);
+  if (error) {
+    PrintSyntaxError(content);
+    return false;
+  }
+  if (document.get_object().get(content_)) {
     return false;
   }
 
-  context_.Reset(isolate, context);
-  content_.Reset(isolate, result_value.As<Object>());
   parsed_ = true;
-
   return true;
 }
 
 std::optional<std::string> JSONParser::GetTopLevelStringField(
     std::string_view field) {
-  Isolate* isolate = isolate_.get();
-  v8::Locker locker(isolate);
-  v8::Isolate::Scope isolate_scope(isolate);
-  v8::HandleScope handle_scope(isolate);
-
-  Local<Context> context = context_.Get(isolate);
-  Context::Scope context_scope(context);
-
-  Local<Object> content_object = content_.Get(isolate);
-
-  Local<Value> value;
-  // It's not a real script, so don't print the source line.
-  errors::PrinterTryCatch bootstrapCatch(
-      isolate, errors::PrinterTryCatch::kDontPrintSourceLine);
-  Local<Value> field_local;
-  if (!ToV8Value(context, field, isolate).ToLocal(&field_local)) {
+  DCHECK(parsed_);
+  simdjson::dom::element element;
+  std::string_view value;
+  if (FindField(content_, field, &element) ||
+      element.get_string().get(value)) {
     return {};
   }
-  if (!content_object->Get(context, field_local).ToLocal(&value) ||
-      !value->IsString()) {
-    return {};
-  }
-  Utf8Value utf8_value(isolate, value);
-  return utf8_value.ToString();
+  return std::string(value);
 }
 
 std::optional<bool> JSONParser::GetTopLevelBoolField(std::string_view field) {
-  Isolate* isolate = isolate_.get();
-  v8::Locker locker(isolate);
-  v8::Isolate::Scope isolate_scope(isolate);
-  v8::HandleScope handle_scope(isolate);
-
-  Local<Context> context = context_.Get(isolate);
-  Context::Scope context_scope(context);
-
-  Local<Object> content_object = content_.Get(isolate);
-  Local<Value> value;
-  bool has_field;
-  // It's not a real script, so don't print the source line.
-  errors::PrinterTryCatch bootstrapCatch(
-      isolate, errors::PrinterTryCatch::kDontPrintSourceLine);
-  Local<Value> field_local;
-  if (!ToV8Value(context, field, isolate).ToLocal(&field_local)) {
-    return {};
-  }
-  if (!content_object->Has(context, field_local).To(&has_field)) {
-    return {};
-  }
-  if (!has_field) {
+  DCHECK(parsed_);
+  simdjson::dom::element value;
+  if (FindField(content_, field, &value)) {
     return false;
   }
-  if (!content_object->Get(context, field_local).ToLocal(&value) ||
-      !value->IsBoolean()) {
+  bool result;
+  if (value.get_bool().get(result)) {
     return {};
   }
-  return value->BooleanValue(isolate);
+  return result;
 }
 
 std::optional<JSONParser::StringDict> JSONParser::GetTopLevelStringDict(
     std::string_view field) {
-  Isolate* isolate = isolate_.get();
-  v8::Locker locker(isolate);
-  v8::Isolate::Scope isolate_scope(isolate);
-  v8::HandleScope handle_scope(isolate);
-  Local<Context> context = context_.Get(isolate);
-  Local<Object> content_object = content_.Get(isolate);
-  Local<Value> value;
-  bool has_field;
-  // It's not a real script, so don't print the source line.
-  errors::PrinterTryCatch bootstrapCatch(
-      isolate, errors::PrinterTryCatch::kDontPrintSourceLine);
-  Local<Value> field_local;
-  if (!ToV8Value(context, field, isolate).ToLocal(&field_local)) {
-    return std::nullopt;
-  }
-  if (!content_object->Has(context, field_local).To(&has_field)) {
-    return std::nullopt;
-  }
-  if (!has_field) {
+  DCHECK(parsed_);
+  simdjson::dom::element value;
+  if (FindField(content_, field, &value)) {
     return StringDict();
   }
-  if (!content_object->Get(context, field_local).ToLocal(&value) ||
-      !value->IsObject()) {
+  simdjson::dom::object dict;
+  if (value.get_object().get(dict)) {
     return std::nullopt;
   }
-  Local<Object> dict = value.As<Object>();
-  Local<Array> keys;
-  if (!dict->GetOwnPropertyNames(context).ToLocal(&keys)) {
-    return std::nullopt;
-  }
-  std::unordered_map<std::string, std::string> result;
-  uint32_t length = keys->Length();
-  for (uint32_t i = 0; i < length; ++i) {
-    Local<Value> key;
-    Local<Value> value;
-    if (!keys->Get(context, i).ToLocal(&key) || !key->IsString())
-      return StringDict();
-    if (!dict->Get(context, key).ToLocal(&value) || !value->IsString())
-      return StringDict();
-
-    Utf8Value key_utf8(isolate, key);
-    Utf8Value value_utf8(isolate, value);
-    result.emplace(*key_utf8, *value_utf8);
+  StringDict result;
+  for (auto [key, element] : dict) {
+    std::string_view element_value;
+    if (element.get_string().get(element_value)) return StringDict();
+    // Like JSON.parse(), keep the last of duplicate keys.
+    result.insert_or_assign(std::string(key), std::string(element_value));
   }
   return result;
 }
@@ -3,12 +3,11 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
-#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include "util.h"
-#include "v8.h"
+#include "simdjson.h"
 
 namespace node {
 // This is intended to be used to get some top-level fields out of a JSON
@@ -19,18 +18,18 @@ class JSONParser {
   using StringDict = std::unordered_map<std::string, std::string>;
   JSONParser();
   ~JSONParser() = default;
+  // Returns false if |content| is not a JSON object, and prints the reason
+  // to stderr if it is not valid JSON.
   bool Parse(const std::string& content);
   std::optional<std::string> GetTopLevelStringField(std::string_view field);
   std::optional<bool> GetTopLevelBoolField(std::string_view field);
   std::optional<StringDict> GetTopLevelStringDict(std::string_view field);
 
  private:
-  // We might want a lighter-weight JSON parser for this use case. But for now
-  // using V8 is good enough.
-  RAIIIsolateWithoutEntering isolate_;
-
-  v8::Global<v8::Context> context_;
-  v8::Global<v8::Object> content_;
+  // The document is only validated and indexed by Parse(). The fields are
+  // converted when they are looked up.
+  simdjson::dom::parser parser_;
+  simdjson::dom::object content_;
   bool parsed_ = false;
 };
 }  // namespace node
@@ -125,6 +125,21 @@ class JSONWriter {
     state_ = kAfterValue;
   }
 
+  // Writes the members of |object|, the text of a top-level object that was
+  // written by another JSONWriter with the same compactness, as members of
+  // the current top-level object.
+  inline void json_members(std::string_view object) {
+    std::string_view::size_type begin = object.find('{');
+    std::string_view::size_type end = object.rfind('}');
+    if (begin == std::string_view::npos || end <= begin) return;
+    std::string_view members = object.substr(begin + 1, end - begin - 1);
+    if (!members.empty() && members.back() == '\n') members.remove_suffix(1);
+    if (members.empty()) return;
+    if (state_ == kAfterValue) out_ << ',';
+    out_ << members;
+    state_ = kAfterValue;
+  }
+
   struct Null {};  // Usable as a JSON value.
 
   struct ForeignJSON {
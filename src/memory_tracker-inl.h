@@ -87,6 +87,10 @@ class MemoryRetainerNode : public v8::EmbedderGraph::Node {
     return retainer_ != nullptr && retainer_->IsCppgcWrapper();
   }
 
+  // Whether the node stands for a MemoryRetainer, as opposed to a field of
+  // one that is tracked with an explicit name and size.
+  bool IsRetainerNode() const { return retainer_ != nullptr; }
+
   v8::EmbedderGraph::Node::Detachedness GetDetachedness() override {
     return detachedness_;
   }
@@ -1,11 +1,12 @@
 #include "module_wrap.h"
 
-#include "env.h"
+#include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_contextify.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_internals.h"
+#include "node_mutex.h"
 #include "node_process-inl.h"
 #include "node_watchdog.h"
 #include "util-inl.h"
@@ -166,7 +167,7 @@ Local<PrimitiveArray> ModuleWrap::GetHostDefinedOptions(
 
 // new ModuleWrap(url, context, source, lineOffset, columnOffset[, cachedData]);
 // new ModuleWrap(url, context, source, lineOffset, columnOffset,
-//                idSymbol);
+//                idSymbol[, streamingJob]);
 // new ModuleWrap(url, context, exportNames, evaluationCallback[, cjsModule])
 void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
@@ -278,6 +279,14 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       }
       Local<String> source_text = args[2].As<String>();
 
+      std::unique_ptr<ScriptCompiler::StreamedSource> streamed_source;
+      if (args.Length() > 6 && args[6]->IsObject()) {
+        CHECK(can_use_builtin_cache);  // Only used by the default loader.
+        ModuleStreamingJob* job;
+        ASSIGN_OR_RETURN_UNWRAP(&job, args[6].As<Object>());
+        streamed_source = job->TakeSource();
+      }
+
       bool cache_rejected = false;
       if (!CompileSourceTextModule(realm,
                                    source_text,
@@ -286,7 +295,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
                                    column_offset,
                                    host_defined_options,
                                    user_cached_data,
-                                   &cache_rejected)
+                                   &cache_rejected,
+                                   streamed_source.get())
                .ToLocal(&module)) {
         if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
           CHECK(!try_catch.Message().IsEmpty());
@@ -366,7 +376,8 @@ MaybeLocal<Module> ModuleWrap::CompileSourceTextModule(
     int column_offset,
     Local<PrimitiveArray> host_defined_options,
     std::optional<ScriptCompiler::CachedData*> user_cached_data,
-    bool* cache_rejected) {
+    bool* cache_rejected,
+    ScriptCompiler::StreamedSource* streamed_source) {
   Isolate* isolate = realm->isolate();
   EscapableHandleScope scope(isolate);
   ScriptOrigin origin(url,
@@ -396,6 +407,24 @@ MaybeLocal<Module> ModuleWrap::CompileSourceTextModule(
     cached_data = cache_entry->CopyCache();
   }
 
+  // The streamed source is not used when there is a code cache to consume,
+  // which is faster than compiling the module again.
+  if (streamed_source != nullptr && cached_data == nullptr) {
+    Local<Module> module;
+    if (!ScriptCompiler::CompileModule(isolate->GetCurrentContext(),
+                                       streamed_source,
+                                       source_text,
+                                       origin)
+             .ToLocal(&module)) {
+      return scope.EscapeMaybe(MaybeLocal<Module>());
+    }
+    if (cache_entry != nullptr) {
+      realm->env()->compile_cache_handler()->MaybeSave(
+          cache_entry, module, false);
+    }
+    return scope.Escape(module);
+  }
+
   ScriptCompiler::Source source(source_text, origin, cached_data);
   ScriptCompiler::CompileOptions options;
   if (cached_data == nullptr) {
@@ -422,6 +451,160 @@ MaybeLocal<Module> ModuleWrap::CompileSourceTextModule(
   return scope.Escape(module);
 }
 
+namespace {
+
+// Hands the whole source text to V8 at once. The text is already in memory,
+// the streaming only moves the parsing off the main thread.
+class SourceTextStream final : public ScriptCompiler::ExternalSourceStream {
+ public:
+  SourceTextStream(std::unique_ptr<uint8_t[]> data, size_t length)
+      : data_(std::move(data)), length_(length) {}
+
+  size_t GetMoreData(const uint8_t** src) override {
+    if (data_ == nullptr) {
+      return 0;
+    }
+    *src = data_.release();
+    return length_;
+  }
+
+ private:
+  std::unique_ptr<uint8_t[]> data_;
+  size_t length_;
+};
+
+}  // anonymous namespace
+
+// Shared by the job and the task running on the worker thread, so that the
+// job can be destroyed while the task is still running.
+struct ModuleStreamingJob::State {
+  Mutex mutex;
+  ConditionVariable cond;
+  bool done = false;      // Protected by mutex.
+  bool detached = false;  // Protected by mutex.
+  Environment* env;
+  // Only accessed on the main thread.
+  ModuleStreamingJob* job;
+  std::unique_ptr<ScriptCompiler::StreamedSource> source;
+  std::unique_ptr<ScriptCompiler::ScriptStreamingTask> task;
+};
+
+class ModuleStreamingJob::StreamingTask final : public v8::Task {
+ public:
+  explicit StreamingTask(std::shared_ptr<State> state)
+      : state_(std::move(state)) {}
+
+  void Run() override {
+    state_->task->Run();
+    Mutex::ScopedLock lock(state_->mutex);
+    if (!state_->detached) {
+      state_->env->SetImmediateThreadsafe(
+          [state = state_](Environment* env) {
+            if (state->job != nullptr) {
+              state->job->OnStreamed();
+            }
+          });
+    }
+    state_->done = true;
+    state_->cond.Broadcast(lock);
+  }
+
+ private:
+  std::shared_ptr<State> state_;
+};
+
+ModuleStreamingJob::ModuleStreamingJob(Environment* env,
+                                       Local<Object> object,
+                                       Local<String> source_text)
+    : BaseObject(env, object), state_(std::make_shared<State>()) {
+  Isolate* isolate = env->isolate();
+  uint32_t length = source_text->Length();
+  size_t byte_length;
+  ScriptCompiler::StreamedSource::Encoding encoding;
+  std::unique_ptr<uint8_t[]> data;
+  if (source_text->IsOneByte()) {
+    byte_length = length;
+    encoding = ScriptCompiler::StreamedSource::ONE_BYTE;
+    data = std::make_unique<uint8_t[]>(byte_length);
+    source_text->WriteOneByteV2(isolate, 0, length, data.get());
+  } else {
+    byte_length = length * sizeof(uint16_t);
+    encoding = ScriptCompiler::StreamedSource::TWO_BYTE;
+    data = std::make_unique<uint8_t[]>(byte_length);
+    source_text->WriteV2(
+        isolate, 0, length, reinterpret_cast<uint16_t*>(data.get()));
+  }
+
+  state_->env = env;
+  state_->job = this;
+  state_->source = std::make_unique<ScriptCompiler::StreamedSource>(
+      std::make_unique<SourceTextStream>(std::move(data), byte_length),
+      encoding);
+  state_->task.reset(ScriptCompiler::StartStreaming(
+      isolate, state_->source.get(), v8::ScriptType::kModule));
+
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(env->context()).ToLocal(&resolver) ||
+      object
+          ->Set(env->context(),
+                FIXED_ONE_BYTE_STRING(isolate, "promise"),
+                resolver->GetPromise())
+          .IsNothing()) {
+    return;
+  }
+  resolver_.Reset(isolate, resolver);
+  MakeWeak();
+
+  // Keep the event loop alive until the streaming has finished.
+  started_ = true;
+  env->add_refs(1);
+  env->isolate_data()->platform()->CallOnWorkerThread(
+      std::make_unique<StreamingTask>(state_));
+}
+
+ModuleStreamingJob::~ModuleStreamingJob() {
+  state_->job = nullptr;
+  if (!started_) {
+    return;
+  }
+  {
+    // The streaming task uses the isolate, so it has to finish before the
+    // environment can go away.
+    Mutex::ScopedLock lock(state_->mutex);
+    state_->detached = true;
+    while (!state_->done) {
+      state_->cond.Wait(lock);
+    }
+  }
+  if (!streamed_) {
+    env()->add_refs(-1);
+  }
+}
+
+void ModuleStreamingJob::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsString());
+  Environment* env = Environment::GetCurrent(args);
+  new ModuleStreamingJob(env, args.This(), args[0].As<String>());
+}
+
+void ModuleStreamingJob::OnStreamed() {
+  streamed_ = true;
+  env()->add_refs(-1);
+  HandleScope handle_scope(env()->isolate());
+  Local<Promise::Resolver> resolver = resolver_.Get(env()->isolate());
+  resolver_.Reset();
+  USE(resolver->Resolve(env()->context(), object()));
+}
+
+std::unique_ptr<ScriptCompiler::StreamedSource>
+ModuleStreamingJob::TakeSource() {
+  if (!streamed_) {
+    return nullptr;
+  }
+  return std::move(state_->source);
+}
+
 ModulePhase to_phase_constant(ModuleImportPhase phase) {
   switch (phase) {
     case ModuleImportPhase::kEvaluation:
@@ -1308,6 +1491,13 @@ void ModuleWrap::CreatePerIsolateProperties(IsolateData* isolate_data,
   SetConstructorFunction(isolate, target, "ModuleWrap", tpl);
   isolate_data->set_module_wrap_constructor_template(tpl);
 
+  Local<FunctionTemplate> streaming_job_tpl =
+      NewFunctionTemplate(isolate, ModuleStreamingJob::New);
+  streaming_job_tpl->InstanceTemplate()->SetInternalFieldCount(
+      ModuleStreamingJob::kInternalFieldCount);
+  SetConstructorFunction(
+      isolate, target, "ModuleStreamingJob", streaming_job_tpl);
+
   SetMethod(isolate,
             target,
             "setImportModuleDynamicallyCallback",
@@ -1350,6 +1540,7 @@ void ModuleWrap::CreatePerContextProperties(Local<Object> target,
 void ModuleWrap::RegisterExternalReferences(
     ExternalReferenceRegistry* registry) {
   registry->Register(New);
+  registry->Register(ModuleStreamingJob::New);
 
   registry->Register(Link);
   registry->Register(GetModuleRequests);
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -92,7 +93,8 @@ class ModuleWrap : public BaseObject {
       int column_offset,
       v8::Local<v8::PrimitiveArray> host_defined_options,
       std::optional<v8::ScriptCompiler::CachedData*> user_cached_data,
-      bool* cache_rejected);
+      bool* cache_rejected,
+      v8::ScriptCompiler::StreamedSource* streamed_source = nullptr);
 
   static void CreateRequiredModuleFacade(
       const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -154,6 +156,40 @@ class ModuleWrap : public BaseObject {
   int module_hash_;
 };
 
+// Parses and compiles the source text of a module on a platform worker thread
+// with V8's script streaming. The promise returned by the constructor (as
+// `job.promise`) resolves once the streaming has finished, after which the job
+// can be passed to the ModuleWrap constructor together with the same source
+// text to finish the compilation on the main thread.
+class ModuleStreamingJob : public BaseObject {
+ public:
+  ModuleStreamingJob(Environment* env,
+                     v8::Local<v8::Object> object,
+                     v8::Local<v8::String> source_text);
+  ~ModuleStreamingJob() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Returns the streamed source, or nullptr if the streaming has not finished
+  // or the source has already been taken.
+  std::unique_ptr<v8::ScriptCompiler::StreamedSource> TakeSource();
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(ModuleStreamingJob)
+  SET_SELF_SIZE(ModuleStreamingJob)
+
+ private:
+  struct State;
+  class StreamingTask;
+
+  void OnStreamed();
+
+  std::shared_ptr<State> state_;
+  v8::Global<v8::Promise::Resolver> resolver_;
+  bool started_ = false;
+  bool streamed_ = false;
+};
+
 }  // namespace loader
 }  // namespace node
 
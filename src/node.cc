@@ -46,6 +46,7 @@
 #include "node_snapshot_builder.h"
 #include "node_v8_platform-inl.h"
 #include "node_version.h"
+#include "spawn_zygote.h"
 
 #if HAVE_OPENSSL
 #include "ncrypto.h"
@@ -123,6 +124,7 @@
 
 // ========== global C++ headers ==========
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>  // PATH_MAX
 #include <csignal>
@@ -238,6 +240,9 @@ void Environment::InitializeDiagnostics() {
   if (heap_snapshot_near_heap_limit_ > 0) {
     AddHeapSnapshotNearHeapLimitCallback();
   }
+#ifdef __wasi__
+  isolate_->AddGCEpilogueCallback(LinearMemoryGCCallback, this);
+#endif
   if (options_->trace_uncaught)
     isolate_->SetCaptureStackTraceForUncaughtExceptions(true);
   if (options_->trace_promises) {
@@ -977,8 +982,13 @@ static ExitCode InitializeNodeWithArgsInternal(
   if (!per_process::cli_options->title.empty())
     uv_set_process_title(per_process::cli_options->title.c_str());
 
+  performance::RecordProcessBootstrapPhase(
+      performance::NODE_BOOTSTRAP_PHASE_OPTION_PARSING,
+      per_process::node_start_time);
+
 #if defined(NODE_HAVE_I18N_SUPPORT)
   if (!(flags & ProcessInitializationFlags::kNoICU)) {
+    uint64_t icu_start = PERFORMANCE_NOW();
     // If the parameter isn't given, use the env variable.
     if (per_process::cli_options->icu_data_dir.empty())
       credentials::SafeGetenv("NODE_ICU_DATA",
@@ -989,15 +999,18 @@ static ExitCode InitializeNodeWithArgsInternal(
     // fall back to the configured default
     if (per_process::cli_options->icu_data_dir.empty()) {
       // Check whether the NODE_ICU_DEFAULT_DATA_DIR contains the right data
-      // file and can be read.
-      static const char full_path[] =
-          NODE_ICU_DEFAULT_DATA_DIR "/" U_ICUDATA_NAME ".dat";
-
-      FILE* f = fopen(full_path, "rb");
-
-      if (f != nullptr) {
-        fclose(f);
-        per_process::cli_options->icu_data_dir = NODE_ICU_DEFAULT_DATA_DIR;
+      // file, or an unpacked data package, and can be read.
+      static const char* const full_paths[] = {
+          NODE_ICU_DEFAULT_DATA_DIR "/" U_ICUDATA_NAME ".dat",
+          NODE_ICU_DEFAULT_DATA_DIR "/" U_ICUDATA_NAME "/res_index.res"};
+
+      for (const char* full_path : full_paths) {
+        FILE* f = fopen(full_path, "rb");
+        if (f != nullptr) {
+          fclose(f);
+          per_process::cli_options->icu_data_dir = NODE_ICU_DEFAULT_DATA_DIR;
+          break;
+        }
       }
     }
 #endif  // NODE_ICU_DEFAULT_DATA_DIR
@@ -1010,11 +1023,14 @@ static ExitCode InitializeNodeWithArgsInternal(
       errors->push_back(icu_error +
                         ": Could not initialize ICU. "
                         "Check the directory specified by NODE_ICU_DATA or "
-                        "--icu-data-dir contains " U_ICUDATA_NAME ".dat and "
+                        "--icu-data-dir contains " U_ICUDATA_NAME ".dat, or "
+                        "an unpacked " U_ICUDATA_NAME " directory, and "
                         "it's readable\n");
       return ExitCode::kInvalidCommandLineArgument;
     }
     per_process::metadata.versions.InitializeIntlVersions();
+    performance::RecordProcessBootstrapPhase(
+        performance::NODE_BOOTSTRAP_PHASE_ICU_INITIALIZATION, icu_start);
   }
 
 # ifndef __POSIX__
@@ -1099,6 +1115,12 @@ InitializeOncePerProcessInternal(const std::vector<std::string>& args,
     }
   }
 
+  if (per_process::cli_options->experimental_spawn_zygote) {
+    // Fork the zygote while the process is still small and single-threaded,
+    // before OpenSSL and the V8 platform are initialized.
+    spawn_zygote::Start();
+  }
+
   if (!(flags & ProcessInitializationFlags::kNoInitOpenSSL)) {
 #if HAVE_OPENSSL
 #ifndef OPENSSL_IS_BORINGSSL
@@ -1207,10 +1229,27 @@ InitializeOncePerProcessInternal(const std::vector<std::string>& args,
 #endif  // HAVE_OPENSSL
   }
 
+  int v8_thread_pool_size =
+      static_cast<int>(per_process::cli_options->v8_thread_pool_size);
+  if (per_process::cli_options->experimental_cpu_quota_aware) {
+    os::EnableCpuQuota();
+    unsigned int parallelism = os::AvailableParallelism();
+    // Leave a CPU to the main thread, like --v8-pool-size=0 does.
+    int limit = std::max(static_cast<int>(parallelism) - 1, 1);
+    if (v8_thread_pool_size < 1 || v8_thread_pool_size > limit)
+      v8_thread_pool_size = limit;
+    // libuv reads this when the threadpool is started on first use.
+    std::string threadpool_size;
+    if (!credentials::SafeGetenv("UV_THREADPOOL_SIZE", &threadpool_size)) {
+      threadpool_size = std::to_string(std::max(parallelism, 4u));
+      uv_os_setenv("UV_THREADPOOL_SIZE", threadpool_size.c_str());
+    }
+  }
+
+  uint64_t v8_initialization_start = PERFORMANCE_NOW();
   if (!(flags & ProcessInitializationFlags::kNoInitializeNodeV8Platform)) {
     uv_thread_setname("MainThread");
-    per_process::v8_platform.Initialize(
-        static_cast<int>(per_process::cli_options->v8_thread_pool_size));
+    per_process::v8_platform.Initialize(v8_thread_pool_size);
     result->platform_ = per_process::v8_platform.Platform();
   }
 
@@ -1263,6 +1302,13 @@ InitializeOncePerProcessInternal(const std::vector<std::string>& args,
 #endif  // NODE_USE_V8_WASM_TRAP_HANDLER
 
   performance::performance_v8_start = PERFORMANCE_NOW();
+  performance::RecordProcessBootstrapPhase(
+      performance::NODE_BOOTSTRAP_PHASE_V8_INITIALIZATION,
+      v8_initialization_start,
+      performance::performance_v8_start);
+  // The tracing agent is only ready to take events now, so the phases
+  // recorded so far are emitted in one go.
+  performance::TraceProcessBootstrapPhases();
   per_process::v8_initialized = true;
 
   return result;
@@ -1382,11 +1428,38 @@ ExitCode GenerateAndWriteSnapshotData(const SnapshotData** snapshot_data_ptr,
       snapshot_config.builder_script_path = std::nullopt;
     }
 
+    // --build-snapshot-base indicates that the snapshot extends a snapshot
+    // previously built from another builder script.
+    std::unique_ptr<SnapshotData> base_data;
+    const std::string& base_path =
+        per_process::cli_options->per_isolate->build_snapshot_base;
+    if (!base_path.empty()) {
+      if (!builder_script_content.has_value()) {
+        fprintf(stderr,
+                "--build-snapshot-base must be used with a builder script.\n");
+        return ExitCode::kInvalidCommandLineArgument;
+      }
+      FILE* fp = fopen(base_path.c_str(), "rb");
+      if (fp == nullptr) {
+        fprintf(stderr,
+                "Cannot open %s for reading the base snapshot.\n",
+                base_path.c_str());
+        return ExitCode::kGenericUserError;
+      }
+      base_data = std::make_unique<SnapshotData>();
+      bool ok = SnapshotData::FromFile(base_data.get(), fp);
+      fclose(fp);
+      if (!ok || !base_data->Check()) {
+        return ExitCode::kStartupSnapshotFailure;
+      }
+    }
+
     exit_code = node::SnapshotBuilder::Generate(generated_data.get(),
                                                 args_maybe_patched,
                                                 result->exec_args(),
                                                 builder_script_content,
-                                                snapshot_config);
+                                                snapshot_config,
+                                                base_data.get());
     if (exit_code == ExitCode::kNoFailure) {
       *snapshot_data_ptr = generated_data.release();
     } else {
@@ -1429,7 +1502,10 @@ bool LoadSnapshotData(const SnapshotData** snapshot_data_ptr) {
       std::unique_ptr<SnapshotData> read_data =
           std::make_unique<SnapshotData>();
       std::string_view snapshot = sea.main_code_or_snapshot;
-      if (SnapshotData::FromBlob(read_data.get(), snapshot)) {
+      // The resource is part of the executable, so the code cache does not
+      // need to be copied out of it.
+      if (SnapshotData::FromBlobWithoutCopy(
+              read_data.get(), snapshot, nullptr)) {
         *snapshot_data_ptr = read_data.release();
         return true;
       } else {
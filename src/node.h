@@ -910,11 +910,32 @@ class NODE_EXTERN CommonEnvironmentSetup {
   enum Flags : uint32_t {
     kNoFlags = 0,
     kIsForSnapshotting = 1,
+    // The setup keeps |make_env| so that ResetEnvironment() can create a new
+    // Environment later.
+    kIsPooled = 2,
   };
 
   struct Impl;
   Impl* impl_;
 
+  // Creates the Environment, and the main context if there is no snapshot.
+  // The isolate must be locked and entered.
+  void InitializeEnvironment(std::vector<std::string>* errors);
+  // Frees the Environment and creates a new one on the same isolate and event
+  // loop. Only available for setups created by an EnvironmentPool.
+  bool ResetEnvironment(std::vector<std::string>* errors);
+
+  // Like CreateForSnapshotting(), but when base is not nullptr, the isolate
+  // and the environment are deserialized from it so that the snapshot
+  // created extends the base snapshot.
+  static std::unique_ptr<CommonEnvironmentSetup> CreateForSnapshottingFrom(
+      MultiIsolatePlatform* platform,
+      std::vector<std::string>* errors,
+      const EmbedderSnapshotData* base,
+      const std::vector<std::string>& args,
+      const std::vector<std::string>& exec_args,
+      const SnapshotConfig& snapshot_config);
+
   CommonEnvironmentSetup(
       MultiIsolatePlatform*,
       std::vector<std::string>*,
@@ -926,6 +947,9 @@ class NODE_EXTERN CommonEnvironmentSetup {
       uint32_t flags,
       std::function<Environment*(const CommonEnvironmentSetup*)>,
       const SnapshotConfig* config = nullptr);
+
+  friend class EnvironmentPool;
+  friend class SnapshotBuilder;
 };
 
 // Implementation for CommonEnvironmentSetup::Create
@@ -968,6 +992,67 @@ CommonEnvironmentSetup::CreateFromSnapshot(
   return ret;
 }
 
+// An EnvironmentPool keeps a number of CommonEnvironmentSetup instances ready
+// for running short-lived scripts, so that the cost of creating an isolate is
+// not paid for every script. When a setup is released back into the pool, its
+// Environment is freed and a new one is created on the same isolate and event
+// loop, deserialized from |snapshot_data| when it is not nullptr.
+//
+// Globals and other JS state do not survive a release, but the V8 heap of the
+// isolate is shared by all the Environments that run on it, so pooling is
+// only suitable for scripts that trust each other.
+//
+// The pool is thread-safe. Setups taken from it may be used on any thread as
+// long as the isolate is locked with a v8::Locker.
+//
+// This is an *experimental* API that is subject to change or removal between
+// Node.js versions, including possible API and ABI breakage.
+class NODE_EXTERN EnvironmentPool {
+ public:
+  ~EnvironmentPool();
+
+  // Creates a pool holding up to |size| setups, all of which are created
+  // upfront. |args|, |exec_args| and |flags| are passed to
+  // CreateEnvironment() for every Environment created by the pool.
+  static std::unique_ptr<EnvironmentPool> Create(
+      MultiIsolatePlatform* platform,
+      std::vector<std::string>* errors,
+      const EmbedderSnapshotData* snapshot_data,
+      size_t size,
+      const std::vector<std::string>& args = {},
+      const std::vector<std::string>& exec_args = {},
+      EnvironmentFlags::Flags flags = EnvironmentFlags::kDefaultFlags);
+
+  // Takes a setup out of the pool, or creates a new one if the pool is empty.
+  // Returns an empty pointer and populates |*errors| on failure.
+  std::unique_ptr<CommonEnvironmentSetup> Acquire(
+      std::vector<std::string>* errors);
+  // Gives a setup that has been returned by Acquire() back to the pool. Its
+  // event loop must not be running.
+  void Release(std::unique_ptr<CommonEnvironmentSetup> setup);
+
+  // Runs |main_script_source_utf8| with LoadEnvironment() in a setup from the
+  // pool, spins its event loop and releases the setup again. Returns the exit
+  // code, or Nothing if the script could not be run.
+  v8::Maybe<int> RunScript(std::string_view main_script_source_utf8);
+
+  // The number of setups that are currently in the pool.
+  size_t size() const;
+
+  EnvironmentPool(const EnvironmentPool&) = delete;
+  EnvironmentPool& operator=(const EnvironmentPool&) = delete;
+  EnvironmentPool(EnvironmentPool&&) = delete;
+  EnvironmentPool& operator=(EnvironmentPool&&) = delete;
+
+ private:
+  struct Impl;
+  Impl* impl_;
+
+  explicit EnvironmentPool(Impl* impl);
+  std::unique_ptr<CommonEnvironmentSetup> CreateSetup(
+      std::vector<std::string>* errors);
+};
+
 /* Converts a unixtime to V8 Date */
 NODE_DEPRECATED("Use v8::Date::New() directly",
                 inline v8::Local<v8::Value> NODE_UNIXTIME_V8(double time) {
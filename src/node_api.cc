@@ -19,6 +19,7 @@
 #include <atomic>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 namespace v8impl {
 static void ThrowNodeApiVersionError(node::Environment* node_env,
@@ -116,9 +117,7 @@ void node_napi_env__::DrainFinalizerQueue() {
   // As userland code can delete additional references in one finalizer,
   // the list of pending finalizers may be mutated as we execute them, so
   // we keep iterating it until it is empty.
-  while (!pending_finalizers.empty()) {
-    v8impl::RefTracker* ref_tracker = *pending_finalizers.begin();
-    pending_finalizers.erase(ref_tracker);
+  while (v8impl::RefTracker* ref_tracker = pending_finalizers.Pop()) {
     ref_tracker->Finalize();
   }
 }
@@ -198,6 +197,62 @@ class BufferFinalizer : private Finalizer {
   ~BufferFinalizer() { env()->Unref(); }
 };
 
+// A queue of pointers that any number of threads can push to without taking a
+// lock, while a single thread pops them. This is Dmitry Vyukov's intrusive
+// MPSC queue: producers swap themselves in at the head, and the consumer
+// follows the links from the tail, which is always a node whose data has
+// already been consumed.
+class MPSCQueue {
+ public:
+  MPSCQueue() : head_(&stub_), tail_(&stub_) {}
+
+  ~MPSCQueue() {
+    void* data;
+    while (Pop(&data)) {
+    }
+    if (tail_ != &stub_) {
+      delete tail_;
+    }
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // Can be called from any thread.
+  void Push(void* data) {
+    Node* node = new Node(data);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Must only be called from one thread at a time. Returns false if the
+  // queue is empty, or if the push of the next item has not completed yet.
+  bool Pop(void** data) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    *data = next->data;
+    tail_ = next;
+    if (tail != &stub_) {
+      delete tail;
+    }
+    return true;
+  }
+
+ private:
+  struct Node {
+    explicit Node(void* data_) : data(data_) {}
+    std::atomic<Node*> next{nullptr};
+    void* data;
+  };
+
+  Node stub_{nullptr};
+  std::atomic<Node*> head_;
+  Node* tail_;
+};
+
 class ThreadSafeFunction : public node::AsyncResource {
  public:
   ThreadSafeFunction(v8::Local<v8::Function> func,
@@ -222,6 +277,8 @@ class ThreadSafeFunction : public node::AsyncResource {
         finalize_data(finalize_data_),
         finalize_cb(finalize_cb_),
         call_js_cb(call_js_cb_ == nullptr ? CallJs : call_js_cb_),
+        call_js_batch_cb(nullptr),
+        max_batch_size(kMaxIterationCount),
         handles_closing(false) {
     ref.Reset(env->isolate, func);
     node::AddEnvironmentCleanupHook(env->isolate, Cleanup, this);
@@ -236,9 +293,18 @@ class ThreadSafeFunction : public node::AsyncResource {
   // These methods can be called from any thread.
 
   napi_status Push(void* data, napi_threadsafe_function_call_mode mode) {
+    // Without a limit on the size of the queue, there is nothing to wait for,
+    // so the item is pushed without taking the lock.
+    if (max_queue_size == 0 && !is_closing) {
+      queue_size++;
+      queue.Push(data);
+      Send();
+      return napi_ok;
+    }
+
     node::Mutex::ScopedLock lock(this->mutex);
 
-    while (queue.size() >= max_queue_size && max_queue_size > 0 &&
+    while (queue_size >= max_queue_size && max_queue_size > 0 &&
            !is_closing) {
       if (mode == napi_tsfn_nonblocking) {
         return napi_queue_full;
@@ -254,7 +320,8 @@ class ThreadSafeFunction : public node::AsyncResource {
         return napi_closing;
       }
     } else {
-      queue.push(data);
+      queue_size++;
+      queue.Push(data);
       Send();
       return napi_ok;
     }
@@ -295,8 +362,20 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
   void EmptyQueueAndDelete() {
-    for (; !queue.empty(); queue.pop()) {
-      call_js_cb(nullptr, nullptr, context, queue.front());
+    // Items that were taken from the queue but not dispatched before the
+    // function was closed come first.
+    void* data;
+    while (queue.Pop(&data)) {
+      batch.push_back(data);
+    }
+    if (call_js_batch_cb != nullptr) {
+      if (!batch.empty()) {
+        call_js_batch_cb(nullptr, nullptr, context, batch.data(), batch.size());
+      }
+    } else {
+      for (void* item : batch) {
+        call_js_cb(nullptr, nullptr, context, item);
+      }
     }
     delete this;
   }
@@ -348,16 +427,25 @@ class ThreadSafeFunction : public node::AsyncResource {
 
   inline void* Context() { return context; }
 
+  napi_status SetBatching(size_t max_batch_size_,
+                          node_api_threadsafe_function_call_js_batch cb) {
+    max_batch_size =
+        max_batch_size_ == 0 ? kMaxIterationCount : max_batch_size_;
+    call_js_batch_cb = cb;
+
+    return napi_ok;
+  }
+
  protected:
   void Dispatch() {
     bool has_more = true;
 
-    // Limit maximum synchronous iteration count to prevent event loop
+    // Limit the number of items dispatched per wakeup to prevent event loop
     // starvation. See `src/node_messaging.cc` for an inspiration.
-    unsigned int iterations_left = kMaxIterationCount;
-    while (has_more && --iterations_left != 0) {
+    size_t items_left = max_batch_size;
+    while (has_more && items_left > 0) {
       dispatch_state = kDispatchRunning;
-      has_more = DispatchOne();
+      has_more = DispatchBatch(&items_left);
 
       // Send() was called while we were executing the JS function
       if (dispatch_state.exchange(kDispatchIdle) != kDispatchRunning) {
@@ -370,53 +458,80 @@ class ThreadSafeFunction : public node::AsyncResource {
     }
   }
 
-  bool DispatchOne() {
-    void* data = nullptr;
-    bool popped_value = false;
+  // Takes up to |*items_left| items from the queue under a single lock, and
+  // hands them to JavaScript, either one call each or all of them in one
+  // call to call_js_batch_cb.
+  bool DispatchBatch(size_t* items_left) {
     bool has_more = false;
 
     {
       node::Mutex::ScopedLock lock(this->mutex);
       if (is_closing) {
         CloseHandlesAndMaybeDelete();
-      } else {
-        size_t size = queue.size();
-        if (size > 0) {
-          data = queue.front();
-          queue.pop();
-          popped_value = true;
-          if (size == max_queue_size && max_queue_size > 0) {
-            cond->Signal(lock);
-          }
-          size--;
-        }
+        return false;
+      }
+
+      void* data;
+      while (batch.size() < *items_left && queue.Pop(&data)) {
+        batch.push_back(data);
+      }
+      size_t size = queue_size.fetch_sub(batch.size());
+      if (size >= max_queue_size && max_queue_size > 0 && !batch.empty()) {
+        cond->Broadcast(lock);
+      }
+      size -= batch.size();
 
-        if (size == 0) {
-          if (thread_count == 0) {
-            is_closing = true;
-            if (max_queue_size > 0) {
-              cond->Signal(lock);
-            }
-            CloseHandlesAndMaybeDelete();
+      if (size == 0) {
+        if (thread_count == 0) {
+          is_closing = true;
+          if (max_queue_size > 0) {
+            cond->Broadcast(lock);
           }
-        } else {
-          has_more = true;
+          CloseHandlesAndMaybeDelete();
         }
+      } else {
+        // If the size is not zero but nothing could be taken, an item is
+        // still being pushed, and Send() is called once it is.
+        has_more = !batch.empty();
       }
     }
 
-    if (popped_value) {
-      v8::HandleScope scope(env->isolate);
+    if (batch.empty()) {
+      return has_more;
+    }
+    *items_left -= batch.size();
+
+    v8::HandleScope scope(env->isolate);
+    napi_value js_callback = nullptr;
+    if (!ref.IsEmpty()) {
+      v8::Local<v8::Function> js_cb =
+          v8::Local<v8::Function>::New(env->isolate, ref);
+      js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
+    }
+
+    if (call_js_batch_cb != nullptr) {
       CallbackScope cb_scope(this);
-      napi_value js_callback = nullptr;
-      if (!ref.IsEmpty()) {
-        v8::Local<v8::Function> js_cb =
-            v8::Local<v8::Function>::New(env->isolate, ref);
-        js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
+      env->CallbackIntoModule<false>([&](napi_env env) {
+        call_js_batch_cb(env, js_callback, context, batch.data(), batch.size());
+      });
+      batch.clear();
+      return has_more;
+    }
+
+    size_t dispatched = 0;
+    while (dispatched < batch.size()) {
+      // The function may be closed by one of the calls, in which case the
+      // remaining items are left to EmptyQueueAndDelete().
+      if (is_closing) {
+        batch.erase(batch.begin(), batch.begin() + dispatched);
+        return false;
       }
+      void* data = batch[dispatched++];
+      CallbackScope cb_scope(this);
       env->CallbackIntoModule<false>(
           [&](napi_env env) { call_js_cb(env, js_callback, context, data); });
     }
+    batch.clear();
 
     return has_more;
   }
@@ -508,12 +623,15 @@ class ThreadSafeFunction : public node::AsyncResource {
   // These are variables protected by the mutex.
   node::Mutex mutex;
   std::unique_ptr<node::ConditionVariable> cond;
-  std::queue<void*> queue;
   uv_async_t async;
   size_t thread_count;
-  bool is_closing;
+  std::atomic_bool is_closing;
   std::atomic_uchar dispatch_state;
 
+  // Pushed to without the mutex if max_queue_size is 0.
+  MPSCQueue queue;
+  std::atomic_size_t queue_size{0};
+
   // These are variables set once, upon creation, and then never again, which
   // means we don't need the mutex to read them.
   void* context;
@@ -525,6 +643,10 @@ class ThreadSafeFunction : public node::AsyncResource {
   void* finalize_data;
   napi_finalize finalize_cb;
   napi_threadsafe_function_call_js call_js_cb;
+  node_api_threadsafe_function_call_js_batch call_js_batch_cb;
+  size_t max_batch_size;
+  // The items taken from the queue by the current dispatch.
+  std::vector<void*> batch;
   bool handles_closing;
 };
 
@@ -1177,7 +1299,8 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
             env->isolate,
             async_resource,
             *v8::String::Utf8Value(env->isolate, async_resource_name)),
-        ThreadPoolWork(env->node_env(), "node_api"),
+        ThreadPoolWork(
+            env->node_env(), "node_api", node::ThreadPoolWorkClass::kAddon),
         _env(env),
         _data(data),
         _execute(execute),
@@ -1200,6 +1323,20 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
 
   void DoThreadPoolWork() override { _execute(_env, _data); }
 
+  void SetWorkClass(node_api_async_work_class work_class) {
+    switch (work_class) {
+      case node_api_async_work_default:
+        set_work_class(node::ThreadPoolWorkClass::kAddon);
+        break;
+      case node_api_async_work_io_bound:
+        set_work_class(node::ThreadPoolWorkClass::kAddonIo);
+        break;
+      case node_api_async_work_cpu_bound:
+        set_work_class(node::ThreadPoolWorkClass::kAddonCpu);
+        break;
+    }
+  }
+
   void AfterThreadPoolWork(int status) override {
     if (_complete == nullptr) return;
 
@@ -1318,6 +1455,39 @@ napi_status NAPI_CDECL napi_cancel_async_work(node_api_basic_env env,
   return napi_clear_last_error(env);
 }
 
+napi_status NAPI_CDECL
+node_api_set_async_work_class(node_api_basic_env env,
+                              napi_async_work work,
+                              node_api_async_work_class work_class) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, work);
+  RETURN_STATUS_IF_FALSE(env,
+                         work_class >= node_api_async_work_default &&
+                             work_class <= node_api_async_work_cpu_bound,
+                         napi_invalid_arg);
+
+  uvimpl::Work* w = reinterpret_cast<uvimpl::Work*>(work);
+  RETURN_STATUS_IF_FALSE(env, !w->is_scheduled(), napi_generic_failure);
+
+  w->SetWorkClass(work_class);
+
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL
+node_api_get_async_work_queue_time(node_api_basic_env env,
+                                   napi_async_work work,
+                                   uint64_t* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, work);
+  CHECK_ARG(env, result);
+
+  uvimpl::Work* w = reinterpret_cast<uvimpl::Work*>(work);
+  *result = w->queue_wait_time();
+
+  return napi_clear_last_error(env);
+}
+
 napi_status NAPI_CDECL
 napi_create_threadsafe_function(napi_env env,
                                 napi_value func,
@@ -1423,6 +1593,16 @@ napi_status NAPI_CDECL napi_ref_threadsafe_function(
   return reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->Ref();
 }
 
+napi_status NAPI_CDECL node_api_set_threadsafe_function_batching(
+    node_api_basic_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    node_api_threadsafe_function_call_js_batch call_js_batch_cb) {
+  CHECK_NOT_NULL(func);
+  return reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->SetBatching(
+      max_batch_size, call_js_batch_cb);
+}
+
 napi_status NAPI_CDECL node_api_get_module_file_name(
     node_api_basic_env basic_env, const char** result) {
   napi_env env = const_cast<napi_env>(basic_env);
@@ -172,6 +172,20 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_queue_async_work(node_api_basic_env env,
 NAPI_EXTERN napi_status NAPI_CDECL
 napi_cancel_async_work(node_api_basic_env env, napi_async_work work);
 
+#ifdef NAPI_EXPERIMENTAL
+#define NODE_API_EXPERIMENTAL_HAS_ASYNC_WORK_CLASS
+
+NAPI_EXTERN napi_status NAPI_CDECL
+node_api_set_async_work_class(node_api_basic_env env,
+                              napi_async_work work,
+                              node_api_async_work_class work_class);
+NAPI_EXTERN napi_status NAPI_CDECL
+node_api_get_async_work_queue_time(node_api_basic_env env,
+                                   napi_async_work work,
+                                   uint64_t* result);
+
+#endif  // NAPI_EXPERIMENTAL
+
 // version management
 NAPI_EXTERN napi_status NAPI_CDECL napi_get_node_version(
     node_api_basic_env env, const napi_node_version** version);
@@ -244,6 +258,17 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_ref_threadsafe_function(
 
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+#define NODE_API_EXPERIMENTAL_HAS_THREADSAFE_FUNCTION_BATCHING
+
+NAPI_EXTERN napi_status NAPI_CDECL node_api_set_threadsafe_function_batching(
+    node_api_basic_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    node_api_threadsafe_function_call_js_batch call_js_batch_cb);
+
+#endif  // NAPI_EXPERIMENTAL
+
 #if NAPI_VERSION >= 8
 
 NAPI_EXTERN napi_status NAPI_CDECL
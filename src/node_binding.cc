@@ -4,6 +4,7 @@
 #include "node_builtins.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_perf.h"
 #include "node_url_pattern.h"
 #include "util.h"
 
@@ -47,6 +48,7 @@
   V(constants)                                                                 \
   V(contextify)                                                                \
   V(credentials)                                                               \
+  V(diagnostics_channel)                                                       \
   V(encoding_binding)                                                          \
   V(errors)                                                                    \
   V(fs)                                                                        \
@@ -55,6 +57,7 @@
   V(heap_utils)                                                                \
   V(http2)                                                                     \
   V(http_parser)                                                               \
+  V(http_serializer)                                                           \
   V(inspector)                                                                 \
   V(internal_only_v8)                                                          \
   V(js_stream)                                                                 \
@@ -65,6 +68,7 @@
   V(mksnapshot)                                                                \
   V(options)                                                                   \
   V(os)                                                                        \
+  V(path)                                                                      \
   V(performance)                                                               \
   V(permission)                                                                \
   V(pipe_wrap)                                                                 \
@@ -75,6 +79,8 @@
   V(serdes)                                                                    \
   V(signal_wrap)                                                               \
   V(spawn_sync)                                                                \
+  V(stdio_writer)                                                              \
+  V(stream_bridge)                                                             \
   V(stream_pipe)                                                               \
   V(stream_wrap)                                                               \
   V(string_decoder)                                                            \
@@ -586,16 +592,23 @@ inline struct node_module* FindModule(struct node_module* list,
   return mp;
 }
 
+static Local<ObjectTemplate> NewBindingTemplate(
+    IsolateData* isolate_data,
+    void (*register_func)(IsolateData*, Local<ObjectTemplate>)) {
+  Local<ObjectTemplate> templ = ObjectTemplate::New(isolate_data->isolate());
+  templ->SetInternalFieldCount(BaseObject::kInternalFieldCount);
+  register_func(isolate_data, templ);
+  return templ;
+}
+
 void CreateInternalBindingTemplates(IsolateData* isolate_data) {
+  // Templates of bindings that are not loaded during bootstrap are created
+  // in GetInternalBindingExportObject() instead. They may also have been
+  // deserialized from the snapshot already.
 #define V(modname)                                                             \
-  do {                                                                         \
-    Local<ObjectTemplate> templ =                                              \
-        ObjectTemplate::New(isolate_data->isolate());                          \
-    templ->SetInternalFieldCount(BaseObject::kInternalFieldCount);             \
-    _register_isolate_##modname(isolate_data, templ);                          \
-    isolate_data->set_##modname##_binding_template(templ);                     \
-  } while (0);
-  NODE_BINDINGS_WITH_PER_ISOLATE_INIT(V)
+  isolate_data->set_##modname##_binding_template(                              \
+      NewBindingTemplate(isolate_data, _register_isolate_##modname));
+  NODE_BINDINGS_WITH_EAGER_PER_ISOLATE_INIT(V)
 #undef V
 }
 
@@ -608,7 +621,17 @@ static Local<Object> GetInternalBindingExportObject(IsolateData* isolate_data,
   if (strcmp(mod_name, #name) == 0) {                                          \
     templ = isolate_data->name##_binding_template();                           \
   } else  // NOLINT(readability/braces)
-  NODE_BINDINGS_WITH_PER_ISOLATE_INIT(V)
+  NODE_BINDINGS_WITH_EAGER_PER_ISOLATE_INIT(V)
+#undef V
+#define V(name)                                                                \
+  if (strcmp(mod_name, #name) == 0) {                                          \
+    templ = isolate_data->name##_binding_template();                           \
+    if (templ.IsEmpty()) {                                                     \
+      templ = NewBindingTemplate(isolate_data, _register_isolate_##name);      \
+      isolate_data->set_##name##_binding_template(templ);                      \
+    }                                                                          \
+  } else  // NOLINT(readability/braces)
+  NODE_BINDINGS_WITH_LAZY_PER_ISOLATE_INIT(V)
 #undef V
   {
     // Default template.
@@ -627,8 +650,14 @@ static Local<Object> InitInternalBinding(Realm* realm, node_module* mod) {
   CHECK_NULL(mod->nm_register_func);
   CHECK_NOT_NULL(mod->nm_context_register_func);
   Local<Value> unused = Undefined(realm->isolate());
+  uint64_t start = PERFORMANCE_NOW();
   // Internal bindings don't have a "module" object, only exports.
   mod->nm_context_register_func(exports, unused, context, mod->nm_priv);
+  realm->env()->performance_state()->RecordBootstrapPhase(
+      performance::NODE_BOOTSTRAP_PHASE_BINDING_INITIALIZATION,
+      start,
+      PERFORMANCE_NOW(),
+      mod->nm_modname);
   return scope.Escape(exports);
 }
 
@@ -43,15 +43,16 @@ static_assert(static_cast<int>(NM_F_LINKED) ==
 #define NODE_BUILTIN_SQLITE_BINDINGS(V)
 #endif
 
-#define NODE_BINDINGS_WITH_PER_ISOLATE_INIT(V)                                 \
+// Bindings whose per-isolate templates are created when the IsolateData is
+// created. These are the ones that are loaded during bootstrap of the main
+// thread, workers or ShadowRealms, so creating them eagerly costs nothing.
+#define NODE_BINDINGS_WITH_EAGER_PER_ISOLATE_INIT(V)                           \
   V(async_wrap)                                                                \
   V(blob)                                                                      \
   V(builtins)                                                                  \
   V(contextify)                                                                \
   V(encoding_binding)                                                          \
   V(fs)                                                                        \
-  V(fs_dir)                                                                    \
-  V(http_parser)                                                               \
   V(messaging)                                                                 \
   V(mksnapshot)                                                                \
   V(modules)                                                                   \
@@ -61,9 +62,19 @@ static_assert(static_cast<int>(NM_F_LINKED) ==
   V(timers)                                                                    \
   V(url)                                                                       \
   V(worker)                                                                    \
-  NODE_BUILTIN_ICU_BINDINGS(V)                                                 \
+  NODE_BUILTIN_ICU_BINDINGS(V)
+
+// Bindings whose per-isolate templates are only created on the first
+// internalBinding() call that loads them in the isolate.
+#define NODE_BINDINGS_WITH_LAZY_PER_ISOLATE_INIT(V)                            \
+  V(fs_dir)                                                                    \
+  V(http_parser)                                                               \
   NODE_BUILTIN_QUIC_BINDINGS(V)
 
+#define NODE_BINDINGS_WITH_PER_ISOLATE_INIT(V)                                 \
+  NODE_BINDINGS_WITH_EAGER_PER_ISOLATE_INIT(V)                                 \
+  NODE_BINDINGS_WITH_LAZY_PER_ISOLATE_INIT(V)
+
 #define NODE_BINDING_CONTEXT_AWARE_CPP(modname, regfunc, priv, flags)          \
   static node::node_module _module = {                                         \
       NODE_MODULE_VERSION,                                                     \
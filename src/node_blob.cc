@@ -14,6 +14,7 @@
 #include "v8.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace node {
 
@@ -32,6 +33,7 @@ using v8::Int32;
 using v8::Isolate;
 using v8::Local;
 using v8::NewStringType;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SnapshotCreator;
@@ -103,7 +105,9 @@ void BlobFromFilePath(const FunctionCallbackInfo<Value>& args) {
   ToNamespacedPath(env, &path);
   THROW_IF_INSUFFICIENT_PERMISSIONS(
       env, permission::PermissionScope::kFileSystemRead, path.ToStringView());
-  auto entry = DataQueue::CreateFdEntry(env, args[0]);
+  auto entry = args[1]->IsTrue()
+                   ? DataQueue::CreateMappedFileEntry(env, args[0])
+                   : DataQueue::CreateFdEntry(env, args[0]);
   if (entry == nullptr) {
     return THROW_ERR_INVALID_ARG_VALUE(env, "Unable to open file as blob");
   }
@@ -332,6 +336,133 @@ BaseObjectPtr<Blob::Reader> Blob::Reader::Create(Environment* env,
   return MakeBaseObject<Blob::Reader>(env, obj, std::move(blob));
 }
 
+namespace {
+// Collects the data of one or more pulls from the DataQueue::Reader of a
+// Blob::Reader and hands it to the JavaScript callback as a single
+// ArrayBuffer. Pulls are issued until max_bytes have been collected,
+// max_pulls pulls have been made, or the source stops returning
+// STATUS_CONTINUE. Sources that complete synchronously are pulled in a loop;
+// for asynchronous sources, the next pull is issued from the callback.
+class BlobPullBatch final {
+ public:
+  BlobPullBatch(Environment* env,
+                BaseObjectPtr<Blob::Reader> reader,
+                std::shared_ptr<DataQueue::Reader> inner,
+                Local<Function> callback,
+                uint64_t max_bytes,
+                size_t max_pulls)
+      : env_(env),
+        reader_(std::move(reader)),
+        inner_(std::move(inner)),
+        callback_(env->isolate(), callback),
+        max_bytes_(max_bytes),
+        max_pulls_(max_pulls) {}
+
+  // Deletes `this` once the callback has been called.
+  int Run() {
+    for (;;) {
+      pending_ = true;
+      synchronous_ = true;
+      int status = inner_->Pull(
+          [this](int status,
+                 const DataQueue::Vec* vecs,
+                 size_t count,
+                 bob::Done done) {
+            OnPull(status, vecs, count, std::move(done));
+          },
+          bob::OPTIONS_END,
+          nullptr,
+          0);
+      synchronous_ = false;
+      if (pending_) return status;
+      if (!want_more_) {
+        Finish();
+        return status;
+      }
+    }
+  }
+
+ private:
+  void OnPull(int status,
+              const DataQueue::Vec* vecs,
+              size_t count,
+              bob::Done done) {
+    pending_ = false;
+    status_ = status;
+    pulls_++;
+    if (count > 0) {
+      for (size_t n = 0; n < count; n++) {
+        vecs_.push_back(vecs[n]);
+        bytes_ += vecs[n].len;
+      }
+      // The vectors stay valid until their Done callback is called.
+      dones_.push_back(std::move(done));
+    } else {
+      std::move(done)(0);
+    }
+    want_more_ = status == bob::STATUS_CONTINUE && bytes_ < max_bytes_ &&
+                 pulls_ < max_pulls_;
+    if (synchronous_) return;
+    if (want_more_) {
+      Run();
+    } else {
+      Finish();
+    }
+  }
+
+  void Finish() {
+    auto dropMe = std::unique_ptr<BlobPullBatch>(this);
+    Isolate* isolate = env_->isolate();
+    HandleScope handle_scope(isolate);
+    Local<Function> fn = callback_.Get(isolate);
+
+    // Data that was collected before the end of the stream is delivered
+    // first, the end of the stream is reported by the next pull.
+    if (status_ == bob::STATUS_EOS) reader_->set_eos();
+
+    Local<Value> argv[2];
+    if (status_ >= 0 && !vecs_.empty()) {
+      std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
+          isolate, bytes_, BackingStoreInitializationMode::kUninitialized);
+      auto ptr = static_cast<uint8_t*>(store->Data());
+      for (const DataQueue::Vec& vec : vecs_) {
+        std::copy(vec.base, vec.base + vec.len, ptr);
+        ptr += vec.len;
+      }
+      argv[0] = Uint32::New(isolate, bob::STATUS_CONTINUE);
+      argv[1] = ArrayBuffer::New(isolate, std::move(store));
+    } else {
+      argv[0] = Int32::New(isolate, status_);
+      argv[1] = Undefined(isolate);
+    }
+
+    // Since we copied the data buffers, signal that we're done with them.
+    for (auto& done : dones_) std::move(done)(0);
+    dones_.clear();
+    reader_->MakeCallback(fn, arraysize(argv), argv);
+  }
+
+  Environment* env_;
+  BaseObjectPtr<Blob::Reader> reader_;
+  std::shared_ptr<DataQueue::Reader> inner_;
+  Global<Function> callback_;
+  uint64_t max_bytes_;
+  size_t max_pulls_;
+  std::vector<DataQueue::Vec> vecs_;
+  std::vector<bob::Done> dones_;
+  uint64_t bytes_ = 0;
+  size_t pulls_ = 0;
+  int status_ = bob::STATUS_CONTINUE;
+  bool pending_ = false;
+  bool synchronous_ = false;
+  bool want_more_ = false;
+};
+}  // namespace
+
+// pull(callback[, maxBytes[, maxPulls]]) calls callback(status, buffer) with
+// the data of up to maxPulls pulls from the underlying DataQueue, stopping
+// early once at least maxBytes bytes have been collected. Both default to a
+// single pull.
 void Blob::Reader::Pull(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Blob::Reader* reader;
@@ -341,67 +472,33 @@ void Blob::Reader::Pull(const FunctionCallbackInfo<Value>& args) {
   Local<Function> fn = args[0].As<Function>();
   CHECK(!fn->IsConstructor());
 
+  uint64_t max_bytes = 0;
+  if (args[1]->IsNumber()) {
+    double value = args[1].As<Number>()->Value();
+    if (value > 0) {
+      max_bytes = value >= static_cast<double>(kMaxSafeJsInteger)
+                      ? static_cast<uint64_t>(kMaxSafeJsInteger)
+                      : static_cast<uint64_t>(value);
+    }
+  }
+  size_t max_pulls = 1;
+  if (args[2]->IsUint32()) {
+    max_pulls = std::max<size_t>(args[2].As<Uint32>()->Value(), 1);
+  }
+
   if (reader->eos_) {
     Local<Value> arg = Int32::New(env->isolate(), bob::STATUS_EOS);
     reader->MakeCallback(fn, 1, &arg);
     return args.GetReturnValue().Set(bob::STATUS_EOS);
   }
 
-  struct Impl {
-    BaseObjectPtr<Blob::Reader> reader;
-    Global<Function> callback;
-    Environment* env;
-  };
-  // TODO(@jasnell): A unique_ptr is likely better here but making this a unique
-  // pointer that is passed into the lambda causes the std::move(next) below to
-  // complain about std::function needing to be copy-constructible.
-  Impl* impl = new Impl();
-  impl->reader = BaseObjectPtr<Blob::Reader>(reader);
-  impl->callback.Reset(env->isolate(), fn);
-  impl->env = env;
-
-  auto next = [impl](int status,
-                     const DataQueue::Vec* vecs,
-                     size_t count,
-                     bob::Done doneCb) mutable {
-    auto dropMe = std::unique_ptr<Impl>(impl);
-    Environment* env = impl->env;
-    HandleScope handleScope(env->isolate());
-    Local<Function> fn = impl->callback.Get(env->isolate());
-
-    if (status == bob::STATUS_EOS) impl->reader->eos_ = true;
-
-    if (count > 0) {
-      // Copy the returns vectors into a single ArrayBuffer.
-      size_t total = 0;
-      for (size_t n = 0; n < count; n++) total += vecs[n].len;
-
-      std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
-          env->isolate(),
-          total,
-          BackingStoreInitializationMode::kUninitialized);
-      auto ptr = static_cast<uint8_t*>(store->Data());
-      for (size_t n = 0; n < count; n++) {
-        std::copy(vecs[n].base, vecs[n].base + vecs[n].len, ptr);
-        ptr += vecs[n].len;
-      }
-      // Since we copied the data buffers, signal that we're done with them.
-      std::move(doneCb)(0);
-      Local<Value> argv[2] = {Uint32::New(env->isolate(), status),
-                              ArrayBuffer::New(env->isolate(), store)};
-      impl->reader->MakeCallback(fn, arraysize(argv), argv);
-      return;
-    }
-
-    Local<Value> argv[2] = {
-        Int32::New(env->isolate(), status),
-        Undefined(env->isolate()),
-    };
-    impl->reader->MakeCallback(fn, arraysize(argv), argv);
-  };
-
-  args.GetReturnValue().Set(reader->inner_->Pull(
-      std::move(next), node::bob::OPTIONS_END, nullptr, 0));
+  auto batch = new BlobPullBatch(env,
+                                 BaseObjectPtr<Blob::Reader>(reader),
+                                 reader->inner_,
+                                 fn,
+                                 max_bytes,
+                                 max_pulls);
+  args.GetReturnValue().Set(batch->Run());
 }
 
 BaseObjectPtr<BaseObject>
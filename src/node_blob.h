@@ -87,6 +87,8 @@ class Blob : public BaseObject {
                     v8::Local<v8::Object> obj,
                     BaseObjectPtr<Blob> strong_ptr);
 
+    void set_eos() { eos_ = true; }
+
     SET_NO_MEMORY_INFO()
     SET_MEMORY_INFO_NAME(Blob::Reader)
     SET_SELF_SIZE(Reader)
@@ -31,6 +31,8 @@
 #include "env-inl.h"
 #include "simdutf.h"
 #include "string_bytes.h"
+#include "string_bytes_simd.h"
+#include "string_search.h"
 
 #include "util-inl.h"
 #include "v8-fast-api-calls.h"
@@ -39,6 +41,8 @@
 #include <stdint.h>
 #include <climits>
 #include <cstring>
+#include <limits>
+#include <vector>
 #include "nbytes.h"
 
 #define THROW_AND_RETURN_UNLESS_BUFFER(env, obj)                            \
@@ -55,6 +59,7 @@
 namespace node {
 namespace Buffer {
 
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
@@ -64,7 +69,9 @@ using v8::Context;
 using v8::EscapableHandleScope;
 using v8::FastApiCallbackOptions;
 using v8::FastOneByteString;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
@@ -563,6 +570,43 @@ void StringSlice(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// toStringWithoutCopy(view, encoding) decodes a view that is not modified
+// afterwards, e.g. the contents of a file that were read internally. Large
+// latin1 and ASCII strings then share its memory, unless the memory is not
+// owned by the view's ArrayBuffer alone, such as a file mapping or a pool
+// that is shared between reads. Those are marked untransferable.
+void ToStringWithoutCopy(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsString());
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+
+  bool untransferable;
+  if (!view->Buffer()
+           ->HasPrivate(env->context(),
+                        env->untransferable_object_private_symbol())
+           .To(&untransferable)) {
+    return;
+  }
+
+  Local<Value> ret;
+  if (untransferable) {
+    ArrayBufferViewContents<char> contents(view);
+    if (StringBytes::Encode(
+            isolate, contents.data(), contents.length(), encoding)
+            .ToLocal(&ret)) {
+      args.GetReturnValue().Set(ret);
+    }
+    return;
+  }
+
+  if (StringBytes::EncodeWithoutCopy(isolate, view, encoding).ToLocal(&ret)) {
+    args.GetReturnValue().Set(ret);
+  }
+}
+
 void CopyImpl(Local<Value> source_obj,
               Local<Value> target_obj,
               const uint32_t target_start,
@@ -605,6 +649,35 @@ uint32_t FastCopy(Local<Value> receiver,
 
 static CFunction fast_copy(CFunction::Make(FastCopy));
 
+// concat(list, target) copies the Uint8Arrays in `list` one after the other
+// into `target`, until it is full, and returns the number of bytes copied. If
+// list[i] is not a Uint8Array, -1 - i is returned instead.
+void Concat(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint8Array());
+  Local<Array> list = args[0].As<Array>();
+  SPREAD_BUFFER_ARG(args[1], target);
+
+  size_t position = 0;
+  const uint32_t length = list->Length();
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> element;
+    if (!list->Get(context, i).ToLocal(&element)) return;
+    if (!element->IsUint8Array()) {
+      args.GetReturnValue().Set(-1 - static_cast<double>(i));
+      return;
+    }
+    ArrayBufferViewContents<char> source(element);
+    size_t to_copy = std::min(source.length(), target_length - position);
+    memmove(target_data + position, source.data(), to_copy);
+    position += to_copy;
+  }
+
+  args.GetReturnValue().Set(static_cast<double>(position));
+}
+
 void Fill(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Local<Context> ctx = env->context();
@@ -1025,13 +1098,13 @@ void IndexOfString(const FunctionCallbackInfo<Value>& args) {
     if (*needle_value == nullptr)
       return args.GetReturnValue().Set(-1);
 
-    result =
-        nbytes::SearchString(reinterpret_cast<const uint8_t*>(haystack),
-                             haystack_length,
-                             reinterpret_cast<const uint8_t*>(*needle_value),
-                             needle_length,
-                             offset,
-                             is_forward);
+    result = stringsearch::SearchString(
+        reinterpret_cast<const uint8_t*>(haystack),
+        haystack_length,
+        reinterpret_cast<const uint8_t*>(*needle_value),
+        needle_length,
+        offset,
+        is_forward);
   } else if (enc == LATIN1) {
     uint8_t* needle_data = node::UncheckedMalloc<uint8_t>(needle_length);
     if (needle_data == nullptr) {
@@ -1040,12 +1113,13 @@ void IndexOfString(const FunctionCallbackInfo<Value>& args) {
     needle->WriteOneByte(
         isolate, needle_data, 0, needle_length, String::NO_NULL_TERMINATION);
 
-    result = nbytes::SearchString(reinterpret_cast<const uint8_t*>(haystack),
-                                  haystack_length,
-                                  needle_data,
-                                  needle_length,
-                                  offset,
-                                  is_forward);
+    result = stringsearch::SearchString(
+        reinterpret_cast<const uint8_t*>(haystack),
+        haystack_length,
+        needle_data,
+        needle_length,
+        offset,
+        is_forward);
     free(needle_data);
   }
 
@@ -1112,18 +1186,107 @@ void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
                                   is_forward);
     result *= 2;
   } else {
-    result = nbytes::SearchString(reinterpret_cast<const uint8_t*>(haystack),
-                                  haystack_length,
-                                  reinterpret_cast<const uint8_t*>(needle),
-                                  needle_length,
-                                  offset,
-                                  is_forward);
+    result = stringsearch::SearchString(
+        reinterpret_cast<const uint8_t*>(haystack),
+        haystack_length,
+        reinterpret_cast<const uint8_t*>(needle),
+        needle_length,
+        offset,
+        is_forward);
   }
 
   args.GetReturnValue().Set(
       result == haystack_length ? -1 : static_cast<int>(result));
 }
 
+// A needle that is searched for in many buffers, see stringsearch::
+// CompiledNeedle. The search is byte-wise, like IndexOfBuffer() with a
+// non-UCS2 encoding.
+class BufferNeedle final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, Local<Object> target) {
+    Isolate* isolate = env->isolate();
+    Local<FunctionTemplate> tmpl = NewFunctionTemplate(isolate, New);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(kInternalFieldCount);
+    SetProtoMethodNoSideEffect(isolate, tmpl, "indexOf", IndexOf);
+    SetConstructorFunction(env->context(), target, "Needle", tmpl);
+  }
+
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+    registry->Register(New);
+    registry->Register(IndexOf);
+  }
+
+  BufferNeedle(Environment* env,
+               Local<Object> object,
+               const uint8_t* data,
+               size_t length)
+      : BaseObject(env, object), needle_(data, length) {
+    MakeWeak();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("needle", needle_.length());
+  }
+
+  SET_MEMORY_INFO_NAME(BufferNeedle)
+  SET_SELF_SIZE(BufferNeedle)
+
+ private:
+  // new Needle(bytes)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    CHECK(args[0]->IsArrayBufferView());
+    Environment* env = Environment::GetCurrent(args);
+    ArrayBufferViewContents<uint8_t> needle(args[0]);
+    new BufferNeedle(env, args.This(), needle.data(), needle.length());
+  }
+
+  // needle.indexOf(buffer, byteOffset, isForward)
+  static void IndexOf(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args[1]->IsNumber());
+    CHECK(args[2]->IsBoolean());
+
+    BufferNeedle* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+    THROW_AND_RETURN_UNLESS_BUFFER(wrap->env(), args[0]);
+    ArrayBufferViewContents<uint8_t> haystack(args[0]);
+    int64_t offset_i64 = args[1].As<Integer>()->Value();
+    bool is_forward = args[2]->IsTrue();
+
+    const size_t haystack_length = haystack.length();
+    const size_t needle_length = wrap->needle_.length();
+
+    int64_t opt_offset = IndexOfOffset(haystack_length,
+                                       offset_i64,
+                                       needle_length,
+                                       is_forward);
+
+    if (needle_length == 0) {
+      // Match String#indexOf() and String#lastIndexOf() behavior.
+      args.GetReturnValue().Set(static_cast<double>(opt_offset));
+      return;
+    }
+
+    if (haystack_length == 0 || opt_offset <= -1) {
+      return args.GetReturnValue().Set(-1);
+    }
+    size_t offset = static_cast<size_t>(opt_offset);
+    CHECK_LT(offset, haystack_length);
+    if ((is_forward && needle_length + offset > haystack_length) ||
+        needle_length > haystack_length) {
+      return args.GetReturnValue().Set(-1);
+    }
+
+    size_t result = wrap->needle_.Search(
+        haystack.data(), haystack_length, offset, is_forward);
+    args.GetReturnValue().Set(
+        result == haystack_length ? -1 : static_cast<double>(result));
+  }
+
+  stringsearch::CompiledNeedle needle_;
+};
+
 int32_t IndexOfNumberImpl(Local<Value> buffer_obj,
                           const uint32_t needle,
                           const int64_t offset_i64,
@@ -1177,6 +1340,138 @@ int32_t FastIndexOfNumber(Local<Value>,
 
 static CFunction fast_index_of_number(CFunction::Make(FastIndexOfNumber));
 
+// Assume caller has properly validated args.
+void WebSocketMaskImpl(Local<Value> data_obj, Local<Value> key_obj) {
+  SPREAD_BUFFER_ARG(data_obj, data);
+  ArrayBufferViewContents<uint8_t, 4> key(key_obj);
+  CHECK_GE(key.length(), 4);
+  simd::XorMask(reinterpret_cast<uint8_t*>(data_data), data_length, key.data());
+}
+
+// webSocketMask(data, key) masks or unmasks `data` in place with the first
+// four bytes of `key`.
+void SlowWebSocketMask(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[1]->IsArrayBufferView());
+  WebSocketMaskImpl(args[0], args[1]);
+}
+
+void FastWebSocketMask(Local<Value> receiver,
+                       Local<Value> data_obj,
+                       Local<Value> key_obj,
+                       // NOLINTNEXTLINE(runtime/references)
+                       FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("buffer.webSocketMask");
+  HandleScope scope(options.isolate);
+  WebSocketMaskImpl(data_obj, key_obj);
+}
+
+static CFunction fast_web_socket_mask(CFunction::Make(FastWebSocketMask));
+
+// Parses the header of the WebSocket frame at the start of `data` into `out`,
+// a Float64Array: out[0] is the first byte (FIN, RSV1-3 and the opcode),
+// out[1] is 1 if the payload is masked and 0 otherwise, and out[2] is the
+// length of the payload. If the payload is masked, the masking key makes up
+// the last four bytes of the header.
+// Returns the length of the header, 0 if `data` does not contain all of it
+// yet, or -1 if the payload length is too large.
+int32_t ParseWebSocketFrameHeaderImpl(Local<Value> data_obj,
+                                      Local<Value> out_obj) {
+  ArrayBufferViewContents<uint8_t, 16> data(data_obj);
+  CHECK(out_obj->IsFloat64Array());
+  Local<Float64Array> out_array = out_obj.As<Float64Array>();
+  CHECK_GE(out_array->Length(), 3);
+  double* out = reinterpret_cast<double*>(
+      static_cast<char*>(out_array->Buffer()->Data()) +
+      out_array->ByteOffset());
+
+  const uint8_t* p = data.data();
+  const size_t length = data.length();
+  if (length < 2) return 0;
+
+  int32_t header_length = 2;
+  uint64_t payload_length = p[1] & 0x7f;
+  if (payload_length == 126) {
+    header_length += 2;
+    if (length < static_cast<size_t>(header_length)) return 0;
+    payload_length = (p[2] << 8) | p[3];
+  } else if (payload_length == 127) {
+    header_length += 8;
+    if (length < static_cast<size_t>(header_length)) return 0;
+    payload_length = 0;
+    for (int i = 2; i < 10; i++) payload_length = (payload_length << 8) | p[i];
+    // This also rejects lengths with the most significant bit set.
+    if (payload_length > static_cast<uint64_t>(kMaxSafeJsInteger)) return -1;
+  }
+  const bool masked = p[1] & 0x80;
+  if (masked) header_length += 4;
+  if (length < static_cast<size_t>(header_length)) return 0;
+
+  out[0] = p[0];
+  out[1] = masked ? 1 : 0;
+  out[2] = static_cast<double>(payload_length);
+  return header_length;
+}
+
+void SlowParseWebSocketFrameHeader(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsArrayBufferView());
+  args.GetReturnValue().Set(ParseWebSocketFrameHeaderImpl(args[0], args[1]));
+}
+
+int32_t FastParseWebSocketFrameHeader(Local<Value> receiver,
+                                      Local<Value> data_obj,
+                                      Local<Value> out_obj,
+                                      // NOLINTNEXTLINE(runtime/references)
+                                      FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("buffer.parseWebSocketFrameHeader");
+  HandleScope scope(options.isolate);
+  return ParseWebSocketFrameHeaderImpl(data_obj, out_obj);
+}
+
+static CFunction fast_parse_web_socket_frame_header(
+    CFunction::Make(FastParseWebSocketFrameHeader));
+
+// findLineBreaks(buffer, start) returns the line breaks in the buffer at or
+// after `start` as a Uint32Array of pairs: the index at which the line break
+// starts and the index at which the next line starts. Line breaks are LF,
+// CRLF, a CR that is not followed by LF and U+2028 and U+2029 in UTF-8, as
+// in readline. Returns undefined if the buffer is too large for the indices.
+void FindLineBreaks(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
+  CHECK(args[1]->IsUint32());
+  ArrayBufferViewContents<uint8_t> buffer(args[0]);
+  const uint8_t* data = buffer.data();
+  const size_t length = buffer.length();
+  if (length > std::numeric_limits<uint32_t>::max()) return;
+
+  std::vector<uint32_t> breaks;
+  size_t i = args[1].As<Uint32>()->Value();
+  while ((i = simd::FindLineBreakCandidate(data, i, length)) < length) {
+    size_t next;
+    if (data[i] == '\n') {
+      next = i + 1;
+    } else if (data[i] == '\r') {
+      next = i + 1 < length && data[i + 1] == '\n' ? i + 2 : i + 1;
+    } else if (i + 2 < length && data[i + 1] == 0x80 &&
+               (data[i + 2] == 0xa8 || data[i + 2] == 0xa9)) {
+      next = i + 3;
+    } else {
+      i++;
+      continue;
+    }
+    breaks.push_back(i);
+    breaks.push_back(next);
+    i = next;
+  }
+
+  Local<ArrayBuffer> ab =
+      ArrayBuffer::New(env->isolate(), breaks.size() * sizeof(uint32_t));
+  if (!breaks.empty()) {
+    memcpy(ab->Data(), breaks.data(), breaks.size() * sizeof(uint32_t));
+  }
+  args.GetReturnValue().Set(Uint32Array::New(ab, 0, breaks.size()));
+}
+
 void Swap16(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
@@ -1297,8 +1592,7 @@ static void Btoa(const FunctionCallbackInfo<Value>& args) {
     size_t expected_length = simdutf::base64_length_from_binary(ext->length());
     buffer.AllocateSufficientStorage(expected_length + 1);
     buffer.SetLengthAndZeroTerminate(expected_length);
-    written =
-        simdutf::binary_to_base64(ext->data(), ext->length(), buffer.out());
+    written = simd::Base64Encode(ext->data(), ext->length(), buffer.out());
   } else if (input->IsOneByte()) {
     MaybeStackBuffer<uint8_t> stack_buf(input->Length());
     input->WriteOneByte(env->isolate(),
@@ -1311,10 +1605,9 @@ static void Btoa(const FunctionCallbackInfo<Value>& args) {
         simdutf::base64_length_from_binary(input->Length());
     buffer.AllocateSufficientStorage(expected_length + 1);
     buffer.SetLengthAndZeroTerminate(expected_length);
-    written =
-        simdutf::binary_to_base64(reinterpret_cast<const char*>(*stack_buf),
-                                  input->Length(),
-                                  buffer.out());
+    written = simd::Base64Encode(reinterpret_cast<const char*>(*stack_buf),
+                                 input->Length(),
+                                 buffer.out());
   } else {
     String::Value value(env->isolate(), input);
     MaybeStackBuffer<char> stack_buf(value.length());
@@ -1328,7 +1621,7 @@ static void Btoa(const FunctionCallbackInfo<Value>& args) {
     size_t expected_length = simdutf::base64_length_from_binary(out_len);
     buffer.AllocateSufficientStorage(expected_length + 1);
     buffer.SetLengthAndZeroTerminate(expected_length);
-    written = simdutf::binary_to_base64(*stack_buf, out_len, buffer.out());
+    written = simd::Base64Encode(*stack_buf, out_len, buffer.out());
   }
 
   auto value = OneByteString(
@@ -1357,7 +1650,7 @@ static void Atob(const FunctionCallbackInfo<Value>& args) {
         simdutf::maximal_binary_length_from_base64(ext->data(), ext->length());
     buffer.AllocateSufficientStorage(expected_length);
     buffer.SetLength(expected_length);
-    result = simdutf::base64_to_binary(
+    result = simd::Base64Decode(
         ext->data(), ext->length(), buffer.out(), simdutf::base64_default);
   } else if (input->IsOneByte()) {
     MaybeStackBuffer<uint8_t> stack_buf(input->Length());
@@ -1371,7 +1664,7 @@ static void Atob(const FunctionCallbackInfo<Value>& args) {
         simdutf::maximal_binary_length_from_base64(data, input->Length());
     buffer.AllocateSufficientStorage(expected_length);
     buffer.SetLength(expected_length);
-    result = simdutf::base64_to_binary(data, input->Length(), buffer.out());
+    result = simd::Base64Decode(data, input->Length(), buffer.out());
   } else {  // 16-bit case
     String::Value value(env->isolate(), input);
     auto data = reinterpret_cast<const char16_t*>(*value);
@@ -1563,6 +1856,7 @@ void Initialize(Local<Object> target,
                             SlowByteLengthUtf8,
                             &fast_byte_length_utf8);
   SetFastMethod(context, target, "copy", SlowCopy, &fast_copy);
+  SetMethod(context, target, "concat", Concat);
   SetFastMethodNoSideEffect(context, target, "compare", Compare, &fast_compare);
   SetMethodNoSideEffect(context, target, "compareOffset", CompareOffset);
   SetMethod(context, target, "fill", Fill);
@@ -1573,9 +1867,22 @@ void Initialize(Local<Object> target,
                             SlowIndexOfNumber,
                             &fast_index_of_number);
   SetMethodNoSideEffect(context, target, "indexOfString", IndexOfString);
+  SetMethodNoSideEffect(context, target, "findLineBreaks", FindLineBreaks);
+  BufferNeedle::Initialize(env, target);
 
   SetMethod(context, target, "copyArrayBuffer", CopyArrayBuffer);
 
+  SetFastMethod(context,
+                target,
+                "webSocketMask",
+                SlowWebSocketMask,
+                &fast_web_socket_mask);
+  SetFastMethod(context,
+                target,
+                "parseWebSocketFrameHeader",
+                SlowParseWebSocketFrameHeader,
+                &fast_parse_web_socket_frame_header);
+
   SetMethod(context, target, "swap16", Swap16);
   SetMethod(context, target, "swap32", Swap32);
   SetMethod(context, target, "swap64", Swap64);
@@ -1603,6 +1910,8 @@ void Initialize(Local<Object> target,
   SetMethodNoSideEffect(context, target, "hexSlice", StringSlice<HEX>);
   SetMethodNoSideEffect(context, target, "ucs2Slice", StringSlice<UCS2>);
   SetMethodNoSideEffect(context, target, "utf8Slice", StringSlice<UTF8>);
+  SetMethodNoSideEffect(
+      context, target, "toStringWithoutCopy", ToStringWithoutCopy);
 
   SetMethod(context, target, "base64Write", StringWrite<BASE64>);
   SetMethod(context, target, "base64urlWrite", StringWrite<BASE64URL>);
@@ -1639,6 +1948,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SlowCopy);
   registry->Register(fast_copy.GetTypeInfo());
   registry->Register(FastCopy);
+  registry->Register(Concat);
   registry->Register(Compare);
   registry->Register(FastCompare);
   registry->Register(fast_compare.GetTypeInfo());
@@ -1649,6 +1959,15 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(FastIndexOfNumber);
   registry->Register(fast_index_of_number.GetTypeInfo());
   registry->Register(IndexOfString);
+  registry->Register(FindLineBreaks);
+  BufferNeedle::RegisterExternalReferences(registry);
+
+  registry->Register(SlowWebSocketMask);
+  registry->Register(FastWebSocketMask);
+  registry->Register(fast_web_socket_mask.GetTypeInfo());
+  registry->Register(SlowParseWebSocketFrameHeader);
+  registry->Register(FastParseWebSocketFrameHeader);
+  registry->Register(fast_parse_web_socket_frame_header.GetTypeInfo());
 
   registry->Register(Swap16);
   registry->Register(Swap32);
@@ -1664,6 +1983,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(StringSlice<HEX>);
   registry->Register(StringSlice<UCS2>);
   registry->Register(StringSlice<UTF8>);
+  registry->Register(ToStringWithoutCopy);
 
   registry->Register(SlowWriteString<ASCII>);
   registry->Register(SlowWriteString<LATIN1>);
@@ -3,6 +3,7 @@
 #include "env-inl.h"
 #include "node_external_reference.h"
 #include "node_internals.h"
+#include "node_perf.h"
 #include "node_threadsafe_cow-inl.h"
 #include "simdutf.h"
 #include "util-inl.h"
@@ -24,6 +25,7 @@ using v8::MaybeLocal;
 using v8::Name;
 using v8::NewStringType;
 using v8::None;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::PropertyCallbackInfo;
@@ -323,6 +325,7 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
       has_cache ? "with" : "without",
       options == ScriptCompiler::kEagerCompile ? "eagerly" : "lazily");
 
+  uint64_t compile_start = uv_hrtime();
   MaybeLocal<Function> maybe_fun =
       ScriptCompiler::CompileFunction(context,
                                       &script_source,
@@ -347,12 +350,19 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
   // will never be in any of these two sets, but the two sets are only for
   // testing anyway.
 
-  Result result = (has_cache && !script_source.GetCachedData()->rejected)
-                      ? Result::kWithCache
-                      : Result::kWithoutCache;
+  Result result = !has_cache ? Result::kWithoutCache
+                  : script_source.GetCachedData()->rejected
+                      ? Result::kWithRejectedCache
+                      : Result::kWithCache;
   if (optional_realm != nullptr) {
     DCHECK_EQ(this, optional_realm->env()->builtin_loader());
-    RecordResult(id, result, optional_realm);
+    uint64_t compile_end = uv_hrtime();
+    RecordResult(id, result, compile_end - compile_start, optional_realm);
+    optional_realm->env()->performance_state()->RecordBootstrapPhase(
+        performance::NODE_BOOTSTRAP_PHASE_BUILTIN_COMPILATION,
+        compile_start,
+        compile_end,
+        id);
   }
 
   if (has_cache) {
@@ -367,7 +377,7 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
                                                                : "is accepted");
   }
 
-  if (result == Result::kWithoutCache && optional_realm != nullptr &&
+  if (result != Result::kWithCache && optional_realm != nullptr &&
       !optional_realm->env()->isolate_data()->is_building_snapshot()) {
     // We failed to accept this cache, maybe because it was rejected, maybe
     // because it wasn't present. Either way, we'll attempt to replace this
@@ -624,6 +634,7 @@ void BuiltinLoader::GetCacheUsage(const FunctionCallbackInfo<Value>& args) {
   Local<Value> builtins_with_cache_js;
   Local<Value> builtins_without_cache_js;
   Local<Value> builtins_in_snapshot_js;
+  Local<Value> builtins_with_rejected_cache_js;
   if (!ToV8Value(context, realm->builtins_with_cache)
            .ToLocal(&builtins_with_cache_js) ||
       result
@@ -644,6 +655,32 @@ void BuiltinLoader::GetCacheUsage(const FunctionCallbackInfo<Value>& args) {
           ->Set(context,
                 FIXED_ONE_BYTE_STRING(isolate, "compiledInSnapshot"),
                 builtins_in_snapshot_js)
+          .IsNothing() ||
+      !ToV8Value(context, realm->builtins_with_rejected_cache)
+           .ToLocal(&builtins_with_rejected_cache_js) ||
+      result
+          ->Set(context,
+                FIXED_ONE_BYTE_STRING(isolate, "compiledWithRejectedCache"),
+                builtins_with_rejected_cache_js)
+          .IsNothing()) {
+    return;
+  }
+
+  // The time spent compiling each built-in, in milliseconds.
+  Local<Object> compile_time = Object::New(isolate);
+  for (const auto& [id, time] : realm->builtin_compile_time) {
+    if (compile_time
+            ->Set(context,
+                  OneByteString(isolate, id),
+                  Number::New(isolate, static_cast<double>(time) / 1e6))
+            .IsNothing()) {
+      return;
+    }
+  }
+  if (result
+          ->Set(context,
+                FIXED_ONE_BYTE_STRING(isolate, "compileTime"),
+                compile_time)
           .IsNothing()) {
     return;
   }
@@ -672,12 +709,17 @@ void BuiltinLoader::ConfigStringGetter(
 
 void BuiltinLoader::RecordResult(const char* id,
                                  BuiltinLoader::Result result,
+                                 uint64_t compile_time,
                                  Realm* realm) {
   if (result == BuiltinLoader::Result::kWithCache) {
     realm->builtins_with_cache.insert(id);
   } else {
     realm->builtins_without_cache.insert(id);
+    if (result == BuiltinLoader::Result::kWithRejectedCache) {
+      realm->builtins_with_rejected_cache.insert(id);
+    }
   }
+  realm->builtin_compile_time[id] += compile_time;
 }
 
 void BuiltinLoader::CompileFunction(const FunctionCallbackInfo<Value>& args) {
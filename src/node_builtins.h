@@ -46,6 +46,12 @@ class BuiltinCodeCacheData {
   BuiltinCodeCacheData(const uint8_t* data, size_t length)
       : data(data), length(length), owning_ptr(nullptr) {}
 
+  // |owner| keeps |data| alive, e.g. the snapshot blob that contains it.
+  BuiltinCodeCacheData(const uint8_t* data,
+                       size_t length,
+                       std::shared_ptr<void> owner)
+      : data(data), length(length), owning_ptr(std::move(owner)) {}
+
   const uint8_t* data;
   size_t length;
 
@@ -151,7 +157,7 @@ class NODE_EXTERN_PRIVATE BuiltinLoader {
   BuiltinCategories GetBuiltinCategories() const;
 
   const v8::ScriptCompiler::CachedData* GetCodeCache(const char* id) const;
-  enum class Result { kWithCache, kWithoutCache };
+  enum class Result { kWithCache, kWithRejectedCache, kWithoutCache };
   v8::MaybeLocal<v8::String> LoadBuiltinSource(v8::Isolate* isolate,
                                                const char* id) const;
   // If an exception is encountered (e.g. source code contains
@@ -165,6 +171,7 @@ class NODE_EXTERN_PRIVATE BuiltinLoader {
 
   static void RecordResult(const char* id,
                            BuiltinLoader::Result result,
+                           uint64_t compile_time,
                            Realm* realm);
   static void GetBuiltinCategories(
       v8::Local<v8::Name> property,
@@ -137,6 +137,10 @@ ContextifyContext* ContextifyContext::New(Environment* env,
           : env->isolate()->GetCurrentContext()->GetMicrotaskQueue();
 
   Local<Context> v8_context;
+  if (!object_template.IsEmpty() &&
+      TakePooledContext(env, queue).ToLocal(&v8_context)) {
+    return New(v8_context, env, sandbox_obj, options);
+  }
   if (!(CreateV8Context(env->isolate(), object_template, snapshot_data, queue)
             .ToLocal(&v8_context))) {
     // Allocation failure, maximum call stack size reached, termination, etc.
@@ -145,6 +149,63 @@ ContextifyContext* ContextifyContext::New(Environment* env,
   return New(v8_context, env, sandbox_obj, options);
 }
 
+// Pooled contexts are deserialized ahead of time with the interceptor
+// template and the microtask queue of the main context, so they can only be
+// handed out for contexts that would have been created the same way.
+MaybeLocal<Context> ContextifyContext::TakePooledContext(
+    Environment* env, MicrotaskQueue* queue) {
+  Environment::VMContextPool* pool = env->vm_context_pool();
+  if (pool->contexts.empty() ||
+      queue != env->context()->GetMicrotaskQueue()) {
+    return {};
+  }
+
+  Local<Context> context = pool->contexts.back().Get(env->isolate());
+  pool->contexts.pop_back();
+  // Refill the pool outside of the code that is currently waiting for the
+  // context.
+  if (!pool->refill_scheduled) {
+    pool->refill_scheduled = true;
+    env->SetImmediate([](Environment* env) { FillContextPool(env); },
+                      CallbackFlags::kUnrefed);
+  }
+  return context;
+}
+
+void ContextifyContext::FillContextPool(Environment* env) {
+  Isolate* isolate = env->isolate();
+  Environment::VMContextPool* pool = env->vm_context_pool();
+  pool->refill_scheduled = false;
+
+  HandleScope scope(isolate);
+  MicrotaskQueue* queue = env->context()->GetMicrotaskQueue();
+  while (pool->contexts.size() < pool->size) {
+    Local<Context> context;
+    if (!CreateV8Context(isolate,
+                         env->contextify_global_template(),
+                         env->isolate_data()->snapshot_data(),
+                         queue)
+             .ToLocal(&context)) {
+      return;
+    }
+    pool->contexts.emplace_back(isolate, context);
+  }
+}
+
+// setContextPoolSize(size)
+void ContextifyContext::SetContextPoolSize(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  Environment::VMContextPool* pool = env->vm_context_pool();
+  pool->size = args[0].As<Uint32>()->Value();
+  if (pool->contexts.size() > pool->size) {
+    pool->contexts.resize(pool->size);
+  } else {
+    FillContextPool(env);
+  }
+}
+
 void ContextifyContext::Trace(cppgc::Visitor* visitor) const {
   CppgcMixin::Trace(visitor);
   visitor->Trace(context_);
@@ -361,11 +422,13 @@ void ContextifyContext::CreatePerIsolateProperties(
     IsolateData* isolate_data, Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
   SetMethod(isolate, target, "makeContext", MakeContext);
+  SetMethod(isolate, target, "setContextPoolSize", SetContextPoolSize);
 }
 
 void ContextifyContext::RegisterExternalReferences(
     ExternalReferenceRegistry* registry) {
   registry->Register(MakeContext);
+  registry->Register(SetContextPoolSize);
   registry->Register(PropertyQueryCallback);
   registry->Register(PropertyGetterCallback);
   registry->Register(PropertySetterCallback);
@@ -997,11 +1060,12 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
   Local<Context> parsing_context = context;
 
   Local<Symbol> id_symbol;
+  bool use_compile_cache = false;
   if (argc > 2) {
     // new ContextifyScript(code, filename, lineOffset, columnOffset,
     //                      cachedData, produceCachedData, parsingContext,
-    //                      hostDefinedOptionId)
-    CHECK_EQ(argc, 8);
+    //                      hostDefinedOptionId, useCompileCache)
+    CHECK_EQ(argc, 9);
     CHECK(args[2]->IsNumber());
     line_offset = args[2].As<Int32>()->Value();
     CHECK(args[3]->IsNumber());
@@ -1022,6 +1086,8 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
     }
     CHECK(args[7]->IsSymbol());
     id_symbol = args[7].As<Symbol>();
+    CHECK(args[8]->IsBoolean());
+    use_compile_cache = args[8]->IsTrue();
   }
 
   ContextifyScript* contextify_script = New(env, args.This());
@@ -1042,6 +1108,17 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
         data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
   }
 
+  // Explicitly passed cachedData takes precedence over the compile cache.
+  CompileCacheEntry* cache_entry = nullptr;
+  if (use_compile_cache && cached_data == nullptr && env->use_compile_cache()) {
+    cache_entry = env->compile_cache_handler()->GetOrInsert(
+        code, filename, CachedCodeType::kVMScript);
+  }
+  if (cache_entry != nullptr && cache_entry->cache != nullptr) {
+    // source will take ownership of cached_data.
+    cached_data = cache_entry->CopyCache();
+  }
+
   Local<PrimitiveArray> host_defined_options =
       PrimitiveArray::New(isolate, loader::HostDefinedOptions::kLength);
   host_defined_options->Set(
@@ -1084,6 +1161,14 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
 
   contextify_script->set_unbound_script(v8_script);
 
+  if (cache_entry != nullptr) {
+    bool rejected = compile_options == ScriptCompiler::kConsumeCodeCache &&
+                    source.GetCachedData()->rejected;
+    env->compile_cache_handler()->MaybeSave(cache_entry, v8_script, rejected);
+    // cachedDataRejected is only reported for cachedData passed by the user.
+    compile_options = ScriptCompiler::kNoCompileOptions;
+  }
+
   std::unique_ptr<ScriptCompiler::CachedData> new_cached_data;
   if (produce_cached_data) {
     new_cached_data.reset(ScriptCompiler::CreateCodeCache(v8_script));
@@ -1453,6 +1538,10 @@ void ContextifyFunction::CompileFunction(
   CHECK(args[9]->IsSymbol());
   Local<Symbol> id_symbol = args[9].As<Symbol>();
 
+  // Argument 11: whether to use the compile cache
+  CHECK(args[10]->IsBoolean());
+  bool use_compile_cache = args[10]->IsTrue();
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
   if (!cached_data_buf.IsEmpty()) {
@@ -1461,6 +1550,34 @@ void ContextifyFunction::CompileFunction(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
   }
 
+  // Functions compiled with context extensions are not cached, as the
+  // extensions change how the code is compiled.
+  CompileCacheEntry* cache_entry = nullptr;
+  if (use_compile_cache && cached_data == nullptr &&
+      context_extensions_buf.IsEmpty() && env->use_compile_cache()) {
+    // The parameters are part of the compiled code, so they are part of
+    // the key: "a,b,\n<code>".
+    Local<String> keyed_code = FIXED_ONE_BYTE_STRING(isolate, "\n");
+    uint32_t params_count = params_buf.IsEmpty() ? 0 : params_buf->Length();
+    for (uint32_t n = params_count; n > 0; n--) {
+      Local<Value> val;
+      if (!params_buf->Get(context, n - 1).ToLocal(&val)) return;
+      CHECK(val->IsString());
+      keyed_code = String::Concat(
+          isolate,
+          String::Concat(
+              isolate, val.As<String>(), FIXED_ONE_BYTE_STRING(isolate, ",")),
+          keyed_code);
+    }
+    keyed_code = String::Concat(isolate, keyed_code, code);
+    cache_entry = env->compile_cache_handler()->GetOrInsert(
+        keyed_code, filename, CachedCodeType::kVMFunction);
+  }
+  if (cache_entry != nullptr && cache_entry->cache != nullptr) {
+    // source will take ownership of cached_data.
+    cached_data = cache_entry->CopyCache();
+  }
+
   Local<PrimitiveArray> host_defined_options =
       loader::ModuleWrap::GetHostDefinedOptions(isolate, id_symbol);
 
@@ -1517,7 +1634,8 @@ void ContextifyFunction::CompileFunction(
                                     options,
                                     produce_cached_data,
                                     id_symbol,
-                                    try_catch);
+                                    try_catch,
+                                    cache_entry);
   Local<Object> result;
   if (!maybe_result.ToLocal(&result)) {
     CHECK(try_catch.HasCaught());
@@ -1548,7 +1666,8 @@ MaybeLocal<Object> ContextifyFunction::CompileFunctionAndCacheResult(
     ScriptCompiler::CompileOptions options,
     bool produce_cached_data,
     Local<Symbol> id_symbol,
-    const TryCatchScope& try_catch) {
+    const TryCatchScope& try_catch,
+    CompileCacheEntry* cache_entry) {
   MaybeLocal<Function> maybe_fn = ScriptCompiler::CompileFunction(
       parsing_context,
       source,
@@ -1596,6 +1715,14 @@ MaybeLocal<Object> ContextifyFunction::CompileFunctionAndCacheResult(
     return {};
   }
 
+  if (cache_entry != nullptr) {
+    bool rejected = options == ScriptCompiler::kConsumeCodeCache &&
+                    source->GetCachedData()->rejected;
+    env->compile_cache_handler()->MaybeSave(cache_entry, fn, rejected);
+    // cachedDataRejected is only reported for cachedData passed by the user.
+    options = ScriptCompiler::kNoCompileOptions;
+  }
+
   std::unique_ptr<ScriptCompiler::CachedData> new_cached_data;
   if (produce_cached_data) {
     new_cached_data.reset(ScriptCompiler::CreateCodeCacheForFunction(fn));
@@ -10,6 +10,7 @@
 
 namespace node {
 class ExternalReferenceRegistry;
+struct CompileCacheEntry;
 
 namespace contextify {
 
@@ -142,6 +143,11 @@ class ContextifyContext final : CPPGC_MIXIN(ContextifyContext) {
                                 ContextOptions* options);
 
   static bool IsStillInitializing(const ContextifyContext* ctx);
+  static v8::MaybeLocal<v8::Context> TakePooledContext(
+      Environment* env, v8::MicrotaskQueue* queue);
+  static void FillContextPool(Environment* env);
+  static void SetContextPoolSize(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void MakeContext(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsContext(const v8::FunctionCallbackInfo<v8::Value>& args);
   static v8::Intercepted PropertyQueryCallback(
@@ -238,7 +244,8 @@ class ContextifyFunction final {
       v8::ScriptCompiler::CompileOptions options,
       bool produce_cached_data,
       v8::Local<v8::Symbol> id_symbol,
-      const errors::TryCatchScope& try_catch);
+      const errors::TryCatchScope& try_catch,
+      CompileCacheEntry* cache_entry = nullptr);
 
  private:
   ContextifyFunction() = delete;
@@ -39,6 +39,7 @@ namespace crypto {
 #define CRYPTO_NAMESPACE_LIST_BASE(V)                                          \
   V(AES)                                                                       \
   V(CipherBase)                                                                \
+  V(CryptoThreadPool)                                                          \
   V(DiffieHellman)                                                             \
   V(DSAAlg)                                                                    \
   V(ECDH)                                                                      \
@@ -48,10 +49,12 @@ namespace crypto {
   V(Keygen)                                                                    \
   V(Keys)                                                                      \
   V(NativeKeyObject)                                                           \
+  V(ParsedObjectCache)                                                         \
   V(PBKDF2Job)                                                                 \
   V(Random)                                                                    \
   V(RSAAlg)                                                                    \
   V(SecureContext)                                                             \
+  V(SessionCache)                                                              \
   V(Sign)                                                                      \
   V(SPKAC)                                                                     \
   V(Timing)                                                                    \
@@ -40,13 +40,16 @@
 #include "crypto/crypto_hmac.h"
 #include "crypto/crypto_keygen.h"
 #include "crypto/crypto_keys.h"
+#include "crypto/crypto_parse_cache.h"
 #include "crypto/crypto_pbkdf2.h"
 #include "crypto/crypto_random.h"
 #include "crypto/crypto_rsa.h"
 #include "crypto/crypto_scrypt.h"
+#include "crypto/crypto_session_cache.h"
 #include "crypto/crypto_sig.h"
 #include "crypto/crypto_spkac.h"
 #include "crypto/crypto_timing.h"
+#include "crypto/crypto_threadpool.h"
 #include "crypto/crypto_tls.h"
 #include "crypto/crypto_util.h"
 #include "crypto/crypto_x509.h"
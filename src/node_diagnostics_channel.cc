@@ -0,0 +1,141 @@
+#include "node_diagnostics_channel.h"
+#include "aliased_buffer-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+namespace node {
+namespace diagnostics_channel {
+
+using v8::Array;
+using v8::Context;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::Uint32;
+using v8::Undefined;
+using v8::Value;
+
+BindingData::BindingData(Realm* realm,
+                         Local<Object> obj,
+                         InternalFieldInfo* info)
+    : SnapshotableObject(realm, obj, type_int),
+      subscribers_buffer(realm->isolate(),
+                         kNativeChannelCount,
+                         MAYBE_FIELD_PTR(info, subscribers_buffer)) {
+  if (info == nullptr) {
+    obj->Set(realm->context(),
+             FIXED_ONE_BYTE_STRING(realm->isolate(), "subscribers"),
+             subscribers_buffer.GetJSArray())
+        .Check();
+  } else {
+    subscribers_buffer.Deserialize(realm->context());
+  }
+  subscribers_buffer.MakeWeak();
+}
+
+bool BindingData::PrepareForSerialization(Local<Context> context,
+                                          v8::SnapshotCreator* creator) {
+  DCHECK_NULL(internal_field_info_);
+  internal_field_info_ = InternalFieldInfoBase::New<InternalFieldInfo>(type());
+  internal_field_info_->subscribers_buffer =
+      subscribers_buffer.Serialize(context, creator);
+  // Return true because we need to maintain the reference to the binding from
+  // JS land.
+  return true;
+}
+
+void BindingData::Deserialize(Local<Context> context,
+                              Local<Object> holder,
+                              int index,
+                              InternalFieldInfoBase* info) {
+  DCHECK_IS_SNAPSHOT_SLOT(index);
+  HandleScope scope(context->GetIsolate());
+  Realm* realm = Realm::GetCurrent(context);
+  // Recreate the buffer in the constructor.
+  InternalFieldInfo* casted_info = static_cast<InternalFieldInfo*>(info);
+  BindingData* binding =
+      realm->AddBindingData<BindingData>(holder, casted_info);
+  CHECK_NOT_NULL(binding);
+}
+
+InternalFieldInfoBase* BindingData::Serialize(int index) {
+  DCHECK_IS_SNAPSHOT_SLOT(index);
+  InternalFieldInfo* info = internal_field_info_;
+  internal_field_info_ = nullptr;
+  return info;
+}
+
+void BindingData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("subscribers_buffer", subscribers_buffer);
+}
+
+void BindingData::SetPublishCallback(const FunctionCallbackInfo<Value>& args) {
+  Realm* realm = Realm::GetCurrent(args);
+  CHECK(args[0]->IsFunction());
+  realm->set_diagnostics_channel_publish_function(args[0].As<Function>());
+}
+
+bool HasSubscribers(Environment* env, NativeChannel channel) {
+  BindingData* binding = env->principal_realm()->GetBindingData<BindingData>();
+  // The channel cannot have subscribers before the binding is loaded.
+  if (binding == nullptr) return false;
+  return binding->subscribers_buffer[channel] != 0;
+}
+
+void Publish(Environment* env, NativeChannel channel, Local<Value> message) {
+  if (!HasSubscribers(env, channel)) return;
+  Realm* realm = env->principal_realm();
+  Local<Function> publish = realm->diagnostics_channel_publish_function();
+  if (publish.IsEmpty()) return;
+
+  Isolate* isolate = env->isolate();
+  Local<Value> argv[] = {Uint32::NewFromUnsigned(isolate, channel), message};
+  // Exceptions of the subscribers are reported by publish() itself.
+  USE(publish->Call(
+      realm->context(), Undefined(isolate), arraysize(argv), argv));
+}
+
+static void Initialize(Local<Object> target,
+                       Local<Value> unused,
+                       Local<Context> context,
+                       void* priv) {
+  Realm* realm = Realm::GetCurrent(context);
+  Isolate* isolate = realm->isolate();
+  BindingData* const binding_data = realm->AddBindingData<BindingData>(target);
+  if (binding_data == nullptr) return;
+
+  SetMethod(context,
+            target,
+            "setPublishCallback",
+            BindingData::SetPublishCallback);
+
+  Local<Value> channels[] = {
+#define V(_, name) FIXED_ONE_BYTE_STRING(isolate, name),
+      NATIVE_DIAGNOSTICS_CHANNELS(V)
+#undef V
+  };
+  target
+      ->Set(context,
+            FIXED_ONE_BYTE_STRING(isolate, "channels"),
+            Array::New(isolate, channels, arraysize(channels)))
+      .Check();
+}
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(BindingData::SetPublishCallback);
+}
+
+}  // namespace diagnostics_channel
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(diagnostics_channel,
+                                    node::diagnostics_channel::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(
+    diagnostics_channel, node::diagnostics_channel::RegisterExternalReferences)
@@ -0,0 +1,76 @@
+#ifndef SRC_NODE_DIAGNOSTICS_CHANNEL_H_
+#define SRC_NODE_DIAGNOSTICS_CHANNEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include "aliased_buffer.h"
+#include "node_snapshotable.h"
+#include "v8.h"
+
+namespace node {
+class Environment;
+class ExternalReferenceRegistry;
+
+namespace diagnostics_channel {
+
+// The diagnostics_channel channels that native code publishes to. Their
+// JavaScript side flags in an AliasedUint32Array whether they have
+// subscribers, so that native code can check that before it builds a
+// message.
+#define NATIVE_DIAGNOSTICS_CHANNELS(V)                                         \
+  V(kNetNativeConnect, "net.native.connect")                                   \
+  V(kHttpNativeParserError, "http.native.parser.error")                        \
+  V(kHttp2NativeFrameInvalid, "http2.native.frame.invalid")
+
+enum NativeChannel : uint32_t {
+#define V(id, _) id,
+  NATIVE_DIAGNOSTICS_CHANNELS(V)
+#undef V
+  kNativeChannelCount
+};
+
+class BindingData : public SnapshotableObject {
+ public:
+  struct InternalFieldInfo : public node::InternalFieldInfoBase {
+    AliasedBufferIndex subscribers_buffer;
+  };
+  BindingData(Realm* realm,
+              v8::Local<v8::Object> obj,
+              InternalFieldInfo* info = nullptr);
+
+  SERIALIZABLE_OBJECT_METHODS()
+  SET_BINDING_ID(diagnostics_channel_binding_data)
+
+  static void SetPublishCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Indexed by NativeChannel. Non-zero if the channel has subscribers.
+  AliasedUint32Array subscribers_buffer;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  InternalFieldInfo* internal_field_info_ = nullptr;
+};
+
+// Returns true if the channel has subscribers in the principal realm of
+// |env|. Native code should check this before it builds a message.
+bool HasSubscribers(Environment* env, NativeChannel channel);
+
+// Publishes |message| to the channel in the principal realm of |env|. Must be
+// called with a HandleScope and the context of |env| entered.
+void Publish(Environment* env,
+             NativeChannel channel,
+             v8::Local<v8::Value> message);
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+}  // namespace diagnostics_channel
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_DIAGNOSTICS_CHANNEL_H_
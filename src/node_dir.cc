@@ -1,5 +1,6 @@
 #include "node_dir.h"
 #include "memory_tracker-inl.h"
+#include "node_buffer.h"
 #include "node_external_reference.h"
 #include "node_file-inl.h"
 #include "node_process-inl.h"
@@ -30,6 +31,7 @@ using fs::FSReqWrapSync;
 using fs::GetReqWrap;
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -43,6 +45,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::TryCatch;
+using v8::Uint8Array;
 using v8::Value;
 
 static const char* get_dir_func_name_by_type(uv_fs_type req_type) {
@@ -230,7 +233,44 @@ static MaybeLocal<Array> DirentListToArray(Environment* env,
   return Array::New(env->isolate(), entries.out(), j);
 }
 
-static void AfterDirRead(uv_fs_t* req) {
+// Returns [names, types], where `names` is a Buffer holding the name of
+// every entry followed by a NUL byte and `types` is a Uint8Array holding
+// their types. This avoids creating one string per entry here and lets JS
+// decode all names at once.
+static MaybeLocal<Array> DirentListToPackedArray(Environment* env,
+                                                 uv_dirent_t* ents,
+                                                 int num) {
+  Isolate* isolate = env->isolate();
+  size_t total = 0;
+  for (int i = 0; i < num; i++) total += strlen(ents[i].name) + 1;
+
+  Local<Object> names;
+  if (!Buffer::New(isolate, total).ToLocal(&names)) return {};
+  char* data = Buffer::Data(names);
+
+  Local<ArrayBuffer> types_buffer = ArrayBuffer::New(isolate, num);
+  uint8_t* types = static_cast<uint8_t*>(types_buffer->Data());
+  for (int i = 0; i < num; i++) {
+    const size_t size = strlen(ents[i].name) + 1;
+    memcpy(data, ents[i].name, size);
+    data += size;
+    types[i] = static_cast<uint8_t>(ents[i].type);
+  }
+
+  Local<Value> result[] = {names, Uint8Array::New(types_buffer, 0, num)};
+  return Array::New(isolate, result, arraysize(result));
+}
+
+static MaybeLocal<Array> DirentListToResult(Environment* env,
+                                            uv_dirent_t* ents,
+                                            int num,
+                                            enum encoding encoding,
+                                            bool packed) {
+  if (packed) return DirentListToPackedArray(env, ents, num);
+  return DirentListToArray(env, ents, num, encoding);
+}
+
+static void AfterDirRead(uv_fs_t* req, bool packed) {
   BaseObjectPtr<FSReqBase> req_wrap { FSReqBase::from_req(req) };
   FSReqAfterScope after(req_wrap.get(), req);
   FS_DIR_ASYNC_TRACE_END1(
@@ -254,10 +294,11 @@ static void AfterDirRead(uv_fs_t* req) {
 
   TryCatch try_catch(isolate);
   Local<Array> js_array;
-  if (!DirentListToArray(env,
-                         dir->dirents,
-                         static_cast<int>(req->result),
-                         req_wrap->encoding())
+  if (!DirentListToResult(env,
+                          dir->dirents,
+                          static_cast<int>(req->result),
+                          req_wrap->encoding(),
+                          packed)
            .ToLocal(&js_array)) {
     // Clear libuv resources *before* delivering results to JS land because
     // that can schedule another operation on the same uv_dir_t. Ditto below.
@@ -270,12 +311,20 @@ static void AfterDirRead(uv_fs_t* req) {
   req_wrap->Resolve(js_array);
 }
 
+static void AfterDirRead(uv_fs_t* req) {
+  AfterDirRead(req, false);
+}
+
+static void AfterDirReadPacked(uv_fs_t* req) {
+  AfterDirRead(req, true);
+}
+
 
 void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
 
-  CHECK_GE(args.Length(), 2);  // encoding, bufferSize, [callback]
+  CHECK_GE(args.Length(), 2);  // encoding, bufferSize, [callback], [packed]
 
   const enum encoding encoding = ParseEncoding(isolate, args[0], UTF8);
 
@@ -291,12 +340,17 @@ void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
     dir->dir_->dirents = dir->dirents_.data();
   }
 
+  // When `packed` is true, the entries are returned in the format of
+  // DirentListToPackedArray() and `encoding` is left to the caller.
+  const bool packed = args[3]->IsTrue();
+
   if (!args[2]->IsUndefined()) {  // dir.read(encoding, bufferSize, req)
     FSReqBase* req_wrap_async = GetReqWrap(args, 2);
     CHECK_NOT_NULL(req_wrap_async);
     FS_DIR_ASYNC_TRACE_BEGIN0(UV_FS_READDIR, req_wrap_async)
     AsyncCall(env, req_wrap_async, args, "readdir", encoding,
-              AfterDirRead, uv_fs_readdir, dir->dir());
+              packed ? AfterDirReadPacked : AfterDirRead,
+              uv_fs_readdir, dir->dir());
   } else {  // dir.read(encoding, bufferSize)
     FSReqWrapSync req_wrap_sync("readdir");
     FS_DIR_SYNC_TRACE_BEGIN(readdir);
@@ -316,10 +370,11 @@ void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
 
     TryCatch try_catch(isolate);
     Local<Array> js_array;
-    if (!DirentListToArray(env,
-                           dir->dir()->dirents,
-                           static_cast<int>(req_wrap_sync.req.result),
-                           encoding)
+    if (!DirentListToResult(env,
+                            dir->dir()->dirents,
+                            static_cast<int>(req_wrap_sync.req.result),
+                            encoding,
+                            packed)
              .ToLocal(&js_array)) {
       // TODO(anonrig): Initializing BufferValue here is wasteful.
       CHECK(try_catch.CanContinue());
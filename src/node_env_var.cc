@@ -4,9 +4,12 @@
 #include "node_external_reference.h"
 #include "node_i18n.h"
 #include "node_process-inl.h"
+#include "node_threadsafe_cow-inl.h"
 
 #include <time.h>  // tzset(), _tzset()
+#include <atomic>
 #include <optional>
+#include <string_view>
 
 namespace node {
 using v8::Array;
@@ -26,6 +29,7 @@ using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Name;
 using v8::NamedPropertyHandlerConfiguration;
+using v8::NewStringType;
 using v8::Nothing;
 using v8::Object;
 using v8::ObjectTemplate;
@@ -45,6 +49,32 @@ class RealEnvStore final : public KVStore {
   int32_t Query(const char* key) const override;
   void Delete(Isolate* isolate, Local<String> key) override;
   MaybeLocal<Array> Enumerate(Isolate* isolate) const override;
+
+ private:
+#ifdef __POSIX__
+  struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const {
+      return std::hash<std::string_view>()(str);
+    }
+  };
+  using EnvMap = std::unordered_map<std::string,
+                                    std::string,
+                                    StringViewHash,
+                                    std::equal_to<>>;
+
+  // Reads of process.env are far more common than writes, so on POSIX they
+  // are served from a snapshot of the environment instead of going through
+  // uv_os_getenv() with env_var_mutex held. The snapshot is taken on first
+  // use and updated by Set() and Delete(); changes made to the environment
+  // behind Node.js' back, e.g. by setenv() calls in addons, are not seen.
+  // Windows keeps reading the real environment because variable names are
+  // case-insensitive there.
+  void EnsureSnapshot() const;
+
+  mutable std::atomic<bool> has_snapshot_{false};
+  mutable ThreadsafeCopyOnWrite<EnvMap> snapshot_;
+#endif  // __POSIX__
 };
 
 class MapKVStore final : public KVStore {
@@ -102,7 +132,36 @@ void DateTimeConfigurationChangeNotification(
   }
 }
 
+#ifdef __POSIX__
+void RealEnvStore::EnsureSnapshot() const {
+  if (has_snapshot_.load(std::memory_order_acquire)) return;
+
+  Mutex::ScopedLock lock(per_process::env_var_mutex);
+  if (has_snapshot_.load(std::memory_order_relaxed)) return;
+
+  uv_env_item_t* items;
+  int count;
+  CHECK_EQ(uv_os_environ(&items, &count), 0);
+  auto cleanup = OnScopeLeave([&]() { uv_os_free_environ(items, count); });
+
+  auto snapshot = snapshot_.write();
+  snapshot->clear();
+  snapshot->reserve(count);
+  for (int i = 0; i < count; i++) {
+    snapshot->emplace(items[i].name, items[i].value);
+  }
+  has_snapshot_.store(true, std::memory_order_release);
+}
+#endif  // __POSIX__
+
 std::optional<std::string> RealEnvStore::Get(const char* key) const {
+#ifdef __POSIX__
+  EnsureSnapshot();
+  auto snapshot = snapshot_.read();
+  auto it = snapshot->find(std::string_view(key));
+  if (it == snapshot->end()) return std::nullopt;
+  return it->second;
+#else
   Mutex::ScopedLock lock(per_process::env_var_mutex);
 
   size_t init_sz = 256;
@@ -121,11 +180,25 @@ std::optional<std::string> RealEnvStore::Get(const char* key) const {
   }
 
   return std::nullopt;
+#endif  // __POSIX__
 }
 
 MaybeLocal<String> RealEnvStore::Get(Isolate* isolate,
                                      Local<String> property) const {
   node::Utf8Value key(isolate, property);
+#ifdef __POSIX__
+  // Look the value up without copying it out of the snapshot, and return an
+  // internalized string so that repeated reads of the same variable do not
+  // allocate a new string each time.
+  EnsureSnapshot();
+  auto snapshot = snapshot_.read();
+  auto it = snapshot->find(std::string_view(*key));
+  if (it == snapshot->end()) return MaybeLocal<String>();
+  return String::NewFromUtf8(isolate,
+                             it->second.data(),
+                             NewStringType::kInternalized,
+                             it->second.size());
+#else
   std::optional<std::string> value = Get(*key);
 
   if (value.has_value()) {
@@ -139,6 +212,7 @@ MaybeLocal<String> RealEnvStore::Get(Isolate* isolate,
   }
 
   return MaybeLocal<String>();
+#endif  // __POSIX__
 }
 
 void RealEnvStore::Set(Isolate* isolate,
@@ -152,11 +226,23 @@ void RealEnvStore::Set(Isolate* isolate,
 #ifdef _WIN32
   if (key.length() > 0 && key[0] == '=') return;
 #endif
-  uv_os_setenv(*key, *val);
+  int err = uv_os_setenv(*key, *val);
+#ifdef __POSIX__
+  if (err == 0 && has_snapshot_.load(std::memory_order_relaxed)) {
+    snapshot_.write()->insert_or_assign(std::string(*key), *val);
+  }
+#else
+  USE(err);
+#endif
   DateTimeConfigurationChangeNotification(isolate, key, *val);
 }
 
 int32_t RealEnvStore::Query(const char* key) const {
+#ifdef __POSIX__
+  EnsureSnapshot();
+  auto snapshot = snapshot_.read();
+  return snapshot->find(std::string_view(key)) == snapshot->end() ? -1 : 0;
+#else
   Mutex::ScopedLock lock(per_process::env_var_mutex);
 
   char val[2];
@@ -176,6 +262,7 @@ int32_t RealEnvStore::Query(const char* key) const {
 #endif
 
   return 0;
+#endif  // __POSIX__
 }
 
 int32_t RealEnvStore::Query(Isolate* isolate, Local<String> property) const {
@@ -187,7 +274,14 @@ void RealEnvStore::Delete(Isolate* isolate, Local<String> property) {
   Mutex::ScopedLock lock(per_process::env_var_mutex);
 
   node::Utf8Value key(isolate, property);
-  uv_os_unsetenv(*key);
+  int err = uv_os_unsetenv(*key);
+#ifdef __POSIX__
+  if (err == 0 && has_snapshot_.load(std::memory_order_relaxed)) {
+    snapshot_.write()->erase(std::string(*key));
+  }
+#else
+  USE(err);
+#endif
   DateTimeConfigurationChangeNotification(isolate, key);
 }
 
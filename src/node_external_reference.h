@@ -93,6 +93,11 @@ using CFunctionBufferCopy = uint32_t (*)(v8::Local<v8::Value>,
                                          uint32_t,
                                          uint32_t,
                                          v8::FastApiCallbackOptions&);
+using CFunctionRandomFill = bool (*)(v8::Local<v8::Value>,
+                                     v8::Local<v8::Value>,
+                                     uint32_t,
+                                     uint32_t,
+                                     v8::FastApiCallbackOptions&);
 
 // This class manages the external references from the V8 heap
 // to the C++ addresses in Node.js.
@@ -123,6 +128,7 @@ class ExternalReferenceRegistry {
   V(CFunctionWithInt64Fallback)                                                \
   V(CFunctionWithBool)                                                         \
   V(CFunctionBufferCopy)                                                       \
+  V(CFunctionRandomFill)                                                       \
   V(CFunctionWriteString)                                                      \
   V(const v8::CFunctionInfo*)                                                  \
   V(v8::FunctionCallback)                                                      \
@@ -170,6 +176,7 @@ class ExternalReferenceRegistry {
   V(config)                                                                    \
   V(contextify)                                                                \
   V(credentials)                                                               \
+  V(diagnostics_channel)                                                       \
   V(encoding_binding)                                                          \
   V(env_var)                                                                   \
   V(errors)                                                                    \
@@ -179,6 +186,7 @@ class ExternalReferenceRegistry {
   V(handle_wrap)                                                               \
   V(heap_utils)                                                                \
   V(http_parser)                                                               \
+  V(http_serializer)                                                           \
   V(internal_only_v8)                                                          \
   V(messaging)                                                                 \
   V(mksnapshot)                                                                \
@@ -186,6 +194,7 @@ class ExternalReferenceRegistry {
   V(modules)                                                                   \
   V(options)                                                                   \
   V(os)                                                                        \
+  V(path)                                                                      \
   V(performance)                                                               \
   V(permission)                                                                \
   V(process_methods)                                                           \
@@ -206,6 +215,7 @@ class ExternalReferenceRegistry {
   V(stream_wrap)                                                               \
   V(signal_wrap)                                                               \
   V(spawn_sync)                                                                \
+  V(stdio_writer)                                                              \
   V(trace_events)                                                              \
   V(timers)                                                                    \
   V(types)                                                                     \
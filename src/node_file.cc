@@ -33,6 +33,7 @@
 #include "node_url.h"
 #include "path.h"
 #include "permission/permission.h"
+#include "simdutf.h"
 #include "util-inl.h"
 
 #include "tracing/trace_event.h"
@@ -40,13 +41,17 @@
 #include "req_wrap-inl.h"
 #include "stream_base-inl.h"
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 #include "uv.h"
 #include "v8-fast-api-calls.h"
 
 #include <errno.h>
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
 
 #if defined(__MINGW32__) || defined(_MSC_VER)
 # include <io.h>
@@ -55,14 +60,23 @@
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
+#if defined(__POSIX__) && !defined(__wasi__)
+#include <sys/mman.h>
+#endif
+
 namespace node {
 
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::BigInt;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -83,6 +97,7 @@ using v8::Object;
 using v8::ObjectTemplate;
 using v8::Promise;
 using v8::String;
+using v8::True;
 using v8::TryCatch;
 using v8::Undefined;
 using v8::Value;
@@ -291,8 +306,13 @@ int FileHandle::DoWrite(WriteWrap* w,
   return UV_ENOSYS;  // Not implemented (yet).
 }
 
+constexpr size_t kReadAheadDepth = 4;
+constexpr size_t kReadChunkSize = 65536;
+
 void FileHandle::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackField("current_read", current_read_);
+  tracker->TrackField("pending_reads", pending_reads_);
+  tracker->TrackFieldWithSize("read_buffer_pool",
+                              read_buffer_pool_.size() * kReadChunkSize);
 }
 
 BaseObject::TransferMode FileHandle::GetTransferMode() const {
@@ -542,22 +562,41 @@ FileHandleReadWrap::FileHandleReadWrap(FileHandle* handle, Local<Object> obj)
   : ReqWrap(handle->env(), obj, AsyncWrap::PROVIDER_FSREQCALLBACK),
     file_handle_(handle) {}
 
+// Reads at a known offset don't depend on each other, so up to
+// kReadAheadDepth of them are kept in flight. They read into chunks that are
+// recycled through a small per-FileHandle pool rather than into buffers
+// provided by the listener, since listeners such as CustomBufferJSListener
+// hand out the same buffer for every read. The results are copied out and
+// emitted in order whenever the listener is reading, so completions that
+// arrive after ReadStop() are kept until the next ReadStart().
+// Reads from the current file position are issued one at a time, directly
+// into buffers provided by the listener.
 int FileHandle::ReadStart() {
   if (!IsAlive() || IsClosing())
     return UV_EOF;
 
   reading_ = true;
 
-  if (current_read_)
-    return 0;
-
-  BaseObjectPtr<FileHandleReadWrap> read_wrap;
+  EmitCompletedReads();
 
-  if (read_length_ == 0) {
-    EmitRead(UV_EOF);
-    return 0;
+  const bool read_ahead = read_offset_ >= 0;
+  const size_t depth = read_ahead ? kReadAheadDepth : 1;
+  while (reading_ && IsAlive() && !IsClosing() &&
+         pending_reads_.size() < depth) {
+    if (read_length_ == 0) {
+      if (pending_reads_.empty()) EmitRead(UV_EOF);
+      break;
+    }
+    int err = DispatchRead(read_ahead);
+    if (err != 0) return pending_reads_.empty() ? err : 0;
   }
 
+  return 0;
+}
+
+int FileHandle::DispatchRead(bool pooled) {
+  BaseObjectPtr<FileHandleReadWrap> read_wrap;
+
   {
     // Create a new FileHandleReadWrap or re-use one.
     // Either way, we need these two scopes for AsyncReset() or otherwise
@@ -587,62 +626,105 @@ int FileHandle::ReadStart() {
       read_wrap = MakeDetachedBaseObject<FileHandleReadWrap>(this, wrap_obj);
     }
   }
-  int64_t recommended_read = 65536;
+  int64_t recommended_read = kReadChunkSize;
   if (read_length_ >= 0 && read_length_ <= recommended_read)
     recommended_read = read_length_;
 
-  read_wrap->buffer_ = EmitAlloc(recommended_read);
-
-  current_read_ = std::move(read_wrap);
-  FS_ASYNC_TRACE_BEGIN0(UV_FS_READ, current_read_.get())
-  current_read_->Dispatch(uv_fs_read,
-                          fd_,
-                          &current_read_->buffer_,
-                          1,
-                          read_offset_,
-                          uv_fs_callback_t{[](uv_fs_t* req) {
-    FileHandle* handle;
-    {
-      FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
-      FS_ASYNC_TRACE_END1(
-          req->fs_type, req_wrap, "result", static_cast<int>(req->result))
-      handle = req_wrap->file_handle_;
-      CHECK_EQ(handle->current_read_.get(), req_wrap);
-    }
-
-    // ReadStart() checks whether current_read_ is set to determine whether
-    // a read is in progress. Moving it into a local variable makes sure that
-    // the ReadStart() call below doesn't think we're still actively reading.
+  if (pooled) {
+    if (read_buffer_pool_.empty()) {
+      read_wrap->chunk_.reset(new char[kReadChunkSize]);
+    } else {
+      read_wrap->chunk_ = std::move(read_buffer_pool_.back());
+      read_buffer_pool_.pop_back();
+    }
+    read_wrap->buffer_ = uv_buf_init(read_wrap->chunk_.get(),
+                                     static_cast<unsigned int>(recommended_read));
+  } else {
+    read_wrap->buffer_ = EmitAlloc(recommended_read);
+  }
+  read_wrap->done_ = false;
+  read_wrap->result_ = 0;
+  read_wrap->generation_ = read_generation_;
+  read_wrap->offset_ = read_offset_;
+  read_wrap->length_ = read_length_;
+
+  // Account for the read right away so that the next one continues after it.
+  if (read_offset_ >= 0)
+    read_offset_ += recommended_read;
+  if (read_length_ >= 0)
+    read_length_ -= recommended_read;
+
+  FileHandleReadWrap* req_wrap = read_wrap.get();
+  pending_reads_.emplace_back(std::move(read_wrap));
+  FS_ASYNC_TRACE_BEGIN0(UV_FS_READ, req_wrap)
+  req_wrap->Dispatch(uv_fs_read,
+                     fd_,
+                     &req_wrap->buffer_,
+                     1,
+                     req_wrap->offset_,
+                     uv_fs_callback_t{[](uv_fs_t* req) {
+    FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
+    FS_ASYNC_TRACE_END1(
+        req->fs_type, req_wrap, "result", static_cast<int>(req->result))
+    FileHandle* handle = req_wrap->file_handle_;
+
+    req_wrap->result_ = req->result;
+    req_wrap->done_ = true;
+    uv_fs_req_cleanup(req);
+
+    handle->EmitCompletedReads();
+
+    // Start over, if EmitRead() didn’t tell us to stop.
+    if (handle->reading_)
+      handle->ReadStart();
+  }});
+
+  return 0;
+}
+
+void FileHandle::EmitCompletedReads() {
+  while (!pending_reads_.empty() && pending_reads_.front()->done_) {
+    const bool stale =
+        pending_reads_.front()->generation_ != read_generation_;
+    if (!reading_ && !stale) break;
+
+    // Moving the read wrap out of pending_reads_ makes sure that re-entrant
+    // ReadStart() calls from EmitRead() see the next read at the front.
     BaseObjectPtr<FileHandleReadWrap> read_wrap =
-        std::move(handle->current_read_);
+        std::move(pending_reads_.front());
+    pending_reads_.pop_front();
 
-    ssize_t result = req->result;
+    ssize_t result = read_wrap->result_;
     uv_buf_t buffer = read_wrap->buffer_;
-
-    uv_fs_req_cleanup(req);
+    std::unique_ptr<char[]> chunk = std::move(read_wrap->chunk_);
+    const int64_t offset = read_wrap->offset_;
+    const int64_t length = read_wrap->length_;
 
     // Push the read wrap back to the freelist, or let it be destroyed
     // once we’re exiting the current scope.
     constexpr size_t kWantedFreelistFill = 100;
-    auto& freelist = handle->binding_data_->file_handle_read_wrap_freelist;
+    auto& freelist = binding_data_->file_handle_read_wrap_freelist;
     if (freelist.size() < kWantedFreelistFill) {
       read_wrap->Reset();
       freelist.emplace_back(std::move(read_wrap));
     }
 
-    if (result >= 0) {
-      // Read at most as many bytes as we originally planned to.
-      if (handle->read_length_ >= 0 && handle->read_length_ < result)
-        result = handle->read_length_;
-
-      // If we read data and we have an expected length, decrease it by
-      // how much we have read.
-      if (handle->read_length_ >= 0)
-        handle->read_length_ -= result;
+    if (stale) {
+      // Read ahead of a short read, EOF or error; the data is not needed.
+      // Only pooled reads can be in flight behind another read.
+      CHECK(chunk);
+      read_buffer_pool_.emplace_back(std::move(chunk));
+      continue;
+    }
 
-      // If we have an offset, increase it by how much we have read.
-      if (handle->read_offset_ >= 0)
-        handle->read_offset_ += result;
+    if (result < 0 || static_cast<size_t>(result) < buffer.len) {
+      // Continue right after what was actually read, and drop the reads that
+      // were issued further ahead.
+      read_generation_++;
+      if (offset >= 0)
+        read_offset_ = offset + std::max<ssize_t>(result, 0);
+      if (length >= 0)
+        read_length_ = length - std::max<ssize_t>(result, 0);
     }
 
     // Reading 0 bytes from a file always means EOF, or that we reached
@@ -650,14 +732,30 @@ int FileHandle::ReadStart() {
     if (result == 0)
       result = UV_EOF;
 
-    handle->EmitRead(result, buffer);
-
-    // Start over, if EmitRead() didn’t tell us to stop.
-    if (handle->reading_)
-      handle->ReadStart();
-  }});
-
-  return 0;
+    if (!chunk) {
+      EmitRead(result, buffer);
+      continue;
+    }
+    if (result <= 0) {
+      read_buffer_pool_.emplace_back(std::move(chunk));
+      EmitRead(result);
+      continue;
+    }
+    // Hand the chunk over if the listener can use it as it is, and replace
+    // it in the pool on the next read.
+    if (EmitReadOwned(&chunk, result))
+      continue;
+    // The listener may return smaller buffers than asked for.
+    for (ssize_t copied = 0; copied < result;) {
+      buffer = EmitAlloc(result - copied);
+      const size_t length =
+          std::min<size_t>(buffer.len, static_cast<size_t>(result - copied));
+      memcpy(buffer.base, chunk.get() + copied, length);
+      copied += length;
+      EmitRead(length, buffer);
+    }
+    read_buffer_pool_.emplace_back(std::move(chunk));
+  }
 }
 
 int FileHandle::ReadStop() {
@@ -1049,20 +1147,113 @@ static void ExistsSync(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(err == 0);
 }
 
+namespace {
+
+// Process-wide cache of the stat() lookups made during module resolution,
+// enabled with --experimental-module-stat-cache. It is shared by all worker
+// threads and records missing paths as well as files and directories. Every
+// module.clearStatCache() call and every event reported by an fs.watch()
+// watcher starts a new generation, which drops all entries.
+class ModuleStatCache {
+ public:
+  static bool IsEnabled() {
+    return per_process::cli_options->experimental_module_stat_cache;
+  }
+
+  // Returns true and sets `result` on a hit, or returns false and sets
+  // `generation` so that the result of the lookup can be inserted later.
+  bool Lookup(const std::string& path, int* result, uint64_t* generation) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+      misses_++;
+      *generation = generation_;
+      return false;
+    }
+    hits_++;
+    *result = it->second;
+    return true;
+  }
+
+  // Results of lookups that raced with a clear are not inserted.
+  void Insert(const std::string& path, int result, uint64_t generation) {
+    Mutex::ScopedLock lock(mutex_);
+    if (generation == generation_) entries_.emplace(path, result);
+  }
+
+  void Clear() {
+    Mutex::ScopedLock lock(mutex_);
+    generation_++;
+    entries_.clear();
+  }
+
+  void GetStats(double* hits, double* misses, double* size) {
+    Mutex::ScopedLock lock(mutex_);
+    *hits = static_cast<double>(hits_);
+    *misses = static_cast<double>(misses_);
+    *size = static_cast<double>(entries_.size());
+  }
+
+ private:
+  Mutex mutex_;
+  std::unordered_map<std::string, int> entries_;
+  uint64_t generation_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+ModuleStatCache module_stat_cache;
+
+// Returns 0 if the path refers to a file, 1 when it's a directory or < 0 on
+// error, going through the module stat cache when it is enabled.
+int ModuleStat(Environment* env, const char* path) {
+  uint64_t generation = 0;
+  const bool use_cache = ModuleStatCache::IsEnabled();
+  int rc;
+  if (use_cache && module_stat_cache.Lookup(path, &rc, &generation)) {
+    return rc;
+  }
+
+  uv_fs_t req;
+  rc = uv_fs_stat(env->event_loop(), &req, path, nullptr);
+  if (rc == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    rc = S_ISDIR(s->st_mode);
+  }
+  uv_fs_req_cleanup(&req);
+
+  if (use_cache) module_stat_cache.Insert(path, rc, generation);
+  return rc;
+}
+
+}  // namespace
+
+void InvalidateModuleStatCache() {
+  if (ModuleStatCache::IsEnabled()) module_stat_cache.Clear();
+}
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
 // Do not expose this function through public API as it doesn't hold
 // Permission Model checks.
+//
+// Module resolution passes `true` as the second argument, to go through
+// the module stat cache when it is enabled; other internal callers need
+// fresh results.
 static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
-  CHECK_EQ(args.Length(), 1);
+  CHECK_GE(args.Length(), 1);
   CHECK(args[0]->IsString());
   BufferValue path(env->isolate(), args[0]);
   CHECK_NOT_NULL(*path);
   ToNamespacedPath(env, &path);
 
+  if (args.Length() > 1 && args[1]->IsTrue()) {
+    return args.GetReturnValue().Set(ModuleStat(env, *path));
+  }
+
   uv_fs_t req;
   int rc = uv_fs_stat(env->event_loop(), &req, *path, nullptr);
   if (rc == 0) {
@@ -1074,6 +1265,21 @@ static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(rc);
 }
 
+// Returns [hits, misses, size] of the module stat cache.
+static void GetModuleStatCacheStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  double hits, misses, size;
+  module_stat_cache.GetStats(&hits, &misses, &size);
+  Local<Value> result[] = {Number::New(isolate, hits),
+                           Number::New(isolate, misses),
+                           Number::New(isolate, size)};
+  args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
+}
+
+static void ClearModuleStatCache(const FunctionCallbackInfo<Value>& args) {
+  InvalidateModuleStatCache();
+}
+
 constexpr bool is_uv_error_except_no_entry(int result) {
   return result < 0 && result != UV_ENOENT;
 }
@@ -1264,6 +1470,393 @@ static void StatFs(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Stats every path of a batch in one go. The results are laid out back to back
+// in a single stats array (kFsStatsFieldsNumber entries per path, same layout
+// as FillGlobalStatsArray()) together with an Int32Array that holds 0 or the
+// negative libuv error code for each path, so that missing files do not need
+// an exception or an Error object each.
+void StatPaths(const std::vector<std::string>& paths,
+               std::vector<uv_stat_t>* stats,
+               std::vector<int>* errors) {
+  stats->resize(paths.size());
+  errors->resize(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    uv_fs_t req;
+    int err = uv_fs_stat(nullptr, &req, paths[i].c_str(), nullptr);
+    if (err == 0) {
+      (*stats)[i] = req.statbuf;
+    }
+    (*errors)[i] = err;
+    uv_fs_req_cleanup(&req);
+  }
+}
+
+static Local<Value> CreateStatManyResult(Isolate* isolate,
+                                         bool use_bigint,
+                                         const std::vector<uv_stat_t>& stats,
+                                         const std::vector<int>& errors) {
+  constexpr size_t kFields =
+      static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+  const size_t count = errors.size();
+  AliasedInt32Array error_array(isolate, count);
+  Local<Value> stats_array;
+  if (use_bigint) {
+    AliasedBigInt64Array arr(isolate, count * kFields);
+    for (size_t i = 0; i < count; i++) {
+      if (errors[i] == 0) FillStatsArray(&arr, &stats[i], i * kFields);
+    }
+    stats_array = arr.GetJSArray();
+  } else {
+    AliasedFloat64Array arr(isolate, count * kFields);
+    for (size_t i = 0; i < count; i++) {
+      if (errors[i] == 0) FillStatsArray(&arr, &stats[i], i * kFields);
+    }
+    stats_array = arr.GetJSArray();
+  }
+  for (size_t i = 0; i < count; i++) error_array.SetValue(i, errors[i]);
+  Local<Value> result[] = {stats_array, error_array.GetJSArray()};
+  return Array::New(isolate, result, arraysize(result));
+}
+
+class StatManyWork final : public ThreadPoolWork {
+ public:
+  StatManyWork(Environment* env,
+               FSReqBase* req_wrap,
+               std::vector<std::string>&& paths)
+      : ThreadPoolWork(env, "statMany", ThreadPoolWorkClass::kFileSystem),
+        req_wrap_(req_wrap),
+        paths_(std::move(paths)) {}
+
+  void DoThreadPoolWork() override {
+    StatPaths(paths_, &stats_, &errors_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StatManyWork> self(this);
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+    if (!env()->can_call_into_js()) return;
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+    if (status != 0) {
+      return req_wrap->Reject(
+          UVException(isolate, status, req_wrap->syscall()));
+    }
+    req_wrap->Resolve(CreateStatManyResult(
+        isolate, req_wrap->use_bigint(), stats_, errors_));
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::vector<std::string> paths_;
+  std::vector<uv_stat_t> stats_;
+  std::vector<int> errors_;
+};
+
+static void StatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+  CHECK(args[0]->IsArray());
+
+  Local<Array> js_paths = args[0].As<Array>();
+  bool use_bigint = args[1]->IsTrue();
+  FSReqBase* req_wrap_async = nullptr;
+  if (!args[2]->IsUndefined()) {
+    req_wrap_async = GetReqWrap(args, 2, use_bigint);
+    CHECK_NOT_NULL(req_wrap_async);
+    req_wrap_async->SetReturnValue(args);
+  }
+
+  std::vector<std::string> paths;
+  paths.reserve(js_paths->Length());
+  for (uint32_t i = 0; i < js_paths->Length(); i++) {
+    Local<Value> value;
+    if (!js_paths->Get(env->context(), i).ToLocal(&value)) return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    ToNamespacedPath(env, &path);
+    if (req_wrap_async != nullptr) {
+      ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
+          env,
+          req_wrap_async,
+          permission::PermissionScope::kFileSystemRead,
+          path.ToStringView());
+    } else {
+      THROW_IF_INSUFFICIENT_PERMISSIONS(
+          env,
+          permission::PermissionScope::kFileSystemRead,
+          path.ToStringView());
+    }
+    paths.emplace_back(path.ToString());
+  }
+
+  if (req_wrap_async != nullptr) {  // statMany(paths, use_bigint, req)
+    req_wrap_async->Init("statMany", nullptr, 0, UTF8);
+    auto* work = new StatManyWork(env, req_wrap_async, std::move(paths));
+    work->ScheduleWork();
+    return;
+  }
+
+  // statMany(paths, use_bigint, undefined)
+  std::vector<uv_stat_t> stats;
+  std::vector<int> errors;
+  FS_SYNC_TRACE_BEGIN(statMany);
+  StatPaths(paths, &stats, &errors);
+  FS_SYNC_TRACE_END(statMany);
+  args.GetReturnValue().Set(
+      CreateStatManyResult(isolate, use_bigint, stats, errors));
+}
+
+// Reads the whole contents of every file of a batch in one go. As with
+// statMany(), a file that cannot be read does not fail the batch. Its error
+// code and the operation that failed are recorded instead.
+struct ReadManyEntry {
+  // Allocated with malloc(), and owned by the entry until it is passed to a
+  // Buffer.
+  char* data = nullptr;
+  size_t length = 0;
+  int error = 0;
+  const char* syscall = nullptr;
+};
+
+static void ReadPath(const std::string& path, int flags, ReadManyEntry* entry) {
+  uv_fs_t req;
+  uv_file file = uv_fs_open(nullptr, &req, path.c_str(), flags, 0666, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (file < 0) {
+    entry->error = file;
+    entry->syscall = "open";
+    return;
+  }
+
+  int err = uv_fs_fstat(nullptr, &req, file, nullptr);
+  // The size of files that aren't regular files, e.g. in /proc, isn't known
+  // up front, so they are read in chunks until the end.
+  const size_t size = err == 0 && S_ISREG(req.statbuf.st_mode)
+                          ? static_cast<size_t>(req.statbuf.st_size)
+                          : 0;
+  uv_fs_req_cleanup(&req);
+  if (err != 0) {
+    entry->syscall = "fstat";
+  } else if (size > Buffer::kMaxLength) {
+    err = UV_EFBIG;
+    entry->syscall = "read";
+  }
+
+  size_t capacity = size > 0 ? size : 64 * 1024;
+  char* data = nullptr;
+  size_t length = 0;
+  if (err == 0) {
+    data = static_cast<char*>(malloc(capacity));
+    if (data == nullptr) {
+      err = UV_ENOMEM;
+      entry->syscall = "read";
+    }
+  }
+  while (err == 0 && (size == 0 || length < size)) {
+    if (length == capacity) {
+      if (capacity == Buffer::kMaxLength) {
+        err = UV_EFBIG;
+        entry->syscall = "read";
+        break;
+      }
+      capacity = std::min(capacity * 2, Buffer::kMaxLength);
+      char* grown = static_cast<char*>(realloc(data, capacity));
+      if (grown == nullptr) {
+        err = UV_ENOMEM;
+        entry->syscall = "read";
+        break;
+      }
+      data = grown;
+    }
+    uv_buf_t buf = uv_buf_init(data + length,
+                               static_cast<unsigned int>(std::min<size_t>(
+                                   capacity - length, INT32_MAX)));
+    int bytes = uv_fs_read(nullptr, &req, file, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes < 0) {
+      err = bytes;
+      entry->syscall = "read";
+    } else if (bytes == 0) {
+      break;
+    } else {
+      length += bytes;
+    }
+  }
+
+  uv_fs_close(nullptr, &req, file, nullptr);
+  uv_fs_req_cleanup(&req);
+
+  if (err != 0) {
+    free(data);
+    entry->error = err;
+    return;
+  }
+  // Don't keep the unused part of a chunk alive with the Buffer.
+  if (length == 0) {
+    free(data);
+    data = nullptr;
+  } else if (length < capacity) {
+    char* shrunk = static_cast<char*>(realloc(data, length));
+    if (shrunk != nullptr) data = shrunk;
+  }
+  entry->data = data;
+  entry->length = length;
+}
+
+static void ReadPaths(const std::vector<std::string>& paths,
+                      int flags,
+                      std::vector<ReadManyEntry>* entries) {
+  entries->resize(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    ReadPath(paths[i], flags, &(*entries)[i]);
+  }
+}
+
+// Returns [contents, errors], where contents holds a Buffer for every file
+// that was read and the name of the failed operation for every other one,
+// and errors holds 0 or the negative libuv error code for each file.
+static MaybeLocal<Value> CreateReadManyResult(
+    Isolate* isolate, std::vector<ReadManyEntry>* entries) {
+  const size_t count = entries->size();
+  AliasedInt32Array error_array(isolate, count);
+  LocalVector<Value> contents(isolate);
+  contents.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    ReadManyEntry* entry = &(*entries)[i];
+    error_array.SetValue(i, entry->error);
+    if (entry->error != 0) {
+      contents.push_back(OneByteString(isolate, entry->syscall));
+      continue;
+    }
+    Local<Object> buffer;
+    bool created = Buffer::New(isolate, entry->data, entry->length)
+                       .ToLocal(&buffer);
+    // The Buffer owns the data now, or has freed it.
+    entry->data = nullptr;
+    if (!created) return MaybeLocal<Value>();
+    contents.push_back(buffer);
+  }
+  Local<Value> result[] = {
+      Array::New(isolate, contents.data(), contents.size()),
+      error_array.GetJSArray(),
+  };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+static void FreeReadManyEntries(std::vector<ReadManyEntry>* entries) {
+  for (ReadManyEntry& entry : *entries) {
+    free(entry.data);
+    entry.data = nullptr;
+  }
+}
+
+class ReadManyWork final : public ThreadPoolWork {
+ public:
+  ReadManyWork(Environment* env,
+               FSReqBase* req_wrap,
+               std::vector<std::string>&& paths,
+               int flags)
+      : ThreadPoolWork(env, "readMany", ThreadPoolWorkClass::kFileSystem),
+        req_wrap_(req_wrap),
+        paths_(std::move(paths)),
+        flags_(flags) {}
+
+  ~ReadManyWork() override { FreeReadManyEntries(&entries_); }
+
+  void DoThreadPoolWork() override {
+    ReadPaths(paths_, flags_, &entries_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadManyWork> self(this);
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+    if (!env()->can_call_into_js()) return;
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+    if (status != 0) {
+      return req_wrap->Reject(
+          UVException(isolate, status, req_wrap->syscall()));
+    }
+    Local<Value> result;
+    if (CreateReadManyResult(isolate, &entries_).ToLocal(&result)) {
+      req_wrap->Resolve(result);
+    }
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::vector<std::string> paths_;
+  const int flags_;
+  std::vector<ReadManyEntry> entries_;
+};
+
+static void ReadMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsInt32());
+
+  Local<Array> js_paths = args[0].As<Array>();
+  const int flags = args[1].As<Int32>()->Value();
+  FSReqBase* req_wrap_async = nullptr;
+  if (!args[2]->IsUndefined()) {
+    req_wrap_async = GetReqWrap(args, 2);
+    CHECK_NOT_NULL(req_wrap_async);
+    req_wrap_async->SetReturnValue(args);
+  }
+
+  std::vector<std::string> paths;
+  paths.reserve(js_paths->Length());
+  for (uint32_t i = 0; i < js_paths->Length(); i++) {
+    Local<Value> value;
+    if (!js_paths->Get(env->context(), i).ToLocal(&value)) return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    ToNamespacedPath(env, &path);
+    if (req_wrap_async != nullptr) {
+      ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
+          env,
+          req_wrap_async,
+          permission::PermissionScope::kFileSystemRead,
+          path.ToStringView());
+    } else {
+      THROW_IF_INSUFFICIENT_PERMISSIONS(
+          env,
+          permission::PermissionScope::kFileSystemRead,
+          path.ToStringView());
+    }
+    paths.emplace_back(path.ToString());
+  }
+
+  if (req_wrap_async != nullptr) {  // readMany(paths, flags, req)
+    req_wrap_async->Init("readMany", nullptr, 0, UTF8);
+    auto* work =
+        new ReadManyWork(env, req_wrap_async, std::move(paths), flags);
+    work->ScheduleWork();
+    return;
+  }
+
+  // readMany(paths, flags, undefined)
+  std::vector<ReadManyEntry> entries;
+  FS_SYNC_TRACE_BEGIN(readMany);
+  ReadPaths(paths, flags, &entries);
+  FS_SYNC_TRACE_END(readMany);
+  Local<Value> result;
+  bool created = CreateReadManyResult(isolate, &entries).ToLocal(&result);
+  FreeReadManyEntries(&entries);
+  if (created) args.GetReturnValue().Set(result);
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1705,49 +2298,304 @@ static void RmSync(const FunctionCallbackInfo<Value>& args) {
       UV_UNKNOWN, "rm", message.c_str(), path_c_str);
 }
 
-int MKDirpSync(uv_loop_t* loop,
-               uv_fs_t* req,
-               const std::string& path,
-               int mode,
-               uv_fs_cb cb) {
-  FSReqWrapSync* req_wrap = ContainerOf(&FSReqWrapSync::req, req);
+#ifndef _WIN32
+// Removes a directory tree for fs.rm(path, { recursive: true }).
+//
+// Directories are processed by up to kRmTreeMaxWorkers jobs on the
+// threadpool at a time. Each job opens a directory, unlinks the entries that
+// are not directories relative to its descriptor and queues the
+// subdirectories, so that every job only keeps one descriptor open. A
+// directory is removed once its last subdirectory is gone, which may happen
+// on any job. Jobs return to the event loop after kRmTreeEntriesPerJob
+// entries so that subtrees found in the meantime are spread over new jobs.
+class RmTree {
+ public:
+  struct Dir {
+    Dir(std::string path, std::shared_ptr<Dir> parent)
+        : path(std::move(path)), parent(std::move(parent)) {}
+    std::string path;
+    std::shared_ptr<Dir> parent;
+    // Subdirectories that still exist, plus one while the directory itself
+    // is being read.
+    std::atomic<size_t> pending{1};
+  };
 
-  // on the first iteration of algorithm, stash state information.
-  if (req_wrap->continuation_data() == nullptr) {
-    req_wrap->set_continuation_data(
-        std::make_unique<FSContinuationData>(req, mode, cb));
-    req_wrap->continuation_data()->PushPath(std::move(path));
+  static constexpr size_t kRmTreeMaxWorkers = 4;
+  static constexpr size_t kRmTreeEntriesPerJob = 4096;
+
+  RmTree(Environment* env, FSReqBase* req_wrap, std::string path)
+      : env_(env), req_wrap_(req_wrap), path_(path) {
+    queue_.push_back(std::make_shared<Dir>(std::move(path), nullptr));
   }
 
-  while (req_wrap->continuation_data()->paths().size() > 0) {
-    std::string next_path = req_wrap->continuation_data()->PopPath();
-    int err = uv_fs_mkdir(loop, req, next_path.c_str(), mode, nullptr);
-    while (true) {
-      switch (err) {
-        // Note: uv_fs_req_cleanup in terminal paths will be called by
-        // ~FSReqWrapSync():
-        case 0:
-          req_wrap->continuation_data()->MaybeSetFirstPath(next_path);
-          if (req_wrap->continuation_data()->paths().empty()) {
-            return 0;
-          }
-          break;
-        case UV_EACCES:
-        case UV_ENOSPC:
-        case UV_ENOTDIR:
-        case UV_EPERM: {
-          return err;
+  void Schedule();
+
+ private:
+  class Job;
+
+  // Runs on the threadpool.
+  void Work() {
+    size_t entries = 0;
+    while (entries < kRmTreeEntriesPerJob) {
+      std::shared_ptr<Dir> dir;
+      {
+        Mutex::ScopedLock lock(mutex_);
+        if (error_ != 0 || queue_.empty()) return;
+        dir = std::move(queue_.back());
+        queue_.pop_back();
+      }
+      entries += ProcessDir(std::move(dir));
+    }
+  }
+
+  size_t ProcessDir(std::shared_ptr<Dir> dir) {
+    int fd = open(dir->path.c_str(),
+                  O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+      const int err = errno;
+      if (err == ENOTDIR || err == ELOOP) {
+        // The root is a file or a symlink, or an entry was replaced.
+        if (unlink(dir->path.c_str()) != 0 && errno != ENOENT) {
+          SetError(errno, "unlink", dir->path);
+          return 1;
         }
-        case UV_ENOENT: {
-          std::string dirname =
-              next_path.substr(0, next_path.find_last_of(kPathSeparator));
-          if (dirname != next_path) {
-            req_wrap->continuation_data()->PushPath(std::move(next_path));
-            req_wrap->continuation_data()->PushPath(std::move(dirname));
-          } else if (req_wrap->continuation_data()->paths().empty()) {
-            err = UV_EEXIST;
-            continue;
-          }
+      } else if (err != ENOENT) {
+        SetError(err, "scandir", dir->path);
+        return 1;
+      }
+      Removed(std::move(dir));
+      return 1;
+    }
+    DIR* stream = fdopendir(fd);
+    if (stream == nullptr) {
+      SetError(errno, "scandir", dir->path);
+      close(fd);
+      return 1;
+    }
+
+    std::vector<std::shared_ptr<Dir>> children;
+    size_t entries = 1;
+    for (;;) {
+      errno = 0;
+      const struct dirent* ent = readdir(stream);
+      if (ent == nullptr) {
+        if (errno != 0) SetError(errno, "scandir", dir->path);
+        break;
+      }
+      const char* name = ent->d_name;
+      if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+      entries++;
+
+      bool is_dir = false;
+#ifdef DT_DIR
+      if (ent->d_type == DT_DIR) {
+        is_dir = true;
+      } else if (ent->d_type == DT_UNKNOWN) {
+        is_dir = IsDirectoryAt(fd, name);
+      }
+#else
+      is_dir = IsDirectoryAt(fd, name);
+#endif
+      if (!is_dir && unlinkat(fd, name, 0) != 0) {
+        const int err = errno;
+        // Some systems report EPERM for directories.
+        if ((err == EISDIR || err == EPERM) && IsDirectoryAt(fd, name)) {
+          is_dir = true;
+        } else if (err != ENOENT) {
+          SetError(err, "unlink", dir->path + '/' + name);
+          break;
+        }
+      }
+      if (is_dir) {
+        dir->pending++;
+        children.push_back(
+            std::make_shared<Dir>(dir->path + '/' + name, dir));
+      }
+    }
+    closedir(stream);
+
+    if (!children.empty()) {
+      Mutex::ScopedLock lock(mutex_);
+      for (auto& child : children) queue_.push_back(std::move(child));
+    }
+    if (--dir->pending == 0) RemoveDir(std::move(dir));
+    return entries;
+  }
+
+  static bool IsDirectoryAt(int fd, const char* name) {
+    struct stat s;
+    return fstatat(fd, name, &s, AT_SYMLINK_NOFOLLOW) == 0 &&
+           S_ISDIR(s.st_mode);
+  }
+
+  // Removes a directory whose entries are all gone, and then every parent
+  // that this leaves empty.
+  void RemoveDir(std::shared_ptr<Dir> dir) {
+    if (rmdir(dir->path.c_str()) != 0 && errno != ENOENT) {
+      SetError(errno, "rmdir", dir->path);
+      return;
+    }
+    Removed(std::move(dir));
+  }
+
+  void Removed(std::shared_ptr<Dir> dir) {
+    std::shared_ptr<Dir> parent = std::move(dir->parent);
+    dir.reset();
+    if (parent && --parent->pending == 0) RemoveDir(std::move(parent));
+  }
+
+  void SetError(int err, const char* syscall, const std::string& path) {
+    Mutex::ScopedLock lock(mutex_);
+    if (error_ != 0) return;
+    error_ = UV__ERR(err);
+    error_syscall_ = syscall;
+    error_path_ = path;
+  }
+
+  // Runs on the event loop thread when a job is done.
+  void AfterJob() {
+    CHECK_GT(active_jobs_, 0);
+    active_jobs_--;
+    Schedule();
+  }
+
+  void Finish();
+
+  Environment* env_;
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string path_;
+  size_t active_jobs_ = 0;
+
+  Mutex mutex_;
+  std::vector<std::shared_ptr<Dir>> queue_;
+  int error_ = 0;
+  const char* error_syscall_ = nullptr;
+  std::string error_path_;
+};
+
+class RmTree::Job final : public ThreadPoolWork {
+ public:
+  Job(Environment* env, RmTree* tree)
+      : ThreadPoolWork(env, "rm", ThreadPoolWorkClass::kFileSystem),
+        tree_(tree) {}
+
+  void DoThreadPoolWork() override { tree_->Work(); }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<Job> self(this);
+    if (status != 0) tree_->SetError(-status, "rm", tree_->path_);
+    tree_->AfterJob();
+  }
+
+ private:
+  RmTree* tree_;
+};
+
+void RmTree::Schedule() {
+  size_t queued;
+  bool failed;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    queued = queue_.size();
+    failed = error_ != 0;
+  }
+  if (!failed) {
+    while (active_jobs_ < kRmTreeMaxWorkers && active_jobs_ < queued) {
+      active_jobs_++;
+      (new Job(env_, this))->ScheduleWork();
+    }
+  }
+  if (active_jobs_ == 0) Finish();
+}
+
+void RmTree::Finish() {
+  std::unique_ptr<RmTree> self(this);
+  BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+  req_wrap->Detach();
+  if (!env_->can_call_into_js()) return;
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env_->context());
+  if (error_ != 0) {
+    return req_wrap->Reject(UVException(
+        isolate, error_, error_syscall_, nullptr, error_path_.c_str()));
+  }
+  req_wrap->Resolve(Undefined(isolate));
+}
+#endif  // _WIN32
+
+// Only available on POSIX; Windows uses the JS implementation, which knows
+// how to deal with EPERM there.
+//
+// rmRecursive(path, req)
+static void RmRecursive(const FunctionCallbackInfo<Value>& args) {
+#ifdef _WIN32
+  UNREACHABLE();
+#else
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK_EQ(args.Length(), 2);
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+  ToNamespacedPath(env, &path);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->SetReturnValue(args);
+  ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
+      env,
+      req_wrap_async,
+      permission::PermissionScope::kFileSystemWrite,
+      path.ToStringView());
+  req_wrap_async->Init("rm", nullptr, 0, UTF8);
+  (new RmTree(env, req_wrap_async, path.ToString()))->Schedule();
+#endif  // _WIN32
+}
+
+int MKDirpSync(uv_loop_t* loop,
+               uv_fs_t* req,
+               const std::string& path,
+               int mode,
+               uv_fs_cb cb) {
+  FSReqWrapSync* req_wrap = ContainerOf(&FSReqWrapSync::req, req);
+
+  // on the first iteration of algorithm, stash state information.
+  if (req_wrap->continuation_data() == nullptr) {
+    req_wrap->set_continuation_data(
+        std::make_unique<FSContinuationData>(req, mode, cb));
+    req_wrap->continuation_data()->PushPath(std::move(path));
+  }
+
+  while (req_wrap->continuation_data()->paths().size() > 0) {
+    std::string next_path = req_wrap->continuation_data()->PopPath();
+    int err = uv_fs_mkdir(loop, req, next_path.c_str(), mode, nullptr);
+    while (true) {
+      switch (err) {
+        // Note: uv_fs_req_cleanup in terminal paths will be called by
+        // ~FSReqWrapSync():
+        case 0:
+          req_wrap->continuation_data()->MaybeSetFirstPath(next_path);
+          if (req_wrap->continuation_data()->paths().empty()) {
+            return 0;
+          }
+          break;
+        case UV_EACCES:
+        case UV_ENOSPC:
+        case UV_ENOTDIR:
+        case UV_EPERM: {
+          return err;
+        }
+        case UV_ENOENT: {
+          std::string dirname =
+              next_path.substr(0, next_path.find_last_of(kPathSeparator));
+          if (dirname != next_path) {
+            req_wrap->continuation_data()->PushPath(std::move(next_path));
+            req_wrap->continuation_data()->PushPath(std::move(dirname));
+          } else if (req_wrap->continuation_data()->paths().empty()) {
+            err = UV_EEXIST;
+            continue;
+          }
           break;
         }
         default:
@@ -1905,165 +2753,753 @@ static void MKDir(const FunctionCallbackInfo<Value>& args) {
         env->ThrowUVException(err, "mkdir", nullptr, *path);
         return;
       }
-      if (!req_wrap_sync.continuation_data()->first_path().empty()) {
-        Local<Value> ret;
-        std::string first_path(req_wrap_sync.continuation_data()->first_path());
-        if (StringBytes::Encode(env->isolate(), first_path.c_str(), UTF8)
-                .ToLocal(&ret)) {
-          args.GetReturnValue().Set(ret);
+      if (!req_wrap_sync.continuation_data()->first_path().empty()) {
+        Local<Value> ret;
+        std::string first_path(req_wrap_sync.continuation_data()->first_path());
+        if (StringBytes::Encode(env->isolate(), first_path.c_str(), UTF8)
+                .ToLocal(&ret)) {
+          args.GetReturnValue().Set(ret);
+        }
+      }
+    } else {
+      SyncCallAndThrowOnError(env, &req_wrap_sync, uv_fs_mkdir, *path, mode);
+    }
+    FS_SYNC_TRACE_END(mkdir);
+  }
+}
+
+static void RealPath(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+  ToNamespacedPath(env, &path);
+
+  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+
+  if (argc > 2) {  // realpath(path, encoding, req)
+    FSReqBase* req_wrap_async = GetReqWrap(args, 2);
+    FS_ASYNC_TRACE_BEGIN1(
+        UV_FS_REALPATH, req_wrap_async, "path", TRACE_STR_COPY(*path))
+    AsyncCall(env, req_wrap_async, args, "realpath", encoding, AfterStringPtr,
+              uv_fs_realpath, *path);
+  } else {  // realpath(path, encoding, undefined, ctx)
+    FSReqWrapSync req_wrap_sync("realpath", *path);
+    FS_SYNC_TRACE_BEGIN(realpath);
+    int err =
+        SyncCallAndThrowOnError(env, &req_wrap_sync, uv_fs_realpath, *path);
+    FS_SYNC_TRACE_END(realpath);
+    if (err < 0) {
+      return;
+    }
+
+    const char* link_path = static_cast<const char*>(req_wrap_sync.req.ptr);
+
+    Local<Value> ret;
+    if (StringBytes::Encode(isolate, link_path, encoding).ToLocal(&ret)) {
+      args.GetReturnValue().Set(ret);
+    }
+  }
+}
+
+static void ReadDir(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+#ifdef _WIN32
+  // On Windows, some API functions accept paths with trailing slashes,
+  // while others do not. This code checks if the input path ends with
+  // a slash (either '/' or '\\') and, if so, ensures that the processed
+  // path also ends with a trailing backslash ('\\').
+  bool slashCheck = false;
+  if (path.ToStringView().ends_with("/") ||
+      path.ToStringView().ends_with("\\")) {
+    slashCheck = true;
+  }
+#endif
+
+  ToNamespacedPath(env, &path);
+
+#ifdef _WIN32
+  if (slashCheck) {
+    size_t new_length = path.length() + 1;
+    path.AllocateSufficientStorage(new_length + 1);
+    path.SetLengthAndZeroTerminate(new_length);
+    path.out()[new_length - 1] = '\\';
+  }
+#endif
+
+  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+
+  bool with_types = args[2]->IsTrue();
+
+  if (argc > 3) {  // readdir(path, encoding, withTypes, req)
+    FSReqBase* req_wrap_async = GetReqWrap(args, 3);
+    ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
+        env,
+        req_wrap_async,
+        permission::PermissionScope::kFileSystemRead,
+        path.ToStringView());
+    req_wrap_async->set_with_file_types(with_types);
+    FS_ASYNC_TRACE_BEGIN1(
+        UV_FS_SCANDIR, req_wrap_async, "path", TRACE_STR_COPY(*path))
+    AsyncCall(env,
+              req_wrap_async,
+              args,
+              "scandir",
+              encoding,
+              AfterScanDir,
+              uv_fs_scandir,
+              *path,
+              0 /*flags*/);
+  } else {  // readdir(path, encoding, withTypes)
+    THROW_IF_INSUFFICIENT_PERMISSIONS(
+        env, permission::PermissionScope::kFileSystemRead, path.ToStringView());
+    FSReqWrapSync req_wrap_sync("scandir", *path);
+    FS_SYNC_TRACE_BEGIN(readdir);
+    int err = SyncCallAndThrowOnError(
+        env, &req_wrap_sync, uv_fs_scandir, *path, 0 /*flags*/);
+    FS_SYNC_TRACE_END(readdir);
+    if (is_uv_error(err)) {
+      return;
+    }
+
+    int r;
+    LocalVector<Value> name_v(isolate);
+    LocalVector<Value> type_v(isolate);
+
+    for (;;) {
+      uv_dirent_t ent;
+
+      r = uv_fs_scandir_next(&(req_wrap_sync.req), &ent);
+      if (r == UV_EOF)
+        break;
+      if (is_uv_error(r)) {
+        env->ThrowUVException(r, "scandir", nullptr, *path);
+        return;
+      }
+
+      Local<Value> fn;
+      if (!StringBytes::Encode(isolate, ent.name, encoding).ToLocal(&fn)) {
+        return;
+      }
+
+      name_v.push_back(fn);
+
+      if (with_types) {
+        type_v.emplace_back(Integer::New(isolate, ent.type));
+      }
+    }
+
+
+    Local<Array> names = Array::New(isolate, name_v.data(), name_v.size());
+    if (with_types) {
+      Local<Value> result[] = {
+        names,
+        Array::New(isolate, type_v.data(), type_v.size())
+      };
+      args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
+    } else {
+      args.GetReturnValue().Set(names);
+    }
+  }
+}
+
+// Walks a directory tree breadth-first, in the same order as the JS
+// implementation of readdir({ recursive: true }) that it replaces. Directories
+// are stored relative to the base path (the base itself is ""), entries refer
+// to their directory by index so that every path is only encoded once.
+// Entries of unknown type are lstat()ed right away and symlinks are stat()ed
+// to find out whether they point to a directory that needs to be walked,
+// so that JS never needs a second round trip per entry.
+struct RecursiveReadDirResult {
+  std::vector<std::string> dirs;
+  std::vector<uint32_t> parents;
+  std::vector<std::string> names;
+  std::vector<uint8_t> types;
+  int error = 0;
+  std::string error_path;
+};
+
+static int DirentTypeFromMode(uint64_t mode) {
+#ifndef _WIN32
+  switch (mode & S_IFMT) {
+    case S_IFREG:
+      return UV_DIRENT_FILE;
+    case S_IFDIR:
+      return UV_DIRENT_DIR;
+    case S_IFLNK:
+      return UV_DIRENT_LINK;
+    case S_IFIFO:
+      return UV_DIRENT_FIFO;
+    case S_IFSOCK:
+      return UV_DIRENT_SOCKET;
+    case S_IFCHR:
+      return UV_DIRENT_CHAR;
+    case S_IFBLK:
+      return UV_DIRENT_BLOCK;
+  }
+#endif  // _WIN32
+  return UV_DIRENT_UNKNOWN;
+}
+
+static void RecursiveReadDir(const std::string& base,
+                             RecursiveReadDirResult* result) {
+#ifdef _WIN32
+  const bool base_has_separator =
+      !base.empty() && (base.back() == '\\' || base.back() == '/');
+#else
+  const bool base_has_separator = !base.empty() && base.back() == '/';
+#endif
+  result->dirs.emplace_back();
+  for (size_t i = 0; i < result->dirs.size(); i++) {
+    std::string dir_path = base;
+    if (i > 0) {
+      if (!base_has_separator) dir_path += node::kPathSeparator;
+      dir_path += result->dirs[i];
+    }
+
+    uv_fs_t req;
+    auto cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+    int err = uv_fs_scandir(nullptr, &req, dir_path.c_str(), 0, nullptr);
+    if (err < 0) {
+      result->error = err;
+      result->error_path = std::move(dir_path);
+      return;
+    }
+
+    for (;;) {
+      uv_dirent_t ent;
+      err = uv_fs_scandir_next(&req, &ent);
+      if (err == UV_EOF) break;
+      if (err < 0) {
+        result->error = err;
+        result->error_path = std::move(dir_path);
+        return;
+      }
+
+      int type = ent.type;
+      bool is_dir = type == UV_DIRENT_DIR;
+      if (type == UV_DIRENT_UNKNOWN || type == UV_DIRENT_LINK) {
+        std::string entry_path = dir_path;
+        if (i > 0 || !base_has_separator) entry_path += node::kPathSeparator;
+        entry_path += ent.name;
+        uv_fs_t stat_req;
+        if (type == UV_DIRENT_UNKNOWN) {
+          if (uv_fs_lstat(nullptr, &stat_req, entry_path.c_str(), nullptr) ==
+              0) {
+            type = DirentTypeFromMode(stat_req.statbuf.st_mode);
+          }
+          uv_fs_req_cleanup(&stat_req);
+        }
+        if (type == UV_DIRENT_DIR) {
+          is_dir = true;
+        } else if (type == UV_DIRENT_LINK || type == UV_DIRENT_UNKNOWN) {
+          // Symlinks to directories are walked, like with stat().
+          if (uv_fs_stat(nullptr, &stat_req, entry_path.c_str(), nullptr) ==
+              0) {
+            is_dir = S_ISDIR(stat_req.statbuf.st_mode);
+          }
+          uv_fs_req_cleanup(&stat_req);
+        }
+      }
+
+      result->parents.push_back(static_cast<uint32_t>(i));
+      result->names.emplace_back(ent.name);
+      result->types.push_back(static_cast<uint8_t>(type));
+      if (is_dir) {
+        std::string child = result->dirs[i];
+        if (i > 0) child += node::kPathSeparator;
+        child += ent.name;
+        result->dirs.push_back(std::move(child));
+      }
+    }
+  }
+}
+
+// Returns [dirs, parents, names, types]: the directories that were walked
+// (relative to the base path), and for each entry the index of its directory
+// in `dirs`, its name and its dirent type.
+static MaybeLocal<Value> CreateRecursiveReadDirResult(
+    Isolate* isolate, const RecursiveReadDirResult& walk) {
+  Local<Context> context = isolate->GetCurrentContext();
+  Local<Value> dirs;
+  Local<Value> names;
+  if (!ToV8Value(context, walk.dirs, isolate).ToLocal(&dirs) ||
+      !ToV8Value(context, walk.names, isolate).ToLocal(&names)) {
+    return MaybeLocal<Value>();
+  }
+
+  const size_t count = walk.names.size();
+  AliasedUint32Array parents(isolate, count);
+  AliasedUint8Array types(isolate, count);
+  for (size_t i = 0; i < count; i++) {
+    parents.SetValue(i, walk.parents[i]);
+    types.SetValue(i, walk.types[i]);
+  }
+
+  Local<Value> result[] = {
+      dirs, parents.GetJSArray(), names, types.GetJSArray()};
+  return Array::New(isolate, result, arraysize(result));
+}
+
+class RecursiveReadDirWork final : public ThreadPoolWork {
+ public:
+  RecursiveReadDirWork(Environment* env, FSReqBase* req_wrap, std::string path)
+      : ThreadPoolWork(
+            env, "readdirRecursive", ThreadPoolWorkClass::kFileSystem),
+        req_wrap_(req_wrap),
+        path_(std::move(path)) {}
+
+  void DoThreadPoolWork() override { RecursiveReadDir(path_, &result_); }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<RecursiveReadDirWork> self(this);
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+    if (!env()->can_call_into_js()) return;
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+    if (status != 0) {
+      return req_wrap->Reject(
+          UVException(isolate, status, "scandir", nullptr, path_.c_str()));
+    }
+    if (result_.error != 0) {
+      return req_wrap->Reject(UVException(isolate,
+                                          result_.error,
+                                          "scandir",
+                                          nullptr,
+                                          result_.error_path.c_str()));
+    }
+    TryCatch try_catch(isolate);
+    Local<Value> result;
+    if (!CreateRecursiveReadDirResult(isolate, result_).ToLocal(&result)) {
+      CHECK(try_catch.CanContinue());
+      return req_wrap->Reject(try_catch.Exception());
+    }
+    req_wrap->Resolve(result);
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string path_;
+  RecursiveReadDirResult result_;
+};
+
+// Only UTF-8 names are supported; other encodings and the permission model
+// use the JS implementation, which checks every directory it reads.
+//
+// readdirRecursive(path, req)
+static void ReadDirRecursive(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+  ToNamespacedPath(env, &path);
+
+  if (!args[1]->IsUndefined()) {  // readdirRecursive(path, req)
+    FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+    CHECK_NOT_NULL(req_wrap_async);
+    req_wrap_async->SetReturnValue(args);
+    ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
+        env,
+        req_wrap_async,
+        permission::PermissionScope::kFileSystemRead,
+        path.ToStringView());
+    req_wrap_async->Init("scandir", nullptr, 0, UTF8);
+    auto* work =
+        new RecursiveReadDirWork(env, req_wrap_async, path.ToString());
+    work->ScheduleWork();
+    return;
+  }
+
+  // readdirRecursive(path, undefined)
+  THROW_IF_INSUFFICIENT_PERMISSIONS(
+      env, permission::PermissionScope::kFileSystemRead, path.ToStringView());
+  RecursiveReadDirResult walk;
+  FS_SYNC_TRACE_BEGIN(readdir);
+  RecursiveReadDir(path.ToString(), &walk);
+  FS_SYNC_TRACE_END(readdir);
+  if (walk.error != 0) {
+    return env->ThrowUVException(
+        walk.error, "scandir", nullptr, walk.error_path.c_str());
+  }
+  Local<Value> result;
+  if (CreateRecursiveReadDirResult(isolate, walk).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
+// Native implementation of the common case of fs.globSync(). Patterns are
+// still parsed and brace-expanded by minimatch; this receives the expanded
+// `globParts` of each pattern and walks the tree once per pattern, only
+// reading the directories that a pattern can still match below.
+//
+// Everything that would need the finer points of the JS walker (symlinks met
+// by `**`, `.` and `..` segments, dot-prefixed segments, extglobs, POSIX
+// character classes and absolute patterns) makes the walk give up, in which
+// case JS falls back to its own implementation.
+namespace {
+
+struct GlobSegment {
+  enum Kind { kLiteral, kWildcard, kGlobstar };
+  Kind kind;
+  std::string text;
+};
+
+// Returns the number of bytes of the UTF-8 character starting at s[i].
+size_t GlobCharLength(std::string_view s, size_t i) {
+  size_t len = 1;
+  while (i + len < s.size() && (s[i + len] & 0xC0) == 0x80) len++;
+  return len;
+}
+
+// Matches `c` against the bracket expression starting at pattern[p]. Returns
+// the length of the expression, or 0 if it is not terminated and the `[`
+// has to be matched literally.
+size_t GlobMatchClass(std::string_view pattern,
+                      size_t p,
+                      char c,
+                      bool nocase,
+                      bool* matched) {
+  size_t i = p + 1;
+  bool negate = false;
+  if (i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^')) {
+    negate = true;
+    i++;
+  }
+  bool found = false;
+  for (size_t start = i; i < pattern.size();) {
+    char lo = pattern[i];
+    if (lo == ']' && i != start) {
+      *matched = found != negate;
+      return i + 1 - p;
+    }
+    char hi = lo;
+    if (i + 2 < pattern.size() && pattern[i + 1] == '-' &&
+        pattern[i + 2] != ']') {
+      hi = pattern[i + 2];
+      i += 3;
+    } else {
+      i++;
+    }
+    if (static_cast<unsigned char>(c) >= 0x80) continue;
+    if ((c >= lo && c <= hi) ||
+        (nocase && ((ToLower(c) >= lo && ToLower(c) <= hi) ||
+                    (ToUpper(c) >= lo && ToUpper(c) <= hi)))) {
+      found = true;
+    }
+  }
+  return 0;
+}
+
+// Matches a file name against a segment made of `*`, `?`, bracket
+// expressions and literal characters. Like minimatch, wildcards never match
+// a leading dot.
+bool GlobMatchSegment(std::string_view pattern,
+                      std::string_view name,
+                      bool nocase) {
+  if (!name.empty() && name[0] == '.') return false;
+  size_t p = 0;
+  size_t n = 0;
+  size_t star_p = std::string_view::npos;
+  size_t star_n = 0;
+  while (n < name.size()) {
+    if (p < pattern.size()) {
+      const char c = pattern[p];
+      if (c == '*') {
+        star_p = ++p;
+        star_n = n;
+        continue;
+      }
+      if (c == '?') {
+        p++;
+        n += GlobCharLength(name, n);
+        continue;
+      }
+      bool matched = false;
+      size_t len = c == '[' ? GlobMatchClass(pattern, p, name[n], nocase,
+                                             &matched)
+                            : 0;
+      if (len > 0) {
+        if (matched) {
+          p += len;
+          n += GlobCharLength(name, n);
+          continue;
+        }
+      } else if (c == name[n] ||
+                 (nocase && ToLower(c) == ToLower(name[n]))) {
+        p++;
+        n++;
+        continue;
+      }
+    }
+    if (star_p == std::string_view::npos) return false;
+    p = star_p;
+    star_n += GlobCharLength(name, star_n);
+    n = star_n;
+  }
+  while (p < pattern.size() && pattern[p] == '*') p++;
+  return p == pattern.size();
+}
+
+// Turns one entry of minimatch's `globParts` into segments, or returns false
+// if the pattern needs the JS implementation.
+bool CompileGlobPattern(const std::vector<std::string>& parts,
+                        bool nocase,
+                        std::vector<GlobSegment>* segments) {
+  if (parts.empty()) return false;
+  for (const std::string& part : parts) {
+    if (part.empty() || part[0] == '.') return false;
+    if (part == "**") {
+      if (segments->empty() || segments->back().kind != GlobSegment::kGlobstar)
+        segments->push_back({GlobSegment::kGlobstar, part});
+      continue;
+    }
+    bool magic = false;
+    for (size_t i = 0; i < part.size(); i++) {
+      const char c = part[i];
+#ifdef _WIN32
+      if (c == ':') return false;
+#endif
+      if (i + 1 < part.size() && part[i + 1] == '(' &&
+          (c == '+' || c == '@' || c == '!' || c == '*' || c == '?')) {
+        return false;  // extglob
+      }
+      if (c == '*' || c == '?') {
+        magic = true;
+      } else if (c == '[') {
+        bool matched;
+        size_t len = GlobMatchClass(part, i, 'a', false, &matched);
+        if (len == 0) continue;
+        std::string_view expression(part.data() + i, len);
+        if (expression.find("[:") != std::string_view::npos ||
+            expression.find('.') != std::string_view::npos) {
+          return false;
         }
+        magic = true;
       }
-    } else {
-      SyncCallAndThrowOnError(env, &req_wrap_sync, uv_fs_mkdir, *path, mode);
     }
-    FS_SYNC_TRACE_END(mkdir);
+    if (magic && nocase) {
+      for (unsigned char c : part) {
+        if (c >= 0x80) return false;
+      }
+    }
+    segments->push_back(
+        {magic ? GlobSegment::kWildcard : GlobSegment::kLiteral, part});
   }
+  return true;
 }
 
-static void RealPath(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  Isolate* isolate = env->isolate();
-
-  const int argc = args.Length();
-  CHECK_GE(argc, 2);
-
-  BufferValue path(isolate, args[0]);
-  CHECK_NOT_NULL(*path);
-  ToNamespacedPath(env, &path);
-
-  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
-
-  if (argc > 2) {  // realpath(path, encoding, req)
-    FSReqBase* req_wrap_async = GetReqWrap(args, 2);
-    FS_ASYNC_TRACE_BEGIN1(
-        UV_FS_REALPATH, req_wrap_async, "path", TRACE_STR_COPY(*path))
-    AsyncCall(env, req_wrap_async, args, "realpath", encoding, AfterStringPtr,
-              uv_fs_realpath, *path);
-  } else {  // realpath(path, encoding, undefined, ctx)
-    FSReqWrapSync req_wrap_sync("realpath", *path);
-    FS_SYNC_TRACE_BEGIN(realpath);
-    int err =
-        SyncCallAndThrowOnError(env, &req_wrap_sync, uv_fs_realpath, *path);
-    FS_SYNC_TRACE_END(realpath);
-    if (err < 0) {
-      return;
-    }
+class GlobWalker {
+ public:
+  GlobWalker(std::string cwd, bool nocase)
+      : cwd_(std::move(cwd)), nocase_(nocase) {}
+
+  // Returns false if the walk ran into something it cannot handle.
+  bool Walk(const std::vector<GlobSegment>& segments) {
+    pattern_id_++;
+    std::vector<std::pair<std::string, size_t>> stack;
+    stack.emplace_back(".", 0);
+    while (!stack.empty()) {
+      auto [rel, idx] = std::move(stack.back());
+      stack.pop_back();
+      if (!visited_.emplace(VisitKey(rel, idx)).second) continue;
+
+      const GlobSegment& segment = segments[idx];
+      const bool last = idx + 1 == segments.size();
+      if (segment.kind == GlobSegment::kLiteral) {
+        std::string child = Join(rel, segment.text);
+        int type = Lstat(child);
+        if (type < 0) continue;
+        if (last) {
+          AddResult(std::move(child));
+        } else if (type == UV_DIRENT_DIR ||
+                   (type == UV_DIRENT_LINK && IsDirectory(child))) {
+          stack.emplace_back(std::move(child), idx + 1);
+        }
+        continue;
+      }
 
-    const char* link_path = static_cast<const char*>(req_wrap_sync.req.ptr);
+      const auto& entries = ReadDir(rel);
+      if (segment.kind == GlobSegment::kWildcard) {
+        for (const auto& [name, type] : entries) {
+          if (!GlobMatchSegment(segment.text, name, nocase_)) continue;
+          if (last) {
+            AddResult(Join(rel, name));
+          } else if (type == UV_DIRENT_DIR) {
+            stack.emplace_back(Join(rel, name), idx + 1);
+          }
+        }
+        continue;
+      }
 
-    Local<Value> ret;
-    if (StringBytes::Encode(isolate, link_path, encoding).ToLocal(&ret)) {
-      args.GetReturnValue().Set(ret);
+      // `**` matches the directory itself, but the cwd only when it is the
+      // whole pattern.
+      if (last && (rel != "." || idx == 0)) AddResult(rel);
+      const GlobSegment* next = last ? nullptr : &segments[idx + 1];
+      const bool next_is_last = idx + 2 == segments.size();
+      for (const auto& [name, type] : entries) {
+        if (name[0] == '.') continue;
+        if (type == UV_DIRENT_LINK) return false;
+        std::string child = Join(rel, name);
+        const bool is_dir = type == UV_DIRENT_DIR;
+        if (next != nullptr &&
+            (next->kind == GlobSegment::kLiteral
+                 ? name == next->text
+                 : GlobMatchSegment(next->text, name, nocase_))) {
+          if (next_is_last) {
+            AddResult(child);
+          } else if (is_dir) {
+            stack.emplace_back(child, idx + 2);
+          }
+        }
+        if (is_dir) {
+          stack.emplace_back(std::move(child), idx);
+        } else if (last) {
+          AddResult(std::move(child));
+        }
+      }
     }
+    return true;
   }
-}
 
-static void ReadDir(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  Isolate* isolate = env->isolate();
+  const std::vector<std::string>& results() const { return results_; }
 
-  const int argc = args.Length();
-  CHECK_GE(argc, 3);
+ private:
+  std::string Join(const std::string& rel, const std::string& name) const {
+    if (rel == ".") return name;
+    return rel + node::kPathSeparator + name;
+  }
 
-  BufferValue path(isolate, args[0]);
-  CHECK_NOT_NULL(*path);
-#ifdef _WIN32
-  // On Windows, some API functions accept paths with trailing slashes,
-  // while others do not. This code checks if the input path ends with
-  // a slash (either '/' or '\\') and, if so, ensures that the processed
-  // path also ends with a trailing backslash ('\\').
-  bool slashCheck = false;
-  if (path.ToStringView().ends_with("/") ||
-      path.ToStringView().ends_with("\\")) {
-    slashCheck = true;
+  std::string FullPath(const std::string& rel) const {
+    if (rel == ".") return cwd_;
+    return cwd_ + node::kPathSeparator + rel;
   }
-#endif
 
-  ToNamespacedPath(env, &path);
+  std::string VisitKey(const std::string& rel, size_t idx) const {
+    return std::to_string(pattern_id_) + ':' + std::to_string(idx) + ':' + rel;
+  }
 
-#ifdef _WIN32
-  if (slashCheck) {
-    size_t new_length = path.length() + 1;
-    path.AllocateSufficientStorage(new_length + 1);
-    path.SetLengthAndZeroTerminate(new_length);
-    path.out()[new_length - 1] = '\\';
+  void AddResult(std::string rel) {
+    if (seen_results_.insert(rel).second) results_.push_back(std::move(rel));
   }
-#endif
 
-  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+  int Lstat(const std::string& rel) const {
+    uv_fs_t req;
+    int err = uv_fs_lstat(nullptr, &req, FullPath(rel).c_str(), nullptr);
+    int type = err < 0 ? -1 : DirentTypeFromMode(req.statbuf.st_mode);
+    uv_fs_req_cleanup(&req);
+    return type;
+  }
 
-  bool with_types = args[2]->IsTrue();
+  bool IsDirectory(const std::string& rel) const {
+    uv_fs_t req;
+    int err = uv_fs_stat(nullptr, &req, FullPath(rel).c_str(), nullptr);
+    bool is_dir = err == 0 && S_ISDIR(req.statbuf.st_mode);
+    uv_fs_req_cleanup(&req);
+    return is_dir;
+  }
 
-  if (argc > 3) {  // readdir(path, encoding, withTypes, req)
-    FSReqBase* req_wrap_async = GetReqWrap(args, 3);
-    ASYNC_THROW_IF_INSUFFICIENT_PERMISSIONS(
-        env,
-        req_wrap_async,
-        permission::PermissionScope::kFileSystemRead,
-        path.ToStringView());
-    req_wrap_async->set_with_file_types(with_types);
-    FS_ASYNC_TRACE_BEGIN1(
-        UV_FS_SCANDIR, req_wrap_async, "path", TRACE_STR_COPY(*path))
-    AsyncCall(env,
-              req_wrap_async,
-              args,
-              "scandir",
-              encoding,
-              AfterScanDir,
-              uv_fs_scandir,
-              *path,
-              0 /*flags*/);
-  } else {  // readdir(path, encoding, withTypes)
-    THROW_IF_INSUFFICIENT_PERMISSIONS(
-        env, permission::PermissionScope::kFileSystemRead, path.ToStringView());
-    FSReqWrapSync req_wrap_sync("scandir", *path);
-    FS_SYNC_TRACE_BEGIN(readdir);
-    int err = SyncCallAndThrowOnError(
-        env, &req_wrap_sync, uv_fs_scandir, *path, 0 /*flags*/);
-    FS_SYNC_TRACE_END(readdir);
-    if (is_uv_error(err)) {
-      return;
+  // Directories that cannot be read are treated as empty, like in JS.
+  const std::vector<std::pair<std::string, int>>& ReadDir(
+      const std::string& rel) {
+    auto [it, inserted] = readdir_cache_.try_emplace(rel);
+    if (!inserted) return it->second;
+    const std::string dir_path = FullPath(rel);
+    uv_fs_t req;
+    auto cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+    if (uv_fs_scandir(nullptr, &req, dir_path.c_str(), 0, nullptr) < 0) {
+      return it->second;
     }
+    uv_dirent_t ent;
+    while (uv_fs_scandir_next(&req, &ent) == 0) {
+      int type = ent.type;
+      if (type == UV_DIRENT_UNKNOWN) {
+        type = Lstat(Join(rel, ent.name));
+        if (type < 0) continue;
+      }
+      it->second.emplace_back(ent.name, type);
+    }
+    return it->second;
+  }
 
-    int r;
-    LocalVector<Value> name_v(isolate);
-    LocalVector<Value> type_v(isolate);
-
-    for (;;) {
-      uv_dirent_t ent;
+  std::string cwd_;
+  bool nocase_;
+  size_t pattern_id_ = 0;
+  std::vector<std::string> results_;
+  std::unordered_set<std::string> seen_results_;
+  std::unordered_set<std::string> visited_;
+  std::unordered_map<std::string, std::vector<std::pair<std::string, int>>>
+      readdir_cache_;
+};
 
-      r = uv_fs_scandir_next(&(req_wrap_sync.req), &ent);
-      if (r == UV_EOF)
-        break;
-      if (is_uv_error(r)) {
-        env->ThrowUVException(r, "scandir", nullptr, *path);
-        return;
-      }
+}  // namespace
 
-      Local<Value> fn;
-      if (!StringBytes::Encode(isolate, ent.name, encoding).ToLocal(&fn)) {
-        return;
-      }
+// glob(cwd, patterns, nocase)
+// `patterns` is an array of minimatch `globParts`. Returns the matched paths
+// relative to `cwd`, or undefined if the patterns need the JS implementation.
+static void Glob(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
 
-      name_v.push_back(fn);
+  CHECK_EQ(args.Length(), 3);
+  BufferValue cwd(isolate, args[0]);
+  CHECK_NOT_NULL(*cwd);
+  ToNamespacedPath(env, &cwd);
+  CHECK(args[1]->IsArray());
+  const bool nocase = args[2]->IsTrue();
 
-      if (with_types) {
-        type_v.emplace_back(Integer::New(isolate, ent.type));
-      }
+  THROW_IF_INSUFFICIENT_PERMISSIONS(
+      env, permission::PermissionScope::kFileSystemRead, cwd.ToStringView());
+
+  Local<Array> patterns = args[1].As<Array>();
+  std::vector<std::vector<GlobSegment>> compiled(patterns->Length());
+  for (uint32_t i = 0; i < patterns->Length(); i++) {
+    Local<Value> pattern;
+    if (!patterns->Get(context, i).ToLocal(&pattern)) return;
+    CHECK(pattern->IsArray());
+    Local<Array> parts_array = pattern.As<Array>();
+    std::vector<std::string> parts;
+    parts.reserve(parts_array->Length());
+    for (uint32_t j = 0; j < parts_array->Length(); j++) {
+      Local<Value> part;
+      if (!parts_array->Get(context, j).ToLocal(&part)) return;
+      CHECK(part->IsString());
+      parts.emplace_back(Utf8Value(isolate, part).ToString());
     }
+    if (!CompileGlobPattern(parts, nocase, &compiled[i])) return;
+  }
 
-
-    Local<Array> names = Array::New(isolate, name_v.data(), name_v.size());
-    if (with_types) {
-      Local<Value> result[] = {
-        names,
-        Array::New(isolate, type_v.data(), type_v.size())
-      };
-      args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
-    } else {
-      args.GetReturnValue().Set(names);
+  GlobWalker walker(cwd.ToString(), nocase);
+  FS_SYNC_TRACE_BEGIN(glob);
+  for (const auto& segments : compiled) {
+    if (!walker.Walk(segments)) {
+      FS_SYNC_TRACE_END(glob);
+      return;
     }
   }
+  FS_SYNC_TRACE_END(glob);
+
+  Local<Value> result;
+  if (ToV8Value(context, walker.results(), isolate).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
 }
 
 static inline Maybe<void> AsyncCheckOpenPermissions(Environment* env,
@@ -2660,6 +4096,100 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+#if defined(__POSIX__) && !defined(__wasi__)
+// With the mmap option, regular files at least this large are mapped into
+// memory by readFileUtf8() and by fs.readFile()/fs.readFileSync() instead of
+// being read through an intermediate heap buffer.
+constexpr size_t kReadFileMmapThreshold = 4 * 1024 * 1024;
+
+// Maps the first |size| bytes of |fd|. The mapping is private and writable so
+// that Buffers backed by it can be modified without touching the file; pages
+// are only copied when they are written to. Returns nullptr on failure, in
+// which case the caller falls back to regular reads.
+static char* MmapFile(uv_file fd, size_t size) {
+  void* data =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) return nullptr;
+  madvise(data, size, MADV_WILLNEED);
+  return static_cast<char*>(data);
+}
+
+// Decodes a large regular file straight from a mapping of it into a string on
+// the V8 heap, without an intermediate copy. The string never refers to the
+// mapping, which is gone when this returns, so that later changes to the file
+// cannot change it. Returns false if |file| is not eligible, in which case
+// |result| is left untouched.
+static bool ReadFileUtf8Mapped(Isolate* isolate,
+                               uv_file file,
+                               MaybeLocal<Value>* result) {
+  uv_fs_t req;
+  auto cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+  if (uv_fs_fstat(nullptr, &req, file, nullptr) != 0 ||
+      !S_ISREG(req.statbuf.st_mode)) {
+    return false;
+  }
+  const size_t size = static_cast<size_t>(req.statbuf.st_size);
+  if (size < kReadFileMmapThreshold ||
+      size > static_cast<size_t>(String::kMaxLength)) {
+    return false;
+  }
+
+  char* data = MmapFile(file, size);
+  if (data == nullptr) return false;
+
+  if (simdutf::validate_ascii(data, size)) {
+    *result = String::NewFromOneByte(isolate,
+                                     reinterpret_cast<const uint8_t*>(data),
+                                     v8::NewStringType::kNormal,
+                                     static_cast<int>(size));
+  } else {
+    *result = String::NewFromUtf8(
+        isolate, data, v8::NewStringType::kNormal, static_cast<int>(size));
+  }
+  munmap(data, size);
+  return true;
+}
+#endif  // defined(__POSIX__) && !defined(__wasi__)
+
+// Maps a regular file that was just opened by fs.readFile() or
+// fs.readFileSync() with the mmap option and returns a Buffer that views the
+// mapping, or undefined if the file could not be mapped. The Buffer sees
+// changes that other processes make to the file, and accessing it after the
+// file has been truncated raises SIGBUS, which is why this is opt-in.
+//
+// mapFile(fd, size)
+static void MapFile(const FunctionCallbackInfo<Value>& args) {
+#if defined(__POSIX__) && !defined(__wasi__)
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsInt32());
+  CHECK(IsSafeJsInt(args[1]));
+  const uv_file fd = args[0].As<Int32>()->Value();
+  const size_t size = static_cast<size_t>(args[1].As<Integer>()->Value());
+
+  char* data = MmapFile(fd, size);
+  if (data == nullptr) return;
+
+  std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
+      data,
+      size,
+      [](void* data, size_t length, void*) { munmap(data, length); },
+      nullptr);
+  Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(), std::move(store));
+  // Like other Buffers over memory that V8 does not own. This also keeps
+  // strings from sharing the mapping, see ToStringWithoutCopy().
+  if (ab->SetPrivate(env->context(),
+                     env->untransferable_object_private_symbol(),
+                     True(env->isolate()))
+          .IsNothing()) {
+    return;
+  }
+  Local<Value> buffer;
+  if (Buffer::New(env, ab, 0, size).ToLocal(&buffer)) {
+    args.GetReturnValue().Set(buffer);
+  }
+#endif  // defined(__POSIX__) && !defined(__wasi__)
+}
+
 static void ReadFileUtf8(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   auto isolate = env->isolate();
@@ -2703,6 +4233,22 @@ static void ReadFileUtf8(const FunctionCallbackInfo<Value>& args) {
     uv_fs_req_cleanup(&req);
   });
 
+#if defined(__POSIX__) && !defined(__wasi__)
+  // A user-supplied fd is read from its current position, which a mapping
+  // of the whole file would not honor.
+  if (!is_fd && args[2]->IsTrue()) {
+    MaybeLocal<Value> mapped;
+    FS_SYNC_TRACE_BEGIN(read);
+    bool handled = ReadFileUtf8Mapped(isolate, file, &mapped);
+    FS_SYNC_TRACE_END(read);
+    if (handled) {
+      Local<Value> val;
+      if (mapped.ToLocal(&val)) args.GetReturnValue().Set(val);
+      return;
+    }
+  }
+#endif  // defined(__POSIX__) && !defined(__wasi__)
+
   std::string result{};
   char buffer[8192];
   uv_buf_t buf = uv_buf_init(buffer, sizeof(buffer));
@@ -3427,6 +4973,108 @@ bool isInsideDir(const std::filesystem::path& src,
   return std::equal(srcArr.begin(), srcArr.end(), destArr.begin());
 }
 
+// Copies the regular files collected while walking a cpSync() tree. The walk
+// itself stays on the calling thread so that every directory exists before the
+// files inside it are copied; the copies are then spread over a few threads.
+// uv_fs_copyfile() tries a reflink (FICLONE/clonefile) first and falls back to
+// copy_file_range()/sendfile() where available.
+class CpSyncFileCopier {
+ public:
+  struct Entry {
+    std::filesystem::path src;
+    std::filesystem::path dest;
+  };
+
+  CpSyncFileCopier(bool force, bool error_on_exist)
+      : force_(force), error_on_exist_(error_on_exist) {}
+
+  void Add(std::filesystem::path src, std::filesystem::path dest) {
+    entries_.push_back({std::move(src), std::move(dest)});
+  }
+
+  const std::vector<Entry>& entries() const { return entries_; }
+
+  // Returns false and throws a JS exception if any copy failed.
+  bool Run(Environment* env) {
+    const size_t threads = std::min<size_t>(
+        entries_.size() / kMinFilesPerThread,
+        std::min<size_t>(uv_available_parallelism(), kMaxThreads));
+    if (threads < 2) {
+      CopyFiles();
+    } else {
+      std::vector<uv_thread_t> workers(threads);
+      size_t started = 0;
+      for (; started < threads; started++) {
+        if (uv_thread_create(&workers[started],
+                             [](void* data) {
+                               static_cast<CpSyncFileCopier*>(data)
+                                   ->CopyFiles();
+                             },
+                             this) != 0) {
+          break;
+        }
+      }
+      // Make progress even if no thread could be started.
+      if (started == 0) CopyFiles();
+      for (size_t i = 0; i < started; i++) {
+        CHECK_EQ(uv_thread_join(&workers[i]), 0);
+      }
+    }
+
+    if (error_ == 0) return true;
+    const Entry& entry = entries_[error_index_];
+    auto dest_str = PathToString(entry.dest);
+    if (error_ == UV_EEXIST) {
+      THROW_ERR_FS_CP_EEXIST(env->isolate(),
+                             "[ERR_FS_CP_EEXIST]: Target already exists: "
+                             "cp returned EEXIST (%s already exists)",
+                             dest_str.c_str());
+      return false;
+    }
+    auto dest_dir_str = PathToString(entry.dest.parent_path());
+    env->ThrowUVException(error_, "cp", nullptr, dest_dir_str.c_str());
+    return false;
+  }
+
+ private:
+  static constexpr size_t kMinFilesPerThread = 16;
+  static constexpr size_t kMaxThreads = 8;
+
+  void CopyFiles() {
+    const int flags = UV_FS_COPYFILE_FICLONE | (force_ ? 0 : UV_FS_COPYFILE_EXCL);
+    for (;;) {
+      const size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= entries_.size() || failed_.load(std::memory_order_relaxed))
+        return;
+      auto src_str = PathToString(entries_[index].src);
+      auto dest_str = PathToString(entries_[index].dest);
+      uv_fs_t req;
+      int err = uv_fs_copyfile(
+          nullptr, &req, src_str.c_str(), dest_str.c_str(), flags, nullptr);
+      uv_fs_req_cleanup(&req);
+      // Without `force`, existing files are either skipped or an error.
+      if (err == UV_EEXIST && !error_on_exist_) err = 0;
+      if (err != 0) {
+        Mutex::ScopedLock lock(mutex_);
+        if (!failed_.exchange(true)) {
+          error_ = err;
+          error_index_ = index;
+        }
+        return;
+      }
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::atomic<size_t> next_{0};
+  std::atomic<bool> failed_{false};
+  Mutex mutex_;
+  int error_ = 0;
+  size_t error_index_ = 0;
+  bool force_;
+  bool error_on_exist_;
+};
+
 static void CpSyncCopyDir(const FunctionCallbackInfo<Value>& args) {
   CHECK_EQ(args.Length(), 7);  // src, dest, force, dereference, errorOnExist,
                                // verbatimSymlinks, preserveTimestamps
@@ -3454,26 +5102,17 @@ static void CpSyncCopyDir(const FunctionCallbackInfo<Value>& args) {
     return env->ThrowStdErrException(error, "cp", *dest);
   }
 
-  auto file_copy_opts = std::filesystem::copy_options::recursive;
-  if (force) {
-    file_copy_opts |= std::filesystem::copy_options::overwrite_existing;
-  } else if (error_on_exist) {
-    file_copy_opts |= std::filesystem::copy_options::none;
-  } else {
-    file_copy_opts |= std::filesystem::copy_options::skip_existing;
-  }
+  CpSyncFileCopier file_copier(force, error_on_exist);
 
   std::function<bool(std::filesystem::path, std::filesystem::path)>
       copy_dir_contents;
   copy_dir_contents = [verbatim_symlinks,
                        &copy_dir_contents,
                        &env,
-                       file_copy_opts,
-                       preserve_timestamps,
+                       &file_copier,
                        force,
                        error_on_exist,
-                       dereference,
-                       &isolate](std::filesystem::path src,
+                       dereference](std::filesystem::path src,
                                  std::filesystem::path dest) {
     std::error_code error;
     for (auto dir_entry : std::filesystem::directory_iterator(src)) {
@@ -3572,30 +5211,23 @@ static void CpSyncCopyDir(const FunctionCallbackInfo<Value>& args) {
           return false;
         }
       } else if (dir_entry.is_regular_file()) {
-        std::filesystem::copy_file(
-            dir_entry.path(), dest_file_path, file_copy_opts, error);
-        if (error) {
-          if (error.value() == EEXIST) {
-            THROW_ERR_FS_CP_EEXIST(isolate,
-                                   "[ERR_FS_CP_EEXIST]: Target already exists: "
-                                   "cp returned EEXIST (%s already exists)",
-                                   dest_file_path.c_str());
-            return false;
-          }
-          env->ThrowStdErrException(error, "cp", dest_str.c_str());
-          return false;
-        }
-
-        if (preserve_timestamps &&
-            !CopyUtimes(dir_entry.path(), dest_file_path, env)) {
-          return false;
-        }
+        file_copier.Add(dir_entry.path(), dest_file_path);
       }
     }
     return true;
   };
 
-  copy_dir_contents(std::filesystem::path(*src), std::filesystem::path(*dest));
+  if (!copy_dir_contents(std::filesystem::path(*src),
+                         std::filesystem::path(*dest)) ||
+      !file_copier.Run(env)) {
+    return;
+  }
+
+  if (preserve_timestamps) {
+    for (const auto& entry : file_copier.entries()) {
+      if (!CopyUtimes(entry.src, entry.dest, env)) return;
+    }
+  }
 }
 
 BindingData::FilePathIsFileReturnType BindingData::FilePathIsFile(
@@ -3606,16 +5238,7 @@ BindingData::FilePathIsFileReturnType BindingData::FilePathIsFile(
       file_path,
       BindingData::FilePathIsFileReturnType::kThrowInsufficientPermissions);
 
-  uv_fs_t req;
-
-  int rc = uv_fs_stat(env->event_loop(), &req, file_path.c_str(), nullptr);
-
-  if (rc == 0) {
-    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
-    rc = S_ISDIR(s->st_mode);
-  }
-
-  uv_fs_req_cleanup(&req);
+  int rc = ModuleStat(env, file_path.c_str());
 
   // rc is 0 if the path refers to a file
   if (rc == 0) return BindingData::FilePathIsFileReturnType::kIsFile;
@@ -3894,6 +5517,7 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(isolate, target, "openFileHandle", OpenFileHandle);
   SetMethod(isolate, target, "read", Read);
   SetMethod(isolate, target, "readFileUtf8", ReadFileUtf8);
+  SetMethod(isolate, target, "mapFile", MapFile);
   SetMethod(isolate, target, "readBuffers", ReadBuffers);
   SetMethod(isolate, target, "fdatasync", Fdatasync);
   SetMethod(isolate, target, "fsync", Fsync);
@@ -3901,13 +5525,23 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(isolate, target, "ftruncate", FTruncate);
   SetMethod(isolate, target, "rmdir", RMDir);
   SetMethod(isolate, target, "rmSync", RmSync);
+  SetMethod(isolate, target, "rmRecursive", RmRecursive);
   SetMethod(isolate, target, "mkdir", MKDir);
   SetMethod(isolate, target, "readdir", ReadDir);
+  SetMethod(isolate, target, "readdirRecursive", ReadDirRecursive);
+  SetMethod(isolate, target, "glob", Glob);
   SetMethod(isolate, target, "internalModuleStat", InternalModuleStat);
+  SetMethod(isolate,
+            target,
+            "getModuleStatCacheStats",
+            GetModuleStatCacheStats);
+  SetMethod(isolate, target, "clearModuleStatCache", ClearModuleStatCache);
   SetMethod(isolate, target, "stat", Stat);
   SetMethod(isolate, target, "lstat", LStat);
   SetMethod(isolate, target, "fstat", FStat);
   SetMethod(isolate, target, "statfs", StatFs);
+  SetMethod(isolate, target, "statMany", StatMany);
+  SetMethod(isolate, target, "readMany", ReadMany);
   SetMethod(isolate, target, "link", Link);
   SetMethod(isolate, target, "symlink", Symlink);
   SetMethod(isolate, target, "readlink", ReadLink);
@@ -3939,6 +5573,15 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
   StatWatcher::CreatePerIsolateProperties(isolate_data, target);
   BindingData::CreatePerIsolateProperties(isolate_data, target);
 
+#if defined(__POSIX__) && !defined(__wasi__)
+  target->Set(FIXED_ONE_BYTE_STRING(isolate, "kReadFileMmapThreshold"),
+              Number::New(isolate, static_cast<double>(kReadFileMmapThreshold)));
+#else
+  // Zero disables the mapFile() fast path on platforms without mmap().
+  target->Set(FIXED_ONE_BYTE_STRING(isolate, "kReadFileMmapThreshold"),
+              Integer::New(isolate, 0));
+#endif
+
   target->Set(
       FIXED_ONE_BYTE_STRING(isolate, "kFsStatsFieldsNumber"),
       Integer::New(isolate,
@@ -4019,6 +5662,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OpenFileHandle);
   registry->Register(Read);
   registry->Register(ReadFileUtf8);
+  registry->Register(MapFile);
   registry->Register(ReadBuffers);
   registry->Register(Fdatasync);
   registry->Register(Fsync);
@@ -4026,13 +5670,20 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(FTruncate);
   registry->Register(RMDir);
   registry->Register(RmSync);
+  registry->Register(RmRecursive);
   registry->Register(MKDir);
   registry->Register(ReadDir);
+  registry->Register(ReadDirRecursive);
+  registry->Register(Glob);
   registry->Register(InternalModuleStat);
+  registry->Register(GetModuleStatCacheStats);
+  registry->Register(ClearModuleStatCache);
   registry->Register(Stat);
   registry->Register(LStat);
   registry->Register(FStat);
   registry->Register(StatFs);
+  registry->Register(StatMany);
+  registry->Register(ReadMany);
   registry->Register(Link);
   registry->Register(Symlink);
   registry->Register(ReadLink);
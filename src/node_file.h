@@ -3,13 +3,18 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <deque>
 #include <optional>
+#include <unordered_map>
 #include "aliased_buffer.h"
 #include "node_messaging.h"
 #include "node_snapshotable.h"
 #include "stream_base.h"
 
 namespace node {
+
+class StatWatcherGroup;
+
 namespace fs {
 
 class FileHandleReadWrap;
@@ -83,6 +88,10 @@ class BindingData : public SnapshotableObject {
   std::vector<BaseObjectPtr<FileHandleReadWrap>>
       file_handle_read_wrap_freelist;
 
+  // StatWatchers polling at the same interval share one timer and one
+  // batched stat job per sweep. Groups delete themselves once empty.
+  std::unordered_map<uint32_t, StatWatcherGroup*> stat_watcher_groups;
+
   SERIALIZABLE_OBJECT_METHODS()
   SET_BINDING_ID(fs_binding_data)
 
@@ -312,6 +321,13 @@ class FileHandleReadWrap final : public ReqWrap<uv_fs_t> {
  private:
   FileHandle* file_handle_;
   uv_buf_t buffer_;
+  // Owns the memory behind buffer_ when it comes from the FileHandle's pool.
+  std::unique_ptr<char[]> chunk_;
+  int64_t offset_ = -1;
+  int64_t length_ = -1;
+  ssize_t result_ = 0;
+  uint64_t generation_ = 0;
+  bool done_ = false;
 
   friend class FileHandle;
 };
@@ -337,6 +353,15 @@ class FileHandle final : public AsyncWrap, public StreamBase {
 
   int GetFD() override { return fd_; }
 
+  // The range that ReadStart() would read next. StreamPipe uses these when
+  // it moves the data out of the file by itself, e.g. with sendfile().
+  int64_t read_offset() const { return read_offset_; }
+  int64_t read_length() const { return read_length_; }
+  inline void AdvanceRead(size_t bytes) {
+    read_offset_ += bytes;
+    if (read_length_ >= 0) read_length_ -= bytes;
+  }
+
   int Release();
 
   // Will asynchronously close the FD and return a Promise that will
@@ -437,6 +462,9 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   // Asynchronous close
   v8::MaybeLocal<v8::Promise> ClosePromise();
 
+  int DispatchRead(bool pooled);
+  void EmitCompletedReads();
+
   int fd_;
   bool closing_ = false;
   bool closed_ = false;
@@ -444,11 +472,24 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   int64_t read_offset_ = -1;
   int64_t read_length_ = -1;
 
-  BaseObjectPtr<FileHandleReadWrap> current_read_;
+  // Reads in the order in which they were issued. Reads issued ahead of a
+  // short read, EOF or error are dropped by bumping read_generation_.
+  std::deque<BaseObjectPtr<FileHandleReadWrap>> pending_reads_;
+  std::vector<std::unique_ptr<char[]>> read_buffer_pool_;
+  uint64_t read_generation_ = 0;
 
   BaseObjectPtr<BindingData> binding_data_;
 };
 
+// Drops all entries of the module stat cache, if it is enabled.
+void InvalidateModuleStatCache();
+
+// Synchronously stats every path, storing the result (or the libuv error)
+// at the same index. Safe to call from the threadpool.
+void StatPaths(const std::vector<std::string>& paths,
+               std::vector<uv_stat_t>* stats,
+               std::vector<int>* errors);
+
 int MKDirpSync(uv_loop_t* loop,
                uv_fs_t* req,
                const std::string& path,
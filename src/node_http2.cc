@@ -6,6 +6,7 @@
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_buffer.h"
+#include "node_diagnostics_channel.h"
 #include "node_http_common-inl.h"
 #include "node_mem-inl.h"
 #include "node_perf.h"
@@ -40,6 +41,7 @@ using v8::Isolate;
 using v8::Local;
 using v8::LocalVector;
 using v8::MaybeLocal;
+using v8::Name;
 using v8::NewStringType;
 using v8::Number;
 using v8::Object;
@@ -224,6 +226,17 @@ Http2Options::Http2Options(Http2State* http2_state, SessionType type) {
         static_cast<uint64_t>(buffer[IDX_OPTIONS_STREAM_RESET_BURST]),
         static_cast<uint64_t>(buffer[IDX_OPTIONS_STREAM_RESET_RATE]));
   }
+
+  // DATA payloads up to this size are copied next to the frame headers, so
+  // that frames from many streams end up in a few large socket writes.
+  if (flags & (1 << IDX_OPTIONS_WRITE_COALESCING_THRESHOLD)) {
+    set_write_coalescing_threshold(
+        buffer[IDX_OPTIONS_WRITE_COALESCING_THRESHOLD]);
+  }
+
+  if (flags & (1 << IDX_OPTIONS_AUTO_WINDOW_TUNING)) {
+    set_auto_window_tuning(buffer[IDX_OPTIONS_AUTO_WINDOW_TUNING] != 0);
+  }
 }
 
 #define GRABSETTING(entries, count, name)                                      \
@@ -584,6 +597,8 @@ Http2Session::Http2Session(Http2State* http2_state,
 
   max_outstanding_pings_ = opts.max_outstanding_pings();
   max_outstanding_settings_ = opts.max_outstanding_settings();
+  write_coalescing_threshold_ = opts.write_coalescing_threshold();
+  auto_window_tuning_ = opts.auto_window_tuning();
 
   local_custom_settings_.number = 0;
   remote_custom_settings_.number = 0;
@@ -1140,6 +1155,24 @@ int Http2Session::OnInvalidFrame(nghttp2_session* handle,
         session->invalid_frame_count_,
         max_invalid_frames,
         lib_error_code);
+
+  Environment* env = session->env();
+  if (diagnostics_channel::HasSubscribers(
+          env, diagnostics_channel::kHttp2NativeFrameInvalid)) {
+    Isolate* isolate = env->isolate();
+    HandleScope scope(isolate);
+    Context::Scope context_scope(env->context());
+    Local<Name> names[] = {
+        env->id_string(), env->type_string(), env->code_string()};
+    Local<Value> values[] = {Integer::New(isolate, frame->hd.stream_id),
+                             Integer::New(isolate, frame->hd.type),
+                             Integer::New(isolate, lib_error_code)};
+    diagnostics_channel::Publish(
+        env,
+        diagnostics_channel::kHttp2NativeFrameInvalid,
+        Object::New(isolate, Null(isolate), names, values, arraysize(names)));
+  }
+
   if (session->invalid_frame_count_++ > max_invalid_frames) {
     session->custom_recv_error_code_ = "ERR_HTTP2_TOO_MANY_INVALID_FRAMES";
     return 1;
@@ -1160,7 +1193,6 @@ int Http2Session::OnInvalidFrame(nghttp2_session* handle,
   if (nghttp2_is_fatal(lib_error_code) ||
       lib_error_code == NGHTTP2_ERR_STREAM_CLOSED ||
       lib_error_code == NGHTTP2_ERR_PROTO) {
-    Environment* env = session->env();
     Isolate* isolate = env->isolate();
     HandleScope scope(isolate);
     Local<Context> context = env->context();
@@ -1342,6 +1374,8 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
   // so that it can send a WINDOW_UPDATE frame. This is a critical part of
   // the flow control process in http2
   CHECK_EQ(nghttp2_session_consume_connection(handle, len), 0);
+  if (session->auto_window_tuning_)
+    session->SampleBandwidthDelayProduct(id, len);
   BaseObjectPtr<Http2Stream> stream = session->FindStream(id);
 
   // If the stream has been destroyed, ignore this chunk
@@ -1680,6 +1714,13 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   Local<Value> arg;
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
   if (ack) {
+    if (bdp_ping_outstanding_ &&
+        memcmp(frame->ping.opaque_data,
+               bdp_ping_payload_,
+               sizeof(bdp_ping_payload_)) == 0) {
+      return OnBandwidthDelayProductPingAck();
+    }
+
     BaseObjectPtr<Http2Ping> ping = PopPing();
 
     if (!ping) {
@@ -1706,6 +1747,66 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   MakeCallback(env()->http2session_on_ping_function(), 1, &arg);
 }
 
+void Http2Session::SampleBandwidthDelayProduct(int32_t id, size_t length) {
+  if (!bdp_ping_outstanding_) {
+    bdp_ping_sent_at_ = uv_hrtime();
+    // The payload is told apart from the ones of Http2Ping, which default to
+    // the time they were sent at.
+    uint64_t payload = ~bdp_ping_sent_at_;
+    memcpy(bdp_ping_payload_, &payload, sizeof(bdp_ping_payload_));
+    if (nghttp2_submit_ping(
+            session_.get(), NGHTTP2_FLAG_NONE, bdp_ping_payload_) == 0) {
+      bdp_ping_outstanding_ = true;
+      bdp_sample_ = 0;
+    }
+  }
+  bdp_sample_ += length;
+  // Streams that were opened before the windows grew still have the initial
+  // window.
+  GrowStreamWindow(id);
+}
+
+void Http2Session::GrowStreamWindow(int32_t id) {
+  nghttp2_session* s = session_.get();
+  int32_t window =
+      nghttp2_session_get_stream_effective_local_window_size(s, id);
+  // The window is negative if nghttp2 doesn't know the stream (yet).
+  if (window >= 0 && bdp_estimate_ > static_cast<uint32_t>(window)) {
+    nghttp2_session_set_local_window_size(
+        s, NGHTTP2_FLAG_NONE, id, bdp_estimate_);
+  }
+}
+
+void Http2Session::OnBandwidthDelayProductPingAck() {
+  bdp_ping_outstanding_ = false;
+  const double rtt = static_cast<double>(uv_hrtime() - bdp_ping_sent_at_);
+  bdp_rtt_ = bdp_rtt_ == 0 ? rtt : bdp_rtt_ + (rtt - bdp_rtt_) * 0.9;
+  Debug(this,
+        "bdp sample: %d bytes in %d ns",
+        bdp_sample_,
+        static_cast<uint64_t>(rtt));
+
+  if (bdp_sample_ < bdp_estimate_ * 2 / 3 ||
+      bdp_estimate_ >= kMaxAutoWindowSize) {
+    return;
+  }
+  const double bandwidth = bdp_sample_ / (bdp_rtt_ * 1.5);
+  if (bandwidth < bdp_max_bandwidth_) return;
+  bdp_max_bandwidth_ = bandwidth;
+
+  bdp_estimate_ = static_cast<uint32_t>(
+      std::min<uint64_t>(bdp_sample_ * 2, kMaxAutoWindowSize));
+  Debug(this, "growing windows to %u", bdp_estimate_);
+
+  nghttp2_session* s = session_.get();
+  if (bdp_estimate_ > static_cast<uint32_t>(
+          nghttp2_session_get_effective_local_window_size(s))) {
+    nghttp2_session_set_local_window_size(
+        s, NGHTTP2_FLAG_NONE, 0, bdp_estimate_);
+  }
+  for (const auto& [id, stream] : streams_) GrowStreamWindow(id);
+}
+
 // Called by OnFrameReceived when a complete SETTINGS frame has been received.
 void Http2Session::HandleSettingsFrame(const nghttp2_frame* frame) {
   Debug(this, "handling settings frame");
@@ -1872,6 +1973,11 @@ void Http2Session::ClearOutgoing(int status) {
         WriteWrap::FromObject(wrap)->Done(0);
       }
     }
+    // Keep the allocation around for the next round of writes, unless the
+    // callbacks above already queued new ones.
+    current_outgoing_buffers_.clear();
+    if (outgoing_buffers_.empty())
+      outgoing_buffers_.swap(current_outgoing_buffers_);
   }
 
   // Now that we've finished sending queued data, if there are any pending
@@ -1904,6 +2010,17 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
   outgoing_storage_.resize(offset + src_length);
   memcpy(&outgoing_storage_[offset], src, src_length);
 
+  // Consecutive copies are contiguous in the storage, so extend the previous
+  // copy if it is not tied to the completion of a write.
+  if (!outgoing_buffers_.empty()) {
+    NgHttp2StreamWrite& last = outgoing_buffers_.back();
+    if (last.buf.base == nullptr && !last.req_wrap) {
+      last.buf.len += src_length;
+      outgoing_length_ += src_length;
+      return;
+    }
+  }
+
   // Store with a base of `nullptr` initially, since future resizes
   // of the outgoing_buffers_ vector may invalidate the pointer.
   // The correct base pointers will be set later, before writing to the
@@ -1968,20 +2085,33 @@ uint8_t Http2Session::SendPendingData() {
 
   // Set the buffer base pointers for copied data that ended up in the
   // sessions's own storage since it might have shifted around during gathering.
-  // (Those are marked by having .base == nullptr.)
+  // (Those are marked by having .base == nullptr.) Adjacent copies are merged
+  // into a single buffer.
   size_t offset = 0;
   size_t i = 0;
+  bool previous_was_copy = false;
   for (const NgHttp2StreamWrite& write : outgoing_buffers_) {
     statistics_.data_sent += write.buf.len;
     if (write.buf.base == nullptr) {
-      bufs[i++] = uv_buf_init(
-          reinterpret_cast<char*>(outgoing_storage_.data() + offset),
-          write.buf.len);
+      if (previous_was_copy) {
+        bufs[i - 1].len += write.buf.len;
+      } else if (write.buf.len > 0) {
+        bufs[i++] = uv_buf_init(
+            reinterpret_cast<char*>(outgoing_storage_.data() + offset),
+            write.buf.len);
+        previous_was_copy = true;
+      }
       offset += write.buf.len;
     } else {
       bufs[i++] = write.buf;
+      previous_was_copy = false;
     }
   }
+  count = i;
+  if (count == 0) {
+    ClearOutgoing(0);
+    return 0;
+  }
 
   chunks_sent_since_last_write_++;
 
@@ -2030,18 +2160,36 @@ int Http2Session::OnSendData(
     CHECK(!stream->queue_.empty());
 
     NgHttp2StreamWrite& write = stream->queue_.front();
+    const size_t threshold = session->write_coalescing_threshold_;
     if (write.buf.len <= length) {
       // This write does not suffice by itself, so we can consume it completely.
       length -= write.buf.len;
-      session->PushOutgoingBuffer(std::move(write));
+      if (write.buf.len <= threshold) {
+        // Small writes are copied, so that they can be sent together with
+        // the frame header. An empty entry completes the write afterwards.
+        session->CopyDataIntoOutgoing(
+            reinterpret_cast<const uint8_t*>(write.buf.base), write.buf.len);
+        if (write.req_wrap) {
+          session->PushOutgoingBuffer(NgHttp2StreamWrite {
+            std::move(write.req_wrap), uv_buf_init(nullptr, 0)
+          });
+        }
+      } else {
+        session->PushOutgoingBuffer(std::move(write));
+      }
       stream->queue_.pop();
       continue;
     }
 
     // Slice off `length` bytes of the first write in the queue.
-    session->PushOutgoingBuffer(NgHttp2StreamWrite {
-      uv_buf_init(write.buf.base, length)
-    });
+    if (length <= threshold) {
+      session->CopyDataIntoOutgoing(
+          reinterpret_cast<const uint8_t*>(write.buf.base), length);
+    } else {
+      session->PushOutgoingBuffer(NgHttp2StreamWrite {
+        uv_buf_init(write.buf.base, length)
+      });
+    }
     write.buf.base += length;
     write.buf.len -= length;
     break;
@@ -2853,6 +3001,9 @@ void Http2Session::RefreshState(const FunctionCallbackInfo<Value>& args) {
       static_cast<double>(nghttp2_session_get_hd_deflate_dynamic_table_size(s));
   buffer[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE] =
       static_cast<double>(nghttp2_session_get_hd_inflate_dynamic_table_size(s));
+  buffer[IDX_SESSION_STATE_BDP_ESTIMATE] =
+      session->auto_window_tuning_ ? session->bdp_estimate_ : 0;
+  buffer[IDX_SESSION_STATE_BDP_RTT] = session->bdp_rtt_ / 1e6;
 }
 
 
@@ -39,6 +39,15 @@ constexpr size_t kDefaultMaxSettings = 10;
 // Default maximum total memory cap for Http2Session.
 constexpr uint64_t kDefaultMaxSessionMemory = 10000000;
 
+// DATA payloads up to this size are copied into the session's outgoing
+// storage, so that they are written together with the frames around them
+// rather than as separate buffers.
+constexpr size_t kDefaultWriteCoalescingThreshold = 1024;
+
+// With automatic window tuning, the connection and stream windows are grown
+// up to this size, as gRPC does.
+constexpr uint32_t kMaxAutoWindowSize = 16 * 1024 * 1024;
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 constexpr uint32_t DEFAULT_SETTINGS_HEADER_TABLE_SIZE = 4096;
 constexpr uint32_t DEFAULT_SETTINGS_ENABLE_PUSH = 1;
@@ -234,6 +243,22 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void set_write_coalescing_threshold(size_t threshold) {
+    write_coalescing_threshold_ = threshold;
+  }
+
+  size_t write_coalescing_threshold() const {
+    return write_coalescing_threshold_;
+  }
+
+  void set_auto_window_tuning(bool enabled) {
+    auto_window_tuning_ = enabled;
+  }
+
+  bool auto_window_tuning() const {
+    return auto_window_tuning_;
+  }
+
  private:
   Nghttp2OptionPointer options_;
   uint64_t max_session_memory_ = kDefaultMaxSessionMemory;
@@ -241,6 +266,8 @@ class Http2Options {
   PaddingStrategy padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = kDefaultMaxPings;
   size_t max_outstanding_settings_ = kDefaultMaxSettings;
+  size_t write_coalescing_threshold_ = kDefaultWriteCoalescingThreshold;
+  bool auto_window_tuning_ = false;
 };
 
 struct Http2Priority : public nghttp2_priority_spec {
@@ -818,6 +845,11 @@ class Http2Session : public AsyncWrap,
 
   void DecrefHeaders(const nghttp2_frame* frame);
 
+  // Automatic window tuning
+  void SampleBandwidthDelayProduct(int32_t id, size_t length);
+  void OnBandwidthDelayProductPingAck();
+  void GrowStreamWindow(int32_t id);
+
   // nghttp2 callbacks
   static int OnBeginHeadersCallback(
       nghttp2_session* session,
@@ -945,6 +977,23 @@ class Http2Session : public AsyncWrap,
   std::vector<NgHttp2StreamWrite> outgoing_buffers_;
   std::vector<uint8_t> outgoing_storage_;
   size_t outgoing_length_ = 0;
+  size_t write_coalescing_threshold_ = kDefaultWriteCoalescingThreshold;
+
+  // With automatic window tuning, a PING is sent when DATA is received and no
+  // such PING is outstanding. The DATA that is received until it is
+  // acknowledged is a sample of the bandwidth-delay product of the
+  // connection. When a sample gets close to the current estimate, and the
+  // bandwidth is at its highest so far, the estimate and the windows are
+  // doubled, as in gRPC's BDP estimator.
+  bool auto_window_tuning_ = false;
+  bool bdp_ping_outstanding_ = false;
+  uint8_t bdp_ping_payload_[8] = {};
+  uint64_t bdp_ping_sent_at_ = 0;
+  uint64_t bdp_sample_ = 0;
+  uint32_t bdp_estimate_ = NGHTTP2_INITIAL_WINDOW_SIZE;
+  double bdp_rtt_ = 0;  // In nanoseconds.
+  double bdp_max_bandwidth_ = 0;
+
   std::vector<int32_t> pending_rst_streams_;
   // Count streams that have been rejected while being opened. Exceeding a fixed
   // limit will result in the session being destroyed, as an indication of a
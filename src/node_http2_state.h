@@ -34,6 +34,8 @@ namespace http2 {
     IDX_SESSION_STATE_OUTBOUND_QUEUE_SIZE,
     IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE,
     IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE,
+    IDX_SESSION_STATE_BDP_ESTIMATE,
+    IDX_SESSION_STATE_BDP_RTT,
     IDX_SESSION_STATE_COUNT
   };
 
@@ -61,6 +63,8 @@ namespace http2 {
     IDX_OPTIONS_STREAM_RESET_RATE,
     IDX_OPTIONS_STREAM_RESET_BURST,
     IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION,
+    IDX_OPTIONS_WRITE_COALESCING_THRESHOLD,
+    IDX_OPTIONS_AUTO_WINDOW_TUNING,
     IDX_OPTIONS_FLAGS
   };
 
@@ -156,7 +156,7 @@ v8::MaybeLocal<v8::String> NgHeader<T>::GetName(
   // a statically defined name. We can safely internalize it here.
   if (header_name != nullptr) {
     auto& static_str_map = env_->isolate_data()->static_str_map;
-    v8::Eternal<v8::String> eternal = static_str_map[header_name];
+    v8::Eternal<v8::String>& eternal = static_str_map[header_name];
     if (eternal.IsEmpty()) {
       v8::Local<v8::String> str = OneByteString(env_->isolate(), header_name);
       eternal.Set(env_->isolate(), str);
@@ -183,6 +183,23 @@ std::string NgHeader<T>::value() const {
   return value_.str();
 }
 
+template <typename T>
+std::string_view NgHeader<T>::name_view() const {
+  return std::string_view(reinterpret_cast<const char*>(name_.data()),
+                          name_.len());
+}
+
+template <typename T>
+std::string_view NgHeader<T>::value_view() const {
+  return std::string_view(reinterpret_cast<const char*>(value_.data()),
+                          value_.len());
+}
+
+template <typename T>
+int32_t NgHeader<T>::token() const {
+  return T::ToHttpHeaderName(token_) != nullptr ? token_ : -1;
+}
+
 template <typename T>
 size_t NgHeader<T>::length() const {
   return name_.len() + value_.len();
@@ -7,6 +7,7 @@
 #include "node_mem.h"
 
 #include <string>
+#include <string_view>
 
 namespace node {
 
@@ -463,6 +464,11 @@ struct NgHeaderBase : public MemoryRetainer {
   virtual v8::MaybeLocal<v8::String> GetValue(allocator_t* allocator) const = 0;
   virtual std::string name() const = 0;
   virtual std::string value() const = 0;
+  // The raw bytes of the name and value, valid while the header is alive.
+  virtual std::string_view name_view() const = 0;
+  virtual std::string_view value_view() const = 0;
+  // The token that identifies a well-known header name, or -1.
+  virtual int32_t token() const = 0;
   virtual size_t length() const = 0;
   virtual uint8_t flags() const = 0;
   virtual std::string ToString() const;
@@ -509,6 +515,9 @@ class NgHeader final : public NgHeaderBase<typename T::allocator_t> {
 
   inline std::string name() const override;
   inline std::string value() const override;
+  inline std::string_view name_view() const override;
+  inline std::string_view value_view() const override;
+  inline int32_t token() const override;
   inline size_t length() const override;
   inline uint8_t flags() const override;
 
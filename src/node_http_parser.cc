@@ -27,12 +27,18 @@
 #include "env-inl.h"
 #include "llhttp.h"
 #include "memory_tracker-inl.h"
+#include "node_diagnostics_channel.h"
 #include "node_external_reference.h"
 #include "stream_base-inl.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <list>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -51,6 +57,9 @@ namespace node {
 namespace http_parser {  // NOLINT(build/namespaces)
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
+using v8::BackingStoreInitializationMode;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -65,11 +74,14 @@ using v8::Isolate;
 using v8::Local;
 using v8::LocalVector;
 using v8::MaybeLocal;
+using v8::Name;
+using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -85,6 +97,41 @@ const size_t kMaxHeaderFieldsCount = 32;
 // Maximum size of chunk extensions
 const size_t kMaxChunkExtensionsSize = 16384;
 
+// Header names that are passed to JS as an index into this list when the
+// parser delivers flat headers, instead of being copied into the buffer.
+// Exposed to JS as `commonHeaders`.
+constexpr std::string_view kCommonHeaders[] = {
+    "Host", "host",
+    "User-Agent", "user-agent",
+    "Accept", "accept",
+    "Accept-Encoding", "accept-encoding",
+    "Accept-Language", "accept-language",
+    "Connection", "connection",
+    "Content-Type", "content-type",
+    "Content-Length", "content-length",
+    "Cookie", "cookie",
+    "Authorization", "authorization",
+    "Cache-Control", "cache-control",
+    "Origin", "origin",
+    "Referer", "referer",
+    "If-None-Match", "if-none-match",
+    "If-Modified-Since", "if-modified-since",
+    "Transfer-Encoding", "transfer-encoding",
+    "X-Forwarded-For", "x-forwarded-for",
+    "X-Request-Id", "x-request-id",
+    "Date", "date",
+    "Server", "server",
+    "Set-Cookie", "set-cookie",
+    "ETag", "etag",
+    "Last-Modified", "last-modified",
+    "Location", "location",
+    "Vary", "vary",
+    "Keep-Alive", "keep-alive",
+    "Upgrade", "upgrade",
+};
+// Marks an offset as an index into kCommonHeaders.
+const uint32_t kCommonHeaderFlag = 1u << 31;
+
 const uint32_t kLenientNone = 0;
 const uint32_t kLenientHeaders = 1 << 0;
 const uint32_t kLenientChunkedLength = 1 << 1;
@@ -122,59 +169,113 @@ class BindingData : public BaseObject {
   SET_MEMORY_INFO_NAME(BindingData)
 };
 
-// helper class for the Parser
-struct StringPtr {
-  StringPtr() {
-    on_heap_ = false;
-    Reset();
+// A bump allocator for the strings of the Parser, i.e. the header fields and
+// values, the URL and the status message. It is reset at the start of every
+// message, so a parser does not allocate memory per header, and the amount
+// of memory it holds is bounded by the maximum header size.
+class HeaderArena {
+ public:
+  char* Allocate(size_t size) {
+    if (blocks_.empty() || blocks_.back().size - used_ < size) {
+      // Leave room for the allocation to grow in place.
+      size_t block_size = std::max(kBlockSize, size * 2);
+      blocks_.push_back({std::make_unique<char[]>(block_size), block_size});
+      used_ = 0;
+    }
+    char* data = blocks_.back().data.get() + used_;
+    used_ += size;
+    return data;
+  }
+
+
+  // If `data`, of `size` bytes, is the most recent allocation and there is
+  // room for `extra` more bytes behind it, grows it and returns a pointer to
+  // the additional bytes. Otherwise, returns nullptr.
+  char* Extend(const char* data, size_t size, size_t extra) {
+    if (blocks_.empty()) return nullptr;
+    Block& block = blocks_.back();
+    if (data + size != block.data.get() + used_ ||
+        block.size - used_ < extra) {
+      return nullptr;
+    }
+    char* tail = block.data.get() + used_;
+    used_ += extra;
+    return tail;
+  }
+
+
+  // Releases all allocations. Only the largest block is kept for the next
+  // message.
+  void Reset() {
+    if (blocks_.size() > 1) {
+      auto largest = std::max_element(
+          blocks_.begin(), blocks_.end(), [](const Block& a, const Block& b) {
+            return a.size < b.size;
+          });
+      Block block = std::move(*largest);
+      blocks_.clear();
+      blocks_.push_back(std::move(block));
+    }
+    used_ = 0;
   }
 
+ private:
+  static constexpr size_t kBlockSize = 4096;
+
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  // The number of bytes that are in use in the last block.
+  size_t used_ = 0;
+};
 
-  ~StringPtr() {
+// helper class for the Parser
+struct StringPtr {
+  StringPtr() {
     Reset();
   }
 
 
-  // If str_ does not point to a heap string yet, this function makes it do
+  // If str_ does not point into the arena yet, this function makes it do
   // so. This is called at the end of each http_parser_execute() so as not
   // to leak references. See issue #2438 and test-http-parser-bad-ref.js.
-  void Save() {
-    if (!on_heap_ && size_ > 0) {
-      char* s = new char[size_];
+  void Save(HeaderArena* arena) {
+    if (!in_arena_ && size_ > 0) {
+      char* s = arena->Allocate(size_);
       memcpy(s, str_, size_);
       str_ = s;
-      on_heap_ = true;
+      in_arena_ = true;
     }
   }
 
 
+  // The memory in the arena is released by HeaderArena::Reset().
   void Reset() {
-    if (on_heap_) {
-      delete[] str_;
-      on_heap_ = false;
-    }
-
     str_ = nullptr;
+    in_arena_ = false;
     size_ = 0;
   }
 
 
-  void Update(const char* str, size_t size) {
+  void Update(const char* str, size_t size, HeaderArena* arena) {
     if (str_ == nullptr) {
       str_ = str;
-    } else if (on_heap_ || str_ + size_ != str) {
-      // Non-consecutive input, make a copy on the heap.
-      // TODO(bnoordhuis) Use slab allocation, O(n) allocs is bad.
-      char* s = new char[size_ + size];
-      memcpy(s, str_, size_);
-      memcpy(s + size_, str, size);
-
-      if (on_heap_)
-        delete[] str_;
-      else
-        on_heap_ = true;
-
-      str_ = s;
+    } else if (in_arena_ || str_ + size_ != str) {
+      // Non-consecutive input, make a copy in the arena. A copy that is
+      // already there is usually the most recent allocation, so it can grow
+      // in place.
+      char* tail = in_arena_ ? arena->Extend(str_, size_, size) : nullptr;
+      if (tail == nullptr) {
+        char* s = arena->Allocate(size_ + size);
+        memcpy(s, str_, size_);
+        str_ = s;
+        in_arena_ = true;
+        tail = s + size_;
+      }
+      memcpy(tail, str, size);
     }
     size_ += size;
   }
@@ -188,6 +289,16 @@ struct StringPtr {
   }
 
 
+  // Returns the size of the string without trailing OWS (SPC or HTAB).
+  size_t TrimmedSize() const {
+    size_t size = size_;
+    while (size > 0 && IsOWS(str_[size - 1])) {
+      size--;
+    }
+    return size;
+  }
+
+
   // Strip trailing OWS (SPC or HTAB) from string.
   Local<String> ToTrimmedString(Environment* env) {
     while (size_ > 0 && IsOWS(str_[size_ - 1])) {
@@ -198,18 +309,29 @@ struct StringPtr {
 
 
   const char* str_;
-  bool on_heap_;
+  bool in_arena_;
   size_t size_;
 };
 
 class Parser;
 
-struct ParserComparator {
-  bool operator()(const Parser* lhs, const Parser* rhs) const;
-};
-
+// Tracks the connections of a server for closeAllConnections(),
+// closeIdleConnections() and the headers and request timeouts.
+//
+// Parsers are appended to the active and headers lists when a message starts,
+// that is with the current time as last_message_start_, and the timeouts are
+// the same for all of them. Both lists are therefore ordered by
+// last_message_start_, and expiring connections only needs to look at the
+// front of each list.
 class ConnectionsList : public BaseObject {
  public:
+    // The position of a Parser in one of the lists, so that it can be removed
+    // in constant time.
+    struct Entry {
+      std::list<Parser*>* list = nullptr;
+      std::list<Parser*>::iterator position;
+    };
+
     static void New(const FunctionCallbackInfo<Value>& args);
 
     static void All(const FunctionCallbackInfo<Value>& args);
@@ -220,21 +342,13 @@ class ConnectionsList : public BaseObject {
 
     static void Expired(const FunctionCallbackInfo<Value>& args);
 
-    void Push(Parser* parser) {
-      all_connections_.insert(parser);
-    }
-
-    void Pop(Parser* parser) {
-      all_connections_.erase(parser);
-    }
-
-    void PushActive(Parser* parser) {
-      active_connections_.insert(parser);
-    }
-
-    void PopActive(Parser* parser) {
-      active_connections_.erase(parser);
-    }
+    inline void Push(Parser* parser);
+    inline void Pop(Parser* parser);
+    // Must be called when a message starts, after last_message_start_ has
+    // been set.
+    inline void PushActive(Parser* parser);
+    inline void PopActive(Parser* parser);
+    inline void HeadersCompleted(Parser* parser);
 
     SET_NO_MEMORY_INFO()
     SET_MEMORY_INFO_NAME(ConnectionsList)
@@ -246,13 +360,27 @@ class ConnectionsList : public BaseObject {
         MakeWeak();
       }
 
-    std::set<Parser*, ParserComparator> all_connections_;
-    std::set<Parser*, ParserComparator> active_connections_;
+    static void Link(std::list<Parser*>* list, Entry* entry, Parser* parser) {
+      Unlink(entry);
+      entry->list = list;
+      entry->position = list->insert(list->end(), parser);
+    }
+
+    static void Unlink(Entry* entry) {
+      if (entry->list == nullptr) return;
+      entry->list->erase(entry->position);
+      entry->list = nullptr;
+    }
+
+    std::list<Parser*> all_connections_;
+    // Connections with a message in progress.
+    std::list<Parser*> active_connections_;
+    // The active connections that have not received all headers yet.
+    std::list<Parser*> headers_connections_;
 };
 
 class Parser : public AsyncWrap, public StreamListener {
   friend class ConnectionsList;
-  friend struct ParserComparator;
 
  public:
   Parser(BindingData* binding_data, Local<Object> wrap)
@@ -267,22 +395,15 @@ class Parser : public AsyncWrap, public StreamListener {
   SET_SELF_SIZE(Parser)
 
   int on_message_begin() {
-    // Important: Pop from the lists BEFORE resetting the last_message_start_
-    // otherwise std::set.erase will fail.
-    if (connectionsList_ != nullptr) {
-      connectionsList_->Pop(this);
-      connectionsList_->PopActive(this);
-    }
-
     num_fields_ = num_values_ = 0;
     headers_completed_ = false;
     chunk_extensions_nread_ = 0;
     last_message_start_ = uv_hrtime();
     url_.Reset();
     status_message_.Reset();
+    header_arena_.Reset();
 
     if (connectionsList_ != nullptr) {
-      connectionsList_->Push(this);
       connectionsList_->PushActive(this);
     }
 
@@ -308,7 +429,7 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
-    url_.Update(at, length);
+    url_.Update(at, length, &header_arena_);
     return 0;
   }
 
@@ -319,7 +440,7 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
-    status_message_.Update(at, length);
+    status_message_.Update(at, length, &header_arena_);
     return 0;
   }
 
@@ -345,7 +466,7 @@ class Parser : public AsyncWrap, public StreamListener {
     CHECK_LT(num_fields_, kMaxHeaderFieldsCount);
     CHECK_EQ(num_fields_, num_values_ + 1);
 
-    fields_[num_fields_ - 1].Update(at, length);
+    fields_[num_fields_ - 1].Update(at, length, &header_arena_);
 
     return 0;
   }
@@ -366,7 +487,7 @@ class Parser : public AsyncWrap, public StreamListener {
     CHECK_LT(num_values_, arraysize(values_));
     CHECK_EQ(num_values_, num_fields_);
 
-    values_[num_values_ - 1].Update(at, length);
+    values_[num_values_ - 1].Update(at, length, &header_arena_);
 
     return 0;
   }
@@ -376,6 +497,10 @@ class Parser : public AsyncWrap, public StreamListener {
     headers_completed_ = true;
     header_nread_ = 0;
 
+    if (connectionsList_ != nullptr) {
+      connectionsList_->HeadersCompleted(this);
+    }
+
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
     // `parserOnHeadersComplete` in lib/_http_common.js.
@@ -409,7 +534,7 @@ class Parser : public AsyncWrap, public StreamListener {
       Flush();
     } else {
       // Fast case, pass headers and URL to JS land.
-      argv[A_HEADERS] = CreateHeaders();
+      argv[A_HEADERS] = flat_headers_ ? CreateFlatHeaders() : CreateHeaders();
       if (parser_.type == HTTP_REQUEST)
         argv[A_URL] = url_.ToString(env());
     }
@@ -493,19 +618,12 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_message_complete() {
     HandleScope scope(env()->isolate());
 
-    // Important: Pop from the lists BEFORE resetting the last_message_start_
-    // otherwise std::set.erase will fail.
     if (connectionsList_ != nullptr) {
-      connectionsList_->Pop(this);
       connectionsList_->PopActive(this);
     }
 
     last_message_start_ = 0;
 
-    if (connectionsList_ != nullptr) {
-      connectionsList_->Push(this);
-    }
-
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -593,16 +711,18 @@ class Parser : public AsyncWrap, public StreamListener {
     }
   }
 
+  // The strings are saved in the order in which they are parsed, so that the
+  // one that may continue in the next chunk is the most recent allocation in
+  // the arena and can grow in place.
   void Save() {
-    url_.Save();
-    status_message_.Save();
+    url_.Save(&header_arena_);
+    status_message_.Save(&header_arena_);
 
     for (size_t i = 0; i < num_fields_; i++) {
-      fields_[i].Save();
-    }
-
-    for (size_t i = 0; i < num_values_; i++) {
-      values_[i].Save();
+      fields_[i].Save(&header_arena_);
+      if (i < num_values_) {
+        values_[i].Save(&header_arena_);
+      }
     }
   }
 
@@ -637,6 +757,7 @@ class Parser : public AsyncWrap, public StreamListener {
     uint64_t max_http_header_size = 0;
     uint32_t lenient_flags = kLenientNone;
     ConnectionsList* connectionsList = nullptr;
+    bool flat_headers = false;
 
     CHECK(args[0]->IsInt32());
     CHECK(args[1]->IsObject());
@@ -660,6 +781,11 @@ class Parser : public AsyncWrap, public StreamListener {
       ASSIGN_OR_RETURN_UNWRAP(&connectionsList, args[4]);
     }
 
+    if (args.Length() > 5) {
+      CHECK(args[5]->IsBoolean());
+      flat_headers = args[5]->IsTrue();
+    }
+
     llhttp_type_t type =
         static_cast<llhttp_type_t>(args[0].As<Int32>()->Value());
 
@@ -676,7 +802,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type, max_http_header_size, lenient_flags);
+    parser->Init(type, max_http_header_size, lenient_flags, flat_headers);
 
     if (connectionsList != nullptr) {
       parser->connectionsList_ = connectionsList;
@@ -686,8 +812,6 @@ class Parser : public AsyncWrap, public StreamListener {
       // server.timeout is left to the default value of zero.
       parser->last_message_start_ = uv_hrtime();
 
-      // Important: Push into the lists AFTER setting the last_message_start_
-      // otherwise std::set.erase will fail later.
       parser->connectionsList_->Push(parser);
       parser->connectionsList_->PushActive(parser);
     } else {
@@ -879,6 +1003,21 @@ class Parser : public AsyncWrap, public StreamListener {
 
       obj->Set(env()->context(), env()->code_string(), code).Check();
       obj->Set(env()->context(), env()->reason_string(), reason).Check();
+
+      if (diagnostics_channel::HasSubscribers(
+              env(), diagnostics_channel::kHttpNativeParserError)) {
+        Isolate* isolate = env()->isolate();
+        Local<Name> names[] = {
+            env()->code_string(),
+            env()->reason_string(),
+            env()->bytes_parsed_string()};
+        Local<Value> values[] = {code, reason, nread_obj};
+        diagnostics_channel::Publish(
+            env(),
+            diagnostics_channel::kHttpNativeParserError,
+            Object::New(
+                isolate, Null(isolate), names, values, arraysize(names)));
+      }
       return scope.Escape(e);
     }
 
@@ -902,6 +1041,65 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  static int FindCommonHeader(const StringPtr& field) {
+    for (size_t i = 0; i < arraysize(kCommonHeaders); i++) {
+      const std::string_view& name = kCommonHeaders[i];
+      if (name.size() == field.size_ &&
+          memcmp(name.data(), field.str_, field.size_) == 0) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+
+  // Copies the header fields and values into a single buffer, followed by
+  // the offsets in that buffer at which each of them ends, and returns a
+  // Uint32Array of those offsets. Fields that are one of kCommonHeaders are
+  // not copied, their offset is kCommonHeaderFlag plus their index instead.
+  // lib/_http_incoming.js creates the strings when they are first needed.
+  Local<Value> CreateFlatHeaders() {
+    int common[kMaxHeaderFieldsCount];
+    size_t length = 0;
+
+    for (size_t i = 0; i < num_values_; ++i) {
+      common[i] = FindCommonHeader(fields_[i]);
+      if (common[i] < 0) length += fields_[i].size_;
+      length += values_[i].TrimmedSize();
+    }
+
+    // The offsets need to be aligned for the Uint32Array.
+    const size_t offsets_start =
+        (length + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+    const size_t count = num_values_ * 2;
+    std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+        env()->isolate(),
+        offsets_start + count * sizeof(uint32_t),
+        BackingStoreInitializationMode::kUninitialized);
+    char* data = static_cast<char*>(bs->Data());
+    uint32_t* offsets = reinterpret_cast<uint32_t*>(data + offsets_start);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < num_values_; ++i) {
+      if (common[i] >= 0) {
+        offsets[i * 2] = kCommonHeaderFlag | static_cast<uint32_t>(common[i]);
+      } else {
+        memcpy(data + offset, fields_[i].str_, fields_[i].size_);
+        offset += fields_[i].size_;
+        offsets[i * 2] = static_cast<uint32_t>(offset);
+      }
+      const size_t value_size = values_[i].TrimmedSize();
+      memcpy(data + offset, values_[i].str_, value_size);
+      offset += value_size;
+      offsets[i * 2 + 1] = static_cast<uint32_t>(offset);
+    }
+    CHECK_EQ(offset, length);
+
+    Local<ArrayBuffer> ab = ArrayBuffer::New(env()->isolate(), std::move(bs));
+    return Uint32Array::New(ab, offsets_start, count);
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -930,7 +1128,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   void Init(llhttp_type_t type, uint64_t max_http_header_size,
-            uint32_t lenient_flags) {
+            uint32_t lenient_flags, bool flat_headers) {
     llhttp_init(&parser_, type, &settings);
 
     if (lenient_flags & kLenientHeaders) {
@@ -967,12 +1165,14 @@ class Parser : public AsyncWrap, public StreamListener {
     header_nread_ = 0;
     url_.Reset();
     status_message_.Reset();
+    header_arena_.Reset();
     num_fields_ = 0;
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
     headers_completed_ = false;
     max_http_header_size_ = max_http_header_size;
+    flat_headers_ = flat_headers;
   }
 
 
@@ -1006,6 +1206,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   llhttp_t parser_;
+  HeaderArena header_arena_;
   StringPtr fields_[kMaxHeaderFieldsCount];  // header fields
   StringPtr values_[kMaxHeaderFieldsCount];  // header values
   StringPtr url_;
@@ -1018,11 +1219,15 @@ class Parser : public AsyncWrap, public StreamListener {
   const char* current_buffer_data_;
   bool headers_completed_ = false;
   bool pending_pause_ = false;
+  bool flat_headers_ = false;
   uint64_t header_nread_ = 0;
   uint64_t chunk_extensions_nread_ = 0;
   uint64_t max_http_header_size_;
   uint64_t last_message_start_;
   ConnectionsList* connectionsList_;
+  ConnectionsList::Entry all_connections_entry_;
+  ConnectionsList::Entry active_connections_entry_;
+  ConnectionsList::Entry headers_connections_entry_;
 
   BaseObjectPtr<BindingData> binding_data_;
 
@@ -1047,18 +1252,29 @@ class Parser : public AsyncWrap, public StreamListener {
   static const llhttp_settings_t settings;
 };
 
-bool ParserComparator::operator()(const Parser* lhs, const Parser* rhs) const {
-  if (lhs->last_message_start_ == 0 && rhs->last_message_start_ == 0) {
-    // When both parsers are idle, guarantee strict order by
-    // comparing pointers as ints.
-    return lhs < rhs;
-  } else if (lhs->last_message_start_ == 0) {
-    return true;
-  } else if (rhs->last_message_start_ == 0) {
-    return false;
+void ConnectionsList::Push(Parser* parser) {
+  if (parser->all_connections_entry_.list != &all_connections_)
+    Link(&all_connections_, &parser->all_connections_entry_, parser);
+}
+
+void ConnectionsList::Pop(Parser* parser) {
+  Unlink(&parser->all_connections_entry_);
+}
+
+void ConnectionsList::PushActive(Parser* parser) {
+  Link(&active_connections_, &parser->active_connections_entry_, parser);
+  if (!parser->headers_completed_) {
+    Link(&headers_connections_, &parser->headers_connections_entry_, parser);
   }
+}
 
-  return lhs->last_message_start_ < rhs->last_message_start_;
+void ConnectionsList::PopActive(Parser* parser) {
+  Unlink(&parser->active_connections_entry_);
+  Unlink(&parser->headers_connections_entry_);
+}
+
+void ConnectionsList::HeadersCompleted(Parser* parser) {
+  Unlink(&parser->headers_connections_entry_);
 }
 
 void ConnectionsList::New(const FunctionCallbackInfo<Value>& args) {
@@ -1157,27 +1373,21 @@ void ConnectionsList::Expired(const FunctionCallbackInfo<Value>& args) {
     return args.GetReturnValue().Set(Array::New(isolate, 0));
   }
 
-  auto iter = list->active_connections_.begin();
-  auto end = list->active_connections_.end();
-
   LocalVector<Value> result(isolate);
-  result.reserve(list->active_connections_.size());
-  while (iter != end) {
-    Parser* parser = *iter;
-    iter++;
-
-    // Check for expiration.
-    if (
-      (!parser->headers_completed_ && headers_deadline > 0 &&
-        parser->last_message_start_ < headers_deadline) ||
-      (
-        request_deadline > 0 &&
-        parser->last_message_start_ < request_deadline)
-    ) {
+  const auto expire = [&](std::list<Parser*>* connections, uint64_t deadline) {
+    while (!connections->empty()) {
+      Parser* parser = connections->front();
+      if (parser->last_message_start_ >= deadline) break;
       result.emplace_back(parser->object());
-
-      list->active_connections_.erase(parser);
+      list->PopActive(parser);
     }
+  };
+
+  if (request_deadline > 0) {
+    expire(&list->active_connections_, request_deadline);
+  }
+  if (headers_deadline > 0) {
+    expire(&list->headers_connections_, headers_deadline);
   }
 
   return args.GetReturnValue().Set(
@@ -1287,6 +1497,9 @@ void CreatePerIsolateProperties(IsolateData* isolate_data,
   t->Set(FIXED_ONE_BYTE_STRING(isolate, "kLenientAll"),
          Integer::NewFromUnsigned(isolate, kLenientAll));
 
+  t->Set(FIXED_ONE_BYTE_STRING(isolate, "kCommonHeaderFlag"),
+         Integer::NewFromUnsigned(isolate, kCommonHeaderFlag));
+
   t->Inherit(AsyncWrap::GetConstructorTemplate(isolate_data));
   SetProtoMethod(isolate, t, "close", Parser::Close);
   SetProtoMethod(isolate, t, "free", Parser::Free);
@@ -1325,6 +1538,7 @@ void CreatePerContextProperties(Local<Object> target,
 
   LocalVector<Value> methods_val(isolate);
   LocalVector<Value> all_methods_val(isolate);
+  LocalVector<Value> common_headers_val(isolate);
 
 #define V(num, name, string)                                                   \
   methods_val.push_back(FIXED_ONE_BYTE_STRING(isolate, #string));
@@ -1334,11 +1548,17 @@ void CreatePerContextProperties(Local<Object> target,
   all_methods_val.push_back(FIXED_ONE_BYTE_STRING(isolate, #string));
   HTTP_ALL_METHOD_MAP(V)
 #undef V
+  for (const std::string_view& name : kCommonHeaders) {
+    common_headers_val.push_back(
+        OneByteString(isolate, name.data(), name.size()));
+  }
 
   Local<Array> methods =
       Array::New(isolate, methods_val.data(), methods_val.size());
   Local<Array> all_methods =
       Array::New(isolate, all_methods_val.data(), all_methods_val.size());
+  Local<Array> common_headers = Array::New(
+      isolate, common_headers_val.data(), common_headers_val.size());
   if (!target
            ->Set(env->context(),
                  FIXED_ONE_BYTE_STRING(isolate, "methods"),
@@ -1346,11 +1566,18 @@ void CreatePerContextProperties(Local<Object> target,
            .IsJust()) {
     return;
   }
-  if (target
-          ->Set(env->context(),
-                FIXED_ONE_BYTE_STRING(isolate, "allMethods"),
-                all_methods)
-          .IsJust()) {
+  if (!target
+           ->Set(env->context(),
+                 FIXED_ONE_BYTE_STRING(isolate, "allMethods"),
+                 all_methods)
+           .IsJust()) {
+    return;
+  }
+  if (!target
+           ->Set(env->context(),
+                 FIXED_ONE_BYTE_STRING(isolate, "commonHeaders"),
+                 common_headers)
+           .IsJust()) {
     return;
   }
 }
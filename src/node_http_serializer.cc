@@ -0,0 +1,199 @@
+#include "env-inl.h"
+#include "node_binding.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+// Serializes the header block of outgoing HTTP/1 messages. The JS side
+// (lib/_http_outgoing.js) flattens the headers into name/value string pairs
+// and calls serializeHeaders(); everything that does not fit this fast path,
+// including every validation failure, is left to the JS implementation so
+// that the errors thrown stay exactly the same.
+
+namespace node {
+namespace http_serializer {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Uint32Array;
+using v8::Value;
+
+namespace {
+
+enum CharClass : uint8_t {
+  kValueChar = 1 << 0,
+  kTokenChar = 1 << 1,
+};
+
+// The characters allowed in header names (RFC 9110 tokens) and in header
+// values (HTAB, SP, VCHAR and obs-text). These are the same sets as the
+// checkIsHttpToken() and checkInvalidHeaderChar() regular expressions.
+constexpr std::array<uint8_t, 256> BuildCharTable() {
+  std::array<uint8_t, 256> table{};
+  table['\t'] = kValueChar;
+  for (int c = 0x20; c < 0x7f; c++) table[c] = kValueChar;
+  for (int c = 0x80; c <= 0xff; c++) table[c] = kValueChar;
+  for (int c = '0'; c <= '9'; c++) table[c] |= kTokenChar;
+  for (int c = 'a'; c <= 'z'; c++) table[c] |= kTokenChar;
+  for (int c = 'A'; c <= 'Z'; c++) table[c] |= kTokenChar;
+  for (char c : std::string_view("!#$%&'*+-.^_`|~")) {
+    table[static_cast<uint8_t>(c)] |= kTokenChar;
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> kCharTable = BuildCharTable();
+
+inline bool IsValid(const uint8_t* data, size_t length, uint8_t char_class) {
+  uint8_t result = char_class;
+  // Accumulates instead of returning early, which lets compilers vectorize
+  // the loop.
+  for (size_t i = 0; i < length; i++) result &= kCharTable[data[i]];
+  return result != 0;
+}
+
+// The headers that matchHeader() in lib/_http_outgoing.js reacts to.
+constexpr std::string_view kSpecialHeaders[] = {
+    "connection",
+    "transfer-encoding",
+    "content-length",
+    "date",
+    "expect",
+    "trailer",
+    "keep-alive",
+};
+
+inline bool IsSpecialHeader(const uint8_t* data, size_t length) {
+  for (const std::string_view& name : kSpecialHeaders) {
+    if (name.size() == length &&
+        StringEqualNoCaseN(
+            reinterpret_cast<const char*>(data), name.data(), length)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Copies |string| to |out|, if it only contains Latin-1 characters.
+inline bool WriteLatin1(Isolate* isolate,
+                        Local<String> string,
+                        MaybeStackBuffer<uint8_t, 4096>* out,
+                        size_t* offset) {
+  if (!string->IsOneByte() && !string->ContainsOnlyOneByte()) return false;
+  uint32_t length = string->Length();
+  // Leaves room for the separator or line ending after the string.
+  size_t storage = *offset + length + 4;
+  if (storage > out->capacity())
+    storage = std::max(storage, 2 * out->capacity());
+  out->AllocateSufficientStorage(storage);
+  string->WriteOneByteV2(isolate, 0, length, out->out() + *offset);
+  *offset += length;
+  return true;
+}
+
+}  // anonymous namespace
+
+// serializeHeaders(headers, validate, specials) joins the flat
+// [name, value, ...] string array |headers| into one `name: value\r\n` block
+// and returns it as a one-byte string. The index of every name that
+// matchHeader() needs to see is stored in |specials|, preceded by their count.
+// Returns undefined if any header needs the JS implementation: entries that
+// are not strings, non Latin-1 characters, invalid names or values when
+// |validate| is true, or more special headers than |specials| can hold.
+static void SerializeHeaders(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsBoolean());
+  CHECK(args[2]->IsUint32Array());
+  Local<Array> headers = args[0].As<Array>();
+  const bool validate = args[1]->IsTrue();
+  Local<Uint32Array> specials_array = args[2].As<Uint32Array>();
+  CHECK_GE(specials_array->Length(), 1);
+  uint32_t* specials = reinterpret_cast<uint32_t*>(
+      static_cast<uint8_t*>(specials_array->Buffer()->Data()) +
+      specials_array->ByteOffset());
+  const uint32_t max_specials = specials_array->Length() - 1;
+  uint32_t specials_count = 0;
+
+  const uint32_t length = headers->Length();
+  if (length % 2 != 0) return;
+
+  MaybeStackBuffer<uint8_t, 4096> out;
+  size_t offset = 0;
+  for (uint32_t i = 0; i < length; i += 2) {
+    Local<Value> name;
+    Local<Value> value;
+    if (!headers->Get(context, i).ToLocal(&name) ||
+        !headers->Get(context, i + 1).ToLocal(&value)) {
+      return;
+    }
+    if (!name->IsString() || !value->IsString()) return;
+
+    const size_t name_offset = offset;
+    if (!WriteLatin1(isolate, name.As<String>(), &out, &offset)) return;
+    const uint8_t* name_data = out.out() + name_offset;
+    const size_t name_length = offset - name_offset;
+    if (validate &&
+        (name_length == 0 || !IsValid(name_data, name_length, kTokenChar))) {
+      return;
+    }
+    if (name_length >= 4 && name_length <= 17 &&
+        IsSpecialHeader(name_data, name_length)) {
+      if (specials_count == max_specials) return;
+      specials[++specials_count] = i;
+    }
+    out[offset++] = ':';
+    out[offset++] = ' ';
+
+    const size_t value_offset = offset;
+    if (!WriteLatin1(isolate, value.As<String>(), &out, &offset)) return;
+    if (validate && !IsValid(out.out() + value_offset,
+                             offset - value_offset,
+                             kValueChar)) {
+      return;
+    }
+    out[offset++] = '\r';
+    out[offset++] = '\n';
+  }
+  specials[0] = specials_count;
+
+  Local<String> result;
+  if (String::NewFromOneByte(isolate,
+                             out.out(),
+                             v8::NewStringType::kNormal,
+                             static_cast<int>(offset))
+          .ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
+static void Initialize(Local<Object> target,
+                       Local<Value> unused,
+                       Local<Context> context,
+                       void* priv) {
+  SetMethod(context, target, "serializeHeaders", SerializeHeaders);
+}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SerializeHeaders);
+}
+
+}  // namespace http_serializer
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(http_serializer,
+                                    node::http_serializer::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(
+    http_serializer, node::http_serializer::RegisterExternalReferences)
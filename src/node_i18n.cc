@@ -27,7 +27,10 @@
  *    macro names. That's the "english+root" data.
  *
  *    If icu_data_path is non-null, the user has provided a path and we assume
- *    it goes somewhere useful. We set that path in ICU, and exit.
+ *    it goes somewhere useful. We set that path in ICU, and exit. The path
+ *    can contain either a full data package (icudt__.dat), which ICU maps
+ *    as a whole, or an unpacked one (see `icutrim.py -X`), whose items ICU
+ *    loads from individual files when they are first used.
  *    If icu_data_path is null, they haven't set a path and we want the
  *    "english+root" data.  We call
  *       udata_setCommonData(SMALL_ICUDATA_ENTRY_POINT,...)
@@ -254,6 +257,100 @@ MaybeLocal<Object> TranscodeUtf8FromUcs2(Environment* env,
   return Buffer::New(env, &destbuf);
 }
 
+// Converts between the pairs of encodings that need no substitutions with
+// simdutf, without going through ICU: copies of valid input, UTF-8 to and
+// from Latin-1, and UTF-16LE to Latin-1. Returns false when ICU has to do
+// the conversion, e.g. because characters have to be substituted.
+bool TranscodeWithoutIcu(Environment* env,
+                         const enum encoding from_encoding,
+                         const enum encoding to_encoding,
+                         const char* source,
+                         const size_t source_length,
+                         MaybeLocal<Object>* result) {
+  auto copy = [&]() {
+    *result = Buffer::Copy(env->isolate(), source, source_length);
+    return true;
+  };
+  const size_t length_in_chars = source_length / sizeof(char16_t);
+  const char16_t* source16 = reinterpret_cast<const char16_t*>(source);
+
+  switch (from_encoding) {
+    case ASCII:
+      if (to_encoding == UCS2) return false;
+      if (simdutf::validate_ascii(source, source_length)) return copy();
+      return false;
+    case LATIN1:
+      switch (to_encoding) {
+        case LATIN1:
+          return copy();
+        case ASCII:
+          if (simdutf::validate_ascii(source, source_length)) return copy();
+          return false;
+        case UTF8: {
+          MaybeStackBuffer<char> destbuf(
+              simdutf::utf8_length_from_latin1(source, source_length));
+          destbuf.SetLength(simdutf::convert_latin1_to_utf8(
+              source, source_length, destbuf.out()));
+          *result = Buffer::New(env, &destbuf);
+          return true;
+        }
+        default:
+          return false;
+      }
+    case UTF8:
+      switch (to_encoding) {
+        case UTF8:
+          if (simdutf::validate_utf8(source, source_length)) return copy();
+          return false;
+        case ASCII:
+          if (simdutf::validate_ascii(source, source_length)) return copy();
+          return false;
+        case LATIN1: {
+          if (source_length == 0) return copy();
+          MaybeStackBuffer<char> destbuf(source_length);
+          const size_t length = simdutf::convert_utf8_to_latin1(
+              source, source_length, destbuf.out());
+          // The input is not valid UTF-8 or not all of it is Latin-1.
+          if (length == 0) return false;
+          destbuf.SetLength(length);
+          *result = Buffer::New(env, &destbuf);
+          return true;
+        }
+        default:
+          return false;
+      }
+    case UCS2:
+      if (source_length % sizeof(char16_t) != 0) return false;
+      switch (to_encoding) {
+        case UCS2:
+          if (simdutf::validate_utf16le(source16, length_in_chars)) {
+            return copy();
+          }
+          return false;
+        case ASCII:
+        case LATIN1: {
+          if (source_length == 0) return copy();
+          MaybeStackBuffer<char> destbuf(length_in_chars);
+          const size_t length = simdutf::convert_utf16le_to_latin1(
+              source16, length_in_chars, destbuf.out());
+          // Not all of the input is Latin-1.
+          if (length == 0) return false;
+          if (to_encoding == ASCII &&
+              !simdutf::validate_ascii(destbuf.out(), length)) {
+            return false;
+          }
+          destbuf.SetLength(length);
+          *result = Buffer::New(env, &destbuf);
+          return true;
+        }
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+
 constexpr const char* EncodingName(const enum encoding encoding) {
   switch (encoding) {
     case ASCII: return "us-ascii";
@@ -285,35 +382,42 @@ void Transcode(const FunctionCallbackInfo<Value>&args) {
   const enum encoding toEncoding = ParseEncoding(isolate, args[2], BUFFER);
 
   if (SupportedEncoding(fromEncoding) && SupportedEncoding(toEncoding)) {
-    TranscodeFunc tfn = &Transcode;
-    switch (fromEncoding) {
-      case ASCII:
-      case LATIN1:
-        if (toEncoding == UCS2) tfn = &TranscodeLatin1ToUcs2;
-        break;
-      case UTF8:
-        if (toEncoding == UCS2)
-          tfn = &TranscodeUcs2FromUtf8;
-        break;
-      case UCS2:
-        switch (toEncoding) {
-          case UCS2:
-            tfn = &Transcode;
-            break;
-          case UTF8:
-            tfn = &TranscodeUtf8FromUcs2;
-            break;
-          default:
-            tfn = &TranscodeFromUcs2;
-        }
-        break;
-      default:
-        // This should not happen because of the SupportedEncoding checks
-        ABORT();
-    }
+    if (!TranscodeWithoutIcu(env,
+                             fromEncoding,
+                             toEncoding,
+                             input.data(),
+                             input.length(),
+                             &result)) {
+      TranscodeFunc tfn = &Transcode;
+      switch (fromEncoding) {
+        case ASCII:
+        case LATIN1:
+          if (toEncoding == UCS2) tfn = &TranscodeLatin1ToUcs2;
+          break;
+        case UTF8:
+          if (toEncoding == UCS2)
+            tfn = &TranscodeUcs2FromUtf8;
+          break;
+        case UCS2:
+          switch (toEncoding) {
+            case UCS2:
+              tfn = &Transcode;
+              break;
+            case UTF8:
+              tfn = &TranscodeUtf8FromUcs2;
+              break;
+            default:
+              tfn = &TranscodeFromUcs2;
+          }
+          break;
+        default:
+          // This should not happen because of the SupportedEncoding checks
+          ABORT();
+      }
 
-    result = tfn(env, EncodingName(fromEncoding), EncodingName(toEncoding),
-                 input.data(), input.length(), &status);
+      result = tfn(env, EncodingName(fromEncoding), EncodingName(toEncoding),
+                   input.data(), input.length(), &status);
+    }
   } else {
     status = U_ILLEGAL_ARGUMENT_ERROR;
   }
@@ -28,10 +28,12 @@
 #include "node.h"
 #include "node_binding.h"
 #include "node_mutex.h"
+#include "slab_allocator.h"
 #include "tracing/trace_event.h"
 #include "util.h"
 #include "uv.h"
 #include "v8.h"
+#include "wasi_arena_allocator.h"
 
 #include <cstdint>
 #include <cstdlib>
@@ -49,6 +51,7 @@ class BuiltinLoader;
 
 namespace per_process {
 extern Mutex env_var_mutex;
+extern Mutex umask_mutex;
 extern uint64_t node_start_time;
 }  // namespace per_process
 
@@ -120,6 +123,8 @@ v8::MaybeLocal<v8::Object> InitializePrivateSymbols(
 
 class NodeArrayBufferAllocator : public ArrayBufferAllocator {
  public:
+  NodeArrayBufferAllocator();
+
   inline uint32_t* zero_fill_field() { return &zero_fill_field_; }
 
   void* Allocate(size_t size) override;  // Defined in src/node.cc
@@ -136,14 +141,24 @@ class NodeArrayBufferAllocator : public ArrayBufferAllocator {
   inline uint64_t total_mem_usage() const {
     return total_mem_usage_.load(std::memory_order_relaxed);
   }
+  // nullptr unless --experimental-arraybuffer-slab-allocator is set.
+  inline const SlabAllocator* slabs() const { return slabs_.get(); }
 
  private:
   uint32_t zero_fill_field_ = 1;  // Boolean but exposed as uint32 to JS land.
   std::atomic<size_t> total_mem_usage_ {0};
 
+#ifdef __wasi__
+  // Delegate to the linear memory arenas that are shared by all threads.
+  v8::ArrayBuffer::Allocator* const allocator_ = WasiArenaAllocator::Get();
+#else
   // Delegate to V8's allocator for compatibility with the V8 memory cage.
-  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator_{
+  std::unique_ptr<v8::ArrayBuffer::Allocator> default_allocator_{
       v8::ArrayBuffer::Allocator::NewDefaultAllocator()};
+  v8::ArrayBuffer::Allocator* const allocator_ = default_allocator_.get();
+#endif
+  // Serves the small allocations from slabs taken from |allocator_|.
+  std::unique_ptr<SlabAllocator> slabs_;
 };
 
 class DebuggingArrayBufferAllocator final : public NodeArrayBufferAllocator {
@@ -269,6 +284,9 @@ class InternalCallbackScope {
   bool failed_ = false;
   bool pushed_ids_ = false;
   bool closed_ = false;
+  // The async id that the CPU time was charged to before this scope, or -1
+  // if CPU time accounting was disabled when the scope was entered.
+  double prior_cpu_time_async_id_ = -1;
   v8::Global<v8::Value> prior_context_frame_;
 };
 
@@ -288,12 +306,17 @@ class DebugSealHandleScope {
 
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env, const char* type)
-      : env_(env), type_(type) {
+  explicit inline ThreadPoolWork(
+      Environment* env,
+      const char* type,
+      ThreadPoolWorkClass work_class = ThreadPoolWorkClass::kOther)
+      : env_(env), type_(type), work_class_(work_class) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
 
+  // Queues the work in the libuv threadpool, or, if the class of the work is
+  // at its limit, until one of the running work items of the class is done.
   inline void ScheduleWork();
   inline int CancelWork();
 
@@ -302,10 +325,31 @@ class ThreadPoolWork {
 
   Environment* env() const { return env_; }
 
+  bool is_scheduled() const { return is_scheduled_; }
+  // The class can only be changed while the work is not scheduled.
+  inline void set_work_class(ThreadPoolWorkClass work_class);
+  // The time in nanoseconds from the last ScheduleWork() to the start of the
+  // work in the threadpool. Only valid in AfterThreadPoolWork(), and 0 if the
+  // work was cancelled before it started.
+  inline uint64_t queue_wait_time() const;
+
  private:
+  inline void QueueWork();
+  inline void OnWorkDone(int status);
+  inline void AddPending(ThreadPoolWorkClassState* state);
+  inline void RemovePending(ThreadPoolWorkClassState* state);
+
   Environment* env_;
   uv_work_t work_req_;
   const char* type_;
+  ThreadPoolWorkClass work_class_;
+  bool is_scheduled_ = false;
+  bool is_pending_ = false;
+  ThreadPoolWork* pending_prev_ = nullptr;
+  ThreadPoolWork* pending_next_ = nullptr;
+  uint64_t schedule_time_ = 0;
+  uint64_t start_time_ = 0;
+  uint64_t end_time_ = 0;
 };
 
 #define TRACING_CATEGORY_NODE "node"
@@ -327,6 +371,14 @@ namespace credentials {
 bool SafeGetenv(const char* key, std::string* text, Environment* env = nullptr);
 }  // namespace credentials
 
+namespace os {
+// Like uv_available_parallelism(), but also takes the CPU quota of the cgroup
+// of the process into account once EnableCpuQuota() has been called
+// (--experimental-cpu-quota-aware).
+unsigned int AvailableParallelism();
+void EnableCpuQuota();
+}  // namespace os
+
 void TraceEnvVar(Environment* env, const char* message);
 void TraceEnvVar(Environment* env, const char* message, const char* key);
 void TraceEnvVar(Environment* env,
@@ -334,6 +386,8 @@ void TraceEnvVar(Environment* env,
                  v8::Local<v8::String> key);
 
 void DefineZlibConstants(v8::Local<v8::Object> target);
+// Creates the CppHeap that is attached to the isolates created by Node.js.
+std::unique_ptr<v8::CppHeap> NewCppHeap(v8::Platform* platform);
 v8::Isolate* NewIsolate(v8::Isolate::CreateParams* params,
                         uv_loop_t* event_loop,
                         MultiIsolatePlatform* platform,
@@ -419,9 +473,18 @@ class DiagnosticFilename {
 };
 
 namespace heap {
-v8::Maybe<void> WriteSnapshot(Environment* env,
-                              const char* filename,
-                              v8::HeapProfiler::HeapSnapshotOptions options);
+// How the JSON of a heap snapshot is compressed while it is serialized.
+enum class HeapSnapshotCompression : uint8_t { kNone, kGzip, kZstd };
+
+HeapSnapshotCompression ParseHeapSnapshotCompression(std::string_view name);
+// The extension of snapshot files, e.g. "heapsnapshot.gz".
+const char* HeapSnapshotExtension(HeapSnapshotCompression compression);
+
+v8::Maybe<void> WriteSnapshot(
+    Environment* env,
+    const char* filename,
+    v8::HeapProfiler::HeapSnapshotOptions options,
+    HeapSnapshotCompression compression = HeapSnapshotCompression::kNone);
 }
 
 namespace heap {
@@ -431,7 +494,9 @@ using HeapSnapshotPointer =
   DeleteFnPtr<const v8::HeapSnapshot, DeleteHeapSnapshot>;
 
 BaseObjectPtr<AsyncWrap> CreateHeapSnapshotStream(
-    Environment* env, HeapSnapshotPointer&& snapshot);
+    Environment* env,
+    HeapSnapshotPointer&& snapshot,
+    HeapSnapshotCompression compression = HeapSnapshotCompression::kNone);
 }  // namespace heap
 
 node_module napi_module_to_node_module(const napi_module* mod);
@@ -463,6 +528,8 @@ bool linux_at_secure();
 namespace heap {
 v8::HeapProfiler::HeapSnapshotOptions GetHeapSnapshotOptions(
     v8::Local<v8::Value> options);
+HeapSnapshotCompression GetHeapSnapshotCompression(
+    v8::Local<v8::Value> options);
 }  // namespace heap
 
 enum encoding ParseEncoding(v8::Isolate* isolate,
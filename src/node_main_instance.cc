@@ -97,6 +97,9 @@ ExitCode NodeMainInstance::Run() {
 
   Context::Scope context_scope(env->context());
   Run(&exit_code, env.get());
+  // The process exits once the main instance is gone, and the isolate is
+  // disposed without running any more weak callbacks.
+  env->set_fast_teardown(true);
   return exit_code;
 }
 
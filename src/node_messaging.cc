@@ -10,6 +10,9 @@
 #include "node_process-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <cmath>
+
 using node::contextify::ContextifyContext;
 using node::errors::TryCatchScope;
 using v8::Array;
@@ -31,6 +34,7 @@ using v8::LocalVector;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SharedArrayBuffer;
@@ -67,6 +71,433 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// A compact format for messages that only contain primitives, plain objects
+// and dense arrays, which is faster to write and read than the format of
+// v8::ValueSerializer because it does not need to consult a delegate for
+// every object. The property names of objects are written once per message
+// for each distinct list of names ("shape"), so that the receiving side
+// only creates the key strings once.
+enum class PlainDataTag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kInt32,
+  kDouble,
+  kOneByteString,
+  kTwoByteString,
+  kArray,
+  // Followed by the id of a shape that was written before.
+  kObject,
+  // Followed by the number of property names and the names themselves,
+  // which make up the next shape id.
+  kObjectWithNewShape,
+};
+
+// Writes a value in the PlainDataTag format. WriteValue() returns
+// Just(false) when it meets anything that the format cannot represent,
+// including objects that are reachable more than once and accessor
+// properties, in which case the caller falls back to v8::ValueSerializer.
+// Properties are read from their descriptors, so no JavaScript runs before
+// that point, and every getter runs exactly once.
+class PlainDataSerializer {
+ public:
+  PlainDataSerializer(Environment* env, Local<Context> context)
+      : env_(env),
+        isolate_(env->isolate()),
+        context_(context),
+        seen_objects_(isolate_),
+        shape_keys_(isolate_) {
+    object_prototype_ = Object::New(isolate_)->GetPrototypeV2();
+    array_prototype_ = Array::New(isolate_)->GetPrototypeV2();
+  }
+
+  ~PlainDataSerializer() { free(data_); }
+
+  Maybe<bool> WriteValue(Local<Value> value, size_t depth = 0) {
+    if (value->IsUndefined()) {
+      WriteTag(PlainDataTag::kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(PlainDataTag::kNull);
+    } else if (value->IsTrue()) {
+      WriteTag(PlainDataTag::kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(PlainDataTag::kFalse);
+    } else if (value->IsInt32()) {
+      WriteTag(PlainDataTag::kInt32);
+      WriteRaw(value.As<v8::Int32>()->Value());
+    } else if (value->IsNumber()) {
+      WriteTag(PlainDataTag::kDouble);
+      WriteRaw(value.As<v8::Number>()->Value());
+    } else if (value->IsString()) {
+      WriteString(value.As<String>());
+    } else if (depth >= kMaxDepth) {
+      return Just(false);
+    } else if (value->IsArray()) {
+      return WriteArray(value.As<Array>(), depth);
+    } else if (value->IsObject()) {
+      return WriteObject(value.As<Object>(), depth);
+    } else {
+      // BigInts, and Symbols, which cannot be cloned at all.
+      return Just(false);
+    }
+    return Just(true);
+  }
+
+  MallocedBuffer<char> Release() {
+    MallocedBuffer<char> buffer(data_, size_);
+    data_ = nullptr;
+    size_ = capacity_ = 0;
+    return buffer;
+  }
+
+ private:
+  static constexpr size_t kMaxDepth = 256;
+  // The number of shapes with the same number of properties that are
+  // compared against the properties of an object before giving up.
+  static constexpr size_t kMaxShapesPerLength = 8;
+
+  Maybe<bool> WriteArray(Local<Array> array, size_t depth) {
+    if (array->GetPrototypeV2() != array_prototype_ || !Visit(array))
+      return Just(false);
+    // Named properties of arrays are cloned, too.
+    Local<Array> names;
+    if (!array
+             ->GetPropertyNames(context_,
+                                v8::KeyCollectionMode::kOwnOnly,
+                                static_cast<v8::PropertyFilter>(
+                                    v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                v8::IndexFilter::kSkipIndices)
+             .ToLocal(&names)) {
+      return Nothing<bool>();
+    }
+    if (names->Length() != 0) return Just(false);
+
+    uint32_t length = array->Length();
+    WriteTag(PlainDataTag::kArray);
+    WriteRaw(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<String> index;
+      Local<Value> element;
+      if (!v8::Uint32::NewFromUnsigned(isolate_, i)
+               ->ToString(context_)
+               .ToLocal(&index)) {
+        return Nothing<bool>();
+      }
+      // Holes are kept as holes by ValueSerializer.
+      Maybe<bool> read = GetDataProperty(array, index, &element);
+      if (read.IsNothing() || !read.FromJust()) return read;
+      Maybe<bool> written = WriteValue(element, depth + 1);
+      if (written.IsNothing() || !written.FromJust()) return written;
+    }
+    return Just(true);
+  }
+
+  Maybe<bool> WriteObject(Local<Object> object, size_t depth) {
+    if (!IsPlainObject(object) || !Visit(object)) return Just(false);
+
+    Local<Array> names;
+    if (!object
+             ->GetOwnPropertyNames(context_,
+                                   static_cast<v8::PropertyFilter>(
+                                       v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                   v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&names)) {
+      return Nothing<bool>();
+    }
+    uint32_t count = names->Length();
+    size_t keys_start = shape_keys_.size();
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> key;
+      if (!names->Get(context_, i).ToLocal(&key)) return Nothing<bool>();
+      shape_keys_.push_back(key);
+    }
+    keys_start = WriteShape(keys_start, count);
+
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> key = shape_keys_[keys_start + i];
+      Local<Value> value;
+      Maybe<bool> read =
+          GetDataProperty(object, key.As<v8::Name>(), &value);
+      if (read.IsNothing() || !read.FromJust()) return read;
+      Maybe<bool> written = WriteValue(value, depth + 1);
+      if (written.IsNothing() || !written.FromJust()) return written;
+    }
+    return Just(true);
+  }
+
+  // Reads the value of an own data property without running any
+  // JavaScript. Returns Just(false) if |key| is not one, e.g. if it is an
+  // accessor, whose getter must only run once, in ValueSerializer.
+  Maybe<bool> GetDataProperty(Local<Object> object,
+                              Local<v8::Name> key,
+                              Local<Value>* value) {
+    Local<Value> descriptor;
+    if (!object->GetOwnPropertyDescriptor(context_, key)
+             .ToLocal(&descriptor)) {
+      return Nothing<bool>();
+    }
+    if (!descriptor->IsObject()) return Just(false);
+    Local<Object> fields = descriptor.As<Object>();
+    bool is_data;
+    if (!fields->HasOwnProperty(context_, env_->value_string())
+             .To(&is_data)) {
+      return Nothing<bool>();
+    }
+    if (!is_data) return Just(false);
+    if (!fields->Get(context_, env_->value_string()).ToLocal(value))
+      return Nothing<bool>();
+    return Just(true);
+  }
+
+  // Writes a reference to the shape made up by the |count| keys at the end
+  // of shape_keys_, starting at |keys_start|, defining it first if
+  // necessary. If an identical shape was written before, the keys are
+  // removed again. Returns the offset of the shape's keys.
+  size_t WriteShape(size_t keys_start, uint32_t count) {
+    std::vector<uint32_t>& candidates = shapes_by_length_[count];
+    for (uint32_t id : candidates) {
+      size_t start = shapes_[id];
+      bool same = true;
+      for (uint32_t i = 0; i < count && same; i++) {
+        same = shape_keys_[start + i] == shape_keys_[keys_start + i];
+      }
+      if (!same) continue;
+      shape_keys_.resize(keys_start);
+      WriteTag(PlainDataTag::kObject);
+      WriteRaw(id);
+      return start;
+    }
+
+    uint32_t id = static_cast<uint32_t>(shapes_.size());
+    shapes_.push_back(keys_start);
+    if (candidates.size() < kMaxShapesPerLength) candidates.push_back(id);
+    WriteTag(PlainDataTag::kObjectWithNewShape);
+    WriteRaw(count);
+    for (uint32_t i = 0; i < count; i++) {
+      WriteString(shape_keys_[keys_start + i].As<String>());
+    }
+    return keys_start;
+  }
+
+  bool IsPlainObject(Local<Object> object) {
+    if (object->IsProxy() || object->IsCallable() ||
+        object->InternalFieldCount() != 0 ||
+        object->HasNamedLookupInterceptor() ||
+        object->HasIndexedLookupInterceptor()) {
+      return false;
+    }
+    Local<Value> prototype = object->GetPrototypeV2();
+    if (!prototype->IsNull() && prototype != object_prototype_) return false;
+    // Objects with internal slots can still have Object.prototype as their
+    // prototype after Object.setPrototypeOf().
+    if (object->IsArrayBuffer() || object->IsArrayBufferView() ||
+        object->IsSharedArrayBuffer() || object->IsDate() ||
+        object->IsRegExp() || object->IsMap() || object->IsSet() ||
+        object->IsWeakMap() || object->IsWeakSet() ||
+        object->IsNativeError() || object->IsPromise() ||
+        object->IsBooleanObject() || object->IsNumberObject() ||
+        object->IsStringObject() || object->IsBigIntObject() ||
+        object->IsSymbolObject() || object->IsWasmModuleObject() ||
+        object->IsWasmMemoryObject() || object->IsGeneratorObject() ||
+        object->IsModuleNamespaceObject() || object->IsMapIterator() ||
+        object->IsSetIterator()) {
+      return false;
+    }
+    return !JSTransferable::IsJSTransferable(env_, context_, object);
+  }
+
+  // Returns false if |object| has been written before.
+  bool Visit(Local<Object> object) {
+    int hash = object->GetIdentityHash();
+    auto range = seen_hashes_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (seen_objects_[it->second] == object) return false;
+    }
+    seen_hashes_.emplace(hash, seen_objects_.size());
+    seen_objects_.push_back(object);
+    return true;
+  }
+
+  void WriteString(Local<String> string) {
+    uint32_t length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(PlainDataTag::kOneByteString);
+      WriteRaw(length);
+      string->WriteOneByteV2(isolate_, 0, length, Reserve(length));
+    } else {
+      WriteTag(PlainDataTag::kTwoByteString);
+      WriteRaw(length);
+      uint16_t* chars = reinterpret_cast<uint16_t*>(
+          Reserve(length * sizeof(uint16_t)));
+      string->WriteV2(isolate_, 0, length, chars);
+    }
+  }
+
+  void WriteTag(PlainDataTag tag) { *Reserve(1) = static_cast<uint8_t>(tag); }
+
+  template <typename T>
+  void WriteRaw(T value) {
+    memcpy(Reserve(sizeof(value)), &value, sizeof(value));
+  }
+
+  uint8_t* Reserve(size_t bytes) {
+    if (size_ + bytes > capacity_) {
+      capacity_ = std::max(capacity_ * 2, size_ + bytes + 64);
+      data_ = Realloc(data_, capacity_);
+    }
+    uint8_t* ret = reinterpret_cast<uint8_t*>(data_ + size_);
+    size_ += bytes;
+    return ret;
+  }
+
+  Environment* env_;
+  Isolate* isolate_;
+  Local<Context> context_;
+  Local<Value> object_prototype_;
+  Local<Value> array_prototype_;
+
+  std::unordered_multimap<int, size_t> seen_hashes_;
+  LocalVector<Object> seen_objects_;
+
+  // The property names of all objects written so far. A shape is identified
+  // by the offset of its keys in here.
+  LocalVector<Value> shape_keys_;
+  std::vector<size_t> shapes_;
+  std::unordered_map<uint32_t, std::vector<uint32_t>> shapes_by_length_;
+
+  char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+};
+
+// Reads a value written by PlainDataSerializer. The input comes from the
+// same process, so it is trusted to be well-formed. This only reads from
+// the buffer, because messages of a BroadcastChannel may be read by several
+// threads at once.
+class PlainDataDeserializer {
+ public:
+  PlainDataDeserializer(Isolate* isolate,
+                        Local<Context> context,
+                        const MallocedBuffer<char>& buffer)
+      : isolate_(isolate),
+        context_(context),
+        position_(reinterpret_cast<const uint8_t*>(buffer.data)),
+        end_(position_ + buffer.size),
+        shape_keys_(isolate) {}
+
+  MaybeLocal<Value> ReadValue() {
+    switch (static_cast<PlainDataTag>(ReadRaw<uint8_t>())) {
+      case PlainDataTag::kUndefined:
+        return v8::Undefined(isolate_);
+      case PlainDataTag::kNull:
+        return v8::Null(isolate_);
+      case PlainDataTag::kTrue:
+        return v8::True(isolate_);
+      case PlainDataTag::kFalse:
+        return v8::False(isolate_);
+      case PlainDataTag::kInt32:
+        return v8::Integer::New(isolate_, ReadRaw<int32_t>());
+      case PlainDataTag::kDouble:
+        return v8::Number::New(isolate_, ReadRaw<double>());
+      case PlainDataTag::kOneByteString:
+        return ReadOneByteString(v8::NewStringType::kNormal);
+      case PlainDataTag::kTwoByteString:
+        return ReadTwoByteString(v8::NewStringType::kNormal);
+      case PlainDataTag::kArray:
+        return ReadArray();
+      case PlainDataTag::kObject:
+        return ReadObject(ReadRaw<uint32_t>());
+      case PlainDataTag::kObjectWithNewShape:
+        if (!ReadShape()) return {};
+        return ReadObject(static_cast<uint32_t>(shapes_.size() - 1));
+    }
+    UNREACHABLE();
+  }
+
+ private:
+  MaybeLocal<Value> ReadArray() {
+    uint32_t length = ReadRaw<uint32_t>();
+    LocalVector<Value> elements(isolate_, length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!ReadValue().ToLocal(&elements[i])) return {};
+    }
+    return Array::New(isolate_, elements.data(), elements.size());
+  }
+
+  MaybeLocal<Value> ReadObject(uint32_t id) {
+    CHECK_LT(id, shapes_.size());
+    auto [start, count] = shapes_[id];
+    Local<Object> object = Object::New(isolate_);
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> value;
+      if (!ReadValue().ToLocal(&value) ||
+          object
+              ->CreateDataProperty(
+                  context_, shape_keys_[start + i].As<v8::Name>(), value)
+              .IsNothing()) {
+        return {};
+      }
+    }
+    return object;
+  }
+
+  bool ReadShape() {
+    uint32_t count = ReadRaw<uint32_t>();
+    size_t start = shape_keys_.size();
+    for (uint32_t i = 0; i < count; i++) {
+      PlainDataTag tag = static_cast<PlainDataTag>(ReadRaw<uint8_t>());
+      Local<Value> key;
+      MaybeLocal<Value> maybe_key =
+          tag == PlainDataTag::kOneByteString
+              ? ReadOneByteString(v8::NewStringType::kInternalized)
+              : ReadTwoByteString(v8::NewStringType::kInternalized);
+      if (!maybe_key.ToLocal(&key)) return false;
+      shape_keys_.push_back(key);
+    }
+    shapes_.emplace_back(start, count);
+    return true;
+  }
+
+  MaybeLocal<Value> ReadOneByteString(v8::NewStringType type) {
+    uint32_t length = ReadRaw<uint32_t>();
+    const uint8_t* chars = ReadBytes(length);
+    return String::NewFromOneByte(isolate_, chars, type, length);
+  }
+
+  MaybeLocal<Value> ReadTwoByteString(v8::NewStringType type) {
+    uint32_t length = ReadRaw<uint32_t>();
+    // The characters may not be aligned, so copy them out first.
+    MaybeStackBuffer<uint16_t> chars(length);
+    memcpy(chars.out(), ReadBytes(length * sizeof(uint16_t)),
+           length * sizeof(uint16_t));
+    return String::NewFromTwoByte(isolate_, chars.out(), type, length);
+  }
+
+  const uint8_t* ReadBytes(size_t length) {
+    CHECK_LE(length, static_cast<size_t>(end_ - position_));
+    const uint8_t* ret = position_;
+    position_ += length;
+    return ret;
+  }
+
+  template <typename T>
+  T ReadRaw() {
+    T value;
+    memcpy(&value, ReadBytes(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  Isolate* isolate_;
+  Local<Context> context_;
+  const uint8_t* position_;
+  const uint8_t* const end_;
+  LocalVector<Value> shape_keys_;
+  // The offset of a shape's keys in shape_keys_, and their number.
+  std::vector<std::pair<size_t, uint32_t>> shapes_;
+};
+
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -151,6 +582,14 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
 
   EscapableHandleScope handle_scope(env->isolate());
 
+  if (is_plain_data_) {
+    PlainDataDeserializer deserializer(env->isolate(), context,
+                                       main_message_buf_);
+    Local<Value> return_value;
+    if (!deserializer.ReadValue().ToLocal(&return_value)) return {};
+    return handle_scope.Escape(return_value);
+  }
+
   // Create all necessary objects for transferables, e.g. MessagePort handles.
   std::vector<BaseObjectPtr<BaseObject>> host_objects(transferables_.size());
   auto cleanup = OnScopeLeave([&]() {
@@ -187,7 +626,7 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
       }
     }
   }
-  transferables_.clear();
+  if (!transferables_.empty()) transferables_.clear();
 
   LocalVector<SharedArrayBuffer> shared_array_buffers(env->isolate());
   // Attach all transferred SharedArrayBuffers to their new Isolate.
@@ -476,6 +915,18 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if (transfer_list_v.length() == 0) {
+    PlainDataSerializer plain_serializer(env, context);
+    bool is_plain_data;
+    if (!plain_serializer.WriteValue(input).To(&is_plain_data))
+      return Nothing<bool>();
+    if (is_plain_data) {
+      main_message_buf_ = plain_serializer.Release();
+      is_plain_data_ = true;
+      return Just(true);
+    }
+  }
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -619,6 +1070,46 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("transferables", transferables_);
 }
 
+IncomingMessageQueue::IncomingMessageQueue() : tail_(new Node()) {
+  head_ = tail_.load(std::memory_order_relaxed);
+}
+
+IncomingMessageQueue::~IncomingMessageQueue() {
+  while (Pop()) {}
+  delete head_;
+}
+
+void IncomingMessageQueue::Push(std::shared_ptr<Message> message) {
+  Node* node = new Node();
+  node->message = std::move(message);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  Node* prev = tail_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+}
+
+Message* IncomingMessageQueue::Peek() const {
+  Node* next = head_->next.load(std::memory_order_acquire);
+  return next == nullptr ? nullptr : next->message.get();
+}
+
+std::shared_ptr<Message> IncomingMessageQueue::Pop() {
+  Node* next = head_->next.load(std::memory_order_acquire);
+  if (next == nullptr) return {};
+  std::shared_ptr<Message> message = std::move(next->message);
+  delete head_;
+  head_ = next;
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  return message;
+}
+
+void IncomingMessageQueue::MemoryInfo(MemoryTracker* tracker) const {
+  for (Node* node = head_->next.load(std::memory_order_acquire);
+       node != nullptr;
+       node = node->next.load(std::memory_order_acquire)) {
+    tracker->TrackField("incoming_message", node->message);
+  }
+}
+
 MessagePortData::MessagePortData(MessagePort* owner)
     : owner_(owner) {
 }
@@ -629,21 +1120,55 @@ MessagePortData::~MessagePortData() {
 }
 
 void MessagePortData::MemoryInfo(MemoryTracker* tracker) const {
-  Mutex::ScopedLock lock(mutex_);
-  tracker->TrackField("incoming_messages", incoming_messages_);
+  incoming_messages_.MemoryInfo(tracker);
 }
 
 void MessagePortData::AddToIncomingQueue(std::shared_ptr<Message> message) {
   // This function will be called by other threads.
-  Mutex::ScopedLock lock(mutex_);
-  incoming_messages_.emplace_back(std::move(message));
+  incoming_messages_.Push(std::move(message));
+
+  // The fence pairs with the one in WaitForMessage(), so that either the
+  // owner sees the message there or this sees that the owner is waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed)) {
+    Mutex::ScopedLock lock(mutex_);
+    message_cond_.Broadcast(lock);
+  }
 
+  // The owner clears the flag before it starts draining the queue, so if it
+  // is already set, the owner has yet to see this message.
+  if (wakeup_pending_.exchange(true, std::memory_order_acq_rel)) return;
+
+  Mutex::ScopedLock lock(mutex_);
   if (owner_ != nullptr) {
     Debug(owner_, "Adding message to incoming queue");
     owner_->TriggerAsync();
   }
 }
 
+bool MessagePortData::WaitForMessage(Environment* env, int64_t timeout) {
+  if (!incoming_messages_.empty()) return true;
+  // The thread wakes up now and then to notice when it is being terminated,
+  // since nothing else can interrupt the wait.
+  static constexpr uint64_t kWaitSlice = 50 * 1000 * 1000;
+  const uint64_t deadline = timeout < 0 ? 0 : uv_hrtime() + timeout;
+  bool received = false;
+  Mutex::ScopedLock lock(mutex_);
+  waiting_.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (!(received = !incoming_messages_.empty()) && !env->is_stopping()) {
+    uint64_t slice = kWaitSlice;
+    if (timeout >= 0) {
+      const uint64_t now = uv_hrtime();
+      if (now >= deadline) break;
+      slice = std::min(slice, deadline - now);
+    }
+    message_cond_.TimedWait(lock, slice);
+  }
+  waiting_.store(false, std::memory_order_relaxed);
+  return received;
+}
+
 void MessagePortData::Entangle(MessagePortData* a, MessagePortData* b) {
   auto group = std::make_shared<SiblingGroup>();
   group->Entangle({a, b});
@@ -775,9 +1300,8 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               Local<Value>* port_list) {
   std::shared_ptr<Message> received;
   {
-    // Get the head of the message queue.
-    Mutex::ScopedLock lock(data_->mutex_);
-
+    // Get the head of the message queue. Only this thread removes messages
+    // from it, so no locking is needed.
     Debug(this, "MessagePort has message");
 
     bool wants_message =
@@ -787,14 +1311,12 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
     // - There are no pending messages
     // - We are not intending to receive messages, and the message we would
     //   receive is not the final "close" message.
-    if (data_->incoming_messages_.empty() ||
-        (!wants_message &&
-         !data_->incoming_messages_.front()->IsCloseMessage())) {
+    Message* next = data_->incoming_messages_.Peek();
+    if (next == nullptr || (!wants_message && !next->IsCloseMessage())) {
       return env()->no_message_symbol();
     }
 
-    received = data_->incoming_messages_.front();
-    data_->incoming_messages_.pop_front();
+    received = data_->incoming_messages_.Pop();
   }
 
   if (received->IsCloseMessage()) {
@@ -822,9 +1344,15 @@ void MessagePort::OnMessage(MessageProcessingMode mode) {
 
   size_t processing_limit;
   if (mode == MessageProcessingMode::kNormalOperation) {
-    Mutex::ScopedLock lock(data_->mutex_);
-    processing_limit = std::max(data_->incoming_messages_.size(),
-                                static_cast<size_t>(1000));
+    // Messages that are added from here on need to wake us up again.
+    data_->wakeup_pending_.exchange(false, std::memory_order_acq_rel);
+    uint64_t batch_size = env()->options()->message_port_batch_size;
+    if (batch_size > 0) {
+      processing_limit = static_cast<size_t>(batch_size);
+    } else {
+      processing_limit = std::max(data_->incoming_messages_.size(),
+                                  static_cast<size_t>(1000));
+    }
   } else {
     processing_limit = std::numeric_limits<size_t>::max();
   }
@@ -842,6 +1370,8 @@ void MessagePort::OnMessage(MessageProcessingMode mode) {
       // noticeable, at least on Windows.
       // (That might require more investigation by somebody more familiar with
       // Windows.)
+      // --message-port-batch-size overrides this for latency-sensitive
+      // applications that prefer to yield to the event loop more often.
       TriggerAsync();
       return;
     }
@@ -1161,6 +1691,13 @@ void MessagePort::ReceiveMessage(const FunctionCallbackInfo<Value>& args) {
     return;
   }
 
+  // If a timeout in milliseconds is passed, wait for a message to arrive.
+  if (args[1]->IsNumber()) {
+    const double timeout = args[1].As<Number>()->Value();
+    port->data_->WaitForMessage(
+        env, std::isfinite(timeout) ? static_cast<int64_t>(timeout * 1e6) : -1);
+  }
+
   Local<Value> payload;
   Local<Context> context;
   if (!port->object()->GetCreationContext().ToLocal(&context)) {
@@ -1245,6 +1782,118 @@ Local<FunctionTemplate> GetMessagePortConstructorTemplate(
 }
 
 // static
+Local<FunctionTemplate> SharedBufferSlice::GetConstructorTemplate(
+    IsolateData* isolate_data) {
+  Local<FunctionTemplate> tmpl =
+      isolate_data->shared_buffer_slice_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = isolate_data->isolate();
+    tmpl = NewFunctionTemplate(isolate, New);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "SharedBufferSlice"));
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        SharedBufferSlice::kInternalFieldCount);
+    SetProtoMethod(isolate, tmpl, "getBuffer", GetBuffer);
+    SetProtoMethod(isolate, tmpl, "release", Release);
+    isolate_data->set_shared_buffer_slice_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+BaseObjectPtr<SharedBufferSlice> SharedBufferSlice::Create(
+    Environment* env,
+    std::shared_ptr<BackingStore> store,
+    size_t byte_offset,
+    size_t length) {
+  Local<Object> obj;
+  if (!GetConstructorTemplate(env->isolate_data())
+           ->InstanceTemplate()
+           ->NewInstance(env->context())
+           .ToLocal(&obj)) {
+    return nullptr;
+  }
+  return MakeBaseObject<SharedBufferSlice>(
+      env, obj, std::move(store), byte_offset, length);
+}
+
+SharedBufferSlice::SharedBufferSlice(Environment* env,
+                                     Local<Object> object,
+                                     std::shared_ptr<BackingStore> store,
+                                     size_t byte_offset,
+                                     size_t length)
+    : BaseObject(env, object),
+      store_(std::move(store)),
+      byte_offset_(byte_offset),
+      length_(length) {
+  MakeWeak();
+}
+
+void SharedBufferSlice::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsSharedArrayBuffer());
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsNumber());
+  std::shared_ptr<BackingStore> store =
+      args[0].As<SharedArrayBuffer>()->GetBackingStore();
+  size_t byte_offset =
+      static_cast<size_t>(args[1].As<v8::Number>()->Value());
+  size_t length = static_cast<size_t>(args[2].As<v8::Number>()->Value());
+  CHECK_LE(byte_offset, store->ByteLength());
+  CHECK_LE(length, store->ByteLength() - byte_offset);
+  new SharedBufferSlice(
+      env, args.This(), std::move(store), byte_offset, length);
+}
+
+void SharedBufferSlice::GetBuffer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SharedBufferSlice* slice;
+  ASSIGN_OR_RETURN_UNWRAP(&slice, args.This());
+  CHECK(slice->store_);
+  Local<SharedArrayBuffer> sab =
+      SharedArrayBuffer::New(env->isolate(), slice->store_);
+  Local<v8::Uint8Array> buffer =
+      v8::Uint8Array::New(sab, slice->byte_offset_, slice->length_);
+  if (buffer->SetPrototypeV2(env->context(), env->buffer_prototype_object())
+          .IsNothing()) {
+    return;
+  }
+  args.GetReturnValue().Set(buffer);
+}
+
+void SharedBufferSlice::Release(const FunctionCallbackInfo<Value>& args) {
+  SharedBufferSlice* slice;
+  ASSIGN_OR_RETURN_UNWRAP(&slice, args.This());
+  slice->store_.reset();
+}
+
+BaseObject::TransferMode SharedBufferSlice::GetTransferMode() const {
+  if (!store_) return TransferMode::kDisallowCloneAndTransfer;
+  return TransferMode::kTransferable;
+}
+
+std::unique_ptr<TransferData> SharedBufferSlice::TransferForMessaging() {
+  return std::make_unique<Data>(std::move(store_), byte_offset_, length_);
+}
+
+void SharedBufferSlice::MemoryInfo(MemoryTracker* tracker) const {
+  // The slab is shared with other slices and threads, so only the part that
+  // belongs to this slice is attributed to it.
+  if (store_) tracker->TrackFieldWithSize("slice", length_);
+}
+
+SharedBufferSlice::Data::Data(std::shared_ptr<BackingStore> store,
+                              size_t byte_offset,
+                              size_t length)
+    : store_(std::move(store)), byte_offset_(byte_offset), length_(length) {}
+
+BaseObjectPtr<BaseObject> SharedBufferSlice::Data::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<TransferData> self) {
+  return SharedBufferSlice::Create(
+      env, std::move(store_), byte_offset_, length_);
+}
+
 BaseObjectPtr<JSTransferable> JSTransferable::Wrap(Environment* env,
                                                    Local<Object> target) {
   Local<Context> context = env->context();
@@ -1539,6 +2188,8 @@ Maybe<bool> SiblingGroup::Dispatch(
         return Just(true);
       }
     }
+    // All destinations share the message, and deserialize it once they
+    // receive it.
     port->AddToIncomingQueue(message);
   }
 
@@ -1716,6 +2367,11 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
                          target,
                          isolate_data->message_port_constructor_string(),
                          GetMessagePortConstructorTemplate(isolate_data));
+  SetConstructorFunction(
+      isolate,
+      target,
+      "SharedBufferSlice",
+      SharedBufferSlice::GetConstructorTemplate(isolate_data));
 
   SetMethod(isolate,
             target,
@@ -1762,6 +2418,9 @@ static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(MessagePort::Drain);
   registry->Register(MessagePort::ReceiveMessage);
   registry->Register(MessagePort::MoveToContext);
+  registry->Register(SharedBufferSlice::New);
+  registry->Register(SharedBufferSlice::GetBuffer);
+  registry->Register(SharedBufferSlice::Release);
   registry->Register(SetDeserializerCreateObjectFunction);
   registry->Register(StructuredClone);
   registry->Register(ExposeLazyDOMExceptionProperty);
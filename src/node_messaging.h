@@ -6,6 +6,7 @@
 #include "env.h"
 #include "node_mutex.h"
 #include "v8.h"
+#include <atomic>
 #include <deque>
 #include <string>
 #include <unordered_map>
@@ -60,8 +61,12 @@ class Message : public MemoryRetainer {
   // This is the last message to be received by a MessagePort.
   bool IsCloseMessage() const;
 
-  // Deserialize the contained JS value. May only be called once, and only
-  // after Serialize() has been called (e.g. by another thread).
+  // Deserialize the contained JS value. May only be called after Serialize()
+  // has been called (e.g. by another thread). Messages with transferables
+  // have a single receiver and may only be deserialized once. Other
+  // messages are not modified by this, so that a message that is dispatched
+  // to several ports can be shared between their threads and deserialized
+  // by each of them.
   v8::MaybeLocal<v8::Value> Deserialize(
       Environment* env,
       v8::Local<v8::Context> context,
@@ -118,6 +123,9 @@ class Message : public MemoryRetainer {
   std::vector<std::unique_ptr<TransferData>> transferables_;
   std::vector<v8::CompiledWasmModule> wasm_modules_;
   std::optional<v8::SharedValueConveyor> shared_value_conveyor_;
+  // Whether main_message_buf_ uses the format for plain data instead of the
+  // one of v8::ValueSerializer.
+  bool is_plain_data_ = false;
 
   friend class MessagePort;
 };
@@ -133,8 +141,10 @@ class SiblingGroup final : public std::enable_shared_from_this<SiblingGroup> {
   ~SiblingGroup();
 
   // Dispatches the Message to the collection of associated
-  // ports. If there is more than one destination port and
-  // the Message contains transferables, Dispatch will fail.
+  // ports. The same Message is added to the queue of every
+  // destination, without copying it. If there is more than
+  // one destination port and the Message contains
+  // transferables, Dispatch will fail.
   // Returns Just(true) if successful and the message was
   // dispatched to at least one destination. Returns Just(false)
   // if there were no destinations. Returns Nothing<bool>()
@@ -167,6 +177,47 @@ class SiblingGroup final : public std::enable_shared_from_this<SiblingGroup> {
   static Map groups_;
 };
 
+// The queue of messages that have been posted to a MessagePortData but not
+// yet received. Messages can be pushed from any thread without locking,
+// see https://www.1024cores.net/home/lock-free-algorithms/queues/
+// non-intrusive-mpsc-node-based-queue, but only the thread that currently
+// owns the port may look at or remove them.
+class IncomingMessageQueue {
+ public:
+  IncomingMessageQueue();
+  ~IncomingMessageQueue();
+
+  IncomingMessageQueue(const IncomingMessageQueue&) = delete;
+  IncomingMessageQueue& operator=(const IncomingMessageQueue&) = delete;
+
+  // This may be called from any thread.
+  void Push(std::shared_ptr<Message> message);
+
+  // These may only be called from the owning thread. A message that is in
+  // the middle of being pushed may not be visible yet; the producer wakes up
+  // the receiver again once it is.
+  Message* Peek() const;
+  std::shared_ptr<Message> Pop();
+  bool empty() const { return Peek() == nullptr; }
+  // An approximation of the number of queued messages.
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  void MemoryInfo(MemoryTracker* tracker) const;
+
+ private:
+  struct Node {
+    std::atomic<Node*> next { nullptr };
+    std::shared_ptr<Message> message;
+  };
+
+  // The last node, which producers append to.
+  std::atomic<Node*> tail_;
+  // A node whose message has already been removed. The next one, if any, is
+  // the front of the queue.
+  Node* head_;
+  std::atomic<size_t> size_ { 0 };
+};
+
 // This contains all data for a `MessagePort` instance that is not tied to
 // a specific Environment/Isolate/event loop, for easier transfer between those.
 class MessagePortData : public TransferData {
@@ -182,6 +233,10 @@ class MessagePortData : public TransferData {
   // Add a message to the incoming queue and notify the receiver.
   // This may be called from any thread.
   void AddToIncomingQueue(std::shared_ptr<Message> message);
+  // Blocks the owner's thread until there is a message in the queue, the
+  // timeout (in nanoseconds, or -1 for none) expires, or |env| is stopping.
+  // Returns whether there is a message.
+  bool WaitForMessage(Environment* env, int64_t timeout);
   v8::Maybe<bool> Dispatch(
       std::shared_ptr<Message> message,
       std::string* error = nullptr);
@@ -206,13 +261,19 @@ class MessagePortData : public TransferData {
   SET_SELF_SIZE(MessagePortData)
 
  private:
-  // This mutex protects all fields below it, with the exception of
-  // sibling_.
-  mutable Mutex mutex_;
   // TODO(addaleax): Make this a std::variant<std::shared_ptr, std::unique_ptr>
   // once that is available with C++17, because std::shared_ptr comes with
   // overhead that is only necessary for BroadcastChannel.
-  std::deque<std::shared_ptr<Message>> incoming_messages_;
+  IncomingMessageQueue incoming_messages_;
+  // Set by the first message that is added after the owner has started
+  // draining the queue, so that a burst of messages only wakes it up once.
+  std::atomic<bool> wakeup_pending_ { false };
+  // Set while the owner is blocked in WaitForMessage().
+  std::atomic<bool> waiting_ { false };
+  // This mutex protects all fields below it. It is only taken by senders
+  // when they need to wake up the owner.
+  mutable Mutex mutex_;
+  ConditionVariable message_cond_;
   MessagePort* owner_ = nullptr;
   std::shared_ptr<SiblingGroup> group_;
   friend class MessagePort;
@@ -377,6 +438,67 @@ class JSTransferable : public BaseObject {
   };
 };
 
+// A slice of a slab, i.e. a SharedArrayBuffer that is carved up by a
+// SharedBufferPool in lib/internal/worker/shared_buffer_pool.js. Moving
+// a slice to another thread only moves its reference to the backing store
+// of the slab, so that neither the data of the slice is copied nor are the
+// other slices of the slab detached. The memory of the slab is freed once
+// no thread holds a reference to it anymore.
+class SharedBufferSlice : public BaseObject {
+ public:
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      IsolateData* isolate_data);
+  static BaseObjectPtr<SharedBufferSlice> Create(
+      Environment* env,
+      std::shared_ptr<v8::BackingStore> store,
+      size_t byte_offset,
+      size_t length);
+
+  SharedBufferSlice(Environment* env,
+                    v8::Local<v8::Object> object,
+                    std::shared_ptr<v8::BackingStore> store,
+                    size_t byte_offset,
+                    size_t length);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Release(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<TransferData> TransferForMessaging() override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SharedBufferSlice)
+  SET_SELF_SIZE(SharedBufferSlice)
+
+ private:
+  class Data : public TransferData {
+   public:
+    Data(std::shared_ptr<v8::BackingStore> store,
+         size_t byte_offset,
+         size_t length);
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<TransferData> self) override;
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(SharedBufferSliceTransferData)
+    SET_SELF_SIZE(Data)
+
+   private:
+    std::shared_ptr<v8::BackingStore> store_;
+    size_t byte_offset_;
+    size_t length_;
+  };
+
+  // Reset once the slice has been transferred or released.
+  std::shared_ptr<v8::BackingStore> store_;
+  size_t byte_offset_;
+  size_t length_;
+};
+
 v8::Local<v8::FunctionTemplate> GetMessagePortConstructorTemplate(
     IsolateData* isolate_data);
 
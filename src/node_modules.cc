@@ -4,6 +4,9 @@
 #include "compile_cache.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_internals.h"
+#include "node_mutex.h"
+#include "node_threadsafe_cow-inl.h"
 #include "node_url.h"
 #include "path.h"
 #include "permission/permission.h"
@@ -92,16 +95,259 @@ Local<Array> BindingData::PackageConfig::Serialize(Realm* realm) const {
   return Array::New(isolate, values, 6);
 }
 
+namespace {
+
+// The parts of the stat of a file that tell whether it has been changed
+// since it was stat'ed.
+struct FileStat {
+  uv_timespec_t mtime = {0, 0};
+  uv_timespec_t ctime = {0, 0};
+  uint64_t size = 0;
+  uint64_t ino = 0;
+
+  static FileStat From(const uv_stat_t& stat) {
+    return FileStat{stat.st_mtim, stat.st_ctim, stat.st_size, stat.st_ino};
+  }
+
+  bool Matches(const uv_stat_t& stat) const {
+    return mtime.tv_sec == stat.st_mtim.tv_sec &&
+           mtime.tv_nsec == stat.st_mtim.tv_nsec &&
+           ctime.tv_sec == stat.st_ctim.tv_sec &&
+           ctime.tv_nsec == stat.st_ctim.tv_nsec && size == stat.st_size &&
+           ino == stat.st_ino;
+  }
+};
+
+bool StatFile(const std::string& path, uv_stat_t* stat) {
+  uv_fs_t req;
+  int rc = uv_fs_stat(nullptr, &req, path.c_str(), nullptr);
+  *stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  return rc == 0;
+}
+
+bool LStatFile(const std::string& path, uv_stat_t* stat) {
+  uv_fs_t req;
+  int rc = uv_fs_lstat(nullptr, &req, path.c_str(), nullptr);
+  *stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  return rc == 0;
+}
+
+// A package.json file that was read by any thread, together with the stat of
+// the file at that time, which tells whether it still has the same content.
+struct SharedPackageConfig {
+  std::shared_ptr<const BindingData::PackageConfig> config;
+  FileStat stat;
+
+  bool IsUpToDate(const uv_stat_t& current) const {
+    return stat.Matches(current);
+  }
+};
+
+// The package configs are immutable once they are parsed, so that all
+// realms of the process, including those of workers, can share them instead
+// of reading and parsing the same files again.
+ThreadsafeCopyOnWrite<std::unordered_map<std::string, SharedPackageConfig>>
+    shared_package_configs;
+
+std::filesystem::path ToFilesystemPath(const std::string& path) {
+#ifdef _WIN32
+  return std::filesystem::path(ConvertToWideString(path, GetACP()));
+#else
+  return std::filesystem::path(path);
+#endif
+}
+
+// A file system entry that a cached resolution was derived from, and whether
+// it existed at that time. Symbolic links are stat'ed themselves when
+// `follow_links` is false, so that re-pointing one is noticed.
+struct ResolutionDependency {
+  std::string path;
+  bool follow_links = true;
+  bool exists = false;
+  FileStat stat;
+
+  bool IsUpToDate() const {
+    uv_stat_t current;
+    const bool current_exists = follow_links ? StatFile(path, &current)
+                                             : LStatFile(path, &current);
+    return current_exists == exists && (!exists || stat.Matches(current));
+  }
+};
+
+// The result of resolving a specifier from a directory with the default
+// conditions. It is used as long as none of the entries that the resolution
+// probed changed: besides the resolved file and the package.json file that
+// applies to it, these are the directories the file could have been found in
+// instead, e.g. `./foo.js` next to `./foo/index.js`, every `node_modules`
+// directory up to the one that provided a package, and the symbolic links
+// that led to the package.
+struct CachedResolution {
+  std::string result;
+  std::vector<ResolutionDependency> dependencies;
+
+  bool IsUpToDate() const {
+    for (const auto& dependency : dependencies) {
+      if (!dependency.IsUpToDate()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Records the current state of `path`. Returns whether it exists, and
+  // whether it is a symbolic link in `*is_symlink`.
+  bool AddDependency(const std::filesystem::path& path,
+                     bool follow_links,
+                     bool* is_symlink = nullptr) {
+    ResolutionDependency dependency;
+    dependency.path = path.string();
+    dependency.follow_links = follow_links;
+    uv_stat_t stat;
+    dependency.exists = follow_links ? StatFile(dependency.path, &stat)
+                                     : LStatFile(dependency.path, &stat);
+    if (dependency.exists) {
+      dependency.stat = FileStat::From(stat);
+    }
+    if (is_symlink != nullptr) {
+      *is_symlink = dependency.exists && (stat.st_mode & S_IFMT) == S_IFLNK;
+    }
+    const bool exists = dependency.exists;
+    dependencies.push_back(std::move(dependency));
+    return exists;
+  }
+
+  // Records `path` as well as its directory, which tell whether a file with
+  // an extension or an index file now takes precedence.
+  void AddPathDependencies(const std::filesystem::path& path) {
+    AddDependency(path.parent_path(), true);
+    AddDependency(path, true);
+  }
+
+  // Records the `node_modules` directories that were searched for the
+  // package of the bare `specifier`, and the package that was found.
+  void AddPackageDependencies(std::string_view specifier,
+                              const std::filesystem::path& parent_path) {
+    if (specifier.empty()) {
+      return;
+    }
+    size_t name_end = specifier.find('/');
+    if (specifier[0] == '@' && name_end != std::string_view::npos) {
+      name_end = specifier.find('/', name_end + 1);
+    }
+    std::string_view name = specifier.substr(0, name_end);
+    std::string_view subpath = name_end == std::string_view::npos
+                                   ? std::string_view()
+                                   : specifier.substr(name_end + 1);
+    if (name.empty()) {
+      return;
+    }
+
+    std::filesystem::path dir = parent_path;
+    do {
+      auto node_modules = dir / "node_modules";
+      AddDependency(dir, true);
+      if (AddDependency(node_modules, true)) {
+        auto package = node_modules / ToFilesystemPath(std::string(name));
+        if (name[0] == '@') {
+          AddDependency(package.parent_path(), true);
+        }
+        bool is_symlink;
+        if (AddDependency(package, false, &is_symlink)) {
+          // Follow the chain of symbolic links, as package managers like
+          // pnpm re-point them to install another version.
+          for (int hops = 0; is_symlink && hops < 32; hops++) {
+            std::error_code error;
+            auto target = std::filesystem::read_symlink(package, error);
+            if (error) {
+              break;
+            }
+            package = (package.parent_path() / target).lexically_normal();
+            AddDependency(package, false, &is_symlink);
+          }
+          if (!subpath.empty()) {
+            AddPathDependencies(
+                package / ToFilesystemPath(std::string(subpath)));
+          }
+          return;
+        }
+      }
+      if (dir.parent_path() == dir) {
+        return;
+      }
+      dir = dir.parent_path();
+    } while (true);
+  }
+};
+
+bool IsPathSpecifier(std::string_view specifier) {
+  if (specifier == "." || specifier == ".." || specifier.starts_with("./") ||
+      specifier.starts_with("../") || specifier.starts_with("/")) {
+    return true;
+  }
+#ifdef _WIN32
+  return specifier.starts_with(".\\") || specifier.starts_with("..\\") ||
+         specifier.starts_with("\\") ||
+         (specifier.size() >= 2 && specifier[1] == ':');
+#else
+  return false;
+#endif
+}
+
+// Resolutions are keyed by a description of the resolver and its options, the
+// parent directory and the specifier. They are shared by all realms of the
+// process, including those of workers.
+ThreadsafeCopyOnWrite<std::unordered_map<std::string, CachedResolution>>
+    resolution_cache;
+
+std::string GetResolutionKey(std::string_view resolver,
+                             std::string_view parent_path,
+                             std::string_view specifier) {
+  std::string key;
+  key.reserve(resolver.size() + parent_path.size() + specifier.size() + 2);
+  key += resolver;
+  key += '\0';
+  key += parent_path;
+  key += '\0';
+  key += specifier;
+  return key;
+}
+
+}  // namespace
+
 const BindingData::PackageConfig* BindingData::GetPackageJSON(
     Realm* realm, std::string_view path, ErrorContext* error_context) {
   auto binding_data = realm->GetBindingData<BindingData>();
 
   auto cache_entry = binding_data->package_configs_.find(path.data());
   if (cache_entry != binding_data->package_configs_.end()) {
-    return &cache_entry->second;
+    return cache_entry->second.get();
+  }
+
+  // The file is stat'ed before it is read, so that a change while it is read
+  // shows up as a different stat the next time.
+  uv_fs_t req;
+  int rc = uv_fs_stat(nullptr, &req, path.data(), nullptr);
+  const uv_stat_t stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  if (rc < 0) {
+    return nullptr;
   }
 
-  PackageConfig package_config{};
+  {
+    auto shared = shared_package_configs.read();
+    auto shared_entry = shared->find(path.data());
+    if (shared_entry != shared->end() &&
+        shared_entry->second.IsUpToDate(stat)) {
+      auto cached = binding_data->package_configs_.emplace(
+          std::string(path), shared_entry->second.config);
+      return cached.first->second.get();
+    }
+  }
+
+  auto package_config_ptr = std::make_shared<PackageConfig>();
+  PackageConfig& package_config = *package_config_ptr;
   package_config.file_path = path;
   // No need to exclude BOM since simdjson will skip it.
   if (ReadFileSync(&package_config.raw_json, path.data()) < 0) {
@@ -246,12 +492,13 @@ const BindingData::PackageConfig* BindingData::GetPackageJSON(
       }
     }
   }
-  // package_config could be quite large, so we should move it instead of
-  // copying it.
-  auto cached = binding_data->package_configs_.insert(
-      {std::string(path), std::move(package_config)});
+  shared_package_configs.write()->insert_or_assign(
+      std::string(path),
+      SharedPackageConfig{package_config_ptr, FileStat::From(stat)});
+  auto cached = binding_data->package_configs_.emplace(
+      std::string(path), std::move(package_config_ptr));
 
-  return &cached.first->second;
+  return cached.first->second.get();
 }
 
 void BindingData::ReadPackageJSON(const FunctionCallbackInfo<Value>& args) {
@@ -486,6 +733,105 @@ void BindingData::GetPackageScopeConfig(
   }
 }
 
+void BindingData::GetCachedResolution(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK_GE(args.Length(), 3);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsString());
+
+  Realm* realm = Realm::GetCurrent(args);
+  Environment* env = realm->env();
+  // The file system checks below are not subject to the permission model.
+  if (!env->use_compile_cache() || env->permission()->enabled()) {
+    return;
+  }
+
+  Isolate* isolate = realm->isolate();
+  Utf8Value specifier(isolate, args[0]);
+  Utf8Value parent_path(isolate, args[1]);
+  Utf8Value resolver(isolate, args[2]);
+  std::string key = GetResolutionKey(resolver.ToStringView(),
+                                     parent_path.ToStringView(),
+                                     specifier.ToStringView());
+  CachedResolution resolution;
+  {
+    auto cache = resolution_cache.read();
+    auto it = cache->find(key);
+    if (it == cache->end()) {
+      return;
+    }
+    resolution = it->second;
+  }
+
+  if (!resolution.IsUpToDate()) {
+    Debug(env,
+          DebugCategory::COMPILE_CACHE,
+          "[compile cache] resolution of %s from %s is stale\n",
+          *specifier,
+          *parent_path);
+    resolution_cache.write()->erase(key);
+    return;
+  }
+
+  Local<Value> result;
+  if (ToV8Value(realm->context(), resolution.result).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
+void BindingData::CacheResolution(const FunctionCallbackInfo<Value>& args) {
+  CHECK_GE(args.Length(), 5);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsString());
+  CHECK(args[3]->IsString());
+  CHECK(args[4]->IsString());
+
+  Realm* realm = Realm::GetCurrent(args);
+  Environment* env = realm->env();
+  if (!env->use_compile_cache() || env->permission()->enabled()) {
+    return;
+  }
+
+  Isolate* isolate = realm->isolate();
+  Utf8Value specifier(isolate, args[0]);
+  Utf8Value parent_path(isolate, args[1]);
+  Utf8Value resolver(isolate, args[2]);
+  Utf8Value filename(isolate, args[3]);
+  Utf8Value result(isolate, args[4]);
+
+  CachedResolution resolution;
+  resolution.result = result.ToString();
+
+  auto parent = ToFilesystemPath(parent_path.ToString());
+  auto file = ToFilesystemPath(filename.ToString());
+  if (!resolution.AddDependency(parent, true) ||
+      !resolution.AddDependency(file, true)) {
+    return;
+  }
+  std::string_view specifier_view = specifier.ToStringView();
+  if (IsPathSpecifier(specifier_view)) {
+    resolution.AddPathDependencies(
+        (parent / ToFilesystemPath(specifier.ToString())).lexically_normal());
+  } else {
+    resolution.AddPackageDependencies(specifier_view, parent);
+  }
+
+  auto package_json = TraverseParent(realm, file);
+  if (package_json != nullptr &&
+      !resolution.AddDependency(ToFilesystemPath(package_json->file_path),
+                                true)) {
+    return;
+  }
+
+  resolution_cache.write()->insert_or_assign(
+      GetResolutionKey(resolver.ToStringView(),
+                       parent_path.ToStringView(),
+                       specifier_view),
+      std::move(resolution));
+}
+
 void FlushCompileCache(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -693,6 +1039,8 @@ void BindingData::CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(
       isolate, target, "getPackageScopeConfig", GetPackageScopeConfig<false>);
   SetMethod(isolate, target, "getPackageType", GetPackageScopeConfig<true>);
+  SetMethod(isolate, target, "getCachedResolution", GetCachedResolution);
+  SetMethod(isolate, target, "cacheResolution", CacheResolution);
   SetMethod(isolate, target, "enableCompileCache", EnableCompileCache);
   SetMethod(isolate, target, "getCompileCacheDir", GetCompileCacheDir);
   SetMethod(isolate, target, "flushCompileCache", FlushCompileCache);
@@ -749,6 +1097,8 @@ void BindingData::RegisterExternalReferences(
   registry->Register(GetNearestParentPackageJSON);
   registry->Register(GetPackageScopeConfig<false>);
   registry->Register(GetPackageScopeConfig<true>);
+  registry->Register(GetCachedResolution);
+  registry->Register(CacheResolution);
   registry->Register(EnableCompileCache);
   registry->Register(GetCompileCacheDir);
   registry->Register(FlushCompileCache);
@@ -11,6 +11,7 @@
 #include "v8.h"
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -64,6 +65,9 @@ class BindingData : public SnapshotableObject {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetPackageJSONScripts(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCachedResolution(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CacheResolution(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void CreatePerIsolateProperties(IsolateData* isolate_data,
                                          v8::Local<v8::ObjectTemplate> ctor);
@@ -74,7 +78,10 @@ class BindingData : public SnapshotableObject {
   static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
  private:
-  std::unordered_map<std::string, PackageConfig> package_configs_;
+  // The package configs that were used by this realm. They are shared with
+  // the other threads through a process-wide cache.
+  std::unordered_map<std::string, std::shared_ptr<const PackageConfig>>
+      package_configs_;
   simdjson::ondemand::parser json_parser;
   // returns null on error
   static const PackageConfig* GetPackageJSON(
@@ -75,6 +75,32 @@ void DebugOptions::CheckOptions(std::vector<std::string>* errors,
 
 void PerProcessOptions::CheckOptions(std::vector<std::string>* errors,
                                      std::vector<std::string>* argv) {
+  for (const std::string& limit : threadpool_work_limits) {
+    ThreadPoolWorkClass work_class;
+    uint32_t value;
+    if (!ParseThreadPoolWorkLimit(limit, &work_class, &value)) {
+      errors->push_back("invalid value for --threadpool-work-limit: " + limit);
+    }
+  }
+
+  if (!experimental_async_stdio.empty() &&
+      experimental_async_stdio != "block" &&
+      experimental_async_stdio != "drop") {
+    errors->push_back("invalid value for --experimental-async-stdio: " +
+                      experimental_async_stdio);
+  }
+
+  if (experimental_async_stdio_buffer_size == 0 ||
+      experimental_async_stdio_buffer_size > 1024 * 1024 * 1024) {
+    errors->push_back("--experimental-async-stdio-buffer-size must be "
+                      "between 1 and 1073741824");
+  }
+
+  if (trace_event_format != "json" && trace_event_format != "perfetto") {
+    errors->push_back("invalid value for --trace-event-format: " +
+                      trace_event_format);
+  }
+
 #if HAVE_OPENSSL
   if (use_openssl_ca && use_bundled_ca) {
     errors->push_back("either --use-openssl-ca or --use-bundled-ca can be "
@@ -97,6 +123,10 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors,
       errors->push_back("--secure-heap-min must be a power of 2");
   }
 #endif  // V8_ENABLE_SANDBOX
+
+  if (crypto_threadpool_size < 0 || crypto_threadpool_size > 1024) {
+    errors->push_back("--crypto-threadpool-size must be between 0 and 1024");
+  }
 #endif  // HAVE_OPENSSL
 
   if (use_largepages != "off" &&
@@ -109,6 +139,10 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors,
 
 void PerIsolateOptions::CheckOptions(std::vector<std::string>* errors,
                                      std::vector<std::string>* argv) {
+  if (!build_snapshot_base.empty() && !build_snapshot) {
+    errors->push_back("--build-snapshot-base must be used with "
+                      "--build-snapshot or --build-snapshot-config");
+  }
   per_env->CheckOptions(errors, argv);
 }
 
@@ -146,6 +180,13 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors,
     errors->push_back("--heapsnapshot-near-heap-limit must not be negative");
   }
 
+  if (!heap_snapshot_compression.empty() &&
+      heap_snapshot_compression != "gzip" &&
+      heap_snapshot_compression != "zstd") {
+    errors->push_back("invalid value for --heapsnapshot-compression: " +
+                      heap_snapshot_compression);
+  }
+
   if (!trace_require_module.empty() && trace_require_module != "all" &&
       trace_require_module != "no-node-modules") {
     errors->push_back("invalid value for --trace-require-module");
@@ -215,6 +256,21 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors,
     if (cpu_prof_interval != kDefaultCpuProfInterval) {
       errors->push_back("--cpu-prof-interval must be used with --cpu-prof");
     }
+    if (cpu_prof_window != 0) {
+      errors->push_back("--cpu-prof-window must be used with --cpu-prof");
+    }
+    if (cpu_prof_format != "cpuprofile") {
+      errors->push_back("--cpu-prof-format must be used with --cpu-prof");
+    }
+  }
+
+  if (cpu_prof_format != "cpuprofile" && cpu_prof_format != "pprof") {
+    errors->push_back("invalid value for --cpu-prof-format: " +
+                      cpu_prof_format);
+  }
+
+  if (cpu_prof_window != 0 && !cpu_prof_name.empty()) {
+    errors->push_back("--cpu-prof-name cannot be used with --cpu-prof-window");
   }
 
   if (cpu_prof && cpu_prof_dir.empty() && !diagnostic_dir.empty()) {
@@ -233,6 +289,22 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors,
     if (heap_prof_interval != kDefaultHeapProfInterval) {
       errors->push_back("--heap-prof-interval must be used with --heap-prof");
     }
+    if (heap_prof_window != 0) {
+      errors->push_back("--heap-prof-window must be used with --heap-prof");
+    }
+    if (heap_prof_format != "heapprofile") {
+      errors->push_back("--heap-prof-format must be used with --heap-prof");
+    }
+  }
+
+  if (heap_prof_format != "heapprofile" && heap_prof_format != "pprof") {
+    errors->push_back("invalid value for --heap-prof-format: " +
+                      heap_prof_format);
+  }
+
+  if (heap_prof_window != 0 && !heap_prof_name.empty()) {
+    errors->push_back(
+        "--heap-prof-name cannot be used with --heap-prof-window");
   }
 
   if (heap_prof && heap_prof_dir.empty() && !diagnostic_dir.empty()) {
@@ -475,6 +547,14 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             kAllowedInEnvvar);
   AddAlias("--enable-network-family-autoselection",
            "--network-family-autoselection");
+  AddOption("--experimental-io-uring-sockets",
+            "read and write TCP and pipe sockets through io_uring on Linux",
+            &EnvironmentOptions::experimental_io_uring_sockets,
+            kAllowedInEnvvar);
+  AddOption("--experimental-stream-read-slabs",
+            "carve socket reads out of slabs that are shared between reads",
+            &EnvironmentOptions::experimental_stream_read_slabs,
+            kAllowedInEnvvar);
   AddOption("--enable-source-maps",
             "Source Map V3 support for stack traces",
             &EnvironmentOptions::enable_source_maps,
@@ -523,6 +603,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "file used to persist localStorage data",
             &EnvironmentOptions::localstorage_file,
             kAllowedInEnvvar);
+  AddOption("--localstorage-write-back",
+            "batch localStorage writes into one transaction per tick",
+            &EnvironmentOptions::localstorage_write_back,
+            kAllowedInEnvvar);
   AddOption("--experimental-global-navigator",
             "expose experimental Navigator API on the global scope",
             &EnvironmentOptions::experimental_global_navigator,
@@ -544,6 +628,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental ES Module import.meta.resolve() parentURL support",
             &EnvironmentOptions::experimental_import_meta_resolve,
             kAllowedInEnvvar);
+  AddOption("--experimental-module-streaming",
+            "parse and compile imported ES modules on worker threads",
+            &EnvironmentOptions::experimental_module_streaming,
+            kAllowedInEnvvar);
   AddOption("--permission",
             "enable the permission system",
             &EnvironmentOptions::permission,
@@ -607,6 +695,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "heap snapshots will be generated.",
             &EnvironmentOptions::heap_snapshot_near_heap_limit,
             kAllowedInEnvvar);
+  AddOption("--heapsnapshot-compression",
+            "compress the heap snapshots generated by --heapsnapshot-signal "
+            "and --heapsnapshot-near-heap-limit with 'gzip' or 'zstd'",
+            &EnvironmentOptions::heap_snapshot_compression,
+            kAllowedInEnvvar);
   AddOption("--http-parser", "", NoOp{}, kAllowedInEnvvar);
   AddOption("--insecure-http-parser",
             "use an insecure HTTP parser that accepts invalid HTTP headers",
@@ -701,6 +794,17 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "placed. Does not affect --prof.",
             &EnvironmentOptions::cpu_prof_dir,
             kAllowedInEnvvar);
+  AddOption("--cpu-prof-window",
+            "write the V8 CPU profile generated with --cpu-prof to a new file "
+            "every specified number of milliseconds, without stopping the "
+            "profiler",
+            &EnvironmentOptions::cpu_prof_window,
+            kAllowedInEnvvar);
+  AddOption("--cpu-prof-format",
+            "format of the V8 CPU profiles generated with --cpu-prof, "
+            "'cpuprofile' (default) or 'pprof'",
+            &EnvironmentOptions::cpu_prof_format,
+            kAllowedInEnvvar);
   AddOption("--experimental-network-inspection",
             "experimental network inspection support",
             &EnvironmentOptions::experimental_network_inspection);
@@ -729,11 +833,27 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "profile generated with --heap-prof. (default: 512 * 1024)",
             &EnvironmentOptions::heap_prof_interval,
             kAllowedInEnvvar);
+  AddOption("--heap-prof-window",
+            "write the V8 heap profile generated with --heap-prof to a new "
+            "file every specified number of milliseconds, without stopping "
+            "the profiler",
+            &EnvironmentOptions::heap_prof_window,
+            kAllowedInEnvvar);
+  AddOption("--heap-prof-format",
+            "format of the V8 heap profiles generated with --heap-prof, "
+            "'heapprofile' (default) or 'pprof'",
+            &EnvironmentOptions::heap_prof_format,
+            kAllowedInEnvvar);
 #endif  // HAVE_INSPECTOR
   AddOption("--max-http-header-size",
             "set the maximum size of HTTP headers (default: 16384 (16KB))",
             &EnvironmentOptions::max_http_header_size,
             kAllowedInEnvvar);
+  AddOption("--message-port-batch-size",
+            "maximum number of messages a MessagePort emits before yielding "
+            "to the event loop (default: 0, meaning all queued messages)",
+            &EnvironmentOptions::message_port_batch_size,
+            kAllowedInEnvvar);
   AddOption("--redirect-warnings",
             "write warnings to file instead of stderr",
             &EnvironmentOptions::redirect_warnings,
@@ -881,6 +1001,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "show stack trace when an environment exits",
             &EnvironmentOptions::trace_exit,
             kAllowedInEnvvar);
+  AddOption("--trace-event-loop-stalls",
+            "show stack traces when the event loop does not make progress "
+            "for longer than the given number of milliseconds",
+            &EnvironmentOptions::trace_event_loop_stalls,
+            kAllowedInEnvvar);
   AddOption("--trace-sync-io",
             "show stack trace when use of sync IO is detected after the "
             "first tick",
@@ -1097,6 +1222,11 @@ PerIsolateOptionsParser::PerIsolateOptionsParser(
             "generate diagnostic report upon receiving signals",
             &PerIsolateOptions::report_on_signal,
             kAllowedInEnvvar);
+  AddOption("--report-on-event-loop-stall",
+            "generate diagnostic report instead of printing stack traces "
+            "for the stalls detected with --trace-event-loop-stalls",
+            &PerIsolateOptions::report_on_event_loop_stall,
+            kAllowedInEnvvar);
   AddOption("--report-signal",
             "causes diagnostic report to be produced on provided signal,"
             " unsupported in Windows. (default: SIGUSR2)",
@@ -1128,6 +1258,11 @@ PerIsolateOptionsParser::PerIsolateOptionsParser(
             &PerIsolateOptions::build_snapshot_config,
             kDisallowedInEnvvar);
   Implies("--build-snapshot-config", "--build-snapshot");
+  AddOption("--build-snapshot-base",
+            "Build the snapshot on top of the snapshot blob in the "
+            "specified path instead of from scratch.",
+            &PerIsolateOptions::build_snapshot_base,
+            kDisallowedInEnvvar);
 
   Insert(eop, &PerIsolateOptions::get_per_env_options);
 }
@@ -1147,6 +1282,10 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "data, it supports ${rotation} and ${pid}.",
             &PerProcessOptions::trace_event_file_pattern,
             kAllowedInEnvvar);
+  AddOption("--trace-event-format",
+            "format of the trace-events data, 'json' (default) or 'perfetto'",
+            &PerProcessOptions::trace_event_format,
+            kAllowedInEnvvar);
   AddAlias("--trace-events-enabled", {
     "--trace-event-categories", "v8,node,node.async_hooks" });
   AddOption("--v8-pool-size",
@@ -1161,6 +1300,25 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "", /* undocumented, only for debugging */
             &PerProcessOptions::debug_arraybuffer_allocations,
             kAllowedInEnvvar);
+  AddOption("--experimental-arraybuffer-slab-allocator",
+            "serve small ArrayBuffer backing stores from per-thread slabs",
+            &PerProcessOptions::experimental_arraybuffer_slab_allocator,
+            kAllowedInEnvvar);
+  AddOption("--experimental-async-stdio",
+            "write stdout and stderr from a separate thread, either "
+            "blocking or dropping writes when its buffer is full "
+            "(block, drop)",
+            &PerProcessOptions::experimental_async_stdio,
+            kAllowedInEnvvar);
+  AddOption("--experimental-async-stdio-buffer-size",
+            "size of the buffer of --experimental-async-stdio in bytes",
+            &PerProcessOptions::experimental_async_stdio_buffer_size,
+            kAllowedInEnvvar);
+  AddOption("--experimental-cpu-quota-aware",
+            "size thread pools and os.availableParallelism() according to "
+            "the cgroup CPU quota",
+            &PerProcessOptions::experimental_cpu_quota_aware,
+            kAllowedInEnvvar);
   AddOption("--disable-proto",
             "disable Object.prototype.__proto__",
             &PerProcessOptions::disable_proto,
@@ -1281,6 +1439,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             &PerProcessOptions::secure_heap_min,
             kAllowedInEnvvar);
 #endif  // V8_ENABLE_SANDBOX
+  AddOption("--crypto-threadpool-size",
+            "number of threads that run asynchronous crypto jobs instead of "
+            "the libuv threadpool (0 disables the dedicated threadpool)",
+            &PerProcessOptions::crypto_threadpool_size,
+            kAllowedInEnvvar);
 #endif  // HAVE_OPENSSL
 #if OPENSSL_VERSION_MAJOR >= 3
   AddOption("--openssl-legacy-provider",
@@ -1300,11 +1463,40 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "or 'silent' (map and silently ignore failure)",
             &PerProcessOptions::use_largepages,
             kAllowedInEnvvar);
+  AddOption("--threadpool-work-limit",
+            "limit how many work items of a class run in the libuv "
+            "threadpool at the same time, as <class>=<limit>, where <class> "
+            "is one of 'fs', 'crypto', 'compression', 'addon', or 'other'",
+            &PerProcessOptions::threadpool_work_limits,
+            kAllowedInEnvvar);
+  AddOption("--max-linear-memory-size",
+            "maximum size of the linear memory (in MiB), memory is released "
+            "when 90% of it is in use (WASI only)",
+            &PerProcessOptions::max_linear_memory_size,
+            kAllowedInEnvvar);
+  AddOption("--experimental-worker-isolate-pool",
+            "number of isolates to deserialize ahead of time for Workers",
+            &PerProcessOptions::worker_isolate_pool_size,
+            kAllowedInEnvvar);
+  AddOption("--experimental-worker-isolate-pool-max-uses",
+            "number of Workers that may run on one pooled isolate",
+            &PerProcessOptions::worker_isolate_pool_max_uses,
+            kAllowedInEnvvar);
+  AddOption("--use-largepages-heap",
+            "advise the kernel to back the V8 heap and code space with "
+            "transparent huge pages (Linux only)",
+            &PerProcessOptions::use_largepages_heap,
+            kAllowedInEnvvar);
 
   AddOption("--trace-sigint",
             "enable printing JavaScript stacktrace on SIGINT",
             &PerProcessOptions::trace_sigint,
             kAllowedInEnvvar);
+  AddOption("--experimental-spawn-zygote",
+            "spawn child processes through a helper process that is forked "
+            "at startup (Linux only)",
+            &PerProcessOptions::experimental_spawn_zygote,
+            kAllowedInEnvvar);
 
   Insert(iop, &PerProcessOptions::get_per_isolate_options);
 
@@ -1330,6 +1522,10 @@ PerProcessOptionsParser::PerProcessOptionsParser(
       "performance.",
       &PerProcessOptions::disable_wasm_trap_handler,
       kAllowedInEnvvar);
+  AddOption("--experimental-module-stat-cache",
+            "cache the file system lookups made during module resolution",
+            &PerProcessOptions::experimental_module_stat_cache,
+            kAllowedInEnvvar);
 }
 
 inline std::string RemoveBrackets(const std::string& host) {
@@ -131,10 +131,12 @@ class EnvironmentOptions : public Options {
   bool experimental_quic = false;
 #endif
   std::string localstorage_file;
+  bool localstorage_write_back = false;
   bool experimental_global_navigator = true;
   bool experimental_global_web_crypto = true;
   bool experimental_wasm_modules = false;
   bool experimental_import_meta_resolve = false;
+  bool experimental_module_streaming = false;
   std::string input_type;  // Value of --input-type
   bool entry_is_url = false;
   bool permission = false;
@@ -152,9 +154,13 @@ class EnvironmentOptions : public Options {
   bool frozen_intrinsics = false;
   int64_t heap_snapshot_near_heap_limit = 0;
   std::string heap_snapshot_signal;
+  std::string heap_snapshot_compression;
   bool network_family_autoselection = true;
+  bool experimental_io_uring_sockets = false;
+  bool experimental_stream_read_slabs = false;
   uint64_t network_family_autoselection_attempt_timeout = 250;
   uint64_t max_http_header_size = 16 * 1024;
+  uint64_t message_port_batch_size = 0;
   bool deprecation = true;
   bool force_async_hooks_checks = true;
   bool allow_native_addons = true;
@@ -171,6 +177,8 @@ class EnvironmentOptions : public Options {
   static const uint64_t kDefaultCpuProfInterval = 1000;
   uint64_t cpu_prof_interval = kDefaultCpuProfInterval;
   std::string cpu_prof_name;
+  uint64_t cpu_prof_window = 0;
+  std::string cpu_prof_format = "cpuprofile";
   bool cpu_prof = false;
   bool experimental_network_inspection = false;
   bool experimental_worker_inspection = false;
@@ -178,6 +186,8 @@ class EnvironmentOptions : public Options {
   std::string heap_prof_name;
   static const uint64_t kDefaultHeapProfInterval = 512 * 1024;
   uint64_t heap_prof_interval = kDefaultHeapProfInterval;
+  uint64_t heap_prof_window = 0;
+  std::string heap_prof_format = "heapprofile";
   bool heap_prof = false;
 #endif  // HAVE_INSPECTOR
   std::string redirect_warnings;
@@ -209,6 +219,7 @@ class EnvironmentOptions : public Options {
   bool throw_deprecation = false;
   bool trace_deprecation = false;
   bool trace_exit = false;
+  uint64_t trace_event_loop_stalls = 0;
   bool trace_sync_io = false;
   bool trace_tls = false;
   bool trace_uncaught = false;
@@ -282,11 +293,13 @@ class PerIsolateOptions : public Options {
   bool track_heap_objects = false;
   bool report_uncaught_exception = false;
   bool report_on_signal = false;
+  bool report_on_event_loop_stall = false;
   bool experimental_shadow_realm = false;
   int64_t stack_trace_limit = 10;
   std::string report_signal = "SIGUSR2";
   bool build_snapshot = false;
   std::string build_snapshot_config;
+  std::string build_snapshot_base;
   inline EnvironmentOptions* get_per_env_options();
   void CheckOptions(std::vector<std::string>* errors,
                     std::vector<std::string>* argv) override;
@@ -312,9 +325,14 @@ class PerProcessOptions : public Options {
   std::string title;
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
+  std::string trace_event_format = "json";
   int64_t v8_thread_pool_size = 4;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
+  bool experimental_arraybuffer_slab_allocator = false;
+  bool experimental_cpu_quota_aware = false;
+  std::string experimental_async_stdio;
+  uint64_t experimental_async_stdio_buffer_size = 1024 * 1024;
   std::string disable_proto;
   // We enable the shared read-only heap which currently requires that the
   // snapshot used in different isolates in the same process to be the same.
@@ -341,6 +359,7 @@ class PerProcessOptions : public Options {
   std::string tls_cipher_list = DEFAULT_CIPHER_LIST_CORE;
   int64_t secure_heap = 0;
   int64_t secure_heap_min = 2;
+  int64_t crypto_threadpool_size = 0;
 #ifdef NODE_OPENSSL_CERT_STORE
   bool ssl_openssl_cert_store = true;
 #else
@@ -359,6 +378,9 @@ class PerProcessOptions : public Options {
 
   bool disable_wasm_trap_handler = false;
 
+  // Per-process so that the cache can be shared by all worker threads.
+  bool experimental_module_stat_cache = false;
+
   // Per-process because reports can be triggered outside a known V8 context.
   bool report_on_fatalerror = false;
   bool report_compact = false;
@@ -367,7 +389,14 @@ class PerProcessOptions : public Options {
 
   // TODO(addaleax): Some of these could probably be per-Environment.
   std::string use_largepages = "off";
+  bool use_largepages_heap = false;
+  std::vector<std::string> threadpool_work_limits;
+  uint64_t max_linear_memory_size = 4096;
+  uint64_t worker_isolate_pool_size = 0;
+  uint64_t worker_isolate_pool_max_uses = 1;
   bool trace_sigint = false;
+  // Per-process because the zygote is forked during process initialization.
+  bool experimental_spawn_zygote = false;
   std::vector<std::string> cmdline;
 
   inline PerIsolateOptions* get_per_isolate_options();
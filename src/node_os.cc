@@ -32,9 +32,17 @@
 # include <climits>         // PATH_MAX on Solaris.
 #endif  // __POSIX__
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 namespace node {
 namespace os {
@@ -408,14 +416,139 @@ static void GetPriority(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(priority);
 }
 
-static void GetAvailableParallelism(const FunctionCallbackInfo<Value>& args) {
+namespace {
+
+std::atomic<bool> cpu_quota_enabled{false};
+std::atomic<unsigned int> cpu_quota_limit{0};
+std::atomic<uint64_t> cpu_quota_read_at{0};
+// The quota of a running container can be changed, so it is re-read at most
+// this often (in nanoseconds).
+constexpr uint64_t kCpuQuotaRefreshInterval = 1000 * 1000 * 1000;
+
+// Returns the number of CPUs that a quota amounts to, or 0 if there is none.
+unsigned int CpuLimitFromQuota(double quota, double period) {
+  if (!(quota > 0) || !(period > 0)) return 0;
+  double cpus = std::ceil(quota / period);
+  if (cpus >= UINT_MAX) return 0;
+  return std::max(static_cast<unsigned int>(cpus), 1u);
+}
+
+#ifdef __linux__
+// With cgroup v2 the quota is in cpu.max ("<quota> <period>" or
+// "max <period>"), and any of the ancestors of the cgroup can set one.
+unsigned int ReadCgroup2CpuLimit(std::string path) {
+  unsigned int limit = 0;
+  while (true) {
+    std::string text;
+    std::string file = "/sys/fs/cgroup" + path + "/cpu.max";
+    double quota;
+    double period;
+    if (ReadFileSync(&text, file.c_str()) == 0 &&
+        sscanf(text.c_str(), "%lf %lf", &quota, &period) == 2) {
+      unsigned int current = CpuLimitFromQuota(quota, period);
+      if (current != 0 && (limit == 0 || current < limit)) limit = current;
+    }
+    if (path.empty() || path == "/") break;
+    path.resize(path.rfind('/'));
+  }
+  return limit;
+}
+
+// With cgroup v1 the quota is in cpu.cfs_quota_us (-1 if there is none) and
+// cpu.cfs_period_us of the cpu controller. Containers usually see their own
+// cgroup at the root of the mount.
+unsigned int ReadCgroup1CpuLimit(std::string_view controllers,
+                                 const std::string& path) {
+  std::string mount = "/sys/fs/cgroup/" + std::string(controllers);
+  for (const std::string& dir : {mount + path, mount}) {
+    std::string quota;
+    std::string period;
+    if (ReadFileSync(&quota, (dir + "/cpu.cfs_quota_us").c_str()) != 0 ||
+        ReadFileSync(&period, (dir + "/cpu.cfs_period_us").c_str()) != 0) {
+      continue;
+    }
+    return CpuLimitFromQuota(strtod(quota.c_str(), nullptr),
+                             strtod(period.c_str(), nullptr));
+  }
+  return 0;
+}
+
+bool HasController(std::string_view controllers, std::string_view name) {
+  while (!controllers.empty()) {
+    size_t comma = controllers.find(',');
+    if (controllers.substr(0, comma) == name) return true;
+    if (comma == std::string_view::npos) break;
+    controllers.remove_prefix(comma + 1);
+  }
+  return false;
+}
+#endif  // __linux__
+
+unsigned int ReadCpuQuotaLimit() {
+#ifdef __linux__
+  std::string cgroups;
+  if (ReadFileSync(&cgroups, "/proc/self/cgroup") != 0) return 0;
+
+  // Each line is "<id>:<controllers>:<path>". The cgroup v2 hierarchy has id
+  // 0 and no controllers. On hybrid systems the cpu controller can still be
+  // attached to a v1 hierarchy, which takes precedence then.
+  std::string_view rest = cgroups;
+  std::string cgroup2_path;
+  bool has_cgroup2 = false;
+  while (!rest.empty()) {
+    size_t eol = rest.find('\n');
+    std::string_view line = rest.substr(0, eol);
+    rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+
+    size_t first = line.find(':');
+    if (first == std::string_view::npos) continue;
+    size_t second = line.find(':', first + 1);
+    if (second == std::string_view::npos) continue;
+    std::string_view id = line.substr(0, first);
+    std::string_view controllers = line.substr(first + 1, second - first - 1);
+    std::string path(line.substr(second + 1));
+
+    if (HasController(controllers, "cpu")) {
+      return ReadCgroup1CpuLimit(controllers, path);
+    }
+    if (id == "0" && controllers.empty()) {
+      has_cgroup2 = true;
+      cgroup2_path = std::move(path);
+    }
+  }
+  if (has_cgroup2) return ReadCgroup2CpuLimit(std::move(cgroup2_path));
+#endif  // __linux__
+  return 0;
+}
+
+}  // anonymous namespace
+
+void EnableCpuQuota() {
+  cpu_quota_enabled.store(true, std::memory_order_relaxed);
+}
+
+unsigned int AvailableParallelism() {
   unsigned int parallelism = uv_available_parallelism();
+  if (!cpu_quota_enabled.load(std::memory_order_relaxed)) return parallelism;
+
+  uint64_t now = uv_hrtime();
+  uint64_t read_at = cpu_quota_read_at.load(std::memory_order_relaxed);
+  if (read_at == 0 || now - read_at >= kCpuQuotaRefreshInterval) {
+    cpu_quota_limit.store(ReadCpuQuotaLimit(), std::memory_order_relaxed);
+    cpu_quota_read_at.store(now, std::memory_order_relaxed);
+  }
+  unsigned int limit = cpu_quota_limit.load(std::memory_order_relaxed);
+  return limit == 0 ? parallelism : std::min(parallelism, limit);
+}
+
+static void GetAvailableParallelism(const FunctionCallbackInfo<Value>& args) {
+  unsigned int parallelism = AvailableParallelism();
   args.GetReturnValue().Set(parallelism);
 }
 
 uint32_t FastGetAvailableParallelism(v8::Local<v8::Value> receiver) {
   TRACK_V8_FAST_API_CALL("os.availableParallelism");
-  return uv_available_parallelism();
+  return AvailableParallelism();
 }
 
 static v8::CFunction fast_get_available_parallelism(
@@ -0,0 +1,149 @@
+#include "env-inl.h"
+#include "node.h"
+#include "node_debug.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8-fast-api-calls.h"
+
+#include <string_view>
+
+namespace node {
+namespace path {
+
+using v8::CFunction;
+using v8::Context;
+using v8::FastApiCallbackOptions;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+// The checks below let lib/path.js return paths that are already normalized
+// without processing them character by character. They are conservative:
+// when they return false, the path is normalized in JavaScript as usual.
+
+// Returns true if posix.normalize() returns `path` unchanged, i.e. `path`
+// has no "." or ".." segments and no repeated separators.
+static bool IsNormalizedPosixPath(std::string_view path) {
+  if (path.empty()) return false;
+  size_t start = 0;
+  for (size_t i = 0; i <= path.size(); i++) {
+    if (i < path.size() && path[i] != '/') continue;
+    std::string_view segment = path.substr(start, i - start);
+    if (segment.empty()) {
+      // Only the segments before a leading separator and after a trailing
+      // separator can be empty.
+      if (start != 0 && i != path.size()) return false;
+    } else if (segment == "." || segment == "..") {
+      return false;
+    }
+    start = i + 1;
+  }
+  return true;
+}
+
+// Returns true if win32.normalize() returns `path` unchanged. Only paths that
+// start with a drive letter root, e.g. "C:\", and only use backslashes are
+// recognized.
+static bool IsNormalizedWin32Path(std::string_view path) {
+  if (path.size() < 3 || path[1] != ':' || path[2] != '\\') return false;
+  const char drive = path[0];
+  if (!((drive >= 'a' && drive <= 'z') || (drive >= 'A' && drive <= 'Z'))) {
+    return false;
+  }
+  size_t start = 3;
+  for (size_t i = start; i <= path.size(); i++) {
+    if (i < path.size()) {
+      const char c = path[i];
+      if (c == '/' || c == ':') return false;
+      if (c != '\\') continue;
+    }
+    std::string_view segment = path.substr(start, i - start);
+    if (segment.empty()) {
+      if (i != path.size()) return false;
+    } else if (segment == "." || segment == "..") {
+      return false;
+    }
+    start = i + 1;
+  }
+  return true;
+}
+
+template <bool (*is_normalized)(std::string_view)>
+static bool IsNormalizedString(Isolate* isolate, Local<Value> value) {
+  if (!value->IsString()) return false;
+  String::ValueView view(isolate, value.As<String>());
+  if (!view.is_one_byte()) return false;
+  return is_normalized(std::string_view(
+      reinterpret_cast<const char*>(view.data8()), view.length()));
+}
+
+static void IsNormalizedPosix(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(
+      IsNormalizedString<IsNormalizedPosixPath>(args.GetIsolate(), args[0]));
+}
+
+static bool FastIsNormalizedPosix(
+    Local<Value> receiver,
+    Local<Value> path,
+    // NOLINTNEXTLINE(runtime/references) This is V8 api.
+    FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("path.isNormalizedPosix");
+  HandleScope handle_scope(options.isolate);
+  return IsNormalizedString<IsNormalizedPosixPath>(options.isolate, path);
+}
+
+static CFunction fast_is_normalized_posix_(
+    CFunction::Make(FastIsNormalizedPosix));
+
+static void IsNormalizedWin32(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(
+      IsNormalizedString<IsNormalizedWin32Path>(args.GetIsolate(), args[0]));
+}
+
+static bool FastIsNormalizedWin32(
+    Local<Value> receiver,
+    Local<Value> path,
+    // NOLINTNEXTLINE(runtime/references) This is V8 api.
+    FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("path.isNormalizedWin32");
+  HandleScope handle_scope(options.isolate);
+  return IsNormalizedString<IsNormalizedWin32Path>(options.isolate, path);
+}
+
+static CFunction fast_is_normalized_win32_(
+    CFunction::Make(FastIsNormalizedWin32));
+
+static void Initialize(Local<Object> target,
+                       Local<Value> unused,
+                       Local<Context> context,
+                       void* priv) {
+  SetFastMethodNoSideEffect(context,
+                            target,
+                            "isNormalizedPosix",
+                            IsNormalizedPosix,
+                            &fast_is_normalized_posix_);
+  SetFastMethodNoSideEffect(context,
+                            target,
+                            "isNormalizedWin32",
+                            IsNormalizedWin32,
+                            &fast_is_normalized_win32_);
+}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(IsNormalizedPosix);
+  registry->Register(FastIsNormalizedPosix);
+  registry->Register(fast_is_normalized_posix_.GetTypeInfo());
+  registry->Register(IsNormalizedWin32);
+  registry->Register(FastIsNormalizedWin32);
+  registry->Register(fast_is_normalized_win32_.GetTypeInfo());
+}
+
+}  // namespace path
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(path, node::path::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(path, node::path::RegisterExternalReferences)
@@ -1,5 +1,6 @@
 #include "node_perf.h"
 #include "aliased_buffer-inl.h"
+#include "async_wrap.h"
 #include "env-inl.h"
 #include "histogram-inl.h"
 #include "memory_tracker-inl.h"
@@ -7,6 +8,7 @@
 #include "node_external_reference.h"
 #include "node_internals.h"
 #include "node_process-inl.h"
+#include "node_watchdog.h"
 #include "util-inl.h"
 
 #include <cinttypes>
@@ -24,11 +26,16 @@ using v8::GCType;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::LocalVector;
 using v8::MaybeLocal;
+using v8::Name;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::PropertyAttribute;
 using v8::ReadOnly;
+using v8::Uint32;
 using v8::Value;
 
 // Microseconds in a millisecond, as a float.
@@ -128,6 +135,69 @@ void PerformanceState::Mark(PerformanceMilestone milestone, uint64_t ts) {
       TRACE_EVENT_SCOPE_THREAD, ts / 1000);
 }
 
+static void TraceBootstrapPhase(const void* id,
+                                BootstrapPhase phase,
+                                uint64_t start,
+                                uint64_t end,
+                                const char* detail) {
+  const char* name = GetBootstrapPhaseName(phase);
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      TRACING_CATEGORY_NODE1(bootstrap), name, id, start / 1000);
+  if (detail != nullptr) {
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP1(
+        TRACING_CATEGORY_NODE1(bootstrap),
+        name,
+        id,
+        end / 1000,
+        "detail",
+        TRACE_STR_COPY(detail));
+  } else {
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+        TRACING_CATEGORY_NODE1(bootstrap), name, id, end / 1000);
+  }
+}
+
+void PerformanceState::RecordBootstrapPhase(BootstrapPhase phase,
+                                            uint64_t start,
+                                            uint64_t end,
+                                            const char* detail) {
+  CHECK_LT(phase, NODE_BOOTSTRAP_PHASE_INVALID);
+  bootstrap_phases[phase] += end - start;
+  TraceBootstrapPhase(this, phase, start, end, detail);
+}
+
+struct ProcessBootstrapPhase {
+  uint64_t start = 0;
+  uint64_t end = 0;
+};
+static ProcessBootstrapPhase process_bootstrap_phases[
+    NODE_BOOTSTRAP_PHASE_INVALID];
+
+void RecordProcessBootstrapPhase(BootstrapPhase phase,
+                                 uint64_t start,
+                                 uint64_t end) {
+  CHECK_LT(phase, NODE_BOOTSTRAP_PHASE_INVALID);
+  process_bootstrap_phases[phase] = {start, end};
+}
+
+void TraceProcessBootstrapPhases() {
+  for (int i = 0; i < NODE_BOOTSTRAP_PHASE_INVALID; ++i) {
+    const ProcessBootstrapPhase& recorded = process_bootstrap_phases[i];
+    if (recorded.end == 0) continue;
+    TraceBootstrapPhase(process_bootstrap_phases,
+                        static_cast<BootstrapPhase>(i),
+                        recorded.start,
+                        recorded.end,
+                        nullptr);
+  }
+}
+
+uint64_t GetProcessBootstrapPhaseDuration(BootstrapPhase phase) {
+  CHECK_LT(phase, NODE_BOOTSTRAP_PHASE_INVALID);
+  const ProcessBootstrapPhase& recorded = process_bootstrap_phases[phase];
+  return recorded.end - recorded.start;
+}
+
 void SetupPerformanceObservers(const FunctionCallbackInfo<Value>& args) {
   Realm* realm = Realm::GetCurrent(args);
   // TODO(legendecas): Remove this check once the sub-realms are supported.
@@ -306,6 +376,156 @@ void MarkBootstrapComplete(const FunctionCallbackInfo<Value>& args) {
       performance::NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE);
 }
 
+static BootstrapPhase GetBootstrapPhaseArg(Local<Value> value) {
+  CHECK(value->IsUint32());
+  uint32_t phase = value.As<Uint32>()->Value();
+  CHECK_LT(phase, NODE_BOOTSTRAP_PHASE_INVALID);
+  return static_cast<BootstrapPhase>(phase);
+}
+
+void MarkBootstrapPhaseStart(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  BootstrapPhase phase = GetBootstrapPhaseArg(args[0]);
+  env->performance_state()->bootstrap_phase_starts[phase] = PERFORMANCE_NOW();
+}
+
+void MarkBootstrapPhaseEnd(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  BootstrapPhase phase = GetBootstrapPhaseArg(args[0]);
+  PerformanceState* state = env->performance_state();
+  uint64_t start = state->bootstrap_phase_starts[phase];
+  if (start == 0) return;
+  state->bootstrap_phase_starts[phase] = 0;
+  state->RecordBootstrapPhase(phase, start);
+}
+
+// Returns an object mapping the names of the bootstrap phases to their
+// durations in milliseconds. The phases that happen once per process are
+// only reported to the main thread.
+void GetBootstrapPhases(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  PerformanceState* state = env->performance_state();
+  LocalVector<Name> names(isolate);
+  LocalVector<Value> values(isolate);
+  for (int i = 0; i < NODE_BOOTSTRAP_PHASE_INVALID; ++i) {
+    BootstrapPhase phase = static_cast<BootstrapPhase>(i);
+    uint64_t duration = state->bootstrap_phases[phase];
+    if (env->is_main_thread()) {
+      duration += GetProcessBootstrapPhaseDuration(phase);
+    }
+    names.push_back(OneByteString(isolate, GetBootstrapPhaseName(phase)));
+    values.push_back(Number::New(
+        isolate, static_cast<double>(duration) / NANOS_PER_MILLIS));
+  }
+  args.GetReturnValue().Set(Object::New(isolate,
+                                        Null(isolate),
+                                        names.data(),
+                                        values.data(),
+                                        names.size()));
+}
+
+// Returns an object mapping the names of the classes of the ThreadPoolWork
+// to the histograms of the time their work spent queued and running. All the
+// histograms created for a class observe the same data.
+void CreateThreadPoolWorkHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  static constexpr std::pair<ThreadPoolWorkClass, const char*> kClasses[] = {
+#define V(klass, class_name) {ThreadPoolWorkClass::klass, class_name},
+      THREADPOOL_WORK_CLASSES(V)
+#undef V
+  };
+
+  LocalVector<Name> names(isolate);
+  LocalVector<Value> values(isolate);
+  for (const auto& [work_class, class_name] : kClasses) {
+    ThreadPoolWorkClassState* state = env->threadpool_work_class(work_class);
+    if (!state->queue_wait) {
+      state->queue_wait = std::make_shared<Histogram>(Histogram::Options{});
+    }
+    if (!state->run_time) {
+      state->run_time = std::make_shared<Histogram>(Histogram::Options{});
+    }
+    BaseObjectPtr<HistogramBase> queue_wait =
+        HistogramBase::Create(env, state->queue_wait);
+    BaseObjectPtr<HistogramBase> run_time =
+        HistogramBase::Create(env, state->run_time);
+    if (!queue_wait || !run_time) return;
+    Local<Value> histograms[] = {queue_wait->object(), run_time->object()};
+    names.push_back(OneByteString(isolate, class_name));
+    values.push_back(Array::New(isolate, histograms, arraysize(histograms)));
+  }
+  args.GetReturnValue().Set(Object::New(isolate,
+                                        Null(isolate),
+                                        names.data(),
+                                        values.data(),
+                                        names.size()));
+}
+
+// Returns an object mapping the names of the EVENT_LOOP_PHASES to the handles
+// of the histograms of their durations, and starts recording them.
+void CreateEventLoopPhaseHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  static constexpr const char* kPhases[] = {
+#define V(_, phase_name) phase_name,
+      EVENT_LOOP_PHASES(V)
+#undef V
+  };
+
+  EventLoopPhaseState* state =
+      env->EnableEventLoopPhases(AsyncWrap::PROVIDERS_LENGTH);
+  LocalVector<Name> names(isolate);
+  LocalVector<Value> values(isolate);
+  for (size_t i = 0; i < arraysize(kPhases); i++) {
+    BaseObjectPtr<HistogramBase> histogram =
+        HistogramBase::Create(env, state->histograms[i]);
+    if (!histogram) return;
+    names.push_back(OneByteString(isolate, kPhases[i]));
+    values.push_back(histogram->object());
+  }
+  args.GetReturnValue().Set(Object::New(isolate,
+                                        Null(isolate),
+                                        names.data(),
+                                        values.data(),
+                                        names.size()));
+}
+
+// Returns an array with the number of callbacks made into JS per
+// AsyncWrap::ProviderType since createEventLoopPhaseHistograms() was first
+// called, or an empty array if it was not.
+void GetEventLoopCallbackCounts(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  EventLoopPhaseState* state = env->event_loop_phases();
+  LocalVector<Value> counts(isolate);
+  if (state != nullptr) {
+    for (uint64_t count : state->callbacks)
+      counts.push_back(Number::New(isolate, static_cast<double>(count)));
+  }
+  args.GetReturnValue().Set(Array::New(isolate, counts.data(), counts.size()));
+}
+
+// Returns the number of the stalls detected with --trace-event-loop-stalls
+// and the duration of the longest one in milliseconds.
+void GetEventLoopStalls(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  StallWatchdog* watchdog = env->stall_watchdog();
+  Local<Value> values[] = {
+      Number::New(isolate,
+                  watchdog != nullptr
+                      ? static_cast<double>(watchdog->stall_count())
+                      : 0),
+      Number::New(isolate,
+                  watchdog != nullptr
+                      ? 1.0 * watchdog->max_stall_duration() / NANOS_PER_MILLIS
+                      : 0),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
 static double PerformanceNowImpl() {
   return static_cast<double>(uv_hrtime() - performance_process_start) /
          NANOS_PER_MILLIS;
@@ -341,6 +561,23 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(isolate, target, "loopIdleTime", LoopIdleTime);
   SetMethod(isolate, target, "createELDHistogram", CreateELDHistogram);
   SetMethod(isolate, target, "markBootstrapComplete", MarkBootstrapComplete);
+  SetMethod(
+      isolate, target, "markBootstrapPhaseStart", MarkBootstrapPhaseStart);
+  SetMethod(isolate, target, "markBootstrapPhaseEnd", MarkBootstrapPhaseEnd);
+  SetMethod(isolate, target, "getBootstrapPhases", GetBootstrapPhases);
+  SetMethod(isolate,
+            target,
+            "createThreadPoolWorkHistograms",
+            CreateThreadPoolWorkHistograms);
+  SetMethod(isolate,
+            target,
+            "createEventLoopPhaseHistograms",
+            CreateEventLoopPhaseHistograms);
+  SetMethod(isolate,
+            target,
+            "getEventLoopCallbackCounts",
+            GetEventLoopCallbackCounts);
+  SetMethod(isolate, target, "getEventLoopStalls", GetEventLoopStalls);
   SetMethod(isolate, target, "uvMetricsInfo", UvMetricsInfo);
   SetFastMethodNoSideEffect(
       isolate, target, "now", SlowPerformanceNow, &fast_performance_now);
@@ -393,6 +630,11 @@ void CreatePerContextProperties(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_BOOTSTRAP_PHASE_##name);
+  NODE_BOOTSTRAP_PHASES(V)
+#undef V
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -408,6 +650,13 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(LoopIdleTime);
   registry->Register(CreateELDHistogram);
   registry->Register(MarkBootstrapComplete);
+  registry->Register(MarkBootstrapPhaseStart);
+  registry->Register(MarkBootstrapPhaseEnd);
+  registry->Register(GetBootstrapPhases);
+  registry->Register(CreateThreadPoolWorkHistograms);
+  registry->Register(CreateEventLoopPhaseHistograms);
+  registry->Register(GetEventLoopCallbackCounts);
+  registry->Register(GetEventLoopStalls);
   registry->Register(UvMetricsInfo);
   registry->Register(SlowPerformanceNow);
   registry->Register(FastPerformanceNow);
@@ -40,6 +40,16 @@ inline PerformanceMilestone ToPerformanceMilestoneEnum(const char* str) {
   return NODE_PERFORMANCE_MILESTONE_INVALID;
 }
 
+inline const char* GetBootstrapPhaseName(BootstrapPhase phase) {
+  switch (phase) {
+#define V(name, label) case NODE_BOOTSTRAP_PHASE_##name: return label;
+  NODE_BOOTSTRAP_PHASES(V)
+#undef V
+    default:
+      UNREACHABLE();
+  }
+}
+
 inline const char* GetPerformanceEntryTypeName(
     PerformanceEntryType type) {
   switch (type) {
@@ -34,6 +34,17 @@ extern uint64_t performance_v8_start;
   V(LOOP_EXIT, "loopExit")                                                     \
   V(BOOTSTRAP_COMPLETE, "bootstrapComplete")
 
+// The phases of the startup whose durations are recorded. The first three
+// happen once per process before any environment is created.
+#define NODE_BOOTSTRAP_PHASES(V)                                               \
+  V(OPTION_PARSING, "optionParsing")                                           \
+  V(ICU_INITIALIZATION, "icuInitialization")                                   \
+  V(V8_INITIALIZATION, "v8Initialization")                                     \
+  V(SNAPSHOT_DESERIALIZATION, "snapshotDeserialization")                       \
+  V(BINDING_INITIALIZATION, "bindingInitialization")                           \
+  V(BUILTIN_COMPILATION, "builtinCompilation")                                 \
+  V(USER_MODULE_LOADING, "userModuleLoading")
+
 #define NODE_PERFORMANCE_ENTRY_TYPES(V)                                       \
   V(GC, "gc")                                                                 \
   V(HTTP, "http")                                                             \
@@ -48,6 +59,23 @@ enum PerformanceMilestone {
   NODE_PERFORMANCE_MILESTONE_INVALID
 };
 
+enum BootstrapPhase {
+#define V(name, _) NODE_BOOTSTRAP_PHASE_##name,
+  NODE_BOOTSTRAP_PHASES(V)
+#undef V
+  NODE_BOOTSTRAP_PHASE_INVALID
+};
+
+// Records a phase that happens once per process. These are traced once the
+// tracing agent is started, see TraceProcessBootstrapPhases().
+void RecordProcessBootstrapPhase(BootstrapPhase phase,
+                                 uint64_t start,
+                                 uint64_t end = PERFORMANCE_NOW());
+void TraceProcessBootstrapPhases();
+// Returns the duration of a phase recorded by RecordProcessBootstrapPhase(),
+// in nanoseconds.
+uint64_t GetProcessBootstrapPhaseDuration(BootstrapPhase phase);
+
 enum PerformanceEntryType {
 #define V(name, _) NODE_PERFORMANCE_ENTRY_TYPE_##name,
   NODE_PERFORMANCE_ENTRY_TYPES(V)
@@ -84,6 +112,19 @@ class PerformanceState {
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
+  // Adds the time between start and end to the duration of the phase and
+  // emits it as a node.bootstrap trace event. detail, if not nullptr, is
+  // added to the trace event, e.g. the id of the built-in being compiled.
+  void RecordBootstrapPhase(BootstrapPhase phase,
+                            uint64_t start,
+                            uint64_t end = PERFORMANCE_NOW(),
+                            const char* detail = nullptr);
+  // Accumulated durations of the bootstrap phases in nanoseconds.
+  uint64_t bootstrap_phases[NODE_BOOTSTRAP_PHASE_INVALID] = {};
+  // Start timestamps of the phases timed from JavaScript, see
+  // performance.markBootstrapPhaseStart().
+  uint64_t bootstrap_phase_starts[NODE_BOOTSTRAP_PHASE_INVALID] = {};
+
  private:
   void Initialize(uint64_t time_origin, double time_origin_timestamp);
   void ResetMilestones();
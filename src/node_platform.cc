@@ -5,8 +5,17 @@
 #include "debug_utils-inl.h"
 #include <algorithm>  // find_if(), find(), move()
 #include <cmath>  // llround()
+#include <cstdint>
+#include <map>
 #include <memory>  // unique_ptr(), shared_ptr(), make_shared()
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cinttypes>
+#include <cstdio>
+#endif
+
 namespace node {
 
 using v8::Isolate;
@@ -18,7 +27,7 @@ using v8::TaskPriority;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<TaskQueueEntry>* task_queue;
+  WorkStealingTaskQueue* task_queue;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
@@ -48,12 +57,34 @@ static void PrintSourceLocation(const v8::SourceLocation& location) {
   }
 }
 
+#if defined(__wasi__) && defined(_REENTRANT)
+// With wasi-threads, every thread is a new instance of the module that
+// shares its memory, and gets a stack of wasi-libc's default size unless
+// told otherwise. That is much smaller than what V8's concurrent marking and
+// off-thread compilation need, so give platform threads the same stack size
+// as the libuv threadpool.
+static constexpr size_t kPlatformThreadStackSize = 8 * 1024 * 1024;
+#endif
+
+static int CreatePlatformThread(uv_thread_t* tid,
+                                uv_thread_cb entry,
+                                void* arg) {
+#if defined(__wasi__) && defined(_REENTRANT)
+  uv_thread_options_t options;
+  options.flags = UV_THREAD_HAS_STACK_SIZE;
+  options.stack_size = kPlatformThreadStackSize;
+  return uv_thread_create_ex(tid, &options, entry, arg);
+#else
+  return uv_thread_create(tid, entry, arg);
+#endif
+}
+
 static void PlatformWorkerThread(void* data) {
   uv_thread_setname("V8Worker");
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<TaskQueueEntry>* pending_worker_tasks = worker_data->task_queue;
+  WorkStealingTaskQueue* pending_worker_tasks = worker_data->task_queue;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
 
@@ -67,8 +98,9 @@ static void PlatformWorkerThread(void* data) {
   bool debug_log_enabled =
       worker_data->debug_log_level != PlatformDebugLogLevel::kNone;
   int id = worker_data->id;
+  WorkStealingTaskQueue::SetCurrentLane(id);
   while (std::unique_ptr<TaskQueueEntry> entry =
-             pending_worker_tasks->Lock().BlockingPop()) {
+             pending_worker_tasks->BlockingPop(id)) {
     if (debug_log_enabled) {
       fprintf(stderr,
               "\nPlatformWorkerThread %d running task %p %s\n",
@@ -80,7 +112,7 @@ static void PlatformWorkerThread(void* data) {
     entry->task->Run();
     // See NodePlatform::DrainTasks().
     if (entry->is_outstanding()) {
-      pending_worker_tasks->Lock().NotifyOfOutstandingCompletion();
+      pending_worker_tasks->NotifyOfOutstandingCompletion();
     }
   }
 }
@@ -96,7 +128,7 @@ static int GetActualThreadPoolSize(int thread_pool_size) {
 
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<TaskQueueEntry>* tasks)
+  explicit DelayedTaskScheduler(WorkStealingTaskQueue* tasks)
       : pending_worker_tasks_(tasks) {}
 
   std::unique_ptr<uv_thread_t> Start() {
@@ -105,7 +137,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
     };
     std::unique_ptr<uv_thread_t> t { new uv_thread_t() };
     uv_sem_init(&ready_, 0);
-    CHECK_EQ(0, uv_thread_create(t.get(), start_thread, this));
+    CHECK_EQ(0, CreatePlatformThread(t.get(), start_thread, this));
     uv_sem_wait(&ready_);
     uv_sem_destroy(&ready_);
     return t;
@@ -214,8 +246,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
         ContainerOf(&DelayedTaskScheduler::loop_, timer->loop);
     auto entry = scheduler->TakeTimerTask(timer);
     bool is_outstanding = entry->is_outstanding();
-    scheduler->pending_worker_tasks_->Lock().Push(std::move(entry),
-                                                  is_outstanding);
+    scheduler->pending_worker_tasks_->Push(std::move(entry), is_outstanding);
   }
 
   std::unique_ptr<TaskQueueEntry> TakeTimerTask(uv_timer_t* timer) {
@@ -232,7 +263,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   uv_sem_t ready_;
   // Task queue in the worker thread task runner, we push the delayed task back
   // to it when the timer expires.
-  TaskQueue<TaskQueueEntry>* pending_worker_tasks_;
+  WorkStealingTaskQueue* pending_worker_tasks_;
 
   // Locally scheduled tasks to be poped into the worker task runner queue.
   // It is flushed whenever the next closest timer expires.
@@ -244,7 +275,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
 
 WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(
     int thread_pool_size, PlatformDebugLogLevel debug_log_level)
-    : debug_log_level_(debug_log_level) {
+    : pending_worker_tasks_(thread_pool_size),
+      debug_log_level_(debug_log_level) {
   Mutex platform_workers_mutex;
   ConditionVariable platform_workers_ready;
 
@@ -264,8 +296,12 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(
                                i,
                                debug_log_level_};
     std::unique_ptr<uv_thread_t> t { new uv_thread_t() };
-    if (uv_thread_create(t.get(), PlatformWorkerThread,
-                         worker_data) != 0) {
+    if (CreatePlatformThread(t.get(), PlatformWorkerThread, worker_data) != 0) {
+      // Do not wait for the threads that could not be started, e.g. when the
+      // WASI runtime limits the number of threads. The lanes of the missing
+      // threads are drained by the others through work stealing.
+      delete worker_data;
+      pending_platform_workers -= thread_pool_size - i;
       break;
     }
     threads_.push_back(std::move(t));
@@ -283,7 +319,7 @@ void WorkerThreadsTaskRunner::PostTask(v8::TaskPriority priority,
                                        const v8::SourceLocation& location) {
   auto entry = std::make_unique<TaskQueueEntry>(std::move(task), priority);
   bool is_outstanding = entry->is_outstanding();
-  pending_worker_tasks_.Lock().Push(std::move(entry), is_outstanding);
+  pending_worker_tasks_.Push(std::move(entry), is_outstanding);
 }
 
 void WorkerThreadsTaskRunner::PostDelayedTask(
@@ -296,11 +332,11 @@ void WorkerThreadsTaskRunner::PostDelayedTask(
 }
 
 void WorkerThreadsTaskRunner::BlockingDrain() {
-  pending_worker_tasks_.Lock().BlockingDrain();
+  pending_worker_tasks_.BlockingDrain();
 }
 
 void WorkerThreadsTaskRunner::Shutdown() {
-  pending_worker_tasks_.Lock().Stop();
+  pending_worker_tasks_.Stop();
   delayed_task_scheduler_->Stop();
   for (size_t i = 0; i < threads_.size(); i++) {
     CHECK_EQ(0, uv_thread_join(threads_[i].get()));
@@ -844,6 +880,318 @@ TaskQueue<T>::PriorityQueue TaskQueue<T>::Locked::PopAll() {
   return result;
 }
 
+namespace {
+// The lane of the worker thread that the current thread is, if any.
+thread_local size_t current_worker_lane = SIZE_MAX;
+}  // namespace
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(size_t lane_count)
+    : lane_count_(lane_count), lanes_(new Lane[lane_count]) {
+  CHECK_GT(lane_count, 0);
+}
+
+void WorkStealingTaskQueue::SetCurrentLane(size_t lane) {
+  current_worker_lane = lane;
+}
+
+void WorkStealingTaskQueue::Push(std::unique_ptr<TaskQueueEntry> entry,
+                                 bool outstanding) {
+  if (outstanding) {
+    Mutex::ScopedLock lock(outstanding_mutex_);
+    outstanding_tasks_++;
+  }
+
+  size_t lane = current_worker_lane;
+  if (lane >= lane_count_) {
+    lane = next_lane_.fetch_add(1, std::memory_order_relaxed) % lane_count_;
+  }
+  size_t priority = static_cast<size_t>(entry->priority);
+  {
+    Mutex::ScopedLock lock(lanes_[lane].mutex);
+    lanes_[lane].tasks[priority].push_back(std::move(entry));
+    pending_tasks_[priority]++;
+  }
+
+  // This pairs with the check in BlockingPop(): either the idle thread sees
+  // the task counted above, or this sees the idle thread and wakes it up.
+  if (idle_threads_ > 0) {
+    Mutex::ScopedLock lock(idle_mutex_);
+    tasks_available_.Signal(lock);
+  }
+}
+
+std::unique_ptr<TaskQueueEntry> WorkStealingTaskQueue::TryPop(size_t lane) {
+  for (size_t priority = kPriorityCount; priority-- > 0;) {
+    if (pending_tasks_[priority] == 0) continue;
+    // Take from the back of the own lane, then steal from the front of the
+    // others.
+    for (size_t i = 0; i < lane_count_; i++) {
+      Lane& victim = lanes_[(lane + i) % lane_count_];
+      Mutex::ScopedLock lock(victim.mutex);
+      auto& tasks = victim.tasks[priority];
+      if (tasks.empty()) continue;
+      std::unique_ptr<TaskQueueEntry> result;
+      if (i == 0) {
+        result = std::move(tasks.back());
+        tasks.pop_back();
+      } else {
+        result = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      pending_tasks_[priority]--;
+      return result;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<TaskQueueEntry> WorkStealingTaskQueue::BlockingPop(
+    size_t lane) {
+  while (true) {
+    {
+      Mutex::ScopedLock lock(idle_mutex_);
+      if (stopped_) return nullptr;
+    }
+    if (std::unique_ptr<TaskQueueEntry> result = TryPop(lane)) {
+      return result;
+    }
+
+    Mutex::ScopedLock lock(idle_mutex_);
+    idle_threads_++;
+    bool has_pending_tasks = false;
+    for (const auto& count : pending_tasks_) {
+      if (count > 0) has_pending_tasks = true;
+    }
+    if (!has_pending_tasks && !stopped_) {
+      tasks_available_.Wait(lock);
+    }
+    idle_threads_--;
+  }
+}
+
+void WorkStealingTaskQueue::NotifyOfOutstandingCompletion() {
+  Mutex::ScopedLock lock(outstanding_mutex_);
+  if (--outstanding_tasks_ == 0) {
+    outstanding_tasks_drained_.Broadcast(lock);
+  }
+}
+
+void WorkStealingTaskQueue::BlockingDrain() {
+  Mutex::ScopedLock lock(outstanding_mutex_);
+  while (outstanding_tasks_ > 0) {
+    outstanding_tasks_drained_.Wait(lock);
+  }
+}
+
+void WorkStealingTaskQueue::Stop() {
+  Mutex::ScopedLock lock(idle_mutex_);
+  stopped_ = true;
+  tasks_available_.Broadcast(lock);
+}
+
+#if defined(__linux__)
+namespace {
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+int GetProtection(v8::PageAllocator::Permission permission) {
+  switch (permission) {
+    case v8::PageAllocator::kNoAccess:
+    case v8::PageAllocator::kNoAccessWillJitLater:
+      return PROT_NONE;
+    case v8::PageAllocator::kRead:
+      return PROT_READ;
+    case v8::PageAllocator::kReadWrite:
+      return PROT_READ | PROT_WRITE;
+    case v8::PageAllocator::kReadWriteExecute:
+      return PROT_READ | PROT_WRITE | PROT_EXEC;
+    case v8::PageAllocator::kReadExecute:
+      return PROT_READ | PROT_EXEC;
+  }
+  UNREACHABLE();
+}
+
+// Implements the same semantics as the default page allocator of V8, except
+// that the reservations of at least one huge page are aligned to the huge
+// page size and marked with MADV_HUGEPAGE. The kernel then backs the parts
+// of them that V8 commits with huge pages when it can. Explicit hugetlb
+// mappings are not used since V8 changes the permissions of and releases
+// the memory at the granularity of the commit page size, which hugetlb
+// mappings do not allow.
+class HugePageAllocator final : public v8::PageAllocator {
+ public:
+  HugePageAllocator() : page_size_(sysconf(_SC_PAGESIZE)) {}
+
+  size_t AllocatePageSize() override { return page_size_; }
+  size_t CommitPageSize() override { return page_size_; }
+  void SetRandomMmapSeed(int64_t seed) override {}
+  // The kernel already randomizes the placement of the mappings.
+  void* GetRandomMmapAddr() override { return nullptr; }
+
+  void* AllocatePages(void* hint,
+                      size_t length,
+                      size_t alignment,
+                      Permission permission) override {
+    const bool huge = length >= kHugePageSize;
+    if (huge) alignment = std::max(alignment, kHugePageSize);
+    const size_t request_length = length + alignment - page_size_;
+    void* result = mmap(hint,
+                        request_length,
+                        GetProtection(permission),
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                        -1,
+                        0);
+    if (result == MAP_FAILED) return nullptr;
+
+    // Trim the mapping to the requested alignment.
+    const uintptr_t base = reinterpret_cast<uintptr_t>(result);
+    const uintptr_t aligned = (base + alignment - 1) & ~(alignment - 1);
+    const uintptr_t end = aligned + length;
+    const uintptr_t request_end = base + request_length;
+    if (aligned != base) {
+      CHECK_EQ(munmap(result, aligned - base), 0);
+    }
+    if (request_end != end) {
+      CHECK_EQ(munmap(reinterpret_cast<void*>(end), request_end - end), 0);
+    }
+
+    void* address = reinterpret_cast<void*>(aligned);
+    if (huge && madvise(address, length, MADV_HUGEPAGE) == 0) {
+      Mutex::ScopedLock lock(mutex_);
+      regions_[aligned] = length;
+    }
+    return address;
+  }
+
+  bool FreePages(void* address, size_t length) override {
+    {
+      Mutex::ScopedLock lock(mutex_);
+      regions_.erase(reinterpret_cast<uintptr_t>(address));
+    }
+    return munmap(address, length) == 0;
+  }
+
+  bool ReleasePages(void* address, size_t length, size_t new_length) override {
+    DCHECK_LT(new_length, length);
+    {
+      Mutex::ScopedLock lock(mutex_);
+      auto it = regions_.find(reinterpret_cast<uintptr_t>(address));
+      if (it != regions_.end()) it->second = new_length;
+    }
+    return munmap(static_cast<char*>(address) + new_length,
+                  length - new_length) == 0;
+  }
+
+  bool SetPermissions(void* address,
+                      size_t length,
+                      Permission permission) override {
+    if (mprotect(address, length, GetProtection(permission)) != 0) {
+      return false;
+    }
+    if (permission == kNoAccess) DiscardSystemPages(address, length);
+    return true;
+  }
+
+  bool DiscardSystemPages(void* address, size_t size) override {
+#if defined(MADV_FREE)
+    if (madvise(address, size, MADV_FREE) == 0) return true;
+#endif
+    return madvise(address, size, MADV_DONTNEED) == 0;
+  }
+
+  bool DecommitPages(void* address, size_t size) override {
+    void* result = mmap(address,
+                        size,
+                        PROT_NONE,
+                        MAP_FIXED | MAP_ANONYMOUS | MAP_PRIVATE,
+                        -1,
+                        0);
+    if (result != address) return false;
+    // The new mapping does not inherit the advice of the reservation.
+    if (IsInAdvisedRegion(reinterpret_cast<uintptr_t>(address))) {
+      madvise(address, size, MADV_HUGEPAGE);
+    }
+    return true;
+  }
+
+  HugePageStats GetStats() {
+    HugePageStats stats;
+    RegionMap regions;
+    {
+      Mutex::ScopedLock lock(mutex_);
+      regions = regions_;
+    }
+    if (regions.empty()) return stats;
+    for (const auto& region : regions) stats.advised_bytes += region.second;
+
+    FILE* smaps = fopen("/proc/self/smaps", "r");
+    if (smaps == nullptr) return stats;
+    char line[4096];
+    bool in_region = false;
+    while (fgets(line, sizeof(line), smaps) != nullptr) {
+      uintptr_t start;
+      uintptr_t end;
+      size_t kilobytes;
+      if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2) {
+        // The advice splits the mappings at the boundaries of the regions,
+        // so a mapping is either entirely inside of a region or outside.
+        in_region = IsInRegion(regions, start);
+      } else if (in_region &&
+                 sscanf(line, "AnonHugePages: %zu kB", &kilobytes) == 1) {
+        stats.huge_page_bytes += kilobytes * 1024;
+      }
+    }
+    fclose(smaps);
+    return stats;
+  }
+
+ private:
+  // Maps the start addresses of the advised reservations to their lengths.
+  using RegionMap = std::map<uintptr_t, size_t>;
+
+  static bool IsInRegion(const RegionMap& regions, uintptr_t address) {
+    auto it = regions.upper_bound(address);
+    if (it == regions.begin()) return false;
+    --it;
+    return address < it->first + it->second;
+  }
+
+  bool IsInAdvisedRegion(uintptr_t address) {
+    Mutex::ScopedLock lock(mutex_);
+    return IsInRegion(regions_, address);
+  }
+
+  const size_t page_size_;
+  Mutex mutex_;
+  RegionMap regions_;
+};
+
+HugePageAllocator* huge_page_allocator = nullptr;
+
+}  // namespace
+
+v8::PageAllocator* GetHugePageAllocator() {
+  // The allocator is never freed because V8 keeps using it until the
+  // process exits.
+  static HugePageAllocator* allocator = new HugePageAllocator();
+  huge_page_allocator = allocator;
+  return allocator;
+}
+
+HugePageStats GetHugePageStats() {
+  if (huge_page_allocator == nullptr) return {};
+  return huge_page_allocator->GetStats();
+}
+#else
+v8::PageAllocator* GetHugePageAllocator() {
+  return nullptr;
+}
+
+HugePageStats GetHugePageStats() {
+  return {};
+}
+#endif  // defined(__linux__)
+
 void MultiIsolatePlatform::DisposeIsolate(Isolate* isolate) {
   // The order of these calls is important. When the Isolate is disposed,
   // it may still post tasks to the platform, so it must still be registered
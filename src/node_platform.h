@@ -3,6 +3,8 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <queue>
 #include <type_traits>
@@ -88,6 +90,59 @@ struct TaskQueueEntry {
   }
 };
 
+// The queue of the tasks posted to the platform worker threads. Each worker
+// thread owns a lane of it, so that the threads do not all contend on one
+// lock. Like in a Chase-Lev deque, the owner of a lane pushes and pops at
+// the back of it, and a thread whose lane is empty steals from the front of
+// the lanes of the others. Within each lane the tasks are kept in one deque
+// per v8::TaskPriority, and the tasks of a higher priority are always taken
+// first across all lanes.
+class WorkStealingTaskQueue {
+ public:
+  explicit WorkStealingTaskQueue(size_t lane_count);
+
+  // Pushes to the lane of the calling thread if it is a worker thread,
+  // otherwise distributes the tasks over the lanes in turn.
+  void Push(std::unique_ptr<TaskQueueEntry> entry, bool outstanding = false);
+  // Blocks until a task is available for the worker thread owning |lane|.
+  // Returns nullptr when the queue is stopped.
+  std::unique_ptr<TaskQueueEntry> BlockingPop(size_t lane);
+  void NotifyOfOutstandingCompletion();
+  void BlockingDrain();
+  void Stop();
+
+  // Marks the calling thread as the owner of |lane|.
+  static void SetCurrentLane(size_t lane);
+
+ private:
+  static constexpr size_t kPriorityCount =
+      static_cast<size_t>(v8::TaskPriority::kMaxPriority) + 1;
+
+  struct Lane {
+    Mutex mutex;
+    std::deque<std::unique_ptr<TaskQueueEntry>> tasks[kPriorityCount];
+  };
+
+  std::unique_ptr<TaskQueueEntry> TryPop(size_t lane);
+
+  const size_t lane_count_;
+  std::unique_ptr<Lane[]> lanes_;
+  std::atomic<size_t> next_lane_{0};
+  // The number of queued tasks of each priority, so that the threads looking
+  // for work do not need to lock the lanes that have nothing to offer.
+  std::atomic<size_t> pending_tasks_[kPriorityCount] = {};
+
+  // Guards the sleeping of the idle threads.
+  Mutex idle_mutex_;
+  ConditionVariable tasks_available_;
+  std::atomic<size_t> idle_threads_{0};
+  bool stopped_ = false;
+
+  Mutex outstanding_mutex_;
+  ConditionVariable outstanding_tasks_drained_;
+  int outstanding_tasks_ = 0;
+};
+
 struct DelayedTask {
   std::unique_ptr<v8::Task> task;
   v8::TaskPriority priority;
@@ -202,14 +257,15 @@ class WorkerThreadsTaskRunner {
 
  private:
   // A queue shared by all threads. The consumers are the worker threads which
-  // take tasks from it to run in PlatformWorkerThread(). The producers can be
+  // take tasks from their lanes of it, or steal them from the lanes of the
+  // others, to run in PlatformWorkerThread(). The producers can be
   // any thread. Both the foreground thread and the worker threads can push
   // tasks into the queue via v8::Platform::PostTaskOnWorkerThread() which
   // eventually calls PostTask() on this class. When any thread calls
   // v8::Platform::PostDelayedTaskOnWorkerThread(), the DelayedTaskScheduler
   // thread will schedule a timer that pushes the delayed tasks back into this
   // queue when the timer expires.
-  TaskQueue<TaskQueueEntry> pending_worker_tasks_;
+  WorkStealingTaskQueue pending_worker_tasks_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -279,6 +335,22 @@ class NodePlatform : public MultiIsolatePlatform {
   PlatformDebugLogLevel debug_log_level_ = PlatformDebugLogLevel::kNone;
 };
 
+struct HugePageStats {
+  // Bytes of the reservations that were advised to use huge pages.
+  size_t advised_bytes = 0;
+  // Bytes of the advised reservations that are backed by huge pages.
+  size_t huge_page_bytes = 0;
+};
+
+// Returns a process-wide page allocator that advises the kernel to back the
+// reservations spanning at least one huge page, such as the V8 code range and
+// the pages of the large object spaces, with transparent huge pages. Returns
+// nullptr on the platforms where this is not supported.
+v8::PageAllocator* GetHugePageAllocator();
+// Reads the state of the reservations made by GetHugePageAllocator() from
+// the kernel. This walks /proc/self/smaps, so it is not cheap.
+HugePageStats GetHugePageStats();
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
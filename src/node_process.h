@@ -54,6 +54,7 @@ class BindingData : public SnapshotableObject {
  public:
   struct InternalFieldInfo : public node::InternalFieldInfoBase {
     AliasedBufferIndex hrtime_buffer;
+    AliasedBufferIndex memory_usage_buffer;
   };
 
   static void AddMethods(v8::Isolate* isolate,
@@ -90,12 +91,26 @@ class BindingData : public SnapshotableObject {
 
   static void SlowBigInt(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  // Fills the memory usage buffer and returns 0 or a libuv error code.
+  static int MemoryUsageImpl(BindingData* receiver);
+
+  static void FastMemoryUsage(
+      v8::Local<v8::Value> unused,
+      v8::Local<v8::Value> receiver,
+      // NOLINTNEXTLINE(runtime/references) This is V8 api.
+      v8::FastApiCallbackOptions& options);
+
+  static void SlowMemoryUsage(const v8::FunctionCallbackInfo<v8::Value>& args);
+
   static void LoadEnvFile(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
   // Buffer length in uint32.
   static constexpr size_t kHrTimeBufferLength = 3;
   AliasedUint32Array hrtime_buffer_;
+  // rss, heapTotal, heapUsed, external and arrayBuffers.
+  static constexpr size_t kMemoryUsageBufferLength = 5;
+  AliasedFloat64Array memory_usage_buffer_;
   InternalFieldInfo* internal_field_info_ = nullptr;
 
   // These need to be static so that we have their addresses available to
@@ -103,6 +118,7 @@ class BindingData : public SnapshotableObject {
   // time.
   static v8::CFunction fast_number_;
   static v8::CFunction fast_bigint_;
+  static v8::CFunction fast_memory_usage_;
 };
 
 }  // namespace process
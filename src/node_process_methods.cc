@@ -4,6 +4,7 @@
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "node.h"
+#include "node_debug.h"
 #include "node_dotenv.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -43,9 +44,11 @@ using v8::Array;
 using v8::ArrayBuffer;
 using v8::CFunction;
 using v8::Context;
+using v8::FastApiCallbackOptions;
 using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
+using v8::HandleScope;
 using v8::HeapStatistics;
 using v8::Integer;
 using v8::Isolate;
@@ -210,36 +213,23 @@ static void Rss(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(static_cast<double>(rss));
 }
 
-static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-
-  Isolate* isolate = env->isolate();
-  // V8 memory usage
-  HeapStatistics v8_heap_stats;
-  isolate->GetHeapStatistics(&v8_heap_stats);
-
-  NodeArrayBufferAllocator* array_buffer_allocator =
-      env->isolate_data()->node_allocator();
-
-  // Get the double array pointer from the Float64Array argument.
-  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 5);
-  double* fields = static_cast<double*>(ab->Data());
-
+static double FastRss(Local<Value> receiver,
+                      // NOLINTNEXTLINE(runtime/references) This is V8 api.
+                      FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("process.memoryUsage.rss");
   size_t rss;
   int err = uv_resident_set_memory(&rss);
-  if (err)
-    return env->ThrowUVException(err, "uv_resident_set_memory");
-
-  fields[0] = static_cast<double>(rss);
-  fields[1] = static_cast<double>(v8_heap_stats.total_heap_size());
-  fields[2] = static_cast<double>(v8_heap_stats.used_heap_size());
-  fields[3] = static_cast<double>(v8_heap_stats.external_memory());
-  fields[4] =
-      array_buffer_allocator == nullptr
-          ? 0
-          : static_cast<double>(array_buffer_allocator->total_mem_usage());
+  if (err) {
+    HandleScope scope(options.isolate);
+    Environment::GetCurrent(options.isolate)
+        ->ThrowUVException(err, "uv_resident_set_memory");
+    return 0;
+  }
+  return static_cast<double>(rss);
 }
 
+static CFunction fast_rss(CFunction::Make(FastRss));
+
 static void GetConstrainedMemory(const FunctionCallbackInfo<Value>& args) {
   uint64_t value = uv_get_constrained_memory();
   args.GetReturnValue().Set(static_cast<double>(value));
@@ -631,7 +621,10 @@ BindingData::BindingData(Realm* realm,
     : SnapshotableObject(realm, object, type_int),
       hrtime_buffer_(realm->isolate(),
                      kHrTimeBufferLength,
-                     MAYBE_FIELD_PTR(info, hrtime_buffer)) {
+                     MAYBE_FIELD_PTR(info, hrtime_buffer)),
+      memory_usage_buffer_(realm->isolate(),
+                           kMemoryUsageBufferLength,
+                           MAYBE_FIELD_PTR(info, memory_usage_buffer)) {
   Isolate* isolate = realm->isolate();
   Local<Context> context = realm->context();
 
@@ -641,23 +634,34 @@ BindingData::BindingData(Realm* realm,
               FIXED_ONE_BYTE_STRING(isolate, "hrtimeBuffer"),
               hrtime_buffer_.GetJSArray())
         .ToChecked();
+    object
+        ->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "memoryUsageBuffer"),
+              memory_usage_buffer_.GetJSArray())
+        .ToChecked();
   } else {
     hrtime_buffer_.Deserialize(realm->context());
+    memory_usage_buffer_.Deserialize(realm->context());
   }
 
-  // The hrtime buffer is referenced from the binding data js object.
-  // Make the native handle weak to avoid keeping the realm alive.
+  // The buffers are referenced from the binding data js object.
+  // Make the native handles weak to avoid keeping the realm alive.
   hrtime_buffer_.MakeWeak();
+  memory_usage_buffer_.MakeWeak();
 }
 
 v8::CFunction BindingData::fast_number_(v8::CFunction::Make(FastNumber));
 v8::CFunction BindingData::fast_bigint_(v8::CFunction::Make(FastBigInt));
+v8::CFunction BindingData::fast_memory_usage_(
+    v8::CFunction::Make(FastMemoryUsage));
 
 void BindingData::AddMethods(Isolate* isolate, Local<ObjectTemplate> target) {
   SetFastMethodNoSideEffect(
       isolate, target, "hrtime", SlowNumber, &fast_number_);
   SetFastMethodNoSideEffect(
       isolate, target, "hrtimeBigInt", SlowBigInt, &fast_bigint_);
+  SetFastMethod(
+      isolate, target, "memoryUsage", SlowMemoryUsage, &fast_memory_usage_);
 }
 
 void BindingData::RegisterExternalReferences(
@@ -668,6 +672,9 @@ void BindingData::RegisterExternalReferences(
   registry->Register(FastBigInt);
   registry->Register(fast_number_.GetTypeInfo());
   registry->Register(fast_bigint_.GetTypeInfo());
+  registry->Register(SlowMemoryUsage);
+  registry->Register(FastMemoryUsage);
+  registry->Register(fast_memory_usage_.GetTypeInfo());
 }
 
 BindingData* BindingData::FromV8Value(Local<Value> value) {
@@ -678,6 +685,7 @@ BindingData* BindingData::FromV8Value(Local<Value> value) {
 
 void BindingData::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("hrtime_buffer", hrtime_buffer_);
+  tracker->TrackField("memory_usage_buffer", memory_usage_buffer_);
 }
 
 // This is the legacy version of hrtime before BigInt was introduced in
@@ -714,12 +722,57 @@ void BindingData::SlowNumber(const v8::FunctionCallbackInfo<v8::Value>& args) {
   NumberImpl(FromJSObject<BindingData>(args.This()));
 }
 
+int BindingData::MemoryUsageImpl(BindingData* receiver) {
+  Environment* env = receiver->env();
+  size_t rss;
+  int err = uv_resident_set_memory(&rss);
+  if (err) return err;
+
+  // V8 memory usage
+  HeapStatistics v8_heap_stats;
+  env->isolate()->GetHeapStatistics(&v8_heap_stats);
+
+  NodeArrayBufferAllocator* array_buffer_allocator =
+      env->isolate_data()->node_allocator();
+
+  AliasedFloat64Array& fields = receiver->memory_usage_buffer_;
+  fields[0] = static_cast<double>(rss);
+  fields[1] = static_cast<double>(v8_heap_stats.total_heap_size());
+  fields[2] = static_cast<double>(v8_heap_stats.used_heap_size());
+  fields[3] = static_cast<double>(v8_heap_stats.external_memory());
+  fields[4] =
+      array_buffer_allocator == nullptr
+          ? 0
+          : static_cast<double>(array_buffer_allocator->total_mem_usage());
+  return 0;
+}
+
+void BindingData::FastMemoryUsage(Local<Value> unused,
+                                  Local<Value> receiver,
+                                  FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("process.memoryUsage");
+  BindingData* binding = FromV8Value(receiver);
+  int err = MemoryUsageImpl(binding);
+  if (err) {
+    HandleScope scope(options.isolate);
+    binding->env()->ThrowUVException(err, "uv_resident_set_memory");
+  }
+}
+
+void BindingData::SlowMemoryUsage(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding = FromJSObject<BindingData>(args.This());
+  int err = MemoryUsageImpl(binding);
+  if (err) binding->env()->ThrowUVException(err, "uv_resident_set_memory");
+}
+
 bool BindingData::PrepareForSerialization(Local<Context> context,
                                           v8::SnapshotCreator* creator) {
   DCHECK_NULL(internal_field_info_);
   internal_field_info_ = InternalFieldInfoBase::New<InternalFieldInfo>(type());
   internal_field_info_->hrtime_buffer =
       hrtime_buffer_.Serialize(context, creator);
+  internal_field_info_->memory_usage_buffer =
+      memory_usage_buffer_.Serialize(context, creator);
   // Return true because we need to maintain the reference to the binding from
   // JS land.
   return true;
@@ -764,10 +817,9 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethod(isolate, target, "chdir", Chdir);
 
   SetMethod(isolate, target, "umask", Umask);
-  SetMethod(isolate, target, "memoryUsage", MemoryUsage);
   SetMethod(isolate, target, "constrainedMemory", GetConstrainedMemory);
   SetMethod(isolate, target, "availableMemory", GetAvailableMemory);
-  SetMethod(isolate, target, "rss", Rss);
+  SetFastMethod(isolate, target, "rss", Rss, &fast_rss);
   SetMethod(isolate, target, "cpuUsage", CPUUsage);
   SetMethod(isolate, target, "threadCpuUsage", ThreadCPUUsage);
   SetMethod(isolate, target, "resourceUsage", ResourceUsage);
@@ -813,10 +865,11 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
 
   registry->Register(Umask);
   registry->Register(RawDebug);
-  registry->Register(MemoryUsage);
   registry->Register(GetConstrainedMemory);
   registry->Register(GetAvailableMemory);
   registry->Register(Rss);
+  registry->Register(FastRss);
+  registry->Register(fast_rss.GetTypeInfo());
   registry->Register(CPUUsage);
   registry->Register(ThreadCPUUsage);
   registry->Register(ResourceUsage);
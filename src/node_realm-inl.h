@@ -1,7 +1,3 @@
-#ifdef __wasi__
-#include "wasi-base-object-list-fix.h"
-#endif
-
 #ifdef __wasi__
 #include "wasi-isolate-extensions.h"
 #endif
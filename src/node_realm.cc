@@ -57,6 +57,8 @@ void Realm::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("cppgc_wrapper_list", cppgc_wrapper_list_);
   tracker->TrackField("builtins_with_cache", builtins_with_cache);
   tracker->TrackField("builtins_without_cache", builtins_without_cache);
+  tracker->TrackField("builtins_with_rejected_cache",
+                      builtins_with_rejected_cache);
 }
 
 void Realm::CreateProperties() {
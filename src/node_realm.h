@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include <v8.h>
+#include <map>
 #include <unordered_map>
 #include "cleanup_queue.h"
 #include "cppgc_helpers.h"
@@ -160,6 +161,10 @@ class Realm : public MemoryRetainer {
   std::set<struct node_module*> internal_bindings;
   std::set<std::string> builtins_with_cache;
   std::set<std::string> builtins_without_cache;
+  // The built-ins in builtins_without_cache whose code cache was rejected.
+  std::set<std::string> builtins_with_rejected_cache;
+  // The time spent compiling each built-in, in nanoseconds.
+  std::map<std::string, uint64_t> builtin_compile_time;
   // This is only filled during deserialization. We use a vector since
   // it's only used for tests.
   std::vector<std::string> builtins_in_snapshot;
@@ -5,6 +5,7 @@
 #include "json_utils.h"
 #include "node_internals.h"
 #include "node_metadata.h"
+#include "node_platform.h"
 #include "node_mutex.h"
 #include "node_worker.h"
 #include "permission/permission.h"
@@ -22,8 +23,9 @@
 #include <ctime>
 #include <cwctype>
 #include <fstream>
+#include <optional>
 
-constexpr int NODE_REPORT_VERSION = 5;
+constexpr int NODE_REPORT_VERSION = 6;
 constexpr int NANOS_PER_SEC = 1000 * 1000 * 1000;
 constexpr double SEC_PER_MICROS = 1e-6;
 constexpr int MAX_FRAME_COUNT = node::kMaxFrameCountForLogging;
@@ -42,6 +44,7 @@ using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
 using v8::Object;
+using v8::Promise;
 using v8::RegisterState;
 using v8::SampleInfo;
 using v8::StackFrame;
@@ -63,6 +66,17 @@ static void WriteNodeReport(Isolate* isolate,
                             bool compact,
                             bool exclude_network = false,
                             bool exclude_env = false);
+struct ReportHeader;
+static void PrintHeader(JSONWriter* writer,
+                        const ReportHeader& header,
+                        bool exclude_network);
+static void PrintThreadSections(JSONWriter* writer,
+                                Isolate* isolate,
+                                Environment* env,
+                                Local<Value> error,
+                                const char* trigger,
+                                bool exclude_network);
+static void PrintProcessSections(JSONWriter* writer, bool exclude_env);
 static void PrintVersionInformation(JSONWriter* writer,
                                     bool exclude_network = false);
 static void PrintJavaScriptErrorStack(JSONWriter* writer,
@@ -87,6 +101,33 @@ static void PrintRelease(JSONWriter* writer);
 static void PrintCpuInfo(JSONWriter* writer);
 static void PrintNetworkInterfaceInfo(JSONWriter* writer);
 
+// The parts of the report header that describe the event, captured when it
+// is triggered.
+struct ReportHeader {
+  std::string message;
+  std::string trigger;
+  std::string filename;
+  TIME_TYPE tm_struct;
+  uv_timeval64_t timestamp;
+  bool has_timestamp;
+  std::optional<uint64_t> thread_id;
+};
+
+static ReportHeader CaptureReportHeader(Environment* env,
+                                        const char* message,
+                                        const char* trigger,
+                                        const std::string& filename) {
+  ReportHeader header;
+  header.message = message;
+  header.trigger = trigger;
+  header.filename = filename;
+  // Obtain the current time.
+  DiagnosticFilename::LocalTime(&header.tm_struct);
+  header.has_timestamp = uv_gettimeofday(&header.timestamp) == 0;
+  if (env != nullptr) header.thread_id = env->thread_id();
+  return header;
+}
+
 // Internal function to coordinate and write the various
 // sections of the report to the supplied stream
 static void WriteNodeReport(Isolate* isolate,
@@ -99,28 +140,39 @@ static void WriteNodeReport(Isolate* isolate,
                             bool compact,
                             bool exclude_network,
                             bool exclude_env) {
-  // Obtain the current time and the pid.
-  TIME_TYPE tm_struct;
-  DiagnosticFilename::LocalTime(&tm_struct);
-  uv_pid_t pid = uv_os_getpid();
+  ReportHeader header = CaptureReportHeader(env, message, trigger, filename);
 
   // Save formatting for output stream.
   std::ios old_state(nullptr);
   old_state.copyfmt(out);
 
-  // File stream opened OK, now start printing the report content:
-  // the title and header information (event, filename, timestamp and pid)
-
   JSONWriter writer(out, compact);
   writer.json_start();
-  writer.json_objectstart("header");
-  writer.json_keyvalue("reportVersion", NODE_REPORT_VERSION);
-  writer.json_keyvalue("event", message);
-  writer.json_keyvalue("trigger", trigger);
-  if (!filename.empty())
-    writer.json_keyvalue("filename", filename);
+  PrintHeader(&writer, header, exclude_network);
+  PrintThreadSections(&writer, isolate, env, error, trigger, exclude_network);
+  PrintProcessSections(&writer, exclude_env);
+  writer.json_objectend();
+
+  // Restore output stream formatting.
+  out.copyfmt(old_state);
+}
+
+// Print the title and header information (event, filename, timestamp and
+// pid) of the report.
+static void PrintHeader(JSONWriter* writer,
+                        const ReportHeader& header,
+                        bool exclude_network) {
+  const TIME_TYPE& tm_struct = header.tm_struct;
+  uv_pid_t pid = uv_os_getpid();
+
+  writer->json_objectstart("header");
+  writer->json_keyvalue("reportVersion", NODE_REPORT_VERSION);
+  writer->json_keyvalue("event", header.message);
+  writer->json_keyvalue("trigger", header.trigger);
+  if (!header.filename.empty())
+    writer->json_keyvalue("filename", header.filename);
   else
-    writer.json_keyvalue("filename", JSONWriter::Null{});
+    writer->json_keyvalue("filename", JSONWriter::Null{});
 
   // Report dump event and module load date/time stamps
   char timebuf[64];
@@ -134,7 +186,7 @@ static void WriteNodeReport(Isolate* isolate,
            tm_struct.wHour,
            tm_struct.wMinute,
            tm_struct.wSecond);
-  writer.json_keyvalue("dumpEventTime", timebuf);
+  writer->json_keyvalue("dumpEventTime", timebuf);
 #else  // UNIX, macOS
   snprintf(timebuf,
            sizeof(timebuf),
@@ -145,86 +197,95 @@ static void WriteNodeReport(Isolate* isolate,
            tm_struct.tm_hour,
            tm_struct.tm_min,
            tm_struct.tm_sec);
-  writer.json_keyvalue("dumpEventTime", timebuf);
+  writer->json_keyvalue("dumpEventTime", timebuf);
 #endif
 
-  uv_timeval64_t ts;
-  if (uv_gettimeofday(&ts) == 0) {
-    writer.json_keyvalue("dumpEventTimeStamp",
-                         std::to_string(ts.tv_sec * 1000 + ts.tv_usec / 1000));
+  if (header.has_timestamp) {
+    const uv_timeval64_t& ts = header.timestamp;
+    writer->json_keyvalue("dumpEventTimeStamp",
+                          std::to_string(ts.tv_sec * 1000 + ts.tv_usec / 1000));
   }
 
   // Report native process ID
-  writer.json_keyvalue("processId", pid);
-  if (env != nullptr)
-    writer.json_keyvalue("threadId", env->thread_id());
+  writer->json_keyvalue("processId", pid);
+  if (header.thread_id.has_value())
+    writer->json_keyvalue("threadId", *header.thread_id);
   else
-    writer.json_keyvalue("threadId", JSONWriter::Null{});
+    writer->json_keyvalue("threadId", JSONWriter::Null{});
 
   {
     // Report the process cwd.
     char buf[PATH_MAX_BYTES];
     size_t cwd_size = sizeof(buf);
     if (uv_cwd(buf, &cwd_size) == 0)
-      writer.json_keyvalue("cwd", buf);
+      writer->json_keyvalue("cwd", buf);
   }
 
   // Report out the command line.
   if (!per_process::cli_options->cmdline.empty()) {
-    writer.json_arraystart("commandLine");
+    writer->json_arraystart("commandLine");
     for (const std::string& arg : per_process::cli_options->cmdline) {
-      writer.json_element(arg);
+      writer->json_element(arg);
     }
-    writer.json_arrayend();
+    writer->json_arrayend();
   }
 
   // Report Node.js and OS version information
-  PrintVersionInformation(&writer, exclude_network);
-  writer.json_objectend();
+  PrintVersionInformation(writer, exclude_network);
+  writer->json_objectend();
+}
 
+// Print the sections of the report that describe the state of the thread
+// that triggered it. These can only be written on that thread.
+static void PrintThreadSections(JSONWriter* writer,
+                                Isolate* isolate,
+                                Environment* env,
+                                Local<Value> error,
+                                const char* trigger,
+                                bool exclude_network) {
   if (isolate != nullptr) {
-    writer.json_objectstart("javascriptStack");
+    writer->json_objectstart("javascriptStack");
     // Report summary JavaScript error stack backtrace
-    PrintJavaScriptErrorStack(&writer, isolate, error, trigger);
+    PrintJavaScriptErrorStack(writer, isolate, error, trigger);
 
-    writer.json_objectend();  // the end of 'javascriptStack'
+    writer->json_objectend();  // the end of 'javascriptStack'
 
     // Report V8 Heap and Garbage Collector information
-    PrintGCStatistics(&writer, isolate);
+    PrintGCStatistics(writer, isolate);
   } else {
-    writer.json_objectstart("javascriptStack");
-    PrintEmptyJavaScriptStack(&writer);
-    writer.json_objectend();  // the end of 'javascriptStack'
+    writer->json_objectstart("javascriptStack");
+    PrintEmptyJavaScriptStack(writer);
+    writer->json_objectend();  // the end of 'javascriptStack'
   }
 
   // Report native stack backtrace
-  PrintNativeStack(&writer);
+  PrintNativeStack(writer);
 
   // Report OS and current thread resource usage
-  PrintResourceUsage(&writer);
+  PrintResourceUsage(writer);
 
-  writer.json_arraystart("libuv");
+  writer->json_arraystart("libuv");
   if (env != nullptr) {
     uv_walk(env->event_loop(),
             exclude_network ? WalkHandleNoNetwork : WalkHandleNetwork,
-            static_cast<void*>(&writer));
+            static_cast<void*>(writer));
 
-    writer.json_start();
-    writer.json_keyvalue("type", "loop");
-    writer.json_keyvalue("is_active",
+    writer->json_start();
+    writer->json_keyvalue("type", "loop");
+    writer->json_keyvalue("is_active",
         static_cast<bool>(uv_loop_alive(env->event_loop())));
-    writer.json_keyvalue("address",
+    writer->json_keyvalue("address",
         ValueToHexString(reinterpret_cast<int64_t>(env->event_loop())));
 
     // Report Event loop idle time
     uint64_t idle_time = uv_metrics_idle_time(env->event_loop());
-    writer.json_keyvalue("loopIdleTimeSeconds", 1.0 * idle_time / 1e9);
-    writer.json_end();
+    writer->json_keyvalue("loopIdleTimeSeconds", 1.0 * idle_time / 1e9);
+    writer->json_end();
   }
 
-  writer.json_arrayend();
+  writer->json_arrayend();
 
-  writer.json_arraystart("workers");
+  writer->json_arraystart("workers");
   if (env != nullptr) {
     Mutex workers_mutex;
     ConditionVariable notify;
@@ -249,20 +310,19 @@ static void WriteNodeReport(Isolate* isolate,
     while (worker_infos.size() < expected_results)
       notify.Wait(lock);
     for (const std::string& worker_info : worker_infos)
-      writer.json_element(JSONWriter::ForeignJSON { worker_info });
+      writer->json_element(JSONWriter::ForeignJSON { worker_info });
   }
-  writer.json_arrayend();
+  writer->json_arrayend();
+}
 
+// Print the sections of the report that describe the process as a whole.
+// These can be written on any thread.
+static void PrintProcessSections(JSONWriter* writer, bool exclude_env) {
   // Report operating system information
   if (exclude_env == false) {
-    PrintEnvironmentVariables(&writer);
+    PrintEnvironmentVariables(writer);
   }
-  PrintSystemInformation(&writer);
-
-  writer.json_objectend();
-
-  // Restore output stream formatting.
-  out.copyfmt(old_state);
+  PrintSystemInformation(writer);
 }
 
 // Report Node.js version, OS version and machine information.
@@ -601,6 +661,10 @@ static void PrintGCStatistics(JSONWriter* writer, Isolate* isolate) {
   writer->json_keyvalue("detachedContextCount",
                         v8_heap_stats.number_of_detached_contexts());
   writer->json_keyvalue("doesZapGarbage", v8_heap_stats.does_zap_garbage());
+  HugePageStats huge_page_stats = GetHugePageStats();
+  writer->json_keyvalue("hugePageAdvisedMemory",
+                        huge_page_stats.advised_bytes);
+  writer->json_keyvalue("hugePageMemory", huge_page_stats.huge_page_bytes);
 
   writer->json_objectstart("heapSpaces");
   // Loop through heap spaces
@@ -841,27 +905,21 @@ static void PrintRelease(JSONWriter* writer) {
   writer->json_objectend();
 }
 
-}  // namespace report
-
-std::string TriggerNodeReport(Isolate* isolate,
-                              Environment* env,
-                              const char* message,
-                              const char* trigger,
+// Determine the required report filename. In order of priority:
+//   1) supplied on API 2) configured on startup 3) default generated
+// Returns false, with an exception pending, if the file may not be written.
+static bool GetReportFilename(Environment* env,
                               const std::string& name,
-                              Local<Value> error) {
-  std::string filename;
-
-  // Determine the required report filename. In order of priority:
-  //   1) supplied on API 2) configured on startup 3) default generated
+                              std::string* filename) {
   if (!name.empty()) {
+    // Filename was specified as API parameter.
+    *filename = name;
     // we may not always be in a great state when generating a node report
     // allow for the case where we don't have an env
     if (env != nullptr) {
       THROW_IF_INSUFFICIENT_PERMISSIONS(
-          env, permission::PermissionScope::kFileSystemWrite, name, name);
-      // Filename was specified as API parameter.
+          env, permission::PermissionScope::kFileSystemWrite, name, false);
     }
-    filename = name;
   } else {
     std::string report_filename;
     {
@@ -870,9 +928,9 @@ std::string TriggerNodeReport(Isolate* isolate,
     }
     if (report_filename.length() > 0) {
       // File name was supplied via start-up option.
-      filename = report_filename;
+      *filename = report_filename;
     } else {
-      filename = *DiagnosticFilename(
+      *filename = *DiagnosticFilename(
           env != nullptr ? env->thread_id() : 0, "report", "json");
     }
     if (env != nullptr) {
@@ -880,9 +938,159 @@ std::string TriggerNodeReport(Isolate* isolate,
           env,
           permission::PermissionScope::kFileSystemWrite,
           std::string_view(Environment::GetCwd(env->exec_path())),
-          filename);
+          false);
     }
   }
+  return true;
+}
+
+// Formats a report from the state that was captured on the thread that
+// triggered it, and writes it to its file in the threadpool.
+class ReportWriteWork final : public ThreadPoolWork {
+ public:
+  ReportWriteWork(Environment* env,
+                  Local<Promise::Resolver> resolver,
+                  ReportHeader&& header,
+                  std::string&& thread_sections,
+                  std::string&& path,
+                  bool compact,
+                  bool exclude_network,
+                  bool exclude_env)
+      : ThreadPoolWork(env, "report.ReportWriteWork"),
+        header_(std::move(header)),
+        thread_sections_(std::move(thread_sections)),
+        path_(std::move(path)),
+        compact_(compact),
+        exclude_network_(exclude_network),
+        exclude_env_(exclude_env) {
+    resolver_.Reset(env->isolate(), resolver);
+  }
+
+  void DoThreadPoolWork() override {
+    std::ostringstream out;
+    JSONWriter writer(out, compact_);
+    writer.json_start();
+    PrintHeader(&writer, header_, exclude_network_);
+    writer.json_members(thread_sections_);
+    PrintProcessSections(&writer, exclude_env_);
+    writer.json_objectend();
+    report_ = out.str();
+
+    // stdout and stderr are written on the main thread.
+    if (IsStdio()) return;
+    uv_buf_t buf = uv_buf_init(report_.data(), report_.size());
+    err_ = WriteFileSync(path_.c_str(), buf);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReportWriteWork> self(this);
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Local<Context> context = env()->context();
+    Context::Scope context_scope(context);
+    Local<Promise::Resolver> resolver = resolver_.Get(isolate);
+
+    if (status != 0) err_ = status;
+    if (err_ != 0) {
+      Local<Value> exception =
+          UVException(isolate, err_, "open", nullptr, path_.c_str());
+      USE(resolver->Reject(context, exception));
+      return;
+    }
+
+    if (header_.filename == "stdout") {
+      std::cout << report_ << std::flush;
+    } else if (header_.filename == "stderr") {
+      std::cerr << report_ << std::flush;
+    }
+
+    Local<Value> filename;
+    if (ToV8Value(context, header_.filename, isolate).ToLocal(&filename)) {
+      USE(resolver->Resolve(context, filename));
+    }
+  }
+
+ private:
+  bool IsStdio() const {
+    return header_.filename == "stdout" || header_.filename == "stderr";
+  }
+
+  v8::Global<Promise::Resolver> resolver_;
+  ReportHeader header_;
+  std::string thread_sections_;
+  std::string path_;
+  std::string report_;
+  bool compact_;
+  bool exclude_network_;
+  bool exclude_env_;
+  int err_ = 0;
+};
+
+MaybeLocal<Promise> TriggerNodeReportAsync(Environment* env,
+                                           const char* message,
+                                           const char* trigger,
+                                           const std::string& name,
+                                           Local<Value> error) {
+  Isolate* isolate = env->isolate();
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(env->context()).ToLocal(&resolver)) {
+    return MaybeLocal<Promise>();
+  }
+
+  std::string filename;
+  if (!GetReportFilename(env, name, &filename)) return MaybeLocal<Promise>();
+
+  std::string path = filename;
+  bool compact;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    compact = per_process::cli_options->report_compact;
+    const std::string& report_directory =
+        per_process::cli_options->report_directory;
+    // Regular file. Append filename to directory path if one was specified
+    if (filename != "stdout" && filename != "stderr" &&
+        report_directory.length() > 0) {
+      path = report_directory + kPathSeparator + filename;
+    }
+  }
+  bool exclude_network = env->options()->report_exclude_network;
+  bool exclude_env = env->report_exclude_env();
+
+  // Only the sections that describe this thread are written synchronously.
+  // The rest of the report is formatted, and the file written, in the
+  // threadpool.
+  ReportHeader header = CaptureReportHeader(env, message, trigger, filename);
+  std::ostringstream thread_sections;
+  {
+    JSONWriter writer(thread_sections, compact);
+    writer.json_start();
+    PrintThreadSections(
+        &writer, isolate, env, error, trigger, exclude_network);
+    writer.json_end();
+  }
+
+  ReportWriteWork* work = new ReportWriteWork(env,
+                                              resolver,
+                                              std::move(header),
+                                              thread_sections.str(),
+                                              std::move(path),
+                                              compact,
+                                              exclude_network,
+                                              exclude_env);
+  work->ScheduleWork();
+  return resolver->GetPromise();
+}
+
+}  // namespace report
+
+std::string TriggerNodeReport(Isolate* isolate,
+                              Environment* env,
+                              const char* message,
+                              const char* trigger,
+                              const std::string& name,
+                              Local<Value> error) {
+  std::string filename;
+  if (!report::GetReportFilename(env, name, &filename)) return filename;
 
   // Open the report file stream for writing. Supports stdout/err,
   // user-specified or (default) generated name
@@ -31,8 +31,19 @@ std::string ValueToHexString(T value) {
   return hex.str();
 }
 
+// Writes a report like TriggerNodeReport(), but only the state of the
+// current thread is captured synchronously. The rest of the report is
+// formatted and written to the file in the threadpool, and the returned
+// promise is resolved with the filename when that is done.
+v8::MaybeLocal<v8::Promise> TriggerNodeReportAsync(Environment* env,
+                                                   const char* message,
+                                                   const char* trigger,
+                                                   const std::string& name,
+                                                   v8::Local<v8::Value> error);
+
 // Function declarations - export functions in src/node_report_module.cc
 void WriteReport(const v8::FunctionCallbackInfo<v8::Value>& info);
+void WriteReportAsync(const v8::FunctionCallbackInfo<v8::Value>& info);
 void GetReport(const v8::FunctionCallbackInfo<v8::Value>& info);
 
 }  // namespace report
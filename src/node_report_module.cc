@@ -23,6 +23,7 @@ using v8::HandleScope;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
+using v8::Promise;
 using v8::String;
 using v8::Value;
 
@@ -52,6 +53,32 @@ void WriteReport(const FunctionCallbackInfo<Value>& info) {
   }
 }
 
+void WriteReportAsync(const FunctionCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Isolate* isolate = env->isolate();
+  HandleScope scope(isolate);
+  std::string filename;
+  Local<Value> error;
+
+  CHECK_EQ(info.Length(), 4);
+  String::Utf8Value message(isolate, info[0].As<String>());
+  String::Utf8Value trigger(isolate, info[1].As<String>());
+
+  if (info[2]->IsString())
+    filename = *String::Utf8Value(isolate, info[2]);
+  if (!info[3].IsEmpty())
+    error = info[3];
+  else
+    error = Local<Value>();
+
+  // Return value is a promise for the report filename
+  Local<Promise> ret;
+  if (TriggerNodeReportAsync(env, *message, *trigger, filename, error)
+          .ToLocal(&ret)) {
+    info.GetReturnValue().Set(ret);
+  }
+}
+
 // External JavaScript API for returning a report
 void GetReport(const FunctionCallbackInfo<Value>& info) {
   Environment* env = Environment::GetCurrent(info);
@@ -203,6 +230,7 @@ static void Initialize(Local<Object> exports,
                        Local<Context> context,
                        void* priv) {
   SetMethod(context, exports, "writeReport", WriteReport);
+  SetMethod(context, exports, "writeReportAsync", WriteReportAsync);
   SetMethod(context, exports, "getReport", GetReport);
   SetMethod(context, exports, "getCompact", GetCompact);
   SetMethod(context, exports, "setCompact", SetCompact);
@@ -233,6 +261,7 @@ static void Initialize(Local<Object> exports,
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(WriteReport);
+  registry->Register(WriteReportAsync);
   registry->Register(GetReport);
   registry->Register(GetCompact);
   registry->Register(SetCompact);
@@ -8,10 +8,12 @@
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_internals.h"
+#include "node_mutex.h"
 #include "node_snapshot_builder.h"
 #include "node_union_bytes.h"
 #include "node_v8_platform-inl.h"
 #include "util-inl.h"
+#include "zstd.h"
 
 // The POSTJECT_SENTINEL_FUSE macro is a string of random characters selected by
 // the Node.js project that is present only once in the entire binary. It is
@@ -114,13 +116,22 @@ size_t SeaSerializer::Write(const SeaResource& sea) {
   if (!sea.assets.empty()) {
     Debug("Write SEA resource assets size %zu\n", sea.assets.size());
     written_total += WriteArithmetic<size_t>(sea.assets.size());
-    for (auto const& [key, content] : sea.assets) {
+    for (auto const& [key, asset] : sea.assets) {
       Debug("Write SEA resource asset %s at %p, size=%zu\n",
             key,
-            content.data(),
-            content.size());
+            asset.content.data(),
+            asset.content.size());
       written_total += WriteStringView(key, StringLogMode::kAddressAndContent);
-      written_total += WriteStringView(content, StringLogMode::kAddressOnly);
+      written_total +=
+          WriteStringView(asset.content, StringLogMode::kAddressOnly);
+      if (sea.compress_assets()) {
+        Debug("Write SEA resource asset compression %d, size=%zu\n",
+              static_cast<int>(asset.compression),
+              asset.size);
+        written_total +=
+            WriteArithmetic<uint8_t>(static_cast<uint8_t>(asset.compression));
+        written_total += WriteArithmetic<size_t>(asset.size);
+      }
     }
   }
   return written_total;
@@ -171,18 +182,32 @@ SeaResource SeaDeserializer::Read() {
           code_cache.size());
   }
 
-  std::unordered_map<std::string_view, std::string_view> assets;
+  // Only the offsets of the assets are recorded here, the content stays in
+  // the mapped section until it is accessed.
+  std::unordered_map<std::string_view, SeaAsset> assets;
   if (static_cast<bool>(flags & SeaFlags::kIncludeAssets)) {
+    bool compress_assets = static_cast<bool>(flags & SeaFlags::kCompressAssets);
     size_t assets_size = ReadArithmetic<size_t>();
     Debug("Read SEA resource assets size %zu\n", assets_size);
+    assets.reserve(assets_size);
     for (size_t i = 0; i < assets_size; ++i) {
       std::string_view key = ReadStringView(StringLogMode::kAddressAndContent);
-      std::string_view content = ReadStringView(StringLogMode::kAddressOnly);
+      SeaAsset asset;
+      asset.content = ReadStringView(StringLogMode::kAddressOnly);
+      asset.size = asset.content.size();
       Debug("Read SEA resource asset %s at %p, size=%zu\n",
             key,
-            content.data(),
-            content.size());
-      assets.emplace(key, content);
+            asset.content.data(),
+            asset.content.size());
+      if (compress_assets) {
+        asset.compression =
+            static_cast<SeaAssetCompression>(ReadArithmetic<uint8_t>());
+        asset.size = ReadArithmetic<size_t>();
+        Debug("Read SEA resource asset compression %d, size=%zu\n",
+              static_cast<int>(asset.compression),
+              asset.size);
+      }
+      assets.emplace(key, asset);
     }
   }
   return {flags, code_path, code, code_cache, assets};
@@ -225,6 +250,10 @@ bool SeaResource::use_code_cache() const {
   return static_cast<bool>(flags & SeaFlags::kUseCodeCache);
 }
 
+bool SeaResource::compress_assets() const {
+  return static_cast<bool>(flags & SeaFlags::kCompressAssets);
+}
+
 SeaResource FindSingleExecutableResource() {
   static const SeaResource sea_resource = []() -> SeaResource {
     std::string_view blob = FindSingleExecutableBlob();
@@ -378,6 +407,18 @@ std::optional<SeaConfig> ParseSingleExecutableConfig(
     result.assets = std::move(assets_opt.value());
   }
 
+  std::optional<bool> compress_assets =
+      parser.GetTopLevelBoolField("compressAssets");
+  if (!compress_assets.has_value()) {
+    FPrintF(stderr,
+            "\"compressAssets\" field of %s is not a Boolean\n",
+            config_path);
+    return std::nullopt;
+  }
+  if (compress_assets.value() && !result.assets.empty()) {
+    result.flags |= SeaFlags::kCompressAssets;
+  }
+
   return result;
 }
 
@@ -484,17 +525,51 @@ std::optional<std::string> GenerateCodeCache(std::string_view main_path,
   return code_cache;
 }
 
+struct BuiltAsset {
+  std::string content;
+  SeaAssetCompression compression = SeaAssetCompression::kNone;
+  size_t size = 0;
+};
+
+// Compress the content with zstd. The content is kept as-is if compressing
+// it does not make it smaller, e.g. for images that are already compressed.
+void CompressAsset(BuiltAsset* asset) {
+  size_t bound = ZSTD_compressBound(asset->content.size());
+  std::string compressed(bound, '\0');
+  size_t result = ZSTD_compress(compressed.data(),
+                                bound,
+                                asset->content.data(),
+                                asset->content.size(),
+                                ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(result) || result >= asset->content.size()) {
+    return;
+  }
+  compressed.resize(result);
+  asset->content = std::move(compressed);
+  asset->compression = SeaAssetCompression::kZstd;
+}
+
 int BuildAssets(const std::unordered_map<std::string, std::string>& config,
-                std::unordered_map<std::string, std::string>* assets) {
+                bool compress,
+                std::unordered_map<std::string, BuiltAsset>* assets) {
   for (auto const& [key, path] : config) {
-    std::string blob;
-    int r = ReadFileSync(&blob, path.c_str());
+    BuiltAsset asset;
+    int r = ReadFileSync(&asset.content, path.c_str());
     if (r != 0) {
       const char* err = uv_strerror(r);
       FPrintF(stderr, "Cannot read asset %s: %s\n", path.c_str(), err);
       return r;
     }
-    assets->emplace(key, std::move(blob));
+    asset.size = asset.content.size();
+    if (compress) {
+      CompressAsset(&asset);
+      per_process::Debug(DebugCategory::SEA,
+                         "Compressed asset %s from %zu to %zu bytes\n",
+                         key,
+                         asset.size,
+                         asset.content.size());
+    }
+    assets->emplace(key, std::move(asset));
   }
   return 0;
 }
@@ -539,13 +614,17 @@ ExitCode GenerateSingleExecutableBlob(
     optional_sv_code_cache = code_cache;
   }
 
-  std::unordered_map<std::string, std::string> assets;
-  if (!config.assets.empty() && BuildAssets(config.assets, &assets) != 0) {
+  std::unordered_map<std::string, BuiltAsset> assets;
+  if (!config.assets.empty() &&
+      BuildAssets(config.assets,
+                  static_cast<bool>(config.flags & SeaFlags::kCompressAssets),
+                  &assets) != 0) {
     return ExitCode::kGenericUserError;
   }
-  std::unordered_map<std::string_view, std::string_view> assets_view;
-  for (auto const& [key, content] : assets) {
-    assets_view.emplace(key, content);
+  std::unordered_map<std::string_view, SeaAsset> assets_view;
+  for (auto const& [key, asset] : assets) {
+    assets_view.emplace(key,
+                        SeaAsset{asset.content, asset.compression, asset.size});
   }
   SeaResource sea{
       config.flags,
@@ -589,6 +668,58 @@ ExitCode BuildSingleExecutableBlob(const std::string& config_path,
   return ExitCode::kGenericUserError;
 }
 
+namespace {
+// Compressed assets are decompressed on first access, and the decompressed
+// content is shared by all the threads for the rest of the process. This is
+// never freed, like the mapped section that the other assets refer to.
+Mutex decompressed_assets_mutex;
+std::unordered_map<std::string_view, std::shared_ptr<BackingStore>>*
+    decompressed_assets = nullptr;
+
+std::shared_ptr<BackingStore> GetDecompressedAsset(std::string_view key,
+                                                   const SeaAsset& asset) {
+  CHECK_EQ(asset.compression, SeaAssetCompression::kZstd);
+  {
+    Mutex::ScopedLock lock(decompressed_assets_mutex);
+    if (decompressed_assets == nullptr) {
+      decompressed_assets = new std::unordered_map<
+          std::string_view,
+          std::shared_ptr<BackingStore>>();
+    }
+    auto it = decompressed_assets->find(key);
+    if (it != decompressed_assets->end()) {
+      return it->second;
+    }
+  }
+
+  // Decompress without holding the lock so that threads accessing other
+  // assets are not blocked.
+  per_process::Debug(DebugCategory::SEA,
+                     "Decompressing asset %s, size=%zu\n",
+                     key,
+                     asset.size);
+  char* data = UncheckedMalloc(asset.size);
+  if (data == nullptr && asset.size > 0) {
+    return nullptr;
+  }
+  size_t result = ZSTD_decompress(
+      data, asset.size, asset.content.data(), asset.content.size());
+  if (ZSTD_isError(result) || result != asset.size) {
+    free(data);
+    return nullptr;
+  }
+  std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
+      data,
+      asset.size,
+      [](void* data, size_t, void*) { free(data); },
+      nullptr);
+
+  Mutex::ScopedLock lock(decompressed_assets_mutex);
+  // If another thread has decompressed it in the meantime, use that one.
+  return decompressed_assets->emplace(key, std::move(store)).first->second;
+}
+}  // anonymous namespace
+
 void GetAsset(const FunctionCallbackInfo<Value>& args) {
   CHECK_EQ(args.Length(), 1);
   CHECK(args[0]->IsString());
@@ -601,15 +732,28 @@ void GetAsset(const FunctionCallbackInfo<Value>& args) {
   if (it == sea_resource.assets.end()) {
     return;
   }
-  // We cast away the constness here, the JS land should ensure that
-  // the data is not mutated.
-  std::unique_ptr<v8::BackingStore> store = ArrayBuffer::NewBackingStore(
-      const_cast<char*>(it->second.data()),
-      it->second.size(),
-      [](void*, size_t, void*) {},
-      nullptr);
-  Local<ArrayBuffer> ab = ArrayBuffer::New(args.GetIsolate(), std::move(store));
-  args.GetReturnValue().Set(ab);
+  const SeaAsset& asset = it->second;
+  if (asset.compression == SeaAssetCompression::kNone) {
+    // We cast away the constness here, the JS land should ensure that
+    // the data is not mutated.
+    std::unique_ptr<v8::BackingStore> store = ArrayBuffer::NewBackingStore(
+        const_cast<char*>(asset.content.data()),
+        asset.content.size(),
+        [](void*, size_t, void*) {},
+        nullptr);
+    Local<ArrayBuffer> ab =
+        ArrayBuffer::New(args.GetIsolate(), std::move(store));
+    args.GetReturnValue().Set(ab);
+    return;
+  }
+
+  std::shared_ptr<BackingStore> store = GetDecompressedAsset(it->first, asset);
+  if (!store) {
+    Environment* env = Environment::GetCurrent(args);
+    THROW_ERR_INVALID_STATE(env, "Cannot decompress asset %s", *key);
+    return;
+  }
+  args.GetReturnValue().Set(ArrayBuffer::New(args.GetIsolate(), store));
 }
 
 MaybeLocal<Value> LoadSingleExecutableApplication(
@@ -28,6 +28,21 @@ enum class SeaFlags : uint32_t {
   kUseSnapshot = 1 << 1,
   kUseCodeCache = 1 << 2,
   kIncludeAssets = 1 << 3,
+  kCompressAssets = 1 << 4,
+};
+
+enum class SeaAssetCompression : uint8_t {
+  kNone = 0,
+  kZstd = 1,
+};
+
+struct SeaAsset {
+  // The content as stored in the blob, which is compressed unless
+  // compression is kNone.
+  std::string_view content;
+  SeaAssetCompression compression = SeaAssetCompression::kNone;
+  // The size of the content after decompression.
+  size_t size = 0;
 };
 
 struct SeaResource {
@@ -35,10 +50,11 @@ struct SeaResource {
   std::string_view code_path;
   std::string_view main_code_or_snapshot;
   std::optional<std::string_view> code_cache;
-  std::unordered_map<std::string_view, std::string_view> assets;
+  std::unordered_map<std::string_view, SeaAsset> assets;
 
   bool use_snapshot() const;
   bool use_code_cache() const;
+  bool compress_assets() const;
 
   static constexpr size_t kHeaderSize = sizeof(kMagic) + sizeof(SeaFlags);
 };
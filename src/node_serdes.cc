@@ -5,10 +5,14 @@
 #include "node_internals.h"
 #include "util-inl.h"
 
+#include <vector>
+
 namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -17,12 +21,15 @@ using v8::Integer;
 using v8::Isolate;
 using v8::Just;
 using v8::Local;
+using v8::LocalVector;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::SharedArrayBuffer;
 using v8::String;
+using v8::Uint8Array;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -35,15 +42,20 @@ class SerializerContext : public BaseObject,
   SerializerContext(Environment* env,
                     Local<Object> wrap);
 
-  ~SerializerContext() override = default;
+  ~SerializerContext() override;
 
   void ThrowDataCloneError(Local<String> message) override;
   Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object) override;
   Maybe<uint32_t> GetSharedArrayBufferId(
       Isolate* isolate, Local<SharedArrayBuffer> shared_array_buffer) override;
+  void* ReallocateBufferMemory(void* old_buffer,
+                               size_t size,
+                               size_t* actual_size) override;
+  void FreeBufferMemory(void* buffer) override;
 
   static void SetTreatArrayBufferViewsAsHostObjects(
       const FunctionCallbackInfo<Value>& args);
+  static void SetInitialBufferSize(const FunctionCallbackInfo<Value>& args);
 
   static void New(const FunctionCallbackInfo<Value>& args);
   static void WriteHeader(const FunctionCallbackInfo<Value>& args);
@@ -54,13 +66,33 @@ class SerializerContext : public BaseObject,
   static void WriteUint64(const FunctionCallbackInfo<Value>& args);
   static void WriteDouble(const FunctionCallbackInfo<Value>& args);
   static void WriteRawBytes(const FunctionCallbackInfo<Value>& args);
+  static void WriteExternalBytes(const FunctionCallbackInfo<Value>& args);
+  static void ReleaseBuffers(const FunctionCallbackInfo<Value>& args);
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SerializerContext)
   SET_SELF_SIZE(SerializerContext)
 
  private:
+  // A piece of the serialized output. Segments without a `store` hold a
+  // chunk of the serializer's own buffer that was allocated with malloc();
+  // the others point into the memory of a view passed to writeExternalBytes().
+  struct Segment {
+    char* data;
+    size_t length;
+    std::shared_ptr<BackingStore> store;
+  };
+
+  // Moves the data that has been written so far into segments_, so that the
+  // next write starts a new chunk. ValueSerializer keeps all of its state
+  // (object ids, transferred buffers) across Release(), only the buffer is
+  // handed over.
+  void FlushBuffer();
+  void FreeSegments();
+
   ValueSerializer serializer_;
+  std::vector<Segment> segments_;
+  size_t initial_buffer_size_ = 0;
 };
 
 class DeserializerContext : public BaseObject,
@@ -101,6 +133,44 @@ SerializerContext::SerializerContext(Environment* env, Local<Object> wrap)
   MakeWeak();
 }
 
+SerializerContext::~SerializerContext() {
+  FreeSegments();
+}
+
+void* SerializerContext::ReallocateBufferMemory(void* old_buffer,
+                                                size_t size,
+                                                size_t* actual_size) {
+  // The first allocation reserves the size hint, if there is one, so that
+  // serializing values of a known size does not have to grow the buffer.
+  if (old_buffer == nullptr && initial_buffer_size_ > size) {
+    size = initial_buffer_size_;
+    initial_buffer_size_ = 0;
+  }
+  void* ret = realloc(old_buffer, size);
+  if (ret != nullptr) *actual_size = size;
+  return ret;
+}
+
+void SerializerContext::FreeBufferMemory(void* buffer) {
+  free(buffer);
+}
+
+void SerializerContext::FlushBuffer() {
+  std::pair<uint8_t*, size_t> ret = serializer_.Release();
+  if (ret.second == 0) {
+    free(ret.first);
+    return;
+  }
+  segments_.push_back({reinterpret_cast<char*>(ret.first), ret.second, {}});
+}
+
+void SerializerContext::FreeSegments() {
+  for (const Segment& segment : segments_) {
+    if (!segment.store) free(segment.data);
+  }
+  segments_.clear();
+}
+
 void SerializerContext::ThrowDataCloneError(Local<String> message) {
   Local<Value> args[1] = { message };
   Local<Value> get_data_clone_error;
@@ -204,20 +274,94 @@ void SerializerContext::SetTreatArrayBufferViewsAsHostObjects(
   ctx->serializer_.SetTreatArrayBufferViewsAsHostObjects(value);
 }
 
+void SerializerContext::SetInitialBufferSize(
+    const FunctionCallbackInfo<Value>& args) {
+  SerializerContext* ctx;
+  ASSIGN_OR_RETURN_UNWRAP(&ctx, args.This());
+  CHECK(args[0]->IsNumber());
+  ctx->initial_buffer_size_ =
+      static_cast<size_t>(args[0].As<Number>()->Value());
+}
+
 void SerializerContext::ReleaseBuffer(const FunctionCallbackInfo<Value>& args) {
   SerializerContext* ctx;
   ASSIGN_OR_RETURN_UNWRAP(&ctx, args.This());
 
-  // Note: Both ValueSerializer and this Buffer::New() variant use malloc()
-  // as the underlying allocator.
-  std::pair<uint8_t*, size_t> ret = ctx->serializer_.Release();
+  char* data;
+  size_t length;
+  if (ctx->segments_.empty()) {
+    // Note: Both ValueSerializer and this Buffer::New() variant use malloc()
+    // as the underlying allocator.
+    std::pair<uint8_t*, size_t> ret = ctx->serializer_.Release();
+    data = reinterpret_cast<char*>(ret.first);
+    length = ret.second;
+  } else {
+    // External segments have been recorded, so they have to be joined.
+    ctx->FlushBuffer();
+    length = 0;
+    for (const Segment& segment : ctx->segments_) length += segment.length;
+    data = UncheckedMalloc(length);
+    if (data == nullptr) {
+      ctx->FreeSegments();
+      return THROW_ERR_MEMORY_ALLOCATION_FAILED(ctx->env());
+    }
+    size_t offset = 0;
+    for (const Segment& segment : ctx->segments_) {
+      memcpy(data + offset, segment.data, segment.length);
+      offset += segment.length;
+    }
+    ctx->FreeSegments();
+  }
+
   Local<Object> buf;
-  if (Buffer::New(ctx->env(), reinterpret_cast<char*>(ret.first), ret.second)
-          .ToLocal(&buf)) {
+  if (Buffer::New(ctx->env(), data, length).ToLocal(&buf)) {
     args.GetReturnValue().Set(buf);
   }
 }
 
+void SerializerContext::ReleaseBuffers(
+    const FunctionCallbackInfo<Value>& args) {
+  SerializerContext* ctx;
+  ASSIGN_OR_RETURN_UNWRAP(&ctx, args.This());
+  Environment* env = ctx->env();
+  Isolate* isolate = env->isolate();
+
+  ctx->FlushBuffer();
+  std::vector<Segment> segments = std::move(ctx->segments_);
+  ctx->segments_.clear();
+
+  LocalVector<Value> buffers(isolate);
+  buffers.reserve(segments.size());
+  for (size_t i = 0; i < segments.size(); i++) {
+    Segment& segment = segments[i];
+    Local<Object> buf;
+    bool ok;
+    if (segment.store) {
+      size_t offset =
+          segment.data - static_cast<char*>(segment.store->Data());
+      Local<ArrayBuffer> ab =
+          ArrayBuffer::New(isolate, std::move(segment.store));
+      Local<Uint8Array> view;
+      ok = Buffer::New(env, ab, offset, segment.length).ToLocal(&view);
+      buf = view;
+    } else {
+      // Buffer::New() takes over the memory, even if it fails.
+      char* data = std::exchange(segment.data, nullptr);
+      ok = Buffer::New(env, data, segment.length).ToLocal(&buf);
+    }
+    if (!ok) {
+      for (size_t j = i + 1; j < segments.size(); j++) {
+        if (!segments[j].store) free(segments[j].data);
+      }
+      return;
+    }
+    buffers.push_back(buf);
+  }
+
+  args.GetReturnValue().Set(
+      Array::New(isolate, buffers.data(), buffers.size()));
+}
+
 void SerializerContext::TransferArrayBuffer(
     const FunctionCallbackInfo<Value>& args) {
   SerializerContext* ctx;
@@ -287,6 +431,31 @@ void SerializerContext::WriteRawBytes(const FunctionCallbackInfo<Value>& args) {
   ctx->serializer_.WriteRawBytes(bytes.data(), bytes.length());
 }
 
+void SerializerContext::WriteExternalBytes(
+    const FunctionCallbackInfo<Value>& args) {
+  SerializerContext* ctx;
+  ASSIGN_OR_RETURN_UNWRAP(&ctx, args.This());
+
+  if (!args[0]->IsArrayBufferView()) {
+    return node::THROW_ERR_INVALID_ARG_TYPE(
+        ctx->env(), "source must be a TypedArray or a DataView");
+  }
+
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  size_t length = view->ByteLength();
+  if (length == 0) return;
+
+  std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
+  char* data = static_cast<char*>(store->Data()) + view->ByteOffset();
+  if (store->IsShared()) {
+    // The released Buffers cannot be backed by shared memory.
+    ctx->serializer_.WriteRawBytes(data, length);
+    return;
+  }
+  ctx->FlushBuffer();
+  ctx->segments_.push_back({data, length, std::move(store)});
+}
+
 DeserializerContext::DeserializerContext(Environment* env,
                                          Local<Object> wrap,
                                          Local<Value> buffer)
@@ -487,10 +656,20 @@ void Initialize(Local<Object> target,
   SetProtoMethod(isolate, ser, "writeDouble", SerializerContext::WriteDouble);
   SetProtoMethod(
       isolate, ser, "writeRawBytes", SerializerContext::WriteRawBytes);
+  SetProtoMethod(isolate,
+                 ser,
+                 "writeExternalBytes",
+                 SerializerContext::WriteExternalBytes);
+  SetProtoMethod(
+      isolate, ser, "releaseBuffers", SerializerContext::ReleaseBuffers);
   SetProtoMethod(isolate,
                  ser,
                  "_setTreatArrayBufferViewsAsHostObjects",
                  SerializerContext::SetTreatArrayBufferViewsAsHostObjects);
+  SetProtoMethod(isolate,
+                 ser,
+                 "_setInitialBufferSize",
+                 SerializerContext::SetInitialBufferSize);
 
   ser->ReadOnlyPrototype();
   SetConstructorFunction(context, target, "Serializer", ser);
@@ -533,7 +712,10 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SerializerContext::WriteUint64);
   registry->Register(SerializerContext::WriteDouble);
   registry->Register(SerializerContext::WriteRawBytes);
+  registry->Register(SerializerContext::WriteExternalBytes);
+  registry->Register(SerializerContext::ReleaseBuffers);
   registry->Register(SerializerContext::SetTreatArrayBufferViewsAsHostObjects);
+  registry->Register(SerializerContext::SetInitialBufferSize);
 
   registry->Register(DeserializerContext::New);
   registry->Register(DeserializerContext::ReadHeader);
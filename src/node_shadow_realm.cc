@@ -1,13 +1,16 @@
 #include "node_shadow_realm.h"
 #include "env-inl.h"
 #include "node_errors.h"
+#include "node_internals.h"
 #include "node_process.h"
+#include "node_snapshotable.h"
 
 namespace node {
 namespace shadow_realm {
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::HandleScope;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
@@ -16,6 +19,28 @@ using v8::Value;
 
 using TryCatchScope = node::errors::TryCatchScope;
 
+namespace {
+
+// When the isolate has been deserialized from a snapshot, the ShadowRealm
+// context is deserialized from the base context in the snapshot, which already
+// contains the primordials and the other per-context states. Otherwise the
+// per-context scripts have to be compiled and run for every new realm.
+Local<Context> NewShadowRealmContext(Environment* env) {
+  Isolate* isolate = env->isolate();
+  if (env->isolate_data()->snapshot_data() == nullptr) {
+    return NewContext(isolate);
+  }
+  Local<Context> context;
+  if (!Context::FromSnapshot(isolate, SnapshotData::kNodeBaseContextIndex)
+           .ToLocal(&context) ||
+      InitializeContextRuntime(context).IsNothing()) {
+    return Local<Context>();
+  }
+  return context;
+}
+
+}  // anonymous namespace
+
 // static
 ShadowRealm* ShadowRealm::New(Environment* env) {
   ShadowRealm* realm = new ShadowRealm(env);
@@ -75,7 +100,7 @@ void ShadowRealm::DeleteMe(void* data) {
 }
 
 ShadowRealm::ShadowRealm(Environment* env)
-    : Realm(env, NewContext(env->isolate()), kShadowRealm) {
+    : Realm(env, NewShadowRealmContext(env), kShadowRealm) {
   context_.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
   CreateProperties();
 
@@ -29,12 +29,16 @@ class NODE_EXTERN_PRIVATE SnapshotBuilder {
   // Generate the snapshot into out. builder_script_content should match
   // config.builder_script_path. This is passed separately
   // in case the script is already read for other purposes.
+  // When base is not nullptr, the isolate and the environment are
+  // deserialized from it before the builder script is run, so that the
+  // snapshot generated contains the states of both.
   static ExitCode Generate(
       SnapshotData* out,
       const std::vector<std::string>& args,
       const std::vector<std::string>& exec_args,
       std::optional<std::string_view> builder_script_content,
-      const SnapshotConfig& config);
+      const SnapshotConfig& config,
+      const SnapshotData* base = nullptr);
 
   // If nullptr is returned, the binary is not built with embedded
   // snapshot.
@@ -15,6 +15,7 @@
 #include "node_blob.h"
 #include "node_builtins.h"
 #include "node_contextify.h"
+#include "node_diagnostics_channel.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_file.h"
@@ -33,6 +34,11 @@
 #include "inspector/worker_inspector.h"  // ParentInspectorHandle
 #endif
 
+#if defined(__POSIX__) && !defined(__wasi__)
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#endif
+
 namespace node {
 
 using v8::Context;
@@ -154,10 +160,23 @@ class SnapshotDeserializer : public BlobDeserializer<SnapshotDeserializer> {
                 DebugCategory::SNAPSHOT_SERDES),
             v) {}
 
+  // The code cache read by this deserializer refers to the blob instead of
+  // copying it. |backing_store| keeps the blob alive, or is nullptr if the
+  // blob has static lifetime.
+  SnapshotDeserializer(std::string_view v, std::shared_ptr<void> backing_store)
+      : SnapshotDeserializer(v) {
+    copy_code_cache_ = false;
+    backing_store_ = std::move(backing_store);
+  }
+
   template <typename T,
             std::enable_if_t<!std::is_same<T, std::string>::value>* = nullptr,
             std::enable_if_t<!std::is_arithmetic<T>::value>* = nullptr>
   T Read();
+
+ private:
+  bool copy_code_cache_ = true;
+  std::shared_ptr<void> backing_store_;
 };
 
 class SnapshotSerializer : public BlobSerializer<SnapshotSerializer> {
@@ -218,9 +237,19 @@ builtins::CodeCacheInfo SnapshotDeserializer::Read() {
   Debug("Read<builtins::CodeCacheInfo>()\n");
 
   std::string id = ReadString();
-  auto owning_ptr =
-      std::make_shared<std::vector<uint8_t>>(ReadVector<uint8_t>());
-  builtins::BuiltinCodeCacheData code_cache_data{std::move(owning_ptr)};
+  builtins::BuiltinCodeCacheData code_cache_data;
+  if (copy_code_cache_) {
+    auto owning_ptr =
+        std::make_shared<std::vector<uint8_t>>(ReadVector<uint8_t>());
+    code_cache_data = builtins::BuiltinCodeCacheData(std::move(owning_ptr));
+  } else {
+    // The layout of the code cache is the same as that of a string.
+    std::string_view view = ReadStringView(StringLogMode::kAddressOnly);
+    code_cache_data = builtins::BuiltinCodeCacheData(
+        reinterpret_cast<const uint8_t*>(view.data()),
+        view.size(),
+        backing_store_);
+  }
   builtins::CodeCacheInfo result{id, code_cache_data};
 
   if (is_debug) {
@@ -634,7 +663,28 @@ EmbedderSnapshotData::Pointer SnapshotData::AsEmbedderWrapper() const {
 }
 
 bool SnapshotData::FromFile(SnapshotData* out, FILE* in) {
-  return FromBlob(out, ReadFileSync(in));
+#if defined(__POSIX__) && !defined(__wasi__)
+  // Map the file so that the code cache of a built-in is only paged in when
+  // the built-in is compiled.
+  int fd = fileno(in);
+  struct stat st;
+  if (fd != -1 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+      st.st_size > 0) {
+    size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      std::shared_ptr<void> mapping(data,
+                                    [size](void* ptr) { munmap(ptr, size); });
+      return FromBlobWithoutCopy(
+          out,
+          std::string_view(static_cast<const char*>(data), size),
+          std::move(mapping));
+    }
+  }
+#endif
+  auto content = std::make_shared<std::vector<char>>(ReadFileSync(in));
+  std::string_view view(content->data(), content->size());
+  return FromBlobWithoutCopy(out, view, std::move(content));
 }
 
 bool SnapshotData::FromBlob(SnapshotData* out, const std::vector<char>& in) {
@@ -643,6 +693,18 @@ bool SnapshotData::FromBlob(SnapshotData* out, const std::vector<char>& in) {
 
 bool SnapshotData::FromBlob(SnapshotData* out, std::string_view in) {
   SnapshotDeserializer r(in);
+  return FromBlobImpl(out, &r);
+}
+
+bool SnapshotData::FromBlobWithoutCopy(SnapshotData* out,
+                                       std::string_view in,
+                                       std::shared_ptr<void> backing_store) {
+  SnapshotDeserializer r(in, std::move(backing_store));
+  return FromBlobImpl(out, &r);
+}
+
+bool SnapshotData::FromBlobImpl(SnapshotData* out, SnapshotDeserializer* d) {
+  SnapshotDeserializer& r = *d;
   r.Debug("SnapshotData::FromBlob()\n");
 
   DCHECK_EQ(out->data_ownership, SnapshotData::DataOwnership::kOwned);
@@ -944,9 +1006,11 @@ ExitCode BuildSnapshotWithoutCodeCache(
     const std::vector<std::string>& args,
     const std::vector<std::string>& exec_args,
     std::optional<std::string_view> builder_script_content,
-    const SnapshotConfig& config) {
+    const SnapshotConfig& config,
+    const SnapshotData* base) {
   DCHECK(builder_script_content.has_value() ==
          config.builder_script_path.has_value());
+  DCHECK_IMPLIES(base != nullptr, builder_script_content.has_value());
   // The default snapshot is meant to be runtime-independent and has more
   // restrictions. We do not enable the inspector and do not run the event
   // loop when building the default snapshot to avoid inconsistencies, but
@@ -958,8 +1022,17 @@ ExitCode BuildSnapshotWithoutCodeCache(
           : SnapshotMetadata::Type::kDefault;
 
   std::vector<std::string> errors;
-  auto setup = CommonEnvironmentSetup::CreateForSnapshotting(
-      per_process::v8_platform.Platform(), &errors, args, exec_args, config);
+  EmbedderSnapshotData::Pointer base_wrapper;
+  if (base != nullptr) {
+    base_wrapper = base->AsEmbedderWrapper();
+  }
+  auto setup = CommonEnvironmentSetup::CreateForSnapshottingFrom(
+      per_process::v8_platform.Platform(),
+      &errors,
+      base_wrapper.get(),
+      args,
+      exec_args,
+      config);
   if (!setup) {
     for (const std::string& err : errors)
       fprintf(stderr, "%s: %s\n", args[0].c_str(), err.c_str());
@@ -1053,9 +1126,10 @@ ExitCode SnapshotBuilder::Generate(
     const std::vector<std::string>& args,
     const std::vector<std::string>& exec_args,
     std::optional<std::string_view> builder_script_content,
-    const SnapshotConfig& snapshot_config) {
+    const SnapshotConfig& snapshot_config,
+    const SnapshotData* base) {
   ExitCode code = BuildSnapshotWithoutCodeCache(
-      out, args, exec_args, builder_script_content, snapshot_config);
+      out, args, exec_args, builder_script_content, snapshot_config, base);
   if (code != ExitCode::kNoFailure) {
     return code;
   }
@@ -1106,12 +1180,19 @@ ExitCode SnapshotBuilder::CreateSnapshot(SnapshotData* out,
     }
 
     // The Node.js-specific context with primodials, can be used by workers
+    // and ShadowRealms.
     // TODO(joyeecheung): investigate if this can be used by vm contexts
     // without breaking compatibility.
     Local<Context> base_context = NewContext(isolate);
     if (base_context.IsEmpty()) {
       return ExitCode::kBootstrapFailure;
     }
+    // Run the per-context scripts now so that the primordials are
+    // deserialized with the context instead of being recreated for every
+    // worker and ShadowRealm.
+    if (GetPerContextExports(base_context, setup->isolate_data()).IsEmpty()) {
+      return ExitCode::kBootstrapFailure;
+    }
     ResetContextSettingsBeforeSnapshot(base_context);
 
     {
@@ -1523,7 +1604,10 @@ void SetDeserializeCallback(const FunctionCallbackInfo<Value>& args) {
 
 void SetDeserializeMainFunction(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
-  CHECK(env->snapshot_deserialize_main().IsEmpty());
+  // When building on top of a base snapshot, the main function of the base
+  // can be replaced.
+  CHECK_IMPLIES(!env->snapshot_deserialize_main().IsEmpty(),
+                env->isolate_data()->snapshot_data() != nullptr);
   CHECK(args[0]->IsFunction());
   env->set_snapshot_deserialize_main(args[0].As<Function>());
 }
@@ -1555,9 +1639,9 @@ BindingData::BindingData(Realm* realm,
     is_building_snapshot_buffer_.Deserialize(realm->context());
   }
   // Reset the status according to the current state of the realm.
+  // This can be deserialized from a base snapshot while building a snapshot
+  // with --build-snapshot-base.
   bool is_building_snapshot = realm->isolate_data()->is_building_snapshot();
-  DCHECK_IMPLIES(is_building_snapshot,
-                 realm->isolate_data()->snapshot_data() == nullptr);
   is_building_snapshot_buffer_[0] = is_building_snapshot ? 1 : 0;
   is_building_snapshot_buffer_.MakeWeak();
 }
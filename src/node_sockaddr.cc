@@ -7,6 +7,8 @@
 #include "node_sockaddr-inl.h"  // NOLINT(build/include_inline)
 #include "uv.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -387,6 +389,282 @@ bool SocketAddress::is_in_network(
   return false;
 }
 
+SocketAddressRateLimiter::SocketAddressRateLimiter(double rate,
+                                                   double burst,
+                                                   size_t max_addresses)
+    : rate_(rate), burst_(burst), buckets_(max_addresses) {
+  CHECK_GT(rate, 0);
+  CHECK_GE(burst, 1);
+}
+
+bool SocketAddressRateLimiter::Consume(const SocketAddress& address) {
+  uint64_t now = uv_hrtime();
+  BucketTraits::Type* bucket = buckets_.Upsert(address);
+  if (bucket->updated_at == 0) {
+    bucket->tokens = burst_;
+  } else {
+    double elapsed = static_cast<double>(now - bucket->updated_at) / 1e9;
+    bucket->tokens = std::min(burst_, bucket->tokens + elapsed * rate_);
+  }
+  bucket->updated_at = now;
+
+  bool allowed = bucket->tokens >= 1;
+  if (allowed) bucket->tokens -= 1;
+  bucket->full_at =
+      now + static_cast<uint64_t>((burst_ - bucket->tokens) / rate_ * 1e9);
+  return allowed;
+}
+
+bool SocketAddressRateLimiter::BucketTraits::CheckExpired(
+    const SocketAddress& address, const Type& type) {
+  return uv_hrtime() >= type.full_at;
+}
+
+void SocketAddressRateLimiter::BucketTraits::Touch(
+    const SocketAddress& address, Type* type) {
+  // New entries are kept at least until Consume() has filled them in.
+  if (type->updated_at == 0)
+    type->full_at = std::numeric_limits<uint64_t>::max();
+}
+
+void SocketAddressRateLimiter::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("buckets", buckets_);
+}
+
+namespace {
+using IPv4Key = SocketAddressBlockList::PrefixTrie<4>::Key;
+using IPv6Key = SocketAddressBlockList::PrefixTrie<16>::Key;
+
+constexpr size_t kMappedPrefix = sizeof(mask) * 8;
+
+inline int GetBit(const uint8_t* key, size_t bit) {
+  return (key[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+IPv4Key ToIPv4Key(const SocketAddress& address) {
+  IPv4Key key;
+  const sockaddr_in* in = reinterpret_cast<const sockaddr_in*>(address.data());
+  memcpy(key.data(), &in->sin_addr, key.size());
+  return key;
+}
+
+IPv6Key ToIPv6Key(const SocketAddress& address) {
+  IPv6Key key;
+  const sockaddr_in6* in =
+      reinterpret_cast<const sockaddr_in6*>(address.data());
+  memcpy(key.data(), &in->sin6_addr, key.size());
+  return key;
+}
+
+// Returns the IPv4-mapped IPv6 address for an IPv4 address.
+IPv6Key ToMappedKey(const IPv4Key& ipv4) {
+  IPv6Key key;
+  memcpy(key.data(), mask, sizeof(mask));
+  memcpy(key.data() + sizeof(mask), ipv4.data(), ipv4.size());
+  return key;
+}
+
+// Returns whether the first |prefix| bits of |key| are within the
+// IPv4-mapped prefix, i.e. whether IPv4 addresses can match them.
+bool IsMappedPrefix(const IPv6Key& key, size_t prefix) {
+  size_t bits = std::min(prefix, kMappedPrefix);
+  for (size_t i = 0; i < bits; i++) {
+    if (GetBit(key.data(), i) != GetBit(mask, i)) return false;
+  }
+  return true;
+}
+
+IPv4Key MappedToIPv4Key(const IPv6Key& key) {
+  IPv4Key ipv4;
+  memcpy(ipv4.data(), key.data() + sizeof(mask), ipv4.size());
+  return ipv4;
+}
+
+template <size_t kBytes>
+std::array<uint8_t, kBytes> FillFrom(std::array<uint8_t, kBytes> key,
+                                     size_t depth,
+                                     int bit) {
+  for (size_t i = depth; i < kBytes * 8; i++) {
+    uint8_t m = 1 << (7 - i % 8);
+    key[i / 8] = static_cast<uint8_t>(bit ? key[i / 8] | m : key[i / 8] & ~m);
+  }
+  return key;
+}
+}  // namespace
+
+template <size_t kBytes>
+uint32_t SocketAddressBlockList::PrefixTrie<kBytes>::Child(uint32_t node,
+                                                           int bit) {
+  uint32_t child = nodes_[node].children[bit];
+  if (child == 0) {
+    child = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_[node].children[bit] = child;
+  }
+  return child;
+}
+
+template <size_t kBytes>
+void SocketAddressBlockList::PrefixTrie<kBytes>::Block(uint32_t node) {
+  // Everything below a blocked node is blocked as well. The nodes that are
+  // cut off stay allocated until the trie is cleared.
+  nodes_[node].blocked = true;
+  nodes_[node].children[0] = nodes_[node].children[1] = 0;
+}
+
+template <size_t kBytes>
+void SocketAddressBlockList::PrefixTrie<kBytes>::Insert(const Key& key,
+                                                        size_t prefix) {
+  CHECK_LE(prefix, kBits);
+  uint32_t node = 0;
+  for (size_t depth = 0; depth < prefix; depth++) {
+    if (nodes_[node].blocked) return;
+    node = Child(node, GetBit(key.data(), depth));
+  }
+  Block(node);
+}
+
+template <size_t kBytes>
+void SocketAddressBlockList::PrefixTrie<kBytes>::InsertRange(
+    const Key& start, const Key& end) {
+  if (end < start) return;
+  Key prefix{};
+  if (start == prefix && end == FillFrom(prefix, 0, 1)) {
+    Block(0);
+    return;
+  }
+  InsertRange(0, 0, &prefix, start, end);
+}
+
+template <size_t kBytes>
+void SocketAddressBlockList::PrefixTrie<kBytes>::InsertRange(
+    uint32_t node,
+    size_t depth,
+    Key* prefix,
+    const Key& start,
+    const Key& end) {
+  // The range overlaps with the addresses below |node| without covering all
+  // of them, so depth < kBits.
+  if (nodes_[node].blocked) return;
+  for (int bit = 0; bit < 2; bit++) {
+    Key low = FillFrom(*prefix, depth, 0);
+    if (bit) low[depth / 8] |= 1 << (7 - depth % 8);
+    Key high = FillFrom(low, depth + 1, 1);
+    if (high < start || end < low) continue;
+    uint32_t child = Child(node, bit);
+    if (!(low < start) && !(end < high)) {
+      Block(child);
+      continue;
+    }
+    InsertRange(child, depth + 1, &low, start, end);
+  }
+}
+
+template <size_t kBytes>
+bool SocketAddressBlockList::PrefixTrie<kBytes>::Contains(
+    const Key& key) const {
+  uint32_t node = 0;
+  for (size_t depth = 0;; depth++) {
+    if (nodes_[node].blocked) return true;
+    if (depth == kBits) return false;
+    node = nodes_[node].children[GetBit(key.data(), depth)];
+    if (node == 0) return false;
+  }
+}
+
+template <size_t kBytes>
+void SocketAddressBlockList::PrefixTrie<kBytes>::Clear() {
+  nodes_.clear();
+  nodes_.emplace_back();
+}
+
+template class SocketAddressBlockList::PrefixTrie<4>;
+template class SocketAddressBlockList::PrefixTrie<16>;
+
+void SocketAddressBlockList::CompiledRules::AddAddress(
+    const SocketAddress& address) {
+  switch (address.family()) {
+    case AF_INET: {
+      IPv4Key key = ToIPv4Key(address);
+      ipv4.Insert(key, 32);
+      ipv6.Insert(ToMappedKey(key), 128);
+      break;
+    }
+    case AF_INET6: {
+      IPv6Key key = ToIPv6Key(address);
+      ipv6.Insert(key, 128);
+      if (IsMappedPrefix(key, 128)) ipv4.Insert(MappedToIPv4Key(key), 32);
+      break;
+    }
+  }
+}
+
+void SocketAddressBlockList::CompiledRules::AddMask(
+    const SocketAddress& network, int prefix) {
+  size_t bits = static_cast<size_t>(prefix);
+  switch (network.family()) {
+    case AF_INET: {
+      IPv4Key key = ToIPv4Key(network);
+      ipv4.Insert(key, bits);
+      ipv6.Insert(ToMappedKey(key), kMappedPrefix + bits);
+      break;
+    }
+    case AF_INET6: {
+      IPv6Key key = ToIPv6Key(network);
+      ipv6.Insert(key, bits);
+      if (IsMappedPrefix(key, bits)) {
+        ipv4.Insert(MappedToIPv4Key(key),
+                    bits > kMappedPrefix ? bits - kMappedPrefix : 0);
+      }
+      break;
+    }
+  }
+}
+
+void SocketAddressBlockList::CompiledRules::AddRange(
+    const SocketAddress& start, const SocketAddress& end) {
+  // Addresses of different families are only ordered relative to each other
+  // when the IPv6 address is IPv4-mapped, see compare_ipv4_ipv6().
+  bool start_is_ipv4 = start.family() == AF_INET;
+  bool end_is_ipv4 = end.family() == AF_INET;
+  IPv6Key start_key =
+      start_is_ipv4 ? ToMappedKey(ToIPv4Key(start)) : ToIPv6Key(start);
+  IPv6Key end_key = end_is_ipv4 ? ToMappedKey(ToIPv4Key(end)) : ToIPv6Key(end);
+
+  // IPv4 addresses can only be within the range if both ends are ordered
+  // relative to them.
+  if ((start_is_ipv4 || IsMappedPrefix(start_key, 128)) &&
+      (end_is_ipv4 || IsMappedPrefix(end_key, 128))) {
+    ipv4.InsertRange(MappedToIPv4Key(start_key), MappedToIPv4Key(end_key));
+  }
+
+  // IPv6 addresses that are compared to an IPv4 end of the range have to be
+  // IPv4-mapped.
+  if (start_is_ipv4 || end_is_ipv4) {
+    IPv6Key mapped_low = ToMappedKey(IPv4Key{});
+    IPv6Key mapped_high = ToMappedKey(IPv4Key{0xff, 0xff, 0xff, 0xff});
+    start_key = std::max(start_key, mapped_low);
+    end_key = std::min(end_key, mapped_high);
+  }
+  ipv6.InsertRange(start_key, end_key);
+}
+
+bool SocketAddressBlockList::CompiledRules::Contains(
+    const SocketAddress& address) const {
+  switch (address.family()) {
+    case AF_INET:
+      return ipv4.Contains(ToIPv4Key(address));
+    case AF_INET6:
+      return ipv6.Contains(ToIPv6Key(address));
+  }
+  return false;
+}
+
+void SocketAddressBlockList::CompiledRules::Clear() {
+  ipv4.Clear();
+  ipv6.Clear();
+}
+
 SocketAddressBlockList::SocketAddressBlockList(
     std::shared_ptr<SocketAddressBlockList> parent)
     : parent_(parent) {}
@@ -396,6 +674,7 @@ void SocketAddressBlockList::AddSocketAddress(
   Mutex::ScopedLock lock(mutex_);
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressRule>(address);
+  rule->Compile(&compiled_);
   rules_.emplace_front(std::move(rule));
   address_rules_[*address.get()] = rules_.begin();
 }
@@ -407,6 +686,7 @@ void SocketAddressBlockList::RemoveSocketAddress(
   if (it != std::end(address_rules_)) {
     rules_.erase(it->second);
     address_rules_.erase(it);
+    compiled_dirty_ = true;
   }
 }
 
@@ -416,6 +696,7 @@ void SocketAddressBlockList::AddSocketAddressRange(
   Mutex::ScopedLock lock(mutex_);
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressRangeRule>(start, end);
+  rule->Compile(&compiled_);
   rules_.emplace_front(std::move(rule));
 }
 
@@ -425,16 +706,20 @@ void SocketAddressBlockList::AddSocketAddressMask(
   Mutex::ScopedLock lock(mutex_);
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressMaskRule>(network, prefix);
+  rule->Compile(&compiled_);
   rules_.emplace_front(std::move(rule));
 }
 
 bool SocketAddressBlockList::Apply(
     const std::shared_ptr<SocketAddress>& address) {
   Mutex::ScopedLock lock(mutex_);
-  for (const auto& rule : rules_) {
-    if (rule->Apply(address))
-      return true;
+  if (compiled_dirty_) {
+    compiled_.Clear();
+    for (const auto& rule : rules_) rule->Compile(&compiled_);
+    compiled_dirty_ = false;
   }
+  if (compiled_.Contains(*address.get()))
+    return true;
   return parent_ ? parent_->Apply(address) : false;
 }
 
@@ -459,6 +744,11 @@ bool SocketAddressBlockList::SocketAddressRule::Apply(
   return this->address->is_match(*address.get());
 }
 
+void SocketAddressBlockList::SocketAddressRule::Compile(
+    CompiledRules* compiled) const {
+  compiled->AddAddress(*address.get());
+}
+
 std::string SocketAddressBlockList::SocketAddressRule::ToString() {
   std::string ret = "Address: ";
   ret += address->family() == AF_INET ? "IPv4" : "IPv6";
@@ -473,6 +763,11 @@ bool SocketAddressBlockList::SocketAddressRangeRule::Apply(
          *address.get() <= *end.get();
 }
 
+void SocketAddressBlockList::SocketAddressRangeRule::Compile(
+    CompiledRules* compiled) const {
+  compiled->AddRange(*start.get(), *end.get());
+}
+
 std::string SocketAddressBlockList::SocketAddressRangeRule::ToString() {
   std::string ret = "Range: ";
   ret += start->family() == AF_INET ? "IPv4" : "IPv6";
@@ -488,6 +783,11 @@ bool SocketAddressBlockList::SocketAddressMaskRule::Apply(
   return address->is_in_network(*network.get(), prefix);
 }
 
+void SocketAddressBlockList::SocketAddressMaskRule::Compile(
+    CompiledRules* compiled) const {
+  compiled->AddMask(*network.get(), prefix);
+}
+
 std::string SocketAddressBlockList::SocketAddressMaskRule::ToString() {
   std::string ret = "Subnet: ";
   ret += network->family() == AF_INET ? "IPv4" : "IPv6";
@@ -520,6 +820,9 @@ bool SocketAddressBlockList::ListRules(Environment* env,
 
 void SocketAddressBlockList::MemoryInfo(node::MemoryTracker* tracker) const {
   tracker->TrackField("rules", rules_);
+  tracker->TrackFieldWithSize(
+      "compiled_rules",
+      compiled_.ipv4.memory_size() + compiled_.ipv6.memory_size());
 }
 
 void SocketAddressBlockList::SocketAddressRule::MemoryInfo(
@@ -11,11 +11,13 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <array>
 #include <compare>
 #include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace node {
 
@@ -232,6 +234,45 @@ class SocketAddressLRU : public MemoryRetainer {
   size_t max_size_;
 };
 
+// A SocketAddressRateLimiter keeps a token bucket for every address it has
+// seen, e.g. to limit how many connections a server accepts from each
+// remote address. Memory is bounded by evicting the least recently used
+// addresses once there are more than |max_addresses|, and by dropping
+// addresses whose bucket has refilled completely.
+class SocketAddressRateLimiter final : public MemoryRetainer {
+ public:
+  // |rate| tokens are added to each bucket per second, up to |burst| tokens.
+  SocketAddressRateLimiter(double rate, double burst, size_t max_addresses);
+
+  // Takes a token from the bucket of |address|. Returns false if the bucket
+  // is empty.
+  bool Consume(const SocketAddress& address);
+
+  size_t size() const { return buckets_.size(); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SocketAddressRateLimiter)
+  SET_SELF_SIZE(SocketAddressRateLimiter)
+
+ private:
+  struct BucketTraits final {
+    struct Type final {
+      double tokens;
+      uint64_t updated_at;
+      // The time at which the bucket is full again. Dropping the entry from
+      // then on does not change the outcome of later checks.
+      uint64_t full_at;
+    };
+
+    static bool CheckExpired(const SocketAddress& address, const Type& type);
+    static void Touch(const SocketAddress& address, Type* type);
+  };
+
+  double rate_;
+  double burst_;
+  SocketAddressLRU<BucketTraits> buckets_;
+};
+
 // A BlockList is used to evaluate whether a given
 // SocketAddress should be accepted for inbound or
 // outbound network activity.
@@ -259,8 +300,61 @@ class SocketAddressBlockList : public MemoryRetainer {
 
   v8::MaybeLocal<v8::Array> ListRules(Environment* env);
 
+  // A binary trie over the first kBytes bytes of addresses. Every prefix that
+  // has been inserted is marked as blocked, so a lookup takes at most as many
+  // steps as the address has bits, regardless of the number of rules.
+  template <size_t kBytes>
+  class PrefixTrie final {
+   public:
+    using Key = std::array<uint8_t, kBytes>;
+    static constexpr size_t kBits = kBytes * 8;
+
+    // Blocks all addresses that start with the first |prefix| bits of |key|.
+    void Insert(const Key& key, size_t prefix);
+    // Blocks all addresses in [start, end], which is split into the smallest
+    // set of prefixes covering it.
+    void InsertRange(const Key& start, const Key& end);
+    bool Contains(const Key& key) const;
+    void Clear();
+
+    size_t memory_size() const { return nodes_.capacity() * sizeof(Node); }
+
+   private:
+    struct Node {
+      // Index 0 is the root, which is never a child, so 0 means no child.
+      uint32_t children[2] = {0, 0};
+      bool blocked = false;
+    };
+
+    uint32_t Child(uint32_t node, int bit);
+    void Block(uint32_t node);
+    void InsertRange(uint32_t node,
+                     size_t depth,
+                     Key* prefix,
+                     const Key& start,
+                     const Key& end);
+
+    std::vector<Node> nodes_ = std::vector<Node>(1);
+  };
+
+  // The rules of the list compiled into tries. IPv4 addresses are looked up
+  // in ipv4, IPv6 addresses in ipv6, where IPv4 rules cover the matching
+  // IPv4-mapped IPv6 addresses, the same way Rule::Apply() compares
+  // addresses of different families.
+  struct CompiledRules {
+    PrefixTrie<4> ipv4;
+    PrefixTrie<16> ipv6;
+
+    void AddAddress(const SocketAddress& address);
+    void AddRange(const SocketAddress& start, const SocketAddress& end);
+    void AddMask(const SocketAddress& network, int prefix);
+    bool Contains(const SocketAddress& address) const;
+    void Clear();
+  };
+
   struct Rule : public MemoryRetainer {
     virtual bool Apply(const std::shared_ptr<SocketAddress>& address) = 0;
+    virtual void Compile(CompiledRules* compiled) const = 0;
     inline v8::MaybeLocal<v8::Value> ToV8String(Environment* env);
     virtual std::string ToString() = 0;
   };
@@ -271,6 +365,7 @@ class SocketAddressBlockList : public MemoryRetainer {
     explicit SocketAddressRule(const std::shared_ptr<SocketAddress>& address);
 
     bool Apply(const std::shared_ptr<SocketAddress>& address) override;
+    void Compile(CompiledRules* compiled) const override;
     std::string ToString() override;
 
     void MemoryInfo(node::MemoryTracker* tracker) const override;
@@ -287,6 +382,7 @@ class SocketAddressBlockList : public MemoryRetainer {
         const std::shared_ptr<SocketAddress>& end);
 
     bool Apply(const std::shared_ptr<SocketAddress>& address) override;
+    void Compile(CompiledRules* compiled) const override;
     std::string ToString() override;
 
     void MemoryInfo(node::MemoryTracker* tracker) const override;
@@ -303,6 +399,7 @@ class SocketAddressBlockList : public MemoryRetainer {
         int prefix);
 
     bool Apply(const std::shared_ptr<SocketAddress>& address) override;
+    void Compile(CompiledRules* compiled) const override;
     std::string ToString() override;
 
     void MemoryInfo(node::MemoryTracker* tracker) const override;
@@ -320,6 +417,10 @@ class SocketAddressBlockList : public MemoryRetainer {
   std::shared_ptr<SocketAddressBlockList> parent_;
   std::list<std::unique_ptr<Rule>> rules_;
   SocketAddress::Map<std::list<std::unique_ptr<Rule>>::iterator> address_rules_;
+  // Added rules are compiled right away. Removing a rule requires the tries
+  // to be rebuilt, which happens on the next Apply().
+  CompiledRules compiled_;
+  bool compiled_dirty_ = false;
 
   Mutex mutex_;
 };
@@ -6,13 +6,17 @@
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_errors.h"
+#include "node_internals.h"
 #include "node_mem-inl.h"
 #include "node_url.h"
 #include "sqlite3.h"
 #include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <variant>
 
 namespace node {
 namespace sqlite {
@@ -21,11 +25,13 @@ using v8::Array;
 using v8::ArrayBuffer;
 using v8::BackingStoreInitializationMode;
 using v8::BigInt;
+using v8::BigInt64Array;
 using v8::Boolean;
 using v8::ConstructorBehavior;
 using v8::Context;
 using v8::DontDelete;
 using v8::Exception;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallback;
 using v8::FunctionCallbackInfo;
@@ -47,7 +53,10 @@ using v8::Promise;
 using v8::SideEffectType;
 using v8::String;
 using v8::TryCatch;
+using v8::TypedArray;
+using v8::Uint32;
 using v8::Uint8Array;
+using v8::Undefined;
 using v8::Value;
 
 #define CHECK_ERROR_OR_THROW(isolate, db, expr, expected, ret)                 \
@@ -171,6 +180,24 @@ inline MaybeLocal<Object> CreateSQLiteError(Isolate* isolate, sqlite3* db) {
   return e;
 }
 
+inline MaybeLocal<Object> CreateSQLiteError(Isolate* isolate,
+                                            const SQLiteError& error) {
+  const char* errstr = sqlite3_errstr(error.errcode);
+  Local<String> js_errmsg;
+  Local<Object> e;
+  Environment* env = Environment::GetCurrent(isolate);
+  if (!String::NewFromUtf8(isolate, errstr).ToLocal(&js_errmsg) ||
+      !CreateSQLiteError(isolate, error.message.c_str()).ToLocal(&e) ||
+      e->Set(env->context(),
+             env->errcode_string(),
+             Integer::New(isolate, error.errcode))
+          .IsNothing() ||
+      e->Set(env->context(), env->errstr_string(), js_errmsg).IsNothing()) {
+    return MaybeLocal<Object>();
+  }
+  return e;
+}
+
 void JSValueToSQLiteResult(Isolate* isolate,
                            sqlite3_context* ctx,
                            Local<Value> value) {
@@ -700,44 +727,81 @@ void DatabaseSync::MemoryInfo(MemoryTracker* tracker) const {
       "open_config", sizeof(open_config_), "DatabaseOpenConfiguration");
 }
 
-bool DatabaseSync::Open() {
-  if (IsOpen()) {
-    THROW_ERR_INVALID_STATE(env(), "database is already open");
-    return false;
-  }
-
+// Opens and configures a connection. The connection is also set when an
+// error is returned, so that the error can be read from it.
+static int OpenConnection(const DatabaseOpenConfiguration& open_config,
+                          sqlite3** connection) {
   // TODO(cjihrig): Support additional flags.
   int default_flags = SQLITE_OPEN_URI;
-  int flags = open_config_.get_read_only()
+  int flags = open_config.get_read_only()
                   ? SQLITE_OPEN_READONLY
                   : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
-  int r = sqlite3_open_v2(open_config_.location().c_str(),
-                          &connection_,
+  if (open_config.get_shared_cache()) {
+    flags |= SQLITE_OPEN_SHAREDCACHE;
+  }
+  int r = sqlite3_open_v2(open_config.location().c_str(),
+                          connection,
                           flags | default_flags,
                           nullptr);
-  CHECK_ERROR_OR_THROW(env()->isolate(), this, r, SQLITE_OK, false);
+  if (r != SQLITE_OK) return r;
 
-  r = sqlite3_db_config(connection_,
+  r = sqlite3_db_config(*connection,
                         SQLITE_DBCONFIG_DQS_DML,
-                        static_cast<int>(open_config_.get_enable_dqs()),
+                        static_cast<int>(open_config.get_enable_dqs()),
                         nullptr);
-  CHECK_ERROR_OR_THROW(env()->isolate(), this, r, SQLITE_OK, false);
-  r = sqlite3_db_config(connection_,
+  if (r != SQLITE_OK) return r;
+  r = sqlite3_db_config(*connection,
                         SQLITE_DBCONFIG_DQS_DDL,
-                        static_cast<int>(open_config_.get_enable_dqs()),
+                        static_cast<int>(open_config.get_enable_dqs()),
                         nullptr);
-  CHECK_ERROR_OR_THROW(env()->isolate(), this, r, SQLITE_OK, false);
+  if (r != SQLITE_OK) return r;
 
   int foreign_keys_enabled;
-  r = sqlite3_db_config(
-      connection_,
-      SQLITE_DBCONFIG_ENABLE_FKEY,
-      static_cast<int>(open_config_.get_enable_foreign_keys()),
-      &foreign_keys_enabled);
-  CHECK_ERROR_OR_THROW(env()->isolate(), this, r, SQLITE_OK, false);
-  CHECK_EQ(foreign_keys_enabled, open_config_.get_enable_foreign_keys());
+  r = sqlite3_db_config(*connection,
+                        SQLITE_DBCONFIG_ENABLE_FKEY,
+                        static_cast<int>(open_config.get_enable_foreign_keys()),
+                        &foreign_keys_enabled);
+  if (r != SQLITE_OK) return r;
+  CHECK_EQ(foreign_keys_enabled, open_config.get_enable_foreign_keys());
+
+  sqlite3_busy_timeout(*connection, open_config.get_timeout());
+
+  std::string pragmas;
+  if (open_config.get_mmap_size().has_value()) {
+    pragmas += "PRAGMA mmap_size = " +
+               std::to_string(open_config.get_mmap_size().value()) + ";";
+  }
+  if (open_config.get_cache_size().has_value()) {
+    pragmas += "PRAGMA cache_size = " +
+               std::to_string(open_config.get_cache_size().value()) + ";";
+  }
+  // The journal mode has been validated, and can be part of the SQL.
+  if (open_config.get_journal_mode().has_value()) {
+    pragmas +=
+        "PRAGMA journal_mode = " + open_config.get_journal_mode().value() + ";";
+  }
+  if (!pragmas.empty()) {
+    r = sqlite3_exec(*connection, pragmas.c_str(), nullptr, nullptr, nullptr);
+    if (r != SQLITE_OK) return r;
+  }
+
+  if (open_config.get_wal_autocheckpoint().has_value()) {
+    r = sqlite3_wal_autocheckpoint(
+        *connection, open_config.get_wal_autocheckpoint().value());
+    if (r != SQLITE_OK) return r;
+  }
+
+  return SQLITE_OK;
+}
+
+bool DatabaseSync::Open() {
+  if (IsOpen()) {
+    THROW_ERR_INVALID_STATE(env(), "database is already open");
+    return false;
+  }
 
-  sqlite3_busy_timeout(connection_, open_config_.get_timeout());
+  int r = OpenConnection(open_config_, &connection_);
+  CHECK_ERROR_OR_THROW(env()->isolate(), this, r, SQLITE_OK, false);
 
   if (allow_load_extension_) {
     if (env()->permission()->enabled()) [[unlikely]] {
@@ -764,6 +828,9 @@ void DatabaseSync::FinalizeBackups() {
 }
 
 void DatabaseSync::FinalizeStatements() {
+  statement_cache_index_.clear();
+  statement_cache_.clear();
+
   for (auto stmt : statements_) {
     stmt->Finalize();
   }
@@ -841,103 +908,97 @@ std::optional<std::string> ValidateDatabasePath(Environment* env,
   return std::nullopt;
 }
 
-void DatabaseSync::New(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  if (!args.IsConstructCall()) {
-    THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
-    return;
-  }
-
-  std::optional<std::string> location =
-      ValidateDatabasePath(env, args[0], "path");
-  if (!location.has_value()) {
-    return;
+// Reads the options of a database into open_config. The open and
+// allowExtension options are only read when open and allow_load_extension are
+// not nullptr.
+static bool ParseOpenOptions(Environment* env,
+                             Local<Value> options_v,
+                             DatabaseOpenConfiguration* open_config,
+                             bool* open,
+                             bool* allow_load_extension) {
+  if (!options_v->IsObject()) {
+    THROW_ERR_INVALID_ARG_TYPE(env->isolate(),
+                               "The \"options\" argument must be an object.");
+    return false;
   }
 
-  DatabaseOpenConfiguration open_config(std::move(location.value()));
-  bool open = true;
-  bool allow_load_extension = false;
-  if (args.Length() > 1) {
-    if (!args[1]->IsObject()) {
-      THROW_ERR_INVALID_ARG_TYPE(env->isolate(),
-                                 "The \"options\" argument must be an object.");
-      return;
-    }
-
-    Local<Object> options = args[1].As<Object>();
+  Local<Object> options = options_v.As<Object>();
+  if (open != nullptr) {
     Local<String> open_string = FIXED_ONE_BYTE_STRING(env->isolate(), "open");
     Local<Value> open_v;
     if (!options->Get(env->context(), open_string).ToLocal(&open_v)) {
-      return;
+      return false;
     }
     if (!open_v->IsUndefined()) {
       if (!open_v->IsBoolean()) {
         THROW_ERR_INVALID_ARG_TYPE(
             env->isolate(), "The \"options.open\" argument must be a boolean.");
-        return;
+        return false;
       }
-      open = open_v.As<Boolean>()->Value();
+      *open = open_v.As<Boolean>()->Value();
     }
+  }
 
-    Local<String> read_only_string =
-        FIXED_ONE_BYTE_STRING(env->isolate(), "readOnly");
-    Local<Value> read_only_v;
-    if (!options->Get(env->context(), read_only_string).ToLocal(&read_only_v)) {
-      return;
-    }
-    if (!read_only_v->IsUndefined()) {
-      if (!read_only_v->IsBoolean()) {
-        THROW_ERR_INVALID_ARG_TYPE(
-            env->isolate(),
-            "The \"options.readOnly\" argument must be a boolean.");
-        return;
-      }
-      open_config.set_read_only(read_only_v.As<Boolean>()->Value());
+  Local<String> read_only_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "readOnly");
+  Local<Value> read_only_v;
+  if (!options->Get(env->context(), read_only_string).ToLocal(&read_only_v)) {
+    return false;
+  }
+  if (!read_only_v->IsUndefined()) {
+    if (!read_only_v->IsBoolean()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.readOnly\" argument must be a boolean.");
+      return false;
     }
+    open_config->set_read_only(read_only_v.As<Boolean>()->Value());
+  }
 
-    Local<String> enable_foreign_keys_string =
-        FIXED_ONE_BYTE_STRING(env->isolate(), "enableForeignKeyConstraints");
-    Local<Value> enable_foreign_keys_v;
-    if (!options->Get(env->context(), enable_foreign_keys_string)
-             .ToLocal(&enable_foreign_keys_v)) {
-      return;
-    }
-    if (!enable_foreign_keys_v->IsUndefined()) {
-      if (!enable_foreign_keys_v->IsBoolean()) {
-        THROW_ERR_INVALID_ARG_TYPE(
-            env->isolate(),
-            "The \"options.enableForeignKeyConstraints\" argument must be a "
-            "boolean.");
-        return;
-      }
-      open_config.set_enable_foreign_keys(
-          enable_foreign_keys_v.As<Boolean>()->Value());
+  Local<String> enable_foreign_keys_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "enableForeignKeyConstraints");
+  Local<Value> enable_foreign_keys_v;
+  if (!options->Get(env->context(), enable_foreign_keys_string)
+           .ToLocal(&enable_foreign_keys_v)) {
+    return false;
+  }
+  if (!enable_foreign_keys_v->IsUndefined()) {
+    if (!enable_foreign_keys_v->IsBoolean()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.enableForeignKeyConstraints\" argument must be a "
+          "boolean.");
+      return false;
     }
+    open_config->set_enable_foreign_keys(
+        enable_foreign_keys_v.As<Boolean>()->Value());
+  }
 
-    Local<String> enable_dqs_string = FIXED_ONE_BYTE_STRING(
-        env->isolate(), "enableDoubleQuotedStringLiterals");
-    Local<Value> enable_dqs_v;
-    if (!options->Get(env->context(), enable_dqs_string)
-             .ToLocal(&enable_dqs_v)) {
-      return;
-    }
-    if (!enable_dqs_v->IsUndefined()) {
-      if (!enable_dqs_v->IsBoolean()) {
-        THROW_ERR_INVALID_ARG_TYPE(
-            env->isolate(),
-            "The \"options.enableDoubleQuotedStringLiterals\" argument must be "
-            "a boolean.");
-        return;
-      }
-      open_config.set_enable_dqs(enable_dqs_v.As<Boolean>()->Value());
+  Local<String> enable_dqs_string = FIXED_ONE_BYTE_STRING(
+      env->isolate(), "enableDoubleQuotedStringLiterals");
+  Local<Value> enable_dqs_v;
+  if (!options->Get(env->context(), enable_dqs_string)
+           .ToLocal(&enable_dqs_v)) {
+    return false;
+  }
+  if (!enable_dqs_v->IsUndefined()) {
+    if (!enable_dqs_v->IsBoolean()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.enableDoubleQuotedStringLiterals\" argument must be "
+          "a boolean.");
+      return false;
     }
+    open_config->set_enable_dqs(enable_dqs_v.As<Boolean>()->Value());
+  }
 
+  if (allow_load_extension != nullptr) {
     Local<String> allow_extension_string =
         FIXED_ONE_BYTE_STRING(env->isolate(), "allowExtension");
     Local<Value> allow_extension_v;
     if (!options->Get(env->context(), allow_extension_string)
              .ToLocal(&allow_extension_v)) {
-      return;
+      return false;
     }
 
     if (!allow_extension_v->IsUndefined()) {
@@ -945,26 +1006,174 @@ void DatabaseSync::New(const FunctionCallbackInfo<Value>& args) {
         THROW_ERR_INVALID_ARG_TYPE(
             env->isolate(),
             "The \"options.allowExtension\" argument must be a boolean.");
-        return;
+        return false;
       }
-      allow_load_extension = allow_extension_v.As<Boolean>()->Value();
+      *allow_load_extension = allow_extension_v.As<Boolean>()->Value();
+    }
+  }
+
+  Local<Value> timeout_v;
+  if (!options->Get(env->context(), env->timeout_string())
+           .ToLocal(&timeout_v)) {
+    return false;
+  }
+
+  if (!timeout_v->IsUndefined()) {
+    if (!timeout_v->IsInt32()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.timeout\" argument must be an integer.");
+      return false;
+    }
+
+    open_config->set_timeout(timeout_v.As<Int32>()->Value());
+  }
+
+  Local<String> shared_cache_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "sharedCache");
+  Local<Value> shared_cache_v;
+  if (!options->Get(env->context(), shared_cache_string)
+           .ToLocal(&shared_cache_v)) {
+    return false;
+  }
+  if (!shared_cache_v->IsUndefined()) {
+    if (!shared_cache_v->IsBoolean()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.sharedCache\" argument must be a boolean.");
+      return false;
     }
+    open_config->set_shared_cache(shared_cache_v.As<Boolean>()->Value());
+  }
+
+  Local<String> mmap_size_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "mmapSize");
+  Local<Value> mmap_size_v;
+  if (!options->Get(env->context(), mmap_size_string).ToLocal(&mmap_size_v)) {
+    return false;
+  }
+  if (!mmap_size_v->IsUndefined()) {
+    double mmap_size =
+        mmap_size_v->IsNumber() ? mmap_size_v.As<Number>()->Value() : -1;
+    if (!(mmap_size >= 0 && mmap_size <= kMaxSafeJsInteger) ||
+        std::trunc(mmap_size) != mmap_size) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.mmapSize\" argument must be a non-negative "
+          "integer.");
+      return false;
+    }
+    open_config->set_mmap_size(static_cast<int64_t>(mmap_size));
+  }
+
+  Local<String> cache_size_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "cacheSize");
+  Local<Value> cache_size_v;
+  if (!options->Get(env->context(), cache_size_string)
+           .ToLocal(&cache_size_v)) {
+    return false;
+  }
+  if (!cache_size_v->IsUndefined()) {
+    if (!cache_size_v->IsInt32()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.cacheSize\" argument must be an integer.");
+      return false;
+    }
+    open_config->set_cache_size(cache_size_v.As<Int32>()->Value());
+  }
+
+  Local<String> journal_mode_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "journalMode");
+  Local<Value> journal_mode_v;
+  if (!options->Get(env->context(), journal_mode_string)
+           .ToLocal(&journal_mode_v)) {
+    return false;
+  }
+  if (!journal_mode_v->IsUndefined()) {
+    if (!journal_mode_v->IsString()) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.journalMode\" argument must be a string.");
+      return false;
+    }
+    static constexpr std::string_view kJournalModes[] = {
+        "delete", "truncate", "persist", "memory", "wal", "off"};
+    Utf8Value journal_mode(env->isolate(), journal_mode_v);
+    if (std::find(std::begin(kJournalModes),
+                  std::end(kJournalModes),
+                  journal_mode.ToStringView()) == std::end(kJournalModes)) {
+      THROW_ERR_INVALID_ARG_VALUE(
+          env->isolate(),
+          "The \"options.journalMode\" argument must be one of 'delete', "
+          "'truncate', 'persist', 'memory', 'wal', or 'off'.");
+      return false;
+    }
+    open_config->set_journal_mode(journal_mode.ToString());
+  }
+
+  Local<String> wal_autocheckpoint_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "walAutoCheckpoint");
+  Local<Value> wal_autocheckpoint_v;
+  if (!options->Get(env->context(), wal_autocheckpoint_string)
+           .ToLocal(&wal_autocheckpoint_v)) {
+    return false;
+  }
+  if (!wal_autocheckpoint_v->IsUndefined()) {
+    if (!wal_autocheckpoint_v->IsInt32() ||
+        wal_autocheckpoint_v.As<Int32>()->Value() < 0) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env->isolate(),
+          "The \"options.walAutoCheckpoint\" argument must be a "
+          "non-negative integer.");
+      return false;
+    }
+    open_config->set_wal_autocheckpoint(
+        wal_autocheckpoint_v.As<Int32>()->Value());
+  }
+
+  return true;
+}
+
+void DatabaseSync::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (!args.IsConstructCall()) {
+    THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+    return;
+  }
+
+  std::optional<std::string> location =
+      ValidateDatabasePath(env, args[0], "path");
+  if (!location.has_value()) {
+    return;
+  }
 
-    Local<Value> timeout_v;
-    if (!options->Get(env->context(), env->timeout_string())
-             .ToLocal(&timeout_v)) {
+  DatabaseOpenConfiguration open_config(std::move(location.value()));
+  bool open = true;
+  bool allow_load_extension = false;
+  if (args.Length() > 1) {
+    if (!ParseOpenOptions(
+            env, args[1], &open_config, &open, &allow_load_extension)) {
       return;
     }
 
-    if (!timeout_v->IsUndefined()) {
-      if (!timeout_v->IsInt32()) {
+    Local<Value> cache_size_v;
+    if (!args[1]
+             .As<Object>()
+             ->Get(env->context(),
+                   FIXED_ONE_BYTE_STRING(env->isolate(), "statementCacheSize"))
+             .ToLocal(&cache_size_v)) {
+      return;
+    }
+    if (!cache_size_v->IsUndefined()) {
+      if (!cache_size_v->IsUint32()) {
         THROW_ERR_INVALID_ARG_TYPE(
             env->isolate(),
-            "The \"options.timeout\" argument must be an integer.");
+            "The \"options.statementCacheSize\" argument must be a "
+            "non-negative integer.");
         return;
       }
-
-      open_config.set_timeout(timeout_v.As<Int32>()->Value());
+      open_config.set_statement_cache_size(cache_size_v.As<Uint32>()->Value());
     }
   }
 
@@ -1026,6 +1235,25 @@ void DatabaseSync::Prepare(const FunctionCallbackInfo<Value>& args) {
   }
 
   Utf8Value sql(env->isolate(), args[0].As<String>());
+  size_t cache_size = db->open_config_.get_statement_cache_size();
+  if (cache_size > 0) {
+    auto it = db->statement_cache_index_.find(sql.ToStringView());
+    if (it != db->statement_cache_index_.end()) {
+      db->statement_cache_hits_++;
+      db->statement_cache_.splice(
+          db->statement_cache_.begin(), db->statement_cache_, it->second);
+      StatementSync* stmt = it->second->second.get();
+      // Hand the statement back as if it was just prepared.
+      if (!stmt->IsFinalized()) {
+        sqlite3_reset(stmt->statement_);
+        sqlite3_clear_bindings(stmt->statement_);
+      }
+      args.GetReturnValue().Set(stmt->object());
+      return;
+    }
+    db->statement_cache_misses_++;
+  }
+
   sqlite3_stmt* s = nullptr;
   int r = sqlite3_prepare_v2(db->connection_, *sql, -1, &s, 0);
   CHECK_ERROR_OR_THROW(env->isolate(), db, r, SQLITE_OK, void());
@@ -1033,6 +1261,37 @@ void DatabaseSync::Prepare(const FunctionCallbackInfo<Value>& args) {
       StatementSync::Create(env, BaseObjectPtr<DatabaseSync>(db), s);
   db->statements_.insert(stmt.get());
   args.GetReturnValue().Set(stmt->object());
+
+  if (cache_size > 0) {
+    db->statement_cache_.emplace_front(sql.ToString(), stmt);
+    db->statement_cache_index_.emplace(db->statement_cache_.front().first,
+                                       db->statement_cache_.begin());
+    if (db->statement_cache_.size() > cache_size) {
+      // The evicted statement remains usable by whoever still references it.
+      db->statement_cache_index_.erase(db->statement_cache_.back().first);
+      db->statement_cache_.pop_back();
+    }
+  }
+}
+
+void DatabaseSync::GetStatementCacheStatistics(
+    const FunctionCallbackInfo<Value>& args) {
+  DatabaseSync* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  Isolate* isolate = args.GetIsolate();
+  Local<Name> keys[] = {
+      FIXED_ONE_BYTE_STRING(isolate, "size"),
+      FIXED_ONE_BYTE_STRING(isolate, "hits"),
+      FIXED_ONE_BYTE_STRING(isolate, "misses"),
+  };
+  Local<Value> values[] = {
+      Number::New(isolate, static_cast<double>(db->statement_cache_.size())),
+      Number::New(isolate, static_cast<double>(db->statement_cache_hits_)),
+      Number::New(isolate, static_cast<double>(db->statement_cache_misses_)),
+  };
+  static_assert(arraysize(keys) == arraysize(values));
+  args.GetReturnValue().Set(Object::New(
+      isolate, Null(isolate), keys, values, arraysize(keys)));
 }
 
 void DatabaseSync::Exec(const FunctionCallbackInfo<Value>& args) {
@@ -1805,101 +2064,133 @@ bool StatementSync::BindParams(const FunctionCallbackInfo<Value>& args) {
   int anon_start = 0;
 
   if (args[0]->IsObject() && !args[0]->IsArrayBufferView()) {
-    Local<Object> obj = args[0].As<Object>();
-    Local<Context> context = obj->GetIsolate()->GetCurrentContext();
-    Local<Array> keys;
-    if (!obj->GetOwnPropertyNames(context).ToLocal(&keys)) {
+    if (!BindNamedParams(args[0].As<Object>())) {
       return false;
     }
+    anon_start++;
+  }
 
-    if (allow_bare_named_params_ && !bare_named_params_.has_value()) {
-      bare_named_params_.emplace();
-      int param_count = sqlite3_bind_parameter_count(statement_);
-      // Parameter indexing starts at one.
-      for (int i = 1; i <= param_count; ++i) {
-        const char* name = sqlite3_bind_parameter_name(statement_, i);
-        if (name == nullptr) {
-          continue;
-        }
-
-        auto bare_name = std::string(name + 1);
-        auto full_name = std::string(name);
-        auto insertion = bare_named_params_->insert({bare_name, full_name});
-        if (insertion.second == false) {
-          auto existing_full_name = (*insertion.first).second;
-          if (full_name != existing_full_name) {
-            THROW_ERR_INVALID_STATE(
-                env(),
-                "Cannot create bare named parameter '%s' because of "
-                "conflicting names '%s' and '%s'.",
-                bare_name,
-                existing_full_name,
-                full_name);
-            return false;
-          }
-        }
-      }
+  for (int i = anon_start; i < args.Length(); ++i) {
+    if (!BindAnonymousParam(args[i], &anon_idx)) {
+      return false;
     }
+  }
 
-    uint32_t len = keys->Length();
-    for (uint32_t j = 0; j < len; j++) {
-      Local<Value> key;
-      if (!keys->Get(context, j).ToLocal(&key)) {
-        return false;
-      }
-
-      Utf8Value utf8_key(env()->isolate(), key);
-      int r = sqlite3_bind_parameter_index(statement_, *utf8_key);
-      if (r == 0) {
-        if (allow_bare_named_params_) {
-          auto lookup = bare_named_params_->find(std::string(*utf8_key));
-          if (lookup != bare_named_params_->end()) {
-            r = sqlite3_bind_parameter_index(statement_,
-                                             lookup->second.c_str());
-          }
-        }
+  return true;
+}
 
-        if (r == 0) {
-          if (allow_unknown_named_params_) {
-            continue;
-          } else {
-            THROW_ERR_INVALID_STATE(
-                env(), "Unknown named parameter '%s'", *utf8_key);
-            return false;
-          }
-        }
-      }
+bool StatementSync::MaybeCollectBareNamedParams() {
+  if (!allow_bare_named_params_ || bare_named_params_.has_value()) {
+    return true;
+  }
 
-      Local<Value> value;
-      if (!obj->Get(context, key).ToLocal(&value)) {
-        return false;
-      }
+  bare_named_params_.emplace();
+  int param_count = sqlite3_bind_parameter_count(statement_);
+  // Parameter indexing starts at one.
+  for (int i = 1; i <= param_count; ++i) {
+    const char* name = sqlite3_bind_parameter_name(statement_, i);
+    if (name == nullptr) {
+      continue;
+    }
 
-      if (!BindValue(value, r)) {
+    auto bare_name = std::string(name + 1);
+    auto full_name = std::string(name);
+    auto insertion = bare_named_params_->insert({bare_name, full_name});
+    if (insertion.second == false) {
+      auto existing_full_name = (*insertion.first).second;
+      if (full_name != existing_full_name) {
+        THROW_ERR_INVALID_STATE(
+            env(),
+            "Cannot create bare named parameter '%s' because of "
+            "conflicting names '%s' and '%s'.",
+            bare_name,
+            existing_full_name,
+            full_name);
         return false;
       }
     }
-    anon_start++;
   }
 
-  for (int i = anon_start; i < args.Length(); ++i) {
-    while (sqlite3_bind_parameter_name(statement_, anon_idx) != nullptr) {
-      anon_idx++;
+  return true;
+}
+
+bool StatementSync::NamedParamIndex(Local<Value> key, int* index) {
+  Utf8Value utf8_key(env()->isolate(), key);
+  int r = sqlite3_bind_parameter_index(statement_, *utf8_key);
+  if (r == 0) {
+    if (allow_bare_named_params_) {
+      auto lookup = bare_named_params_->find(std::string(*utf8_key));
+      if (lookup != bare_named_params_->end()) {
+        r = sqlite3_bind_parameter_index(statement_, lookup->second.c_str());
+      }
     }
 
-    if (!BindValue(args[i], anon_idx)) {
+    if (r == 0 && !allow_unknown_named_params_) {
+      THROW_ERR_INVALID_STATE(env(), "Unknown named parameter '%s'", *utf8_key);
       return false;
     }
-
-    anon_idx++;
   }
 
+  *index = r;
   return true;
 }
 
-bool StatementSync::BindValue(const Local<Value>& value, const int index) {
-  // SQLite only supports a subset of JavaScript types. Some JS types such as
-  // functions don't make sense to support. Other JS types such as booleans and
+bool StatementSync::BindNamedParams(Local<Object> obj) {
+  Local<Context> context = obj->GetIsolate()->GetCurrentContext();
+  Local<Array> keys;
+  if (!obj->GetOwnPropertyNames(context).ToLocal(&keys)) {
+    return false;
+  }
+
+  if (!MaybeCollectBareNamedParams()) {
+    return false;
+  }
+
+  uint32_t len = keys->Length();
+  for (uint32_t j = 0; j < len; j++) {
+    Local<Value> key;
+    if (!keys->Get(context, j).ToLocal(&key)) {
+      return false;
+    }
+
+    int index;
+    if (!NamedParamIndex(key, &index)) {
+      return false;
+    }
+    if (index == 0) {
+      // Unknown named parameters are allowed.
+      continue;
+    }
+
+    Local<Value> value;
+    if (!obj->Get(context, key).ToLocal(&value)) {
+      return false;
+    }
+
+    if (!BindValue(value, index)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool StatementSync::BindAnonymousParam(const Local<Value>& value, int* index) {
+  while (sqlite3_bind_parameter_name(statement_, *index) != nullptr) {
+    (*index)++;
+  }
+
+  if (!BindValue(value, *index)) {
+    return false;
+  }
+
+  (*index)++;
+  return true;
+}
+
+bool StatementSync::BindValue(const Local<Value>& value, const int index) {
+  // SQLite only supports a subset of JavaScript types. Some JS types such as
+  // functions don't make sense to support. Other JS types such as booleans and
   // Dates could be supported by converting them to numbers. However, there
   // would not be a good way to read the values back from SQLite with the
   // original type.
@@ -1952,7 +2243,38 @@ MaybeLocal<Name> StatementSync::ColumnNameToName(const int column) {
     return MaybeLocal<Name>();
   }
 
-  return String::NewFromUtf8(env()->isolate(), col_name).As<Name>();
+  return String::NewFromUtf8(
+             env()->isolate(), col_name, NewStringType::kInternalized)
+      .As<Name>();
+}
+
+bool StatementSync::GetColumnNames(LocalVector<Name>* names) {
+  Isolate* isolate = env()->isolate();
+  size_t num_cols = sqlite3_column_count(statement_);
+  // SQLite prepares the statement again when the schema changes, which can
+  // change the names of its columns.
+  int reprepare_count =
+      sqlite3_stmt_status(statement_, SQLITE_STMTSTATUS_REPREPARE, 0);
+  if (column_names_.size() != num_cols ||
+      column_names_reprepare_count_ != reprepare_count) {
+    column_names_.clear();
+    column_names_.reserve(num_cols);
+    for (size_t i = 0; i < num_cols; ++i) {
+      Local<Name> name;
+      if (!ColumnNameToName(i).ToLocal(&name)) {
+        column_names_.clear();
+        return false;
+      }
+      column_names_.emplace_back(isolate, name);
+    }
+    column_names_reprepare_count_ = reprepare_count;
+  }
+
+  names->reserve(num_cols);
+  for (const Global<Name>& name : column_names_) {
+    names->emplace_back(name.Get(isolate));
+  }
+  return true;
 }
 
 void StatementSync::MemoryInfo(MemoryTracker* tracker) const {}
@@ -1992,14 +2314,7 @@ void StatementSync::All(const FunctionCallbackInfo<Value>& args) {
     LocalVector<Name> row_keys(isolate);
 
     while ((r = sqlite3_step(stmt->statement_)) == SQLITE_ROW) {
-      if (row_keys.size() == 0) {
-        row_keys.reserve(num_cols);
-        for (int i = 0; i < num_cols; ++i) {
-          Local<Name> key;
-          if (!stmt->ColumnNameToName(i).ToLocal(&key)) return;
-          row_keys.emplace_back(key);
-        }
-      }
+      if (row_keys.size() == 0 && !stmt->GetColumnNames(&row_keys)) return;
 
       LocalVector<Value> row_values(isolate);
       row_values.reserve(num_cols);
@@ -2020,6 +2335,152 @@ void StatementSync::All(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(Array::New(isolate, rows.data(), rows.size()));
 }
 
+// The values of a column of the result set of StatementSync::AllColumnar().
+// The values are read into a typed array while they are all numbers of the
+// same type, and into an array of JavaScript values otherwise.
+class ResultColumn {
+ public:
+  explicit ResultColumn(Isolate* isolate) : values_(isolate) {}
+
+  // Appends the value of the column of the current row of the statement.
+  bool Append(StatementSync* stmt,
+              sqlite3_stmt* statement,
+              int column,
+              bool use_big_ints) {
+    Isolate* isolate = stmt->env()->isolate();
+    int type = sqlite3_column_type(statement, column);
+    if (kind_ == kEmpty) {
+      if (type == SQLITE_FLOAT || (type == SQLITE_INTEGER && !use_big_ints)) {
+        kind_ = kFloat64;
+      } else if (type == SQLITE_INTEGER) {
+        kind_ = kBigInt64;
+      } else {
+        kind_ = kValues;
+      }
+    }
+
+    if (kind_ == kFloat64) {
+      if (type == SQLITE_FLOAT) {
+        doubles_.push_back(sqlite3_column_double(statement, column));
+        return true;
+      } else if (type == SQLITE_INTEGER && !use_big_ints) {
+        sqlite3_int64 val = sqlite3_column_int64(statement, column);
+        if (std::abs(val) > kMaxSafeJsInteger) {
+          THROW_ERR_OUT_OF_RANGE(isolate,
+                                 "Value is too large to be represented as a "
+                                 "JavaScript number: %" PRId64,
+                                 val);
+          return false;
+        }
+        doubles_.push_back(static_cast<double>(val));
+        return true;
+      }
+      ConvertToValues(isolate);
+    } else if (kind_ == kBigInt64) {
+      if (type == SQLITE_INTEGER) {
+        int64s_.push_back(sqlite3_column_int64(statement, column));
+        return true;
+      }
+      ConvertToValues(isolate);
+    }
+
+    Local<Value> val;
+    if (!stmt->ColumnToValue(column).ToLocal(&val)) return false;
+    values_.emplace_back(val);
+    return true;
+  }
+
+  Local<Value> ToValue(Isolate* isolate) {
+    switch (kind_) {
+      case kFloat64:
+        return Float64Array::New(
+            ToArrayBuffer(isolate, doubles_), 0, doubles_.size());
+      case kBigInt64:
+        return BigInt64Array::New(
+            ToArrayBuffer(isolate, int64s_), 0, int64s_.size());
+      default:
+        return Array::New(isolate, values_.data(), values_.size());
+    }
+  }
+
+ private:
+  enum Kind { kEmpty, kFloat64, kBigInt64, kValues };
+
+  template <typename T>
+  static Local<ArrayBuffer> ToArrayBuffer(Isolate* isolate,
+                                          const std::vector<T>& data) {
+    size_t size = data.size() * sizeof(T);
+    auto store = ArrayBuffer::NewBackingStore(
+        isolate, size, BackingStoreInitializationMode::kUninitialized);
+    if (size > 0) memcpy(store->Data(), data.data(), size);
+    return ArrayBuffer::New(isolate, std::move(store));
+  }
+
+  // Called when a value that does not fit into the typed array is read.
+  void ConvertToValues(Isolate* isolate) {
+    values_.reserve(doubles_.size() + int64s_.size() + 1);
+    for (double val : doubles_) {
+      values_.emplace_back(Number::New(isolate, val));
+    }
+    for (int64_t val : int64s_) {
+      values_.emplace_back(BigInt::New(isolate, val));
+    }
+    doubles_ = {};
+    int64s_ = {};
+    kind_ = kValues;
+  }
+
+  Kind kind_ = kEmpty;
+  std::vector<double> doubles_;
+  std::vector<int64_t> int64s_;
+  LocalVector<Value> values_;
+};
+
+void StatementSync::AllColumnar(const FunctionCallbackInfo<Value>& args) {
+  StatementSync* stmt;
+  ASSIGN_OR_RETURN_UNWRAP(&stmt, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(
+      env, stmt->IsFinalized(), "statement has been finalized");
+  Isolate* isolate = env->isolate();
+  int r = sqlite3_reset(stmt->statement_);
+  CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+
+  if (!stmt->BindParams(args)) {
+    return;
+  }
+
+  auto reset = OnScopeLeave([&]() { sqlite3_reset(stmt->statement_); });
+  int num_cols = sqlite3_column_count(stmt->statement_);
+  LocalVector<Name> keys(isolate);
+  keys.reserve(num_cols);
+  std::vector<ResultColumn> columns;
+  columns.reserve(num_cols);
+  for (int i = 0; i < num_cols; ++i) {
+    Local<Name> key;
+    if (!stmt->ColumnNameToName(i).ToLocal(&key)) return;
+    keys.emplace_back(key);
+    columns.emplace_back(isolate);
+  }
+
+  while ((r = sqlite3_step(stmt->statement_)) == SQLITE_ROW) {
+    for (int i = 0; i < num_cols; ++i) {
+      if (!columns[i].Append(stmt, stmt->statement_, i, stmt->use_big_ints_)) {
+        return;
+      }
+    }
+  }
+  CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_DONE, void());
+
+  LocalVector<Value> values(isolate);
+  values.reserve(num_cols);
+  for (ResultColumn& column : columns) {
+    values.emplace_back(column.ToValue(isolate));
+  }
+  args.GetReturnValue().Set(Object::New(
+      isolate, Null(isolate), keys.data(), values.data(), num_cols));
+}
+
 void StatementSync::Iterate(const FunctionCallbackInfo<Value>& args) {
   StatementSync* stmt;
   ASSIGN_OR_RETURN_UNWRAP(&stmt, args.This());
@@ -2101,16 +2562,13 @@ void StatementSync::Get(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(result);
   } else {
     LocalVector<Name> keys(isolate);
-    keys.reserve(num_cols);
+    if (!stmt->GetColumnNames(&keys)) return;
     LocalVector<Value> values(isolate);
     values.reserve(num_cols);
 
     for (int i = 0; i < num_cols; ++i) {
-      Local<Name> key;
-      if (!stmt->ColumnNameToName(i).ToLocal(&key)) return;
       Local<Value> val;
       if (!stmt->ColumnToValue(i).ToLocal(&val)) return;
-      keys.emplace_back(key);
       values.emplace_back(val);
     }
 
@@ -2166,6 +2624,206 @@ void StatementSync::Run(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(result);
 }
 
+// A column of the parameters of StatementSync::RunMany(), when the rows are
+// passed by column. The values of typed arrays are read directly.
+struct ParamColumn {
+  int index;
+  Local<Value> values;
+  const double* doubles = nullptr;
+  const int64_t* int64s = nullptr;
+};
+
+static bool GetParamColumn(Environment* env,
+                           Local<Value> values,
+                           ParamColumn* column,
+                           uint32_t* length) {
+  if (values->IsFloat64Array() || values->IsBigInt64Array()) {
+    Local<TypedArray> array = values.As<TypedArray>();
+    const char* data =
+        static_cast<const char*>(array->Buffer()->Data()) + array->ByteOffset();
+    if (values->IsFloat64Array()) {
+      column->doubles = reinterpret_cast<const double*>(data);
+    } else {
+      column->int64s = reinterpret_cast<const int64_t*>(data);
+    }
+    *length = array->Length();
+  } else if (values->IsArray()) {
+    *length = values.As<Array>()->Length();
+  } else {
+    THROW_ERR_INVALID_ARG_TYPE(
+        env->isolate(),
+        "The columns of the \"rows\" argument must be arrays, Float64Arrays, "
+        "or BigInt64Arrays.");
+    return false;
+  }
+  column->values = values;
+  return true;
+}
+
+void StatementSync::RunMany(const FunctionCallbackInfo<Value>& args) {
+  StatementSync* stmt;
+  ASSIGN_OR_RETURN_UNWRAP(&stmt, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(
+      env, stmt->IsFinalized(), "statement has been finalized");
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  if (!args[0]->IsObject() || args[0]->IsArrayBufferView()) {
+    THROW_ERR_INVALID_ARG_TYPE(
+        isolate, "The \"rows\" argument must be an array or an object.");
+    return;
+  }
+
+  // The rows are either an array of rows, or an object whose properties are
+  // the columns of the rows, by the name of their parameter.
+  Local<Array> rows;
+  std::vector<ParamColumn> columns;
+  uint32_t row_count = 0;
+  if (args[0]->IsArray()) {
+    rows = args[0].As<Array>();
+    row_count = rows->Length();
+  } else {
+    Local<Object> obj = args[0].As<Object>();
+    Local<Array> keys;
+    if (!obj->GetOwnPropertyNames(context).ToLocal(&keys) ||
+        !stmt->MaybeCollectBareNamedParams()) {
+      return;
+    }
+
+    uint32_t len = keys->Length();
+    for (uint32_t j = 0; j < len; j++) {
+      Local<Value> key;
+      ParamColumn column;
+      Local<Value> values;
+      uint32_t length;
+      if (!keys->Get(context, j).ToLocal(&key) ||
+          !stmt->NamedParamIndex(key, &column.index) ||
+          !obj->Get(context, key).ToLocal(&values) ||
+          !GetParamColumn(env, values, &column, &length)) {
+        return;
+      }
+      if (j == 0) {
+        row_count = length;
+      } else if (length != row_count) {
+        THROW_ERR_INVALID_ARG_VALUE(
+            env,
+            "The columns of the \"rows\" argument must have equal length.");
+        return;
+      }
+      // Unknown named parameters are allowed.
+      if (column.index != 0) columns.push_back(column);
+    }
+  }
+
+  // Run all the rows in a savepoint, which behaves like a transaction when
+  // there is none yet, so that either all or none of them are applied.
+  sqlite3* connection = stmt->db_->Connection();
+  int r = sqlite3_exec(
+      connection, "SAVEPOINT node_sqlite_run_many", nullptr, nullptr, nullptr);
+  CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+  bool released = false;
+  auto rollback = OnScopeLeave([&]() {
+    if (released) return;
+    sqlite3_exec(connection,
+                 "ROLLBACK TO node_sqlite_run_many;"
+                 "RELEASE node_sqlite_run_many",
+                 nullptr,
+                 nullptr,
+                 nullptr);
+  });
+  auto reset = OnScopeLeave([&]() { sqlite3_reset(stmt->statement_); });
+
+  bool read_only = sqlite3_stmt_readonly(stmt->statement_);
+  sqlite3_int64 changes = 0;
+  for (uint32_t i = 0; i < row_count; i++) {
+    sqlite3_reset(stmt->statement_);
+    r = sqlite3_clear_bindings(stmt->statement_);
+    CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+
+    if (rows.IsEmpty()) {
+      for (const ParamColumn& column : columns) {
+        if (column.doubles != nullptr) {
+          r = sqlite3_bind_double(
+              stmt->statement_, column.index, column.doubles[i]);
+          CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+        } else if (column.int64s != nullptr) {
+          r = sqlite3_bind_int64(
+              stmt->statement_, column.index, column.int64s[i]);
+          CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+        } else {
+          Local<Value> value;
+          if (!column.values.As<Array>()->Get(context, i).ToLocal(&value) ||
+              !stmt->BindValue(value, column.index)) {
+            return;
+          }
+        }
+      }
+    } else {
+      Local<Value> row;
+      if (!rows->Get(context, i).ToLocal(&row)) {
+        return;
+      }
+      if (row->IsArray()) {
+        Local<Array> values = row.As<Array>();
+        uint32_t len = values->Length();
+        int anon_idx = 1;
+        for (uint32_t j = 0; j < len; j++) {
+          Local<Value> value;
+          if (!values->Get(context, j).ToLocal(&value) ||
+              !stmt->BindAnonymousParam(value, &anon_idx)) {
+            return;
+          }
+        }
+      } else if (row->IsObject() && !row->IsArrayBufferView()) {
+        if (!stmt->BindNamedParams(row.As<Object>())) {
+          return;
+        }
+      } else {
+        THROW_ERR_INVALID_ARG_TYPE(
+            isolate,
+            "The \"rows[%u]\" argument must be an array or an object.",
+            i);
+        return;
+      }
+    }
+
+    r = sqlite3_step(stmt->statement_);
+    if (r != SQLITE_ROW && r != SQLITE_DONE) {
+      THROW_ERR_SQLITE_ERROR(isolate, stmt->db_.get());
+      return;
+    }
+    if (!read_only) changes += sqlite3_changes64(connection);
+  }
+
+  sqlite3_reset(stmt->statement_);
+  r = sqlite3_exec(
+      connection, "RELEASE node_sqlite_run_many", nullptr, nullptr, nullptr);
+  CHECK_ERROR_OR_THROW(isolate, stmt->db_.get(), r, SQLITE_OK, void());
+  released = true;
+
+  sqlite3_int64 last_insert_rowid = sqlite3_last_insert_rowid(connection);
+  Local<Value> last_insert_rowid_val;
+  Local<Value> changes_val;
+  if (stmt->use_big_ints_) {
+    last_insert_rowid_val = BigInt::New(isolate, last_insert_rowid);
+    changes_val = BigInt::New(isolate, changes);
+  } else {
+    last_insert_rowid_val = Number::New(isolate, last_insert_rowid);
+    changes_val = Number::New(isolate, changes);
+  }
+
+  Local<Object> result = Object::New(isolate);
+  if (result
+          ->Set(context, env->last_insert_rowid_string(), last_insert_rowid_val)
+          .IsNothing() ||
+      result->Set(context, env->changes_string(), changes_val).IsNothing()) {
+    return;
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
 void StatementSync::Columns(const FunctionCallbackInfo<Value>& args) {
   StatementSync* stmt;
   ASSIGN_OR_RETURN_UNWRAP(&stmt, args.This());
@@ -2368,8 +3026,10 @@ Local<FunctionTemplate> StatementSync::GetConstructorTemplate(
         StatementSync::kInternalFieldCount);
     SetProtoMethod(isolate, tmpl, "iterate", StatementSync::Iterate);
     SetProtoMethod(isolate, tmpl, "all", StatementSync::All);
+    SetProtoMethod(isolate, tmpl, "allColumnar", StatementSync::AllColumnar);
     SetProtoMethod(isolate, tmpl, "get", StatementSync::Get);
     SetProtoMethod(isolate, tmpl, "run", StatementSync::Run);
+    SetProtoMethod(isolate, tmpl, "runMany", StatementSync::RunMany);
     SetProtoMethodNoSideEffect(
         isolate, tmpl, "columns", StatementSync::Columns);
     SetSideEffectFreeGetter(isolate,
@@ -2498,15 +3158,12 @@ void StatementSyncIterator::Next(const FunctionCallbackInfo<Value>& args) {
     row_value = Array::New(isolate, array_values.data(), array_values.size());
   } else {
     LocalVector<Name> row_keys(isolate);
+    if (!iter->stmt_->GetColumnNames(&row_keys)) return;
     LocalVector<Value> row_values(isolate);
-    row_keys.reserve(num_cols);
     row_values.reserve(num_cols);
     for (int i = 0; i < num_cols; ++i) {
-      Local<Name> key;
-      if (!iter->stmt_->ColumnNameToName(i).ToLocal(&key)) return;
       Local<Value> val;
       if (!iter->stmt_->ColumnToValue(i).ToLocal(&val)) return;
-      row_keys.emplace_back(key);
       row_values.emplace_back(val);
     }
 
@@ -2645,6 +3302,751 @@ void Session::Delete() {
   session_ = nullptr;
 }
 
+void Database::Task::SetError(sqlite3* connection) {
+  error_ = SQLiteError{sqlite3_extended_errcode(connection),
+                       sqlite3_errmsg(connection)};
+}
+
+// Reads a column of the current row of a statement.
+static SQLiteValue ReadColumn(sqlite3_stmt* stmt, int column) {
+  switch (sqlite3_column_type(stmt, column)) {
+    case SQLITE_INTEGER:
+      return static_cast<int64_t>(sqlite3_column_int64(stmt, column));
+    case SQLITE_FLOAT:
+      return sqlite3_column_double(stmt, column);
+    case SQLITE_TEXT: {
+      auto text =
+          reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+      return std::string(text, sqlite3_column_bytes(stmt, column));
+    }
+    case SQLITE_NULL:
+      return std::monostate();
+    case SQLITE_BLOB: {
+      auto data =
+          static_cast<const uint8_t*>(sqlite3_column_blob(stmt, column));
+      return std::vector<uint8_t>(data,
+                                  data + sqlite3_column_bytes(stmt, column));
+    }
+    default:
+      UNREACHABLE("Bad SQLite value");
+  }
+}
+
+// The value must outlive the step of the statement, as it is not copied.
+static int BindSQLiteValue(sqlite3_stmt* stmt,
+                           int index,
+                           const SQLiteValue& value) {
+  if (auto val = std::get_if<int64_t>(&value)) {
+    return sqlite3_bind_int64(stmt, index, *val);
+  } else if (auto val = std::get_if<double>(&value)) {
+    return sqlite3_bind_double(stmt, index, *val);
+  } else if (auto val = std::get_if<std::string>(&value)) {
+    return sqlite3_bind_text(
+        stmt, index, val->data(), val->size(), SQLITE_STATIC);
+  } else if (auto val = std::get_if<std::vector<uint8_t>>(&value)) {
+    return sqlite3_bind_blob(
+        stmt, index, val->data(), val->size(), SQLITE_STATIC);
+  }
+  return sqlite3_bind_null(stmt, index);
+}
+
+static MaybeLocal<Value> SQLiteValueToJS(Isolate* isolate,
+                                         const SQLiteValue& value) {
+  if (auto val = std::get_if<int64_t>(&value)) {
+    if (std::abs(*val) > kMaxSafeJsInteger) {
+      THROW_ERR_OUT_OF_RANGE(isolate,
+                             "Value is too large to be represented as a "
+                             "JavaScript number: %" PRId64,
+                             *val);
+      return MaybeLocal<Value>();
+    }
+    return Number::New(isolate, *val);
+  } else if (auto val = std::get_if<double>(&value)) {
+    return Number::New(isolate, *val);
+  } else if (auto val = std::get_if<std::string>(&value)) {
+    return String::NewFromUtf8(
+               isolate, val->data(), NewStringType::kNormal, val->size())
+        .FromMaybe(Local<String>());
+  } else if (auto val = std::get_if<std::vector<uint8_t>>(&value)) {
+    auto store = ArrayBuffer::NewBackingStore(
+        isolate, val->size(), BackingStoreInitializationMode::kUninitialized);
+    if (!val->empty()) memcpy(store->Data(), val->data(), val->size());
+    Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+    return Uint8Array::New(ab, 0, val->size());
+  }
+  return Null(isolate);
+}
+
+static bool JSValueToSQLiteValue(Environment* env,
+                                 Local<Value> value,
+                                 int index,
+                                 SQLiteValue* result) {
+  if (value->IsNumber()) {
+    *result = value.As<Number>()->Value();
+  } else if (value->IsString()) {
+    *result = Utf8Value(env->isolate(), value.As<String>()).ToString();
+  } else if (value->IsNull()) {
+    *result = std::monostate();
+  } else if (value->IsArrayBufferView()) {
+    ArrayBufferViewContents<uint8_t> buf(value);
+    *result = std::vector<uint8_t>(buf.data(), buf.data() + buf.length());
+  } else if (value->IsBigInt()) {
+    bool lossless;
+    int64_t as_int = value.As<BigInt>()->Int64Value(&lossless);
+    if (!lossless) {
+      THROW_ERR_INVALID_ARG_VALUE(env, "BigInt value is too large to bind.");
+      return false;
+    }
+    *result = as_int;
+  } else {
+    THROW_ERR_INVALID_ARG_TYPE(
+        env->isolate(),
+        "Provided value cannot be bound to SQLite parameter %d.",
+        index);
+    return false;
+  }
+  return true;
+}
+
+class ExecTask : public Database::Task {
+ public:
+  explicit ExecTask(std::string&& sql) : sql_(std::move(sql)) {}
+
+  void Run(sqlite3* connection) override {
+    int r = sqlite3_exec(connection, sql_.c_str(), nullptr, nullptr, nullptr);
+    if (r != SQLITE_OK) SetError(connection);
+  }
+
+  MaybeLocal<Value> Result(Database* db) override {
+    return Undefined(db->env()->isolate());
+  }
+
+ private:
+  std::string sql_;
+};
+
+class PrepareTask : public Database::Task {
+ public:
+  explicit PrepareTask(std::string&& sql) : sql_(std::move(sql)) {}
+
+  void Run(sqlite3* connection) override {
+    int r = sqlite3_prepare_v2(connection, sql_.c_str(), -1, &statement_, 0);
+    if (r != SQLITE_OK) {
+      SetError(connection);
+      return;
+    }
+    // Copy the names of the parameters, so that the parameters can be
+    // validated on the JavaScript thread.
+    int param_count = sqlite3_bind_parameter_count(statement_);
+    parameter_names_.reserve(param_count);
+    // Parameter indexing starts at one.
+    for (int i = 1; i <= param_count; ++i) {
+      const char* name = sqlite3_bind_parameter_name(statement_, i);
+      parameter_names_.emplace_back(name != nullptr ? name : "");
+    }
+  }
+
+  MaybeLocal<Value> Result(Database* db) override {
+    // If the statement cannot be wrapped, it is finalized when the database
+    // is closed.
+    BaseObjectPtr<Statement> stmt =
+        Statement::Create(db->env(),
+                          BaseObjectPtr<Database>(db),
+                          statement_,
+                          std::move(parameter_names_));
+    if (!stmt) return MaybeLocal<Value>();
+    return stmt->object();
+  }
+
+ private:
+  std::string sql_;
+  sqlite3_stmt* statement_ = nullptr;
+  std::vector<std::string> parameter_names_;
+};
+
+class FinalizeTask : public Database::Task {
+ public:
+  explicit FinalizeTask(sqlite3_stmt* statement) : statement_(statement) {}
+
+  void Run(sqlite3* connection) override { sqlite3_finalize(statement_); }
+
+  MaybeLocal<Value> Result(Database* db) override { UNREACHABLE(); }
+
+ private:
+  sqlite3_stmt* statement_;
+};
+
+class CloseTask : public Database::Task {
+ public:
+  explicit CloseTask(Database* db) : db_(db) {}
+
+  void Run(sqlite3* connection) override {
+    sqlite3_stmt* stmt;
+    while ((stmt = sqlite3_next_stmt(connection, nullptr)) != nullptr) {
+      sqlite3_finalize(stmt);
+    }
+    Mutex::ScopedLock lock(db_->mutex_);
+    sqlite3_close_v2(connection);
+    db_->connection_ = nullptr;
+  }
+
+  MaybeLocal<Value> Result(Database* db) override {
+    return Undefined(db->env()->isolate());
+  }
+
+  bool StopsThread() const override { return true; }
+
+ private:
+  Database* db_;
+};
+
+// Binds the parameters of a statement, and steps it with Step() on the thread
+// of the database.
+class StatementTask : public Database::Task {
+ public:
+  StatementTask(sqlite3_stmt* statement, Statement::Bindings&& bindings)
+      : statement_(statement), bindings_(std::move(bindings)) {}
+
+  void Run(sqlite3* connection) override {
+    sqlite3_reset(statement_);
+    sqlite3_clear_bindings(statement_);
+    // The bound values are not copied by SQLite, so they are cleared before
+    // the task is deleted.
+    auto reset = OnScopeLeave([&]() {
+      sqlite3_reset(statement_);
+      sqlite3_clear_bindings(statement_);
+    });
+    for (const auto& [index, value] : bindings_) {
+      if (BindSQLiteValue(statement_, index, value) != SQLITE_OK) {
+        SetError(connection);
+        return;
+      }
+    }
+    if (!Step(connection)) SetError(connection);
+  }
+
+ protected:
+  virtual bool Step(sqlite3* connection) = 0;
+
+  sqlite3_stmt* statement_;
+
+ private:
+  Statement::Bindings bindings_;
+};
+
+class RunTask : public StatementTask {
+ public:
+  using StatementTask::StatementTask;
+
+  MaybeLocal<Value> Result(Database* db) override {
+    Environment* env = db->env();
+    Local<Object> result = Object::New(env->isolate());
+    if (result
+            ->Set(env->context(),
+                  env->last_insert_rowid_string(),
+                  Number::New(env->isolate(), last_insert_rowid_))
+            .IsNothing() ||
+        result
+            ->Set(env->context(),
+                  env->changes_string(),
+                  Number::New(env->isolate(), changes_))
+            .IsNothing()) {
+      return MaybeLocal<Value>();
+    }
+    return result;
+  }
+
+ protected:
+  bool Step(sqlite3* connection) override {
+    int r = sqlite3_step(statement_);
+    if (r != SQLITE_ROW && r != SQLITE_DONE) return false;
+    last_insert_rowid_ = sqlite3_last_insert_rowid(connection);
+    changes_ = sqlite3_changes64(connection);
+    return true;
+  }
+
+ private:
+  sqlite3_int64 last_insert_rowid_ = 0;
+  sqlite3_int64 changes_ = 0;
+};
+
+// Copies the rows that a statement returns, all of them or only the first
+// one, to be converted to objects on the JavaScript thread.
+template <bool kAll>
+class QueryTask : public StatementTask {
+ public:
+  using StatementTask::StatementTask;
+
+  MaybeLocal<Value> Result(Database* db) override {
+    Isolate* isolate = db->env()->isolate();
+    if (!kAll && (rows_ == 0 || columns_.empty())) {
+      return Undefined(isolate);
+    }
+
+    size_t num_cols = columns_.size();
+    LocalVector<Name> keys(isolate);
+    keys.reserve(num_cols);
+    for (const std::string& column : columns_) {
+      Local<String> key;
+      if (!String::NewFromUtf8(
+               isolate, column.data(), NewStringType::kNormal, column.size())
+               .ToLocal(&key)) {
+        return MaybeLocal<Value>();
+      }
+      keys.emplace_back(key);
+    }
+
+    LocalVector<Value> rows(isolate);
+    rows.reserve(rows_);
+    LocalVector<Value> row_values(isolate);
+    row_values.reserve(num_cols);
+    for (size_t i = 0; i < rows_; i++) {
+      row_values.clear();
+      for (size_t j = 0; j < num_cols; j++) {
+        Local<Value> val;
+        if (!SQLiteValueToJS(isolate, values_[i * num_cols + j])
+                 .ToLocal(&val)) {
+          return MaybeLocal<Value>();
+        }
+        row_values.emplace_back(val);
+      }
+      rows.emplace_back(Object::New(
+          isolate, Null(isolate), keys.data(), row_values.data(), num_cols));
+    }
+
+    if (!kAll) return rows[0];
+    return Array::New(isolate, rows.data(), rows.size());
+  }
+
+ protected:
+  bool Step(sqlite3* connection) override {
+    int r;
+    while ((r = sqlite3_step(statement_)) == SQLITE_ROW) {
+      if (rows_ == 0) {
+        int num_cols = sqlite3_column_count(statement_);
+        columns_.reserve(num_cols);
+        for (int i = 0; i < num_cols; ++i) {
+          const char* name = sqlite3_column_name(statement_, i);
+          columns_.emplace_back(name != nullptr ? name : "");
+        }
+      }
+      for (size_t i = 0; i < columns_.size(); ++i) {
+        values_.emplace_back(ReadColumn(statement_, i));
+      }
+      rows_++;
+      if (!kAll) return true;
+    }
+    return r == SQLITE_DONE;
+  }
+
+ private:
+  std::vector<std::string> columns_;
+  // The values of all the rows, row by row.
+  std::vector<SQLiteValue> values_;
+  size_t rows_ = 0;
+};
+
+Database::Database(Environment* env,
+                   Local<Object> object,
+                   sqlite3* connection)
+    : BaseObject(env, object),
+      connection_(connection),
+      async_(new uv_async_t) {
+  MakeWeak();
+  CHECK_EQ(uv_async_init(env->event_loop(), async_, OnCompleted), 0);
+  async_->data = this;
+  uv_unref(reinterpret_cast<uv_handle_t*>(async_));
+  CHECK_EQ(uv_thread_create(&thread_, ThreadMain, this), 0);
+}
+
+Database::~Database() {
+  Stop();
+}
+
+void Database::MemoryInfo(MemoryTracker* tracker) const {}
+
+void Database::ThreadMain(void* data) {
+  Database* db = static_cast<Database*>(data);
+  bool stop = false;
+  while (!stop) {
+    std::unique_ptr<Task> task;
+    {
+      Mutex::ScopedLock lock(db->mutex_);
+      while (db->pending_.empty()) db->pending_cond_.Wait(lock);
+      task = std::move(db->pending_.front());
+      db->pending_.pop_front();
+    }
+
+    task->Run(db->connection_);
+    stop = task->StopsThread();
+    if (task->resolver_.IsEmpty()) continue;
+
+    {
+      Mutex::ScopedLock lock(db->mutex_);
+      db->completed_.push_back(std::move(task));
+    }
+    uv_async_send(db->async_);
+  }
+}
+
+MaybeLocal<Promise> Database::Post(std::unique_ptr<Task> task) {
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(env()->context()).ToLocal(&resolver)) {
+    return MaybeLocal<Promise>();
+  }
+  task->resolver_.Reset(env()->isolate(), resolver);
+  if (outstanding_++ == 0) {
+    ClearWeak();
+    uv_ref(reinterpret_cast<uv_handle_t*>(async_));
+  }
+  PostWithoutResult(std::move(task));
+  return resolver->GetPromise();
+}
+
+void Database::PostWithoutResult(std::unique_ptr<Task> task) {
+  Mutex::ScopedLock lock(mutex_);
+  pending_.push_back(std::move(task));
+  pending_cond_.Signal(lock);
+}
+
+void Database::OnCompleted(uv_async_t* async) {
+  Database* db = static_cast<Database*>(async->data);
+  std::deque<std::unique_ptr<Task>> completed;
+  {
+    Mutex::ScopedLock lock(db->mutex_);
+    completed.swap(db->completed_);
+  }
+  if (completed.empty()) return;
+
+  Environment* env = db->env();
+  if (!env->can_call_into_js()) return;
+  BaseObjectPtr<Database> strong_ref(db);
+  HandleScope handle_scope(env->isolate());
+  InternalCallbackScope callback_scope(
+      env, db->object(), {0, 0}, InternalCallbackScope::kNoFlags);
+  for (auto& task : completed) {
+    db->Complete(std::move(task));
+  }
+}
+
+void Database::Complete(std::unique_ptr<Task> task) {
+  Isolate* isolate = env()->isolate();
+  Local<Context> context = env()->context();
+  Local<Promise::Resolver> resolver = task->resolver_.Get(isolate);
+  if (task->StopsThread()) OnClosed();
+
+  if (task->error_.has_value()) {
+    Local<Object> e;
+    if (CreateSQLiteError(isolate, task->error_.value()).ToLocal(&e)) {
+      USE(resolver->Reject(context, e));
+    }
+  } else {
+    TryCatch try_catch(isolate);
+    Local<Value> result;
+    if (task->Result(this).ToLocal(&result)) {
+      USE(resolver->Resolve(context, result));
+    } else if (try_catch.HasCaught() && try_catch.CanContinue()) {
+      USE(resolver->Reject(context, try_catch.Exception()));
+    }
+  }
+
+  if (--outstanding_ == 0) {
+    if (async_ != nullptr) uv_unref(reinterpret_cast<uv_handle_t*>(async_));
+    MakeWeak();
+  }
+}
+
+void Database::OnClosed() {
+  for (Statement* stmt : statements_) {
+    stmt->statement_ = nullptr;
+  }
+  statements_.clear();
+  Stop();
+}
+
+void Database::Stop() {
+  if (stopped_) return;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (connection_ != nullptr) {
+      // Abort the query that is running, if any, and drop the queued tasks.
+      sqlite3_interrupt(connection_);
+      pending_.clear();
+      pending_.push_back(std::make_unique<CloseTask>(this));
+      pending_cond_.Signal(lock);
+    }
+  }
+  CHECK_EQ(uv_thread_join(&thread_), 0);
+  stopped_ = true;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    completed_.clear();
+  }
+  env()->CloseHandle(async_, [](uv_async_t* handle) { delete handle; });
+  async_ = nullptr;
+}
+
+void Database::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (!args.IsConstructCall()) {
+    THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+    return;
+  }
+
+  std::optional<std::string> location =
+      ValidateDatabasePath(env, args[0], "path");
+  if (!location.has_value()) {
+    return;
+  }
+
+  DatabaseOpenConfiguration open_config(std::move(location.value()));
+  if (args.Length() > 1 &&
+      !ParseOpenOptions(env, args[1], &open_config, nullptr, nullptr)) {
+    return;
+  }
+
+  sqlite3* connection = nullptr;
+  int r = OpenConnection(open_config, &connection);
+  if (r != SQLITE_OK) {
+    Local<Object> e;
+    if (CreateSQLiteError(env->isolate(), connection).ToLocal(&e)) {
+      env->isolate()->ThrowException(e);
+    }
+    sqlite3_close_v2(connection);
+    return;
+  }
+
+  new Database(env, args.This(), connection);
+}
+
+void Database::IsOpenGetter(const FunctionCallbackInfo<Value>& args) {
+  Database* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  args.GetReturnValue().Set(db->IsOpen());
+}
+
+void Database::Close(const FunctionCallbackInfo<Value>& args) {
+  Database* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(env, !db->IsOpen(), "database is not open");
+  db->closing_ = true;
+  Local<Promise> promise;
+  if (db->Post(std::make_unique<CloseTask>(db)).ToLocal(&promise)) {
+    args.GetReturnValue().Set(promise);
+  }
+}
+
+void Database::AsyncDispose(const FunctionCallbackInfo<Value>& args) {
+  Database* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  if (db->IsOpen()) Close(args);
+}
+
+void Database::Exec(const FunctionCallbackInfo<Value>& args) {
+  Database* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(env, !db->IsOpen(), "database is not open");
+
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(env->isolate(),
+                               "The \"sql\" argument must be a string.");
+    return;
+  }
+
+  Utf8Value sql(env->isolate(), args[0].As<String>());
+  Local<Promise> promise;
+  if (db->Post(std::make_unique<ExecTask>(sql.ToString())).ToLocal(&promise)) {
+    args.GetReturnValue().Set(promise);
+  }
+}
+
+void Database::Prepare(const FunctionCallbackInfo<Value>& args) {
+  Database* db;
+  ASSIGN_OR_RETURN_UNWRAP(&db, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(env, !db->IsOpen(), "database is not open");
+
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(env->isolate(),
+                               "The \"sql\" argument must be a string.");
+    return;
+  }
+
+  Utf8Value sql(env->isolate(), args[0].As<String>());
+  Local<Promise> promise;
+  if (db->Post(std::make_unique<PrepareTask>(sql.ToString()))
+          .ToLocal(&promise)) {
+    args.GetReturnValue().Set(promise);
+  }
+}
+
+Statement::Statement(Environment* env,
+                     Local<Object> object,
+                     BaseObjectPtr<Database> db,
+                     sqlite3_stmt* stmt,
+                     std::vector<std::string>&& parameter_names)
+    : BaseObject(env, object),
+      db_(std::move(db)),
+      statement_(stmt),
+      parameter_names_(std::move(parameter_names)) {
+  MakeWeak();
+  if (statement_ != nullptr) db_->statements_.insert(this);
+}
+
+Statement::~Statement() {
+  if (IsFinalized()) return;
+  db_->statements_.erase(this);
+  // Otherwise, the statement is finalized when the database is closed.
+  if (db_->IsOpen()) {
+    db_->PostWithoutResult(std::make_unique<FinalizeTask>(statement_));
+  }
+}
+
+void Statement::MemoryInfo(MemoryTracker* tracker) const {}
+
+bool Statement::CollectBindings(const FunctionCallbackInfo<Value>& args,
+                                Bindings* bindings) {
+  Isolate* isolate = env()->isolate();
+  Local<Context> context = env()->context();
+  int anon_idx = 1;
+  int anon_start = 0;
+
+  if (args[0]->IsObject() && !args[0]->IsArrayBufferView()) {
+    Local<Object> obj = args[0].As<Object>();
+    Local<Array> keys;
+    if (!obj->GetOwnPropertyNames(context).ToLocal(&keys)) {
+      return false;
+    }
+
+    uint32_t len = keys->Length();
+    for (uint32_t j = 0; j < len; j++) {
+      Local<Value> key;
+      if (!keys->Get(context, j).ToLocal(&key)) {
+        return false;
+      }
+
+      Utf8Value utf8_key(isolate, key);
+      std::string_view name = utf8_key.ToStringView();
+      auto it = std::find(
+          parameter_names_.begin(), parameter_names_.end(), name);
+      int index = 0;
+      if (it != parameter_names_.end()) {
+        index = it - parameter_names_.begin() + 1;
+      } else {
+        // Look the name up as a bare named parameter, without its prefix.
+        for (size_t i = 0; i < parameter_names_.size(); i++) {
+          const std::string& full_name = parameter_names_[i];
+          if (full_name.empty() ||
+              std::string_view(full_name).substr(1) != name) {
+            continue;
+          }
+          if (index != 0) {
+            THROW_ERR_INVALID_STATE(
+                env(),
+                "Cannot create bare named parameter '%s' because of "
+                "conflicting names '%s' and '%s'.",
+                *utf8_key,
+                parameter_names_[index - 1],
+                full_name);
+            return false;
+          }
+          index = i + 1;
+        }
+      }
+
+      if (index == 0) {
+        THROW_ERR_INVALID_STATE(
+            env(), "Unknown named parameter '%s'", *utf8_key);
+        return false;
+      }
+
+      Local<Value> value;
+      SQLiteValue sqlite_value;
+      if (!obj->Get(context, key).ToLocal(&value) ||
+          !JSValueToSQLiteValue(env(), value, index, &sqlite_value)) {
+        return false;
+      }
+      bindings->emplace_back(index, std::move(sqlite_value));
+    }
+    anon_start++;
+  }
+
+  int param_count = parameter_names_.size();
+  for (int i = anon_start; i < args.Length(); ++i) {
+    while (anon_idx <= param_count && !parameter_names_[anon_idx - 1].empty()) {
+      anon_idx++;
+    }
+
+    SQLiteValue sqlite_value;
+    if (!JSValueToSQLiteValue(env(), args[i], anon_idx, &sqlite_value)) {
+      return false;
+    }
+    bindings->emplace_back(anon_idx, std::move(sqlite_value));
+    anon_idx++;
+  }
+
+  return true;
+}
+
+template <typename StepTask>
+void Statement::Step(const FunctionCallbackInfo<Value>& args) {
+  Statement* stmt;
+  ASSIGN_OR_RETURN_UNWRAP(&stmt, args.This());
+  Environment* env = Environment::GetCurrent(args);
+  THROW_AND_RETURN_ON_BAD_STATE(
+      env, !stmt->db_->IsOpen(), "database is not open");
+  THROW_AND_RETURN_ON_BAD_STATE(
+      env, stmt->IsFinalized(), "statement has been finalized");
+
+  Bindings bindings;
+  if (!stmt->CollectBindings(args, &bindings)) {
+    return;
+  }
+
+  Local<Promise> promise;
+  if (stmt->db_
+          ->Post(std::make_unique<StepTask>(stmt->statement_,
+                                            std::move(bindings)))
+          .ToLocal(&promise)) {
+    args.GetReturnValue().Set(promise);
+  }
+}
+
+Local<FunctionTemplate> Statement::GetConstructorTemplate(Environment* env) {
+  Local<FunctionTemplate> tmpl = env->sqlite_statement_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, IllegalConstructor);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "Statement"));
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        Statement::kInternalFieldCount);
+    SetProtoMethod(isolate, tmpl, "all", Statement::Step<QueryTask<true>>);
+    SetProtoMethod(isolate, tmpl, "get", Statement::Step<QueryTask<false>>);
+    SetProtoMethod(isolate, tmpl, "run", Statement::Step<RunTask>);
+    env->set_sqlite_statement_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+BaseObjectPtr<Statement> Statement::Create(
+    Environment* env,
+    BaseObjectPtr<Database> db,
+    sqlite3_stmt* stmt,
+    std::vector<std::string>&& parameter_names) {
+  Local<Object> obj;
+  if (!GetConstructorTemplate(env)
+           ->InstanceTemplate()
+           ->NewInstance(env->context())
+           .ToLocal(&obj)) {
+    return nullptr;
+  }
+
+  return MakeBaseObject<Statement>(
+      env, obj, std::move(db), stmt, std::move(parameter_names));
+}
+
 void DefineConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, SQLITE_CHANGESET_OMIT);
   NODE_DEFINE_CONSTANT(target, SQLITE_CHANGESET_REPLACE);
@@ -2691,6 +4093,10 @@ static void Initialize(Local<Object> target,
                  DatabaseSync::EnableLoadExtension);
   SetProtoMethod(
       isolate, db_tmpl, "loadExtension", DatabaseSync::LoadExtension);
+  SetProtoMethodNoSideEffect(isolate,
+                             db_tmpl,
+                             "getStatementCacheStatistics",
+                             DatabaseSync::GetStatementCacheStatistics);
   SetSideEffectFreeGetter(isolate,
                           db_tmpl,
                           FIXED_ONE_BYTE_STRING(isolate, "isOpen"),
@@ -2707,6 +4113,22 @@ static void Initialize(Local<Object> target,
   SetConstructorFunction(
       context, target, "Session", Session::GetConstructorTemplate(env));
 
+  Local<FunctionTemplate> async_db_tmpl =
+      NewFunctionTemplate(isolate, Database::New);
+  async_db_tmpl->InstanceTemplate()->SetInternalFieldCount(
+      Database::kInternalFieldCount);
+  SetProtoMethod(isolate, async_db_tmpl, "close", Database::Close);
+  SetProtoAsyncDispose(isolate, async_db_tmpl, Database::AsyncDispose);
+  SetProtoMethod(isolate, async_db_tmpl, "exec", Database::Exec);
+  SetProtoMethod(isolate, async_db_tmpl, "prepare", Database::Prepare);
+  SetSideEffectFreeGetter(isolate,
+                          async_db_tmpl,
+                          FIXED_ONE_BYTE_STRING(isolate, "isOpen"),
+                          Database::IsOpenGetter);
+  SetConstructorFunction(context, target, "Database", async_db_tmpl);
+  SetConstructorFunction(
+      context, target, "Statement", Statement::GetConstructorTemplate(env));
+
   target->Set(context, env->constants_string(), constants).Check();
 
   Local<Function> backup_function;
@@ -5,11 +5,22 @@
 
 #include "base_object.h"
 #include "node_mem.h"
+#include "node_mutex.h"
 #include "sqlite3.h"
 #include "util.h"
+#include "uv.h"
 
+#include <deque>
+#include <list>
 #include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <variant>
+#include <vector>
 
 namespace node {
 namespace sqlite {
@@ -37,7 +48,47 @@ class DatabaseOpenConfiguration {
 
   inline void set_timeout(int timeout) { timeout_ = timeout; }
 
-  inline int get_timeout() { return timeout_; }
+  inline int get_timeout() const { return timeout_; }
+
+  inline bool get_shared_cache() const { return shared_cache_; }
+
+  inline void set_shared_cache(bool flag) { shared_cache_ = flag; }
+
+  inline const std::optional<int64_t>& get_mmap_size() const {
+    return mmap_size_;
+  }
+
+  inline void set_mmap_size(int64_t size) { mmap_size_ = size; }
+
+  inline const std::optional<int>& get_cache_size() const {
+    return cache_size_;
+  }
+
+  inline void set_cache_size(int size) { cache_size_ = size; }
+
+  inline const std::optional<std::string>& get_journal_mode() const {
+    return journal_mode_;
+  }
+
+  inline void set_journal_mode(std::string&& mode) {
+    journal_mode_ = std::move(mode);
+  }
+
+  inline const std::optional<int>& get_wal_autocheckpoint() const {
+    return wal_autocheckpoint_;
+  }
+
+  inline void set_wal_autocheckpoint(int pages) {
+    wal_autocheckpoint_ = pages;
+  }
+
+  inline void set_statement_cache_size(uint32_t size) {
+    statement_cache_size_ = size;
+  }
+
+  inline uint32_t get_statement_cache_size() const {
+    return statement_cache_size_;
+  }
 
  private:
   std::string location_;
@@ -45,10 +96,19 @@ class DatabaseOpenConfiguration {
   bool enable_foreign_keys_ = true;
   bool enable_dqs_ = false;
   int timeout_ = 0;
+  bool shared_cache_ = false;
+  // The settings that are left to the defaults of SQLite when they are not
+  // set.
+  std::optional<int64_t> mmap_size_;
+  std::optional<int> cache_size_;
+  std::optional<std::string> journal_mode_;
+  std::optional<int> wal_autocheckpoint_;
+  uint32_t statement_cache_size_ = 0;
 };
 
 class StatementSync;
 class BackupJob;
+class ResultColumn;
 
 class DatabaseSync : public BaseObject {
  public:
@@ -76,6 +136,8 @@ class DatabaseSync : public BaseObject {
   static void EnableLoadExtension(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoadExtension(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStatementCacheStatistics(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   void FinalizeStatements();
   void RemoveBackup(BackupJob* backup);
   void AddBackup(BackupJob* backup);
@@ -109,6 +171,17 @@ class DatabaseSync : public BaseObject {
   std::set<sqlite3_session*> sessions_;
   std::unordered_set<StatementSync*> statements_;
 
+  // The statements that prepare() returns again when it is called with the
+  // same SQL, from the most to the least recently used, and an index of them
+  // by their SQL. They are only cached if options.statementCacheSize is set.
+  using StatementCache =
+      std::list<std::pair<std::string, BaseObjectPtr<StatementSync>>>;
+  StatementCache statement_cache_;
+  std::unordered_map<std::string_view, StatementCache::iterator>
+      statement_cache_index_;
+  uint64_t statement_cache_hits_ = 0;
+  uint64_t statement_cache_misses_ = 0;
+
   friend class Session;
 };
 
@@ -125,9 +198,11 @@ class StatementSync : public BaseObject {
                                              BaseObjectPtr<DatabaseSync> db,
                                              sqlite3_stmt* stmt);
   static void All(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void AllColumnar(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Iterate(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Get(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Run(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void RunMany(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Columns(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SourceSQLGetter(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ExpandedSQLGetter(
@@ -153,11 +228,24 @@ class StatementSync : public BaseObject {
   bool allow_bare_named_params_;
   bool allow_unknown_named_params_;
   std::optional<std::map<std::string, std::string>> bare_named_params_;
+  std::vector<v8::Global<v8::Name>> column_names_;
+  int column_names_reprepare_count_ = 0;
   bool BindParams(const v8::FunctionCallbackInfo<v8::Value>& args);
+  bool MaybeCollectBareNamedParams();
+  // Looks up the index of a named parameter, which is 0 if the parameter is
+  // unknown and unknown named parameters are allowed.
+  bool NamedParamIndex(v8::Local<v8::Value> key, int* index);
+  bool BindNamedParams(v8::Local<v8::Object> obj);
+  bool BindAnonymousParam(const v8::Local<v8::Value>& value, int* index);
   bool BindValue(const v8::Local<v8::Value>& value, const int index);
   v8::MaybeLocal<v8::Value> ColumnToValue(const int column);
   v8::MaybeLocal<v8::Name> ColumnNameToName(const int column);
+  // Appends the names of the columns of the current row to names. They are
+  // only created once, instead of for every row.
+  bool GetColumnNames(v8::LocalVector<v8::Name>* names);
 
+  friend class DatabaseSync;
+  friend class ResultColumn;
   friend class StatementSyncIterator;
 };
 
@@ -212,6 +300,139 @@ class Session : public BaseObject {
   BaseObjectWeakPtr<DatabaseSync> database_;  // The Parent Database
 };
 
+// A value that is bound to a parameter or read from a column of a Statement.
+// It does not depend on V8, so that it can be passed between threads.
+using SQLiteValue = std::variant<std::monostate,  // NULL
+                                 int64_t,
+                                 double,
+                                 std::string,
+                                 std::vector<uint8_t>>;
+
+// An error that is reported by SQLite on the thread of a Database, which is
+// turned into an ERR_SQLITE_ERROR on the JavaScript thread.
+struct SQLiteError {
+  int errcode;
+  std::string message;
+};
+
+class CloseTask;
+class Statement;
+
+// The asynchronous counterpart of DatabaseSync. The connection is only used by
+// a dedicated thread, which runs the tasks that are posted to it one at a
+// time and in order, so that long running queries do not block the event
+// loop. The results are copied out of SQLite on that thread, and are only
+// converted to JavaScript values when the promises of the tasks are settled.
+class Database : public BaseObject {
+ public:
+  class Task {
+   public:
+    virtual ~Task() = default;
+
+    // Runs on the thread of the database.
+    virtual void Run(sqlite3* connection) = 0;
+    // Runs on the JavaScript thread after Run() succeeded, to create the
+    // value that the promise of the task is resolved with.
+    virtual v8::MaybeLocal<v8::Value> Result(Database* db) = 0;
+    // Whether the thread of the database stops after running the task.
+    virtual bool StopsThread() const { return false; }
+
+    // Records the last error of the connection, to reject the promise with.
+    void SetError(sqlite3* connection);
+
+   private:
+    friend class Database;
+
+    v8::Global<v8::Promise::Resolver> resolver_;
+    std::optional<SQLiteError> error_;
+  };
+
+  Database(Environment* env, v8::Local<v8::Object> object, sqlite3* connection);
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void IsOpenGetter(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void AsyncDispose(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Exec(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Prepare(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Posts a task to the thread of the database, and returns the promise that
+  // is settled with its result.
+  v8::MaybeLocal<v8::Promise> Post(std::unique_ptr<Task> task);
+  // Posts a task whose result is not waited for.
+  void PostWithoutResult(std::unique_ptr<Task> task);
+  bool IsOpen() const { return !closing_; }
+
+  SET_MEMORY_INFO_NAME(Database)
+  SET_SELF_SIZE(Database)
+
+ private:
+  ~Database() override;
+  static void ThreadMain(void* data);
+  static void OnCompleted(uv_async_t* async);
+  void Complete(std::unique_ptr<Task> task);
+  void OnClosed();
+  void Stop();
+
+  sqlite3* connection_;
+  uv_thread_t thread_;
+  uv_async_t* async_;
+  bool closing_ = false;
+  bool stopped_ = false;
+  // The number of tasks whose promise has not been settled yet. The database
+  // is kept alive and the event loop is kept running while there are any.
+  size_t outstanding_ = 0;
+  std::unordered_set<Statement*> statements_;
+
+  Mutex mutex_;
+  ConditionVariable pending_cond_;
+  std::deque<std::unique_ptr<Task>> pending_;
+  std::deque<std::unique_ptr<Task>> completed_;
+
+  friend class CloseTask;
+  friend class Statement;
+};
+
+class Statement : public BaseObject {
+ public:
+  Statement(Environment* env,
+            v8::Local<v8::Object> object,
+            BaseObjectPtr<Database> db,
+            sqlite3_stmt* stmt,
+            std::vector<std::string>&& parameter_names);
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+  static BaseObjectPtr<Statement> Create(
+      Environment* env,
+      BaseObjectPtr<Database> db,
+      sqlite3_stmt* stmt,
+      std::vector<std::string>&& parameter_names);
+
+  // The values to bind to the parameters, by their index.
+  using Bindings = std::vector<std::pair<int, SQLiteValue>>;
+
+  SET_MEMORY_INFO_NAME(Statement)
+  SET_SELF_SIZE(Statement)
+
+ private:
+  ~Statement() override;
+  bool IsFinalized() const { return statement_ == nullptr; }
+  bool CollectBindings(const v8::FunctionCallbackInfo<v8::Value>& args,
+                       Bindings* bindings);
+  template <typename StepTask>
+  static void Step(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  BaseObjectPtr<Database> db_;
+  // Only used on the thread of the database.
+  sqlite3_stmt* statement_;
+  // The names of the parameters as they appear in the SQL, or empty strings
+  // for anonymous parameters. The name of parameter i is at index i - 1.
+  std::vector<std::string> parameter_names_;
+
+  friend class Database;
+};
+
 class UserDefinedFunction {
  public:
   UserDefinedFunction(Environment* env,
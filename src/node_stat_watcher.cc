@@ -26,10 +26,15 @@
 #include "node_external_reference.h"
 #include "node_file-inl.h"
 #include "permission/permission.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include <cstdint>
 #include <cstring>
 #include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace node {
 
@@ -64,6 +69,172 @@ void StatWatcher::RegisterExternalReferences(
   registry->Register(StatWatcher::Start);
 }
 
+namespace {
+
+// Mirrors statbuf_eq() in libuv's fs-poll.c so that watchers report
+// exactly the changes uv_fs_poll would have reported.
+bool StatEqual(const uv_stat_t& a, const uv_stat_t& b) {
+  return a.st_ctim.tv_nsec == b.st_ctim.tv_nsec &&
+         a.st_mtim.tv_nsec == b.st_mtim.tv_nsec &&
+         a.st_birthtim.tv_nsec == b.st_birthtim.tv_nsec &&
+         a.st_ctim.tv_sec == b.st_ctim.tv_sec &&
+         a.st_mtim.tv_sec == b.st_mtim.tv_sec &&
+         a.st_birthtim.tv_sec == b.st_birthtim.tv_sec &&
+         a.st_size == b.st_size &&
+         a.st_mode == b.st_mode &&
+         a.st_uid == b.st_uid &&
+         a.st_gid == b.st_gid &&
+         a.st_ino == b.st_ino &&
+         a.st_dev == b.st_dev &&
+         a.st_flags == b.st_flags &&
+         a.st_gen == b.st_gen;
+}
+
+}  // anonymous namespace
+
+// All StatWatchers of a realm that poll at the same interval share one
+// timer. Every tick stats all of their files in a single threadpool job,
+// and only the watchers whose file changed are called back into JS.
+class StatWatcherGroup final {
+ public:
+  static void Join(StatWatcher* watcher, uint32_t interval);
+  void Leave(StatWatcher* watcher);
+
+ private:
+  class Sweep;
+
+  StatWatcherGroup(fs::BindingData* binding_data, uint32_t interval);
+
+  void Add(StatWatcher* watcher);
+  void StartSweep();
+  void OnSweepDone(Sweep* sweep, int status);
+  void Destroy();
+  static void OnTimer(uv_timer_t* handle);
+
+  fs::BindingData* const binding_data_;
+  const uint32_t interval_;
+  uv_timer_t timer_;
+  std::vector<StatWatcher*> watchers_;
+  bool sweeping_ = false;
+  // Set when watchers joined that do not have a baseline yet.
+  bool needs_sweep_ = false;
+};
+
+class StatWatcherGroup::Sweep final : public ThreadPoolWork {
+ public:
+  Sweep(Environment* env, StatWatcherGroup* group)
+      : ThreadPoolWork(env, "statWatcher", ThreadPoolWorkClass::kFileSystem),
+        group_(group) {}
+
+  void DoThreadPoolWork() override {
+    fs::StatPaths(paths_, &stats_, &errors_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<Sweep> self(this);
+    group_->OnSweepDone(this, status);
+  }
+
+ private:
+  friend class StatWatcherGroup;
+
+  StatWatcherGroup* const group_;
+  std::vector<BaseObjectPtr<StatWatcher>> watchers_;
+  std::vector<std::string> paths_;
+  std::vector<uv_stat_t> stats_;
+  std::vector<int> errors_;
+};
+
+StatWatcherGroup::StatWatcherGroup(fs::BindingData* binding_data,
+                                   uint32_t interval)
+    : binding_data_(binding_data), interval_(interval) {
+  CHECK_EQ(0, uv_timer_init(binding_data->env()->event_loop(), &timer_));
+  // Liveness is tracked by the handles of the individual watchers.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+}
+
+void StatWatcherGroup::Join(StatWatcher* watcher, uint32_t interval) {
+  // Like uv_fs_poll_start(), treat an interval of 0 as 1 millisecond.
+  if (interval == 0) interval = 1;
+  fs::BindingData* binding_data = watcher->binding_data_.get();
+  StatWatcherGroup*& group = binding_data->stat_watcher_groups[interval];
+  if (group == nullptr) group = new StatWatcherGroup(binding_data, interval);
+  group->Add(watcher);
+}
+
+void StatWatcherGroup::Add(StatWatcher* watcher) {
+  watcher->group_ = this;
+  watcher->group_index_ = watchers_.size();
+  watchers_.push_back(watcher);
+
+  // uv_fs_poll stats the file as soon as it is started, so take the
+  // baseline of new watchers right away rather than one interval later.
+  // Restarting the timer coalesces watchers added in the same tick.
+  needs_sweep_ = true;
+  if (!sweeping_) uv_timer_start(&timer_, OnTimer, 0, interval_);
+}
+
+void StatWatcherGroup::Leave(StatWatcher* watcher) {
+  CHECK_EQ(watcher->group_, this);
+  const size_t index = watcher->group_index_;
+  watchers_[index] = watchers_.back();
+  watchers_[index]->group_index_ = index;
+  watchers_.pop_back();
+  watcher->group_ = nullptr;
+
+  // While sweeping, OnSweepDone() takes care of an empty group.
+  if (watchers_.empty() && !sweeping_) Destroy();
+}
+
+void StatWatcherGroup::OnTimer(uv_timer_t* handle) {
+  StatWatcherGroup* group = ContainerOf(&StatWatcherGroup::timer_, handle);
+  // Skip the tick if the previous sweep has not finished yet.
+  if (!group->sweeping_) group->StartSweep();
+}
+
+void StatWatcherGroup::StartSweep() {
+  Sweep* sweep = new Sweep(binding_data_->env(), this);
+  sweep->watchers_.reserve(watchers_.size());
+  sweep->paths_.reserve(watchers_.size());
+  for (StatWatcher* watcher : watchers_) {
+    sweep->watchers_.emplace_back(watcher);
+    sweep->paths_.push_back(watcher->path_);
+  }
+  sweeping_ = true;
+  needs_sweep_ = false;
+  sweep->ScheduleWork();
+}
+
+void StatWatcherGroup::OnSweepDone(Sweep* sweep, int status) {
+  Environment* env = binding_data_->env();
+  if (status == 0 && env->can_call_into_js()) {
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    for (size_t i = 0; i < sweep->watchers_.size(); i++) {
+      StatWatcher* watcher = sweep->watchers_[i].get();
+      // The watcher may have been closed by an earlier callback.
+      if (watcher->group_ != this) continue;
+      watcher->OnPoll(sweep->errors_[i], &sweep->stats_[i]);
+    }
+  }
+  sweeping_ = false;
+
+  if (watchers_.empty()) {
+    Destroy();
+  } else if (needs_sweep_) {
+    uv_timer_start(&timer_, OnTimer, 0, interval_);
+  }
+}
+
+void StatWatcherGroup::Destroy() {
+  CHECK(watchers_.empty());
+  CHECK(!sweeping_);
+  binding_data_->stat_watcher_groups.erase(interval_);
+  binding_data_->env()->CloseHandle(&timer_, [](uv_timer_t* handle) {
+    delete ContainerOf(&StatWatcherGroup::timer_, handle);
+  });
+}
+
 StatWatcher::StatWatcher(fs::BindingData* binding_data,
                          Local<Object> wrap,
                          bool use_bigint)
@@ -73,26 +244,50 @@ StatWatcher::StatWatcher(fs::BindingData* binding_data,
                  AsyncWrap::PROVIDER_STATWATCHER),
       use_bigint_(use_bigint),
       binding_data_(binding_data) {
-  CHECK_EQ(0, uv_fs_poll_init(env()->event_loop(), &watcher_));
+  CHECK_EQ(0, uv_timer_init(env()->event_loop(), &watcher_));
 }
 
+void StatWatcher::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("path", path_);
+}
+
+void StatWatcher::Close(Local<Value> close_callback) {
+  if (group_ != nullptr) group_->Leave(this);
+  HandleWrap::Close(close_callback);
+}
 
-void StatWatcher::Callback(uv_fs_poll_t* handle,
-                           int status,
+void StatWatcher::OnPoll(int status, const uv_stat_t* curr) {
+  if (status != 0) {
+    if (poll_status_ != status) {
+      poll_status_ = status;
+      uv_stat_t zero_stat = {};
+      Callback(status, &prev_stat_, &zero_stat);
+    }
+    return;
+  }
+
+  const bool changed =
+      poll_status_ < 0 ||
+      (poll_status_ != 0 && !StatEqual(prev_stat_, *curr));
+  const uv_stat_t prev = prev_stat_;
+  prev_stat_ = *curr;
+  poll_status_ = 1;
+  if (changed) Callback(0, &prev, curr);
+}
+
+void StatWatcher::Callback(int status,
                            const uv_stat_t* prev,
                            const uv_stat_t* curr) {
-  StatWatcher* wrap = ContainerOf(&StatWatcher::watcher_, handle);
-  Environment* env = wrap->env();
+  Environment* env = this->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
   Local<Value> arr = fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, curr);
-  USE(fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, prev, true));
+      binding_data_.get(), use_bigint_, curr);
+  USE(fs::FillGlobalStatsArray(binding_data_.get(), use_bigint_, prev, true));
 
   Local<Value> argv[2] = { Integer::New(env->isolate(), status), arr };
-  wrap->MakeCallback(env->onchange_string(), arraysize(argv), argv);
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
 }
 
 
@@ -120,12 +315,18 @@ void StatWatcher::Start(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[1]->IsUint32());
   const uint32_t interval = args[1].As<Uint32>()->Value();
 
-  // Note that uv_fs_poll_start does not return ENOENT, we are handling
-  // mostly memory errors here.
-  const int err = uv_fs_poll_start(&wrap->watcher_, Callback, *path, interval);
+  // Make the handle active so that ref()/unref() control whether the
+  // watcher keeps the loop alive, as with uv_fs_poll. The timeout is
+  // clamped by libuv and never expires.
+  const int err = uv_timer_start(
+      &wrap->watcher_, [](uv_timer_t*) {}, UINT64_MAX, 0);
   if (err != 0) {
     args.GetReturnValue().Set(err);
+    return;
   }
+
+  wrap->path_ = *path;
+  StatWatcherGroup::Join(wrap, interval);
 }
 
 }  // namespace node
@@ -29,6 +29,8 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <string>
+
 namespace node {
 namespace fs {
 class BindingData;
@@ -36,6 +38,7 @@ class BindingData;
 
 class Environment;
 class ExternalReferenceRegistry;
+class StatWatcherGroup;
 
 class StatWatcher : public HandleWrap {
  public:
@@ -51,19 +54,36 @@ class StatWatcher : public HandleWrap {
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
 
-  SET_NO_MEMORY_INFO()
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(StatWatcher)
   SET_SELF_SIZE(StatWatcher)
 
  private:
-  static void Callback(uv_fs_poll_t* handle,
-                       int status,
-                       const uv_stat_t* prev,
-                       const uv_stat_t* curr);
+  friend class StatWatcherGroup;
 
-  uv_fs_poll_t watcher_;
+  // Applies the result of one poll, following the same rules as
+  // uv_fs_poll: the first successful stat only records a baseline, and
+  // JS is called only when the status or the stat data changed.
+  void OnPoll(int status, const uv_stat_t* curr);
+  void Callback(int status, const uv_stat_t* prev, const uv_stat_t* curr);
+
+  // Polling is driven by the shared timer of the StatWatcherGroup. This
+  // timer is started with an infinite timeout and never fires; it only
+  // makes the handle active while watching and carries the ref state.
+  uv_timer_t watcher_;
   const bool use_bigint_;
   BaseObjectPtr<fs::BindingData> binding_data_;
+
+  std::string path_;
+  StatWatcherGroup* group_ = nullptr;
+  size_t group_index_ = 0;
+  uv_stat_t prev_stat_ = {};
+  // 0 before the first poll, 1 after a successful poll, otherwise the
+  // error of the last poll.
+  int poll_status_ = 0;
 };
 
 }  // namespace node
@@ -0,0 +1,251 @@
+#include "env-inl.h"
+#include "node_binding.h"
+#include "node_external_reference.h"
+#include "node_mutex.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace node {
+namespace stdio_writer {
+
+using v8::ArrayBufferView;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Int32;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Value;
+
+namespace {
+
+// An AsyncStdioWriter copies what is written to stdout or stderr into a
+// bounded ring buffer, from which a thread of its own writes it to the file
+// descriptor. Everything that has accumulated while a write was in progress
+// is written with the next one, so many small writes turn into a few large
+// ones. When the buffer is full, writes either wait for the thread to make
+// room or are dropped and counted.
+class AsyncStdioWriter {
+ public:
+  AsyncStdioWriter(int fd, size_t capacity, bool drop_when_full);
+  // Writes out what is still buffered before the thread is stopped.
+  ~AsyncStdioWriter();
+
+  AsyncStdioWriter(const AsyncStdioWriter&) = delete;
+  AsyncStdioWriter& operator=(const AsyncStdioWriter&) = delete;
+
+  void Write(const char* data, size_t length);
+  // Waits until everything that has been written so far has been written to
+  // the file descriptor.
+  void Flush();
+  uint64_t dropped_bytes();
+
+ private:
+  static void ThreadMain(void* data);
+  // Returns the number of bytes that could not be written.
+  size_t WriteToFd(uv_buf_t* bufs, unsigned int nbufs);
+
+  const int fd_;
+  const size_t capacity_;
+  const bool drop_when_full_;
+  std::unique_ptr<char[]> buffer_;
+  Mutex mutex_;
+  ConditionVariable data_cond_;
+  ConditionVariable space_cond_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  uint64_t dropped_bytes_ = 0;
+  bool stopping_ = false;
+  uv_thread_t thread_;
+};
+
+// Indexed by file descriptor. The writers are only ever created from the main
+// thread, and are destroyed, flushing them, when the process exits.
+std::unique_ptr<AsyncStdioWriter> writers[3];
+
+AsyncStdioWriter::AsyncStdioWriter(int fd, size_t capacity, bool drop_when_full)
+    : fd_(fd),
+      capacity_(capacity),
+      drop_when_full_(drop_when_full),
+      buffer_(new char[capacity]) {
+  CHECK_EQ(uv_thread_create(&thread_, ThreadMain, this), 0);
+}
+
+AsyncStdioWriter::~AsyncStdioWriter() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    stopping_ = true;
+    data_cond_.Signal(lock);
+  }
+  CHECK_EQ(uv_thread_join(&thread_), 0);
+}
+
+void AsyncStdioWriter::Write(const char* data, size_t length) {
+  Mutex::ScopedLock lock(mutex_);
+  if (drop_when_full_ && length > capacity_ - size_) {
+    dropped_bytes_ += length;
+    return;
+  }
+  while (length > 0) {
+    while (size_ == capacity_) space_cond_.Wait(lock);
+    size_t tail = (head_ + size_) % capacity_;
+    size_t n = std::min({length, capacity_ - size_, capacity_ - tail});
+    std::copy(data, data + n, buffer_.get() + tail);
+    size_ += n;
+    data += n;
+    length -= n;
+    data_cond_.Signal(lock);
+  }
+}
+
+void AsyncStdioWriter::Flush() {
+  Mutex::ScopedLock lock(mutex_);
+  while (size_ > 0) space_cond_.Wait(lock);
+}
+
+uint64_t AsyncStdioWriter::dropped_bytes() {
+  Mutex::ScopedLock lock(mutex_);
+  return dropped_bytes_;
+}
+
+size_t AsyncStdioWriter::WriteToFd(uv_buf_t* bufs, unsigned int nbufs) {
+  while (nbufs > 0) {
+    uv_fs_t req;
+    int r = uv_fs_write(nullptr, &req, fd_, bufs, nbufs, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (r == UV_EAGAIN) {
+      // The file descriptor may have been made non-blocking by another
+      // process that shares it.
+      uv_sleep(1);
+      continue;
+    }
+    if (r < 0) {
+      // The output is gone (e.g. EPIPE), so the rest is discarded.
+      size_t remaining = 0;
+      for (unsigned int i = 0; i < nbufs; i++) remaining += bufs[i].len;
+      return remaining;
+    }
+    size_t written = r;
+    while (nbufs > 0 && written >= bufs[0].len) {
+      written -= bufs[0].len;
+      bufs++;
+      nbufs--;
+    }
+    if (nbufs > 0) {
+      bufs[0].base += written;
+      bufs[0].len -= written;
+    }
+  }
+  return 0;
+}
+
+void AsyncStdioWriter::ThreadMain(void* data) {
+  AsyncStdioWriter* writer = static_cast<AsyncStdioWriter*>(data);
+  Mutex::ScopedLock lock(writer->mutex_);
+  while (true) {
+    while (writer->size_ == 0 && !writer->stopping_)
+      writer->data_cond_.Wait(lock);
+    if (writer->size_ == 0) return;
+
+    // Everything that is buffered is written at once, in at most two pieces.
+    // Writers only append to the free part of the buffer, so it can be read
+    // without holding the lock.
+    size_t size = writer->size_;
+    size_t first = std::min(size, writer->capacity_ - writer->head_);
+    uv_buf_t bufs[] = {
+        uv_buf_init(writer->buffer_.get() + writer->head_, first),
+        uv_buf_init(writer->buffer_.get(), size - first)};
+    size_t failed;
+    {
+      Mutex::ScopedUnlock unlock(lock);
+      failed = writer->WriteToFd(bufs, size > first ? 2 : 1);
+    }
+    writer->head_ = (writer->head_ + size) % writer->capacity_;
+    writer->size_ -= size;
+    writer->dropped_bytes_ += failed;
+    writer->space_cond_.Broadcast(lock);
+  }
+}
+
+AsyncStdioWriter* GetWriter(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsInt32());
+  int fd = args[0].As<Int32>()->Value();
+  CHECK(fd == 1 || fd == 2);
+  CHECK(writers[fd]);
+  return writers[fd].get();
+}
+
+// start(fd, capacity, dropWhenFull)
+void Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(env->is_main_thread());
+  CHECK(args[0]->IsInt32());
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsBoolean());
+  int fd = args[0].As<Int32>()->Value();
+  CHECK(fd == 1 || fd == 2);
+  size_t capacity = static_cast<size_t>(args[1].As<Number>()->Value());
+  CHECK_GT(capacity, 0);
+  if (writers[fd]) return;
+  writers[fd] = std::make_unique<AsyncStdioWriter>(
+      fd, capacity, args[2]->IsTrue());
+}
+
+// writeBuffer(fd, view)
+void WriteBuffer(const FunctionCallbackInfo<Value>& args) {
+  AsyncStdioWriter* writer = GetWriter(args);
+  CHECK(args[1]->IsArrayBufferView());
+  ArrayBufferViewContents<char> contents(args[1].As<ArrayBufferView>());
+  writer->Write(contents.data(), contents.length());
+}
+
+// writeUtf8String(fd, string)
+void WriteUtf8String(const FunctionCallbackInfo<Value>& args) {
+  AsyncStdioWriter* writer = GetWriter(args);
+  CHECK(args[1]->IsString());
+  Utf8Value value(args.GetIsolate(), args[1]);
+  writer->Write(*value, value.length());
+}
+
+// flush(fd)
+void Flush(const FunctionCallbackInfo<Value>& args) {
+  GetWriter(args)->Flush();
+}
+
+// getDroppedBytes(fd)
+void GetDroppedBytes(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(
+      static_cast<double>(GetWriter(args)->dropped_bytes()));
+}
+
+}  // anonymous namespace
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  SetMethod(context, target, "start", Start);
+  SetMethod(context, target, "writeBuffer", WriteBuffer);
+  SetMethod(context, target, "writeUtf8String", WriteUtf8String);
+  SetMethod(context, target, "flush", Flush);
+  SetMethodNoSideEffect(context, target, "getDroppedBytes", GetDroppedBytes);
+}
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Start);
+  registry->Register(WriteBuffer);
+  registry->Register(WriteUtf8String);
+  registry->Register(Flush);
+  registry->Register(GetDroppedBytes);
+}
+
+}  // namespace stdio_writer
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(stdio_writer,
+                                    node::stdio_writer::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(stdio_writer,
+                                node::stdio_writer::RegisterExternalReferences)
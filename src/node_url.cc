@@ -8,18 +8,24 @@
 #include "node_metadata.h"
 #include "node_process-inl.h"
 #include "path.h"
+#include "simdutf.h"
+#include "string_bytes_simd.h"
 #include "util-inl.h"
 #include "v8-fast-api-calls.h"
 #include "v8-local-handle.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <numeric>
+#include <string>
 
 namespace node {
 namespace url {
 
+using v8::Array;
+using v8::ArrayBuffer;
 using v8::CFunction;
 using v8::Context;
 using v8::FastApiCallbackOptions;
@@ -27,10 +33,15 @@ using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Isolate;
 using v8::Local;
+using v8::LocalVector;
+using v8::MaybeLocal;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SnapshotCreator;
 using v8::String;
+using v8::Uint32Array;
 using v8::Value;
 
 void BindingData::MemoryInfo(MemoryTracker* tracker) const {
@@ -416,6 +427,188 @@ void BindingData::Parse(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void BindingData::ParseMany(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsArray());  // inputs
+  // args[1] // base url
+
+  Realm* realm = Realm::GetCurrent(args);
+  Isolate* isolate = realm->isolate();
+  Local<Context> context = realm->context();
+  Local<Array> inputs = args[0].As<Array>();
+
+  ada::result<ada::url_aggregator> base;
+  ada::url_aggregator* base_pointer = nullptr;
+  if (args[1]->IsString()) {
+    Utf8Value base_(isolate, args[1]);
+    base = ada::parse<ada::url_aggregator>(base_.ToStringView());
+    if (!base) {
+      return ThrowInvalidURL(realm->env(), base_.ToStringView(), std::nullopt);
+    }
+    base_pointer = &base.value();
+  }
+
+  // The components of the i-th URL are stored at [i * kURLComponentsLength,
+  // (i + 1) * kURLComponentsLength) in the same layout as urlComponents.
+  const uint32_t length = inputs->Length();
+  const size_t components_length = size_t{length} * kURLComponentsLength;
+  Local<ArrayBuffer> buffer =
+      ArrayBuffer::New(isolate, components_length * sizeof(uint32_t));
+  uint32_t* components = static_cast<uint32_t*>(buffer->Data());
+  LocalVector<Value> hrefs(isolate, length);
+
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> input;
+    if (!inputs->Get(context, i).ToLocal(&input)) {
+      return;
+    }
+    CHECK(input->IsString());
+    Utf8Value input_utf8(isolate, input);
+    auto out = ada::parse<ada::url_aggregator>(input_utf8.ToStringView(),
+                                               base_pointer);
+    uint32_t* url_components = components + size_t{i} * kURLComponentsLength;
+    if (!out) {
+      std::fill_n(url_components, kURLComponentsLength, 0);
+      hrefs[i] = Null(isolate);
+      continue;
+    }
+
+    const ada::url_components& c = out->get_components();
+    url_components[0] = c.protocol_end;
+    url_components[1] = c.username_end;
+    url_components[2] = c.host_start;
+    url_components[3] = c.host_end;
+    url_components[4] = c.port;
+    url_components[5] = c.pathname_start;
+    url_components[6] = c.search_start;
+    url_components[7] = c.hash_start;
+    url_components[8] = out->type;
+
+    // Inputs that are already serialized are returned as they are, which
+    // avoids creating a new string for them.
+    std::string_view href = out->get_href();
+    if (href == input_utf8.ToStringView()) {
+      hrefs[i] = input;
+    } else if (!ToV8Value(context, href, isolate).ToLocal(&hrefs[i])) {
+      return;
+    }
+  }
+
+  Local<Value> result[] = {
+      Array::New(isolate, hrefs.data(), hrefs.size()),
+      Uint32Array::New(buffer, 0, components_length),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
+}
+
+// Returns the byte that the percent-escape at `input[i]` encodes, or -1 if
+// it is a '%' that isn't followed by two hex digits.
+static int DecodePercentEscape(std::string_view input, size_t i) {
+  if (i + 2 >= input.size()) return -1;
+  int hi = nbytes::unhex_table[static_cast<uint8_t>(input[i + 1])];
+  int lo = nbytes::unhex_table[static_cast<uint8_t>(input[i + 2])];
+  if (hi < 0 || lo < 0) return -1;
+  return hi << 4 | lo;
+}
+
+// Creates the string of the application/x-www-form-urlencoded `input`, with
+// '+' replaced by a space and the percent-escapes decoded. Sequences that are
+// not valid UTF-8 are replaced by U+FFFD.
+//
+// querystring.unescape() decodes such strings, and strings that contain a
+// '%' that doesn't start an escape, byte by byte, which truncates the
+// characters that aren't ASCII. If `legacy` is true, `*mismatch` is set for
+// the strings where the results differ.
+static MaybeLocal<String> DecodeFormUrlencoded(Isolate* isolate,
+                                               std::string_view input,
+                                               std::string* scratch,
+                                               bool legacy,
+                                               bool* mismatch) {
+  size_t i = simd::FindFormUrlencodedEscape(input.data(), 0, input.size());
+  if (i == input.size()) {
+    return String::NewFromUtf8(
+        isolate, input.data(), v8::NewStringType::kNormal, input.size());
+  }
+
+  bool invalid_escape = false;
+  scratch->assign(input.data(), i);
+  while (i < input.size()) {
+    if (input[i] == '+') {
+      scratch->push_back(' ');
+      i++;
+    } else if (int byte = DecodePercentEscape(input, i); byte >= 0) {
+      scratch->push_back(static_cast<char>(byte));
+      i += 3;
+    } else {
+      invalid_escape = true;
+      scratch->push_back('%');
+      i++;
+    }
+    size_t next =
+        simd::FindFormUrlencodedEscape(input.data(), i, input.size());
+    scratch->append(input.data() + i, next - i);
+    i = next;
+  }
+
+  if (legacy && !simdutf::validate_ascii(input.data(), input.size()) &&
+      (invalid_escape ||
+       !simdutf::validate_utf8(scratch->data(), scratch->size()))) {
+    *mismatch = true;
+  }
+  return String::NewFromUtf8(
+      isolate, scratch->data(), v8::NewStringType::kNormal, scratch->size());
+}
+
+// parseSearchParams(input, maxPairs, legacy) splits `input` at '&' and every
+// pair at its first '=', and returns the decoded names and values as one flat
+// array [name0, value0, name1, value1, ...]. Empty pairs are skipped. If
+// `maxPairs` is positive, only that many pairs, empty ones included, are
+// parsed, which is how querystring.parse() counts its maxKeys. If `legacy` is
+// true and a name or value would not be decoded the way querystring.unescape()
+// decodes it, undefined is returned instead.
+void BindingData::ParseSearchParams(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());   // input
+  CHECK(args[1]->IsNumber());   // maxPairs
+  CHECK(args[2]->IsBoolean());  // legacy
+
+  Isolate* isolate = args.GetIsolate();
+  Utf8Value input_utf8(isolate, args[0]);
+  std::string_view input = input_utf8.ToStringView();
+  const double max_pairs = args[1].As<Number>()->Value();
+  const bool legacy = args[2]->IsTrue();
+
+  LocalVector<Value> result(isolate);
+  std::string scratch;
+  bool mismatch = false;
+  double pairs = 0;
+  size_t start = 0;
+  while (start <= input.size() && (max_pairs <= 0 || pairs < max_pairs)) {
+    size_t end = input.find('&', start);
+    if (end == std::string_view::npos) end = input.size();
+    std::string_view pair = input.substr(start, end - start);
+    start = end + 1;
+    pairs++;
+    if (pair.empty()) continue;
+
+    size_t eq = pair.find('=');
+    std::string_view name = pair.substr(0, eq);
+    std::string_view value =
+        eq == std::string_view::npos ? std::string_view() : pair.substr(eq + 1);
+    Local<String> name_string;
+    Local<String> value_string;
+    if (!DecodeFormUrlencoded(isolate, name, &scratch, legacy, &mismatch)
+             .ToLocal(&name_string) ||
+        !DecodeFormUrlencoded(isolate, value, &scratch, legacy, &mismatch)
+             .ToLocal(&value_string)) {
+      return;
+    }
+    if (mismatch) return;
+    result.push_back(name_string);
+    result.push_back(value_string);
+  }
+
+  args.GetReturnValue().Set(Array::New(isolate, result.data(), result.size()));
+}
+
 void BindingData::Update(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsString());    // href
   CHECK(args[1]->IsNumber());    // action type
@@ -520,6 +713,9 @@ void BindingData::CreatePerIsolateProperties(IsolateData* isolate_data,
   SetMethodNoSideEffect(isolate, target, "format", Format);
   SetMethodNoSideEffect(isolate, target, "getOrigin", GetOrigin);
   SetMethod(isolate, target, "parse", Parse);
+  SetMethod(isolate, target, "parseMany", ParseMany);
+  SetMethodNoSideEffect(
+      isolate, target, "parseSearchParams", ParseSearchParams);
   SetMethod(isolate, target, "pathToFileURL", PathToFileURL);
   SetMethod(isolate, target, "update", Update);
   SetFastMethodNoSideEffect(
@@ -541,6 +737,8 @@ void BindingData::RegisterExternalReferences(
   registry->Register(Format);
   registry->Register(GetOrigin);
   registry->Register(Parse);
+  registry->Register(ParseMany);
+  registry->Register(ParseSearchParams);
   registry->Register(PathToFileURL);
   registry->Register(Update);
   registry->Register(CanParse);
@@ -64,6 +64,9 @@ class BindingData : public SnapshotableObject {
   static void Format(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetOrigin(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Parse(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ParseMany(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ParseSearchParams(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void PathToFileURL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
 
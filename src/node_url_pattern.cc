@@ -8,6 +8,9 @@
 #include "path.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace node {
 using node::url_pattern::URLPatternRegexProvider;
 
@@ -58,6 +61,7 @@ using v8::DontDelete;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
+using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::LocalVector;
@@ -518,38 +522,51 @@ bool URLPattern::Test(Environment* env,
 
 // V8 Methods
 
-void URLPattern::Exec(const FunctionCallbackInfo<Value>& args) {
-  URLPattern* url_pattern;
-  ASSIGN_OR_RETURN_UNWRAP(&url_pattern, args.This());
-  auto env = Environment::GetCurrent(args);
-
-  ada::url_pattern_input input;
-  std::optional<std::string> baseURL{};
-  std::string input_base;
+// Parses the (input[, baseURL]) arguments of exec() and test(). A string
+// input is stored in `input_base`, which must outlive `input`. Returns false
+// if an exception is pending.
+static bool ParseMatchArguments(Environment* env,
+                                const FunctionCallbackInfo<Value>& args,
+                                ada::url_pattern_input* input,
+                                std::string* input_base,
+                                std::optional<std::string>* base_url) {
   if (args.Length() == 0) {
-    input = ada::url_pattern_init{};
+    *input = ada::url_pattern_init{};
   } else if (args[0]->IsString()) {
     Utf8Value input_value(env->isolate(), args[0].As<String>());
-    input_base = input_value.ToString();
-    input = std::string_view(input_base);
+    *input_base = input_value.ToString();
+    *input = std::string_view(*input_base);
   } else if (args[0]->IsObject()) {
-    auto maybeInput = URLPatternInit::FromJsObject(env, args[0].As<Object>());
-    if (!maybeInput.has_value()) return;
-    input = std::move(*maybeInput);
+    auto maybeInput =
+        URLPattern::URLPatternInit::FromJsObject(env, args[0].As<Object>());
+    if (!maybeInput.has_value()) return false;
+    *input = std::move(*maybeInput);
   } else {
     THROW_ERR_INVALID_ARG_TYPE(
         env, "URLPattern input needs to be a string or an object");
-    return;
+    return false;
   }
 
   if (args.Length() > 1) {
     if (!args[1]->IsString()) {
       THROW_ERR_INVALID_ARG_TYPE(env, "baseURL must be a string");
-      return;
+      return false;
     }
     Utf8Value base_url_value(env->isolate(), args[1].As<String>());
-    baseURL = base_url_value.ToStringView();
+    *base_url = base_url_value.ToString();
   }
+  return true;
+}
+
+void URLPattern::Exec(const FunctionCallbackInfo<Value>& args) {
+  URLPattern* url_pattern;
+  ASSIGN_OR_RETURN_UNWRAP(&url_pattern, args.This());
+  auto env = Environment::GetCurrent(args);
+
+  ada::url_pattern_input input;
+  std::optional<std::string> baseURL{};
+  std::string input_base;
+  if (!ParseMatchArguments(env, args, &input, &input_base, &baseURL)) return;
 
   Local<Value> result;
   std::optional<std::string_view> baseURL_opt =
@@ -569,30 +586,7 @@ void URLPattern::Test(const FunctionCallbackInfo<Value>& args) {
   ada::url_pattern_input input;
   std::optional<std::string> baseURL{};
   std::string input_base;
-  if (args.Length() == 0) {
-    input = ada::url_pattern_init{};
-  } else if (args[0]->IsString()) {
-    Utf8Value input_value(env->isolate(), args[0].As<String>());
-    input_base = input_value.ToString();
-    input = std::string_view(input_base);
-  } else if (args[0]->IsObject()) {
-    auto maybeInput = URLPatternInit::FromJsObject(env, args[0].As<Object>());
-    if (!maybeInput.has_value()) return;
-    input = std::move(*maybeInput);
-  } else {
-    THROW_ERR_INVALID_ARG_TYPE(
-        env, "URLPattern input needs to be a string or an object");
-    return;
-  }
-
-  if (args.Length() > 1) {
-    if (!args[1]->IsString()) {
-      THROW_ERR_INVALID_ARG_TYPE(env, "baseURL must be a string");
-      return;
-    }
-    Utf8Value base_url_value(env->isolate(), args[1].As<String>());
-    baseURL = base_url_value.ToStringView();
-  }
+  if (!ParseMatchArguments(env, args, &input, &input_base, &baseURL)) return;
 
   std::optional<std::string_view> baseURL_opt =
       baseURL ? std::optional<std::string_view>(*baseURL) : std::nullopt;
@@ -617,6 +611,181 @@ void URLPattern::HasRegexpGroups(const FunctionCallbackInfo<Value>& info) {
   info.GetReturnValue().Set(url_pattern->HasRegExpGroups());
 }
 
+// Returns the part of the pathname pattern that every pathname matched by
+// the pattern starts with. Patterns that ignore case are not indexed.
+static std::string_view LiteralPathnamePrefix(
+    const ada::url_pattern<URLPatternRegexProvider>& pattern) {
+  if (pattern.ignore_case()) return {};
+  std::string_view pathname = pattern.get_pathname();
+  size_t end = pathname.find_first_of(":*(){}\\");
+  if (end == std::string_view::npos) return pathname;
+  // A "/" directly before a group is its prefix, which is optional when the
+  // group is, e.g. "/users/:id?" matches "/users".
+  if (end > 0 && pathname[end - 1] == '/') end--;
+  return pathname.substr(0, end);
+}
+
+URLPatternList::URLPatternList(
+    Environment* env,
+    Local<Object> object,
+    std::vector<BaseObjectPtr<URLPattern>>&& patterns)
+    : BaseObject(env, object), patterns_(std::move(patterns)) {
+  MakeWeak();
+  for (size_t i = 0; i < patterns_.size(); i++) {
+    TrieNode* node = &root_;
+    for (char c : LiteralPathnamePrefix(patterns_[i]->url_pattern_)) {
+      std::unique_ptr<TrieNode>& child = node->children[c];
+      if (!child) child = std::make_unique<TrieNode>();
+      node = child.get();
+    }
+    node->patterns.push_back(i);
+  }
+}
+
+void URLPatternList::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("patterns", patterns_);
+}
+
+void URLPatternList::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args.IsConstructCall()) {
+    THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+    return;
+  }
+
+  if (!args[0]->IsArray()) {
+    THROW_ERR_INVALID_ARG_TYPE(env, "patterns must be an array");
+    return;
+  }
+  Local<Array> array = args[0].As<Array>();
+  std::vector<BaseObjectPtr<URLPattern>> patterns;
+  patterns.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> value;
+    if (!array->Get(env->context(), i).ToLocal(&value)) return;
+    if (!env->url_pattern_constructor_template()->HasInstance(value)) {
+      THROW_ERR_INVALID_ARG_TYPE(
+          env, "patterns must only contain URLPattern objects");
+      return;
+    }
+    patterns.emplace_back(Unwrap<URLPattern>(value.As<Object>()));
+  }
+
+  new URLPatternList(env, args.This(), std::move(patterns));
+}
+
+bool URLPatternList::CollectCandidates(const ada::url_pattern_input& input,
+                                       const std::string_view* base_url,
+                                       std::vector<size_t>* candidates) const {
+  if (!std::holds_alternative<std::string_view>(input)) {
+    candidates->resize(patterns_.size());
+    std::iota(candidates->begin(), candidates->end(), 0);
+    return true;
+  }
+
+  ada::result<ada::url_aggregator> base;
+  if (base_url != nullptr) {
+    base = ada::parse<ada::url_aggregator>(*base_url);
+    if (!base) return false;
+  }
+  auto url = ada::parse<ada::url_aggregator>(std::get<std::string_view>(input),
+                                             base ? &*base : nullptr);
+  if (!url) return false;
+
+  const TrieNode* node = &root_;
+  candidates->assign(node->patterns.begin(), node->patterns.end());
+  for (char c : url->get_pathname()) {
+    auto it = node->children.find(c);
+    if (it == node->children.end()) break;
+    node = it->second.get();
+    candidates->insert(
+        candidates->end(), node->patterns.begin(), node->patterns.end());
+  }
+  std::sort(candidates->begin(), candidates->end());
+  return true;
+}
+
+bool URLPatternList::Match(
+    const ada::url_pattern_input& input,
+    const std::string_view* base_url,
+    std::optional<std::pair<size_t, ada::url_pattern_result>>* match) const {
+  std::vector<size_t> candidates;
+  if (!CollectCandidates(input, base_url, &candidates)) return true;
+  for (size_t index : candidates) {
+    auto result = patterns_[index]->url_pattern_.exec(input, base_url);
+    if (!result) return false;
+    if (result->has_value()) {
+      match->emplace(index, std::move(result->value()));
+      return true;
+    }
+  }
+  return true;
+}
+
+void URLPatternList::Exec(const FunctionCallbackInfo<Value>& args) {
+  URLPatternList* list;
+  ASSIGN_OR_RETURN_UNWRAP(&list, args.This());
+  auto env = Environment::GetCurrent(args);
+  auto isolate = env->isolate();
+
+  ada::url_pattern_input input;
+  std::optional<std::string> baseURL{};
+  std::string input_base;
+  if (!ParseMatchArguments(env, args, &input, &input_base, &baseURL)) return;
+
+  std::string_view base_url_view;
+  if (baseURL) base_url_view = *baseURL;
+  std::optional<std::pair<size_t, ada::url_pattern_result>> match;
+  if (!list->Match(input, baseURL ? &base_url_view : nullptr, &match)) {
+    THROW_ERR_OPERATION_FAILED(env, "Failed to exec URLPatternList");
+    return;
+  }
+  if (!match) {
+    args.GetReturnValue().SetNull();
+    return;
+  }
+
+  Local<Value> result;
+  if (!URLPattern::URLPatternResult::ToJSValue(env, match->second)
+           .ToLocal(&result)) {
+    return;
+  }
+  Local<Name> names[] = {env->index_string(), env->result_string()};
+  Local<Value> values[] = {
+      Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(match->first)),
+      result,
+  };
+  args.GetReturnValue().Set(Object::New(
+      isolate, Object::New(isolate), names, values, arraysize(names)));
+}
+
+void URLPatternList::Test(const FunctionCallbackInfo<Value>& args) {
+  URLPatternList* list;
+  ASSIGN_OR_RETURN_UNWRAP(&list, args.This());
+  auto env = Environment::GetCurrent(args);
+
+  ada::url_pattern_input input;
+  std::optional<std::string> baseURL{};
+  std::string input_base;
+  if (!ParseMatchArguments(env, args, &input, &input_base, &baseURL)) return;
+
+  std::string_view base_url_view;
+  if (baseURL) base_url_view = *baseURL;
+  std::optional<std::pair<size_t, ada::url_pattern_result>> match;
+  if (!list->Match(input, baseURL ? &base_url_view : nullptr, &match)) {
+    THROW_ERR_OPERATION_FAILED(env, "Failed to test URLPatternList");
+    return;
+  }
+  args.GetReturnValue().Set(match.has_value());
+}
+
+void URLPatternList::Length(const FunctionCallbackInfo<Value>& info) {
+  URLPatternList* list;
+  ASSIGN_OR_RETURN_UNWRAP(&list, info.This());
+  info.GetReturnValue().Set(static_cast<uint32_t>(list->patterns_.size()));
+}
+
 static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(URLPattern::New);
 #define URL_PATTERN_COMPONENT_GETTERS(uppercase_name, _)                       \
@@ -626,6 +795,10 @@ static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(URLPattern::HasRegexpGroups);
   registry->Register(URLPattern::Exec);
   registry->Register(URLPattern::Test);
+  registry->Register(URLPatternList::New);
+  registry->Register(URLPatternList::Exec);
+  registry->Register(URLPatternList::Test);
+  registry->Register(URLPatternList::Length);
 }
 
 static void Initialize(Local<Object> target,
@@ -668,6 +841,22 @@ static void Initialize(Local<Object> target,
   SetProtoMethodNoSideEffect(isolate, ctor_tmpl, "exec", URLPattern::Exec);
   SetProtoMethodNoSideEffect(isolate, ctor_tmpl, "test", URLPattern::Test);
   SetConstructorFunction(context, target, "URLPattern", ctor_tmpl);
+  env->set_url_pattern_constructor_template(ctor_tmpl);
+
+  auto list_tmpl = NewFunctionTemplate(isolate, URLPatternList::New);
+  list_tmpl->InstanceTemplate()->SetInternalFieldCount(
+      URLPatternList::kInternalFieldCount);
+  list_tmpl->PrototypeTemplate()->SetAccessorProperty(
+      env->length_string(),
+      FunctionTemplate::New(isolate,
+                            URLPatternList::Length,
+                            Local<Value>(),
+                            Signature::New(isolate, list_tmpl)),
+      Local<FunctionTemplate>(),
+      attributes);
+  SetProtoMethodNoSideEffect(isolate, list_tmpl, "exec", URLPatternList::Exec);
+  SetProtoMethodNoSideEffect(isolate, list_tmpl, "test", URLPatternList::Test);
+  SetConstructorFunction(context, target, "URLPatternList", list_tmpl);
 }
 
 }  // namespace node::url_pattern
@@ -9,8 +9,11 @@
 
 #include <v8.h>
 
+#include <map>
+#include <memory>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 namespace node::url_pattern {
 
@@ -91,6 +94,8 @@ class URLPattern : public BaseObject {
   };
 
  private:
+  friend class URLPatternList;
+
   ada::url_pattern<URLPatternRegexProvider> url_pattern_;
   // Getter methods
 #define URL_PATTERN_COMPONENT_GETTERS(name, _) v8::MaybeLocal<v8::Value> name();
@@ -112,6 +117,47 @@ class URLPattern : public BaseObject {
 #undef URL_PATTERN_CACHED_VALUES
 };
 
+// Matches an input against many URLPatterns in one call. The patterns are
+// indexed by the literal prefix of their pathname, so that only the patterns
+// that can match the pathname of the input are executed.
+class URLPatternList : public BaseObject {
+ public:
+  URLPatternList(Environment* env,
+                 v8::Local<v8::Object> object,
+                 std::vector<BaseObjectPtr<URLPattern>>&& patterns);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Exec(const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void Test(const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void Length(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(URLPatternList)
+  SET_SELF_SIZE(URLPatternList)
+
+ private:
+  struct TrieNode {
+    // Indices of the patterns whose literal pathname prefix ends here.
+    std::vector<size_t> patterns;
+    std::map<char, std::unique_ptr<TrieNode>> children;
+  };
+
+  // Collects the indices of the patterns that can match the input, in list
+  // order. Returns false if the input cannot match any of them.
+  bool CollectCandidates(const ada::url_pattern_input& input,
+                         const std::string_view* base_url,
+                         std::vector<size_t>* candidates) const;
+  // Sets `match` to the index and result of the first matching pattern, if
+  // any. Returns false if matching failed.
+  bool Match(const ada::url_pattern_input& input,
+             const std::string_view* base_url,
+             std::optional<std::pair<size_t, ada::url_pattern_result>>* match)
+      const;
+
+  std::vector<BaseObjectPtr<URLPattern>> patterns_;
+  TrieNode root_;
+};
+
 }  // namespace node::url_pattern
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -23,18 +23,26 @@
 #include "aliased_buffer-inl.h"
 #include "base_object-inl.h"
 #include "env-inl.h"
+#include "histogram-inl.h"
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_external_reference.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace node {
 namespace v8_utils {
 using v8::Array;
 using v8::BigInt;
 using v8::CFunction;
 using v8::Context;
+using v8::EmbedderGraph;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -48,6 +56,7 @@ using v8::Local;
 using v8::LocalVector;
 using v8::MaybeLocal;
 using v8::Name;
+using v8::Number;
 using v8::Object;
 using v8::ScriptCompiler;
 using v8::String;
@@ -98,6 +107,54 @@ static const size_t kHeapCodeStatisticsPropertiesCount =
     HEAP_CODE_STATISTICS_PROPERTIES(V);
 #undef V
 
+// The GC types that are recorded by the histogram mode of GCProfiler.
+#define GC_TYPES(V)                                                            \
+  V(0, kGCTypeScavenge, Scavenge)                                              \
+  V(1, kGCTypeMinorMarkSweep, MinorMarkSweep)                                  \
+  V(2, kGCTypeMarkSweepCompact, MarkSweepCompact)                              \
+  V(3, kGCTypeIncrementalMarking, IncrementalMarking)                          \
+  V(4, kGCTypeProcessWeakCallbacks, ProcessWeakCallbacks)
+
+#define V(a, b, c) +1
+static constexpr size_t kGCTypeCount = GC_TYPES(V);
+#undef V
+
+// The statistics of each GC type in the statistics buffer of GCProfiler.
+// Pauses are in microseconds.
+#define GC_TYPE_STATISTICS_PROPERTIES(V)                                       \
+  V(0, count, kGCCountIndex)                                                   \
+  V(1, pause_total, kGCPauseTotalIndex)                                        \
+  V(2, pause_min, kGCPauseMinIndex)                                            \
+  V(3, pause_max, kGCPauseMaxIndex)                                            \
+  V(4, pause_mean, kGCPauseMeanIndex)                                          \
+  V(5, pause_stddev, kGCPauseStddevIndex)                                      \
+  V(6, pause_p50, kGCPauseP50Index)                                            \
+  V(7, pause_p90, kGCPauseP90Index)                                            \
+  V(8, pause_p99, kGCPauseP99Index)                                            \
+  V(9, bytes_freed, kGCBytesFreedIndex)                                        \
+  V(10, bytes_promoted, kGCBytesPromotedIndex)
+
+#define V(a, b, c) +1
+static constexpr size_t kGCTypeStatisticsPropertiesCount =
+    GC_TYPE_STATISTICS_PROPERTIES(V);
+#undef V
+
+// The statistics of each heap space in the statistics buffer of GCProfiler,
+// after those of the GC types. They only count the collections that freed
+// bytes in the space.
+#define GC_SPACE_STATISTICS_PROPERTIES(V)                                      \
+  V(0, count, kGCSpaceCountIndex)                                              \
+  V(1, bytes_freed, kGCSpaceBytesFreedIndex)                                   \
+  V(2, bytes_freed_max, kGCSpaceBytesFreedMaxIndex)                            \
+  V(3, bytes_freed_mean, kGCSpaceBytesFreedMeanIndex)                          \
+  V(4, bytes_freed_p50, kGCSpaceBytesFreedP50Index)                            \
+  V(5, bytes_freed_p99, kGCSpaceBytesFreedP99Index)
+
+#define V(a, b, c) +1
+static constexpr size_t kGCSpaceStatisticsPropertiesCount =
+    GC_SPACE_STATISTICS_PROPERTIES(V);
+#undef V
+
 BindingData::BindingData(Realm* realm,
                          Local<Object> obj,
                          InternalFieldInfo* info)
@@ -499,6 +556,94 @@ static void GetCppHeapStatistics(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(result);
 }
 
+// An EmbedderGraph that only sums up the sizes of the nodes that
+// MemoryTracker adds to it by class name, instead of building a graph of
+// them for a heap snapshot. The JS heap is not visited, and all the JS objects
+// that are referenced by the native objects are mapped to the same node.
+// Fields that are tracked with an explicit size, e.g. the contents of a
+// std::string, are accounted to the MemoryRetainer that holds them.
+class NativeMemoryGraph final : public EmbedderGraph {
+ public:
+  struct ClassStatistics {
+    size_t count = 0;
+    size_t size = 0;
+  };
+
+  Node* V8Node(const Local<Value>& value) override { return &js_node_; }
+
+  Node* AddNode(std::unique_ptr<Node> node) override {
+    nodes_.push_back(std::move(node));
+    return nodes_.back().get();
+  }
+
+  void AddEdge(Node* from, Node* to, const char* name) override {
+    if (from == &js_node_ || to == &js_node_) return;
+    // The first edge to a node comes from the node that it was added from.
+    owners_.emplace(to, from);
+  }
+
+  std::map<std::string, ClassStatistics> Aggregate() const {
+    std::map<std::string, ClassStatistics> statistics;
+    for (const auto& node : nodes_) {
+      // All the nodes that are not JS objects are added by MemoryTracker.
+      auto* retainer_node = static_cast<MemoryRetainerNode*>(node.get());
+      Node* owner = node.get();
+      while (owner != nullptr &&
+             !static_cast<MemoryRetainerNode*>(owner)->IsRetainerNode()) {
+        auto it = owners_.find(owner);
+        owner = it == owners_.end() ? nullptr : it->second;
+      }
+      if (retainer_node->IsRetainerNode()) {
+        statistics[retainer_node->Name()].count++;
+      }
+      const char* name = owner != nullptr ? owner->Name() : node->Name();
+      statistics[name].size += node->SizeInBytes();
+    }
+    return statistics;
+  }
+
+ private:
+  class JSNode final : public Node {
+   public:
+    const char* Name() override { return "JSObject"; }
+    size_t SizeInBytes() override { return 0; }
+    bool IsEmbedderNode() override { return false; }
+  };
+
+  JSNode js_node_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::unordered_map<Node*, Node*> owners_;
+};
+
+static void GetNativeMemoryStatistics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  NativeMemoryGraph graph;
+  {
+    MemoryTracker tracker(isolate, &graph);
+    tracker.Track(env);
+  }
+
+  Local<Object> result =
+      Object::New(isolate, Null(isolate), nullptr, nullptr, 0);
+  Local<Name> names[] = {FIXED_ONE_BYTE_STRING(isolate, "count"),
+                         env->size_string()};
+  for (const auto& [class_name, stats] : graph.Aggregate()) {
+    Local<Value> values[] = {
+        Number::New(isolate, static_cast<double>(stats.count)),
+        Number::New(isolate, static_cast<double>(stats.size))};
+    Local<Object> entry =
+        Object::New(isolate, Null(isolate), names, values, arraysize(names));
+    Local<String> key;
+    if (!String::NewFromUtf8(isolate, class_name.c_str()).ToLocal(&key) ||
+        result->Set(env->context(), key, entry).IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(result);
+}
+
 static void BeforeGCCallback(Isolate* isolate,
                              v8::GCType gc_type,
                              v8::GCCallbackFlags flags,
@@ -507,12 +652,16 @@ static void BeforeGCCallback(Isolate* isolate,
   if (profiler->current_gc_type != 0) {
     return;
   }
-  JSONWriter* writer = profiler->writer();
-  writer->json_start();
-  writer->json_keyvalue("gcType", GetGCTypeName(gc_type));
-  writer->json_objectstart("beforeGC");
-  SetHeapStatistics(writer, isolate);
-  writer->json_objectend();
+  if (profiler->mode == GCProfiler::GCProfilerMode::kHistogram) {
+    profiler->SaveHeapSpaceUsage(isolate);
+  } else {
+    JSONWriter* writer = profiler->writer();
+    writer->json_start();
+    writer->json_keyvalue("gcType", GetGCTypeName(gc_type));
+    writer->json_objectstart("beforeGC");
+    SetHeapStatistics(writer, isolate);
+    writer->json_objectend();
+  }
   profiler->current_gc_type = gc_type;
   profiler->start_time = uv_hrtime();
 }
@@ -525,23 +674,64 @@ static void AfterGCCallback(Isolate* isolate,
   if (profiler->current_gc_type != gc_type) {
     return;
   }
-  JSONWriter* writer = profiler->writer();
+  uint64_t pause = uv_hrtime() - profiler->start_time;
   profiler->current_gc_type = 0;
-  writer->json_keyvalue("cost", (uv_hrtime() - profiler->start_time) / 1e3);
   profiler->start_time = 0;
+  if (profiler->mode == GCProfiler::GCProfilerMode::kHistogram) {
+    profiler->RecordGC(isolate, gc_type, pause);
+    return;
+  }
+  JSONWriter* writer = profiler->writer();
+  writer->json_keyvalue("cost", pause / 1e3);
   writer->json_objectstart("afterGC");
   SetHeapStatistics(writer, isolate);
   writer->json_objectend();
   writer->json_end();
 }
 
-GCProfiler::GCProfiler(Environment* env, Local<Object> object)
+GCProfiler::GCProfiler(Environment* env,
+                       Local<Object> object,
+                       GCProfilerMode mode)
     : BaseObject(env, object),
       start_time(0),
       current_gc_type(0),
       state(GCProfilerState::kInitialized),
-      writer_(out_stream_, false) {
+      mode(mode),
+      writer_(out_stream_, false),
+      statistics_buffer_(
+          env->isolate(),
+          mode == GCProfilerMode::kHistogram
+              ? kGCTypeCount * kGCTypeStatisticsPropertiesCount +
+                  env->isolate()->NumberOfHeapSpaces() *
+                      kGCSpaceStatisticsPropertiesCount
+              : 0) {
   MakeWeak();
+  if (mode != GCProfilerMode::kHistogram) return;
+
+  for (size_t i = 0; i < kGCTypeCount; i++) {
+    pause_histograms_.emplace_back(
+        std::make_unique<Histogram>(Histogram::Options{}));
+  }
+  bytes_freed_.resize(kGCTypeCount);
+  bytes_promoted_.resize(kGCTypeCount);
+
+  size_t space_count = env->isolate()->NumberOfHeapSpaces();
+  for (size_t i = 0; i < space_count; i++) {
+    HeapSpaceStatistics s;
+    env->isolate()->GetHeapSpaceStatistics(&s, i);
+    std::string_view name = s.space_name();
+    space_freed_histograms_.emplace_back(
+        std::make_unique<Histogram>(Histogram::Options{}));
+    young_spaces_.push_back(name == "new_space" ||
+                            name == "new_large_object_space");
+  }
+  space_used_before_.resize(space_count);
+
+  object
+      ->Set(env->context(),
+            FIXED_ONE_BYTE_STRING(env->isolate(), "statisticsBuffer"),
+            statistics_buffer_.GetJSArray())
+      .Check();
 }
 
 // This function will be called when
@@ -556,6 +746,53 @@ GCProfiler::~GCProfiler() {
   }
 }
 
+void GCProfiler::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("statistics_buffer", statistics_buffer_);
+}
+
+void GCProfiler::SaveHeapSpaceUsage(Isolate* isolate) {
+  for (size_t i = 0; i < space_used_before_.size(); i++) {
+    HeapSpaceStatistics s;
+    isolate->GetHeapSpaceStatistics(&s, i);
+    space_used_before_[i] = s.space_used_size();
+  }
+}
+
+void GCProfiler::RecordGC(Isolate* isolate,
+                          v8::GCType gc_type,
+                          uint64_t pause) {
+  size_t type;
+  switch (gc_type) {
+#define V(index, type_name, _)                                                 \
+  case v8::GCType::type_name:                                                  \
+    type = index;                                                              \
+    break;
+    GC_TYPES(V)
+#undef V
+    default:
+      return;
+  }
+
+  // The histograms cannot record zero.
+  pause_histograms_[type]->Record(std::max<int64_t>(pause, 1));
+
+  bool young_gc = gc_type == v8::GCType::kGCTypeScavenge ||
+                  gc_type == v8::GCType::kGCTypeMinorMarkSweep;
+  for (size_t i = 0; i < space_used_before_.size(); i++) {
+    HeapSpaceStatistics s;
+    isolate->GetHeapSpaceStatistics(&s, i);
+    size_t before = space_used_before_[i];
+    size_t after = s.space_used_size();
+    if (after < before) {
+      bytes_freed_[type] += before - after;
+      space_freed_histograms_[i]->Record(before - after);
+    } else if (young_gc && !young_spaces_[i]) {
+      // What the old spaces gain in a young generation GC was promoted.
+      bytes_promoted_[type] += after - before;
+    }
+  }
+}
+
 JSONWriter* GCProfiler::writer() {
   return &writer_;
 }
@@ -567,7 +804,10 @@ std::ostringstream* GCProfiler::out_stream() {
 void GCProfiler::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   Environment* env = Environment::GetCurrent(args);
-  new GCProfiler(env, args.This());
+  GCProfiler::GCProfilerMode mode = args[0]->IsTrue()
+                                        ? GCProfiler::GCProfilerMode::kHistogram
+                                        : GCProfiler::GCProfilerMode::kJSON;
+  new GCProfiler(env, args.This(), mode);
 }
 
 void GCProfiler::Start(const FunctionCallbackInfo<Value>& args) {
@@ -577,6 +817,14 @@ void GCProfiler::Start(const FunctionCallbackInfo<Value>& args) {
   if (profiler->state != GCProfiler::GCProfilerState::kInitialized) {
     return;
   }
+  if (profiler->mode == GCProfiler::GCProfilerMode::kHistogram) {
+    env->isolate()->AddGCPrologueCallback(BeforeGCCallback,
+                                          static_cast<void*>(profiler));
+    env->isolate()->AddGCEpilogueCallback(AfterGCCallback,
+                                          static_cast<void*>(profiler));
+    profiler->state = GCProfiler::GCProfilerState::kStarted;
+    return;
+  }
   profiler->writer()->json_start();
   profiler->writer()->json_keyvalue("version", 1);
 
@@ -602,6 +850,14 @@ void GCProfiler::Stop(const FunctionCallbackInfo<v8::Value>& args) {
   if (profiler->state != GCProfiler::GCProfilerState::kStarted) {
     return;
   }
+  if (profiler->mode == GCProfiler::GCProfilerMode::kHistogram) {
+    // The statistics stay readable through UpdateStatisticsBuffer().
+    env->isolate()->RemoveGCPrologueCallback(BeforeGCCallback, profiler);
+    env->isolate()->RemoveGCEpilogueCallback(AfterGCCallback, profiler);
+    profiler->current_gc_type = 0;
+    profiler->state = GCProfiler::GCProfilerState::kStopped;
+    return;
+  }
   profiler->writer()->json_arrayend();
   uv_timeval64_t ts;
   if (uv_gettimeofday(&ts) == 0) {
@@ -619,6 +875,44 @@ void GCProfiler::Stop(const FunctionCallbackInfo<v8::Value>& args) {
   }
 }
 
+void GCProfiler::UpdateStatisticsBuffer(
+    const FunctionCallbackInfo<Value>& args) {
+  GCProfiler* profiler;
+  ASSIGN_OR_RETURN_UNWRAP(&profiler, args.This());
+  CHECK(profiler->mode == GCProfiler::GCProfilerMode::kHistogram);
+  AliasedFloat64Array& buffer = profiler->statistics_buffer_;
+
+  for (size_t i = 0; i < kGCTypeCount; i++) {
+    const Histogram& pauses = *profiler->pause_histograms_[i];
+    size_t offset = i * kGCTypeStatisticsPropertiesCount;
+    size_t count = pauses.Count();
+    buffer[offset + 0] = static_cast<double>(count);
+    buffer[offset + 1] = count * pauses.Mean() / 1e3;
+    buffer[offset + 2] = count > 0 ? pauses.Min() / 1e3 : 0;
+    buffer[offset + 3] = pauses.Max() / 1e3;
+    buffer[offset + 4] = count > 0 ? pauses.Mean() / 1e3 : 0;
+    buffer[offset + 5] = count > 0 ? pauses.Stddev() / 1e3 : 0;
+    buffer[offset + 6] = pauses.Percentile(50) / 1e3;
+    buffer[offset + 7] = pauses.Percentile(90) / 1e3;
+    buffer[offset + 8] = pauses.Percentile(99) / 1e3;
+    buffer[offset + 9] = profiler->bytes_freed_[i];
+    buffer[offset + 10] = profiler->bytes_promoted_[i];
+  }
+
+  size_t spaces_offset = kGCTypeCount * kGCTypeStatisticsPropertiesCount;
+  for (size_t i = 0; i < profiler->space_freed_histograms_.size(); i++) {
+    const Histogram& freed = *profiler->space_freed_histograms_[i];
+    size_t offset = spaces_offset + i * kGCSpaceStatisticsPropertiesCount;
+    size_t count = freed.Count();
+    buffer[offset + 0] = static_cast<double>(count);
+    buffer[offset + 1] = count * freed.Mean();
+    buffer[offset + 2] = static_cast<double>(freed.Max());
+    buffer[offset + 3] = count > 0 ? freed.Mean() : 0;
+    buffer[offset + 4] = static_cast<double>(freed.Percentile(50));
+    buffer[offset + 5] = static_cast<double>(freed.Percentile(99));
+  }
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -645,6 +939,8 @@ void Initialize(Local<Object> target,
             UpdateHeapCodeStatisticsBuffer);
   SetMethodNoSideEffect(
       context, target, "getCppHeapStatistics", GetCppHeapStatistics);
+  SetMethodNoSideEffect(
+      context, target, "getNativeMemoryStatistics", GetNativeMemoryStatistics);
 
   size_t number_of_heap_spaces = env->isolate()->NumberOfHeapSpaces();
 
@@ -679,7 +975,23 @@ void Initialize(Local<Object> target,
   HEAP_STATISTICS_PROPERTIES(V)
   HEAP_CODE_STATISTICS_PROPERTIES(V)
   HEAP_SPACE_STATISTICS_PROPERTIES(V)
+  GC_TYPE_STATISTICS_PROPERTIES(V)
+  GC_SPACE_STATISTICS_PROPERTIES(V)
 #undef V
+  target
+      ->Set(context,
+            FIXED_ONE_BYTE_STRING(env->isolate(),
+                                  "kGCTypeStatisticsPropertiesCount"),
+            Uint32::NewFromUnsigned(env->isolate(),
+                                    kGCTypeStatisticsPropertiesCount))
+      .Check();
+  target
+      ->Set(context,
+            FIXED_ONE_BYTE_STRING(env->isolate(),
+                                  "kGCSpaceStatisticsPropertiesCount"),
+            Uint32::NewFromUnsigned(env->isolate(),
+                                    kGCSpaceStatisticsPropertiesCount))
+      .Check();
 
   // Export symbols used by v8.setFlagsFromString()
   SetMethod(context, target, "setFlagsFromString", SetFlagsFromString);
@@ -699,8 +1011,26 @@ void Initialize(Local<Object> target,
   t->InstanceTemplate()->SetInternalFieldCount(BaseObject::kInternalFieldCount);
   SetProtoMethod(env->isolate(), t, "start", GCProfiler::Start);
   SetProtoMethod(env->isolate(), t, "stop", GCProfiler::Stop);
+  SetProtoMethod(env->isolate(),
+                 t,
+                 "updateStatisticsBuffer",
+                 GCProfiler::UpdateStatisticsBuffer);
   SetConstructorFunction(context, target, "GCProfiler", t);
 
+  {
+    Isolate* isolate = env->isolate();
+    Local<Value> gc_types[] = {
+#define V(_, __, name) FIXED_ONE_BYTE_STRING(isolate, #name),
+        GC_TYPES(V)
+#undef V
+    };
+    target
+        ->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "kGCTypes"),
+              Array::New(isolate, gc_types, arraysize(gc_types)))
+        .Check();
+  }
+
   {
     Isolate* isolate = env->isolate();
     Local<Object> detail_level = Object::New(isolate);
@@ -725,7 +1055,9 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GCProfiler::New);
   registry->Register(GCProfiler::Start);
   registry->Register(GCProfiler::Stop);
+  registry->Register(GCProfiler::UpdateStatisticsBuffer);
   registry->Register(GetCppHeapStatistics);
+  registry->Register(GetNativeMemoryStatistics);
   registry->Register(IsStringOneByteRepresentation);
   registry->Register(FastIsStringOneByteRepresentation);
   registry->Register(fast_is_string_one_byte_representation_.GetTypeInfo());
@@ -3,9 +3,12 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <memory>
 #include <sstream>
+#include <vector>
 #include "aliased_buffer.h"
 #include "base_object.h"
+#include "histogram.h"
 #include "json_utils.h"
 #include "node_snapshotable.h"
 #include "util.h"
@@ -45,27 +48,50 @@ class BindingData : public SnapshotableObject {
 class GCProfiler : public BaseObject {
  public:
   enum class GCProfilerState { kInitialized, kStarted, kStopped };
-  GCProfiler(Environment* env, v8::Local<v8::Object> object);
+  // In the histogram mode, the pauses and the bytes that are freed are
+  // recorded into histograms that can be sampled while the profiler runs,
+  // instead of into a JSON document that is returned by Stop().
+  enum class GCProfilerMode { kJSON, kHistogram };
+  GCProfiler(Environment* env,
+             v8::Local<v8::Object> object,
+             GCProfilerMode mode);
   inline ~GCProfiler() override;
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UpdateStatisticsBuffer(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
   JSONWriter* writer();
 
   std::ostringstream* out_stream();
 
-  SET_NO_MEMORY_INFO()
+  // Used in the histogram mode.
+  void SaveHeapSpaceUsage(v8::Isolate* isolate);
+  void RecordGC(v8::Isolate* isolate, v8::GCType gc_type, uint64_t pause);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(GCProfiler)
   SET_SELF_SIZE(GCProfiler)
 
   uint64_t start_time;
   uint8_t current_gc_type;
   GCProfilerState state;
+  const GCProfilerMode mode;
 
  private:
   std::ostringstream out_stream_;
   JSONWriter writer_;
+
+  AliasedFloat64Array statistics_buffer_;
+  // Indexed by the GC types of GC_TYPES in src/node_v8.cc.
+  std::vector<std::unique_ptr<Histogram>> pause_histograms_;
+  std::vector<double> bytes_freed_;
+  std::vector<double> bytes_promoted_;
+  // Indexed by heap space.
+  std::vector<std::unique_ptr<Histogram>> space_freed_histograms_;
+  std::vector<size_t> space_used_before_;
+  std::vector<bool> young_spaces_;
 };
 
 }  // namespace v8_utils
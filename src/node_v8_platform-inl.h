@@ -101,7 +101,11 @@ struct V8Platform {
       StartTracingAgent();
     }
     // Tracing must be initialized before platform threads are created.
-    platform_ = new NodePlatform(thread_pool_size, controller);
+    v8::PageAllocator* page_allocator = nullptr;
+    if (per_process::cli_options->use_largepages_heap) {
+      page_allocator = GetHugePageAllocator();
+    }
+    platform_ = new NodePlatform(thread_pool_size, controller, page_allocator);
     v8::V8::InitializePlatform(platform_);
   }
   // Make sure V8Platform don not call into Libuv threadpool,
@@ -146,7 +150,10 @@ struct V8Platform {
           convert_to_set(categories),
           std::unique_ptr<tracing::AsyncTraceWriter>(
               new tracing::NodeTraceWriter(
-                  per_process::cli_options->trace_event_file_pattern)),
+                  per_process::cli_options->trace_event_file_pattern,
+                  per_process::cli_options->trace_event_format == "perfetto"
+                      ? tracing::NodeTraceWriter::Format::kPerfetto
+                      : tracing::NodeTraceWriter::Format::kJSON)),
           tracing::Agent::kUseDefaultCategories);
     }
   }
@@ -651,6 +651,52 @@ uint32_t WASI::FdFilestatSetTimes(WASI& wasi,
       &wasi.uvw_, fd, st_atim, st_mtim, fst_flags);
 }
 
+namespace {
+// The iovec arrays of WASI calls are usually short, so they are built on the
+// stack.
+constexpr size_t kStackIovecCount = 16;
+
+template <typename T>
+using IovecArray = MaybeStackBuffer<T, kStackIovecCount>;
+
+// Builds the iovecs described by the |count| entries at |offset| in the guest
+// memory. Their buffers are not copied: the iovecs point straight into the
+// backing store of the WebAssembly.Memory. |T| is either uvwasi_iovec_t or
+// uvwasi_ciovec_t, which have the same layout in the guest memory.
+template <typename T>
+uvwasi_errno_t ReadIovecs(WasmMemory memory,
+                          uint32_t offset,
+                          uint32_t count,
+                          IovecArray<T>* iovs) {
+  static_assert(UVWASI_SERDES_SIZE_iovec_t == 8);
+  static_assert(UVWASI_SERDES_SIZE_ciovec_t == 8);
+  // Unlike |count| * 8 in uint32_t arithmetic, this cannot overflow.
+  if (!uvwasi_serdes_check_array_bounds(
+          offset, memory.size, UVWASI_SERDES_SIZE_iovec_t, count)) {
+    return UVWASI_EOVERFLOW;
+  }
+  iovs->AllocateSufficientStorage(count);
+  T* out = iovs->out();
+  const char* entry = memory.data + offset;
+  for (uint32_t i = 0; i < count; i++, entry += UVWASI_SERDES_SIZE_iovec_t) {
+    uint32_t fields[2];
+    memcpy(fields, entry, sizeof(fields));
+    if constexpr (IsBigEndian()) {
+      fields[0] = __builtin_bswap32(fields[0]);
+      fields[1] = __builtin_bswap32(fields[1]);
+    }
+    const uint32_t buf_ptr = fields[0];
+    const uint32_t buf_len = fields[1];
+    if (!uvwasi_serdes_check_bounds(buf_ptr, memory.size, buf_len)) {
+      return UVWASI_EOVERFLOW;
+    }
+    out[i].buf = memory.data + buf_ptr;
+    out[i].buf_len = buf_len;
+  }
+  return UVWASI_ESUCCESS;
+}
+}  // namespace
+
 uint32_t WASI::FdPread(WASI& wasi,
                        WasmMemory memory,
                        uint32_t fd,
@@ -665,20 +711,15 @@ uint32_t WASI::FdPread(WASI& wasi,
         iovs_len,
         offset,
         nread_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, iovs_ptr, iovs_len * UVWASI_SERDES_SIZE_iovec_t);
   CHECK_BOUNDS_OR_RETURN(memory.size, nread_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_iovec_t> iovs(iovs_len);
-  uvwasi_errno_t err;
-
-  err = uvwasi_serdes_readv_iovec_t(
-      memory.data, memory.size, iovs_ptr, iovs.data(), iovs_len);
+  IovecArray<uvwasi_iovec_t> iovs;
+  uvwasi_errno_t err = ReadIovecs(memory, iovs_ptr, iovs_len, &iovs);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
 
   uvwasi_size_t nread;
-  err = uvwasi_fd_pread(&wasi.uvw_, fd, iovs.data(), iovs_len, offset, &nread);
+  err = uvwasi_fd_pread(&wasi.uvw_, fd, *iovs, iovs_len, offset, &nread);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory.data, nread_ptr, nread);
 
@@ -725,21 +766,15 @@ uint32_t WASI::FdPwrite(WASI& wasi,
         iovs_len,
         offset,
         nwritten_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, iovs_ptr, iovs_len * UVWASI_SERDES_SIZE_ciovec_t);
   CHECK_BOUNDS_OR_RETURN(memory.size, nwritten_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> iovs(iovs_len);
-  uvwasi_errno_t err;
-
-  err = uvwasi_serdes_readv_ciovec_t(
-      memory.data, memory.size, iovs_ptr, iovs.data(), iovs_len);
+  IovecArray<uvwasi_ciovec_t> iovs;
+  uvwasi_errno_t err = ReadIovecs(memory, iovs_ptr, iovs_len, &iovs);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
 
   uvwasi_size_t nwritten;
-  err = uvwasi_fd_pwrite(
-      &wasi.uvw_, fd, iovs.data(), iovs_len, offset, &nwritten);
+  err = uvwasi_fd_pwrite(&wasi.uvw_, fd, *iovs, iovs_len, offset, &nwritten);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory.data, nwritten_ptr, nwritten);
 
@@ -753,20 +788,15 @@ uint32_t WASI::FdRead(WASI& wasi,
                       uint32_t iovs_len,
                       uint32_t nread_ptr) {
   Debug(wasi, "fd_read(%d, %d, %d, %d)\n", fd, iovs_ptr, iovs_len, nread_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, iovs_ptr, iovs_len * UVWASI_SERDES_SIZE_iovec_t);
   CHECK_BOUNDS_OR_RETURN(memory.size, nread_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_iovec_t> iovs(iovs_len);
-  uvwasi_errno_t err;
-
-  err = uvwasi_serdes_readv_iovec_t(
-      memory.data, memory.size, iovs_ptr, iovs.data(), iovs_len);
+  IovecArray<uvwasi_iovec_t> iovs;
+  uvwasi_errno_t err = ReadIovecs(memory, iovs_ptr, iovs_len, &iovs);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
 
   uvwasi_size_t nread;
-  err = uvwasi_fd_read(&wasi.uvw_, fd, iovs.data(), iovs_len, &nread);
+  err = uvwasi_fd_read(&wasi.uvw_, fd, *iovs, iovs_len, &nread);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory.data, nread_ptr, nread);
 
@@ -854,20 +884,15 @@ uint32_t WASI::FdWrite(WASI& wasi,
         iovs_ptr,
         iovs_len,
         nwritten_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, iovs_ptr, iovs_len * UVWASI_SERDES_SIZE_ciovec_t);
   CHECK_BOUNDS_OR_RETURN(memory.size, nwritten_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> iovs(iovs_len);
-  uvwasi_errno_t err;
-
-  err = uvwasi_serdes_readv_ciovec_t(
-      memory.data, memory.size, iovs_ptr, iovs.data(), iovs_len);
+  IovecArray<uvwasi_ciovec_t> iovs;
+  uvwasi_errno_t err = ReadIovecs(memory, iovs_ptr, iovs_len, &iovs);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
 
   uvwasi_size_t nwritten;
-  err = uvwasi_fd_write(&wasi.uvw_, fd, iovs.data(), iovs_len, &nwritten);
+  err = uvwasi_fd_write(&wasi.uvw_, fd, *iovs, iovs_len, &nwritten);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory.data, nwritten_ptr, nwritten);
 
@@ -1210,13 +1235,10 @@ uint32_t WASI::SockRecv(WASI& wasi,
         ri_flags,
         ro_datalen_ptr,
         ro_flags_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, ri_data_ptr, ri_data_len * UVWASI_SERDES_SIZE_iovec_t);
   CHECK_BOUNDS_OR_RETURN(memory.size, ro_datalen_ptr, 4);
   CHECK_BOUNDS_OR_RETURN(memory.size, ro_flags_ptr, 4);
-  std::vector<uvwasi_iovec_t> ri_data(ri_data_len);
-  uvwasi_errno_t err = uvwasi_serdes_readv_iovec_t(
-      memory.data, memory.size, ri_data_ptr, ri_data.data(), ri_data_len);
+  IovecArray<uvwasi_iovec_t> ri_data;
+  uvwasi_errno_t err = ReadIovecs(memory, ri_data_ptr, ri_data_len, &ri_data);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
@@ -1225,7 +1247,7 @@ uint32_t WASI::SockRecv(WASI& wasi,
   uvwasi_roflags_t ro_flags;
   err = uvwasi_sock_recv(&wasi.uvw_,
                          sock,
-                         ri_data.data(),
+                         *ri_data,
                          ri_data_len,
                          ri_flags,
                          &ro_datalen,
@@ -1252,20 +1274,17 @@ uint32_t WASI::SockSend(WASI& wasi,
         si_data_len,
         si_flags,
         so_datalen_ptr);
-  CHECK_BOUNDS_OR_RETURN(
-      memory.size, si_data_ptr, si_data_len * UVWASI_SERDES_SIZE_ciovec_t);
   CHECK_BOUNDS_OR_RETURN(
       memory.size, so_datalen_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> si_data(si_data_len);
-  uvwasi_errno_t err = uvwasi_serdes_readv_ciovec_t(
-      memory.data, memory.size, si_data_ptr, si_data.data(), si_data_len);
+  IovecArray<uvwasi_ciovec_t> si_data;
+  uvwasi_errno_t err = ReadIovecs(memory, si_data_ptr, si_data_len, &si_data);
   if (err != UVWASI_ESUCCESS) {
     return err;
   }
 
   uvwasi_size_t so_datalen;
   err = uvwasi_sock_send(
-      &wasi.uvw_, sock, si_data.data(), si_data_len, si_flags, &so_datalen);
+      &wasi.uvw_, sock, *si_data, si_data_len, si_flags, &so_datalen);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory.data, so_datalen_ptr, so_datalen);
 
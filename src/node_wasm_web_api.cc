@@ -1,5 +1,6 @@
 #include "node_wasm_web_api.h"
 
+#include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -9,6 +10,7 @@ namespace wasm_web_api {
 
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
+using v8::CompiledWasmModule;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -54,6 +56,10 @@ void WasmStreamingObject::MemoryInfo(MemoryTracker* tracker) const {
   // module that is being compiled is roughly what V8 allocates (as in, off by
   // only a small factor).
   tracker->TrackFieldWithSize("streaming", wasm_size_);
+  if (cache_entry_ && cache_entry_->file_data != nullptr &&
+      !cache_entry_->file_mapped) {
+    tracker->TrackFieldWithSize("compiled_module", cache_entry_->file_size);
+  }
 }
 
 MaybeLocal<Object> WasmStreamingObject::Create(
@@ -86,8 +92,29 @@ void WasmStreamingObject::SetURL(const FunctionCallbackInfo<Value>& args) {
 
   CHECK_EQ(args.Length(), 1);
   CHECK(args[0]->IsString());
-  Utf8Value url(Environment::GetCurrent(args)->isolate(), args[0]);
+  Environment* env = Environment::GetCurrent(args);
+  Utf8Value url(env->isolate(), args[0]);
   obj->streaming_->SetUrl(url.out(), url.length());
+  if (env->use_compile_cache()) {
+    obj->UseCompileCache(env, url.ToStringView());
+  }
+}
+
+void WasmStreamingObject::UseCompileCache(Environment* env,
+                                          std::string_view url) {
+  // This must happen before any bytes are pushed. Whether the wire bytes are
+  // still the same is only known when the streaming finishes.
+  cache_entry_ = env->compile_cache_handler()->GetWasmModule(url);
+  if (cache_entry_->file_data != nullptr &&
+      !streaming_->SetCompiledModuleBytes(cache_entry_->module_data(),
+                                          cache_entry_->module_size())) {
+    cache_entry_->ReleaseData();
+  }
+
+  streaming_->SetMoreFunctionsCanBeSerializedCallback(
+      [filename = cache_entry_->cache_filename](CompiledWasmModule module) {
+        CompileCacheHandler::SaveWasmModule(filename, std::move(module));
+      });
 }
 
 void WasmStreamingObject::Push(const FunctionCallbackInfo<Value>& args) {
@@ -121,9 +148,12 @@ void WasmStreamingObject::Push(const FunctionCallbackInfo<Value>& args) {
   }
 
   // Forward the data to V8. Internally, V8 will make a copy.
-  obj->streaming_->OnBytesReceived(static_cast<const uint8_t*>(bytes) + offset,
-                                   size);
+  const uint8_t* data = static_cast<const uint8_t*>(bytes) + offset;
+  obj->streaming_->OnBytesReceived(data, size);
   obj->wasm_size_ += size;
+  if (obj->cache_entry_ && obj->cache_entry_->file_data != nullptr) {
+    obj->cache_entry_->UpdateStreamedHash(data, size);
+  }
 }
 
 void WasmStreamingObject::Finish(const FunctionCallbackInfo<Value>& args) {
@@ -132,7 +162,14 @@ void WasmStreamingObject::Finish(const FunctionCallbackInfo<Value>& args) {
   CHECK(obj->streaming_);
 
   CHECK_EQ(args.Length(), 0);
-  obj->streaming_->Finish();
+  if (!obj->cache_entry_) {
+    obj->streaming_->Finish();
+    return;
+  }
+  // V8 deserializes the module synchronously if it can be used, after which
+  // the content of the cache file is no longer needed.
+  obj->streaming_->Finish(obj->cache_entry_->MatchesStreamedBytes());
+  obj->cache_entry_->ReleaseData();
 }
 
 void WasmStreamingObject::Abort(const FunctionCallbackInfo<Value>& args) {
@@ -142,6 +179,9 @@ void WasmStreamingObject::Abort(const FunctionCallbackInfo<Value>& args) {
 
   CHECK_EQ(args.Length(), 1);
   obj->streaming_->Abort(args[0]);
+  if (obj->cache_entry_) {
+    obj->cache_entry_->ReleaseData();
+  }
 }
 
 void StartStreamingCompilation(const FunctionCallbackInfo<Value>& info) {
@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "base_object-inl.h"
+#include "compile_cache.h"
 #include "v8.h"
 
 namespace node {
@@ -38,8 +39,14 @@ class WasmStreamingObject final : public BaseObject {
   static void Finish(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Abort(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  // Hands the module compiled from |url| in a previous run to V8, and lets V8
+  // write it back to the compile cache once it has been optimized.
+  void UseCompileCache(Environment* env, std::string_view url);
+
   std::shared_ptr<v8::WasmStreaming> streaming_;
   size_t wasm_size_ = 0;
+  // Set if the compile cache is enabled.
+  std::unique_ptr<WasmCacheEntry> cache_entry_;
 };
 
 // This is a v8::WasmStreamingCallback implementation that must be passed to
@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <algorithm>
+#include <cinttypes>
 
 #include "async_wrap-inl.h"
 #include "debug_utils-inl.h"
@@ -34,9 +35,11 @@ namespace node {
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::HandleScope;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
+using v8::StackTrace;
 using v8::Value;
 
 Watchdog::Watchdog(v8::Isolate* isolate, uint64_t ms, bool* timed_out)
@@ -99,6 +102,117 @@ void Watchdog::Timer(uv_timer_t* timer) {
 }
 
 
+StallWatchdog::StallWatchdog(Environment* env,
+                             uint64_t threshold_ms,
+                             bool report)
+    : env_(env), threshold_(threshold_ms * 1000 * 1000), report_(report) {
+  uv_metrics_t metrics;
+  CHECK_EQ(0, uv_metrics_info(env->event_loop(), &metrics));
+  last_loop_count_ = metrics.loop_count;
+  last_idle_time_ = uv_metrics_idle_time(env->event_loop());
+  last_progress_ = uv_hrtime();
+
+  CHECK_EQ(0, uv_loop_init(&loop_));
+  CHECK_EQ(0, uv_async_init(&loop_, &async_, [](uv_async_t* signal) {
+    StallWatchdog* w = ContainerOf(&StallWatchdog::async_, signal);
+    uv_stop(&w->loop_);
+  }));
+  CHECK_EQ(0, uv_timer_init(&loop_, &timer_));
+  // Check a few times per threshold, so that a stall is detected at most a
+  // quarter of the threshold after it started to count as one.
+  uint64_t interval = std::max<uint64_t>(threshold_ms / 4, 1);
+  CHECK_EQ(0, uv_timer_start(&timer_, &StallWatchdog::Timer, interval,
+                             interval));
+  CHECK_EQ(0, uv_thread_create(&thread_, &StallWatchdog::Run, this));
+}
+
+StallWatchdog::~StallWatchdog() {
+  Stop();
+}
+
+void StallWatchdog::Stop() {
+  if (stopped_) return;
+  stopped_ = true;
+
+  uv_async_send(&async_);
+  uv_thread_join(&thread_);
+
+  uv_close(reinterpret_cast<uv_handle_t*>(&async_), nullptr);
+
+  // UV_RUN_DEFAULT so that libuv has a chance to clean up.
+  uv_run(&loop_, UV_RUN_DEFAULT);
+
+  CheckedUvLoopClose(&loop_);
+}
+
+void StallWatchdog::Run(void* arg) {
+  StallWatchdog* wd = static_cast<StallWatchdog*>(arg);
+
+  uv_run(&wd->loop_, UV_RUN_DEFAULT);
+
+  // Close the timer handle on this side and let Stop() close async_.
+  uv_close(reinterpret_cast<uv_handle_t*>(&wd->timer_), nullptr);
+}
+
+void StallWatchdog::Timer(uv_timer_t* timer) {
+  StallWatchdog* w = ContainerOf(&StallWatchdog::timer_, timer);
+  Environment* env = w->env_;
+  if (env->is_stopping()) return;
+
+  // Both of these are safe to read from other threads. The loop count goes
+  // up with every iteration of the loop and the idle time while it waits
+  // for I/O, so if neither changed, the thread is stuck in a callback.
+  uv_metrics_t metrics;
+  uv_metrics_info(env->event_loop(), &metrics);
+  uint64_t idle_time = uv_metrics_idle_time(env->event_loop());
+  uint64_t now = uv_hrtime();
+
+  if (metrics.loop_count != w->last_loop_count_ ||
+      idle_time != w->last_idle_time_) {
+    if (w->stalled_) {
+      w->stalled_ = false;
+      uint64_t duration = now - w->last_progress_;
+      if (duration > w->max_stall_duration_)
+        w->max_stall_duration_ = duration;
+    }
+    w->last_loop_count_ = metrics.loop_count;
+    w->last_idle_time_ = idle_time;
+    w->last_progress_ = now;
+    return;
+  }
+
+  if (w->stalled_ || now - w->last_progress_ <= w->threshold_) return;
+
+  w->stalled_ = true;
+  w->stall_count_++;
+  env->RequestInterrupt([](Environment* env) { PrintStall(env); });
+}
+
+void StallWatchdog::PrintStall(Environment* env) {
+  StallWatchdog* w = env->stall_watchdog();
+  if (w == nullptr || !env->can_call_into_js()) return;
+
+  if (w->report_) {
+    TriggerNodeReport(
+        env, "Event loop stall", "EventLoopStall", "", Local<Value>());
+    return;
+  }
+
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  fprintf(stderr,
+          "(node:%d) WARNING: Detected an event loop stall of more than "
+          "%" PRIu64 " ms\n",
+          uv_os_getpid(),
+          w->threshold_ / (1000 * 1000));
+  PrintStackTrace(
+      isolate,
+      StackTrace::CurrentStackTrace(isolate,
+                                    static_cast<int>(env->stack_trace_limit()),
+                                    StackTrace::kDetailed));
+  DumpNativeBacktrace(stderr);
+}
+
 SigintWatchdog::SigintWatchdog(
   v8::Isolate* isolate, bool* received_signal)
     : isolate_(isolate), received_signal_(received_signal) {
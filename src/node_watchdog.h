@@ -24,6 +24,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <vector>
 #include "handle_wrap.h"
 #include "memory_tracker-inl.h"
@@ -62,6 +63,48 @@ class Watchdog {
   bool* timed_out_;
 };
 
+// Detects, from a thread of its own, when the event loop of an Environment
+// makes no progress for longer than a threshold. The progress is read from
+// the metrics of the loop, so the thread of the Environment does no work for
+// this. For every stall, the JavaScript and native stacks of the blocked
+// thread are printed to stderr once it handles the interrupt requested for
+// it, or a diagnostic report is written instead.
+class StallWatchdog {
+ public:
+  StallWatchdog(Environment* env, uint64_t threshold_ms, bool report);
+  ~StallWatchdog();
+
+  // Stops the watchdog thread. The counters keep their values.
+  void Stop();
+
+  uint64_t stall_count() const { return stall_count_; }
+  // The duration of the longest stall that ended, in nanoseconds.
+  uint64_t max_stall_duration() const { return max_stall_duration_; }
+
+ private:
+  static void Run(void* arg);
+  static void Timer(uv_timer_t* timer);
+  static void PrintStall(Environment* env);
+
+  Environment* env_;
+  const uint64_t threshold_;
+  const bool report_;
+  bool stopped_ = false;
+  uv_thread_t thread_;
+  uv_loop_t loop_;
+  uv_async_t async_;
+  uv_timer_t timer_;
+
+  // Only accessed from the watchdog thread.
+  uint64_t last_loop_count_ = 0;
+  uint64_t last_idle_time_ = 0;
+  uint64_t last_progress_ = 0;
+  bool stalled_ = false;
+
+  std::atomic<uint64_t> stall_count_{0};
+  std::atomic<uint64_t> max_stall_duration_{0};
+};
+
 class SigintWatchdogBase {
  public:
   virtual ~SigintWatchdogBase() = default;
@@ -6,6 +6,7 @@
 #include "node.h"
 #include "node_errors.h"
 #include "node_mem-inl.h"
+#include "node_process-inl.h"
 #include "path.h"
 #include "sqlite3.h"
 #include "util-inl.h"
@@ -82,10 +83,34 @@ static void ThrowQuotaExceededException(Local<Context> context) {
   isolate->ThrowException(exception);
 }
 
+// The value cache is dropped once it holds this many UTF-16 code units.
+static constexpr size_t kMaxCacheSize = 1 << 20;
+
+static std::u16string ToU16String(const TwoByteValue& value) {
+  return std::u16string(reinterpret_cast<const char16_t*>(value.out()),
+                        value.length());
+}
+
+static std::u16string ColumnToU16String(sqlite3_stmt* stmt, int column) {
+  CHECK(sqlite3_column_type(stmt, column) == SQLITE_BLOB);
+  auto size = sqlite3_column_bytes(stmt, column) / sizeof(char16_t);
+  return std::u16string(
+      static_cast<const char16_t*>(sqlite3_column_blob(stmt, column)), size);
+}
+
+static MaybeLocal<String> U16StringToString(Isolate* isolate,
+                                            const std::u16string& value) {
+  return String::NewFromTwoByte(isolate,
+                                reinterpret_cast<const uint16_t*>(value.data()),
+                                NewStringType::kNormal,
+                                value.size());
+}
+
 Storage::Storage(Environment* env,
                  Local<Object> object,
-                 std::string_view location)
-    : BaseObject(env, object) {
+                 std::string_view location,
+                 bool write_back)
+    : BaseObject(env, object), write_back_(write_back) {
   MakeWeak();
   symbols_.Reset(env->isolate(), Map::New(env->isolate()));
   db_ = nullptr;
@@ -93,12 +118,18 @@ Storage::Storage(Environment* env,
 }
 
 Storage::~Storage() {
+  Flush();
+  for (auto& stmt : statements_) {
+    stmt = nullptr;
+  }
   db_ = nullptr;
 }
 
 void Storage::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("symbols", symbols_);
   tracker->TrackField("location", location_);
+  tracker->TrackFieldWithSize("value_cache",
+                              value_cache_size_ * sizeof(char16_t));
 }
 
 Maybe<void> Storage::Open() {
@@ -225,71 +256,199 @@ void Storage::New(const FunctionCallbackInfo<Value>& args) {
     ToNamespacedPath(env, &location);
   }
 
-  new Storage(env, args.This(), location.ToStringView());
+  new Storage(env, args.This(), location.ToStringView(), args[2]->IsTrue());
+}
+
+sqlite3_stmt* Storage::GetStatement(StatementId id) {
+  // Indexed by StatementId.
+  static constexpr std::string_view sql[kStatementCount] = {
+      "DELETE FROM nodejs_webstorage",
+      "PRAGMA data_version",
+      "SELECT key FROM nodejs_webstorage",
+      "SELECT count(*) FROM nodejs_webstorage",
+      "SELECT value FROM nodejs_webstorage WHERE key = ? LIMIT 1",
+      "SELECT key FROM nodejs_webstorage LIMIT 1 OFFSET ?",
+      "DELETE FROM nodejs_webstorage WHERE key = ?",
+      "INSERT INTO nodejs_webstorage (key, value) VALUES (?, ?)"
+      "  ON CONFLICT (key) DO UPDATE SET value = EXCLUDED.value"
+      "  WHERE EXCLUDED.key = key",
+  };
+
+  if (!statements_[id]) {
+    sqlite3_stmt* s = nullptr;
+    int r = sqlite3_prepare_v3(db_.get(),
+                               sql[id].data(),
+                               sql[id].size(),
+                               SQLITE_PREPARE_PERSISTENT,
+                               &s,
+                               nullptr);
+    CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, nullptr);
+    statements_[id] = stmt_unique_ptr(s);
+  }
+  return statements_[id].get();
+}
+
+Maybe<void> Storage::ValidateCache() {
+  // No other connection can change an in-memory database, or commit while
+  // this connection holds the write lock.
+  if (location_ == kInMemoryPath || in_transaction_) {
+    return JustVoid();
+  }
+
+  sqlite3_stmt* stmt = GetStatement(kDataVersionStatement);
+  if (stmt == nullptr) {
+    return Nothing<void>();
+  }
+  auto reset = OnScopeLeave([stmt] { sqlite3_reset(stmt); });
+  CHECK_ERROR_OR_THROW(env(), sqlite3_step(stmt), SQLITE_ROW, Nothing<void>());
+  int64_t data_version = sqlite3_column_int64(stmt, 0);
+  if (data_version != data_version_) {
+    ClearCache();
+    data_version_ = data_version;
+  }
+  return JustVoid();
+}
+
+void Storage::CacheValue(std::u16string key,
+                         std::optional<std::u16string> value) {
+  auto it = value_cache_.find(key);
+  if (it != value_cache_.end()) {
+    value_cache_size_ -= it->first.size();
+    if (it->second.has_value()) {
+      value_cache_size_ -= it->second->size();
+    }
+    value_cache_.erase(it);
+  }
+
+  size_t size = key.size() + (value.has_value() ? value->size() : 0);
+  if (size > kMaxCacheSize) {
+    return;
+  }
+  if (value_cache_size_ + size > kMaxCacheSize) {
+    value_cache_.clear();
+    value_cache_size_ = 0;
+  }
+  value_cache_size_ += size;
+  value_cache_.emplace(std::move(key), std::move(value));
+}
+
+void Storage::ClearCache() {
+  value_cache_.clear();
+  value_cache_size_ = 0;
+  key_cache_.reset();
+}
+
+Maybe<void> Storage::BeginWrite() {
+  if (!write_back_ || in_transaction_) {
+    return JustVoid();
+  }
+
+  int r = sqlite3_exec(db_.get(), "BEGIN IMMEDIATE", 0, 0, nullptr);
+  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
+  // Other connections may have committed before the write lock was taken.
+  if (ValidateCache().IsNothing()) {
+    sqlite3_exec(db_.get(), "ROLLBACK", 0, 0, nullptr);
+    return Nothing<void>();
+  }
+  in_transaction_ = true;
+
+  env()->SetImmediate(
+      [storage = BaseObjectPtr<Storage>(this)](Environment* env) {
+        int r = storage->Flush();
+        if (r != SQLITE_OK) {
+          ProcessEmitWarning(
+              env, "Failed to commit Web Storage data: %s", sqlite3_errstr(r));
+        }
+      });
+  return JustVoid();
+}
+
+int Storage::Flush() {
+  if (!in_transaction_) {
+    return SQLITE_OK;
+  }
+
+  in_transaction_ = false;
+  int r = sqlite3_exec(db_.get(), "COMMIT", 0, 0, nullptr);
+  if (r != SQLITE_OK) {
+    sqlite3_exec(db_.get(), "ROLLBACK", 0, 0, nullptr);
+    ClearCache();
+  }
+  return r;
 }
 
 Maybe<void> Storage::Clear() {
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || BeginWrite().IsNothing()) {
     return Nothing<void>();
   }
 
-  static constexpr std::string_view sql = "DELETE FROM nodejs_webstorage";
-  sqlite3_stmt* s = nullptr;
-  CHECK_ERROR_OR_THROW(
-      env(),
-      sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0),
-      SQLITE_OK,
-      Nothing<void>());
-  auto stmt = stmt_unique_ptr(s);
-  CHECK_ERROR_OR_THROW(
-      env(), sqlite3_step(stmt.get()), SQLITE_DONE, Nothing<void>());
+  sqlite3_stmt* stmt = GetStatement(kClearStatement);
+  if (stmt == nullptr) {
+    return Nothing<void>();
+  }
+  auto reset = OnScopeLeave([stmt] { sqlite3_reset(stmt); });
+  CHECK_ERROR_OR_THROW(env(), sqlite3_step(stmt), SQLITE_DONE, Nothing<void>());
+  ClearCache();
+  key_cache_.emplace();
   return JustVoid();
 }
 
 MaybeLocal<Array> Storage::Enumerate() {
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || ValidateCache().IsNothing()) {
     return Local<Array>();
   }
 
-  static constexpr std::string_view sql = "SELECT key FROM nodejs_webstorage";
-  sqlite3_stmt* s = nullptr;
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Array>());
-  auto stmt = stmt_unique_ptr(s);
+  std::vector<std::u16string> keys;
+  if (!key_cache_.has_value()) {
+    sqlite3_stmt* stmt = GetStatement(kEnumerateStatement);
+    if (stmt == nullptr) {
+      return Local<Array>();
+    }
+    auto reset = OnScopeLeave([stmt] { sqlite3_reset(stmt); });
+    size_t size = 0;
+    int r;
+    while ((r = sqlite3_step(stmt)) == SQLITE_ROW) {
+      keys.emplace_back(ColumnToU16String(stmt, 0));
+      size += keys.back().size();
+    }
+    CHECK_ERROR_OR_THROW(env(), r, SQLITE_DONE, Local<Array>());
+    if (size <= kMaxCacheSize) {
+      key_cache_ = std::move(keys);
+    }
+  }
+
+  const std::vector<std::u16string>& result =
+      key_cache_.has_value() ? *key_cache_ : keys;
   LocalVector<Value> values(env()->isolate());
-  Local<Value> value;
-  while ((r = sqlite3_step(stmt.get())) == SQLITE_ROW) {
-    CHECK(sqlite3_column_type(stmt.get(), 0) == SQLITE_BLOB);
-    auto size = sqlite3_column_bytes(stmt.get(), 0) / sizeof(uint16_t);
-    if (!String::NewFromTwoByte(env()->isolate(),
-                                reinterpret_cast<const uint16_t*>(
-                                    sqlite3_column_blob(stmt.get(), 0)),
-                                NewStringType::kNormal,
-                                size)
-             .ToLocal(&value)) {
+  values.reserve(result.size());
+  Local<String> value;
+  for (const std::u16string& key : result) {
+    if (!U16StringToString(env()->isolate(), key).ToLocal(&value)) {
       return Local<Array>();
     }
     values.emplace_back(value);
   }
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_DONE, Local<Array>());
   return Array::New(env()->isolate(), values.data(), values.size());
 }
 
 MaybeLocal<Value> Storage::Length() {
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || ValidateCache().IsNothing()) {
     return {};
   }
 
-  static constexpr std::string_view sql =
-      "SELECT count(*) FROM nodejs_webstorage";
-  sqlite3_stmt* s = nullptr;
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Value>());
-  auto stmt = stmt_unique_ptr(s);
-  CHECK_ERROR_OR_THROW(
-      env(), sqlite3_step(stmt.get()), SQLITE_ROW, Local<Value>());
-  CHECK(sqlite3_column_type(stmt.get(), 0) == SQLITE_INTEGER);
-  int result = sqlite3_column_int(stmt.get(), 0);
+  if (key_cache_.has_value()) {
+    return Integer::NewFromUnsigned(env()->isolate(),
+                                    static_cast<uint32_t>(key_cache_->size()));
+  }
+
+  sqlite3_stmt* stmt = GetStatement(kLengthStatement);
+  if (stmt == nullptr) {
+    return {};
+  }
+  auto reset = OnScopeLeave([stmt] { sqlite3_reset(stmt); });
+  CHECK_ERROR_OR_THROW(env(), sqlite3_step(stmt), SQLITE_ROW, Local<Value>());
+  CHECK(sqlite3_column_type(stmt, 0) == SQLITE_INTEGER);
+  int result = sqlite3_column_int(stmt, 0);
   return Integer::New(env()->isolate(), result);
 }
 
@@ -299,61 +458,73 @@ MaybeLocal<Value> Storage::Load(Local<Name> key) {
     return symbol_map->Get(env()->context(), key);
   }
 
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || ValidateCache().IsNothing()) {
     return {};
   }
 
-  static constexpr std::string_view sql =
-      "SELECT value FROM nodejs_webstorage WHERE key = ? LIMIT 1";
-  sqlite3_stmt* s = nullptr;
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Value>());
-  auto stmt = stmt_unique_ptr(s);
   TwoByteValue utf16key(env()->isolate(), key);
+  std::u16string cache_key = ToU16String(utf16key);
+  auto it = value_cache_.find(cache_key);
+  if (it != value_cache_.end()) {
+    if (!it->second.has_value()) {
+      return Null(env()->isolate());
+    }
+    return U16StringToString(env()->isolate(), *it->second).As<Value>();
+  }
+
+  sqlite3_stmt* stmt = GetStatement(kLoadStatement);
+  if (stmt == nullptr) {
+    return {};
+  }
+  auto reset = OnScopeLeave([stmt] {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+  });
   auto key_size = utf16key.length() * sizeof(uint16_t);
-  r = sqlite3_bind_blob(stmt.get(), 1, utf16key.out(), key_size, SQLITE_STATIC);
+  int r = sqlite3_bind_blob(stmt, 1, utf16key.out(), key_size, SQLITE_STATIC);
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Value>());
-  r = sqlite3_step(stmt.get());
+  r = sqlite3_step(stmt);
   if (r == SQLITE_ROW) {
-    CHECK(sqlite3_column_type(stmt.get(), 0) == SQLITE_BLOB);
-    auto size = sqlite3_column_bytes(stmt.get(), 0) / sizeof(uint16_t);
-    return String::NewFromTwoByte(env()->isolate(),
-                                  reinterpret_cast<const uint16_t*>(
-                                      sqlite3_column_blob(stmt.get(), 0)),
-                                  NewStringType::kNormal,
-                                  size)
-        .As<Value>();
+    std::u16string value = ColumnToU16String(stmt, 0);
+    Local<String> result;
+    if (!U16StringToString(env()->isolate(), value).ToLocal(&result)) {
+      return {};
+    }
+    CacheValue(std::move(cache_key), std::move(value));
+    return result;
   } else if (r != SQLITE_DONE) {
     THROW_SQLITE_ERROR(env(), r);
     return {};
   } else {
+    CacheValue(std::move(cache_key), std::nullopt);
     return Null(env()->isolate());
   }
 }
 
 MaybeLocal<Value> Storage::LoadKey(const int index) {
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || ValidateCache().IsNothing()) {
     return {};
   }
 
-  static constexpr std::string_view sql =
-      "SELECT key FROM nodejs_webstorage LIMIT 1 OFFSET ?";
-  sqlite3_stmt* s = nullptr;
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Value>());
-  auto stmt = stmt_unique_ptr(s);
-  r = sqlite3_bind_int(stmt.get(), 1, index);
+  if (key_cache_.has_value()) {
+    if (static_cast<size_t>(index) >= key_cache_->size()) {
+      return Null(env()->isolate());
+    }
+    return U16StringToString(env()->isolate(), (*key_cache_)[index])
+        .As<Value>();
+  }
+
+  sqlite3_stmt* stmt = GetStatement(kLoadKeyStatement);
+  if (stmt == nullptr) {
+    return {};
+  }
+  auto reset = OnScopeLeave([stmt] { sqlite3_reset(stmt); });
+  int r = sqlite3_bind_int(stmt, 1, index);
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Local<Value>());
 
-  r = sqlite3_step(stmt.get());
+  r = sqlite3_step(stmt);
   if (r == SQLITE_ROW) {
-    CHECK(sqlite3_column_type(stmt.get(), 0) == SQLITE_BLOB);
-    auto size = sqlite3_column_bytes(stmt.get(), 0) / sizeof(uint16_t);
-    return String::NewFromTwoByte(env()->isolate(),
-                                  reinterpret_cast<const uint16_t*>(
-                                      sqlite3_column_blob(stmt.get(), 0)),
-                                  NewStringType::kNormal,
-                                  size)
+    return U16StringToString(env()->isolate(), ColumnToU16String(stmt, 0))
         .As<Value>();
   } else if (r != SQLITE_DONE) {
     THROW_SQLITE_ERROR(env(), r);
@@ -370,22 +541,28 @@ Maybe<void> Storage::Remove(Local<Name> key) {
     return result.IsNothing() ? Nothing<void>() : JustVoid();
   }
 
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || BeginWrite().IsNothing()) {
     return Nothing<void>();
   }
 
-  static constexpr std::string_view sql =
-      "DELETE FROM nodejs_webstorage WHERE key = ?";
-  sqlite3_stmt* s = nullptr;
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
-  auto stmt = stmt_unique_ptr(s);
+  sqlite3_stmt* stmt = GetStatement(kRemoveStatement);
+  if (stmt == nullptr) {
+    return Nothing<void>();
+  }
+  auto reset = OnScopeLeave([stmt] {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+  });
   TwoByteValue utf16key(env()->isolate(), key);
   auto key_size = utf16key.length() * sizeof(uint16_t);
-  r = sqlite3_bind_blob(stmt.get(), 1, utf16key.out(), key_size, SQLITE_STATIC);
+  int r = sqlite3_bind_blob(stmt, 1, utf16key.out(), key_size, SQLITE_STATIC);
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
-  CHECK_ERROR_OR_THROW(
-      env(), sqlite3_step(stmt.get()), SQLITE_DONE, Nothing<void>());
+  CHECK_ERROR_OR_THROW(env(), sqlite3_step(stmt), SQLITE_DONE, Nothing<void>());
+
+  if (sqlite3_changes(db_.get()) > 0) {
+    key_cache_.reset();
+  }
+  CacheValue(ToU16String(utf16key), std::nullopt);
   return JustVoid();
 }
 
@@ -401,34 +578,41 @@ Maybe<void> Storage::Store(Local<Name> key, Local<Value> value) {
     return Nothing<void>();
   }
 
-  if (!Open().IsJust()) {
+  if (!Open().IsJust() || BeginWrite().IsNothing()) {
     return Nothing<void>();
   }
 
-  static constexpr std::string_view sql =
-      "INSERT INTO nodejs_webstorage (key, value) VALUES (?, ?)"
-      "  ON CONFLICT (key) DO UPDATE SET value = EXCLUDED.value"
-      "  WHERE EXCLUDED.key = key";
-  sqlite3_stmt* s = nullptr;
+  sqlite3_stmt* stmt = GetStatement(kStoreStatement);
+  if (stmt == nullptr) {
+    return Nothing<void>();
+  }
+  auto reset = OnScopeLeave([stmt] {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+  });
   TwoByteValue utf16key(env()->isolate(), key);
   TwoByteValue utf16val(env()->isolate(), val);
-  int r = sqlite3_prepare_v2(db_.get(), sql.data(), sql.size(), &s, 0);
-  CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
-  auto stmt = stmt_unique_ptr(s);
   auto key_size = utf16key.length() * sizeof(uint16_t);
-  r = sqlite3_bind_blob(stmt.get(), 1, utf16key.out(), key_size, SQLITE_STATIC);
+  int r = sqlite3_bind_blob(stmt, 1, utf16key.out(), key_size, SQLITE_STATIC);
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
   auto val_size = utf16val.length() * sizeof(uint16_t);
-  r = sqlite3_bind_blob(stmt.get(), 2, utf16val.out(), val_size, SQLITE_STATIC);
+  r = sqlite3_bind_blob(stmt, 2, utf16val.out(), val_size, SQLITE_STATIC);
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_OK, Nothing<void>());
 
-  r = sqlite3_step(stmt.get());
+  r = sqlite3_step(stmt);
   if (r == SQLITE_CONSTRAINT) {
     ThrowQuotaExceededException(env()->context());
     return Nothing<void>();
   }
 
   CHECK_ERROR_OR_THROW(env(), r, SQLITE_DONE, Nothing<void>());
+
+  std::u16string cache_key = ToU16String(utf16key);
+  auto it = value_cache_.find(cache_key);
+  if (it == value_cache_.end() || !it->second.has_value()) {
+    key_cache_.reset();
+  }
+  CacheValue(std::move(cache_key), ToU16String(utf16val));
   return JustVoid();
 }
 
@@ -436,6 +620,15 @@ static MaybeLocal<String> Uint32ToName(Local<Context> context, uint32_t index) {
   return Uint32::New(context->GetIsolate(), index)->ToString(context);
 }
 
+static void Flush(const FunctionCallbackInfo<Value>& info) {
+  Storage* storage;
+  ASSIGN_OR_RETURN_UNWRAP(&storage, info[0]);
+  int r = storage->Flush();
+  if (r != SQLITE_OK) {
+    THROW_SQLITE_ERROR(Environment::GetCurrent(info), r);
+  }
+}
+
 static void Clear(const FunctionCallbackInfo<Value>& info) {
   Storage* storage;
   ASSIGN_OR_RETURN_UNWRAP(&storage, info.This());
@@ -750,6 +943,7 @@ static void Initialize(Local<Object> target,
   SetProtoMethod(isolate, ctor_tmpl, "removeItem", RemoveItem);
   SetProtoMethod(isolate, ctor_tmpl, "setItem", SetItem);
   SetConstructorFunction(context, target, "Storage", ctor_tmpl);
+  SetMethod(context, target, "flush", Flush);
 
   auto symbol = env->isolate_data()->constructor_key_symbol();
   target
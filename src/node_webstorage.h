@@ -8,6 +8,11 @@
 #include "sqlite3.h"
 #include "util.h"
 
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace node {
 namespace webstorage {
 
@@ -29,7 +34,8 @@ class Storage : public BaseObject {
  public:
   Storage(Environment* env,
           v8::Local<v8::Object> object,
-          std::string_view location);
+          std::string_view location,
+          bool write_back);
   void MemoryInfo(MemoryTracker* tracker) const override;
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -40,17 +46,52 @@ class Storage : public BaseObject {
   v8::MaybeLocal<v8::Value> LoadKey(const int index);
   v8::Maybe<void> Remove(v8::Local<v8::Name> key);
   v8::Maybe<void> Store(v8::Local<v8::Name> key, v8::Local<v8::Value> value);
+  // Commits the transaction that batches writes in write-back mode.
+  int Flush();
 
   SET_MEMORY_INFO_NAME(Storage)
   SET_SELF_SIZE(Storage)
 
  private:
+  enum StatementId {
+    kClearStatement,
+    kDataVersionStatement,
+    kEnumerateStatement,
+    kLengthStatement,
+    kLoadStatement,
+    kLoadKeyStatement,
+    kRemoveStatement,
+    kStoreStatement,
+    kStatementCount
+  };
+
   v8::Maybe<void> Open();
+  // Returns the cached prepared statement, preparing it on first use.
+  sqlite3_stmt* GetStatement(StatementId id);
+  // Drops the cached values if another connection changed the database.
+  v8::Maybe<void> ValidateCache();
+  void CacheValue(std::u16string key, std::optional<std::u16string> value);
+  void ClearCache();
+  // Opens the transaction that batches writes until the next tick.
+  v8::Maybe<void> BeginWrite();
 
   ~Storage() override;
   std::string location_;
   conn_unique_ptr db_;
+  stmt_unique_ptr statements_[kStatementCount];
   v8::Global<v8::Map> symbols_;
+
+  bool write_back_;
+  bool in_transaction_ = false;
+
+  // Values read from or written to the database, or std::nullopt for keys
+  // that are known to be missing. The cache is bounded by kMaxCacheSize and
+  // only used while `PRAGMA data_version` is unchanged.
+  std::unordered_map<std::u16string, std::optional<std::u16string>>
+      value_cache_;
+  size_t value_cache_size_ = 0;
+  std::optional<std::vector<std::u16string>> key_cache_;
+  int64_t data_version_ = -1;
 };
 
 }  // namespace webstorage
@@ -13,6 +13,8 @@
 #include "util-inl.h"
 #include "v8-cppgc.h"
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -40,6 +42,7 @@ using v8::ResourceConstraints;
 using v8::SealHandleScope;
 using v8::String;
 using v8::TryCatch;
+using v8::Uint32;
 using v8::Value;
 
 namespace node {
@@ -138,6 +141,186 @@ void Worker::UpdateResourceConstraints(ResourceConstraints* constraints) {
   }
 }
 
+// Isolates that are deserialized from the snapshot ahead of time on a
+// background thread, so that starting a Worker does not have to wait for
+// isolate creation. Each entry comes with the event loop that the isolate
+// is registered with on the platform. Workers that exit cleanly hand their
+// isolate back until it has served `max_uses` of them.
+class WorkerIsolatePool {
+ public:
+  struct Entry {
+    std::unique_ptr<uv_loop_t> loop;
+    std::shared_ptr<ArrayBufferAllocator> allocator;
+    Isolate* isolate = nullptr;
+    size_t max_young_gen_size = 0;
+    uint64_t uses = 0;
+  };
+
+  // Returns nullptr unless StartIsolatePool() has been called.
+  static WorkerIsolatePool* Get() { return pool_.load(); }
+
+  // Takes an isolate for |w|, or returns nullptr if the Worker has to
+  // create its own, e.g. because it sets custom resource limits.
+  std::unique_ptr<Entry> Take(Worker* w);
+  // Returns false if the isolate should be disposed of instead.
+  bool Return(std::unique_ptr<Entry>* entry);
+
+  static void Start(Environment* env, size_t size, uint64_t max_uses);
+
+ private:
+  WorkerIsolatePool(MultiIsolatePlatform* platform,
+                    const SnapshotData* snapshot_data,
+                    size_t size,
+                    uint64_t max_uses)
+      : platform_(platform),
+        snapshot_data_(snapshot_data),
+        size_(size),
+        max_uses_(max_uses) {}
+
+  std::unique_ptr<Entry> CreateEntry();
+  void DisposeEntry(std::unique_ptr<Entry> entry);
+  void Refill();
+  void Stop();
+
+  static std::atomic<WorkerIsolatePool*> pool_;
+
+  MultiIsolatePlatform* const platform_;
+  const SnapshotData* const snapshot_data_;
+  const size_t size_;
+  const uint64_t max_uses_;
+  uv_thread_t thread_;
+
+  Mutex mutex_;
+  ConditionVariable refill_;
+  std::deque<std::unique_ptr<Entry>> entries_;
+  bool stopped_ = false;
+};
+
+std::atomic<WorkerIsolatePool*> WorkerIsolatePool::pool_{nullptr};
+
+void WorkerIsolatePool::Start(Environment* env,
+                              size_t size,
+                              uint64_t max_uses) {
+  CHECK(env->is_main_thread());
+  if (pool_.load() != nullptr || size == 0) return;
+  // The pool outlives the main Environment by design: Workers that are
+  // still being torn down may hold a pointer to it. Only its isolates are
+  // released when the main Environment goes away.
+  WorkerIsolatePool* pool =
+      new WorkerIsolatePool(env->isolate_data()->platform(),
+                            env->isolate_data()->snapshot_data(),
+                            size,
+                            max_uses);
+  CHECK_EQ(uv_thread_create(
+               &pool->thread_,
+               [](void* arg) {
+                 static_cast<WorkerIsolatePool*>(arg)->Refill();
+               },
+               pool),
+           0);
+  pool_.store(pool);
+  env->AddCleanupHook(
+      [](void* arg) { static_cast<WorkerIsolatePool*>(arg)->Stop(); }, pool);
+}
+
+std::unique_ptr<WorkerIsolatePool::Entry> WorkerIsolatePool::CreateEntry() {
+  auto entry = std::make_unique<Entry>();
+  entry->loop = std::make_unique<uv_loop_t>();
+  if (uv_loop_init(entry->loop.get()) != 0) return nullptr;
+  uv_loop_configure(entry->loop.get(), UV_METRICS_IDLE_TIME);
+
+  entry->allocator = ArrayBufferAllocator::Create();
+  Isolate::CreateParams params;
+  SetIsolateCreateParamsForNode(&params);
+  params.array_buffer_allocator_shared = entry->allocator;
+  entry->isolate =
+      NewIsolate(&params, entry->loop.get(), platform_, snapshot_data_);
+  if (entry->isolate == nullptr) {
+    CheckedUvLoopClose(entry->loop.get());
+    return nullptr;
+  }
+  SetIsolateUpForNode(entry->isolate);
+  entry->max_young_gen_size =
+      params.constraints.max_young_generation_size_in_bytes();
+  return entry;
+}
+
+void WorkerIsolatePool::DisposeEntry(std::unique_ptr<Entry> entry) {
+  bool platform_finished = false;
+  platform_->AddIsolateFinishedCallback(entry->isolate, [](void* data) {
+    *static_cast<bool*>(data) = true;
+  }, &platform_finished);
+  platform_->DisposeIsolate(entry->isolate);
+  while (!platform_finished) {
+    uv_run(entry->loop.get(), UV_RUN_ONCE);
+  }
+  CheckedUvLoopClose(entry->loop.get());
+}
+
+void WorkerIsolatePool::Refill() {
+  uv_thread_setname("WorkerIsolatePool");
+  Mutex::ScopedLock lock(mutex_);
+  while (!stopped_) {
+    if (entries_.size() >= size_) {
+      refill_.Wait(lock);
+      continue;
+    }
+    std::unique_ptr<Entry> entry;
+    {
+      Mutex::ScopedUnlock unlock(lock);
+      entry = CreateEntry();
+    }
+    // Workers fall back to creating their own isolates from here on.
+    if (!entry) break;
+    if (stopped_) {
+      Mutex::ScopedUnlock unlock(lock);
+      DisposeEntry(std::move(entry));
+      break;
+    }
+    entries_.push_back(std::move(entry));
+  }
+}
+
+std::unique_ptr<WorkerIsolatePool::Entry> WorkerIsolatePool::Take(Worker* w) {
+  // The pooled isolates use the default heap configuration.
+  if (w->snapshot_data() != snapshot_data_ ||
+      w->resource_limits_[kMaxYoungGenerationSizeMb] > 0 ||
+      w->resource_limits_[kMaxOldGenerationSizeMb] > 0 ||
+      w->resource_limits_[kCodeRangeSizeMb] > 0) {
+    return nullptr;
+  }
+  Mutex::ScopedLock lock(mutex_);
+  if (stopped_ || entries_.empty()) return nullptr;
+  std::unique_ptr<Entry> entry = std::move(entries_.front());
+  entries_.pop_front();
+  entry->uses++;
+  refill_.Signal(lock);
+  return entry;
+}
+
+bool WorkerIsolatePool::Return(std::unique_ptr<Entry>* entry) {
+  if ((*entry)->uses >= max_uses_) return false;
+  Mutex::ScopedLock lock(mutex_);
+  if (stopped_ || entries_.size() >= size_) return false;
+  entries_.push_back(std::move(*entry));
+  return true;
+}
+
+void WorkerIsolatePool::Stop() {
+  std::deque<std::unique_ptr<Entry>> entries;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    stopped_ = true;
+    refill_.Signal(lock);
+  }
+  CHECK_EQ(uv_thread_join(&thread_), 0);
+  {
+    Mutex::ScopedLock lock(mutex_);
+    entries.swap(entries_);
+  }
+  for (auto& entry : entries) DisposeEntry(std::move(entry));
+}
+
 // This class contains data that is only relevant to the child thread itself,
 // and only while it is running.
 // (Eventually, the Environment instance should probably also be moved here.)
@@ -145,7 +328,26 @@ class WorkerThreadData {
  public:
   explicit WorkerThreadData(Worker* w)
     : w_(w) {
-    int ret = uv_loop_init(&loop_);
+    WorkerIsolatePool* pool = WorkerIsolatePool::Get();
+    // The heap of a pooled isolate has been touched by the thread that
+    // created it, so it would not be local to the CPUs of a bound worker.
+    if (pool != nullptr && w->cpu_mask_.empty()) pooled_ = pool->Take(w);
+    if (pooled_) {
+      Debug(w, "Worker %llu uses a pooled isolate", w->thread_id_.id);
+      loop_ = pooled_->loop.get();
+      loop_init_failed_ = false;
+      // Record the default limits the pooled isolate was created with.
+      Isolate::CreateParams params;
+      SetIsolateCreateParamsForNode(&params);
+      w->UpdateResourceConstraints(&params.constraints);
+      SetUpIsolate(pooled_->isolate,
+                   pooled_->allocator.get(),
+                   pooled_->max_young_gen_size);
+      return;
+    }
+
+    loop_ = &own_loop_;
+    int ret = uv_loop_init(loop_);
     if (ret != 0) {
       char err_buf[128];
       uv_err_name_r(ret, err_buf, sizeof(err_buf));
@@ -154,16 +356,15 @@ class WorkerThreadData {
       return;
     }
     loop_init_failed_ = false;
-    uv_loop_configure(&loop_, UV_METRICS_IDLE_TIME);
+    uv_loop_configure(loop_, UV_METRICS_IDLE_TIME);
 
-    std::shared_ptr<ArrayBufferAllocator> allocator =
-        ArrayBufferAllocator::Create();
+    allocator_ = ArrayBufferAllocator::Create();
     Isolate::CreateParams params;
     SetIsolateCreateParamsForNode(&params);
     w->UpdateResourceConstraints(&params.constraints);
-    params.array_buffer_allocator_shared = allocator;
+    params.array_buffer_allocator_shared = allocator_;
     Isolate* isolate =
-        NewIsolate(&params, &loop_, w->platform_, w->snapshot_data());
+        NewIsolate(&params, loop_, w->platform_, w->snapshot_data());
     if (isolate == nullptr) {
       // TODO(joyeecheung): maybe this should be kBootstrapFailure instead?
       w->Exit(ExitCode::kGenericUserError,
@@ -173,45 +374,21 @@ class WorkerThreadData {
     }
 
     SetIsolateUpForNode(isolate);
-
-    // Be sure it's called before Environment::InitializeDiagnostics()
-    // so that this callback stays when the callback of
-    // --heapsnapshot-near-heap-limit gets is popped.
-    isolate->AddNearHeapLimitCallback(Worker::NearHeapLimit, w);
-
-    {
-      Locker locker(isolate);
-      Isolate::Scope isolate_scope(isolate);
-      // V8 computes its stack limit the first time a `Locker` is used based on
-      // --stack-size. Reset it to the correct value.
-      isolate->SetStackLimit(w->stack_base_);
-
-      HandleScope handle_scope(isolate);
-      isolate_data_.reset(IsolateData::CreateIsolateData(
-          isolate,
-          &loop_,
-          w_->platform_,
-          allocator.get(),
-          w->snapshot_data()->AsEmbedderWrapper().get(),
-          std::move(w_->per_isolate_opts_)));
-      CHECK(isolate_data_);
-      CHECK(!isolate_data_->is_building_snapshot());
-      isolate_data_->set_worker_context(w_);
-      isolate_data_->max_young_gen_size =
-          params.constraints.max_young_generation_size_in_bytes();
-    }
-
-    Mutex::ScopedLock lock(w_->mutex_);
-    w_->isolate_ = isolate;
+    SetUpIsolate(isolate,
+                 allocator_.get(),
+                 params.constraints.max_young_generation_size_in_bytes());
   }
 
   ~WorkerThreadData() {
     Debug(w_, "Worker %llu dispose isolate", w_->thread_id_.id);
     Isolate* isolate;
+    bool clean_exit;
     {
       Mutex::ScopedLock lock(w_->mutex_);
       isolate = w_->isolate_;
       w_->isolate_ = nullptr;
+      clean_exit = w_->exit_code_ == ExitCode::kNoFailure &&
+                   w_->custom_error_ == nullptr;
     }
 
     if (isolate != nullptr) {
@@ -224,6 +401,18 @@ class WorkerThreadData {
         Locker locker(isolate);
         Isolate::Scope isolate_scope(isolate);
         isolate_data_.reset();
+        if (pooled_ && clean_exit) {
+          isolate->RemoveNearHeapLimitCallback(Worker::NearHeapLimit, 0);
+          isolate->CancelTerminateExecution();
+          // Drop what is left of the previous Environment before the
+          // isolate is handed to the next Worker.
+          isolate->LowMemoryNotification();
+        }
+      }
+
+      if (pooled_ && clean_exit &&
+          WorkerIsolatePool::Get()->Return(&pooled_)) {
+        return;
       }
 
       w_->platform_->AddIsolateFinishedCallback(isolate, [](void* data) {
@@ -234,20 +423,56 @@ class WorkerThreadData {
 
       // Wait until the platform has cleaned up all relevant resources.
       while (!platform_finished) {
-        uv_run(&loop_, UV_RUN_ONCE);
+        uv_run(loop_, UV_RUN_ONCE);
       }
     }
     if (!loop_init_failed_) {
-      CheckedUvLoopClose(&loop_);
+      CheckedUvLoopClose(loop_);
     }
   }
 
   bool loop_is_usable() const { return !loop_init_failed_; }
 
  private:
+  void SetUpIsolate(Isolate* isolate,
+                    ArrayBufferAllocator* allocator,
+                    size_t max_young_gen_size) {
+    // Be sure it's called before Environment::InitializeDiagnostics()
+    // so that this callback stays when the callback of
+    // --heapsnapshot-near-heap-limit gets is popped.
+    isolate->AddNearHeapLimitCallback(Worker::NearHeapLimit, w_);
+
+    {
+      Locker locker(isolate);
+      Isolate::Scope isolate_scope(isolate);
+      // V8 computes its stack limit the first time a `Locker` is used based on
+      // --stack-size. Reset it to the correct value.
+      isolate->SetStackLimit(w_->stack_base_);
+
+      HandleScope handle_scope(isolate);
+      isolate_data_.reset(IsolateData::CreateIsolateData(
+          isolate,
+          loop_,
+          w_->platform_,
+          allocator,
+          w_->snapshot_data()->AsEmbedderWrapper().get(),
+          std::move(w_->per_isolate_opts_)));
+      CHECK(isolate_data_);
+      CHECK(!isolate_data_->is_building_snapshot());
+      isolate_data_->set_worker_context(w_);
+      isolate_data_->max_young_gen_size = max_young_gen_size;
+    }
+
+    Mutex::ScopedLock lock(w_->mutex_);
+    w_->isolate_ = isolate;
+  }
+
   Worker* const w_;
-  uv_loop_t loop_;
+  uv_loop_t own_loop_;
+  uv_loop_t* loop_ = nullptr;
   bool loop_init_failed_ = true;
+  std::shared_ptr<ArrayBufferAllocator> allocator_;
+  std::unique_ptr<WorkerIsolatePool::Entry> pooled_;
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data_;
   const SnapshotData* snapshot_data_ = nullptr;
   friend class Worker;
@@ -487,6 +712,75 @@ Worker::~Worker() {
   Debug(this, "Worker %llu destroyed", thread_id_.id);
 }
 
+// Adds the CPUs of a list like "0-3,8,10-11", as found in
+// /sys/devices/system/node/node<N>/cpulist, to |mask|.
+static bool ParseCpuList(const std::string& list, std::vector<char>* mask) {
+  size_t pos = 0;
+  while (pos < list.size() && list[pos] != '\n') {
+    char* end;
+    const char* start = list.c_str() + pos;
+    unsigned long first = strtoul(start, &end, 10);  // NOLINT(runtime/int)
+    if (end == start) return false;
+    unsigned long last = first;  // NOLINT(runtime/int)
+    if (*end == '-') {
+      start = end + 1;
+      last = strtoul(start, &end, 10);
+      if (end == start || last < first) return false;
+    }
+    for (unsigned long cpu = first; cpu <= last; cpu++) {  // NOLINT
+      if (cpu < mask->size()) (*mask)[cpu] = 1;
+    }
+    if (*end == ',') end++;
+    pos = end - list.c_str();
+  }
+  return true;
+}
+
+// Fills |mask| from the cpuAffinity and numaNode options of a Worker. Returns
+// false and throws if one of them names CPUs that do not exist.
+static bool GetCpuMask(Environment* env,
+                       Local<Value> cpus,
+                       Local<Value> numa_node,
+                       std::vector<char>* mask) {
+  if (!cpus->IsArray() && !numa_node->IsInt32()) return true;
+  const int mask_size = uv_cpumask_size();
+  if (mask_size <= 0) {
+    THROW_ERR_FEATURE_UNAVAILABLE_ON_PLATFORM(
+        env, "Binding worker threads to CPUs is not supported");
+    return false;
+  }
+  mask->assign(mask_size, 0);
+
+  if (cpus->IsArray()) {
+    Local<Array> array = cpus.As<Array>();
+    for (uint32_t i = 0; i < array->Length(); i++) {
+      Local<Value> cpu;
+      if (!array->Get(env->context(), i).ToLocal(&cpu)) return false;
+      CHECK(cpu->IsUint32());
+      uint32_t index = cpu.As<Uint32>()->Value();
+      if (index >= static_cast<uint32_t>(mask_size)) {
+        THROW_ERR_OUT_OF_RANGE(
+            env, "CPU %u exceeds the supported number of CPUs", index);
+        return false;
+      }
+      (*mask)[index] = 1;
+    }
+  }
+
+  if (numa_node->IsInt32()) {
+    int node = numa_node.As<Integer>()->Value();
+    std::string path =
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+    std::string list;
+    if (ReadFileSync(&list, path.c_str()) != 0 ||
+        !ParseCpuList(list, mask)) {
+      THROW_ERR_INVALID_ARG_VALUE(env, "NUMA node %d is not available", node);
+      return false;
+    }
+  }
+  return true;
+}
+
 void Worker::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   THROW_IF_INSUFFICIENT_PERMISSIONS(
@@ -694,6 +988,8 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
   limit_info->CopyContents(worker->resource_limits_,
                            sizeof(worker->resource_limits_));
 
+  if (!GetCpuMask(env, args[7], args[8], &worker->cpu_mask_)) return;
+
   CHECK(args[4]->IsBoolean());
   if (args[4]->IsTrue() || env->tracks_unmanaged_fds())
     worker->environment_flags_ |= EnvironmentFlags::kTrackUnmanagedFds;
@@ -739,6 +1035,19 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
     const uintptr_t stack_top = reinterpret_cast<uintptr_t>(&arg);
 
     uv_thread_setname(w->name_.c_str());
+    // Bind the thread before the loop and the isolate are created, so that
+    // the memory they touch first is allocated on the node of these CPUs.
+    if (!w->cpu_mask_.empty()) {
+      uv_thread_t self = uv_thread_self();
+      int err = uv_thread_setaffinity(
+          &self, w->cpu_mask_.data(), nullptr, w->cpu_mask_.size());
+      if (err != 0) {
+        Debug(w,
+              "Worker %llu could not set its CPU affinity: %s",
+              w->thread_id_.id,
+              uv_strerror(err));
+      }
+    }
     // Leave a few kilobytes just to make sure we're within limits and have
     // some space to do work in C++ land.
     w->stack_base_ = stack_top - (w->stack_size_ - kStackBufferSize);
@@ -1080,6 +1389,15 @@ void GetEnvMessagePort(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void StartIsolatePool(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  size_t size = static_cast<size_t>(args[0].As<Number>()->Value());
+  uint64_t max_uses = static_cast<uint64_t>(args[1].As<Number>()->Value());
+  WorkerIsolatePool::Start(env, size, max_uses);
+}
+
 void CreateWorkerPerIsolateProperties(IsolateData* isolate_data,
                                       Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
@@ -1134,6 +1452,7 @@ void CreateWorkerPerIsolateProperties(IsolateData* isolate_data,
   }
 
   SetMethod(isolate, target, "getEnvMessagePort", GetEnvMessagePort);
+  SetMethod(isolate, target, "startIsolatePool", StartIsolatePool);
 }
 
 void CreateWorkerPerContextProperties(Local<Object> target,
@@ -1188,6 +1507,7 @@ void CreateWorkerPerContextProperties(Local<Object> target,
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GetEnvMessagePort);
+  registry->Register(StartIsolatePool);
   registry->Register(Worker::New);
   registry->Register(Worker::StartThread);
   registry->Register(Worker::StopThread);
@@ -14,6 +14,7 @@ namespace node {
 struct SnapshotData;
 namespace worker {
 
+class WorkerIsolatePool;
 class WorkerThreadData;
 
 enum ResourceLimits {
@@ -107,6 +108,10 @@ class Worker : public AsyncWrap {
   // Optional name used for debugging in inspector and trace events.
   std::string name_;
 
+  // CPUs the thread is bound to, in the format of uv_thread_setaffinity().
+  // Empty if the thread uses the default placement.
+  std::vector<char> cpu_mask_;
+
   // Custom resource constraints:
   double resource_limits_[kTotalResourceLimitCount];
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
@@ -137,6 +142,7 @@ class Worker : public AsyncWrap {
 
   const SnapshotData* snapshot_data_ = nullptr;
   const bool is_internal_;
+  friend class WorkerIsolatePool;
   friend class WorkerThreadData;
 };
 
@@ -25,30 +25,43 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "node_debug.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_messaging.h"
 #include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include "v8-fast-api-calls.h"
 #include "v8.h"
 
 #include "brotli/decode.h"
 #include "brotli/encode.h"
 #include "zlib.h"
+#include "zdict.h"
 #include "zstd.h"
 #include "zstd_errors.h"
 
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace node {
 
+using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::CFunction;
 using v8::Context;
+using v8::FastApiCallbackOptions;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -57,8 +70,11 @@ using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Object;
+using v8::Uint32;
 using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -170,6 +186,134 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// Returns the windowBits argument of deflateInit2() or inflateInit2() that
+// selects the format of |mode|.
+int ZlibInitWindowBits(node_zlib_mode mode, int window_bits) {
+  if (mode == GZIP || mode == GUNZIP) {
+    window_bits += 16;
+  }
+
+  if (mode == UNZIP) {
+    window_bits += 32;
+  }
+
+  if (mode == DEFLATERAW || mode == INFLATERAW) {
+    window_bits *= -1;
+  }
+
+  return window_bits;
+}
+
+// Keeps the zlib state of closed streams so that streams that are created
+// later with the same parameters can reuse it. deflateInit2() allocates and
+// sets up the window and hash tables, a few hundred KB at high memory levels,
+// while a reset state only needs them cleared. Streams are only created and
+// closed on the thread of their Environment, so each thread has its own pool.
+class ZlibStatePool {
+ public:
+  struct Key {
+    node_zlib_mode mode;
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  static ZlibStatePool* ForCurrentThread() {
+    static thread_local ZlibStatePool pool;
+    return &pool;
+  }
+
+  // |window_bits| is the value passed to deflateInit2() or inflateInit2().
+  static Key KeyFor(node_zlib_mode mode, int level, int window_bits,
+                    int mem_level, int strategy) {
+    // The parameters other than the window size only affect compression.
+    if (mode == DEFLATE || mode == GZIP || mode == DEFLATERAW)
+      return {mode, level, window_bits, mem_level, strategy};
+    return {mode, 0, window_bits, 0, 0};
+  }
+
+  // Allocation functions for states that are not owned by a stream. They
+  // use the same layout as those of CompressionStream, which took over
+  // states created with them and vice versa. |opaque| is a size_t that
+  // counts the memory held by the state.
+  static void* Alloc(void* opaque, uInt items, uInt size) {
+    size_t real_size =
+        MultiplyWithOverflowCheck(static_cast<size_t>(items),
+                                  static_cast<size_t>(size)) + kOffset;
+    char* memory = UncheckedMalloc(real_size);
+    if (memory == nullptr) [[unlikely]] {
+      return nullptr;
+    }
+    *reinterpret_cast<size_t*>(memory) = real_size;
+    if (opaque != nullptr) *static_cast<size_t*>(opaque) += real_size;
+    return memory + kOffset;
+  }
+
+  static void Free(void* opaque, void* pointer) {
+    if (pointer == nullptr) [[unlikely]] {
+      return;
+    }
+    free(static_cast<char*>(pointer) - kOffset);
+  }
+
+  ZlibStatePool() = default;
+  ZlibStatePool(const ZlibStatePool&) = delete;
+  ZlibStatePool& operator=(const ZlibStatePool&) = delete;
+
+  ~ZlibStatePool() {
+    for (Entry& entry : entries_) End(&entry);
+  }
+
+  // Returns the most recently pooled state for |key|, if any, and stores the
+  // amount of memory it holds in |memory|.
+  std::unique_ptr<z_stream> Take(const Key& key, size_t* memory) {
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+      if (it->key != key) continue;
+      std::unique_ptr<z_stream> strm = std::move(it->strm);
+      *memory = it->memory;
+      entries_.erase(std::next(it).base());
+      return strm;
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of a reset state. The state must not allocate memory
+  // anymore, and its zfree function must not account for the memory, since
+  // the state may outlive the stream that created it.
+  void Put(const Key& key, std::unique_ptr<z_stream> strm, size_t memory) {
+    if (entries_.size() == kMaxEntries) {
+      End(&entries_.front());
+      entries_.erase(entries_.begin());
+    }
+    entries_.push_back(Entry{key, std::move(strm), memory});
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    std::unique_ptr<z_stream> strm;
+    size_t memory;
+  };
+
+  static void End(Entry* entry) {
+    if (entry->key.mode == DEFLATE || entry->key.mode == GZIP ||
+        entry->key.mode == DEFLATERAW) {
+      deflateEnd(entry->strm.get());
+    } else {
+      inflateEnd(entry->strm.get());
+    }
+  }
+
+  static constexpr size_t kOffset =
+      std::max(sizeof(size_t), alignof(max_align_t));
+  static constexpr size_t kMaxEntries = 16;
+  // Least recently pooled first.
+  std::vector<Entry> entries_;
+};
+
 class ZlibContext final : public MemoryRetainer {
  public:
   ZlibContext() = default;
@@ -189,6 +333,15 @@ class ZlibContext final : public MemoryRetainer {
             std::vector<unsigned char>&& dictionary);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
+  // Replaces the state that InitZlib() would create with a reset state with
+  // the same parameters from the pool of the current thread. Returns the
+  // amount of memory the state holds, or 0 if the pool had none.
+  size_t TakeFromPool();
+  // Resets the state of a deflate or inflate stream and moves it into the
+  // pool of the current thread instead of freeing it. |memory| is the amount
+  // of memory the state holds, and |free| releases it without accounting
+  // for it. Returns false if the state cannot be reused.
+  bool Recycle(size_t memory, free_func free);
 
   SET_MEMORY_INFO_NAME(ZlibContext)
   SET_SELF_SIZE(ZlibContext)
@@ -204,9 +357,12 @@ class ZlibContext final : public MemoryRetainer {
   CompressionError ErrorForMessage(const char* message) const;
   CompressionError SetDictionary();
   bool InitZlib();
+  ZlibStatePool::Key PoolKey() const;
 
   Mutex mutex_;  // Protects zlib_init_done_.
   bool zlib_init_done_ = false;
+  bool from_pool_ = false;
+  bool params_changed_ = false;
   int err_ = 0;
   int flush_ = 0;
   int level_ = 0;
@@ -217,7 +373,7 @@ class ZlibContext final : public MemoryRetainer {
   unsigned int gzip_id_bytes_read_ = 0;
   std::vector<unsigned char> dictionary_;
 
-  z_stream strm_;
+  std::unique_ptr<z_stream> strm_ = std::make_unique<z_stream>();
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -291,6 +447,176 @@ class BrotliDecoderContext final : public BrotliContext {
   DeleteFnPtr<BrotliDecoderState, BrotliDecoderDestroyInstance> state_;
 };
 
+// A dictionary that has been digested for both compression and
+// decompression. ZSTD_CDict and ZSTD_DDict are read-only once they have been
+// created, so the streams that use a dictionary share it, also across threads.
+class ZstdDictionary final : public MemoryRetainer {
+ public:
+  static std::shared_ptr<ZstdDictionary> Create(const uint8_t* data,
+                                                size_t size,
+                                                int level) {
+    auto dictionary = std::make_shared<ZstdDictionary>();
+    dictionary->cdict_.reset(ZSTD_createCDict(data, size, level));
+    dictionary->ddict_.reset(ZSTD_createDDict(data, size));
+    if (!dictionary->cdict_ || !dictionary->ddict_) return nullptr;
+    dictionary->id_ = ZSTD_getDictID_fromDict(data, size);
+    dictionary->size_ = size;
+    return dictionary;
+  }
+
+  const ZSTD_CDict* cdict() const { return cdict_.get(); }
+  const ZSTD_DDict* ddict() const { return ddict_.get(); }
+  // 0 for dictionaries that are raw content rather than trained ones.
+  unsigned int id() const { return id_; }
+  size_t size() const { return size_; }
+
+  static void FreeCDict(ZSTD_CDict* cdict) { ZSTD_freeCDict(cdict); }
+  static void FreeDDict(ZSTD_DDict* ddict) { ZSTD_freeDDict(ddict); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("cdict", ZSTD_sizeof_CDict(cdict_.get()));
+    tracker->TrackFieldWithSize("ddict", ZSTD_sizeof_DDict(ddict_.get()));
+  }
+
+  SET_MEMORY_INFO_NAME(ZstdDictionary)
+  SET_SELF_SIZE(ZstdDictionary)
+
+ private:
+  DeleteFnPtr<ZSTD_CDict, FreeCDict> cdict_;
+  DeleteFnPtr<ZSTD_DDict, FreeDDict> ddict_;
+  unsigned int id_ = 0;
+  size_t size_ = 0;
+};
+
+class ZstdDictionaryWrap final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, Local<Object> target) {
+    SetConstructorFunction(env->context(),
+                           target,
+                           "ZstdDictionary",
+                           GetConstructorTemplate(env),
+                           SetConstructorFunctionFlag::NONE);
+  }
+
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+    registry->Register(New);
+    registry->Register(GetId);
+    registry->Register(GetSize);
+  }
+
+  static Local<FunctionTemplate> GetConstructorTemplate(Environment* env) {
+    Local<FunctionTemplate> tmpl =
+        env->zstd_dictionary_constructor_template();
+    if (tmpl.IsEmpty()) {
+      Isolate* isolate = env->isolate();
+      tmpl = NewFunctionTemplate(isolate, New);
+      tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "ZstdDictionary"));
+      tmpl->InstanceTemplate()->SetInternalFieldCount(kInternalFieldCount);
+      SetProtoMethodNoSideEffect(isolate, tmpl, "getId", GetId);
+      SetProtoMethodNoSideEffect(isolate, tmpl, "getSize", GetSize);
+      env->set_zstd_dictionary_constructor_template(tmpl);
+    }
+    return tmpl;
+  }
+
+  static bool HasInstance(Environment* env, Local<Value> value) {
+    return GetConstructorTemplate(env)->HasInstance(value);
+  }
+
+  static BaseObjectPtr<ZstdDictionaryWrap> Create(
+      Environment* env, std::shared_ptr<ZstdDictionary> dictionary) {
+    Local<Object> obj;
+    if (!GetConstructorTemplate(env)
+             ->InstanceTemplate()
+             ->NewInstance(env->context())
+             .ToLocal(&obj)) {
+      return nullptr;
+    }
+    return MakeBaseObject<ZstdDictionaryWrap>(env, obj, std::move(dictionary));
+  }
+
+  ZstdDictionaryWrap(Environment* env,
+                     Local<Object> object,
+                     std::shared_ptr<ZstdDictionary> dictionary)
+      : BaseObject(env, object), dictionary_(std::move(dictionary)) {
+    MakeWeak();
+  }
+
+  const std::shared_ptr<ZstdDictionary>& dictionary() const {
+    return dictionary_;
+  }
+
+  TransferMode GetTransferMode() const override {
+    return TransferMode::kCloneable;
+  }
+
+  std::unique_ptr<worker::TransferData> CloneForMessaging() const override {
+    return std::make_unique<TransferData>(dictionary_);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("dictionary", dictionary_);
+  }
+
+  SET_MEMORY_INFO_NAME(ZstdDictionaryWrap)
+  SET_SELF_SIZE(ZstdDictionaryWrap)
+
+  class TransferData final : public worker::TransferData {
+   public:
+    explicit TransferData(std::shared_ptr<ZstdDictionary> dictionary)
+        : dictionary_(std::move(dictionary)) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        Local<Context> context,
+        std::unique_ptr<worker::TransferData> self) override {
+      return Create(env, std::move(dictionary_));
+    }
+
+    void MemoryInfo(MemoryTracker* tracker) const override {
+      tracker->TrackField("dictionary", dictionary_);
+    }
+
+    SET_MEMORY_INFO_NAME(ZstdDictionaryWrap::TransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    std::shared_ptr<ZstdDictionary> dictionary_;
+  };
+
+ private:
+  // new ZstdDictionary(data, level)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args[0]->IsArrayBufferView());
+    CHECK(args[1]->IsInt32());
+    ArrayBufferViewContents<uint8_t> data(args[0]);
+    std::shared_ptr<ZstdDictionary> dictionary = ZstdDictionary::Create(
+        data.data(), data.length(), args[1].As<Int32>()->Value());
+    if (!dictionary) {
+      return THROW_ERR_ZLIB_INITIALIZATION_FAILED(
+          env, "Could not create zstd dictionary");
+    }
+    new ZstdDictionaryWrap(env, args.This(), std::move(dictionary));
+  }
+
+  static void GetId(const FunctionCallbackInfo<Value>& args) {
+    ZstdDictionaryWrap* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+    args.GetReturnValue().Set(wrap->dictionary_->id());
+  }
+
+  static void GetSize(const FunctionCallbackInfo<Value>& args) {
+    ZstdDictionaryWrap* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+    args.GetReturnValue().Set(
+        static_cast<double>(wrap->dictionary_->size()));
+  }
+
+  std::shared_ptr<ZstdDictionary> dictionary_;
+};
+
 class ZstdContext : public MemoryRetainer {
  public:
   ZstdContext() = default;
@@ -305,7 +631,25 @@ class ZstdContext : public MemoryRetainer {
   ZstdContext(const ZstdContext&) = delete;
   ZstdContext& operator=(const ZstdContext&) = delete;
 
+  // The dictionary is kept so that it can be applied again when the stream
+  // is reset. A digested dictionary is referenced, raw content is loaded.
+  inline void SetDictionary(std::shared_ptr<ZstdDictionary> dictionary) {
+    digested_dictionary_ = std::move(dictionary);
+  }
+  inline void SetDictionary(std::vector<uint8_t>&& dictionary) {
+    dictionary_ = std::move(dictionary);
+  }
+
  protected:
+  CompressionError DictionaryError(size_t result) const {
+    if (!ZSTD_isError(result)) return {};
+    return CompressionError(
+        "Could not set zstd dictionary", "ERR_ZLIB_INITIALIZATION_FAILED", -1);
+  }
+
+  std::shared_ptr<ZstdDictionary> digested_dictionary_;
+  std::vector<uint8_t> dictionary_;
+
   ZSTD_EndDirective flush_ = ZSTD_e_continue;
 
   ZSTD_inBuffer input_ = {nullptr, 0, 0};
@@ -375,7 +719,7 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env, "zlib"),
+        ThreadPoolWork(env, "zlib", ThreadPoolWorkClass::kCompression),
         write_result_(nullptr) {
     MakeWeak();
   }
@@ -400,6 +744,15 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     CHECK(init_done_ && "close before init");
 
     AllocScope alloc_scope(this);
+    if constexpr (std::is_same_v<CompressionContext, ZlibContext>) {
+      // zlib_memory_ has to cover all of the state before it is handed over.
+      AdjustAmountOfExternalAllocatedMemory();
+      if (ctx_.Recycle(zlib_memory_, ZlibStatePool::Free)) {
+        AsyncWrap::env()->external_memory_accounter()->Decrease(
+            AsyncWrap::env()->isolate(), zlib_memory_);
+        zlib_memory_ = 0;
+      }
+    }
     ctx_.Close();
   }
 
@@ -634,6 +987,15 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     free(real_pointer);
   }
 
+  // Accounts for memory that a pooled state already held when the stream
+  // took it over.
+  void AdoptMemory(size_t size) {
+    if (size == 0) return;
+    zlib_memory_ += size;
+    AsyncWrap::env()->external_memory_accounter()->Increase(
+        AsyncWrap::env()->isolate(), size);
+  }
+
   // This is called on the main thread after zlib may have allocated something
   // in order to report it back to V8.
   void AdjustAmountOfExternalAllocatedMemory() {
@@ -753,6 +1115,7 @@ class ZlibStream final : public CompressionStream<ZlibContext> {
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
     wrap->context()->Init(level, window_bits, mem_level, strategy,
                           std::move(dictionary));
+    wrap->AdoptMemory(wrap->context()->TakeFromPool());
   }
 
   static void Params(const FunctionCallbackInfo<Value>& args) {
@@ -878,11 +1241,23 @@ class ZstdStream final : public CompressionStream<CompressionContext> {
     Environment* env = Environment::GetCurrent(args);
     Local<Context> context = env->context();
 
-    CHECK(args.Length() == 4 &&
-          "init(params, pledgedSrcSize, writeResult, writeCallback)");
+    CHECK(args.Length() == 5 &&
+          "init(params, pledgedSrcSize, writeResult, writeCallback, "
+          "dictionary)");
     ZstdStream* wrap;
     ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
 
+    if (ZstdDictionaryWrap::HasInstance(env, args[4])) {
+      ZstdDictionaryWrap* dictionary;
+      ASSIGN_OR_RETURN_UNWRAP(&dictionary, args[4]);
+      wrap->context()->SetDictionary(dictionary->dictionary());
+    } else if (Buffer::HasInstance(args[4])) {
+      const uint8_t* data =
+          reinterpret_cast<const uint8_t*>(Buffer::Data(args[4]));
+      wrap->context()->SetDictionary(
+          std::vector<uint8_t>(data, data + Buffer::Length(args[4])));
+    }
+
     CHECK(args[2]->IsUint32Array());
     uint32_t* write_result = reinterpret_cast<uint32_t*>(Buffer::Data(args[2]));
 
@@ -958,10 +1333,10 @@ void ZlibContext::Close() {
 
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
@@ -986,11 +1361,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -1003,7 +1378,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -1036,7 +1411,7 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
@@ -1044,12 +1419,12 @@ void ZlibContext::DoThreadPoolWork() {
           err_ == Z_NEED_DICT &&
           !dictionary_.empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
+        err_ = inflateSetDictionary(strm_.get(),
                                     dictionary_.data(),
                                     dictionary_.size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -1058,17 +1433,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -1079,10 +1454,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(const char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in));
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in));
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -1093,14 +1468,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -1111,7 +1486,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
@@ -1143,12 +1518,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -1164,9 +1539,9 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
@@ -1194,7 +1569,6 @@ void ZlibContext::Init(
         "invalid strategy");
 
   level_ = level;
-  window_bits_ = window_bits;
   mem_level_ = mem_level;
   strategy_ = strategy;
 
@@ -1202,17 +1576,7 @@ void ZlibContext::Init(
 
   err_ = Z_OK;
 
-  if (mode_ == GZIP || mode_ == GUNZIP) {
-    window_bits_ += 16;
-  }
-
-  if (mode_ == UNZIP) {
-    window_bits_ += 32;
-  }
-
-  if (mode_ == DEFLATERAW || mode_ == INFLATERAW) {
-    window_bits_ *= -1;
-  }
+  window_bits_ = ZlibInitWindowBits(mode_, window_bits);
 
   dictionary_ = std::move(dictionary);
 }
@@ -1223,11 +1587,15 @@ bool ZlibContext::InitZlib() {
     return false;
   }
 
-  switch (mode_) {
+  // A state from the pool has already been initialized and reset.
+  err_ = Z_OK;
+  switch (from_pool_ ? NONE : mode_) {
+    case NONE:
+      break;
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -1238,7 +1606,7 @@ bool ZlibContext::InitZlib() {
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
@@ -1265,14 +1633,14 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
+      err_ = deflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
+      err_ = inflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
@@ -1299,7 +1667,8 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
+      params_changed_ = true;
       break;
     default:
       break;
@@ -1313,6 +1682,67 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
 }
 
 
+size_t ZlibContext::TakeFromPool() {
+  Mutex::ScopedLock lock(mutex_);
+  CHECK(!zlib_init_done_);
+  if (mode_ == NONE) return 0;
+
+  size_t memory = 0;
+  std::unique_ptr<z_stream> strm =
+      ZlibStatePool::ForCurrentThread()->Take(PoolKey(), &memory);
+  if (!strm) return 0;
+
+  strm->zalloc = strm_->zalloc;
+  strm->zfree = strm_->zfree;
+  strm->opaque = strm_->opaque;
+  strm_ = std::move(strm);
+  from_pool_ = true;
+  return memory;
+}
+
+
+bool ZlibContext::Recycle(size_t memory, free_func free) {
+  Mutex::ScopedLock lock(mutex_);
+  // deflateReset() does not undo deflateParams().
+  if (!zlib_init_done_ || params_changed_) return false;
+
+  int err;
+  switch (mode_) {
+    case DEFLATE:
+    case GZIP:
+    case DEFLATERAW:
+      err = deflateReset(strm_.get());
+      break;
+    case INFLATE:
+    case GUNZIP:
+    case INFLATERAW:
+    case UNZIP:
+      // Unlike inflateReset(), this also forgets a window size that was read
+      // from a zlib header.
+      err = inflateReset2(strm_.get(), window_bits_);
+      break;
+    default:
+      return false;
+  }
+  if (err != Z_OK) return false;
+
+  strm_->zalloc = nullptr;
+  strm_->zfree = free;
+  strm_->opaque = nullptr;
+  ZlibStatePool::ForCurrentThread()->Put(
+      PoolKey(), std::move(strm_), memory);
+  strm_ = std::make_unique<z_stream>();
+  zlib_init_done_ = false;
+  return true;
+}
+
+
+ZlibStatePool::Key ZlibContext::PoolKey() const {
+  return ZlibStatePool::KeyFor(
+      mode_, level_, window_bits_, mem_level_, strategy_);
+}
+
+
 void BrotliContext::SetBuffers(const char* in, uint32_t in_len,
                                char* out, uint32_t out_len) {
   next_in_ = reinterpret_cast<const uint8_t*>(in);
@@ -1525,6 +1955,14 @@ CompressionError ZstdCompressContext::Init(uint64_t pledged_src_size) {
     return CompressionError(
         "Could not set pledged src size", "ERR_ZLIB_INITIALIZATION_FAILED", -1);
   }
+  if (digested_dictionary_) {
+    return DictionaryError(
+        ZSTD_CCtx_refCDict(cctx_.get(), digested_dictionary_->cdict()));
+  }
+  if (!dictionary_.empty()) {
+    return DictionaryError(ZSTD_CCtx_loadDictionary(
+        cctx_.get(), dictionary_.data(), dictionary_.size()));
+  }
   return {};
 }
 
@@ -1559,6 +1997,14 @@ CompressionError ZstdDecompressContext::Init(uint64_t pledged_src_size) {
                             "ERR_ZLIB_INITIALIZATION_FAILED",
                             -1);
   }
+  if (digested_dictionary_) {
+    return DictionaryError(
+        ZSTD_DCtx_refDDict(dctx_.get(), digested_dictionary_->ddict()));
+  }
+  if (!dictionary_.empty()) {
+    return DictionaryError(ZSTD_DCtx_loadDictionary(
+        dctx_.get(), dictionary_.data(), dictionary_.size()));
+  }
   return {};
 }
 
@@ -1577,6 +2023,303 @@ void ZstdDecompressContext::DoThreadPoolWork() {
   }
 }
 
+// Compresses a whole buffer the way pigz does. The input is split into blocks
+// that are deflated independently on several threads, each one primed with
+// the window of input that precedes it, and the raw deflate output of the
+// blocks is joined into a single gzip, zlib or raw deflate stream. Every block
+// but the last ends with a sync flush, which leaves it on a byte boundary, and
+// the checksums of the blocks are combined with crc32_combine() or
+// adler32_combine().
+class ParallelDeflate final : public AsyncWrap {
+ public:
+  static void Initialize(Environment* env, Local<Object> target) {
+    Isolate* isolate = env->isolate();
+    Local<FunctionTemplate> t = NewFunctionTemplate(isolate, New);
+    t->InstanceTemplate()->SetInternalFieldCount(
+        ParallelDeflate::kInternalFieldCount);
+    t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+    SetProtoMethod(isolate, t, "compress", Compress);
+    SetConstructorFunction(env->context(), target, "ParallelDeflate", t);
+  }
+
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+    registry->Register(New);
+    registry->Register(Compress);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    size_t size = blocks_.size() * sizeof(Block);
+    for (const Block& block : blocks_) size += block.output.capacity();
+    tracker->TrackFieldWithSize("blocks", size);
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelDeflate)
+  SET_SELF_SIZE(ParallelDeflate)
+
+ private:
+  struct Block {
+    size_t offset;
+    size_t length;
+    std::vector<uint8_t> output;
+    uLong check;
+  };
+
+  class Worker final : public ThreadPoolWork {
+   public:
+    Worker(Environment* env, ParallelDeflate* job)
+        : ThreadPoolWork(env, "zlib", ThreadPoolWorkClass::kCompression),
+          job_(job) {}
+
+    void DoThreadPoolWork() override { job_->CompressBlocks(); }
+
+    void AfterThreadPoolWork(int status) override {
+      std::unique_ptr<Worker> self(this);
+      job_->OnWorkerDone(status);
+    }
+
+   private:
+    BaseObjectPtr<ParallelDeflate> job_;
+  };
+
+  ParallelDeflate(Environment* env, Local<Object> object)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_ZLIB) {
+    MakeWeak();
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    new ParallelDeflate(env, args.This());
+  }
+
+  // compress(input, mode, level, windowBits, memLevel, strategy, blockSize,
+  //          parallelism, sync)
+  // Returns the compressed Buffer, or a zlib error code, when |sync| is true.
+  // Otherwise oncomplete(errno, buffer) is called once all the blocks have
+  // been compressed on the threadpool.
+  static void Compress(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    ParallelDeflate* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.This());
+    CHECK(job->blocks_.empty());
+    CHECK(args[0]->IsArrayBufferView());
+    for (int i = 1; i < 8; i++) CHECK(args[i]->IsInt32());
+
+    job->mode_ = static_cast<node_zlib_mode>(args[1].As<Int32>()->Value());
+    CHECK(job->mode_ == DEFLATE || job->mode_ == GZIP ||
+          job->mode_ == DEFLATERAW);
+    job->level_ = args[2].As<Int32>()->Value();
+    // Like deflateInit2(), which does not support a window of 256 bytes.
+    job->window_bits_ = std::max(args[3].As<Int32>()->Value(), 9);
+    job->mem_level_ = args[4].As<Int32>()->Value();
+    job->strategy_ = args[5].As<Int32>()->Value();
+    const size_t block_size = args[6].As<Int32>()->Value();
+    const size_t parallelism = args[7].As<Int32>()->Value();
+    const bool sync = args[8]->IsTrue();
+    CHECK_GT(block_size, 0);
+    CHECK_GT(parallelism, 0);
+
+    Local<ArrayBufferView> input = args[0].As<ArrayBufferView>();
+    job->length_ = input->ByteLength();
+    job->data_ =
+        static_cast<const uint8_t*>(input->Buffer()->Data()) +
+        input->ByteOffset();
+    for (size_t offset = 0; offset < job->length_ || offset == 0;
+         offset += block_size) {
+      job->blocks_.push_back(Block{
+          offset, std::min(block_size, job->length_ - offset), {}, 0});
+    }
+    job->next_block_ = 0;
+    job->error_ = Z_OK;
+
+    const size_t workers = std::min(parallelism, job->blocks_.size());
+    if (sync) {
+      job->RunOnThreads(workers);
+      Local<Value> result;
+      if (job->Finish().ToLocal(&result)) args.GetReturnValue().Set(result);
+      return;
+    }
+
+    job->input_.Reset(env->isolate(), input);
+    job->pending_workers_ = workers;
+    for (size_t i = 0; i < workers; i++) (new Worker(env, job))->ScheduleWork();
+  }
+
+  // Compresses the blocks that no other thread has claimed yet.
+  void CompressBlocks() {
+    for (;;) {
+      const size_t index = next_block_++;
+      if (index >= blocks_.size()) return;
+      const int err = CompressBlock(index);
+      if (err != Z_OK) {
+        int expected = Z_OK;
+        error_.compare_exchange_strong(expected, err);
+        return;
+      }
+    }
+  }
+
+  int CompressBlock(size_t index) {
+    Block& block = blocks_[index];
+    const bool last = index == blocks_.size() - 1;
+    const Bytef* data = data_ + block.offset;
+    block.check = mode_ == GZIP ? crc32(0, data, block.length)
+                                : adler32(1, data, block.length);
+
+    z_stream stream{};
+    int err = deflateInit2(
+        &stream, level_, Z_DEFLATED, -window_bits_, mem_level_, strategy_);
+    if (err != Z_OK) return err;
+    auto cleanup = OnScopeLeave([&]() { deflateEnd(&stream); });
+
+    if (block.offset > 0) {
+      const size_t window =
+          std::min<size_t>(block.offset, size_t{1} << window_bits_);
+      err = deflateSetDictionary(
+          &stream, data - window, static_cast<uInt>(window));
+      if (err != Z_OK) return err;
+    }
+
+    // The bound covers the stored blocks of incompressible data. The extra
+    // bytes leave room for the empty block written by the sync flush.
+    block.output.resize(deflateBound(&stream, block.length) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(block.length);
+    stream.next_out = block.output.data();
+    stream.avail_out = static_cast<uInt>(block.output.size());
+    err = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    if (err != (last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0)
+      return err == Z_OK || err == Z_STREAM_END ? Z_BUF_ERROR : err;
+    block.output.resize(block.output.size() - stream.avail_out);
+    return Z_OK;
+  }
+
+  void RunOnThreads(size_t threads) {
+    std::vector<uv_thread_t> workers(threads - 1);
+    size_t started = 0;
+    for (; started < workers.size(); started++) {
+      if (uv_thread_create(&workers[started],
+                           [](void* data) {
+                             static_cast<ParallelDeflate*>(data)
+                                 ->CompressBlocks();
+                           },
+                           this) != 0) {
+        break;
+      }
+    }
+    // The calling thread compresses blocks as well.
+    CompressBlocks();
+    for (size_t i = 0; i < started; i++) {
+      CHECK_EQ(uv_thread_join(&workers[i]), 0);
+    }
+  }
+
+  void OnWorkerDone(int status) {
+    if (status == UV_ECANCELED) {
+      int expected = Z_OK;
+      error_.compare_exchange_strong(expected, Z_STREAM_ERROR);
+    }
+    if (--pending_workers_ > 0) return;
+    input_.Reset();
+    if (status == UV_ECANCELED) return;
+
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+    Local<Value> result;
+    if (!Finish().ToLocal(&result)) return;
+    Local<Value> argv[] = {
+        Integer::New(isolate, result->IsInt32() ? result.As<Int32>()->Value()
+                                                : Z_OK),
+        result->IsInt32() ? Undefined(isolate) : result,
+    };
+    MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  // Joins the compressed blocks into a Buffer, or returns the error code of
+  // the block that failed.
+  MaybeLocal<Value> Finish() {
+    Isolate* isolate = env()->isolate();
+    auto release = OnScopeLeave([&]() { blocks_.clear(); });
+    if (error_ != Z_OK) return Integer::New(isolate, error_);
+
+    uint8_t header[10];
+    size_t header_length = 0;
+    size_t trailer_length = 0;
+    uLong check = blocks_[0].check;
+    for (size_t i = 1; i < blocks_.size(); i++) {
+      check = mode_ == GZIP
+                  ? crc32_combine(check, blocks_[i].check, blocks_[i].length)
+                  : adler32_combine(check, blocks_[i].check, blocks_[i].length);
+    }
+    // The same headers as deflate() writes.
+    if (mode_ == GZIP) {
+      const uint8_t xfl = level_ == 9 ? 2 : level_ == 1 ? 4 : 0;
+      const uint8_t gzip_header[] = {
+          GZIP_HEADER_ID1, GZIP_HEADER_ID2, Z_DEFLATED, 0, 0, 0, 0, 0, xfl,
+#ifdef _WIN32
+          10,
+#else
+          3,
+#endif
+      };
+      memcpy(header, gzip_header, sizeof(gzip_header));
+      header_length = sizeof(gzip_header);
+      trailer_length = 8;
+    } else if (mode_ == DEFLATE) {
+      const int level_flags = level_ == Z_DEFAULT_COMPRESSION ? 2
+                              : level_ < 2                    ? 0
+                              : level_ < 6                    ? 1
+                              : level_ == 6                   ? 2
+                                                              : 3;
+      const unsigned int cmf = Z_DEFLATED + ((window_bits_ - 8) << 4);
+      unsigned int flg = level_flags << 6;
+      flg += 31 - ((cmf << 8) + flg) % 31;
+      header[0] = static_cast<uint8_t>(cmf);
+      header[1] = static_cast<uint8_t>(flg);
+      header_length = 2;
+      trailer_length = 4;
+    }
+
+    size_t total = header_length + trailer_length;
+    for (const Block& block : blocks_) total += block.output.size();
+    Local<Object> buffer;
+    if (!Buffer::New(env(), total).ToLocal(&buffer)) return {};
+    uint8_t* out = reinterpret_cast<uint8_t*>(Buffer::Data(buffer));
+
+    memcpy(out, header, header_length);
+    out += header_length;
+    for (const Block& block : blocks_) {
+      memcpy(out, block.output.data(), block.output.size());
+      out += block.output.size();
+    }
+    if (mode_ == GZIP) {
+      const uint32_t values[] = {static_cast<uint32_t>(check),
+                                 static_cast<uint32_t>(length_)};
+      for (uint32_t value : values) {
+        for (int shift = 0; shift < 32; shift += 8) *out++ = value >> shift;
+      }
+    } else if (mode_ == DEFLATE) {
+      for (int shift = 24; shift >= 0; shift -= 8) *out++ = check >> shift;
+    }
+    return buffer;
+  }
+
+  node_zlib_mode mode_ = NONE;
+  int level_ = Z_DEFAULT_COMPRESSION;
+  int window_bits_ = Z_DEFAULT_WINDOWBITS;
+  int mem_level_ = Z_DEFAULT_MEMLEVEL;
+  int strategy_ = Z_DEFAULT_STRATEGY;
+  const uint8_t* data_ = nullptr;
+  size_t length_ = 0;
+  // Keeps the input alive while the threadpool compresses it.
+  v8::Global<Value> input_;
+  std::vector<Block> blocks_;
+  std::atomic<size_t> next_block_{0};
+  std::atomic<int> error_{Z_OK};
+  size_t pending_workers_ = 0;
+};
+
 template <typename Stream>
 struct MakeClass {
   static void Make(Environment* env, Local<Object> target, const char* name) {
@@ -1620,7 +2363,6 @@ T CallOnSequence(v8::Isolate* isolate, Local<Value> value, F callback) {
   }
 }
 
-// TODO(joyeecheung): use fast API
 static void CRC32(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsArrayBufferView() || args[0]->IsString());
   CHECK(args[1]->IsUint32());
@@ -1636,6 +2378,216 @@ static void CRC32(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(result);
 }
 
+static uint32_t FastCRC32(Local<Value> receiver,
+                          Local<Value> data,
+                          uint32_t value,
+                          // NOLINTNEXTLINE(runtime/references)
+                          FastApiCallbackOptions& options) {
+  TRACK_V8_FAST_API_CALL("zlib.crc32");
+  HandleScope scope(options.isolate);
+  CHECK(data->IsArrayBufferView() || data->IsString());
+  return CallOnSequence<uint32_t>(
+      options.isolate, data, [&](const char* chars, size_t size) -> uint32_t {
+        return crc32(value, reinterpret_cast<const Bytef*>(chars), size);
+      });
+}
+
+static CFunction fast_crc32_(CFunction::Make(FastCRC32));
+
+// Runs a whole buffer through a deflate or inflate state at once, for the
+// convenience methods. The states come from, and go back to, the pool of the
+// current thread, so that calls with the same parameters do not allocate.
+class ZlibOneShot {
+ public:
+  ZlibOneShot(node_zlib_mode mode, int level, int window_bits, int mem_level,
+              int strategy)
+      : mode_(mode),
+        key_(ZlibStatePool::KeyFor(mode,
+                                   level,
+                                   ZlibInitWindowBits(mode, window_bits),
+                                   mem_level,
+                                   strategy)) {
+    strm_ = ZlibStatePool::ForCurrentThread()->Take(key_, &memory_);
+    if (!strm_) {
+      strm_ = std::make_unique<z_stream>();
+      strm_->zalloc = ZlibStatePool::Alloc;
+      strm_->zfree = ZlibStatePool::Free;
+      strm_->opaque = &memory_;
+      int err = IsDeflate()
+          ? deflateInit2(strm_.get(), level, Z_DEFLATED, key_.window_bits,
+                         mem_level, strategy)
+          : inflateInit2(strm_.get(), key_.window_bits);
+      if (err != Z_OK) strm_.reset();
+    }
+    if (strm_) {
+      strm_->zalloc = ZlibStatePool::Alloc;
+      strm_->opaque = &memory_;
+    }
+  }
+
+  ~ZlibOneShot() {
+    if (!strm_) return;
+    int err = IsDeflate() ? deflateReset(strm_.get())
+                          : inflateReset2(strm_.get(), key_.window_bits);
+    strm_->zalloc = nullptr;
+    strm_->opaque = nullptr;
+    if (err == Z_OK) {
+      ZlibStatePool::ForCurrentThread()->Put(key_, std::move(strm_), memory_);
+    } else if (IsDeflate()) {
+      deflateEnd(strm_.get());
+    } else {
+      inflateEnd(strm_.get());
+    }
+  }
+
+  ZlibOneShot(const ZlibOneShot&) = delete;
+  ZlibOneShot& operator=(const ZlibOneShot&) = delete;
+
+  bool ok() const { return strm_ != nullptr; }
+
+  uLong Bound(uLong length) { return deflateBound(strm_.get(), length); }
+
+  // Returns the size of the output, or -1 if the input is not a single
+  // complete stream or the output does not fit. The caller then runs the
+  // input through a regular stream, which reports the error.
+  int64_t Run(const unsigned char* in, size_t in_len,
+              unsigned char* out, size_t out_len) {
+    if (in_len > UINT_MAX || out_len > UINT_MAX) return -1;
+    strm_->next_in = const_cast<Bytef*>(in);
+    strm_->avail_in = in_len;
+    strm_->next_out = out;
+    strm_->avail_out = out_len;
+
+    int err;
+    if (IsDeflate()) {
+      err = deflate(strm_.get(), Z_FINISH);
+    } else {
+      err = inflate(strm_.get(), Z_FINISH);
+      // Concatenated gzip members are decompressed as one.
+      while (err == Z_STREAM_END && mode_ == GUNZIP &&
+             strm_->avail_in > 0 && strm_->next_in[0] != 0x00) {
+        err = inflateReset(strm_.get());
+        if (err == Z_OK) err = inflate(strm_.get(), Z_FINISH);
+      }
+    }
+    if (err != Z_STREAM_END || strm_->avail_in != 0) return -1;
+    return out_len - strm_->avail_out;
+  }
+
+ private:
+  bool IsDeflate() const {
+    return mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW;
+  }
+
+  node_zlib_mode mode_;
+  ZlibStatePool::Key key_;
+  std::unique_ptr<z_stream> strm_;
+  size_t memory_ = 0;
+};
+
+static node_zlib_mode OneShotMode(Local<Value> value) {
+  CHECK(value->IsUint32());
+  node_zlib_mode mode =
+      static_cast<node_zlib_mode>(value.As<Uint32>()->Value());
+  CHECK(mode == DEFLATE || mode == GZIP || mode == DEFLATERAW ||
+        mode == INFLATE || mode == GUNZIP || mode == INFLATERAW);
+  return mode;
+}
+
+// zlibOneShot(mode, input, output, level, windowBits, memLevel, strategy)
+static void ZlibOneShotSync(const FunctionCallbackInfo<Value>& args) {
+  node_zlib_mode mode = OneShotMode(args[0]);
+  CHECK(args[1]->IsArrayBufferView());
+  CHECK(args[2]->IsArrayBufferView());
+  CHECK(args[3]->IsInt32());
+  CHECK(args[4]->IsInt32());
+  CHECK(args[5]->IsInt32());
+  CHECK(args[6]->IsInt32());
+
+  ArrayBufferViewContents<unsigned char> input(args[1]);
+  SPREAD_BUFFER_ARG(args[2], output);
+
+  ZlibOneShot one_shot(mode,
+                       args[3].As<Int32>()->Value(),
+                       args[4].As<Int32>()->Value(),
+                       args[5].As<Int32>()->Value(),
+                       args[6].As<Int32>()->Value());
+  int64_t result = -1;
+  if (one_shot.ok()) {
+    result = one_shot.Run(input.data(),
+                          input.length(),
+                          reinterpret_cast<unsigned char*>(output_data),
+                          output_length);
+  }
+  args.GetReturnValue().Set(static_cast<double>(result));
+}
+
+// deflateBound(mode, length, level, windowBits, memLevel, strategy)
+static void DeflateBound(const FunctionCallbackInfo<Value>& args) {
+  node_zlib_mode mode = OneShotMode(args[0]);
+  CHECK(mode == DEFLATE || mode == GZIP || mode == DEFLATERAW);
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsInt32());
+  CHECK(args[3]->IsInt32());
+  CHECK(args[4]->IsInt32());
+  CHECK(args[5]->IsInt32());
+
+  ZlibOneShot one_shot(mode,
+                       args[2].As<Int32>()->Value(),
+                       args[3].As<Int32>()->Value(),
+                       args[4].As<Int32>()->Value(),
+                       args[5].As<Int32>()->Value());
+  if (!one_shot.ok()) {
+    return THROW_ERR_ZLIB_INITIALIZATION_FAILED(Environment::GetCurrent(args),
+                                                "Initialization failed");
+  }
+  uLong length = static_cast<uLong>(args[1].As<v8::Number>()->Value());
+  args.GetReturnValue().Set(static_cast<double>(one_shot.Bound(length)));
+}
+
+// trainZstdDictionary(samples, capacity)
+static void TrainZstdDictionary(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint32());
+  Local<Array> samples = args[0].As<Array>();
+  const size_t capacity = args[1].As<Uint32>()->Value();
+
+  // ZDICT_trainFromBuffer() takes the samples concatenated.
+  std::vector<uint8_t> buffer;
+  std::vector<size_t> sizes(samples->Length());
+  for (uint32_t i = 0; i < samples->Length(); i++) {
+    Local<Value> sample;
+    if (!samples->Get(env->context(), i).ToLocal(&sample)) return;
+    CHECK(sample->IsArrayBufferView());
+    ArrayBufferViewContents<uint8_t> contents(sample);
+    buffer.insert(
+        buffer.end(), contents.data(), contents.data() + contents.length());
+    sizes[i] = contents.length();
+  }
+
+  std::vector<uint8_t> dictionary(capacity);
+  const size_t result = ZDICT_trainFromBuffer(dictionary.data(),
+                                              dictionary.size(),
+                                              buffer.data(),
+                                              sizes.data(),
+                                              static_cast<unsigned>(
+                                                  sizes.size()));
+  if (ZDICT_isError(result)) {
+    return THROW_ERR_INVALID_ARG_VALUE(env,
+                                       "Could not train zstd dictionary: %s",
+                                       ZDICT_getErrorName(result));
+  }
+
+  Local<Object> out;
+  if (Buffer::Copy(env,
+                   reinterpret_cast<const char*>(dictionary.data()),
+                   result)
+          .ToLocal(&out)) {
+    args.GetReturnValue().Set(out);
+  }
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -1648,7 +2600,13 @@ void Initialize(Local<Object> target,
   MakeClass<ZstdCompressStream>::Make(env, target, "ZstdCompress");
   MakeClass<ZstdDecompressStream>::Make(env, target, "ZstdDecompress");
 
-  SetMethod(context, target, "crc32", CRC32);
+  ParallelDeflate::Initialize(env, target);
+  ZstdDictionaryWrap::Initialize(env, target);
+
+  SetFastMethodNoSideEffect(context, target, "crc32", CRC32, &fast_crc32_);
+  SetMethod(context, target, "zlibOneShot", ZlibOneShotSync);
+  SetMethodNoSideEffect(context, target, "deflateBound", DeflateBound);
+  SetMethod(context, target, "trainZstdDictionary", TrainZstdDictionary);
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).Check();
@@ -1660,7 +2618,14 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   MakeClass<BrotliDecoderStream>::Make(registry);
   MakeClass<ZstdCompressStream>::Make(registry);
   MakeClass<ZstdDecompressStream>::Make(registry);
+  ParallelDeflate::RegisterExternalReferences(registry);
+  ZstdDictionaryWrap::RegisterExternalReferences(registry);
   registry->Register(CRC32);
+  registry->Register(FastCRC32);
+  registry->Register(fast_crc32_.GetTypeInfo());
+  registry->Register(ZlibOneShotSync);
+  registry->Register(DeflateBound);
+  registry->Register(TrainZstdDictionary);
 }
 
 }  // anonymous namespace
@@ -21,5 +21,9 @@ bool ChildProcessPermission::is_granted(Environment* env,
   return deny_all_ == false;
 }
 
+PermissionStatus ChildProcessPermission::status(PermissionScope perm) const {
+  return deny_all_ ? PermissionStatus::kDenied : PermissionStatus::kGranted;
+}
+
 }  // namespace permission
 }  // namespace node
@@ -9,6 +9,8 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <string>
 #include <string_view>
@@ -33,26 +35,34 @@ std::string WildcardIfDir(const std::string& res) noexcept {
   return res;
 }
 
-void FreeRecursivelyNode(
-    node::permission::FSPermission::RadixTree::Node* node) {
-  if (node == nullptr) {
-    return;
-  }
+// A small per-thread cache of recent decisions. Only absolute paths are
+// cached, as they resolve to the same path regardless of the working
+// directory, which also lets cache hits skip PathResolve().
+struct CachedDecision {
+  uint64_t generation = 0;
+  std::string path;
+  bool granted = false;
+};
+constexpr size_t kDecisionCacheSize = 16;
+thread_local std::array<CachedDecision, kDecisionCacheSize> decision_cache;
 
-  if (node->children.size()) {
-    for (auto& c : node->children) {
-      FreeRecursivelyNode(c.second);
-    }
-  }
-
-  delete node->wildcard_child;
-  delete node;
-}
+std::atomic<uint64_t> next_tree_generation{1};
 
 bool is_tree_granted(
     node::Environment* env,
     const node::permission::FSPermission::RadixTree* granted_tree,
     const std::string_view& param) {
+  CachedDecision* cached = nullptr;
+#ifndef _WIN32
+  if (!param.empty() && param[0] == '/') {
+    size_t slot = std::hash<std::string_view>{}(param) % kDecisionCacheSize;
+    cached = &decision_cache[slot];
+    if (cached->generation == granted_tree->generation() &&
+        cached->path == param) {
+      return cached->granted;
+    }
+  }
+#endif
   std::string resolved_param = node::PathResolve(env, {param});
 #ifdef _WIN32
   // Remove leading "\\?\" from UNC path
@@ -69,48 +79,13 @@ bool is_tree_granted(
     resolved_param.erase(0, 2);
   }
 #endif
-  return granted_tree->Lookup(resolved_param, true);
-}
-
-void PrintTree(const node::permission::FSPermission::RadixTree::Node* node,
-               size_t spaces = 0) {
-  std::string whitespace(spaces, ' ');
-
-  if (node == nullptr) {
-    return;
-  }
-  if (node->wildcard_child != nullptr) {
-    node::per_process::Debug(node::DebugCategory::PERMISSION_MODEL,
-                             "%s Wildcard: %s\n",
-                             whitespace,
-                             node->prefix);
-  } else {
-    node::per_process::Debug(node::DebugCategory::PERMISSION_MODEL,
-                             "%s Prefix: %s\n",
-                             whitespace,
-                             node->prefix);
-    if (node->children.size()) {
-      size_t child = 0;
-      for (const auto& pair : node->children) {
-        ++child;
-        node::per_process::Debug(node::DebugCategory::PERMISSION_MODEL,
-                                 "%s Child(%s): %s\n",
-                                 whitespace,
-                                 child,
-                                 std::string(1, pair.first));
-        PrintTree(pair.second, spaces + 2);
-      }
-      node::per_process::Debug(node::DebugCategory::PERMISSION_MODEL,
-                               "%s End of tree - child(%s)\n",
-                               whitespace,
-                               child);
-    } else {
-      node::per_process::Debug(node::DebugCategory::PERMISSION_MODEL,
-                               "%s End of tree: %s\n",
-                               whitespace,
-                               node->prefix);
-    }
+  bool granted = granted_tree->Lookup(resolved_param, true);
+  if (cached != nullptr) {
+    cached->generation = granted_tree->generation();
+    cached->path.assign(param);
+    cached->granted = granted;
   }
+  return granted;
 }
 
 }  // namespace
@@ -171,66 +146,130 @@ bool FSPermission::is_granted(Environment* env,
   }
 }
 
-FSPermission::RadixTree::RadixTree() : root_node_(new Node("")) {}
+PermissionStatus FSPermission::status(PermissionScope perm) const {
+  switch (perm) {
+    case PermissionScope::kFileSystem:
+      return allow_all_in_ && allow_all_out_ ? PermissionStatus::kGranted
+                                             : PermissionStatus::kDenied;
+    case PermissionScope::kFileSystemRead:
+      if (deny_all_in_) return PermissionStatus::kDenied;
+      if (allow_all_in_) return PermissionStatus::kGranted;
+      return PermissionStatus::kNeedsCheck;
+    case PermissionScope::kFileSystemWrite:
+      if (deny_all_out_) return PermissionStatus::kDenied;
+      if (allow_all_out_) return PermissionStatus::kGranted;
+      return PermissionStatus::kNeedsCheck;
+    default:
+      return PermissionStatus::kDenied;
+  }
+}
+
+FSPermission::RadixTree::RadixTree()
+    : nodes_(1), generation_(next_tree_generation++) {}
 
-FSPermission::RadixTree::~RadixTree() {
-  FreeRecursivelyNode(root_node_);
+uint32_t FSPermission::RadixTree::FindOrAddChild(uint32_t parent,
+                                                 std::string_view label,
+                                                 bool is_wildcard) {
+  uint32_t* link = &nodes_[parent].first_child;
+  while (*link != kNoNode) {
+    const Node& child = nodes_[*link];
+    if (child.is_wildcard == is_wildcard && child.label == label) {
+      return *link;
+    }
+    link = &nodes_[*link].next_sibling;
+  }
+  // Link the new node before nodes_ grows, which invalidates `link`.
+  uint32_t index = static_cast<uint32_t>(nodes_.size());
+  *link = index;
+  nodes_.push_back({std::string(label), kNoNode, kNoNode, false, is_wildcard});
+  return index;
 }
 
 bool FSPermission::RadixTree::Lookup(const std::string_view& s,
                                      bool when_empty_return) const {
-  FSPermission::RadixTree::Node* current_node = root_node_;
-  if (current_node->children.empty()) {
+  if (nodes_[0].first_child == kNoNode) {
     return when_empty_return;
   }
-  size_t parent_node_prefix_len = current_node->prefix.length();
-  const std::string path(s);
-  auto path_len = path.length();
 
+  uint32_t current = 0;
+  size_t pos = 0;
   while (true) {
-    if (parent_node_prefix_len == path_len && current_node->IsEndNode()) {
-      return true;
+    size_t end = s.find(kPathSeparator, pos);
+    std::string_view segment = s.substr(pos, end - pos);
+    uint32_t next = kNoNode;
+    for (uint32_t i = nodes_[current].first_child; i != kNoNode;
+         i = nodes_[i].next_sibling) {
+      const Node& child = nodes_[i];
+      if (child.is_wildcard) {
+        // Everything after a wildcard is ignored, so this grants access to
+        // anything below this segment as well.
+        if (segment.starts_with(child.label)) return true;
+      } else if (child.label == segment) {
+        next = i;
+      }
     }
-
-    auto node = current_node->NextNode(path, parent_node_prefix_len);
-    if (node == nullptr) {
+    if (next == kNoNode) {
       return false;
     }
+    current = next;
+    if (end == std::string_view::npos) break;
+    pos = end + 1;
+  }
 
-    current_node = node;
-    parent_node_prefix_len += current_node->prefix.length();
-    if (current_node->wildcard_child != nullptr &&
-        path_len >= (parent_node_prefix_len - 2 /* slash* */)) {
-      return true;
-    }
+  if (nodes_[current].is_leaf) {
+    return true;
   }
+  // Handle optional trailing
+  // path = /home/subdirectory
+  // granted = /home/subdirectory/*
+  for (uint32_t i = nodes_[current].first_child; i != kNoNode;
+       i = nodes_[i].next_sibling) {
+    if (nodes_[i].is_wildcard && nodes_[i].label.empty()) return true;
+  }
+  return false;
 }
 
 void FSPermission::RadixTree::Insert(const std::string& path) {
-  FSPermission::RadixTree::Node* current_node = root_node_;
-
-  size_t parent_node_prefix_len = current_node->prefix.length();
-  size_t path_len = path.length();
+  size_t wildcard = path.find('*');
+  std::string_view granted = std::string_view(path).substr(0, wildcard);
 
-  for (size_t i = 1; i <= path_len; ++i) {
-    bool is_wildcard_node = path[i - 1] == '*';
-    bool is_last_char = i == path_len;
-
-    if (is_wildcard_node || is_last_char) {
-      std::string node_path = path.substr(parent_node_prefix_len, i);
-      current_node = current_node->CreateChild(node_path);
-    }
-
-    if (is_wildcard_node) {
-      current_node = current_node->CreateWildcardChild();
-      parent_node_prefix_len = i;
+  uint32_t current = 0;
+  size_t pos = 0;
+  while (true) {
+    size_t end = granted.find(kPathSeparator, pos);
+    std::string_view segment = granted.substr(pos, end - pos);
+    if (end == std::string_view::npos) {
+      if (wildcard != std::string::npos) {
+        FindOrAddChild(current, segment, true);
+      } else {
+        nodes_[FindOrAddChild(current, segment, false)].is_leaf = true;
+      }
+      break;
     }
+    current = FindOrAddChild(current, segment, false);
+    pos = end + 1;
   }
+  generation_ = next_tree_generation++;
 
   if (per_process::enabled_debug_list.enabled(DebugCategory::PERMISSION_MODEL))
       [[unlikely]] {
     per_process::Debug(DebugCategory::PERMISSION_MODEL, "Inserting %s\n", path);
-    PrintTree(root_node_);
+    Print(0, 0);
+  }
+}
+
+void FSPermission::RadixTree::Print(uint32_t index, size_t spaces) const {
+  std::string whitespace(spaces, ' ');
+  const Node& node = nodes_[index];
+  per_process::Debug(DebugCategory::PERMISSION_MODEL,
+                     "%s %s: %s%s\n",
+                     whitespace,
+                     node.is_wildcard ? "Wildcard" : "Segment",
+                     node.label,
+                     node.is_leaf ? " (granted)" : "");
+  for (uint32_t i = node.first_child; i != kNoNode;
+       i = nodes_[i].next_sibling) {
+    Print(i, spaces + 2);
   }
 }
 
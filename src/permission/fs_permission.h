@@ -5,7 +5,10 @@
 
 #include "v8.h"
 
-#include <unordered_map>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 #include "permission/permission_base.h"
 #include "util.h"
 
@@ -21,129 +24,42 @@ class FSPermission final : public PermissionBase {
   bool is_granted(Environment* env,
                   PermissionScope perm,
                   const std::string_view& param) const override;
-
-  struct RadixTree {
-    struct Node {
-      std::string prefix;
-      std::unordered_map<char, Node*> children;
-      Node* wildcard_child;
-      bool is_leaf;
-
-      explicit Node(const std::string& pre)
-          : prefix(pre), wildcard_child(nullptr), is_leaf(false) {}
-
-      Node() : wildcard_child(nullptr), is_leaf(false) {}
-
-      Node* CreateChild(const std::string& path_prefix) {
-        if (path_prefix.empty() && !is_leaf) {
-          is_leaf = true;
-          return this;
-        }
-
-        CHECK(!path_prefix.empty());
-        char label = path_prefix[0];
-
-        Node* child = children[label];
-        if (child == nullptr) {
-          children[label] = new Node(path_prefix);
-          return children[label];
-        }
-
-        // swap prefix
-        size_t i = 0;
-        size_t prefix_len = path_prefix.length();
-        for (; i < child->prefix.length(); ++i) {
-          if (i > prefix_len || path_prefix[i] != child->prefix[i]) {
-            std::string parent_prefix = child->prefix.substr(0, i);
-            std::string child_prefix = child->prefix.substr(i);
-
-            child->prefix = child_prefix;
-            Node* split_child = new Node(parent_prefix);
-            split_child->children[child_prefix[0]] = child;
-            children[parent_prefix[0]] = split_child;
-
-            return split_child->CreateChild(path_prefix.substr(i));
-          }
-        }
-        child->is_leaf = true;
-        return child->CreateChild(path_prefix.substr(i));
-      }
-
-      Node* CreateWildcardChild() {
-        if (wildcard_child != nullptr) {
-          return wildcard_child;
-        }
-        wildcard_child = new Node();
-        return wildcard_child;
-      }
-
-      Node* NextNode(const std::string& path, size_t idx) const {
-        if (idx >= path.length()) {
-          return nullptr;
-        }
-
-        // wildcard node takes precedence
-        if (children.size() > 1) {
-          auto it = children.find('*');
-          if (it != children.end()) {
-            return it->second;
-          }
-        }
-
-        auto it = children.find(path[idx]);
-        if (it == children.end()) {
-          return nullptr;
-        }
-        auto child = it->second;
-        // match prefix
-        size_t prefix_len = child->prefix.length();
-        for (size_t i = 0; i < path.length(); ++i) {
-          if (i >= prefix_len || child->prefix[i] == '*') {
-            return child;
-          }
-
-          // Handle optional trailing
-          // path = /home/subdirectory
-          // child = subdirectory/*
-          if (idx >= path.length() &&
-              child->prefix[i] == node::kPathSeparator) {
-            continue;
-          }
-
-          if (path[idx++] != child->prefix[i]) {
-            return nullptr;
-          }
-        }
-        return child;
-      }
-
-      // A node can be a *end* node and have children
-      // E.g: */slower*, */slown* are inserted:
-      // /slow
-      // ---> er
-      // ---> n
-      // If */slow* is inserted right after, it will create an
-      // empty node
-      // /slow
-      // ---> '\000' ASCII (0) || \0
-      // ---> er
-      // ---> n
-      bool IsEndNode() const {
-        if (children.empty()) {
-          return true;
-        }
-        return is_leaf;
-      }
-    };
-
+  PermissionStatus status(PermissionScope perm) const override;
+
+  // Granted paths are stored in a trie of path segments. A wildcard is
+  // stored as a child of the node that precedes it, labelled with the part
+  // of its segment before the '*': "/home/test*" adds a wildcard child
+  // "test" to the node of "/home". All nodes live in a single vector and
+  // link to their first child and next sibling by index.
+  class RadixTree {
+   public:
     RadixTree();
-    ~RadixTree();
     void Insert(const std::string& s);
     bool Lookup(const std::string_view& s) const { return Lookup(s, false); }
     bool Lookup(const std::string_view& s, bool when_empty_return) const;
 
+    // Changes whenever a path is inserted, and is unique across trees, so it
+    // can be used to key cached lookup results.
+    uint64_t generation() const { return generation_; }
+
    private:
-    Node* root_node_;
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    struct Node {
+      std::string label;
+      uint32_t first_child = kNoNode;
+      uint32_t next_sibling = kNoNode;
+      bool is_leaf = false;
+      bool is_wildcard = false;
+    };
+
+    uint32_t FindOrAddChild(uint32_t parent,
+                            std::string_view label,
+                            bool is_wildcard);
+    void Print(uint32_t index, size_t spaces) const;
+
+    std::vector<Node> nodes_;
+    uint64_t generation_;
   };
 
  private:
@@ -20,5 +20,9 @@ bool InspectorPermission::is_granted(Environment* env,
   return deny_all_ == false;
 }
 
+PermissionStatus InspectorPermission::status(PermissionScope perm) const {
+  return deny_all_ ? PermissionStatus::kDenied : PermissionStatus::kGranted;
+}
+
 }  // namespace permission
 }  // namespace node
@@ -18,6 +18,7 @@ class InspectorPermission final : public PermissionBase {
   bool is_granted(Environment* env,
                   PermissionScope perm,
                   const std::string_view& param = "") const override;
+  PermissionStatus status(PermissionScope perm) const override;
 
  private:
   bool deny_all_;
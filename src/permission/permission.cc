@@ -104,6 +104,7 @@ Permission::Permission() : enabled_(false) {
   nodes_.insert(std::make_pair(PermissionScope::k##Name, wasi));
   WASI_PERMISSIONS(V)
 #undef V
+  statuses_.fill(PermissionStatus::kNeedsCheck);
 }
 
 const char* GetErrorFlagSuggestion(node::permission::PermissionScope perm) {
@@ -167,15 +168,25 @@ void Permission::AsyncThrowAccessDenied(Environment* env,
 void Permission::EnablePermissions() {
   if (!enabled_) {
     enabled_ = true;
+    UpdateStatuses();
   }
 }
 
+void Permission::UpdateStatuses() {
+#define V(Name, _, __, ___)                                                    \
+  statuses_[static_cast<size_t>(PermissionScope::k##Name)] =                   \
+      nodes_.at(PermissionScope::k##Name)->status(PermissionScope::k##Name);
+  PERMISSIONS(V)
+#undef V
+}
+
 void Permission::Apply(Environment* env,
                        const std::vector<std::string>& allow,
                        PermissionScope scope) {
   auto permission = nodes_.find(scope);
   if (permission != nodes_.end()) {
     permission->second->Apply(env, allow, scope);
+    if (enabled_) UpdateStatuses();
   }
 }
 
@@ -13,6 +13,7 @@
 #include "permission/worker_permission.h"
 #include "v8.h"
 
+#include <array>
 #include <string_view>
 #include <unordered_map>
 
@@ -55,6 +56,16 @@ class Permission {
     if (!enabled_) [[likely]] {
       return true;
     }
+    // Most scopes are either granted or denied as a whole, which does not
+    // need a lookup.
+    switch (scope_status(permission)) {
+      case PermissionStatus::kGranted:
+        return true;
+      case PermissionStatus::kDenied:
+        return false;
+      case PermissionStatus::kNeedsCheck:
+        break;
+    }
     return is_scope_granted(env, permission, res);
   }
 
@@ -77,6 +88,17 @@ class Permission {
   void EnablePermissions();
 
  private:
+  FORCE_INLINE PermissionStatus scope_status(PermissionScope permission) const {
+    int index = static_cast<int>(permission);
+    if (index < 0 || index >= static_cast<int>(statuses_.size())) {
+      return PermissionStatus::kDenied;
+    }
+    return statuses_[index];
+  }
+
+  // Recomputes statuses_ after the permissions have changed.
+  void UpdateStatuses();
+
   COLD_NOINLINE bool is_scope_granted(Environment* env,
                                       const PermissionScope permission,
                                       const std::string_view& res = "") const {
@@ -88,6 +110,9 @@ class Permission {
   }
 
   std::unordered_map<PermissionScope, std::shared_ptr<PermissionBase>> nodes_;
+  std::array<PermissionStatus,
+             static_cast<size_t>(PermissionScope::kPermissionsCount)>
+      statuses_;
   bool enabled_;
 };
 
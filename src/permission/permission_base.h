@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <string_view>
@@ -43,6 +44,14 @@ enum class PermissionScope {
 };
 #undef V
 
+// Whether a scope is granted or denied regardless of the resource, or
+// whether the resource has to be checked.
+enum class PermissionStatus : uint8_t {
+  kNeedsCheck,
+  kGranted,
+  kDenied,
+};
+
 class PermissionBase {
  public:
   virtual void Apply(Environment* env,
@@ -51,6 +60,9 @@ class PermissionBase {
   virtual bool is_granted(Environment* env,
                           PermissionScope perm,
                           const std::string_view& param = "") const = 0;
+  virtual PermissionStatus status(PermissionScope perm) const {
+    return PermissionStatus::kNeedsCheck;
+  }
 };
 
 }  // namespace permission
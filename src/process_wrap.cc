@@ -23,6 +23,7 @@
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "permission/permission.h"
+#include "spawn_zygote.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "util-inl.h"
@@ -83,6 +84,11 @@ class ProcessWrap : public HandleWrap {
   SET_MEMORY_INFO_NAME(ProcessWrap)
   SET_SELF_SIZE(ProcessWrap)
 
+ protected:
+  void OnClose() override {
+    if (zygote_pid_ != 0) spawn_zygote::Forget(zygote_pid_);
+  }
+
  private:
   static void New(const FunctionCallbackInfo<Value>& args) {
     // This constructor should not be exposed to public javascript.
@@ -344,17 +350,31 @@ class ProcessWrap : public HandleWrap {
       options.flags |= UV_PROCESS_DETACHED;
     }
 
+    int pid = 0;
     if (err == 0) {
-      err = uv_spawn(env->event_loop(), &wrap->process_, &options);
+      if (spawn_zygote::Spawn(
+              env, &options, OnZygoteExit, wrap, &pid, &err)) {
+        CHECK_EQ(uv_async_init(env->event_loop(),
+                               &wrap->zygote_async_,
+                               [](uv_async_t* handle) {}),
+                 0);
+        wrap->spawned_by_zygote_ = true;
+        wrap->zygote_pid_ = pid;
+      } else {
+        err = uv_spawn(env->event_loop(), &wrap->process_, &options);
+        if (err == 0) {
+          CHECK_EQ(wrap->process_.data, wrap);
+          pid = wrap->process_.pid;
+        }
+      }
       wrap->MarkAsInitialized();
     }
 
     if (err == 0) {
-      CHECK_EQ(wrap->process_.data, wrap);
       if (wrap->object()
               ->Set(context,
                     env->pid_string(),
-                    Integer::New(env->isolate(), wrap->process_.pid))
+                    Integer::New(env->isolate(), pid))
               .IsNothing()) {
         return;
       }
@@ -389,7 +409,13 @@ class ProcessWrap : public HandleWrap {
       signal = SIGKILL;
     }
 #endif
-    int err = uv_process_kill(&wrap->process_, signal);
+    int err;
+    if (wrap->spawned_by_zygote_) {
+      err = wrap->zygote_pid_ != 0 ? uv_kill(wrap->zygote_pid_, signal)
+                                   : UV_ESRCH;
+    } else {
+      err = uv_process_kill(&wrap->process_, signal);
+    }
     args.GetReturnValue().Set(err);
   }
 
@@ -398,8 +424,17 @@ class ProcessWrap : public HandleWrap {
                      int term_signal) {
     ProcessWrap* wrap = ContainerOf(&ProcessWrap::process_, handle);
     CHECK_EQ(&wrap->process_, handle);
+    wrap->EmitExit(exit_status, term_signal);
+  }
+
+  static void OnZygoteExit(void* data, int64_t exit_status, int term_signal) {
+    ProcessWrap* wrap = static_cast<ProcessWrap*>(data);
+    wrap->zygote_pid_ = 0;
+    wrap->EmitExit(exit_status, term_signal);
+  }
 
-    Environment* env = wrap->env();
+  void EmitExit(int64_t exit_status, int term_signal) {
+    Environment* env = this->env();
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
 
@@ -408,10 +443,20 @@ class ProcessWrap : public HandleWrap {
       OneByteString(env->isolate(), signo_string(term_signal))
     };
 
-    wrap->MakeCallback(env->onexit_string(), arraysize(argv), argv);
+    MakeCallback(env->onexit_string(), arraysize(argv), argv);
   }
 
-  uv_process_t process_;
+  // Children spawned through the zygote are not children of this process and
+  // cannot be tracked by libuv. An async handle, which is never sent, stands
+  // in for the process handle and keeps the loop alive until the handle is
+  // closed, and the zygote reports the exit of the child instead.
+  union {
+    uv_process_t process_;
+    uv_async_t zygote_async_;
+  };
+  bool spawned_by_zygote_ = false;
+  // The pid of a child spawned through the zygote, until it exits.
+  int zygote_pid_ = 0;
 };
 
 
@@ -0,0 +1,85 @@
+#ifndef SRC_PROTOBUF_WRITER_H_
+#define SRC_PROTOBUF_WRITER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace node {
+
+// Appends the fields of a protobuf message to a string, for the few binary
+// formats that are written without depending on protobuf itself (Perfetto
+// traces, pprof profiles). Nested messages are built separately and appended
+// with AppendMessage().
+class ProtobufWriter {
+ public:
+  enum WireType : uint32_t {
+    kVarint = 0,
+    kFixed64 = 1,
+    kLengthDelimited = 2,
+  };
+
+  void AppendVarint(uint32_t field, uint64_t value) {
+    AppendTag(field, kVarint);
+    AppendRawVarint(value);
+  }
+
+  void AppendDouble(uint32_t field, double value) {
+    AppendTag(field, kFixed64);
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value));
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+      data_.push_back(static_cast<char>(bits & 0xff));
+      bits >>= 8;
+    }
+  }
+
+  void AppendString(uint32_t field, std::string_view value) {
+    AppendTag(field, kLengthDelimited);
+    AppendRawVarint(value.size());
+    data_.append(value);
+  }
+
+  void AppendMessage(uint32_t field, const ProtobufWriter& message) {
+    AppendString(field, message.data_);
+  }
+
+  // Appends a packed repeated field of varints.
+  void AppendPackedVarints(uint32_t field,
+                           const std::vector<uint64_t>& values) {
+    if (values.empty()) return;
+    ProtobufWriter packed;
+    for (uint64_t value : values) packed.AppendRawVarint(value);
+    AppendMessage(field, packed);
+  }
+
+  const std::string& data() const { return data_; }
+  std::string&& release() { return std::move(data_); }
+
+ private:
+  void AppendTag(uint32_t field, uint32_t wire_type) {
+    AppendRawVarint((static_cast<uint64_t>(field) << 3) | wire_type);
+  }
+
+  void AppendRawVarint(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+
+  std::string data_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_PROTOBUF_WRITER_H_
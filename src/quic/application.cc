@@ -232,14 +232,20 @@ void Session::Application::SendPendingData() {
     return;
   }
   static constexpr size_t kMaxPackets = 32;
+  // The burst size used when the pacing option is enabled.
+  static constexpr size_t kMaxPacedPackets = 4;
   Debug(session_, "Application sending pending data");
   PathStorage path;
   StreamData stream_data;
+  // Set when sending stopped because the burst allowed by the send quantum
+  // was used up, rather than because there was nothing left to send.
+  bool send_quantum_exhausted = false;
 
   auto update_stats = OnScopeLeave([&] {
     auto& s = session();
     if (!s.is_destroyed()) [[likely]] {
       s.UpdatePacketTxTime();
+      if (send_quantum_exhausted) s.RecordPacingDelay();
       s.UpdateTimer();
       s.UpdateDataStats();
     }
@@ -249,9 +255,15 @@ void Session::Application::SendPendingData() {
   const size_t max_packet_size = session_->max_packet_size();
 
   // The maximum number of packets to send in this call to SendPendingData.
-  const size_t max_packet_count = std::min(
+  size_t max_packet_count = std::min(
       kMaxPackets, ngtcp2_conn_get_send_quantum(*session_) / max_packet_size);
-  if (max_packet_count == 0) return;
+  if (session_->config().options.pacing) {
+    max_packet_count = std::min(max_packet_count, kMaxPacedPackets);
+  }
+  if (max_packet_count == 0) {
+    send_quantum_exhausted = true;
+    return;
+  }
 
   // The number of packets that have been sent in this call to SendPendingData.
   size_t packet_send_count = 0;
@@ -409,6 +421,7 @@ void Session::Application::SendPendingData() {
 
     // If we have sent the maximum number of packets, we're done.
     if (++packet_send_count == max_packet_count) {
+      send_quantum_exhausted = true;
       return;
     }
 
@@ -104,7 +104,9 @@ class Packet;
   V(max_stateless_resets, "maxStatelessResetsPerHost")                         \
   V(max_stream_window, "maxStreamWindow")                                      \
   V(max_window, "maxWindow")                                                   \
+  V(metrics, "metrics")                                                        \
   V(min_version, "minVersion")                                                 \
+  V(pacing, "pacing")                                                          \
   V(packetwrap, "PacketWrap")                                                  \
   V(preferred_address_strategy, "preferredAddressPolicy")                      \
   V(protocol, "protocol")                                                      \
@@ -112,15 +114,18 @@ class Packet;
   V(qpack_blocked_streams, "qpackBlockedStreams")                              \
   V(qpack_encoder_max_dtable_capacity, "qpackEncoderMaxDTableCapacity")        \
   V(qpack_max_dtable_capacity, "qpackMaxDTableCapacity")                       \
+  V(record_metrics, "recordMetrics")                                           \
   V(reject_unauthorized, "rejectUnauthorized")                                 \
   V(reno, "reno")                                                              \
   V(retry_token_expiration, "retryTokenExpiration")                            \
   V(reset_token_secret, "resetTokenSecret")                                    \
+  V(reuse_port, "reusePort")                                                   \
   V(rx_loss, "rxDiagnosticLoss")                                               \
   V(servername, "servername")                                                  \
   V(session, "Session")                                                        \
   V(stream, "Stream")                                                          \
   V(success, "success")                                                        \
+  V(ticket_keys, "ticketKeys")                                                 \
   V(tls_options, "tls")                                                        \
   V(token_expiration, "tokenExpiration")                                       \
   V(token_secret, "tokenSecret")                                               \
@@ -24,8 +24,10 @@
 
 namespace node {
 
+using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
+using v8::BackingStoreInitializationMode;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -71,7 +73,8 @@ namespace quic {
   V(RETRY_COUNT, retry_count)                                                  \
   V(VERSION_NEGOTIATION_COUNT, version_negotiation_count)                      \
   V(STATELESS_RESET_COUNT, stateless_reset_count)                              \
-  V(IMMEDIATE_CLOSE_COUNT, immediate_close_count)
+  V(IMMEDIATE_CLOSE_COUNT, immediate_close_count)                              \
+  V(FORWARDED_PACKET_COUNT, forwarded_packet_count)
 
 struct Endpoint::State {
 #define V(_, name, type) type name;
@@ -194,7 +197,7 @@ Maybe<Endpoint::Options> Endpoint::Options::From(Environment* env,
       !SET(max_connections_per_host) || !SET(max_connections_total) ||
       !SET(max_stateless_resets) || !SET(address_lru_size) ||
       !SET(max_retries) || !SET(validate_address) ||
-      !SET(disable_stateless_reset) || !SET(ipv6_only) ||
+      !SET(disable_stateless_reset) || !SET(ipv6_only) || !SET(reuse_port) ||
 #ifdef DEBUG
       !SET(rx_loss) || !SET(tx_loss) ||
 #endif
@@ -265,6 +268,7 @@ std::string Endpoint::Options::ToString() const {
   res += prefix + "reset token secret: " + reset_token_secret.ToString();
   res += prefix + "token secret: " + token_secret.ToString();
   res += prefix + "ipv6 only: " + boolToString(ipv6_only);
+  res += prefix + "reuse port: " + boolToString(reuse_port);
   res += prefix +
          "udp receive buffer size: " + std::to_string(udp_receive_buffer_size);
   res +=
@@ -318,7 +322,12 @@ class Endpoint::UDP::Impl final : public HandleWrap {
                    reinterpret_cast<uv_handle_t*>(&handle_),
                    PROVIDER_QUIC_UDP),
         endpoint_(endpoint) {
-    CHECK_EQ(uv_udp_init(endpoint->env()->event_loop(), &handle_), 0);
+    // Datagrams are received in batches with recvmmsg() where it is
+    // available.
+    CHECK_EQ(uv_udp_init_ex(endpoint->env()->event_loop(),
+                            &handle_,
+                            AF_UNSPEC | UV_UDP_RECVMMSG),
+             0);
     handle_.data = this;
   }
 
@@ -327,10 +336,22 @@ class Endpoint::UDP::Impl final : public HandleWrap {
   SET_SELF_SIZE(Impl)
 
  private:
+  // Room for this many datagrams of the maximum size per recvmmsg() call.
+  static constexpr size_t kRecvBatchBufferSize = 16 * 64 * 1024;
+
   static void OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
-    *buf = From(handle)->env()->allocate_managed_buffer(suggested_size);
+    Impl* impl = From(handle);
+    if (uv_udp_using_recvmmsg(&impl->handle_)) {
+      // The batch buffer is reused for every read, and each datagram is
+      // copied out of it into a buffer of its own size.
+      if (!impl->recv_batch_buffer_)
+        impl->recv_batch_buffer_.reset(new char[kRecvBatchBufferSize]);
+      *buf = uv_buf_init(impl->recv_batch_buffer_.get(), kRecvBatchBufferSize);
+      return;
+    }
+    *buf = impl->env()->allocate_managed_buffer(suggested_size);
   }
 
   static void OnReceive(uv_udp_t* handle,
@@ -338,27 +359,49 @@ class Endpoint::UDP::Impl final : public HandleWrap {
                         const uv_buf_t* buf,
                         const sockaddr* addr,
                         unsigned int flags) {
+    auto impl = From(handle);
+    DCHECK_NOT_NULL(impl);
+    DCHECK_NOT_NULL(impl->endpoint_);
+    const bool batched = uv_udp_using_recvmmsg(&impl->handle_);
+
+    // Buffers that are not from the batch buffer are managed buffers, and
+    // are owned by the received packet from here on.
+    std::shared_ptr<BackingStore> backing;
+    if (!batched) backing = impl->env()->release_managed_buffer(*buf);
+
     // Nothing to do in these cases. Specifically, if the nread
     // is zero or we've received a partial packet, we're just
     // going to ignore it.
     if (nread == 0 || flags & UV_UDP_PARTIAL) return;
 
-    auto impl = From(handle);
-    DCHECK_NOT_NULL(impl);
-    DCHECK_NOT_NULL(impl->endpoint_);
-
     if (nread < 0) {
       impl->endpoint_->Destroy(CloseContext::RECEIVE_FAILURE,
                                static_cast<int>(nread));
       return;
     }
 
-    impl->endpoint_->Receive(uv_buf_init(buf->base, static_cast<size_t>(nread)),
-                             SocketAddress(addr));
+    if (batched) {
+      backing = ArrayBuffer::NewBackingStore(
+          impl->env()->isolate(),
+          nread,
+          BackingStoreInitializationMode::kUninitialized);
+      memcpy(backing->Data(), buf->base, nread);
+    } else if (!backing) [[unlikely]] {
+      // At this point something bad happened and we need to treat this as a
+      // fatal case. There's likely no way to test this specific condition
+      // reliably.
+      impl->endpoint_->Destroy(CloseContext::RECEIVE_FAILURE, UV_ENOMEM);
+      return;
+    }
+
+    impl->endpoint_->Receive(
+        Store(std::move(backing), static_cast<size_t>(nread)),
+        SocketAddress(addr));
   }
 
   uv_udp_t handle_;
   Endpoint* endpoint_;
+  std::unique_ptr<char[]> recv_batch_buffer_;
 
   friend class UDP;
 };
@@ -382,6 +425,7 @@ int Endpoint::UDP::Bind(const Options& options) {
   int flags = 0;
   if (options.local_address->family() == AF_INET6 && options.ipv6_only)
     flags |= UV_UDP_IPV6ONLY;
+  if (options.reuse_port) flags |= UV_UDP_REUSEPORT;
   int err = uv_udp_bind(&impl_->handle_, options.local_address->data(), flags);
   int size;
 
@@ -481,6 +525,19 @@ int Endpoint::UDP::Send(const BaseObjectPtr<Packet>& packet) {
   // which we don't want.
   packet->ClearWeak();
   packet->Dispatched();
+
+  // Most packets can be sent right away, without going through a send
+  // request and its callback. Anything else, including errors, is left to
+  // uv_udp_send(), which queues the packet or reports the error through the
+  // callback as before.
+  if (uv_udp_try_send(&impl_->handle_,
+                      &buf,
+                      1,
+                      packet->destination().data()) >= 0) {
+    packet->Done(0);
+    return 0;
+  }
+
   int err = uv_udp_send(packet->req(),
                         &impl_->handle_,
                         &buf,
@@ -526,6 +583,7 @@ Local<FunctionTemplate> Endpoint::GetConstructorTemplate(Environment* env) {
     SetProtoMethod(isolate, tmpl, "connect", DoConnect);
     SetProtoMethod(isolate, tmpl, "markBusy", MarkBusy);
     SetProtoMethod(isolate, tmpl, "ref", Ref);
+    SetProtoMethod(isolate, tmpl, "rotateTokenSecret", DoRotateTokenSecret);
     SetProtoMethodNoSideEffect(isolate, tmpl, "address", LocalAddress);
     state.set_endpoint_constructor_template(tmpl);
   }
@@ -606,6 +664,7 @@ void Endpoint::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(LocalAddress);
   registry->Register(Ref);
   registry->Register(MarkBusy);
+  registry->Register(DoRotateTokenSecret);
 }
 
 Endpoint::Endpoint(Environment* env,
@@ -615,6 +674,7 @@ Endpoint::Endpoint(Environment* env,
       stats_(env->isolate()),
       state_(env->isolate()),
       options_(options),
+      token_secret_(options.token_secret),
       udp_(this),
       addrLRU_(options_.address_lru_size) {
   MakeWeak();
@@ -653,7 +713,7 @@ RegularToken Endpoint::GenerateNewToken(uint32_t version,
         version,
         remote_address);
   DCHECK(!is_closed() && !is_closing());
-  return RegularToken(version, remote_address, options_.token_secret);
+  return RegularToken(version, remote_address, token_secret_);
 }
 
 StatelessResetToken Endpoint::GenerateNewStatelessResetToken(
@@ -665,12 +725,19 @@ StatelessResetToken Endpoint::GenerateNewStatelessResetToken(
   return StatelessResetToken(token, options_.reset_token_secret, cid);
 }
 
+void Endpoint::RotateTokenSecret(const TokenSecret& secret) {
+  Debug(this, "Rotating the token secret");
+  previous_token_secret_ = token_secret_;
+  token_secret_ = secret;
+}
+
 void Endpoint::AddSession(const CID& cid, BaseObjectPtr<Session> session) {
   DCHECK(!is_closed() && !is_closing());
   Debug(this, "Adding session for CID %s", cid);
   IncrementSocketAddressCounter(session->remote_address());
   AssociateCID(session->config().dcid, session->config().scid);
   sessions_[cid] = session;
+  AddRoute(cid);
   if (session->is_server()) {
     STAT_INCREMENT(Stats, server_sessions);
     // We only emit the new session event for server sessions.
@@ -690,6 +757,7 @@ void Endpoint::RemoveSession(const CID& cid,
   if (sessions_.erase(cid)) {
     DecrementSocketAddressCounter(remote_address);
   }
+  RemoveRoute(cid);
   if (sessions_.empty()) {
     udp_.Unref();
   }
@@ -720,6 +788,7 @@ void Endpoint::AssociateCID(const CID& cid, const CID& scid) {
       dcid_to_scid_[cid] != scid) {
     Debug(this, "Associating CID %s with SCID %s", cid, scid);
     dcid_to_scid_.emplace(cid, scid);
+    AddRoute(cid);
   }
 }
 
@@ -727,6 +796,7 @@ void Endpoint::DisassociateCID(const CID& cid) {
   if (!is_closed() && cid) {
     Debug(this, "Disassociating CID %s", cid);
     dcid_to_scid_.erase(cid);
+    RemoveRoute(cid);
   }
 }
 
@@ -787,7 +857,7 @@ void Endpoint::SendRetry(const PathDescriptor& options) {
   auto info = addrLRU_.Upsert(options.remote_address);
   if (++(info->retry_count) <= options_.max_retries) {
     auto packet =
-        Packet::CreateRetryPacket(env(), this, options, options_.token_secret);
+        Packet::CreateRetryPacket(env(), this, options, token_secret_);
     if (packet) {
       STAT_INCREMENT(Stats, retry_count);
       Send(std::move(packet));
@@ -889,6 +959,7 @@ bool Endpoint::Start() {
       return false;
     }
     state_->bound = 1;
+    if (options_.reuse_port) StartRouting();
   }
 
   err = udp_.Start();
@@ -1036,6 +1107,7 @@ void Endpoint::Destroy(CloseContext context, int status) {
   DCHECK(sessions_.empty());
   token_map_.clear();
   dcid_to_scid_.clear();
+  StopRouting();
 
   udp_.Close();
   state_->closing = 0;
@@ -1059,8 +1131,7 @@ void Endpoint::CloseGracefully() {
   MaybeDestroy();
 }
 
-void Endpoint::Receive(const uv_buf_t& buf,
-                       const SocketAddress& remote_address) {
+void Endpoint::Receive(Store&& store, const SocketAddress& remote_address) {
   const auto receive = [&](Session* session,
                            Store&& store,
                            const SocketAddress& local_address,
@@ -1266,12 +1337,20 @@ void Endpoint::Receive(const uv_buf_t& buf,
                       "Initial packet from %s has retry token %s",
                       remote_address,
                       token);
-                auto ocid = token.Validate(
-                    version,
-                    remote_address,
-                    dcid,
-                    options_.token_secret,
-                    options_.retry_token_expiration * NGTCP2_SECONDS);
+                // Tokens made before the secret was last rotated are still
+                // accepted until they expire.
+                const auto validate = [&](const TokenSecret& secret) {
+                  return token.Validate(
+                      version,
+                      remote_address,
+                      dcid,
+                      secret,
+                      options_.retry_token_expiration * NGTCP2_SECONDS);
+                };
+                auto ocid = validate(token_secret_);
+                if (!ocid.has_value() && previous_token_secret_.has_value()) {
+                  ocid = validate(previous_token_secret_.value());
+                }
                 if (!ocid.has_value()) {
                   Debug(
                       this, "Retry token from %s is invalid.", remote_address);
@@ -1304,11 +1383,16 @@ void Endpoint::Receive(const uv_buf_t& buf,
                       "Initial packet from %s has regular token %s",
                       remote_address,
                       token);
-                if (!token.Validate(
-                        version,
-                        remote_address,
-                        options_.token_secret,
-                        options_.token_expiration * NGTCP2_SECONDS)) {
+                const auto validate = [&](const TokenSecret& secret) {
+                  return token.Validate(
+                      version,
+                      remote_address,
+                      secret,
+                      options_.token_expiration * NGTCP2_SECONDS);
+                };
+                if (!validate(token_secret_) &&
+                    (!previous_token_secret_.has_value() ||
+                     !validate(previous_token_secret_.value()))) {
                   Debug(this,
                         "Regular token from %s is invalid.",
                         remote_address);
@@ -1471,21 +1555,13 @@ void Endpoint::Receive(const uv_buf_t& buf,
   //   return;
   // }
 
-  Debug(this, "Received %zu-byte packet from %s", buf.len, remote_address);
-
-  // The managed buffer here contains the received packet. We do not yet know
-  // at this point if it is a valid QUIC packet. We need to do some basic
-  // checks. It is critical at this point that we do as little work as possible
-  // to avoid a DOS vector.
-  std::shared_ptr<BackingStore> backing = env()->release_managed_buffer(buf);
-  if (!backing) [[unlikely]] {
-    // At this point something bad happened and we need to treat this as a fatal
-    // case. There's likely no way to test this specific condition reliably.
-    return Destroy(CloseContext::RECEIVE_FAILURE, UV_ENOMEM);
-  }
-
-  Store store(std::move(backing), buf.len, 0);
+  Debug(
+      this, "Received %zu-byte packet from %s", store.length(), remote_address);
 
+  // The store here contains the received packet. We do not yet know at this
+  // point if it is a valid QUIC packet. We need to do some basic checks. It is
+  // critical at this point that we do as little work as possible to avoid a
+  // DOS vector.
   ngtcp2_vec vec = store;
   ngtcp2_version_cid pversion_cid;
 
@@ -1549,6 +1625,10 @@ void Endpoint::Receive(const uv_buf_t& buf,
     // No existing session.
     Debug(this, "No existing session for dcid %s", dcid);
 
+    // With reuse_port, the session may be owned by another endpoint bound to
+    // the same address, for instance if the path of the connection changed.
+    if (MaybeForward(dcid, store, remote_address)) return;
+
     // Handle possible reception of a stateless reset token... If it is a
     // stateless reset, the packet will be handled with no additional action
     // necessary here. We want to return immediately without committing any
@@ -1584,6 +1664,71 @@ void Endpoint::Receive(const uv_buf_t& buf,
   // session after this point.
 }
 
+void Endpoint::StartRouting() {
+  DCHECK(!router_);
+  inbox_async_ = new uv_async_t();
+  CHECK_EQ(uv_async_init(env()->event_loop(),
+                         inbox_async_,
+                         [](uv_async_t* async) {
+                           static_cast<Endpoint*>(async->data)
+                               ->ReceiveForwarded();
+                         }),
+           0);
+  inbox_async_->data = this;
+  // The inbox does not keep the event loop alive on its own, the UDP handle
+  // takes care of that.
+  uv_unref(reinterpret_cast<uv_handle_t*>(inbox_async_));
+  inbox_ = std::make_shared<CIDRouter::Inbox>(inbox_async_);
+  router_ = CIDRouter::Get(udp_.local_address());
+  Debug(this, "Routing packets with the endpoints bound to the same address");
+}
+
+void Endpoint::StopRouting() {
+  if (!router_) return;
+  router_->RemoveAll(inbox_.get());
+  inbox_->Close();
+  env()->CloseHandle(inbox_async_, [](uv_async_t* async) { delete async; });
+  inbox_async_ = nullptr;
+  inbox_.reset();
+  router_.reset();
+}
+
+void Endpoint::AddRoute(const CID& cid) {
+  if (router_) router_->Add(cid, inbox_);
+}
+
+void Endpoint::RemoveRoute(const CID& cid) {
+  if (router_) router_->Remove(cid, inbox_.get());
+}
+
+bool Endpoint::MaybeForward(const CID& dcid,
+                            const Store& store,
+                            const SocketAddress& remote_address) {
+  if (!router_) return false;
+  auto inbox = router_->Find(dcid);
+  if (!inbox || inbox == inbox_) return false;
+  ngtcp2_vec vec = store;
+  if (!inbox->Push(vec.base, vec.len, remote_address)) return false;
+  Debug(this, "Forwarded packet for dcid %s to the endpoint owning it", dcid);
+  STAT_INCREMENT(Stats, forwarded_packet_count);
+  return true;
+}
+
+void Endpoint::ReceiveForwarded() {
+  if (is_closed() || !inbox_) return;
+  for (auto& datagram : inbox_->Drain()) {
+    auto backing = ArrayBuffer::NewBackingStore(
+        env()->isolate(),
+        datagram.length,
+        BackingStoreInitializationMode::kUninitialized);
+    memcpy(backing->Data(), datagram.data.get(), datagram.length);
+    Receive(Store(std::move(backing), datagram.length),
+            datagram.remote_address);
+    // Receiving the packet may have destroyed the endpoint.
+    if (is_closed()) return;
+  }
+}
+
 void Endpoint::PacketDone(int status) {
   if (is_closed()) return;
   // At this point we should be waiting on at least one packet.
@@ -1736,6 +1881,21 @@ void Endpoint::MarkBusy(const FunctionCallbackInfo<Value>& args) {
   endpoint->MarkAsBusy(args[0]->IsTrue());
 }
 
+void Endpoint::DoRotateTokenSecret(const FunctionCallbackInfo<Value>& args) {
+  Endpoint* endpoint;
+  ASSIGN_OR_RETURN_UNWRAP(&endpoint, args.This());
+  if (args[0]->IsUndefined()) {
+    endpoint->RotateTokenSecret(TokenSecret());
+    return;
+  }
+  // The length is validated in JavaScript.
+  CHECK(args[0]->IsArrayBufferView());
+  Store store(args[0].As<ArrayBufferView>());
+  CHECK_EQ(store.length(), TokenSecret::QUIC_TOKENSECRET_LEN);
+  ngtcp2_vec buf = store;
+  endpoint->RotateTokenSecret(TokenSecret(buf.base));
+}
+
 void Endpoint::DoCloseGracefully(const FunctionCallbackInfo<Value>& args) {
   Endpoint* endpoint;
   ASSIGN_OR_RETURN_UNWRAP(&endpoint, args.This());
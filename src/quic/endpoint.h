@@ -13,6 +13,7 @@
 #include <optional>
 #include "bindingdata.h"
 #include "packet.h"
+#include "routing.h"
 #include "session.h"
 #include "sessionticket.h"
 #include "tokens.h"
@@ -126,6 +127,13 @@ class Endpoint final : public AsyncWrap, public Packet::Listener {
     // flag on the underlying uv_udp_t.
     bool ipv6_only = false;
 
+    // Sets SO_REUSEPORT on the socket, so that several endpoints, typically
+    // in different threads or processes, can bind to the same address. The
+    // kernel then distributes incoming datagrams among them by their source
+    // address, which keeps the packets of a connection on one endpoint as
+    // long as its path does not change.
+    bool reuse_port = false;
+
     uint32_t udp_receive_buffer_size = 0;
     uint32_t udp_send_buffer_size = 0;
 
@@ -170,6 +178,12 @@ class Endpoint final : public AsyncWrap, public Packet::Listener {
   // blocked when activity is too high.
   void MarkAsBusy(bool on = true);
 
+  // Replaces the secret used to generate new retry and regular tokens. Tokens
+  // generated with the previous secret are still accepted until they expire,
+  // so that endpoints that share a secret can rotate it without turning away
+  // the clients that hold one.
+  void RotateTokenSecret(const TokenSecret& secret);
+
   // Use the endpoint's token secret to generate a new token.
   RegularToken GenerateNewToken(uint32_t version,
                                 const SocketAddress& remote_address);
@@ -352,6 +366,12 @@ class Endpoint final : public AsyncWrap, public Packet::Listener {
   // packets.
   // @param bool on - If true, mark the Endpoint as busy.
   static void MarkBusy(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Rotate the secret used for retry and regular tokens.
+  // @param v8::ArrayBufferView secret - The new secret. Generated at random
+  // if undefined.
+  static void DoRotateTokenSecret(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void FastMarkBusy(v8::Local<v8::Object> receiver, bool on);
 
   // DoCloseGracefully is the signal that endpoint should close. Any packets
@@ -369,11 +389,30 @@ class Endpoint final : public AsyncWrap, public Packet::Listener {
   static void Ref(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void FastRef(v8::Local<v8::Object> receiver, bool on);
 
-  void Receive(const uv_buf_t& buf, const SocketAddress& from);
+  void Receive(Store&& store, const SocketAddress& from);
+
+  // When the endpoint is bound with reuse_port, the CIDs of its sessions are
+  // registered with the CIDRouter shared by all of the endpoints bound to the
+  // same address, and packets that other endpoints receive for them are
+  // handed to this endpoint's inbox.
+  void StartRouting();
+  void StopRouting();
+  void AddRoute(const CID& cid);
+  void RemoveRoute(const CID& cid);
+  // Hands the packet to the endpoint that owns the CID, if it is another
+  // endpoint bound to the same address. Returns true if the packet has been
+  // handed over.
+  bool MaybeForward(const CID& dcid,
+                    const Store& store,
+                    const SocketAddress& remote_address);
+  void ReceiveForwarded();
 
   AliasedStruct<Stats> stats_;
   AliasedStruct<State> state_;
   const Options options_;
+  // Initially options_.token_secret. See RotateTokenSecret().
+  TokenSecret token_secret_;
+  std::optional<TokenSecret> previous_token_secret_;
   UDP udp_;
 
   struct ServerState {
@@ -392,6 +431,11 @@ class Endpoint final : public AsyncWrap, public Packet::Listener {
   CID::Map<CID> dcid_to_scid_;
   StatelessResetToken::Map<Session*> token_map_;
 
+  // Set while the endpoint is bound with reuse_port.
+  std::shared_ptr<CIDRouter> router_;
+  std::shared_ptr<CIDRouter::Inbox> inbox_;
+  uv_async_t* inbox_async_ = nullptr;
+
   struct SocketAddressInfoTraits final {
     struct Type final {
       size_t active_connections;
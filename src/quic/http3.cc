@@ -19,11 +19,15 @@
 
 namespace node {
 
+using v8::Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Context;
+using v8::Isolate;
 using v8::Local;
 using v8::Object;
 using v8::ObjectTemplate;
+using v8::String;
 using v8::Value;
 
 namespace quic {
@@ -58,6 +62,29 @@ void Http3Application::InitPerContext(Realm* realm, Local<Object> target) {
                          target,
                          "Http3Application",
                          GetConstructorTemplate(realm->env()));
+
+  // The names of the headers that are received as a QPACK token, indexed by
+  // the token. Streams deliver these names as the token, marked with
+  // Stream::kHeaderTokenFlag, so that the strings are only created once.
+  Isolate* isolate = realm->isolate();
+  Local<Context> context = realm->context();
+  Local<Array> names = Array::New(isolate);
+  const auto set = [&](int32_t token, Local<String> name) {
+    return names->Set(context, token, name).IsJust();
+  };
+#define V(key, name)                                                           \
+  if (!set(NGHTTP3_QPACK_TOKEN__##key, FIXED_ONE_BYTE_STRING(isolate, name)))  \
+    return;
+  HTTP_SPECIAL_HEADERS(V)
+#undef V
+#define V(key, name)                                                           \
+  if (!set(NGHTTP3_QPACK_TOKEN_##key, FIXED_ONE_BYTE_STRING(isolate, name)))   \
+    return;
+  HTTP_REGULAR_HEADERS(V)
+#undef V
+  target
+      ->Set(context, FIXED_ONE_BYTE_STRING(isolate, "http3HeaderNames"), names)
+      .Check();
 }
 
 void Http3Application::RegisterExternalReferences(
@@ -259,12 +286,20 @@ class Http3ApplicationImpl final : public Session::Application {
       return false;
     }
 
+    // Data that nghttp3 did not consume yet, for instance because the
+    // stream's headers are blocked waiting on QPACK encoder instructions, is
+    // buffered by nghttp3 and reported later by on_deferred_consume. Only
+    // the stream's own flow control window waits for it. Connection level
+    // credit is returned right away, so that a blocked stream does not stall
+    // the other streams of the session. The amount nghttp3 buffers is bounded
+    // by the stream windows and by qpackBlockedStreams.
     if (nread > 0) {
-      Debug(&session(),
-            "Extending stream and connection offset by %zd bytes",
-            nread);
+      Debug(&session(), "Extending stream offset by %zd bytes", nread);
       session().ExtendStreamOffset(stream_id, nread);
-      session().ExtendOffset(nread);
+    }
+    if (datalen > 0) {
+      Debug(&session(), "Extending connection offset by %zu bytes", datalen);
+      session().ExtendOffset(datalen);
     }
 
     return true;
@@ -823,8 +858,9 @@ class Http3ApplicationImpl final : public Session::Application {
     NGHTTP3_CALLBACK_SCOPE(app);
     auto& session = app.session();
     Debug(&session, "HTTP/3 application deferred consume %zu bytes", consumed);
+    // The connection level offset was already extended when the data was
+    // received. See ReceiveStreamData().
     session.ExtendStreamOffset(stream_id, consumed);
-    session.ExtendOffset(consumed);
     return NGTCP2_SUCCESS;
   }
 
@@ -28,7 +28,9 @@ namespace quic {
 namespace {
 static constexpr size_t kRandlen = NGTCP2_MIN_STATELESS_RESET_RANDLEN * 5;
 static constexpr size_t kMinStatelessResetLen = 41;
-static constexpr size_t kMaxFreeList = 100;
+// Each free packet keeps its buffer, so this bounds the memory held by the
+// freelist to roughly kMaxFreeList * kDefaultMaxPacketLength bytes.
+static constexpr size_t kMaxFreeList = 1024;
 }  // namespace
 
 std::string PathDescriptor::ToString() const {
@@ -49,8 +51,8 @@ struct Packet::Data final : public MemoryRetainer {
 
   // The diagnostic_label_ is used only as a debugging tool when
   // logging debug information about the packet. It identifies
-  // the purpose of the packet.
-  const std::string diagnostic_label_;
+  // the purpose of the packet. It is always a string literal.
+  const char* diagnostic_label_;
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackFieldWithSize("data", data_.length());
@@ -58,11 +60,20 @@ struct Packet::Data final : public MemoryRetainer {
   SET_MEMORY_INFO_NAME(Data)
   SET_SELF_SIZE(Data)
 
-  Data(size_t length, std::string_view diagnostic_label)
+  Data(size_t length, const char* diagnostic_label)
       : diagnostic_label_(diagnostic_label) {
     data_.AllocateSufficientStorage(length);
   }
 
+  // Whether the storage can be reused for a packet of up to the default
+  // length, which is the case unless it had to be allocated separately.
+  bool is_reusable() const { return !data_.IsAllocated(); }
+
+  void Reset(size_t length, const char* diagnostic_label) {
+    diagnostic_label_ = diagnostic_label;
+    data_.AllocateSufficientStorage(length);
+  }
+
   size_t length() const { return data_.length(); }
   operator uv_buf_t() {
     return uv_buf_init(reinterpret_cast<char*>(data_.out()), data_.length());
@@ -70,7 +81,7 @@ struct Packet::Data final : public MemoryRetainer {
   operator ngtcp2_vec() { return ngtcp2_vec{data_.out(), data_.length()}; }
 
   std::string ToString() const {
-    return diagnostic_label_ + ", " + std::to_string(length());
+    return std::string(diagnostic_label_) + ", " + std::to_string(length());
   }
 };
 
@@ -127,10 +138,15 @@ BaseObjectPtr<Packet> Packet::Create(Environment* env,
         env, listener, obj, destination, length, diagnostic_label);
   }
 
-  return FromFreeList(env,
-                      std::make_shared<Data>(length, diagnostic_label),
-                      listener,
-                      destination);
+  auto packet = FromFreeList(env, listener, destination);
+  // Packets in the freelist usually still have their buffer, which can be
+  // used again unless the new packet needs more room.
+  if (packet->data_ && length <= kDefaultMaxPacketLength) {
+    packet->data_->Reset(length, diagnostic_label);
+  } else {
+    packet->data_ = std::make_shared<Data>(length, diagnostic_label);
+  }
+  return packet;
 }
 
 BaseObjectPtr<Packet> Packet::Clone() const {
@@ -147,11 +163,12 @@ BaseObjectPtr<Packet> Packet::Clone() const {
     return MakeBaseObject<Packet>(env(), listener_, obj, destination_, data_);
   }
 
-  return FromFreeList(env(), data_, listener_, destination_);
+  auto packet = FromFreeList(env(), listener_, destination_);
+  packet->data_ = data_;
+  return packet;
 }
 
 BaseObjectPtr<Packet> Packet::FromFreeList(Environment* env,
-                                           std::shared_ptr<Data> data,
                                            Listener* listener,
                                            const SocketAddress& destination) {
   auto& binding = BindingData::Get(env);
@@ -162,7 +179,6 @@ BaseObjectPtr<Packet> Packet::FromFreeList(Environment* env,
   CHECK_EQ(env, obj->env());
   auto packet = BaseObjectPtr<Packet>(static_cast<Packet*>(obj.get()));
   Debug(packet.get(), "Reusing packet from freelist");
-  packet->data_ = std::move(data);
   packet->destination_ = destination;
   packet->listener_ = listener;
   return packet;
@@ -211,7 +227,9 @@ void Packet::Done(int status) {
 
   Debug(this, "Returning packet to freelist");
   listener_ = nullptr;
-  data_.reset();
+  // Keep the buffer for the next packet, unless it is shared with a clone
+  // of this packet or larger than a default packet.
+  if (data_ && (data_.use_count() > 1 || !data_->is_reusable())) data_.reset();
   Reset();
   binding.packet_freelist.push_back(std::move(self));
 }
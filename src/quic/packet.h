@@ -39,7 +39,9 @@ struct PathDescriptor {
 // BindingData instance. When using Create() to create
 // a Packet, we'll check to see if there is a free
 // packet in the freelist and use it instead of starting
-// fresh with a new packet. The freelist can store at
+// fresh with a new packet. Free packets keep their
+// storage, so that reusing one allocates neither a JS
+// object nor a buffer. The freelist can store at
 // most kMaxFreeList packets
 //
 // Packets are always encrypted so their content should
@@ -140,7 +142,6 @@ class Packet final : public ReqWrap<uv_udp_send_t> {
 
  private:
   static BaseObjectPtr<Packet> FromFreeList(Environment* env,
-                                            std::shared_ptr<Data> data,
                                             Listener* listener,
                                             const SocketAddress& destination);
 
@@ -0,0 +1,123 @@
+#if HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
+
+#include "routing.h"
+#include <node_sockaddr-inl.h>
+#include <util-inl.h>
+#include <unordered_map>
+
+namespace node::quic {
+
+namespace {
+// The routers of the process by local address. The map only holds weak
+// references, the routers are owned by the Endpoints that use them.
+struct RouterRegistry final {
+  Mutex mutex;
+  std::unordered_map<SocketAddress,
+                     std::weak_ptr<CIDRouter>,
+                     SocketAddress::Hash>
+      routers;
+};
+
+RouterRegistry& GetRouterRegistry() {
+  // Intentionally leaked, the routers may outlive static destructors.
+  static RouterRegistry* registry = new RouterRegistry();
+  return *registry;
+}
+}  // namespace
+
+// ============================================================================
+// CIDRouter::Inbox
+
+CIDRouter::Inbox::Inbox(uv_async_t* async) : async_(async) {
+  CHECK_NOT_NULL(async);
+}
+
+bool CIDRouter::Inbox::Push(const uint8_t* data,
+                            size_t length,
+                            const SocketAddress& remote_address) {
+  Mutex::ScopedLock lock(mutex_);
+  if (async_ == nullptr) return false;
+  auto copy = std::make_unique<uint8_t[]>(length);
+  memcpy(copy.get(), data, length);
+  datagrams_.push_back(Datagram{std::move(copy), length, remote_address});
+  // Only the first datagram of a batch needs to wake up the Endpoint, the
+  // rest are drained along with it.
+  if (datagrams_.size() == 1) CHECK_EQ(uv_async_send(async_), 0);
+  return true;
+}
+
+std::vector<CIDRouter::Datagram> CIDRouter::Inbox::Drain() {
+  std::vector<Datagram> datagrams;
+  Mutex::ScopedLock lock(mutex_);
+  datagrams_.swap(datagrams);
+  return datagrams;
+}
+
+void CIDRouter::Inbox::Close() {
+  Mutex::ScopedLock lock(mutex_);
+  async_ = nullptr;
+  datagrams_.clear();
+}
+
+// ============================================================================
+// CIDRouter
+
+std::shared_ptr<CIDRouter> CIDRouter::Get(const SocketAddress& address) {
+  auto& registry = GetRouterRegistry();
+  Mutex::ScopedLock lock(registry.mutex);
+  auto& entry = registry.routers[address];
+  std::shared_ptr<CIDRouter> router = entry.lock();
+  if (!router) {
+    router = std::make_shared<CIDRouter>(address);
+    entry = router;
+  }
+  return router;
+}
+
+CIDRouter::CIDRouter(const SocketAddress& address) : address_(address) {}
+
+CIDRouter::~CIDRouter() {
+  auto& registry = GetRouterRegistry();
+  Mutex::ScopedLock lock(registry.mutex);
+  auto it = registry.routers.find(address_);
+  // Another router may have been registered for the address since the last
+  // reference to this one was dropped.
+  if (it != registry.routers.end() && it->second.expired())
+    registry.routers.erase(it);
+}
+
+void CIDRouter::Add(const CID& cid, const std::shared_ptr<Inbox>& inbox) {
+  if (!cid) return;
+  RwLock::ScopedWriteLock lock(lock_);
+  routes_[cid] = inbox;
+}
+
+void CIDRouter::Remove(const CID& cid, const Inbox* inbox) {
+  if (!cid) return;
+  RwLock::ScopedWriteLock lock(lock_);
+  auto it = routes_.find(cid);
+  if (it != routes_.end() && it->second.get() == inbox) routes_.erase(it);
+}
+
+void CIDRouter::RemoveAll(const Inbox* inbox) {
+  RwLock::ScopedWriteLock lock(lock_);
+  for (auto it = routes_.begin(); it != routes_.end();) {
+    if (it->second.get() == inbox) {
+      it = routes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<CIDRouter::Inbox> CIDRouter::Find(const CID& cid) const {
+  if (!cid) return {};
+  RwLock::ScopedReadLock lock(lock_);
+  auto it = routes_.find(cid);
+  if (it == routes_.end()) return {};
+  return it->second;
+}
+
+}  // namespace node::quic
+
+#endif  // HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
@@ -0,0 +1,96 @@
+#pragma once
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#if HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
+
+#include <node_mutex.h>
+#include <node_sockaddr.h>
+#include <uv.h>
+#include <memory>
+#include <vector>
+#include "cid.h"
+
+namespace node::quic {
+
+// When several Endpoints, usually one per worker thread, are bound to the same
+// local address with reuse_port, the kernel distributes the datagrams among
+// their sockets by the source address of each datagram. That keeps all of the
+// packets of a connection on one Endpoint until its path changes, for instance
+// after a NAT rebinding or a connection migration. From then on, the packets
+// may be delivered to an Endpoint that knows nothing about the Session.
+//
+// A CIDRouter is shared by all of the Endpoints of the process that are bound
+// to the same local address. It maps the CIDs of their sessions to the Inbox of
+// the Endpoint that owns each session, so that an Endpoint that receives a
+// packet for a CID it does not know can hand the packet to the owning Endpoint
+// directly, without a detour through JavaScript. Lookups are far more common
+// than updates, so they only take a read lock.
+class CIDRouter final {
+ public:
+  // A datagram handed from one Endpoint to another. The data is copied out of
+  // the receiving Endpoint's buffers since those belong to its isolate.
+  struct Datagram final {
+    std::unique_ptr<uint8_t[]> data;
+    size_t length;
+    SocketAddress remote_address;
+  };
+
+  // The datagrams that other threads have handed to an Endpoint. The Endpoint
+  // is woken up through its uv_async_t, which it has to keep open until
+  // Close() has been called.
+  class Inbox final {
+   public:
+    explicit Inbox(uv_async_t* async);
+
+    Inbox(const Inbox&) = delete;
+    Inbox& operator=(const Inbox&) = delete;
+
+    // Queues a copy of the datagram. Returns false if the Endpoint has
+    // already been closed.
+    bool Push(const uint8_t* data,
+              size_t length,
+              const SocketAddress& remote_address);
+
+    // Takes all of the queued datagrams. Called on the Endpoint's thread.
+    std::vector<Datagram> Drain();
+
+    // Called on the Endpoint's thread before the uv_async_t is closed.
+    void Close();
+
+   private:
+    Mutex mutex_;
+    uv_async_t* async_;
+    std::vector<Datagram> datagrams_;
+  };
+
+  // Returns the router shared by the Endpoints bound to the given address,
+  // creating it if there is none yet.
+  static std::shared_ptr<CIDRouter> Get(const SocketAddress& address);
+
+  explicit CIDRouter(const SocketAddress& address);
+  ~CIDRouter();
+
+  CIDRouter(const CIDRouter&) = delete;
+  CIDRouter& operator=(const CIDRouter&) = delete;
+
+  void Add(const CID& cid, const std::shared_ptr<Inbox>& inbox);
+
+  // Removes the route for the given CID if it leads to the given inbox.
+  void Remove(const CID& cid, const Inbox* inbox);
+
+  // Removes all of the routes that lead to the given inbox.
+  void RemoveAll(const Inbox* inbox);
+
+  // Returns the inbox of the Endpoint that owns the CID, if any.
+  std::shared_ptr<Inbox> Find(const CID& cid) const;
+
+ private:
+  const SocketAddress address_;
+  RwLock lock_;
+  CID::Map<std::shared_ptr<Inbox>> routes_;
+};
+
+}  // namespace node::quic
+
+#endif  // HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -6,6 +6,7 @@
 #include <crypto/crypto_util.h>
 #include <debug_utils-inl.h>
 #include <env-inl.h>
+#include <histogram-inl.h>
 #include <memory_tracker-inl.h>
 #include <ngtcp2/ngtcp2.h>
 #include <node_bob-inl.h>
@@ -459,7 +460,8 @@ Maybe<Session::Options> Session::Options::From(Environment* env,
       !SET(transport_params) || !SET(tls_options) || !SET(qlog) ||
       !SET(application_provider) || !SET(handshake_timeout) ||
       !SET(max_stream_window) || !SET(max_window) || !SET(max_payload_size) ||
-      !SET(unacknowledged_packet_threshold) || !SET(cc_algorithm)) {
+      !SET(unacknowledged_packet_threshold) || !SET(cc_algorithm) ||
+      !SET(record_metrics) || !SET(pacing)) {
     return Nothing<Options>();
   }
 
@@ -506,6 +508,12 @@ std::string Session::Options::ToString() const {
     res += prefix + "unacknowledged packet threshold: <default>";
   }
   res += prefix + "cc algorithm: " + to_string(cc_algorithm);
+  if (record_metrics) {
+    res += prefix + "record metrics: yes";
+  }
+  if (pacing) {
+    res += prefix + "pacing: yes";
+  }
   res += indent.Close();
   return res;
 }
@@ -535,6 +543,12 @@ struct Session::Impl final : public MemoryRetainer {
   QuicError last_error_;
   PendingStream::PendingStreamQueue pending_bidi_stream_queue_;
   PendingStream::PendingStreamQueue pending_uni_stream_queue_;
+  // Only allocated when the record_metrics option is set. The histograms are
+  // shared with the HistogramBase handles given to JavaScript, which may be
+  // cloned to other threads and outlive the session.
+  std::shared_ptr<Histogram> rtt_histogram_;
+  std::shared_ptr<Histogram> cwnd_histogram_;
+  std::shared_ptr<Histogram> pacing_histogram_;
 
   Impl(Session* session, Endpoint* endpoint, const Config& config)
       : session_(session),
@@ -547,6 +561,11 @@ struct Session::Impl final : public MemoryRetainer {
         application_(SelectApplication(session, config_)),
         timer_(session_->env(), [this] { session_->OnTimeout(); }) {
     timer_.Unref();
+    if (config.options.record_metrics) [[unlikely]] {
+      rtt_histogram_ = std::make_shared<Histogram>(Histogram::Options{});
+      cwnd_histogram_ = std::make_shared<Histogram>(Histogram::Options{});
+      pacing_histogram_ = std::make_shared<Histogram>(Histogram::Options{});
+    }
   }
 
   inline bool is_closing() const { return state_->closing; }
@@ -631,6 +650,9 @@ struct Session::Impl final : public MemoryRetainer {
     tracker->TrackField("remote_address", remote_address_);
     tracker->TrackField("application", application_);
     tracker->TrackField("timer", timer_);
+    tracker->TrackField("rtt_histogram", rtt_histogram_);
+    tracker->TrackField("cwnd_histogram", cwnd_histogram_);
+    tracker->TrackField("pacing_histogram", pacing_histogram_);
   }
   SET_SELF_SIZE(Impl)
   SET_MEMORY_INFO_NAME(Session::Impl)
@@ -1317,6 +1339,21 @@ Session::Session(Endpoint* endpoint,
     defineProperty(binding.keylog_string(), keylog_stream_->object());
   }
 
+  if (config.options.record_metrics) [[unlikely]] {
+    // The order must match the destructuring of the metrics property in
+    // lib/internal/quic/quic.js.
+    auto rtt = HistogramBase::Create(env(), impl_->rtt_histogram_);
+    auto cwnd = HistogramBase::Create(env(), impl_->cwnd_histogram_);
+    auto pacing = HistogramBase::Create(env(), impl_->pacing_histogram_);
+    if (rtt && cwnd && pacing) [[likely]] {
+      Local<Value> histograms[] = {
+          rtt->object(), cwnd->object(), pacing->object()};
+      defineProperty(
+          binding.metrics_string(),
+          Array::New(env()->isolate(), histograms, arraysize(histograms)));
+    }
+  }
+
   UpdateDataStats();
 }
 
@@ -2195,6 +2232,15 @@ void Session::UpdateDataStats() {
   auto& stats_ = impl_->stats_;
   ngtcp2_conn_info info;
   ngtcp2_conn_get_conn_info(*this, &info);
+  if (impl_->rtt_histogram_) [[unlikely]] {
+    // ngtcp2 does not report individual RTT samples, so a new sample is
+    // detected by latest_rtt changing. Consecutive samples with the exact
+    // same value are recorded once.
+    if (info.latest_rtt > 0 && info.latest_rtt != STAT_GET(Stats, latest_rtt))
+      impl_->rtt_histogram_->Record(info.latest_rtt);
+    if (info.cwnd > 0 && info.cwnd != STAT_GET(Stats, cwnd))
+      impl_->cwnd_histogram_->Record(info.cwnd);
+  }
   STAT_SET(Stats, bytes_in_flight, info.bytes_in_flight);
   STAT_SET(Stats, cwnd, info.cwnd);
   STAT_SET(Stats, latest_rtt, info.latest_rtt);
@@ -2208,6 +2254,19 @@ void Session::UpdateDataStats() {
       std::max(STAT_GET(Stats, max_bytes_in_flight), info.bytes_in_flight));
 }
 
+void Session::RecordPacingDelay() {
+  if (!impl_->pacing_histogram_) [[likely]] {
+    return;
+  }
+  // After ngtcp2_conn_update_pkt_tx_time(), the expiry includes the time at
+  // which pacing allows the next packet to go out.
+  uint64_t expiry = ngtcp2_conn_get_expiry(*this);
+  uint64_t now = uv_hrtime();
+  if (expiry > now && expiry != UINT64_MAX) {
+    impl_->pacing_histogram_->Record(expiry - now);
+  }
+}
+
 void Session::SendConnectionClose() {
   // Method is a non-op if the session is in a state where packets cannot
   // be transmitted to the remote peer.
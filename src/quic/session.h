@@ -177,6 +177,16 @@ class Session final : public AsyncWrap, private SessionTicket::AppData::Source {
     // is the better of the two for our needs.
     ngtcp2_cc_algo cc_algorithm = CC_ALGO_CUBIC;
 
+    // When true, RTT samples, congestion window changes and pacing delays are
+    // recorded into histograms that are exposed to JavaScript. Off by default
+    // because it adds work to every ack processed by the session.
+    bool record_metrics = false;
+
+    // When true, the packets that ngtcp2's send quantum allows are sent in
+    // smaller bursts, leaving it to the session timer to send the rest once
+    // the pacing interval computed by the congestion controller has elapsed.
+    bool pacing = false;
+
     void MemoryInfo(MemoryTracker* tracker) const override;
     SET_MEMORY_INFO_NAME(Session::Options)
     SET_SELF_SIZE(Options)
@@ -460,6 +470,9 @@ class Session final : public AsyncWrap, private SessionTicket::AppData::Source {
   // Has to be called after certain operations that generate packets.
   void UpdatePacketTxTime();
   void UpdateDataStats();
+  // Records the time until ngtcp2 allows the next packet to be sent. Called
+  // when a send burst ended because the send quantum was used up.
+  void RecordPacingDelay();
   void UpdatePath(const PathStorage& path);
 
   void ProcessPendingBidiStreams();
@@ -18,6 +18,7 @@ namespace node {
 using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::BackingStoreInitializationMode;
 using v8::BigInt;
 using v8::FunctionCallbackInfo;
@@ -33,6 +34,7 @@ using v8::ObjectTemplate;
 using v8::PropertyAttribute;
 using v8::SharedArrayBuffer;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Value;
 
 namespace quic {
@@ -430,7 +432,7 @@ class Stream::Outbound final : public MemoryRetainer {
     // otherwise, return whatever is in the uncommitted queue.
     if (eos_) {
       if (uncommitted_ > 0) {
-        PullUncommitted(std::move(next));
+        PullUncommitted(std::move(next), data, count);
         return bob::Status::STATUS_CONTINUE;
       }
       std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, [](int) {});
@@ -442,7 +444,7 @@ class Stream::Outbound final : public MemoryRetainer {
     // uncommitted bytes currently in the queue rather than reading more from
     // the queue.
     if (uncommitted_ >= kDefaultMaxPacketLength) {
-      PullUncommitted(std::move(next));
+      PullUncommitted(std::move(next), data, count);
       return bob::Status::STATUS_CONTINUE;
     }
 
@@ -540,7 +542,7 @@ class Stream::Outbound final : public MemoryRetainer {
         // If the read returns eos, and there are uncommitted bytes in the
         // queue, we'll set eos_ to true and return the current set of
         // uncommitted bytes.
-        PullUncommitted(std::move(next));
+        PullUncommitted(std::move(next), data, count);
         return bob::STATUS_CONTINUE;
       }
       // If the read returns eos, and there are no uncommitted bytes in the
@@ -553,7 +555,7 @@ class Stream::Outbound final : public MemoryRetainer {
       // If the read returns blocked, and there are uncommitted bytes in the
       // queue, we'll return the current set of uncommitted bytes.
       if (uncommitted_ > 0) {
-        PullUncommitted(std::move(next));
+        PullUncommitted(std::move(next), data, count);
         return bob::Status::STATUS_CONTINUE;
       }
       // If the read returns blocked, and there are no uncommitted bytes in the
@@ -572,7 +574,7 @@ class Stream::Outbound final : public MemoryRetainer {
     }
 
     DCHECK_EQ(ret, bob::Status::STATUS_CONTINUE);
-    PullUncommitted(std::move(next));
+    PullUncommitted(std::move(next), data, count);
     return bob::Status::STATUS_CONTINUE;
   }
 
@@ -592,20 +594,33 @@ class Stream::Outbound final : public MemoryRetainer {
     ~OnComplete() { std::move(done)(0); }
   };
 
-  void PullUncommitted(bob::Next<ngtcp2_vec> next) {
+  // Passes the uncommitted bytes on as vectors that point into the entries
+  // pulled from reader_, so the payload is only copied once, when it is
+  // written into a packet. The entries are held until the bytes are
+  // acknowledged. When the caller provides storage for the vectors, they are
+  // written into it directly and at most count of them are passed on.
+  void PullUncommitted(bob::Next<ngtcp2_vec> next,
+                       ngtcp2_vec* data,
+                       size_t count) {
     MaybeStackBuffer<ngtcp2_vec, 16> chunks;
-    chunks.AllocateSufficientStorage(count_);
+    ngtcp2_vec* dest = data;
+    size_t max = std::min(count, count_);
+    if (dest == nullptr || max == 0) {
+      chunks.AllocateSufficientStorage(count_);
+      dest = chunks.out();
+      max = count_;
+    }
     auto head = commit_head_;
     size_t n = 0;
-    while (head != nullptr && n < count_) {
+    while (head != nullptr && n < max) {
       // There might only be one byte here but there should never be zero.
       DCHECK_LT(head->offset, head->buf.len);
-      chunks[n].base = head->buf.base + head->offset;
-      chunks[n].len = head->buf.len - head->offset;
+      dest[n].base = head->buf.base + head->offset;
+      dest[n].len = head->buf.len - head->offset;
       head = head->next.get();
       n++;
     }
-    std::move(next)(bob::Status::STATUS_CONTINUE, chunks.out(), n, [](int) {});
+    std::move(next)(bob::Status::STATUS_CONTINUE, dest, n, [](int) {});
   }
 
   void MarkErrored() {
@@ -770,6 +785,9 @@ void Stream::InitPerContext(Realm* realm, Local<Object> target) {
 
   NODE_DEFINE_CONSTANT(target, QUIC_STREAM_HEADERS_FLAGS_NONE);
   NODE_DEFINE_CONSTANT(target, QUIC_STREAM_HEADERS_FLAGS_TERMINAL);
+
+  constexpr uint32_t QUIC_STREAM_HEADER_TOKEN_FLAG = kHeaderTokenFlag;
+  NODE_DEFINE_CONSTANT(target, QUIC_STREAM_HEADER_TOKEN_FLAG);
 }
 
 Stream* Stream::From(void* stream_user_data) {
@@ -1065,6 +1083,7 @@ int Stream::DoPull(bob::Next<ngtcp2_vec> next,
 void Stream::BeginHeaders(HeadersKind kind) {
   headers_length_ = 0;
   headers_.clear();
+  headers_offsets_.clear();
   set_headers_kind(kind);
 }
 
@@ -1075,24 +1094,24 @@ void Stream::set_headers_kind(HeadersKind kind) {
 bool Stream::AddHeader(const Header& header) {
   size_t len = header.length();
   if (!session_->application().CanAddHeader(
-          headers_.size(), headers_length_, len)) {
+          headers_offsets_.size() / 2, headers_length_, len)) {
     return false;
   }
 
   headers_length_ += len;
 
-  auto& state = BindingData::Get(env());
-
-  const auto push = [&](auto raw) {
-    Local<Value> value;
-    if (!raw.ToLocal(&value)) [[unlikely]] {
-      return false;
-    }
-    headers_.push_back(value);
-    return true;
-  };
-
-  return push(header.GetName(&state)) && push(header.GetValue(&state));
+  // No JavaScript values are created until the whole block is emitted.
+  int32_t token = header.token();
+  if (token >= 0) {
+    headers_offsets_.push_back(kHeaderTokenFlag |
+                               static_cast<uint32_t>(token));
+  } else {
+    headers_ += header.name_view();
+    headers_offsets_.push_back(static_cast<uint32_t>(headers_.size()));
+  }
+  headers_ += header.value_view();
+  headers_offsets_.push_back(static_cast<uint32_t>(headers_.size()));
+  return true;
 }
 
 void Stream::Acknowledge(size_t datalen) {
@@ -1260,13 +1279,30 @@ void Stream::EmitHeaders() {
   }
   CallbackScope<Stream> cb_scope(this);
 
+  // The names and values are followed in the same ArrayBuffer by their end
+  // offsets, which need to be aligned for the Uint32Array. See
+  // decodeHeaders() in lib/internal/quic/quic.js.
+  const size_t offsets_start =
+      (headers_.size() + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+  const size_t count = headers_offsets_.size();
+  std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+      env()->isolate(),
+      offsets_start + count * sizeof(uint32_t),
+      BackingStoreInitializationMode::kUninitialized);
+  char* data = static_cast<char*>(bs->Data());
+  memcpy(data, headers_.data(), headers_.size());
+  memcpy(data + offsets_start,
+         headers_offsets_.data(),
+         count * sizeof(uint32_t));
+  headers_.clear();
+  headers_offsets_.clear();
+
+  Local<ArrayBuffer> ab = ArrayBuffer::New(env()->isolate(), std::move(bs));
   Local<Value> argv[] = {
-      Array::New(env()->isolate(), headers_.data(), headers_.size()),
+      Uint32Array::New(ab, offsets_start, count),
       Integer::NewFromUnsigned(env()->isolate(),
                                static_cast<uint32_t>(headers_kind_))};
 
-  headers_.clear();
-
   MakeCallback(
       BindingData::Get(env()).stream_headers_callback(), arraysize(argv), argv);
 }
@@ -250,6 +250,10 @@ class Stream final : public AsyncWrap,
   // Currently, only HTTP/3 streams support headers. These methods are here
   // to support that. They are not used when using any other QUIC application.
 
+  // Marks the offsets of header names that are identified by a token, see
+  // headers_offsets_. The application maps tokens to names.
+  static constexpr uint32_t kHeaderTokenFlag = 1u << 31;
+
   void BeginHeaders(HeadersKind kind);
   void set_headers_kind(HeadersKind kind);
   // Returns false if the header cannot be added. This will typically happen
@@ -329,10 +333,13 @@ class Stream final : public AsyncWrap,
   };
   std::optional<PendingPriority> pending_priority_ = std::nullopt;
 
-  // The headers_ field holds a block of headers that have been received and
-  // are being buffered for delivery to the JavaScript side.
-  // TODO(@jasnell): Use v8::Global instead of v8::Local here.
-  v8::LocalVector<v8::Value> headers_;
+  // The headers_ field holds the names and values of a block of headers that
+  // have been received, back to back, while they are buffered for delivery
+  // to the JavaScript side. headers_offsets_ holds the offset in headers_ at
+  // which each name and value ends. Names that the application identifies by
+  // a token are not copied; their offset is kHeaderTokenFlag | token instead.
+  std::string headers_;
+  std::vector<uint32_t> headers_offsets_;
 
   // The headers_kind_ field indicates the kind of headers that are being
   // buffered.
@@ -11,6 +11,7 @@
 #include <ngtcp2/ngtcp2_crypto.h>
 #include <ngtcp2/ngtcp2_crypto_quictls.h>
 #include <node_sockaddr-inl.h>
+#include <openssl/hmac.h>
 #include <openssl/ssl.h>
 #include <v8.h>
 #include "bindingdata.h"
@@ -21,7 +22,9 @@
 namespace node {
 
 using ncrypto::BIOPointer;
+using ncrypto::Cipher;
 using ncrypto::ClearErrorOnReturn;
+using ncrypto::Digest;
 using ncrypto::MarkPopErrorOnReturn;
 using ncrypto::SSLCtxPointer;
 using ncrypto::SSLPointer;
@@ -240,6 +243,52 @@ int TLSContext::OnVerifyClientCertificate(int preverify_ok,
   return 1;
 }
 
+int TLSContext::OnTicketKey(SSL* ssl,
+                            unsigned char* name,
+                            unsigned char* iv,
+                            EVP_CIPHER_CTX* ectx,
+                            HMAC_CTX* hctx,
+                            int enc) {
+  static constexpr size_t kNameLength = 16;
+  static constexpr size_t kSecretLength = 16;
+  const auto& keys = TLSSession::From(ssl).context().options().ticket_keys;
+  DCHECK(!keys.empty());
+
+  const auto init = [&](const Store& key, bool encrypt) {
+    ngtcp2_vec vec = key;
+    const uint8_t* hmac = vec.base + kNameLength;
+    const uint8_t* aes = hmac + kSecretLength;
+    return EVP_CipherInit_ex(ectx,
+                             Cipher::AES_128_CBC,
+                             nullptr,
+                             aes,
+                             iv,
+                             encrypt ? 1 : 0) > 0 &&
+           HMAC_Init_ex(hctx, hmac, kSecretLength, Digest::SHA256, nullptr) >
+               0;
+  };
+
+  if (enc) {
+    ngtcp2_vec current = keys[0];
+    memcpy(name, current.base, kNameLength);
+    if (!ncrypto::CSPRNG(iv, 16) || !init(keys[0], true)) return -1;
+    return 1;
+  }
+
+  for (size_t n = 0; n < keys.size(); n++) {
+    ngtcp2_vec key = keys[n];
+    if (memcmp(name, key.base, kNameLength) != 0) continue;
+    if (!init(keys[n], false)) return -1;
+    // Tickets encrypted with a key other than the current one are replaced
+    // with new ones.
+    return n == 0 ? 1 : 2;
+  }
+
+  // None of the keys match. The ticket is ignored and a full handshake is
+  // performed.
+  return 0;
+}
+
 std::unique_ptr<TLSSession> TLSContext::NewSession(
     Session* session, const std::optional<SessionTicket>& maybeSessionTicket) {
   // Passing a session ticket only makes sense with a client session.
@@ -274,6 +323,16 @@ SSLCtxPointer TLSContext::Initialize() {
                            OnVerifyClientCertificate);
       }
 
+      if (!options_.ticket_keys.empty()) {
+        for (const auto& key : options_.ticket_keys) {
+          if (key.length() != kTicketKeyLength) {
+            validation_error_ = "Invalid ticket key length";
+            return SSLCtxPointer();
+          }
+        }
+        SSL_CTX_set_tlsext_ticket_key_cb(ctx.get(), OnTicketKey);
+      }
+
       // TODO(@jasnell): There's a bug int the GenerateCallback flow somewhere.
       // Need to update in order to support session tickets.
       // CHECK_EQ(SSL_CTX_set_session_ticket_cb(ctx.get(),
@@ -328,7 +387,7 @@ SSLCtxPointer TLSContext::Initialize() {
               auto x509 = X509Pointer(PEM_read_bio_X509_AUX(
                   bio.get(), nullptr, crypto::NoPasswordCallback, nullptr))) {
             if (cert_store == crypto::GetOrCreateRootCertStore()) {
-              cert_store = crypto::NewRootCertStore();
+              cert_store = crypto::NewRootCertStoreOverlay();
               SSL_CTX_set_cert_store(ctx.get(), cert_store);
             }
             CHECK_EQ(1, X509_STORE_add_cert(cert_store, x509.get()));
@@ -386,7 +445,7 @@ SSLCtxPointer TLSContext::Initialize() {
 
       X509_STORE* cert_store = SSL_CTX_get_cert_store(ctx.get());
       if (cert_store == crypto::GetOrCreateRootCertStore()) {
-        cert_store = crypto::NewRootCertStore();
+        cert_store = crypto::NewRootCertStoreOverlay();
         SSL_CTX_set_cert_store(ctx.get(), cert_store);
       }
 
@@ -446,7 +505,8 @@ Maybe<TLSContext::Options> TLSContext::Options::From(Environment* env,
       !SET(servername) || !SET(ciphers) || !SET(groups) ||
       !SET(verify_private_key) || !SET(keylog) ||
       !SET_VECTOR(crypto::KeyObjectData, keys) || !SET_VECTOR(Store, certs) ||
-      !SET_VECTOR(Store, ca) || !SET_VECTOR(Store, crl)) {
+      !SET_VECTOR(Store, ca) || !SET_VECTOR(Store, crl) ||
+      !SET_VECTOR(Store, ticket_keys)) {
     return Nothing<Options>();
   }
 
@@ -473,6 +533,7 @@ std::string TLSContext::Options::ToString() const {
   res += prefix + "certs: " + std::to_string(certs.size());
   res += prefix + "ca: " + std::to_string(ca.size());
   res += prefix + "crl: " + std::to_string(crl.size());
+  res += prefix + "ticket keys: " + std::to_string(ticket_keys.size());
   res += indent.Close();
   return res;
 }
@@ -482,6 +543,7 @@ void TLSContext::Options::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("certs", certs);
   tracker->TrackField("ca", ca);
   tracker->TrackField("crl", crl);
+  tracker->TrackField("ticket_keys", ticket_keys);
 }
 
 const TLSContext::Options TLSContext::Options::kDefault = {};
@@ -112,6 +112,10 @@ class TLSContext final : public MemoryRetainer,
                                           "SHA256:TLS_AES_128_CCM_SHA256";
   static constexpr auto DEFAULT_GROUPS = "X25519:P-256:P-384:P-521";
 
+  // A ticket key is made of a 16-byte name, a 16-byte HMAC secret and a
+  // 16-byte AES key, like the ticketKeys of tls.Server.
+  static constexpr size_t kTicketKeyLength = 48;
+
   struct Options final : public MemoryRetainer {
     // The SNI servername to use for this session. This option is only used by
     // the client.
@@ -162,6 +166,16 @@ class TLSContext final : public MemoryRetainer,
     // JavaScript option name "crl"
     std::vector<Store> crl;
 
+    // The keys used to encrypt and decrypt TLS session tickets, each of
+    // kTicketKeyLength bytes. New tickets are encrypted with the first key,
+    // tickets encrypted with any of the others are still accepted and renewed.
+    // Servers that share the keys accept each other's tickets, so clients can
+    // resume sessions, and send 0-RTT data, to any of them. When empty, the
+    // server uses a random key of its own. This option is only used by the
+    // server side.
+    // JavaScript option name "ticketKeys"
+    std::vector<Store> ticket_keys;
+
     void MemoryInfo(MemoryTracker* tracker) const override;
     SET_MEMORY_INFO_NAME(TLSContext::Options)
     SET_SELF_SIZE(Options)
@@ -211,6 +225,12 @@ class TLSContext final : public MemoryRetainer,
                           unsigned int inlen,
                           void* arg);
   static int OnVerifyClientCertificate(int preverify_ok, X509_STORE_CTX* ctx);
+  static int OnTicketKey(SSL* ssl,
+                         unsigned char* name,
+                         unsigned char* iv,
+                         EVP_CIPHER_CTX* ectx,
+                         HMAC_CTX* hctx,
+                         int enc);
 
   Side side_;
   Options options_;
@@ -0,0 +1,123 @@
+#include "slab_allocator.h"
+
+#include "memory_tracker-inl.h"
+#include "util.h"
+
+#include <algorithm>
+
+namespace node {
+
+SlabAllocator::SlabAllocator(v8::ArrayBuffer::Allocator* backing)
+    : backing_(backing) {}
+
+SlabAllocator::~SlabAllocator() {
+  for (auto& [address, slab] : slabs_) {
+    backing_->Free(slab->base, kSlabSize);
+  }
+}
+
+size_t SlabAllocator::SizeClassOf(size_t size) {
+  auto it = std::lower_bound(kBlockSizes.begin(), kBlockSizes.end(), size);
+  CHECK_NE(it, kBlockSizes.end());
+  return it - kBlockSizes.begin();
+}
+
+SlabAllocator::Slab* SlabAllocator::NewSlab(size_t size_class) {
+  char* base = static_cast<char*>(backing_->AllocateUninitialized(kSlabSize));
+  if (base == nullptr) return nullptr;
+  auto slab = std::make_unique<Slab>();
+  slab->base = base;
+  slab->size_class = size_class;
+  Slab* ret = slab.get();
+  slabs_.emplace(reinterpret_cast<uintptr_t>(base), std::move(slab));
+  return ret;
+}
+
+void SlabAllocator::ReleaseSlab(Slab* slab) {
+  char* base = slab->base;
+  slabs_.erase(reinterpret_cast<uintptr_t>(base));
+  backing_->Free(base, kSlabSize);
+}
+
+void* SlabAllocator::Allocate(size_t size) {
+  CHECK_LE(size, kMaxSize);
+  const size_t size_class = SizeClassOf(size);
+  const size_t block_size = kBlockSizes[size_class];
+
+  Mutex::ScopedLock lock(mutex_);
+  SizeClass& sc = size_classes_[size_class];
+  if (sc.partial.empty()) {
+    Slab* slab = sc.empty;
+    sc.empty = nullptr;
+    if (slab == nullptr) slab = NewSlab(size_class);
+    if (slab == nullptr) return nullptr;
+    sc.partial.push_back(slab);
+  }
+
+  Slab* slab = sc.partial.back();
+  void* block;
+  if (slab->free_list != nullptr) {
+    block = slab->free_list;
+    slab->free_list = *static_cast<void**>(block);
+  } else {
+    block = slab->base + slab->untouched * block_size;
+    slab->untouched++;
+  }
+  if (++slab->used == BlocksPerSlab(size_class)) sc.partial.pop_back();
+
+  requested_bytes_ += size;
+  used_bytes_ += block_size;
+  return block;
+}
+
+bool SlabAllocator::Free(void* data, size_t size) {
+  if (data == nullptr || size > kMaxSize) return false;
+  const uintptr_t address = reinterpret_cast<uintptr_t>(data);
+
+  Mutex::ScopedLock lock(mutex_);
+  auto it = slabs_.upper_bound(address);
+  if (it == slabs_.begin()) return false;
+  Slab* slab = std::prev(it)->second.get();
+  const uintptr_t base = reinterpret_cast<uintptr_t>(slab->base);
+  if (address >= base + kSlabSize) return false;
+
+  const size_t size_class = slab->size_class;
+  const size_t block_size = kBlockSizes[size_class];
+  CHECK_EQ((address - base) % block_size, 0);
+  CHECK_GT(slab->used, 0);
+
+  SizeClass& sc = size_classes_[size_class];
+  if (slab->used-- == BlocksPerSlab(size_class)) sc.partial.push_back(slab);
+  *static_cast<void**>(data) = slab->free_list;
+  slab->free_list = data;
+  requested_bytes_ -= std::min(size, requested_bytes_);
+  used_bytes_ -= block_size;
+
+  if (slab->used == 0) {
+    sc.partial.erase(std::find(sc.partial.begin(), sc.partial.end(), slab));
+    if (sc.empty == nullptr) {
+      // Start over with the blocks in order.
+      slab->free_list = nullptr;
+      slab->untouched = 0;
+      sc.empty = slab;
+    } else {
+      ReleaseSlab(slab);
+    }
+  }
+  return true;
+}
+
+void SlabAllocator::MemoryInfo(MemoryTracker* tracker) const {
+  Mutex::ScopedLock lock(mutex_);
+  size_t empty_bytes = 0;
+  for (const SizeClass& sc : size_classes_) {
+    if (sc.empty != nullptr) empty_bytes += kSlabSize;
+  }
+  const size_t slab_bytes = slabs_.size() * kSlabSize;
+  tracker->TrackFieldWithSize("free_blocks",
+                              slab_bytes - empty_bytes - used_bytes_);
+  tracker->TrackFieldWithSize("empty_slabs", empty_bytes);
+  tracker->TrackFieldWithSize("padding", used_bytes_ - requested_bytes_);
+}
+
+}  // namespace node
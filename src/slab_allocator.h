@@ -0,0 +1,103 @@
+#ifndef SRC_SLAB_ALLOCATOR_H_
+#define SRC_SLAB_ALLOCATOR_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "memory_tracker.h"
+#include "node_mutex.h"
+#include "v8-array-buffer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace node {
+
+// Serves the small backing stores of a NodeArrayBufferAllocator from slabs
+// of blocks of the same size, to avoid a round trip through malloc() for
+// each short-lived Buffer. Each NodeArrayBufferAllocator, and so each thread
+// that runs JavaScript, has its own slabs. The slabs are taken from the
+// allocator that backs the NodeArrayBufferAllocator, so that they are in the
+// V8 memory cage when there is one.
+//
+// A slab is given back as soon as its last block is freed, except for one
+// empty slab per size class that is kept for the next allocation.
+//
+// Backing stores can be freed on other threads than the one that allocated
+// them, for example by the V8 array buffer sweeper, so all of the state is
+// guarded by a mutex.
+class SlabAllocator final : public MemoryRetainer {
+ public:
+  // Larger allocations are not served from slabs.
+  static constexpr size_t kMaxSize = 2048;
+  // The size of the memory that is taken from the backing allocator at once.
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+  explicit SlabAllocator(v8::ArrayBuffer::Allocator* backing);
+  ~SlabAllocator() override;
+
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  // Returns uninitialized memory for at least |size| <= kMaxSize bytes, or
+  // nullptr if no new slab could be allocated.
+  void* Allocate(size_t size);
+  // Returns false, and does nothing, if |data| is not from Allocate().
+  bool Free(void* data, size_t size);
+
+  // Reports the memory of the slabs that is not used by backing stores:
+  // the blocks that are free, the kept empty slabs and the bytes of the
+  // blocks in use beyond the requested size.
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SlabAllocator)
+  SET_SELF_SIZE(SlabAllocator)
+
+ private:
+  static constexpr std::array<uint16_t, 14> kBlockSizes = {
+      16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048};
+
+  struct Slab {
+    char* base;
+    size_t size_class;
+    // The number of blocks that are in use.
+    size_t used = 0;
+    // Blocks at and after this index have never been used.
+    size_t untouched = 0;
+    // The blocks that were freed, linked through their first bytes.
+    void* free_list = nullptr;
+  };
+
+  struct SizeClass {
+    // The slabs with both free blocks and blocks in use.
+    std::vector<Slab*> partial;
+    // An empty slab that is kept for the next allocation.
+    Slab* empty = nullptr;
+  };
+
+  static size_t SizeClassOf(size_t size);
+  static size_t BlocksPerSlab(size_t size_class) {
+    return kSlabSize / kBlockSizes[size_class];
+  }
+
+  Slab* NewSlab(size_t size_class);
+  void ReleaseSlab(Slab* slab);
+
+  v8::ArrayBuffer::Allocator* const backing_;
+  mutable Mutex mutex_;
+  std::array<SizeClass, kBlockSizes.size()> size_classes_;
+  // All slabs, by the address of their memory.
+  std::map<uintptr_t, std::unique_ptr<Slab>> slabs_;
+  // The sum of the sizes that were requested for the blocks in use.
+  size_t requested_bytes_ = 0;
+  // The sum of the sizes of the blocks in use.
+  size_t used_bytes_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SLAB_ALLOCATOR_H_
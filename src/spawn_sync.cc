@@ -28,9 +28,16 @@
 #include "string_bytes.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstring>
 #include "nbytes.h"
 
+#ifdef __POSIX__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
 using v8::Array;
@@ -53,45 +60,141 @@ using v8::Object;
 using v8::String;
 using v8::Value;
 
-void SyncProcessOutputBuffer::OnAlloc(size_t suggested_size,
-                                      uv_buf_t* buf) const {
-  if (used() == kBufferSize)
-    *buf = uv_buf_init(nullptr, 0);
-  else
-    *buf = uv_buf_init(data_ + used(), available());
+#ifdef __POSIX__
+static size_t RoundUpToPageSize(size_t size) {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return (size + page_size - 1) & ~(page_size - 1);
 }
+#endif  // __POSIX__
 
 
-void SyncProcessOutputBuffer::OnRead(const uv_buf_t* buf, size_t nread) {
-  // If we hand out the same chunk twice, this should catch it.
-  CHECK_EQ(buf->base, data_ + used());
-  used_ += static_cast<unsigned int>(nread);
+SyncProcessOutputBuffer::~SyncProcessOutputBuffer() {
+  FreeData();
+}
+
+
+void SyncProcessOutputBuffer::Reserve(size_t size) {
+  if (size > capacity_) USE(Grow(size));
 }
 
 
-size_t SyncProcessOutputBuffer::Copy(char* dest) const {
-  if (dest != nullptr) memcpy(dest, data_, used());
-  return used();
+void SyncProcessOutputBuffer::OnAlloc(size_t suggested_size, uv_buf_t* buf) {
+  if (capacity_ - used_ < kMinReadSize &&
+      !Grow(std::max(capacity_ * 2, used_ + kMinReadSize))) {
+    // libuv reports UV_ENOBUFS to the read callback.
+    *buf = uv_buf_init(nullptr, 0);
+    return;
+  }
+  // Use unsigned int because that's what `uv_buf_init` takes.
+  const size_t available = std::min<size_t>(capacity_ - used_, UINT_MAX);
+  *buf = uv_buf_init(data_ + used_, static_cast<unsigned int>(available));
 }
 
 
-unsigned int SyncProcessOutputBuffer::available() const {
-  return sizeof data_ - used();
+void SyncProcessOutputBuffer::OnRead(const uv_buf_t* buf, size_t nread) {
+  // If we hand out the same chunk twice, this should catch it.
+  CHECK_EQ(buf->base, data_ + used_);
+  used_ += nread;
 }
 
 
-unsigned int SyncProcessOutputBuffer::used() const {
-  return used_;
+bool SyncProcessOutputBuffer::Grow(size_t capacity) {
+#ifdef __POSIX__
+  if (capacity >= kMmapThreshold) {
+    capacity = RoundUpToPageSize(capacity);
+    void* data;
+#ifdef __linux__
+    if (mapped_) {
+      data = mremap(data_, capacity_, capacity, MREMAP_MAYMOVE);
+      if (data == MAP_FAILED) return false;
+      data_ = static_cast<char*>(data);
+      capacity_ = capacity;
+      return true;
+    }
+#endif  // __linux__
+    data = mmap(nullptr,
+                capacity,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS,
+                -1,
+                0);
+    if (data == MAP_FAILED) return false;
+    if (used_ > 0) memcpy(data, data_, used_);
+    FreeData();
+    data_ = static_cast<char*>(data);
+    capacity_ = capacity;
+    mapped_ = true;
+    return true;
+  }
+#endif  // __POSIX__
+  char* data = UncheckedRealloc(data_, capacity);
+  if (data == nullptr) return false;
+  data_ = data;
+  capacity_ = capacity;
+  return true;
 }
 
 
-SyncProcessOutputBuffer* SyncProcessOutputBuffer::next() const {
-  return next_;
+void SyncProcessOutputBuffer::FreeData() {
+  if (mapped_) {
+#ifdef __POSIX__
+    munmap(data_, capacity_);
+#endif
+  } else {
+    free(data_);
+  }
+  data_ = nullptr;
+  capacity_ = 0;
+  mapped_ = false;
 }
 
 
-void SyncProcessOutputBuffer::set_next(SyncProcessOutputBuffer* next) {
-  next_ = next;
+MaybeLocal<Object> SyncProcessOutputBuffer::Release(Environment* env) {
+  auto reset = OnScopeLeave([&]() {
+    FreeData();
+    used_ = 0;
+  });
+
+  if (used_ == 0) return Buffer::New(env, 0);
+
+#ifdef V8_ENABLE_SANDBOX
+  // Memory that was not allocated by V8 cannot back an ArrayBuffer inside of
+  // the sandbox.
+  return Buffer::Copy(env, data_, used_);
+#else
+  const size_t length = used_;
+  char* data = data_;
+
+  if (mapped_) {
+#ifdef __POSIX__
+    // Give the slack at the end of the mapping back to the system.
+    const size_t mapped_length = RoundUpToPageSize(length);
+    if (mapped_length < capacity_) {
+      munmap(data + mapped_length, capacity_ - mapped_length);
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+    mapped_ = false;
+    return Buffer::New(
+        env,
+        data,
+        length,
+        [](char* mapping, void* hint) {
+          munmap(mapping, reinterpret_cast<size_t>(hint));
+        },
+        reinterpret_cast<void*>(mapped_length));
+#endif  // __POSIX__
+  }
+
+  if (length < capacity_) {
+    char* shrunk = UncheckedRealloc(data, length);
+    if (shrunk != nullptr) data = shrunk;
+  }
+  data_ = nullptr;
+  capacity_ = 0;
+  return Buffer::New(
+      env, data, length, [](char* ptr, void* hint) { free(ptr); }, nullptr);
+#endif  // V8_ENABLE_SANDBOX
 }
 
 
@@ -104,9 +207,6 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
       writable_(writable),
       input_buffer_(input_buffer),
 
-      first_output_buffer_(nullptr),
-      last_output_buffer_(nullptr),
-
       uv_pipe_(),
       write_req_(),
       shutdown_req_(),
@@ -118,14 +218,6 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
 
 SyncProcessStdioPipe::~SyncProcessStdioPipe() {
   CHECK(lifecycle_ == kUninitialized || lifecycle_ == kClosed);
-
-  SyncProcessOutputBuffer* buf;
-  SyncProcessOutputBuffer* next;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = next) {
-    next = buf->next();
-    delete buf;
-  }
 }
 
 
@@ -186,15 +278,13 @@ void SyncProcessStdioPipe::Close() {
   lifecycle_ = kClosing;
 }
 
-MaybeLocal<Object> SyncProcessStdioPipe::GetOutputAsBuffer(
-    Environment* env) const {
-  size_t length = OutputLength();
-  Local<Object> js_buffer;
-  if (!Buffer::New(env, length).ToLocal(&js_buffer)) {
-    return MaybeLocal<Object>();
-  }
-  CopyOutput(Buffer::Data(js_buffer));
-  return js_buffer;
+MaybeLocal<Object> SyncProcessStdioPipe::GetOutputAsBuffer(Environment* env) {
+  return output_buffer_.Release(env);
+}
+
+
+void SyncProcessStdioPipe::ReserveOutput(size_t size) {
+  output_buffer_.Reserve(size);
 }
 
 bool SyncProcessStdioPipe::readable() const {
@@ -236,45 +326,12 @@ uv_handle_t* SyncProcessStdioPipe::uv_handle() const {
 }
 
 
-size_t SyncProcessStdioPipe::OutputLength() const {
-  SyncProcessOutputBuffer* buf;
-  size_t size = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    size += buf->used();
-
-  return size;
-}
-
-
-void SyncProcessStdioPipe::CopyOutput(char* dest) const {
-  SyncProcessOutputBuffer* buf;
-  size_t offset = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    offset += buf->Copy(dest + offset);
-}
-
-
 void SyncProcessStdioPipe::OnAlloc(size_t suggested_size, uv_buf_t* buf) {
   // This function assumes that libuv will never allocate two buffers for the
   // same stream at the same time. There's an assert in
   // SyncProcessOutputBuffer::OnRead that would fail if this assumption was
   // ever violated.
-
-  if (last_output_buffer_ == nullptr) {
-    // Allocate the first capture buffer.
-    first_output_buffer_ = new SyncProcessOutputBuffer();
-    last_output_buffer_ = first_output_buffer_;
-
-  } else if (last_output_buffer_->available() == 0) {
-    // The current capture buffer is full so get us a new one.
-    SyncProcessOutputBuffer* buf = new SyncProcessOutputBuffer();
-    last_output_buffer_->set_next(buf);
-    last_output_buffer_ = buf;
-  }
-
-  last_output_buffer_->OnAlloc(suggested_size, buf);
+  output_buffer_.OnAlloc(suggested_size, buf);
 }
 
 
@@ -288,7 +345,7 @@ void SyncProcessStdioPipe::OnRead(const uv_buf_t* buf, ssize_t nread) {
     uv_read_stop(uv_stream());
 
   } else {
-    last_output_buffer_->OnRead(buf, nread);
+    output_buffer_.OnRead(buf, nread);
     process_handler_->IncrementBufferSizeAndCheckOverflow(nread);
   }
 }
@@ -390,6 +447,7 @@ void SyncProcessRunner::Spawn(const FunctionCallbackInfo<Value>& args) {
 
 SyncProcessRunner::SyncProcessRunner(Environment* env)
     : max_buffer_(0),
+      output_size_hint_(0),
       timeout_(0),
       kill_signal_(SIGTERM),
 
@@ -934,6 +992,26 @@ Maybe<int> SyncProcessRunner::ParseOptions(Local<Value> js_value) {
     }
   }
 
+  Local<Value> js_output_size_hint;
+  if (!js_options->Get(context, env()->output_size_hint_string())
+           .ToLocal(&js_output_size_hint)) {
+    return Nothing<int>();
+  }
+  if (!js_output_size_hint->IsNullOrUndefined()) {
+    if (!js_output_size_hint->IsNumber()) {
+      THROW_ERR_INVALID_ARG_TYPE(env(),
+                                 "options.outputSizeHint must be a number");
+      return Nothing<int>();
+    }
+    double hint;
+    if (!js_output_size_hint->NumberValue(context).To(&hint)) {
+      return Nothing<int>();
+    }
+    // There is no point in reserving more than maxBuffer allows.
+    if (max_buffer_ > 0) hint = std::min(hint, max_buffer_);
+    if (hint > 0) output_size_hint_ = static_cast<size_t>(hint);
+  }
+
   Local<Value> js_kill_signal;
   if (!js_options->Get(context, env()->kill_signal_string())
            .ToLocal(&js_kill_signal)) {
@@ -1087,6 +1165,10 @@ int SyncProcessRunner::AddStdioPipe(uint32_t child_fd,
     return r;
   }
 
+  if (child_fd == 1 && writable && output_size_hint_ > 0) {
+    h->ReserveOutput(output_size_hint_);
+  }
+
   uv_stdio_containers_[child_fd].flags = h->uv_flags();
   uv_stdio_containers_[child_fd].data.stream = h->uv_stream();
 
@@ -36,29 +36,39 @@ class SyncProcessStdioPipe;
 class SyncProcessRunner;
 
 
+// Collects the output of a pipe in a single growable allocation, which then
+// becomes the backing store of the Buffer that is returned to JavaScript
+// without being copied. Outputs that grow beyond kMmapThreshold are moved to
+// an anonymous mapping, which is grown with mremap() on Linux and returned to
+// the system as soon as the Buffer is collected.
 class SyncProcessOutputBuffer {
-  static const unsigned int kBufferSize = 65536;
+  static constexpr size_t kMinReadSize = 65536;
+  static constexpr size_t kMmapThreshold = 16 * 1024 * 1024;
 
  public:
-  inline SyncProcessOutputBuffer() = default;
+  SyncProcessOutputBuffer() = default;
+  ~SyncProcessOutputBuffer();
+  SyncProcessOutputBuffer(const SyncProcessOutputBuffer&) = delete;
+  SyncProcessOutputBuffer& operator=(const SyncProcessOutputBuffer&) = delete;
 
-  inline void OnAlloc(size_t suggested_size, uv_buf_t* buf) const;
-  inline void OnRead(const uv_buf_t* buf, size_t nread);
-
-  inline size_t Copy(char* dest) const;
+  // Makes room for `size` bytes of output up front. Failures are ignored,
+  // the buffer is grown while reading instead.
+  void Reserve(size_t size);
 
-  inline unsigned int available() const;
-  inline unsigned int used() const;
+  inline void OnAlloc(size_t suggested_size, uv_buf_t* buf);
+  inline void OnRead(const uv_buf_t* buf, size_t nread);
 
-  inline SyncProcessOutputBuffer* next() const;
-  inline void set_next(SyncProcessOutputBuffer* next);
+  // Transfers the output to a new Buffer and leaves this buffer empty.
+  v8::MaybeLocal<v8::Object> Release(Environment* env);
 
  private:
-  // Use unsigned int because that's what `uv_buf_init` takes.
-  mutable char data_[kBufferSize];
-  unsigned int used_ = 0;
+  bool Grow(size_t capacity);
+  void FreeData();
 
-  SyncProcessOutputBuffer* next_ = nullptr;
+  char* data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+  bool mapped_ = false;
 };
 
 
@@ -82,7 +92,8 @@ class SyncProcessStdioPipe {
   int Start();
   void Close();
 
-  v8::MaybeLocal<v8::Object> GetOutputAsBuffer(Environment* env) const;
+  v8::MaybeLocal<v8::Object> GetOutputAsBuffer(Environment* env);
+  inline void ReserveOutput(size_t size);
 
   inline bool readable() const;
   inline bool writable() const;
@@ -93,9 +104,6 @@ class SyncProcessStdioPipe {
   inline uv_handle_t* uv_handle() const;
 
  private:
-  inline size_t OutputLength() const;
-  inline void CopyOutput(char* dest) const;
-
   inline void OnAlloc(size_t suggested_size, uv_buf_t* buf);
   inline void OnRead(const uv_buf_t* buf, ssize_t nread);
   inline void OnWriteDone(int result);
@@ -120,8 +128,7 @@ class SyncProcessStdioPipe {
   bool writable_;
   uv_buf_t input_buffer_;
 
-  SyncProcessOutputBuffer* first_output_buffer_;
-  SyncProcessOutputBuffer* last_output_buffer_;
+  SyncProcessOutputBuffer output_buffer_;
 
   mutable uv_pipe_t uv_pipe_;
   uv_write_t write_req_;
@@ -199,6 +206,7 @@ class SyncProcessRunner {
   static void KillTimerCloseCallback(uv_handle_t* handle);
 
   double max_buffer_;
+  size_t output_size_hint_;
   uint64_t timeout_;
   int kill_signal_;
 
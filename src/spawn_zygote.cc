@@ -0,0 +1,807 @@
+#include "spawn_zygote.h"
+
+#include "env-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <grp.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern char** environ;
+#endif  // __linux__
+
+namespace node {
+namespace spawn_zygote {
+
+#ifdef __linux__
+
+namespace {
+
+// Requests that are larger than this, usually because of a very large
+// environment, are spawned with uv_spawn() instead.
+constexpr size_t kMaxRequestSize = 128 * 1024;
+constexpr uint32_t kMaxStdioCount = 64;
+constexpr uint32_t kInheritEnvironment = UINT32_MAX;
+
+// A spawn request is a single SOCK_SEQPACKET message that starts with a
+// RequestHeader, followed by `stdio_count` int32_t indices into the file
+// descriptors sent along with the message (-1 for UV_IGNORE), followed by the
+// NUL-terminated file, absolute cwd, arguments and environment. The cwd and
+// the umask are those of the process at the time of the request, not those
+// that the zygote inherited at startup.
+struct RequestHeader {
+  uint32_t flags;
+  uint32_t uid;
+  uint32_t gid;
+  uint32_t umask;
+  uint32_t stdio_count;
+  uint32_t argc;
+  uint32_t envc;  // kInheritEnvironment if options.env is unset.
+};
+
+struct Reply {
+  int32_t err;
+  int32_t pid;
+};
+
+struct ExitEvent {
+  int32_t pid;
+  int32_t term_signal;
+  int64_t exit_status;
+};
+
+struct PendingChild {
+  ExitCallback exit_cb;
+  void* data;
+};
+
+// The user and group ids of a process.
+struct Credentials {
+  uid_t uid = 0;
+  uid_t euid = 0;
+  uid_t suid = 0;
+  gid_t gid = 0;
+  gid_t egid = 0;
+  gid_t sgid = 0;
+  std::vector<gid_t> groups;
+
+  bool operator==(const Credentials& other) const {
+    return uid == other.uid && euid == other.euid && suid == other.suid &&
+           gid == other.gid && egid == other.egid && sgid == other.sgid &&
+           groups == other.groups;
+  }
+};
+
+bool GetCredentials(Credentials* creds) {
+  if (getresuid(&creds->uid, &creds->euid, &creds->suid) != 0 ||
+      getresgid(&creds->gid, &creds->egid, &creds->sgid) != 0) {
+    return false;
+  }
+  const int count = getgroups(0, nullptr);
+  if (count < 0) return false;
+  creds->groups.resize(count);
+  if (getgroups(count, creds->groups.data()) != count) return false;
+  return true;
+}
+
+// State of the process that started the zygote. Only accessed on the thread
+// of `zygote_env`, except for `zygote_credentials`, which is set before any
+// other thread is started.
+int request_fd = -1;
+int event_fd = -1;
+Environment* zygote_env = nullptr;
+uv_poll_t* event_poll = nullptr;
+std::unordered_map<int, PendingChild> pending_children;
+// The ids that the zygote, and thus its children, run with.
+Credentials zygote_credentials;
+
+// State of the zygote.
+int sigchld_pipe[2] = {-1, -1};
+
+void OnSigchld(int signo) {
+  const int saved_errno = errno;
+  const char c = 0;
+  USE(write(sigchld_pipe[1], &c, 1));
+  errno = saved_errno;
+}
+
+[[noreturn]] void WriteErrorAndExit(int error_fd, int err) {
+  ssize_t n;
+  do {
+    n = write(error_fd, &err, sizeof(err));
+  } while (n == -1 && errno == EINTR);
+  _exit(127);
+}
+
+// libuv error codes are negated errno values on Linux.
+[[noreturn]] void WriteErrnoAndExit(int error_fd) {
+  WriteErrorAndExit(error_fd, -errno);
+}
+
+// Runs in the forked child of the zygote. This mirrors
+// uv__process_child_init() so that children behave the same no matter how
+// they were spawned.
+[[noreturn]] void InitChild(const RequestHeader& header,
+                            const char* file,
+                            const char* cwd,
+                            char** args,
+                            char** env,
+                            int* stdio,
+                            int error_fd) {
+  const int stdio_count = static_cast<int>(header.stdio_count);
+
+  for (int n = 1; n < 32; n++) {
+    if (n == SIGKILL || n == SIGSTOP) continue;
+    if (signal(n, SIG_DFL) == SIG_ERR) WriteErrnoAndExit(error_fd);
+  }
+
+  if (header.flags & UV_PROCESS_DETACHED) setsid();
+
+  if (error_fd < stdio_count) {
+    error_fd = fcntl(error_fd, F_DUPFD_CLOEXEC, stdio_count);
+    if (error_fd == -1) _exit(127);
+  }
+
+  // Move the file descriptors that would be overwritten by the dup2() calls
+  // below out of the way first, see uv__process_child_init().
+  for (int fd = 0; fd < stdio_count; fd++) {
+    if (stdio[fd] < 0 || stdio[fd] >= fd) continue;
+    stdio[fd] = fcntl(stdio[fd], F_DUPFD_CLOEXEC, stdio_count);
+    if (stdio[fd] == -1) WriteErrnoAndExit(error_fd);
+  }
+
+  for (int fd = 0; fd < stdio_count; fd++) {
+    int use_fd = stdio[fd];
+    int close_fd = -1;
+
+    if (use_fd < 0) {
+      if (fd >= 3) continue;
+      // Redirect stdin, stdout and stderr to /dev/null even if UV_IGNORE is
+      // set.
+      close(fd);
+      use_fd = open("/dev/null", fd == 0 ? O_RDONLY : O_RDWR);
+      close_fd = use_fd;
+      if (use_fd < 0) WriteErrnoAndExit(error_fd);
+    }
+
+    if (fd == use_fd) {
+      if (close_fd == -1 && fcntl(fd, F_SETFD, 0) == -1) {
+        WriteErrnoAndExit(error_fd);
+      }
+    } else if (dup2(use_fd, fd) == -1) {
+      WriteErrnoAndExit(error_fd);
+    }
+
+    if (fd <= 2 && close_fd == -1) {
+      const int flags = fcntl(fd, F_GETFL);
+      if (flags != -1 && (flags & O_NONBLOCK)) {
+        fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+      }
+    }
+
+    if (close_fd >= stdio_count) close(close_fd);
+  }
+
+  umask(static_cast<mode_t>(header.umask));
+
+  if (chdir(cwd) != 0) WriteErrnoAndExit(error_fd);
+
+  if (header.flags & (UV_PROCESS_SETUID | UV_PROCESS_SETGID)) {
+    // Optimistically drop the supplementary groups, like libuv does. This
+    // fails unless the zygote runs as root, which is fine.
+    USE(setgroups(0, nullptr));
+  }
+
+  if ((header.flags & UV_PROCESS_SETGID) && setgid(header.gid) != 0) {
+    WriteErrnoAndExit(error_fd);
+  }
+
+  if ((header.flags & UV_PROCESS_SETUID) && setuid(header.uid) != 0) {
+    WriteErrnoAndExit(error_fd);
+  }
+
+  if (env != nullptr) environ = env;
+
+  sigset_t set;
+  sigemptyset(&set);
+  if (sigprocmask(SIG_SETMASK, &set, nullptr) != 0) abort();
+
+  execvp(file, args);
+  WriteErrnoAndExit(error_fd);
+}
+
+// Reads the next NUL-terminated string from [*pos, end), or returns nullptr
+// if the request is malformed.
+char* NextString(char** pos, char* end) {
+  char* str = *pos;
+  char* nul = static_cast<char*>(memchr(str, '\0', end - str));
+  if (nul == nullptr) return nullptr;
+  *pos = nul + 1;
+  return str;
+}
+
+// Spawns the child described by the request in `data` and returns 0 or a
+// libuv error code.
+int SpawnChild(char* data, size_t size, int* fds, size_t fd_count, int* pid) {
+  RequestHeader header;
+  if (size < sizeof(header)) return UV_EINVAL;
+  memcpy(&header, data, sizeof(header));
+  if (header.stdio_count > kMaxStdioCount) return UV_EINVAL;
+
+  char* pos = data + sizeof(header);
+  char* end = data + size;
+  int stdio[kMaxStdioCount];
+  if (static_cast<size_t>(end - pos) < header.stdio_count * sizeof(int32_t)) {
+    return UV_EINVAL;
+  }
+  for (uint32_t i = 0; i < header.stdio_count; i++) {
+    int32_t index;
+    memcpy(&index, pos, sizeof(index));
+    pos += sizeof(index);
+    if (index >= 0 && static_cast<size_t>(index) >= fd_count) return UV_EINVAL;
+    stdio[i] = index < 0 ? -1 : fds[index];
+  }
+
+  char* file = NextString(&pos, end);
+  char* cwd = NextString(&pos, end);
+  if (file == nullptr || cwd == nullptr) return UV_EINVAL;
+
+  std::vector<char*> args;
+  for (uint32_t i = 0; i < header.argc; i++) {
+    char* arg = NextString(&pos, end);
+    if (arg == nullptr) return UV_EINVAL;
+    args.push_back(arg);
+  }
+  args.push_back(nullptr);
+
+  std::vector<char*> env;
+  if (header.envc != kInheritEnvironment) {
+    for (uint32_t i = 0; i < header.envc; i++) {
+      char* pair = NextString(&pos, end);
+      if (pair == nullptr) return UV_EINVAL;
+      env.push_back(pair);
+    }
+    env.push_back(nullptr);
+  }
+
+  int error_pipe[2];
+  if (pipe2(error_pipe, O_CLOEXEC) != 0) return -errno;
+
+  const pid_t child = fork();
+  if (child == -1) {
+    const int err = -errno;
+    close(error_pipe[0]);
+    close(error_pipe[1]);
+    return err;
+  }
+
+  if (child == 0) {
+    close(error_pipe[0]);
+    InitChild(header,
+              file,
+              cwd,
+              args.data(),
+              env.empty() ? nullptr : env.data(),
+              stdio,
+              error_pipe[1]);
+  }
+
+  close(error_pipe[1]);
+  int exec_error;
+  ssize_t n;
+  do {
+    n = read(error_pipe[0], &exec_error, sizeof(exec_error));
+  } while (n == -1 && errno == EINTR);
+  close(error_pipe[0]);
+
+  if (n == sizeof(exec_error)) {
+    // The child failed before or in execvp(), reap it right away so that its
+    // exit is not reported.
+    pid_t r;
+    do {
+      r = waitpid(child, nullptr, 0);
+    } while (r == -1 && errno == EINTR);
+    return exec_error;
+  }
+
+  *pid = child;
+  return 0;
+}
+
+// Handles the next request on `fd`. Returns false when the process that
+// started the zygote has gone away.
+bool HandleRequest(int fd, std::vector<char>* buffer) {
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxStdioCount)];
+  iovec iov = {buffer->data(), buffer->size()};
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t n;
+  do {
+    n = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+  } while (n == -1 && errno == EINTR);
+  if (n <= 0) return false;
+
+  int fds[kMaxStdioCount];
+  size_t fd_count = 0;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count && fd_count < kMaxStdioCount; i++) {
+      memcpy(&fds[fd_count++], CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+    }
+  }
+
+  Reply reply = {0, 0};
+  int pid = 0;
+  if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) {
+    reply.err = UV_E2BIG;
+  } else {
+    reply.err = SpawnChild(buffer->data(), n, fds, fd_count, &pid);
+    reply.pid = pid;
+  }
+
+  for (size_t i = 0; i < fd_count; i++) close(fds[i]);
+
+  do {
+    n = send(fd, &reply, sizeof(reply), MSG_NOSIGNAL);
+  } while (n == -1 && errno == EINTR);
+  return n == sizeof(reply);
+}
+
+void ReapChildren(std::deque<ExitEvent>* events) {
+  int status;
+  pid_t pid;
+  while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+    ExitEvent event = {pid, 0, 0};
+    if (WIFEXITED(status)) event.exit_status = WEXITSTATUS(status);
+    if (WIFSIGNALED(status)) event.term_signal = WTERMSIG(status);
+    events->push_back(event);
+  }
+}
+
+// Sends as many queued exit events as the socket accepts without blocking, so
+// that the zygote keeps handling requests while the process is busy.
+void SendEvents(int fd, std::deque<ExitEvent>* events) {
+  while (!events->empty()) {
+    const ssize_t n = send(fd,
+                           &events->front(),
+                           sizeof(ExitEvent),
+                           MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      // The process is gone if this is not EAGAIN, which shows up as EOF on
+      // the request socket next.
+      if (errno != EAGAIN && errno != EWOULDBLOCK) events->clear();
+      return;
+    }
+    events->pop_front();
+  }
+}
+
+[[noreturn]] void RunZygote(int request_fd, int event_fd) {
+  for (int n = 1; n < 32; n++) {
+    if (n == SIGKILL || n == SIGSTOP) continue;
+    signal(n, SIG_DFL);
+  }
+  // Signals from the terminal are meant for the process, which may handle
+  // them. The zygote exits when the process does.
+  signal(SIGHUP, SIG_IGN);
+  signal(SIGINT, SIG_IGN);
+  signal(SIGQUIT, SIG_IGN);
+
+  sigset_t set;
+  sigemptyset(&set);
+  sigprocmask(SIG_SETMASK, &set, nullptr);
+
+  if (pipe2(sigchld_pipe, O_CLOEXEC | O_NONBLOCK) != 0) _exit(1);
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = OnSigchld;
+  sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+  if (sigaction(SIGCHLD, &sa, nullptr) != 0) _exit(1);
+
+  std::vector<char> buffer(kMaxRequestSize);
+  std::deque<ExitEvent> events;
+  for (;;) {
+    pollfd fds[] = {
+        {request_fd, POLLIN, 0},
+        {sigchld_pipe[0], POLLIN, 0},
+        {event_fd, 0, 0},
+    };
+    if (!events.empty()) fds[2].events = POLLOUT;
+    if (poll(fds, arraysize(fds), -1) == -1) {
+      if (errno == EINTR) continue;
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      char buf[64];
+      while (read(sigchld_pipe[0], buf, sizeof(buf)) > 0) {
+      }
+      ReapChildren(&events);
+    }
+    SendEvents(event_fd, &events);
+
+    if (fds[0].revents != 0 && !HandleRequest(request_fd, &buffer)) break;
+  }
+  _exit(0);
+}
+
+void ClosePoll() {
+  if (event_poll == nullptr) return;
+  uv_close(reinterpret_cast<uv_handle_t*>(event_poll), [](uv_handle_t* handle) {
+    delete reinterpret_cast<uv_poll_t*>(handle);
+  });
+  event_poll = nullptr;
+}
+
+// Stops using the zygote. Closing the request socket makes it exit.
+void Shutdown(void* unused = nullptr) {
+  ClosePoll();
+  if (request_fd != -1) {
+    close(request_fd);
+    request_fd = -1;
+  }
+  if (event_fd != -1) {
+    close(event_fd);
+    event_fd = -1;
+  }
+}
+
+void OnZygoteLost() {
+  zygote_env->RemoveCleanupHook(Shutdown, nullptr);
+  Shutdown();
+  // The children keep running, but their exit status can no longer be
+  // observed.
+  std::unordered_map<int, PendingChild> children;
+  children.swap(pending_children);
+  for (const auto& [pid, child] : children) {
+    child.exit_cb(child.data, UV_EPIPE, 0);
+  }
+}
+
+void OnEvent(uv_poll_t* handle, int status, int events) {
+  while (event_fd != -1) {
+    ExitEvent event;
+    const ssize_t n = recv(event_fd, &event, sizeof(event), 0);
+    if (n == -1 && errno == EINTR) continue;
+    if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+    if (n != sizeof(event)) {
+      OnZygoteLost();
+      return;
+    }
+
+    auto it = pending_children.find(event.pid);
+    if (it == pending_children.end()) continue;
+    const PendingChild child = it->second;
+    pending_children.erase(it);
+    child.exit_cb(child.data, event.exit_status, event.term_signal);
+  }
+}
+
+// The exit events are read on the event loop of the first Environment that
+// spawns through the zygote, which has to be the main thread.
+bool StartEventPoll(Environment* env) {
+  if (zygote_env != nullptr) return zygote_env == env && event_poll != nullptr;
+  if (!env->is_main_thread()) return false;
+  zygote_env = env;
+
+  event_poll = new uv_poll_t;
+  if (uv_poll_init(env->event_loop(), event_poll, event_fd) != 0) {
+    delete event_poll;
+    event_poll = nullptr;
+    Shutdown();
+    return false;
+  }
+  CHECK_EQ(uv_poll_start(event_poll, UV_READABLE, OnEvent), 0);
+  // Each child keeps the loop alive through its own handle.
+  uv_unref(reinterpret_cast<uv_handle_t*>(event_poll));
+  env->AddCleanupHook(Shutdown, nullptr);
+  return true;
+}
+
+// Appends the request for `options`, minus the stdio indices, to `strings`.
+// Returns false if the request would be too large.
+bool SerializeStrings(const uv_process_options_t* options,
+                      std::string* strings,
+                      RequestHeader* header) {
+  auto append = [&](const char* str) {
+    strings->append(str);
+    strings->push_back('\0');
+    return strings->size() <= kMaxRequestSize;
+  };
+
+  if (!append(options->file)) return false;
+
+  // The zygote has a working directory of its own, so resolve the cwd, or
+  // the lack of one, against the current working directory of the process.
+  // If that has been removed, let uv_spawn() handle it.
+  if (options->cwd != nullptr && options->cwd[0] == '/') {
+    if (!append(options->cwd)) return false;
+  } else {
+    char buf[PATH_MAX];
+    size_t size = sizeof(buf);
+    if (uv_cwd(buf, &size) != 0) return false;
+    std::string cwd(buf, size);
+    if (options->cwd != nullptr) {
+      cwd += '/';
+      cwd += options->cwd;
+    }
+    if (!append(cwd.c_str())) return false;
+  }
+
+  header->argc = 0;
+  for (char** arg = options->args; arg != nullptr && *arg != nullptr; arg++) {
+    if (!append(*arg)) return false;
+    header->argc++;
+  }
+
+  header->envc = kInheritEnvironment;
+  if (options->env != nullptr) {
+    header->envc = 0;
+    for (char** pair = options->env; *pair != nullptr; pair++) {
+      if (!append(*pair)) return false;
+      header->envc++;
+    }
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+void Start() {
+  int request_fds[2];
+  int event_fds[2];
+  if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, request_fds)) {
+    return;
+  }
+  if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, event_fds)) {
+    close(request_fds[0]);
+    close(request_fds[1]);
+    return;
+  }
+
+  Credentials credentials;
+  if (!GetCredentials(&credentials)) {
+    for (int fd : {request_fds[0], request_fds[1], event_fds[0], event_fds[1]})
+      close(fd);
+    return;
+  }
+
+  const pid_t pid = fork();
+  if (pid == 0) {
+    close(request_fds[0]);
+    close(event_fds[0]);
+    RunZygote(request_fds[1], event_fds[1]);
+  }
+
+  close(request_fds[1]);
+  close(event_fds[1]);
+  if (pid == -1) {
+    // Spawn child processes as usual.
+    close(request_fds[0]);
+    close(event_fds[0]);
+    return;
+  }
+  request_fd = request_fds[0];
+  event_fd = event_fds[0];
+  zygote_credentials = std::move(credentials);
+}
+
+bool Spawn(Environment* env,
+           const uv_process_options_t* options,
+           ExitCallback exit_cb,
+           void* data,
+           int* pid,
+           int* err) {
+  if (request_fd == -1 || options->stdio_count < 0 ||
+      static_cast<uint32_t>(options->stdio_count) > kMaxStdioCount ||
+      !StartEventPoll(env)) {
+    return false;
+  }
+
+  // The zygote cannot give up or regain privileges on behalf of the process,
+  // so spawn with uv_spawn() once process.setuid() and friends have been
+  // called.
+  Credentials credentials;
+  if (!GetCredentials(&credentials) || !(credentials == zygote_credentials)) {
+    return false;
+  }
+
+  RequestHeader header;
+  memset(&header, 0, sizeof(header));
+  std::string strings;
+  if (!SerializeStrings(options, &strings, &header)) return false;
+  header.flags = options->flags;
+  header.uid = options->uid;
+  header.gid = options->gid;
+  {
+    Mutex::ScopedLock lock(per_process::umask_mutex);
+    const mode_t mask = umask(0);
+    umask(mask);
+    header.umask = mask;
+  }
+  header.stdio_count = options->stdio_count;
+
+  std::vector<int32_t> indices;
+  std::vector<int> fds;
+  // The two ends of the socket pairs created for UV_CREATE_PIPE.
+  std::vector<std::pair<uv_pipe_t*, int>> parent_ends;
+  std::vector<int> child_ends;
+  auto close_pipes = OnScopeLeave([&]() {
+    for (const auto& [pipe, fd] : parent_ends) {
+      if (fd >= 0) close(fd);
+    }
+    for (int fd : child_ends) close(fd);
+  });
+
+  *err = 0;
+  for (int i = 0; i < options->stdio_count; i++) {
+    const uv_stdio_container_t& container = options->stdio[i];
+    int fd = -1;
+    switch (container.flags & (UV_IGNORE | UV_CREATE_PIPE | UV_INHERIT_FD |
+                               UV_INHERIT_STREAM)) {
+      case UV_IGNORE:
+        break;
+      case UV_CREATE_PIPE: {
+        if (container.data.stream->type != UV_NAMED_PIPE) {
+          *err = UV_EINVAL;
+          return true;
+        }
+        uv_file pair[2];
+        *err = uv_socketpair(SOCK_STREAM, 0, pair, 0, 0);
+        if (*err != 0) return true;
+        int size = 64 * 1024;
+        for (int end : pair) {
+          setsockopt(end, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+          setsockopt(end, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        }
+        parent_ends.emplace_back(
+            reinterpret_cast<uv_pipe_t*>(container.data.stream), pair[0]);
+        child_ends.push_back(pair[1]);
+        fd = pair[1];
+        break;
+      }
+      case UV_INHERIT_FD:
+        fd = container.data.fd;
+        break;
+      case UV_INHERIT_STREAM: {
+        uv_os_fd_t stream_fd;
+        if (uv_fileno(reinterpret_cast<uv_handle_t*>(container.data.stream),
+                      &stream_fd) != 0) {
+          stream_fd = -1;
+        }
+        fd = stream_fd;
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+    if ((container.flags & (UV_INHERIT_FD | UV_INHERIT_STREAM)) && fd < 0) {
+      *err = UV_EINVAL;
+      return true;
+    }
+    indices.push_back(fd < 0 ? -1 : static_cast<int32_t>(fds.size()));
+    if (fd >= 0) fds.push_back(fd);
+  }
+
+  std::string request(reinterpret_cast<const char*>(&header), sizeof(header));
+  request.append(reinterpret_cast<const char*>(indices.data()),
+                 indices.size() * sizeof(int32_t));
+  request.append(strings);
+  if (request.size() > kMaxRequestSize) return false;
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxStdioCount)];
+  iovec iov = {request.data(), request.size()};
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  if (!fds.empty()) {
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+  }
+
+  ssize_t n;
+  do {
+    n = sendmsg(request_fd, &msg, MSG_NOSIGNAL);
+  } while (n == -1 && errno == EINTR);
+  if (n == -1) {
+    // EMSGSIZE and ENOBUFS only affect this request. Anything else means that
+    // the zygote is gone, which the event socket reports as well.
+    if (errno != EMSGSIZE && errno != ENOBUFS) {
+      close(request_fd);
+      request_fd = -1;
+    }
+    return false;
+  }
+
+  Reply reply;
+  do {
+    n = recv(request_fd, &reply, sizeof(reply), 0);
+  } while (n == -1 && errno == EINTR);
+  if (n != sizeof(reply)) {
+    close(request_fd);
+    request_fd = -1;
+    *err = UV_EPIPE;
+    return true;
+  }
+
+  *err = reply.err;
+  if (*err != 0) return true;
+
+  for (auto& [pipe, fd] : parent_ends) {
+    const int r = uv_pipe_open(pipe, fd);
+    if (r != 0) {
+      // Like uv_spawn(), fail if the parent end of a pipe cannot be opened,
+      // but do not leave the child running.
+      if (*err == 0) *err = r;
+      continue;
+    }
+    // The pipe owns the file descriptor now.
+    fd = -1;
+  }
+
+  if (*err != 0) {
+    uv_kill(reply.pid, SIGKILL);
+    return true;
+  }
+
+  pending_children[reply.pid] = PendingChild{exit_cb, data};
+  *pid = reply.pid;
+  return true;
+}
+
+void Forget(int pid) {
+  pending_children.erase(pid);
+}
+
+#else  // !__linux__
+
+void Start() {}
+
+bool Spawn(Environment* env,
+           const uv_process_options_t* options,
+           ExitCallback exit_cb,
+           void* data,
+           int* pid,
+           int* err) {
+  return false;
+}
+
+void Forget(int pid) {}
+
+#endif  // __linux__
+
+}  // namespace spawn_zygote
+}  // namespace node
@@ -0,0 +1,54 @@
+#ifndef SRC_SPAWN_ZYGOTE_H_
+#define SRC_SPAWN_ZYGOTE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdint>
+#include "uv.h"
+
+namespace node {
+
+class Environment;
+
+// The spawn zygote is a small helper process that is forked during process
+// initialization, before the heap and the thread pools exist, and that forks
+// and executes child processes on behalf of the main thread. fork() has to
+// copy the page tables of the forking process, which takes milliseconds once
+// the process has grown to a few GiB; the zygote stays small, so spawning
+// through it costs the same no matter how large Node.js grows.
+//
+// The zygote is enabled by --experimental-spawn-zygote and only available on
+// Linux. The children are children of the zygote, which reports their exit
+// back to the process.
+namespace spawn_zygote {
+
+using ExitCallback = void (*)(void* data, int64_t exit_status, int term_signal);
+
+// Forks the zygote. Must be called before any other thread is started.
+void Start();
+
+// Spawns a child process as described by `options` through the zygote, on
+// behalf of `env`. Returns false if the zygote cannot handle the request, in
+// which case the caller should fall back to uv_spawn(). Otherwise, stores the
+// result of the spawn in `*err`, and on success stores the pid of the child
+// in `*pid` and arranges for `exit_cb(data, ...)` to be called when the child
+// exits. If the zygote itself goes away first, `exit_cb` is called with
+// UV_EPIPE as the exit status. UV_CREATE_PIPE streams are opened with
+// uv_pipe_open().
+bool Spawn(Environment* env,
+           const uv_process_options_t* options,
+           ExitCallback exit_cb,
+           void* data,
+           int* pid,
+           int* err);
+
+// Stops tracking the child `pid`, e.g. because its handle has been closed
+// before the child exited.
+void Forget(int pid);
+
+}  // namespace spawn_zygote
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SPAWN_ZYGOTE_H_
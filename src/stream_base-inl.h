@@ -79,6 +79,15 @@ void StreamResource::EmitRead(ssize_t nread, const uv_buf_t& buf) {
   listener_->OnStreamRead(nread, buf);
 }
 
+bool StreamResource::EmitReadOwned(std::unique_ptr<char[]>* data,
+                                   size_t nread) {
+  DebugSealHandleScope seal_handle_scope;
+  if (!listener_->OnStreamReadOwned(data, nread))
+    return false;
+  bytes_read_ += static_cast<uint64_t>(nread);
+  return true;
+}
+
 void StreamResource::EmitAfterWrite(WriteWrap* w, int status) {
   DebugSealHandleScope seal_handle_scope;
   listener_->OnStreamAfterWrite(w, status);
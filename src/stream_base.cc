@@ -8,6 +8,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "simdutf.h"
 #include "string_bytes.h"
 #include "util-inl.h"
 #include "v8.h"
@@ -18,6 +19,7 @@ namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
 using v8::BackingStore;
 using v8::BackingStoreInitializationMode;
 using v8::ConstructorBehavior;
@@ -165,6 +167,15 @@ int StreamBase::UseUserBuffer(const FunctionCallbackInfo<Value>& args) {
   return 0;
 }
 
+int StreamBase::ReadInto(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsArrayBufferView());
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  CHECK_GT(view->ByteLength(), 0);
+
+  PushStreamListener(new ReadIntoJSListener(stream_env()->isolate(), view));
+  return 0;
+}
+
 int StreamBase::Shutdown(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   Local<Object> req_wrap_obj = args[0].As<Object>();
@@ -177,6 +188,42 @@ void StreamBase::SetWriteResult(const StreamWriteResult& res) {
   env_->stream_base_state()[kLastWriteWasAsync] = res.async;
 }
 
+// If the bytes of `string` in `encoding` are exactly the contents of an
+// external string, points `buf` at them and returns true. External string
+// data never moves and lives as long as the string, which the JS side keeps
+// alive in `req._chunks` until the write has finished, so it can be written
+// without copying. Heap strings may be moved by the GC and are always
+// copied.
+static bool GetExternalStringData(Local<String> string,
+                                  enum encoding encoding,
+                                  uv_buf_t* buf) {
+  if (string->IsExternalOneByte()) {
+    const String::ExternalOneByteStringResource* resource =
+        string->GetExternalOneByteStringResource();
+    const char* data = resource->data();
+    const size_t length = resource->length();
+    // UTF-8 encodes one-byte strings as-is only if they are pure ASCII.
+    if (encoding == LATIN1 || encoding == ASCII ||
+        (encoding == UTF8 && simdutf::validate_ascii(data, length))) {
+      *buf = uv_buf_init(const_cast<char*>(data), length);
+      return true;
+    }
+    return false;
+  }
+
+  if constexpr (IsLittleEndian()) {
+    if (encoding == UCS2 && string->IsExternalTwoByte()) {
+      const String::ExternalStringResource* resource =
+          string->GetExternalStringResource();
+      *buf = uv_buf_init(
+          reinterpret_cast<char*>(const_cast<uint16_t*>(resource->data())),
+          resource->length() * sizeof(uint16_t));
+      return true;
+    }
+  }
+  return false;
+}
+
 int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -196,6 +243,8 @@ int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
     count = chunks->Length() >> 1;
 
   MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  // Whether bufs[i] already points into an external string.
+  MaybeStackBuffer<bool, 16> is_external(all_buffers ? 0 : count);
 
   size_t storage_size = 0;
   size_t offset;
@@ -219,6 +268,9 @@ int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
       if (!chunks->Get(context, i * 2 + 1).ToLocal(&next_chunk))
         return -1;
       enum encoding encoding = ParseEncoding(isolate, next_chunk);
+      is_external[i] = GetExternalStringData(string, encoding, &bufs[i]);
+      if (is_external[i])
+        continue;
       size_t chunk_size;
       if ((encoding == UTF8 &&
              string->Length() > 65535 &&
@@ -262,6 +314,10 @@ int StreamBase::Writev(const FunctionCallbackInfo<Value>& args) {
         continue;
       }
 
+      // External string, already set up in the first pass
+      if (is_external[i])
+        continue;
+
       // Write string
       CHECK_LE(offset, storage_size);
       char* str_storage =
@@ -569,6 +625,7 @@ void StreamBase::AddMethods(IsolateData* isolate_data,
   SetProtoMethod(isolate, t, "shutdown", JSMethod<&StreamBase::Shutdown>);
   SetProtoMethod(
       isolate, t, "useUserBuffer", JSMethod<&StreamBase::UseUserBuffer>);
+  SetProtoMethod(isolate, t, "readInto", JSMethod<&StreamBase::ReadInto>);
   SetProtoMethod(isolate, t, "writev", JSMethod<&StreamBase::Writev>);
   SetProtoMethod(isolate, t, "writeBuffer", JSMethod<&StreamBase::WriteBuffer>);
   SetProtoMethod(isolate,
@@ -609,6 +666,7 @@ void StreamBase::RegisterExternalReferences(
   registry->Register(JSMethod<&StreamBase::ReadStopJS>);
   registry->Register(JSMethod<&StreamBase::Shutdown>);
   registry->Register(JSMethod<&StreamBase::UseUserBuffer>);
+  registry->Register(JSMethod<&StreamBase::ReadInto>);
   registry->Register(JSMethod<&StreamBase::Writev>);
   registry->Register(JSMethod<&StreamBase::WriteBuffer>);
   registry->Register(JSMethod<&StreamBase::WriteString<ASCII>>);
@@ -687,7 +745,7 @@ void StreamResource::ClearError() {
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
-  return env->allocate_managed_buffer(suggested_size);
+  return env->allocate_stream_read_buffer(suggested_size);
 }
 
 void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
@@ -697,7 +755,8 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Isolate* isolate = env->isolate();
   HandleScope handle_scope(isolate);
   Context::Scope context_scope(env->context());
-  std::unique_ptr<BackingStore> bs = env->release_managed_buffer(buf_);
+  size_t offset;
+  Local<ArrayBuffer> ab = env->release_stream_read_buffer(buf_, nread, &offset);
 
   if (nread <= 0)  {
     if (nread < 0)
@@ -705,15 +764,7 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
     return;
   }
 
-  CHECK_LE(static_cast<size_t>(nread), bs->ByteLength());
-  if (static_cast<size_t>(nread) != bs->ByteLength()) {
-    std::unique_ptr<BackingStore> old_bs = std::move(bs);
-    bs = ArrayBuffer::NewBackingStore(
-        isolate, nread, BackingStoreInitializationMode::kUninitialized);
-    memcpy(bs->Data(), old_bs->Data(), nread);
-  }
-
-  stream->CallJSOnreadMethod(nread, ArrayBuffer::New(isolate, std::move(bs)));
+  stream->CallJSOnreadMethod(nread, ab, offset);
 }
 
 
@@ -752,6 +803,51 @@ void CustomBufferJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
 }
 
 
+ReadIntoJSListener::ReadIntoJSListener(Isolate* isolate,
+                                       Local<ArrayBufferView> view)
+    : buffer_(isolate, view->Buffer()),
+      data_(static_cast<char*>(view->Buffer()->Data())),
+      offset_(view->ByteOffset()),
+      length_(view->ByteLength()) {}
+
+
+uv_buf_t ReadIntoJSListener::OnStreamAlloc(size_t suggested_size) {
+  return uv_buf_init(data_ + offset_ + filled_, length_ - filled_);
+}
+
+
+void ReadIntoJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  CHECK_NOT_NULL(stream_);
+
+  if (nread == 0) return;
+  if (nread > 0) {
+    CHECK_EQ(buf.base, data_ + offset_ + filled_);
+    filled_ += nread;
+    CHECK_LE(filled_, length_);
+    if (filled_ < length_) return;
+  }
+
+  // The buffer is full, or reading failed. Either way, hand back to the
+  // previous listener before calling into JS, which may read into another
+  // buffer right away.
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<ArrayBuffer> ab = buffer_.Get(env->isolate());
+  const size_t offset = offset_;
+  const size_t filled = filled_;
+  StreamListener* previous = previous_listener_;
+  stream->RemoveStreamListener(this);
+  delete this;
+
+  if (filled > 0)
+    stream->CallJSOnreadMethod(filled, ab, offset);
+  if (nread < 0)
+    previous->OnStreamRead(nread, uv_buf_init(nullptr, 0));
+}
+
+
 void ReportWritesToJSStreamListener::OnStreamAfterReqFinished(
     StreamReq* req_wrap, int status) {
   StreamBase* stream = static_cast<StreamBase*>(stream_);
@@ -141,6 +141,15 @@ class StreamListener {
   virtual void OnStreamRead(ssize_t nread,
                             const uv_buf_t& buf) = 0;
 
+  // This may be called instead of `OnStreamAlloc()` and `OnStreamRead()` by
+  // streams that have read `nread` bytes into memory of their own, such as
+  // the read-ahead buffers of a FileHandle. A listener that can use the data
+  // without copying it takes over `*data` and returns true. Otherwise, the
+  // stream copies the data into buffers from `OnStreamAlloc()`.
+  virtual bool OnStreamReadOwned(std::unique_ptr<char[]>* data, size_t nread) {
+    return false;
+  }
+
   // This is called once a write has finished. `status` may be 0 or,
   // if negative, a libuv error code.
   // By default, this is simply passed on to the previous listener
@@ -216,6 +225,27 @@ class CustomBufferJSListener : public ReportWritesToJSStreamListener {
 };
 
 
+// A one-shot listener that reads directly into a user-provided buffer until
+// it is full, and then reports the whole range to JS as a single read. It
+// removes itself from the stream once it is done, so that reading continues
+// through the listener that was active before it.
+class ReadIntoJSListener : public StreamListener {
+ public:
+  ReadIntoJSListener(v8::Isolate* isolate, v8::Local<v8::ArrayBufferView> view);
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override { delete this; }
+
+ private:
+  v8::Global<v8::ArrayBuffer> buffer_;
+  char* data_;
+  size_t offset_;
+  size_t length_;
+  size_t filled_ = 0;
+};
+
+
 // A generic stream, comparable to JS land’s `Duplex` streams.
 // A stream is always controlled through one `StreamListener` instance.
 class StreamResource {
@@ -288,6 +318,9 @@ class StreamResource {
   inline void EmitRead(
       ssize_t nread,
       const uv_buf_t& buf = uv_buf_init(nullptr, 0));
+  // Call the current listener's OnStreamReadOwned() method and, if it took
+  // over the data, update the stream's read byte counter.
+  inline bool EmitReadOwned(std::unique_ptr<char[]>* data, size_t nread);
   // Call the current listener's OnStreamAfterWrite() method.
   inline void EmitAfterWrite(WriteWrap* w, int status);
   // Call the current listener's OnStreamAfterShutdown() method.
@@ -388,6 +421,7 @@ class StreamBase : public StreamResource {
   template <enum encoding enc>
   int WriteString(const v8::FunctionCallbackInfo<v8::Value>& args);
   int UseUserBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int ReadInto(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void GetFD(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetExternal(const v8::FunctionCallbackInfo<v8::Value>& args);
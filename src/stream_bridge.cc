@@ -0,0 +1,337 @@
+#include "stream_bridge.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "stream_base-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::ArrayBufferView;
+using v8::BackingStore;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::Value;
+
+StreamByteSource::StreamByteSource(Environment* env,
+                                   Local<Object> obj,
+                                   StreamBase* stream)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_STREAMBRIDGE) {
+  MakeWeak();
+  stream->PushStreamListener(this);
+}
+
+StreamByteSource::~StreamByteSource() {
+  Detach();
+}
+
+void StreamByteSource::Detach() {
+  if (stream_ == nullptr) return;
+  if (reading_) stream_->ReadStop();
+  reading_ = false;
+  stream_->RemoveStreamListener(this);
+}
+
+void StreamByteSource::ClearView() {
+  view_store_.reset();
+  view_data_ = nullptr;
+  view_length_ = 0;
+}
+
+void StreamByteSource::MaybeReadStop() {
+  if (view_data_ != nullptr || !reading_ || stream_ == nullptr) return;
+  reading_ = false;
+  stream_->ReadStop();
+}
+
+size_t StreamByteSource::CopyFromBuffered() {
+  size_t copied = 0;
+  while (!buffered_.empty() && copied < view_length_) {
+    Chunk& chunk = buffered_.front();
+    size_t len = std::min(chunk.length, view_length_ - copied);
+    char* from = static_cast<char*>(chunk.store->Data()) + chunk.offset;
+    std::copy(from, from + len, view_data_ + copied);
+    copied += len;
+    chunk.offset += len;
+    chunk.length -= len;
+    if (chunk.length == 0) buffered_.pop_front();
+  }
+  return copied;
+}
+
+void StreamByteSource::Complete(ssize_t nread) {
+  ClearView();
+  if (nread < 0) Detach();
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+  Local<Value> arg = Integer::New(isolate, nread);
+  MakeCallback(env()->oncomplete_string(), 1, &arg);
+}
+
+uv_buf_t StreamByteSource::OnStreamAlloc(size_t suggested_size) {
+  if (view_data_ != nullptr) {
+    // Some streams read asynchronously, so keep the memory alive even if the
+    // view is withdrawn in the meantime.
+    alloc_store_ = view_store_;
+    alloc_base_ = view_data_;
+    return uv_buf_init(view_data_, view_length_);
+  }
+  return env()->allocate_managed_buffer(suggested_size);
+}
+
+void StreamByteSource::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  if (buf.base != nullptr && buf.base == alloc_base_) {
+    std::shared_ptr<BackingStore> store = std::move(alloc_store_);
+    alloc_base_ = nullptr;
+    if (view_data_ != buf.base) {
+      // The source has been detached while the read was in progress.
+      if (nread < 0) pending_error_ = nread;
+      return;
+    }
+    // The data has been read straight into the view. A zero-length read
+    // leaves the view pending.
+    if (nread == 0) return;
+    BaseObjectPtr<StreamByteSource> strong_ref{this};
+    Complete(nread);
+    MaybeReadStop();
+    return;
+  }
+
+  std::unique_ptr<BackingStore> bs = env()->release_managed_buffer(buf);
+  if (nread > 0) {
+    buffered_.push_back({std::move(bs), 0, static_cast<size_t>(nread)});
+  } else if (nread < 0) {
+    if (view_data_ != nullptr) {
+      BaseObjectPtr<StreamByteSource> strong_ref{this};
+      Complete(nread);
+      return;
+    }
+    pending_error_ = nread;
+    Detach();
+    return;
+  }
+  MaybeReadStop();
+}
+
+void StreamByteSource::OnStreamDestroy() {
+  // The stream is going away, possibly from inside the garbage collector, so
+  // a pending read is completed asynchronously.
+  reading_ = false;
+  if (pending_error_ == 0) pending_error_ = UV_EPIPE;
+  if (view_data_ == nullptr) return;
+  ClearView();
+  BaseObjectPtr<StreamByteSource> strong_ref{this};
+  env()->SetImmediate([this, strong_ref](Environment* env) {
+    Complete(pending_error_);
+  });
+}
+
+void StreamByteSource::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsObject());
+  StreamBase* stream = StreamBase::FromObject(args[0].As<Object>());
+  CHECK_NOT_NULL(stream);
+  new StreamByteSource(env, args.This(), stream);
+}
+
+void StreamByteSource::Read(const FunctionCallbackInfo<Value>& args) {
+  StreamByteSource* source;
+  ASSIGN_OR_RETURN_UNWRAP(&source, args.This());
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK_NULL(source->view_data_);
+
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  CHECK_GT(view->ByteLength(), 0);
+  source->view_store_ = view->Buffer()->GetBackingStore();
+  source->view_data_ =
+      static_cast<char*>(source->view_store_->Data()) + view->ByteOffset();
+  source->view_length_ = view->ByteLength();
+
+  if (size_t copied = source->CopyFromBuffered()) {
+    source->ClearView();
+    return args.GetReturnValue().Set(static_cast<double>(copied));
+  }
+
+  if (source->pending_error_ != 0 || source->stream_ == nullptr) {
+    source->ClearView();
+    ssize_t err = source->pending_error_ != 0 ? source->pending_error_ : UV_EOF;
+    return args.GetReturnValue().Set(static_cast<double>(err));
+  }
+
+  if (!source->reading_) {
+    int err = static_cast<StreamBase*>(source->stream_)->ReadStart();
+    if (err != 0) {
+      source->ClearView();
+      return args.GetReturnValue().Set(err);
+    }
+    source->reading_ = true;
+  }
+  args.GetReturnValue().Set(0);
+}
+
+void StreamByteSource::Detach(const FunctionCallbackInfo<Value>& args) {
+  StreamByteSource* source;
+  ASSIGN_OR_RETURN_UNWRAP(&source, args.This());
+  source->ClearView();
+  source->buffered_.clear();
+  source->Detach();
+}
+
+StreamByteSink::StreamByteSink(Environment* env,
+                               Local<Object> obj,
+                               StreamBase* stream)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_STREAMBRIDGE) {
+  MakeWeak();
+  stream->PushStreamListener(this);
+}
+
+StreamByteSink::~StreamByteSink() {
+  if (stream_ != nullptr) stream_->RemoveStreamListener(this);
+}
+
+void StreamByteSink::Detach() {
+  detach_requested_ = true;
+  // A pending write still reports to this listener, so we stay attached
+  // until it has finished.
+  if (stream_ == nullptr || pending_wrap_ != nullptr) return;
+  stream_->RemoveStreamListener(this);
+}
+
+void StreamByteSink::Complete(int status) {
+  BaseObjectPtr<StreamByteSink> strong_ref = std::move(pending_ref_);
+  pending_store_.reset();
+  pending_wrap_ = nullptr;
+  if (detach_requested_) Detach();
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+  Local<Value> arg = Integer::New(isolate, status);
+  MakeCallback(env()->oncomplete_string(), 1, &arg);
+}
+
+uv_buf_t StreamByteSink::OnStreamAlloc(size_t suggested_size) {
+  CHECK_NOT_NULL(previous_listener_);
+  return previous_listener_->OnStreamAlloc(suggested_size);
+}
+
+void StreamByteSink::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  CHECK_NOT_NULL(previous_listener_);
+  return previous_listener_->OnStreamRead(nread, buf);
+}
+
+void StreamByteSink::OnStreamAfterWrite(WriteWrap* w, int status) {
+  if (in_write_) {
+    // Some streams, e.g. JSStream, can finish a write before Write() returns.
+    sync_status_ = status;
+    finished_in_write_ = true;
+    return;
+  }
+  if (w != pending_wrap_ || w == nullptr) {
+    CHECK_NOT_NULL(previous_listener_);
+    return previous_listener_->OnStreamAfterWrite(w, status);
+  }
+  Complete(status);
+}
+
+void StreamByteSink::OnStreamDestroy() {
+  pending_wrap_ = nullptr;
+  if (pending_store_ == nullptr) return;
+  env()->SetImmediate([this, strong_ref = std::move(pending_ref_)](
+                          Environment* env) { Complete(UV_EPIPE); });
+}
+
+void StreamByteSink::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsObject());
+  StreamBase* stream = StreamBase::FromObject(args[0].As<Object>());
+  CHECK_NOT_NULL(stream);
+  new StreamByteSink(env, args.This(), stream);
+}
+
+void StreamByteSink::Write(const FunctionCallbackInfo<Value>& args) {
+  StreamByteSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.This());
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK_NULL(sink->pending_wrap_);
+
+  if (sink->stream_ == nullptr) return args.GetReturnValue().Set(UV_EPIPE);
+
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
+  uv_buf_t buf = uv_buf_init(
+      static_cast<char*>(store->Data()) + view->ByteOffset(),
+      view->ByteLength());
+
+  sink->in_write_ = true;
+  sink->finished_in_write_ = false;
+  StreamWriteResult res =
+      static_cast<StreamBase*>(sink->stream_)->Write(&buf, 1);
+  sink->in_write_ = false;
+  if (res.err < 0) return args.GetReturnValue().Set(res.err);
+  if (sink->finished_in_write_) {
+    int status = sink->sync_status_;
+    return args.GetReturnValue().Set(status < 0 ? status : 1);
+  }
+  if (!res.async) return args.GetReturnValue().Set(1);
+
+  // The memory of the view, and this object, have to stay alive until the
+  // write has finished.
+  sink->pending_store_ = std::move(store);
+  sink->pending_wrap_ = res.wrap;
+  sink->pending_ref_.reset(sink);
+  args.GetReturnValue().Set(0);
+}
+
+void StreamByteSink::Detach(const FunctionCallbackInfo<Value>& args) {
+  StreamByteSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.This());
+  sink->Detach();
+}
+
+namespace {
+
+void InitializeStreamBridge(Local<Object> target,
+                            Local<Value> unused,
+                            Local<Context> context,
+                            void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> source =
+      NewFunctionTemplate(isolate, StreamByteSource::New);
+  SetProtoMethod(isolate, source, "read", StreamByteSource::Read);
+  SetProtoMethod(isolate, source, "detach", StreamByteSource::Detach);
+  source->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  source->InstanceTemplate()->SetInternalFieldCount(
+      StreamByteSource::kInternalFieldCount);
+  SetConstructorFunction(context, target, "StreamByteSource", source);
+
+  Local<FunctionTemplate> sink =
+      NewFunctionTemplate(isolate, StreamByteSink::New);
+  SetProtoMethod(isolate, sink, "write", StreamByteSink::Write);
+  SetProtoMethod(isolate, sink, "detach", StreamByteSink::Detach);
+  sink->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  sink->InstanceTemplate()->SetInternalFieldCount(
+      StreamByteSink::kInternalFieldCount);
+  SetConstructorFunction(context, target, "StreamByteSink", sink);
+}
+
+}  // anonymous namespace
+
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(stream_bridge,
+                                    node::InitializeStreamBridge)
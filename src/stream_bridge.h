@@ -0,0 +1,114 @@
+#ifndef SRC_STREAM_BRIDGE_H_
+#define SRC_STREAM_BRIDGE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "stream_base.h"
+
+#include <deque>
+#include <memory>
+
+namespace node {
+
+// StreamByteSource and StreamByteSink connect a StreamBase to a WHATWG
+// readable byte stream or writable stream (see
+// lib/internal/webstreams/adapters.js) without going through the regular
+// JavaScript stream listener.
+//
+// A StreamByteSource reads data straight into the views of BYOB requests:
+// read(view) hands the memory of the view to the stream, which reads into it
+// from OnStreamAlloc(), and oncomplete(nread) is called once it has been
+// filled. Data that arrives while no view is pending (e.g. from streams that
+// keep emitting data after ReadStop()) is buffered and copied into the next
+// view.
+class StreamByteSource final : public AsyncWrap, public StreamListener {
+ public:
+  StreamByteSource(Environment* env,
+                   v8::Local<v8::Object> obj,
+                   StreamBase* stream);
+  ~StreamByteSource() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // read(view) returns the number of bytes that have been copied into the
+  // view synchronously, 0 if the read is pending, or a negative libuv error
+  // code (including UV_EOF).
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Detach(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(StreamByteSource)
+  SET_SELF_SIZE(StreamByteSource)
+
+ private:
+  struct Chunk {
+    std::unique_ptr<v8::BackingStore> store;
+    size_t offset;
+    size_t length;
+  };
+
+  void Detach();
+  void Complete(ssize_t nread);
+  void ClearView();
+  void MaybeReadStop();
+  size_t CopyFromBuffered();
+
+  std::shared_ptr<v8::BackingStore> view_store_;
+  char* view_data_ = nullptr;
+  size_t view_length_ = 0;
+  // The memory that was last handed out by OnStreamAlloc() for a view.
+  std::shared_ptr<v8::BackingStore> alloc_store_;
+  char* alloc_base_ = nullptr;
+  std::deque<Chunk> buffered_;
+  // EOF or an error that was received while no view was pending.
+  ssize_t pending_error_ = 0;
+  bool reading_ = false;
+};
+
+// A StreamByteSink writes the views that are passed to write(view) to the
+// stream without wrapping them in a JavaScript WriteWrap. write(view) returns
+// 1 if the data has been written synchronously, 0 if the write is pending, in
+// which case oncomplete(status) is called once it has finished, or a negative
+// libuv error code. At most one write can be pending at a time.
+class StreamByteSink final : public AsyncWrap, public StreamListener {
+ public:
+  StreamByteSink(Environment* env,
+                 v8::Local<v8::Object> obj,
+                 StreamBase* stream);
+  ~StreamByteSink() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Write(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Detach(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamAfterWrite(WriteWrap* w, int status) override;
+  void OnStreamDestroy() override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(StreamByteSink)
+  SET_SELF_SIZE(StreamByteSink)
+
+ private:
+  void Detach();
+  void Complete(int status);
+
+  std::shared_ptr<v8::BackingStore> pending_store_;
+  WriteWrap* pending_wrap_ = nullptr;
+  BaseObjectPtr<StreamByteSink> pending_ref_;
+  bool detach_requested_ = false;
+  bool in_write_ = false;
+  bool finished_in_write_ = false;
+  int sync_status_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_STREAM_BRIDGE_H_
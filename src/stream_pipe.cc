@@ -1,10 +1,13 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
 #include "node_buffer.h"
+#include "node_file.h"
+#include "stream_wrap.h"
 #include "util-inl.h"
 
 namespace node {
 
+using v8::ArrayBuffer;
 using v8::BackingStore;
 using v8::Context;
 using v8::Function;
@@ -138,6 +141,23 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
   pipe->ProcessData(nread, std::move(bs));
 }
 
+// Writes the data that the source read into its own memory, for example the
+// read-ahead buffers of a FileHandle, without copying it first. Sinks that
+// frame the data themselves, such as Http2Streams, reference it directly.
+bool StreamPipe::ReadableListener::OnStreamReadOwned(
+    std::unique_ptr<char[]>* data, size_t nread) {
+  StreamPipe* pipe = ContainerOf(&StreamPipe::readable_listener_, this);
+  std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+      data->release(),
+      nread,
+      [](void* data, size_t length, void* deleter_data) {
+        delete[] static_cast<char*>(data);
+      },
+      nullptr);
+  pipe->ProcessData(nread, std::move(bs));
+  return true;
+}
+
 void StreamPipe::ProcessData(size_t nread,
                              std::unique_ptr<BackingStore> bs) {
   CHECK(uses_wants_write_ || pending_writes_ == 0);
@@ -154,6 +174,149 @@ void StreamPipe::ProcessData(size_t nread,
   }
 }
 
+namespace {
+// Upper bound for a single sendfile() call.
+constexpr size_t kSendFileChunkSize = 4 * 1024 * 1024;
+// Size of the regular reads used while the socket is full.
+constexpr size_t kSendFileFallbackSize = 64 * 1024;
+}  // anonymous namespace
+
+bool StreamPipe::CanSendFile() {
+#ifdef _WIN32
+  // libuv emulates sendfile() with CRT file descriptors, which sockets
+  // are not on Windows.
+  return false;
+#else
+  if (source()->GetAsyncWrap()->provider_type() !=
+      AsyncWrap::PROVIDER_FILEHANDLE) {
+    return false;
+  }
+  const AsyncWrap::ProviderType sink_type =
+      sink()->GetAsyncWrap()->provider_type();
+  if (sink_type != AsyncWrap::PROVIDER_TCPWRAP &&
+      sink_type != AsyncWrap::PROVIDER_PIPEWRAP) {
+    return false;
+  }
+  if (sink()->IsIPCPipe() || sink()->GetFD() < 0) return false;
+  // Data that is already queued must go out first.
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(sink());
+  if (uv_stream_get_write_queue_size(wrap->stream()) != 0) return false;
+  // sendfile() needs an explicit position.
+  return static_cast<fs::FileHandle*>(source())->read_offset() >= 0;
+#endif
+}
+
+void StreamPipe::StartFileRequest() {
+  is_sending_file_ = true;
+  sendfile_ref_.reset(this);
+  env()->IncreaseWaitingRequestCounter();
+}
+
+// Returns whether the pipe is still active.
+bool StreamPipe::FinishFileRequest() {
+  uv_fs_req_cleanup(&sendfile_req_);
+  is_sending_file_ = false;
+  env()->DecreaseWaitingRequestCounter();
+  return !is_closed_ && env()->can_call_into_js();
+}
+
+void StreamPipe::SendFile() {
+  if (is_closed_ || is_eof_ || is_sending_file_ || pending_writes_ > 0)
+    return;
+
+  fs::FileHandle* file = static_cast<fs::FileHandle*>(source());
+  if (file->read_length() == 0) {
+    readable_listener_.OnStreamRead(UV_EOF, uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  size_t count = kSendFileChunkSize;
+  if (file->read_length() > 0)
+    count = std::min<size_t>(count, file->read_length());
+
+  StartFileRequest();
+  int err = uv_fs_sendfile(env()->event_loop(),
+                           &sendfile_req_,
+                           sink()->GetFD(),
+                           file->GetFD(),
+                           file->read_offset(),
+                           count,
+                           AfterSendFile);
+  if (err < 0) {
+    BaseObjectPtr<StreamPipe> strong_ref = std::move(sendfile_ref_);
+    if (FinishFileRequest())
+      readable_listener_.OnStreamRead(err, uv_buf_init(nullptr, 0));
+  }
+}
+
+void StreamPipe::AfterSendFile(uv_fs_t* req) {
+  StreamPipe* pipe = ContainerOf(&StreamPipe::sendfile_req_, req);
+  BaseObjectPtr<StreamPipe> strong_ref = std::move(pipe->sendfile_ref_);
+  const ssize_t result = req->result;
+  if (!pipe->FinishFileRequest()) return;
+
+  HandleScope handle_scope(pipe->env()->isolate());
+  InternalCallbackScope callback_scope(pipe,
+      InternalCallbackScope::kSkipTaskQueues);
+
+  if (result > 0) {
+    static_cast<fs::FileHandle*>(pipe->source())->AdvanceRead(result);
+    pipe->SendFile();
+  } else if (result == UV_EAGAIN) {
+    pipe->SendFileFallback();
+  } else {
+    // 0 means that the end of the file has been reached.
+    pipe->readable_listener_.OnStreamRead(result == 0 ? UV_EOF : result,
+                                          uv_buf_init(nullptr, 0));
+  }
+}
+
+void StreamPipe::SendFileFallback() {
+  fs::FileHandle* file = static_cast<fs::FileHandle*>(source());
+  size_t size = kSendFileFallbackSize;
+  if (file->read_length() > 0)
+    size = std::min<size_t>(size, file->read_length());
+
+  sendfile_fallback_buf_ = env()->allocate_managed_buffer(size);
+  StartFileRequest();
+  int err = uv_fs_read(env()->event_loop(),
+                       &sendfile_req_,
+                       file->GetFD(),
+                       &sendfile_fallback_buf_,
+                       1,
+                       file->read_offset(),
+                       AfterSendFileFallback);
+  if (err < 0) {
+    BaseObjectPtr<StreamPipe> strong_ref = std::move(sendfile_ref_);
+    env()->release_managed_buffer(sendfile_fallback_buf_);
+    if (FinishFileRequest())
+      readable_listener_.OnStreamRead(err, uv_buf_init(nullptr, 0));
+  }
+}
+
+void StreamPipe::AfterSendFileFallback(uv_fs_t* req) {
+  StreamPipe* pipe = ContainerOf(&StreamPipe::sendfile_req_, req);
+  BaseObjectPtr<StreamPipe> strong_ref = std::move(pipe->sendfile_ref_);
+  const ssize_t result = req->result;
+  std::unique_ptr<BackingStore> bs =
+      pipe->env()->release_managed_buffer(pipe->sendfile_fallback_buf_);
+  if (!pipe->FinishFileRequest()) return;
+
+  HandleScope handle_scope(pipe->env()->isolate());
+  InternalCallbackScope callback_scope(pipe,
+      InternalCallbackScope::kSkipTaskQueues);
+
+  if (result <= 0) {
+    pipe->readable_listener_.OnStreamRead(result == 0 ? UV_EOF : result,
+                                          uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  static_cast<fs::FileHandle*>(pipe->source())->AdvanceRead(result);
+  // Once this write has finished, OnStreamWantsWrite() resumes sendfile().
+  pipe->ProcessData(result, std::move(bs));
+}
+
 void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
                                                       int status) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
@@ -225,6 +388,10 @@ void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
   HandleScope handle_scope(pipe->env()->isolate());
   InternalCallbackScope callback_scope(pipe,
       InternalCallbackScope::kSkipTaskQueues);
+  if (pipe->uses_sendfile_) {
+    pipe->SendFile();
+    return;
+  }
   pipe->is_reading_ = true;
   pipe->source()->ReadStart();
 }
@@ -286,6 +453,7 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.This());
   pipe->is_closed_ = false;
+  pipe->uses_sendfile_ = pipe->CanSendFile();
   pipe->writable_listener_.OnStreamWantsWrite(65536);
 }
 
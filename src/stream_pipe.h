@@ -48,10 +48,32 @@ class StreamPipe : public AsyncWrap {
 
   void ProcessData(size_t nread, std::unique_ptr<v8::BackingStore> bs);
 
+  // When the source is a FileHandle with a known offset and the sink is a
+  // TCP or pipe socket, the data is moved by the kernel with sendfile()
+  // rather than through userland buffers. When the socket is full,
+  // one chunk is read and written the regular way, which also waits for
+  // the socket to become writable again, and sendfile() resumes after it.
+  bool CanSendFile();
+  void SendFile();
+  void SendFileFallback();
+  void StartFileRequest();
+  bool FinishFileRequest();
+  static void AfterSendFile(uv_fs_t* req);
+  static void AfterSendFileFallback(uv_fs_t* req);
+
+  bool uses_sendfile_ = false;
+  bool is_sending_file_ = false;
+  uv_fs_t sendfile_req_;
+  uv_buf_t sendfile_fallback_buf_;
+  // Keeps this object alive while `sendfile_req_` is in flight.
+  BaseObjectPtr<StreamPipe> sendfile_ref_;
+
   class ReadableListener : public StreamListener {
    public:
     uv_buf_t OnStreamAlloc(size_t suggested_size) override;
     void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+    bool OnStreamReadOwned(std::unique_ptr<char[]>* data,
+                           size_t nread) override;
     void OnStreamDestroy() override;
   };
 
@@ -199,7 +199,53 @@ bool LibuvStreamWrap::IsIPCPipe() {
   return is_named_pipe_ipc();
 }
 
+#ifdef NODE_HAVE_IO_URING_STREAMS
+IoUringStream* LibuvStreamWrap::io_uring() {
+  // Only connected streams have a file descriptor.
+  if (!io_uring_checked_ && GetFD() >= 0) {
+    io_uring_checked_ = true;
+    io_uring_ = IoUringStream::Create(this);
+  }
+  return io_uring_.get();
+}
+#endif
+
+void LibuvStreamWrap::Close(Local<Value> close_callback) {
+  CancelPendingIo();
+  HandleWrap::Close(close_callback);
+}
+
+void LibuvStreamWrap::CancelPendingIo() {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  // The requests in flight keep the socket open, so they are cancelled
+  // before libuv closes it.
+  if (io_uring_ && state_ == kInitialized) io_uring_->Close();
+#endif
+}
+
+void LibuvStreamWrap::OnClose() {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (io_uring_) {
+    io_uring_->OnClose();
+    io_uring_.reset();
+  }
+#endif
+}
+
+void LibuvStreamWrap::OnRefChanged() {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (io_uring_) io_uring_->UpdateRef();
+#endif
+}
+
 int LibuvStreamWrap::ReadStart() {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (IoUringStream* io_uring = this->io_uring()) return io_uring->ReadStart();
+#endif
+  return UvReadStart();
+}
+
+int LibuvStreamWrap::UvReadStart() {
   return uv_read_start(
       stream(),
       [](uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
@@ -216,6 +262,13 @@ int LibuvStreamWrap::ReadStart() {
 
 
 int LibuvStreamWrap::ReadStop() {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (IoUringStream* io_uring = this->io_uring()) return io_uring->ReadStop();
+#endif
+  return UvReadStop();
+}
+
+int LibuvStreamWrap::UvReadStop() {
   return uv_read_stop(stream());
 }
 
@@ -305,6 +358,9 @@ void LibuvStreamWrap::GetWriteQueueSize(
   }
 
   uint32_t write_queue_size = wrap->stream()->write_queue_size;
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (wrap->io_uring_) write_queue_size += wrap->io_uring_->write_queue_size();
+#endif
   info.GetReturnValue().Set(write_queue_size);
 }
 
@@ -333,7 +389,19 @@ WriteWrap* LibuvStreamWrap::CreateWriteWrap(Local<Object> object) {
 }
 
 
-int LibuvStreamWrap::DoShutdown(ShutdownWrap* req_wrap_) {
+int LibuvStreamWrap::DoShutdown(ShutdownWrap* req_wrap) {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  // The socket is only shut down once io_uring is done with the writes.
+  if (IoUringStream* io_uring = this->io_uring()) {
+    if (io_uring->has_pending_shutdown()) return UV_ENOTCONN;
+    if (io_uring->DeferShutdown(req_wrap)) return 0;
+  }
+#endif
+  return DispatchShutdown(req_wrap);
+}
+
+
+int LibuvStreamWrap::DispatchShutdown(ShutdownWrap* req_wrap_) {
   LibuvShutdownWrap* req_wrap = static_cast<LibuvShutdownWrap*>(req_wrap_);
   return req_wrap->Dispatch(uv_shutdown, stream(), AfterUvShutdown);
 }
@@ -354,6 +422,11 @@ void LibuvStreamWrap::AfterUvShutdown(uv_shutdown_t* req, int status) {
 // required in order to skip the data that was successfully written via
 // uv_try_write().
 int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  // All writes are batched up and go through io_uring.
+  if (io_uring() != nullptr) return 0;
+#endif
+
   int err;
   size_t written;
   uv_buf_t* vbufs = *bufs;
@@ -393,6 +466,12 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
                              uv_buf_t* bufs,
                              size_t count,
                              uv_stream_t* send_handle) {
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  if (IoUringStream* io_uring = this->io_uring()) {
+    CHECK_NULL(send_handle);
+    return io_uring->Write(req_wrap, bufs, count);
+  }
+#endif
   LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(req_wrap);
   return w->Dispatch(uv_write2,
                      stream(),
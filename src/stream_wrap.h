@@ -26,8 +26,11 @@
 
 #include "stream_base.h"
 #include "handle_wrap.h"
+#include "io_uring_stream.h"
 #include "v8.h"
 
+#include <memory>
+
 namespace node {
 
 class Environment;
@@ -80,6 +83,9 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   static LibuvStreamWrap* From(Environment* env, v8::Local<v8::Object> object);
 
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
  protected:
   LibuvStreamWrap(Environment* env,
                   v8::Local<v8::Object> object,
@@ -87,6 +93,10 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
                   AsyncWrap::ProviderType provider);
 
   AsyncWrap* GetAsyncWrap() override;
+  // Must be called before the handle is closed other than through Close().
+  void CancelPendingIo();
+  void OnClose() override;
+  void OnRefChanged() override;
 
   static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
       Environment* env);
@@ -100,6 +110,18 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
 
  private:
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  friend class IoUringStream;
+
+  // Returns the io_uring state of the stream if it uses
+  // --experimental-io-uring-sockets. That is decided once it has a socket.
+  IoUringStream* io_uring();
+#endif
+
+  int UvReadStart();
+  int UvReadStop();
+  int DispatchShutdown(ShutdownWrap* req_wrap);
+
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -113,6 +135,11 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   uv_stream_t* const stream_;
 
+#ifdef NODE_HAVE_IO_URING_STREAMS
+  std::unique_ptr<IoUringStream> io_uring_;
+  bool io_uring_checked_ = false;
+#endif
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
@@ -26,6 +26,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "simdutf.h"
+#include "string_bytes_simd.h"
 #include "util.h"
 #include "v8-external-memory-accounter.h"
 
@@ -41,6 +42,8 @@
 
 namespace node {
 
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::ExternalMemoryAccounter;
 using v8::HandleScope;
 using v8::Isolate;
@@ -194,6 +197,36 @@ MaybeLocal<Value> ExternTwoByteString::NewSimpleFromCopy(Isolate* isolate,
   return str;
 }
 
+// A one-byte string whose characters are the bytes of a backing store. The
+// backing store is kept alive until the string is collected.
+class BackingStoreOneByteString : public String::ExternalOneByteStringResource {
+ public:
+  BackingStoreOneByteString(Isolate* isolate,
+                            std::shared_ptr<BackingStore> store,
+                            const char* data,
+                            size_t length)
+      : isolate_(isolate),
+        store_(std::move(store)),
+        data_(data),
+        length_(length) {
+    external_memory_accounter_.Increase(isolate_, length_);
+  }
+
+  ~BackingStoreOneByteString() override {
+    external_memory_accounter_.Decrease(isolate_, length_);
+  }
+
+  const char* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+ private:
+  Isolate* isolate_;
+  ExternalMemoryAccounter external_memory_accounter_;
+  std::shared_ptr<BackingStore> store_;
+  const char* data_;
+  size_t length_;
+};
+
 }  // anonymous namespace
 
 static size_t keep_buflen_in_range(size_t len) {
@@ -269,6 +302,20 @@ size_t StringBytes::Write(Isolate* isolate,
       break;
 
     case UCS2: {
+      if (input_view.is_one_byte() &&
+          reinterpret_cast<uintptr_t>(buf) % sizeof(char16_t) == 0) {
+        // simdutf writes little endian data on all platforms.
+        const size_t nchars =
+            std::min(buflen / sizeof(char16_t),
+                     static_cast<size_t>(input_view.length()));
+        nbytes = simdutf::convert_latin1_to_utf16le(
+                     reinterpret_cast<const char*>(input_view.data8()),
+                     nchars,
+                     reinterpret_cast<char16_t*>(buf)) *
+                 sizeof(char16_t);
+        break;
+      }
+
       nbytes = WriteUCS2(isolate, buf, buflen, str);
 
       // Node's "ucs2" encoding wants LE character data stored in
@@ -283,7 +330,7 @@ size_t StringBytes::Write(Isolate* isolate,
     case BASE64URL:
       if (input_view.is_one_byte()) {  // 8-bit case
         size_t written_len = buflen;
-        auto result = simdutf::base64_to_binary_safe(
+        auto result = simd::Base64DecodeSafe(
             reinterpret_cast<const char*>(input_view.data8()),
             input_view.length(),
             buf,
@@ -324,7 +371,7 @@ size_t StringBytes::Write(Isolate* isolate,
     case BASE64: {
       if (input_view.is_one_byte()) {  // 8-bit case
         size_t written_len = buflen;
-        auto result = simdutf::base64_to_binary_safe(
+        auto result = simd::Base64DecodeSafe(
             reinterpret_cast<const char*>(input_view.data8()),
             input_view.length(),
             buf,
@@ -361,10 +408,10 @@ size_t StringBytes::Write(Isolate* isolate,
     case HEX:
       if (input_view.is_one_byte()) {
         nbytes =
-            nbytes::HexDecode(buf,
-                              buflen,
-                              reinterpret_cast<const char*>(input_view.data8()),
-                              input_view.length());
+            simd::HexDecode(buf,
+                            buflen,
+                            reinterpret_cast<const char*>(input_view.data8()),
+                            input_view.length());
       } else {
         String::Value value(isolate, str);
         nbytes = nbytes::HexDecode(buf, buflen, *value, value.length());
@@ -551,7 +598,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         return MaybeLocal<Value>();
       }
 
-      size_t written = simdutf::binary_to_base64(buf, buflen, dst);
+      size_t written = simd::Base64Encode(buf, buflen, dst);
       CHECK_EQ(written, dlen);
 
       return ExternOneByteString::New(isolate, dst, dlen);
@@ -568,7 +615,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
       }
 
       size_t written =
-          simdutf::binary_to_base64(buf, buflen, dst, simdutf::base64_url);
+          simd::Base64Encode(buf, buflen, dst, simdutf::base64_url);
       CHECK_EQ(written, dlen);
 
       return ExternOneByteString::New(isolate, dst, dlen);
@@ -582,7 +629,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         isolate->ThrowException(node::ERR_MEMORY_ALLOCATION_FAILED(isolate));
         return MaybeLocal<Value>();
       }
-      size_t written = nbytes::HexEncode(buf, buflen, dst, dlen);
+      size_t written = simd::HexEncode(buf, buflen, dst, dlen);
       CHECK_EQ(written, dlen);
 
       return ExternOneByteString::New(isolate, dst, dlen);
@@ -591,6 +638,21 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
     case UCS2: {
       buflen = keep_buflen_in_range(buflen);
       size_t str_len = buflen / 2;
+      if (str_len != 0 && reinterpret_cast<uintptr_t>(buf) % 2 == 0) {
+        // Data that is all Latin-1 becomes a one-byte string, which takes
+        // half the memory.
+        char* latin1 = node::UncheckedMalloc(str_len);
+        if (latin1 == nullptr) {
+          isolate->ThrowException(node::ERR_MEMORY_ALLOCATION_FAILED(isolate));
+          return MaybeLocal<Value>();
+        }
+        if (simdutf::convert_utf16le_to_latin1(
+                reinterpret_cast<const char16_t*>(buf), str_len, latin1) ==
+            str_len) {
+          return ExternOneByteString::New(isolate, latin1, str_len);
+        }
+        free(latin1);
+      }
       if constexpr (IsBigEndian()) {
         uint16_t* dst = node::UncheckedMalloc<uint16_t>(str_len);
         if (str_len != 0 && dst == nullptr) {
@@ -658,4 +720,33 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
   return Encode(isolate, buf, len, encoding);
 }
 
+MaybeLocal<Value> StringBytes::EncodeWithoutCopy(Isolate* isolate,
+                                                 Local<ArrayBufferView> view,
+                                                 enum encoding encoding) {
+  const size_t length = view->ByteLength();
+  if (length < EXTERN_APEX || (encoding != LATIN1 && encoding != ASCII)) {
+    ArrayBufferViewContents<char> contents(view);
+    return Encode(isolate, contents.data(), contents.length(), encoding);
+  }
+
+  std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
+  const char* data =
+      static_cast<const char*>(store->Data()) + view->ByteOffset();
+  // Other threads may write to shared memory at any time.
+  if (store->IsShared() ||
+      (encoding == ASCII && !simdutf::validate_ascii(data, length))) {
+    return Encode(isolate, data, length, encoding);
+  }
+
+  auto* resource =
+      new BackingStoreOneByteString(isolate, std::move(store), data, length);
+  Local<String> str;
+  if (!String::NewExternalOneByte(isolate, resource).ToLocal(&str)) {
+    delete resource;
+    isolate->ThrowException(node::ERR_STRING_TOO_LONG(isolate));
+    return MaybeLocal<Value>();
+  }
+  return str;
+}
+
 }  // namespace node
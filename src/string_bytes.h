@@ -95,6 +95,17 @@ class StringBytes {
                                           const char* buf,
                                           enum encoding encoding);
 
+  // Like Encode() for the contents of `view`, but large LATIN1 strings, and
+  // large ASCII strings whose bytes are all ASCII, refer to the memory of
+  // `view` instead of copying it, and keep its backing store alive. The
+  // contents of `view` must never be modified afterwards, so its memory must
+  // be owned by its backing store alone, not, e.g., be a file mapping. Shared
+  // backing stores are always copied.
+  static v8::MaybeLocal<v8::Value> EncodeWithoutCopy(
+      v8::Isolate* isolate,
+      v8::Local<v8::ArrayBufferView> view,
+      enum encoding encoding);
+
  private:
   static size_t WriteUCS2(v8::Isolate* isolate,
                           char* buf,
@@ -0,0 +1,492 @@
+#ifndef SRC_STRING_BYTES_SIMD_H_
+#define SRC_STRING_BYTES_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "nbytes.h"
+#include "simdutf.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NODE_STRING_BYTES_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NODE_STRING_BYTES_NEON 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define NODE_STRING_BYTES_WASM 1
+#endif
+
+// Hex and base64 coding of one-byte data, WebSocket masking and the searches
+// for line breaks and for the escapes of form data.
+//
+// The hex code uses the SIMD instructions that are part of the baseline of
+// the target, so that no CPU detection is needed. Base64 is coded by simdutf,
+// which selects its kernels at runtime. simdutf has no WebAssembly kernels,
+// so for wasm simd128 the blocks of the input that need no special handling
+// are coded here and the rest is left to simdutf.
+
+namespace node {
+namespace simd {
+
+// Same as nbytes::HexEncode().
+inline size_t HexEncode(const char* src, size_t slen, char* dst, size_t dlen) {
+  size_t i = 0;
+#if defined(NODE_STRING_BYTES_SSE2)
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i zero = _mm_set1_epi8('0');
+  // 'a' - '0' - 10
+  const __m128i letter = _mm_set1_epi8(39);
+  auto to_hex = [&](__m128i n) {
+    const __m128i gt9 = _mm_and_si128(_mm_cmpgt_epi8(n, nine), letter);
+    return _mm_add_epi8(_mm_add_epi8(n, zero), gt9);
+  };
+  for (; i + 16 <= slen; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi = to_hex(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    const __m128i lo = to_hex(_mm_and_si128(v, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+#elif defined(NODE_STRING_BYTES_NEON)
+  const uint8x16_t mask = vdupq_n_u8(0x0f);
+  const uint8x16_t nine = vdupq_n_u8(9);
+  const uint8x16_t zero = vdupq_n_u8('0');
+  const uint8x16_t letter = vdupq_n_u8(39);
+  auto to_hex = [&](uint8x16_t n) {
+    return vaddq_u8(vaddq_u8(n, zero), vandq_u8(vcgtq_u8(n, nine), letter));
+  };
+  for (; i + 16 <= slen; i += 16) {
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x2_t out;
+    out.val[0] = to_hex(vshrq_n_u8(v, 4));
+    out.val[1] = to_hex(vandq_u8(v, mask));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dst + i * 2), out);
+  }
+#elif defined(NODE_STRING_BYTES_WASM)
+  const v128_t mask = wasm_i8x16_splat(0x0f);
+  const v128_t nine = wasm_i8x16_splat(9);
+  const v128_t zero = wasm_i8x16_splat('0');
+  const v128_t letter = wasm_i8x16_splat(39);
+  auto to_hex = [&](v128_t n) {
+    return wasm_i8x16_add(wasm_i8x16_add(n, zero),
+                          wasm_v128_and(wasm_i8x16_gt(n, nine), letter));
+  };
+  for (; i + 16 <= slen; i += 16) {
+    const v128_t v = wasm_v128_load(src + i);
+    const v128_t hi = to_hex(wasm_u8x16_shr(v, 4));
+    const v128_t lo = to_hex(wasm_v128_and(v, mask));
+    wasm_v128_store(dst + i * 2,
+                    wasm_i8x16_shuffle(hi, lo, 0, 16, 1, 17, 2, 18, 3, 19,
+                                       4, 20, 5, 21, 6, 22, 7, 23));
+    wasm_v128_store(dst + i * 2 + 16,
+                    wasm_i8x16_shuffle(hi, lo, 8, 24, 9, 25, 10, 26, 11, 27,
+                                       12, 28, 13, 29, 14, 30, 15, 31));
+  }
+#endif
+  return i * 2 +
+         nbytes::HexEncode(src + i, slen - i, dst + i * 2, dlen - i * 2);
+}
+
+// Same as nbytes::HexDecode() for one-byte strings. Blocks of 32 characters
+// are decoded at once until a block contains a character that is not a hex
+// digit, the rest is decoded one pair at a time.
+inline size_t HexDecode(char* buf, size_t len, const char* src, size_t srclen) {
+  size_t i = 0;
+#if defined(NODE_STRING_BYTES_SSE2)
+  // Maps each hex digit to its value and clears the lanes of |valid| for the
+  // other characters. SSE2 has no unsigned comparisons other than equality,
+  // so x <= n is computed as min(x, n) == x.
+  auto from_hex = [](__m128i c, __m128i* valid) {
+    const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i is_digit =
+        _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i letter =
+        _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter =
+        _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_andnot_si128(is_digit,
+                         _mm_add_epi8(letter, _mm_set1_epi8(10))));
+  };
+  // Each 16-bit lane holds the value of the high nibble in its low byte.
+  auto pack = [](__m128i v) {
+    return _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00ff)), 4),
+        _mm_srli_epi16(v, 8));
+  };
+  for (; i + 16 <= len && (i + 16) * 2 <= srclen; i += 16) {
+    __m128i valid = _mm_set1_epi8(-1);
+    const __m128i a = from_hex(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)),
+        &valid);
+    const __m128i b = from_hex(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16)),
+        &valid);
+    if (_mm_movemask_epi8(valid) != 0xffff) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i),
+                     _mm_packus_epi16(pack(a), pack(b)));
+  }
+#elif defined(NODE_STRING_BYTES_NEON)
+  auto from_hex = [](uint8x16_t c, uint8x16_t* valid) {
+    const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    const uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t letter =
+        vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_letter = vcleq_u8(letter, vdupq_n_u8(5));
+    *valid = vandq_u8(*valid, vorrq_u8(is_digit, is_letter));
+    return vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+  };
+  for (; i + 16 <= len && (i + 16) * 2 <= srclen; i += 16) {
+    // Separates the high and the low nibble characters.
+    const uint8x16x2_t c =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(src + i * 2));
+    uint8x16_t valid = vdupq_n_u8(0xff);
+    const uint8x16_t hi = from_hex(c.val[0], &valid);
+    const uint8x16_t lo = from_hex(c.val[1], &valid);
+    if (vminvq_u8(valid) != 0xff) break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(buf + i),
+             vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  }
+#elif defined(NODE_STRING_BYTES_WASM)
+  auto from_hex = [](v128_t c, v128_t* valid) {
+    const v128_t digit = wasm_i8x16_sub(c, wasm_i8x16_splat('0'));
+    const v128_t is_digit = wasm_u8x16_le(digit, wasm_i8x16_splat(9));
+    const v128_t letter = wasm_i8x16_sub(
+        wasm_v128_or(c, wasm_i8x16_splat(0x20)), wasm_i8x16_splat('a'));
+    const v128_t is_letter = wasm_u8x16_le(letter, wasm_i8x16_splat(5));
+    *valid = wasm_v128_and(*valid, wasm_v128_or(is_digit, is_letter));
+    return wasm_v128_bitselect(
+        digit, wasm_i8x16_add(letter, wasm_i8x16_splat(10)), is_digit);
+  };
+  auto pack = [](v128_t v) {
+    return wasm_v128_or(
+        wasm_i16x8_shl(wasm_v128_and(v, wasm_i16x8_splat(0x00ff)), 4),
+        wasm_u16x8_shr(v, 8));
+  };
+  for (; i + 16 <= len && (i + 16) * 2 <= srclen; i += 16) {
+    v128_t valid = wasm_i8x16_splat(-1);
+    const v128_t a = from_hex(wasm_v128_load(src + i * 2), &valid);
+    const v128_t b = from_hex(wasm_v128_load(src + i * 2 + 16), &valid);
+    if (!wasm_i8x16_all_true(valid)) break;
+    wasm_v128_store(buf + i, wasm_u8x16_narrow_i16x8(pack(a), pack(b)));
+  }
+#endif
+  return i + nbytes::HexDecode(buf + i, len - i, src + i * 2, srclen - i * 2);
+}
+
+#if defined(NODE_STRING_BYTES_WASM)
+// The characters for 62 and 63.
+inline void Base64Extra(simdutf::base64_options options, char* c62, char* c63) {
+  const bool url = (options & simdutf::base64_url) != 0;
+  *c62 = url ? '-' : '+';
+  *c63 = url ? '_' : '/';
+}
+
+// Encodes 12 bytes from groups of 16 readable bytes of |src| into 16
+// characters each. Returns the number of bytes encoded, a multiple of 3.
+inline size_t Base64EncodeBlocks(const char* src,
+                                 size_t slen,
+                                 char* dst,
+                                 simdutf::base64_options options) {
+  char c62, c63;
+  Base64Extra(options, &c62, &c63);
+  const v128_t zero = wasm_i8x16_splat(0);
+  size_t i = 0;
+  for (char* out = dst; i + 16 <= slen; i += 12, out += 16) {
+    // The 24 bits of each group of 3 bytes, in big-endian order.
+    const v128_t n = wasm_i8x16_shuffle(wasm_v128_load(src + i), zero,
+                                        2, 1, 0, 16, 5, 4, 3, 16,
+                                        8, 7, 6, 16, 11, 10, 9, 16);
+    // One 6-bit index in each byte.
+    const v128_t index = wasm_v128_or(
+        wasm_v128_or(
+            wasm_u32x4_shr(n, 18),
+            wasm_v128_and(wasm_u32x4_shr(n, 4), wasm_i32x4_splat(0x3f00))),
+        wasm_v128_or(
+            wasm_v128_and(wasm_i32x4_shl(n, 10), wasm_i32x4_splat(0x3f0000)),
+            wasm_v128_and(wasm_i32x4_shl(n, 24),
+                          wasm_i32x4_splat(0x3f000000))));
+    // 'A' + index, adjusted for each range of the alphabet.
+    v128_t chars = wasm_i8x16_add(index, wasm_i8x16_splat('A'));
+    auto adjust = [&](int above, int delta) {
+      chars = wasm_i8x16_add(
+          chars,
+          wasm_v128_and(wasm_i8x16_gt(index, wasm_i8x16_splat(above)),
+                        wasm_i8x16_splat(delta)));
+    };
+    adjust(25, 'a' - 26 - 'A');
+    adjust(51, '0' - 52 - ('a' - 26));
+    adjust(61, c62 - 62 - ('0' - 52));
+    adjust(62, c63 - 63 - (c62 - 62));
+    wasm_v128_store(out, chars);
+  }
+  return i;
+}
+
+// Decodes groups of 16 characters of the alphabet of |options| into 12
+// bytes each, as long as |dlen| has space. Stops at the first group with
+// any other character, such as padding or white space. Returns the number of
+// characters decoded, a multiple of 4.
+inline size_t Base64DecodeBlocks(const char* src,
+                                 size_t slen,
+                                 char* dst,
+                                 size_t dlen,
+                                 simdutf::base64_options options) {
+  char c62, c63;
+  Base64Extra(options, &c62, &c63);
+  size_t i = 0;
+  for (size_t o = 0; i + 16 <= slen && o + 12 <= dlen; i += 16, o += 12) {
+    const v128_t c = wasm_v128_load(src + i);
+    auto in_range = [&](char lo, char hi) {
+      return wasm_v128_and(wasm_u8x16_ge(c, wasm_i8x16_splat(lo)),
+                           wasm_u8x16_le(c, wasm_i8x16_splat(hi)));
+    };
+    const v128_t upper = in_range('A', 'Z');
+    const v128_t lower = in_range('a', 'z');
+    const v128_t digit = in_range('0', '9');
+    const v128_t is62 = wasm_i8x16_eq(c, wasm_i8x16_splat(c62));
+    const v128_t is63 = wasm_i8x16_eq(c, wasm_i8x16_splat(c63));
+    const v128_t valid = wasm_v128_or(
+        wasm_v128_or(upper, lower),
+        wasm_v128_or(digit, wasm_v128_or(is62, is63)));
+    if (!wasm_i8x16_all_true(valid)) break;
+    auto offset = [](v128_t mask, int delta) {
+      return wasm_v128_and(mask, wasm_i8x16_splat(delta));
+    };
+    const v128_t values = wasm_i8x16_add(
+        c,
+        wasm_v128_or(
+            wasm_v128_or(offset(upper, -'A'), offset(lower, 26 - 'a')),
+            wasm_v128_or(offset(digit, 52 - '0'),
+                         wasm_v128_or(offset(is62, 62 - c62),
+                                      offset(is63, 63 - c63)))));
+    // Two 6-bit values in each 16-bit lane, then four in each 32-bit lane.
+    const v128_t pairs = wasm_v128_or(
+        wasm_i16x8_shl(wasm_v128_and(values, wasm_i16x8_splat(0x00ff)), 6),
+        wasm_u16x8_shr(values, 8));
+    const v128_t groups = wasm_v128_or(
+        wasm_i32x4_shl(wasm_v128_and(pairs, wasm_i32x4_splat(0xffff)), 12),
+        wasm_u32x4_shr(pairs, 16));
+    const v128_t bytes = wasm_i8x16_shuffle(groups, groups,
+                                            2, 1, 0, 6, 5, 4, 10, 9,
+                                            8, 14, 13, 12, 0, 0, 0, 0);
+    wasm_v128_store64_lane(dst + o, bytes, 0);
+    wasm_v128_store32_lane(dst + o + 8, bytes, 2);
+  }
+  return i;
+}
+#endif  // defined(NODE_STRING_BYTES_WASM)
+
+// Same as simdutf::binary_to_base64().
+inline size_t Base64Encode(
+    const char* src,
+    size_t slen,
+    char* dst,
+    simdutf::base64_options options = simdutf::base64_default) {
+#if defined(NODE_STRING_BYTES_WASM)
+  const size_t done = Base64EncodeBlocks(src, slen, dst, options);
+  return done / 3 * 4 + simdutf::binary_to_base64(
+                            src + done, slen - done, dst + done / 3 * 4,
+                            options);
+#else
+  return simdutf::binary_to_base64(src, slen, dst, options);
+#endif
+}
+
+// Same as simdutf::base64_to_binary().
+inline simdutf::result Base64Decode(
+    const char* src,
+    size_t slen,
+    char* dst,
+    simdutf::base64_options options = simdutf::base64_default) {
+#if defined(NODE_STRING_BYTES_WASM)
+  const size_t done = Base64DecodeBlocks(src, slen, dst, SIZE_MAX, options);
+  simdutf::result result = simdutf::base64_to_binary(
+      src + done, slen - done, dst + done / 4 * 3, options);
+  result.count +=
+      result.error == simdutf::error_code::SUCCESS ? done / 4 * 3 : done;
+  return result;
+#else
+  return simdutf::base64_to_binary(src, slen, dst, options);
+#endif
+}
+
+// Same as simdutf::base64_to_binary_safe().
+inline simdutf::result Base64DecodeSafe(
+    const char* src,
+    size_t slen,
+    char* dst,
+    size_t& dlen,  // NOLINT(runtime/references)
+    simdutf::base64_options options = simdutf::base64_default) {
+#if defined(NODE_STRING_BYTES_WASM)
+  const size_t done = Base64DecodeBlocks(src, slen, dst, dlen, options);
+  const size_t written = done / 4 * 3;
+  size_t rest = dlen - written;
+  simdutf::result result = simdutf::base64_to_binary_safe(
+      src + done, slen - done, dst + written, rest, options);
+  dlen = written + rest;
+  result.count += done;
+  return result;
+#else
+  return simdutf::base64_to_binary_safe(src, slen, dst, dlen, options);
+#endif
+}
+
+// XORs `data` in place with the 4-byte `key`, repeated, as the payload of a
+// masked WebSocket frame is (RFC 6455, section 5.3).
+inline void XorMask(uint8_t* data, size_t length, const uint8_t* key) {
+  uint32_t key32;
+  memcpy(&key32, key, sizeof(key32));
+  size_t i = 0;
+#if defined(NODE_STRING_BYTES_SSE2)
+  const __m128i mask = _mm_set1_epi32(static_cast<int>(key32));
+  for (; i + 16 <= length; i += 16) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i);
+    _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), mask));
+  }
+#elif defined(NODE_STRING_BYTES_NEON)
+  const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(key32));
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(data + i, veorq_u8(vld1q_u8(data + i), mask));
+  }
+#elif defined(NODE_STRING_BYTES_WASM)
+  const v128_t mask = wasm_i32x4_splat(key32);
+  for (; i + 16 <= length; i += 16) {
+    wasm_v128_store(data + i, wasm_v128_xor(wasm_v128_load(data + i), mask));
+  }
+#endif
+  // `i` is a multiple of 4 here, so the key is still aligned with the data.
+  for (; i < length; i++) {
+    data[i] ^= key[i & 3];
+  }
+}
+
+// `bits` must not be 0.
+inline unsigned CountTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return index;
+#else
+  return __builtin_ctzll(bits);
+#endif
+}
+
+// Returns the index of the first '\n', '\r' or 0xe2 (the first byte of
+// U+2028 and U+2029 in UTF-8) in `data` at or after `start`, or `length` if
+// there is none.
+inline size_t FindLineBreakCandidate(const uint8_t* data,
+                                     size_t start,
+                                     size_t length) {
+  size_t i = start;
+#if defined(NODE_STRING_BYTES_SSE2)
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i e2 = _mm_set1_epi8(static_cast<char>(0xe2));
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i match = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)),
+        _mm_cmpeq_epi8(v, e2));
+    int bits = _mm_movemask_epi8(match);
+    if (bits != 0) return i + CountTrailingZeros(bits);
+  }
+#elif defined(NODE_STRING_BYTES_NEON)
+  const uint8x16_t lf = vdupq_n_u8('\n');
+  const uint8x16_t cr = vdupq_n_u8('\r');
+  const uint8x16_t e2 = vdupq_n_u8(0xe2);
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t v = vld1q_u8(data + i);
+    uint8x16_t match =
+        vorrq_u8(vorrq_u8(vceqq_u8(v, lf), vceqq_u8(v, cr)), vceqq_u8(v, e2));
+    // Four bits per byte.
+    uint64_t bits = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+    if (bits != 0) return i + (CountTrailingZeros(bits) >> 2);
+  }
+#elif defined(NODE_STRING_BYTES_WASM)
+  const v128_t lf = wasm_i8x16_splat('\n');
+  const v128_t cr = wasm_i8x16_splat('\r');
+  const v128_t e2 = wasm_i8x16_splat(static_cast<int8_t>(0xe2));
+  for (; i + 16 <= length; i += 16) {
+    v128_t v = wasm_v128_load(data + i);
+    v128_t match = wasm_v128_or(
+        wasm_v128_or(wasm_i8x16_eq(v, lf), wasm_i8x16_eq(v, cr)),
+        wasm_i8x16_eq(v, e2));
+    uint32_t bits = wasm_i8x16_bitmask(match);
+    if (bits != 0) return i + CountTrailingZeros(bits);
+  }
+#endif
+  for (; i < length; i++) {
+    if (data[i] == '\n' || data[i] == '\r' || data[i] == 0xe2) return i;
+  }
+  return length;
+}
+
+// Returns the index of the first '%' or '+' in `data` at or after `start`, or
+// `length` if there is none. These are the only bytes that
+// application/x-www-form-urlencoded decoding changes.
+inline size_t FindFormUrlencodedEscape(const char* data,
+                                       size_t start,
+                                       size_t length) {
+  size_t i = start;
+#if defined(NODE_STRING_BYTES_SSE2)
+  const __m128i percent = _mm_set1_epi8('%');
+  const __m128i plus = _mm_set1_epi8('+');
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i match =
+        _mm_or_si128(_mm_cmpeq_epi8(v, percent), _mm_cmpeq_epi8(v, plus));
+    int bits = _mm_movemask_epi8(match);
+    if (bits != 0) return i + CountTrailingZeros(bits);
+  }
+#elif defined(NODE_STRING_BYTES_NEON)
+  const uint8x16_t percent = vdupq_n_u8('%');
+  const uint8x16_t plus = vdupq_n_u8('+');
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+    uint8x16_t match = vorrq_u8(vceqq_u8(v, percent), vceqq_u8(v, plus));
+    // Four bits per byte.
+    uint64_t bits = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+    if (bits != 0) return i + (CountTrailingZeros(bits) >> 2);
+  }
+#elif defined(NODE_STRING_BYTES_WASM)
+  const v128_t percent = wasm_i8x16_splat('%');
+  const v128_t plus = wasm_i8x16_splat('+');
+  for (; i + 16 <= length; i += 16) {
+    v128_t v = wasm_v128_load(data + i);
+    v128_t match =
+        wasm_v128_or(wasm_i8x16_eq(v, percent), wasm_i8x16_eq(v, plus));
+    uint32_t bits = wasm_i8x16_bitmask(match);
+    if (bits != 0) return i + CountTrailingZeros(bits);
+  }
+#endif
+  for (; i < length; i++) {
+    if (data[i] == '%' || data[i] == '+') return i;
+  }
+  return length;
+}
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_STRING_BYTES_SIMD_H_
@@ -5,6 +5,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "simdutf.h"
 #include "string_bytes.h"
 #include "util.h"
 
@@ -24,11 +25,34 @@ namespace node {
 
 namespace {
 
+// Non-ASCII UTF-8 chunks that decode to at least this many UTF-16 code units
+// are created as external strings, which V8 does not copy into its heap, and
+// which can be part of a cons string like any other string.
+constexpr size_t kExternalUTF16Length = 1024 * 1024;
+
 MaybeLocal<String> MakeString(Isolate* isolate,
                               const char* data,
                               size_t length,
                               enum encoding encoding) {
   MaybeLocal<Value> ret;
+  if (encoding == UTF8 && simdutf::validate_ascii(data, length)) {
+    // ASCII is also Latin-1, which does not have to be decoded.
+    encoding = LATIN1;
+  } else if (encoding == UTF8 && length >= kExternalUTF16Length) {
+    const size_t utf16_length = simdutf::utf16_length_from_utf8(data, length);
+    if (utf16_length >= kExternalUTF16Length) {
+      MaybeStackBuffer<uint16_t> utf16(utf16_length);
+      // This fails for invalid UTF-8, which is left to V8 to replace.
+      if (simdutf::convert_utf8_to_utf16le(
+              data, length, reinterpret_cast<char16_t*>(utf16.out())) ==
+          utf16_length) {
+        ret = StringBytes::Encode(isolate, utf16.out(), utf16_length);
+        if (ret.IsEmpty()) return {};
+        return ret.ToLocalChecked().As<String>();
+      }
+    }
+  }
+
   if (encoding == UTF8) {
     MaybeLocal<String> utf8_string;
     if (length <= static_cast<size_t>(v8::String::kMaxLength)) {
@@ -0,0 +1,228 @@
+#ifndef SRC_STRING_SEARCH_H_
+#define SRC_STRING_SEARCH_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "nbytes.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NODE_STRING_SEARCH_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NODE_STRING_SEARCH_NEON 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define NODE_STRING_SEARCH_WASM 1
+#endif
+
+namespace node {
+namespace stringsearch {
+
+// Returned by FirstLastSearch() when it stopped because of too many
+// candidates that did not match.
+constexpr size_t kGaveUp = SIZE_MAX;
+
+// Forward search for multi-byte needles. 16 positions are checked at once by
+// comparing the bytes at each position with the first byte of the needle and
+// the bytes at the position of the last byte of the needle with its last
+// byte. Only the positions where both match are compared with the rest of the
+// needle. Returns the position of the first match at or after |start|, or
+// |haystack_length| if there is none.
+//
+// Inputs such as long runs of the same byte can make most positions
+// candidates. When the comparisons that fail outweigh the bytes skipped,
+// this stops, stores the position to continue from in |*resume| and returns
+// kGaveUp, so that the caller can use an algorithm with better worst case
+// behavior.
+inline size_t FirstLastSearch(const uint8_t* haystack,
+                              size_t haystack_length,
+                              const uint8_t* needle,
+                              size_t needle_length,
+                              size_t start,
+                              size_t* resume) {
+  // The last position that a match can start at, plus one.
+  const size_t end = haystack_length - needle_length + 1;
+  const uint8_t first = needle[0];
+  const uint8_t last = needle[needle_length - 1];
+  const uint8_t* const middle = needle + 1;
+  const size_t middle_length = needle_length - 2;
+
+  // Each comparison that fails costs up to |needle_length| byte comparisons.
+  size_t wasted = 0;
+  auto matches = [&](size_t i) {
+    if (memcmp(haystack + i + 1, middle, middle_length) == 0) return true;
+    wasted += needle_length;
+    return false;
+  };
+  auto give_up = [&](size_t i) { return wasted > 1024 + 2 * (i - start); };
+
+  size_t i = start;
+#if defined(NODE_STRING_SEARCH_SSE2) || defined(NODE_STRING_SEARCH_NEON) || \
+    defined(NODE_STRING_SEARCH_WASM)
+  constexpr size_t kBlock = 16;
+#if defined(NODE_STRING_SEARCH_SSE2)
+  const __m128i first_block = _mm_set1_epi8(static_cast<char>(first));
+  const __m128i last_block = _mm_set1_epi8(static_cast<char>(last));
+#elif defined(NODE_STRING_SEARCH_NEON)
+  const uint8x16_t first_block = vdupq_n_u8(first);
+  const uint8x16_t last_block = vdupq_n_u8(last);
+#else
+  const v128_t first_block = wasm_i8x16_splat(first);
+  const v128_t last_block = wasm_i8x16_splat(last);
+#endif
+  for (; i + kBlock <= end; i += kBlock) {
+    const uint8_t* p = haystack + i;
+    // One bit, or for NEON one nibble, for each position in the block.
+#if defined(NODE_STRING_SEARCH_SSE2)
+    const __m128i eq_first = _mm_cmpeq_epi8(
+        first_block, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    const __m128i eq_last = _mm_cmpeq_epi8(
+        last_block,
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(p + needle_length - 1)));
+    uint64_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+    constexpr unsigned kShift = 0;
+#elif defined(NODE_STRING_SEARCH_NEON)
+    const uint8x16_t eq = vandq_u8(
+        vceqq_u8(first_block, vld1q_u8(p)),
+        vceqq_u8(last_block, vld1q_u8(p + needle_length - 1)));
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    constexpr unsigned kShift = 2;
+#else
+    const v128_t eq = wasm_v128_and(
+        wasm_i8x16_eq(first_block, wasm_v128_load(p)),
+        wasm_i8x16_eq(last_block, wasm_v128_load(p + needle_length - 1)));
+    uint64_t mask = wasm_i8x16_bitmask(eq);
+    constexpr unsigned kShift = 0;
+#endif
+    while (mask != 0) {
+      const size_t offset = std::countr_zero(mask) >> kShift;
+      if (matches(i + offset)) return i + offset;
+#if defined(NODE_STRING_SEARCH_NEON)
+      mask &= ~(uint64_t{0xf} << (offset << kShift));
+#else
+      mask &= mask - 1;
+#endif
+    }
+    if (give_up(i + kBlock)) {
+      *resume = i + kBlock;
+      return kGaveUp;
+    }
+  }
+#endif  // SIMD
+
+  for (; i < end; i++) {
+    if (haystack[i] == first && haystack[i + needle_length - 1] == last) {
+      if (matches(i)) return i;
+      if (give_up(i + 1)) {
+        *resume = i + 1;
+        return kGaveUp;
+      }
+    }
+  }
+  return haystack_length;
+}
+
+// Like nbytes::SearchString(), but uses FirstLastSearch() for forward
+// searches of needles of at least two bytes.
+inline size_t SearchString(const uint8_t* haystack,
+                           size_t haystack_length,
+                           const uint8_t* needle,
+                           size_t needle_length,
+                           size_t start_index,
+                           bool is_forward) {
+  if (is_forward && needle_length >= 2 && haystack_length >= needle_length) {
+    size_t resume;
+    const size_t pos = FirstLastSearch(
+        haystack, haystack_length, needle, needle_length, start_index, &resume);
+    if (pos != kGaveUp) return pos;
+    start_index = resume;
+  }
+  return nbytes::SearchString(
+      haystack, haystack_length, needle, needle_length, start_index,
+      is_forward);
+}
+
+// A needle that is searched for repeatedly. It keeps a copy of the needle
+// and the tables of the Boyer-Moore searches that are used for backward
+// searches and as the fallback of forward searches, so that they are only
+// set up once.
+class CompiledNeedle {
+ public:
+  CompiledNeedle(const uint8_t* data, size_t length)
+      : needle_(data, data + length) {}
+
+  CompiledNeedle(const CompiledNeedle&) = delete;
+  CompiledNeedle& operator=(const CompiledNeedle&) = delete;
+
+  const uint8_t* data() const { return needle_.data(); }
+  size_t length() const { return needle_.size(); }
+
+  // Same as SearchString() with this needle.
+  size_t Search(const uint8_t* haystack,
+                size_t haystack_length,
+                size_t start_index,
+                bool is_forward) {
+    const size_t needle_length = needle_.size();
+    if (haystack_length < needle_length) return haystack_length;
+    if (is_forward) {
+      if (needle_length >= 2) {
+        size_t resume;
+        const size_t pos = FirstLastSearch(haystack,
+                                           haystack_length,
+                                           needle_.data(),
+                                           needle_length,
+                                           start_index,
+                                           &resume);
+        if (pos != kGaveUp) return pos;
+        start_index = resume;
+      }
+      return GetSearch(true)->Search(
+          Vector(haystack, haystack_length, true), start_index);
+    }
+
+    // Search for the reversed needle in the reversed haystack, see
+    // nbytes::SearchString().
+    const size_t diff = haystack_length - needle_length;
+    const size_t relative_start_index =
+        diff < start_index ? 0 : diff - start_index;
+    const size_t pos = GetSearch(false)->Search(
+        Vector(haystack, haystack_length, false), relative_start_index);
+    if (pos == haystack_length) return pos;
+    return haystack_length - needle_length - pos;
+  }
+
+ private:
+  using Vector = nbytes::stringsearch::Vector<const uint8_t>;
+  using Searcher = nbytes::stringsearch::StringSearch<uint8_t>;
+
+  Searcher* GetSearch(bool is_forward) {
+    std::unique_ptr<Searcher>& search = is_forward ? forward_ : backward_;
+    if (!search) {
+      search = std::make_unique<Searcher>(
+          Vector(needle_.data(), needle_.size(), is_forward));
+    }
+    return search.get();
+  }
+
+  const std::vector<uint8_t> needle_;
+  std::unique_ptr<Searcher> forward_;
+  std::unique_ptr<Searcher> backward_;
+};
+
+}  // namespace stringsearch
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_STRING_SEARCH_H_
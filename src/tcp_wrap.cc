@@ -25,29 +25,39 @@
 #include "connection_wrap.h"
 #include "env-inl.h"
 #include "handle_wrap.h"
+#include "histogram-inl.h"
 #include "node_buffer.h"
+#include "node_diagnostics_channel.h"
 #include "node_external_reference.h"
 #include "node_internals.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
+#include "timer_wrap-inl.h"
 #include "util-inl.h"
 
 #include <cstdlib>
+#include <type_traits>
 
 
 namespace node {
 
+using v8::Array;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::LocalVector;
 using v8::MaybeLocal;
+using v8::Name;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
@@ -106,6 +116,8 @@ void TCPWrap::Initialize(Local<Object> target,
   SetProtoMethod(isolate, t, "setNoDelay", SetNoDelay);
   SetProtoMethod(isolate, t, "setKeepAlive", SetKeepAlive);
   SetProtoMethod(isolate, t, "reset", Reset);
+  SetProtoMethod(isolate, t, "createAcceptHistogram", CreateAcceptHistogram);
+  SetProtoMethod(isolate, t, "setConnectionRateLimit", SetConnectionRateLimit);
 
 #ifdef _WIN32
   SetProtoMethod(isolate, t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -126,6 +138,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
+  TCPConnectRace::Initialize(env, target, constants);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -145,9 +158,12 @@ void TCPWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SetNoDelay);
   registry->Register(SetKeepAlive);
   registry->Register(Reset);
+  registry->Register(CreateAcceptHistogram);
+  registry->Register(SetConnectionRateLimit);
 #ifdef _WIN32
   registry->Register(SetSimultaneousAccepts);
 #endif
+  TCPConnectRace::RegisterExternalReferences(registry);
 }
 
 void TCPWrap::New(const FunctionCallbackInfo<Value>& args) {
@@ -355,6 +371,22 @@ void TCPWrap::Connect(const FunctionCallbackInfo<Value>& args,
                                         TRACE_STR_COPY(*ip_address),
                                         "port",
                                         port);
+      if (diagnostics_channel::HasSubscribers(
+              env, diagnostics_channel::kNetNativeConnect)) {
+        Isolate* isolate = env->isolate();
+        Local<Name> names[] = {
+            env->address_string(), env->port_string(), env->family_string()};
+        Local<Value> values[] = {
+            args[1],
+            Integer::NewFromUnsigned(isolate, port),
+            std::is_same_v<T, sockaddr_in6> ? env->ipv6_string()
+                                            : env->ipv4_string()};
+        diagnostics_channel::Publish(
+            env,
+            diagnostics_channel::kNetNativeConnect,
+            Object::New(
+                isolate, Null(isolate), names, values, arraysize(names)));
+      }
     }
   }
 
@@ -373,6 +405,7 @@ void TCPWrap::Reset(const FunctionCallbackInfo<Value>& args) {
 int TCPWrap::Reset(Local<Value> close_callback) {
   if (state_ != kInitialized) return 0;
 
+  CancelPendingIo();
   int err = uv_tcp_close_reset(&handle_, OnClose);
   state_ = kClosing;
   if (!err & !close_callback.IsEmpty() && close_callback->IsFunction() &&
@@ -384,6 +417,294 @@ int TCPWrap::Reset(Local<Value> close_callback) {
   return err;
 }
 
+void TCPWrap::CreateAcceptHistogram(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  Environment* env = wrap->env();
+
+  // All histograms created for this handle observe the same data.
+  if (!wrap->accept_histogram_)
+    wrap->accept_histogram_ = std::make_shared<Histogram>(Histogram::Options{});
+
+  BaseObjectPtr<HistogramBase> histogram =
+      HistogramBase::Create(env, wrap->accept_histogram_);
+  if (histogram)
+    args.GetReturnValue().Set(histogram->object());
+}
+
+void TCPWrap::SetConnectionRateLimit(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.This());
+  CHECK(args[0]->IsNumber());  // rate
+  CHECK(args[1]->IsNumber());  // burst
+  CHECK(args[2]->IsUint32());  // maxAddresses
+  wrap->rate_limiter_ = std::make_unique<SocketAddressRateLimiter>(
+      args[0].As<Number>()->Value(),
+      args[1].As<Number>()->Value(),
+      args[2].As<Uint32>()->Value());
+}
+
+TCPConnectRace::TCPConnectRace(Environment* env, Local<Object> object)
+    : AsyncWrap(env, object, PROVIDER_TCPCONNECTWRAP),
+      timer_(env, [this] { OnAttemptTimeout(); }) {
+  MakeWeak();
+  timer_.Unref();
+}
+
+void TCPConnectRace::Initialize(Environment* env,
+                                Local<Object> target,
+                                Local<Object> constants) {
+  Isolate* isolate = env->isolate();
+  Local<FunctionTemplate> t = NewFunctionTemplate(isolate, New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      TCPConnectRace::kInternalFieldCount);
+  t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, t, "start", Start);
+  SetProtoMethod(isolate, t, "cancel", Cancel);
+  SetConstructorFunction(env->context(), target, "TCPConnectRace", t);
+
+  NODE_DEFINE_CONSTANT(constants, kAttemptStarted);
+  NODE_DEFINE_CONSTANT(constants, kAttemptFailed);
+  NODE_DEFINE_CONSTANT(constants, kAttemptTimedOut);
+}
+
+void TCPConnectRace::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Start);
+  registry->Register(Cancel);
+}
+
+void TCPConnectRace::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("addresses", addresses_);
+  tracker->TrackFieldWithSize("attempts", attempts_.size() * sizeof(Attempt));
+  tracker->TrackField("timer", timer_);
+}
+
+void TCPConnectRace::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new TCPConnectRace(env, args.This());
+}
+
+void TCPConnectRace::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  TCPConnectRace* race;
+  ASSIGN_OR_RETURN_UNWRAP(&race, args.This());
+  CHECK(!race->self_ref_);
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsUint32());
+
+  TCPWrap* first;
+  ASSIGN_OR_RETURN_UNWRAP(
+      &first, args[0], args.GetReturnValue().Set(UV_EBADF));
+
+  Local<Array> addresses = args[1].As<Array>();
+  const uint32_t length = addresses->Length();
+  CHECK_EQ(length % 2, 0);
+  for (uint32_t i = 0; i < length; i += 2) {
+    Local<Value> address;
+    Local<Value> family;
+    if (!addresses->Get(env->context(), i).ToLocal(&address) ||
+        !addresses->Get(env->context(), i + 1).ToLocal(&family)) {
+      return;
+    }
+    CHECK(address->IsString());
+    CHECK(family->IsInt32());
+    race->addresses_.emplace_back(*Utf8Value(env->isolate(), address));
+    race->families_.push_back(family.As<Int32>()->Value());
+  }
+  CHECK(!race->addresses_.empty());
+
+  race->first_.reset(first);
+  race->port_ = static_cast<int>(args[2].As<Uint32>()->Value());
+  race->attempt_delay_ = args[3].As<Uint32>()->Value();
+  race->report_attempts_ = args[4]->IsTrue();
+  race->self_ref_.reset(race);
+  race->StartNextAttempt();
+  race->MaybeRelease();
+}
+
+void TCPConnectRace::Cancel(const FunctionCallbackInfo<Value>& args) {
+  TCPConnectRace* race;
+  ASSIGN_OR_RETURN_UNWRAP(&race, args.This());
+  if (!race->self_ref_ || race->finished_) return;
+  race->Stop(nullptr);
+  race->MaybeRelease();
+}
+
+int TCPConnectRace::Connect(size_t index) {
+  TCPWrap* wrap = first_.get();
+  if (index > 0) {
+    Local<Object> object;
+    if (!TCPWrap::Instantiate(env(), this, TCPWrap::SOCKET).ToLocal(&object))
+      return UV_ENOMEM;
+    wrap = Unwrap<TCPWrap>(object);
+    if (wrap == nullptr) return UV_EBADF;
+  }
+
+  sockaddr_storage addr;
+  const char* address = addresses_[index].c_str();
+  int err = families_[index] == 6
+                ? uv_ip6_addr(address,
+                              port_,
+                              reinterpret_cast<sockaddr_in6*>(&addr))
+                : uv_ip4_addr(address,
+                              port_,
+                              reinterpret_cast<sockaddr_in*>(&addr));
+
+  auto attempt = std::make_unique<Attempt>();
+  attempt->race = this;
+  attempt->index = index;
+  attempt->wrap.reset(wrap);
+  if (err == 0) {
+    err = uv_tcp_connect(&attempt->req,
+                         &wrap->handle_,
+                         reinterpret_cast<const sockaddr*>(&addr),
+                         OnConnect);
+  }
+  if (err != 0) {
+    if (index > 0) wrap->Close();
+    return err;
+  }
+  attempt->req.data = attempt.get();
+  attempts_.push_back(std::move(attempt));
+  pending_++;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(TRACING_CATEGORY_NODE2(net, native),
+                                    "connect",
+                                    attempts_.back().get(),
+                                    "ip",
+                                    TRACE_STR_COPY(address),
+                                    "port",
+                                    port_);
+  return 0;
+}
+
+void TCPConnectRace::StartNextAttempt() {
+  timer_.Stop();
+  while (!finished_ && next_ < addresses_.size()) {
+    const size_t index = next_++;
+    Report(kAttemptStarted, index);
+    if (finished_) return;
+    const int err = Connect(index);
+    if (err == 0) {
+      // The last attempt is only limited by the operating system's timeout.
+      if (next_ < addresses_.size()) timer_.Update(attempt_delay_);
+      return;
+    }
+    errors_.push_back(static_cast<int>(index));
+    errors_.push_back(err);
+    Report(kAttemptFailed, index, err);
+  }
+  if (!finished_ && pending_ == 0) Finish(nullptr);
+}
+
+void TCPConnectRace::OnConnect(uv_connect_t* req, int status) {
+  Attempt* attempt = static_cast<Attempt*>(req->data);
+  TCPConnectRace* race = attempt->race;
+  Environment* env = race->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  TRACE_EVENT_NESTABLE_ASYNC_END1(TRACING_CATEGORY_NODE2(net, native),
+                                  "connect",
+                                  attempt,
+                                  "status",
+                                  status);
+
+  race->pending_--;
+  if (!race->finished_) {
+    if (status == 0) {
+      race->Finish(attempt);
+    } else {
+      race->OnAttemptFailed(attempt, status);
+    }
+  }
+  race->MaybeRelease();
+}
+
+void TCPConnectRace::OnAttemptFailed(Attempt* attempt, int status) {
+  errors_.push_back(static_cast<int>(attempt->index));
+  errors_.push_back(status);
+  if (attempt->index > 0) attempt->wrap->Close();
+  Report(kAttemptFailed, attempt->index, status);
+  StartNextAttempt();
+}
+
+void TCPConnectRace::OnAttemptTimeout() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  Report(kAttemptTimedOut, next_ - 1);
+  StartNextAttempt();
+  MaybeRelease();
+}
+
+void TCPConnectRace::Report(AttemptEvent event, size_t index, int status) {
+  if (!report_attempts_) return;
+  Isolate* isolate = env()->isolate();
+  Local<Value> argv[] = {
+      Integer::New(isolate, event),
+      Integer::New(isolate, static_cast<int32_t>(index)),
+      Integer::New(isolate, status),
+  };
+  MakeCallback(FIXED_ONE_BYTE_STRING(isolate, "onattempt"),
+               arraysize(argv),
+               argv);
+}
+
+void TCPConnectRace::Stop(Attempt* winner) {
+  finished_ = true;
+  timer_.Stop();
+  // The first handle belongs to the socket, which closes it itself when it
+  // did not win. Closing a handle also cancels its pending connect request.
+  for (const auto& attempt : attempts_) {
+    if (attempt.get() != winner && attempt->index > 0)
+      attempt->wrap->Close();
+  }
+}
+
+void TCPConnectRace::Finish(Attempt* winner) {
+  Stop(winner);
+
+  Isolate* isolate = env()->isolate();
+  LocalVector<Value> errors(isolate);
+  errors.reserve(errors_.size());
+  for (int value : errors_) errors.push_back(Integer::New(isolate, value));
+
+  bool readable = false;
+  bool writable = false;
+  Local<Value> handle = Undefined(isolate);
+  int index = -1;
+  if (winner != nullptr) {
+    uv_stream_t* stream =
+        reinterpret_cast<uv_stream_t*>(&winner->wrap->handle_);
+    readable = uv_is_readable(stream) != 0;
+    writable = uv_is_writable(stream) != 0;
+    handle = winner->wrap->object();
+    index = static_cast<int>(winner->index);
+  }
+
+  Local<Value> argv[] = {
+      Integer::New(isolate, winner != nullptr ? 0 : errors_.back()),
+      handle,
+      Integer::New(isolate, index),
+      Boolean::New(isolate, readable),
+      Boolean::New(isolate, writable),
+      Array::New(isolate, errors.data(), errors.size()),
+      Integer::New(isolate, static_cast<int32_t>(next_)),
+  };
+  MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+}
+
+void TCPConnectRace::MaybeRelease() {
+  if (!finished_ || pending_ > 0) return;
+  timer_.Stop();
+  attempts_.clear();
+  first_.reset();
+  self_ref_.reset();
+}
+
 // also used by udp_wrap.cc
 MaybeLocal<Object> AddressToJS(Environment* env,
                                const sockaddr* addr,
@@ -26,6 +26,11 @@
 
 #include "async_wrap.h"
 #include "connection_wrap.h"
+#include "timer_wrap.h"
+
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace node {
 
@@ -64,6 +69,8 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
  private:
   typedef uv_tcp_t HandleType;
 
+  friend class TCPConnectRace;
+
   template <typename T,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
@@ -89,6 +96,10 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
       int family,
       std::function<int(const char* ip_address, int port, T* addr)> uv_ip_addr);
   static void Reset(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CreateAcceptHistogram(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetConnectionRateLimit(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   int Reset(v8::Local<v8::Value> close_callback = v8::Local<v8::Value>());
 
 #ifdef _WIN32
@@ -97,6 +108,79 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
 #endif
 };
 
+// Connects to the first address that accepts a connection out of a list,
+// following Happy Eyeballs (RFC 8305): a new attempt is started whenever the
+// previous one fails or has not completed within the attempt delay, while
+// the earlier attempts keep running. Every attempt but the first uses a new
+// TCP handle. Only the handle that won is handed to JavaScript, through a
+// single oncomplete(status, handle, index, readable, writable, errors,
+// attempted) call, and the others are closed. The per attempt onattempt()
+// callbacks are only made when requested.
+class TCPConnectRace final : public AsyncWrap {
+ public:
+  enum AttemptEvent {
+    kAttemptStarted,
+    kAttemptFailed,
+    kAttemptTimedOut,
+  };
+
+  static void Initialize(Environment* env,
+                         v8::Local<v8::Object> target,
+                         v8::Local<v8::Object> constants);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(TCPConnectRace)
+  SET_SELF_SIZE(TCPConnectRace)
+
+ private:
+  struct Attempt {
+    TCPConnectRace* race;
+    size_t index;
+    BaseObjectPtr<TCPWrap> wrap;
+    uv_connect_t req;
+  };
+
+  TCPConnectRace(Environment* env, v8::Local<v8::Object> object);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // start(handle, addresses, port, attemptDelay, reportAttempts), where
+  // |addresses| is a flat [address, family, ...] array and |handle| is used
+  // for the first attempt.
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Stops the race without calling into JavaScript again.
+  static void Cancel(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OnConnect(uv_connect_t* req, int status);
+
+  void StartNextAttempt();
+  int Connect(size_t index);
+  void OnAttemptFailed(Attempt* attempt, int status);
+  void OnAttemptTimeout();
+  void Report(AttemptEvent event, size_t index, int status = 0);
+  // Ends the race, closing the handles of all the attempts but |winner|.
+  void Stop(Attempt* winner);
+  // Stops the race and calls oncomplete with |winner|, or with the errors of
+  // all the attempts if it is null.
+  void Finish(Attempt* winner);
+  // Drops the references that keep the race alive once it has ended and the
+  // connect requests of all its attempts have completed.
+  void MaybeRelease();
+
+  BaseObjectPtr<TCPConnectRace> self_ref_;
+  BaseObjectPtr<TCPWrap> first_;
+  std::vector<std::string> addresses_;
+  std::vector<int> families_;
+  std::vector<std::unique_ptr<Attempt>> attempts_;
+  // Flat [index, status, ...] list of the attempts that failed.
+  std::vector<int> errors_;
+  TimerWrapHandle timer_;
+  uint64_t attempt_delay_ = 0;
+  int port_ = 0;
+  size_t next_ = 0;
+  size_t pending_ = 0;
+  bool report_attempts_ = false;
+  bool finished_ = false;
+};
 
 }  // namespace node
 
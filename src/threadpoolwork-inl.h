@@ -24,6 +24,8 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "env-inl.h"
+#include "histogram-inl.h"
 #include "node_internals.h"
 #include "tracing/trace_event.h"
 #include "util-inl.h"
@@ -34,6 +36,56 @@ void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
   TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
       TRACING_CATEGORY_NODE2(threadpoolwork, async), type_, this);
+  is_scheduled_ = true;
+  schedule_time_ = uv_hrtime();
+  start_time_ = 0;
+  ThreadPoolWorkClassState* state = env_->threadpool_work_class(work_class_);
+  if (state->limit != 0 && state->running >= state->limit) {
+    AddPending(state);
+    return;
+  }
+  QueueWork();
+}
+
+void ThreadPoolWork::set_work_class(ThreadPoolWorkClass work_class) {
+  CHECK(!is_scheduled_);
+  work_class_ = work_class;
+}
+
+uint64_t ThreadPoolWork::queue_wait_time() const {
+  return start_time_ == 0 ? 0 : start_time_ - schedule_time_;
+}
+
+void ThreadPoolWork::AddPending(ThreadPoolWorkClassState* state) {
+  is_pending_ = true;
+  pending_prev_ = state->pending_tail;
+  pending_next_ = nullptr;
+  if (state->pending_tail != nullptr) {
+    state->pending_tail->pending_next_ = this;
+  } else {
+    state->pending_head = this;
+  }
+  state->pending_tail = this;
+}
+
+void ThreadPoolWork::RemovePending(ThreadPoolWorkClassState* state) {
+  if (pending_prev_ != nullptr) {
+    pending_prev_->pending_next_ = pending_next_;
+  } else {
+    state->pending_head = pending_next_;
+  }
+  if (pending_next_ != nullptr) {
+    pending_next_->pending_prev_ = pending_prev_;
+  } else {
+    state->pending_tail = pending_prev_;
+  }
+  pending_prev_ = nullptr;
+  pending_next_ = nullptr;
+  is_pending_ = false;
+}
+
+void ThreadPoolWork::QueueWork() {
+  env_->threadpool_work_class(work_class_)->running++;
   int status = uv_queue_work(
       env_->event_loop(),
       &work_req_,
@@ -41,26 +93,60 @@ void ThreadPoolWork::ScheduleWork() {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         TRACE_EVENT_BEGIN0(TRACING_CATEGORY_NODE2(threadpoolwork, sync),
                            self->type_);
+        self->start_time_ = uv_hrtime();
         self->DoThreadPoolWork();
+        self->end_time_ = uv_hrtime();
         TRACE_EVENT_END0(TRACING_CATEGORY_NODE2(threadpoolwork, sync),
                          self->type_);
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
-        self->env_->DecreaseWaitingRequestCounter();
-        TRACE_EVENT_NESTABLE_ASYNC_END1(
-            TRACING_CATEGORY_NODE2(threadpoolwork, async),
-            self->type_,
-            self,
-            "result",
-            status);
-        self->AfterThreadPoolWork(status);
+        self->env_->threadpool_work_class(self->work_class_)->running--;
+        self->OnWorkDone(status);
       });
   CHECK_EQ(status, 0);
 }
 
+void ThreadPoolWork::OnWorkDone(int status) {
+  is_scheduled_ = false;
+  ThreadPoolWorkClassState* state = env_->threadpool_work_class(work_class_);
+  if (status == 0) {
+    if (state->queue_wait) {
+      state->queue_wait->Record(
+          static_cast<int64_t>(start_time_ - schedule_time_));
+    }
+    if (state->run_time) {
+      state->run_time->Record(static_cast<int64_t>(end_time_ - start_time_));
+    }
+  }
+
+  // Let the next work item of the class take the freed slot before this one
+  // is possibly deleted by AfterThreadPoolWork().
+  if (state->pending_head != nullptr && state->running < state->limit) {
+    ThreadPoolWork* next = state->pending_head;
+    next->RemovePending(state);
+    next->QueueWork();
+  }
+
+  env_->DecreaseWaitingRequestCounter();
+  TRACE_EVENT_NESTABLE_ASYNC_END1(
+      TRACING_CATEGORY_NODE2(threadpoolwork, async),
+      type_,
+      this,
+      "result",
+      status);
+  AfterThreadPoolWork(status);
+}
+
 int ThreadPoolWork::CancelWork() {
-  return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
+  if (!is_pending_) {
+    return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
+  }
+  // The work has not reached the threadpool yet. Like uv_cancel(), report
+  // the cancellation asynchronously.
+  RemovePending(env_->threadpool_work_class(work_class_));
+  env_->SetImmediate([this](Environment* env) { OnWorkDone(UV_ECANCELED); });
+  return 0;
 }
 
 }  // namespace node
@@ -0,0 +1,188 @@
+#include "timer_wheel.h"
+
+#include "util.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace node {
+namespace timers {
+
+void TimerWheel::Schedule(uint32_t id, uint64_t expiry) {
+  CHECK_NE(id, kNoEntry);
+  if (id >= entries_.size()) entries_.resize(id + 1);
+  Entry& entry = entries_[id];
+  if (entry.scheduled) {
+    Unlink(id);
+  } else {
+    entry.scheduled = true;
+    size_++;
+  }
+  entry.expiry = expiry;
+  entry.sequence = next_sequence_++;
+  Place(id);
+}
+
+void TimerWheel::Cancel(uint32_t id) {
+  if (!IsScheduled(id)) return;
+  Unlink(id);
+  entries_[id].scheduled = false;
+  size_--;
+}
+
+void TimerWheel::Place(uint32_t id) {
+  Entry& entry = entries_[id];
+  uint64_t expiry = entry.expiry;
+  uint64_t diff = expiry ^ now_;
+
+  List* list;
+  if (expiry <= now_) {
+    entry.level = kDueLevel;
+    entry.slot = 0;
+    list = &due_;
+  } else if ((diff >> (kLevelBits * kLevels)) != 0) {
+    entry.level = kOverflowLevel;
+    entry.slot = 0;
+    list = &overflow_;
+  } else {
+    int level = 0;
+    while ((diff >> (kLevelBits * (level + 1))) != 0) level++;
+    uint32_t slot = (expiry >> (kLevelBits * level)) & kSlotMask;
+    entry.level = level;
+    entry.slot = slot;
+    occupied_[level] |= uint64_t{1} << slot;
+    list = &slots_[level][slot];
+  }
+
+  entry.next = kNoEntry;
+  entry.prev = list->tail;
+  if (list->tail != kNoEntry) {
+    entries_[list->tail].next = id;
+  } else {
+    list->head = id;
+  }
+  list->tail = id;
+}
+
+TimerWheel::List* TimerWheel::ListOf(const Entry& entry) {
+  if (entry.level == kOverflowLevel) return &overflow_;
+  if (entry.level == kDueLevel) return &due_;
+  return &slots_[entry.level][entry.slot];
+}
+
+void TimerWheel::Unlink(uint32_t id) {
+  Entry& entry = entries_[id];
+  List* list = ListOf(entry);
+  if (entry.prev != kNoEntry) {
+    entries_[entry.prev].next = entry.next;
+  } else {
+    list->head = entry.next;
+  }
+  if (entry.next != kNoEntry) {
+    entries_[entry.next].prev = entry.prev;
+  } else {
+    list->tail = entry.prev;
+  }
+  if (list->head == kNoEntry && entry.level < kLevels) {
+    occupied_[entry.level] &= ~(uint64_t{1} << entry.slot);
+  }
+  entry.prev = entry.next = kNoEntry;
+}
+
+uint64_t TimerWheel::NextEvent() const {
+  uint64_t next = kNoExpiry;
+  for (int level = 0; level < kLevels; level++) {
+    // Only the slots after the current one of a level can have entries.
+    uint32_t current = (now_ >> (kLevelBits * level)) & kSlotMask;
+    if (current == kSlotMask) continue;
+    uint64_t pending = occupied_[level] & (~uint64_t{0} << (current + 1));
+    if (pending == 0) continue;
+    int span = kLevelBits * (level + 1);
+    uint64_t slot = std::countr_zero(pending);
+    next = std::min(next,
+                    ((now_ >> span) << span) | (slot << (kLevelBits * level)));
+  }
+  if (overflow_.head != kNoEntry) {
+    int span = kLevelBits * kLevels;
+    next = std::min(next, ((now_ >> span) + 1) << span);
+  }
+  return next;
+}
+
+void TimerWheel::Drain(List* list, std::vector<uint32_t>* expired) {
+  uint32_t id = list->head;
+  list->head = list->tail = kNoEntry;
+  while (id != kNoEntry) {
+    Entry& entry = entries_[id];
+    uint32_t next = entry.next;
+    entry.prev = entry.next = kNoEntry;
+    if (entry.expiry <= now_) {
+      entry.scheduled = false;
+      size_--;
+      expired->push_back(id);
+    } else {
+      Place(id);
+    }
+    id = next;
+  }
+}
+
+void TimerWheel::Expire(uint64_t now, std::vector<uint32_t>* expired) {
+  size_t first = expired->size();
+  Drain(&due_, expired);
+  while (now_ < now) {
+    uint64_t next = NextEvent();
+    if (next > now) {
+      now_ = now;
+      break;
+    }
+    now_ = next;
+
+    // Higher levels first, so that their entries can move down into the
+    // slots that are due at the same time.
+    if ((now_ & ((uint64_t{1} << (kLevelBits * kLevels)) - 1)) == 0) {
+      Drain(&overflow_, expired);
+    }
+    for (int level = kLevels - 1; level >= 0; level--) {
+      uint32_t slot = (now_ >> (kLevelBits * level)) & kSlotMask;
+      uint64_t bit = uint64_t{1} << slot;
+      if ((occupied_[level] & bit) == 0) continue;
+      occupied_[level] &= ~bit;
+      Drain(&slots_[level][slot], expired);
+    }
+  }
+
+  std::sort(expired->begin() + first,
+            expired->end(),
+            [this](uint32_t a, uint32_t b) {
+              const Entry& entry_a = entries_[a];
+              const Entry& entry_b = entries_[b];
+              if (entry_a.expiry != entry_b.expiry) {
+                return entry_a.expiry < entry_b.expiry;
+              }
+              return entry_a.sequence < entry_b.sequence;
+            });
+}
+
+uint64_t TimerWheel::NextExpiry() const {
+  // The entries that are due are the earliest ones. Otherwise, the lowest
+  // level with entries has the earliest ones in its first slot with entries.
+  const List* list = &due_;
+  if (list->head == kNoEntry) {
+    list = &overflow_;
+    for (int level = 0; level < kLevels; level++) {
+      if (occupied_[level] != 0) {
+        list = &slots_[level][std::countr_zero(occupied_[level])];
+        break;
+      }
+    }
+  }
+  uint64_t next = kNoExpiry;
+  for (uint32_t id = list->head; id != kNoEntry; id = entries_[id].next) {
+    next = std::min(next, entries_[id].expiry);
+  }
+  return next;
+}
+
+}  // namespace timers
+}  // namespace node
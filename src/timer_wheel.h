@@ -0,0 +1,104 @@
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace node {
+namespace timers {
+
+// A hierarchical timing wheel with a resolution of one millisecond. Each
+// level has 64 slots, and each slot of a level spans the whole range of the
+// level below it. Entries are placed on the lowest level on which their
+// expiry falls within the range of the wheel, and move down as the time of
+// the wheel reaches them, so scheduling, rescheduling and cancelling are O(1)
+// and expiring costs O(1) per entry and level.
+//
+// Entries are identified by small integers chosen by the caller, which are
+// used as indices into the storage of the wheel.
+class TimerWheel {
+ public:
+  static constexpr uint64_t kNoExpiry = UINT64_MAX;
+
+  explicit TimerWheel(uint64_t now = 0) : now_(now) {}
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Schedules the entry or, if it is scheduled already, moves it to the new
+  // expiry. An entry whose expiry is not later than the time of the wheel
+  // expires with the next call to Expire().
+  void Schedule(uint32_t id, uint64_t expiry);
+  // Does nothing if the entry is not scheduled.
+  void Cancel(uint32_t id);
+  bool IsScheduled(uint32_t id) const {
+    return id < entries_.size() && entries_[id].scheduled;
+  }
+
+  // Advances the time of the wheel to |now| and appends the entries that
+  // expired to |expired|, ordered by expiry, and by the order in which they
+  // were scheduled for the same expiry. The expired entries are no longer
+  // scheduled.
+  void Expire(uint64_t now, std::vector<uint32_t>* expired);
+
+  // The earliest expiry of the scheduled entries, or kNoExpiry.
+  uint64_t NextExpiry() const;
+
+  uint64_t now() const { return now_; }
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr int kLevelBits = 6;
+  static constexpr int kLevels = 6;
+  static constexpr uint32_t kSlotsPerLevel = 1 << kLevelBits;
+  static constexpr uint32_t kSlotMask = kSlotsPerLevel - 1;
+  // The entries beyond the range of the top level wait on an extra level
+  // with a single slot until the wheel gets close enough.
+  static constexpr uint8_t kOverflowLevel = kLevels;
+  // The entries that were due when they were scheduled.
+  static constexpr uint8_t kDueLevel = kLevels + 1;
+  static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+  struct Entry {
+    uint64_t expiry = 0;
+    uint64_t sequence = 0;
+    uint32_t prev = kNoEntry;
+    uint32_t next = kNoEntry;
+    uint8_t level = 0;
+    uint8_t slot = 0;
+    bool scheduled = false;
+  };
+
+  struct List {
+    uint32_t head = kNoEntry;
+    uint32_t tail = kNoEntry;
+  };
+
+  // Places a scheduled entry on the level and slot of its expiry.
+  void Place(uint32_t id);
+  void Unlink(uint32_t id);
+  List* ListOf(const Entry& entry);
+  // The earliest time at which a slot has to be expired or moved down.
+  uint64_t NextEvent() const;
+  // Takes all the entries from the list, and expires or places them again.
+  void Drain(List* list, std::vector<uint32_t>* expired);
+
+  std::vector<Entry> entries_;
+  List slots_[kLevels][kSlotsPerLevel];
+  List overflow_;
+  List due_;
+  // The slots of each level that have entries, one bit per slot.
+  uint64_t occupied_[kLevels] = {};
+  uint64_t now_;
+  uint64_t next_sequence_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace timers
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMER_WHEEL_H_
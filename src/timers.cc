@@ -6,11 +6,13 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace node {
 namespace timers {
 
+using v8::Array;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -19,6 +21,7 @@ using v8::Local;
 using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
+using v8::Uint32;
 using v8::Value;
 
 void BindingData::SetupTimers(const FunctionCallbackInfo<Value>& args) {
@@ -95,6 +98,85 @@ void BindingData::ToggleImmediateRefImpl(BindingData* data, bool ref) {
   data->env()->ToggleImmediateRef(ref);
 }
 
+void BindingData::SlowScheduleTimerList(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  int64_t expiry;
+  if (args[1]
+          ->IntegerValue(args.GetIsolate()->GetCurrentContext())
+          .To(&expiry)) {
+    ScheduleTimerListImpl(Realm::GetBindingData<BindingData>(args),
+                          args[0].As<Uint32>()->Value(),
+                          expiry);
+  }
+}
+
+void BindingData::FastScheduleTimerList(Local<Value> receiver,
+                                        uint32_t id,
+                                        int64_t expiry) {
+  TRACK_V8_FAST_API_CALL("timers.scheduleTimerList");
+  ScheduleTimerListImpl(FromJSObject<BindingData>(receiver), id, expiry);
+}
+
+void BindingData::ScheduleTimerListImpl(BindingData* data,
+                                        uint32_t id,
+                                        int64_t expiry) {
+  data->timer_lists_.Schedule(
+      id, static_cast<uint64_t>(std::max<int64_t>(expiry, 0)));
+}
+
+void BindingData::SlowCancelTimerList(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  CancelTimerListImpl(Realm::GetBindingData<BindingData>(args),
+                      args[0].As<Uint32>()->Value());
+}
+
+void BindingData::FastCancelTimerList(Local<Value> receiver, uint32_t id) {
+  TRACK_V8_FAST_API_CALL("timers.cancelTimerList");
+  CancelTimerListImpl(FromJSObject<BindingData>(receiver), id);
+}
+
+void BindingData::CancelTimerListImpl(BindingData* data, uint32_t id) {
+  data->timer_lists_.Cancel(id);
+}
+
+void BindingData::ExpireTimerLists(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  BindingData* data = Realm::GetBindingData<BindingData>(args);
+  int64_t now;
+  if (!args[0]->IntegerValue(isolate->GetCurrentContext()).To(&now)) return;
+
+  std::vector<uint32_t>& expired = data->expired_timer_lists_;
+  expired.clear();
+  data->timer_lists_.Expire(static_cast<uint64_t>(std::max<int64_t>(now, 0)),
+                            &expired);
+
+  LocalVector<Value> ids(isolate);
+  ids.reserve(expired.size());
+  for (uint32_t id : expired) {
+    ids.push_back(Uint32::NewFromUnsigned(isolate, id));
+  }
+  args.GetReturnValue().Set(Array::New(isolate, ids.data(), ids.size()));
+}
+
+void BindingData::SlowGetNextTimerListExpiry(
+    const FunctionCallbackInfo<Value>& args) {
+  double expiry =
+      GetNextTimerListExpiryImpl(Realm::GetBindingData<BindingData>(args));
+  args.GetReturnValue().Set(Number::New(args.GetIsolate(), expiry));
+}
+
+double BindingData::FastGetNextTimerListExpiry(Local<Value> receiver) {
+  TRACK_V8_FAST_API_CALL("timers.getNextTimerListExpiry");
+  return GetNextTimerListExpiryImpl(FromJSObject<BindingData>(receiver));
+}
+
+double BindingData::GetNextTimerListExpiryImpl(BindingData* data) {
+  uint64_t expiry = data->timer_lists_.NextExpiry();
+  if (expiry == TimerWheel::kNoExpiry) return -1;
+  return static_cast<double>(expiry);
+}
+
 BindingData::BindingData(Realm* realm, Local<Object> object)
     : SnapshotableObject(realm, object, type_int) {}
 
@@ -132,6 +214,12 @@ v8::CFunction BindingData::fast_toggle_timer_ref_(
     v8::CFunction::Make(FastToggleTimerRef));
 v8::CFunction BindingData::fast_toggle_immediate_ref_(
     v8::CFunction::Make(FastToggleImmediateRef));
+v8::CFunction BindingData::fast_schedule_timer_list_(
+    v8::CFunction::Make(FastScheduleTimerList));
+v8::CFunction BindingData::fast_cancel_timer_list_(
+    v8::CFunction::Make(FastCancelTimerList));
+v8::CFunction BindingData::fast_get_next_timer_list_expiry_(
+    v8::CFunction::Make(FastGetNextTimerListExpiry));
 
 void BindingData::CreatePerIsolateProperties(IsolateData* isolate_data,
                                              Local<ObjectTemplate> target) {
@@ -155,6 +243,22 @@ void BindingData::CreatePerIsolateProperties(IsolateData* isolate_data,
                 "toggleImmediateRef",
                 SlowToggleImmediateRef,
                 &fast_toggle_immediate_ref_);
+  SetFastMethod(isolate,
+                target,
+                "scheduleTimerList",
+                SlowScheduleTimerList,
+                &fast_schedule_timer_list_);
+  SetFastMethod(isolate,
+                target,
+                "cancelTimerList",
+                SlowCancelTimerList,
+                &fast_cancel_timer_list_);
+  SetMethod(isolate, target, "expireTimerLists", ExpireTimerLists);
+  SetFastMethod(isolate,
+                target,
+                "getNextTimerListExpiry",
+                SlowGetNextTimerListExpiry,
+                &fast_get_next_timer_list_expiry_);
 }
 
 void BindingData::CreatePerContextProperties(Local<Object> target,
@@ -199,6 +303,20 @@ void BindingData::RegisterTimerExternalReferences(
   registry->Register(SlowToggleImmediateRef);
   registry->Register(FastToggleImmediateRef);
   registry->Register(fast_toggle_immediate_ref_.GetTypeInfo());
+
+  registry->Register(SlowScheduleTimerList);
+  registry->Register(FastScheduleTimerList);
+  registry->Register(fast_schedule_timer_list_.GetTypeInfo());
+
+  registry->Register(SlowCancelTimerList);
+  registry->Register(FastCancelTimerList);
+  registry->Register(fast_cancel_timer_list_.GetTypeInfo());
+
+  registry->Register(ExpireTimerLists);
+
+  registry->Register(SlowGetNextTimerListExpiry);
+  registry->Register(FastGetNextTimerListExpiry);
+  registry->Register(fast_get_next_timer_list_expiry_.GetTypeInfo());
 }
 
 }  // namespace timers
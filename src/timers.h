@@ -4,7 +4,9 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include <cinttypes>
+#include <vector>
 #include "node_snapshotable.h"
+#include "timer_wheel.h"
 
 namespace node {
 class ExternalReferenceRegistry;
@@ -50,6 +52,28 @@ class BindingData : public SnapshotableObject {
                                      bool ref);
   static void ToggleImmediateRefImpl(BindingData* data, bool ref);
 
+  // The lists of timers of the same duration are kept in a TimerWheel, by the
+  // ids that JS assigned to them.
+  static void SlowScheduleTimerList(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FastScheduleTimerList(v8::Local<v8::Value> receiver,
+                                    uint32_t id,
+                                    int64_t expiry);
+  static void ScheduleTimerListImpl(BindingData* data,
+                                    uint32_t id,
+                                    int64_t expiry);
+  static void SlowCancelTimerList(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FastCancelTimerList(v8::Local<v8::Value> receiver, uint32_t id);
+  static void CancelTimerListImpl(BindingData* data, uint32_t id);
+  // Returns an array of the ids of the lists that expired, in the order in
+  // which they should be processed.
+  static void ExpireTimerLists(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SlowGetNextTimerListExpiry(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static double FastGetNextTimerListExpiry(v8::Local<v8::Value> receiver);
+  static double GetNextTimerListExpiryImpl(BindingData* data);
+
   static void CreatePerIsolateProperties(IsolateData* isolate_data,
                                          v8::Local<v8::ObjectTemplate> target);
   static void CreatePerContextProperties(v8::Local<v8::Object> target,
@@ -64,6 +88,12 @@ class BindingData : public SnapshotableObject {
   static v8::CFunction fast_schedule_timers_;
   static v8::CFunction fast_toggle_timer_ref_;
   static v8::CFunction fast_toggle_immediate_ref_;
+  static v8::CFunction fast_schedule_timer_list_;
+  static v8::CFunction fast_cancel_timer_list_;
+  static v8::CFunction fast_get_next_timer_list_expiry_;
+
+  TimerWheel timer_lists_;
+  std::vector<uint32_t> expired_timer_lists_;
 };
 
 }  // namespace timers
@@ -0,0 +1,393 @@
+#include "tracing/perfetto_trace_writer.h"
+
+#include "tracing/trace_event_common.h"
+
+#include <functional>
+#include <string>
+
+namespace node {
+namespace tracing {
+
+namespace {
+
+// The numbers of the protobuf fields used, from the .proto files of
+// https://github.com/google/perfetto/tree/main/protos/perfetto/trace.
+enum TraceField : uint32_t { kTracePacket = 1 };
+
+enum TracePacketField : uint32_t {
+  kPacketTimestamp = 8,
+  kPacketTrustedPacketSequenceId = 10,
+  kPacketTrackEvent = 11,
+  kPacketSequenceFlags = 13,
+  kPacketTimestampClockId = 58,
+  kPacketTrackDescriptor = 60,
+};
+
+enum TrackDescriptorField : uint32_t {
+  kTrackUuid = 1,
+  kTrackName = 2,
+  kTrackProcess = 3,
+  kTrackThread = 4,
+  kTrackParentUuid = 5,
+  kTrackCounter = 8,
+};
+
+enum ProcessDescriptorField : uint32_t {
+  kProcessPid = 1,
+  kProcessName = 6,
+};
+
+enum ThreadDescriptorField : uint32_t {
+  kThreadPid = 1,
+  kThreadTid = 2,
+  kThreadName = 5,
+};
+
+enum TrackEventField : uint32_t {
+  kEventDebugAnnotations = 4,
+  kEventType = 9,
+  kEventTrackUuid = 11,
+  kEventCategories = 22,
+  kEventName = 23,
+  kEventCounterValue = 30,
+  kEventDoubleCounterValue = 44,
+};
+
+enum TrackEventType : uint64_t {
+  kSliceBegin = 1,
+  kSliceEnd = 2,
+  kInstant = 3,
+  kCounter = 4,
+};
+
+enum DebugAnnotationField : uint32_t {
+  kAnnotationBoolValue = 2,
+  kAnnotationUintValue = 3,
+  kAnnotationIntValue = 4,
+  kAnnotationDoubleValue = 5,
+  kAnnotationStringValue = 6,
+  kAnnotationPointerValue = 7,
+  kAnnotationLegacyJsonValue = 9,
+  kAnnotationName = 10,
+};
+
+// The timestamps of the trace events are read from the monotonic clock.
+constexpr uint64_t kBuiltinClockMonotonic = 3;
+// There is a single sequence of packets. SEQ_INCREMENTAL_STATE_CLEARED is set
+// on the first packet of it, even though no state is interned.
+constexpr uint64_t kSequenceId = 1;
+constexpr uint64_t kSeqIncrementalStateCleared = 1;
+
+enum TrackKind : uint64_t {
+  kProcessTrack = 1,
+  kThreadTrack,
+  kAsyncTrack,
+  kCounterTrack,
+};
+
+uint64_t MakeUuid(TrackKind kind, uint64_t a, uint64_t b) {
+  // splitmix64, so that the uuids of the different kinds do not collide.
+  uint64_t x = (kind << 56) ^ (a << 24) ^ b ^ 0x9e3779b97f4a7c15;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+}  // namespace
+
+PerfettoTraceWriter::PerfettoTraceWriter(std::ostream& stream)
+    : stream_(stream) {}
+
+void PerfettoTraceWriter::AppendTrackDescriptor(const Message& descriptor) {
+  Message packet;
+  packet.AppendVarint(kPacketTrustedPacketSequenceId, kSequenceId);
+  if (first_packet_) {
+    packet.AppendVarint(kPacketSequenceFlags, kSeqIncrementalStateCleared);
+    first_packet_ = false;
+  }
+  packet.AppendMessage(kPacketTrackDescriptor, descriptor);
+  Message trace;
+  trace.AppendMessage(kTracePacket, packet);
+  stream_ << trace.data();
+}
+
+void PerfettoTraceWriter::AppendTrackEvent(int64_t timestamp,
+                                           const Message& track_event) {
+  Message packet;
+  // The trace events have timestamps in microseconds, Perfetto uses
+  // nanoseconds.
+  packet.AppendVarint(kPacketTimestamp,
+                      static_cast<uint64_t>(timestamp) * 1000);
+  packet.AppendVarint(kPacketTimestampClockId, kBuiltinClockMonotonic);
+  packet.AppendVarint(kPacketTrustedPacketSequenceId, kSequenceId);
+  if (first_packet_) {
+    packet.AppendVarint(kPacketSequenceFlags, kSeqIncrementalStateCleared);
+    first_packet_ = false;
+  }
+  packet.AppendMessage(kPacketTrackEvent, track_event);
+  Message trace;
+  trace.AppendMessage(kTracePacket, packet);
+  stream_ << trace.data();
+}
+
+uint64_t PerfettoTraceWriter::ProcessTrack(int pid) {
+  uint64_t uuid = MakeUuid(kProcessTrack, static_cast<uint32_t>(pid), 0);
+  if (tracks_.insert(uuid).second) {
+    Message process;
+    process.AppendVarint(kProcessPid, static_cast<uint32_t>(pid));
+    Message descriptor;
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendMessage(kTrackProcess, process);
+    AppendTrackDescriptor(descriptor);
+  }
+  return uuid;
+}
+
+uint64_t PerfettoTraceWriter::ThreadTrack(int pid, int tid) {
+  uint64_t uuid = MakeUuid(kThreadTrack,
+                           static_cast<uint32_t>(pid),
+                           static_cast<uint32_t>(tid));
+  if (tracks_.count(uuid) == 0) {
+    uint64_t parent = ProcessTrack(pid);
+    tracks_.insert(uuid);
+    Message thread;
+    thread.AppendVarint(kThreadPid, static_cast<uint32_t>(pid));
+    thread.AppendVarint(kThreadTid, static_cast<uint32_t>(tid));
+    Message descriptor;
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendVarint(kTrackParentUuid, parent);
+    descriptor.AppendMessage(kTrackThread, thread);
+    AppendTrackDescriptor(descriptor);
+  }
+  return uuid;
+}
+
+uint64_t PerfettoTraceWriter::AsyncTrack(TraceObject* trace_event,
+                                         std::string_view category) {
+  // Like in the JSON format, async events with the same category and id
+  // belong together.
+  uint64_t uuid = MakeUuid(kAsyncTrack,
+                           std::hash<std::string_view>()(category),
+                           trace_event->id());
+  if (tracks_.count(uuid) == 0) {
+    uint64_t parent = ProcessTrack(trace_event->pid());
+    tracks_.insert(uuid);
+    Message descriptor;
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendVarint(kTrackParentUuid, parent);
+    descriptor.AppendString(kTrackName, trace_event->name());
+    AppendTrackDescriptor(descriptor);
+  }
+  return uuid;
+}
+
+uint64_t PerfettoTraceWriter::CounterTrack(int pid, std::string_view name) {
+  uint64_t uuid = MakeUuid(kCounterTrack,
+                           static_cast<uint32_t>(pid),
+                           std::hash<std::string_view>()(name));
+  if (tracks_.count(uuid) == 0) {
+    uint64_t parent = ProcessTrack(pid);
+    tracks_.insert(uuid);
+    Message descriptor;
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendVarint(kTrackParentUuid, parent);
+    descriptor.AppendString(kTrackName, name);
+    descriptor.AppendMessage(kTrackCounter, Message());
+    AppendTrackDescriptor(descriptor);
+  }
+  return uuid;
+}
+
+void PerfettoTraceWriter::AppendMetadata(TraceObject* trace_event) {
+  // The names of the threads and of the process are sent as metadata events
+  // with a "name" argument. They are written as the names of their tracks.
+  if (trace_event->num_args() < 1 ||
+      (trace_event->arg_types()[0] != TRACE_VALUE_TYPE_STRING &&
+       trace_event->arg_types()[0] != TRACE_VALUE_TYPE_COPY_STRING) ||
+      trace_event->arg_values()[0].as_string == nullptr) {
+    return;
+  }
+  std::string_view event_name = trace_event->name();
+  const char* name = trace_event->arg_values()[0].as_string;
+  uint32_t pid = static_cast<uint32_t>(trace_event->pid());
+
+  Message descriptor;
+  if (event_name == "thread_name") {
+    uint64_t uuid = ThreadTrack(trace_event->pid(), trace_event->tid());
+    Message thread;
+    thread.AppendVarint(kThreadPid, pid);
+    thread.AppendVarint(kThreadTid, static_cast<uint32_t>(trace_event->tid()));
+    thread.AppendString(kThreadName, name);
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendVarint(kTrackParentUuid, ProcessTrack(trace_event->pid()));
+    descriptor.AppendMessage(kTrackThread, thread);
+  } else if (event_name == "process_name") {
+    uint64_t uuid = ProcessTrack(trace_event->pid());
+    Message process;
+    process.AppendVarint(kProcessPid, pid);
+    process.AppendString(kProcessName, name);
+    descriptor.AppendVarint(kTrackUuid, uuid);
+    descriptor.AppendMessage(kTrackProcess, process);
+  } else {
+    return;
+  }
+  AppendTrackDescriptor(descriptor);
+}
+
+void PerfettoTraceWriter::AppendArgs(TraceObject* trace_event,
+                                     Message* track_event) {
+  for (int i = 0; i < trace_event->num_args(); i++) {
+    Message annotation;
+    annotation.AppendString(kAnnotationName, trace_event->arg_names()[i]);
+    const TraceObject::ArgValue& value = trace_event->arg_values()[i];
+    switch (trace_event->arg_types()[i]) {
+      case TRACE_VALUE_TYPE_BOOL:
+        annotation.AppendVarint(kAnnotationBoolValue, value.as_uint ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        annotation.AppendVarint(kAnnotationUintValue, value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        annotation.AppendVarint(kAnnotationIntValue,
+                                static_cast<uint64_t>(value.as_int));
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        annotation.AppendDouble(kAnnotationDoubleValue, value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        annotation.AppendVarint(
+            kAnnotationPointerValue,
+            static_cast<uint64_t>(
+                reinterpret_cast<uintptr_t>(value.as_pointer)));
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        annotation.AppendString(
+            kAnnotationStringValue,
+            value.as_string != nullptr ? value.as_string : "");
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string json;
+        trace_event->arg_convertables()[i]->AppendAsTraceFormat(&json);
+        annotation.AppendString(kAnnotationLegacyJsonValue, json);
+        break;
+      }
+      default:
+        continue;
+    }
+    track_event->AppendMessage(kEventDebugAnnotations, annotation);
+  }
+}
+
+void PerfettoTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  char phase = trace_event->phase();
+  if (phase == TRACE_EVENT_PHASE_METADATA) {
+    AppendMetadata(trace_event);
+    return;
+  }
+
+  std::string_view category_group =
+      v8::platform::tracing::TracingController::GetCategoryGroupName(
+          trace_event->category_enabled_flag());
+
+  if (phase == TRACE_EVENT_PHASE_COUNTER) {
+    for (int i = 0; i < trace_event->num_args(); i++) {
+      std::string name = trace_event->name();
+      if (trace_event->num_args() > 1) {
+        name += '.';
+        name += trace_event->arg_names()[i];
+      }
+      Message track_event;
+      track_event.AppendVarint(kEventType, kCounter);
+      track_event.AppendVarint(kEventTrackUuid,
+                               CounterTrack(trace_event->pid(), name));
+      const TraceObject::ArgValue& value = trace_event->arg_values()[i];
+      switch (trace_event->arg_types()[i]) {
+        case TRACE_VALUE_TYPE_INT:
+          track_event.AppendVarint(kEventCounterValue,
+                                   static_cast<uint64_t>(value.as_int));
+          break;
+        case TRACE_VALUE_TYPE_UINT:
+          track_event.AppendVarint(kEventCounterValue, value.as_uint);
+          break;
+        case TRACE_VALUE_TYPE_DOUBLE:
+          track_event.AppendDouble(kEventDoubleCounterValue, value.as_double);
+          break;
+        default:
+          continue;
+      }
+      AppendTrackEvent(trace_event->ts(), track_event);
+    }
+    return;
+  }
+
+  uint64_t type;
+  uint64_t track;
+  switch (phase) {
+    case TRACE_EVENT_PHASE_BEGIN:
+    case TRACE_EVENT_PHASE_COMPLETE:
+      type = kSliceBegin;
+      track = ThreadTrack(trace_event->pid(), trace_event->tid());
+      break;
+    case TRACE_EVENT_PHASE_END:
+      type = kSliceEnd;
+      track = ThreadTrack(trace_event->pid(), trace_event->tid());
+      break;
+    case TRACE_EVENT_PHASE_INSTANT:
+    case TRACE_EVENT_PHASE_MARK:
+      type = kInstant;
+      track = ThreadTrack(trace_event->pid(), trace_event->tid());
+      break;
+    case TRACE_EVENT_PHASE_ASYNC_BEGIN:
+    case TRACE_EVENT_PHASE_NESTABLE_ASYNC_BEGIN:
+      type = kSliceBegin;
+      track = AsyncTrack(trace_event, category_group);
+      break;
+    case TRACE_EVENT_PHASE_ASYNC_END:
+    case TRACE_EVENT_PHASE_NESTABLE_ASYNC_END:
+      type = kSliceEnd;
+      track = AsyncTrack(trace_event, category_group);
+      break;
+    case TRACE_EVENT_PHASE_ASYNC_STEP_INTO:
+    case TRACE_EVENT_PHASE_ASYNC_STEP_PAST:
+    case TRACE_EVENT_PHASE_NESTABLE_ASYNC_INSTANT:
+      type = kInstant;
+      track = AsyncTrack(trace_event, category_group);
+      break;
+    default:
+      // Flow, sample, object and context events have no equivalent.
+      return;
+  }
+
+  Message track_event;
+  track_event.AppendVarint(kEventType, type);
+  track_event.AppendVarint(kEventTrackUuid, track);
+  if (type != kSliceEnd) {
+    // The category group is a comma separated list of categories.
+    size_t start = 0;
+    while (start <= category_group.size()) {
+      size_t end = category_group.find(',', start);
+      if (end == std::string_view::npos) end = category_group.size();
+      if (end > start) {
+        track_event.AppendString(kEventCategories,
+                                 category_group.substr(start, end - start));
+      }
+      start = end + 1;
+    }
+    track_event.AppendString(kEventName, trace_event->name());
+    AppendArgs(trace_event, &track_event);
+  }
+  AppendTrackEvent(trace_event->ts(), track_event);
+
+  if (phase == TRACE_EVENT_PHASE_COMPLETE) {
+    Message end_event;
+    end_event.AppendVarint(kEventType, kSliceEnd);
+    end_event.AppendVarint(kEventTrackUuid, track);
+    AppendTrackEvent(trace_event->ts() + trace_event->duration(), end_event);
+  }
+}
+
+void PerfettoTraceWriter::Flush() {}
+
+}  // namespace tracing
+}  // namespace node
@@ -0,0 +1,50 @@
+#ifndef SRC_TRACING_PERFETTO_TRACE_WRITER_H_
+#define SRC_TRACING_PERFETTO_TRACE_WRITER_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <unordered_set>
+
+#include "libplatform/v8-tracing.h"
+#include "protobuf_writer.h"
+
+namespace node {
+namespace tracing {
+
+using v8::platform::tracing::TraceObject;
+using v8::platform::tracing::TraceWriter;
+
+// Serializes trace events into the binary protobuf format of Perfetto, as a
+// sequence of Trace.packet fields that can be concatenated, instead of into
+// JSON. Every thread gets a track, and so does every id of async events and
+// every series of counter events. The descriptor of a track is written
+// before its first event in the stream.
+class PerfettoTraceWriter : public TraceWriter {
+ public:
+  explicit PerfettoTraceWriter(std::ostream& stream);
+
+  void AppendTraceEvent(TraceObject* trace_event) override;
+  void Flush() override;
+
+ private:
+  using Message = ProtobufWriter;
+
+  uint64_t ThreadTrack(int pid, int tid);
+  uint64_t ProcessTrack(int pid);
+  uint64_t AsyncTrack(TraceObject* trace_event, std::string_view category);
+  uint64_t CounterTrack(int pid, std::string_view name);
+  void AppendTrackDescriptor(const Message& descriptor);
+  void AppendTrackEvent(int64_t timestamp, const Message& track_event);
+  void AppendMetadata(TraceObject* trace_event);
+  static void AppendArgs(TraceObject* trace_event, Message* track_event);
+
+  std::ostream& stream_;
+  std::unordered_set<uint64_t> tracks_;
+  bool first_packet_ = true;
+};
+
+}  // namespace tracing
+}  // namespace node
+
+#endif  // SRC_TRACING_PERFETTO_TRACE_WRITER_H_
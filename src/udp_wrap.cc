@@ -141,7 +141,14 @@ void UDPWrapBase::RegisterExternalReferences(
   registry->Register(RecvStop);
 }
 
-UDPWrap::UDPWrap(Environment* env, Local<Object> object)
+namespace {
+// uv__udp_recvmmsg() reads at most 20 datagrams of up to 64 KiB each, and
+// only as many as fit into the buffer it is given.
+constexpr size_t kRecvBatchDatagrams = 20;
+constexpr size_t kRecvBatchBufferSize = kRecvBatchDatagrams * 64 * 1024;
+}  // anonymous namespace
+
+UDPWrap::UDPWrap(Environment* env, Local<Object> object, unsigned int flags)
     : HandleWrap(env,
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
@@ -149,7 +156,7 @@ UDPWrap::UDPWrap(Environment* env, Local<Object> object)
   object->SetAlignedPointerInInternalField(
       UDPWrapBase::kUDPWrapBaseField, static_cast<UDPWrapBase*>(this));
 
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  int r = uv_udp_init_ex(env->event_loop(), &handle_, AF_UNSPEC | flags);
   CHECK_EQ(r, 0);  // can't fail anyway
 
   set_listener(this);
@@ -233,6 +240,7 @@ void UDPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, UV_UDP_IPV6ONLY);
   NODE_DEFINE_CONSTANT(constants, UV_UDP_REUSEADDR);
   NODE_DEFINE_CONSTANT(constants, UV_UDP_REUSEPORT);
+  NODE_DEFINE_CONSTANT(constants, UV_UDP_RECVMMSG);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -270,7 +278,12 @@ void UDPWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
 void UDPWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   Environment* env = Environment::GetCurrent(args);
-  new UDPWrap(env, args.This());
+  unsigned int flags = 0;
+  if (args[0]->IsUint32()) {
+    flags = args[0].As<Uint32>()->Value();
+    CHECK_EQ(flags & ~UV_UDP_RECVMMSG, 0);
+  }
+  new UDPWrap(env, args.This(), flags);
 }
 
 
@@ -677,6 +690,7 @@ void UDPWrapBase::RecvStart(const FunctionCallbackInfo<Value>& args) {
 
 int UDPWrap::RecvStart() {
   if (IsHandleClosing()) return UV_EBADF;
+  recv_batch_.clear();
   int err = uv_udp_recv_start(&handle_, OnAlloc, OnRecv);
   // UV_EALREADY means that the socket is already bound but that's okay
   if (err == UV_EALREADY)
@@ -720,6 +734,11 @@ void UDPWrap::OnAlloc(uv_handle_t* handle,
 }
 
 uv_buf_t UDPWrap::OnAlloc(size_t suggested_size) {
+  if (uv_udp_using_recvmmsg(&handle_)) {
+    if (!recv_batch_buffer_)
+      recv_batch_buffer_.reset(new char[kRecvBatchBufferSize]);
+    return uv_buf_init(recv_batch_buffer_.get(), kRecvBatchBufferSize);
+  }
   return env()->allocate_managed_buffer(suggested_size);
 }
 
@@ -738,7 +757,18 @@ void UDPWrap::OnRecv(ssize_t nread,
                      unsigned int flags) {
   Environment* env = this->env();
   Isolate* isolate = env->isolate();
-  std::unique_ptr<BackingStore> bs = env->release_managed_buffer(buf_);
+  std::unique_ptr<BackingStore> bs;
+  if (uv_udp_using_recvmmsg(&handle_)) {
+    if (flags & UV_UDP_MMSG_CHUNK)
+      return AddToReceiveBatch(nread, buf_, addr);
+    if (flags & UV_UDP_MMSG_FREE)
+      return FlushReceiveBatch();
+    // Outside of a batch, only errors and empty reads are reported. The
+    // buffer belongs to this handle and is not released.
+    CHECK_LE(nread, 0);
+  } else {
+    bs = env->release_managed_buffer(buf_);
+  }
   if (nread == 0 && addr == nullptr) {
     return;
   }
@@ -807,6 +837,90 @@ void UDPWrap::OnRecv(ssize_t nread,
   MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
+void UDPWrap::AddToReceiveBatch(ssize_t nread,
+                                const uv_buf_t& buf,
+                                const sockaddr* addr) {
+  CHECK_GE(nread, 0);
+  CHECK_NOT_NULL(addr);
+  CHECK_GE(buf.base, recv_batch_buffer_.get());
+  CHECK_LE(buf.base + nread, recv_batch_buffer_.get() + kRecvBatchBufferSize);
+
+  BatchedDatagram& datagram = recv_batch_.emplace_back();
+  datagram.offset = buf.base - recv_batch_buffer_.get();
+  datagram.length = nread;
+  memcpy(&datagram.address, addr, SocketAddress::GetLength(addr));
+}
+
+void UDPWrap::FlushReceiveBatch() {
+  if (recv_batch_.empty()) return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  // Copy the whole batch into one ArrayBuffer so that it costs a single
+  // allocation, and let every datagram be a view into it.
+  size_t total = 0;
+  for (const BatchedDatagram& datagram : recv_batch_)
+    total += datagram.length;
+  std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+      isolate, total, BackingStoreInitializationMode::kUninitialized);
+  char* data = static_cast<char*>(bs->Data());
+  size_t offset = 0;
+  for (const BatchedDatagram& datagram : recv_batch_) {
+    memcpy(data + offset,
+           recv_batch_buffer_.get() + datagram.offset,
+           datagram.length);
+    offset += datagram.length;
+  }
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(bs));
+
+  const size_t count = recv_batch_.size();
+  MaybeStackBuffer<Local<Value>, kRecvBatchDatagrams> buffers(count);
+  MaybeStackBuffer<Local<Value>, kRecvBatchDatagrams> addresses(count);
+
+  Local<Value> argv[] = {
+      Integer::New(isolate, static_cast<int32_t>(count)),
+      object(),
+      Undefined(isolate),
+      Undefined(isolate)};
+
+  bool has_caught = false;
+  {
+    TryCatchScope try_catch(env);
+    offset = 0;
+    for (size_t i = 0; i < count; i++) {
+      const BatchedDatagram& datagram = recv_batch_[i];
+      const sockaddr* addr =
+          reinterpret_cast<const sockaddr*>(&datagram.address);
+      Local<Object> buffer;
+      Local<Object> address;
+      if (!Buffer::New(env, ab, offset, datagram.length).ToLocal(&buffer) ||
+          !AddressToJS(env, addr).ToLocal(&address)) {
+        DCHECK(try_catch.HasCaught() && !try_catch.HasTerminated());
+        argv[2] = try_catch.Exception();
+        DCHECK(!argv[2].IsEmpty());
+        has_caught = true;
+        break;
+      }
+      buffers[i] = buffer;
+      addresses[i] = address;
+      offset += datagram.length;
+    }
+  }
+  recv_batch_.clear();
+
+  if (has_caught) {
+    MakeCallback(env->onerror_string(), arraysize(argv), argv);
+    return;
+  }
+
+  argv[2] = Array::New(isolate, buffers.out(), count);
+  argv[3] = Array::New(isolate, addresses.out(), count);
+  MakeCallback(env->onmessagebatch_string(), arraysize(argv), argv);
+}
+
 MaybeLocal<Object> UDPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         UDPWrap::SocketType type) {
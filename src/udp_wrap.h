@@ -30,6 +30,9 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <memory>
+#include <vector>
+
 namespace node {
 
 class ExternalReferenceRegistry;
@@ -189,7 +192,7 @@ class UDPWrap final : public HandleWrap,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
 
-  UDPWrap(Environment* env, v8::Local<v8::Object> object);
+  UDPWrap(Environment* env, v8::Local<v8::Object> object, unsigned int flags);
 
   static void DoBind(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
@@ -212,8 +215,25 @@ class UDPWrap final : public HandleWrap,
                      const struct sockaddr* addr,
                      unsigned int flags);
 
+  void AddToReceiveBatch(ssize_t nread,
+                         const uv_buf_t& buf,
+                         const sockaddr* addr);
+  void FlushReceiveBatch();
+
   uv_udp_t handle_;
 
+  // When the handle was created with UV_UDP_RECVMMSG, libuv reads a batch of
+  // datagrams into this buffer with a single recvmmsg() call and reports them
+  // one by one before handing the buffer back. They are collected here and
+  // passed to JS in a single onmessagebatch callback.
+  struct BatchedDatagram {
+    size_t offset;
+    size_t length;
+    sockaddr_storage address;
+  };
+  std::unique_ptr<char[]> recv_batch_buffer_;
+  std::vector<BatchedDatagram> recv_batch_;
+
   bool current_send_has_callback_;
   v8::Local<v8::Object> current_send_req_wrap_;
 };
@@ -45,7 +45,6 @@
 
 namespace node {
 
-#ifndef __wasi__
 template <typename T>
 ListNode<T>::ListNode() : prev_(this), next_(this) {}
 
@@ -134,7 +133,6 @@ template <typename T, ListNode<T> (T::*M)>
 typename ListHead<T, M>::Iterator ListHead<T, M>::end() const {
   return Iterator(const_cast<ListNode<T>*>(&head_));
 }
-#endif
 
 template <typename Inner, typename Outer>
 constexpr uintptr_t OffsetOf(Inner Outer::*field) {
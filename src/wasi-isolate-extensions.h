@@ -12,16 +12,10 @@ inline bool IsolateInContext(Isolate* isolate) {
   return true;
 }
 
-inline CppHeap* IsolateGetCppHeap(Isolate* isolate) {
-  // WASI doesn't use CppHeap
-  return nullptr;
-}
-
 } // namespace v8
 
 // Macros to redirect method calls
 #define InContext() v8::IsolateInContext(this)
-#define GetCppHeap() v8::IsolateGetCppHeap(this)
 
 #endif // __wasi__
 
@@ -0,0 +1,123 @@
+#include "wasi_arena_allocator.h"
+
+#ifdef __wasi__
+
+#include "memory_tracker-inl.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace node {
+
+WasiArenaAllocator* WasiArenaAllocator::Get() {
+  // Never destroyed, as backing stores may outlive every isolate.
+  static WasiArenaAllocator* allocator = new WasiArenaAllocator();
+  return allocator;
+}
+
+void WasiArenaAllocator::AddFreeRegion(uintptr_t address, size_t size) {
+  auto next = free_by_address_.lower_bound(address);
+  if (next != free_by_address_.end() && next->first == address + size) {
+    size += next->second;
+    next = std::next(next);
+    RemoveFreeRegion(std::prev(next));
+  }
+  if (next != free_by_address_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == address) {
+      address = prev->first;
+      size += prev->second;
+      RemoveFreeRegion(prev);
+    }
+  }
+  free_by_address_.emplace(address, size);
+  free_by_size_.emplace(size, address);
+  free_bytes_ += size;
+}
+
+void WasiArenaAllocator::RemoveFreeRegion(
+    std::map<uintptr_t, size_t>::iterator it) {
+  auto range = free_by_size_.equal_range(it->second);
+  auto by_size = std::find_if(range.first, range.second, [&](const auto& e) {
+    return e.second == it->first;
+  });
+  CHECK_NE(by_size, range.second);
+  free_by_size_.erase(by_size);
+  free_bytes_ -= it->second;
+  free_by_address_.erase(it);
+}
+
+bool WasiArenaAllocator::Grow(size_t size) {
+  // A free region at the end of the memory is merged with the new one, so
+  // only the difference needs to be reserved.
+  const uintptr_t memory_end = __builtin_wasm_memory_size(0) * kPageSize;
+  if (!free_by_address_.empty()) {
+    auto last = std::prev(free_by_address_.end());
+    if (last->first + last->second == memory_end) {
+      size -= std::min(size, last->second);
+    }
+  }
+  size_t bytes = std::max(size, kArenaSize);
+  bytes = (bytes + kPageSize - 1) & ~(kPageSize - 1);
+  const size_t old_pages = __builtin_wasm_memory_grow(0, bytes / kPageSize);
+  if (old_pages == SIZE_MAX) return false;
+  reserved_bytes_ += bytes;
+  AddFreeRegion(old_pages * kPageSize, bytes);
+  return true;
+}
+
+void* WasiArenaAllocator::AllocateUninitialized(size_t size) {
+  if (size < kGranuleSize) return malloc(size);
+  const size_t rounded = RoundUp(size);
+
+  Mutex::ScopedLock lock(mutex_);
+  auto it = free_by_size_.lower_bound(rounded);
+  // If something else grew the memory while it was being grown here, the
+  // new region may not have been merged with the old end, so try twice.
+  for (int attempt = 0; it == free_by_size_.end() && attempt < 2; attempt++) {
+    if (!Grow(rounded)) return nullptr;
+    it = free_by_size_.lower_bound(rounded);
+  }
+  if (it == free_by_size_.end()) return nullptr;
+
+  const uintptr_t address = it->second;
+  const size_t region_size = it->first;
+  RemoveFreeRegion(free_by_address_.find(address));
+  if (region_size > rounded) {
+    AddFreeRegion(address + rounded, region_size - rounded);
+  }
+  requested_bytes_ += size;
+  return reinterpret_cast<void*>(address);
+}
+
+void* WasiArenaAllocator::Allocate(size_t size) {
+  if (size < kGranuleSize) return calloc(size, 1);
+  void* data = AllocateUninitialized(size);
+  if (data != nullptr) memset(data, 0, size);
+  return data;
+}
+
+void WasiArenaAllocator::Free(void* data, size_t size) {
+  if (size < kGranuleSize) return free(data);
+  if (data == nullptr) return;
+
+  Mutex::ScopedLock lock(mutex_);
+  AddFreeRegion(reinterpret_cast<uintptr_t>(data), RoundUp(size));
+  requested_bytes_ -= std::min(size, requested_bytes_);
+}
+
+void WasiArenaAllocator::MemoryInfo(MemoryTracker* tracker) const {
+  Mutex::ScopedLock lock(mutex_);
+  const size_t used_bytes = reserved_bytes_ - free_bytes_;
+  tracker->TrackFieldWithSize("free_regions", free_bytes_);
+  tracker->TrackFieldWithSize("padding",
+                              used_bytes - std::min(used_bytes,
+                                                    requested_bytes_));
+}
+
+}  // namespace node
+
+#endif  // __wasi__
@@ -0,0 +1,86 @@
+#ifndef SRC_WASI_ARENA_ALLOCATOR_H_
+#define SRC_WASI_ARENA_ALLOCATOR_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#ifdef __wasi__
+
+#include "memory_tracker.h"
+#include "node_mutex.h"
+#include "v8-array-buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace node {
+
+// Serves the backing stores of all NodeArrayBufferAllocators in a WASI build
+// from arenas of linear memory that are reserved with memory.grow, instead
+// of from the general purpose malloc(). The linear memory can never be
+// given back to the host, so what matters is that freed memory is reused:
+// allocations are rounded up to granules, served best-fit from the free
+// regions, and freed regions are merged with their free neighbours so that
+// later, larger buffers fit into them.
+//
+// Allocations smaller than a granule still go to malloc(), or to the
+// SlabAllocator when it is enabled, which backs its slabs with this.
+//
+// There is one instance per process, as backing stores can be freed on any
+// thread and by any isolate. All of the state is guarded by a mutex.
+class WasiArenaAllocator final : public v8::ArrayBuffer::Allocator,
+                                 public MemoryRetainer {
+ public:
+  // The unit in which memory is handed out.
+  static constexpr size_t kGranuleSize = 4 * 1024;
+  // The size of a WebAssembly memory page.
+  static constexpr size_t kPageSize = 64 * 1024;
+  // The least amount of memory that is reserved at once.
+  static constexpr size_t kArenaSize = 16 * kPageSize;
+
+  static WasiArenaAllocator* Get();
+
+  WasiArenaAllocator(const WasiArenaAllocator&) = delete;
+  WasiArenaAllocator& operator=(const WasiArenaAllocator&) = delete;
+
+  void* Allocate(size_t size) override;
+  void* AllocateUninitialized(size_t size) override;
+  void Free(void* data, size_t size) override;
+
+  // Reports the memory of the arenas that is not used by backing stores:
+  // the free regions and the bytes of the used ones beyond the requested
+  // size.
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(WasiArenaAllocator)
+  SET_SELF_SIZE(WasiArenaAllocator)
+
+ private:
+  WasiArenaAllocator() = default;
+
+  static size_t RoundUp(size_t size) {
+    return (size + kGranuleSize - 1) & ~(kGranuleSize - 1);
+  }
+
+  // Adds a free region of at least |size| bytes at the end of the linear
+  // memory. Returns false if the memory cannot grow anymore.
+  bool Grow(size_t size);
+  void AddFreeRegion(uintptr_t address, size_t size);
+  void RemoveFreeRegion(std::map<uintptr_t, size_t>::iterator it);
+
+  mutable Mutex mutex_;
+  // The free regions, by address and by size.
+  std::map<uintptr_t, size_t> free_by_address_;
+  std::multimap<size_t, uintptr_t> free_by_size_;
+  size_t reserved_bytes_ = 0;
+  size_t free_bytes_ = 0;
+  // The sum of the sizes that were requested for the regions in use.
+  size_t requested_bytes_ = 0;
+};
+
+}  // namespace node
+
+#endif  // __wasi__
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_WASI_ARENA_ALLOCATOR_H_
@@ -0,0 +1,47 @@
+#include "cleanup_queue-inl.h"
+#include "node_bench.h"
+
+#include <vector>
+
+using node::CleanupQueue;
+
+namespace {
+
+void Noop(void* arg) {
+  node_bench::DoNotOptimize(arg);
+}
+
+// Adds state.range(0) hooks, removes every other one, and drains the rest,
+// as an Environment does with the hooks of its handles and BaseObjects.
+void BM_CleanupQueueAddRemoveDrain(node_bench::State& state) {
+  std::vector<char> args(state.range(0));
+  while (state.KeepRunning()) {
+    CleanupQueue queue;
+    for (char& arg : args) queue.Add(Noop, &arg);
+    for (size_t i = 0; i < args.size(); i += 2) queue.Remove(Noop, &args[i]);
+    queue.Drain();
+  }
+  state.SetItemsProcessed(state.iterations() * args.size());
+}
+
+// Only measures Drain(), including the hooks that are skipped when the
+// process is about to exit.
+void BM_CleanupQueueDrain(node_bench::State& state) {
+  std::vector<char> args(state.range(0));
+  bool skip_memory_only = state.range(1) != 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    CleanupQueue queue;
+    for (size_t i = 0; i < args.size(); i++)
+      queue.Add(Noop, &args[i], /* memory_only */ i % 2 == 0);
+    state.ResumeTiming();
+    queue.Drain(skip_memory_only);
+  }
+  state.SetItemsProcessed(state.iterations() * args.size());
+}
+
+}  // anonymous namespace
+
+NODE_BENCHMARK(BM_CleanupQueueAddRemoveDrain)->Arg(16)->Arg(4096);
+// Args: number of hooks, whether memory-only hooks are skipped.
+NODE_BENCHMARK(BM_CleanupQueueDrain)->Args({4096, 0})->Args({4096, 1});
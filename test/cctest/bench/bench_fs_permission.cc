@@ -0,0 +1,55 @@
+#include "node_bench.h"
+#include "permission/fs_permission.h"
+
+#include <string>
+#include <vector>
+
+using node::permission::FSPermission;
+
+namespace {
+
+// A tree with state.range(0) granted directories like the ones that
+// --allow-fs-read is typically given, plus a wildcard.
+void FillTree(FSPermission::RadixTree* tree, int64_t entries) {
+  for (int64_t i = 0; i < entries; i++) {
+    tree->Insert("/home/user/projects/app-" + std::to_string(i) +
+                 "/node_modules/");
+  }
+  tree->Insert("/tmp/cache-*");
+}
+
+void Lookup(node_bench::State& state, const std::vector<std::string>& paths) {
+  FSPermission::RadixTree tree;
+  FillTree(&tree, state.range(0));
+  while (state.KeepRunning()) {
+    for (const std::string& path : paths)
+      node_bench::DoNotOptimize(tree.Lookup(path, true));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+
+void BM_FSPermissionLookupGranted(node_bench::State& state) {
+  std::string last = std::to_string(state.range(0) - 1);
+  Lookup(state,
+         {"/home/user/projects/app-0/node_modules/lodash/index.js",
+          "/home/user/projects/app-" + last +
+              "/node_modules/@scope/pkg/lib/deeply/nested/file.js"});
+}
+
+void BM_FSPermissionLookupDenied(node_bench::State& state) {
+  Lookup(state,
+         {"/home/user/projects/other/index.js",
+          "/home/user/.ssh/id_ed25519",
+          "/etc/passwd"});
+}
+
+void BM_FSPermissionLookupWildcard(node_bench::State& state) {
+  Lookup(state, {"/tmp/cache-1234/entry", "/tmp/other/entry"});
+}
+
+}  // anonymous namespace
+
+// Args: number of granted paths.
+NODE_BENCHMARK(BM_FSPermissionLookupGranted)->Arg(1)->Arg(64)->Arg(1024);
+NODE_BENCHMARK(BM_FSPermissionLookupDenied)->Arg(1)->Arg(64)->Arg(1024);
+NODE_BENCHMARK(BM_FSPermissionLookupWildcard)->Arg(1)->Arg(64);
@@ -0,0 +1,102 @@
+#include "llhttp.h"
+#include "node_bench.h"
+
+#include <string>
+
+// Parser::Execute() in src/node_http_parser.cc is internal to that file and
+// calls into JavaScript, so this measures llhttp_execute() with callbacks
+// that do what Parser's do on the native side: collect the URL and the
+// header fields and values, and skip over the body.
+
+namespace {
+
+struct Collector {
+  std::string url;
+  std::string fields;
+  std::string values;
+  size_t body = 0;
+  size_t messages = 0;
+};
+
+Collector* CollectorOf(llhttp_t* parser) {
+  return static_cast<Collector*>(parser->data);
+}
+
+int OnUrl(llhttp_t* parser, const char* at, size_t length) {
+  CollectorOf(parser)->url.append(at, length);
+  return 0;
+}
+
+int OnHeaderField(llhttp_t* parser, const char* at, size_t length) {
+  CollectorOf(parser)->fields.append(at, length);
+  return 0;
+}
+
+int OnHeaderValue(llhttp_t* parser, const char* at, size_t length) {
+  CollectorOf(parser)->values.append(at, length);
+  return 0;
+}
+
+int OnBody(llhttp_t* parser, const char* at, size_t length) {
+  CollectorOf(parser)->body += length;
+  return 0;
+}
+
+int OnMessageComplete(llhttp_t* parser) {
+  Collector* collector = CollectorOf(parser);
+  collector->url.clear();
+  collector->fields.clear();
+  collector->values.clear();
+  collector->messages++;
+  return 0;
+}
+
+std::string MakeRequest(size_t headers, size_t body) {
+  std::string request = "POST /some/resource?with=query HTTP/1.1\r\n"
+                        "Host: example.com\r\n";
+  for (size_t i = 0; i < headers; i++) {
+    request += "X-Header-" + std::to_string(i) + ": value-" +
+               std::to_string(i) + "\r\n";
+  }
+  request += "Content-Length: " + std::to_string(body) + "\r\n\r\n";
+  request += std::string(body, 'x');
+  return request;
+}
+
+// Args: number of extra headers, body length, pipelined requests per call.
+void BM_LlhttpExecute(node_bench::State& state) {
+  std::string data;
+  for (int64_t i = 0; i < state.range(2); i++)
+    data += MakeRequest(state.range(0), state.range(1));
+
+  llhttp_settings_t settings;
+  llhttp_settings_init(&settings);
+  settings.on_url = OnUrl;
+  settings.on_header_field = OnHeaderField;
+  settings.on_header_value = OnHeaderValue;
+  settings.on_body = OnBody;
+  settings.on_message_complete = OnMessageComplete;
+
+  Collector collector;
+  llhttp_t parser;
+  llhttp_init(&parser, HTTP_REQUEST, &settings);
+  parser.data = &collector;
+  while (state.KeepRunning()) {
+    llhttp_errno_t err = llhttp_execute(&parser, data.data(), data.size());
+    node_bench::DoNotOptimize(err);
+    node_bench::ClobberMemory();
+  }
+  if (collector.messages !=
+      static_cast<size_t>(state.iterations() * state.range(2))) {
+    state.SetLabel("parse error");
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+}  // anonymous namespace
+
+NODE_BENCHMARK(BM_LlhttpExecute)
+    ->Args({0, 0, 1})
+    ->Args({16, 0, 1})
+    ->Args({16, 0, 16})
+    ->Args({4, 1024, 16});
@@ -0,0 +1,62 @@
+#include "node_bench.h"
+#include "util.h"  // For CHECK(), which nbytes.h uses.
+
+#include "nbytes.h"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// A haystack of pseudo-random lowercase letters with the needle at the very
+// end, which is the worst case for a forward search.
+std::string MakeHaystack(size_t length, const std::string& needle) {
+  std::string haystack;
+  haystack.reserve(length + needle.size());
+  uint32_t seed = 1;
+  while (haystack.size() < length) {
+    seed = seed * 1103515245 + 12345;
+    haystack += static_cast<char>('a' + (seed >> 16) % 26);
+  }
+  return haystack + needle;
+}
+
+void SearchString(node_bench::State& state, bool is_forward) {
+  std::string needle;
+  for (int64_t i = 0; i < state.range(1); i++)
+    needle += static_cast<char>('A' + i % 26);
+  std::string haystack = is_forward ? MakeHaystack(state.range(0), needle)
+                                    : needle + MakeHaystack(state.range(0), "");
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  while (state.KeepRunning()) {
+    size_t pos = nbytes::SearchString(
+        data,
+        haystack.size(),
+        reinterpret_cast<const uint8_t*>(needle.data()),
+        needle.size(),
+        is_forward ? 0 : haystack.size(),
+        is_forward);
+    node_bench::DoNotOptimize(pos);
+  }
+  state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+
+void BM_SearchStringForward(node_bench::State& state) {
+  SearchString(state, true);
+}
+
+void BM_SearchStringBackward(node_bench::State& state) {
+  SearchString(state, false);
+}
+
+}  // anonymous namespace
+
+// Args: haystack length, needle length.
+NODE_BENCHMARK(BM_SearchStringForward)
+    ->Args({65536, 1})
+    ->Args({65536, 4})
+    ->Args({65536, 16})
+    ->Args({65536, 256});
+NODE_BENCHMARK(BM_SearchStringBackward)
+    ->Args({65536, 1})
+    ->Args({65536, 16});
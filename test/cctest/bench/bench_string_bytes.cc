@@ -0,0 +1,50 @@
+#include "node_bench.h"
+#include "string_bytes.h"
+#include "v8.h"
+
+#include <string>
+
+using node::StringBytes;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Value;
+
+namespace {
+
+template <node::encoding kEncoding, char kFill>
+void BM_StringBytesEncode(node_bench::State& state) {
+  Isolate* isolate = node_bench::isolate();
+  std::string input(state.range(0), kFill);
+  while (state.KeepRunning()) {
+    HandleScope handle_scope(isolate);
+    Local<Value> value =
+        StringBytes::Encode(isolate, input.data(), input.size(), kEncoding)
+            .ToLocalChecked();
+    node_bench::DoNotOptimize(value);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_StringBytesEncodeUtf8Ascii(node_bench::State& state) {
+  BM_StringBytesEncode<node::UTF8, 'a'>(state);
+}
+
+void BM_StringBytesEncodeLatin1(node_bench::State& state) {
+  BM_StringBytesEncode<node::LATIN1, '\xe9'>(state);
+}
+
+void BM_StringBytesEncodeHex(node_bench::State& state) {
+  BM_StringBytesEncode<node::HEX, '\x5a'>(state);
+}
+
+void BM_StringBytesEncodeBase64(node_bench::State& state) {
+  BM_StringBytesEncode<node::BASE64, '\x5a'>(state);
+}
+
+}  // anonymous namespace
+
+NODE_BENCHMARK(BM_StringBytesEncodeUtf8Ascii)->Arg(16)->Arg(1024)->Arg(65536);
+NODE_BENCHMARK(BM_StringBytesEncodeLatin1)->Arg(16)->Arg(1024)->Arg(65536);
+NODE_BENCHMARK(BM_StringBytesEncodeHex)->Arg(16)->Arg(1024)->Arg(65536);
+NODE_BENCHMARK(BM_StringBytesEncodeBase64)->Arg(16)->Arg(1024)->Arg(65536);
@@ -0,0 +1,168 @@
+#include "node_bench.h"
+
+#include "node.h"
+#include "util.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <regex>
+
+namespace node_bench {
+
+namespace {
+
+std::vector<std::unique_ptr<Benchmark>>& registry() {
+  static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+  return benchmarks;
+}
+
+v8::Isolate* shared_isolate = nullptr;
+
+}  // anonymous namespace
+
+Benchmark* RegisterBenchmark(const char* name, Benchmark::Function fn) {
+  registry().push_back(std::make_unique<Benchmark>(name, fn));
+  return registry().back().get();
+}
+
+v8::Isolate* isolate() {
+  CHECK_NOT_NULL(shared_isolate);
+  return shared_isolate;
+}
+
+void UseCharPointer(char const volatile* pointer) {}
+
+class Runner {
+ public:
+  explicit Runner(double min_time) : min_time_(min_time) {}
+
+  static std::string NameOf(const Benchmark& benchmark,
+                            const std::vector<int64_t>& args) {
+    std::string name = benchmark.name_;
+    for (int64_t arg : args) name += "/" + std::to_string(arg);
+    return name;
+  }
+
+  static std::vector<std::vector<int64_t>> ArgsOf(const Benchmark& benchmark) {
+    if (benchmark.args_.empty()) return {{}};
+    return benchmark.args_;
+  }
+
+  // Like Google Benchmark, the number of iterations grows until a run takes
+  // at least `min_time_` seconds, and only that run is reported.
+  void Run(const Benchmark& benchmark, const std::vector<int64_t>& args) {
+    int64_t iterations = 1;
+    while (true) {
+      State state(iterations, args);
+      benchmark.fn_(state);
+      double seconds =
+          std::chrono::duration<double>(state.elapsed_).count();
+      if (seconds >= min_time_ || iterations >= kMaxIterations) {
+        Report(NameOf(benchmark, args), state, seconds);
+        return;
+      }
+      double multiplier =
+          seconds <= 0 ? 10 : std::min(10.0, min_time_ * 1.4 / seconds);
+      iterations = std::min<int64_t>(
+          kMaxIterations,
+          std::max<int64_t>(iterations + 1,
+                            static_cast<int64_t>(iterations * multiplier)));
+    }
+  }
+
+ private:
+  static constexpr int64_t kMaxIterations = 1000000000;
+
+  static void Report(const std::string& name, const State& state,
+                     double seconds) {
+    double ns = seconds * 1e9 / state.iterations_;
+    char rate[32] = "";
+    if (state.bytes_processed_ > 0) {
+      snprintf(rate, sizeof(rate), "%.1f MiB/s",
+               state.bytes_processed_ / seconds / (1 << 20));
+    } else if (state.items_processed_ > 0) {
+      snprintf(rate, sizeof(rate), "%.1f k items/s",
+               state.items_processed_ / seconds / 1000);
+    }
+    fprintf(stdout,
+            "%-48s %14.1f ns %12" PRId64 " %s %s\n",
+            name.c_str(),
+            ns,
+            state.iterations_,
+            rate,
+            state.label_.c_str());
+    fflush(stdout);
+  }
+
+  double min_time_;
+};
+
+}  // namespace node_bench
+
+int main(int argc, char** argv) {
+  std::string filter = ".";
+  double min_time = 0.5;
+  bool list = false;
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (strncmp(arg, "--benchmark_filter=", 19) == 0) {
+      filter = arg + 19;
+    } else if (strncmp(arg, "--benchmark_min_time=", 21) == 0) {
+      min_time = atof(arg + 21);
+    } else if (strcmp(arg, "--benchmark_list_tests") == 0) {
+      list = true;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--benchmark_filter=<regex>] "
+              "[--benchmark_min_time=<seconds>] [--benchmark_list_tests]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  uv_os_unsetenv("NODE_OPTIONS");
+  std::shared_ptr<node::InitializationResult> result =
+      node::InitializeOncePerProcess(
+          {argv[0]}, node::ProcessInitializationFlags::kNoFlags);
+  CHECK_EQ(result->exit_code(), 0);
+
+  uv_loop_t loop;
+  CHECK_EQ(uv_loop_init(&loop), 0);
+  std::unique_ptr<node::ArrayBufferAllocator,
+                  decltype(&node::FreeArrayBufferAllocator)>
+      allocator(node::CreateArrayBufferAllocator(),
+                &node::FreeArrayBufferAllocator);
+  node::MultiIsolatePlatform* platform = result->platform();
+  v8::Isolate* isolate = node::NewIsolate(allocator.get(), &loop, platform);
+  CHECK_NOT_NULL(isolate);
+  isolate->Enter();
+  node_bench::shared_isolate = isolate;
+
+  std::regex pattern(filter);
+  node_bench::Runner runner(min_time);
+  for (const auto& benchmark : node_bench::registry()) {
+    for (const auto& args : node_bench::Runner::ArgsOf(*benchmark)) {
+      std::string name = node_bench::Runner::NameOf(*benchmark, args);
+      if (!std::regex_search(name, pattern)) continue;
+      if (list) {
+        fprintf(stdout, "%s\n", name.c_str());
+        continue;
+      }
+      runner.Run(*benchmark, args);
+    }
+  }
+
+  node_bench::shared_isolate = nullptr;
+  platform->DrainTasks(isolate);
+  isolate->Exit();
+  platform->DisposeIsolate(isolate);
+  CHECK_EQ(uv_loop_close(&loop), 0);
+  node::TearDownOncePerProcess();
+  return 0;
+}
@@ -0,0 +1,153 @@
+#ifndef TEST_CCTEST_BENCH_NODE_BENCH_H_
+#define TEST_CCTEST_BENCH_NODE_BENCH_H_
+
+// A small harness for microbenchmarks of C++ hot paths, modelled on Google
+// Benchmark so that suites read the same:
+//
+//   static void BM_Something(node_bench::State& state) {
+//     std::string input(state.range(0), 'a');
+//     while (state.KeepRunning()) {
+//       node_bench::DoNotOptimize(Something(input));
+//     }
+//     state.SetBytesProcessed(state.iterations() * input.size());
+//   }
+//   NODE_BENCHMARK(BM_Something)->Arg(64)->Arg(65536);
+//
+// The node_bench executable accepts --benchmark_filter=<regex>,
+// --benchmark_min_time=<seconds> and --benchmark_list_tests.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace v8 {
+class Isolate;
+}  // namespace v8
+
+namespace node_bench {
+
+class State {
+ public:
+  State(int64_t max_iterations, const std::vector<int64_t>& args)
+      : max_iterations_(max_iterations), args_(args) {}
+
+  // Returns true as long as the benchmark should run another iteration. The
+  // clock starts with the first call.
+  inline bool KeepRunning() {
+    if (!started_) {
+      started_ = true;
+      ResumeTiming();
+    }
+    if (iterations_ < max_iterations_) {
+      iterations_++;
+      return true;
+    }
+    PauseTiming();
+    return false;
+  }
+
+  // Excludes e.g. the setup of the next iteration from the measurement.
+  void PauseTiming() {
+    if (!running_) return;
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+    running_ = false;
+  }
+  void ResumeTiming() {
+    if (running_) return;
+    start_ = std::chrono::steady_clock::now();
+    running_ = true;
+  }
+
+  int64_t range(size_t index = 0) const { return args_.at(index); }
+  int64_t iterations() const { return iterations_; }
+
+  void SetBytesProcessed(int64_t bytes) { bytes_processed_ = bytes; }
+  void SetItemsProcessed(int64_t items) { items_processed_ = items; }
+  void SetLabel(const std::string& label) { label_ = label; }
+
+ private:
+  friend class Runner;
+
+  const int64_t max_iterations_;
+  const std::vector<int64_t>& args_;
+  int64_t iterations_ = 0;
+  int64_t bytes_processed_ = 0;
+  int64_t items_processed_ = 0;
+  std::string label_;
+  bool started_ = false;
+  bool running_ = false;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration elapsed_{};
+};
+
+class Benchmark {
+ public:
+  using Function = void (*)(State&);
+
+  Benchmark(const char* name, Function fn) : name_(name), fn_(fn) {}
+
+  // Runs the benchmark once for every argument, available as state.range(0).
+  Benchmark* Arg(int64_t arg) {
+    args_.push_back({arg});
+    return this;
+  }
+  Benchmark* Args(const std::vector<int64_t>& args) {
+    args_.push_back(args);
+    return this;
+  }
+
+ private:
+  friend class Runner;
+
+  std::string name_;
+  Function fn_;
+  std::vector<std::vector<int64_t>> args_;
+};
+
+Benchmark* RegisterBenchmark(const char* name, Benchmark::Function fn);
+
+// An isolate that benchmarks can use. It is entered, but there is no handle
+// scope or context.
+v8::Isolate* isolate();
+
+void UseCharPointer(char const volatile* pointer);
+
+// MSVC and WebAssembly don't have the inline assembly that tells the compiler
+// that memory is observed, so they pass the value to another translation unit
+// instead.
+#if defined(_MSC_VER) || defined(__wasi__)
+#define NODE_BENCHMARK_NO_INLINE_ASM 1
+#endif
+
+// Keeps the compiler from optimizing away the computation of `value`.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#ifdef NODE_BENCHMARK_NO_INLINE_ASM
+  UseCharPointer(&reinterpret_cast<char const volatile&>(value));
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Forces pending writes to memory to be considered observable.
+inline void ClobberMemory() {
+#ifdef NODE_BENCHMARK_NO_INLINE_ASM
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+
+}  // namespace node_bench
+
+#define NODE_BENCHMARK_CONCAT_(a, b) a##b
+#define NODE_BENCHMARK_CONCAT(a, b) NODE_BENCHMARK_CONCAT_(a, b)
+
+#define NODE_BENCHMARK(fn)                                                     \
+  static node_bench::Benchmark* NODE_BENCHMARK_CONCAT(node_bench_, __LINE__)  \
+      [[maybe_unused]] = node_bench::RegisterBenchmark(#fn, fn)
+
+#endif  // TEST_CCTEST_BENCH_NODE_BENCH_H_
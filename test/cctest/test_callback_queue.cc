@@ -0,0 +1,74 @@
+#include "callback_queue-inl.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using node::CallbackFlags::kRefed;
+using node::CallbackQueue;
+using node::ThreadsafeCallbackQueue;
+
+using Queue = CallbackQueue<void, std::vector<int>*>;
+using ThreadsafeQueue = ThreadsafeCallbackQueue<void, std::vector<int>*>;
+
+TEST(ThreadsafeCallbackQueueTest, KeepsInsertionOrder) {
+  ThreadsafeQueue queue;
+  EXPECT_TRUE(queue.Push(queue.CreateCallback(
+      [](std::vector<int>* calls) { calls->push_back(0); }, kRefed)));
+  for (int i = 1; i < 5; i++) {
+    EXPECT_FALSE(queue.Push(queue.CreateCallback(
+        [i](std::vector<int>* calls) { calls->push_back(i); }, kRefed)));
+  }
+  EXPECT_EQ(queue.size(), 5u);
+
+  Queue taken;
+  queue.TakeAll(&taken);
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(taken.size(), 5u);
+  std::vector<int> calls;
+  while (auto head = taken.Shift()) head->Call(&calls);
+  EXPECT_EQ(calls, (std::vector<int>{0, 1, 2, 3, 4}));
+
+  // The first callback after the queue was drained wakes up the consumer.
+  EXPECT_TRUE(queue.Push(queue.CreateCallback(
+      [](std::vector<int>* calls) { calls->push_back(5); }, kRefed)));
+  EXPECT_EQ(queue.peak_size(), 5u);
+  EXPECT_EQ(queue.wakeups(), 2u);
+  // The callbacks that are left are freed with the queue.
+}
+
+TEST(ThreadsafeCallbackQueueTest, ConcurrentProducers) {
+  static constexpr int kThreads = 4;
+  static constexpr int kPerThread = 10000;
+  ThreadsafeQueue queue;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&queue, t]() {
+      for (int i = 0; i < kPerThread; i++) {
+        const int value = t * kPerThread + i;
+        queue.Push(queue.CreateCallback(
+            [value](std::vector<int>* calls) { calls->push_back(value); },
+            kRefed));
+      }
+    });
+  }
+
+  std::vector<int> calls;
+  auto drain = [&]() {
+    Queue taken;
+    queue.TakeAll(&taken);
+    while (auto head = taken.Shift()) head->Call(&calls);
+  };
+  while (calls.size() < kThreads * kPerThread) drain();
+  for (std::thread& thread : threads) thread.join();
+  drain();
+
+  // The callbacks of each producer are run in the order they were pushed.
+  ASSERT_EQ(calls.size(), static_cast<size_t>(kThreads * kPerThread));
+  std::vector<int> next(kThreads);
+  for (int value : calls) {
+    const int t = value / kPerThread;
+    EXPECT_EQ(value % kPerThread, next[t]++);
+  }
+  EXPECT_EQ(queue.size(), 0u);
+}
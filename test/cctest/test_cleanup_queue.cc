@@ -0,0 +1,105 @@
+#include "cleanup_queue-inl.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using node::CleanupQueue;
+
+namespace {
+
+struct Recorder {
+  std::vector<int> calls;
+};
+
+struct Hook {
+  Recorder* recorder;
+  int id;
+  CleanupQueue* queue = nullptr;
+  Hook* remove = nullptr;
+  Hook* add = nullptr;
+};
+
+void RunHook(void* arg) {
+  Hook* hook = static_cast<Hook*>(arg);
+  hook->recorder->calls.push_back(hook->id);
+  if (hook->remove != nullptr) hook->queue->Remove(RunHook, hook->remove);
+  if (hook->add != nullptr) hook->queue->Add(RunHook, hook->add);
+}
+
+}  // anonymous namespace
+
+TEST(CleanupQueueTest, RunsInReverseInsertionOrder) {
+  CleanupQueue queue;
+  Recorder recorder;
+  std::vector<Hook> hooks;
+  for (int i = 0; i < 5; i++) hooks.push_back({&recorder, i});
+  for (Hook& hook : hooks) queue.Add(RunHook, &hook);
+  queue.Remove(RunHook, &hooks[2]);
+  queue.Remove(RunHook, &hooks[4]);
+  queue.Remove(RunHook, &hooks[0]);
+  // Removing a hook that is not there is a no-op.
+  queue.Remove(RunHook, &hooks[0]);
+  queue.Add(RunHook, &hooks[0]);
+  EXPECT_FALSE(queue.empty());
+
+  queue.Drain();
+  EXPECT_EQ(recorder.calls, (std::vector<int>{0, 3, 1}));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CleanupQueueTest, HooksCanRemoveAndAddHooks) {
+  CleanupQueue queue;
+  Recorder recorder;
+  Hook a{&recorder, 0};
+  Hook b{&recorder, 1};
+  Hook c{&recorder, 2, &queue};
+  Hook d{&recorder, 3, &queue};
+  Hook late{&recorder, 4};
+  // `c` removes `b`, which would have run next, and `d` adds a new hook.
+  c.remove = &b;
+  d.add = &late;
+  queue.Add(RunHook, &a);
+  queue.Add(RunHook, &b);
+  queue.Add(RunHook, &c);
+  queue.Add(RunHook, &d);
+
+  // Hooks that are added while draining are left for the next call.
+  queue.Drain();
+  EXPECT_EQ(recorder.calls, (std::vector<int>{3, 2, 0}));
+  EXPECT_FALSE(queue.empty());
+  queue.Drain();
+  EXPECT_EQ(recorder.calls, (std::vector<int>{3, 2, 0, 4}));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CleanupQueueTest, SkipsMemoryOnlyHooks) {
+  CleanupQueue queue;
+  Recorder recorder;
+  Hook a{&recorder, 0};
+  Hook b{&recorder, 1};
+  Hook c{&recorder, 2};
+  queue.Add(RunHook, &a);
+  queue.Add(RunHook, &b, true);
+  queue.Add(RunHook, &c);
+
+  queue.Drain(true);
+  EXPECT_EQ(recorder.calls, (std::vector<int>{2, 0}));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CleanupQueueTest, ManyHooks) {
+  static constexpr int kCount = 100000;
+  CleanupQueue queue;
+  Recorder recorder;
+  std::vector<Hook> hooks;
+  hooks.reserve(kCount);
+  for (int i = 0; i < kCount; i++) hooks.push_back({&recorder, i});
+  for (Hook& hook : hooks) queue.Add(RunHook, &hook);
+  for (int i = 0; i < kCount; i += 2) queue.Remove(RunHook, &hooks[i]);
+
+  queue.Drain();
+  ASSERT_EQ(recorder.calls.size(), static_cast<size_t>(kCount / 2));
+  for (size_t i = 0; i < recorder.calls.size(); i++) {
+    EXPECT_EQ(recorder.calls[i], kCount - 1 - 2 * static_cast<int>(i));
+  }
+}
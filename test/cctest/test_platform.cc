@@ -1,7 +1,9 @@
 #include "node_internals.h"
 #include "libplatform/libplatform.h"
 
+#include <atomic>
 #include <string>
+#include <vector>
 #include "gtest/gtest.h"
 #include "node_test_fixture.h"
 
@@ -128,3 +130,81 @@ TEST_F(PlatformTest, TracingControllerNullptr) {
   node::SetTracingController(orig_controller);
   EXPECT_EQ(node::GetTracingController(), orig_controller);
 }
+
+// This task increments the given counter and posts |children| more tasks to
+// the worker threads from the worker thread that runs it.
+class CountingWorkerTask : public v8::Task {
+ public:
+  CountingWorkerTask(int children,
+                     std::atomic<int>* run_count,
+                     node::NodePlatform* platform)
+      : children_(children), run_count_(run_count), platform_(platform) {}
+
+  void Run() final {
+    ++*run_count_;
+    for (int i = 0; i < children_; i++) {
+      platform_->PostTaskOnWorkerThread(
+          v8::TaskPriority::kUserBlocking,
+          std::make_unique<CountingWorkerTask>(0, run_count_, platform_));
+    }
+  }
+
+ private:
+  int children_;
+  std::atomic<int>* run_count_;
+  node::NodePlatform* platform_;
+};
+
+TEST_F(PlatformTest, WorkerTasksPostedFromWorkersAreDrained) {
+  std::atomic<int> run_count{0};
+  for (int i = 0; i < 100; i++) {
+    platform->PostTaskOnWorkerThread(
+        v8::TaskPriority::kUserBlocking,
+        std::make_unique<CountingWorkerTask>(10, &run_count, platform.get()));
+  }
+  platform->DrainTasks(isolate_);
+  EXPECT_EQ(run_count, 100 * 11);
+}
+
+class RecordingTask : public v8::Task {
+ public:
+  RecordingTask(int id, std::vector<int>* order) : id_(id), order_(order) {}
+  void Run() final { order_->push_back(id_); }
+
+ private:
+  int id_;
+  std::vector<int>* order_;
+};
+
+TEST(WorkStealingTaskQueueTest, PopsByPriorityAcrossLanes) {
+  node::WorkStealingTaskQueue queue(4);
+  std::vector<int> order;
+  const v8::TaskPriority priorities[] = {
+      v8::TaskPriority::kBestEffort,
+      v8::TaskPriority::kUserVisible,
+      v8::TaskPriority::kUserBlocking,
+  };
+  // Distributed over the lanes in turn since this is not a worker thread.
+  for (int i = 0; i < 12; i++) {
+    v8::TaskPriority priority = priorities[i % 3];
+    queue.Push(std::make_unique<node::TaskQueueEntry>(
+        std::make_unique<RecordingTask>(static_cast<int>(priority), &order),
+        priority));
+  }
+  for (int i = 0; i < 12; i++) {
+    std::unique_ptr<node::TaskQueueEntry> entry = queue.BlockingPop(0);
+    ASSERT_NE(entry, nullptr);
+    entry->task->Run();
+  }
+  const int best_effort = static_cast<int>(v8::TaskPriority::kBestEffort);
+  const int user_visible = static_cast<int>(v8::TaskPriority::kUserVisible);
+  const int user_blocking = static_cast<int>(v8::TaskPriority::kUserBlocking);
+  std::vector<int> expected = {user_blocking, user_blocking, user_blocking,
+                               user_blocking, user_visible, user_visible,
+                               user_visible, user_visible, best_effort,
+                               best_effort, best_effort, best_effort};
+  EXPECT_EQ(order, expected);
+
+  queue.Stop();
+  EXPECT_EQ(queue.BlockingPop(0), nullptr);
+}
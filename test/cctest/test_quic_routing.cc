@@ -0,0 +1,111 @@
+#if HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
+#include <gtest/gtest.h>
+#include <node_sockaddr-inl.h>
+#include <quic/cid.h>
+#include <quic/routing.h>
+#include <util-inl.h>
+#include <uv.h>
+#include <memory>
+#include <thread>
+
+using node::SocketAddress;
+using node::quic::CID;
+using node::quic::CIDRouter;
+
+namespace {
+SocketAddress MakeAddress(uint32_t port) {
+  SocketAddress address;
+  CHECK(SocketAddress::New("127.0.0.1", port, &address));
+  return address;
+}
+}  // namespace
+
+TEST(CIDRouter, SharedByAddress) {
+  auto router1 = CIDRouter::Get(MakeAddress(4433));
+  auto router2 = CIDRouter::Get(MakeAddress(4433));
+  auto router3 = CIDRouter::Get(MakeAddress(4434));
+  CHECK_EQ(router1, router2);
+  CHECK_NE(router1, router3);
+}
+
+TEST(CIDRouter, Routes) {
+  uv_async_t async1;
+  uv_async_t async2;
+  auto inbox1 = std::make_shared<CIDRouter::Inbox>(&async1);
+  auto inbox2 = std::make_shared<CIDRouter::Inbox>(&async2);
+  auto router = CIDRouter::Get(MakeAddress(4435));
+
+  auto& random = CID::Factory::random();
+  auto cid1 = random.Generate();
+  auto cid2 = random.Generate();
+  auto cid3 = random.Generate();
+
+  router->Add(cid1, inbox1);
+  router->Add(cid2, inbox1);
+  router->Add(cid3, inbox2);
+  CHECK_EQ(router->Find(cid1), inbox1);
+  CHECK_EQ(router->Find(cid2), inbox1);
+  CHECK_EQ(router->Find(cid3), inbox2);
+  CHECK(!router->Find(random.Generate()));
+  CHECK(!router->Find(CID::kInvalid));
+
+  // Routes are only removed by the endpoint they lead to.
+  router->Remove(cid1, inbox2.get());
+  CHECK_EQ(router->Find(cid1), inbox1);
+  router->Remove(cid1, inbox1.get());
+  CHECK(!router->Find(cid1));
+
+  router->RemoveAll(inbox1.get());
+  CHECK(!router->Find(cid2));
+  CHECK_EQ(router->Find(cid3), inbox2);
+}
+
+TEST(CIDRouter, Inbox) {
+  uv_loop_t loop;
+  CHECK_EQ(uv_loop_init(&loop), 0);
+
+  struct State {
+    std::shared_ptr<CIDRouter::Inbox> inbox;
+    size_t received = 0;
+  } state;
+
+  uv_async_t async;
+  async.data = &state;
+  CHECK_EQ(uv_async_init(&loop,
+                         &async,
+                         [](uv_async_t* handle) {
+                           auto state = static_cast<State*>(handle->data);
+                           for (auto& datagram : state->inbox->Drain()) {
+                             CHECK_EQ(datagram.length, 3);
+                             CHECK_EQ(memcmp(datagram.data.get(), "abc", 3), 0);
+                             CHECK_EQ(datagram.remote_address.port(), 1234);
+                             state->received++;
+                           }
+                           if (state->received == 100) {
+                             uv_close(reinterpret_cast<uv_handle_t*>(handle),
+                                      nullptr);
+                           }
+                         }),
+           0);
+  state.inbox = std::make_shared<CIDRouter::Inbox>(&async);
+
+  // Datagrams are pushed from another thread.
+  std::thread thread([inbox = state.inbox] {
+    const SocketAddress remote = MakeAddress(1234);
+    for (int n = 0; n < 100; n++) {
+      CHECK(inbox->Push(reinterpret_cast<const uint8_t*>("abc"), 3, remote));
+    }
+  });
+  thread.join();
+
+  CHECK_EQ(uv_run(&loop, UV_RUN_DEFAULT), 0);
+  CHECK_EQ(state.received, 100);
+
+  // A closed inbox no longer accepts datagrams.
+  state.inbox->Close();
+  CHECK(!state.inbox->Push(
+      reinterpret_cast<const uint8_t*>("abc"), 3, MakeAddress(1234)));
+  CHECK(state.inbox->Drain().empty());
+  CHECK_EQ(uv_loop_close(&loop), 0);
+}
+#endif  // HAVE_OPENSSL && NODE_OPENSSL_HAS_QUIC
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using node::timers::TimerWheel;
+
+TEST(TimerWheelTest, ExpiresInOrder) {
+  TimerWheel wheel(1000);
+  wheel.Schedule(0, 1300);
+  wheel.Schedule(1, 1001);
+  wheel.Schedule(2, 1300);
+  wheel.Schedule(3, 1064);
+  EXPECT_EQ(wheel.size(), 4u);
+  EXPECT_EQ(wheel.NextExpiry(), 1001u);
+
+  std::vector<uint32_t> expired;
+  wheel.Expire(1000, &expired);
+  EXPECT_TRUE(expired.empty());
+
+  wheel.Expire(1064, &expired);
+  EXPECT_EQ(expired, (std::vector<uint32_t>{1, 3}));
+  EXPECT_EQ(wheel.NextExpiry(), 1300u);
+
+  // Entries with the same expiry expire in the order they were scheduled.
+  expired.clear();
+  wheel.Expire(5000, &expired);
+  EXPECT_EQ(expired, (std::vector<uint32_t>{0, 2}));
+  EXPECT_EQ(wheel.size(), 0u);
+  EXPECT_EQ(wheel.NextExpiry(), TimerWheel::kNoExpiry);
+}
+
+TEST(TimerWheelTest, RescheduleAndCancel) {
+  TimerWheel wheel;
+  wheel.Schedule(0, 10);
+  wheel.Schedule(1, 20);
+  wheel.Schedule(0, 30);
+  wheel.Cancel(1);
+  // Cancelling an entry that is not scheduled does nothing.
+  wheel.Cancel(1);
+  wheel.Cancel(7);
+  EXPECT_FALSE(wheel.IsScheduled(1));
+  EXPECT_TRUE(wheel.IsScheduled(0));
+  EXPECT_EQ(wheel.NextExpiry(), 30u);
+
+  std::vector<uint32_t> expired;
+  wheel.Expire(29, &expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.Expire(30, &expired);
+  EXPECT_EQ(expired, (std::vector<uint32_t>{0}));
+  EXPECT_FALSE(wheel.IsScheduled(0));
+}
+
+TEST(TimerWheelTest, DueEntriesExpireOnNextCall) {
+  TimerWheel wheel(100);
+  wheel.Schedule(0, 50);
+  wheel.Schedule(1, 100);
+  EXPECT_EQ(wheel.NextExpiry(), 50u);
+
+  std::vector<uint32_t> expired;
+  wheel.Expire(100, &expired);
+  EXPECT_EQ(expired, (std::vector<uint32_t>{0, 1}));
+}
+
+// Compares the wheel against a sorted map over many random operations,
+// including expiries on all of the levels and beyond the range of the top
+// one.
+TEST(TimerWheelTest, MatchesReference) {
+  for (uint64_t start : {uint64_t{0}, (uint64_t{1} << 36) - 1000}) {
+    std::mt19937_64 random(start);
+    TimerWheel wheel(start);
+    uint64_t now = start;
+    uint64_t sequence = 0;
+    std::map<uint32_t, std::pair<uint64_t, uint64_t>> reference;
+
+    for (int i = 0; i < 20000; i++) {
+      uint32_t id = random() % 500;
+      switch (random() % 10) {
+        case 0:
+          wheel.Cancel(id);
+          reference.erase(id);
+          break;
+        case 1:
+        case 2:
+        case 3:
+        case 4: {
+          uint64_t delay = random() % 4 == 0 ? random() % (uint64_t{1} << 31)
+                                             : random() % 3000;
+          wheel.Schedule(id, now + delay);
+          reference[id] = {now + delay, sequence++};
+          break;
+        }
+        default: {
+          uint64_t next = TimerWheel::kNoExpiry;
+          for (const auto& [_, entry] : reference) {
+            next = std::min(next, entry.first);
+          }
+          ASSERT_EQ(wheel.NextExpiry(), next);
+
+          now += random() % 10 == 0 ? random() % (uint64_t{1} << 31)
+                                    : random() % 200;
+          std::vector<std::pair<std::pair<uint64_t, uint64_t>, uint32_t>>
+              due;
+          for (auto it = reference.begin(); it != reference.end();) {
+            if (it->second.first <= now) {
+              due.push_back({it->second, it->first});
+              it = reference.erase(it);
+            } else {
+              ++it;
+            }
+          }
+          std::sort(due.begin(), due.end());
+          std::vector<uint32_t> expected;
+          for (const auto& entry : due) expected.push_back(entry.second);
+
+          std::vector<uint32_t> expired;
+          wheel.Expire(now, &expired);
+          ASSERT_EQ(expired, expected);
+          ASSERT_EQ(wheel.size(), reference.size());
+        }
+      }
+    }
+  }
+}
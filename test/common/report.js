@@ -110,7 +110,7 @@ function _validateContent(report, fields = []) {
                         'glibcVersionRuntime', 'glibcVersionCompiler', 'cwd',
                         'reportVersion', 'networkInterfaces', 'threadId'];
   checkForUnknownFields(header, headerFields);
-  assert.strictEqual(header.reportVersion, 5);  // Increment as needed.
+  assert.strictEqual(header.reportVersion, 6);  // Increment as needed.
   assert.strictEqual(typeof header.event, 'string');
   assert.strictEqual(typeof header.trigger, 'string');
   assert(typeof header.filename === 'string' || header.filename === null);
@@ -214,6 +214,8 @@ function _validateContent(report, fields = []) {
       'nativeContextCount',
       'detachedContextCount',
       'doesZapGarbage',
+      'hugePageAdvisedMemory',
+      'hugePageMemory',
       'heapSpaces',
     ];
     checkForUnknownFields(heap, jsHeapFields);
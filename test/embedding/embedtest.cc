@@ -87,6 +87,8 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
   //           arg1 arg2...
   // No snapshot:
   // embedtest arg1 arg2...
+  // Running in an EnvironmentPool, with or without a snapshot:
+  // embedtest --embedder-pool-runs count arg1 arg2...
   node::EmbedderSnapshotData::Pointer snapshot;
 
   std::string binary_path = args[0];
@@ -95,6 +97,7 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
   bool snapshot_as_file = false;
   std::optional<node::SnapshotConfig> snapshot_config;
   std::string snapshot_blob_path;
+  int pool_runs = 0;
   for (size_t i = 0; i < args.size(); ++i) {
     const std::string& arg = args[i];
     if (arg == "--embedder-snapshot-create") {
@@ -112,6 +115,10 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
       assert(i + 1 < args.size());
       snapshot_blob_path = args[i + 1];
       i++;
+    } else if (arg == "--embedder-pool-runs") {
+      assert(i + 1 < args.size());
+      pool_runs = std::stoi(args[i + 1]);
+      i++;
     } else {
       filtered_args.push_back(arg);
     }
@@ -151,6 +158,27 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
   }
 
   std::vector<std::string> errors;
+
+  if (pool_runs > 0) {
+    // Run the script several times, reusing a single isolate.
+    std::unique_ptr<node::EnvironmentPool> pool = node::EnvironmentPool::Create(
+        platform, &errors, snapshot.get(), 1, filtered_args, exec_args);
+    if (!pool) {
+      for (const std::string& err : errors)
+        fprintf(stderr, "%s: %s\n", binary_path.c_str(), err.c_str());
+      return 1;
+    }
+    for (int i = 0; i < pool_runs; i++) {
+      exit_code = pool->RunScript(
+                          "globalThis.require = require;"
+                          "require('vm').runInThisContext(process.argv[1]);")
+                      .FromMaybe(1);
+      if (exit_code != 0) break;
+      assert(pool->size() == 1);
+    }
+    return exit_code;
+  }
+
   std::unique_ptr<CommonEnvironmentSetup> setup;
 
   if (snapshot) {
@@ -153,6 +153,24 @@ for (const extraSnapshotArgs of [
     { cwd: tmpdir.path });
 }
 
+// Scripts run in an EnvironmentPool reuse the isolate, but not the globals.
+spawnSyncAndAssert(
+  binary,
+  ['--embedder-pool-runs', '3',
+   'console.log(typeof globalThis.poolRun); globalThis.poolRun = 1;'],
+  {
+    trim: true,
+    stdout: 'undefined\nundefined\nundefined',
+  });
+
+spawnSyncAndExit(
+  binary,
+  ['--embedder-pool-runs', '3', 'process.exitCode = 5'],
+  {
+    status: 5,
+    signal: null,
+  });
+
 // Guarantee NODE_REPL_EXTERNAL_MODULE won't bypass kDisableNodeOptionsEnv
 {
   spawnSyncAndExit(
@@ -0,0 +1,10 @@
+'use strict';
+
+// Stands in for a WASI build of node in test-benchmark-compare-wasi.js by
+// running the native node binary with the same arguments.
+const { spawnSync } = require('child_process');
+
+const { status } = spawnSync(process.execPath, process.argv.slice(2), {
+  stdio: 'inherit',
+});
+process.exit(status);
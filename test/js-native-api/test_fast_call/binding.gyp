@@ -0,0 +1,11 @@
+{
+  "targets": [
+    {
+      "target_name": "test_fast_call",
+      "defines": [ "NAPI_EXPERIMENTAL" ],
+      "sources": [
+        "test_fast_call.c"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,41 @@
+'use strict';
+// Flags: --allow-natives-syntax
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/test_fast_call`);
+
+// The slow callbacks are used until the callers are optimized.
+assert.strictEqual(binding.add(1.5, 2), 3.5);
+assert.strictEqual(binding.sumBytes(new Uint8Array([1, 2, 3])), 6);
+assert.strictEqual(binding.getFastCallCount(), 0);
+
+// Functions with a fast call are not constructors.
+assert.throws(() => new binding.add(1, 2), TypeError);
+
+// Signatures with invalid types are rejected with napi_invalid_arg.
+assert.strictEqual(binding.invalidSignature(), 1);
+
+function add(a, b) {
+  return binding.add(a, b);
+}
+
+function sumBytes(array) {
+  return binding.sumBytes(array);
+}
+
+const small = new Uint8Array([1, 2, 3]);
+const large = new Uint8Array(1024).fill(1);
+
+%PrepareFunctionForOptimization(add);
+%PrepareFunctionForOptimization(sumBytes);
+assert.strictEqual(add(1, 2), 3);
+assert.strictEqual(sumBytes(small), 6);
+%OptimizeFunctionOnNextCall(add);
+%OptimizeFunctionOnNextCall(sumBytes);
+assert.strictEqual(add(0.5, 0.25), 0.75);
+assert.strictEqual(sumBytes(small), 6);
+assert.strictEqual(sumBytes(large), 1024);
+
+// The optimized callers called the fast calls.
+assert(binding.getFastCallCount() > 0);
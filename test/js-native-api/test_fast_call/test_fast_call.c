@@ -0,0 +1,107 @@
+#include <js_native_api.h>
+#include <stdint.h>
+#include "../common.h"
+#include "../entry_point.h"
+
+static uint32_t fast_call_count = 0;
+
+static napi_value Add(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  double a, b;
+  napi_value result;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_double(env, args[0], &a));
+  NODE_API_CALL(env, napi_get_value_double(env, args[1], &b));
+  NODE_API_CALL(env, napi_create_double(env, a + b, &result));
+  return result;
+}
+
+static double FastAdd(napi_value receiver, double a, double b) {
+  fast_call_count++;
+  return a + b;
+}
+
+static napi_value SumBytes(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg, result;
+  void* data;
+  size_t length, i;
+  uint32_t sum = 0;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+  NODE_API_CALL(env, napi_get_typedarray_info(
+      env, arg, NULL, &length, &data, NULL, NULL));
+  for (i = 0; i < length; i++) {
+    sum += ((uint8_t*)data)[i];
+  }
+  NODE_API_CALL(env, napi_create_uint32(env, sum, &result));
+  return result;
+}
+
+static uint32_t FastSumBytes(napi_value receiver, napi_value array) {
+  uint8_t storage[NODE_API_FAST_TYPEDARRAY_STORAGE_SIZE];
+  const void* data;
+  size_t length, i;
+  uint32_t sum = 0;
+  fast_call_count++;
+  if (node_api_get_fast_typedarray_contents(
+          array, storage, sizeof(storage), &data, &length) != napi_ok) {
+    return 0;
+  }
+  for (i = 0; i < length; i++) {
+    sum += ((const uint8_t*)data)[i];
+  }
+  return sum;
+}
+
+static napi_value GetFastCallCount(napi_env env, napi_callback_info info) {
+  napi_value result;
+  NODE_API_CALL(env, napi_create_uint32(env, fast_call_count, &result));
+  return result;
+}
+
+static const node_api_fast_type add_args[] = {node_api_fast_float64,
+                                              node_api_fast_float64};
+static const node_api_fast_function fast_add = {
+    (const void*)FastAdd, node_api_fast_float64, add_args, 2};
+
+static const node_api_fast_type sum_bytes_args[] = {node_api_fast_value};
+static const node_api_fast_function fast_sum_bytes = {
+    (const void*)FastSumBytes, node_api_fast_uint32, sum_bytes_args, 1};
+
+// Returns the status of creating a function with a fast call that has a void
+// argument.
+static napi_value InvalidSignature(napi_env env, napi_callback_info info) {
+  static const node_api_fast_type args[] = {node_api_fast_void};
+  static const node_api_fast_function fast_function = {
+      (const void*)FastAdd, node_api_fast_float64, args, 1};
+  napi_value fn, result;
+  napi_status status = node_api_create_function_with_fast_call(
+      env, "invalid", NAPI_AUTO_LENGTH, Add, NULL, &fast_function, &fn);
+  NODE_API_CALL(env, napi_create_int32(env, status, &result));
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_value add, sum_bytes;
+  napi_property_descriptor descriptors[] = {
+      DECLARE_NODE_API_PROPERTY("getFastCallCount", GetFastCallCount),
+      DECLARE_NODE_API_PROPERTY("invalidSignature", InvalidSignature),
+  };
+
+  NODE_API_CALL(env, node_api_create_function_with_fast_call(
+      env, "add", NAPI_AUTO_LENGTH, Add, NULL, &fast_add, &add));
+  NODE_API_CALL(env, napi_set_named_property(env, exports, "add", add));
+  NODE_API_CALL(env, node_api_create_function_with_fast_call(
+      env, "sumBytes", NAPI_AUTO_LENGTH, SumBytes, NULL, &fast_sum_bytes,
+      &sum_bytes));
+  NODE_API_CALL(env, napi_set_named_property(
+      env, exports, "sumBytes", sum_bytes));
+
+  NODE_API_CALL(env, napi_define_properties(
+      env, exports, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+
+  return exports;
+}
+EXTERN_C_END
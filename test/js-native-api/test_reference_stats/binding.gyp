@@ -0,0 +1,11 @@
+{
+  "targets": [
+    {
+      "target_name": "test_reference_stats",
+      "defines": [ "NAPI_EXPERIMENTAL" ],
+      "sources": [
+        "test_reference_stats.c"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,38 @@
+'use strict';
+// Flags: --expose-gc
+
+const common = require('../../common');
+const assert = require('assert');
+const { gcUntil } = require('../../common/gc');
+const binding = require(`./build/${common.buildType}/test_reference_stats`);
+
+const { liveReferences } = binding.getReferenceStats();
+
+// References created by the addon are counted until they are deleted,
+// including when the pool has to grow for them.
+binding.createReferences(500);
+assert.strictEqual(binding.getReferenceStats().liveReferences,
+                   liveReferences + 500);
+binding.deleteReferences();
+assert.strictEqual(binding.getReferenceStats().liveReferences,
+                   liveReferences);
+
+// The memory of the deleted references is reused.
+binding.createReferences(500);
+assert.strictEqual(binding.getReferenceStats().liveReferences,
+                   liveReferences + 500);
+binding.deleteReferences();
+
+// The references of wrapped objects are counted until the objects are
+// collected and their finalizers have run.
+(() => {
+  for (let i = 0; i < 1000; i++) {
+    binding.wrap({});
+  }
+})();
+
+gcUntil('release the references of wrapped objects', () => {
+  const stats = binding.getReferenceStats();
+  return stats.liveReferences === liveReferences &&
+         stats.pendingFinalizers === 0;
+});
@@ -0,0 +1,82 @@
+#include <js_native_api.h>
+#include <stdlib.h>
+#include "../common.h"
+#include "../entry_point.h"
+
+#define MAX_REFS 1000
+
+static napi_ref refs[MAX_REFS];
+static uint32_t ref_count = 0;
+
+static napi_value getReferenceStats(napi_env env, napi_callback_info info) {
+  size_t live_references, pending_finalizers;
+  napi_value result, value;
+
+  NODE_API_CALL(env,
+                node_api_get_reference_stats(
+                    env, &live_references, &pending_finalizers));
+  NODE_API_CALL(env, napi_create_object(env, &result));
+  NODE_API_CALL(
+      env, napi_create_uint32(env, (uint32_t)live_references, &value));
+  NODE_API_CALL(
+      env, napi_set_named_property(env, result, "liveReferences", value));
+  NODE_API_CALL(
+      env, napi_create_uint32(env, (uint32_t)pending_finalizers, &value));
+  NODE_API_CALL(
+      env, napi_set_named_property(env, result, "pendingFinalizers", value));
+  return result;
+}
+
+static napi_value createReferences(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  uint32_t count, i;
+
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[0], &count));
+  NODE_API_ASSERT(env, ref_count + count <= MAX_REFS, "Too many references");
+  for (i = 0; i < count; i++) {
+    napi_value obj;
+    NODE_API_CALL(env, napi_create_object(env, &obj));
+    NODE_API_CALL(env, napi_create_reference(env, obj, 1, &refs[ref_count++]));
+  }
+  return NULL;
+}
+
+static napi_value deleteReferences(napi_env env, napi_callback_info info) {
+  while (ref_count > 0) {
+    NODE_API_CALL(env, napi_delete_reference(env, refs[--ref_count]));
+  }
+  return NULL;
+}
+
+static void noopFinalizer(node_api_basic_env env, void* data, void* hint) {}
+
+static napi_value wrap(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_wrap(env, argv[0], NULL, noopFinalizer, NULL, NULL));
+  return NULL;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor descriptors[] = {
+      DECLARE_NODE_API_PROPERTY("getReferenceStats", getReferenceStats),
+      DECLARE_NODE_API_PROPERTY("createReferences", createReferences),
+      DECLARE_NODE_API_PROPERTY("deleteReferences", deleteReferences),
+      DECLARE_NODE_API_PROPERTY("wrap", wrap),
+  };
+
+  NODE_API_CALL(
+      env,
+      napi_define_properties(env,
+                             exports,
+                             sizeof(descriptors) / sizeof(*descriptors),
+                             descriptors));
+
+  return exports;
+}
+EXTERN_C_END
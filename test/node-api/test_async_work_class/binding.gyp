@@ -0,0 +1,9 @@
+{
+  "targets": [
+    {
+      "target_name": "test_async_work_class",
+      "defines": [ "NAPI_EXPERIMENTAL" ],
+      "sources": [ "test_async_work_class.c" ]
+    }
+  ]
+}
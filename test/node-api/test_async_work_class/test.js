@@ -0,0 +1,30 @@
+'use strict';
+
+// This tests that Node-API async work that is marked as CPU-bound leaves a
+// thread of the threadpool to the other work, and that it can be cancelled
+// while it waits for a thread.
+
+const common = require('../../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  const binding = require(`./build/${common.buildType}/test_async_work_class`);
+  binding.runCpuBoundWork(3, common.mustCall((results, maxRunning) => {
+    // With two threads, one CPU-bound work item runs at a time.
+    assert.strictEqual(maxRunning, 1);
+    assert.strictEqual(results[0].cancelled, false);
+    assert.strictEqual(results[1].cancelled, false);
+    assert(results[1].queueTime > 0);
+    assert.strictEqual(results[2].cancelled, true);
+    assert.strictEqual(results[2].queueTime, 0);
+  }));
+  return;
+}
+
+const child = spawnSync(process.execPath, [__filename, 'child'], {
+  env: { ...process.env, UV_THREADPOOL_SIZE: '2' },
+  encoding: 'utf8',
+});
+assert.strictEqual(child.stderr, '');
+assert.strictEqual(child.status, 0);
@@ -0,0 +1,132 @@
+#include <node_api.h>
+#include <uv.h>
+#include "../../js-native-api/common.h"
+
+#define MAX_WORKS 8
+
+typedef struct {
+  napi_async_work work;
+  napi_status status;
+  uint64_t queue_time;
+} WorkItem;
+
+static WorkItem items[MAX_WORKS];
+static uint32_t item_count = 0;
+static uint32_t completed_count = 0;
+static napi_ref callback_ref = NULL;
+
+static uv_mutex_t mutex;
+static int running = 0;
+static int max_running = 0;
+
+static void Execute(napi_env env, void* data) {
+  uv_mutex_lock(&mutex);
+  if (++running > max_running) max_running = running;
+  uv_mutex_unlock(&mutex);
+
+  uv_sleep(50);
+
+  uv_mutex_lock(&mutex);
+  running--;
+  uv_mutex_unlock(&mutex);
+}
+
+static void Complete(napi_env env, napi_status status, void* data) {
+  WorkItem* item = (WorkItem*)data;
+  item->status = status;
+  NODE_API_CALL_RETURN_VOID(
+      env,
+      node_api_get_async_work_queue_time(env, item->work, &item->queue_time));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_async_work(env, item->work));
+  if (++completed_count < item_count) return;
+
+  napi_value results, max_running_value, callback, undefined;
+  uint32_t i;
+  NODE_API_CALL_RETURN_VOID(env, napi_create_array(env, &results));
+  for (i = 0; i < item_count; i++) {
+    napi_value result, value;
+    NODE_API_CALL_RETURN_VOID(env, napi_create_object(env, &result));
+    NODE_API_CALL_RETURN_VOID(
+        env,
+        napi_get_boolean(env, items[i].status == napi_cancelled, &value));
+    NODE_API_CALL_RETURN_VOID(
+        env, napi_set_named_property(env, result, "cancelled", value));
+    NODE_API_CALL_RETURN_VOID(
+        env, napi_create_double(env, (double)items[i].queue_time, &value));
+    NODE_API_CALL_RETURN_VOID(
+        env, napi_set_named_property(env, result, "queueTime", value));
+    NODE_API_CALL_RETURN_VOID(env, napi_set_element(env, results, i, result));
+  }
+  NODE_API_CALL_RETURN_VOID(
+      env, napi_create_int32(env, max_running, &max_running_value));
+  NODE_API_CALL_RETURN_VOID(
+      env, napi_get_reference_value(env, callback_ref, &callback));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_reference(env, callback_ref));
+  callback_ref = NULL;
+  napi_value argv[] = {results, max_running_value};
+  NODE_API_CALL_RETURN_VOID(
+      env, napi_call_function(env, undefined, callback, 2, argv, NULL));
+}
+
+// Queues CPU-bound work items and cancels the last one while it waits for a
+// thread, then calls back with the results and the highest number of work
+// items that ran at the same time.
+static napi_value RunCpuBoundWork(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], resource_name;
+  uint32_t i;
+  napi_status status;
+
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[0], &item_count));
+  NODE_API_ASSERT(env,
+                  item_count >= 2 && item_count <= MAX_WORKS,
+                  "Unexpected number of work items");
+  NODE_API_CALL(env, napi_create_reference(env, argv[1], 1, &callback_ref));
+  NODE_API_CALL(env,
+                napi_create_string_utf8(
+                    env, "TestResource", NAPI_AUTO_LENGTH, &resource_name));
+
+  completed_count = 0;
+  for (i = 0; i < item_count; i++) {
+    NODE_API_CALL(env,
+                  napi_create_async_work(env,
+                                         NULL,
+                                         resource_name,
+                                         Execute,
+                                         Complete,
+                                         &items[i],
+                                         &items[i].work));
+    NODE_API_CALL(
+        env,
+        node_api_set_async_work_class(
+            env, items[i].work, node_api_async_work_cpu_bound));
+    NODE_API_CALL(env, napi_queue_async_work(env, items[i].work));
+  }
+
+  // The class cannot change once the work is queued.
+  status = node_api_set_async_work_class(
+      env, items[0].work, node_api_async_work_io_bound);
+  NODE_API_ASSERT(env,
+                  status == napi_generic_failure,
+                  "Changing the class of queued work should fail");
+
+  NODE_API_CALL(env, napi_cancel_async_work(env, items[item_count - 1].work));
+  return NULL;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("runCpuBoundWork", RunCpuBoundWork),
+  };
+
+  uv_mutex_init(&mutex);
+  NODE_API_CALL(env,
+                napi_define_properties(
+                    env, exports, sizeof(properties) / sizeof(*properties),
+                    properties));
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
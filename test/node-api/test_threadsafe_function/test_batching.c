@@ -0,0 +1,117 @@
+#include <node_api.h>
+#include <uv.h>
+#include "../../js-native-api/common.h"
+
+#define ITEM_COUNT 10000
+
+static uv_thread_t producer;
+static int items[ITEM_COUNT];
+
+typedef struct {
+  napi_threadsafe_function tsfn;
+  napi_ref done_cb;
+} batching_info;
+
+static batching_info info;
+
+static void Produce(void* data) {
+  napi_threadsafe_function tsfn = data;
+  int index;
+
+  for (index = 0; index < ITEM_COUNT; index++) {
+    items[index] = index;
+    if (napi_call_threadsafe_function(
+            tsfn, &items[index], napi_tsfn_blocking) != napi_ok) {
+      napi_fatal_error("Produce", NAPI_AUTO_LENGTH,
+          "napi_call_threadsafe_function failed", NAPI_AUTO_LENGTH);
+    }
+  }
+
+  if (napi_release_threadsafe_function(tsfn, napi_tsfn_release) != napi_ok) {
+    napi_fatal_error("Produce", NAPI_AUTO_LENGTH,
+        "napi_release_threadsafe_function failed", NAPI_AUTO_LENGTH);
+  }
+}
+
+// Delivers each batch to JavaScript as an array of numbers.
+static void CallJsBatch(napi_env env,
+                        napi_value cb,
+                        void* context,
+                        void** data,
+                        size_t count) {
+  napi_value array, value, recv;
+  size_t index;
+
+  if (env == NULL || cb == NULL) {
+    return;
+  }
+
+  NODE_API_CALL_RETURN_VOID(env, napi_create_array_with_length(env, count,
+      &array));
+  for (index = 0; index < count; index++) {
+    NODE_API_CALL_RETURN_VOID(env, napi_create_int32(env, *(int*)data[index],
+        &value));
+    NODE_API_CALL_RETURN_VOID(env, napi_set_element(env, array,
+        (uint32_t)index, value));
+  }
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &recv));
+  NODE_API_CALL_RETURN_VOID(env, napi_call_function(env, recv, cb, 1, &array,
+      NULL));
+}
+
+static void Finalize(napi_env env, void* data, void* hint) {
+  napi_value done_cb, recv;
+
+  if (uv_thread_join(&producer) != 0) {
+    napi_fatal_error("Finalize", NAPI_AUTO_LENGTH,
+        "failed to join the producer thread", NAPI_AUTO_LENGTH);
+  }
+
+  NODE_API_CALL_RETURN_VOID(env, napi_get_reference_value(env, info.done_cb,
+      &done_cb));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_reference(env, info.done_cb));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &recv));
+  NODE_API_CALL_RETURN_VOID(env, napi_call_function(env, recv, done_cb, 0,
+      NULL, NULL));
+}
+
+// StartBatching(callback, maxBatchSize, maxQueueSize, done)
+static napi_value StartBatching(napi_env env, napi_callback_info cb_info) {
+  size_t argc = 4;
+  napi_value argv[4], name;
+  uint32_t max_batch_size, max_queue_size;
+
+  NODE_API_CALL(env, napi_get_cb_info(env, cb_info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &max_batch_size));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[2], &max_queue_size));
+  NODE_API_CALL(env, napi_create_reference(env, argv[3], 1, &info.done_cb));
+  NODE_API_CALL(env, napi_create_string_utf8(env, "batching",
+      NAPI_AUTO_LENGTH, &name));
+
+  NODE_API_CALL(env, napi_create_threadsafe_function(env, argv[0], NULL, name,
+      max_queue_size, 1, NULL, Finalize, NULL, NULL, &info.tsfn));
+  NODE_API_CALL(env, node_api_set_threadsafe_function_batching(env,
+      info.tsfn, max_batch_size, CallJsBatch));
+
+  NODE_API_ASSERT(env,
+      uv_thread_create(&producer, Produce, info.tsfn) == 0,
+      "Failed to start the producer thread");
+
+  return NULL;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("StartBatching", StartBatching),
+  };
+
+  NODE_API_CALL(
+      env,
+      napi_define_properties(env,
+                             exports,
+                             sizeof(properties) / sizeof(properties[0]),
+                             properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
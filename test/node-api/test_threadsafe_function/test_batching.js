@@ -0,0 +1,33 @@
+'use strict';
+
+// Tests that node_api_set_threadsafe_function_batching() delivers the queued
+// items in order, in batches of at most the configured size.
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/test_batching`);
+
+const ITEM_COUNT = 10000;
+
+function testBatching(maxBatchSize, maxQueueSize) {
+  return new Promise((resolve) => {
+    const received = [];
+    binding.StartBatching(common.mustCallAtLeast((batch) => {
+      assert(Array.isArray(batch));
+      assert(batch.length > 0);
+      assert(batch.length <= maxBatchSize);
+      received.push(...batch);
+    }), maxBatchSize, maxQueueSize, common.mustCall(() => {
+      assert.deepStrictEqual(received,
+                             Array.from({ length: ITEM_COUNT }, (_, i) => i));
+      resolve();
+    }));
+  });
+}
+
+(async () => {
+  // Unbounded queue, which is pushed to without a lock.
+  await testBatching(64, 0);
+  // Bounded queue, where the producer has to wait for the batches.
+  await testBatching(16, 100);
+})().then(common.mustCall());
@@ -0,0 +1,40 @@
+'use strict';
+
+// Tests the thread CPU time accounting of async resources.
+
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const fs = require('fs');
+
+function spin(micros) {
+  const start = process.threadCpuUsage();
+  let usage;
+  do {
+    usage = process.threadCpuUsage(start);
+  } while (usage.user + usage.system < micros);
+}
+
+assert.throws(() => async_hooks.getCPUTime('1'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+fs.stat(__filename, common.mustCall(() => {
+  // Not accounted while it is disabled.
+  assert.strictEqual(
+    async_hooks.getCPUTime(async_hooks.executionAsyncId()), undefined);
+
+  async_hooks.enableCPUTimeAccounting();
+  fs.stat(__filename, common.mustCall(() => {
+    const asyncId = async_hooks.executionAsyncId();
+    const before = async_hooks.getCPUTime(asyncId);
+    assert.strictEqual(typeof before, 'number');
+    spin(20000);
+    const after = async_hooks.getCPUTime(asyncId);
+    assert(after - before >= 20000, `${before} ${after}`);
+    assert.strictEqual(async_hooks.getCPUTime(1e9), undefined);
+
+    async_hooks.disableCPUTimeAccounting();
+    assert.strictEqual(async_hooks.getCPUTime(asyncId), undefined);
+  }));
+}));
@@ -0,0 +1,39 @@
+// Flags: --async-context-frame
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { AsyncLocalStorage } = require('async_hooks');
+
+// Test that the contexts of many stores are kept apart as they are entered,
+// disabled and propagated through promises.
+
+const stores = Array.from({ length: 100 }, () => new AsyncLocalStorage());
+
+function runAll(index, cb) {
+  if (index === stores.length) return cb();
+  return stores[index].run(index, () => runAll(index + 1, cb));
+}
+
+runAll(0, common.mustCall(async () => {
+  const outer = stores[50];
+  await outer.run('inner', common.mustCall(async () => {
+    await undefined;
+    assert.strictEqual(outer.getStore(), 'inner');
+    assert.strictEqual(stores[49].getStore(), 49);
+  }));
+
+  for (let i = 0; i < stores.length; i++) {
+    assert.strictEqual(stores[i].getStore(), i);
+  }
+
+  stores[10].disable();
+  assert.strictEqual(stores[10].getStore(), undefined);
+  assert.strictEqual(stores[11].getStore(), 11);
+  await undefined;
+  assert.strictEqual(stores[10].getStore(), undefined);
+  assert.strictEqual(stores[11].getStore(), 11);
+}));
+
+for (const store of stores) {
+  assert.strictEqual(store.getStore(), undefined);
+}
@@ -0,0 +1,89 @@
+'use strict';
+
+require('../common');
+
+// This tests benchmark/compare-wasi.js and benchmark/wasi-overhead.js.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+
+const compare = require.resolve('../../benchmark/compare-wasi.js');
+const overhead = require.resolve('../../benchmark/wasi-overhead.js');
+
+tmpdir.refresh();
+
+{
+  const child = spawnSync(process.execPath, [
+    compare,
+    '--native', process.execPath,
+    '--wasi', fixtures.path('wasi-benchmark-runtime.js'),
+    '--runtime', process.execPath,
+    '--env-flag', '',
+    '--runs', '2',
+    '--warmup', '0',
+    '--filter', 'basename-posix',
+    '--set', 'n=10',
+    '--set', 'pathext=/foo',
+    'path',
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.status, 0, child.stderr);
+
+  const lines = child.stdout.trim().split('\n');
+  assert.strictEqual(lines.shift(),
+                     '"binary","filename","configuration","rate","time"');
+  assert.deepStrictEqual(
+    lines.map((line) => line.split(',').slice(0, 3).join(',')),
+    [
+      '"native","path/basename-posix.js","n=10 pathext=/foo"',
+      '"wasi","path/basename-posix.js","n=10 pathext=/foo"',
+      '"native","path/basename-posix.js","n=10 pathext=/foo"',
+      '"wasi","path/basename-posix.js","n=10 pathext=/foo"',
+    ]);
+  for (const line of lines) {
+    const [rate, time] = line.split(',').slice(3).map(Number);
+    assert(rate > 0, line);
+    assert(time > 0, line);
+  }
+}
+
+{
+  const csv = tmpdir.resolve('results.csv');
+  fs.writeFileSync(csv, [
+    '"binary","filename","configuration","rate","time"',
+    '"native","fs/a.js","n=1",100,1',
+    '"wasi","fs/a.js","n=1",10,1',
+    '"native","fs/a.js","n=1",120,1',
+    '"wasi","fs/a.js","n=1",12,1',
+    '"native","fs/b.js","n=1 s=""x,y""",100,1',
+    '"wasi","fs/b.js","n=1 s=""x,y""",40,1',
+    '"native","url/c.js","n=1",100,1',
+    '"wasi","url/c.js","n=1",50,1',
+    '',
+  ].join('\n'));
+
+  const byCategory = spawnSync(process.execPath, [overhead, csv], {
+    encoding: 'utf8',
+  });
+  assert.strictEqual(byCategory.status, 0, byCategory.stderr);
+  assert.deepStrictEqual(byCategory.stdout.split('\n'), [
+    'category  configurations  slowdown  slowest configuration',
+    'fs                     2     5.00x  fs/a.js n=1 (10.00x)',
+    'url                    1     2.00x  url/c.js n=1 (2.00x)',
+    '',
+  ]);
+
+  const byFile = spawnSync(process.execPath, [overhead, '--by', 'file', csv], {
+    encoding: 'utf8',
+  });
+  assert.strictEqual(byFile.status, 0, byFile.stderr);
+  assert.deepStrictEqual(byFile.stdout.split('\n'), [
+    'file      configurations  slowdown  slowest configuration',
+    'fs/a.js                1    10.00x  fs/a.js n=1 (10.00x)',
+    'fs/b.js                1     2.50x  fs/b.js n=1 s="x,y" (2.50x)',
+    'url/c.js               1     2.00x  url/c.js n=1 (2.00x)',
+    '',
+  ]);
+}
@@ -0,0 +1,66 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { Blob } = require('buffer');
+const { openAsBlob, writeFileSync } = require('fs');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+// Pulls from a blob reader collect many small parts into a single chunk.
+(async () => {
+  const parts = Array.from({ length: 5000 }, (_, i) => `${i % 10}`);
+  const blob = new Blob(parts);
+  const expected = parts.join('');
+
+  assert.strictEqual(await blob.text(), expected);
+  assert.strictEqual(Buffer.from(await blob.arrayBuffer()).toString(),
+                     expected);
+
+  const chunks = [];
+  for await (const chunk of blob.stream()) chunks.push(chunk);
+  assert.strictEqual(Buffer.concat(chunks).toString(), expected);
+  assert.ok(chunks.length < 10, `${chunks.length} chunks`);
+})().then(common.mustCall());
+
+// Large parts are not split, and streams still produce bounded chunks when
+// parts are smaller than the chunk size.
+(async () => {
+  const big = Buffer.alloc(256 * 1024, 'x');
+  const small = Buffer.alloc(1000, 'y');
+  const parts = [big, ...Array(200).fill(small), big];
+  const blob = new Blob(parts);
+
+  const chunks = [];
+  for await (const chunk of blob.stream()) chunks.push(chunk);
+  assert.deepStrictEqual(Buffer.concat(chunks), Buffer.concat(parts));
+  assert.strictEqual(chunks[0].length, big.length);
+  assert.ok(chunks.length > 3);
+
+  assert.deepStrictEqual(Buffer.from(await blob.arrayBuffer()),
+                         Buffer.concat(parts));
+})().then(common.mustCall());
+
+// Batching also works across file-backed and in-memory parts.
+(async () => {
+  const file = tmpdir.resolve('batched-reads.txt');
+  writeFileSync(file, 'file contents');
+  const fileBlob = await openAsBlob(file);
+  const blob = new Blob(['a', fileBlob, 'b', fileBlob.slice(5), 'c']);
+  const expected = 'afile contentsbcontentsc';
+  assert.strictEqual(await blob.text(), expected);
+
+  const chunks = [];
+  for await (const chunk of blob.stream()) chunks.push(chunk);
+  assert.strictEqual(Buffer.concat(chunks).toString(), expected);
+})().then(common.mustCall());
+
+// Empty blobs.
+(async () => {
+  const blob = new Blob([]);
+  assert.strictEqual(await blob.text(), '');
+  assert.strictEqual((await blob.arrayBuffer()).byteLength, 0);
+  // eslint-disable-next-line no-unused-vars
+  for await (const _ of blob.stream()) assert.fail('unexpected chunk');
+})().then(common.mustCall());
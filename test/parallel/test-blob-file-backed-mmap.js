@@ -0,0 +1,78 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { appendFileSync, openAsBlob, writeFileSync } = require('fs');
+const { Blob } = require('buffer');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const data = Buffer.alloc(300 * 1024);
+for (let i = 0; i < data.length; i++) data[i] = i % 251;
+
+const testfile = tmpdir.resolve('mmap-backed-blob.bin');
+const modified = tmpdir.resolve('mmap-backed-blob-modified.bin');
+const empty = tmpdir.resolve('mmap-backed-blob-empty.bin');
+writeFileSync(testfile, data);
+writeFileSync(modified, data);
+writeFileSync(empty, '');
+
+(async () => {
+  const blob = await openAsBlob(testfile, { mmap: true });
+  assert.strictEqual(blob.size, data.length);
+
+  // Can be read multiple times.
+  assert.deepStrictEqual(Buffer.from(await blob.arrayBuffer()), data);
+  assert.deepStrictEqual(Buffer.from(await blob.arrayBuffer()), data);
+
+  const chunks = [];
+  for await (const chunk of blob.stream()) chunks.push(chunk);
+  assert.deepStrictEqual(Buffer.concat(chunks), data);
+
+  // Slices are views over the same mapping.
+  for (const [start, end] of [[0, 10], [65530, 65550], [1000, undefined],
+                              [data.length - 5, data.length + 5],
+                              [10, 5]]) {
+    const slice = blob.slice(start, end);
+    const expected = data.subarray(start, end);
+    assert.strictEqual(slice.size, expected.length);
+    assert.deepStrictEqual(Buffer.from(await slice.arrayBuffer()), expected);
+    assert.deepStrictEqual(
+      Buffer.from(await slice.slice(1, 3).arrayBuffer()),
+      expected.subarray(1, 3));
+  }
+
+  // Can be combined with other Blobs.
+  const combined = new Blob(['hello', blob.slice(0, 4), 'world']);
+  assert.deepStrictEqual(
+    Buffer.from(await combined.arrayBuffer()),
+    Buffer.concat([Buffer.from('hello'), data.subarray(0, 4),
+                   Buffer.from('world')]));
+})().then(common.mustCall());
+
+(async () => {
+  // If the file is modified, reads fail.
+  const blob = await openAsBlob(modified, { mmap: true });
+  appendFileSync(modified, 'abc');
+  await assert.rejects(blob.arrayBuffer(), { name: 'NotReadableError' });
+})().then(common.mustCall());
+
+(async () => {
+  const blob = await openAsBlob(empty, { mmap: true });
+  assert.strictEqual(blob.size, 0);
+  assert.strictEqual(await blob.text(), '');
+})().then(common.mustCall());
+
+for (const mmap of [1, 'true', {}]) {
+  assert.throws(() => openAsBlob(testfile, { mmap }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+if (!common.isWindows) {
+  // Only regular files can be mapped.
+  assert.throws(() => openAsBlob(tmpdir.path, { mmap: true }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+}
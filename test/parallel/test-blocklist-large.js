@@ -0,0 +1,75 @@
+'use strict';
+
+require('../common');
+
+// This tests that BlockList answers checks correctly for large rule sets and
+// for rules that mix address families.
+
+const assert = require('assert');
+const { BlockList } = require('net');
+
+{
+  const blockList = new BlockList();
+  for (let i = 0; i < 65536; i++) {
+    blockList.addSubnet(`10.${i >> 8}.${i & 0xff}.0`, 28);
+  }
+  for (let i = 0; i < 1000; i++) {
+    blockList.addAddress(`2001:db8::${i.toString(16)}`, 'ipv6');
+  }
+  blockList.addRange('192.168.1.10', '192.168.3.20');
+
+  assert(blockList.check('10.0.0.0'));
+  assert(blockList.check('10.255.255.15'));
+  assert(!blockList.check('10.255.255.16'));
+  assert(!blockList.check('11.0.0.1'));
+  assert(blockList.check('2001:db8::3e7', 'ipv6'));
+  assert(!blockList.check('2001:db8::3e8', 'ipv6'));
+  assert(!blockList.check('192.168.1.9'));
+  assert(blockList.check('192.168.1.10'));
+  assert(blockList.check('192.168.2.200'));
+  assert(blockList.check('192.168.3.20'));
+  assert(!blockList.check('192.168.3.21'));
+  // IPv4 rules also match the IPv4-mapped IPv6 addresses.
+  assert(blockList.check('::ffff:10.1.2.3', 'ipv6'));
+  assert(blockList.check('::ffff:192.168.2.1', 'ipv6'));
+  assert(!blockList.check('::10.1.2.3', 'ipv6'));
+}
+
+{
+  const blockList = new BlockList();
+  blockList.addRange('::ffff:1.1.1.1', '::ffff:1.1.1.10', 'ipv6');
+  blockList.addSubnet('::ffff:2.2.0.0', 112, 'ipv6');
+  assert(blockList.check('1.1.1.5'));
+  assert(!blockList.check('1.1.1.11'));
+  assert(blockList.check('2.2.255.1'));
+  assert(!blockList.check('2.3.0.1'));
+}
+
+{
+  // IPv4 addresses are not ordered relative to IPv6 addresses that are not
+  // IPv4-mapped, so they never fall into such ranges.
+  const blockList = new BlockList();
+  blockList.addRange('::1', 'ffff::', 'ipv6');
+  assert(!blockList.check('1.1.1.5'));
+  assert(blockList.check('::ffff:1.1.1.5', 'ipv6'));
+  assert(blockList.check('::2', 'ipv6'));
+  assert(!blockList.check('ffff::1', 'ipv6'));
+}
+
+{
+  // Subnets that contain the whole IPv4-mapped range match all IPv4
+  // addresses.
+  const blockList = new BlockList();
+  blockList.addSubnet('::', 64, 'ipv6');
+  assert(blockList.check('8.8.8.8'));
+  assert(blockList.check('::1', 'ipv6'));
+  assert(!blockList.check('1::1', 'ipv6'));
+}
+
+{
+  const blockList = new BlockList();
+  blockList.addSubnet('0.0.0.0', 0);
+  assert(blockList.check('255.255.255.255'));
+  assert(blockList.check('::ffff:1.2.3.4', 'ipv6'));
+  assert(!blockList.check('::1', 'ipv6'));
+}
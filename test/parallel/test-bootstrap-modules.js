@@ -42,7 +42,6 @@ expected.beforePreExec = new Set([
   'NativeModule internal/util/types',
   'NativeModule internal/validators',
   'NativeModule internal/linkedlist',
-  'NativeModule internal/priority_queue',
   'NativeModule internal/assert',
   'NativeModule internal/util/inspect',
   'NativeModule internal/util/debuglog',
@@ -65,6 +64,7 @@ expected.beforePreExec = new Set([
   'NativeModule timers',
   'Internal Binding trace_events',
   'NativeModule internal/constants',
+  'Internal Binding path',
   'NativeModule path',
   'NativeModule internal/process/execution',
   'NativeModule internal/process/permission',
@@ -72,7 +72,6 @@ expected.beforePreExec = new Set([
   'NativeModule internal/console/constructor',
   'NativeModule internal/console/global',
   'NativeModule internal/querystring',
-  'NativeModule querystring',
   'Internal Binding url',
   'Internal Binding url_pattern',
   'Internal Binding blob',
@@ -102,6 +101,7 @@ expected.beforePreExec = new Set([
   'Internal Binding module_wrap',
   'NativeModule internal/modules/cjs/loader',
   'NativeModule diagnostics_channel',
+  'Internal Binding diagnostics_channel',
   'Internal Binding wasm_web_api',
   'NativeModule internal/events/abort_listener',
   'NativeModule internal/modules/typescript',
@@ -120,11 +120,13 @@ const { isMainThread } = require('worker_threads');
 
 if (isMainThread) {
   [
+    'NativeModule querystring',
     'NativeModule url',
   ].forEach(expected.beforePreExec.add.bind(expected.beforePreExec));
 } else {  // Worker.
   [
     'NativeModule diagnostics_channel',
+    'Internal Binding diagnostics_channel',
     'NativeModule internal/abort_controller',
     'NativeModule internal/error_serdes',
     'NativeModule internal/perf/event_loop_utilization',
@@ -98,3 +98,24 @@ assert.deepStrictEqual(
 assert.deepStrictEqual(Buffer.concat([new Uint8Array([0x41, 0x42]),
                                       new Uint8Array([0x43, 0x44])]),
                        Buffer.from('ABCD'));
+
+// Longer lists are copied in a single call into C++.
+{
+  const list = [];
+  for (let i = 0; i < 20; i++)
+    list.push(i % 2 ? Buffer.from([i]) : new Uint8Array([i, i]));
+  const expected = Buffer.from(list.flatMap((buf) => [...buf]));
+  assert.deepStrictEqual(Buffer.concat(list), expected);
+  assert.deepStrictEqual(Buffer.concat(list, 7), expected.subarray(0, 7));
+  assert.deepStrictEqual(
+    Buffer.concat(list, expected.length + 5),
+    Buffer.concat([expected, Buffer.alloc(5)]));
+
+  assert.throws(() => {
+    Buffer.concat([...list, 'hello'], 10);
+  }, {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: 'The "list[20]" argument must be an instance of Buffer ' +
+             'or Uint8Array. Received type string (\'hello\')'
+  });
+}
@@ -0,0 +1,104 @@
+'use strict';
+
+require('../common');
+
+// Hex and base64 strings are coded in blocks of 16 or 32 characters where
+// SIMD code is available. Check lengths around the block sizes and invalid
+// characters in every position of a block against a plain implementation.
+
+const assert = require('assert');
+
+const digits = '0123456789abcdef';
+const alphabet =
+  'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+function hex(buf) {
+  let str = '';
+  for (const byte of buf)
+    str += digits[byte >> 4] + digits[byte & 15];
+  return str;
+}
+
+function base64(buf) {
+  let str = '';
+  for (let i = 0; i < buf.length; i += 3) {
+    const n = (buf[i] << 16) | (buf[i + 1] << 8) | buf[i + 2];
+    str += alphabet[n >> 18] + alphabet[(n >> 12) & 63] +
+           (i + 1 < buf.length ? alphabet[(n >> 6) & 63] : '=') +
+           (i + 2 < buf.length ? alphabet[n & 63] : '=');
+  }
+  return str;
+}
+
+const source = Buffer.alloc(200);
+for (let i = 0; i < source.length; i++)
+  source[i] = (i * 151 + (i >> 3)) & 0xff;
+
+for (let length = 0; length <= 100; length++) {
+  const data = source.subarray(0, length);
+
+  const hexString = hex(data);
+  assert.strictEqual(data.toString('hex'), hexString);
+  assert.deepStrictEqual(Buffer.from(hexString, 'hex'), data);
+  assert.deepStrictEqual(Buffer.from(hexString.toUpperCase(), 'hex'), data);
+
+  const base64String = base64(data);
+  assert.strictEqual(data.toString('base64'), base64String);
+  assert.deepStrictEqual(Buffer.from(base64String, 'base64'), data);
+
+  const base64urlString = base64String.replace(/\+/g, '-')
+                                      .replace(/\//g, '_')
+                                      .replace(/=/g, '');
+  assert.strictEqual(data.toString('base64url'), base64urlString);
+  assert.deepStrictEqual(Buffer.from(base64urlString, 'base64url'), data);
+
+  const latin1 = data.toString('latin1');
+  assert.strictEqual(btoa(latin1), base64String);
+  assert.strictEqual(atob(base64String), latin1);
+}
+
+{
+  // Decoding of hex stops at the first pair that is not hex.
+  const data = source.subarray(0, 64);
+  const hexString = hex(data);
+  for (let i = 0; i < hexString.length; i++) {
+    for (const c of ['g', 'G', '/', ':', '@', '`', ' ', '\xff']) {
+      const str = hexString.slice(0, i) + c + hexString.slice(i + 1);
+      assert.deepStrictEqual(Buffer.from(str, 'hex'),
+                             data.subarray(0, i >> 1));
+    }
+  }
+
+  // Writes are limited to the size of the target.
+  for (const size of [15, 16, 17, 31, 33]) {
+    const target = Buffer.alloc(size);
+    assert.strictEqual(target.write(hexString, 'hex'), size);
+    assert.deepStrictEqual(target, data.subarray(0, size));
+  }
+}
+
+{
+  const data = source.subarray(0, 96);
+  const base64String = base64(data);
+
+  // White space and the characters of the other alphabet are accepted.
+  const wrapped = base64String.replace(/.{19}/g, '$&\n');
+  assert.deepStrictEqual(Buffer.from(wrapped, 'base64'), data);
+  assert.strictEqual(atob(wrapped), data.toString('latin1'));
+  const url = base64String.replace(/\+/g, '-').replace(/\//g, '_');
+  assert.deepStrictEqual(Buffer.from(url, 'base64'), data);
+  assert.deepStrictEqual(Buffer.from(base64String, 'base64url'), data);
+
+  // Invalid characters are skipped by Buffer.from() and rejected by atob().
+  for (let i = 0; i < base64String.length; i += 5) {
+    const str = base64String.slice(0, i) + '*' + base64String.slice(i);
+    assert.deepStrictEqual(Buffer.from(str, 'base64'), data);
+    assert.throws(() => atob(str), { name: 'InvalidCharacterError' });
+  }
+
+  for (const size of [11, 12, 13, 47, 49]) {
+    const target = Buffer.alloc(size);
+    assert.strictEqual(target.write(base64String, 'base64'), size);
+    assert.deepStrictEqual(target, data.subarray(0, size));
+  }
+}
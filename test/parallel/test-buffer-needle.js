@@ -0,0 +1,124 @@
+'use strict';
+
+require('../common');
+
+// Buffer#indexOf() and Needle search with SIMD code for needles of two or
+// more bytes, and fall back to Boyer-Moore-Horspool for inputs with many
+// partial matches. Check both against a plain search.
+
+const assert = require('assert');
+const { Needle } = require('buffer');
+
+function naiveIndexOf(haystack, needle, start) {
+  for (let i = start; i + needle.length <= haystack.length; i++) {
+    let j = 0;
+    while (j < needle.length && haystack[i + j] === needle[j]) j++;
+    if (j === needle.length) return i;
+  }
+  return -1;
+}
+
+function naiveLastIndexOf(haystack, needle, start) {
+  for (let i = Math.min(start, haystack.length - needle.length); i >= 0; i--) {
+    let j = 0;
+    while (j < needle.length && haystack[i + j] === needle[j]) j++;
+    if (j === needle.length) return i;
+  }
+  return -1;
+}
+
+function check(haystack, needleBytes, start) {
+  const expected = naiveIndexOf(haystack, needleBytes, start);
+  assert.strictEqual(haystack.indexOf(needleBytes, start), expected);
+  const needle = new Needle(needleBytes);
+  assert.strictEqual(needle.indexOf(haystack, start), expected);
+  assert.strictEqual(needle.includes(haystack, start), expected !== -1);
+  const last = naiveLastIndexOf(haystack, needleBytes, start);
+  assert.strictEqual(haystack.lastIndexOf(needleBytes, start), last);
+  assert.strictEqual(needle.lastIndexOf(haystack, start), last);
+}
+
+{
+  // Small alphabets give many candidates for the first and last byte.
+  let seed = 1;
+  const random = () => (seed = (seed * 1103515245 + 12345) >>> 0) >>> 16;
+  const haystack = Buffer.alloc(4096);
+  for (let i = 0; i < haystack.length; i++)
+    haystack[i] = 97 + random() % 3;
+  for (let n = 0; n < 300; n++) {
+    const length = 2 + random() % 20;
+    const from = random() % (haystack.length - length);
+    const needle = Buffer.from(haystack.subarray(from, from + length));
+    if (n % 3 === 0) needle[random() % length] = 97 + random() % 4;
+    check(haystack, needle, random() % haystack.length);
+    check(haystack, needle, 0);
+  }
+}
+
+{
+  // Matches in each position of a 16 byte block, and at the very end.
+  const haystack = Buffer.alloc(100, 'x');
+  for (let i = 0; i < haystack.length - 3; i++) {
+    haystack.write('abc', i);
+    check(haystack, Buffer.from('abc'), 0);
+    check(haystack, Buffer.from('xab'), 0);
+    haystack.fill('x', i, i + 3);
+  }
+}
+
+{
+  // Long runs of the same byte where only the end matches.
+  const haystack = Buffer.alloc(1 << 20, 'a');
+  haystack[haystack.length - 1] = 98;
+  const needle = Buffer.alloc(100, 'a');
+  needle[99] = 98;
+  assert.strictEqual(haystack.indexOf(needle), haystack.length - 100);
+  assert.strictEqual(new Needle(needle).indexOf(haystack),
+                     haystack.length - 100);
+  check(haystack.subarray(0, 5000), needle, 0);
+}
+
+{
+  const needle = new Needle('abc');
+  assert.strictEqual(needle.length, 3);
+  const haystack = Buffer.from('abcabcabc');
+  assert.strictEqual(needle.indexOf(haystack), 0);
+  assert.strictEqual(needle.indexOf(haystack, 1), 3);
+  assert.strictEqual(needle.indexOf(haystack, -3), 6);
+  assert.strictEqual(needle.indexOf(haystack, -100), 0);
+  assert.strictEqual(needle.indexOf(haystack, 7), -1);
+  assert.strictEqual(needle.indexOf(haystack, '1'), 3);
+  assert.strictEqual(needle.indexOf(haystack, NaN), 0);
+  assert.strictEqual(needle.lastIndexOf(haystack), 6);
+  assert.strictEqual(needle.lastIndexOf(haystack, 5), 3);
+  assert.strictEqual(needle.lastIndexOf(haystack, -100), -1);
+  assert.strictEqual(needle.lastIndexOf(haystack, 100), 6);
+  assert.strictEqual(needle.indexOf(Buffer.alloc(0)), -1);
+  assert.strictEqual(needle.includes(new Uint8Array(haystack)), true);
+  assert.strictEqual(needle.indexOf(new DataView(haystack.buffer,
+                                                 haystack.byteOffset + 1,
+                                                 5)), 2);
+
+  // The bytes of the value are copied.
+  const value = Buffer.from('xyz');
+  const copied = new Needle(value);
+  value.fill(0);
+  assert.strictEqual(copied.indexOf(Buffer.from('__xyz')), 2);
+
+  assert.strictEqual(new Needle('деревня').length, 14);
+  assert.strictEqual(new Needle('6869', 'hex').indexOf(Buffer.from('ohhi')),
+                     2);
+  assert.strictEqual(new Needle(new Uint16Array([0x6261])).length, 2);
+
+  const empty = new Needle('');
+  assert.strictEqual(empty.indexOf(haystack), 0);
+  assert.strictEqual(empty.indexOf(haystack, 4), 4);
+  assert.strictEqual(empty.indexOf(haystack, 100), haystack.length);
+  assert.strictEqual(empty.lastIndexOf(haystack), haystack.length);
+
+  assert.throws(() => new Needle(1), { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => new Needle('a', 'bogus'), {
+    code: 'ERR_UNKNOWN_ENCODING',
+  });
+  assert.throws(() => needle.indexOf('abc'), { code: 'ERR_INVALID_ARG_TYPE' });
+}
@@ -0,0 +1,63 @@
+// Flags: --experimental-arraybuffer-slab-allocator --expose-gc
+'use strict';
+
+const common = require('../common');
+
+// Small backing stores come from slabs of blocks of the same size. Check
+// that the blocks do not overlap, that reused blocks are zero-filled where
+// they have to be, and that memory from a worker can be freed on the main
+// thread.
+
+const assert = require('assert');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+function fillAndCheck() {
+  const buffers = [];
+  for (let round = 0; round < 3; round++) {
+    for (let size = 0; size <= 4096; size += 7) {
+      const buf = Buffer.allocUnsafeSlow(size);
+      buf.fill(size & 0xff);
+      buffers.push(buf);
+    }
+    for (const buf of buffers) {
+      for (let i = 0; i < buf.length; i++)
+        assert.strictEqual(buf[i], buf.length & 0xff);
+    }
+    buffers.length = 0;
+    globalThis.gc();
+  }
+
+  for (const size of [1, 16, 17, 100, 1500, 2048, 2049]) {
+    for (let i = 0; i < 100; i++) {
+      Buffer.allocUnsafeSlow(size).fill(0xff);
+      assert.ok(Buffer.alloc(size).every((byte) => byte === 0));
+      assert.ok(new Uint8Array(size).every((byte) => byte === 0));
+      assert.ok(new ArrayBuffer(size).byteLength === size);
+    }
+  }
+}
+
+if (isMainThread) {
+  fillAndCheck();
+
+  const worker = new Worker(__filename);
+  worker.on('message', common.mustCall((buffers) => {
+    for (const [i, buf] of buffers.entries()) {
+      assert.strictEqual(buf.byteLength, i * 16);
+      assert.ok(new Uint8Array(buf).every((byte) => byte === i));
+    }
+    buffers.length = 0;
+    globalThis.gc();
+  }));
+  worker.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    globalThis.gc();
+    fillAndCheck();
+  }));
+} else {
+  fillAndCheck();
+  const buffers = [];
+  for (let i = 0; i < 100; i++)
+    buffers.push(new Uint8Array(i * 16).fill(i).buffer);
+  parentPort.postMessage(buffers, buffers);
+}
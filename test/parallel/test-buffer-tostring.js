@@ -35,3 +35,17 @@ for (let i = 1; i < 10; i++) {
   assert.ok(!Buffer.isEncoding(encoding));
   assert.throws(() => Buffer.from('foo').toString(encoding), error);
 }
+
+// ucs2 data that is all Latin-1 and data that is not, also at odd offsets.
+for (const str of ['hä', 'h€', 'ÿ'.repeat(5000), `${'ÿ'.repeat(5000)}€`]) {
+  const buf = Buffer.from(str, 'ucs2');
+  assert.strictEqual(buf.length, str.length * 2);
+  assert.strictEqual(buf.toString('ucs2'), str);
+  const unaligned = Buffer.alloc(buf.length + 1);
+  buf.copy(unaligned, 1);
+  assert.strictEqual(unaligned.toString('ucs2', 1), str);
+  assert.strictEqual(unaligned.write(str, 1, 'ucs2'), buf.length);
+  assert.deepStrictEqual(unaligned.subarray(1), buf);
+}
+assert.deepStrictEqual(Buffer.from('hä', 'ucs2'),
+                       Buffer.from([0x68, 0x00, 0xe4, 0x00]));
@@ -0,0 +1,89 @@
+// Flags: --expose-internals
+'use strict';
+require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const { webSocketMask, parseWebSocketFrameHeader } = internalBinding('buffer');
+
+function maskInJS(data, key) {
+  const result = Buffer.from(data);
+  for (let i = 0; i < result.length; i++) {
+    result[i] ^= key[i & 3];
+  }
+  return result;
+}
+
+// Masking covers the vectorized blocks and the bytes that follow them, for
+// views that start anywhere in their buffer.
+{
+  const key = Buffer.from([0x37, 0xfa, 0x21, 0x3d]);
+  const source = Buffer.alloc(200);
+  for (let i = 0; i < source.length; i++) source[i] = i * 7;
+
+  for (let length = 0; length <= 70; length++) {
+    for (const offset of [0, 1, 3]) {
+      const data = Buffer.from(source).subarray(offset, offset + length);
+      const expected = maskInJS(data, key);
+      webSocketMask(data, key);
+      assert.deepStrictEqual(data, expected);
+      // Masking twice restores the data.
+      webSocketMask(data, key);
+      assert.deepStrictEqual(data, source.subarray(offset, offset + length));
+    }
+  }
+
+  // Only the first four bytes of the key are used.
+  const data = Buffer.from('Hello');
+  webSocketMask(data, Buffer.from([0x37, 0xfa, 0x21, 0x3d, 0xff]));
+  assert.deepStrictEqual(data, Buffer.from([0x7f, 0x9f, 0x4d, 0x51, 0x58]));
+}
+
+// Frame headers.
+{
+  const out = new Float64Array(3);
+
+  function parse(bytes) {
+    out.fill(-1);
+    return parseWebSocketFrameHeader(Buffer.from(bytes), out);
+  }
+
+  // The examples of RFC 6455, section 5.7.
+  assert.strictEqual(parse([0x81, 0x05, 0x48, 0x65, 0x6c, 0x6c, 0x6f]), 2);
+  assert.deepStrictEqual([...out], [0x81, 0, 5]);
+
+  assert.strictEqual(
+    parse([0x81, 0x85, 0x37, 0xfa, 0x21, 0x3d, 0x7f, 0x9f, 0x4d, 0x51, 0x58]),
+    6);
+  assert.deepStrictEqual([...out], [0x81, 1, 5]);
+
+  assert.strictEqual(parse([0x82, 0x7e, 0x01, 0x00]), 4);
+  assert.deepStrictEqual([...out], [0x82, 0, 256]);
+
+  assert.strictEqual(
+    parse([0x82, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00]), 10);
+  assert.deepStrictEqual([...out], [0x82, 0, 65536]);
+
+  assert.strictEqual(
+    parse([0x02, 0xff, 0x00, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+           1, 2, 3, 4]),
+    14);
+  assert.deepStrictEqual([...out], [0x02, 1, Number.MAX_SAFE_INTEGER]);
+
+  // Incomplete headers.
+  for (const bytes of [
+    [],
+    [0x81],
+    [0x81, 0x85, 0x37, 0xfa, 0x21],
+    [0x82, 0x7e, 0x01],
+    [0x82, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 1, 2, 3],
+  ]) {
+    assert.strictEqual(parse(bytes), 0);
+    assert.deepStrictEqual([...out], [-1, -1, -1]);
+  }
+
+  // Payload lengths that can't be represented exactly.
+  assert.strictEqual(
+    parse([0x82, 0x7f, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00]), -1);
+  assert.strictEqual(
+    parse([0x82, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00]), -1);
+}
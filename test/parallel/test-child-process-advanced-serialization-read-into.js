@@ -0,0 +1,54 @@
+'use strict';
+
+// The rest of large advanced-serialization IPC messages is read in place.
+// Check that large messages arrive intact both ways, also when they are
+// sent back to back with small ones that end up in the same reads.
+
+const common = require('../common');
+const assert = require('assert');
+const child_process = require('child_process');
+
+function makeMessages() {
+  const messages = [];
+  for (const size of [16, 256 * 1024 - 100, 256 * 1024, 3 * 1024 * 1024 + 7, 5]) {
+    const data = new Uint8Array(size);
+    for (let i = 0; i < size; i++) data[i] = i * 7 + size;
+    messages.push({ size, data, nested: { data: data.subarray(1, 11) } });
+  }
+  return messages;
+}
+
+function check(message, expected) {
+  assert.strictEqual(message.size, expected.size);
+  assert.deepStrictEqual(message.data, expected.data);
+  assert.deepStrictEqual(message.nested.data, expected.nested.data);
+}
+
+if (process.argv[2] === 'child') {
+  const expected = makeMessages();
+  let received = 0;
+  process.on('message', (message) => {
+    check(message, expected[received]);
+    if (++received === expected.length) {
+      for (const message of expected)
+        process.send(message);
+      process.disconnect();
+    }
+  });
+} else {
+  const child = child_process.fork(__filename, ['child'], {
+    serialization: 'advanced',
+  });
+  const expected = makeMessages();
+  for (const message of expected)
+    child.send(message);
+
+  let received = 0;
+  child.on('message', common.mustCall((message) => {
+    check(message, expected[received++]);
+  }, expected.length));
+  child.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    assert.strictEqual(received, expected.length);
+  }));
+}
@@ -0,0 +1,119 @@
+// Flags: --experimental-spawn-zygote
+'use strict';
+const common = require('../common');
+if (!common.isLinux)
+  common.skip('the spawn zygote is only available on Linux');
+
+const assert = require('assert');
+const { fork, spawn } = require('child_process');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+if (process.argv[2] === 'child') {
+  process.on('message', (message) => {
+    process.send({ message, ppid: process.ppid });
+  });
+  return;
+}
+
+tmpdir.refresh();
+
+function run(args, options = {}) {
+  return new Promise((resolve, reject) => {
+    const child = spawn(process.execPath, args, options);
+    let stdout = '';
+    child.stdout?.setEncoding('utf8');
+    child.stdout?.on('data', (chunk) => stdout += chunk);
+    child.on('error', reject);
+    child.on('close', (code, signal) => resolve({ child, code, signal, stdout }));
+  });
+}
+
+(async () => {
+  // Children are spawned by the zygote, not by this process.
+  {
+    const { child, code, stdout } =
+      await run(['-p', 'process.ppid'], { stdio: ['ignore', 'pipe', 'inherit'] });
+    assert.strictEqual(code, 0);
+    assert.ok(child.pid > 0);
+    assert.notStrictEqual(Number(stdout), process.pid);
+  }
+
+  // Exit codes, cwd and the environment are passed through.
+  {
+    const { code, stdout } = await run(
+      ['-e', 'console.log(process.cwd(), process.env.ZYGOTE_TEST); process.exit(3)'],
+      { cwd: tmpdir.path, env: { ZYGOTE_TEST: 'yes' } });
+    assert.strictEqual(code, 3);
+    assert.strictEqual(stdout, `${tmpdir.path} yes\n`);
+  }
+
+  // The cwd and the umask of the process at the time of the spawn are
+  // inherited, not those of the process when the zygote was started.
+  {
+    const cwd = process.cwd();
+    const mask = process.umask(0o027);
+    fs.mkdirSync(tmpdir.resolve('sub'));
+    process.chdir(tmpdir.path);
+    try {
+      let { code, stdout } = await run(
+        ['-p', 'process.cwd() + " " + process.umask().toString(8)']);
+      assert.strictEqual(code, 0);
+      assert.strictEqual(stdout, `${tmpdir.path} 27\n`);
+
+      // A relative cwd is relative to the current working directory.
+      ({ code, stdout } = await run(['-p', 'process.cwd()'], { cwd: 'sub' }));
+      assert.strictEqual(code, 0);
+      assert.strictEqual(stdout, `${tmpdir.resolve('sub')}\n`);
+    } finally {
+      process.chdir(cwd);
+      process.umask(mask);
+    }
+  }
+
+  // Pipes work in both directions.
+  {
+    const child = spawn(process.execPath,
+                        ['-e', 'process.stdin.pipe(process.stdout)']);
+    let stdout = '';
+    child.stdout.setEncoding('utf8');
+    child.stdout.on('data', (chunk) => stdout += chunk);
+    child.stdin.end('hello zygote');
+    const [code] = await new Promise((resolve) => {
+      child.on('close', (...args) => resolve(args));
+    });
+    assert.strictEqual(code, 0);
+    assert.strictEqual(stdout, 'hello zygote');
+  }
+
+  // Signals are delivered to the child and reported on exit.
+  {
+    const child = spawn(process.execPath, ['-e', 'setInterval(() => {}, 1000)']);
+    assert.strictEqual(child.kill('SIGTERM'), true);
+    const [code, signal] = await new Promise((resolve) => {
+      child.on('exit', (...args) => resolve(args));
+    });
+    assert.strictEqual(code, null);
+    assert.strictEqual(signal, 'SIGTERM');
+  }
+
+  // Spawn errors are reported as usual.
+  {
+    const child = spawn('this-command-does-not-exist');
+    const err = await new Promise((resolve) => child.on('error', resolve));
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(child.pid, undefined);
+  }
+
+  // IPC channels are set up through the zygote too.
+  {
+    const child = fork(__filename, ['child']);
+    child.send('ping');
+    const [reply] = await new Promise((resolve) => {
+      child.on('message', (...args) => resolve(args));
+    });
+    assert.strictEqual(reply.message, 'ping');
+    assert.notStrictEqual(reply.ppid, process.pid);
+    child.disconnect();
+  }
+})().then(common.mustCall());
@@ -0,0 +1,46 @@
+'use strict';
+require('../common');
+
+// This test checks that spawnSync() collects large outputs correctly and that
+// the outputSizeHint option does not change the output.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+function run(size, options = {}) {
+  const script = `process.stdout.write(Buffer.alloc(${size}, 'abc'));` +
+                 `process.stderr.write('x'.repeat(${size % 100000}));`;
+  return spawnSync(process.execPath, ['-e', script],
+                   { maxBuffer: Infinity, ...options });
+}
+
+for (const size of [0, 1024, 70 * 1024, 20 * 1024 * 1024]) {
+  for (const outputSizeHint of [undefined, 0, 1024, size, size * 2]) {
+    const ret = run(size, { outputSizeHint });
+    assert.ifError(ret.error);
+    assert.strictEqual(ret.status, 0);
+    assert.ok(Buffer.isBuffer(ret.stdout));
+    assert.strictEqual(ret.stdout.length, size);
+    assert.ok(ret.stdout.equals(Buffer.alloc(size, 'abc')));
+    assert.strictEqual(ret.stderr.toString(), 'x'.repeat(size % 100000));
+  }
+}
+
+// The hint is only a hint; maxBuffer is still enforced.
+{
+  const ret = run(1024 * 1024, { maxBuffer: 64 * 1024,
+                                 outputSizeHint: 1024 * 1024 });
+  assert.strictEqual(ret.error.code, 'ENOBUFS');
+}
+
+for (const outputSizeHint of [-1, 1.5, Number.MAX_SAFE_INTEGER + 1]) {
+  assert.throws(() => run(0, { outputSizeHint }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+}
+
+for (const outputSizeHint of ['1024', {}, true]) {
+  assert.throws(() => run(0, { outputSizeHint }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
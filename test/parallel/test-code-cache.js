@@ -24,9 +24,21 @@ for (const key of canBeRequired) {
 const {
   compiledWithoutCache,
   compiledWithCache,
-  compiledInSnapshot
+  compiledWithRejectedCache,
+  compiledInSnapshot,
+  compileTime,
 } = getCacheUsage();
 
+// Every built-in that was compiled has its compile time recorded, and the
+// ones whose cache was rejected are counted as compiled without cache.
+for (const key of [...compiledWithCache, ...compiledWithoutCache]) {
+  assert.strictEqual(typeof compileTime[key], 'number', key);
+  assert(compileTime[key] >= 0, key);
+}
+for (const key of compiledWithRejectedCache) {
+  assert(compiledWithoutCache.has(key), key);
+}
+
 function extractModules(list) {
   return list.filter((m) => m.startsWith('NativeModule'))
   .map((m) => m.replace('NativeModule ', ''));
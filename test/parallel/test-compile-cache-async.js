@@ -0,0 +1,57 @@
+'use strict';
+
+// This tests that NODE_COMPILE_CACHE_ASYNC creates the compile cache after the
+// code has run and writes it on a worker thread.
+
+require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+const dir = tmpdir.resolve('.compile_cache_dir');
+const script = fixtures.path('snapshot', 'typescript.js');
+
+function run(assertStderr) {
+  spawnSyncAndAssert(
+    process.execPath,
+    [script],
+    {
+      env: {
+        ...process.env,
+        NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+        NODE_COMPILE_CACHE: dir,
+        NODE_COMPILE_CACHE_ASYNC: '1',
+      },
+      cwd: tmpdir.path
+    },
+    {
+      stderr(output) {
+        console.log(output);  // Logging for debugging.
+        assertStderr(output);
+        return true;
+      }
+    });
+}
+
+run((output) => {
+  assert.match(output, /typescript\.js was not initialized, initializing the in-memory entry after it has run/);
+  assert.match(output, /created V8 code cache for CommonJS .*typescript\.js after it has run/);
+  assert.match(output, /writing 1 caches on a worker thread/);
+  assert.match(output, /writing cache for CommonJS .*typescript\.js.*success/);
+  // The cache was written in the background, so it is not written again when
+  // the instance exits.
+  assert.match(output, /skip persisting CommonJS .*typescript\.js because cache was already persisted/);
+});
+
+const cacheDir = fs.readdirSync(dir);
+assert.strictEqual(cacheDir.length, 1);
+assert.strictEqual(fs.readdirSync(path.join(dir, cacheDir[0])).length, 1);
+
+run((output) => {
+  assert.match(output, /cache for CommonJS .*typescript\.js was accepted, keeping the in-memory entry/);
+  assert.doesNotMatch(output, /caches on a worker thread/);
+});
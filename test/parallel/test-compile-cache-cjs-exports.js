@@ -0,0 +1,74 @@
+'use strict';
+
+// This tests NODE_COMPILE_CACHE caches the export names of CommonJS modules
+// imported from ES modules.
+
+require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const dir = tmpdir.resolve('.compile_cache_dir');
+const script = tmpdir.resolve('main.mjs');
+const dep = tmpdir.resolve('dep.cjs');
+const reexported = tmpdir.resolve('reexported.cjs');
+fs.writeFileSync(script, `
+import { foo, bar } from './dep.cjs';
+console.log(foo, bar);
+`);
+fs.writeFileSync(dep, `
+exports.foo = 'foo';
+module.exports = { ...require('./reexported.cjs'), foo: 'foo' };
+`);
+fs.writeFileSync(reexported, 'exports.bar = "bar";');
+
+const env = {
+  ...process.env,
+  NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+  NODE_COMPILE_CACHE: dir,
+};
+
+spawnSyncAndAssert(
+  process.execPath,
+  [script],
+  { env, cwd: tmpdir.path },
+  {
+    stdout: 'foo bar',
+    stderr(output) {
+      assert.match(output, /saving transpilation cache for CommonJSExports .*dep\.cjs/);
+      assert.match(output, /saving transpilation cache for CommonJSExports .*reexported\.cjs/);
+      assert.match(output, /writing cache for CommonJSExports .*dep\.cjs.*success/);
+      return true;
+    }
+  });
+
+spawnSyncAndAssert(
+  process.execPath,
+  [script],
+  { env, cwd: tmpdir.path },
+  {
+    stdout: 'foo bar',
+    stderr(output) {
+      assert.match(output, /retrieving transpile cache for CommonJSExports .*dep\.cjs.*success/);
+      assert.match(output, /retrieving transpile cache for CommonJSExports .*reexported\.cjs.*success/);
+      assert.match(output, /skip persisting CommonJSExports .*dep\.cjs because cache was the same/);
+      return true;
+    }
+  });
+
+// When the source changes, the export names are computed again.
+fs.writeFileSync(reexported, 'exports.baz = "baz"; exports.bar = "bar2";');
+spawnSyncAndAssert(
+  process.execPath,
+  [script],
+  { env, cwd: tmpdir.path },
+  {
+    stdout: 'foo bar2',
+    stderr(output) {
+      assert.match(output, /retrieving transpile cache for CommonJSExports .*dep\.cjs.*success/);
+      assert.match(output, /saving transpilation cache for CommonJSExports .*reexported\.cjs/);
+      return true;
+    }
+  });
@@ -0,0 +1,72 @@
+'use strict';
+
+// This tests that NODE_COMPILE_CACHE_PACK keeps the compile cache in a single
+// file of the cache directory.
+
+require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+const dir = tmpdir.resolve('.compile_cache_dir');
+const script = tmpdir.resolve('script.js');
+const dependency = tmpdir.resolve('dependency.js');
+fs.copyFileSync(fixtures.path('snapshot', 'typescript.js'), script);
+fs.appendFileSync(script, '\nrequire("./dependency.js");\n');
+fs.writeFileSync(dependency, 'module.exports = 1;\n');
+
+function run(assertStderr) {
+  spawnSyncAndAssert(
+    process.execPath,
+    [script],
+    {
+      env: {
+        ...process.env,
+        NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+        NODE_COMPILE_CACHE: dir,
+        NODE_COMPILE_CACHE_PACK: '1',
+      },
+      cwd: tmpdir.path
+    },
+    {
+      stderr(output) {
+        console.log(output);  // Logging for debugging.
+        assertStderr(output);
+        return true;
+      }
+    });
+}
+
+run((output) => {
+  assert.match(output, /script\.js was not initialized, initializing the in-memory entry/);
+  assert.match(output, /writing 2 records to pack .*success/);
+});
+
+const cacheDir = fs.readdirSync(dir);
+assert.strictEqual(cacheDir.length, 1);
+assert.deepStrictEqual(fs.readdirSync(path.join(dir, cacheDir[0])), ['pack']);
+
+// The second run reads the cache from the pack, and does not write it again.
+run((output) => {
+  assert.match(output, /reading cache from pack for CommonJS .*script\.js\.\.\. success/);
+  assert.match(output, /cache for .*script\.js was accepted, keeping the in-memory entry/);
+  assert.match(output, /cache for .*dependency\.js was accepted, keeping the in-memory entry/);
+  assert.doesNotMatch(output, /records .*pack/);
+});
+
+// The cache of a file that has changed is appended to the pack.
+fs.writeFileSync(dependency, 'module.exports = 2;\n');
+run((output) => {
+  assert.match(output, /reading cache from pack for CommonJS .*dependency\.js\.\.\.code (size|hash) mismatch/);
+  assert.match(output, /appending 1 records to the end of pack .*success/);
+});
+
+run((output) => {
+  assert.match(output, /cache for .*script\.js was accepted, keeping the in-memory entry/);
+  assert.match(output, /cache for .*dependency\.js was accepted, keeping the in-memory entry/);
+  assert.doesNotMatch(output, /records .*pack/);
+});
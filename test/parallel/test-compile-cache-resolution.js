@@ -0,0 +1,160 @@
+'use strict';
+
+// This tests that the compile cache keeps the resolutions of the requests in
+// memory for the other threads, and that they are not used once any of the
+// file system entries that the resolution probed changes.
+
+const common = require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const tmpdir = require('../common/tmpdir');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+// Resolves the requests of load.js and load.mjs, which are next to it, runs
+// mutate.js, and then resolves the same requests on a worker, which starts
+// with empty JS caches.
+const runner = `'use strict';
+const fs = require('fs');
+const path = require('path');
+const { Worker, isMainThread } = require('worker_threads');
+(async () => {
+  const results = [require('./load.js')];
+  if (fs.existsSync(path.join(__dirname, 'load.mjs')))
+    results.push((await import('./load.mjs')).default);
+  console.log(isMainThread ? 'main' : 'worker', ...results);
+  if (isMainThread) {
+    require('./mutate.js');
+    new Worker(__filename);
+  }
+})();
+`;
+
+let appc = 0;
+// Creates an app from `files`, a map from relative paths to contents, and
+// runs it with the compile cache enabled.
+function test({ files, symlinks = {}, mutate, main, worker, stale }) {
+  const app = tmpdir.resolve(`app-${++appc}`);
+  files = {
+    'lib/runner.js': runner,
+    'lib/mutate.js': mutate,
+    ...files,
+  };
+  for (const [name, content] of Object.entries(files)) {
+    fs.mkdirSync(path.dirname(path.join(app, name)), { recursive: true });
+    fs.writeFileSync(path.join(app, name), content);
+  }
+  for (const [name, target] of Object.entries(symlinks)) {
+    fs.symlinkSync(path.join(app, target), path.join(app, name), 'junction');
+  }
+
+  spawnSyncAndAssert(
+    process.execPath,
+    [path.join(app, 'lib', 'runner.js')],
+    {
+      env: {
+        ...process.env,
+        NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+        NODE_COMPILE_CACHE: tmpdir.resolve(`.compile_cache_dir-${appc}`),
+      },
+      cwd: app,
+    },
+    {
+      stdout: `main ${main}\nworker ${worker}`,
+      trim: true,
+      stderr(output) {
+        console.log(output);  // Logging for debugging.
+        for (const specifier of stale) {
+          assert.ok(output.includes(`resolution of ${specifier} from `),
+                    `${specifier} is not stale`);
+        }
+        if (stale.length === 0)
+          assert.doesNotMatch(output, /is stale/);
+        // Nothing is stored for later runs.
+        assert.doesNotMatch(output, /resolutions to /);
+        return true;
+      }
+    });
+}
+
+// The worker reuses resolutions that did not change.
+test({
+  files: {
+    'lib/load.js': 'module.exports = require("./dep");\n',
+    'lib/dep/index.js': 'module.exports = "index";\n',
+  },
+  mutate: '',
+  main: 'index',
+  worker: 'index',
+  stale: [],
+});
+
+// A file that takes precedence next to the requesting module.
+test({
+  files: {
+    'lib/load.js': 'module.exports = require("./dep");\n',
+    'lib/dep/index.js': 'module.exports = "index";\n',
+  },
+  mutate: `require('fs').writeFileSync(require('path').join(__dirname, 'dep.js'),
+                                       'module.exports = "file";');`,
+  main: 'index',
+  worker: 'file',
+  stale: ['./dep'],
+});
+
+// A file that takes precedence in a subdirectory.
+test({
+  files: {
+    'lib/load.js': 'module.exports = require("./sub/dep");\n',
+    'lib/sub/dep/index.js': 'module.exports = "index";\n',
+  },
+  mutate: `require('fs').writeFileSync(require('path').join(__dirname, 'sub', 'dep.js'),
+                                       'module.exports = "file";');`,
+  main: 'index',
+  worker: 'file',
+  stale: ['./sub/dep'],
+});
+
+// A package that is installed in a nearer node_modules directory.
+test({
+  files: {
+    'lib/load.js': 'module.exports = require("foo");\n',
+    'lib/load.mjs': 'export { default } from "foo";\n',
+    'lib/node_modules/other/index.js': '',
+    'node_modules/foo/index.js': 'module.exports = "outer";\n',
+  },
+  mutate: `const fs = require('fs');
+const path = require('path');
+fs.mkdirSync(path.join(__dirname, 'node_modules', 'foo'));
+fs.writeFileSync(path.join(__dirname, 'node_modules', 'foo', 'index.js'),
+                 'module.exports = "inner";');`,
+  main: 'outer outer',
+  worker: 'inner inner',
+  stale: ['foo'],
+});
+
+// A symbolic link to a package that is re-pointed to another version, the way
+// pnpm installs packages.
+if (common.canCreateSymLink()) {
+  const bar = (version) => `node_modules/.pnpm/bar@${version}/node_modules/bar`;
+  test({
+    files: {
+      'lib/load.js': 'module.exports = require("bar");\n',
+      'lib/load.mjs': 'export { default } from "bar";\n',
+      [`${bar(1)}/index.js`]: 'module.exports = "1";\n',
+      [`${bar(2)}/index.js`]: 'module.exports = "2";\n',
+      'lib/node_modules/.keep': '',
+    },
+    symlinks: { 'lib/node_modules/bar': bar(1) },
+    mutate: `const fs = require('fs');
+const path = require('path');
+const link = path.join(__dirname, 'node_modules', 'bar');
+fs.unlinkSync(link);
+fs.symlinkSync(path.join(__dirname, '..', ${JSON.stringify(bar(2))}), link, 'junction');`,
+    main: '1 1',
+    worker: '2 2',
+    stale: ['bar'],
+  });
+}
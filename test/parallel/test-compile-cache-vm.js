@@ -0,0 +1,72 @@
+'use strict';
+
+// This tests that vm.Script and vm.compileFunction() can use the compile
+// cache with the useCompileCache option.
+
+require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const dir = tmpdir.resolve('.compile_cache_dir');
+
+const script = `
+  const assert = require('assert');
+  const vm = require('vm');
+  const code = 'let sum = 0; for (let i = 0; i < 10; i++) sum += i; sum';
+  const script = new vm.Script(code, {
+    filename: 'template.js',
+    useCompileCache: true,
+  });
+  assert.strictEqual(script.runInThisContext(), 45);
+  assert.strictEqual(script.cachedDataRejected, undefined);
+  // Scripts with the same file name are cached separately.
+  assert.strictEqual(new vm.Script('1 + 1', {
+    filename: 'template.js',
+    useCompileCache: true,
+  }).runInThisContext(), 2);
+  assert.strictEqual(new vm.Script(code, {
+    filename: 'not-cached.js',
+  }).runInThisContext(), 45);
+  const fn = vm.compileFunction('return a + b', ['a', 'b'], {
+    filename: 'function.js',
+    useCompileCache: true,
+  });
+  assert.strictEqual(fn(1, 2), 3);
+  assert.strictEqual(fn.cachedDataRejected, undefined);
+`;
+
+function run(check) {
+  spawnSyncAndAssert(
+    process.execPath,
+    ['-e', script],
+    {
+      env: {
+        ...process.env,
+        NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+        NODE_COMPILE_CACHE: dir,
+      },
+      cwd: tmpdir.path,
+    },
+    {
+      stderr(output) {
+        console.log(output);  // Logging for debugging.
+        assert.doesNotMatch(output, /not-cached\.js/);
+        check(output);
+        return true;
+      },
+    });
+}
+
+run((output) => {
+  assert.match(output, /VMScript template\.js was not initialized, initializing the in-memory entry/);
+  assert.match(output, /VMFunction function\.js was not initialized, initializing the in-memory entry/);
+  assert.match(output, /writing cache for VMScript template\.js.*success/);
+  assert.match(output, /writing cache for VMFunction function\.js.*success/);
+});
+
+run((output) => {
+  assert.match(output, /VMScript template\.js was accepted, keeping the in-memory entry/);
+  assert.match(output, /VMFunction function\.js was accepted, keeping the in-memory entry/);
+});
@@ -0,0 +1,81 @@
+'use strict';
+
+// This tests that WebAssembly modules compiled with
+// WebAssembly.compileStreaming() are stored in the compile cache and used
+// by later runs as long as the module bytes do not change.
+
+require('../common');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+const fs = require('fs');
+
+tmpdir.refresh();
+const dir = tmpdir.resolve('.compile_cache_dir');
+const wasmFile = tmpdir.resolve('simple.wasm');
+fs.copyFileSync(fixtures.path('simple.wasm'), wasmFile);
+
+const script = `
+const http = require('http');
+const fs = require('fs');
+const server = http.createServer((req, res) => {
+  res.writeHead(200, { 'Content-Type': 'application/wasm' });
+  res.end(fs.readFileSync(${JSON.stringify(wasmFile)}));
+}).listen(0, async () => {
+  const url = 'http://localhost:' + server.address().port + '/simple.wasm';
+  const module = await WebAssembly.compileStreaming(fetch(url));
+  const instance = new WebAssembly.Instance(module);
+  console.log(instance.exports.add(10, 20));
+  server.close();
+});
+`;
+
+function run(assertStderr) {
+  spawnSyncAndAssert(
+    process.execPath,
+    [
+      // Compile with the top tier right away and let V8 hand out the module
+      // for caching as soon as it is compiled.
+      '--no-liftoff',
+      '--wasm-caching-threshold=0',
+      '--wasm-caching-timeout-ms=0',
+      '-e', script,
+    ],
+    {
+      env: {
+        ...process.env,
+        NODE_DEBUG_NATIVE: 'COMPILE_CACHE',
+        NODE_COMPILE_CACHE: dir,
+      },
+      cwd: tmpdir.path
+    },
+    {
+      stdout: '30',
+      stderr(output) {
+        console.log(output);  // Logging for debugging.
+        assertStderr(output);
+        return true;
+      }
+    });
+}
+
+run((output) => {
+  assert.match(output, /reading WebAssembly module from .* for .*simple\.wasm\.\.\. .*no such file or directory/i);
+  assert.match(output, /wrote WebAssembly module .*simple\.wasm to /);
+});
+
+run((output) => {
+  assert.match(output, /reading WebAssembly module from .* for .*simple\.wasm\.\.\.\[.*\]\.\.\. success/);
+});
+
+// Once the module changes, the cached one is not used, and the new one is
+// written to the cache.
+const bytes = fs.readFileSync(wasmFile);
+// Append an empty custom section named "x".
+fs.writeFileSync(wasmFile, Buffer.concat([bytes, Buffer.from([0, 2, 1, 0x78])]));
+
+run((output) => {
+  assert.match(output, /reading WebAssembly module from .* for .*simple\.wasm\.\.\.\[.*\]\.\.\. success/);
+  assert.match(output, /wrote WebAssembly module .*simple\.wasm to /);
+});
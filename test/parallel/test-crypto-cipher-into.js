@@ -0,0 +1,168 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Test encrypting and decrypting into caller-provided buffers with
+// cipher.updateInto(), cipher.finalInto(), crypto.aeadSeal() and
+// crypto.aeadOpen().
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const plaintext = Buffer.from('Encrypted records of a messaging protocol. '
+  .repeat(10));
+
+function encrypt(algorithm, key, iv, aad) {
+  const cipher = crypto.createCipheriv(algorithm, key, iv);
+  if (aad) cipher.setAAD(aad);
+  const ciphertext = Buffer.concat([cipher.update(plaintext), cipher.final()]);
+  const aead = /gcm|poly1305/.test(algorithm);
+  return { ciphertext, tag: aead ? cipher.getAuthTag() : undefined };
+}
+
+{
+  // A block cipher writes up to a block more than it is given.
+  const key = crypto.randomBytes(32);
+  const iv = crypto.randomBytes(16);
+  const { ciphertext } = encrypt('aes-256-cbc', key, iv);
+
+  const cipher = crypto.createCipheriv('aes-256-cbc', key, iv);
+  const output = Buffer.alloc(plaintext.length + 16 + 3);
+  assert.throws(() => cipher.updateInto(plaintext, output, 4), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  let written = cipher.updateInto(plaintext, output, 3);
+  assert.throws(() => cipher.finalInto(output, output.length - 15), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  written += cipher.finalInto(output, 3 + written);
+  assert.deepStrictEqual(output.subarray(3, 3 + written), ciphertext);
+
+  const decipher = crypto.createDecipheriv('aes-256-cbc', key, iv);
+  const decrypted = new Uint8Array(ciphertext.length + 16);
+  written = decipher.updateInto(ciphertext, decrypted);
+  written += decipher.finalInto(decrypted, written);
+  assert.deepStrictEqual(Buffer.from(decrypted.buffer, 0, written), plaintext);
+}
+
+for (const algorithm of ['aes-128-gcm', 'aes-256-ctr', 'chacha20-poly1305']) {
+  // Stream ciphers and AEAD modes work in place and need no room for final().
+  const key = crypto.randomBytes(algorithm === 'aes-128-gcm' ? 16 : 32);
+  const iv = crypto.randomBytes(algorithm === 'aes-256-ctr' ? 16 : 12);
+  const { ciphertext, tag } = encrypt(algorithm, key, iv);
+
+  const record = Buffer.from(plaintext);
+  const cipher = crypto.createCipheriv(algorithm, key, iv);
+  assert.strictEqual(cipher.updateInto(record, record), record.length);
+  assert.strictEqual(cipher.finalInto(record, record.length), 0);
+  assert.deepStrictEqual(record, ciphertext);
+  if (tag) assert.deepStrictEqual(cipher.getAuthTag(), tag);
+
+  const decipher = crypto.createDecipheriv(algorithm, key, iv);
+  if (tag) decipher.setAuthTag(tag);
+  assert.strictEqual(decipher.updateInto(record, record), record.length);
+  assert.strictEqual(decipher.finalInto(record, record.length), 0);
+  assert.deepStrictEqual(record, plaintext);
+}
+
+{
+  const cipher = crypto.createCipheriv('aes-128-gcm', Buffer.alloc(16),
+                                       Buffer.alloc(12));
+  const output = Buffer.alloc(16);
+  assert.throws(() => cipher.updateInto('string', output), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => cipher.updateInto(output, new ArrayBuffer(16)), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => cipher.updateInto(output, output, 17), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  cipher.finalInto(output);
+  assert.throws(() => cipher.finalInto(output), {
+    code: 'ERR_CRYPTO_INVALID_STATE',
+  });
+}
+
+for (const algorithm of ['aes-128-gcm', 'aes-256-gcm', 'chacha20-poly1305']) {
+  const key = crypto.randomBytes(algorithm === 'aes-128-gcm' ? 16 : 32);
+  const iv = crypto.randomBytes(12);
+  const aad = Buffer.from('header');
+  const { ciphertext, tag } = encrypt(algorithm, key, iv, aad);
+  const sealed = Buffer.concat([ciphertext, tag]);
+
+  // Into a separate buffer, at an offset.
+  let output = Buffer.alloc(sealed.length + 5);
+  assert.strictEqual(
+    crypto.aeadSeal(algorithm, key, iv, plaintext, output,
+                    { aad, offset: 5 }),
+    sealed.length);
+  assert.deepStrictEqual(output.subarray(5), sealed);
+  output = Buffer.alloc(plaintext.length);
+  assert.strictEqual(
+    crypto.aeadOpen(algorithm, key, iv, sealed, output, { aad }),
+    plaintext.length);
+  assert.deepStrictEqual(output, plaintext);
+
+  // In place, with a KeyObject.
+  const keyObject = crypto.createSecretKey(key);
+  const record = Buffer.alloc(plaintext.length + 16);
+  plaintext.copy(record);
+  crypto.aeadSeal(algorithm, keyObject, iv,
+                  record.subarray(0, plaintext.length), record, { aad });
+  assert.deepStrictEqual(record, sealed);
+  crypto.aeadOpen(algorithm, keyObject, iv, record, record, { aad });
+  assert.deepStrictEqual(record.subarray(0, plaintext.length), plaintext);
+
+  // Shorter tags.
+  output = Buffer.alloc(plaintext.length + 12);
+  crypto.aeadSeal(algorithm, key, iv, plaintext, output,
+                  { aad, authTagLength: 12 });
+  assert.deepStrictEqual(output.subarray(plaintext.length),
+                         tag.subarray(0, 12));
+
+  // Authentication failures don't leak any plaintext.
+  const tampered = Buffer.from(sealed);
+  tampered[0] ^= 1;
+  output = Buffer.alloc(plaintext.length, 0xff);
+  assert.throws(() => crypto.aeadOpen(algorithm, key, iv, tampered, output), {
+    message: 'Unsupported state or unable to authenticate data',
+  });
+  assert.deepStrictEqual(output, Buffer.alloc(plaintext.length));
+  assert.throws(() => crypto.aeadOpen(algorithm, key, iv, sealed, output), {
+    message: 'Unsupported state or unable to authenticate data',
+  });
+
+  assert.throws(() => crypto.aeadSeal(algorithm, key, iv, plaintext,
+                                      Buffer.alloc(plaintext.length + 15)), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => crypto.aeadOpen(algorithm, key, iv,
+                                      Buffer.alloc(15), output), {
+    code: 'ERR_CRYPTO_INVALID_AUTH_TAG',
+  });
+  assert.throws(() => crypto.aeadSeal(algorithm, key.subarray(1), iv,
+                                      plaintext, output), {
+    code: 'ERR_CRYPTO_INVALID_KEYLEN',
+  });
+  assert.throws(() => crypto.aeadSeal(algorithm, key, Buffer.alloc(0),
+                                      plaintext, output), {
+    code: 'ERR_CRYPTO_INVALID_IV',
+  });
+  assert.throws(() => crypto.aeadSeal(algorithm, key, iv, plaintext, output,
+                                      { authTagLength: 17 }), {
+    code: 'ERR_CRYPTO_INVALID_AUTH_TAG',
+  });
+}
+
+assert.throws(() => crypto.aeadSeal('aes-128-cbc', Buffer.alloc(16),
+                                    Buffer.alloc(16), plaintext,
+                                    Buffer.alloc(1024)), {
+  code: 'ERR_CRYPTO_UNKNOWN_CIPHER',
+});
+assert.throws(() => crypto.aeadSeal('aes-128-gcm', Buffer.alloc(16),
+                                    Buffer.alloc(12), plaintext,
+                                    Buffer.alloc(1024), { offset: -1 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
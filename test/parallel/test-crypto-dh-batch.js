@@ -0,0 +1,87 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Test that crypto.diffieHellmanBatch() derives the same secrets as
+// crypto.diffieHellman() does for each of the public keys.
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const types = [
+  ['x25519'],
+  ['x448'],
+  ['ec', { namedCurve: 'P-256' }],
+  ['dh', { group: 'modp14' }],
+];
+
+for (const [type, options] of types) {
+  const { privateKey } = crypto.generateKeyPairSync(type, options);
+  const peers = Array.from({ length: 5 },
+                           () => crypto.generateKeyPairSync(type, options));
+  // Private keys can be used as the public keys, too.
+  const publicKeys = peers.map(({ publicKey, privateKey }, i) => {
+    return i % 2 ? publicKey : privateKey;
+  });
+  const expected = publicKeys.map((publicKey) => {
+    return crypto.diffieHellman({ privateKey, publicKey });
+  });
+
+  assert.deepStrictEqual(
+    crypto.diffieHellmanBatch({ privateKey, publicKeys }), expected);
+  crypto.diffieHellmanBatch({ privateKey, publicKeys },
+                            common.mustSucceed((secrets) => {
+                              assert.deepStrictEqual(secrets, expected);
+                            }));
+
+  // The secrets are derived by the peers, too.
+  for (let i = 0; i < peers.length; i++) {
+    const [secret] = crypto.diffieHellmanBatch({
+      privateKey: peers[i].privateKey,
+      publicKeys: [crypto.createPublicKey(privateKey)],
+    });
+    assert.deepStrictEqual(secret, expected[i]);
+  }
+}
+
+{
+  const { privateKey, publicKey } = crypto.generateKeyPairSync('x25519');
+  assert.deepStrictEqual(
+    crypto.diffieHellmanBatch({ privateKey, publicKeys: [] }), []);
+
+  assert.throws(() => crypto.diffieHellmanBatch({ privateKey }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /"options\.publicKeys"/,
+  });
+  assert.throws(() => crypto.diffieHellmanBatch({
+    privateKey,
+    publicKeys: [publicKey, 'key'],
+  }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+    message: /'options\.publicKeys\[1\]'/,
+  });
+  assert.throws(() => crypto.diffieHellmanBatch({
+    privateKey: publicKey,
+    publicKeys: [publicKey],
+  }), {
+    code: 'ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE',
+  });
+  assert.throws(() => crypto.diffieHellmanBatch({
+    privateKey,
+    publicKeys: [crypto.generateKeyPairSync('x448').publicKey],
+  }), {
+    code: 'ERR_CRYPTO_INCOMPATIBLE_KEY',
+  });
+
+  // A failure to derive one of the secrets fails the whole batch.
+  const p256 = crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' });
+  const p384 = crypto.generateKeyPairSync('ec', { namedCurve: 'P-384' });
+  assert.throws(() => crypto.diffieHellmanBatch({
+    privateKey: p256.privateKey,
+    publicKeys: [p256.publicKey, p384.publicKey],
+  }), {
+    name: 'Error',
+    code: /^ERR_OSSL_/,
+  });
+}
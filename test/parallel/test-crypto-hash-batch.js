@@ -0,0 +1,73 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const inputs = ['', 'a', 'Node.js', Buffer.alloc(1000, 'x'),
+                new Uint16Array([1, 2, 3]), new DataView(new ArrayBuffer(7))];
+
+function expected(algorithm, list) {
+  return Buffer.concat(list.map((input) => {
+    if (typeof input !== 'string')
+      input = new Uint8Array(input.buffer, input.byteOffset, input.byteLength);
+    return crypto.hash(algorithm, input, 'buffer');
+  }));
+}
+
+for (const algorithm of ['md5', 'sha1', 'sha256', 'sha512']) {
+  const want = expected(algorithm, inputs);
+  assert.deepStrictEqual(crypto.hashBatch(algorithm, inputs), want);
+
+  crypto.hashBatch(algorithm, inputs, common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, want);
+  }));
+}
+
+{
+  // One buffer and the offsets at which each input starts.
+  const data = Buffer.from('abcdefg');
+  const want = expected('sha256', ['abc', '', 'defg']);
+  assert.deepStrictEqual(crypto.hashBatch('sha256', data, [0, 3, 3]), want);
+  assert.deepStrictEqual(
+    crypto.hashBatch('sha256', data, new Uint32Array([0, 3, 3])), want);
+  crypto.hashBatch('sha256', data, [0, 3, 3],
+                   common.mustSucceed((digests) => {
+                     assert.deepStrictEqual(digests, want);
+                   }));
+
+  // Bytes before the first offset are not hashed.
+  assert.deepStrictEqual(crypto.hashBatch('sha1', data, [2]),
+                         expected('sha1', ['cdefg']));
+  assert.deepStrictEqual(crypto.hashBatch('sha1', data),
+                         expected('sha1', ['abcdefg']));
+  assert.strictEqual(crypto.hashBatch('sha1', data, []).length, 0);
+  assert.strictEqual(crypto.hashBatch('sha1', []).length, 0);
+}
+
+assert.throws(() => crypto.hashBatch('sha1', Buffer.alloc(4), [0, 5]), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => crypto.hashBatch('sha1', Buffer.alloc(4), [2, 1]), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => crypto.hashBatch('sha1', Buffer.alloc(4), '0'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => crypto.hashBatch('sha1', ['a', [1]]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => crypto.hashBatch('sha1', ['a'], [0]), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+assert.throws(() => crypto.hashBatch('sha1', 'abc'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => crypto.hashBatch('sha1', ['a'], 'callback'), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+assert.throws(() => crypto.hashBatch('nope', ['a']), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST',
+});
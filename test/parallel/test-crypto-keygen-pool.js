@@ -0,0 +1,82 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Test that key pairs can be generated ahead of time with
+// crypto.setKeyPairPoolSize(), and that generateKeyPair() and
+// generateKeyPairSync() hand each pooled key pair out only once.
+
+const assert = require('assert');
+const {
+  generateKeyPair,
+  generateKeyPairSync,
+  setKeyPairPoolSize,
+} = require('crypto');
+const { setTimeout } = require('timers/promises');
+const { testSignVerify } = require('../common/crypto');
+
+const rsaOptions = { modulusLength: 1024 };
+const ecOptions = { namedCurve: 'prime256v1' };
+
+async function waitForPool(type, options, size) {
+  let count;
+  while ((count = setKeyPairPoolSize(type, options, size)) < size)
+    await setTimeout(10);
+  assert.strictEqual(count, size);
+}
+
+(async () => {
+  assert.strictEqual(setKeyPairPoolSize('rsa', rsaOptions, 4), 0);
+  await waitForPool('rsa', rsaOptions, 4);
+  await waitForPool('ec', ecOptions, 4);
+
+  const publicKeys = new Set();
+  for (let i = 0; i < 6; i++) {
+    const { publicKey, privateKey } = generateKeyPairSync('rsa', {
+      ...rsaOptions,
+      publicKeyEncoding: { type: 'spki', format: 'pem' },
+    });
+    assert.strictEqual(typeof publicKey, 'string');
+    assert.strictEqual(privateKey.asymmetricKeyDetails.modulusLength, 1024);
+    testSignVerify(publicKey, privateKey);
+    publicKeys.add(publicKey);
+  }
+  assert.strictEqual(publicKeys.size, 6);
+
+  await Promise.all(Array.from({ length: 6 }, () => new Promise((resolve) => {
+    generateKeyPair('ec', ecOptions, common.mustSucceed((pub, priv) => {
+      assert.strictEqual(priv.asymmetricKeyDetails.namedCurve, 'prime256v1');
+      testSignVerify(pub, priv);
+      const exported = pub.export({ type: 'spki', format: 'der' });
+      assert(!publicKeys.has(exported.toString('hex')));
+      publicKeys.add(exported.toString('hex'));
+      resolve();
+    }));
+  })));
+  assert.strictEqual(publicKeys.size, 12);
+
+  // Options that were not pooled still work.
+  const { privateKey } = generateKeyPairSync('rsa', { modulusLength: 512 });
+  assert.strictEqual(privateKey.asymmetricKeyDetails.modulusLength, 512);
+
+  // Lowering and clearing the size drops the pooled key pairs.
+  await waitForPool('ec', ecOptions, 4);
+  assert.strictEqual(setKeyPairPoolSize('ec', ecOptions, 2), 2);
+  assert.strictEqual(setKeyPairPoolSize('ec', ecOptions, 0), 0);
+  assert.strictEqual(setKeyPairPoolSize('rsa', rsaOptions, 0), 0);
+})().then(common.mustCall());
+
+assert.throws(() => setKeyPairPoolSize('dsa', { modulusLength: 1024 }, 1), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+assert.throws(() => setKeyPairPoolSize('rsa', rsaOptions, -1), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => setKeyPairPoolSize('rsa', {}, 1), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => setKeyPairPoolSize('ec', { namedCurve: 'abcdef' }, 1), {
+  code: 'ERR_CRYPTO_INVALID_CURVE',
+});
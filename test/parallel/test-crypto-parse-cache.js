@@ -0,0 +1,84 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Certificates and public keys that are parsed again are served from a cache
+// that is shared with worker threads. Private keys are not cached.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+const cert = fixtures.readKey('agent1-cert.pem');
+const publicKey = fixtures.readKey('rsa_public_2048.pem');
+const privateKey = fixtures.readKey('rsa_private_2048.pem');
+
+if (!isMainThread) {
+  new crypto.X509Certificate(cert);
+  crypto.createPublicKey(publicKey);
+  parentPort.postMessage('done');
+  return;
+}
+
+function stats() {
+  return crypto.getParseCacheStats();
+}
+
+{
+  const before = stats();
+  const x509 = new crypto.X509Certificate(cert);
+  const again = new crypto.X509Certificate(cert);
+  assert.notStrictEqual(again, x509);
+  assert.strictEqual(again.fingerprint256, x509.fingerprint256);
+  assert.strictEqual(again.toString(), x509.toString());
+
+  const after = stats();
+  assert.strictEqual(after.certificates.misses,
+                     before.certificates.misses + 1);
+  assert.strictEqual(after.certificates.hits, before.certificates.hits + 1);
+  assert.strictEqual(after.certificates.entries,
+                     before.certificates.entries + 1);
+  assert(after.certificates.size > before.certificates.size + cert.length);
+
+  // The DER encoding is a different input.
+  new crypto.X509Certificate(x509.raw);
+  assert.strictEqual(stats().certificates.entries,
+                     before.certificates.entries + 2);
+}
+
+{
+  const before = stats();
+  const key = crypto.createPublicKey(publicKey);
+  const again = crypto.createPublicKey(publicKey);
+  assert(again.equals(key));
+  assert.strictEqual(
+    crypto.createPublicKey({
+      key: key.export({ format: 'der', type: 'spki' }),
+      format: 'der',
+      type: 'spki',
+    }).asymmetricKeyType,
+    'rsa');
+
+  const after = stats();
+  assert.strictEqual(after.publicKeys.hits, before.publicKeys.hits + 1);
+  assert.strictEqual(after.publicKeys.entries, before.publicKeys.entries + 2);
+
+  // Deriving a public key from a private key does not cache either of them.
+  crypto.createPublicKey(privateKey);
+  crypto.createPrivateKey(privateKey);
+  assert.strictEqual(stats().publicKeys.entries,
+                     before.publicKeys.entries + 2);
+}
+
+assert.throws(() => new crypto.X509Certificate(Buffer.from('not a cert')));
+assert.strictEqual(stats().certificates.entries, 2);
+
+const before = stats();
+const worker = new Worker(__filename);
+worker.on('message', common.mustCall(() => {
+  const after = stats();
+  assert.strictEqual(after.certificates.hits, before.certificates.hits + 1);
+  assert.strictEqual(after.publicKeys.hits, before.publicKeys.hits + 1);
+}));
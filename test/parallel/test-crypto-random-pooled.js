@@ -0,0 +1,66 @@
+// Flags: --expose-internals --no-warnings --allow-natives-syntax
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Small random requests are served from a per-thread pool of random bytes.
+// Make sure that they never hand out the same bytes twice, including across
+// threads, and that requests around the pooling threshold work.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const { internalBinding } = require('internal/test/binding');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+const { kMaxPooledRandomBytes } = internalBinding('crypto');
+
+function sample() {
+  const values = [];
+  for (let i = 0; i < 1000; i++)
+    values.push(crypto.randomBytes(16).toString('hex'));
+  return values;
+}
+
+if (!isMainThread) {
+  parentPort.postMessage(sample());
+  return;
+}
+
+assert.strictEqual(typeof kMaxPooledRandomBytes, 'number');
+
+for (const size of [1, 16, kMaxPooledRandomBytes - 1, kMaxPooledRandomBytes,
+                    kMaxPooledRandomBytes + 1, 4096, 4097]) {
+  const a = crypto.randomFillSync(Buffer.alloc(size + 4), 2, size);
+  assert.strictEqual(a.readUInt16BE(0), 0);
+  assert.strictEqual(a.readUInt16BE(size + 2), 0);
+  if (size >= 16) {
+    assert.notDeepStrictEqual(a, Buffer.alloc(size + 4));
+    assert.notDeepStrictEqual(crypto.randomBytes(size), crypto.randomBytes(size));
+    assert.notDeepStrictEqual(
+      crypto.getRandomValues(new Uint32Array(size / 4)),
+      crypto.getRandomValues(new Uint32Array(size / 4)));
+  }
+}
+
+// The offset into an ArrayBuffer is honored.
+{
+  const ab = new ArrayBuffer(32);
+  crypto.randomFillSync(ab, 16, 16);
+  assert.deepStrictEqual(Buffer.from(ab, 0, 16), Buffer.alloc(16));
+}
+
+function testGetRandomValues() {
+  return crypto.getRandomValues(new Uint8Array(16));
+}
+
+eval('%PrepareFunctionForOptimization(testGetRandomValues)');
+testGetRandomValues();
+eval('%OptimizeFunctionOnNextCall(testGetRandomValues)');
+testGetRandomValues();
+
+const worker = new Worker(__filename);
+worker.on('message', common.mustCall((values) => {
+  const all = new Set([...values, ...sample()]);
+  assert.strictEqual(all.size, 2000);
+}));
@@ -0,0 +1,95 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+
+const messages = [
+  Buffer.from(''),
+  Buffer.from('Node.js'),
+  new Uint8Array(1000).fill(7),
+  new DataView(new ArrayBuffer(16)),
+];
+
+const cases = [
+  {
+    algorithm: null,
+    privateKey: fixtures.readKey('ed25519_private.pem', 'ascii'),
+    publicKey: fixtures.readKey('ed25519_public.pem', 'ascii'),
+    options: {},
+  },
+  {
+    algorithm: 'sha256',
+    privateKey: fixtures.readKey('ec_p256_private.pem', 'ascii'),
+    publicKey: fixtures.readKey('ec_p256_public.pem', 'ascii'),
+    options: { dsaEncoding: 'ieee-p1363' },
+  },
+  {
+    algorithm: 'sha256',
+    privateKey: fixtures.readKey('rsa_private_2048.pem', 'ascii'),
+    publicKey: fixtures.readKey('rsa_public_2048.pem', 'ascii'),
+    options: {
+      padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+      saltLength: 32,
+    },
+  },
+];
+
+for (const { algorithm, privateKey, publicKey, options } of cases) {
+  const privateKeyOptions = { key: privateKey, ...options };
+  const publicKeyOptions = { key: publicKey, ...options };
+
+  const signatures = crypto.signBatch(algorithm, messages, privateKeyOptions);
+  assert.strictEqual(signatures.length, messages.length);
+  for (let i = 0; i < messages.length; i++) {
+    assert(Buffer.isBuffer(signatures[i]));
+    assert.strictEqual(crypto.verify(algorithm, messages[i], publicKeyOptions,
+                                     signatures[i]), true);
+  }
+
+  assert.deepStrictEqual(
+    crypto.verifyBatch(algorithm, messages, publicKeyOptions, signatures),
+    [true, true, true, true]);
+
+  // A signature of another message does not verify.
+  const mixed = [signatures[1], signatures[0], signatures[2], signatures[3]];
+  assert.deepStrictEqual(
+    crypto.verifyBatch(algorithm, messages, publicKeyOptions, mixed),
+    [false, false, true, true]);
+
+  crypto.signBatch(algorithm, messages, privateKeyOptions,
+                   common.mustSucceed((signatures) => {
+                     assert.strictEqual(signatures.length, messages.length);
+                     crypto.verifyBatch(
+                       algorithm, messages, publicKeyOptions, signatures,
+                       common.mustSucceed((results) => {
+                         assert.deepStrictEqual(results,
+                                                [true, true, true, true]);
+                       }));
+                   }));
+}
+
+{
+  const key = fixtures.readKey('ed25519_private.pem', 'ascii');
+  assert.deepStrictEqual(crypto.signBatch(null, [], key), []);
+  assert.deepStrictEqual(crypto.verifyBatch(null, [], key, []), []);
+
+  assert.throws(() => crypto.signBatch(null, Buffer.from('a'), key), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.signBatch(null, ['a'], key), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.signBatch(null, [Buffer.from('a')]), {
+    code: 'ERR_CRYPTO_SIGN_KEY_REQUIRED',
+  });
+  assert.throws(() => crypto.verifyBatch(null, [Buffer.from('a')], key, []), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => crypto.signBatch(null, [], key, 'callback'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
@@ -0,0 +1,73 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With --crypto-threadpool-size, asynchronous crypto jobs run on a dedicated
+// threadpool, also when they are started from a worker thread.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const { spawnSync } = require('child_process');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+function pbkdf2(count) {
+  const promises = [];
+  for (let i = 0; i < count; i++) {
+    promises.push(new Promise((resolve, reject) => {
+      crypto.pbkdf2('password', 'salt', 1000, 32, 'sha256', (err, key) => {
+        if (err) return reject(err);
+        assert.deepStrictEqual(
+          key, crypto.pbkdf2Sync('password', 'salt', 1000, 32, 'sha256'));
+        resolve();
+      });
+    }));
+  }
+  return Promise.all(promises);
+}
+
+if (!isMainThread) {
+  pbkdf2(4).then(() => parentPort.postMessage('done'));
+  return;
+}
+
+if (process.argv[2] === 'child') {
+  const stats = crypto.getThreadPoolStats();
+  assert.deepStrictEqual(stats, { size: 2, queued: 0, active: 0, completed: 0 });
+
+  pbkdf2(8).then(common.mustCall(() => {
+    assert.strictEqual(crypto.getThreadPoolStats().completed, 8);
+
+    // randomBytes() stays on the libuv threadpool.
+    crypto.randomBytes(16, common.mustSucceed(() => {
+      assert.strictEqual(crypto.getThreadPoolStats().completed, 8);
+
+      const worker = new Worker(__filename);
+      worker.on('message', common.mustCall(() => {
+        assert.deepStrictEqual(crypto.getThreadPoolStats(),
+                               { size: 2, queued: 0, active: 0, completed: 12 });
+      }));
+    }));
+  }));
+  return;
+}
+
+assert.deepStrictEqual(crypto.getThreadPoolStats(),
+                       { size: 0, queued: 0, active: 0, completed: 0 });
+pbkdf2(2).then(common.mustCall(() => {
+  assert.strictEqual(crypto.getThreadPoolStats().completed, 0);
+}));
+
+{
+  const { status, stderr } = spawnSync(
+    process.execPath, ['--crypto-threadpool-size=2', __filename, 'child']);
+  assert.strictEqual(status, 0, stderr.toString());
+}
+
+{
+  const { status, stderr } = spawnSync(
+    process.execPath, ['--crypto-threadpool-size=2000', '-e', '']);
+  assert.strictEqual(status, 9);
+  assert.match(stderr.toString(),
+               /--crypto-threadpool-size must be between 0 and 1024/);
+}
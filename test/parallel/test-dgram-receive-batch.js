@@ -0,0 +1,43 @@
+'use strict';
+
+// Datagrams read in batches with recvmmsg() are emitted one by one, in
+// order, with their own contents and sender information.
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+assert.throws(() => dgram.createSocket({ type: 'udp4', receiveBatch: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+const count = 50;
+const messages = [];
+for (let i = 0; i < count; i++)
+  messages.push(Buffer.alloc(i * 37 % 1500, `${i};`));
+
+const receiver = dgram.createSocket({ type: 'udp4', receiveBatch: true });
+const sender = dgram.createSocket('udp4');
+
+let received = 0;
+receiver.on('message', common.mustCall((msg, rinfo) => {
+  assert.deepStrictEqual(msg, messages[received]);
+  assert.strictEqual(rinfo.size, msg.length);
+  assert.strictEqual(rinfo.address, '127.0.0.1');
+  assert.strictEqual(rinfo.port, sender.address().port);
+  if (++received === count) {
+    receiver.close();
+    sender.close();
+  }
+}, count));
+
+receiver.bind(0, '127.0.0.1', common.mustCall(() => {
+  sender.bind(0, '127.0.0.1', common.mustCall(() => {
+    const { port } = receiver.address();
+    let i = 0;
+    (function sendNext() {
+      if (i === count) return;
+      sender.send(messages[i++], port, '127.0.0.1', common.mustSucceed(sendNext));
+    })();
+  }));
+}));
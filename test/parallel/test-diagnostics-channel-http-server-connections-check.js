@@ -0,0 +1,67 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dc = require('diagnostics_channel');
+const { createServer } = require('http');
+const { connect } = require('net');
+
+// The server publishes each check of its connections on
+// 'http.server.connections.check'. A connection that is still receiving
+// headers expires, one whose headers are complete does not.
+
+const headersTimeout = common.platformTimeout(500);
+const server = createServer({
+  headersTimeout,
+  requestTimeout: 0,
+  keepAliveTimeout: 0,
+  connectionsCheckingInterval: headersTimeout / 4,
+}, common.mustCall((req, res) => {
+  // Wait for the other connection to time out before finishing.
+  req.resume();
+  req.on('end', common.mustCall(() => res.end('ok')));
+}));
+
+let expired = 0;
+dc.subscribe('http.server.connections.check', common.mustCallAtLeast((message) => {
+  assert.strictEqual(message.server, server);
+  assert.strictEqual(typeof message.duration, 'number');
+  assert(message.duration >= 0);
+  expired += message.expired;
+}));
+
+server.listen(0, common.mustCall(() => {
+  const port = server.address().port;
+
+  const uploading = connect(port);
+  uploading.write('POST / HTTP/1.1\r\n' +
+                  'Host: localhost\r\n' +
+                  'Connection: close\r\n' +
+                  'Content-Length: 2\r\n\r\n' +
+                  'a');
+  let uploadResponse = '';
+  uploading.setEncoding('utf8');
+  uploading.on('data', (chunk) => uploadResponse += chunk);
+  uploading.on('close', common.mustCall(() => {
+    assert.match(uploadResponse, /^HTTP\/1\.1 200 OK/);
+    assert.strictEqual(expired, 1);
+    server.close();
+  }));
+
+  const interrupted = connect(port);
+  let response = '';
+  interrupted.setEncoding('utf8');
+  interrupted.on('data', (chunk) => response += chunk);
+  interrupted.on('error', () => {});
+  interrupted.on('close', common.mustCall(() => {
+    assert.strictEqual(
+      response,
+      'HTTP/1.1 408 Request Timeout\r\nConnection: close\r\n\r\n'
+    );
+    assert.strictEqual(expired, 1);
+    uploading.end('b');
+  }));
+  interrupted.write('GET / HTTP/1.1\r\n' +
+                    'Host: localhost\r\n' +
+                    'X-Slow: ');
+}));
@@ -0,0 +1,51 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dc = require('diagnostics_channel');
+const http = require('http');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+
+const { channels, subscribers } = internalBinding('diagnostics_channel');
+const connectIndex = channels.indexOf('net.native.connect');
+const parserErrorIndex = channels.indexOf('http.native.parser.error');
+assert.notStrictEqual(connectIndex, -1);
+assert.notStrictEqual(parserErrorIndex, -1);
+assert.ok(channels.includes('http2.native.frame.invalid'));
+
+{
+  // The native side only sees the channels that have subscribers.
+  const onMessage = common.mustNotCall();
+  assert.strictEqual(subscribers[connectIndex], 0);
+  dc.subscribe('net.native.connect', onMessage);
+  assert.strictEqual(subscribers[connectIndex], 1);
+  dc.unsubscribe('net.native.connect', onMessage);
+  assert.strictEqual(subscribers[connectIndex], 0);
+}
+
+const server = http.createServer(common.mustNotCall());
+
+dc.subscribe('http.native.parser.error', common.mustCall((message) => {
+  assert.strictEqual(message.code, 'HPE_INVALID_METHOD');
+  assert.strictEqual(typeof message.reason, 'string');
+  assert.strictEqual(typeof message.bytesParsed, 'number');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+
+  dc.channel('net.native.connect').subscribe(common.mustCall((message) => {
+    assert.deepStrictEqual({ ...message }, {
+      address: '127.0.0.1',
+      port,
+      family: 'IPv4',
+    });
+  }));
+
+  const socket = net.connect(port, '127.0.0.1', common.mustCall(() => {
+    socket.end('NOT_A_METHOD / HTTP/1.1\r\n\r\n');
+  }));
+  socket.resume();
+  socket.on('close', common.mustCall(() => server.close()));
+}));
@@ -0,0 +1,74 @@
+'use strict';
+const common = require('../common');
+
+// Checks that the lookup cache answers repeated lookups, shares concurrent
+// ones and can be disabled again.
+
+const assert = require('assert');
+const dns = require('dns');
+
+assert.deepStrictEqual(dns.getLookupCacheStats(), {
+  hits: 0,
+  misses: 0,
+  staleHits: 0,
+  coalesced: 0,
+  entries: 0,
+});
+
+for (const options of [null, 'yes', true, 1]) {
+  assert.throws(() => dns.setLookupCache(options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+for (const key of ['ttl', 'negativeTtl', 'staleTtl', 'maxEntries']) {
+  assert.throws(() => dns.setLookupCache({ [key]: -1 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => dns.setLookupCache({ [key]: '1' }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+dns.setLookupCache({ ttl: 60_000, maxEntries: 16 });
+
+(async () => {
+  const options = { family: 4, all: true };
+  const results = await Promise.all([
+    dns.promises.lookup('localhost', options),
+    dns.promises.lookup('localhost', options),
+    dns.promises.lookup('localhost', options),
+  ]);
+  assert.ok(results[0].length > 0);
+  assert.deepStrictEqual(results[1], results[0]);
+  assert.deepStrictEqual(results[2], results[0]);
+  assert.deepStrictEqual(dns.getLookupCacheStats(), {
+    hits: 0,
+    misses: 1,
+    staleHits: 0,
+    coalesced: 2,
+    entries: 1,
+  });
+
+  await new Promise((resolve) => {
+    dns.lookup('localhost', options, common.mustSucceed((addresses) => {
+      assert.deepStrictEqual(addresses, results[0]);
+      resolve();
+    }));
+  });
+  assert.strictEqual(dns.getLookupCacheStats().hits, 1);
+
+  // A different family is a different entry.
+  await dns.promises.lookup('localhost', { family: 0, all: true });
+  assert.strictEqual(dns.getLookupCacheStats().entries, 2);
+
+  dns.setLookupCache(false);
+  assert.strictEqual(dns.getLookupCacheStats().entries, 0);
+  await dns.promises.lookup('localhost', options);
+  assert.deepStrictEqual(dns.getLookupCacheStats(), {
+    hits: 1,
+    misses: 2,
+    staleHits: 0,
+    coalesced: 2,
+    entries: 0,
+  });
+})().then(common.mustCall());
@@ -0,0 +1,37 @@
+// Flags: --experimental-module-streaming
+'use strict';
+
+// This tests that imported ES modules that are compiled off-thread with
+// --experimental-module-streaming behave like modules compiled on the main
+// thread.
+
+const common = require('../common');
+const assert = require('assert');
+const tmpdir = require('../common/tmpdir');
+const fs = require('fs');
+const { pathToFileURL } = require('url');
+
+tmpdir.refresh();
+fs.writeFileSync(tmpdir.resolve('entry.mjs'), `
+import { b } from './b.mjs';
+import { c } from './c.mjs';
+export const value = b + c + 'é中';
+export const url = import.meta.url;
+`);
+fs.writeFileSync(tmpdir.resolve('b.mjs'), `
+import { c } from './c.mjs';
+export const b = 'b' + c;
+`);
+fs.writeFileSync(tmpdir.resolve('c.mjs'), "export const c = 'c';\n");
+fs.writeFileSync(tmpdir.resolve('invalid.mjs'), 'export const = 1;\n');
+
+(async () => {
+  const entry = pathToFileURL(tmpdir.resolve('entry.mjs')).href;
+  const ns = await import(entry);
+  assert.strictEqual(ns.value, 'bccé中');
+  assert.strictEqual(ns.url, entry);
+
+  await assert.rejects(import(pathToFileURL(tmpdir.resolve('invalid.mjs'))), {
+    name: 'SyntaxError',
+  });
+})().then(common.mustCall());
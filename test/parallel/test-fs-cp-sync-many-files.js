@@ -0,0 +1,120 @@
+'use strict';
+const common = require('../common');
+
+// cpSync() copies the regular files of large trees on several threads. Make
+// sure that trees with enough files to take that path are copied completely,
+// and that existing files and errors are handled like they are for small
+// trees.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+// Comfortably more than the 16 files per thread that are needed for at least
+// two threads.
+const kDirs = 4;
+const kFilesPerDir = 64;
+
+function contents(dir, file) {
+  return `${dir}/${file}\n`.repeat(dir + file + 1);
+}
+
+const src = tmpdir.resolve('src');
+const files = [];
+for (let dir = 0; dir < kDirs; dir++) {
+  fs.mkdirSync(path.join(src, `dir-${dir}`, 'nested'), { recursive: true });
+  for (let file = 0; file < kFilesPerDir; file++) {
+    // Half of the files are one level deeper.
+    const name = path.join(`dir-${dir}`, file % 2 ? 'nested' : '',
+                           `file-${file}.txt`);
+    fs.writeFileSync(path.join(src, name), contents(dir, file));
+    files.push([name, contents(dir, file)]);
+  }
+}
+
+let destc = 0;
+function nextdest() {
+  return tmpdir.resolve(`dest-${++destc}`);
+}
+
+function assertCopied(dest, expected = files) {
+  for (const [name, data] of expected) {
+    assert.strictEqual(fs.readFileSync(path.join(dest, name), 'utf8'), data);
+  }
+}
+
+// All files are copied, and their timestamps are preserved on request.
+{
+  const dest = nextdest();
+  fs.cpSync(src, dest, { recursive: true, preserveTimestamps: true });
+  assertCopied(dest);
+  for (const [name] of files) {
+    const srcStat = fs.statSync(path.join(src, name));
+    const destStat = fs.statSync(path.join(dest, name));
+    assert.strictEqual(destStat.mtime.getTime(), srcStat.mtime.getTime());
+  }
+}
+
+// Existing files are overwritten by default.
+{
+  const dest = nextdest();
+  fs.cpSync(src, dest, { recursive: true });
+  for (const [name] of files.slice(0, 40))
+    fs.writeFileSync(path.join(dest, name), 'old');
+  fs.cpSync(src, dest, { recursive: true });
+  assertCopied(dest);
+}
+
+// With force: false, existing files are kept and the others are copied.
+{
+  const dest = nextdest();
+  fs.cpSync(src, dest, { recursive: true });
+  const existing = files.slice(100, 140);
+  for (const [name] of existing)
+    fs.writeFileSync(path.join(dest, name), 'old');
+  for (const [name] of files.slice(0, 40))
+    fs.unlinkSync(path.join(dest, name));
+
+  fs.cpSync(src, dest, { recursive: true, force: false });
+  for (const [name] of existing)
+    assert.strictEqual(fs.readFileSync(path.join(dest, name), 'utf8'), 'old');
+  assertCopied(dest, files.slice(0, 40));
+}
+
+// With force: false and errorOnExist: true, an existing file is an error.
+{
+  const dest = nextdest();
+  fs.mkdirSync(path.join(dest, 'dir-3', 'nested'), { recursive: true });
+  const [name] = files[files.length - 1];
+  fs.writeFileSync(path.join(dest, name), 'old');
+
+  assert.throws(() => {
+    fs.cpSync(src, dest, { recursive: true, force: false, errorOnExist: true });
+  }, (err) => {
+    assert.strictEqual(err.code, 'ERR_FS_CP_EEXIST');
+    assert.ok(err.message.includes(path.join(dest, name)), err.message);
+    return true;
+  });
+  assert.strictEqual(fs.readFileSync(path.join(dest, name), 'utf8'), 'old');
+}
+
+// A file that cannot be copied fails the whole copy, even if the other files
+// are copied on other threads.
+if (!common.isWindows) {
+  const dest = nextdest();
+  const [name] = files[150];
+  // A directory is in the way of the file.
+  fs.mkdirSync(path.join(dest, name), { recursive: true });
+
+  assert.throws(() => {
+    fs.cpSync(src, dest, { recursive: true });
+  }, (err) => {
+    assert.strictEqual(err.syscall, 'cp');
+    assert.strictEqual(typeof err.code, 'string');
+    if (common.isLinux) assert.strictEqual(err.code, 'EISDIR');
+    return true;
+  });
+}
@@ -0,0 +1,89 @@
+'use strict';
+
+// This test checks that the native fast path of fs.globSync() agrees with
+// the JS implementation, which is still used when an `exclude` function is
+// passed.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = tmpdir.resolve('glob');
+const files = [
+  'a.js',
+  'b.ts',
+  '.hidden.js',
+  'src/index.js',
+  'src/util.js',
+  'src/lib/deep.js',
+  'src/lib/deep.md',
+  'src/.cache/skip.js',
+  'docs/readme.md',
+  'docs/api/fs.md',
+  'x1/y.txt',
+  'x2/y.txt',
+  'x3/y.txt',
+  'ünïcödé/é.txt',
+];
+for (const file of files) {
+  fs.mkdirSync(path.join(root, path.dirname(file)), { recursive: true });
+  fs.writeFileSync(path.join(root, file), '');
+}
+
+function sorted(results) {
+  return [...results].sort();
+}
+
+const patterns = [
+  '*',
+  '*.js',
+  '**',
+  '**/*.js',
+  '**/*.md',
+  'src/**',
+  'src/**/*.js',
+  'src/*/deep.*',
+  '**/lib/*',
+  '**/api/**',
+  'x[12]/y.txt',
+  'x[!1]/*',
+  'x?/y.txt',
+  '{src,docs}/*.{js,md}',
+  'missing/**/*.js',
+  'ünïcödé/?.txt',
+  'a.js',
+  'src/lib/deep.js',
+  ['*.js', 'src/*.js', '*.js'],
+];
+
+for (const pattern of patterns) {
+  const native = fs.globSync(pattern, { cwd: root });
+  const js = fs.globSync(pattern, { cwd: root, exclude: () => false });
+  assert.deepStrictEqual(sorted(native), sorted(js), `pattern: ${pattern}`);
+  assert.strictEqual(new Set(native).size, native.length);
+}
+
+assert.deepStrictEqual(
+  sorted(fs.globSync('**/*.js', { cwd: root })),
+  sorted(['a.js', 'src/index.js', 'src/util.js', 'src/lib/deep.js'].map(path.normalize)),
+);
+
+// Patterns that the native walker does not handle fall back to JS.
+for (const pattern of ['./*.js', '.*', 'src/../*.js', '+(a|b).*', 'x[[:digit:]]/*']) {
+  const native = fs.globSync(pattern, { cwd: root });
+  const js = fs.globSync(pattern, { cwd: root, exclude: () => false });
+  assert.deepStrictEqual(sorted(native), sorted(js), `pattern: ${pattern}`);
+}
+
+if (common.canCreateSymLink()) {
+  fs.symlinkSync(path.join(root, 'src'), path.join(root, 'link'), 'dir');
+  for (const pattern of ['**/*.js', 'link/*.js', '*']) {
+    const native = fs.globSync(pattern, { cwd: root });
+    const js = fs.globSync(pattern, { cwd: root, exclude: () => false });
+    assert.deepStrictEqual(sorted(native), sorted(js), `pattern: ${pattern}`);
+  }
+}
@@ -0,0 +1,124 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const testDir = tmpdir.resolve('prefetch');
+fs.mkdirSync(testDir);
+
+const expected = [];
+for (let i = 0; i < 100; i++) {
+  const name = i % 10 === 0 ? `dir-${i}` : `filé-${i}`;
+  if (name.startsWith('dir'))
+    fs.mkdirSync(`${testDir}/${name}`);
+  else
+    fs.writeFileSync(`${testDir}/${name}`, '');
+  expected.push(name);
+}
+expected.sort();
+
+function check(dirents, encoding) {
+  const names = dirents.map((dirent) => {
+    if (encoding === 'buffer') {
+      assert.ok(Buffer.isBuffer(dirent.name));
+      return dirent.name.toString();
+    }
+    return dirent.name;
+  });
+  assert.deepStrictEqual(names.sort(), expected);
+  for (const dirent of dirents) {
+    const name = String(dirent.name);
+    assert.strictEqual(dirent.isDirectory(), name.startsWith('dir'));
+    assert.strictEqual(dirent.isFile(), !name.startsWith('dir'));
+  }
+}
+
+assert.throws(() => fs.opendirSync(testDir, { prefetch: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+// Async iteration, with batches smaller than the directory.
+for (const encoding of ['utf8', 'buffer', 'latin1', 'hex']) {
+  (async () => {
+    const dirents = [];
+    const dir = await fs.promises.opendir(testDir, {
+      bufferSize: 7,
+      encoding,
+      prefetch: true,
+    });
+    for await (const dirent of dir)
+      dirents.push(dirent);
+    if (encoding === 'latin1' || encoding === 'hex') {
+      const decoded = dirents.map((dirent) => {
+        const name = Buffer.from(dirent.name, encoding).toString();
+        return { __proto__: dirent, name };
+      });
+      check(decoded);
+    } else {
+      check(dirents, encoding);
+    }
+  })().then(common.mustCall());
+}
+
+// Callback reads.
+{
+  const dir = fs.opendirSync(testDir, { bufferSize: 3, prefetch: true });
+  const dirents = [];
+  function read() {
+    dir.read(common.mustSucceed((dirent) => {
+      if (dirent === null) {
+        check(dirents);
+        dir.close(common.mustSucceed());
+        return;
+      }
+      dirents.push(dirent);
+      read();
+    }));
+  }
+  read();
+}
+
+// Synchronous reads consume a batch that was prefetched asynchronously.
+{
+  const dir = fs.opendirSync(testDir, { bufferSize: 1, prefetch: true });
+  dir.read(common.mustSucceed((first) => {
+    // The next batch is being prefetched.
+    assert.throws(() => dir.readSync(), {
+      code: 'ERR_DIR_CONCURRENT_OPERATION',
+    });
+    assert.throws(() => dir.closeSync(), {
+      code: 'ERR_DIR_CONCURRENT_OPERATION',
+    });
+
+    setImmediate(common.mustCall(function waitForPrefetch() {
+      let dirent;
+      try {
+        dirent = dir.readSync();
+      } catch (err) {
+        assert.strictEqual(err.code, 'ERR_DIR_CONCURRENT_OPERATION');
+        return setImmediate(common.mustCall(waitForPrefetch));
+      }
+      const dirents = [first, dirent];
+      while ((dirent = dir.readSync()) !== null)
+        dirents.push(dirent);
+      check(dirents);
+      dir.closeSync();
+    }));
+  }));
+}
+
+// Closing waits for a pending prefetch.
+{
+  const dir = fs.opendirSync(testDir, { bufferSize: 1, prefetch: true });
+  dir.read(common.mustSucceed((dirent) => {
+    assert.notStrictEqual(dirent, null);
+    dir.close(common.mustSucceed(() => {
+      assert.rejects(dir.read(), { code: 'ERR_DIR_CLOSED' })
+        .then(common.mustCall());
+    }));
+  }));
+}
@@ -0,0 +1,82 @@
+'use strict';
+
+// Tests filehandle.setWriteBehind(): writes issued without waiting for the
+// previous ones are applied in order and each reports its own byte count.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { open } = fs.promises;
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+async function currentPosition() {
+  const filename = tmpdir.resolve('write-behind-append.txt');
+  const file = await open(filename, 'w');
+  assert.strictEqual(file.setWriteBehind(), file);
+
+  const chunks = [];
+  const writes = [];
+  for (let i = 0; i < 200; i++) {
+    const chunk = `line ${i}\n`;
+    chunks.push(chunk);
+    writes.push(i % 2 ?
+      file.write(chunk) :
+      file.write(Buffer.from(`xx${chunk}`), 2, Buffer.byteLength(chunk)));
+  }
+  const results = await Promise.all(writes);
+  for (let i = 0; i < results.length; i++) {
+    assert.strictEqual(results[i].bytesWritten, Buffer.byteLength(chunks[i]));
+  }
+  assert.strictEqual(results[1].buffer, chunks[1]);
+  await file.close();
+  assert.strictEqual(fs.readFileSync(filename, 'utf8'), chunks.join(''));
+}
+
+async function positional() {
+  const filename = tmpdir.resolve('write-behind-positional.txt');
+  const file = await open(filename, 'w');
+  file.setWriteBehind(true);
+  await Promise.all([
+    file.write(Buffer.from('abc'), 0, 3, 0),
+    file.write(Buffer.from('def'), 0, 3, 3),
+    // Not contiguous with the previous write.
+    file.write(Buffer.from('XY'), 0, 2, 1),
+    file.write('ü', 6, 'utf8'),
+  ]);
+  await file.close();
+  assert.strictEqual(fs.readFileSync(filename, 'utf8'), 'aXYdefü');
+}
+
+async function disable() {
+  const filename = tmpdir.resolve('write-behind-disabled.txt');
+  const file = await open(filename, 'w');
+  file.setWriteBehind(true);
+  file.setWriteBehind(false);
+  assert.strictEqual((await file.write('abc')).bytesWritten, 3);
+  await file.close();
+  assert.strictEqual(fs.readFileSync(filename, 'utf8'), 'abc');
+}
+
+async function errors() {
+  const file = await open(tmpdir.resolve('write-behind-readonly.txt'), 'w');
+  await file.close();
+  const readonly = await open(tmpdir.resolve('write-behind-readonly.txt'), 'r');
+  readonly.setWriteBehind();
+  await Promise.all([
+    assert.rejects(readonly.write('a'), { code: 'EBADF' }),
+    assert.rejects(readonly.write('b'), { code: 'EBADF' }),
+  ]);
+  await readonly.close();
+  assert.throws(() => readonly.setWriteBehind('yes'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+(async () => {
+  await currentPosition();
+  await positional();
+  await disable();
+  await errors();
+})().then(common.mustCall());
@@ -0,0 +1,81 @@
+'use strict';
+const common = require('../common');
+const assert = require('node:assert');
+const fs = require('node:fs');
+const path = require('node:path');
+const { pathToFileURL } = require('node:url');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const empty = tmpdir.resolve('empty.txt');
+fs.writeFileSync(empty, '');
+const latin1 = tmpdir.resolve('latin1.txt');
+fs.writeFileSync(latin1, Buffer.from([0x61, 0xe9, 0xff]));
+const missing = path.join(__dirname, 'does-not-exist-readMany');
+const paths = [__filename, empty, missing, pathToFileURL(latin1), __dirname];
+
+function verify(contents, encoding) {
+  assert.strictEqual(contents.length, paths.length);
+  const expected = [
+    fs.readFileSync(__filename, encoding),
+    fs.readFileSync(empty, encoding),
+    undefined,
+    fs.readFileSync(latin1, encoding),
+  ];
+  for (let i = 0; i < 4; i++) {
+    if (i === 2) continue;
+    assert.deepStrictEqual(contents[i], expected[i]);
+  }
+
+  assert.ok(contents[2] instanceof Error);
+  assert.strictEqual(contents[2].code, 'ENOENT');
+  assert.strictEqual(contents[2].syscall, 'open');
+  assert.strictEqual(contents[2].path, missing);
+
+  assert.ok(contents[4] instanceof Error);
+  assert.strictEqual(contents[4].code, 'EISDIR');
+}
+
+for (const encoding of [undefined, 'utf8', 'latin1', 'base64']) {
+  verify(fs.readManySync(paths, encoding), encoding);
+  verify(fs.readManySync(paths, { encoding }), encoding);
+  fs.readMany(paths, { encoding }, common.mustSucceed((contents) => {
+    verify(contents, encoding);
+  }));
+  fs.promises.readMany(paths, { encoding }).then(common.mustCall((contents) => {
+    verify(contents, encoding);
+  }));
+}
+
+fs.readMany(paths, common.mustSucceed((contents) => {
+  verify(contents);
+  assert.ok(Buffer.isBuffer(contents[0]));
+}));
+assert.deepStrictEqual(fs.readManySync([]), []);
+
+// Files whose size is not known up front are read until the end.
+if (common.isLinux) {
+  const [status] = fs.readManySync(['/proc/self/status'], 'utf8');
+  assert.match(status, /^Name:/);
+}
+
+[false, 1, {}, null, undefined, 'file'].forEach((input) => {
+  assert.throws(() => fs.readManySync(input), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError',
+  });
+  assert.throws(() => fs.readMany(input, common.mustNotCall()), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError',
+  });
+});
+
+assert.throws(() => fs.readManySync([__filename, 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /"paths\[1\]"/,
+});
+
+assert.throws(() => fs.readMany(paths), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
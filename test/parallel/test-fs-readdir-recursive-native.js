@@ -0,0 +1,79 @@
+'use strict';
+
+// This test checks readdir({ recursive: true }) results as produced by the
+// native directory walker: breadth-first order, relative paths, Dirent
+// parent paths, symlinked directories and error reporting.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = tmpdir.resolve('walk');
+fs.mkdirSync(path.join(root, 'a', 'b'), { recursive: true });
+fs.mkdirSync(path.join(root, 'c'));
+fs.writeFileSync(path.join(root, 'file.txt'), '');
+fs.writeFileSync(path.join(root, 'a', 'one.txt'), '');
+fs.writeFileSync(path.join(root, 'a', 'b', 'two.txt'), '');
+fs.writeFileSync(path.join(root, 'c', 'three.txt'), '');
+
+const expected = [
+  'a',
+  'c',
+  'file.txt',
+  path.join('a', 'b'),
+  path.join('a', 'one.txt'),
+  path.join('c', 'three.txt'),
+  path.join('a', 'b', 'two.txt'),
+];
+
+assert.deepStrictEqual(fs.readdirSync(root, { recursive: true }), expected);
+
+fs.readdir(root, { recursive: true }, common.mustSucceed((files) => {
+  assert.deepStrictEqual(files, expected);
+}));
+
+{
+  const dirents = fs.readdirSync(root, { recursive: true, withFileTypes: true });
+  assert.deepStrictEqual(
+    dirents.map((d) => path.join(d.parentPath, d.name)),
+    expected.map((p) => path.join(root, p)),
+  );
+  assert.strictEqual(dirents[0].parentPath, root);
+  assert.ok(dirents[0].isDirectory());
+  assert.ok(dirents[2].isFile());
+}
+
+fs.readdir(root, { recursive: true, withFileTypes: true },
+           common.mustSucceed((dirents) => {
+             assert.deepStrictEqual(dirents.map((d) => d.name),
+                                    expected.map((p) => path.basename(p)));
+           }));
+
+// Other encodings still use the JS implementation and agree on the result.
+assert.deepStrictEqual(
+  fs.readdirSync(root, { recursive: true, encoding: 'latin1' }), expected);
+
+// Symlinks to directories are walked.
+if (common.canCreateSymLink()) {
+  const linked = tmpdir.resolve('linked');
+  fs.mkdirSync(linked);
+  fs.symlinkSync(path.join(root, 'c'), path.join(linked, 'link'), 'dir');
+  assert.deepStrictEqual(fs.readdirSync(linked, { recursive: true }),
+                         ['link', path.join('link', 'three.txt')]);
+  const dirents = fs.readdirSync(linked, { recursive: true, withFileTypes: true });
+  assert.ok(dirents[0].isSymbolicLink());
+}
+
+assert.throws(() => fs.readdirSync(tmpdir.resolve('missing'), { recursive: true }), {
+  code: 'ENOENT',
+  syscall: 'scandir',
+});
+
+fs.readdir(tmpdir.resolve('missing'), { recursive: true }, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'scandir');
+}));
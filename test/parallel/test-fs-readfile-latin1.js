@@ -0,0 +1,84 @@
+// Flags: --expose-gc --expose-internals
+'use strict';
+const common = require('../common');
+
+// This test ensures that large files that are read as latin1 or ASCII strings,
+// which share the memory of the buffer the file was read into instead of
+// copying it, have the right contents, also after the buffer is collected,
+// and that memory the buffer does not own alone is always copied.
+
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const { internalBinding } = require('internal/test/binding');
+
+tmpdir.refresh();
+
+// The largest files are mapped into memory with the mmap option.
+const sizes = [1024, 2 * 1024 * 1024 + 3, 5 * 1024 * 1024];
+const files = sizes.map((size) => {
+  const ascii = Buffer.alloc(size);
+  const latin1 = Buffer.alloc(size);
+  for (let i = 0; i < size; i++) {
+    ascii[i] = 0x20 + i % 95;
+    latin1[i] = i % 256;
+  }
+  const asciiFile = tmpdir.resolve(`ascii-${size}.txt`);
+  const latin1File = tmpdir.resolve(`latin1-${size}.txt`);
+  fs.writeFileSync(asciiFile, ascii);
+  fs.writeFileSync(latin1File, latin1);
+  return [
+    [asciiFile, ascii],
+    [latin1File, latin1],
+  ];
+}).flat();
+
+const checks = [];
+function check(str, contents, encoding) {
+  assert.strictEqual(str, contents.toString(encoding));
+  checks.push([str, contents, encoding]);
+}
+
+for (const [file, contents] of files) {
+  for (const encoding of ['latin1', 'binary', 'ascii']) {
+    check(fs.readFileSync(file, { encoding }), contents, encoding);
+    check(fs.readFileSync(file, { encoding, mmap: true }), contents, encoding);
+    fs.readFile(file, encoding, common.mustSucceed((str) => {
+      check(str, contents, encoding);
+    }));
+    fs.promises.readFile(file, encoding).then(common.mustCall((str) => {
+      check(str, contents, encoding);
+    }));
+  }
+}
+
+{
+  const { toStringWithoutCopy } = internalBinding('buffer');
+  const { mapFile } = internalBinding('fs');
+  const size = 5 * 1024 * 1024;
+
+  const shared = new Uint8Array(new SharedArrayBuffer(size)).fill(0x61);
+  const fromShared = toStringWithoutCopy(shared, 'latin1');
+  shared.fill(0x62);
+  assert.strictEqual(fromShared, 'a'.repeat(size));
+
+  const file = tmpdir.resolve('mapped.txt');
+  fs.writeFileSync(file, 'a'.repeat(size));
+  const fd = fs.openSync(file, 'r+');
+  const mapped = mapFile(fd, size);
+  if (mapped !== undefined) {
+    const fromMapped = toStringWithoutCopy(mapped, 'latin1');
+    fs.writeSync(fd, 'b'.repeat(size), 0);
+    // The mapping itself sees the write.
+    if (common.isLinux) assert.strictEqual(mapped[0], 0x62);
+    assert.strictEqual(fromMapped, 'a'.repeat(size));
+  }
+  fs.closeSync(fd);
+}
+
+process.on('exit', () => {
+  globalThis.gc();
+  for (const [str, contents, encoding] of checks) {
+    assert.strictEqual(str, contents.toString(encoding));
+  }
+});
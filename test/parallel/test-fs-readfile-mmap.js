@@ -0,0 +1,95 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// This test ensures that large regular files, which fs.readFile() and
+// fs.readFileSync() map into memory with the mmap option instead of reading
+// them, still come back with the right contents, that the returned Buffers do
+// not write through to the file, and that strings and the Buffers returned
+// without the option do not change with the file.
+
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const { internalBinding } = require('internal/test/binding');
+
+const { kReadFileMmapThreshold } = internalBinding('fs');
+assert.strictEqual(typeof kReadFileMmapThreshold, 'number');
+
+tmpdir.refresh();
+
+const size = Math.max(kReadFileMmapThreshold, 1024) + 17;
+const ascii = tmpdir.resolve('mmap-ascii.txt');
+const utf8 = tmpdir.resolve('mmap-utf8.txt');
+const asciiContents = 'abcdefghij\n'.repeat(Math.ceil(size / 11));
+const utf8Contents = `${asciiContents}é中😀`;
+fs.writeFileSync(ascii, asciiContents);
+fs.writeFileSync(utf8, utf8Contents);
+
+for (const mmap of [1, 'true', null]) {
+  assert.throws(() => fs.readFileSync(ascii, { mmap }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => fs.readFile(ascii, { mmap }, common.mustNotCall()), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+for (const mmap of [false, true]) {
+  const options = { mmap };
+  assert.strictEqual(fs.readFileSync(ascii, { ...options, encoding: 'utf8' }),
+                     asciiContents);
+  assert.strictEqual(fs.readFileSync(utf8, { ...options, encoding: 'utf8' }),
+                     utf8Contents);
+  assert.strictEqual(fs.readFileSync(ascii, { ...options, encoding: 'latin1' }),
+                     asciiContents);
+
+  const buf = fs.readFileSync(ascii, options);
+  assert.ok(Buffer.isBuffer(buf));
+  assert.strictEqual(buf.length, Buffer.byteLength(asciiContents));
+  assert.strictEqual(buf.toString(), asciiContents);
+
+  // Writes to the Buffer must stay private to this process.
+  buf[0] = 0x41;
+  assert.strictEqual(fs.readFileSync(ascii, 'utf8'), asciiContents);
+}
+
+// Strings never refer to the mapping, and without the option, neither do
+// Buffers.
+{
+  const file = tmpdir.resolve('mmap-changed.txt');
+  fs.writeFileSync(file, asciiContents);
+  const strings = ['utf8', 'latin1', 'ascii'].map((encoding) => {
+    return fs.readFileSync(file, { encoding, mmap: true });
+  });
+  const buf = fs.readFileSync(file);
+  const fd = fs.openSync(file, 'r+');
+  fs.writeSync(fd, 'ABCDEFGHIJ', 0);
+  fs.closeSync(fd);
+  for (const str of strings)
+    assert.strictEqual(str, asciiContents);
+  assert.strictEqual(buf.toString(), asciiContents);
+}
+
+for (const mmap of [false, true]) {
+  fs.readFile(utf8, { mmap }, common.mustSucceed((buf) => {
+    assert.strictEqual(buf.toString(), utf8Contents);
+  }));
+
+  fs.readFile(ascii, { encoding: 'utf8', mmap }, common.mustSucceed((str) => {
+    assert.strictEqual(str, asciiContents);
+  }));
+
+  fs.readFile(ascii, { encoding: 'latin1', mmap }, common.mustSucceed((str) => {
+    assert.strictEqual(str, asciiContents);
+  }));
+}
+
+// A user-supplied fd is read from its current position.
+{
+  const fd = fs.openSync(ascii, 'r');
+  fs.readSync(fd, Buffer.alloc(11), 0, 11, null);
+  assert.strictEqual(fs.readFileSync(fd, { encoding: 'utf8', mmap: true }),
+                     asciiContents.slice(11));
+  fs.closeSync(fd);
+}
@@ -0,0 +1,66 @@
+'use strict';
+
+// This test checks fs.rm(path, { recursive: true }) on trees that are wide
+// and deep enough to be spread over several jobs of the native remover.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+let count = 0;
+function makeTree(dir, depth) {
+  fs.mkdirSync(dir, { recursive: true });
+  for (let i = 0; i < 20; i++) {
+    fs.writeFileSync(path.join(dir, `file-${i}`), '');
+  }
+  if (depth > 0) {
+    for (let i = 0; i < 6; i++) {
+      makeTree(path.join(dir, `dir-${i}`), depth - 1);
+    }
+  }
+  count++;
+}
+
+const outside = tmpdir.resolve('outside');
+fs.mkdirSync(outside);
+fs.writeFileSync(path.join(outside, 'keep'), '');
+
+const root = tmpdir.resolve('tree');
+makeTree(root, 3);
+assert.strictEqual(count, 259);
+if (common.canCreateSymLink()) {
+  // Symlinks are removed, not followed.
+  fs.symlinkSync(outside, path.join(root, 'dir-0', 'link'), 'dir');
+  fs.symlinkSync(path.join(outside, 'keep'), path.join(root, 'file-link'));
+}
+
+fs.rm(root, { recursive: true }, common.mustSucceed(() => {
+  assert.strictEqual(fs.existsSync(root), false);
+  assert.strictEqual(fs.existsSync(path.join(outside, 'keep')), true);
+
+  // A single file, and a path that is already gone.
+  const file = tmpdir.resolve('single');
+  fs.writeFileSync(file, '');
+  fs.promises.rm(file, { recursive: true }).then(common.mustCall(() => {
+    assert.strictEqual(fs.existsSync(file), false);
+    return fs.promises.rm(file, { recursive: true, force: true });
+  })).then(common.mustCall());
+}));
+
+// Entries that cannot be removed make the whole operation fail.
+if (!common.isWindows && !common.isIBMi && process.getuid() !== 0) {
+  const locked = tmpdir.resolve('locked');
+  makeTree(locked, 1);
+  fs.chmodSync(path.join(locked, 'dir-2'), 0o500);
+  fs.rm(locked, { recursive: true }, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EACCES');
+    assert.strictEqual(err.syscall, 'unlink');
+    assert.strictEqual(path.dirname(err.path), path.join(locked, 'dir-2'));
+    fs.chmodSync(path.join(locked, 'dir-2'), 0o700);
+    fs.rmSync(locked, { recursive: true });
+  }));
+}
@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common');
+const assert = require('node:assert');
+const fs = require('node:fs');
+const path = require('node:path');
+const { pathToFileURL } = require('node:url');
+
+const missing = path.join(__dirname, 'does-not-exist-statMany');
+const paths = [__filename, __dirname, missing, pathToFileURL(__filename)];
+
+function verify(stats, bigint = false) {
+  assert.strictEqual(stats.length, paths.length);
+  const expected = bigint ?
+    fs.statSync(__filename, { bigint: true }) :
+    fs.statSync(__filename);
+  assert.ok(stats[0].isFile());
+  assert.strictEqual(stats[0].ino, expected.ino);
+  assert.strictEqual(stats[0].size, expected.size);
+  assert.strictEqual(typeof stats[0].size, bigint ? 'bigint' : 'number');
+  assert.ok(stats[1].isDirectory());
+  assert.strictEqual(stats[2], 'ENOENT');
+  assert.strictEqual(stats[3].ino, expected.ino);
+}
+
+verify(fs.statManySync(paths));
+verify(fs.statManySync(paths, { bigint: true }), true);
+assert.deepStrictEqual(fs.statManySync([]), []);
+
+fs.statMany(paths, common.mustSucceed((stats) => verify(stats)));
+fs.statMany(paths, { bigint: true }, common.mustSucceed((stats) => {
+  verify(stats, true);
+}));
+
+fs.promises.statMany(paths).then(common.mustCall(verify));
+
+[false, 1, {}, null, undefined, 'file'].forEach((input) => {
+  assert.throws(() => fs.statManySync(input), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError',
+  });
+  assert.throws(() => fs.statMany(input, common.mustNotCall()), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError',
+  });
+});
+
+assert.throws(() => fs.statManySync([__filename, 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /"paths\[1\]"/,
+});
+
+assert.throws(() => fs.statMany(paths), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
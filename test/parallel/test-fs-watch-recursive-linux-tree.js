@@ -0,0 +1,82 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('This test can run only on Linux');
+
+// Test that a recursive watcher on Linux watches the whole tree with a single
+// handle, and follows the directories that are created in or moved into it.
+
+const assert = require('node:assert');
+const path = require('node:path');
+const fs = require('node:fs');
+const { setTimeout } = require('node:timers/promises');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const rootDirectory = fs.mkdtempSync(tmpdir.path + path.sep);
+for (let i = 0; i < 20; i++) {
+  fs.mkdirSync(path.join(rootDirectory, `dir-${i}`, 'sub'), { recursive: true });
+}
+
+function countHandles(type) {
+  return process.getActiveResourcesInfo().filter((t) => t === type).length;
+}
+
+function waitFor(watcher, filename, encoding) {
+  return new Promise((resolve) => {
+    watcher.on('change', function listener(event, name) {
+      if (encoding === 'buffer') {
+        assert.ok(Buffer.isBuffer(name));
+        name = name.toString();
+      }
+      if (name === filename) {
+        watcher.off('change', listener);
+        resolve(event);
+      }
+    });
+  });
+}
+
+(async () => {
+  const watcher = fs.watch(rootDirectory, { recursive: true });
+  assert.strictEqual(countHandles('RecursiveFSEventWrap'), 1);
+  assert.strictEqual(countHandles('FSEventWrap'), 0);
+
+  // A change in an existing subdirectory.
+  let event = waitFor(watcher, path.join('dir-3', 'sub', 'file.txt'));
+  fs.writeFileSync(path.join(rootDirectory, 'dir-3', 'sub', 'file.txt'), 'a');
+  assert.strictEqual(await event, 'rename');
+
+  // Files in directories that are created together with them.
+  event = waitFor(watcher, path.join('new', 'a', 'b', 'file.txt'));
+  fs.mkdirSync(path.join(rootDirectory, 'new', 'a', 'b'), { recursive: true });
+  fs.writeFileSync(path.join(rootDirectory, 'new', 'a', 'b', 'file.txt'), 'a');
+  assert.strictEqual(await event, 'rename');
+
+  // Changes in a directory that has been moved are reported by its new path.
+  fs.renameSync(path.join(rootDirectory, 'new'),
+                path.join(rootDirectory, 'dir-0', 'moved'));
+  await setTimeout(common.platformTimeout(100));
+  event = waitFor(watcher, path.join('dir-0', 'moved', 'a', 'b', 'file.txt'));
+  fs.appendFileSync(
+    path.join(rootDirectory, 'dir-0', 'moved', 'a', 'b', 'file.txt'), 'b');
+  assert.strictEqual(await event, 'change');
+
+  watcher.close();
+})().then(common.mustCall());
+
+(async () => {
+  // The filenames are encoded as requested.
+  const watcher = fs.watch(rootDirectory, {
+    recursive: true,
+    encoding: 'buffer',
+  });
+  const event = waitFor(watcher, path.join('dir-7', 'sub', 'other.txt'),
+                        'buffer');
+  fs.writeFileSync(path.join(rootDirectory, 'dir-7', 'sub', 'other.txt'), 'a');
+  assert.strictEqual(await event, 'rename');
+  watcher.close();
+})().then(common.mustCall());
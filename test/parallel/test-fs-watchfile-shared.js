@@ -0,0 +1,52 @@
+'use strict';
+
+// Watchers polling at the same interval share one timer and one batched
+// stat job. Only the watchers whose file changed must be notified, and
+// closing a watcher from within a change listener must not disturb the
+// others.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const interval = 10;
+const files = [];
+for (let i = 0; i < 50; i++) {
+  const file = tmpdir.resolve(`file-${i}`);
+  fs.writeFileSync(file, 'a');
+  files.push(file);
+}
+
+const changed = files[17];
+const missing = path.join(tmpdir.path, 'does-not-exist');
+
+for (const file of files) {
+  if (file === changed) continue;
+  fs.watchFile(file, { interval }, common.mustNotCall());
+}
+
+// A missing file is reported once with zeroed stats, then not again
+// until it shows up.
+fs.watchFile(missing, { interval }, common.mustCall((curr) => {
+  assert.strictEqual(curr.ino, 0);
+}));
+
+fs.watchFile(changed, { interval }, common.mustCall((curr, prev) => {
+  assert.strictEqual(prev.size, 1);
+  assert.strictEqual(curr.size, 3);
+
+  // Close this watcher and then the rest while the sweep that delivered
+  // the change is still being processed.
+  fs.unwatchFile(changed);
+  for (const file of files) fs.unwatchFile(file);
+  fs.unwatchFile(missing);
+}));
+
+// The first sweep only records a baseline. Wait for it before writing.
+setTimeout(() => {
+  fs.writeFileSync(changed, 'abc');
+}, common.platformTimeout(100));
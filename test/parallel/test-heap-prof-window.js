@@ -0,0 +1,97 @@
+'use strict';
+
+// This tests that --heap-prof-window writes a heap profile for every window
+// while the sampling keeps running, and that --heap-prof-format=pprof writes
+// them in the pprof format.
+
+const common = require('../common');
+common.skipIfInspectorDisabled();
+
+const assert = require('assert');
+const fs = require('fs');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+const {
+  getHeapProfiles,
+  findFirstFrame,
+  kHeapProfInterval,
+  env,
+} = require('../common/prof');
+
+// Keep allocating, and retaining, for a few windows.
+const code = `
+  const end = Date.now() + 1000;
+  const retained = [];
+  function allocateRetained() {
+    for (let i = 0; i < 100; i++) retained.push({ i, s: 'x'.repeat(i) });
+  }
+  function work() {
+    allocateRetained();
+    if (Date.now() < end) setImmediate(work);
+  }
+  work();
+`;
+
+function run(...args) {
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--heap-prof',
+    '--heap-prof-interval',
+    kHeapProfInterval,
+    '--heap-prof-window',
+    '200',
+    ...args,
+    '-e', code,
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  return output;
+}
+
+{
+  run();
+  const profiles = getHeapProfiles(tmpdir.path);
+  assert(profiles.length > 1, `${profiles.length} profiles`);
+  const { frame } = findFirstFrame(profiles[profiles.length - 1],
+                                   'allocateRetained');
+  assert.notStrictEqual(frame, undefined);
+}
+
+{
+  run('--heap-prof-format', 'pprof');
+  const profiles = fs.readdirSync(tmpdir.path)
+    .filter((file) => file.endsWith('.pprof'));
+  assert(profiles.length > 1, `${profiles.length} profiles`);
+  const text = fs.readFileSync(tmpdir.resolve(profiles[profiles.length - 1]))
+    .toString('latin1');
+  assert(!text.includes('"head"'));
+  assert(text.includes('space'));
+  assert(text.includes('allocateRetained'));
+}
+
+// --heap-prof-window with --heap-prof-name
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--heap-prof',
+    '--heap-prof-window',
+    '100',
+    '--heap-prof-name',
+    'test.heapprofile',
+    '-e', '',
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  assert.strictEqual(output.status, 9);
+  assert.strictEqual(
+    output.stderr.toString().trim(),
+    `${process.execPath}: --heap-prof-name cannot be used with ` +
+    '--heap-prof-window');
+}
@@ -0,0 +1,92 @@
+// Flags: --expose-internals
+'use strict';
+require('../common');
+
+// The header block of outgoing messages is serialized natively when all the
+// headers are plain strings or numbers. Check that the result, the state
+// derived from special headers and the validation errors are the same as
+// those of the JS implementation.
+
+const assert = require('assert');
+const { OutgoingMessage } = require('http');
+const { kOutHeaders } = require('internal/http');
+const { internalBinding } = require('internal/test/binding');
+const { serializeHeaders } = internalBinding('http_serializer');
+
+const firstLine = 'GET / HTTP/1.1\r\n';
+
+function store(headers) {
+  const msg = new OutgoingMessage();
+  msg._storeHeader(firstLine, headers);
+  return msg;
+}
+
+{
+  const expected = firstLine +
+    'A: 1\r\nContent-Length: 5\r\nSet-Cookie: a\r\nSet-Cookie: b\r\n' +
+    'Connection: keep-alive\r\n\r\n';
+  for (const headers of [
+    ['A', '1', 'Content-Length', 5, 'Set-Cookie', ['a', 'b']],
+    [['A', '1'], ['Content-Length', 5], ['Set-Cookie', ['a', 'b']]],
+    { 'A': '1', 'Content-Length': 5, 'Set-Cookie': ['a', 'b'] },
+  ]) {
+    const msg = store(headers);
+    assert.strictEqual(msg._header, expected);
+    assert.strictEqual(msg._contentLength, 5);
+    assert.strictEqual(msg.chunkedEncoding, false);
+  }
+}
+
+{
+  const msg = new OutgoingMessage();
+  msg.setHeader('connection', 'close');
+  msg.setHeader('x-latin1', 'café');
+  msg.setHeader('cookie', ['a=1', 'b=2']);
+  msg._storeHeader(firstLine, msg[kOutHeaders]);
+  assert.strictEqual(
+    msg._header,
+    firstLine + 'connection: close\r\nx-latin1: café\r\n' +
+    'cookie: a=1; b=2\r\nTransfer-Encoding: chunked\r\n\r\n');
+  assert.strictEqual(msg._last, true);
+  assert.strictEqual(msg.chunkedEncoding, true);
+}
+
+{
+  // More special headers than the native serializer records.
+  const headers = [];
+  for (let i = 0; i < 40; i++) headers.push('Date', `${i}`);
+  const msg = store(headers);
+  assert.strictEqual(msg._header.split('\r\nDate: ').length, 41);
+}
+
+assert.throws(() => store(['In valid', 'x']), {
+  code: 'ERR_INVALID_HTTP_TOKEN',
+});
+assert.throws(() => store({ '': 'x' }), { code: 'ERR_INVALID_HTTP_TOKEN' });
+assert.throws(() => store({ x: 'a\r\nb' }), { code: 'ERR_INVALID_CHAR' });
+assert.throws(() => store({ x: 'Ā' }), { code: 'ERR_INVALID_CHAR' });
+assert.throws(() => store({ x: undefined }), {
+  code: 'ERR_HTTP_INVALID_HEADER_VALUE',
+});
+assert.throws(() => store(['x']), { code: 'ERR_INVALID_ARG_VALUE' });
+
+{
+  const specials = new Uint32Array(3);
+  assert.strictEqual(
+    serializeHeaders(['a', 'b', 'Connection', 'close'], true, specials),
+    'a: b\r\nConnection: close\r\n');
+  assert.deepStrictEqual([...specials], [1, 2, 0]);
+
+  assert.strictEqual(serializeHeaders(['a b', 'c'], true, specials),
+                     undefined);
+  assert.strictEqual(serializeHeaders(['a b', 'c'], false, specials),
+                     'a b: c\r\n');
+  assert.strictEqual(serializeHeaders(['a', 1], false, specials), undefined);
+  assert.strictEqual(serializeHeaders(['a', 'Ā'], false, specials),
+                     undefined);
+  assert.strictEqual(
+    serializeHeaders(['Date', '1', 'Date', '2', 'Date', '3'], true, specials),
+    undefined);
+  assert.strictEqual(serializeHeaders([], true, specials), '');
+  assert.strictEqual(specials[0], 0);
+}
@@ -0,0 +1,81 @@
+'use strict';
+const { mustCall } = require('../common');
+const assert = require('assert');
+
+const { HTTPParser } = require('_http_common');
+const { REQUEST, RESPONSE } = HTTPParser;
+
+const kOnHeaders = HTTPParser.kOnHeaders | 0;
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+
+// Headers, URLs and status messages that arrive one byte at a time, in
+// separate buffers, are reassembled, including when there are more headers
+// than fit into a single kOnHeaders call and across keep-alive requests.
+
+function feedByteByByte(parser, message) {
+  for (let i = 0; i < message.length; i++) {
+    assert.strictEqual(parser.execute(Buffer.from(message.subarray(i, i + 1))),
+                       1);
+  }
+}
+
+{
+  const cookie = 'a='.padEnd(16 * 1024, 'x');
+  const extraHeaders = Array.from({ length: 40 },
+                                  (_, i) => [`x-h${i}`, `${i}`]);
+  const requests = [
+    {
+      url: '/first?query=' + 'q'.repeat(1000),
+      headers: [['Cookie', cookie], ...extraHeaders],
+    },
+    { url: '/second', headers: [['Host', 'example.com'], ['Cookie', 'b=c']] },
+  ];
+
+  const parser = new HTTPParser();
+  parser.initialize(REQUEST, {}, 64 * 1024);
+
+  let flushedHeaders = [];
+  let flushedUrl = '';
+  parser[kOnHeaders] = (headers, url) => {
+    flushedHeaders = flushedHeaders.concat(headers);
+    flushedUrl += url;
+  };
+
+  let index = 0;
+  parser[kOnHeadersComplete] = mustCall((versionMajor, versionMinor, headers,
+                                         method, url) => {
+    const expected = requests[index++];
+    assert.strictEqual(flushedUrl + (url ?? ''), expected.url);
+    // The headers are undefined if they have all been passed to kOnHeaders.
+    assert.deepStrictEqual(flushedHeaders.concat(headers ?? []),
+                           expected.headers.flat());
+    flushedHeaders = [];
+    flushedUrl = '';
+  }, requests.length);
+  parser[kOnMessageComplete] = mustCall(requests.length);
+
+  for (const { url, headers } of requests) {
+    const head = headers.map(([name, value]) => `${name}: ${value}\r\n`);
+    feedByteByByte(parser,
+                   Buffer.from(`GET ${url} HTTP/1.1\r\n${head.join('')}\r\n`));
+  }
+}
+
+{
+  const statusMessage = 'Very Long Status Message '.repeat(20).trim();
+  const parser = new HTTPParser();
+  parser.initialize(RESPONSE, {});
+
+  parser[kOnHeadersComplete] = mustCall((versionMajor, versionMinor, headers,
+                                         method, url, statusCode,
+                                         message) => {
+    assert.strictEqual(statusCode, 200);
+    assert.strictEqual(message, statusMessage);
+    assert.deepStrictEqual(headers, ['Content-Length', '0']);
+  });
+  parser[kOnMessageComplete] = mustCall();
+
+  feedByteByByte(parser, Buffer.from(
+    `HTTP/1.1 200 ${statusMessage}\r\nContent-Length: 0\r\n\r\n`));
+}
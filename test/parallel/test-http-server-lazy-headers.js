@@ -0,0 +1,97 @@
+'use strict';
+const common = require('../common');
+
+// With `lazyHeaders`, the request headers are delivered as a flat buffer and
+// only turned into strings when they are accessed. The result must be the
+// same as without the option.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+assert.throws(() => http.createServer({ lazyHeaders: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+function request(server, head) {
+  return new Promise((resolve) => {
+    const socket = net.connect(server.address().port, () => {
+      socket.end(head, 'latin1');
+    });
+    let response = '';
+    socket.setEncoding('latin1');
+    socket.on('data', (chunk) => response += chunk);
+    socket.on('end', () => resolve(response));
+  });
+}
+
+const head = 'GET /lazy HTTP/1.1\r\n' +
+             'Host: localhost\r\n' +
+             'USER-AGENT: test \t\r\n' +
+             'X-Custom: caf\xe9\r\n' +
+             'x-custom: second\r\n' +
+             'Cookie: a=1\r\n' +
+             'Cookie: b=2\r\n' +
+             'Connection: close\r\n\r\n';
+
+const expectedRawHeaders = [
+  'Host', 'localhost',
+  'USER-AGENT', 'test',
+  'X-Custom', 'caf\xe9',
+  'x-custom', 'second',
+  'Cookie', 'a=1',
+  'Cookie', 'b=2',
+  'Connection', 'close',
+];
+
+(async () => {
+  for (const lazyHeaders of [false, true]) {
+    const server = http.createServer({ lazyHeaders }, common.mustCall((req, res) => {
+      if (req.url === '/host') {
+        assert.strictEqual(req.headers.host, 'x');
+        return res.end();
+      }
+      assert.strictEqual(req.url, '/lazy');
+      assert.deepStrictEqual(req.rawHeaders, expectedRawHeaders);
+      assert.deepStrictEqual(req.headers, {
+        'host': 'localhost',
+        'user-agent': 'test',
+        'x-custom': 'caf\xe9, second',
+        'cookie': 'a=1; b=2',
+        'connection': 'close',
+      });
+      assert.deepStrictEqual(req.headersDistinct['x-custom'],
+                             ['caf\xe9', 'second']);
+      res.end('ok');
+    }, 2));
+    await new Promise((resolve) => server.listen(0, resolve));
+
+    assert.match(await request(server, head), /^HTTP\/1\.1 200 OK/);
+
+    // The Host header is still required.
+    assert.match(await request(server, 'GET / HTTP/1.1\r\n\r\n'),
+                 /^HTTP\/1\.1 400 Bad Request/);
+    assert.match(await request(server, 'GET /host HTTP/1.1\r\n' +
+                                       'hOsT: x\r\n\r\n'),
+                 /^HTTP\/1\.1 200 OK/);
+
+    // And so is a valid Expect header.
+    assert.match(await request(server, 'GET / HTTP/1.1\r\n' +
+                                       'Host: x\r\n' +
+                                       'Expect: nothing\r\n\r\n'),
+                 /^HTTP\/1\.1 417 Expectation Failed/);
+
+    server.close();
+  }
+
+  // maxHeadersCount applies to `headers`, but not to `rawHeaders`.
+  const server = http.createServer({ lazyHeaders: true }, common.mustCall((req, res) => {
+    assert.deepStrictEqual(req.headers, { 'host': 'localhost', 'user-agent': 'test' });
+    assert.deepStrictEqual(req.rawHeaders, expectedRawHeaders);
+    res.end();
+  }));
+  server.maxHeadersCount = 2;
+  await new Promise((resolve) => server.listen(0, resolve));
+  assert.match(await request(server, head), /^HTTP\/1\.1 200 OK/);
+  server.close();
+})().then(common.mustCall());
@@ -0,0 +1,63 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With autoWindowTuning, the session measures the bandwidth-delay product of
+// the connection with PING frames of its own while DATA is received. Check
+// that the data arrives intact, that the estimate is reported, and that the
+// PINGs don't get in the way of the ones sent with http2session.ping().
+
+const assert = require('assert');
+const http2 = require('http2');
+
+const kSize = 8 * 1024 * 1024;
+const body = Buffer.alloc(kSize, 'abcdefghij');
+
+function test(autoWindowTuning) {
+  return new Promise((resolve) => {
+    const server = http2.createServer();
+    server.on('stream', common.mustCall((stream) => {
+      stream.respond();
+      stream.end(body);
+    }));
+
+    server.listen(0, common.mustCall(() => {
+      const client = http2.connect(`http://localhost:${server.address().port}`,
+                                   { autoWindowTuning });
+      const req = client.request();
+      const chunks = [];
+      let pinged = false;
+      req.on('data', (chunk) => {
+        chunks.push(chunk);
+        if (!pinged) {
+          pinged = true;
+          client.ping(common.mustSucceed((duration) => {
+            assert.strictEqual(typeof duration, 'number');
+          }));
+        }
+      });
+      req.on('end', common.mustCall(() => {
+        assert.ok(Buffer.concat(chunks).equals(body));
+        const { bdpEstimate, bdpRtt } = client.state;
+        if (autoWindowTuning) {
+          assert.ok(bdpEstimate >= 65535, `${bdpEstimate}`);
+          assert.ok(bdpEstimate <= 16 * 1024 * 1024, `${bdpEstimate}`);
+          assert.ok(bdpRtt > 0, `${bdpRtt}`);
+        } else {
+          assert.strictEqual(bdpEstimate, 0);
+          assert.strictEqual(bdpRtt, 0);
+        }
+        client.close();
+        server.close(resolve);
+      }));
+      req.end();
+    }));
+  });
+}
+
+(async () => {
+  await test(false);
+  await test(true);
+})().then(common.mustCall());
@@ -0,0 +1,60 @@
+'use strict';
+
+// Files are read ahead of the consumer when they are served from an offset.
+// Check that large responses arrive complete and in order, with and without
+// an explicit range, and while the client applies backpressure.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const http2 = require('http2');
+const assert = require('assert');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+// Not a multiple of the chunk size, so that the last read is a short one.
+const data = Buffer.alloc(1024 * 1024 + 1234);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 7 + (i >> 16)) & 0xff;
+const fname = tmpdir.resolve('read-ahead.bin');
+fs.writeFileSync(fname, data);
+
+const ranges = [
+  { offset: 0, length: undefined },
+  { offset: 100, length: 300 * 1024 },
+  { offset: 65536 * 3 + 5, length: undefined },
+];
+
+const server = http2.createServer();
+server.on('stream', (stream, headers) => {
+  const { offset, length } = ranges[+headers[':path'].slice(1)];
+  stream.respondWithFile(fname, {}, { offset, length });
+});
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let remaining = ranges.length;
+  ranges.forEach(({ offset, length }, i) => {
+    const req = client.request({ ':path': `/${i}` });
+    const chunks = [];
+    req.on('data', (chunk) => {
+      chunks.push(chunk);
+      // Pause now and then so that reads complete while not reading.
+      if (chunks.length % 4 === 0) {
+        req.pause();
+        setTimeout(() => req.resume(), 1);
+      }
+    });
+    req.on('end', common.mustCall(() => {
+      const end = length === undefined ? data.length : offset + length;
+      assert.deepStrictEqual(Buffer.concat(chunks), data.subarray(offset, end));
+      if (--remaining === 0) {
+        client.close();
+        server.close();
+      }
+    }));
+    req.end();
+  });
+}));
@@ -37,6 +37,7 @@ function onStream(stream, headers, flags) {
     assert.strictEqual(typeof state.outboundQueueSize, 'number');
     assert.strictEqual(typeof state.deflateDynamicTableSize, 'number');
     assert.strictEqual(typeof state.inflateDynamicTableSize, 'number');
+    assert.strictEqual(state.bdpEstimate, 0);
   }
 
   stream.respond({
@@ -84,6 +85,8 @@ server.on('listening', common.mustCall(() => {
       assert.strictEqual(typeof state.outboundQueueSize, 'number');
       assert.strictEqual(typeof state.deflateDynamicTableSize, 'number');
       assert.strictEqual(typeof state.inflateDynamicTableSize, 'number');
+      assert.strictEqual(state.bdpEstimate, 0);
+    assert.strictEqual(state.bdpEstimate, 0);
     }
   }));
 
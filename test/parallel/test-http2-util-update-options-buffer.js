@@ -26,7 +26,9 @@ const IDX_OPTIONS_MAX_SETTINGS = 9;
 const IDX_OPTIONS_STREAM_RESET_RATE = 10;
 const IDX_OPTIONS_STREAM_RESET_BURST = 11;
 const IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION = 12;
-const IDX_OPTIONS_FLAGS = 13;
+const IDX_OPTIONS_WRITE_COALESCING_THRESHOLD = 13;
+const IDX_OPTIONS_AUTO_WINDOW_TUNING = 14;
+const IDX_OPTIONS_FLAGS = 15;
 
 {
   updateOptionsBuffer({
@@ -42,7 +44,9 @@ const IDX_OPTIONS_FLAGS = 13;
     maxSettings: 10,
     streamResetRate: 11,
     streamResetBurst: 12,
-    strictFieldWhitespaceValidation: false
+    strictFieldWhitespaceValidation: false,
+    writeCoalescingThreshold: 13,
+    autoWindowTuning: true,
   });
 
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE], 1);
@@ -58,6 +62,8 @@ const IDX_OPTIONS_FLAGS = 13;
   strictEqual(optionsBuffer[IDX_OPTIONS_STREAM_RESET_RATE], 11);
   strictEqual(optionsBuffer[IDX_OPTIONS_STREAM_RESET_BURST], 12);
   strictEqual(optionsBuffer[IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION], 1);
+  strictEqual(optionsBuffer[IDX_OPTIONS_WRITE_COALESCING_THRESHOLD], 13);
+  strictEqual(optionsBuffer[IDX_OPTIONS_AUTO_WINDOW_TUNING], 1);
 
   const flags = optionsBuffer[IDX_OPTIONS_FLAGS];
 
@@ -73,6 +79,8 @@ const IDX_OPTIONS_FLAGS = 13;
   ok(flags & (1 << IDX_OPTIONS_STREAM_RESET_RATE));
   ok(flags & (1 << IDX_OPTIONS_STREAM_RESET_BURST));
   ok(flags & (1 << IDX_OPTIONS_STRICT_HTTP_FIELD_WHITESPACE_VALIDATION));
+  ok(flags & (1 << IDX_OPTIONS_WRITE_COALESCING_THRESHOLD));
+  ok(flags & (1 << IDX_OPTIONS_AUTO_WINDOW_TUNING));
 }
 
 {
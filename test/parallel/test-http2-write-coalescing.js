@@ -0,0 +1,61 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Small DATA frames from many concurrent streams are copied into the
+// session's buffer and written together. Check that the payloads arrive
+// intact and in order, with and without coalescing.
+
+const assert = require('assert');
+const http2 = require('http2');
+
+const kStreams = 50;
+const kChunks = 20;
+
+function chunk(stream, i) {
+  return `${stream}:${i}:${'x'.repeat(i * 97 % 1500)};`;
+}
+
+function test(writeCoalescingThreshold) {
+  return new Promise((resolve) => {
+    const server = http2.createServer({ writeCoalescingThreshold });
+    server.on('stream', common.mustCall((stream, headers) => {
+      const id = headers[':path'].slice(1);
+      stream.respond();
+      for (let i = 0; i < kChunks; i++)
+        stream.write(chunk(id, i), common.mustSucceed());
+      stream.end();
+    }, kStreams));
+
+    server.listen(0, common.mustCall(() => {
+      const client = http2.connect(`http://localhost:${server.address().port}`,
+                                   { writeCoalescingThreshold });
+      let pending = kStreams;
+      for (let n = 0; n < kStreams; n++) {
+        const req = client.request({ ':path': `/${n}` });
+        let data = '';
+        req.setEncoding('utf8');
+        req.on('data', (chunk) => data += chunk);
+        req.on('end', common.mustCall(() => {
+          let expected = '';
+          for (let i = 0; i < kChunks; i++)
+            expected += chunk(n, i);
+          assert.strictEqual(data, expected);
+          if (--pending === 0) {
+            client.close();
+            server.close(resolve);
+          }
+        }));
+        req.end();
+      }
+    }));
+  });
+}
+
+(async () => {
+  await test(undefined);
+  await test(0);
+  await test(64 * 1024);
+})().then(common.mustCall());
@@ -88,3 +88,30 @@ assert.deepStrictEqual(
 {
   buffer.transcode(new buffer.Buffer.allocUnsafeSlow(1), 'utf16le', 'ucs2');
 }
+
+// Conversions that don't need substitutions, and the same conversions of
+// input that needs them.
+{
+  const latin1 = Buffer.from('hä ÿ', 'latin1');
+  const utf8 = Buffer.from('hä ÿ', 'utf8');
+  const ucs2 = Buffer.from('hä ÿ', 'ucs2');
+  assert.deepStrictEqual(buffer.transcode(latin1, 'latin1', 'utf8'), utf8);
+  assert.deepStrictEqual(buffer.transcode(utf8, 'utf8', 'latin1'), latin1);
+  assert.deepStrictEqual(buffer.transcode(ucs2, 'ucs2', 'latin1'), latin1);
+  assert.deepStrictEqual(buffer.transcode(latin1, 'latin1', 'latin1'), latin1);
+  assert.deepStrictEqual(buffer.transcode(utf8, 'utf8', 'utf8'), utf8);
+  assert.deepStrictEqual(buffer.transcode(ucs2, 'ucs2', 'ucs2'), ucs2);
+
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from('hä€', 'ucs2'), 'ucs2', 'latin1'),
+    Buffer.from('hä?', 'latin1'));
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from('hä', 'ucs2'), 'ucs2', 'ascii'),
+    Buffer.from('h?'));
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from('hä', 'latin1'), 'latin1', 'ascii'),
+    Buffer.from('h?'));
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from('hi'), 'utf8', 'ascii'),
+    Buffer.from('hi'));
+}
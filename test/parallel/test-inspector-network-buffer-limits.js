@@ -0,0 +1,142 @@
+// Flags: --inspect=0 --experimental-network-inspection
+'use strict';
+const common = require('../common');
+
+common.skipIfInspectorDisabled();
+
+const inspector = require('node:inspector/promises');
+const { Network } = require('node:inspector');
+const test = require('node:test');
+const assert = require('node:assert');
+const { setTimeout } = require('node:timers/promises');
+
+const session = new inspector.Session();
+session.connect();
+
+function requestWillBeSent(requestId) {
+  Network.requestWillBeSent({
+    requestId,
+    timestamp: 1,
+    wallTime: 1,
+    request: {
+      url: 'https://example.com',
+      method: 'GET',
+      headers: {},
+    },
+  });
+}
+
+function dataReceived(requestId, data) {
+  Network.dataReceived({
+    requestId,
+    timestamp: 2,
+    dataLength: data.byteLength,
+    encodedDataLength: data.byteLength,
+    data,
+  });
+}
+
+function loadingFinished(requestId) {
+  Network.loadingFinished({
+    requestId,
+    timestamp: 3,
+  });
+}
+
+async function streamResourceContent(requestId) {
+  const { bufferedData } = await session.post('Network.streamResourceContent', {
+    requestId,
+  });
+  return Buffer.from(bufferedData, 'base64').toString();
+}
+
+test('should reject invalid parameters', async () => {
+  await assert.rejects(session.post('Network.enable', { sampleInterval: 0 }), {
+    code: 'ERR_INSPECTOR_COMMAND',
+  });
+  await assert.rejects(session.post('Network.enable', { maxTotalBufferSize: -1 }), {
+    code: 'ERR_INSPECTOR_COMMAND',
+  });
+});
+
+test('should only track one in every sampleInterval requests', async () => {
+  session.removeAllListeners();
+  await session.post('Network.enable', { sampleInterval: 3 });
+
+  const requested = [];
+  const finished = [];
+  session.on('Network.requestWillBeSent', ({ params }) => requested.push(params.requestId));
+  session.on('Network.loadingFinished', ({ params }) => finished.push(params.requestId));
+  for (let i = 0; i < 7; i++) {
+    requestWillBeSent(`sampled-${i}`);
+    loadingFinished(`sampled-${i}`);
+  }
+  await setTimeout(1);
+
+  assert.deepStrictEqual(requested, ['sampled-0', 'sampled-3', 'sampled-6']);
+  assert.deepStrictEqual(finished, requested);
+  await assert.rejects(streamResourceContent('sampled-1'), {
+    code: 'ERR_INSPECTOR_COMMAND',
+  });
+  await session.post('Network.disable');
+});
+
+test('should drop a response body larger than maxResourceBufferSize', async () => {
+  session.removeAllListeners();
+  await session.post('Network.enable', { maxResourceBufferSize: 8 });
+
+  requestWillBeSent('small');
+  dataReceived('small', Buffer.from('12345678'));
+  loadingFinished('small');
+  requestWillBeSent('large');
+  dataReceived('large', Buffer.from('12345'));
+  dataReceived('large', Buffer.from('6789'));
+  loadingFinished('large');
+
+  assert.strictEqual(await streamResourceContent('small'), '12345678');
+  await assert.rejects(streamResourceContent('large'), {
+    code: 'ERR_INSPECTOR_COMMAND',
+  });
+  await session.post('Network.disable');
+});
+
+test('should drop the oldest response bodies beyond maxTotalBufferSize', async () => {
+  session.removeAllListeners();
+  await session.post('Network.enable', { maxTotalBufferSize: 10 });
+
+  requestWillBeSent('first');
+  dataReceived('first', Buffer.from('first'));
+  loadingFinished('first');
+  requestWillBeSent('second');
+  dataReceived('second', Buffer.from('second'));
+  loadingFinished('second');
+
+  await assert.rejects(streamResourceContent('first'), {
+    code: 'ERR_INSPECTOR_COMMAND',
+  });
+  assert.strictEqual(await streamResourceContent('second'), 'second');
+  await session.post('Network.disable');
+});
+
+test('should batch the streamed data of an event loop iteration', async () => {
+  session.removeAllListeners();
+  await session.post('Network.enable');
+
+  const events = [];
+  session.on('Network.dataReceived', ({ params }) => events.push(params));
+  requestWillBeSent('streamed');
+  assert.strictEqual(await streamResourceContent('streamed'), '');
+  dataReceived('streamed', Buffer.from('Hello, '));
+  dataReceived('streamed', Buffer.from('world'));
+  await setTimeout(1);
+  dataReceived('streamed', Buffer.from('!'));
+  loadingFinished('streamed');
+  await setTimeout(1);
+
+  assert.strictEqual(events.length, 2);
+  assert.strictEqual(events[0].dataLength, 12);
+  assert.strictEqual(Buffer.from(events[0].data, 'base64').toString(), 'Hello, world');
+  assert.strictEqual(events[1].dataLength, 1);
+  assert.strictEqual(Buffer.from(events[1].data, 'base64').toString(), '!');
+  await session.post('Network.disable');
+});
@@ -0,0 +1,36 @@
+'use strict';
+require('../common');
+
+// Bindings whose per-isolate templates are created on first use still work
+// in child processes, with and without the built-in snapshot, and in workers
+// after the main thread has loaded them.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const { Worker } = require('worker_threads');
+
+function check(dir, fresh) {
+  const assert = require('assert');
+  if (fresh) {
+    for (const name of ['http_parser', 'fs_dir'])
+      assert(!process.moduleLoadList.includes(`Internal Binding ${name}`));
+  }
+  const { HTTPParser } = require('_http_common');
+  assert.strictEqual(typeof new HTTPParser().initialize, 'function');
+  const handle = require('fs').opendirSync(dir);
+  assert.ok(handle.readSync());
+  handle.closeSync();
+}
+
+const script = `(${check})(${JSON.stringify(__dirname)}, true)`;
+
+for (const args of [[], ['--no-node-snapshot']]) {
+  const child = spawnSync(process.execPath, [...args, '-e', script],
+                          { encoding: 'utf8' });
+  assert.strictEqual(child.stderr, '');
+  assert.strictEqual(child.status, 0);
+}
+
+check(__dirname, false);
+const worker = new Worker(script, { eval: true });
+worker.on('exit', (code) => assert.strictEqual(code, 0));
@@ -0,0 +1,42 @@
+'use strict';
+
+// This tests that --use-largepages-heap advises the reservations of V8 to
+// use transparent huge pages, and that the diagnostic report shows how much
+// of them the kernel backs by huge pages.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { spawnSyncAndAssert } = require('../common/child_process');
+
+const script = 'process.stdout.write(JSON.stringify(' +
+               'process.report.getReport().javascriptHeap))';
+
+function getHugePageCounters(execArgv) {
+  let heap;
+  spawnSyncAndAssert(process.execPath, [...execArgv, '-e', script], {
+    stdout(output) {
+      heap = JSON.parse(output);
+    },
+  });
+  assert(Number.isSafeInteger(heap.hugePageAdvisedMemory));
+  assert(Number.isSafeInteger(heap.hugePageMemory));
+  assert(heap.hugePageMemory <= heap.hugePageAdvisedMemory);
+  return heap;
+}
+
+{
+  const heap = getHugePageCounters([]);
+  assert.strictEqual(heap.hugePageAdvisedMemory, 0);
+  assert.strictEqual(heap.hugePageMemory, 0);
+}
+
+{
+  const heap = getHugePageCounters(['--use-largepages-heap']);
+  if (!common.isLinux ||
+      !fs.existsSync('/sys/kernel/mm/transparent_hugepage')) {
+    assert.strictEqual(heap.hugePageAdvisedMemory, 0);
+  } else {
+    assert(heap.hugePageAdvisedMemory > 0);
+  }
+}
@@ -0,0 +1,40 @@
+// Flags: --experimental-module-stat-cache
+'use strict';
+
+// Tests that module resolution caches missing paths until the stat cache is
+// cleared, and that it counts hits and misses.
+
+require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { clearStatCache, getStatCacheStats } = require('module');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+assert.strictEqual(getStatCacheStats().enabled, true);
+
+const file = tmpdir.resolve('late.js');
+const request = path.join(tmpdir.path, 'late');
+
+assert.throws(() => require(request), { code: 'MODULE_NOT_FOUND' });
+const { misses } = getStatCacheStats();
+assert.ok(misses > 0);
+
+// The file is not seen, the lookups are answered from the cache.
+fs.writeFileSync(file, 'module.exports = 42;');
+assert.throws(() => require(request), { code: 'MODULE_NOT_FOUND' });
+const stats = getStatCacheStats();
+assert.ok(stats.hits > 0);
+assert.strictEqual(stats.misses, misses);
+assert.ok(stats.size > 0);
+
+clearStatCache();
+assert.strictEqual(getStatCacheStats().size, 0);
+assert.strictEqual(require(request), 42);
+
+// Other file system APIs are not affected by the cache.
+fs.unlinkSync(file);
+assert.strictEqual(fs.existsSync(file), false);
+assert.deepStrictEqual(fs.readdirSync(tmpdir.path, { recursive: true }), []);
@@ -0,0 +1,75 @@
+'use strict';
+
+const common = require('../common');
+const { createMockedLookup } = require('../common/dns');
+
+const assert = require('assert');
+const { createConnection, createServer } = require('net');
+
+// The connection attempts of the family autoselection are raced in native
+// code. Check that the attempt events are still reported when listened to,
+// and that destroying the socket stops the race.
+
+const autoSelectFamilyAttemptTimeout = common.defaultAutoSelectFamilyAttemptTimeout;
+
+const server = createServer(common.mustCall((socket) => {
+  socket.end('response');
+}));
+
+server.listen(0, '127.0.0.1', common.mustCall(async () => {
+  const { port } = server.address();
+
+  await new Promise((resolve) => {
+    const connection = createConnection({
+      host: 'example.org',
+      port,
+      lookup: createMockedLookup('::1', '127.0.0.1'),
+      autoSelectFamily: true,
+      autoSelectFamilyAttemptTimeout,
+    });
+
+    const events = [];
+    connection.on('connectionAttempt', (address, attemptPort, family) => {
+      assert.strictEqual(attemptPort, port);
+      events.push(['attempt', address, family]);
+    });
+    connection.on('connectionAttemptFailed', (address, attemptPort, family, error) => {
+      assert.strictEqual(attemptPort, port);
+      assert.strictEqual(error.address, address);
+      events.push(['failed', address, family]);
+    });
+
+    let response = '';
+    connection.setEncoding('utf8');
+    connection.on('data', (chunk) => response += chunk);
+    connection.on('ready', common.mustCall(() => {
+      assert.deepStrictEqual(connection.autoSelectFamilyAttemptedAddresses,
+                             [`::1:${port}`, `127.0.0.1:${port}`]);
+      assert.deepStrictEqual(events, [
+        ['attempt', '::1', 6],
+        ['failed', '::1', 6],
+        ['attempt', '127.0.0.1', 4],
+      ]);
+      assert.strictEqual(connection.remoteAddress, '127.0.0.1');
+    }));
+    connection.on('end', common.mustCall(() => {
+      assert.strictEqual(response, 'response');
+      resolve();
+    }));
+  });
+
+  // Destroying the socket while an attempt is pending stops the race.
+  const connection = createConnection({
+    host: 'example.org',
+    port,
+    lookup: createMockedLookup('::1', '127.0.0.1'),
+    autoSelectFamily: true,
+    autoSelectFamilyAttemptTimeout,
+  });
+  connection.once('connectionAttempt', common.mustCall(() => {
+    connection.destroy();
+  }));
+  connection.on('connect', common.mustNotCall());
+  connection.on('error', common.mustNotCall());
+  connection.on('close', common.mustCall(() => server.close()));
+}));
@@ -0,0 +1,99 @@
+// Flags: --experimental-io-uring-sockets
+'use strict';
+
+// With --experimental-io-uring-sockets, TCP and pipe sockets are read and
+// written through io_uring where it is available, and through libuv where it
+// is not. Either way, the data has to arrive intact and in order, pausing and
+// half-closing have to work, and closing a socket with writes in flight has to
+// fail them instead of leaving them hanging.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const tmpdir = require('../common/tmpdir');
+
+const kSize = 4 * 1024 * 1024;
+const payload = Buffer.alloc(kSize);
+for (let i = 0; i < kSize; i++) payload[i] = i % 251;
+
+function listen(server, pipe) {
+  return new Promise((resolve) => {
+    if (pipe) {
+      tmpdir.refresh();
+      server.listen(common.PIPE, () => resolve(common.PIPE));
+    } else {
+      server.listen(0, () => resolve(server.address().port));
+    }
+  });
+}
+
+// The server echoes everything back and ends its side after the client's
+// end. The client writes in many small chunks so that writes queue up.
+async function echo(pipe) {
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.pipe(socket);
+  }));
+  const address = await listen(server, pipe);
+  const client = net.connect(address);
+  const chunks = [];
+  client.on('data', (chunk) => chunks.push(chunk));
+  for (let offset = 0; offset < kSize; offset += 1000)
+    client.write(payload.subarray(offset, offset + 1000));
+  client.end();
+  await new Promise((resolve) => client.on('end', resolve));
+  assert.ok(Buffer.concat(chunks).equals(payload));
+  client.destroy();
+  server.close();
+}
+
+// Data that arrives while the socket is paused is not lost.
+async function pause() {
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.end(payload);
+  }));
+  const port = await listen(server, false);
+  const client = net.connect(port);
+  const chunks = [];
+  let paused = false;
+  client.on('data', (chunk) => {
+    chunks.push(chunk);
+    if (!paused) {
+      paused = true;
+      client.pause();
+      setTimeout(() => client.resume(), 100);
+    }
+  });
+  await new Promise((resolve) => client.on('end', resolve));
+  assert.ok(Buffer.concat(chunks).equals(payload));
+  server.close();
+}
+
+// Destroying a socket with writes in flight cancels the writes that have
+// not gone out yet.
+async function destroy() {
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.pause();
+    socket.on('error', () => {});
+    socket.on('close', common.mustCall());
+  }));
+  const port = await listen(server, false);
+  const client = net.connect(port);
+  await new Promise((resolve) => client.on('connect', resolve));
+  for (let i = 0; i < 64; i++) {
+    client.write(payload, (err) => {
+      if (err !== undefined && err !== null)
+        assert.strictEqual(err.code, 'ERR_STREAM_DESTROYED');
+    });
+  }
+  client.destroy();
+  await new Promise((resolve) => client.on('close', resolve));
+  server.close();
+}
+
+(async () => {
+  await echo(false);
+  await echo(true);
+  await pause();
+  await destroy();
+})().then(common.mustCall());
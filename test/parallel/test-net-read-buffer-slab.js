@@ -0,0 +1,57 @@
+// Flags: --experimental-stream-read-slabs
+'use strict';
+
+// With --experimental-stream-read-slabs, socket reads are carved out of shared
+// slabs. Make sure that retained chunks of concurrent connections are never
+// overwritten by later reads, and that slab-backed chunks cannot be
+// transferred away.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel } = require('worker_threads');
+
+const sizes = [1, 100, 4096, 4097, 20000, 65536, 100000];
+const connections = 8;
+
+function payload(id, size) {
+  return Buffer.alloc(size, `${id}:${size};`);
+}
+
+const server = net.createServer((socket) => {
+  socket.once('data', common.mustCall((data) => {
+    const id = data.toString();
+    let i = 0;
+    (function writeNext() {
+      if (i === sizes.length) return socket.end();
+      const size = sizes[i++];
+      socket.write(payload(id, size), writeNext);
+    })();
+  }));
+});
+
+server.listen(0, common.mustCall(() => {
+  let pending = connections;
+  for (let id = 0; id < connections; id++) {
+    const chunks = [];
+    const socket = net.connect(server.address().port);
+    socket.write(`${id}`);
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      const expected = Buffer.concat(
+        sizes.map((size) => payload(id, size)));
+      assert.deepStrictEqual(Buffer.concat(chunks), expected);
+
+      const { port1 } = new MessageChannel();
+      for (const chunk of chunks) {
+        if (chunk.byteLength === chunk.buffer.byteLength) continue;
+        assert.throws(() => port1.postMessage(chunk, [chunk.buffer]), {
+          name: 'DataCloneError',
+        });
+      }
+      port1.close();
+
+      if (--pending === 0) server.close();
+    }));
+  }
+}));
@@ -0,0 +1,35 @@
+'use strict';
+
+// By default, every socket read gets an ArrayBuffer of its own, which holds
+// exactly the bytes that were read and can be transferred.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel } = require('worker_threads');
+
+const payload = Buffer.alloc(100000, 'abc');
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.end(payload);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const chunks = [];
+  const socket = net.connect(server.address().port);
+  socket.on('data', (chunk) => {
+    assert.strictEqual(chunk.byteOffset, 0);
+    assert.strictEqual(chunk.buffer.byteLength, chunk.byteLength);
+    chunks.push(Buffer.from(chunk));
+
+    const { port1, port2 } = new MessageChannel();
+    port1.postMessage(chunk, [chunk.buffer]);
+    assert.strictEqual(chunk.byteLength, 0);
+    port1.close();
+    port2.close();
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), payload);
+    server.close();
+  }));
+}));
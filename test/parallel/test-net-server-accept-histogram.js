@@ -0,0 +1,115 @@
+'use strict';
+
+// server.createAcceptHistogram() records the time between consecutive
+// accepted connections of a listening socket, also for worker threads that
+// each accept on their own reusePort socket.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { checkSupportReusePort, options } = require('../common/net');
+const { Worker, isMainThread, parentPort, workerData } =
+  require('worker_threads');
+
+if (!isMainThread) {
+  let connections = 0;
+  let histogram;
+  const server = net.createServer((socket) => {
+    connections++;
+    socket.end();
+  });
+  server.listen({ ...options, port: workerData.port }, () => {
+    histogram = server.createAcceptHistogram();
+    parentPort.postMessage('listening');
+  });
+  parentPort.on('message', () => {
+    parentPort.postMessage({ connections, count: histogram.count });
+    server.close();
+    parentPort.close();
+  });
+  return;
+}
+
+{
+  const server = net.createServer();
+  assert.throws(() => server.createAcceptHistogram(), {
+    code: 'ERR_SERVER_NOT_RUNNING',
+  });
+}
+
+if (!common.isWindows) {
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const server = net.createServer();
+  server.listen(common.PIPE, common.mustCall(() => {
+    assert.throws(() => server.createAcceptHistogram(), {
+      code: 'ERR_INVALID_STATE',
+    });
+    server.close();
+  }));
+}
+
+function connectMany(port, count, cb) {
+  let pending = count;
+  for (let i = 0; i < count; i++) {
+    net.connect(port, common.mustCall(function() {
+      this.resume();
+      this.on('close', common.mustCall(() => {
+        if (--pending === 0) cb();
+      }));
+    }));
+  }
+}
+
+{
+  const server = net.createServer((socket) => socket.end());
+  server.listen(0, common.mustCall(() => {
+    const histogram = server.createAcceptHistogram();
+    const other = server.createAcceptHistogram();
+    assert.strictEqual(histogram.count, 0);
+
+    connectMany(server.address().port, 5, common.mustCall(() => {
+      // The first accepted connection only marks the starting point.
+      assert.strictEqual(histogram.count, 4);
+      assert.strictEqual(other.count, 4);
+      assert.ok(histogram.min > 0);
+      histogram.reset();
+      assert.strictEqual(other.count, 0);
+      server.close();
+    }));
+  }));
+}
+
+checkSupportReusePort().then(common.mustCall(() => {
+  const server = net.createServer();
+  server.listen(options, common.mustCall(() => {
+    const { port } = server.address();
+    server.close();
+
+    const total = 40;
+    const workers = [];
+    let listening = 0;
+    for (let i = 0; i < 2; i++) {
+      const worker = new Worker(__filename, { workerData: { port } });
+      worker.once('message', common.mustCall(() => {
+        if (++listening < 2) return;
+        connectMany(port, total, common.mustCall(() => {
+          let accepted = 0;
+          let reported = 0;
+          for (const worker of workers) {
+            worker.postMessage('done');
+            worker.once('message', common.mustCall(({ connections, count }) => {
+              assert.strictEqual(count, Math.max(connections - 1, 0));
+              accepted += connections;
+              if (++reported === workers.length)
+                assert.strictEqual(accepted, total);
+            }));
+          }
+        }));
+      }));
+      workers.push(worker);
+    }
+  }));
+}), () => {
+  common.printSkipMessage('The `reusePort` option is not supported');
+});
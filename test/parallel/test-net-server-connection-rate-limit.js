@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Connections over the per-address limit are closed before the 'connection'
+// event is emitted.
+{
+  const server = net.createServer({
+    connectionRateLimit: { rate: 0.001, burst: 2 },
+  }, common.mustCall((socket) => socket.end(), 2));
+
+  server.listen(0, common.localhostIPv4, common.mustCall(async () => {
+    const { port } = server.address();
+    const connect = () => new Promise((resolve) => {
+      const socket = net.connect(port, common.localhostIPv4);
+      socket.on('error', () => {});
+      socket.resume();
+      socket.on('close', resolve);
+    });
+    for (let i = 0; i < 3; i++) await connect();
+    server.close();
+  }));
+}
+
+for (const connectionRateLimit of [1, 'a', null]) {
+  assert.throws(() => net.createServer({ connectionRateLimit }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+for (const connectionRateLimit of [
+  {},
+  { rate: '1' },
+  { rate: 1, burst: '1' },
+  { rate: 1, maxAddresses: '1' },
+]) {
+  assert.throws(() => net.createServer({ connectionRateLimit }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+for (const connectionRateLimit of [
+  { rate: 0 },
+  { rate: -1 },
+  { rate: Infinity },
+  { rate: 1, burst: 0.5 },
+  { rate: 1, maxAddresses: 0 },
+  { rate: 1, maxAddresses: 1.5 },
+]) {
+  assert.throws(() => net.createServer({ connectionRateLimit }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+}
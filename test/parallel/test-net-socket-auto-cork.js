@@ -0,0 +1,76 @@
+'use strict';
+
+// With autoCork, writes issued within one tick reach the handle as a single
+// writev, unless the buffered data reaches the high-water mark first.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+assert.throws(() => new net.Socket({ autoCork: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+function countWrites(socket) {
+  const calls = [];
+  const handle = socket._handle;
+  for (const method of ['writev', 'writeBuffer', 'writeUtf8String']) {
+    const original = handle[method];
+    handle[method] = function(...args) {
+      calls.push(method);
+      return original.apply(this, args);
+    };
+  }
+  return calls;
+}
+
+const server = net.createServer({ autoCork: true }, common.mustCall((socket) => {
+  assert.strictEqual(socket.writableCorked, 0);
+  const calls = countWrites(socket);
+
+  socket.write('a');
+  socket.write('b');
+  socket.write(Buffer.from('c'));
+  assert.strictEqual(socket.writableCorked, 1);
+  assert.deepStrictEqual(calls, []);
+
+  process.nextTick(common.mustCall(() => {
+    assert.strictEqual(socket.writableCorked, 0);
+    assert.deepStrictEqual(calls, ['writev']);
+
+    // Corking by hand is left alone.
+    socket.cork();
+    socket.write('d');
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(socket.writableCorked, 1);
+      assert.deepStrictEqual(calls, ['writev']);
+      socket.uncork();
+      socket.end();
+    }));
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect({
+    port: server.address().port,
+    autoCork: true,
+    writableHighWaterMark: 4,
+  }, common.mustCall(() => {
+    const calls = countWrites(client);
+    client.write('ab');
+    assert.strictEqual(client.writableCorked, 1);
+    // Reaching the high-water mark flushes right away.
+    assert.strictEqual(client.write('cd'), false);
+    assert.strictEqual(client.writableCorked, 0);
+    assert.deepStrictEqual(calls, ['writev']);
+    client.end();
+  }));
+
+  let received = '';
+  client.setEncoding('utf8');
+  client.on('data', (chunk) => received += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, 'abcd');
+    server.close();
+  }));
+}));
@@ -0,0 +1,66 @@
+// Flags: --expose_externalize_string
+'use strict';
+
+// Corked writes of external strings are written directly from the string
+// memory. Check that the bytes that arrive match what copying them would
+// have produced, for every encoding that can take this path and for ones
+// that cannot.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const {
+  createExternalizableString,
+  createExternalizableTwoByteString,
+  externalizeString,
+} = globalThis;
+
+common.allowGlobals(
+  createExternalizableString,
+  createExternalizableTwoByteString,
+  externalizeString,
+  globalThis.x,
+);
+
+function external(create, str) {
+  // Must be unique strings to be externalizable.
+  const result = create(`${str} ${Math.random()}`.repeat(10000));
+  externalizeString(result);
+  return result;
+}
+
+const chunks = [
+  [external(createExternalizableString, 'ascii as utf8'), 'utf8'],
+  [external(createExternalizableString, 'latin1 ümlaut'), 'latin1'],
+  [external(createExternalizableString, 'ascii as ascii'), 'ascii'],
+  // Not pure ASCII, so it has to be converted to UTF-8.
+  [external(createExternalizableString, 'ümlaut as utf8'), 'utf8'],
+  [external(createExternalizableTwoByteString, 'two byte € ucs2'), 'ucs2'],
+  [external(createExternalizableTwoByteString, 'two byte € utf8'), 'utf8'],
+  [Buffer.from('a buffer in between'), undefined],
+  ['a heap string', 'utf8'],
+];
+
+const expected = Buffer.concat(chunks.map(([chunk, encoding]) => {
+  return Buffer.isBuffer(chunk) ? chunk : Buffer.from(chunk, encoding);
+}));
+
+const server = net.createServer(common.mustCall((socket) => {
+  const received = [];
+  socket.on('data', (data) => received.push(data));
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(received), expected);
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.cork();
+    for (const [chunk, encoding] of chunks)
+      client.write(chunk, encoding);
+    client.uncork();
+    client.end();
+  }));
+}));
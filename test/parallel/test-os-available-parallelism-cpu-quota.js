@@ -0,0 +1,53 @@
+'use strict';
+require('../common');
+
+// This test checks that --experimental-cpu-quota-aware only ever lowers
+// os.availableParallelism() and sizes the libuv threadpool from it.
+
+const assert = require('assert');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const os = require('os');
+
+const script = 'console.log(JSON.stringify({' +
+  'parallelism: require("os").availableParallelism(),' +
+  'threadpool: process.env.UV_THREADPOOL_SIZE }))';
+const env = { ...process.env };
+delete env.UV_THREADPOOL_SIZE;
+
+spawnSyncAndAssert(
+  process.execPath,
+  ['--experimental-cpu-quota-aware', '-e', script],
+  { env },
+  {
+    stdout(output) {
+      const { parallelism, threadpool } = JSON.parse(output);
+      assert.ok(Number.isInteger(parallelism));
+      assert.ok(parallelism >= 1);
+      assert.ok(parallelism <= os.availableParallelism());
+      assert.strictEqual(threadpool, `${Math.max(parallelism, 4)}`);
+    },
+  });
+
+// An explicit threadpool size is kept.
+spawnSyncAndAssert(
+  process.execPath,
+  ['--experimental-cpu-quota-aware', '-e', script],
+  { env: { ...env, UV_THREADPOOL_SIZE: '7' } },
+  {
+    stdout(output) {
+      assert.strictEqual(JSON.parse(output).threadpool, '7');
+    },
+  });
+
+// Without the flag nothing changes.
+spawnSyncAndAssert(
+  process.execPath,
+  ['-e', script],
+  { env },
+  {
+    stdout(output) {
+      const { parallelism, threadpool } = JSON.parse(output);
+      assert.strictEqual(parallelism, os.availableParallelism());
+      assert.strictEqual(threadpool, undefined);
+    },
+  });
@@ -98,3 +98,17 @@ assert.strictEqual(
   '../../../../baz'
 );
 assert.strictEqual(path.posix.normalize('foo/bar\\baz'), 'foo/bar\\baz');
+
+// Paths that are already normalized are returned as is.
+assert.strictEqual(path.win32.normalize('C:\\foo\\bar'), 'C:\\foo\\bar');
+assert.strictEqual(path.win32.normalize('C:\\foo\\'), 'C:\\foo\\');
+assert.strictEqual(path.win32.normalize('C:\\foo/bar'), 'C:\\foo\\bar');
+assert.strictEqual(path.win32.normalize('C:\\foo\\\\bar'), 'C:\\foo\\bar');
+assert.strictEqual(path.win32.normalize('C:\\foo\\..'), 'C:\\');
+assert.strictEqual(path.posix.normalize('/foo/bar'), '/foo/bar');
+assert.strictEqual(path.posix.normalize('foo/bar/'), 'foo/bar/');
+assert.strictEqual(path.posix.normalize('/'), '/');
+assert.strictEqual(path.posix.normalize('//'), '/');
+assert.strictEqual(path.posix.normalize('/foo//bar'), '/foo/bar');
+assert.strictEqual(path.posix.normalize('foo/.'), 'foo');
+assert.strictEqual(path.posix.normalize('/foo/bär'), '/foo/bär');
@@ -37,6 +37,9 @@ const resolveTests = [
       'C:\\foo\\tmp.3\\cycles\\root.js'],
      [['\\\\.\\PHYSICALDRIVE0'], '\\\\.\\PHYSICALDRIVE0'],
      [['\\\\?\\PHYSICALDRIVE0'], '\\\\?\\PHYSICALDRIVE0'],
+     [['C:\\foo\\bar'], 'C:\\foo\\bar'],
+     [['C:\\foo', 'bar\\'], 'C:\\foo\\bar'],
+     [['C:\\foo\\', 'bar'], 'C:\\foo\\bar'],
     ],
   ],
   [ path.posix.resolve,
@@ -48,6 +51,9 @@ const resolveTests = [
      [[''], posixyCwd],
      [['.'], posixyCwd],
      [['/some/dir', '.', '/absolute/'], '/absolute'],
+     [['/foo/bar'], '/foo/bar'],
+     [['/foo', 'bar/'], '/foo/bar'],
+     [['/foo/', 'bar'], '/foo/bar'],
      [['/foo/tmp.3/', '../tmp.3/cycles/root.js'], '/foo/tmp.3/cycles/root.js'],
     ],
   ],
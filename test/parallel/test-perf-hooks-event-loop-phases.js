@@ -0,0 +1,43 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const {
+  createEventLoopPhaseHistograms,
+  eventLoopCallbackCounts,
+} = require('perf_hooks');
+const fs = require('fs');
+
+// Nothing is counted before the phases are recorded.
+assert.deepStrictEqual(eventLoopCallbackCounts(), {});
+
+const phases = createEventLoopPhaseHistograms();
+assert.deepStrictEqual(Object.keys(phases),
+                       ['timers', 'poll', 'check', 'microtasks']);
+for (const histogram of Object.values(phases))
+  assert.strictEqual(histogram.count, 0);
+
+setTimeout(common.mustCall(() => {
+  const start = Date.now();
+  while (Date.now() - start < 20);
+
+  setImmediate(common.mustCall(() => {
+    fs.stat(__filename, common.mustSucceed(() => {
+      setImmediate(common.mustCall(() => {
+        // All the histograms of a phase observe the same data.
+        const { timers } = createEventLoopPhaseHistograms();
+        assert.strictEqual(timers.count, phases.timers.count);
+        assert(phases.timers.count >= 1);
+        assert(phases.timers.max >= 20e6, `${phases.timers.max} < 20e6`);
+        assert(phases.check.count >= 2);
+        assert(phases.poll.count >= 1);
+        assert(phases.microtasks.count >= 1);
+
+        const counts = eventLoopCallbackCounts();
+        assert(counts.FSREQCALLBACK >= 1, JSON.stringify(counts));
+        for (const count of Object.values(counts))
+          assert(count > 0);
+      }));
+    }));
+  }));
+}), 1);
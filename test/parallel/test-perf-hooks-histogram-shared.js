@@ -0,0 +1,77 @@
+'use strict';
+
+const common = require('../common');
+const { deepStrictEqual, strictEqual, throws } = require('assert');
+const { createHistogram } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+// Test that a shared histogram can be recorded into by many workers at the
+// same time, and that snapshots with reset do not lose any value.
+
+{
+  for (const shared of ['true', 1, null]) {
+    throws(() => createHistogram({ shared }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  const histogram = createHistogram();
+  for (const reset of ['true', 1, null]) {
+    throws(() => histogram.snapshot({ reset }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+}
+
+for (const shared of [false, true]) {
+  const histogram = createHistogram({ shared });
+  histogram.record(1);
+  histogram.record(100);
+
+  const snapshot = histogram.snapshot();
+  strictEqual(snapshot.count, 2);
+  strictEqual(snapshot.min, 1);
+  strictEqual(snapshot.max, 100);
+  deepStrictEqual(snapshot.percentiles, histogram.percentiles);
+
+  // The snapshot is a copy.
+  snapshot.record(1000);
+  strictEqual(snapshot.count, 3);
+  strictEqual(histogram.count, 2);
+
+  strictEqual(histogram.snapshot({ reset: true }).count, 2);
+  strictEqual(histogram.count, 0);
+  strictEqual(histogram.max, 0);
+
+  histogram.record(5);
+  histogram.add(snapshot);
+  strictEqual(histogram.count, 4);
+  histogram.reset();
+  strictEqual(histogram.count, 0);
+}
+
+{
+  const kWorkers = 4;
+  const kValues = 10000;
+  const histogram = createHistogram({ shared: true });
+  let recorded = 0;
+  let running = kWorkers;
+
+  const interval = setInterval(() => {
+    recorded += histogram.snapshot({ reset: true }).count;
+  }, 1);
+
+  for (let i = 0; i < kWorkers; i++) {
+    const worker = new Worker(`
+      const { workerData: { histogram, count } } =
+        require('worker_threads');
+      for (let i = 1; i <= count; i++) histogram.record(i);
+    `, { eval: true, workerData: { histogram, count: kValues } });
+    worker.on('exit', common.mustCall(() => {
+      if (--running > 0) return;
+      clearInterval(interval);
+      const rest = histogram.snapshot({ reset: true });
+      strictEqual(recorded + rest.count, kWorkers * kValues);
+      strictEqual(histogram.count, 0);
+    }));
+  }
+}
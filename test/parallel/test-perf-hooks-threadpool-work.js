@@ -0,0 +1,69 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { createThreadPoolWorkHistograms } = require('perf_hooks');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const zlib = require('zlib');
+
+if (process.argv[2] === 'child') {
+  // With one compression at a time, all but the first have to wait for the
+  // ones before them.
+  const histograms = createThreadPoolWorkHistograms();
+  const input = Buffer.alloc(1024 * 1024, 'x');
+  let pending = 4;
+  for (let i = 0; i < 4; i++) {
+    zlib.gzip(input, common.mustSucceed(() => {
+      if (--pending > 0) return;
+      const { queueWait, runTime } = histograms.compression;
+      assert.strictEqual(runTime.count, 4);
+      assert.strictEqual(queueWait.count, 4);
+      assert(queueWait.max >= runTime.min,
+             `${queueWait.max} < ${runTime.min}`);
+    }));
+  }
+  return;
+}
+
+{
+  const histograms = createThreadPoolWorkHistograms();
+  assert.deepStrictEqual(Object.keys(histograms),
+                         ['fs', 'crypto', 'compression', 'addon', 'addon-io',
+                          'addon-cpu', 'other']);
+  for (const { queueWait, runTime } of Object.values(histograms)) {
+    assert.strictEqual(queueWait.count, 0);
+    assert.strictEqual(runTime.count, 0);
+  }
+
+  zlib.deflate('hello', common.mustSucceed(() => {
+    // All the histograms of a class observe the same data.
+    const { queueWait, runTime } =
+      createThreadPoolWorkHistograms().compression;
+    assert.strictEqual(histograms.compression.runTime.count, 1);
+    assert.strictEqual(runTime.count, 1);
+    assert.strictEqual(queueWait.count, 1);
+    assert.strictEqual(histograms.fs.runTime.count, 0);
+  }));
+}
+
+spawnSyncAndAssert(process.execPath, [
+  '--threadpool-work-limit=compression=1',
+  __filename,
+  'child',
+], {});
+
+spawnSyncAndAssert(process.execPath, [
+  '--threadpool-work-limit=network=1',
+  '-e', '',
+], {
+  status: 9,
+  stderr: /invalid value for --threadpool-work-limit: network=1/,
+});
+
+spawnSyncAndAssert(process.execPath, [
+  '--threadpool-work-limit=compression=0',
+  '-e', '',
+], {
+  status: 9,
+  stderr: /invalid value for --threadpool-work-limit: compression=0/,
+});
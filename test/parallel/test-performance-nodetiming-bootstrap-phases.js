@@ -0,0 +1,44 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+const { Worker, isMainThread } = require('worker_threads');
+
+const phases = [
+  'optionParsing',
+  'icuInitialization',
+  'v8Initialization',
+  'snapshotDeserialization',
+  'bindingInitialization',
+  'builtinCompilation',
+  'userModuleLoading',
+];
+
+const { bootstrapPhases } = performance.nodeTiming;
+assert.deepStrictEqual(Object.keys(bootstrapPhases), phases);
+for (const phase of phases) {
+  assert.strictEqual(typeof bootstrapPhases[phase], 'number');
+  assert(bootstrapPhases[phase] >= 0, `${phase}: ${bootstrapPhases[phase]}`);
+}
+
+// The entry point is still being evaluated.
+assert.strictEqual(bootstrapPhases.userModuleLoading, 0);
+
+if (isMainThread) {
+  assert(bootstrapPhases.optionParsing > 0);
+  assert(bootstrapPhases.v8Initialization > 0);
+
+  setImmediate(common.mustCall(() => {
+    assert(performance.nodeTiming.bootstrapPhases.userModuleLoading > 0);
+  }));
+
+  const worker = new Worker(__filename);
+  worker.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+  }));
+} else {
+  assert.strictEqual(bootstrapPhases.optionParsing, 0);
+  assert.strictEqual(bootstrapPhases.icuInitialization, 0);
+  assert.strictEqual(bootstrapPhases.v8Initialization, 0);
+}
@@ -0,0 +1,53 @@
+// Flags: --permission --allow-fs-read=* --allow-child-process
+'use strict';
+
+const common = require('../common');
+const { isMainThread } = require('worker_threads');
+
+if (!isMainThread) {
+  common.skip('This test only works on a main thread');
+}
+if (common.isWindows) {
+  common.skip('Decisions are only cached for POSIX paths');
+}
+
+// Repeated permission checks may be answered from a cache of recent
+// decisions. Make sure that the cached answers match the uncached ones.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const { status, stderr } = spawnSync(
+  process.execPath,
+  [
+    '--permission',
+    '--allow-fs-read=/granted/*',
+    '--allow-fs-read=/files/index.js',
+    '--allow-fs-write=/files/index.json',
+    '-e',
+    `
+      const assert = require('assert');
+      const paths = {
+        '/granted': true,
+        '/granted/a/b/c': true,
+        '/granted/../files/index.js': true,
+        '/grante': false,
+        '/files/index.js': true,
+        '/files/index.json': false,
+        '/files/../granted/x': true,
+        '/files/../denied/x': false,
+      };
+      for (let i = 0; i < 1000; i++) {
+        for (const [path, granted] of Object.entries(paths)) {
+          assert.strictEqual(process.permission.has('fs.read', path), granted,
+                             path);
+          assert.strictEqual(process.permission.has('fs.write', path),
+                             path === '/files/index.json', path);
+        }
+        assert.ok(!process.permission.has('fs.read', \`/denied/\${i}\`));
+        assert.ok(process.permission.has('fs.read', \`/granted/\${i}\`));
+      }
+    `,
+  ]
+);
+assert.strictEqual(status, 0, stderr.toString());
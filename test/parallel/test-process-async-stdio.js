@@ -0,0 +1,69 @@
+'use strict';
+const common = require('../common');
+
+// Tests --experimental-async-stdio with stdout and stderr connected to pipes.
+
+const assert = require('assert');
+const { spawn, spawnSync } = require('child_process');
+
+const lines = 20000;
+const script = `
+  for (let i = 0; i < ${lines}; i++) console.log('line %d', i);
+  console.error('done');
+`;
+
+// Everything is written, in order, in block mode.
+for (const args of [['--experimental-async-stdio=block'],
+                    ['--experimental-async-stdio=block',
+                     '--experimental-async-stdio-buffer-size=7']]) {
+  const child = spawnSync(process.execPath, [...args, '-e', script],
+                          { encoding: 'utf8', maxBuffer: Infinity });
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stderr, 'done\n');
+  const expected = Array.from({ length: lines }, (_, i) => `line ${i}\n`);
+  assert.strictEqual(child.stdout, expected.join(''));
+}
+
+// Buffered output is written out when process.exit() is called.
+{
+  const child = spawnSync(process.execPath, [
+    '--experimental-async-stdio=block',
+    '-e',
+    'process.stdout.write("a".repeat(1e6)); process.exit(0);',
+  ], { encoding: 'utf8', maxBuffer: Infinity });
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stdout, 'a'.repeat(1e6));
+}
+
+// In drop mode, writes that don't fit into the buffer while the reader is
+// slow are dropped and counted.
+{
+  const child = spawn(process.execPath, [
+    '--experimental-async-stdio=drop',
+    '--experimental-async-stdio-buffer-size=4096',
+    '-e',
+    `const chunk = 'x'.repeat(1023) + '\\n';
+     for (let i = 0; i < 4096; i++) process.stdout.write(chunk);
+     console.error(process.stdout.droppedBytes);`,
+  ], { stdio: ['ignore', 'pipe', 'pipe'] });
+  let received = 0;
+  let stderr = '';
+  child.stdout.pause();
+  setTimeout(() => child.stdout.resume(), common.platformTimeout(500));
+  child.stdout.on('data', (chunk) => received += chunk.length);
+  child.stderr.setEncoding('utf8');
+  child.stderr.on('data', (chunk) => stderr += chunk);
+  child.on('close', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const dropped = Number(stderr);
+    assert.ok(dropped > 0);
+    assert.strictEqual(received + dropped, 4096 * 1024);
+    assert.strictEqual(dropped % 1024, 0);
+  }));
+}
+
+for (const arg of ['--experimental-async-stdio=sometimes',
+                   '--experimental-async-stdio-buffer-size=0']) {
+  const child = spawnSync(process.execPath, [arg, '-e', '']);
+  assert.strictEqual(child.status, 9);
+}
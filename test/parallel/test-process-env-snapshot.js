@@ -0,0 +1,52 @@
+'use strict';
+const common = require('../common');
+
+// Reads of process.env are served from a snapshot of the environment. Check
+// that the snapshot stays in sync with the real environment as variables are
+// set and deleted from the main thread and from workers sharing it.
+
+const assert = require('assert');
+const { execFileSync } = require('child_process');
+const { Worker, SHARE_ENV } = require('worker_threads');
+
+const key = 'NODE_TEST_ENV_SNAPSHOT';
+const printKey = ['-p', `process.env.${key} ?? '<unset>'`];
+
+assert.strictEqual(process.env[key], undefined);
+assert.strictEqual(key in process.env, false);
+
+for (const value of ['first', '', 'second', 'x'.repeat(4096)]) {
+  process.env[key] = value;
+  assert.strictEqual(process.env[key], value);
+  assert.strictEqual(key in process.env, true);
+  assert.ok(Object.keys(process.env).includes(key));
+  // Repeated reads return the same value.
+  assert.strictEqual(process.env[key], process.env[key]);
+  assert.strictEqual(execFileSync(process.execPath, printKey, {
+    encoding: 'utf8',
+  }), `${value}\n`);
+}
+
+delete process.env[key];
+assert.strictEqual(process.env[key], undefined);
+assert.strictEqual(key in process.env, false);
+assert.strictEqual(execFileSync(process.execPath, printKey, {
+  encoding: 'utf8',
+}), '<unset>\n');
+
+process.env[key] = 'main';
+const worker = new Worker(`
+  const assert = require('assert');
+  const { parentPort } = require('worker_threads');
+  assert.strictEqual(process.env.${key}, 'main');
+  process.env.${key} = 'worker';
+  parentPort.postMessage(process.env.${key});
+`, { eval: true, env: SHARE_ENV });
+worker.on('message', common.mustCall((value) => {
+  assert.strictEqual(value, 'worker');
+  assert.strictEqual(process.env[key], 'worker');
+}));
+worker.on('exit', common.mustCall(() => {
+  delete process.env[key];
+  assert.strictEqual(process.env[key], undefined);
+}));
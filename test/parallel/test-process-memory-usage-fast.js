@@ -0,0 +1,28 @@
+// Flags: --expose-internals --no-warnings --allow-natives-syntax
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+
+const { internalBinding } = require('internal/test/binding');
+
+function testFastMemoryUsage() {
+  const usage = process.memoryUsage();
+  assert.ok(usage.rss > 0);
+  assert.ok(usage.heapUsed > 0);
+  assert.ok(process.memoryUsage.rss() > 0);
+}
+
+eval('%PrepareFunctionForOptimization(testFastMemoryUsage)');
+testFastMemoryUsage();
+eval('%OptimizeFunctionOnNextCall(testFastMemoryUsage)');
+testFastMemoryUsage();
+
+// Each call returns a fresh object even though the values are shared.
+assert.notStrictEqual(process.memoryUsage(), process.memoryUsage());
+
+if (common.isDebug) {
+  const { getV8FastApiCallCount } = internalBinding('debug');
+  assert.strictEqual(getV8FastApiCallCount('process.memoryUsage'), 1);
+  assert.strictEqual(getV8FastApiCallCount('process.memoryUsage.rss'), 1);
+}
@@ -0,0 +1,84 @@
+'use strict';
+// querystring.parse() and URLSearchParams split and decode the pairs in C++.
+// This checks the cases where the result depends on how the bytes are
+// decoded and that the JS parser is still used where its results differ.
+require('../common');
+
+const assert = require('assert');
+const querystring = require('querystring');
+
+function parse(...args) {
+  return { ...querystring.parse(...args) };
+}
+
+function searchParams(input) {
+  return [...new URLSearchParams(input)];
+}
+
+// Escapes, '+' and escapes that are incomplete.
+assert.deepStrictEqual(parse('a+b=c%20d&%41=%zz&e=%4&f=%'), {
+  'a b': 'c d',
+  'A': '%zz',
+  'e': '%4',
+  'f': '%',
+});
+assert.deepStrictEqual(searchParams('?a+b=c%20d&%41=%zz&e=%4&f=%'), [
+  ['a b', 'c d'],
+  ['A', '%zz'],
+  ['e', '%4'],
+  ['f', '%'],
+]);
+
+// Names without a value, empty names and repeated names.
+assert.deepStrictEqual(parse('a&=&&b=1=2&a=&a=x'), {
+  'a': ['', '', 'x'],
+  '': '',
+  'b': '1=2',
+});
+assert.deepStrictEqual(searchParams('a&=&&b=1=2&'), [
+  ['a', ''],
+  ['', ''],
+  ['b', '1=2'],
+]);
+
+// UTF-8, with the sequences that are not valid replaced.
+assert.deepStrictEqual(parse('%E2%82%AC=%F0%9F%98%80&x=%FF%E2%82'), {
+  '€': '😀',
+  'x': '��',
+});
+assert.deepStrictEqual(searchParams('%E2%82%AC=%F0%9F%98%80&x=%ED%A0%80'), [
+  ['€', '😀'],
+  ['x', '���'],
+]);
+
+// maxKeys counts the empty pairs too.
+assert.deepStrictEqual(parse('&&a=1&b=2', null, null, { maxKeys: 3 }),
+                       { a: '1' });
+assert.deepStrictEqual(parse('a=1&b=2&c=3', null, null, { maxKeys: 2 }),
+                       { a: '1', b: '2' });
+assert.deepStrictEqual(parse('a=1&b=2&c=3', null, null, { maxKeys: 0 }),
+                       { a: '1', b: '2', c: '3' });
+
+// querystring.unescape() decodes the strings that are not valid UTF-8 once
+// decoded byte by byte, so the characters that aren't ASCII are truncated in
+// them. URLSearchParams keeps them.
+assert.deepStrictEqual(parse('%FFé=%41%zzé'), {
+  '��': 'A%zz�',
+});
+assert.deepStrictEqual(searchParams('%FFé=%41%zzé'), [
+  ['�é', 'A%zzé'],
+]);
+
+// Lone surrogates are kept by querystring and replaced by URLSearchParams.
+assert.deepStrictEqual(parse('\ud800=%41\udc00'), { '\ud800': 'A\udc00' });
+assert.deepStrictEqual(searchParams('\ud800=%41\udc00'), [
+  ['�', 'A�'],
+]);
+
+// Separators and decoders other than the default ones.
+assert.deepStrictEqual(parse('a:1;b:%41', ';', ':'), { a: '1', b: 'A' });
+assert.deepStrictEqual(
+  parse('a=%41&b=2', null, null, {
+    decodeURIComponent: (s) => s.toLowerCase(),
+  }),
+  { a: '%41', b: '2' });
@@ -101,6 +101,11 @@ describe('quic internal endpoint options', { skip: !hasQuic }, async () => {
         valid: [true, false, 0, 1, 'a'],
         invalid: [],
       },
+      {
+        key: 'reusePort',
+        valid: [true, false, 0, 1, 'a'],
+        invalid: [],
+      },
       {
         key: 'udpReceiveBufferSize',
         valid: [0, 1, 2, 3, 4, 1000],
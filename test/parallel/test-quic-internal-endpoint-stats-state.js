@@ -99,6 +99,7 @@ describe('quic internal endpoint stats and state', { skip: !hasQuic }, () => {
     strictEqual(typeof endpoint.stats.versionNegotiationCount, 'bigint');
     strictEqual(typeof endpoint.stats.statelessResetCount, 'bigint');
     strictEqual(typeof endpoint.stats.immediateCloseCount, 'bigint');
+    strictEqual(typeof endpoint.stats.forwardedPacketCount, 'bigint');
 
     deepStrictEqual(Object.keys(endpoint.stats.toJSON()), [
       'connected',
@@ -115,6 +116,7 @@ describe('quic internal endpoint stats and state', { skip: !hasQuic }, () => {
       'versionNegotiationCount',
       'statelessResetCount',
       'immediateCloseCount',
+      'forwardedPacketCount',
     ]);
 
     it('stats can be inspected without errors', () => {
@@ -0,0 +1,45 @@
+// Flags: --expose-internals --experimental-quic --no-warnings
+'use strict';
+
+const { hasQuic } = require('../common');
+
+const {
+  describe,
+  it,
+} = require('node:test');
+
+describe('quic internal http3 application', { skip: !hasQuic }, () => {
+  const { internalBinding } = require('internal/test/binding');
+  const {
+    strictEqual,
+    rejects,
+    throws,
+  } = require('node:assert');
+  const quic = internalBinding('quic');
+
+  it('exposes the names of the QPACK header tokens', () => {
+    strictEqual(quic.QUIC_STREAM_HEADER_TOKEN_FLAG, 2 ** 31);
+    const names = new Set(quic.http3HeaderNames.filter((name) => name));
+    for (const name of [':status', ':method', ':path', 'content-type']) {
+      strictEqual(names.has(name), true, name);
+    }
+  });
+
+  it('accepts the QPACK settings', () => {
+    new quic.Http3Application({
+      qpackMaxDTableCapacity: 4096,
+      qpackEncoderMaxDTableCapacity: 4096n,
+      qpackBlockedStreams: 100,
+    });
+    throws(() => new quic.Http3Application({ qpackBlockedStreams: 'x' }), {
+      code: 'ERR_INVALID_ARG_VALUE',
+    });
+  });
+
+  it('validates the application option', async () => {
+    const { connect } = require('node:quic');
+    await rejects(connect('127.0.0.1:1', { application: 1 }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  });
+});
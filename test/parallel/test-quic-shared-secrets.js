@@ -0,0 +1,70 @@
+// Flags: --experimental-quic --expose-internals --no-warnings
+'use strict';
+
+const { hasQuic } = require('../common');
+
+const {
+  describe,
+  it,
+} = require('node:test');
+
+// Token secrets can be rotated, and servers can share TLS session ticket keys.
+
+describe('quic shared token secrets and ticket keys', { skip: !hasQuic }, async () => {
+  const {
+    ok,
+    rejects,
+    strictEqual,
+    throws,
+  } = require('node:assert');
+
+  const { createPrivateKey, randomBytes } = require('node:crypto');
+  const fixtures = require('../common/fixtures');
+  const keys = createPrivateKey(fixtures.readKey('agent1-key.pem'));
+  const certs = fixtures.readKey('agent1-cert.pem');
+
+  const {
+    QuicEndpoint,
+    connect,
+    listen,
+  } = require('internal/quic/quic');
+
+  it('token secrets can be rotated', () => {
+    const endpoint = new QuicEndpoint({ tokenSecret: randomBytes(16) });
+    endpoint.rotateTokenSecret(randomBytes(16));
+    endpoint.rotateTokenSecret();
+
+    throws(() => endpoint.rotateTokenSecret('secret'), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+    throws(() => endpoint.rotateTokenSecret(randomBytes(15)), {
+      code: 'ERR_INVALID_ARG_VALUE',
+    });
+
+    endpoint.destroy();
+    throws(() => endpoint.rotateTokenSecret(), {
+      code: 'ERR_INVALID_STATE',
+    });
+  });
+
+  it('ticket keys are validated', async () => {
+    await rejects(listen(() => {}, { keys, certs, ticketKeys: randomBytes(47) }), {
+      code: 'ERR_INVALID_ARG_VALUE',
+    });
+    await rejects(listen(() => {}, { keys, certs, ticketKeys: ['key'] }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  });
+
+  it('servers with ticket keys complete handshakes', async () => {
+    const ticketKeys = [randomBytes(48), randomBytes(48)];
+    const serverEndpoint = await listen(() => {}, { keys, certs, ticketKeys });
+    ok(serverEndpoint.address !== undefined);
+
+    const clientSession = await connect(serverEndpoint.address);
+    const info = await clientSession.opened;
+    strictEqual(info.servername, 'localhost');
+    await clientSession.close();
+    serverEndpoint.destroy();
+  });
+});
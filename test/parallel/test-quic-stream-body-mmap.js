@@ -0,0 +1,74 @@
+// Flags: --experimental-quic --no-warnings
+'use strict';
+
+const { hasQuic } = require('../common');
+const { Buffer } = require('node:buffer');
+
+const {
+  describe,
+  it,
+} = require('node:test');
+
+// TODO(@jasnell): Temporarily skip the test on mac until we can figure
+// out while it is failing on macs in CI but running locally on macs ok.
+const isMac = process.platform === 'darwin';
+const skip = isMac || !hasQuic;
+
+async function readAll(readable) {
+  const chunks = [];
+  for await (const chunk of readable) {
+    chunks.push(chunk);
+  }
+  return Buffer.concat(chunks);
+}
+
+describe('quic streams send file-backed bodies', { skip }, async () => {
+  const { createPrivateKey } = require('node:crypto');
+  const fs = require('node:fs');
+  const fixtures = require('../common/fixtures');
+  const tmpdir = require('../common/tmpdir');
+  const keys = createPrivateKey(fixtures.readKey('agent1-key.pem'));
+  const certs = fixtures.readKey('agent1-cert.pem');
+
+  const {
+    listen,
+    connect,
+  } = require('node:quic');
+
+  const {
+    ok,
+  } = require('node:assert');
+
+  tmpdir.refresh();
+  // Large enough to need many packets and several pulls from the mapping.
+  const contents = Buffer.alloc(1024 * 1024 + 17);
+  for (let i = 0; i < contents.length; i++) contents[i] = i % 251;
+  const file = tmpdir.resolve('quic-body.bin');
+  fs.writeFileSync(file, contents);
+
+  for (const mmap of [false, true]) {
+    it(`the body is received intact (mmap: ${mmap})`, async () => {
+      const received = Promise.withResolvers();
+
+      const serverEndpoint = await listen((serverSession) => {
+        serverSession.onstream = (stream) => {
+          readAll(stream.readable).then((data) => {
+            received.resolve(data);
+            serverSession.close();
+          });
+        };
+      }, { keys, certs });
+
+      const clientSession = await connect(serverEndpoint.address);
+      await clientSession.opened;
+
+      const body = await fs.openAsBlob(file, { mmap });
+      const stream = await clientSession.createUnidirectionalStream({ body });
+      ok(stream);
+
+      const data = await received.promise;
+      clientSession.close();
+      ok(data.equals(contents));
+    });
+  }
+});
@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+const assert = require('node:assert');
+const readline = require('node:readline');
+const { Readable } = require('node:stream');
+
+// Buffer chunks are split into the same lines as the decoded text, wherever
+// they are cut, including within CRLF and within multibyte characters.
+
+const text = '012\n345\r67\r\n89\u{2028}ABC\u{2029}DEF\n\n' +
+             'añb€c\u{1F600}\r\rend\r\n' + 'x'.repeat(100) + '\nlast';
+const expected = ['012', '345', '67', '89', 'ABC', 'DEF', '', 'añb€c\u{1F600}',
+                  '', 'end', 'x'.repeat(100), 'last'];
+const bytes = Buffer.from(text);
+
+function readLines(chunks) {
+  const rli = new readline.Interface({
+    input: Readable.from(chunks),
+    crlfDelay: Infinity,
+  });
+  const lines = [];
+  rli.on('line', (line) => lines.push(line));
+  return new Promise((resolve) => rli.on('close', () => resolve(lines)));
+}
+
+(async () => {
+  assert.deepStrictEqual(await readLines([bytes]), expected);
+
+  for (const size of [1, 2, 3, 5, 7, 16, 17, 64]) {
+    const chunks = [];
+    for (let i = 0; i < bytes.length; i += size) {
+      chunks.push(bytes.subarray(i, i + size));
+    }
+    assert.deepStrictEqual(await readLines(chunks), expected,
+                           `chunks of ${size} bytes`);
+  }
+
+  // Every possible cut into two chunks.
+  for (let i = 1; i < bytes.length; i++) {
+    assert.deepStrictEqual(
+      await readLines([bytes.subarray(0, i), bytes.subarray(i)]),
+      expected,
+      `cut at ${i}`);
+  }
+})().then(common.mustCall());
@@ -0,0 +1,28 @@
+'use strict';
+
+// This tests that ShadowRealms work the same whether their context is
+// deserialized from the snapshot or built from scratch.
+
+require('../common');
+const { spawnSyncAndExitWithoutError } = require('../common/child_process');
+
+const script = `
+  const assert = require('assert');
+  const realm = new ShadowRealm();
+  assert.strictEqual(realm.evaluate('1 + 1'), 2);
+  assert.strictEqual(realm.evaluate('typeof URL'), 'function');
+  assert.strictEqual(realm.evaluate('typeof DOMException'), 'function');
+  assert.strictEqual(
+    realm.evaluate('new URL("https://nodejs.org/a/../b").href'),
+    'https://nodejs.org/b');
+  // Realms do not share their intrinsics or the per-context states.
+  assert.strictEqual(realm.evaluate('Array.prototype.x = 1; [].x'), 1);
+  assert.strictEqual(new ShadowRealm().evaluate('[].x'), undefined);
+  assert.strictEqual([].x, undefined);
+`;
+
+for (const args of [[], ['--no-node-snapshot']]) {
+  spawnSyncAndExitWithoutError(
+    process.execPath,
+    ['--experimental-shadow-realm', ...args, '-e', script]);
+}
@@ -48,6 +48,27 @@ const assert = require('assert');
   assert(existsSync(output));
 }
 
+{
+  // Like JSON.parse(), the last of duplicate keys is used.
+  tmpdir.refresh();
+  const config = tmpdir.resolve('duplicate.json');
+  const main = tmpdir.resolve('bundle.js');
+  writeFileSync(main, 'console.log("hello")', 'utf-8');
+  writeFileSync(
+    config,
+    '{ "main": "bundle.js", "output": "first.blob", "output": "last.blob" }',
+    'utf8');
+  const child = spawnSync(
+    process.execPath,
+    ['--experimental-sea-config', config], {
+      cwd: tmpdir.path,
+    });
+
+  assert.strictEqual(child.status, 0);
+  assert(!existsSync(tmpdir.resolve('first.blob')));
+  assert(existsSync(tmpdir.resolve('last.blob')));
+}
+
 {
   tmpdir.refresh();
   const config = tmpdir.resolve('no-disableExperimentalSEAWarning.json');
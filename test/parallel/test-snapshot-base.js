@@ -0,0 +1,99 @@
+'use strict';
+
+// This tests that --build-snapshot-base builds a snapshot on top of another
+// snapshot without running the builder script of the base again.
+
+require('../common');
+const assert = require('assert');
+const tmpdir = require('../common/tmpdir');
+const {
+  spawnSyncAndAssert,
+  spawnSyncAndExitWithoutError,
+} = require('../common/child_process');
+const fs = require('fs');
+
+tmpdir.refresh();
+const baseBlobPath = tmpdir.resolve('base.blob');
+const appBlobPath = tmpdir.resolve('app.blob');
+
+fs.writeFileSync(tmpdir.resolve('base.js'), `
+const { startupSnapshot } = require('v8');
+globalThis.baseBuildCount = (globalThis.baseBuildCount || 0) + 1;
+globalThis.framework = { name: 'framework' };
+startupSnapshot.addDeserializeCallback(() => {
+  globalThis.order = ['base'];
+});
+startupSnapshot.setDeserializeMainFunction(() => {
+  console.log('base main');
+});
+`);
+
+fs.writeFileSync(tmpdir.resolve('app.js'), `
+const { startupSnapshot } = require('v8');
+const assert = require('assert');
+assert(startupSnapshot.isBuildingSnapshot());
+assert.strictEqual(globalThis.framework.name, 'framework');
+// The deserialize callbacks of the base are not run while building.
+assert.strictEqual(globalThis.order, undefined);
+globalThis.app = { name: 'app' };
+startupSnapshot.addDeserializeCallback(() => {
+  globalThis.order.push('app');
+});
+startupSnapshot.setDeserializeMainFunction(() => {
+  console.log(globalThis.baseBuildCount, globalThis.framework.name,
+              globalThis.app.name, globalThis.order.join(','));
+});
+`);
+
+spawnSyncAndExitWithoutError(process.execPath, [
+  '--snapshot-blob',
+  baseBlobPath,
+  '--build-snapshot',
+  'base.js',
+], {
+  cwd: tmpdir.path
+});
+
+spawnSyncAndAssert(process.execPath, [
+  '--snapshot-blob',
+  baseBlobPath,
+], {
+  cwd: tmpdir.path
+}, {
+  stdout: 'base main',
+  trim: true,
+});
+
+spawnSyncAndExitWithoutError(process.execPath, [
+  '--snapshot-blob',
+  appBlobPath,
+  '--build-snapshot-base',
+  baseBlobPath,
+  '--build-snapshot',
+  'app.js',
+], {
+  cwd: tmpdir.path
+});
+assert(fs.statSync(appBlobPath).isFile());
+
+spawnSyncAndAssert(process.execPath, [
+  '--snapshot-blob',
+  appBlobPath,
+], {
+  cwd: tmpdir.path
+}, {
+  stdout: '1 framework app base,app',
+  trim: true,
+});
+
+// --build-snapshot-base only works when building a snapshot.
+spawnSyncAndAssert(process.execPath, [
+  '--build-snapshot-base',
+  baseBlobPath,
+  'app.js',
+], {
+  cwd: tmpdir.path
+}, {
+  status: 9,
+  stderr: /--build-snapshot-base must be used with --build-snapshot/,
+});
@@ -0,0 +1,235 @@
+'use strict';
+const { skipIfSQLiteMissing } = require('../common');
+skipIfSQLiteMissing();
+const tmpdir = require('../common/tmpdir');
+const assert = require('node:assert');
+const { join } = require('node:path');
+const { Database, DatabaseSync, Statement } = require('node:sqlite');
+const { suite, test } = require('node:test');
+let cnt = 0;
+
+tmpdir.refresh();
+
+function nextDb() {
+  return join(tmpdir.path, `database-${cnt++}.db`);
+}
+
+suite('Database() constructor', () => {
+  test('throws if called without new', (t) => {
+    t.assert.throws(() => {
+      Database();
+    }, {
+      code: 'ERR_CONSTRUCT_CALL_REQUIRED',
+      message: /Cannot call constructor without `new`/,
+    });
+  });
+
+  test('throws if the database location is not a string', (t) => {
+    t.assert.throws(() => {
+      new Database();
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The "path" argument must be a string, Uint8Array, or URL without null bytes/,
+    });
+  });
+
+  test('throws if options is not an object', (t) => {
+    t.assert.throws(() => {
+      new Database('foo', null);
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The "options" argument must be an object/,
+    });
+  });
+
+  test('throws if the database cannot be opened', (t) => {
+    t.assert.throws(() => {
+      new Database(nextDb(), { readOnly: true });
+    }, {
+      code: 'ERR_SQLITE_ERROR',
+      message: /unable to open database file/,
+    });
+  });
+
+  test('opens the database', async (t) => {
+    const db = new Database(nextDb());
+    t.assert.strictEqual(db.isOpen, true);
+    await db.close();
+    t.assert.strictEqual(db.isOpen, false);
+  });
+});
+
+suite('Database.prototype.exec()', () => {
+  test('executes SQL', async (t) => {
+    const path = nextDb();
+    const db = new Database(path);
+    t.after(() => { db.close(); });
+    const result = await db.exec(`
+      CREATE TABLE data(key INTEGER PRIMARY KEY, val INTEGER) STRICT;
+      INSERT INTO data (key, val) VALUES (1, 2);
+      INSERT INTO data (key, val) VALUES (8, 9);
+    `);
+    t.assert.strictEqual(result, undefined);
+
+    const sync = new DatabaseSync(path);
+    t.after(() => { sync.close(); });
+    t.assert.deepStrictEqual(
+      sync.prepare('SELECT * FROM data ORDER BY key').all().map((row) => {
+        return { ...row };
+      }),
+      [{ key: 1, val: 2 }, { key: 8, val: 9 }],
+    );
+  });
+
+  test('rejects with SQLite errors', async (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    await t.assert.rejects(db.exec('CREATE TABLEEEE'), {
+      code: 'ERR_SQLITE_ERROR',
+      message: /syntax error/,
+      errcode: 1,
+      errstr: 'SQL logic error',
+    });
+  });
+
+  test('throws if the SQL is not a string', (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    t.assert.throws(() => {
+      db.exec();
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The "sql" argument must be a string/,
+    });
+  });
+});
+
+suite('Statement', () => {
+  test('cannot be constructed', (t) => {
+    t.assert.throws(() => {
+      new Statement();
+    }, {
+      code: 'ERR_ILLEGAL_CONSTRUCTOR',
+    });
+  });
+
+  test('runs, gets, and queries all rows', async (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    await db.exec('CREATE TABLE data(key INTEGER PRIMARY KEY, val ANY) STRICT');
+    const insert = await db.prepare('INSERT INTO data (key, val) VALUES (?, ?)');
+    t.assert.ok(insert instanceof Statement);
+
+    const results = await Promise.all([
+      insert.run(1, 'one'),
+      insert.run(2, 2.5),
+      insert.run(3, new Uint8Array([1, 2])),
+      insert.run(4, null),
+    ]);
+    t.assert.deepStrictEqual(results.map((result) => ({ ...result })), [
+      { changes: 1, lastInsertRowid: 1 },
+      { changes: 1, lastInsertRowid: 2 },
+      { changes: 1, lastInsertRowid: 3 },
+      { changes: 1, lastInsertRowid: 4 },
+    ]);
+
+    const all = await db.prepare('SELECT * FROM data ORDER BY key');
+    const rows = await all.all();
+    t.assert.deepStrictEqual(rows.map((row) => ({ ...row })), [
+      { key: 1, val: 'one' },
+      { key: 2, val: 2.5 },
+      { key: 3, val: new Uint8Array([1, 2]) },
+      { key: 4, val: null },
+    ]);
+    t.assert.strictEqual(Object.getPrototypeOf(rows[0]), null);
+
+    const get = await db.prepare('SELECT val FROM data WHERE key = ?');
+    t.assert.deepStrictEqual({ ...await get.get(1) }, { val: 'one' });
+    t.assert.strictEqual(await get.get(10), undefined);
+  });
+
+  test('binds named parameters', async (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    await db.exec('CREATE TABLE data(key INTEGER, val INTEGER) STRICT');
+    const insert = await db.prepare(
+      'INSERT INTO data (key, val) VALUES ($k, :v)');
+    await insert.run({ $k: 1, v: 2 });
+    await insert.run({ k: 3n, $v: 4 });
+    const all = await db.prepare('SELECT * FROM data ORDER BY key');
+    t.assert.deepStrictEqual((await all.all()).map((row) => ({ ...row })), [
+      { key: 1, val: 2 },
+      { key: 3, val: 4 },
+    ]);
+
+    t.assert.throws(() => {
+      insert.run({ unknown: 1 });
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /Unknown named parameter 'unknown'/,
+    });
+    t.assert.throws(() => {
+      insert.run({ $k: {} });
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /Provided value cannot be bound to SQLite parameter 1/,
+    });
+  });
+
+  test('rejects if an integer is not a safe integer', async (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    const stmt = await db.prepare(`SELECT ${Number.MAX_SAFE_INTEGER + 1} AS v`);
+    await t.assert.rejects(stmt.get(), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+  });
+
+  test('rejects with SQLite errors', async (t) => {
+    const db = new Database(':memory:');
+    t.after(() => { db.close(); });
+    await t.assert.rejects(db.prepare('SELECT * FROM missing'), {
+      code: 'ERR_SQLITE_ERROR',
+      message: /no such table: missing/,
+    });
+  });
+});
+
+suite('Database.prototype.close()', () => {
+  test('waits for the queries that were issued before', async (t) => {
+    const db = new Database(':memory:');
+    const exec = db.exec('CREATE TABLE data(key INTEGER)');
+    const prepare = db.prepare('SELECT * FROM data');
+    const close = db.close();
+    t.assert.strictEqual(db.isOpen, false);
+    await exec;
+    const stmt = await prepare;
+    await close;
+
+    t.assert.throws(() => {
+      stmt.all();
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /database is not open/,
+    });
+    t.assert.throws(() => {
+      db.exec('SELECT 1');
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /database is not open/,
+    });
+    t.assert.throws(() => {
+      db.close();
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /database is not open/,
+    });
+  });
+
+  test('is called by Symbol.asyncDispose', async (t) => {
+    const db = new Database(':memory:');
+    await db[Symbol.asyncDispose]();
+    t.assert.strictEqual(db.isOpen, false);
+    assert.strictEqual(db[Symbol.asyncDispose](), undefined);
+  });
+});
@@ -0,0 +1,86 @@
+'use strict';
+const { skipIfSQLiteMissing } = require('../common');
+skipIfSQLiteMissing();
+const tmpdir = require('../common/tmpdir');
+const { join } = require('node:path');
+const { Database, DatabaseSync } = require('node:sqlite');
+const { suite, test } = require('node:test');
+let cnt = 0;
+
+tmpdir.refresh();
+
+function nextDb() {
+  return join(tmpdir.path, `database-${cnt++}.db`);
+}
+
+function pragma(db, name) {
+  return db.prepare(`PRAGMA ${name}`).get()[name];
+}
+
+suite('DatabaseSync tuning options', () => {
+  test('throws if the options are invalid', (t) => {
+    const cases = [
+      [{ sharedCache: 1 },
+       'ERR_INVALID_ARG_TYPE', /"options\.sharedCache" argument must be a boolean/],
+      [{ mmapSize: -1 },
+       'ERR_INVALID_ARG_TYPE', /"options\.mmapSize" argument must be a non-negative integer/],
+      [{ mmapSize: 1.5 },
+       'ERR_INVALID_ARG_TYPE', /"options\.mmapSize" argument must be a non-negative integer/],
+      [{ cacheSize: '10' },
+       'ERR_INVALID_ARG_TYPE', /"options\.cacheSize" argument must be an integer/],
+      [{ journalMode: 1 },
+       'ERR_INVALID_ARG_TYPE', /"options\.journalMode" argument must be a string/],
+      [{ journalMode: 'wal; DROP TABLE data' },
+       'ERR_INVALID_ARG_VALUE', /"options\.journalMode" argument must be one of/],
+      [{ walAutoCheckpoint: -1 },
+       'ERR_INVALID_ARG_TYPE', /"options\.walAutoCheckpoint" argument must be a non-negative integer/],
+    ];
+    for (const [options, code, message] of cases) {
+      t.assert.throws(() => {
+        new DatabaseSync(nextDb(), options);
+      }, { code, message });
+    }
+  });
+
+  test('applies the options to the connection', (t) => {
+    const db = new DatabaseSync(nextDb(), {
+      mmapSize: 1024 * 1024,
+      cacheSize: -4096,
+      journalMode: 'wal',
+      walAutoCheckpoint: 100,
+    });
+    t.after(() => { db.close(); });
+    t.assert.strictEqual(pragma(db, 'mmap_size'), 1024 * 1024);
+    t.assert.strictEqual(pragma(db, 'cache_size'), -4096);
+    t.assert.strictEqual(pragma(db, 'journal_mode'), 'wal');
+    t.assert.strictEqual(pragma(db, 'wal_autocheckpoint'), 100);
+  });
+
+  test('applies the options when the database is opened again', (t) => {
+    const db = new DatabaseSync(nextDb(), { cacheSize: 10, open: false });
+    db.open();
+    t.assert.strictEqual(pragma(db, 'cache_size'), 10);
+    db.close();
+    db.open();
+    t.after(() => { db.close(); });
+    t.assert.strictEqual(pragma(db, 'cache_size'), 10);
+  });
+
+  test('connections in shared-cache mode share tables', (t) => {
+    const path = nextDb();
+    const first = new DatabaseSync(path, { sharedCache: true });
+    t.after(() => { first.close(); });
+    const second = new DatabaseSync(path, { sharedCache: true });
+    t.after(() => { second.close(); });
+    first.exec('CREATE TABLE data(key INTEGER PRIMARY KEY) STRICT');
+    first.exec('INSERT INTO data (key) VALUES (1)');
+    t.assert.strictEqual(second.prepare('SELECT * FROM data').get().key, 1);
+  });
+
+  test('the options are supported by Database', async (t) => {
+    const db = new Database(nextDb(), { journalMode: 'wal' });
+    t.after(() => db.close());
+    const stmt = await db.prepare('PRAGMA journal_mode');
+    t.assert.strictEqual((await stmt.get()).journal_mode, 'wal');
+  });
+});
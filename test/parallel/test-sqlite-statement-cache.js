@@ -0,0 +1,90 @@
+'use strict';
+const { skipIfSQLiteMissing } = require('../common');
+skipIfSQLiteMissing();
+const { DatabaseSync } = require('node:sqlite');
+const { suite, test } = require('node:test');
+
+suite('DatabaseSync statementCacheSize option', () => {
+  test('throws if the option is not a non-negative integer', (t) => {
+    for (const statementCacheSize of ['10', -1, 1.5, null]) {
+      t.assert.throws(() => {
+        new DatabaseSync(':memory:', { statementCacheSize });
+      }, {
+        code: 'ERR_INVALID_ARG_TYPE',
+        message: /The "options\.statementCacheSize" argument must be a non-negative integer/,
+      });
+    }
+  });
+
+  test('the cache is disabled by default', (t) => {
+    const db = new DatabaseSync(':memory:');
+    t.after(() => { db.close(); });
+    t.assert.notStrictEqual(db.prepare('SELECT 1'), db.prepare('SELECT 1'));
+    t.assert.deepStrictEqual({ ...db.getStatementCacheStatistics() }, {
+      size: 0,
+      hits: 0,
+      misses: 0,
+    });
+  });
+
+  test('returns cached statements that are reset', (t) => {
+    const db = new DatabaseSync(':memory:', { statementCacheSize: 2 });
+    t.after(() => { db.close(); });
+    db.exec(`
+      CREATE TABLE data(key INTEGER PRIMARY KEY) STRICT;
+      INSERT INTO data (key) VALUES (1), (2), (3);
+    `);
+
+    const sql = 'SELECT key FROM data ORDER BY key';
+    const stmt = db.prepare(sql);
+    const iterator = stmt.iterate();
+    t.assert.strictEqual(iterator.next().value.key, 1);
+
+    t.assert.strictEqual(db.prepare(sql), stmt);
+    t.assert.deepStrictEqual(stmt.all().map((row) => row.key), [1, 2, 3]);
+    t.assert.deepStrictEqual({ ...db.getStatementCacheStatistics() }, {
+      size: 1,
+      hits: 1,
+      misses: 1,
+    });
+  });
+
+  test('evicts the least recently used statements', (t) => {
+    const db = new DatabaseSync(':memory:', { statementCacheSize: 2 });
+    t.after(() => { db.close(); });
+
+    const one = db.prepare('SELECT 1');
+    const two = db.prepare('SELECT 2');
+    t.assert.strictEqual(db.prepare('SELECT 1'), one);
+    const three = db.prepare('SELECT 3');
+    t.assert.strictEqual(db.prepare('SELECT 1'), one);
+    t.assert.strictEqual(db.prepare('SELECT 3'), three);
+
+    // The evicted statement is still usable.
+    const otherTwo = db.prepare('SELECT 2');
+    t.assert.notStrictEqual(otherTwo, two);
+    t.assert.deepStrictEqual({ ...two.get() }, { 2: 2 });
+    t.assert.deepStrictEqual({ ...db.getStatementCacheStatistics() }, {
+      size: 2,
+      hits: 3,
+      misses: 4,
+    });
+  });
+
+  test('clears the cache when the database is closed', (t) => {
+    const db = new DatabaseSync(':memory:', { statementCacheSize: 2 });
+    const stmt = db.prepare('SELECT 1');
+    db.close();
+    t.assert.strictEqual(db.getStatementCacheStatistics().size, 0);
+
+    db.open();
+    t.after(() => { db.close(); });
+    t.assert.notStrictEqual(db.prepare('SELECT 1'), stmt);
+    t.assert.throws(() => {
+      stmt.get();
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /statement has been finalized/,
+    });
+  });
+});
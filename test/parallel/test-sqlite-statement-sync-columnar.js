@@ -0,0 +1,84 @@
+'use strict';
+const { skipIfSQLiteMissing } = require('../common');
+skipIfSQLiteMissing();
+const { DatabaseSync } = require('node:sqlite');
+const { suite, test } = require('node:test');
+
+suite('StatementSync.prototype.allColumnar()', () => {
+  function makeDb(t) {
+    const db = new DatabaseSync(':memory:');
+    t.after(() => { db.close(); });
+    db.exec(`
+      CREATE TABLE data(
+        key INTEGER PRIMARY KEY,
+        real REAL,
+        text TEXT,
+        mixed ANY
+      ) STRICT;
+      INSERT INTO data VALUES (1, 0.5, 'one', 1);
+      INSERT INTO data VALUES (2, 1.5, 'two', 2.5);
+      INSERT INTO data VALUES (3, 2, 'three', NULL);
+    `);
+    return db;
+  }
+
+  test('returns the values of each column', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('SELECT * FROM data ORDER BY key');
+    const result = stmt.allColumnar();
+    t.assert.strictEqual(Object.getPrototypeOf(result), null);
+    t.assert.deepStrictEqual(Object.keys(result),
+                             ['key', 'real', 'text', 'mixed']);
+    t.assert.deepStrictEqual(result.key, new Float64Array([1, 2, 3]));
+    t.assert.deepStrictEqual(result.real, new Float64Array([0.5, 1.5, 2]));
+    t.assert.deepStrictEqual(result.text, ['one', 'two', 'three']);
+    t.assert.deepStrictEqual(result.mixed, [1, 2.5, null]);
+  });
+
+  test('returns BigInt64Array when reading BigInts', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('SELECT key, real, mixed FROM data ORDER BY key');
+    stmt.setReadBigInts(true);
+    const result = stmt.allColumnar();
+    t.assert.deepStrictEqual(result.key, new BigInt64Array([1n, 2n, 3n]));
+    t.assert.deepStrictEqual(result.real, new Float64Array([0.5, 1.5, 2]));
+    t.assert.deepStrictEqual(result.mixed, [1n, 2.5, null]);
+  });
+
+  test('binds parameters', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare(
+      'SELECT key FROM data WHERE key > $min AND key < ? ORDER BY key');
+    t.assert.deepStrictEqual(stmt.allColumnar({ min: 1 }, 4).key,
+                             new Float64Array([2, 3]));
+  });
+
+  test('returns empty arrays if there are no rows', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('SELECT key, text FROM data WHERE key > 10');
+    t.assert.deepStrictEqual({ ...stmt.allColumnar() }, { key: [], text: [] });
+  });
+
+  test('throws if an integer is not a safe integer', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare(`SELECT ${Number.MAX_SAFE_INTEGER} + 1 AS v`);
+    t.assert.throws(() => {
+      stmt.allColumnar();
+    }, {
+      code: 'ERR_OUT_OF_RANGE',
+      message: /Value is too large to be represented as a JavaScript number/,
+    });
+  });
+
+  test('throws if the statement has been finalized', (t) => {
+    const db = new DatabaseSync(':memory:');
+    const stmt = db.prepare('SELECT 1');
+    db.close();
+    t.assert.throws(() => {
+      stmt.allColumnar();
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /statement has been finalized/,
+    });
+  });
+});
@@ -0,0 +1,129 @@
+'use strict';
+const { skipIfSQLiteMissing } = require('../common');
+skipIfSQLiteMissing();
+const { DatabaseSync } = require('node:sqlite');
+const { suite, test } = require('node:test');
+
+function makeDb(t) {
+  const db = new DatabaseSync(':memory:');
+  t.after(() => { db.close(); });
+  db.exec('CREATE TABLE data(key INTEGER PRIMARY KEY, val ANY) STRICT');
+  return db;
+}
+
+function rows(db) {
+  return db.prepare('SELECT * FROM data ORDER BY key').all()
+    .map((row) => ({ ...row }));
+}
+
+suite('StatementSync.prototype.runMany()', () => {
+  test('runs an array of rows', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES (?, ?)');
+    const result = stmt.runMany([[1, 'one'], [2, 2.5], [3, null]]);
+    t.assert.deepStrictEqual({ ...result }, { changes: 3, lastInsertRowid: 3 });
+    t.assert.deepStrictEqual(rows(db), [
+      { key: 1, val: 'one' },
+      { key: 2, val: 2.5 },
+      { key: 3, val: null },
+    ]);
+  });
+
+  test('binds named parameters of rows', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES ($k, :v)');
+    stmt.runMany([{ $k: 1, v: 'one' }, { k: 2, ':v': 'two' }]);
+    t.assert.deepStrictEqual(rows(db), [
+      { key: 1, val: 'one' },
+      { key: 2, val: 'two' },
+    ]);
+  });
+
+  test('runs rows by column', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES ($k, $v)');
+    stmt.setReadBigInts(true);
+    const result = stmt.runMany({
+      k: new BigInt64Array([1n, 2n]),
+      v: new Float64Array([0.5, 1.5]).subarray(0),
+    });
+    t.assert.deepStrictEqual({ ...result },
+                             { changes: 2n, lastInsertRowid: 2n });
+    stmt.runMany({ k: [3, 4], v: ['three', new Uint8Array([4])] });
+    t.assert.deepStrictEqual(rows(db), [
+      { key: 1, val: 0.5 },
+      { key: 2, val: 1.5 },
+      { key: 3, val: 'three' },
+      { key: 4, val: new Uint8Array([4]) },
+    ]);
+  });
+
+  test('rolls back all the rows on failure', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES (?, ?)');
+    t.assert.throws(() => {
+      stmt.runMany([[1, 'one'], [2, 'two'], [1, 'again']]);
+    }, {
+      code: 'ERR_SQLITE_ERROR',
+      message: /UNIQUE constraint failed: data\.key/,
+    });
+    t.assert.throws(() => {
+      stmt.runMany([[1, 'one'], [2, {}]]);
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /Provided value cannot be bound to SQLite parameter 2/,
+    });
+    t.assert.deepStrictEqual(rows(db), []);
+    t.assert.strictEqual(db.isTransaction, false);
+  });
+
+  test('only rolls back its own rows within a transaction', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES (?, ?)');
+    db.exec('BEGIN');
+    stmt.run(1, 'one');
+    t.assert.throws(() => {
+      stmt.runMany([[2, 'two'], [1, 'again']]);
+    }, {
+      code: 'ERR_SQLITE_ERROR',
+    });
+    t.assert.strictEqual(db.isTransaction, true);
+    db.exec('COMMIT');
+    t.assert.deepStrictEqual(rows(db), [{ key: 1, val: 'one' }]);
+  });
+
+  test('throws if the rows are invalid', (t) => {
+    const db = makeDb(t);
+    const stmt = db.prepare('INSERT INTO data (key, val) VALUES ($k, $v)');
+    t.assert.throws(() => {
+      stmt.runMany();
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The "rows" argument must be an array or an object/,
+    });
+    t.assert.throws(() => {
+      stmt.runMany([1]);
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The "rows\[0\]" argument must be an array or an object/,
+    });
+    t.assert.throws(() => {
+      stmt.runMany({ k: new Int32Array(1), v: [1] });
+    }, {
+      code: 'ERR_INVALID_ARG_TYPE',
+      message: /The columns of the "rows" argument must be arrays/,
+    });
+    t.assert.throws(() => {
+      stmt.runMany({ k: [1, 2], v: [1] });
+    }, {
+      code: 'ERR_INVALID_ARG_VALUE',
+      message: /The columns of the "rows" argument must have equal length/,
+    });
+    t.assert.throws(() => {
+      stmt.runMany({ unknown: [1] });
+    }, {
+      code: 'ERR_INVALID_STATE',
+      message: /Unknown named parameter 'unknown'/,
+    });
+  });
+});
@@ -53,6 +53,21 @@ suite('StatementSync.prototype.get()', () => {
     const stmt = db.prepare('SELECT 1 as __proto__, 2 as constructor, 3 as toString');
     t.assert.deepStrictEqual(stmt.get(), { __proto__: null, ['__proto__']: 1, constructor: 2, toString: 3 });
   });
+
+  test('returns the columns of the current schema', (t) => {
+    const db = new DatabaseSync(nextDb());
+    t.after(() => { db.close(); });
+    db.exec(`
+      CREATE TABLE storage(key TEXT, val TEXT);
+      INSERT INTO storage (key, val) VALUES ('key1', 'val1');
+    `);
+    const stmt = db.prepare('SELECT * FROM storage');
+    t.assert.deepStrictEqual(stmt.get(), { __proto__: null, key: 'key1', val: 'val1' });
+    t.assert.deepStrictEqual(stmt.get(), { __proto__: null, key: 'key1', val: 'val1' });
+    db.exec('ALTER TABLE storage RENAME COLUMN val TO value');
+    t.assert.deepStrictEqual(stmt.get(), { __proto__: null, key: 'key1', value: 'val1' });
+    t.assert.deepStrictEqual(stmt.all(), [{ __proto__: null, key: 'key1', value: 'val1' }]);
+  });
 });
 
 suite('StatementSync.prototype.all()', () => {
@@ -0,0 +1,61 @@
+// Flags: --expose-internals
+'use strict';
+
+// A StreamPipe from a FileHandle to a TCP socket sends the file with
+// sendfile(). Check that the whole requested range arrives in order, also
+// when the receiver is slow enough for the socket to fill up.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { StreamPipe } = internalBinding('stream_pipe');
+const { FileHandle } = internalBinding('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = tmpdir.resolve('sendfile.bin');
+const data = Buffer.alloc(8 * 1024 * 1024);
+for (let i = 0; i < data.length; i += 4) data.writeUInt32LE(i, i);
+fs.writeFileSync(file, data);
+
+function test(offset, length, slow) {
+  const end = length < 0 ? data.length : offset + length;
+  const expected = data.subarray(offset, end);
+
+  const server = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => {
+      chunks.push(chunk);
+      if (slow) {
+        socket.pause();
+        setTimeout(() => socket.resume(), 1);
+      }
+    });
+    socket.on('end', common.mustCall(() => {
+      assert.ok(Buffer.concat(chunks).equals(expected));
+      server.close();
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port, common.mustCall(() => {
+      const fd = fs.openSync(file, 'r');
+      const handle = new FileHandle(fd, offset, length);
+      handle.onread = common.mustCall();
+      const pipe = new StreamPipe(handle, socket._handle);
+      pipe.onunpipe = common.mustCall(() => {
+        handle.releaseFD();
+        fs.closeSync(fd);
+      });
+      pipe.start();
+    }));
+    socket.resume();
+  }));
+}
+
+test(0, -1, false);
+test(12345, 3 * 1024 * 1024 + 7, false);
+test(100, -1, true);
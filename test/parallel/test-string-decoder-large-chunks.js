@@ -0,0 +1,43 @@
+'use strict';
+
+// ASCII chunks and large UTF-8 chunks are not decoded by V8. Check that the
+// strings are the same as those of Buffer#toString(), also when sequences are
+// split between chunks.
+
+require('../common');
+
+const assert = require('assert');
+const { StringDecoder } = require('string_decoder');
+
+function decodeInChunks(buf, chunkLength) {
+  const decoder = new StringDecoder('utf8');
+  let out = '';
+  for (let i = 0; i < buf.length; i += chunkLength)
+    out += decoder.write(buf.subarray(i, i + chunkLength));
+  return out + decoder.end();
+}
+
+const ascii = Buffer.from('line of text\n'.repeat(1000));
+assert.strictEqual(decodeInChunks(ascii, 4096), ascii.toString());
+assert.strictEqual(decodeInChunks(ascii, 7), ascii.toString());
+
+const size = 3 * 1024 * 1024;
+for (const sample of ['\u00e9t\u00e9 ', '\u20ac', '\u{1F600}', 'abc\u00e9']) {
+  const buf = Buffer.from(sample.repeat(size / Buffer.byteLength(sample)));
+  const expected = buf.toString();
+  for (const chunkLength of [size, 1024 * 1024 + 1, 1024 * 1024 * 2 - 1])
+    assert.strictEqual(decodeInChunks(buf, chunkLength), expected);
+}
+
+{
+  // Invalid UTF-8 in a large chunk is replaced like in smaller chunks.
+  const buf = Buffer.alloc(2 * 1024 * 1024, '\u00e9');
+  buf[1000] = 0xff;
+  buf[buf.length - 1] = 0xc3;
+  assert.strictEqual(decodeInChunks(buf, buf.length), buf.toString());
+
+  const decoder = new StringDecoder('utf8');
+  const str = decoder.write(buf);
+  assert.strictEqual(str, buf.subarray(0, -1).toString());
+  assert.strictEqual(decoder.end(), '\uFFFD');
+}
@@ -0,0 +1,119 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// Messages that only contain primitives, plain objects and dense arrays are
+// serialized in a compact format of their own. Make sure that the result is
+// the same as that of the regular format, including when the value turns out
+// to contain something else partway through.
+
+const shapes = [];
+for (let i = 0; i < 20; i++) {
+  shapes.push({ id: i, name: `item ${i}`, tags: ['a', 'b'], score: i / 3 });
+}
+
+for (const value of [
+  undefined, null, true, false, 0, -0, 1, -1, 2 ** 31, 1.5, NaN, Infinity,
+  '', 'latin1 \xff', 'two byte ☃', '\ud800',
+  [], [1, 'two', [3]], {}, { a: 1, b: { c: [null, undefined] } },
+  { 1: 'index', b: 'named', 0: 'first' },
+  JSON.parse('{"__proto__": 42}'),
+  shapes,
+  [{ a: 1, b: 2 }, { b: 2, a: 1 }, { a: 3, b: 4, c: 5 }],
+]) {
+  const clone = structuredClone(value);
+  assert.deepStrictEqual(clone, value);
+  if (typeof value === 'object' && value !== null) {
+    assert.notStrictEqual(clone, value);
+    assert.deepStrictEqual(Object.keys(clone), Object.keys(value));
+  }
+}
+
+// Objects without a prototype become regular objects.
+{
+  const value = { __proto__: null, x: 1 };
+  const clone = structuredClone(value);
+  assert.strictEqual(Object.getPrototypeOf(clone), Object.prototype);
+  assert.deepStrictEqual({ ...clone }, { x: 1 });
+}
+
+// Class instances and holes lose their prototype and are preserved,
+// respectively, like they are with the regular format.
+{
+  class Point {
+    constructor() {
+      this.x = 1;
+      this.y = 2;
+    }
+  }
+  const holes = [1, 2, 3];
+  delete holes[1];
+  const clone = structuredClone({ point: new Point(), holes });
+  assert.strictEqual(Object.getPrototypeOf(clone.point), Object.prototype);
+  assert.deepStrictEqual(clone.point, { x: 1, y: 2 });
+  assert.strictEqual(clone.holes.length, 3);
+  assert(!(1 in clone.holes));
+}
+
+// Shared references and cycles are kept.
+{
+  const shared = { value: 1 };
+  const value = { a: shared, b: shared, list: [shared] };
+  value.self = value;
+  const clone = structuredClone(value);
+  assert.strictEqual(clone.a, clone.b);
+  assert.strictEqual(clone.a, clone.list[0]);
+  assert.strictEqual(clone.self, clone);
+}
+
+// Exotic values nested deep inside plain data.
+{
+  const value = {
+    a: [1, 2, { date: new Date(0), map: new Map([[1, { b: 2 }]]) }],
+    big: 10n,
+    buffer: new Uint8Array([1, 2, 3]),
+  };
+  assert.deepStrictEqual(structuredClone(value), value);
+}
+
+// Arrays with named properties keep them.
+{
+  const value = [1, 2];
+  value.extra = 'yes';
+  assert.strictEqual(structuredClone(value).extra, 'yes');
+}
+
+// Errors for values that cannot be cloned are unchanged.
+assert.throws(() => structuredClone({ a: [1, { f() {} }] }), {
+  name: 'DataCloneError',
+});
+assert.throws(() => structuredClone({ a: Symbol('s') }), {
+  name: 'DataCloneError',
+});
+
+// Exceptions thrown by getters propagate.
+assert.throws(() => structuredClone({ get a() { throw new Error('boom'); } }), {
+  message: 'boom',
+});
+
+// Getters run exactly once, also when the value turns out to contain
+// something that needs the regular format afterwards.
+{
+  let calls = 0;
+  const value = {
+    get a() { calls++; return 1; },
+    b: new Map(),
+    list: [1, 2],
+  };
+  Object.defineProperty(value.list, 0, {
+    enumerable: true,
+    get() { calls++; return 'element'; },
+  });
+  const clone = structuredClone(value);
+  assert.strictEqual(calls, 2);
+  assert.deepStrictEqual(clone, { a: 1, b: new Map(), list: ['element', 2] });
+
+  calls = 0;
+  structuredClone({ x: { get y() { calls++; return [3]; } } });
+  assert.strictEqual(calls, 1);
+}
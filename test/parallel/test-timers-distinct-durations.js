@@ -0,0 +1,27 @@
+'use strict';
+
+// This tests that timers with many distinct durations, which are kept in
+// separate lists on the different levels of the timing wheel, fire in the
+// order of their expiry, and that cancelled ones do not fire.
+
+const common = require('../common');
+const assert = require('assert');
+
+const fired = [];
+
+for (let i = 0; i < 300; i++) {
+  // Durations spread across more than one level of the wheel.
+  const duration = 1 + (i * 37) % 300;
+  const timer = setTimeout(() => fired.push(duration), duration);
+  if (i % 10 === 0) {
+    clearTimeout(timer);
+  }
+}
+
+setTimeout(common.mustCall(() => {
+  assert.strictEqual(fired.length, 270);
+  for (let i = 1; i < fired.length; i++) {
+    assert(fired[i - 1] <= fired[i],
+           `${fired[i - 1]} fired after ${fired[i]}`);
+  }
+}), 400);
@@ -0,0 +1,81 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+}
+
+const { opensslCli } = require('../common/crypto');
+
+if (!opensslCli) {
+  common.skip('missing openssl cli');
+}
+
+// With the ocspCache option, a response that an 'OCSPRequest' listener
+// provides is stapled to later handshakes without emitting the event again.
+
+const assert = require('assert');
+const fs = require('fs');
+const tls = require('tls');
+const { execFileSync } = require('child_process');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+
+const key = fixtures.readKey('agent1-key.pem');
+const cert = fixtures.readKey('agent1-cert.pem');
+const ca = fixtures.readKey('ca1-cert.pem');
+
+assert.throws(() => tls.createServer({ key, cert, ocspCache: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+// A response of the test CA for agent1, valid for a day.
+tmpdir.refresh();
+fs.writeFileSync(tmpdir.resolve('index.txt'), '');
+execFileSync(opensslCli, [
+  'ocsp',
+  '-index', tmpdir.resolve('index.txt'),
+  '-rsigner', fixtures.path('keys', 'ca1-cert.pem'),
+  '-rkey', fixtures.path('keys', 'ca1-key.pem'),
+  '-passin', 'pass:password',
+  '-CA', fixtures.path('keys', 'ca1-cert.pem'),
+  '-issuer', fixtures.path('keys', 'ca1-cert.pem'),
+  '-cert', fixtures.path('keys', 'agent1-cert.pem'),
+  '-ndays', '1',
+  '-respout', tmpdir.resolve('response.der'),
+], { stdio: 'ignore' });
+const response = fs.readFileSync(tmpdir.resolve('response.der'));
+
+function connect(port, expected) {
+  return new Promise((resolve) => {
+    const client = tls.connect({
+      port,
+      ca,
+      servername: 'agent1',
+      requestOCSP: true,
+    }, common.mustCall(() => {
+      client.end();
+    }));
+    client.on('OCSPResponse', common.mustCall((resp) => {
+      assert.deepStrictEqual(resp, expected);
+    }));
+    client.on('close', resolve);
+  });
+}
+
+async function test(resp, requests) {
+  const server = tls.createServer({ key, cert, ocspCache: true });
+  server.on('OCSPRequest', common.mustCall((certificate, issuer, callback) => {
+    callback(null, resp);
+  }, requests));
+  await new Promise((resolve) => server.listen(0, resolve));
+  await connect(server.address().port, resp);
+  await connect(server.address().port, resp);
+  server.close();
+}
+
+(async () => {
+  // A response that cannot be parsed is stapled, but not cached.
+  await test(Buffer.from('not an OCSP response'), 2);
+  await test(response, 1);
+})().then(common.mustCall());
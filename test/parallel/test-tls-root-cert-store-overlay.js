@@ -0,0 +1,51 @@
+'use strict';
+
+// A SecureContext that uses the default root certificates gets a store of its
+// own when CAs are added to it. That store still trusts the default roots,
+// here ca1 through NODE_EXTRA_CA_CERTS, and the added CAs do not leak into
+// other contexts.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fixtures = require('../common/fixtures');
+
+if (process.argv[2] !== 'child') {
+  const { status, stderr } = spawnSync(process.execPath, [__filename, 'child'], {
+    env: {
+      ...process.env,
+      NODE_EXTRA_CA_CERTS: fixtures.path('keys', 'ca1-cert.pem'),
+    },
+  });
+  assert.strictEqual(status, 0, stderr.toString());
+  return;
+}
+
+const { connect, keys, tls } = require(fixtures.path('tls-connect'));
+
+const defaultContext = tls.createSecureContext({});
+const overlayContext = tls.createSecureContext({});
+overlayContext.context.addCACert(keys.agent3.ca);
+
+function check(agent, secureContext, expectedError) {
+  return new Promise((resolve) => {
+    connect({
+      client: { secureContext, servername: agent, rejectUnauthorized: true },
+      server: { key: keys[agent].key, cert: keys[agent].cert },
+    }, common.mustCall((err, pair, cleanup) => {
+      assert.strictEqual(err?.code, expectedError);
+      cleanup();
+      resolve();
+    }));
+  });
+}
+
+(async () => {
+  await check('agent1', overlayContext, undefined);
+  await check('agent3', overlayContext, undefined);
+  await check('agent1', defaultContext, undefined);
+  await check('agent3', defaultContext, 'UNABLE_TO_VERIFY_LEAF_SIGNATURE');
+})().then(common.mustCall());
@@ -0,0 +1,137 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Servers that share a tls.SessionCache, also across worker threads, resume
+// each other's sessions, both by session ID and by ticket.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { SSL_OP_NO_TICKET } = require('crypto').constants;
+const { Worker, isMainThread, parentPort, workerData } =
+  require('worker_threads');
+
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  sessionIdContext: 'test-tls-shared-session-cache',
+};
+
+function listen(extraOptions) {
+  return new Promise((resolve) => {
+    const server = tls.createServer({ ...options, ...extraOptions }, (socket) => {
+      socket.end('x');
+    });
+    server.listen(0, () => resolve(server));
+  });
+}
+
+if (!isMainThread) {
+  listen({
+    sessionCache: workerData.sessionCache,
+    secureOptions: SSL_OP_NO_TICKET,
+  }).then((server) => {
+    parentPort.postMessage(server.address().port);
+    parentPort.once('message', () => server.close());
+  });
+  return;
+}
+
+function connect(port, session, extraOptions) {
+  return new Promise((resolve) => {
+    let reused;
+    let firstSession;
+    const client = tls.connect({
+      port,
+      session,
+      rejectUnauthorized: false,
+      ...extraOptions,
+    }, () => {
+      reused = client.isSessionReused();
+    });
+    client.on('session', (session) => {
+      firstSession ??= session;
+    });
+    client.resume();
+    client.on('close', () => resolve({ reused, session: firstSession }));
+  });
+}
+
+assert.throws(() => new tls.SessionCache({ maxSessions: 0 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => tls.createSecureContext({ sessionCache: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => new tls.SessionCache().setTicketKeys(Buffer.alloc(32)), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+
+(async () => {
+  // Session IDs, shared with a server on a worker thread.
+  {
+    const sessionCache = new tls.SessionCache();
+    const worker = new Worker(__filename, { workerData: { sessionCache } });
+    const [workerPort] = await new Promise((resolve) => {
+      worker.once('message', (port) => resolve([port]));
+    });
+    const server = await listen({
+      sessionCache,
+      secureOptions: SSL_OP_NO_TICKET,
+    });
+    const clientOptions = { maxVersion: 'TLSv1.2' };
+
+    const first = await connect(server.address().port, undefined, clientOptions);
+    assert.strictEqual(first.reused, false);
+    assert.strictEqual(sessionCache.size, 1);
+
+    const second = await connect(workerPort, first.session, clientOptions);
+    assert.strictEqual(second.reused, true);
+
+    sessionCache.clear();
+    assert.strictEqual(sessionCache.size, 0);
+    const third = await connect(workerPort, first.session, clientOptions);
+    assert.strictEqual(third.reused, false);
+
+    server.close();
+    worker.postMessage('close');
+  }
+
+  // Session tickets, with key rotation.
+  {
+    const sessionCache = new tls.SessionCache();
+    const servers = [
+      await listen({ sessionCache }),
+      await listen({ sessionCache }),
+    ];
+    const [port1, port2] = servers.map((server) => server.address().port);
+
+    const keys = sessionCache.getTicketKeys();
+    assert.strictEqual(keys.length, 48);
+    assert.deepStrictEqual(servers[0].getTicketKeys(), keys);
+
+    const first = await connect(port1);
+    assert.strictEqual(first.reused, false);
+    assert.strictEqual((await connect(port2, first.session)).reused, true);
+
+    // Tickets issued with the previous keys are still accepted.
+    sessionCache.rotateTicketKeys();
+    assert.notDeepStrictEqual(sessionCache.getTicketKeys(), keys);
+    assert.deepStrictEqual(servers[1].getTicketKeys(),
+                           sessionCache.getTicketKeys());
+    assert.strictEqual((await connect(port2, first.session)).reused, true);
+
+    // But not once the keys have been replaced twice.
+    sessionCache.rotateTicketKeys();
+    assert.strictEqual((await connect(port1, first.session)).reused, false);
+
+    sessionCache.setTicketKeys(keys);
+    assert.deepStrictEqual(sessionCache.getTicketKeys(), keys);
+    assert.strictEqual((await connect(port1, first.session)).reused, true);
+
+    for (const server of servers)
+      server.close();
+  }
+})().then(common.mustCall());
@@ -0,0 +1,42 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Corked writes mixing small buffers with ones that fill whole TLS records
+// are encrypted partly in place and partly coalesced. Check that the data
+// arrives complete and in order.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const sizes = [5, 40 * 1024, 1, 2, 16 * 1024, 16 * 1024 - 1, 100 * 1024, 3];
+const chunks = sizes.map((size, i) => Buffer.alloc(size, `${i}`));
+const expected = Buffer.concat(chunks);
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+}, common.mustCall((socket) => {
+  socket.cork();
+  for (const chunk of chunks)
+    socket.write(chunk);
+  socket.write('tail');
+  socket.uncork();
+  socket.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+  });
+  const received = [];
+  client.on('data', (data) => received.push(data));
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(received),
+                           Buffer.concat([expected, Buffer.from('tail')]));
+    server.close();
+  }));
+}));
@@ -0,0 +1,51 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { eventLoopStalls } = require('perf_hooks');
+const { spawnSyncAndAssert } = require('../common/child_process');
+
+// Test that --trace-event-loop-stalls prints a stack trace for a callback
+// that blocks the event loop for longer than the threshold, and that
+// perf_hooks.eventLoopStalls() counts it.
+
+function blockTheLoop() {
+  const start = Date.now();
+  while (Date.now() - start < 500);
+}
+
+if (process.argv[2] === 'child') {
+  setTimeout(common.mustCall(() => {
+    blockTheLoop();
+    setTimeout(common.mustCall(() => {
+      const { count, maxDuration } = eventLoopStalls();
+      console.log(JSON.stringify({ count, maxDuration }));
+    }), 100);
+  }), 1);
+  return;
+}
+
+// Without the option, nothing is detected.
+assert.deepStrictEqual(eventLoopStalls(), { count: 0, maxDuration: 0 });
+
+spawnSyncAndAssert(process.execPath, [
+  '--trace-event-loop-stalls=100',
+  __filename,
+  'child',
+], {
+  stdout(output) {
+    const { count, maxDuration } = JSON.parse(output);
+    assert.strictEqual(count, 1);
+    assert(maxDuration >= 100, `${maxDuration} < 100`);
+  },
+  stderr: /WARNING: Detected an event loop stall of more than 100 ms[\s\S]*blockTheLoop/,
+});
+
+// Idle time is not a stall.
+spawnSyncAndAssert(process.execPath, [
+  '--trace-event-loop-stalls=50',
+  '-e',
+  'setTimeout(() => console.log(require("perf_hooks").eventLoopStalls().count), 300)',
+], {
+  stdout: '0',
+  stderr: '',
+});
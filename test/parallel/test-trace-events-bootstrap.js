@@ -12,6 +12,13 @@ const names = [
   'loopStart',
   'loopExit',
   'bootstrapComplete',
+  'optionParsing',
+  'icuInitialization',
+  'v8Initialization',
+  'snapshotDeserialization',
+  'bindingInitialization',
+  'builtinCompilation',
+  'userModuleLoading',
 ];
 
 if (process.argv[2] === 'child') {
@@ -0,0 +1,68 @@
+'use strict';
+
+// This tests that --trace-event-format=perfetto writes the trace events as a
+// binary Perfetto trace.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+
+tmpdir.refresh();
+
+const CODE = `
+  const { performance } = require('perf_hooks');
+  performance.mark('perfetto-mark-a');
+  performance.mark('perfetto-mark-b');
+  performance.measure('perfetto-measure', 'perfetto-mark-a', 'perfetto-mark-b');
+`;
+
+const proc = cp.spawn(process.execPath, [
+  '--trace-event-categories', 'node.perf.usertiming',
+  '--trace-event-format', 'perfetto',
+  '-e', CODE,
+], { cwd: tmpdir.path });
+
+proc.once('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  const file = tmpdir.resolve('node_trace.1.log');
+  assert(fs.existsSync(file));
+  const data = fs.readFileSync(file);
+
+  // Every field of the Trace message is a TracePacket, field 1 with wire
+  // type 2 (length-delimited).
+  let offset = 0;
+  let packets = 0;
+  while (offset < data.length) {
+    assert.strictEqual(data[offset++], 0x0a);
+    let length = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = data[offset++];
+      length += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    offset += length;
+    packets++;
+  }
+  assert.strictEqual(offset, data.length);
+  assert(packets > 0);
+
+  const text = data.toString('latin1');
+  assert(text.includes('perfetto-mark-a'));
+  assert(text.includes('perfetto-mark-b'));
+  assert(text.includes('perfetto-measure'));
+  assert(text.includes('node.perf.usertiming'));
+  assert(!text.includes('traceEvents'));
+}));
+
+{
+  const child = cp.spawnSync(process.execPath, [
+    '--trace-event-format', 'xml', '-e', '',
+  ]);
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr.toString(),
+               /invalid value for --trace-event-format: xml/);
+}
@@ -0,0 +1,75 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { parseMany } = require('url');
+
+{
+  const inputs = [
+    'https://example.org/a?b#c',
+    'HTTP://EXAMPLE.ORG:80/./x/../y',
+    'not a url',
+    'file:///tmp/x',
+    'https://user:pass@[::1]:8443/',
+  ];
+  const results = parseMany(inputs);
+  assert.strictEqual(results.length, inputs.length);
+
+  for (let i = 0; i < inputs.length; i++) {
+    const expected = URL.parse(inputs[i]);
+    if (expected === null) {
+      assert.strictEqual(results.href(i), null);
+      assert.strictEqual(results.url(i), null);
+      continue;
+    }
+    assert.strictEqual(results.href(i), expected.href);
+    const url = results.url(i);
+    assert.ok(url instanceof URL);
+    assert.deepStrictEqual(url, expected);
+    for (const key of ['protocol', 'username', 'password', 'host', 'hostname',
+                       'port', 'pathname', 'search', 'hash', 'origin']) {
+      assert.strictEqual(url[key], expected[key]);
+    }
+  }
+
+  assert.deepStrictEqual([...results].map((url) => url?.href ?? null),
+                         inputs.map((input) => URL.parse(input)?.href ?? null));
+  assert.notStrictEqual(results.url(0), results.url(0));
+  assert.strictEqual(results.href(inputs.length), null);
+  assert.strictEqual(results.url(inputs.length), null);
+}
+
+{
+  const results = parseMany(['/a', '../b?c', 'https://other.org/', 5],
+                            new URL('https://example.com/x/y'));
+  assert.deepStrictEqual(
+    [0, 1, 2, 3].map((i) => results.href(i)),
+    [
+      'https://example.com/a',
+      'https://example.com/b?c',
+      'https://other.org/',
+      'https://example.com/x/5',
+    ]);
+
+  // URLs created from the batch can still be modified.
+  const url = results.url(1);
+  url.searchParams.append('d', 'e');
+  url.hash = 'f';
+  assert.strictEqual(url.href, 'https://example.com/b?c=&d=e#f');
+  assert.strictEqual(results.href(1), 'https://example.com/b?c');
+}
+
+assert.strictEqual(parseMany([]).length, 0);
+
+assert.throws(() => parseMany(['/a'], 'not a url'), {
+  code: 'ERR_INVALID_URL',
+  name: 'TypeError',
+});
+assert.throws(() => parseMany('https://example.org/'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => parseMany(['https://example.org/']).url(-1), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => parseMany(['https://example.org/']).href('0'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
@@ -0,0 +1,79 @@
+'use strict';
+
+require('../common');
+
+const assert = require('assert');
+const { URLPattern, URLPatternList } = require('url');
+
+const patterns = [
+  new URLPattern({ pathname: '/users/:id' }),
+  new URLPattern({ pathname: '/users/:id/posts/:post' }),
+  new URLPattern({ pathname: '/docs{/:page}?' }),
+  new URLPattern({ pathname: '/files/*' }),
+  new URLPattern({ pathname: '/ABOUT' }, { ignoreCase: true }),
+  new URLPattern({ hostname: 'api.example.org' }),
+];
+const list = new URLPatternList(patterns);
+assert.strictEqual(list.length, patterns.length);
+
+// The result is the first pattern in the list that matches, with the same
+// result as URLPattern.prototype.exec().
+for (const input of [
+  'https://example.org/users/42',
+  'https://example.org/users/42/posts/7',
+  'https://example.org/docs',
+  'https://example.org/docs/intro',
+  'https://example.org/files/a/b.txt',
+  'https://example.org/about',
+  'https://api.example.org/anything',
+  'https://example.org/nothing',
+  'https://example.org/users',
+  'not a url',
+  { pathname: '/users/1' },
+  { hostname: 'api.example.org' },
+  { pathname: '/nothing' },
+]) {
+  const index = patterns.findIndex((pattern) => pattern.test(input));
+  const match = list.exec(input);
+  assert.strictEqual(list.test(input), index !== -1);
+  if (index === -1) {
+    assert.strictEqual(match, null);
+    continue;
+  }
+  assert.strictEqual(match.index, index);
+  assert.deepStrictEqual(match.result, patterns[index].exec(input));
+}
+
+{
+  const match = list.exec('/users/42/posts/7', 'https://example.org');
+  assert.strictEqual(match.index, 1);
+  assert.deepStrictEqual(match.result.pathname.groups, { id: '42', post: '7' });
+  assert.strictEqual(list.exec('/users/42', 'not a url'), null);
+}
+
+// Patterns are kept in their original order.
+{
+  const ordered = new URLPatternList([
+    new URLPattern({ pathname: '/*' }),
+    new URLPattern({ pathname: '/users/:id' }),
+  ]);
+  assert.strictEqual(ordered.exec('https://example.org/users/1').index, 0);
+}
+
+assert.strictEqual(new URLPatternList([]).exec('https://example.org/'), null);
+
+assert.throws(() => URLPatternList([]), {
+  code: 'ERR_CONSTRUCT_CALL_REQUIRED',
+});
+assert.throws(() => new URLPatternList(), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => new URLPatternList([{ pathname: '/' }]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => list.exec(1), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => list.test('https://example.org', 1), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
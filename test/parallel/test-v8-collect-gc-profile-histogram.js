@@ -0,0 +1,75 @@
+// Flags: --expose-gc
+'use strict';
+require('../common');
+const assert = require('assert');
+const { GCProfiler } = require('v8');
+
+const gcTypes = [
+  'Scavenge',
+  'MinorMarkSweep',
+  'MarkSweepCompact',
+  'IncrementalMarking',
+  'ProcessWeakCallbacks',
+];
+
+function checkStatistics(stats) {
+  assert.ok(stats.startTime > 0);
+  assert.deepStrictEqual(Object.keys(stats.gcTypes).sort(), gcTypes.sort());
+  for (const type of gcTypes) {
+    const item = stats.gcTypes[type];
+    for (const value of Object.values(item)) {
+      assert.ok(value >= 0);
+    }
+    assert.ok(item.pauseMin <= item.pauseMax);
+    assert.ok(item.pauseTotal >= item.pauseMax);
+  }
+  for (const item of Object.values(stats.heapSpaces)) {
+    for (const value of Object.values(item)) {
+      assert.ok(value >= 0);
+    }
+    assert.ok(item.bytesFreed >= item.bytesFreedMax);
+  }
+}
+
+{
+  const profiler = new GCProfiler({ mode: 'histogram' });
+  assert.strictEqual(profiler.getStatistics(), undefined);
+  profiler.start();
+
+  for (let i = 0; i < 100; i++) {
+    new Array(100);
+  }
+  global.gc();
+
+  // The statistics can be sampled while the profiler is running.
+  const running = profiler.getStatistics();
+  checkStatistics(running);
+  const total = Object.values(running.gcTypes)
+    .reduce((sum, { count }) => sum + count, 0);
+  assert.ok(total >= 1);
+  assert.ok(running.gcTypes.MarkSweepCompact.count >= 1);
+
+  global.gc();
+  const stopped = profiler.stop();
+  checkStatistics(stopped);
+  assert.ok(stopped.gcTypes.MarkSweepCompact.count >
+            running.gcTypes.MarkSweepCompact.count);
+  assert.strictEqual(profiler.getStatistics(), undefined);
+}
+
+{
+  const profiler = new GCProfiler();
+  assert.throws(() => profiler.getStatistics(), {
+    code: 'ERR_INVALID_STATE',
+  });
+}
+
+[null, 'histogram'].forEach((options) => {
+  assert.throws(() => new GCProfiler(options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+});
+
+assert.throws(() => new GCProfiler({ mode: 'text' }), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
@@ -0,0 +1,36 @@
+'use strict';
+
+// Tests v8.getNativeMemoryStatistics().
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const v8 = require('v8');
+const zlib = require('zlib');
+
+function count(stats, name) {
+  return stats[name]?.count ?? 0;
+}
+
+const before = v8.getNativeMemoryStatistics();
+assert.strictEqual(Object.getPrototypeOf(before), null);
+assert.strictEqual(before.Environment.count, 1);
+for (const name of Object.keys(before)) {
+  const { count, size } = before[name];
+  assert(Number.isSafeInteger(count) && count >= 0, name);
+  assert(Number.isSafeInteger(size) && size >= 0, name);
+}
+
+const streams = Array.from({ length: 5 }, () => zlib.createGzip());
+const server = net.createServer();
+server.listen(0, common.mustCall(() => {
+  const after = v8.getNativeMemoryStatistics();
+  assert.strictEqual(count(after, 'TCPServerWrap'),
+                     count(before, 'TCPServerWrap') + 1);
+  assert.strictEqual(count(after, 'ZlibStream'),
+                     count(before, 'ZlibStream') + streams.length);
+  assert(after.ZlibStream.size > 0);
+
+  for (const stream of streams) stream.close();
+  server.close();
+}));
@@ -0,0 +1,96 @@
+'use strict';
+require('../common');
+
+// This test checks that DefaultSerializer can write large typed arrays as
+// external segments, and that the output is the same as without them.
+
+const assert = require('assert');
+const v8 = require('v8');
+
+const tensor = new Float64Array(64 * 1024).map((_, i) => i);
+const small = new Uint8Array([1, 2, 3]);
+const value = { tensor, small, again: tensor, tail: 'end' };
+const expected = v8.serialize(value);
+
+function serializer(options) {
+  const ser = new v8.DefaultSerializer(options);
+  ser.writeHeader();
+  ser.writeValue(value);
+  return ser;
+}
+
+{
+  const buffers = serializer({ externalThreshold: 1024 }).releaseBuffers();
+  assert.ok(Array.isArray(buffers));
+  assert.ok(buffers.length > 1);
+  for (const buf of buffers) assert.ok(Buffer.isBuffer(buf));
+  // The large array has not been copied.
+  const external = buffers.find((buf) => buf.buffer === tensor.buffer);
+  assert.ok(external);
+  assert.strictEqual(external.byteOffset, tensor.byteOffset);
+  assert.strictEqual(external.length, tensor.byteLength);
+  // Small arrays are copied as usual.
+  assert.ok(!buffers.some((buf) => buf.buffer === small.buffer));
+
+  const joined = Buffer.concat(buffers);
+  assert.deepStrictEqual(joined, expected);
+  assert.deepStrictEqual(v8.deserialize(joined), value);
+}
+
+// releaseBuffer() joins the segments.
+assert.deepStrictEqual(
+  serializer({ externalThreshold: 0 }).releaseBuffer(), expected);
+assert.deepStrictEqual(
+  v8.serialize(value, { externalThreshold: 1024 }), expected);
+
+// Without external segments, releaseBuffers() returns a single buffer.
+{
+  const buffers = serializer().releaseBuffers();
+  assert.strictEqual(buffers.length, 1);
+  assert.deepStrictEqual(buffers[0], expected);
+}
+
+// The buffer size hint does not change the output.
+for (const bufferSize of [0, 16, expected.length, expected.length * 2]) {
+  assert.deepStrictEqual(v8.serialize(value, { bufferSize }), expected);
+  assert.deepStrictEqual(
+    Buffer.concat(serializer({ bufferSize, externalThreshold: 1024 })
+      .releaseBuffers()),
+    expected);
+}
+
+// Memory that is shared with other threads is always copied.
+{
+  const shared = new Uint8Array(new SharedArrayBuffer(4096)).fill(7);
+  const ser = new v8.Serializer();
+  ser.writeHeader();
+  ser.writeExternalBytes(shared);
+  const buffers = ser.releaseBuffers();
+  assert.strictEqual(buffers.length, 1);
+  assert.ok(buffers[0].subarray(-4096).every((byte) => byte === 7));
+}
+
+{
+  const ser = new v8.Serializer();
+  assert.deepStrictEqual(ser.releaseBuffers(), []);
+  assert.throws(() => ser.writeExternalBytes('abc'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+for (const options of [null, 1, 'a']) {
+  assert.throws(() => new v8.DefaultSerializer(options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+for (const name of ['bufferSize', 'externalThreshold']) {
+  assert.throws(() => new v8.DefaultSerializer({ [name]: '1' }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  for (const bad of [-1, 1.5, Infinity]) {
+    assert.throws(() => new v8.DefaultSerializer({ [name]: bad }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+  }
+}
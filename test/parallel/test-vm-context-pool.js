@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common');
+
+// This test checks that contexts handed out from the pool behave like
+// freshly created ones.
+
+const assert = require('assert');
+const vm = require('vm');
+
+for (const size of [-1, 1.5, 2 ** 32, '1', null]) {
+  assert.throws(() => vm.setContextPoolSize(size), {
+    code: /^ERR_(OUT_OF_RANGE|INVALID_ARG_TYPE)$/,
+  });
+}
+
+vm.setContextPoolSize(4);
+
+const contexts = [];
+for (let i = 0; i < 10; i++) {
+  const context = vm.createContext({ i });
+  assert.ok(vm.isContext(context));
+  assert.strictEqual(vm.runInContext('globalThis.x = i * 2; x', context), i * 2);
+  assert.strictEqual(context.x, i * 2);
+  assert.strictEqual(vm.runInContext('typeof require', context), 'undefined');
+  contexts.push(context);
+}
+
+// Contexts are never shared.
+const arrays = contexts.map((context) => vm.runInContext('Array', context));
+assert.strictEqual(new Set(arrays).size, arrays.length);
+assert.notStrictEqual(arrays[0], Array);
+
+// Contexts with their own microtask queue and vanilla contexts are not taken
+// from the pool.
+{
+  const context = vm.createContext({}, { microtaskMode: 'afterEvaluate' });
+  vm.runInContext('Promise.resolve(1).then((v) => globalThis.r = v)', context);
+  assert.strictEqual(context.r, 1);
+  const vanilla = vm.createContext(vm.constants.DONT_CONTEXTIFY);
+  assert.strictEqual(vm.runInContext('1 + 1', vanilla), 2);
+}
+
+// The pool is refilled asynchronously.
+setImmediate(common.mustCall(() => {
+  const context = vm.createContext({ name: 'refilled' });
+  assert.strictEqual(vm.runInContext('name', context), 'refilled');
+  vm.setContextPoolSize(0);
+  assert.strictEqual(vm.runInContext('1', vm.createContext()), 1);
+}));
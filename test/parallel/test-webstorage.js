@@ -110,6 +110,77 @@ test('localStorage is persisted if it is used', async () => {
   assert.match(cp.stdout, /barbaz/);
 });
 
+describe('--localstorage-write-back', () => {
+  test('commits writes at the end of the tick', async () => {
+    const localStorageFile = nextLocalStorage();
+    let cp = await spawnPromisified(process.execPath, [
+      '--experimental-webstorage',
+      '--localstorage-write-back',
+      '--localstorage-file', localStorageFile,
+      '-e', `
+      localStorage.clear();
+      for (let i = 0; i < 10; i++) localStorage.setItem(i, i * 2);
+      localStorage.removeItem('3');
+      console.log(localStorage.length, localStorage.getItem('4'));
+      setImmediate(() => { localStorage.foo = 'barbaz'; });
+      `,
+    ]);
+    assert.strictEqual(cp.code, 0);
+    assert.strictEqual(cp.stdout, '9 8\n');
+
+    cp = await spawnPromisified(process.execPath, [
+      '--experimental-webstorage',
+      '--localstorage-file', localStorageFile,
+      '-pe', 'Object.keys(localStorage).sort().join()',
+    ]);
+    assert.strictEqual(cp.code, 0);
+    assert.strictEqual(cp.stdout, '0,1,2,4,5,6,7,8,9,foo\n');
+  });
+
+  test('commits writes on process.exit()', async () => {
+    const localStorageFile = nextLocalStorage();
+    let cp = await spawnPromisified(process.execPath, [
+      '--experimental-webstorage',
+      '--localstorage-write-back',
+      '--localstorage-file', localStorageFile,
+      '-e', 'localStorage.foo = "barbaz"; process.exit(0)',
+    ]);
+    assert.strictEqual(cp.code, 0);
+
+    cp = await spawnPromisified(process.execPath, [
+      '--experimental-webstorage',
+      '--localstorage-file', localStorageFile,
+      '-pe', 'localStorage.foo',
+    ]);
+    assert.strictEqual(cp.code, 0);
+    assert.match(cp.stdout, /barbaz/);
+  });
+
+  test('sees writes of other processes', async () => {
+    const localStorageFile = nextLocalStorage();
+    const cp = await spawnPromisified(process.execPath, [
+      '--experimental-webstorage',
+      '--localstorage-write-back',
+      '--localstorage-file', localStorageFile,
+      '-e', `
+      const { execFileSync } = require('node:child_process');
+      localStorage.foo = 'a';
+      setImmediate(() => {
+        console.log(localStorage.foo, localStorage.length);
+        execFileSync(process.execPath, [
+          '--experimental-webstorage',
+          '--localstorage-file', ${JSON.stringify(localStorageFile)},
+          '-e', 'localStorage.foo = "b"; localStorage.bar = "c"',
+        ]);
+        console.log(localStorage.foo, localStorage.length);
+      });
+      `,
+    ]);
+    assert.strictEqual(cp.code, 0);
+    assert.strictEqual(cp.stdout, 'a 1\nb 2\n');
+  });
+});
+
 
 describe('webstorage quota for localStorage and sessionStorage', () => {
   const MAX_STORAGE_SIZE = 10 * 1024 * 1024;
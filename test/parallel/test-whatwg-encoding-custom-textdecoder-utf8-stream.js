@@ -0,0 +1,86 @@
+'use strict';
+
+// UTF-8 is decoded natively with the stream option. Check sequences that
+// are split between chunks against decoding all of the bytes at once.
+
+require('../common');
+
+const assert = require('assert');
+
+const samples = [
+  '\uFEFFa\u00e9\u20ac\u{1F600}z',
+  'ascii only, which is long enough to not fit in a single small chunk',
+  Buffer.from([0xef, 0xbb, 0xbf, 0xef, 0xbb, 0xbf, 0x41]),
+  Buffer.from([0xe2, 0x82, 0x41, 0xf0, 0x9f, 0x98, 0xc2]),
+  Buffer.from([0xed, 0xa0, 0x80, 0xe0, 0x80, 0xf4, 0x90, 0x80, 0x80, 0xff]),
+  Buffer.from([0xf0, 0x9f, 0x98]),
+];
+
+function decodeInChunks(bytes, splits, options) {
+  const decoder = new TextDecoder('utf-8', options);
+  let out = '';
+  let start = 0;
+  for (const end of splits) {
+    out += decoder.decode(bytes.subarray(start, end), { stream: true });
+    start = end;
+  }
+  return out + decoder.decode(bytes.subarray(start));
+}
+
+for (const sample of samples) {
+  const bytes = Buffer.from(sample);
+  for (const ignoreBOM of [false, true]) {
+    const expected = new TextDecoder('utf-8', { ignoreBOM }).decode(bytes);
+    for (let i = 0; i <= bytes.length; i++) {
+      assert.strictEqual(decodeInChunks(bytes, [i], { ignoreBOM }), expected);
+      for (let j = i; j <= bytes.length; j++) {
+        assert.strictEqual(decodeInChunks(bytes, [i, j], { ignoreBOM }),
+                           expected);
+      }
+    }
+    // One byte at a time.
+    const splits = Array.from({ length: bytes.length }, (_, i) => i + 1);
+    assert.strictEqual(decodeInChunks(bytes, splits, { ignoreBOM }), expected);
+  }
+}
+
+{
+  // The decoder can be used again after the end of a stream, and the BOM is
+  // stripped again at the start of the next stream.
+  const decoder = new TextDecoder();
+  assert.strictEqual(decoder.decode(Buffer.from([0xef, 0xbb]),
+                                    { stream: true }), '');
+  assert.strictEqual(decoder.decode(Buffer.from([0xbf, 0xe2, 0x82]),
+                                    { stream: true }), '');
+  assert.strictEqual(decoder.decode(Buffer.from([0xac])), '\u20ac');
+  assert.strictEqual(decoder.decode(Buffer.from([0xef, 0xbb, 0xbf, 0x41]),
+                                    { stream: true }), 'A');
+  // An incomplete sequence at the end of the stream is replaced.
+  assert.strictEqual(decoder.decode(Buffer.from([0xf0, 0x9f]),
+                                    { stream: true }), '');
+  assert.strictEqual(decoder.decode(), '\uFFFD');
+  assert.strictEqual(decoder.decode(Buffer.from('\uFEFFb')), 'b');
+}
+
+{
+  const decoder = new TextDecoder('utf-8', { fatal: true });
+  assert.strictEqual(decoder.decode(Buffer.from([0xf0, 0x9f, 0x98]),
+                                    { stream: true }), '');
+  assert.throws(() => decoder.decode(Buffer.from([0x41]), { stream: true }), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+  });
+  // The state is reset after an error.
+  assert.strictEqual(decoder.decode(Buffer.from('A'),
+                                    { stream: true }), 'A');
+  assert.strictEqual(decoder.decode(Buffer.from([0xe2, 0x82]),
+                                    { stream: true }), '');
+  assert.throws(() => decoder.decode(), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+  });
+  assert.strictEqual(decoder.decode(new Uint8Array([0xe2, 0x82, 0xac])),
+                     '\u20ac');
+}
+
+assert.throws(() => new TextDecoder().decode('a', { stream: true }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
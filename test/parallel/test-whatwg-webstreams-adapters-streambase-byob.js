@@ -0,0 +1,105 @@
+// Flags: --expose-internals --no-warnings
+'use strict';
+
+const common = require('../common');
+
+const assert = require('assert');
+
+const {
+  internalBinding,
+} = require('internal/test/binding');
+
+const {
+  newWritableStreamFromStreamBase,
+  newReadableStreamFromStreamBase,
+} = require('internal/webstreams/adapters');
+
+const {
+  JSStream
+} = internalBinding('js_stream');
+
+const { UV_EPIPE } = internalBinding('uv');
+
+// Data is read straight into the views of BYOB requests.
+(async () => {
+  const stream = new JSStream();
+  const readable = newReadableStreamFromStreamBase(stream, undefined, {
+    ondone: common.mustCall(),
+  });
+  const reader = readable.getReader({ mode: 'byob' });
+
+  const chunk = reader.read(new Uint8Array(3));
+  stream.readBuffer(Buffer.from('hello'));
+  let { done, value } = await chunk;
+  assert(!done);
+  assert.deepStrictEqual(value, new Uint8Array(Buffer.from('hel')));
+
+  // The rest of the data has been buffered.
+  ({ done, value } = await reader.read(new Uint8Array(10)));
+  assert(!done);
+  assert.deepStrictEqual(value, new Uint8Array(Buffer.from('lo')));
+
+  stream.emitEOF();
+  ({ done, value } = await reader.read(new Uint8Array(10)));
+  assert(done);
+  assert.strictEqual(value.byteLength, 0);
+})().then(common.mustCall());
+
+// Data that arrives while no read is pending is not lost, and EOF is only
+// reported after it has been read.
+(async () => {
+  const stream = new JSStream();
+  const readable = newReadableStreamFromStreamBase(stream);
+  const reader = readable.getReader();
+
+  const first = reader.read();
+  stream.readBuffer(Buffer.from('abc'));
+  stream.readBuffer(Buffer.from('def'));
+  stream.emitEOF();
+
+  const chunks = [];
+  for (let result = await first; !result.done; result = await reader.read())
+    chunks.push(result.value);
+  assert.ok(chunks.every((chunk) => chunk instanceof Uint8Array));
+  assert.strictEqual(Buffer.concat(chunks).toString(), 'abcdef');
+})().then(common.mustCall());
+
+// Writes that complete asynchronously, synchronously, or fail.
+(async () => {
+  const stream = new JSStream();
+  const written = [];
+  let status = 0;
+  let sync = false;
+  stream.onwrite = common.mustCall((req, bufs) => {
+    written.push(...bufs);
+    if (sync)
+      stream.finishWrite(req, status);
+    else
+      setImmediate(() => stream.finishWrite(req, status));
+  }, 5);
+  stream.onshutdown = common.mustCall((req) => {
+    setImmediate(() => stream.finishShutdown(req, 0));
+  });
+
+  const writable = newWritableStreamFromStreamBase(stream);
+  const writer = writable.getWriter();
+  await writer.write(Buffer.from('a'));
+  await writer.write(new Uint16Array([0x6262]));
+  sync = true;
+  await writer.write(new TextEncoder().encode('c').buffer);
+  await writer.write(Buffer.from('d'));
+  assert.strictEqual(Buffer.concat(written).toString(), 'abbcd');
+
+  await assert.rejects(writer.write('e'), { code: 'ERR_INVALID_ARG_TYPE' });
+
+  const other = new JSStream();
+  other.onwrite = common.mustCall((req) => {
+    setImmediate(() => other.finishWrite(req, UV_EPIPE));
+  });
+  const failing = newWritableStreamFromStreamBase(other).getWriter();
+  await assert.rejects(failing.write(Buffer.from('x')), { code: 'EPIPE' });
+
+  const last = newWritableStreamFromStreamBase(stream).getWriter();
+  await last.write(Buffer.from('e'));
+  await last.close();
+})().then(common.mustCall());
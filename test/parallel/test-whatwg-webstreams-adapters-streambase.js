@@ -22,7 +22,7 @@ const {
   const stream = new JSStream();
   stream.onwrite = common.mustCall((req, buf) => {
     assert.deepStrictEqual(buf[0], Buffer.from('hello'));
-    req.oncomplete();
+    setImmediate(() => stream.finishWrite(req, 0));
   });
 
   const writable = newWritableStreamFromStreamBase(stream);
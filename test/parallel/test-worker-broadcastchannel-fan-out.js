@@ -0,0 +1,50 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+// A message that is broadcast to many threads is serialized once and shared
+// by all receivers, each of which deserializes its own copy.
+
+const kWorkers = 8;
+const sab = new SharedArrayBuffer(4);
+const message = { kind: 'invalidate', keys: ['a', 'b'], shared: sab };
+
+const channel = new BroadcastChannel('test-fan-out');
+const replies = new BroadcastChannel('test-fan-out-replies');
+let ready = 0;
+let received = 0;
+replies.onmessage = common.mustCall(({ data }) => {
+  if (data === 'ready') {
+    if (++ready === kWorkers) {
+      new Uint32Array(sab)[0] = 42;
+      channel.postMessage(message);
+    }
+    return;
+  }
+  assert.deepStrictEqual(data, { kind: 'invalidate', keys: ['a', 'b', 'local'],
+                                 value: 42 });
+  if (++received === kWorkers) {
+    channel.close();
+    replies.close();
+  }
+}, kWorkers * 2);
+
+for (let i = 0; i < kWorkers; i++) {
+  new Worker(`
+    const channel = new BroadcastChannel('test-fan-out');
+    const replies = new BroadcastChannel('test-fan-out-replies');
+    channel.onmessage = ({ data }) => {
+      // Changes to one receiver's copy are not visible to the others.
+      data.keys.push('local');
+      replies.postMessage({
+        kind: data.kind,
+        keys: data.keys,
+        value: new Uint32Array(data.shared)[0],
+      });
+      channel.close();
+      replies.close();
+    };
+    replies.postMessage('ready');
+  `, { eval: true }).on('exit', common.mustCall());
+}
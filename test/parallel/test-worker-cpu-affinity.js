@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { Worker } = require('worker_threads');
+
+for (const cpuAffinity of ['0', ['0']]) {
+  assert.throws(() => new Worker('', { eval: true, cpuAffinity }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+for (const cpuAffinity of [[-1], [0.5]]) {
+  assert.throws(() => new Worker('', { eval: true, cpuAffinity }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+}
+assert.throws(() => new Worker('', { eval: true, numaNode: -1 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+
+if (common.isMacOS) {
+  assert.throws(() => new Worker('', { eval: true, cpuAffinity: [0] }), {
+    code: 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM',
+  });
+  return;
+}
+
+assert.throws(() => new Worker('', { eval: true, cpuAffinity: [1e6] }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => new Worker('', { eval: true, numaNode: 1e6 }), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+
+if (!common.isLinux) {
+  common.skip('Checking the affinity of a thread requires Linux');
+}
+
+function allowedCpus(status) {
+  const list = /^Cpus_allowed_list:\s*(\S+)$/m.exec(status)[1];
+  const cpus = [];
+  for (const range of list.split(',')) {
+    const [first, last = first] = range.split('-').map(Number);
+    for (let cpu = first; cpu <= last; cpu++) cpus.push(cpu);
+  }
+  return cpus;
+}
+
+const code = `
+  const { parentPort } = require('worker_threads');
+  parentPort.postMessage(
+    require('fs').readFileSync('/proc/thread-self/status', 'latin1'));
+`;
+
+// Pick a CPU this process is allowed to run on.
+const cpu = allowedCpus(fs.readFileSync('/proc/self/status', 'latin1'))[0];
+new Worker(code, { eval: true, cpuAffinity: [cpu] })
+  .on('message', common.mustCall((status) => {
+    assert.deepStrictEqual(allowedCpus(status), [cpu]);
+  }));
+
+if (fs.existsSync('/sys/devices/system/node/node0/cpulist')) {
+  new Worker(code, { eval: true, numaNode: 0 })
+    .on('message', common.mustCall((status) => {
+      const nodeCpus = allowedCpus(
+        'Cpus_allowed_list: ' +
+        fs.readFileSync('/sys/devices/system/node/node0/cpulist', 'latin1'));
+      for (const cpu of allowedCpus(status)) {
+        assert(nodeCpus.includes(cpu), `${cpu} is not on node 0`);
+      }
+    }));
+}
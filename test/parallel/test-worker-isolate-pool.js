@@ -0,0 +1,64 @@
+// Flags: --experimental-worker-isolate-pool=2 --experimental-worker-isolate-pool-max-uses=2
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+// Workers that take an isolate from the pool, including ones that run on an
+// isolate that a previous Worker handed back, behave like any other Worker.
+
+const code = `
+const { parentPort, resourceLimits } = require('worker_threads');
+parentPort.once('message', (value) => {
+  parentPort.postMessage({ value: value * 2, resourceLimits });
+});
+globalThis.leftover = 'previous worker';
+`;
+
+function runWorker(options) {
+  return new Promise((resolve) => {
+    const w = new Worker(`${code}
+      require('worker_threads').parentPort.postMessage(typeof leftover);`, {
+      eval: true,
+      ...options,
+    });
+    const messages = [];
+    w.on('message', (message) => messages.push(message));
+    w.postMessage(21);
+    w.on('exit', common.mustCall((exitCode) => {
+      resolve({ exitCode, messages });
+    }));
+  });
+}
+
+(async () => {
+  const results = [];
+  for (let i = 0; i < 5; i++) {
+    results.push(await runWorker());
+  }
+  for (const { exitCode, messages } of results) {
+    assert.strictEqual(exitCode, 0);
+    // Each Worker gets a fresh global object.
+    assert.deepStrictEqual(messages[0], 'undefined');
+    assert.strictEqual(messages[1].value, 42);
+    assert.deepStrictEqual(messages[1].resourceLimits,
+                           results[0].messages[1].resourceLimits);
+  }
+
+  // Workers with custom heap limits create their own isolate.
+  const { exitCode, messages } = await runWorker({
+    resourceLimits: { maxOldGenerationSizeMb: 64 },
+  });
+  assert.strictEqual(exitCode, 0);
+  assert.strictEqual(messages[1].resourceLimits.maxOldGenerationSizeMb, 64);
+
+  // A Worker that is terminated does not hand its isolate back, and the
+  // pool keeps working afterwards.
+  const w = new Worker('setInterval(() => {}, 1000);', { eval: true });
+  w.on('online', common.mustCall(() => w.terminate()));
+  w.on('exit', common.mustCall(async (exitCode) => {
+    assert.strictEqual(exitCode, 1);
+    const result = await runWorker();
+    assert.strictEqual(result.messages[1].value, 42);
+  }));
+})().then(common.mustCall());
@@ -0,0 +1,46 @@
+// Flags: --message-port-batch-size=10
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { BroadcastChannel, MessageChannel, Worker } = require('worker_threads');
+
+// With --message-port-batch-size, a port yields to the event loop after
+// emitting that many messages.
+{
+  const { port1, port2 } = new MessageChannel();
+  let received = 0;
+  port1.on('message', common.mustCall(() => {
+    if (received++ === 0) {
+      setImmediate(common.mustCall(() => {
+        assert.strictEqual(received, 10);
+      }));
+    }
+    if (received === 100) port1.close();
+  }, 100));
+  for (let i = 0; i < 100; i++) port2.postMessage(i);
+}
+
+// Messages that several threads post at the same time to a port all arrive,
+// in order for each of the senders.
+{
+  const kSenders = 4;
+  const kMessages = 10000;
+  const channel = new BroadcastChannel('test-message-port-batch-size');
+  const next = new Array(kSenders).fill(0);
+  let done = 0;
+  channel.onmessage = common.mustCall(({ data: { sender, i } }) => {
+    assert.strictEqual(i, next[sender]++);
+    if (i === kMessages - 1 && ++done === kSenders) channel.close();
+  }, kSenders * kMessages);
+  for (let sender = 0; sender < kSenders; sender++) {
+    new Worker(`
+      const { workerData: { sender, kMessages } } = require('worker_threads');
+      const channel = new BroadcastChannel('test-message-port-batch-size');
+      for (let i = 0; i < kMessages; i++) channel.postMessage({ sender, i });
+      channel.close();
+    `, {
+      eval: true,
+      workerData: { sender, kMessages },
+    }).on('exit', common.mustCall());
+  }
+}
@@ -0,0 +1,77 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const {
+  MessageChannel,
+  Worker,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+// Test that receiveMessageOnPort() with a timeout blocks until a message is
+// posted from another thread, the timeout expires, or the port is closed.
+
+{
+  const { port1, port2 } = new MessageChannel();
+  assert.strictEqual(receiveMessageOnPort(port1, { timeout: 0 }), undefined);
+
+  const start = process.hrtime.bigint();
+  assert.strictEqual(receiveMessageOnPort(port1, { timeout: 50 }), undefined);
+  assert.ok(process.hrtime.bigint() - start >= 40_000_000n);
+
+  port2.postMessage('queued');
+  assert.deepStrictEqual(receiveMessageOnPort(port1, { timeout: Infinity }),
+                         { message: 'queued' });
+  port1.close();
+}
+
+{
+  // Synchronous requests to a worker that answers them from its event loop.
+  const { port1, port2 } = new MessageChannel();
+  const w = new Worker(`
+    const { workerData: port } = require('worker_threads');
+    port.on('message', (n) => {
+      if (n === 'close') return port.close();
+      port.postMessage(n * 2);
+    });
+  `, { eval: true, workerData: port2, transferList: [port2] });
+
+  for (let i = 0; i < 100; i++) {
+    port1.postMessage(i);
+    assert.deepStrictEqual(receiveMessageOnPort(port1, { timeout: Infinity }),
+                           { message: i * 2 });
+  }
+
+  // Closing the other side wakes up the thread.
+  port1.postMessage('close');
+  assert.strictEqual(receiveMessageOnPort(port1, { timeout: Infinity }),
+                     undefined);
+  w.on('exit', common.mustCall());
+}
+
+{
+  // A worker that is blocked can still be terminated.
+  const w = new Worker(`
+    const { MessageChannel, receiveMessageOnPort, parentPort } =
+      require('worker_threads');
+    const { port1 } = new MessageChannel();
+    parentPort.postMessage('waiting');
+    receiveMessageOnPort(port1, { timeout: Infinity });
+  `, { eval: true });
+  w.on('message', common.mustCall(() => w.terminate()));
+  w.on('exit', common.mustCall());
+}
+
+{
+  const { port1 } = new MessageChannel();
+  for (const timeout of [-1, NaN]) {
+    assert.throws(() => receiveMessageOnPort(port1, { timeout }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+  }
+  for (const options of [null, 'a', { timeout: '1' }]) {
+    assert.throws(() => receiveMessageOnPort(port1, options), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  port1.close();
+}
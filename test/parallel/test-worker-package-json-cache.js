@@ -0,0 +1,43 @@
+'use strict';
+
+// The package.json files that were read by one thread are reused by the
+// others, unless the file has changed since then.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const { Worker } = require('worker_threads');
+
+tmpdir.refresh();
+const pkg = tmpdir.resolve('pkg');
+fs.mkdirSync(pkg);
+fs.writeFileSync(`${pkg}/a.js`, 'module.exports = "a";');
+fs.writeFileSync(`${pkg}/b.js`, 'module.exports = "b";');
+fs.writeFileSync(`${pkg}/package.json`, JSON.stringify({ main: 'a.js' }));
+
+assert.strictEqual(require(pkg), 'a');
+
+function requireInWorker(expected) {
+  const worker = new Worker(`
+    const { parentPort, workerData } = require('worker_threads');
+    parentPort.postMessage(require(workerData));
+  `, { eval: true, workerData: pkg });
+  return new Promise((resolve) => {
+    worker.on('message', common.mustCall((value) => {
+      assert.strictEqual(value, expected);
+    }));
+    worker.on('exit', common.mustCall(resolve));
+  });
+}
+
+(async () => {
+  await requireInWorker('a');
+
+  fs.writeFileSync(`${pkg}/package.json`, JSON.stringify({ main: 'b.js' }));
+  // Make sure that the change is visible even on file systems with a coarse
+  // modification time.
+  const future = new Date(Date.now() + 10_000);
+  fs.utimesSync(`${pkg}/package.json`, future, future);
+  await requireInWorker('b');
+})().then(common.mustCall());
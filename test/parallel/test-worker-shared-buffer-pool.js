@@ -0,0 +1,68 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { SharedBufferPool, Worker } = require('worker_threads');
+
+{
+  const pool = new SharedBufferPool({ slabSize: 64 });
+  const a = pool.allocate(5);
+  const b = pool.allocate(3);
+  assert.strictEqual(a.length, 5);
+  assert.strictEqual(b.length, 3);
+  assert.strictEqual(a.buffer.length, 5);
+  // Slices of the same slab share a SharedArrayBuffer, 8-byte aligned.
+  assert.strictEqual(a.buffer.buffer, b.buffer.buffer);
+  assert(a.buffer.buffer instanceof SharedArrayBuffer);
+  assert.strictEqual(b.buffer.byteOffset, 8);
+
+  // Large slices get a slab of their own.
+  const c = pool.allocate(40);
+  assert.notStrictEqual(c.buffer.buffer, a.buffer.buffer);
+  assert.strictEqual(c.buffer.byteOffset, 0);
+
+  a.release();
+  assert.throws(() => a.buffer, { code: 'ERR_INVALID_STATE' });
+  assert.strictEqual(b.buffer.length, 3);
+}
+
+{
+  assert.throws(() => new SharedBufferPool({ slabSize: 4 }),
+                { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => new SharedBufferPool().allocate(-1),
+                { code: 'ERR_OUT_OF_RANGE' });
+}
+
+{
+  const pool = new SharedBufferPool();
+  const slice = pool.allocate(5);
+  const neighbour = pool.allocate(5);
+  const view = slice.buffer;
+  view.write('hello');
+  neighbour.buffer.write('world');
+
+  const w = new Worker(`
+    const { parentPort } = require('worker_threads');
+    parentPort.once('message', (slice) => {
+      const buf = slice.buffer;
+      parentPort.postMessage(buf.toString());
+      buf.write('HELLO');
+      parentPort.postMessage('done');
+    });
+  `, { eval: true });
+
+  const messages = [];
+  w.on('message', common.mustCall((msg) => {
+    messages.push(msg);
+    if (msg !== 'done') return;
+    assert.deepStrictEqual(messages, ['hello', 'done']);
+    // The memory was shared, not copied.
+    assert.strictEqual(view.toString(), 'HELLO');
+    assert.strictEqual(neighbour.buffer.toString(), 'world');
+    w.terminate();
+  }, 2));
+
+  w.postMessage(slice, [slice]);
+  assert.throws(() => slice.buffer, { code: 'ERR_INVALID_STATE' });
+  assert.throws(() => w.postMessage(slice, [slice]),
+                { code: 'ERR_INVALID_STATE' });
+}
@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { spawnSyncAndAssert } = require('../common/child_process');
+const { Worker, isMainThread, workerData } = require('worker_threads');
+
+// Test that the output of a worker that is written in bursts, and coalesced
+// into fewer messages to the parent thread, arrives complete and in order,
+// and that the `inheritStdio` option writes it straight to the process.
+
+const kLines = 1000;
+const expected = Array.from({ length: kLines }, (_, i) => `line ${i}\n`).join('');
+
+if (!isMainThread) {
+  for (let i = 0; i < kLines; i++)
+    console.log(`line ${i}`);
+  // A large write is not held back until the end of the tick.
+  process.stderr.write('x'.repeat(64 * 1024));
+  if (workerData === 'exit')
+    process.exit();
+  return;
+}
+
+if (process.argv[2] === 'inherit') {
+  const w = new Worker(__filename, { inheritStdio: true });
+  w.stdout.on('data', common.mustNotCall());
+  w.stderr.on('data', common.mustNotCall());
+  w.on('exit', common.mustCall());
+  return;
+}
+
+for (const mode of ['return', 'exit']) {
+  const w = new Worker(__filename, {
+    stdout: true,
+    stderr: true,
+    workerData: mode,
+  });
+  let stdout = '';
+  let stderr = '';
+  w.stdout.setEncoding('utf8');
+  w.stdout.on('data', (chunk) => stdout += chunk);
+  w.stderr.setEncoding('utf8');
+  w.stderr.on('data', (chunk) => stderr += chunk);
+  w.on('exit', common.mustCall(() => {
+    assert.strictEqual(stdout, expected);
+    assert.strictEqual(stderr.length, 64 * 1024);
+  }));
+}
+
+spawnSyncAndAssert(process.execPath, [__filename, 'inherit'], {
+  stdout: expected,
+  stderr(output) {
+    assert.strictEqual(output, 'x'.repeat(64 * 1024));
+  },
+});
+
+assert.throws(() => new Worker(__filename, { inheritStdio: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
@@ -0,0 +1,71 @@
+// Flags: --expose-internals --no-warnings --allow-natives-syntax
+'use strict';
+
+const common = require('../common');
+
+// The Adler-32 checksums of the zlib format and the chunked inflate copies
+// use SIMD code when it is available. Check them against a plain
+// implementation for lengths and offsets around the block sizes.
+
+const assert = require('assert');
+const zlib = require('zlib');
+const { internalBinding } = require('internal/test/binding');
+
+function adler32(buf) {
+  let s1 = 1;
+  let s2 = 0;
+  for (let i = 0; i < buf.length; i++) {
+    s1 = (s1 + buf[i]) % 65521;
+    s2 = (s2 + s1) % 65521;
+  }
+  return ((s2 << 16) | s1) >>> 0;
+}
+
+const source = Buffer.alloc(70000);
+for (let i = 0; i < source.length; i++)
+  source[i] = (i * 7919 + (i >> 5)) & 0xff;
+// Runs of 0xff exercise the largest sums between two reductions.
+source.fill(0xff, 20000, 40000);
+
+for (const length of [63, 64, 65, 96, 1023, 5552, 5553, 65536, 69990]) {
+  for (const offset of [0, 1, 7, 15]) {
+    const data = source.subarray(offset, offset + length);
+
+    const deflated = zlib.deflateSync(data);
+    assert.strictEqual(deflated.readUInt32BE(deflated.length - 4),
+                       adler32(data));
+    assert.deepStrictEqual(zlib.inflateSync(deflated), data);
+
+    const gzipped = zlib.gzipSync(data, { level: 1 });
+    assert.strictEqual(gzipped.readUInt32LE(gzipped.length - 8),
+                       zlib.crc32(data));
+    assert.deepStrictEqual(zlib.gunzipSync(gzipped), data);
+  }
+}
+
+{
+  // Matches with short distances are expanded with the splat loads of the
+  // inflate chunk copy code.
+  for (const period of [1, 2, 3, 4, 8, 9, 16, 17]) {
+    const pattern = source.subarray(100, 100 + period);
+    const data = Buffer.alloc(4096 + period, pattern);
+    assert.deepStrictEqual(zlib.inflateSync(zlib.deflateSync(data)), data);
+  }
+}
+
+{
+  function testFastPath() {
+    assert.strictEqual(zlib.crc32('hello world'), 0x0d4a1185);
+    assert.strictEqual(zlib.crc32(Buffer.from('hello world')), 0x0d4a1185);
+  }
+
+  eval('%PrepareFunctionForOptimization(zlib.crc32)');
+  testFastPath();
+  eval('%OptimizeFunctionOnNextCall(zlib.crc32)');
+  testFastPath();
+
+  if (common.isDebug) {
+    const { getV8FastApiCallCount } = internalBinding('debug');
+    assert.strictEqual(getV8FastApiCallCount('zlib.crc32'), 2);
+  }
+}
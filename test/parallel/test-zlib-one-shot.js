@@ -0,0 +1,140 @@
+'use strict';
+
+require('../common');
+
+// Small inputs of the synchronous convenience methods and inputs with the
+// `output` option are run through zlib without a stream. Check that the
+// results and errors are the same as those of a stream, which `chunkSize`
+// forces.
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('hello world '.repeat(100));
+const stream = { chunkSize: 16 * 1024 };
+
+for (const [compress, decompress] of [
+  ['deflateSync', 'inflateSync'],
+  ['deflateSync', 'unzipSync'],
+  ['gzipSync', 'gunzipSync'],
+  ['gzipSync', 'unzipSync'],
+  ['deflateRawSync', 'inflateRawSync'],
+]) {
+  for (const options of [{}, { level: 1, windowBits: 9, memLevel: 2 }]) {
+    const compressed = zlib[compress](input, options);
+    assert.deepStrictEqual(compressed,
+                           zlib[compress](input, { ...options, ...stream }));
+    assert.deepStrictEqual(zlib[decompress](compressed), input);
+
+    const output = Buffer.alloc(zlib.deflateBound(input.length, {
+      ...options,
+      format: compress.slice(0, -4),
+    }));
+    const result = zlib[compress](input, { ...options, output });
+    assert.strictEqual(result.buffer, output.buffer);
+    assert.deepStrictEqual(result, compressed);
+
+    const decompressed = new Uint8Array(input.length);
+    assert.deepStrictEqual(
+      zlib[decompress](compressed, { output: new DataView(decompressed.buffer) }),
+      input);
+    assert.deepStrictEqual(Buffer.from(decompressed), input);
+  }
+}
+
+{
+  // The result does not fit.
+  const compressed = zlib.deflateSync(input);
+  assert.throws(() => zlib.inflateSync(compressed, {
+    output: Buffer.alloc(input.length - 1),
+  }), {
+    code: 'ERR_OUT_OF_RANGE',
+    message: /It must be >= 1200\. Received 1199/,
+  });
+  assert.throws(() => zlib.deflateSync(input, { output: Buffer.alloc(1) }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => zlib.inflateSync(compressed, { maxOutputLength: 10 }), {
+    code: 'ERR_BUFFER_TOO_LARGE',
+  });
+}
+
+{
+  // Data after the end of a zlib stream is ignored.
+  const compressed = Buffer.concat([zlib.deflateSync(input), Buffer.from('x')]);
+  assert.deepStrictEqual(zlib.inflateSync(compressed), input);
+  assert.throws(() => zlib.inflateSync(compressed, {
+    rejectGarbageAfterEnd: true,
+  }), {
+    code: 'ERR_TRAILING_JUNK_AFTER_STREAM_END',
+  });
+}
+
+{
+  // Concatenated gzip members.
+  const compressed = Buffer.concat([zlib.gzipSync('abc'), zlib.gzipSync('def')]);
+  assert.strictEqual(zlib.gunzipSync(compressed).toString(), 'abcdef');
+}
+
+for (const data of [
+  Buffer.from('not compressed'),
+  Buffer.alloc(0),
+  zlib.deflateSync(input).subarray(0, 100),
+  Buffer.concat([zlib.gzipSync(input), Buffer.from('junk')]),
+]) {
+  let expected;
+  try {
+    zlib.unzipSync(data, stream);
+  } catch (err) {
+    expected = err;
+  }
+  assert.ok(expected);
+  assert.throws(() => zlib.unzipSync(data), {
+    code: expected.code,
+    message: expected.message,
+  });
+  assert.throws(() => zlib.unzipSync(data, { output: Buffer.alloc(2048) }), {
+    code: expected.code,
+    message: expected.message,
+  });
+}
+
+{
+  // The stream is still used, and the result copied, for the options that
+  // zlib cannot handle at once.
+  const dictionary = Buffer.from('hello world');
+  const compressed = zlib.deflateSync(input, { dictionary });
+  const output = Buffer.alloc(2048);
+  const result = zlib.inflateSync(compressed, { dictionary, output });
+  assert.strictEqual(result.buffer, output.buffer);
+  assert.deepStrictEqual(result, input);
+}
+
+assert.throws(() => zlib.deflateSync(input, { output: 'buffer' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.deflateSync(input, {
+  output: Buffer.alloc(2048),
+  info: true,
+}), {
+  code: 'ERR_INCOMPATIBLE_OPTION_PAIR',
+});
+
+{
+  const random = Buffer.alloc(10000);
+  for (let i = 0; i < random.length; i++)
+    random[i] = (i * 2654435761) >>> 24;
+  for (const format of ['deflate', 'deflateRaw', 'gzip']) {
+    for (const level of [0, 1, 9]) {
+      const bound = zlib.deflateBound(random.length, { format, level });
+      assert.ok(zlib[`${format}Sync`](random, { level }).length <= bound);
+    }
+  }
+  assert.throws(() => zlib.deflateBound(-1), { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => zlib.deflateBound(1, { format: 'brotli' }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => zlib.deflateBound(1, { level: 10 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+}
@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+
+// The convenience methods compress large inputs in blocks on several threads
+// when `parallelism` is set. Check that the output is a single valid stream
+// for every format.
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const blockSize = 32 * 1024;
+const input = Buffer.alloc(blockSize * 5 + 123);
+for (let i = 0; i < input.length; i++)
+  input[i] = (i * 31 + (i >> 8)) % 251;
+
+const formats = [
+  ['gzip', 'gunzipSync'],
+  ['deflate', 'inflateSync'],
+  ['deflateRaw', 'inflateRawSync'],
+];
+
+for (const [method, decompress] of formats) {
+  for (const options of [
+    { parallelism: 2, blockSize },
+    { parallelism: 4, blockSize, level: 9 },
+    { parallelism: 3, blockSize, level: 1, windowBits: 10, memLevel: 4 },
+    { parallelism: 2 },
+  ]) {
+    const compressed = zlib[`${method}Sync`](input, options);
+    assert.deepStrictEqual(zlib[decompress](compressed), input);
+
+    zlib[method](input, options, common.mustSucceed((result) => {
+      assert.deepStrictEqual(result, compressed);
+    }));
+  }
+
+  // Empty and short inputs are a single block.
+  for (const data of ['', 'hello']) {
+    const compressed = zlib[`${method}Sync`](data, { parallelism: 2 });
+    assert.strictEqual(zlib[decompress](compressed).toString(), data);
+  }
+}
+
+// gzip streams carry the CRC32 of the whole input.
+{
+  const compressed = zlib.gzipSync(input, { parallelism: 4, blockSize });
+  assert.strictEqual(compressed.readUInt32LE(compressed.length - 8),
+                     zlib.crc32(input));
+  assert.strictEqual(compressed.readUInt32LE(compressed.length - 4),
+                     input.length);
+}
+
+assert.throws(() => zlib.gzipSync(input, { parallelism: 0 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => zlib.gzipSync(input, { parallelism: 2, blockSize: 1024 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => zlib.gzipSync(input, { parallelism: 2, level: 10 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => zlib.gzipSync({}, { parallelism: 2 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.gzipSync(input, { parallelism: 2,
+                                           maxOutputLength: 10 }), {
+  code: 'ERR_BUFFER_TOO_LARGE',
+});
+zlib.gzip(input, { parallelism: 2, maxOutputLength: 10 },
+          common.mustCall((err) => {
+            assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+          }));
@@ -0,0 +1,89 @@
+'use strict';
+const common = require('../common');
+
+// The zlib state of closed streams is reset and reused by later streams with
+// the same parameters. Check that a reused state behaves like a new one, also
+// after errors, dictionaries, params() and window sizes from zlib headers.
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('reuse me '.repeat(1000) + 'x'.repeat(5000));
+const expected = {
+  gzip: zlib.gzipSync(input),
+  deflate: zlib.deflateSync(input, { level: 9, memLevel: 9 }),
+  deflateRaw: zlib.deflateRawSync(input, { windowBits: 9 }),
+};
+
+for (let i = 0; i < 20; i++) {
+  assert.deepStrictEqual(zlib.gzipSync(input), expected.gzip);
+  assert.deepStrictEqual(zlib.deflateSync(input, { level: 9, memLevel: 9 }),
+                         expected.deflate);
+  assert.deepStrictEqual(zlib.deflateRawSync(input, { windowBits: 9 }),
+                         expected.deflateRaw);
+  assert.deepStrictEqual(zlib.gunzipSync(expected.gzip), input);
+  assert.deepStrictEqual(zlib.inflateSync(expected.deflate), input);
+  assert.deepStrictEqual(zlib.inflateRawSync(expected.deflateRaw,
+                                             { windowBits: 9 }),
+                         input);
+}
+
+// A stream that failed leaves nothing behind for the next one.
+{
+  const corrupt = Buffer.from(expected.gzip);
+  corrupt[20] ^= 0xff;
+  assert.throws(() => zlib.gunzipSync(corrupt), { code: 'Z_DATA_ERROR' });
+  assert.deepStrictEqual(zlib.gunzipSync(expected.gzip), input);
+}
+
+// Streams that are not finished before they are closed.
+for (let i = 0; i < 3; i++) {
+  const deflate = zlib.createGzip();
+  deflate.write(input);
+  deflate.close();
+}
+assert.deepStrictEqual(zlib.gzipSync(input), expected.gzip);
+
+// Dictionaries are set again on a reused state.
+{
+  const dictionary = Buffer.from('reuse me ');
+  const compressed = zlib.deflateSync(input, { dictionary });
+  for (let i = 0; i < 3; i++) {
+    assert.deepStrictEqual(zlib.deflateSync(input, { dictionary }), compressed);
+    assert.deepStrictEqual(zlib.inflateSync(compressed, { dictionary }), input);
+  }
+  assert.deepStrictEqual(zlib.deflateSync(input), zlib.deflateSync(input));
+}
+
+// windowBits: 0 takes the window size from the header of each stream.
+{
+  const small = zlib.deflateSync(input, { windowBits: 9 });
+  const large = zlib.deflateSync(input, { windowBits: 15 });
+  for (let i = 0; i < 3; i++) {
+    assert.deepStrictEqual(zlib.inflateSync(small, { windowBits: 0 }), input);
+    assert.deepStrictEqual(zlib.inflateSync(large, { windowBits: 0 }), input);
+  }
+}
+
+// params() changes the state of a stream for good.
+{
+  const deflate = zlib.createDeflate({ level: 1 });
+  deflate.params(9, zlib.constants.Z_HUFFMAN_ONLY, common.mustSucceed(() => {
+    deflate.end(input);
+  }));
+  deflate.resume();
+  deflate.on('close', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.deflateSync(input, { level: 1 }),
+                           zlib.deflateSync(input, { level: 1 }));
+  }));
+}
+
+// Async streams.
+(async () => {
+  for (let i = 0; i < 10; i++) {
+    const result = await new Promise((resolve, reject) => {
+      zlib.gzip(input, (err, result) => (err ? reject(err) : resolve(result)));
+    });
+    assert.deepStrictEqual(result, expected.gzip);
+  }
+})().then(common.mustCall());
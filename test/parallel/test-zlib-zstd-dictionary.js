@@ -0,0 +1,121 @@
+'use strict';
+const common = require('../common');
+
+// Zstd streams accept raw and digested dictionaries, dictionaries can be
+// trained from samples, and digested dictionaries can be shared with other
+// threads.
+
+const assert = require('assert');
+const zlib = require('zlib');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+const samples = [];
+for (let i = 0; i < 2000; i++) {
+  samples.push(JSON.stringify({
+    id: i,
+    type: ['message', 'presence', 'typing'][i % 3],
+    user: { name: `user-${i % 37}`, status: i % 2 ? 'online' : 'away' },
+    text: `hello number ${i * 7919 % 1000}`,
+  }));
+}
+const message = Buffer.from(samples[1234]);
+
+const trained = zlib.trainZstdDictionary(samples, { dictionarySize: 4096 });
+assert.ok(Buffer.isBuffer(trained));
+assert.ok(trained.length > 0 && trained.length <= 4096);
+
+const dictionary = new zlib.ZstdDictionary(trained, { level: 5 });
+assert.ok(zlib.ZstdDictionary.isZstdDictionary(dictionary));
+assert.notStrictEqual(dictionary.id, 0);
+assert.strictEqual(dictionary.size, trained.length);
+
+{
+  const plain = zlib.zstdCompressSync(message);
+  const compressed = zlib.zstdCompressSync(message, { dictionary });
+  assert.ok(compressed.length < plain.length);
+  assert.deepStrictEqual(zlib.zstdDecompressSync(compressed, { dictionary }),
+                         message);
+  // A raw dictionary with the same content decompresses the same frames.
+  assert.deepStrictEqual(
+    zlib.zstdDecompressSync(compressed, { dictionary: trained }), message);
+  assert.deepStrictEqual(
+    zlib.zstdDecompressSync(
+      zlib.zstdCompressSync(message, { dictionary: trained.buffer.slice(
+        trained.byteOffset, trained.byteOffset + trained.length) }),
+      { dictionary }),
+    message);
+
+  // The dictionary is required to decompress.
+  assert.throws(() => zlib.zstdDecompressSync(compressed), {
+    code: 'ZSTD_error_dictionary_wrong',
+  });
+}
+
+// Raw content dictionaries have no ID.
+{
+  const raw = new zlib.ZstdDictionary(Buffer.from(samples.slice(0, 20).join('')));
+  assert.strictEqual(raw.id, 0);
+  const compressed = zlib.zstdCompressSync(message, { dictionary: raw });
+  assert.deepStrictEqual(
+    zlib.zstdDecompressSync(compressed, { dictionary: raw }), message);
+}
+
+// Async streams, and streams that are reset.
+zlib.zstdCompress(message, { dictionary }, common.mustSucceed((compressed) => {
+  zlib.zstdDecompress(compressed, { dictionary },
+                      common.mustSucceed((result) => {
+                        assert.deepStrictEqual(result, message);
+                      }));
+}));
+{
+  const stream = zlib.createZstdCompress({ dictionary });
+  stream.reset();
+  const chunks = [];
+  stream.on('data', (chunk) => chunks.push(chunk));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(
+      zlib.zstdDecompressSync(Buffer.concat(chunks), { dictionary }), message);
+  }));
+  stream.end(message);
+}
+
+// Multithreaded compression.
+{
+  const input = Buffer.from(samples.join('\n').repeat(4));
+  const compressed = zlib.zstdCompressSync(input, {
+    params: { [zlib.constants.ZSTD_c_nbWorkers]: 2 },
+  });
+  assert.deepStrictEqual(zlib.zstdDecompressSync(compressed), input);
+}
+
+// Digested dictionaries are cloned without being copied.
+{
+  const { port1, port2 } = new MessageChannel();
+  port1.postMessage(dictionary);
+  const { message: clone } = receiveMessageOnPort(port2);
+  assert.ok(clone instanceof zlib.ZstdDictionary);
+  assert.strictEqual(clone.id, dictionary.id);
+  const compressed = zlib.zstdCompressSync(message, { dictionary: clone });
+  assert.deepStrictEqual(zlib.zstdDecompressSync(compressed, { dictionary }),
+                         message);
+  port1.close();
+}
+
+assert.throws(() => new zlib.ZstdDictionary('abc'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => new zlib.ZstdDictionary(trained, { level: 23 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => zlib.zstdCompressSync(message, { dictionary: 'abc' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.trainZstdDictionary('abc'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.trainZstdDictionary([{}]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.trainZstdDictionary(['a', 'b']), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
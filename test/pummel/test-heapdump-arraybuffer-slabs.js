@@ -0,0 +1,24 @@
+// Flags: --experimental-arraybuffer-slab-allocator
+'use strict';
+
+// This tests that the slabs of small ArrayBuffer backing stores are tracked
+// in heap snapshots.
+
+require('../common');
+const { createJSHeapSnapshot, validateByRetainingPathFromNodes } = require('../common/heap');
+
+// Keep some blocks in use, and some free in the same slabs.
+const buffers = [];
+for (let i = 0; i < 1000; i++)
+  buffers.push(Buffer.allocUnsafeSlow(100 + (i % 10) * 30));
+buffers.length = 500;
+
+const nodes = createJSHeapSnapshot();
+validateByRetainingPathFromNodes(nodes, 'Node / IsolateData', [
+  { node_name: 'Node / SlabAllocator', edge_name: 'array_buffer_slabs' },
+  { node_name: 'Node / free_blocks', edge_name: 'free_blocks' },
+]);
+validateByRetainingPathFromNodes(nodes, 'Node / IsolateData', [
+  { node_name: 'Node / SlabAllocator', edge_name: 'array_buffer_slabs' },
+  { node_name: 'Node / padding', edge_name: 'padding' },
+]);
@@ -0,0 +1,35 @@
+'use strict';
+// Test producing a report on an event loop stall.
+const common = require('../common');
+const assert = require('assert');
+const childProcess = require('child_process');
+const helper = require('../common/report');
+const tmpdir = require('../common/tmpdir');
+
+if (process.argv[2] === 'child') {
+  setTimeout(() => {
+    const start = Date.now();
+    while (Date.now() - start < 500);
+  }, 1);
+  return;
+}
+
+tmpdir.refresh();
+const child = childProcess.spawn(process.execPath, [
+  '--trace-event-loop-stalls=100',
+  '--report-on-event-loop-stall',
+  __filename,
+  'child',
+], {
+  cwd: tmpdir.path,
+});
+child.on('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  const reports = helper.findReports(child.pid, tmpdir.path);
+  assert.strictEqual(reports.length, 1);
+
+  helper.validate(reports[0], [
+    ['header.event', 'Event loop stall'],
+    ['header.trigger', 'EventLoopStall'],
+  ]);
+}));
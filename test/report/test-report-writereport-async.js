@@ -0,0 +1,59 @@
+'use strict';
+
+// Test producing a report asynchronously via API call.
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const helper = require('../common/report');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+process.report.directory = tmpdir.path;
+
+(async () => {
+  {
+    // Test with no arguments.
+    const file = await process.report.writeReportAsync();
+    const reports = helper.findReports(process.pid, tmpdir.path);
+    assert.strictEqual(reports.length, 1);
+    assert.strictEqual(tmpdir.resolve(file), reports[0]);
+    helper.validate(reports[0]);
+    fs.unlinkSync(reports[0]);
+  }
+
+  {
+    // Test with file and error arguments.
+    const error = new Error('test error');
+    error.foo = 'goo';
+    const file = await process.report.writeReportAsync('custom-name-1.json',
+                                                       error);
+    assert.strictEqual(file, 'custom-name-1.json');
+    const absolutePath = tmpdir.resolve(file);
+    helper.validate(absolutePath,
+                    [['javascriptStack.errorProperties.foo', 'goo']]);
+    fs.unlinkSync(absolutePath);
+  }
+
+  {
+    // Test that the sections written in the threadpool honor the exclusions.
+    process.report.excludeEnv = true;
+    const file = await process.report.writeReportAsync('custom-name-2.json');
+    const report = JSON.parse(fs.readFileSync(tmpdir.resolve(file), 'utf8'));
+    assert.strictEqual(report.environmentVariables, undefined);
+    assert.ok(report.sharedObjects);
+    process.report.excludeEnv = false;
+  }
+
+  {
+    // Test that a file that cannot be written rejects the promise.
+    process.report.directory = tmpdir.resolve('does-not-exist');
+    await assert.rejects(process.report.writeReportAsync('custom-name-3.json'),
+                         { code: 'ENOENT', syscall: 'open' });
+  }
+
+  [null, 1, Symbol(), function() {}].forEach((file) => {
+    assert.throws(() => {
+      process.report.writeReportAsync(file);
+    }, { code: 'ERR_INVALID_ARG_TYPE' });
+  });
+})().then(common.mustCall());
@@ -123,6 +123,14 @@ function testInitialized(req, ctor_name) {
   testInitialized(new JSStream(), 'JSStream');
 }
 
+{
+  const { JSStream } = internalBinding('js_stream');
+  const { StreamByteSink, StreamByteSource } =
+    internalBinding('stream_bridge');
+  testInitialized(new StreamByteSource(new JSStream()), 'StreamByteSource');
+  testInitialized(new StreamByteSink(new JSStream()), 'StreamByteSink');
+}
+
 
 {
   // We don't want to expose getAsyncId for promises but we need to construct
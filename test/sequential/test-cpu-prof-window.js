@@ -0,0 +1,97 @@
+'use strict';
+
+// This tests that --cpu-prof-window writes a CPU profile for every window
+// while the profiler keeps running, and that --cpu-prof-format=pprof writes
+// them in the pprof format.
+
+const common = require('../common');
+common.skipIfInspectorDisabled();
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+const {
+  getCpuProfiles,
+  kCpuProfInterval,
+  env,
+} = require('../common/cpu-prof');
+
+// Keep the event loop busy for a few windows.
+const code = `
+  const end = Date.now() + 1000;
+  function fibonacci(n) { return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2); }
+  function work() {
+    fibonacci(20);
+    if (Date.now() < end) setImmediate(work);
+  }
+  work();
+`;
+
+function run(...args) {
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof',
+    '--cpu-prof-interval',
+    kCpuProfInterval,
+    '--cpu-prof-window',
+    '200',
+    ...args,
+    '-e', code,
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+}
+
+{
+  run();
+  const profiles = getCpuProfiles(tmpdir.path);
+  assert(profiles.length > 1, `${profiles.length} profiles`);
+  const names = profiles.flatMap((file) => {
+    const profile = JSON.parse(fs.readFileSync(file, 'utf8'));
+    return profile.nodes.map((node) => node.callFrame.functionName);
+  });
+  assert(names.includes('fibonacci'));
+}
+
+{
+  run('--cpu-prof-format', 'pprof');
+  const profiles = fs.readdirSync(tmpdir.path)
+    .filter((file) => file.endsWith('.pprof'))
+    .map((file) => path.join(tmpdir.path, file));
+  assert(profiles.length > 1, `${profiles.length} profiles`);
+  const data = Buffer.concat(profiles.map((file) => fs.readFileSync(file)));
+  // The pprof profiles are binary, with the names in their string tables.
+  const text = data.toString('latin1');
+  assert(!text.includes('"nodes"'));
+  assert(text.includes('nanoseconds'));
+  assert(text.includes('fibonacci'));
+}
+
+// --cpu-prof-window with --cpu-prof-name
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof',
+    '--cpu-prof-window',
+    '100',
+    '--cpu-prof-name',
+    'test.cpuprofile',
+    '-e', '',
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  assert.strictEqual(output.status, 9);
+  assert.strictEqual(
+    output.stderr.toString().trim(),
+    `${process.execPath}: --cpu-prof-name cannot be used with ` +
+    '--cpu-prof-window');
+}
@@ -0,0 +1,65 @@
+'use strict';
+
+// This tests that heap snapshots can be compressed while they are written.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const zlib = require('zlib');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+function checkSnapshot(json) {
+  const snapshot = JSON.parse(json);
+  assert(snapshot.snapshot.meta);
+  assert(snapshot.nodes.length > 0);
+  assert(snapshot.strings.length > 0);
+}
+
+if (process.argv[2] === 'child') {
+  const v8 = require('v8');
+  const compression = process.argv[3];
+  const decompress = compression === 'gzip' ?
+    zlib.gunzipSync : zlib.zstdDecompressSync;
+  const extension = compression === 'gzip' ? '.gz' : '.zst';
+
+  const filename = v8.writeHeapSnapshot(undefined, { compression });
+  assert(filename.endsWith(`.heapsnapshot${extension}`), filename);
+  checkSnapshot(decompress(fs.readFileSync(filename)).toString());
+
+  const chunks = [];
+  v8.getHeapSnapshot({ compression })
+    .on('data', (chunk) => chunks.push(chunk))
+    .on('end', common.mustCall(() => {
+      checkSnapshot(decompress(Buffer.concat(chunks)).toString());
+    }));
+  return;
+}
+
+tmpdir.refresh();
+
+// Start child processes to prevent the heap from growing too big.
+for (const compression of ['gzip', 'zstd']) {
+  const child = spawnSync(
+    process.execPath,
+    [__filename, 'child', compression],
+    { cwd: tmpdir.path });
+  if (child.status !== 0) {
+    console.log('[STDERR]', child.stderr.toString());
+    console.log('[STDOUT]', child.stdout.toString());
+  }
+  assert.strictEqual(child.status, 0);
+}
+
+assert.throws(() => require('v8').writeHeapSnapshot(undefined, {
+  compression: 'brotli',
+}), { code: 'ERR_INVALID_ARG_VALUE' });
+
+{
+  const child = spawnSync(process.execPath, [
+    '--heapsnapshot-compression', 'brotli', '-e', '',
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert.match(child.stderr.toString(),
+               /invalid value for --heapsnapshot-compression: brotli/);
+}
@@ -233,6 +233,7 @@ const customTypesMap = {
 
   'tls.SecureContext': 'tls.html#tlscreatesecurecontextoptions',
   'tls.Server': 'tls.html#class-tlsserver',
+  'tls.SessionCache': 'tls.html#class-tlssessioncache',
   'tls.TLSSocket': 'tls.html#class-tlstlssocket',
 
   'Tracing': 'tracing.html#tracing-object',
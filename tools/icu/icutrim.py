@@ -82,6 +82,12 @@ parser.add_option('-L',"--locales",
                   help="sets the 'locales.only' variable",
                   default=None)
 
+parser.add_option("-X","--extract-dir",
+                  action="store",
+                  dest="extractdir",
+                  help="also unpack the trimmed data into individual files under this directory",
+                  default=None)
+
 parser.add_option('-e', '--endian', action='store', dest='endian', help='endian, big, little or host, your default is "%s".' % endian, default=endian, metavar='endianness')
 
 (options, args) = parser.parse_args()
@@ -353,3 +359,15 @@ for tree in trees:
     runcmd("iculslocs", "-i %s -N %s -T %s -b %s" % (outfile, dataname, tree, treebundtxt))
     runcmd("genrb","-d %s -s %s res_index.txt" % (treebunddir, treebunddir))
     runcmd("icupkg","-s %s -a %s%s %s" % (options.tmpdir, trees[tree]["treeprefix"], RES_INDX, outfile))
+
+## STEP 3 - optionally unpack the trimmed data. ICU loads the items of an
+## unpacked package from individual files on first use, so a process only
+## maps the data of the locales it actually uses.
+if options.extractdir:
+    extractdir = os.path.join(options.extractdir, dataname)
+    if os.path.exists(extractdir):
+        print("Error, extract directory does exist: %s" % (extractdir))
+        sys.exit(1)
+    os.makedirs(extractdir)
+    runcmd("icupkg", "-l %s > %s" % (outfile, listfile))
+    runcmd("icupkg", "-d %s -x %s %s" % (extractdir, listfile, outfile))
@@ -4,6 +4,7 @@ import { ConfigBinding } from './internalBinding/config';
 import { ConstantsBinding } from './internalBinding/constants';
 import { DebugBinding } from './internalBinding/debug';
 import { HttpParserBinding } from './internalBinding/http_parser';
+import { HttpSerializerBinding } from './internalBinding/http_serializer';
 import { InspectorBinding } from './internalBinding/inspector';
 import { FsBinding } from './internalBinding/fs';
 import { FsDirBinding } from './internalBinding/fs_dir';
@@ -32,6 +33,7 @@ interface InternalBindingMap {
   fs: FsBinding;
   fs_dir: FsDirBinding;
   http_parser: HttpParserBinding;
+  http_serializer: HttpSerializerBinding;
   inspector: InspectorBinding;
   messaging: MessagingBinding;
   modules: ModulesBinding;
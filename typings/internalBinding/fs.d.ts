@@ -116,6 +116,9 @@ declare namespace InternalFSBinding {
   function futimes(fd: number, atime: number, mtime: number, usePromises: typeof kUsePromises): Promise<void>;
 
   function internalModuleStat(receiver: unknown, path: string): number;
+  function internalModuleStat(path: string, useModuleStatCache?: boolean): number;
+  function getModuleStatCacheStats(): [hits: number, misses: number, size: number];
+  function clearModuleStatCache(): void;
 
   function lchown(path: string, uid: number, gid: number, req: FSReqCallback): void;
   function lchown(path: string, uid: number, gid: number, req: undefined, ctx: FSSyncContext): void;
@@ -179,7 +182,14 @@ declare namespace InternalFSBinding {
   function readdir(path: StringOrBuffer, encoding: unknown, withFileTypes: true, usePromises: typeof kUsePromises): Promise<[string[], number[]]>;
   function readdir(path: StringOrBuffer, encoding: unknown, withFileTypes: false, usePromises: typeof kUsePromises): Promise<string[]>;
 
-  function readFileUtf8(path: StringOrBuffer, flags: number): string;
+  function readFileUtf8(path: StringOrBuffer, flags: number, mmap?: boolean): string;
+
+  function readMany(paths: StringOrBuffer[], flags: number, req: FSReqCallback<[Array<Buffer | string>, Int32Array]>): void;
+  function readMany(paths: StringOrBuffer[], flags: number, req: undefined): [Array<Buffer | string>, Int32Array];
+  function readMany(paths: StringOrBuffer[], flags: number, usePromises: typeof kUsePromises): Promise<[Array<Buffer | string>, Int32Array]>;
+  function readdirRecursive(path: StringOrBuffer, req: FSReqCallback<[string[], Uint32Array, string[], Uint8Array]>): void;
+  function readdirRecursive(path: StringOrBuffer, req: undefined): [string[], Uint32Array, string[], Uint8Array];
+  function mapFile(fd: number, size: number): Buffer | undefined;
 
   function readlink(path: StringOrBuffer, encoding: unknown, req: FSReqCallback<string | Buffer>): void;
   function readlink(path: StringOrBuffer, encoding: unknown, req: undefined, ctx: FSSyncContext): string | Buffer;
@@ -201,6 +211,7 @@ declare namespace InternalFSBinding {
   function rmdir(path: string, usePromises: typeof kUsePromises): Promise<void>;
 
   function rmSync(path: StringOrBuffer, maxRetries: number, recursive: boolean, retryDelay: number): void;
+  function rmRecursive(path: StringOrBuffer, req: FSReqCallback): void;
 
   function stat(path: StringOrBuffer, useBigint: boolean, req: FSReqCallback<Float64Array | BigUint64Array>): void;
   function stat(path: StringOrBuffer, useBigint: true, req: FSReqCallback<BigUint64Array>): void;
@@ -212,6 +223,10 @@ declare namespace InternalFSBinding {
   function stat(path: StringOrBuffer, useBigint: true, usePromises: typeof kUsePromises): Promise<BigUint64Array>;
   function stat(path: StringOrBuffer, useBigint: false, usePromises: typeof kUsePromises): Promise<Float64Array>;
 
+  function statMany(paths: StringOrBuffer[], useBigint: boolean, req: FSReqCallback<[Float64Array | BigUint64Array, Int32Array]>): void;
+  function statMany(paths: StringOrBuffer[], useBigint: boolean, req: undefined): [Float64Array | BigUint64Array, Int32Array];
+  function statMany(paths: StringOrBuffer[], useBigint: boolean, usePromises: typeof kUsePromises): Promise<[Float64Array | BigUint64Array, Int32Array]>;
+
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, req: FSReqCallback): void;
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, req: undefined, ctx: FSSyncContext): void;
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, usePromises: typeof kUsePromises): Promise<void>;
@@ -254,6 +269,7 @@ export interface FsBinding {
   bigintStatValues: BigUint64Array;
 
   kFsStatsFieldsNumber: number;
+  kReadFileMmapThreshold: number;
   StatWatcher: typeof InternalFSBinding.StatWatcher;
 
   access: typeof InternalFSBinding.access;
@@ -272,10 +288,13 @@ export interface FsBinding {
   ftruncate: typeof InternalFSBinding.ftruncate;
   futimes: typeof InternalFSBinding.futimes;
   internalModuleStat: typeof InternalFSBinding.internalModuleStat;
+  getModuleStatCacheStats: typeof InternalFSBinding.getModuleStatCacheStats;
+  clearModuleStatCache: typeof InternalFSBinding.clearModuleStatCache;
   lchown: typeof InternalFSBinding.lchown;
   link: typeof InternalFSBinding.link;
   lstat: typeof InternalFSBinding.lstat;
   lutimes: typeof InternalFSBinding.lutimes;
+  mapFile: typeof InternalFSBinding.mapFile;
   mkdtemp: typeof InternalFSBinding.mkdtemp;
   mkdir: typeof InternalFSBinding.mkdir;
   open: typeof InternalFSBinding.open;
@@ -283,13 +302,17 @@ export interface FsBinding {
   read: typeof InternalFSBinding.read;
   readBuffers: typeof InternalFSBinding.readBuffers;
   readdir: typeof InternalFSBinding.readdir;
+  readdirRecursive: typeof InternalFSBinding.readdirRecursive;
   readFileUtf8: typeof InternalFSBinding.readFileUtf8;
+  readMany: typeof InternalFSBinding.readMany;
   readlink: typeof InternalFSBinding.readlink;
   realpath: typeof InternalFSBinding.realpath;
   rename: typeof InternalFSBinding.rename;
   rmdir: typeof InternalFSBinding.rmdir;
   rmSync: typeof InternalFSBinding.rmSync;
+  rmRecursive: typeof InternalFSBinding.rmRecursive;
   stat: typeof InternalFSBinding.stat;
+  statMany: typeof InternalFSBinding.statMany;
   symlink: typeof InternalFSBinding.symlink;
   unlink: typeof InternalFSBinding.unlink;
   utimes: typeof InternalFSBinding.utimes;
@@ -8,6 +8,7 @@ declare namespace InternalFSDirBinding {
   class DirHandle {
     read(encoding: string, bufferSize: number, callback: FSReqCallback): string[] | undefined;
     read(encoding: string, bufferSize: number): string[] | undefined;
+    read(encoding: string, bufferSize: number, callback: FSReqCallback | undefined, packed: true): [Buffer, Uint8Array] | undefined;
     close(callback: FSReqCallback): void;
     close(): void;
   }
@@ -0,0 +1,3 @@
+export interface HttpSerializerBinding {
+  serializeHeaders(headers: string[], validate: boolean, specials: Uint32Array): string | undefined;
+}
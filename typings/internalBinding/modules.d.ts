@@ -26,6 +26,8 @@ export interface ModulesBinding {
   getNearestParentPackageJSON(path: string): SerializedPackageConfig | undefined
   getPackageScopeConfig(path: string): SerializedPackageConfig | undefined
   getPackageType(path: string): PackageConfig['type'] | undefined
+  getCachedResolution(specifier: string, parentPath: string, resolverKey: string): string | undefined
+  cacheResolution(specifier: string, parentPath: string, resolverKey: string, filename: string, result: string): void
   enableCompileCache(path?: string): { status: number, message?: string, directory?: string }
   getCompileCacheDir(): string | undefined
   flushCompileCache(keepDeserializedCache?: boolean): void
@@ -40,6 +40,7 @@ interface EndpointOptions {
   validateAddress?: boolean;
   disableStatelessReset?: boolean;
   ipv6Only?: boolean;
+  reusePort?: boolean;
   udpReceiveBufferSize?: number;
   udpSendBufferSize?: number;
   udpTTL?: number;
@@ -60,6 +61,7 @@ interface Endpoint {
   closeGracefully(): void;
   markBusy(on?: boolean): void;
   ref(on?: boolean): void;
+  rotateTokenSecret(secret?: ArrayBufferView): void;
   address(): SocketAddress|void;
   readonly state: ArrayBuffer;
   readonly stats: ArrayBuffer;
@@ -68,6 +70,8 @@ interface Endpoint {
 export interface QuicBinding {
   setCallbacks(callbacks: QuicCallbacks): void;
   flushPacketFreeList(): void;
+  readonly http3HeaderNames: string[];
+  readonly QUIC_STREAM_HEADER_TOKEN_FLAG: number;
 
   readonly IDX_STATS_ENDPOINT_CREATED_AT: number;
   readonly IDX_STATS_ENDPOINT_DESTROYED_AT: number;
@@ -82,6 +86,7 @@ export interface QuicBinding {
   readonly IDX_STATS_ENDPOINT_VERSION_NEGOTIATION_COUNT: number;
   readonly IDX_STATS_ENDPOINT_STATELESS_RESET_COUNT: number;
   readonly IDX_STATS_ENDPOINT_IMMEDIATE_CLOSE_COUNT: number;
+  readonly IDX_STATS_ENDPOINT_FORWARDED_PACKET_COUNT: number;
   readonly IDX_STATS_ENDPOINT_COUNT: number;
   readonly IDX_STATE_ENDPOINT_BOUND: number;
   readonly IDX_STATE_ENDPOINT_BOUND_SIZE: number;
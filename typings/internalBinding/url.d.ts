@@ -9,5 +9,6 @@ export interface URLBinding {
   canParse(input: string, base: string): boolean;
   format(input: string, fragment?: boolean, unicode?: boolean, search?: boolean, auth?: boolean): string;
   parse(input: string, base?: string): string | false;
+  parseSearchParams(input: string, maxPairs: number, legacy: boolean): string[] | undefined;
   update(input: string, actionType: typeof urlUpdateActions, value: string): string | false;
 }
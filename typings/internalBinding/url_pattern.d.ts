@@ -15,6 +15,16 @@ export class URLPattern {
   test(input: string | Record<string, string>, baseURL?: string): boolean;
 }
 
+export class URLPatternList {
+  readonly length: number
+
+  constructor(patterns: URLPattern[]);
+
+  exec(input: string | Record<string, string>, baseURL?: string): null | { index: number, result: Record<string, unknown> };
+  test(input: string | Record<string, string>, baseURL?: string): boolean;
+}
+
 export interface URLPatternBinding {
   URLPattern: URLPattern;
+  URLPatternList: URLPatternList;
 }
@@ -31,10 +31,21 @@ declare namespace InternalZlibBinding {
     constructor(mode: number);
     init(initParamsArray: Uint32Array, writeState: Uint32Array, callback: VoidFunction): boolean;
   }
+
+  class ZstdDictionary {
+    constructor(data: ArrayBufferView, level: number);
+    getId(): number;
+    getSize(): number;
+  }
 }
 
 export interface ZlibBinding {
   BrotliDecoder: typeof InternalZlibBinding.BrotliDecoder;
   BrotliEncoder: typeof InternalZlibBinding.BrotliEncoder;
   Zlib: typeof InternalZlibBinding.Zlib;
+  ZstdDictionary: typeof InternalZlibBinding.ZstdDictionary;
+
+  deflateBound(mode: number, length: number, level: number, windowBits: number, memLevel: number, strategy: number): number;
+  trainZstdDictionary(samples: ArrayBufferView[], capacity: number): Buffer;
+  zlibOneShot(mode: number, input: ArrayBufferView, output: ArrayBufferView, level: number, windowBits: number, memLevel: number, strategy: number): number;
 }